@@ -0,0 +1,208 @@
+# SPDX-FileCopyrightText: Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+# SPDX-License-Identifier: Apache-2.0
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+#
+
+"""
+Compares google-benchmark and pytest-benchmark json results against a baseline of median times and reports the
+benchmarks which regressed beyond a tolerance. Used by the bench_all target of cpp/mrc/benchmarks:
+
+    compare_benchmarks.py --baseline cpp/mrc/benchmarks/baseline.json --report report.md results/*.json
+
+exits with 1 if any benchmark regressed. With --update the baseline is rewritten from the results instead, keeping
+its tolerances.
+
+The baseline holds the median real time of each benchmark in nanoseconds, keyed by `<executable>/<benchmark name>`,
+with a default relative tolerance and optional per-benchmark tolerances keyed by regular expressions:
+
+    {
+        "tolerance": 0.1,
+        "tolerances": {"bench_mrc_network/.*": 0.25},
+        "context": {...},
+        "benchmarks": {"bench_mrc/mrc_runner_launch_and_join/1": {"time_ns": 10500.0}}
+    }
+"""
+
+import argparse
+import json
+import os
+import re
+import sys
+
+# nanoseconds per unit of the time_unit of google-benchmark results
+TIME_UNITS = {"ns": 1.0, "us": 1e3, "ms": 1e6, "s": 1e9}
+
+DEFAULT_TOLERANCE = 0.1
+
+
+def executable_name(path: str):
+    name = os.path.basename(path)
+    return name[:-2] if name.endswith(".x") else name
+
+
+def load_google_benchmark(results: dict):
+    """
+    Median real time of each benchmark; the median aggregate of repeated runs is preferred over the mean and over
+    single runs. Benchmarks which were skipped or failed are omitted.
+    """
+    prefix = executable_name(results.get("context", {}).get("executable", "bench"))
+    preference = {"median": 0, "mean": 1, None: 2}
+    times = {}
+    for bench in results.get("benchmarks", []):
+        if bench.get("error_occurred") or bench.get("skipped"):
+            continue
+        aggregate = bench.get("aggregate_name") if bench.get("run_type") == "aggregate" else None
+        if aggregate not in preference:
+            continue
+        name = "{}/{}".format(prefix, bench.get("run_name", bench["name"]))
+        time_ns = bench["real_time"] * TIME_UNITS[bench.get("time_unit", "ns")]
+        rank = preference[aggregate]
+        if name not in times or rank < times[name][0]:
+            times[name] = (rank, time_ns)
+    return {name: time_ns for name, (_, time_ns) in times.items()}
+
+
+def load_pytest_benchmark(results: dict):
+    return {"python/{}".format(bench["fullname"]): bench["stats"]["median"] * 1e9 for bench in results["benchmarks"]}
+
+
+def load_results(paths: list):
+    times = {}
+    for path in paths:
+        with open(path) as f:
+            results = json.load(f)
+        # pytest-benchmark reports its version in machine_info, google-benchmark its library in context
+        if "machine_info" in results:
+            times.update(load_pytest_benchmark(results))
+        else:
+            times.update(load_google_benchmark(results))
+    return times
+
+
+def tolerance_of(name: str, baseline: dict, default: float):
+    for pattern, tolerance in baseline.get("tolerances", {}).items():
+        if re.fullmatch(pattern, name):
+            return tolerance
+    return default
+
+
+def format_time(time_ns):
+    if time_ns is None:
+        return "-"
+    for unit, scale in (("s", 1e9), ("ms", 1e6), ("us", 1e3)):
+        if time_ns >= scale:
+            return "{:.3f} {}".format(time_ns / scale, unit)
+    return "{:.1f} ns".format(time_ns)
+
+
+def compare(baseline: dict, times: dict, default_tolerance: float):
+    """
+    Rows of (status, name, baseline time, current time, relative change, tolerance) sorted by status and change
+    """
+    rows = []
+    baseline_times = {name: bench["time_ns"] for name, bench in baseline.get("benchmarks", {}).items()}
+    for name in sorted(set(baseline_times) | set(times)):
+        tolerance = tolerance_of(name, baseline, default_tolerance)
+        before = baseline_times.get(name)
+        after = times.get(name)
+        if before is None:
+            rows.append(("new", name, before, after, None, tolerance))
+            continue
+        if after is None:
+            rows.append(("missing", name, before, after, None, tolerance))
+            continue
+
+        change = (after - before) / before if before > 0 else 0.0
+        if change > tolerance:
+            status = "regression"
+        elif change < -tolerance:
+            status = "improvement"
+        else:
+            status = "ok"
+        rows.append((status, name, before, after, change, tolerance))
+
+    order = {"regression": 0, "improvement": 1, "ok": 2, "new": 3, "missing": 4}
+    rows.sort(key=lambda row: (order[row[0]], -(row[4] or 0.0), row[1]))
+    return rows
+
+
+def make_report(rows: list):
+    counts = {}
+    for row in rows:
+        counts[row[0]] = counts.get(row[0], 0) + 1
+
+    lines = ["# Benchmark comparison", ""]
+    lines.append(", ".join("{} {}".format(count, status) for status, count in sorted(counts.items())) or "no results")
+    lines.append("")
+    lines.append("| status | benchmark | baseline | current | change | tolerance |")
+    lines.append("| --- | --- | ---: | ---: | ---: | ---: |")
+    for status, name, before, after, change, tolerance in rows:
+        lines.append("| {} | {} | {} | {} | {} | {:.0%} |".format(status,
+                                                                 name,
+                                                                 format_time(before),
+                                                                 format_time(after),
+                                                                 "-" if change is None else "{:+.1%}".format(change),
+                                                                 tolerance))
+    return "\n".join(lines) + "\n"
+
+
+def update_baseline(baseline: dict, times: dict, path: str):
+    baseline["benchmarks"] = {name: {"time_ns": round(time_ns, 3)} for name, time_ns in sorted(times.items())}
+    baseline["context"] = {"host_name": os.uname().nodename, "machine": os.uname().machine}
+    with open(path, "w") as f:
+        json.dump(baseline, f, indent=4)
+        f.write("\n")
+    print("wrote {} benchmarks to {}".format(len(times), path))
+
+
+def parse_args():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("results", nargs="+", help="google-benchmark or pytest-benchmark json results")
+    parser.add_argument("--baseline", required=True, help="baseline json")
+    parser.add_argument("--tolerance",
+                        type=float,
+                        default=None,
+                        help="relative tolerance overriding the default tolerance of the baseline")
+    parser.add_argument("--report", default=None, help="also write the report as markdown to this file")
+    parser.add_argument("--update", action="store_true", help="rewrite the baseline from the results")
+    return parser.parse_args()
+
+
+def main():
+    args = parse_args()
+
+    baseline = {"tolerance": DEFAULT_TOLERANCE, "tolerances": {}, "benchmarks": {}}
+    if os.path.exists(args.baseline):
+        with open(args.baseline) as f:
+            baseline = json.load(f)
+
+    times = load_results([path for path in args.results if os.path.exists(path)])
+
+    if args.update:
+        update_baseline(baseline, times, args.baseline)
+        return 0
+
+    default_tolerance = args.tolerance if args.tolerance is not None else baseline.get("tolerance", DEFAULT_TOLERANCE)
+    rows = compare(baseline, times, default_tolerance)
+    report = make_report(rows)
+    print(report)
+    if args.report:
+        with open(args.report, "w") as f:
+            f.write(report)
+
+    return 1 if any(row[0] == "regression" for row in rows) else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -37,6 +37,15 @@ for benchmark in "${BENCHMARKS[@]}"; do
        set -e
 done
 
+rapids-logger "Comparing against the baseline"
+set +e
+python ${MRC_ROOT}/ci/scripts/compare_benchmarks.py \
+       --baseline ${MRC_ROOT}/cpp/mrc/benchmarks/baseline.json \
+       --report "${REPORTS_DIR}/benchmark_comparison.md" \
+       ${REPORTS_DIR}/*.json
+BENCH_RESULTS=$(($BENCH_RESULTS+$?))
+set -e
+
 # We want the archive step to run, even if we failed, save our exit status, which the next step can use
 echo ${BENCH_RESULTS} > ${WORKSPACE_TMP}/exit_status
 
@@ -70,6 +70,11 @@ include(deps/Configure_ucx)
 set(HWLOC_VERSION "2.5" CACHE STRING "Version of hwloc to use")
 include(deps/Configure_hwloc)
 
+# lz4 and zstd
+# ============
+# - codecs of the optional compression of encoded buffers
+include(deps/Configure_compression)
+
 # FlatBuffers
 # ===========
 # rapids_find_package(Flatbuffers REQUIRED
@@ -145,6 +150,19 @@ include(deps/Configure_prometheus)
 # =========
 include(deps/Configure_libcudacxx)
 
+if(MRC_BUILD_KAFKA)
+  # librdkafka
+  # ==========
+  # - client of the optional io::KafkaConsumer
+  rapids_find_package(RdKafka REQUIRED
+    GLOBAL_TARGETS RdKafka::rdkafka
+    BUILD_EXPORT_SET ${PROJECT_NAME}-core-exports
+    INSTALL_EXPORT_SET ${PROJECT_NAME}-core-exports
+    FIND_ARGS
+    CONFIG
+  )
+endif()
+
 if(MRC_BUILD_BENCHMARKS)
   # google benchmark
   # ================
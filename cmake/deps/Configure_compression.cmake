@@ -0,0 +1,46 @@
+#=============================================================================
+# SPDX-FileCopyrightText: Copyright (c) 2020-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+# SPDX-License-Identifier: Apache-2.0
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+#=============================================================================
+
+function(find_and_configure_compression)
+
+  list(APPEND CMAKE_MESSAGE_CONTEXT "compression")
+
+  find_package(PkgConfig REQUIRED)
+
+  # lz4 and zstd are only available through pkg-config; each is aliased to <name>::<name> and exported with the same
+  # pkg-config search so that consumers of the install tree resolve them the same way
+  foreach(name IN ITEMS liblz4 libzstd)
+
+    pkg_check_modules(${name} REQUIRED IMPORTED_TARGET GLOBAL ${name})
+
+    message(STATUS "Found ${name} with pkg-config at: ${${name}_LIBRARY_DIRS}")
+
+    add_library(${name}::${name} ALIAS PkgConfig::${name})
+
+    rapids_export_package(INSTALL ${name}
+      ${PROJECT_NAME}-core-exports
+      GLOBAL_TARGETS ${name}::${name}
+    )
+
+    configure_file("${CMAKE_CURRENT_FUNCTION_LIST_DIR}/templates/pkgconfig_package.cmake.in"
+      "${CMAKE_BINARY_DIR}/rapids-cmake/${PROJECT_NAME}-core-exports/install/package_${name}.cmake" @ONLY)
+
+  endforeach()
+
+endfunction()
+
+find_and_configure_compression()
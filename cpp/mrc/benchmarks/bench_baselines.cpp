@@ -17,6 +17,7 @@
 
 #include "mrc/benchmarking/tracer.hpp"
 #include "mrc/benchmarking/util.hpp"
+#include "mrc/data/pooled_allocator.hpp"
 
 #include <benchmark/benchmark.h>
 #include <nlohmann/json.hpp>
@@ -328,6 +329,35 @@ void sharedptr_nocreate_latency(const std::size_t packet_count)
             []() {});
 }
 
+void pooled_sharedptr_create_latency(const std::size_t packet_count)
+{
+    using data_type_t = std::shared_ptr<DataObject>;
+
+    auto ints = rxcpp::observable<>::create<data_type_t>([&](rxcpp::subscriber<data_type_t> subscriber) {
+        defs::tracing_start_ns = TimeUtil::get_delay_compensated_time_point();
+        for (auto i = 0; i < packet_count; ++i)
+        {
+            subscriber.on_next(mrc::data::make_pooled_shared<DataObject>());
+        }
+        subscriber.on_completed();
+    });
+
+    ints.map([](data_type_t data) {
+            data->m_data_object_counter++;
+            data->m_payload->m_data_payload_counter++;
+            return data;
+        })
+        .subscribe(
+            [](data_type_t data) {
+                defs::count += 1;
+                if (defs::count == defs::object_count)
+                {
+                    defs::elapsed_total_ns = (TimeUtil::get_current_time_point() - defs::tracing_start_ns).count();
+                }
+            },
+            []() {});
+}
+
 static void rx_map_latency_raw(benchmark::State& state)
 {
     for (auto _ : state)
@@ -370,6 +400,20 @@ static void rx_sharedptr_nocreate_latency(benchmark::State& state)
         static_cast<double>(defs::elapsed_total_ns * TimeUtil::NsToSec) / defs::object_count;
 }
 
+static void rx_pooled_sharedptr_create_latency(benchmark::State& state)
+{
+    for (auto _ : state)
+    {
+        defs::reset();
+        pooled_sharedptr_create_latency(defs::object_count);
+    }
+
+    state.counters["elapsed_seconds"] = defs::elapsed_total_ns * TimeUtil::NsToSec;
+    state.counters["count"]           = defs::count;
+    state.counters["average_latency_seconds"] =
+        static_cast<double>(defs::elapsed_total_ns * TimeUtil::NsToSec) / defs::object_count;
+}
+
 static void rx_debug_noop_tap_sharedptr_latency(benchmark::State& state)
 {
     for (auto _ : state)
@@ -466,6 +510,7 @@ BENCHMARK(chrono_highres_clock_now)->UseRealTime();
 BENCHMARK(rx_map_latency_raw)->UseRealTime();
 BENCHMARK(rx_tap_latency_raw)->UseRealTime();
 BENCHMARK(rx_sharedptr_nocreate_latency)->UseRealTime();
+BENCHMARK(rx_pooled_sharedptr_create_latency)->UseRealTime();
 BENCHMARK(rx_debug_noop_tap_sharedptr_latency)->UseRealTime();
 BENCHMARK(rx_debug_noop_maptap_sharedptr_latency)->UseRealTime();
 BENCHMARK(rx_debug_tap_sharedptr_latency)->UseRealTime();
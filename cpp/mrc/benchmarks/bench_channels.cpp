@@ -0,0 +1,463 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "mrc/channel/buffered_channel.hpp"
+#include "mrc/channel/channel.hpp"
+#include "mrc/channel/null_channel.hpp"
+#include "mrc/channel/recent_channel.hpp"
+#include "mrc/channel/status.hpp"
+#include "mrc/coroutines/ring_buffer.hpp"
+#include "mrc/coroutines/sync_wait.hpp"
+#include "mrc/coroutines/task.hpp"
+#include "mrc/coroutines/thread_pool.hpp"
+#include "mrc/coroutines/when_all.hpp"
+
+#include <benchmark/benchmark.h>
+#include <boost/fiber/fiber.hpp>
+#include <hwloc.h>
+#include <pthread.h>
+#include <sched.h>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+using namespace mrc;
+
+namespace {
+
+// Sweeps the channel implementations in isolation over producer/consumer counts, payloads, engines and placements.
+// Arguments: producers, consumers, engine (Threads: one thread per producer and consumer; Fibers: all of them are
+// fibers of the benchmark thread) and placement (Unpinned; SameNode: all threads on the cpus of the first numa node;
+// CrossNode: producers on the first and consumers on the last numa node). Latency percentiles are computed from one
+// in LatencySampleRate elements and reported as counters.
+
+constexpr std::size_t ElementsPerIteration = 1 << 16;
+constexpr std::size_t LatencySampleRate    = 64;
+constexpr std::size_t ChannelCapacity      = 128;
+
+enum Engine : std::int64_t
+{
+    Threads,
+    Fibers,
+};
+
+enum Placement : std::int64_t
+{
+    Unpinned,
+    SameNode,
+    CrossNode,
+};
+
+struct Payload4K
+{
+    std::array<std::byte, 4096> data{};
+};
+
+template <typename PayloadT>
+PayloadT make_payload(std::size_t i)
+{
+    if constexpr (std::is_same_v<PayloadT, std::shared_ptr<std::int64_t>>)
+    {
+        return std::make_shared<std::int64_t>(i);
+    }
+    else if constexpr (std::is_same_v<PayloadT, Payload4K>)
+    {
+        Payload4K payload;
+        payload.data[0] = static_cast<std::byte>(i);
+        return payload;
+    }
+    else
+    {
+        return static_cast<std::int64_t>(i);
+    }
+}
+
+template <typename PayloadT>
+struct Message
+{
+    std::int64_t sent_ns{0};
+    PayloadT payload{};
+};
+
+// NullChannel has no capacity
+template <typename ChannelT>
+std::unique_ptr<ChannelT> make_channel()
+{
+    if constexpr (std::is_constructible_v<ChannelT, std::size_t>)
+    {
+        return std::make_unique<ChannelT>(ChannelCapacity);
+    }
+    else
+    {
+        return std::make_unique<ChannelT>();
+    }
+}
+
+std::int64_t now_ns()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+}
+
+// cpus of the numa nodes of the machine, first to last
+const std::vector<std::vector<unsigned>>& numa_cpus()
+{
+    static const auto s_cpus = [] {
+        std::vector<std::vector<unsigned>> cpus;
+        hwloc_topology_t topology;
+        hwloc_topology_init(&topology);
+        hwloc_topology_load(topology);
+        auto count = hwloc_get_nbobjs_by_type(topology, HWLOC_OBJ_NUMANODE);
+        for (int i = 0; i < count; i++)
+        {
+            auto* node = hwloc_get_obj_by_type(topology, HWLOC_OBJ_NUMANODE, i);
+            auto& node_cpus = cpus.emplace_back();
+            unsigned cpu;
+            hwloc_bitmap_foreach_begin(cpu, node->cpuset)
+            {
+                node_cpus.push_back(cpu);
+            }
+            hwloc_bitmap_foreach_end();
+        }
+        hwloc_topology_destroy(topology);
+        return cpus;
+    }();
+    return s_cpus;
+}
+
+// cpu of the index-th producer or consumer thread, -1 if it is not pinned
+int placement_cpu(Placement placement, bool consumer, std::size_t index)
+{
+    const auto& cpus = numa_cpus();
+    if (placement == Unpinned || cpus.empty())
+    {
+        return -1;
+    }
+    const auto& node = (placement == CrossNode && consumer ? cpus.back() : cpus.front());
+    return static_cast<int>(node[index % node.size()]);
+}
+
+void pin_current_thread(int cpu)
+{
+    if (cpu < 0)
+    {
+        return;
+    }
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+}
+
+bool check_placement(benchmark::State& state, Placement placement)
+{
+    if (placement == CrossNode && numa_cpus().size() < 2)
+    {
+        state.SkipWithError("cross node placement requires at least 2 numa nodes");
+        return false;
+    }
+    return true;
+}
+
+class LatencySamples
+{
+  public:
+    void add(const std::vector<std::int64_t>& samples)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_samples.insert(m_samples.end(), samples.begin(), samples.end());
+    }
+
+    void report(benchmark::State& state)
+    {
+        if (m_samples.empty())
+        {
+            return;
+        }
+        std::sort(m_samples.begin(), m_samples.end());
+        auto percentile = [this](double p) {
+            return static_cast<double>(m_samples[static_cast<std::size_t>(p * (m_samples.size() - 1))]);
+        };
+        state.counters["p50_ns"]  = percentile(0.50);
+        state.counters["p99_ns"]  = percentile(0.99);
+        state.counters["p999_ns"] = percentile(0.999);
+    }
+
+  private:
+    std::mutex m_mutex;
+    std::vector<std::int64_t> m_samples;
+};
+
+// runs the producers and consumers on threads or as fibers of the calling thread and waits for them
+void run_workers(Engine engine,
+                 Placement placement,
+                 std::size_t producers,
+                 std::size_t consumers,
+                 const std::function<void(std::size_t)>& produce,
+                 const std::function<void()>& consume)
+{
+    if (engine == Fibers)
+    {
+        std::vector<boost::fibers::fiber> fibers;
+        for (std::size_t i = 0; i < consumers; i++)
+        {
+            fibers.emplace_back(consume);
+        }
+        for (std::size_t i = 0; i < producers; i++)
+        {
+            fibers.emplace_back(produce, i);
+        }
+        for (auto& fiber : fibers)
+        {
+            fiber.join();
+        }
+        return;
+    }
+
+    std::vector<std::thread> threads;
+    for (std::size_t i = 0; i < consumers; i++)
+    {
+        threads.emplace_back([&consume, cpu = placement_cpu(placement, true, i)] {
+            pin_current_thread(cpu);
+            consume();
+        });
+    }
+    for (std::size_t i = 0; i < producers; i++)
+    {
+        threads.emplace_back([&produce, i, cpu = placement_cpu(placement, false, i)] {
+            pin_current_thread(cpu);
+            produce(i);
+        });
+    }
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+}
+
+template <typename ChannelT, typename PayloadT>
+void mrc_channel_sweep(benchmark::State& state)
+{
+    const auto producers = static_cast<std::size_t>(state.range(0));
+    const auto consumers = static_cast<std::size_t>(state.range(1));
+    const auto engine    = static_cast<Engine>(state.range(2));
+    const auto placement = static_cast<Placement>(state.range(3));
+    if (!check_placement(state, placement))
+    {
+        return;
+    }
+
+    LatencySamples latencies;
+    std::size_t received = 0;
+
+    for (auto _ : state)
+    {
+        // through the base interface, which implementations may hide
+        auto owner    = make_channel<ChannelT>();
+        auto& channel = static_cast<channel::Channel<Message<PayloadT>>&>(*owner);
+        std::atomic<std::size_t> remaining_producers{producers};
+        std::atomic<std::size_t> total_received{0};
+
+        auto produce = [&](std::size_t index) {
+            for (std::size_t i = index; i < ElementsPerIteration; i += producers)
+            {
+                channel.await_write(Message<PayloadT>{now_ns(), make_payload<PayloadT>(i)});
+            }
+            if (remaining_producers.fetch_sub(1) == 1)
+            {
+                channel.close_channel();
+            }
+        };
+
+        auto consume = [&] {
+            std::vector<std::int64_t> samples;
+            std::size_t count = 0;
+            Message<PayloadT> message;
+            while (channel.await_read(message) == channel::Status::success)
+            {
+                if (count++ % LatencySampleRate == 0)
+                {
+                    samples.push_back(now_ns() - message.sent_ns);
+                }
+                benchmark::DoNotOptimize(message);
+            }
+            total_received += count;
+            latencies.add(samples);
+        };
+
+        run_workers(engine, placement, producers, consumers, produce, consume);
+        received += total_received.load();
+    }
+
+    // throughput counts the written elements; those evicted by a RecentChannel or discarded by a NullChannel are
+    // missing from the delivered fraction
+    state.SetItemsProcessed(state.iterations() * ElementsPerIteration);
+    state.counters["delivered"] = static_cast<double>(received) / (ElementsPerIteration * state.iterations());
+    latencies.report(state);
+}
+
+// the coroutine ring buffer runs its producers and consumers as tasks of a thread pool, one thread per task; with a
+// placement, the first producers threads of the pool are placed as producers and the others as consumers
+template <typename PayloadT>
+void mrc_coro_ring_buffer_sweep(benchmark::State& state)
+{
+    const auto producers = static_cast<std::size_t>(state.range(0));
+    const auto consumers = static_cast<std::size_t>(state.range(1));
+    const auto placement = static_cast<Placement>(state.range(3));
+    if (!check_placement(state, placement))
+    {
+        return;
+    }
+
+    coroutines::ThreadPool pool({.thread_count            = static_cast<std::uint32_t>(producers + consumers),
+                                 .on_thread_start_functor = [producers, placement](std::size_t index) {
+                                     auto consumer = index >= producers;
+                                     pin_current_thread(
+                                         placement_cpu(placement, consumer, consumer ? index - producers : index));
+                                 },
+                                 .description = "bench"});
+
+    LatencySamples latencies;
+    std::size_t received = 0;
+
+    for (auto _ : state)
+    {
+        coroutines::RingBuffer<Message<PayloadT>> ring_buffer({.capacity = ChannelCapacity});
+        std::atomic<std::size_t> remaining_producers{producers};
+
+        auto produce = [&](std::size_t index) -> coroutines::Task<std::size_t> {
+            co_await pool.schedule();
+            for (std::size_t i = index; i < ElementsPerIteration; i += producers)
+            {
+                // a named element: gcc destroys braced temporaries of a co_await expression twice
+                Message<PayloadT> message{now_ns(), make_payload<PayloadT>(i)};
+                co_await ring_buffer.write(std::move(message));
+            }
+            if (remaining_producers.fetch_sub(1) == 1)
+            {
+                ring_buffer.close();
+            }
+            co_return 0;
+        };
+
+        auto consume = [&]() -> coroutines::Task<std::size_t> {
+            co_await pool.schedule();
+            std::vector<std::int64_t> samples;
+            std::size_t count = 0;
+            while (true)
+            {
+                auto message = co_await ring_buffer.read();
+                if (!message)
+                {
+                    break;
+                }
+                if (count++ % LatencySampleRate == 0)
+                {
+                    samples.push_back(now_ns() - message->sent_ns);
+                }
+                benchmark::DoNotOptimize(*message);
+            }
+            latencies.add(samples);
+            co_return count;
+        };
+
+        std::vector<coroutines::Task<std::size_t>> tasks;
+        for (std::size_t i = 0; i < consumers; i++)
+        {
+            tasks.push_back(consume());
+        }
+        for (std::size_t i = 0; i < producers; i++)
+        {
+            tasks.push_back(produce(i));
+        }
+        auto results = coroutines::sync_wait(coroutines::when_all(std::move(tasks)));
+        for (auto& result : results)
+        {
+            received += result.return_value();
+        }
+    }
+
+    state.SetItemsProcessed(received);
+    latencies.report(state);
+}
+
+// producers x consumers over both engines and all placements; fibers of a single thread are not placed
+void channel_sweep_args(benchmark::internal::Benchmark* bench)
+{
+    for (std::int64_t producers : {1, 4})
+    {
+        for (std::int64_t consumers : {1, 4})
+        {
+            for (auto placement : {Unpinned, SameNode, CrossNode})
+            {
+                bench->Args({producers, consumers, Threads, placement});
+            }
+            bench->Args({producers, consumers, Fibers, Unpinned});
+        }
+    }
+    bench->ArgNames({"producers", "consumers", "engine", "placement"})->UseRealTime();
+}
+
+void ring_buffer_sweep_args(benchmark::internal::Benchmark* bench)
+{
+    for (std::int64_t producers : {1, 4})
+    {
+        for (std::int64_t consumers : {1, 4})
+        {
+            for (auto placement : {Unpinned, SameNode, CrossNode})
+            {
+                bench->Args({producers, consumers, Threads, placement});
+            }
+        }
+    }
+    bench->ArgNames({"producers", "consumers", "engine", "placement"})->UseRealTime();
+}
+
+using shared_payload_t = std::shared_ptr<std::int64_t>;
+
+}  // namespace
+
+BENCHMARK_TEMPLATE(mrc_channel_sweep, BufferedChannel<Message<std::int64_t>>, std::int64_t)
+    ->Apply(channel_sweep_args);
+BENCHMARK_TEMPLATE(mrc_channel_sweep, BufferedChannel<Message<shared_payload_t>>, shared_payload_t)
+    ->Apply(channel_sweep_args);
+BENCHMARK_TEMPLATE(mrc_channel_sweep, BufferedChannel<Message<Payload4K>>, Payload4K)->Apply(channel_sweep_args);
+
+BENCHMARK_TEMPLATE(mrc_channel_sweep, RecentChannel<Message<std::int64_t>>, std::int64_t)
+    ->Apply(channel_sweep_args);
+BENCHMARK_TEMPLATE(mrc_channel_sweep, RecentChannel<Message<shared_payload_t>>, shared_payload_t)
+    ->Apply(channel_sweep_args);
+BENCHMARK_TEMPLATE(mrc_channel_sweep, RecentChannel<Message<Payload4K>>, Payload4K)->Apply(channel_sweep_args);
+
+BENCHMARK_TEMPLATE(mrc_channel_sweep, channel::NullChannel<Message<std::int64_t>>, std::int64_t)
+    ->Apply(channel_sweep_args);
+BENCHMARK_TEMPLATE(mrc_channel_sweep, channel::NullChannel<Message<Payload4K>>, Payload4K)
+    ->Apply(channel_sweep_args);
+
+BENCHMARK_TEMPLATE(mrc_coro_ring_buffer_sweep, std::int64_t)->Apply(ring_buffer_sweep_args);
+BENCHMARK_TEMPLATE(mrc_coro_ring_buffer_sweep, shared_payload_t)->Apply(ring_buffer_sweep_args);
+BENCHMARK_TEMPLATE(mrc_coro_ring_buffer_sweep, Payload4K)->Apply(ring_buffer_sweep_args);
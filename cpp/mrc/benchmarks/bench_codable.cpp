@@ -0,0 +1,76 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "internal/resources/manager.hpp"
+#include "internal/runtime/partition.hpp"
+#include "internal/runtime/runtime.hpp"
+#include "internal/system/system.hpp"
+#include "internal/system/system_provider.hpp"
+
+#include "mrc/codable/api.hpp"
+#include "mrc/codable/decode.hpp"
+#include "mrc/codable/encode.hpp"
+#include "mrc/codable/fundamental_types.hpp"  // IWYU pragma: keep
+#include "mrc/options/options.hpp"
+#include "mrc/options/placement.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <utility>
+
+using namespace mrc;
+
+/**
+ * Micro benchmark of the codable encode and decode paths of the data a remote descriptor carries; small strings are
+ * copied into the eager descriptor of the encoded object, larger ones are registered as memory regions with ucx.
+ */
+
+namespace {
+
+std::unique_ptr<internal::runtime::Runtime> make_runtime()
+{
+    auto options = std::make_shared<Options>();
+    options->placement().resources_strategy(PlacementResources::Dedicated);
+
+    auto resources = std::make_unique<internal::resources::Manager>(
+        internal::system::SystemProvider(internal::system::make_system(std::move(options))));
+    return std::make_unique<internal::runtime::Runtime>(std::move(resources));
+}
+
+}  // namespace
+
+// encode a string of state.range(0) bytes into a new codable storage and decode it back
+static void mrc_codable_string_round_trip(benchmark::State& state)
+{
+    auto runtime     = make_runtime();
+    const auto bytes = static_cast<std::size_t>(state.range(0));
+    const std::string str(bytes, 'x');
+
+    for (auto _ : state)
+    {
+        auto storage = runtime->partition(0).make_codable_storage();
+        codable::encode(str, *storage);
+        benchmark::DoNotOptimize(codable::decode<std::string>(*storage));
+    }
+
+    state.SetBytesProcessed(state.iterations() * bytes);
+}
+
+BENCHMARK(mrc_codable_string_round_trip)->RangeMultiplier(64)->Range(64, 1 << 24)->UseRealTime();
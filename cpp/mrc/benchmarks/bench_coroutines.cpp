@@ -15,15 +15,33 @@
  * limitations under the License.
  */
 
+#include "mrc/coroutines/event.hpp"
+#include "mrc/coroutines/frame_pool.hpp"
 #include "mrc/coroutines/sync_wait.hpp"
 #include "mrc/coroutines/task.hpp"
+#include "mrc/coroutines/thread_pool.hpp"
+#include "mrc/coroutines/when_all.hpp"
 
 #include <benchmark/benchmark.h>
 
+#include <atomic>
+#include <chrono>
 #include <coroutine>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
 
 using namespace mrc;
 
+namespace {
+struct PooledValue
+{};
+}  // namespace
+
+template <>
+struct mrc::coroutines::use_frame_pool<PooledValue> : std::true_type
+{};
+
 static void mrc_coro_create_single_task_and_sync(benchmark::State& state)
 {
     auto task = []() -> coroutines::Task<void> { co_return; };
@@ -34,6 +52,16 @@ static void mrc_coro_create_single_task_and_sync(benchmark::State& state)
     }
 }
 
+static void mrc_coro_create_single_pooled_task_and_sync(benchmark::State& state)
+{
+    auto task = []() -> coroutines::Task<PooledValue> { co_return PooledValue{}; };
+
+    for (auto _ : state)
+    {
+        coroutines::sync_wait(task());
+    }
+}
+
 static void mrc_coro_create_single_task_and_sync_on_when_all(benchmark::State& state)
 {
     auto task = []() -> coroutines::Task<void> { co_return; };
@@ -130,9 +158,121 @@ static void mrc_coro_await_incrementing_awaitable_baseline(benchmark::State& sta
     coroutines::sync_wait(task());
 }
 
+// fan out `range(1)` tasks from an executor thread, each hopping through `range(2)` yields, then fan back in
+// the fanned-out tasks start on the local queue of a single executor, so scaling with `range(0)` threads requires
+// the idle executors to steal work
+static void mrc_coro_thread_pool_fan_out_fan_in(benchmark::State& state)
+{
+    coroutines::ThreadPool pool({.thread_count = static_cast<std::uint32_t>(state.range(0)), .description = "bench"});
+
+    const auto fan_out = static_cast<std::size_t>(state.range(1));
+    const auto hops    = static_cast<std::size_t>(state.range(2));
+
+    auto leaf = [&pool, hops](std::size_t x) -> coroutines::Task<std::size_t> {
+        co_await pool.schedule();
+        std::size_t value = x;
+        for (std::size_t i = 0; i < hops; i++)
+        {
+            co_await pool.yield();
+            benchmark::DoNotOptimize(value += i);
+        }
+        co_return value;
+    };
+
+    auto root = [&pool, &leaf, fan_out]() -> coroutines::Task<std::size_t> {
+        co_await pool.schedule();
+        std::vector<coroutines::Task<std::size_t>> tasks;
+        tasks.reserve(fan_out);
+        for (std::size_t i = 0; i < fan_out; i++)
+        {
+            tasks.push_back(leaf(i));
+        }
+        auto results    = co_await coroutines::when_all(std::move(tasks));
+        std::size_t sum = 0;
+        for (auto& result : results)
+        {
+            sum += result.return_value();
+        }
+        co_return sum;
+    };
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(coroutines::sync_wait(root()));
+    }
+
+    state.SetItemsProcessed(state.iterations() * fan_out * (hops + 1));
+}
+
+// time from setting an event to all of its `range(1)` waiters on a pool of `range(0)` threads having run; with
+// `range(2)` == 0 the setter resumes the waiters inline one after the other, otherwise they are handed to the pool
+// at once by set(pool) and striped across its executors
+static void mrc_coro_event_set_waiters(benchmark::State& state)
+{
+    coroutines::ThreadPool pool({.thread_count = static_cast<std::uint32_t>(state.range(0)), .description = "bench"});
+
+    const auto waiter_count = static_cast<std::size_t>(state.range(1));
+    const bool on_pool      = state.range(2) != 0;
+
+    for (auto _ : state)
+    {
+        coroutines::Event event;
+        std::atomic<std::size_t> suspended{0};
+        std::chrono::high_resolution_clock::time_point set_at;
+
+        auto waiter = [&]() -> coroutines::Task<void> {
+            co_await pool.schedule();
+            suspended++;
+            co_await event;
+            benchmark::DoNotOptimize(suspended.load(std::memory_order_relaxed));
+        };
+
+        auto setter = [&]() -> coroutines::Task<void> {
+            co_await pool.schedule();
+            while (suspended.load() < waiter_count)
+            {
+                co_await pool.yield();
+            }
+            set_at = std::chrono::high_resolution_clock::now();
+            if (on_pool)
+            {
+                event.set(pool);
+            }
+            else
+            {
+                event.set();
+            }
+        };
+
+        std::vector<coroutines::Task<void>> tasks;
+        tasks.reserve(waiter_count + 1);
+        for (std::size_t i = 0; i < waiter_count; i++)
+        {
+            tasks.push_back(waiter());
+        }
+        tasks.push_back(setter());
+        coroutines::sync_wait(coroutines::when_all(std::move(tasks)));
+
+        state.SetIterationTime(
+            std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - set_at).count());
+    }
+
+    state.SetItemsProcessed(state.iterations() * waiter_count);
+}
+
 BENCHMARK(mrc_coro_create_single_task_and_sync);
+BENCHMARK(mrc_coro_create_single_pooled_task_and_sync);
 BENCHMARK(mrc_coro_create_single_task_and_sync_on_when_all);
 BENCHMARK(mrc_coro_create_two_tasks_and_sync_on_when_all);
 BENCHMARK(mrc_coro_await_suspend_never);
 BENCHMARK(mrc_coro_await_incrementing_awaitable_baseline);
 BENCHMARK(mrc_coro_await_incrementing_awaitable);
+BENCHMARK(mrc_coro_thread_pool_fan_out_fan_in)
+    ->ArgsProduct({{1, 2, 4, 8, 16, 32}, {1024}, {0, 16}})
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK(mrc_coro_event_set_waiters)
+    ->ArgsProduct({{1, 4, 16}, {16, 1024, 16384}, {0, 1}})
+    ->ArgNames({"threads", "waiters", "on_pool"})
+    ->UseManualTime()
+    ->Unit(benchmark::kMicrosecond);
@@ -0,0 +1,338 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "internal/control_plane/client.hpp"
+#include "internal/control_plane/client/connections_manager.hpp"
+#include "internal/data_plane/client.hpp"
+#include "internal/data_plane/request.hpp"
+#include "internal/data_plane/resources.hpp"
+#include "internal/memory/device_resources.hpp"
+#include "internal/memory/host_resources.hpp"
+#include "internal/network/resources.hpp"
+#include "internal/resources/manager.hpp"
+#include "internal/resources/partition_resources.hpp"
+#include "internal/runnable/resources.hpp"
+#include "internal/system/system.hpp"
+#include "internal/system/system_provider.hpp"
+#include "internal/ucx/memory_block.hpp"
+#include "internal/ucx/registration_cache.hpp"
+
+#include "mrc/core/task_queue.hpp"
+#include "mrc/memory/buffer.hpp"
+#include "mrc/memory/literals.hpp"
+#include "mrc/options/network.hpp"
+#include "mrc/options/options.hpp"
+#include "mrc/options/placement.hpp"
+#include "mrc/options/resources.hpp"
+#include "mrc/types.hpp"
+
+#include <benchmark/benchmark.h>
+#include <boost/fiber/future/future.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace mrc;
+using namespace mrc::memory::literals;
+
+namespace {
+
+// Micro benchmarks of the data plane client and server over UCX loopback between the first two partitions of a
+// machine, i.e. a multi-gpu host; they are skipped on machines exposing a single partition. Arguments: message size in
+// bytes, memory kind of the buffers (Host: pinned host memory of the partition; Device: device memory of its gpu) and
+// the number of requests in flight per iteration. The sizes span the eager and rendezvous protocols of ucx; set
+// UCX_RNDV_THRESH to move the crossover, and the other UCX_* variables or NetworkOptions being tuned, when comparing
+// runs on new hardware.
+
+constexpr std::int64_t MaxMessageBytes  = 16_MiB;
+constexpr std::int64_t MaxBytesInFlight = 64_MiB;
+
+enum Memory : std::int64_t
+{
+    Host,
+    Device,
+};
+
+struct Loopback
+{
+    std::unique_ptr<internal::resources::Manager> resources;
+    internal::data_plane::Resources* sender{nullptr};
+    internal::data_plane::Resources* receiver{nullptr};
+    InstanceID sender_id{0};
+    InstanceID receiver_id{0};
+};
+
+// partition 1 sends to, or pulls from, partition 0; empty if the machine exposes a single partition
+std::optional<Loopback> make_loopback()
+{
+    auto options = std::make_shared<Options>();
+    options->enable_server(true);
+    options->architect_url("localhost:13337");
+    options->placement().resources_strategy(PlacementResources::Dedicated);
+    options->resources().enable_device_memory_pool(true);
+    options->resources().enable_host_memory_pool(true);
+    options->resources().host_memory_pool().block_size(2 * MaxBytesInFlight);
+    options->resources().host_memory_pool().max_aggregate_bytes(8 * MaxBytesInFlight);
+    options->resources().device_memory_pool().block_size(2 * MaxBytesInFlight);
+    options->resources().device_memory_pool().max_aggregate_bytes(8 * MaxBytesInFlight);
+
+    auto resources = std::make_unique<internal::resources::Manager>(
+        internal::system::SystemProvider(internal::system::make_system(std::move(options))));
+    if (resources->partition_count() < 2)
+    {
+        return std::nullopt;
+    }
+
+    auto f1 = resources->partition(0).network()->control_plane().client().connections().update_future();
+    auto f2 = resources->partition(1).network()->control_plane().client().connections().update_future();
+    resources->partition(0).network()->control_plane().client().request_update();
+    f1.get();
+    f2.get();
+
+    Loopback loopback;
+    loopback.receiver    = &resources->partition(0).network()->data_plane();
+    loopback.sender      = &resources->partition(1).network()->data_plane();
+    loopback.receiver_id = resources->partition(0).network()->instance_id();
+    loopback.sender_id   = resources->partition(1).network()->instance_id();
+    loopback.resources   = std::move(resources);
+    return loopback;
+}
+
+std::optional<mrc::memory::buffer> make_buffer(internal::resources::PartitionResources& partition,
+                                               Memory memory,
+                                               std::size_t bytes)
+{
+    if (memory == Device)
+    {
+        if (!partition.device())
+        {
+            return std::nullopt;
+        }
+        return partition.device()->make_buffer(bytes);
+    }
+    return partition.host().make_buffer(bytes);
+}
+
+void set_counters(benchmark::State& state, Memory memory, std::size_t bytes, std::size_t in_flight)
+{
+    state.SetBytesProcessed(state.iterations() * bytes * in_flight);
+    state.SetItemsProcessed(state.iterations() * in_flight);
+    state.SetLabel(memory == Device ? "device" : "host");
+}
+
+// tagged point-to-point sends of state.range(2) messages from partition 1 into recvs pre-posted on partition 0
+void mrc_data_plane_send_recv(benchmark::State& state)
+{
+    const auto bytes     = static_cast<std::size_t>(state.range(0));
+    const auto memory    = static_cast<Memory>(state.range(1));
+    const auto in_flight = static_cast<std::size_t>(state.range(2));
+
+    auto loopback = make_loopback();
+    if (!loopback)
+    {
+        state.SkipWithError("data plane benchmarks require 2 or more partitions");
+        return;
+    }
+
+    auto src = make_buffer(loopback->resources->partition(1), memory, bytes * in_flight);
+    auto dst = make_buffer(loopback->resources->partition(0), memory, bytes * in_flight);
+    if (!src || !dst)
+    {
+        state.SkipWithError("device memory benchmarks require a gpu per partition");
+        return;
+    }
+
+    loopback->resources->partition(1)
+        .runnable()
+        .main()
+        .enqueue([&] {
+            std::vector<internal::data_plane::Request> sends(in_flight);
+            std::vector<internal::data_plane::Request> recvs(in_flight);
+            auto* src_data = static_cast<std::byte*>(src->data());
+            auto* dst_data = static_cast<std::byte*>(dst->data());
+
+            for (auto _ : state)
+            {
+                for (std::size_t i = 0; i < in_flight; ++i)
+                {
+                    loopback->receiver->client().async_p2p_recv(dst_data + i * bytes, bytes, i, recvs[i]);
+                }
+                for (std::size_t i = 0; i < in_flight; ++i)
+                {
+                    loopback->sender->client().async_p2p_send(
+                        src_data + i * bytes, bytes, i, loopback->receiver_id, sends[i]);
+                }
+                for (std::size_t i = 0; i < in_flight; ++i)
+                {
+                    sends[i].await_complete();
+                    recvs[i].await_complete();
+                }
+            }
+        })
+        .get();
+
+    set_counters(state, memory, bytes, in_flight);
+}
+
+// round trip of a message from partition 1 to partition 0 and back; the time of an iteration is the latency
+void mrc_data_plane_ping_pong(benchmark::State& state)
+{
+    const auto bytes  = static_cast<std::size_t>(state.range(0));
+    const auto memory = static_cast<Memory>(state.range(1));
+
+    auto loopback = make_loopback();
+    if (!loopback)
+    {
+        state.SkipWithError("data plane benchmarks require 2 or more partitions");
+        return;
+    }
+
+    auto ping = make_buffer(loopback->resources->partition(1), memory, bytes);
+    auto pong = make_buffer(loopback->resources->partition(0), memory, bytes);
+    if (!ping || !pong)
+    {
+        state.SkipWithError("device memory benchmarks require a gpu per partition");
+        return;
+    }
+
+    loopback->resources->partition(1)
+        .runnable()
+        .main()
+        .enqueue([&] {
+            internal::data_plane::Request send;
+            internal::data_plane::Request recv;
+            internal::data_plane::Request echo_recv;
+            internal::data_plane::Request echo_send;
+
+            for (auto _ : state)
+            {
+                loopback->receiver->client().async_p2p_recv(pong->data(), bytes, 1, echo_recv);
+                loopback->sender->client().async_p2p_recv(ping->data(), bytes, 2, recv);
+                loopback->sender->client().async_p2p_send(ping->data(), bytes, 1, loopback->receiver_id, send);
+
+                // the echo is issued once the ping has arrived
+                echo_recv.await_complete();
+                loopback->receiver->client().async_p2p_send(pong->data(), bytes, 2, loopback->sender_id, echo_send);
+
+                recv.await_complete();
+                send.await_complete();
+                echo_send.await_complete();
+            }
+        })
+        .get();
+
+    set_counters(state, memory, bytes, 1);
+}
+
+// rdma gets by partition 1 of state.range(2) regions of a buffer registered by partition 0, as issued by the pulls of
+// remote descriptor payloads
+void mrc_data_plane_get(benchmark::State& state)
+{
+    const auto bytes     = static_cast<std::size_t>(state.range(0));
+    const auto memory    = static_cast<Memory>(state.range(1));
+    const auto in_flight = static_cast<std::size_t>(state.range(2));
+
+    auto loopback = make_loopback();
+    if (!loopback)
+    {
+        state.SkipWithError("data plane benchmarks require 2 or more partitions");
+        return;
+    }
+
+    auto src = make_buffer(loopback->resources->partition(0), memory, bytes * in_flight);
+    auto dst = make_buffer(loopback->resources->partition(1), memory, bytes * in_flight);
+    if (!src || !dst)
+    {
+        state.SkipWithError("device memory benchmarks require a gpu per partition");
+        return;
+    }
+
+    auto block = loopback->receiver->registration_cache().lookup(src->data());
+    if (!block)
+    {
+        state.SkipWithError("the source buffer is not registered with ucx");
+        return;
+    }
+    const auto src_keys = block->packed_remote_keys();
+
+    loopback->resources->partition(1)
+        .runnable()
+        .main()
+        .enqueue([&] {
+            std::vector<internal::data_plane::Request> gets(in_flight);
+            auto* src_data = static_cast<std::byte*>(src->data());
+            auto* dst_data = static_cast<std::byte*>(dst->data());
+
+            for (auto _ : state)
+            {
+                for (std::size_t i = 0; i < in_flight; ++i)
+                {
+                    loopback->sender->client().async_get(
+                        dst_data + i * bytes, bytes, loopback->receiver_id, src_data + i * bytes, src_keys, gets[i]);
+                }
+                for (auto& get : gets)
+                {
+                    get.await_complete();
+                }
+            }
+        })
+        .get();
+
+    set_counters(state, memory, bytes, in_flight);
+}
+
+// sizes from 8 bytes to MaxMessageBytes for both memory kinds, at every depth whose buffers fit into MaxBytesInFlight
+void data_plane_sweep_args(benchmark::internal::Benchmark* bench)
+{
+    for (std::int64_t bytes = 8; bytes <= MaxMessageBytes; bytes *= 8)
+    {
+        for (auto memory : {Host, Device})
+        {
+            for (std::int64_t in_flight : {1, 8, 64})
+            {
+                if (bytes * in_flight <= MaxBytesInFlight)
+                {
+                    bench->Args({bytes, memory, in_flight});
+                }
+            }
+        }
+    }
+    bench->ArgNames({"bytes", "memory", "in_flight"})->UseRealTime();
+}
+
+void ping_pong_args(benchmark::internal::Benchmark* bench)
+{
+    for (std::int64_t bytes = 8; bytes <= MaxMessageBytes; bytes *= 8)
+    {
+        for (auto memory : {Host, Device})
+        {
+            bench->Args({bytes, memory});
+        }
+    }
+    bench->ArgNames({"bytes", "memory"})->UseRealTime();
+}
+
+}  // namespace
+
+BENCHMARK(mrc_data_plane_send_recv)->Apply(data_plane_sweep_args);
+BENCHMARK(mrc_data_plane_ping_pong)->Apply(ping_pong_args);
+BENCHMARK(mrc_data_plane_get)->Apply(data_plane_sweep_args);
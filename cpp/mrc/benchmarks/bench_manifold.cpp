@@ -0,0 +1,125 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2021-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "mrc/core/executor.hpp"
+#include "mrc/engine/pipeline/ipipeline.hpp"
+#include "mrc/node/rx_sink.hpp"
+#include "mrc/node/rx_source.hpp"
+#include "mrc/pipeline/pipeline.hpp"
+#include "mrc/segment/builder.hpp"
+#include "mrc/segment/definition.hpp"
+#include "mrc/segment/egress_ports.hpp"
+#include "mrc/segment/ingress_ports.hpp"
+#include "mrc/segment/object.hpp"  // IWYU pragma: keep
+
+#include <benchmark/benchmark.h>
+#include <rxcpp/rx.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <utility>
+
+using namespace mrc;
+
+/**
+ * Macro benchmarks of the segment-to-segment data path: every message crosses state.range(0) manifolds, each
+ * connecting the egress port of one segment to the ingress port of the next. Pipeline construction is excluded from
+ * the timing; the timed region covers the start of the segments, the flow of all messages and the shutdown.
+ */
+
+namespace {
+
+constexpr std::size_t MessageCount = 100'000;
+
+std::string port_name(std::size_t hop)
+{
+    return "port_" + std::to_string(hop);
+}
+
+// source segment -> (manifolds - 1) pass-thru segments -> sink segment
+std::unique_ptr<pipeline::Pipeline> make_manifold_chain(std::size_t manifolds, std::atomic<std::size_t>& received)
+{
+    auto pipeline = pipeline::make_pipeline();
+
+    pipeline->register_segment(
+        segment::Definition::create("src", segment::EgressPorts<std::size_t>({port_name(0)}), [](segment::Builder& s) {
+            auto src = s.make_source<std::size_t>("source", [](rxcpp::subscriber<std::size_t> sub) {
+                for (std::size_t i = 0; i < MessageCount && sub.is_subscribed(); i++)
+                {
+                    sub.on_next(i);
+                }
+                sub.on_completed();
+            });
+            s.make_edge(src, s.get_egress<std::size_t>(port_name(0)));
+        }));
+
+    for (std::size_t hop = 1; hop < manifolds; hop++)
+    {
+        pipeline->register_segment(
+            segment::Definition::create("hop_" + std::to_string(hop),
+                                        segment::IngressPorts<std::size_t>({port_name(hop - 1)}),
+                                        segment::EgressPorts<std::size_t>({port_name(hop)}),
+                                        [hop](segment::Builder& s) {
+                                            // pure pass-thru
+                                            s.make_edge(s.get_ingress<std::size_t>(port_name(hop - 1)),
+                                                        s.get_egress<std::size_t>(port_name(hop)));
+                                        }));
+    }
+
+    pipeline->register_segment(segment::Definition::create(
+        "sink",
+        segment::IngressPorts<std::size_t>({port_name(manifolds - 1)}),
+        [manifolds, &received](segment::Builder& s) {
+            auto sink = s.make_sink<std::size_t>(
+                "sink", rxcpp::make_observer_dynamic<std::size_t>([&received](std::size_t) { received++; }));
+            s.make_edge(s.get_ingress<std::size_t>(port_name(manifolds - 1)), sink);
+        }));
+
+    return pipeline;
+}
+
+}  // namespace
+
+static void mrc_multi_segment_manifold_throughput(benchmark::State& state)
+{
+    const auto manifolds = static_cast<std::size_t>(state.range(0));
+    std::atomic<std::size_t> received{0};
+
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        received = 0;
+        Executor executor;
+        executor.register_pipeline(make_manifold_chain(manifolds, received));
+        state.ResumeTiming();
+
+        executor.start();
+        executor.join();
+
+        if (received != MessageCount)
+        {
+            state.SkipWithError("messages were lost crossing the manifolds");
+            break;
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * MessageCount);
+    state.counters["manifolds"] = manifolds;
+}
+
+BENCHMARK(mrc_multi_segment_manifold_throughput)->Arg(1)->Arg(2)->Arg(4)->Unit(benchmark::kMillisecond)->UseRealTime();
@@ -16,14 +16,26 @@
  */
 
 #include "mrc/channel/status.hpp"
+#include "mrc/data/cached_reusable_pool.hpp"
 #include "mrc/data/reusable_pool.hpp"
+#include "mrc/runnable/context.hpp"
+#include "mrc/runnable/engine.hpp"
+#include "mrc/runnable/launch_options.hpp"
+#include "mrc/runnable/runnable.hpp"
+#include "mrc/runnable/runner.hpp"
+#include "mrc/runnable/types.hpp"
+#include "mrc/types.hpp"
 #include "mrc/utils/macros.hpp"
 
 #include <benchmark/benchmark.h>
+#include <boost/fiber/future/async.hpp>
 
 #include <array>
 #include <cstddef>
+#include <functional>
 #include <memory>
+#include <utility>
+#include <vector>
 
 using namespace mrc;
 
@@ -53,6 +65,63 @@ class Buffer
   private:
     std::array<float, 1024> m_buffer;
 };
+
+// launches each task as a fiber on the calling thread
+class PostEngine final : public runnable::Engine
+{
+  public:
+    runnable::EngineType engine_type() const final
+    {
+        return runnable::EngineType::Fiber;
+    }
+
+  private:
+    Future<void> launch_task(std::function<void()> task) final
+    {
+        return boost::fibers::async(boost::fibers::launch::post, std::move(task));
+    }
+};
+
+class PostEngines final : public runnable::Engines
+{
+  public:
+    PostEngines(std::size_t size) : m_launch_options("post", size)
+    {
+        for (std::size_t i = 0; i < size; ++i)
+        {
+            m_launchers.push_back(std::make_shared<PostEngine>());
+        }
+    }
+
+    const std::vector<std::shared_ptr<runnable::Engine>>& launchers() const final
+    {
+        return m_launchers;
+    }
+
+    const runnable::LaunchOptions& launch_options() const final
+    {
+        return m_launch_options;
+    }
+
+    runnable::EngineType engine_type() const final
+    {
+        return runnable::EngineType::Fiber;
+    }
+
+    std::size_t size() const final
+    {
+        return m_launchers.size();
+    }
+
+  private:
+    std::vector<std::shared_ptr<runnable::Engine>> m_launchers;
+    runnable::LaunchOptions m_launch_options;
+};
+
+class NoopRunnable final : public runnable::RunnableWithContext<>
+{
+    void run(ContextType& ctx) final {}
+};
 }  // namespace
 
 static void mrc_data_reusable(benchmark::State& state)
@@ -68,4 +137,37 @@ static void mrc_data_reusable(benchmark::State& state)
     }
 }
 
+static void mrc_data_cached_reusable(benchmark::State& state)
+{
+    auto pool = data::CachedReusablePool<Buffer>::create(32);
+    pool->add_item(std::make_unique<Buffer>());
+    pool->add_item(std::make_unique<Buffer>());
+
+    for (auto _ : state)
+    {
+        auto buffer = pool->await_item();
+        benchmark::DoNotOptimize(buffer->data()[0] += 1.0);
+    }
+}
+
 BENCHMARK(mrc_data_reusable);
+BENCHMARK(mrc_data_cached_reusable);
+
+// startup and teardown cost of a runner with state.range(0) instances
+static void mrc_runner_launch_and_join(benchmark::State& state)
+{
+    const auto instances = static_cast<std::size_t>(state.range(0));
+
+    for (auto _ : state)
+    {
+        auto engines = std::make_shared<PostEngines>(instances);
+        auto runner  = runnable::make_runner(std::make_unique<NoopRunnable>());
+        runner->enqueue(engines);
+        runner->await_live();
+        runner->await_join();
+    }
+
+    state.SetItemsProcessed(state.iterations() * instances);
+}
+
+BENCHMARK(mrc_runner_launch_and_join)->RangeMultiplier(8)->Range(1, 4096);
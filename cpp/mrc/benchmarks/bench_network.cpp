@@ -0,0 +1,188 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2021-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "internal/control_plane/client.hpp"
+#include "internal/control_plane/client/connections_manager.hpp"
+#include "internal/control_plane/server.hpp"
+#include "internal/network/resources.hpp"
+#include "internal/remote_descriptor/manager.hpp"
+#include "internal/resources/manager.hpp"
+#include "internal/resources/partition_resources.hpp"
+#include "internal/runnable/resources.hpp"
+#include "internal/runtime/partition.hpp"
+#include "internal/runtime/runtime.hpp"
+#include "internal/system/system.hpp"
+#include "internal/system/system_provider.hpp"
+
+#include "mrc/channel/status.hpp"
+#include "mrc/channel/types.hpp"
+#include "mrc/codable/fundamental_types.hpp"  // IWYU pragma: keep
+#include "mrc/core/task_queue.hpp"
+#include "mrc/node/sink_channel.hpp"
+#include "mrc/options/options.hpp"
+#include "mrc/options/placement.hpp"
+#include "mrc/pubsub/publisher.hpp"
+#include "mrc/pubsub/publisher_policy.hpp"
+#include "mrc/pubsub/subscriber.hpp"
+#include "mrc/runtime/remote_descriptor.hpp"
+
+#include <benchmark/benchmark.h>
+#include <boost/fiber/future/future.hpp>
+#include <boost/fiber/operations.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <string>
+#include <thread>
+#include <utility>
+
+using namespace mrc;
+
+/**
+ * Macro benchmarks of the network paths over UCX loopback: remote descriptor round trips between the partitions of a
+ * single runtime and publish/subscribe between two runtimes connected through a local control plane server. The remote
+ * descriptor benchmark requires a machine exposing at least two partitions, i.e. a multi-gpu host, and is skipped
+ * otherwise.
+ */
+
+namespace {
+
+std::unique_ptr<internal::runtime::Runtime> make_runtime(std::function<void(Options&)> updater = nullptr)
+{
+    auto options = std::make_shared<Options>();
+    options->placement().resources_strategy(PlacementResources::Dedicated);
+    if (updater)
+    {
+        updater(*options);
+    }
+
+    auto resources = std::make_unique<internal::resources::Manager>(
+        internal::system::SystemProvider(internal::system::make_system(std::move(options))));
+    return std::make_unique<internal::runtime::Runtime>(std::move(resources));
+}
+
+}  // namespace
+
+// register an object of state.range(0) bytes on partition 0, decode it on partition 1 and wait for the release of the
+// remote descriptor to reach the owning partition
+static void mrc_remote_descriptor_round_trip(benchmark::State& state)
+{
+    auto runtime = make_runtime([](Options& options) {
+        options.enable_server(true);
+        options.architect_url("localhost:13337");
+    });
+    if (runtime->partition_count() < 2)
+    {
+        state.SkipWithError("remote descriptor round trips require 2 or more partitions");
+        return;
+    }
+
+    auto f1 = runtime->partition(0).resources().network()->control_plane().client().connections().update_future();
+    runtime->partition(0).resources().network()->control_plane().client().request_update();
+    f1.get();
+
+    const auto bytes = static_cast<std::size_t>(state.range(0));
+
+    runtime->partition(0)
+        .resources()
+        .runnable()
+        .main()
+        .enqueue([&] {
+            auto& rd_manager_0 = runtime->partition(0).remote_descriptor_manager();
+            auto& rd_manager_1 = runtime->partition(1).remote_descriptor_manager();
+
+            for (auto _ : state)
+            {
+                auto rd     = rd_manager_0.register_object(std::string(bytes, 'x'));
+                auto handle = internal::remote_descriptor::Manager::unwrap_handle(std::move(rd));
+                auto rd_1   = rd_manager_1.make_remote_descriptor(std::move(handle));
+                benchmark::DoNotOptimize(rd_1.decode<std::string>());
+                rd_1.release_ownership();
+
+                while (rd_manager_0.size() != 0)
+                {
+                    boost::this_fiber::yield();
+                }
+            }
+        })
+        .get();
+
+    state.SetBytesProcessed(state.iterations() * bytes);
+}
+
+// one-way latency of a round-robin publish of an int from one runtime to a subscriber of a second runtime
+static void mrc_pubsub_round_robin_latency(benchmark::State& state)
+{
+    auto server_runtime = make_runtime();
+    auto server =
+        std::make_unique<internal::control_plane::Server>(server_runtime->partition(0).resources().runnable());
+    server->service_start();
+    server->service_await_live();
+
+    auto client_1 = make_runtime([](Options& options) { options.architect_url("localhost:13337"); });
+    auto client_2 = make_runtime([](Options& options) { options.architect_url("localhost:13337"); });
+
+    {
+        auto& client = client_1->partition(0).resources().network()->control_plane().client();
+
+        auto publisher =
+            pubsub::Publisher<int>::create("bench_int", pubsub::PublisherPolicy::RoundRobin, client_1->partition(0));
+        auto subscriber = pubsub::Subscriber<int>::create("bench_int", client_2->partition(0));
+
+        node::SinkChannelReadable<int> reader;
+        node::make_edge(*subscriber, reader);
+        auto& egress = reader.egress();
+
+        publisher->await_start();
+        subscriber->await_start();
+
+        // the subscriber becomes visible to the publisher with a later control plane update; messages written before
+        // then are not delivered, so the first message is retried until one arrives and the duplicates are drained
+        int value = 0;
+        do
+        {
+            client.request_update();
+            publisher->await_write(0);
+        } while (egress.await_read_until(value, channel::clock_t::now() + std::chrono::milliseconds(100)) !=
+                 channel::Status::success);
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        while (egress.try_read(value) == channel::Status::success) {}
+
+        for (auto _ : state)
+        {
+            publisher->await_write(1);
+            egress.await_read(value);
+        }
+
+        state.SetItemsProcessed(state.iterations());
+
+        subscriber->request_stop();
+        subscriber->await_join();
+        publisher->request_stop();
+        publisher->await_join();
+    }
+
+    client_1.reset();
+    client_2.reset();
+
+    server->service_stop();
+    server->service_await_join();
+}
+
+BENCHMARK(mrc_remote_descriptor_round_trip)->RangeMultiplier(64)->Range(64, 1 << 24)->UseRealTime();
+BENCHMARK(mrc_pubsub_round_robin_latency)->UseRealTime();
@@ -18,6 +18,8 @@
 #include "mrc/benchmarking/segment_watcher.hpp"
 #include "mrc/benchmarking/tracer.hpp"
 #include "mrc/benchmarking/util.hpp"
+#include "mrc/channel/buffered_channel.hpp"
+#include "mrc/channel/status.hpp"
 #include "mrc/core/executor.hpp"
 #include "mrc/engine/pipeline/ipipeline.hpp"
 #include "mrc/node/rx_node.hpp"
@@ -28,6 +30,7 @@
 #include "mrc/segment/object.hpp"   // IWYU pragma: keep
 
 #include <benchmark/benchmark.h>
+#include <boost/fiber/future/async.hpp>
 #include <nlohmann/json.hpp>
 #include <rxcpp/rx.hpp>
 
@@ -172,8 +175,10 @@ class ManualRxcppFixture : public benchmark::Fixture
  * network.
  * @tparam OneAtATimeV Indicates whether or not tracers should be sent through the segment one at a time. This can be
  * used to test the maximum raw throughput of each component.
+ * @tparam DirectV Indicates whether the intermediate stage is a node component called directly by the source rather
+ * than a runnable node connected by channels.
  */
-template <class TracerTypeT, bool OneAtATimeV>
+template <class TracerTypeT, bool OneAtATimeV, bool DirectV = false>
 class SimpleEmitReceiveFixture : public benchmark::Fixture
 {
   public:
@@ -191,12 +196,21 @@ class SimpleEmitReceiveFixture : public benchmark::Fixture
             auto src = segment.make_source<data_type_t>(
                 src_name, m_watcher->template create_rx_tracer_source<OneAtATimeV>(src_name));
 
-            auto internal_idx = m_watcher->get_or_create_node_entry(int_name);
-            auto internal     = segment.make_node<data_type_t, data_type_t>(
-                int_name,
-                m_watcher->create_tracer_receive_tap(int_name),
-                rxcpp::operators::map([](data_type_t tracer) { return tracer; }),
-                m_watcher->create_tracer_emit_tap(int_name));
+            auto internal_idx  = m_watcher->get_or_create_node_entry(int_name);
+            auto make_internal = [&](auto&&... ops) {
+                if constexpr (DirectV)
+                {
+                    return segment.make_node_component<data_type_t, data_type_t>(int_name, ops...);
+                }
+                else
+                {
+                    return segment.make_node<data_type_t, data_type_t>(int_name, ops...);
+                }
+            };
+
+            auto internal = make_internal(m_watcher->create_tracer_receive_tap(int_name),
+                                          rxcpp::operators::map([](data_type_t tracer) { return tracer; }),
+                                          m_watcher->create_tracer_emit_tap(int_name));
             segment.make_edge(src, internal);
 
             auto sink_idx = m_watcher->get_or_create_node_entry(sink_name);
@@ -300,6 +314,9 @@ class SegmentComponentRawLatency : public SimpleEmitReceiveFixture<latency_trace
 class SegmentComponentLatency : public SimpleEmitReceiveFixture<latency_tracer_t, false>
 {};
 
+class SegmentDirectComponentRawLatency : public SimpleEmitReceiveFixture<latency_tracer_t, true, true>
+{};
+
 /** Throughput **/
 using throughput_tracer_t = TracerEnsemble<std::size_t, ThroughputTracer>;
 class SegmentRawThroughput : public SimpleEmitReceiveFixture<throughput_tracer_t, true>
@@ -353,6 +370,18 @@ BENCHMARK_F(SegmentComponentLatency, component_latency)(benchmark::State& state)
     add_state_counters(m_watcher->aggregate_tracers(), state);
 }
 
+// NOLINTNEXTLINE
+BENCHMARK_F(SegmentDirectComponentRawLatency, component_latency_direct_raw)(benchmark::State& state)
+{
+    m_watcher->tracer_count(1e3);
+    for (auto _ : state)
+    {
+        m_watcher->reset();
+        m_watcher->trace_until_notified();
+    }
+    add_state_counters(m_watcher->aggregate_tracers(), state);
+}
+
 // NOLINTNEXTLINE
 BENCHMARK_F(SegmentRawThroughput, component_throughput_raw)(benchmark::State& state)
 {
@@ -400,3 +429,48 @@ BENCHMARK_F(SegmentLongComponentRawLatency, long_pipeline_component_latency)(ben
     }
     add_state_counters(m_watcher->aggregate_tracers(), state);
 }
+
+/**
+ * @brief Batch-size sweep over the batched channel api; a producer fiber writes shared_ptr payloads in batches of
+ * state.range(0) while the calling fiber drains with await_read_n. A batch size of 1 matches the per-element cost of
+ * await_write/await_read.
+ */
+static void channel_batched_throughput(benchmark::State& state)
+{
+    using data_t                          = std::shared_ptr<std::size_t>;
+    static constexpr std::size_t Elements = 1 << 16;
+    const auto batch_size                 = static_cast<std::size_t>(state.range(0));
+
+    for (auto _ : state)
+    {
+        channel::BufferedChannel<data_t> channel(channel::default_channel_size());
+
+        auto producer = boost::fibers::async([&] {
+            std::vector<data_t> batch(batch_size);
+            for (std::size_t i = 0; i < Elements; i += batch_size)
+            {
+                for (auto& item : batch)
+                {
+                    item = std::make_shared<std::size_t>(i);
+                }
+                channel.await_write_n(batch);
+            }
+            channel.close_channel();
+        });
+
+        std::vector<data_t> output;
+        output.reserve(batch_size);
+        std::size_t count = 0;
+        while (channel.await_read_n(output, batch_size) == channel::Status::success)
+        {
+            count += output.size();
+            output.clear();
+        }
+        producer.get();
+        benchmark::DoNotOptimize(count);
+    }
+
+    state.SetItemsProcessed(state.iterations() * Elements);
+}
+
+BENCHMARK(channel_batched_throughput)->RangeMultiplier(2)->Range(1, 128);
@@ -0,0 +1,126 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "mrc/arrow/c_data_interface.hpp"
+#include "mrc/memory/buffer_view.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace mrc::arrow {
+
+/**
+ * @brief An array of a batch and its children as described by the Arrow columnar format, with views of its buffers
+ *
+ * The views are sized from the format, length and offset of the array, e.g. the values of a utf8 array span up to its
+ * last offset. Absent buffers, such as the validity bitmap of an array without nulls, have a null data pointer.
+ */
+struct ArrowArrayLayout
+{
+    std::string format;
+    std::string name;
+    // metadata in the binary encoding of the C data interface; empty if the array has none
+    std::string metadata;
+    std::int64_t flags{0};
+    std::int64_t length{0};
+    std::int64_t null_count{0};
+    std::int64_t offset{0};
+    std::vector<memory::const_buffer_view> buffers;
+    std::vector<ArrowArrayLayout> children;
+};
+
+/**
+ * @brief Record batch of Arrow columns, the type dataframes travel as between nodes and across the data plane
+ *
+ * Batches are exchanged with other Arrow implementations through the C data interface without copying the columns:
+ * pyarrow and libcudf export them with `_export_to_c` / `to_arrow`, and export_to_c hands a batch back. A batch is an
+ * immutable, shared reference, so copies are cheap and all refer to the same columns, which are released with the last
+ * copy.
+ *
+ * When encoded, every column buffer is a descriptor of its own which large buffers describe in place, so receivers pull
+ * the columns straight into memory of their pools rather than unpacking a serialized blob. Dictionary encoded, union,
+ * run-end encoded and view columns are not supported and throw exceptions::MrcRuntimeError.
+ */
+class ArrowBatch
+{
+  public:
+    ArrowBatch() = default;
+
+    /**
+     * @brief Takes ownership of a struct array exported through the C data interface, e.g. by
+     * `pyarrow.RecordBatch._export_to_c`; schema and array are moved from and left released
+     *
+     * The schema of a record batch is a struct (format "+s") whose children are the columns.
+     */
+    static ArrowBatch import_from_c(ArrowSchema* schema, ArrowArray* array);
+
+    /**
+     * @brief Batch of the arrays of layout; owner keeps the memory of the buffers alive for as long as the batch exists
+     */
+    static ArrowBatch from_layout(const ArrowArrayLayout& layout, std::shared_ptr<const void> owner);
+
+    /**
+     * @brief Exports the batch through the C data interface into uninitialized structs, e.g. for
+     * `pyarrow.RecordBatch._import_from_c`
+     *
+     * The exported structs reference the columns of the batch, which stay alive until the consumer releases them.
+     */
+    void export_to_c(ArrowSchema* schema, ArrowArray* array) const;
+
+    // false for a default constructed batch
+    explicit operator bool() const;
+
+    std::int64_t num_rows() const;
+
+    std::int64_t num_columns() const;
+
+    std::vector<std::string> column_names() const;
+
+    const ArrowSchema& schema() const;
+
+    const ArrowArray& array() const;
+
+    // the struct array of the batch with its columns as children
+    ArrowArrayLayout layout() const;
+
+    // buffers of the batch in depth first order of its arrays, excluding absent buffers
+    std::vector<memory::const_buffer_view> buffers() const;
+
+    // total bytes of buffers()
+    std::size_t nbytes() const;
+
+  private:
+    struct State;
+
+    explicit ArrowBatch(std::shared_ptr<const State> state);
+
+    std::shared_ptr<const State> m_state;
+};
+
+/**
+ * @brief Layout of array, whose schema is schema
+ *
+ * @throws exceptions::MrcRuntimeError if the format is not supported or the array does not match it
+ */
+ArrowArrayLayout make_layout(const ArrowSchema& schema, const ArrowArray& array);
+
+}  // namespace mrc::arrow
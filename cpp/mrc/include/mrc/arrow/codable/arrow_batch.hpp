@@ -0,0 +1,50 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "mrc/arrow/arrow_batch.hpp"
+#include "mrc/codable/codable_protocol.hpp"
+
+#include <cstddef>
+
+// IWYU pragma: no_forward_declare mrc::codable::codable_protocol
+
+namespace mrc::codable {
+class EncodingOptions;
+template <typename T>
+class Encoder;
+template <typename T>
+class Decoder;
+
+/**
+ * A batch is encoded as an eager descriptor holding the schema and the lengths of its arrays, followed by a descriptor
+ * per non-empty column buffer in depth first order. Buffers above the eager threshold are described in place, so they
+ * are pulled by receivers without being copied on the sending side; the batch must outlive its encoding. Decoded
+ * buffers are allocated from the host memory resource of the decoder.
+ */
+template <>
+struct codable_protocol<mrc::arrow::ArrowBatch>
+{
+    static void serialize(const arrow::ArrowBatch& obj,
+                          Encoder<arrow::ArrowBatch>& encoded,
+                          const EncodingOptions& opts);
+
+    static arrow::ArrowBatch deserialize(const Decoder<arrow::ArrowBatch>& encoded, std::size_t object_idx);
+};
+
+}  // namespace mrc::codable
@@ -0,0 +1,149 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "mrc/benchmarking/live_sampler.hpp"
+#include "mrc/benchmarking/tuning_profile.hpp"
+#include "mrc/utils/macros.hpp"
+
+#include <chrono>
+#include <cstddef>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <string>
+
+namespace mrc::benchmarking {
+
+struct AutoTunerOptions
+{
+    // end to end latency the pipeline must stay within; bounds the channel sizes, as queued elements add to latency
+    std::chrono::milliseconds latency_target{100};
+    // utilization the engine counts of the nodes aim for
+    double target_utilization{0.7};
+    std::size_t max_pe_count{8};
+    std::size_t max_engines_per_pe{4};
+    // channel sizes are powers of two within these bounds
+    std::size_t min_channel_size{16};
+    std::size_t max_channel_size{4096};
+    // leading samples of a round which are ignored while the pipeline ramps up
+    std::size_t warm_up_samples{1};
+};
+
+/**
+ * @brief Measurements of one tuning round; rates are per second.
+ *
+ * throughput is the rate at which the sinks of the pipeline, i.e. the nodes which did not emit, received elements.
+ * latency_seconds estimates the end to end latency as the sum over the nodes of their service time and of the time
+ * elements queue in their input channel, the latter from the mean occupancy of the channel by Little's law.
+ */
+struct TuningRound
+{
+    TuningProfile profile;
+    std::size_t samples{0};
+    double throughput{0.0};
+    double latency_seconds{0.0};
+    bool meets_latency_target{false};
+};
+
+/**
+ * @brief Searches for the engine counts and channel sizes of the nodes of a pipeline maximizing its throughput within
+ * a latency target while the pipeline runs on live or replayed input.
+ *
+ * Tuning proceeds in rounds, each running the pipeline built with the profile of the round, see
+ * segment::Builder::apply_tuning, while a LiveSampler passes its samples to observe. next_round scores the round and
+ * derives the profile of the next one from the measurements: saturated nodes are given the engines to bring their
+ * utilization to the target, as recommended by analyze_bottlenecks, beyond max_pe_count as more engines per pe; input
+ * channels are sized to the elements which arrive within the latency budget of the node. The best round meeting the
+ * latency target is kept and persisted with TuningProfile::save, to launch the deployment with.
+ *
+ * Node and queue names must match, as for analyze_bottlenecks: the input channel of a node is watched by the
+ * LiveSampler under the name of the node.
+ */
+class AutoTuner
+{
+  public:
+    AutoTuner(AutoTunerOptions options = {}, TuningProfile initial = {});
+
+    DELETE_COPYABILITY(AutoTuner);
+    DELETE_MOVEABILITY(AutoTuner);
+
+    /**
+     * @brief Account a sample to the current round; may be used as the callback of a LiveSampler
+     */
+    void observe(const LiveSample& sample);
+
+    // profile the pipeline of the current round is built with
+    TuningProfile profile() const;
+
+    /**
+     * @brief Score the current round and start the next one; returns the profile the pipeline is rebuilt with
+     */
+    TuningProfile next_round();
+
+    // true once a round recommended the profile it was run with, i.e. further rounds would not change the pipeline
+    bool converged() const;
+
+    // best round meeting the latency target, or the round closest to meeting it if none did
+    std::optional<TuningRound> best() const;
+
+  private:
+    struct NodeTotals
+    {
+        std::size_t received{0};
+        std::size_t emitted{0};
+        double read_wait_ns{0.0};
+        double write_wait_ns{0.0};
+        // operator time summed over the emitted elements
+        double latency_ns{0.0};
+    };
+
+    struct QueueTotals
+    {
+        std::size_t capacity{0};
+        // occupancy integrated over the round
+        double occupancy_seconds{0.0};
+    };
+
+    // the samples of the current round as a single sample over the round
+    LiveSample round_sample() const;
+
+    TuningRound score_round(const LiveSample& sample) const;
+    TuningProfile recommend(const LiveSample& sample) const;
+
+    NodeTuning tuning_of(const std::string& name) const;
+
+    // latency an element spends in the input channel of node, from the mean occupancy of the channel
+    double queueing_seconds(const LiveNodeSample& node) const;
+
+    const AutoTunerOptions m_options;
+
+    mutable std::mutex m_mutex;
+    TuningProfile m_profile;
+    bool m_converged{false};
+    std::optional<TuningRound> m_best;
+
+    // totals of the samples of the current round
+    std::size_t m_samples{0};
+    std::size_t m_skipped{0};
+    double m_interval_seconds{0.0};
+    std::map<std::string, NodeTotals> m_nodes;
+    std::map<std::string, QueueTotals> m_queues;
+};
+
+}  // namespace mrc::benchmarking
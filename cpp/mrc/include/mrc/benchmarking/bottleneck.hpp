@@ -0,0 +1,105 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include "mrc/benchmarking/live_sampler.hpp"
+
+#include <nlohmann/json_fwd.hpp>
+
+#include <cstddef>
+#include <map>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace mrc::benchmarking {
+
+enum class NodeState
+{
+    // the node is busy most of the interval while its input backs up: it limits the throughput of the pipeline
+    Saturated,
+    // the node mostly waits on writes; its downstream limits it
+    Backpressured,
+    // the node mostly waits on reads; its upstream limits it
+    Starved,
+    Balanced,
+};
+
+const char* node_state_name(NodeState state);
+
+struct BottleneckOptions
+{
+    // utilization from which a node is saturated
+    double saturation_threshold{0.8};
+    // fill of the input channel from which a node which is not backpressured is saturated
+    double input_fill_threshold{0.9};
+    // fraction of the interval spent waiting from which a node is starved or backpressured
+    double wait_threshold{0.5};
+    // utilization the recommended pe counts aim for
+    double target_utilization{0.7};
+    // pe counts of the nodes by name; nodes without an entry are assumed to run on a single pe
+    std::map<std::string, std::size_t> pe_counts;
+};
+
+/**
+ * @brief Diagnosis of one node over the interval of a LiveSample.
+ *
+ * The wait fractions are the read and write wait times of the node normalized by the interval and its pe count;
+ * utilization is the remaining fraction of the interval, spent in the operator. input_fill is the occupancy of the
+ * input channel relative to its capacity when a queue with the name of the node is watched.
+ */
+struct NodeDiagnosis
+{
+    std::string name;
+    NodeState state{NodeState::Balanced};
+    double utilization{0.0};
+    double read_wait_fraction{0.0};
+    double write_wait_fraction{0.0};
+    std::optional<double> input_fill;
+    std::size_t pe_count{1};
+    std::size_t recommended_pe_count{1};
+};
+
+struct BottleneckReport
+{
+    std::size_t sequence{0};
+    double interval_seconds{0.0};
+
+    // nodes by decreasing utilization, i.e. the critical path of the pipeline first
+    std::vector<NodeDiagnosis> nodes;
+
+    // most utilized saturated node, if any
+    std::optional<std::string> critical_node;
+
+    nlohmann::json to_json() const;
+
+    /**
+     * @brief One line per node which is not balanced, for logs
+     */
+    std::string summary() const;
+};
+
+/**
+ * @brief Identify the saturated, backpressured and starved nodes of a live sample and recommend pe counts.
+ *
+ * Saturated nodes are recommended enough pes to bring their utilization down to the target, starved nodes are
+ * recommended fewer pes down to a single one; the others keep their pe count since scaling them does not relieve the
+ * pipeline. Nodes without activity over the interval are reported as balanced.
+ */
+BottleneckReport analyze_bottlenecks(const LiveSample& sample, const BottleneckOptions& options = {});
+
+}  // namespace mrc::benchmarking
@@ -0,0 +1,212 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace mrc::metrics {
+class Registry;
+}
+
+namespace mrc::benchmarking {
+
+/**
+ * @brief Aggregated scheduling statistics of the fibers sharing a name, or of a single fiber.
+ *
+ * - running: time the fiber was executing on a thread
+ * - ready: time the fiber was runnable but waiting in a scheduler ready queue
+ * - blocked: time the fiber was suspended waiting on a mutex, channel, future, timer, etc.
+ * - cpu: cpu time consumed by the thread while running the fiber; less than running when the thread was preempted
+ * - channel_wait: part of the fiber's time spent waiting on an empty or full mrc channel
+ */
+struct FiberStatistics
+{
+    std::string name;
+    std::uint64_t fiber_count{0};
+    std::uint64_t context_switches{0};
+    std::chrono::nanoseconds running{0};
+    std::chrono::nanoseconds ready{0};
+    std::chrono::nanoseconds blocked{0};
+    std::chrono::nanoseconds cpu{0};
+    std::chrono::nanoseconds channel_wait{0};
+};
+
+/**
+ * @brief Collects per-fiber running/ready/blocked time from the tracing fiber scheduler.
+ *
+ * Tracing is enabled with FiberPoolOptions::enable_tracing_scheduler. Fibers are grouped by the name of the runnable
+ * they execute; fibers which never call name_current_fiber are grouped as "unnamed". Results are available as
+ * aggregated statistics, as metrics::Registry counters and as a Chrome trace event file which can be loaded by
+ * chrome://tracing or https://ui.perfetto.dev.
+ */
+class FiberTracer
+{
+  public:
+    using clock_t = std::chrono::steady_clock;
+
+    enum class State : std::uint8_t
+    {
+        Created,
+        Ready,
+        Running,
+        Blocked,
+    };
+
+    // live, lock-free totals of all fibers sharing a name; instances are never destroyed
+    struct NameStatistics
+    {
+        const std::string name;
+        std::atomic<std::uint64_t> fiber_count{0};
+        std::atomic<std::uint64_t> context_switches{0};
+        std::atomic<std::int64_t> running_ns{0};
+        std::atomic<std::int64_t> ready_ns{0};
+        std::atomic<std::int64_t> blocked_ns{0};
+        std::atomic<std::int64_t> cpu_ns{0};
+        std::atomic<std::int64_t> channel_wait_ns{0};
+
+        // values reported by the last call to export_metrics
+        std::int64_t exported_running_ns{0};
+        std::int64_t exported_ready_ns{0};
+        std::int64_t exported_blocked_ns{0};
+        std::int64_t exported_cpu_ns{0};
+        std::int64_t exported_channel_wait_ns{0};
+        std::uint64_t exported_context_switches{0};
+    };
+
+    struct Slice
+    {
+        const NameStatistics* name;
+        std::uint64_t fiber_id;
+        clock_t::time_point start;
+        clock_t::time_point end;
+    };
+
+    // per-thread buffer of running slices; owned jointly by the tracer and the scheduler of the thread
+    struct ThreadBuffer
+    {
+        std::uint32_t thread_index;
+        std::mutex mutex;
+        std::vector<Slice> slices;
+        std::uint64_t dropped{0};
+    };
+
+    /**
+     * @brief Per-fiber tracing state, embedded in the fiber properties of the tracing scheduler.
+     */
+    class FiberState
+    {
+      public:
+        ~FiberState();
+
+        // scheduler hooks, called on the thread currently owning the fiber; thread_cpu is the thread_cpu_time() of
+        // the switch
+        void on_ready(clock_t::time_point now);
+        void on_running(clock_t::time_point now, std::chrono::nanoseconds thread_cpu);
+        void on_stopped(clock_t::time_point now, std::chrono::nanoseconds thread_cpu, ThreadBuffer& buffer);
+
+        void add_channel_wait(std::chrono::nanoseconds duration);
+
+        void set_name(const std::string& name);
+
+        FiberStatistics statistics() const;
+
+      private:
+        void accumulate(clock_t::time_point now);
+
+        NameStatistics* m_name{nullptr};
+        std::uint64_t m_fiber_id{0};
+        State m_state{State::Created};
+        clock_t::time_point m_last{};
+        clock_t::time_point m_running_since{};
+        std::chrono::nanoseconds m_cpu_since{0};
+        std::uint64_t m_context_switches{0};
+        std::chrono::nanoseconds m_running{0};
+        std::chrono::nanoseconds m_ready{0};
+        std::chrono::nanoseconds m_blocked{0};
+        std::chrono::nanoseconds m_cpu{0};
+        std::chrono::nanoseconds m_channel_wait{0};
+    };
+
+    /**
+     * @brief Name the fiber currently running on this thread; the name is used to group statistics and label slices.
+     * No-op if the calling thread is not running the tracing scheduler.
+     */
+    static void name_current_fiber(const std::string& name);
+
+    /**
+     * @brief Attribute time spent waiting on a channel to the fiber currently running on this thread. No-op if the
+     * calling thread is not running the tracing scheduler.
+     */
+    static void record_channel_wait(std::chrono::nanoseconds duration);
+
+    /**
+     * @brief Cpu time consumed by the calling thread
+     */
+    static std::chrono::nanoseconds thread_cpu_time();
+
+    /**
+     * @brief Statistics aggregated by fiber name, including fibers which are still alive.
+     */
+    static std::vector<FiberStatistics> collect();
+
+    /**
+     * @brief Statistics of the most recently completed fibers in completion order.
+     */
+    static std::vector<FiberStatistics> completed_fibers();
+
+    /**
+     * @brief Increment the mrc_fiber_{running,ready,blocked,cpu,channel_wait}_ns and mrc_fiber_context_switches
+     * counters of the registry, labeled by fiber name, by the amounts accumulated since the previous export.
+     */
+    static void export_metrics(metrics::Registry& registry);
+
+    /**
+     * @brief Write the recorded running slices as a Chrome trace event json file; each scheduler thread is a process
+     * and each fiber a thread of the trace.
+     */
+    static void write_chrome_trace(const std::string& filename);
+
+    /**
+     * @brief Maximum number of slices retained per scheduler thread; slices beyond the limit are counted as dropped.
+     */
+    static void max_slices_per_thread(std::size_t count);
+
+    /**
+     * @brief Discard recorded slices and completed fiber statistics. Name totals are not reset.
+     */
+    static void reset();
+
+    // scheduler integration
+    static std::shared_ptr<ThreadBuffer> make_thread_buffer();
+    static void set_current_fiber(FiberState* state);
+
+  private:
+    static NameStatistics& find_or_create_name(const std::string& name);
+    static void record_completed(FiberStatistics&& statistics);
+    static std::uint64_t next_fiber_id();
+    static std::size_t max_slices_per_thread();
+};
+
+}  // namespace mrc::benchmarking
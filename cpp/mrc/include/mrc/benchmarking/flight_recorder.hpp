@@ -0,0 +1,190 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace mrc::benchmarking {
+
+enum class FlightEventType : std::uint32_t
+{
+    // elements written to / read from a channel; id: channel, value: number of elements
+    ChannelWrite,
+    ChannelRead,
+    // a fiber was switched in by a fiber scheduler; id: fiber context
+    FiberSwitch,
+    // completion of a data plane send / receive; id: request, value: 0 on success
+    NetworkSend,
+    NetworkRecv,
+    // tagged message picked up by a receive manager; id: tag, value: bytes
+    NetworkTaggedMessage,
+    // user defined event; id and value are chosen by the caller
+    Mark,
+};
+
+const char* flight_event_name(FlightEventType type);
+
+struct FlightEvent
+{
+    std::chrono::steady_clock::time_point timestamp;
+    FlightEventType type;
+    std::uint32_t value;
+    std::uint64_t id;
+    // os thread id of the thread which recorded the event
+    std::int32_t thread_id;
+};
+
+namespace detail {
+
+/**
+ * @brief Fixed-size ring of the most recent events of one thread.
+ *
+ * Only the owning thread writes; each slot is a seqlock so readers on other threads detect, and skip, slots which are
+ * overwritten while they read them.
+ */
+class FlightRing
+{
+  public:
+    FlightRing(std::size_t capacity);
+
+    void push(FlightEventType type, std::uint64_t id, std::uint32_t value) noexcept
+    {
+        auto pos   = m_head.load(std::memory_order_relaxed);
+        auto& slot = m_slots[pos & m_mask];
+
+        slot.sequence.store(2 * pos + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        slot.timestamp.store(std::chrono::steady_clock::now().time_since_epoch().count(), std::memory_order_relaxed);
+        slot.meta.store((static_cast<std::uint64_t>(type) << 32) | value, std::memory_order_relaxed);
+        slot.id.store(id, std::memory_order_relaxed);
+        slot.sequence.store(2 * pos + 2, std::memory_order_release);
+
+        m_head.store(pos + 1, std::memory_order_release);
+    }
+
+    // consistent copy of the retained events, oldest first
+    void read(std::vector<FlightEvent>& events) const;
+
+    // binds the ring to the calling thread, discarding the events of its previous owner
+    void adopt();
+
+    std::size_t capacity() const
+    {
+        return m_mask + 1;
+    }
+
+  private:
+    struct alignas(32) Slot
+    {
+        std::atomic<std::uint64_t> sequence{0};
+        std::atomic<std::int64_t> timestamp{0};
+        std::atomic<std::uint64_t> meta{0};
+        std::atomic<std::uint64_t> id{0};
+    };
+
+    const std::size_t m_mask;
+    std::unique_ptr<Slot[]> m_slots;
+    std::atomic<std::uint64_t> m_head{0};
+
+    // position of the first event of the current owner
+    std::atomic<std::uint64_t> m_start{0};
+    std::atomic<std::int32_t> m_thread_id{0};
+};
+
+// ring of the calling thread, null until the thread records its first event
+inline thread_local FlightRing* t_flight_ring{nullptr};
+
+}  // namespace detail
+
+/**
+ * @brief Always-on flight recorder keeping the most recent channel, fiber and network events of every thread.
+ *
+ * Each thread records into its own fixed-size binary ring, so recording costs a clock read and a few stores without
+ * locks or allocations; the oldest events of a thread are overwritten once its ring is full. The rings can be dumped
+ * at any time, e.g. on a signal or when a latency budget is breached, as a Chrome trace event file which loads in
+ * https://ui.perfetto.dev or chrome://tracing.
+ *
+ * Recording is enabled with the MRC_FLIGHT_RECORDER environment variable or FlightRecorder::enable. The ring of a
+ * thread which exits is reused by the next thread recording an event.
+ */
+class FlightRecorder
+{
+  public:
+    static void record(FlightEventType type, std::uint64_t id, std::uint32_t value = 0) noexcept
+    {
+        if (!s_enabled.load(std::memory_order_relaxed))
+        {
+            return;
+        }
+        auto* ring = detail::t_flight_ring;
+        if (ring == nullptr)
+        {
+            ring = acquire_ring();
+        }
+        ring->push(type, id, value);
+    }
+
+    static void enable(bool flag);
+
+    static bool enabled();
+
+    /**
+     * @brief Number of events retained per thread, rounded up to a power of 2; applies to rings created afterwards.
+     */
+    static void capacity_per_thread(std::size_t count);
+
+    /**
+     * @brief Retained events of all threads ordered by timestamp
+     */
+    static std::vector<FlightEvent> snapshot();
+
+    /**
+     * @brief Write the retained events as a Chrome trace event json file; each thread is a thread of the trace and
+     * each event an instant event.
+     */
+    static void write_trace(const std::string& filename);
+
+    /**
+     * @brief Directory the dumps of trigger_dump and dump_on_signal are written to; defaults to the working directory
+     */
+    static void dump_directory(std::string directory);
+
+    /**
+     * @brief Dump the rings from a background thread, e.g. when a latency budget is breached. Requests within one
+     * second of the previous dump are ignored so a burst of breaches produces a single dump.
+     * @return true if a dump was scheduled
+     */
+    static bool trigger_dump(const std::string& reason);
+
+    /**
+     * @brief Dump the rings each time the process receives signum, e.g. SIGUSR2
+     */
+    static void dump_on_signal(int signum);
+
+  private:
+    static detail::FlightRing* acquire_ring();
+
+    static std::atomic<bool> s_enabled;
+};
+
+}  // namespace mrc::benchmarking
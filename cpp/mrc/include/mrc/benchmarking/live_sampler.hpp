@@ -0,0 +1,145 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include "mrc/benchmarking/trace_statistics.hpp"
+#include "mrc/channel/telemetry.hpp"
+#include "mrc/utils/macros.hpp"
+
+#include <nlohmann/json_fwd.hpp>
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace mrc::benchmarking {
+
+/**
+ * @brief Activity of a traced node over the interval of a LiveSample; rates are per second.
+ *
+ * mean_latency_ns is the operator time per emitted element. read_wait_ns and write_wait_ns are the times the node
+ * spent reading its input and writing its output channel: a node mostly waiting on writes is backpressured by its
+ * downstream, one mostly waiting on reads is starved by its upstream.
+ */
+struct LiveNodeSample
+{
+    std::string name;
+    std::size_t received{0};
+    std::size_t emitted{0};
+    double receive_rate{0.0};
+    double emit_rate{0.0};
+    double mean_latency_ns{0.0};
+    std::size_t read_wait_ns{0};
+    std::size_t write_wait_ns{0};
+};
+
+/**
+ * @brief State of a watched channel at the time of a LiveSample; reads, writes and blocked times cover the interval.
+ */
+struct LiveQueueSample
+{
+    std::string name;
+    std::size_t capacity{0};
+    std::size_t occupancy{0};
+    std::size_t high_water_mark{0};
+    std::uint64_t reads{0};
+    std::uint64_t writes{0};
+    double blocked_writer_seconds{0.0};
+    double blocked_reader_seconds{0.0};
+};
+
+struct LiveSample
+{
+    std::size_t sequence{0};
+    double interval_seconds{0.0};
+    std::vector<LiveNodeSample> nodes;
+    std::vector<LiveQueueSample> queues;
+
+    nlohmann::json to_json() const;
+};
+
+/**
+ * @brief Periodically samples the throughput, latency and backpressure of a running pipeline and pushes the deltas
+ * since the previous sample to a callback.
+ *
+ * Node activity is read from the lock-free totals of TraceStatistics, so nodes are only reported while operator and
+ * channel tracing are enabled, see TraceStatistics::trace_operators and TraceStatistics::trace_channels. Queue
+ * occupancy is read from the channels registered with watch_queue. Sampling runs on a dedicated thread and never
+ * blocks the pipeline; the callback is invoked on that thread and should return well within the period.
+ */
+class LiveSampler
+{
+  public:
+    using callback_t    = std::function<void(const LiveSample&)>;
+    using queue_probe_t = std::function<std::optional<channel::ChannelStatistics>()>;
+
+    LiveSampler(std::chrono::milliseconds period, callback_t on_sample);
+    ~LiveSampler();
+
+    DELETE_COPYABILITY(LiveSampler);
+    DELETE_MOVEABILITY(LiveSampler);
+
+    /**
+     * @brief Report the channel statistics returned by probe under name; a probe returning an empty optional, e.g.
+     * because the node it observes was destroyed, is dropped from later samples.
+     */
+    void watch_queue(std::string name, queue_probe_t probe);
+
+    void start();
+
+    /**
+     * @brief Stop sampling and wait for the sampling thread; must not be called from the callback
+     */
+    void stop();
+
+    bool is_running() const;
+
+    /**
+     * @brief Sample now; the next sample reports the deltas from this one. Used by the sampling thread, and by
+     * consumers pulling samples instead of receiving them through the callback.
+     */
+    LiveSample sample();
+
+  private:
+    void sampling_loop();
+
+    const std::chrono::milliseconds m_period;
+    const callback_t m_on_sample;
+
+    mutable std::mutex m_mutex;
+    std::condition_variable m_cv;
+    bool m_running{false};
+    std::thread m_thread;
+
+    std::map<std::string, queue_probe_t> m_queue_probes;
+
+    // totals of the previous sample
+    std::size_t m_sequence{0};
+    std::chrono::steady_clock::time_point m_last_sample;
+    std::map<std::string, TraceStatisticsSnapshot> m_last_nodes;
+    std::map<std::string, channel::ChannelStatistics> m_last_queues;
+};
+
+}  // namespace mrc::benchmarking
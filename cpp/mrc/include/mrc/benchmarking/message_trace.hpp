@@ -0,0 +1,217 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2021-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "mrc/codable/codable_protocol.hpp"
+#include "mrc/codable/decode.hpp"
+#include "mrc/codable/encode.hpp"
+#include "mrc/codable/encoding_options.hpp"
+#include "mrc/codable/type_traits.hpp"
+#include "mrc/memory/memory_kind.hpp"
+
+#include <glog/logging.h>
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace mrc::benchmarking {
+
+/**
+ * @brief Time a traced message spent in a named stage of the pipeline, e.g. a node, on the machine named by location
+ *
+ * Timestamps are in nanoseconds since the unix epoch so the hops recorded on different machines share a time base;
+ * they are only as comparable as the clocks of the machines are synchronized.
+ */
+struct TraceHop
+{
+    std::string name;
+    std::string location;
+    std::int64_t start_ns{0};
+    std::int64_t end_ns{0};
+};
+
+/**
+ * @brief Sampled trace of a single message as it moves through segments, manifolds and machines
+ *
+ * A TraceContext travels with its message, see Traced, and accumulates a TraceHop for every stage which records one,
+ * usually with a TraceScope. The context of an unsampled message is empty and recording into it is a no-op, so
+ * tracing can stay compiled in with a low sample rate. Once the message reaches its final stage, finish hands the
+ * trace to the TraceExporter installed with set_exporter.
+ *
+ * Sampling is disabled by default: start only returns a sampled context once a sample rate greater than 0 is set.
+ */
+class TraceContext
+{
+  public:
+    using clock_t = std::chrono::system_clock;
+
+    // unsampled context
+    TraceContext() = default;
+
+    /**
+     * @brief Begin the trace of a new message, sampled with the probability set by set_sample_rate
+     */
+    static TraceContext start(std::string name);
+
+    // probability in [0, 1] with which start samples a message
+    static void set_sample_rate(double rate);
+    static double sample_rate();
+
+    // location recorded with the hops of this process; defaults to the hostname
+    static void set_location(std::string location);
+    static const std::string& location();
+
+    bool sampled() const;
+    const std::string& name() const;
+    const std::vector<TraceHop>& hops() const;
+
+    // 128-bit trace id and 64-bit id of the root span; 0 for an unsampled context
+    const std::array<std::uint64_t, 2>& trace_id() const;
+    std::uint64_t span_id() const;
+    std::int64_t start_ns() const;
+
+    void record_hop(std::string name, clock_t::time_point start, clock_t::time_point end);
+
+    /**
+     * @brief Export the trace and reset the context to unsampled; a no-op for an unsampled context
+     */
+    void finish();
+
+    // compact binary form of the context used by the codable protocol of Traced
+    std::vector<std::byte> pack() const;
+    static TraceContext unpack(const std::byte* data, std::size_t size);
+
+  private:
+    std::array<std::uint64_t, 2> m_trace_id{0, 0};
+    std::uint64_t m_span_id{0};
+    std::int64_t m_start_ns{0};
+    std::string m_name;
+    std::vector<TraceHop> m_hops;
+};
+
+/**
+ * @brief Records the lifetime of the scope as a hop of the trace, e.g. the time a node spends on a message
+ */
+class TraceScope
+{
+  public:
+    TraceScope(TraceContext& context, std::string name);
+    ~TraceScope();
+
+    TraceScope(const TraceScope&)            = delete;
+    TraceScope& operator=(const TraceScope&) = delete;
+
+  private:
+    TraceContext& m_context;
+    std::string m_name;
+    TraceContext::clock_t::time_point m_start;
+};
+
+/**
+ * @brief Receives the sampled traces of finished messages
+ *
+ * export_trace may be called concurrently from any thread completing a trace.
+ */
+class TraceExporter
+{
+  public:
+    virtual ~TraceExporter() = default;
+
+    virtual void export_trace(const TraceContext& context) = 0;
+
+    // install the process-wide exporter; traces finished without an exporter are dropped
+    static void set_exporter(std::shared_ptr<TraceExporter> exporter);
+    static std::shared_ptr<TraceExporter> exporter();
+};
+
+/**
+ * @brief Writes each trace as a line of OpenTelemetry OTLP/JSON, e.g. for the otlpjsonfile receiver of a collector
+ *
+ * A trace is exported as a root span covering the trace from start to finish with a child span per hop. The hops of
+ * a message crossing machines share the trace id, so the collector assembles them into a single trace.
+ */
+class OtlpJsonTraceExporter final : public TraceExporter
+{
+  public:
+    OtlpJsonTraceExporter(std::ostream& stream, std::string service_name = "mrc");
+
+    void export_trace(const TraceContext& context) final;
+
+    static std::string to_otlp_json(const TraceContext& context, const std::string& service_name);
+
+  private:
+    std::ostream& m_stream;
+    const std::string m_service_name;
+    std::mutex m_mutex;
+};
+
+/**
+ * @brief Message with its trace context; edges, manifolds and remote descriptors of Traced<T> carry the context along
+ */
+template <typename T>
+struct Traced
+{
+    T payload;
+    TraceContext trace;
+};
+
+template <typename T>
+Traced<T> make_traced(T payload, std::string name)
+{
+    return {std::move(payload), TraceContext::start(std::move(name))};
+}
+
+}  // namespace mrc::benchmarking
+
+namespace mrc::codable {
+
+template <typename T>
+struct codable_protocol<benchmarking::Traced<T>>
+{
+    static void serialize(const benchmarking::Traced<T>& obj,
+                          Encoder<benchmarking::Traced<T>>& encoder,
+                          const EncodingOptions& opts)
+    {
+        static_assert(is_codable_v<T>, "payload type is not codable");
+        auto bytes = obj.trace.pack();
+        encoder.copy_to_eager_descriptor({bytes.data(), bytes.size(), memory::memory_kind::host});
+        encoder.template rebind<T>().serialize(obj.payload, opts);
+    }
+
+    static benchmarking::Traced<T> deserialize(const Decoder<benchmarking::Traced<T>>& decoder, std::size_t object_idx)
+    {
+        auto idx = decoder.start_idx_for_object(object_idx);
+        std::vector<std::byte> bytes(decoder.buffer_size(idx));
+        decoder.copy_from_buffer(idx, {bytes.data(), bytes.size(), memory::memory_kind::host});
+
+        auto children = decoder.child_object_indices(object_idx);
+        CHECK_EQ(children.size(), 1);
+        return {decoder.template deserialize_child<T>(children[0]),
+                benchmarking::TraceContext::unpack(bytes.data(), bytes.size())};
+    }
+};
+
+}  // namespace mrc::codable
@@ -17,9 +17,13 @@
 
 #pragma once
 
+#include "mrc/benchmarking/bottleneck.hpp"
+#include "mrc/benchmarking/live_sampler.hpp"
+#include "mrc/benchmarking/trace_columns.hpp"
 #include "mrc/benchmarking/trace_statistics.hpp"
 #include "mrc/benchmarking/tracer.hpp"
 #include "mrc/core/executor.hpp"
+#include "mrc/segment/object.hpp"
 
 #include <boost/fiber/barrier.hpp>
 #include <boost/fiber/condition_variable.hpp>
@@ -30,9 +34,12 @@
 #include <atomic>
 #include <chrono>
 #include <functional>
+#include <map>
 #include <memory>
 #include <mutex>
+#include <optional>
 #include <string>
+#include <utility>
 
 namespace mrc::benchmarking {
 
@@ -136,6 +143,38 @@ class SegmentWatcher
      */
     void payload_initializer(std::function<void(TracerTypeT&)> payload_init);
 
+    /**
+     * @brief Live mode: sample the throughput, latency and backpressure of the pipeline every period and push the
+     * deltas since the previous sample to on_sample, see LiveSampler. Live mode neither starts nor restarts the
+     * pipeline and runs independently of the tracing cycles; it is stopped by stop_live or shutdown.
+     */
+    void start_live(std::chrono::milliseconds period, LiveSampler::callback_t on_sample);
+
+    /**
+     * @brief Stop live mode; must not be called from the on_sample callback.
+     */
+    void stop_live();
+
+    /**
+     * @brief Live mode reporting the saturated, backpressured and starved nodes of each sample, see
+     * analyze_bottlenecks. The pe counts of the nodes registered with watch_queue are filled into options. Each
+     * report is logged at VLOG(1); it is stopped by stop_live or shutdown.
+     */
+    void start_bottleneck_reports(std::chrono::milliseconds period,
+                                  std::function<void(const BottleneckReport&)> on_report,
+                                  BottleneckOptions options = {});
+
+    /**
+     * @brief Report the occupancy of the input channel of a node in the live samples. Call it once the edges into the
+     * node were formed, e.g. at the end of the segment initializer. The watcher does not extend the lifetime of the
+     * channel; it is no longer reported once the channel is destroyed with its segment.
+     * @param name Name of the queue in the samples; bottleneck reports attribute the queue and the pe count of the
+     * object to the traced node of the same name.
+     * @param object Segment object of a node reading from a channel, i.e. deriving from node::SinkChannelBase.
+     */
+    template <typename ObjectT>
+    void watch_queue(const std::string& name, const std::shared_ptr<segment::Object<ObjectT>>& object);
+
   private:
     std::atomic<bool> m_running{false};
     std::atomic<bool> m_tracing{false};
@@ -161,7 +200,14 @@ class SegmentWatcher
     std::map<std::string, std::size_t> m_nodeid;
     std::map<std::size_t, std::string> m_id2name;
 
-    std::vector<std::shared_ptr<TracerBase>> m_tracers;
+    // tracers are folded into a row as they reach the sink and released; allocated for m_count_max rows once the
+    // node count is known
+    std::unique_ptr<TraceColumns> m_columns;
+
+    std::mutex m_live_mutex;
+    std::map<std::string, LiveSampler::queue_probe_t> m_queue_probes;
+    std::map<std::string, std::size_t> m_pe_counts;
+    std::unique_ptr<LiveSampler> m_live_sampler;
 
     void shutdown_watcher();
     void shutdown_segment();
@@ -195,8 +241,17 @@ decltype(auto) SegmentWatcher<TracerTypeT>::create_tracer_sink_lambda(const std:
         sink_f(*tracer);
         tracer->emit(idx);
 
+        if (!m_columns)
+        {
+            m_columns = std::make_unique<TraceColumns>(TracerTypeT::column_count(m_max_nodes), m_count_max);
+        }
+        auto row = m_columns->append_row();
+        if (row != TraceColumns::npos)
+        {
+            tracer->write_columns(*m_columns, row);
+        }
+
         m_latency_cycle_ready = true;
-        m_tracers.push_back(tracer);
         m_count++;
     };
 
@@ -394,6 +449,7 @@ template <typename TracerTypeT>
 void SegmentWatcher<TracerTypeT>::shutdown()
 {
     VLOG(5) << "Shutdown called." << std::endl << std::flush;
+    stop_live();
     stop_trace();
     shutdown_watcher();
     shutdown_segment();
@@ -406,7 +462,10 @@ void SegmentWatcher<TracerTypeT>::reset()
     VLOG(5) << "Reset called." << std::endl;
     std::unique_lock<std::mutex> lock(m_mutex);
     m_count = 0;
-    m_tracers.clear();
+    if (m_columns)
+    {
+        m_columns->clear();
+    }
     TraceStatistics::reset();
     VLOG(5) << "Reset complete." << std::endl;
 }
@@ -438,7 +497,11 @@ std::shared_ptr<TraceAggregatorBase> SegmentWatcher<TracerTypeT>::aggregate_trac
     using namespace nlohmann;
     auto elapsed    = m_tracing_end_ns - m_tracing_start_ns;
     auto aggregator = std::make_shared<TraceAggregator<TracerTypeT>>();
-    aggregator->process_tracer_data(m_tracers, elapsed.count() / 1e9, m_max_nodes, m_id2name);
+    if (!m_columns)
+    {
+        m_columns = std::make_unique<TraceColumns>(TracerTypeT::column_count(m_max_nodes), m_count_max);
+    }
+    aggregator->process_tracer_columns(*m_columns, elapsed.count() / 1e9, m_max_nodes, m_id2name);
 
     return aggregator;
 }
@@ -455,13 +518,15 @@ void SegmentWatcher<TracerTypeT>::tracer_count(std::size_t count)
     CHECK(count > 0);
 
     m_count_max = count;
-    m_tracers.reserve(m_count_max);
+
+    // the columns are reallocated for the new count by the next tracer reaching the sink
+    m_columns.reset();
 }
 
 template <typename TracerTypeT>
 std::size_t SegmentWatcher<TracerTypeT>::tracer_count() const
 {
-    return m_tracers.size();
+    return m_columns ? m_columns->rows() : 0;
 }
 
 template <typename TracerTypeT>
@@ -470,6 +535,82 @@ void SegmentWatcher<TracerTypeT>::payload_initializer(std::function<void(TracerT
     m_payload_init = payload_init;
 }
 
+template <typename TracerTypeT>
+void SegmentWatcher<TracerTypeT>::start_live(std::chrono::milliseconds period, LiveSampler::callback_t on_sample)
+{
+    std::unique_lock<std::mutex> lock(m_live_mutex);
+    if (m_live_sampler)
+    {
+        m_live_sampler->stop();
+    }
+
+    m_live_sampler = std::make_unique<LiveSampler>(period, std::move(on_sample));
+    for (const auto& [name, probe] : m_queue_probes)
+    {
+        m_live_sampler->watch_queue(name, probe);
+    }
+    m_live_sampler->start();
+}
+
+template <typename TracerTypeT>
+void SegmentWatcher<TracerTypeT>::start_bottleneck_reports(std::chrono::milliseconds period,
+                                                           std::function<void(const BottleneckReport&)> on_report,
+                                                           BottleneckOptions options)
+{
+    {
+        std::unique_lock<std::mutex> lock(m_live_mutex);
+        options.pe_counts.insert(m_pe_counts.begin(), m_pe_counts.end());
+    }
+
+    start_live(period, [on_report = std::move(on_report), options = std::move(options)](const LiveSample& sample) {
+        auto report = analyze_bottlenecks(sample, options);
+        VLOG(1) << report.summary();
+        if (on_report)
+        {
+            on_report(report);
+        }
+    });
+}
+
+template <typename TracerTypeT>
+void SegmentWatcher<TracerTypeT>::stop_live()
+{
+    std::unique_lock<std::mutex> lock(m_live_mutex);
+    if (m_live_sampler)
+    {
+        m_live_sampler->stop();
+        m_live_sampler.reset();
+    }
+}
+
+template <typename TracerTypeT>
+template <typename ObjectT>
+void SegmentWatcher<TracerTypeT>::watch_queue(const std::string& name,
+                                              const std::shared_ptr<segment::Object<ObjectT>>& object)
+{
+    auto observer = object->object().channel_observer();
+
+    LiveSampler::queue_probe_t probe = [observer]() -> std::optional<channel::ChannelStatistics> {
+        auto observed = observer.lock();
+        if (!observed)
+        {
+            return std::nullopt;
+        }
+        return observed->statistics();
+    };
+
+    std::unique_lock<std::mutex> lock(m_live_mutex);
+    m_queue_probes[name] = probe;
+    if (object->is_runnable())
+    {
+        m_pe_counts[name] = object->launch_options().pe_count;
+    }
+    if (m_live_sampler)
+    {
+        m_live_sampler->watch_queue(name, std::move(probe));
+    }
+}
+
 template <typename TracerTypeT>
 void SegmentWatcher<TracerTypeT>::shutdown_watcher()
 {
@@ -0,0 +1,87 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <vector>
+
+namespace mrc::benchmarking {
+
+/**
+ * @brief Statistics of the non-zero samples of a TraceColumns column, i.e. of the tracers which traversed its cell
+ */
+struct ColumnSummary
+{
+    std::size_t count{0};
+    std::uint64_t sum{0};
+    std::uint64_t min{0};
+    std::uint64_t max{0};
+    std::uint64_t p50{0};
+    std::uint64_t p90{0};
+    std::uint64_t p99{0};
+};
+
+/**
+ * @brief Fixed capacity columnar store of the samples of completed tracers, one row per tracer
+ *
+ * Samples are stored column-major in a single allocation made on construction, so tracers are folded into their row
+ * and released as they complete rather than being retained until the end of a run, and each column is a contiguous
+ * array the summaries are computed over with loops the compiler vectorizes. The store takes capacity * column_count
+ * samples of 8 bytes; rows appended beyond its capacity are dropped.
+ *
+ * Appending and writing rows is not synchronized; summarize reuses a scratch column and must not be called
+ * concurrently either.
+ */
+class TraceColumns
+{
+  public:
+    static constexpr std::size_t npos = std::numeric_limits<std::size_t>::max();
+
+    TraceColumns(std::size_t column_count, std::size_t capacity);
+
+    std::size_t column_count() const;
+    std::size_t capacity() const;
+
+    // number of rows appended
+    std::size_t rows() const;
+
+    // index of a new zeroed row, or npos if all capacity rows are taken
+    std::size_t append_row();
+
+    void set(std::size_t row, std::size_t column, std::uint64_t value);
+
+    // samples of the appended rows of column
+    std::span<const std::uint64_t> column(std::size_t column) const;
+
+    ColumnSummary summarize(std::size_t column) const;
+
+    // drops all rows, keeping the storage; rows are zeroed as they are appended
+    void clear();
+
+  private:
+    const std::size_t m_column_count;
+    const std::size_t m_capacity;
+    std::size_t m_rows{0};
+    std::vector<std::uint64_t> m_values;
+    mutable std::vector<std::uint64_t> m_scratch;
+};
+
+}  // namespace mrc::benchmarking
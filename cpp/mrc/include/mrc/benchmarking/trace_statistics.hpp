@@ -22,44 +22,44 @@
 
 #include <nlohmann/json_fwd.hpp>
 
-#include <array>
+#include <atomic>
 #include <cstddef>  // for size_t
-#include <functional>
-#include <map>
 #include <memory>
-#include <mutex>
 #include <string>
-#include <thread>
 #include <tuple>
+#include <vector>
 
 namespace mrc::benchmarking {
 
 /**
- * @brief Class used to store statistics gathered from internal nodes via watcher interfaces. The class consists
- * of various static elements that allow for a consistent global view + aggregation of thread local storage elements
- * which keep track of statistics on a per thread basis.
+ * @brief Point in time totals of a named TraceStatistics object, summed across all threads which reported to it.
  */
-class TraceStatistics : public WatcherInterface
+struct TraceStatisticsSnapshot
 {
-    // Thread local map to store a name-unique per-thread TraceStatistics struct.
-    thread_local static std::map<std::string, std::shared_ptr<TraceStatistics>> TraceObjectMap;
-
-    // Multi-map containing a shared pointer to all TraceStatistics structures across all thread_local storage.
-    // Primarily used to aggregate statistics across threads without blocking or having to run per-thread routines.
-    static std::multimap<std::string, std::shared_ptr<TraceStatistics>> TraceObjectMultimap;
-    static std::recursive_mutex s_state_mutex;
-
-    // Performance optimization that assigns an initial number of 'slots' for watcher entrypoint handling. Slot count
-    // should be greater than or equal to the number of WatchableEvents
-    static constexpr std::size_t MaxSlotsV = 10;
-
-    static bool s_trace_operators;
-    static bool s_trace_operators_set_manually;
+    std::string name;
+    std::size_t emission_count{0};
+    std::size_t receive_count{0};
+    std::size_t channel_sink_reads{0};
+    std::size_t channel_source_writes{0};
+    std::size_t total_internal_elapsed_ns{0};
+    std::size_t total_ch_read_elapsed_ns{0};
+    std::size_t total_ch_write_elapsed_ns{0};
+    std::size_t total_elapsed_ns{0};
+};
 
-    static bool s_trace_channels;
-    static bool s_trace_channels_set_manually;
+/**
+ * @brief Class used to store statistics gathered from internal nodes via watcher interfaces. Each uniquely named
+ * stats object is assigned an integer id on creation, which indexes a fixed slot of counters in per-thread storage;
+ * events only touch the counters of the calling thread, without locks or look-ups by name. Readers sum the slots of
+ * all threads without blocking the writers, so statistics can be polled while a pipeline is running.
+ */
+class TraceStatistics : public WatcherInterface
+{
+    static std::atomic<bool> s_trace_operators;
+    static std::atomic<bool> s_trace_operators_set_manually;
 
-    static bool s_initialized;
+    static std::atomic<bool> s_trace_channels;
+    static std::atomic<bool> s_trace_channels_set_manually;
 
     static void init();
 
@@ -71,22 +71,19 @@ class TraceStatistics : public WatcherInterface
     static nlohmann::json aggregate();
 
     /**
-     * @brief (Threadsafe) Retrieve the thread local stats object associated with a given unique name or create a new
-     * one if it does not exist. Its worth noting that the TraceStatistics object retrived is not explicitly thread
-     * local -- rather, the map associating uniquely named TraceStatistics objects for each thread is thread-local.
+     * @brief (Threadsafe) Retrieve the stats object associated with a given unique name or create a new one if it does
+     * not exist. The object may be shared by elements on any number of threads; each thread reports to its own
+     * counters.
      * @param name Name of the uniquely identified stats object.
-     * @return Shared pointer to the thread local stats object.
+     * @return Shared pointer to the stats object.
      */
     static std::shared_ptr<TraceStatistics> get_or_create(const std::string& name);
 
     /**
-     * @brief Retrieve a multi-map containing pointers to all thread local TraceStatistics objects. Can be used for
-     * custom aggregation.
-     * @return Multi-map where the multiplicity of each entry will be equal to the number of unique threads which
-     * have called 'get_or_create'.
+     * @brief (Lock-free) Point in time totals of every stats object, ordered by name. The totals are read while
+     * threads keep reporting, so they should be considered approximately consistent across counters.
      */
-    [[maybe_unused]] static const std::multimap<std::string, std::shared_ptr<TraceStatistics>>&
-    get_thread_local_results_map();
+    static std::vector<TraceStatisticsSnapshot> snapshot();
 
     /**
      * @brief Reset existing statistics, and call sync_state.
@@ -131,6 +128,11 @@ class TraceStatistics : public WatcherInterface
 
     nlohmann::json to_json() const;
 
+    /**
+     * @brief Id indexing the counters of this stats object
+     */
+    std::size_t id() const;
+
     /**
      * @brief Watcher interface override.
      */
@@ -142,7 +144,7 @@ class TraceStatistics : public WatcherInterface
     void on_exit(const WatchableEvent& e, bool rc, const void* data) override;
 
   private:
-    TraceStatistics(const std::string& name);
+    TraceStatistics(std::string name, std::size_t id);
 
     /**
      * @brief Entry point for channel event.
@@ -164,51 +166,18 @@ class TraceStatistics : public WatcherInterface
      */
     void channel_write_start();
 
-    /**
-     * @brief clear all counters on this stats object.
-     */
-    void clear();
-
     /**
      * @brief Data emission handler -- called when an node emits a data element to its source output.
      */
     void emit();
 
-    /**
-     * @brief Initializes the lookup tables for WatchableEvent handlers. These will be set to no-ops if
-     * the related tracing flags are false, or the handling implementation otherwise.
-     */
-    void initialize_lookup_tables();
-
     /**
      * @brief Data receive handler -- called when an node pulls data from it's sink a data element to its source output.
      */
     void receive();
 
-    /**
-     * Thread ID where this stats object is created.
-     * @return thread id
-     */
-    std::thread::id parent_id() const;
-
-    const std::string& m_name;
-    const std::thread::id m_parent_id;
-
-    TimeUtil::time_pt_t m_start_time;
-    TimeUtil::time_pt_t m_internal_chain_start;
-    TimeUtil::time_pt_t m_channel_read_start;
-    TimeUtil::time_pt_t m_channel_write_start;
-
-    std::size_t m_emission_count{0};
-    std::size_t m_receive_count{0};
-    std::size_t m_channel_sink_reads{0};
-    std::size_t m_channel_source_writes{0};
-    std::size_t m_total_internal_elapsed_ns{0};
-    std::size_t m_total_ch_read_elapsed_ns{0};
-    std::size_t m_total_ch_write_elapsed_ns{0};
-
-    std::array<std::function<void(void)>, MaxSlotsV> m_entry_lookup_table;
-    std::array<std::function<void(void)>, MaxSlotsV> m_exit_lookup_table;
+    const std::string m_name;
+    const std::size_t m_id;
 };
 
 }  // namespace mrc::benchmarking
@@ -17,6 +17,7 @@
 
 #pragma once
 
+#include "mrc/benchmarking/trace_columns.hpp"
 #include "mrc/benchmarking/util.hpp"
 
 #include <glog/logging.h>
@@ -107,7 +108,17 @@ class LatencyTracer : public TracerBase
     ~LatencyTracer() override = default;
     LatencyTracer(std::size_t max_nodes);
 
-    static void aggregate(std::vector<std::shared_ptr<TracerBase>> tracers, nlohmann::json& j);
+    /**
+     * @brief Number of TraceColumns columns of the tracer: the latency of each emit, recv node pair in nanoseconds.
+     */
+    static std::size_t column_count(std::size_t max_nodes);
+
+    /**
+     * @brief Aggregate the mean, min, max and percentile latencies of the columns starting at first_column.
+     */
+    static void aggregate(const TraceColumns& columns, std::size_t first_column, nlohmann::json& j);
+
+    void write_columns(TraceColumns& columns, std::size_t row, std::size_t first_column) const;
 
     void emit(std::size_t emit_id,
               std::size_t recv_id,
@@ -134,7 +145,15 @@ struct ThroughputTracer : public TracerBase
     ~ThroughputTracer() override = default;
     ThroughputTracer(std::size_t max_nodes);
 
-    static void aggregate(std::vector<std::shared_ptr<TracerBase>> tracers, nlohmann::json& j);
+    /**
+     * @brief Number of TraceColumns columns of the tracer: the latency of each emit, recv node pair in nanoseconds
+     * followed by the emission and the receive count of each node.
+     */
+    static std::size_t column_count(std::size_t max_nodes);
+
+    static void aggregate(const TraceColumns& columns, std::size_t first_column, nlohmann::json& j);
+
+    void write_columns(TraceColumns& columns, std::size_t row, std::size_t first_column) const;
 
     void emit(std::size_t emit_id,
               std::size_t recv_id,
@@ -279,6 +298,25 @@ class TracerEnsemble : public TracerTypeT...
         m_recv_hop_id = nid;
     }
 
+    /**
+     * @brief Number of TraceColumns columns of the ensemble, those of each tracer type in order.
+     */
+    static std::size_t column_count(std::size_t max_nodes)
+    {
+        return (TracerTypeT::column_count(max_nodes) + ...);
+    }
+
+    /**
+     * @brief Fold the state of each tracer type into row of columns; the ensemble may be released afterwards.
+     */
+    void write_columns(TraceColumns& columns, std::size_t row) const
+    {
+        std::size_t first_column = 0;
+        ((TracerTypeT::write_columns(columns, row, first_column),
+          first_column += TracerTypeT::column_count(m_max_nodes)),
+         ...);
+    }
+
     /**
      * @brief Reset timestamps for this trace ensemble.
      */
@@ -322,6 +360,19 @@ class TraceAggregatorBase
                              std::size_t segment_node_count,
                              const std::map<std::size_t, std::string>& cmpt_id_to_name);
 
+    /**
+     * Aggregate tracers already folded into columns, one row per tracer, without retaining the tracers themselves.
+     *
+     * @param columns Columns of the tracers of the TracerEnsemble
+     * @param trace_time_elapsed_seconds Total elapsed trace time
+     * @param segment_node_count Total segment nodes in traced segment
+     * @param cmpt_id_to_name Map of int id to std::string names
+     */
+    void process_tracer_columns(const TraceColumns& columns,
+                                double trace_time_elapsed_seconds,
+                                std::size_t segment_node_count,
+                                const std::map<std::size_t, std::string>& cmpt_id_to_name);
+
     /**
      * @brief Return aggregated JSON data.
      * @return JSON data.
@@ -330,11 +381,19 @@ class TraceAggregatorBase
 
   protected:
     /**
-     * Virtual function is used to aggregate tracer ensembles on the derived class.
-     * @param tracers tracers to aggregate.
+     * Virtual function is used to aggregate the columns of tracer ensembles on the derived class.
+     * @param columns columns to aggregate.
      * @param j json object where aggregate data will be collected.
      */
-    virtual void aggregate(std::vector<std::shared_ptr<TracerBase>> tracers, nlohmann::json& j) = 0;
+    virtual void aggregate(const TraceColumns& columns, nlohmann::json& j) = 0;
+
+    /**
+     * Virtual function is used to fold tracer ensembles into columns on the derived class.
+     * @param tracers tracers to fold.
+     * @param node_count node count the tracers were created with.
+     */
+    virtual TraceColumns make_columns(const std::vector<std::shared_ptr<TracerBase>>& tracers,
+                                      std::size_t node_count) = 0;
 
     /**
      * @brief Convert a map that uses numeric keys into one with stringified keys; this is just to address a deficiency
@@ -378,27 +437,43 @@ class TraceAggregator : public TraceAggregatorBase
   protected:
     /**
      * @brief Proxy member function for calling the type aware static aggregation function.
-     * @param tracers Collection of tracers to aggregate
+     * @param columns Columns of the tracers to aggregate
      * @param j json object where collection data is aggregated.
      */
-    void aggregate(std::vector<std::shared_ptr<TracerBase>> tracers, nlohmann::json& j) override
+    void aggregate(const TraceColumns& columns, nlohmann::json& j) override
+    {
+        aggregate_components(columns, 0, j);
+    }
+
+    TraceColumns make_columns(const std::vector<std::shared_ptr<TracerBase>>& tracers,
+                              std::size_t node_count) override
     {
-        aggregate_components(tracers, j);
+        TraceColumns columns(EnsembleTypeT::column_count(node_count), tracers.size());
+        for (const auto& tracer : tracers)
+        {
+            auto ensemble = std::dynamic_pointer_cast<EnsembleTypeT>(tracer);
+            CHECK(ensemble && tracer->max_nodes() == node_count);
+            ensemble->write_columns(columns, columns.append_row());
+        }
+        return columns;
     }
 
     /**
-     * @brief Aggregate data from a vector of tracers, across all ensemble tracers and populate 'j' with the results.
+     * @brief Aggregate the columns of all ensemble tracers and populate 'j' with the results.
      * @tparam N Initial tracer type index to aggregate from. Used to iterate over all tracer types within an ensemble.
-     * @param tracers vector of shared pointers to a collection of tracer ensembles.
+     * @param columns columns of a collection of tracer ensembles.
+     * @param first_column first column of tracer type N.
      * @param j json object to populate with aggregate data.
      */
     template <std::size_t N = 0>
-    static void aggregate_components(std::vector<std::shared_ptr<TracerBase>> tracers, nlohmann::json& j)
+    static void aggregate_components(const TraceColumns& columns, std::size_t first_column, nlohmann::json& j)
     {
         if constexpr (N < EnsembleTypeT::EnsembleSizeV)
         {
-            EnsembleTypeT::template nth_t<N>::aggregate(tracers, j);
-            aggregate_components<N + 1>(tracers, j);
+            using tracer_t = typename EnsembleTypeT::template nth_t<N>;
+            tracer_t::aggregate(columns, first_column, j);
+            aggregate_components<N + 1>(
+                columns, first_column + tracer_t::column_count(j["metadata"]["node_count"].get<std::size_t>()), j);
         }
     }
 };
@@ -0,0 +1,78 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "mrc/runnable/launch_options.hpp"
+
+#include <nlohmann/json_fwd.hpp>
+
+#include <cstddef>
+#include <map>
+#include <string>
+
+namespace mrc::benchmarking {
+
+struct NodeTuning
+{
+    std::size_t pe_count{1};
+    std::size_t engines_per_pe{1};
+    // capacity of the input channel of the node; 0 keeps the channel the node was constructed with
+    std::size_t channel_size{0};
+
+    bool operator==(const NodeTuning& other) const = default;
+};
+
+/**
+ * @brief Engine counts and channel sizes of the nodes of a pipeline by node name, e.g. as found by an AutoTuner.
+ *
+ * Node names are those of the TraceStatistics of the nodes, i.e. the names given to the segment::Builder including
+ * the namespace of their module. A profile is persisted as json and applied to the nodes of a segment with
+ * segment::Builder::apply_tuning before they are created.
+ */
+class TuningProfile
+{
+  public:
+    void set(std::string name, NodeTuning tuning);
+
+    // nullptr if the profile has no entry for name
+    const NodeTuning* find(const std::string& name) const;
+
+    const std::map<std::string, NodeTuning>& nodes() const;
+
+    bool empty() const;
+
+    /**
+     * @brief Set the pe_count and engines_per_pe of the launch options of node name; false if the profile has no
+     * entry for name
+     */
+    bool apply(const std::string& name, runnable::LaunchOptions& options) const;
+
+    nlohmann::json to_json() const;
+    static TuningProfile from_json(const nlohmann::json& j);
+
+    // throws exceptions::MrcRuntimeError if the file can not be written or read
+    void save(const std::string& path) const;
+    static TuningProfile load(const std::string& path);
+
+    bool operator==(const TuningProfile& other) const = default;
+
+  private:
+    std::map<std::string, NodeTuning> m_nodes;
+};
+
+}  // namespace mrc::benchmarking
@@ -18,10 +18,15 @@
 #pragma once
 
 #include "mrc/channel/channel.hpp"
+#include "mrc/channel/telemetry.hpp"
 
 #include <boost/fiber/buffered_channel.hpp>
 #include <boost/fiber/channel_op_status.hpp>
 
+#include <cstddef>
+#include <span>
+#include <vector>
+
 namespace mrc::channel {
 
 template <typename T>
@@ -30,18 +35,19 @@ class BufferedChannel final : public Channel<T>
     using status_t = boost::fibers::channel_op_status;
 
   public:
-    BufferedChannel(std::size_t buffer_size = default_channel_size()) : m_channel(buffer_size) {}
+    BufferedChannel(std::size_t buffer_size = default_channel_size()) : m_capacity(buffer_size), m_channel(buffer_size)
+    {}
     ~BufferedChannel() final = default;
 
   private:
     inline Status do_await_write(T&& val) final
     {
-        return status(m_channel.push(std::move(val)));
+        return status(push(std::move(val)));
     }
 
     inline Status do_await_read(T& val) final
     {
-        return status(m_channel.pop(std::ref(val)));
+        return status(pop(val, nullptr));
     }
 
     Status do_try_read(T& val) final
@@ -51,7 +57,41 @@ class BufferedChannel final : public Channel<T>
 
     Status do_await_read_until(T& val, const time_point_t& deadline) final
     {
-        return status(m_channel.pop_wait_until(std::ref(val), deadline));
+        return status(pop(val, &deadline));
+    }
+
+    Status do_await_write_n(std::span<T> values) final
+    {
+        for (auto& value : values)
+        {
+            auto rc = push(std::move(value));
+            if (rc != status_t::success)
+            {
+                return status(rc);
+            }
+        }
+        return Status::success;
+    }
+
+    // a single (potentially parking) pop followed by non-blocking pops; the reader is woken at most once per batch
+    Status do_await_read_n(std::vector<T>& values, std::size_t max_count, const time_point_t* deadline) final
+    {
+        auto& first = values.emplace_back();
+        auto rc     = (deadline == nullptr ? do_await_read(first) : do_await_read_until(first, *deadline));
+        if (rc != Status::success)
+        {
+            values.pop_back();
+            return rc;
+        }
+        for (std::size_t i = 1; i < max_count; i++)
+        {
+            if (m_channel.try_pop(std::ref(values.emplace_back())) != status_t::success)
+            {
+                values.pop_back();
+                break;
+            }
+        }
+        return Status::success;
     }
 
     void do_close_channel() final
@@ -64,6 +104,40 @@ class BufferedChannel final : public Channel<T>
         return m_channel.is_closed();
     }
 
+    std::size_t do_capacity() const final
+    {
+        // boost::fibers::buffered_channel keeps one slot open to distinguish full from empty
+        return m_capacity - 1;
+    }
+
+    // the blocking calls are only made, and timed, after the non-blocking attempt fails
+    status_t push(T&& val)
+    {
+        auto rc = m_channel.try_push(std::move(val));
+        if (rc != status_t::full)
+        {
+            return rc;
+        }
+        BlockedTimer timer(this->telemetry(), &ChannelTelemetry::record_blocked_writer);
+        return m_channel.push(std::move(val));
+    }
+
+    status_t pop(T& val, const time_point_t* deadline)
+    {
+        status_t rc;
+        if (this->resolve_without_parking([&] { return (rc = m_channel.try_pop(std::ref(val))) != status_t::empty; }))
+        {
+            return rc;
+        }
+        rc = m_channel.try_pop(std::ref(val));
+        if (rc != status_t::empty)
+        {
+            return rc;
+        }
+        BlockedTimer timer(this->telemetry(), &ChannelTelemetry::record_blocked_reader);
+        return (deadline == nullptr ? m_channel.pop(std::ref(val)) : m_channel.pop_wait_until(std::ref(val), *deadline));
+    }
+
     Status status(const status_t rc)
     {
         switch (rc)
@@ -82,6 +156,7 @@ class BufferedChannel final : public Channel<T>
         return Status::error;
     }
 
+    const std::size_t m_capacity;
     boost::fibers::buffered_channel<T> m_channel;
 };
 
@@ -18,12 +18,23 @@
 #pragma once
 
 #include "mrc/channel/egress.hpp"
+#include "mrc/channel/in_flight_budget.hpp"
 #include "mrc/channel/ingress.hpp"
 #include "mrc/channel/status.hpp"
+#include "mrc/channel/telemetry.hpp"
 #include "mrc/channel/types.hpp"
+#include "mrc/channel/wait_policy.hpp"
+#include "mrc/core/time_slice.hpp"
 #include "mrc/core/watcher.hpp"
 
+#include <algorithm>
+#include <atomic>
 #include <cstddef>
+#include <memory>
+#include <optional>
+#include <span>
+#include <utility>
+#include <vector>
 
 namespace mrc::channel {
 
@@ -52,6 +63,9 @@ struct ChannelBase
  * The channel interface was designed to mimic boost::fiber::buffered_channel but allow for alternative
  * implementations such as RecentChannel and NullChannel.
  *
+ * The blocking reads and writes are the yield points of TimeSlice: a fiber whose time slice has elapsed yields before
+ * the operation.
+ *
  * @note While Channel provides an close_channel and is_channel_closed method, these are rarely used in the MRC code
  * base. A Channel is most often owned by an object which then exposed a custom Ingress to that channel for which
  * the contract guarantees the channels is open and direct closure by writers is not allowed.
@@ -71,9 +85,43 @@ class Channel : public Ingress<T>, public Egress<T>, public Watchable, public Ch
     Status await_read_until(T& t, const time_point_t& tp) final;
     Status try_read(T& t) final;
 
+    Status await_write_n(std::span<T> values) final;
+    Status await_read_n(std::vector<T>& values, std::size_t max_count) final;
+    Status await_read_n(std::vector<T>& values, std::size_t max_count, const time_point_t& tp) final;
+
+    // capacity less occupancy of bounded channels
+    std::optional<std::size_t> writable_capacity() const final;
+
     void close_channel();
     bool is_channel_closed() const;
 
+    /**
+     * @brief Set how readers wait on an empty channel; must be set before the channel is shared with readers.
+     */
+    void set_wait_policy(const WaitPolicy& policy);
+    const WaitPolicy& wait_policy() const;
+    const WaitCounters& wait_counters() const;
+
+    /**
+     * @brief Charge the elements buffered in the channel to a budget shared with other channels; must be set before
+     * the channel is shared with writers.
+     */
+    void set_in_flight_budget(std::shared_ptr<InFlightBudget> budget);
+
+    /**
+     * @brief Occupancy, high-water mark and blocked reader/writer time of the channel
+     */
+    ChannelStatistics statistics() const;
+    void reset_high_water_mark();
+
+  protected:
+    ChannelTelemetry& telemetry();
+
+    // runs the spin/yield phases of the wait policy; returns true if try_fn resolved the wait, false if the caller
+    // must park
+    template <typename TryFnT>
+    bool resolve_without_parking(TryFnT&& try_fn);
+
   private:
     virtual Status do_await_write(T&&) = 0;
 
@@ -81,15 +129,65 @@ class Channel : public Ingress<T>, public Egress<T>, public Watchable, public Ch
     virtual Status do_await_read_until(T&, const time_point_t&) = 0;
     virtual Status do_try_read(T&)                              = 0;
 
+    // batched variants; the defaults are composed from the single element virtuals above, implementations which can
+    // amortize locking and wake-ups over a batch should override them
+    virtual Status do_await_write_n(std::span<T> values);
+    virtual Status do_await_read_n(std::vector<T>& values, std::size_t max_count, const time_point_t* deadline);
+
     virtual void do_close_channel()           = 0;
     virtual bool do_is_channel_closed() const = 0;
+
+    // number of elements the channel can hold before writers block; 0 if unbounded or unknown
+    virtual std::size_t do_capacity() const
+    {
+        return 0;
+    }
+
+    void charge_budget(std::size_t count)
+    {
+        if (m_in_flight_budget)
+        {
+            m_in_flight_budget->acquire(count * sizeof(T), m_budget_held);
+            m_budget_held.fetch_add(count * sizeof(T), std::memory_order_release);
+        }
+    }
+
+    void credit_budget(std::size_t count)
+    {
+        if (m_in_flight_budget && count > 0)
+        {
+            // clamped like the budget, elements of a failed batch write may be credited twice
+            auto held = m_budget_held.load(std::memory_order_relaxed);
+            while (!m_budget_held.compare_exchange_weak(
+                held, held - std::min(held, count * sizeof(T)), std::memory_order_release))
+            {}
+            m_in_flight_budget->release(count * sizeof(T));
+        }
+    }
+
+    ChannelTelemetry m_telemetry;
+    WaitPolicy m_wait_policy;
+    WaitCounters m_wait_counters;
+    std::shared_ptr<InFlightBudget> m_in_flight_budget;
+    // bytes of the elements of this channel charged to the budget
+    std::atomic<std::size_t> m_budget_held{0};
 };
 
 template <typename T>
 inline Status Channel<T>::await_write(T&& t)
 {
+    TimeSlice::checkpoint();
     WATCHER_PROLOGUE(WatchableEvent::channel_write);
+    charge_budget(1);
     auto rc = do_await_write(std::move(t));
+    if (rc == Status::success)
+    {
+        m_telemetry.record_writes(1);
+    }
+    else
+    {
+        credit_budget(1);
+    }
     WATCHER_EPILOGUE(WatchableEvent::channel_write, rc == Status::success);
     return rc;
 }
@@ -97,8 +195,14 @@ inline Status Channel<T>::await_write(T&& t)
 template <typename T>
 inline Status Channel<T>::await_read(T& t)
 {
+    TimeSlice::checkpoint();
     WATCHER_PROLOGUE(WatchableEvent::channel_read);
     auto rc = do_await_read(t);
+    if (rc == Status::success)
+    {
+        m_telemetry.record_reads(1);
+        credit_budget(1);
+    }
     WATCHER_EPILOGUE(WatchableEvent::channel_read, rc == Status::success);
     return rc;
 }
@@ -106,8 +210,14 @@ inline Status Channel<T>::await_read(T& t)
 template <typename T>
 inline Status Channel<T>::await_read_until(T& t, const time_point_t& tp)
 {
+    TimeSlice::checkpoint();
     WATCHER_PROLOGUE(WatchableEvent::channel_read);
     auto rc = do_await_read_until(t, tp);
+    if (rc == Status::success)
+    {
+        m_telemetry.record_reads(1);
+        credit_budget(1);
+    }
     WATCHER_EPILOGUE(WatchableEvent::channel_read, rc == Status::success);
     return rc;
 }
@@ -117,10 +227,97 @@ inline Status Channel<T>::try_read(T& t)
 {
     WATCHER_PROLOGUE(WatchableEvent::channel_read);
     auto rc = do_try_read(t);
+    if (rc == Status::success)
+    {
+        m_telemetry.record_reads(1);
+        credit_budget(1);
+    }
     WATCHER_EPILOGUE(WatchableEvent::channel_read, rc == Status::success);
     return rc;
 }
 
+template <typename T>
+Status Channel<T>::await_write_n(std::span<T> values)
+{
+    TimeSlice::checkpoint();
+    WATCHER_PROLOGUE(WatchableEvent::channel_write);
+    charge_budget(values.size());
+    auto rc = do_await_write_n(values);
+    if (rc == Status::success)
+    {
+        m_telemetry.record_writes(values.size());
+    }
+    else
+    {
+        // writes only fail on a closed channel; elements written before the failure may be credited twice as they are
+        // drained, which the budget clamps
+        credit_budget(values.size());
+    }
+    WATCHER_EPILOGUE(WatchableEvent::channel_write, rc == Status::success);
+    return rc;
+}
+
+template <typename T>
+Status Channel<T>::await_read_n(std::vector<T>& values, std::size_t max_count)
+{
+    TimeSlice::checkpoint();
+    WATCHER_PROLOGUE(WatchableEvent::channel_read);
+    const auto initial_size = values.size();
+    auto rc                 = do_await_read_n(values, max_count, nullptr);
+    m_telemetry.record_reads(values.size() - initial_size);
+    credit_budget(values.size() - initial_size);
+    WATCHER_EPILOGUE(WatchableEvent::channel_read, rc == Status::success);
+    return rc;
+}
+
+template <typename T>
+Status Channel<T>::await_read_n(std::vector<T>& values, std::size_t max_count, const time_point_t& tp)
+{
+    TimeSlice::checkpoint();
+    WATCHER_PROLOGUE(WatchableEvent::channel_read);
+    const auto initial_size = values.size();
+    auto rc                 = do_await_read_n(values, max_count, &tp);
+    m_telemetry.record_reads(values.size() - initial_size);
+    credit_budget(values.size() - initial_size);
+    WATCHER_EPILOGUE(WatchableEvent::channel_read, rc == Status::success);
+    return rc;
+}
+
+template <typename T>
+Status Channel<T>::do_await_write_n(std::span<T> values)
+{
+    for (auto& value : values)
+    {
+        auto rc = do_await_write(std::move(value));
+        if (rc != Status::success)
+        {
+            return rc;
+        }
+    }
+    return Status::success;
+}
+
+template <typename T>
+Status Channel<T>::do_await_read_n(std::vector<T>& values, std::size_t max_count, const time_point_t* deadline)
+{
+    auto& first = values.emplace_back();
+    auto rc     = (deadline == nullptr ? do_await_read(first) : do_await_read_until(first, *deadline));
+    if (rc != Status::success)
+    {
+        values.pop_back();
+        return rc;
+    }
+    for (std::size_t i = 1; i < max_count; i++)
+    {
+        if (do_try_read(values.emplace_back()) != Status::success)
+        {
+            values.pop_back();
+            break;
+        }
+    }
+    return Status::success;
+}
+
 template <typename T>
 inline void Channel<T>::close_channel()
 {
@@ -133,6 +330,71 @@ inline bool Channel<T>::is_channel_closed() const
     return do_is_channel_closed();
 }
 
+template <typename T>
+void Channel<T>::set_wait_policy(const WaitPolicy& policy)
+{
+    m_wait_policy = policy;
+}
+
+template <typename T>
+void Channel<T>::set_in_flight_budget(std::shared_ptr<InFlightBudget> budget)
+{
+    m_in_flight_budget = std::move(budget);
+}
+
+template <typename T>
+const WaitPolicy& Channel<T>::wait_policy() const
+{
+    return m_wait_policy;
+}
+
+template <typename T>
+const WaitCounters& Channel<T>::wait_counters() const
+{
+    return m_wait_counters;
+}
+
+template <typename T>
+ChannelStatistics Channel<T>::statistics() const
+{
+    return m_telemetry.statistics(do_capacity());
+}
+
+template <typename T>
+std::optional<std::size_t> Channel<T>::writable_capacity() const
+{
+    const auto capacity = do_capacity();
+    if (capacity == 0)
+    {
+        return std::nullopt;
+    }
+    const auto occupancy = m_telemetry.occupancy();
+    return (capacity > occupancy ? capacity - occupancy : 0);
+}
+
+template <typename T>
+void Channel<T>::reset_high_water_mark()
+{
+    m_telemetry.reset_high_water_mark();
+}
+
+template <typename T>
+ChannelTelemetry& Channel<T>::telemetry()
+{
+    return m_telemetry;
+}
+
+template <typename T>
+template <typename TryFnT>
+bool Channel<T>::resolve_without_parking(TryFnT&& try_fn)
+{
+    if (m_wait_policy.strategy == WaitStrategy::park)
+    {
+        return false;
+    }
+    return spin_before_park(m_wait_policy, m_wait_counters, std::forward<TryFnT>(try_fn));
+}
+
 }  // namespace mrc::channel
 
 namespace mrc {
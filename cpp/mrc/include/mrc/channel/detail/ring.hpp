@@ -0,0 +1,271 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <new>
+#include <utility>
+#include <vector>
+
+namespace mrc::channel {
+
+/**
+ * @brief Size used to pad the producer and consumer cursors of a ring onto separate cache lines.
+ */
+constexpr std::size_t ring_cache_line_size = 64;
+
+namespace detail {
+
+/**
+ * @brief Bounded single-producer/single-consumer ring. Each side owns its cursor and caches the other side's cursor
+ * so the shared cache line is only touched when the cached view says the ring is full/empty.
+ */
+template <typename T>
+class SpscRing
+{
+  public:
+    explicit SpscRing(std::size_t capacity) : m_mask(capacity - 1), m_slots(capacity) {}
+
+    ~SpscRing()
+    {
+        T discard;
+        while (try_pop(discard)) {}
+    }
+
+    bool try_push(T& val)
+    {
+        const auto tail = m_tail.load(std::memory_order_relaxed);
+        if (tail - m_cached_head == m_slots.size())
+        {
+            m_cached_head = m_head.load(std::memory_order_acquire);
+            if (tail - m_cached_head == m_slots.size())
+            {
+                return false;
+            }
+        }
+        m_slots[tail & m_mask].construct(std::move(val));
+        m_tail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool try_pop(T& val)
+    {
+        const auto head = m_head.load(std::memory_order_relaxed);
+        if (head == m_cached_tail)
+        {
+            m_cached_tail = m_tail.load(std::memory_order_acquire);
+            if (head == m_cached_tail)
+            {
+                return false;
+            }
+        }
+        m_slots[head & m_mask].extract(val);
+        m_head.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool empty() const
+    {
+        return m_head.load(std::memory_order_acquire) == m_tail.load(std::memory_order_acquire);
+    }
+
+    bool full() const
+    {
+        return m_tail.load(std::memory_order_acquire) - m_head.load(std::memory_order_acquire) == m_slots.size();
+    }
+
+    std::size_t size() const
+    {
+        return m_tail.load(std::memory_order_acquire) - m_head.load(std::memory_order_acquire);
+    }
+
+    std::size_t capacity() const
+    {
+        return m_slots.size();
+    }
+
+  private:
+    struct Slot
+    {
+        void construct(T&& val)
+        {
+            new (&m_storage) T(std::move(val));
+        }
+
+        void extract(T& val)
+        {
+            auto* ptr = std::launder(reinterpret_cast<T*>(&m_storage));
+            val       = std::move(*ptr);
+            ptr->~T();
+        }
+
+        alignas(T) std::byte m_storage[sizeof(T)];  // NOLINT
+    };
+
+    const std::size_t m_mask;
+    std::vector<Slot> m_slots;
+
+    // consumer owned
+    alignas(ring_cache_line_size) std::atomic<std::size_t> m_head{0};
+    std::size_t m_cached_tail{0};
+
+    // producer owned
+    alignas(ring_cache_line_size) std::atomic<std::size_t> m_tail{0};
+    std::size_t m_cached_head{0};
+};
+
+/**
+ * @brief Bounded multi-producer/multi-consumer ring using a per-slot sequence number to arbitrate ownership between
+ * competing producers and consumers (D. Vyukov's bounded MPMC queue).
+ */
+template <typename T>
+class MpmcRing
+{
+  public:
+    explicit MpmcRing(std::size_t capacity) : m_mask(capacity - 1), m_slots(capacity)
+    {
+        for (std::size_t i = 0; i < capacity; i++)
+        {
+            m_slots[i].m_sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    ~MpmcRing()
+    {
+        while (try_discard()) {}
+    }
+
+    bool try_push(T& val)
+    {
+        auto pos = m_enqueue_pos.load(std::memory_order_relaxed);
+        Slot* slot;
+        while (true)
+        {
+            slot           = &m_slots[pos & m_mask];
+            const auto seq = slot->m_sequence.load(std::memory_order_acquire);
+            const auto dif = static_cast<std::ptrdiff_t>(seq) - static_cast<std::ptrdiff_t>(pos);
+            if (dif == 0)
+            {
+                if (m_enqueue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                {
+                    break;
+                }
+            }
+            else if (dif < 0)
+            {
+                return false;
+            }
+            else
+            {
+                pos = m_enqueue_pos.load(std::memory_order_relaxed);
+            }
+        }
+        new (&slot->m_storage) T(std::move(val));
+        slot->m_sequence.store(pos + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool try_pop(T& val)
+    {
+        return pop_with([&val](T& front) { val = std::move(front); });
+    }
+
+    // drops the oldest element in place, without requiring T to be default constructible
+    bool try_discard()
+    {
+        return pop_with([](T& /*front*/) {});
+    }
+
+    bool empty() const
+    {
+        const auto pos = m_dequeue_pos.load(std::memory_order_acquire);
+        const auto seq = m_slots[pos & m_mask].m_sequence.load(std::memory_order_acquire);
+        return static_cast<std::ptrdiff_t>(seq) - static_cast<std::ptrdiff_t>(pos + 1) < 0;
+    }
+
+    bool full() const
+    {
+        const auto pos = m_enqueue_pos.load(std::memory_order_acquire);
+        const auto seq = m_slots[pos & m_mask].m_sequence.load(std::memory_order_acquire);
+        return static_cast<std::ptrdiff_t>(seq) - static_cast<std::ptrdiff_t>(pos) < 0;
+    }
+
+    // approximate under concurrent modification
+    std::size_t size() const
+    {
+        const auto head = m_dequeue_pos.load(std::memory_order_acquire);
+        const auto tail = m_enqueue_pos.load(std::memory_order_acquire);
+        return (tail > head ? tail - head : 0);
+    }
+
+    std::size_t capacity() const
+    {
+        return m_slots.size();
+    }
+
+  private:
+    template <typename ConsumeFnT>
+    bool pop_with(ConsumeFnT&& consume)
+    {
+        auto pos = m_dequeue_pos.load(std::memory_order_relaxed);
+        Slot* slot;
+        while (true)
+        {
+            slot           = &m_slots[pos & m_mask];
+            const auto seq = slot->m_sequence.load(std::memory_order_acquire);
+            const auto dif = static_cast<std::ptrdiff_t>(seq) - static_cast<std::ptrdiff_t>(pos + 1);
+            if (dif == 0)
+            {
+                if (m_dequeue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                {
+                    break;
+                }
+            }
+            else if (dif < 0)
+            {
+                return false;
+            }
+            else
+            {
+                pos = m_dequeue_pos.load(std::memory_order_relaxed);
+            }
+        }
+        auto* ptr = std::launder(reinterpret_cast<T*>(&slot->m_storage));
+        consume(*ptr);
+        ptr->~T();
+        slot->m_sequence.store(pos + m_mask + 1, std::memory_order_release);
+        return true;
+    }
+
+    struct Slot
+    {
+        std::atomic<std::size_t> m_sequence;
+        alignas(T) std::byte m_storage[sizeof(T)];  // NOLINT
+    };
+
+    const std::size_t m_mask;
+    std::vector<Slot> m_slots;
+
+    alignas(ring_cache_line_size) std::atomic<std::size_t> m_enqueue_pos{0};
+    alignas(ring_cache_line_size) std::atomic<std::size_t> m_dequeue_pos{0};
+};
+
+}  // namespace detail
+
+}  // namespace mrc::channel
@@ -20,6 +20,9 @@
 #include "mrc/channel/status.hpp"
 #include "mrc/channel/types.hpp"
 
+#include <cstddef>
+#include <vector>
+
 namespace mrc::channel {
 
 /**
@@ -35,6 +38,44 @@ struct Egress
     virtual Status await_read(T&)                            = 0;
     virtual Status await_read_until(T&, const time_point_t&) = 0;
     virtual Status try_read(T&)                              = 0;
+
+    /**
+     * @brief Block until at least one value is available, then append up to max_count values to values without
+     * blocking further.
+     *
+     * @return Status::success if at least one value was appended; otherwise the status of the blocking read
+     */
+    virtual Status await_read_n(std::vector<T>& values, std::size_t max_count)
+    {
+        return drain_after(await_read(values.emplace_back()), values, max_count);
+    }
+
+    /**
+     * @brief Same as await_read_n, but gives up waiting for the first value at deadline.
+     */
+    virtual Status await_read_n(std::vector<T>& values, std::size_t max_count, const time_point_t& deadline)
+    {
+        return drain_after(await_read_until(values.emplace_back(), deadline), values, max_count);
+    }
+
+  private:
+    Status drain_after(Status rc, std::vector<T>& values, std::size_t max_count)
+    {
+        if (rc != Status::success)
+        {
+            values.pop_back();
+            return rc;
+        }
+        for (std::size_t i = 1; i < max_count; i++)
+        {
+            if (try_read(values.emplace_back()) != Status::success)
+            {
+                values.pop_back();
+                break;
+            }
+        }
+        return Status::success;
+    }
 };
 
 }  // namespace mrc::channel
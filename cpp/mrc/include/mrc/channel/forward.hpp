@@ -41,4 +41,15 @@ class RecentChannel;
 template <typename T>
 class NullChannel;
 
+template <typename T>
+class PriorityChannel;
+
+template <typename T>
+class SpillChannel;
+
+enum class RingTopology;
+
+template <typename T, RingTopology TopologyV>
+class RingChannel;
+
 }  // namespace mrc::channel
@@ -0,0 +1,103 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "mrc/types.hpp"  // for CondV & Mutex
+#include "mrc/utils/macros.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <mutex>
+
+namespace mrc::channel {
+
+/**
+ * @brief Bound on the bytes buffered across a set of channels, e.g. the input channels of the nodes of a segment
+ *
+ * A write acquires the size of its elements before entering the channel and blocks the calling fiber while the budget
+ * is exhausted; a read releases them. A write is always admitted while nothing is in flight, so an element larger than
+ * the budget does not deadlock. Sizes are the shallow sizes of the elements, i.e. sizeof(T).
+ *
+ * Each channel holds a reserve of one write: a write into a channel which holds nothing against the budget is admitted
+ * even if the budget is exhausted. Otherwise the upstream stages of a pipeline sharing the budget could fill it while a
+ * downstream stage blocks on its write and never frees the credit of its input. The budget may therefore be exceeded
+ * by up to one write per channel.
+ */
+class InFlightBudget final
+{
+  public:
+    InFlightBudget(std::size_t limit_bytes) : m_limit(limit_bytes) {}
+    ~InFlightBudget() = default;
+
+    DELETE_COPYABILITY(InFlightBudget);
+    DELETE_MOVEABILITY(InFlightBudget);
+
+    /**
+     * @param bytes Size of the elements being written
+     * @param held Bytes the writing channel currently holds against the budget; the channel decrements it before the
+     * matching release
+     */
+    void acquire(std::size_t bytes, const std::atomic<std::size_t>& held)
+    {
+        std::unique_lock<Mutex> lock(m_mutex);
+        auto admit = [this, bytes, &held] {
+            return m_in_flight == 0 || held.load(std::memory_order_acquire) == 0 || m_in_flight + bytes <= m_limit;
+        };
+        if (!admit())
+        {
+            ++m_blocked;
+            m_cv.wait(lock, admit);
+        }
+        m_in_flight += bytes;
+    }
+
+    void release(std::size_t bytes)
+    {
+        std::lock_guard<Mutex> lock(m_mutex);
+        m_in_flight -= std::min(bytes, m_in_flight);
+        m_cv.notify_all();
+    }
+
+    std::size_t limit() const
+    {
+        return m_limit;
+    }
+
+    std::size_t in_flight() const
+    {
+        std::lock_guard<Mutex> lock(m_mutex);
+        return m_in_flight;
+    }
+
+    // number of writes which had to wait for the budget
+    std::size_t blocked_count() const
+    {
+        std::lock_guard<Mutex> lock(m_mutex);
+        return m_blocked;
+    }
+
+  private:
+    const std::size_t m_limit;
+    std::size_t m_in_flight{0};
+    std::size_t m_blocked{0};
+    mutable Mutex m_mutex;
+    CondV m_cv;
+};
+
+}  // namespace mrc::channel
@@ -19,6 +19,9 @@
 
 #include "mrc/channel/status.hpp"
 
+#include <cstddef>
+#include <optional>
+#include <span>
 #include <type_traits>  // IWYU pragma: export
 #include <utility>
 
@@ -51,6 +54,37 @@ struct Ingress : public IngressHandle
     {
         return await_write(std::move(t));
     }
+
+    /**
+     * @brief Write a batch of values; each value is moved out of the span.
+     *
+     * The default implementation forwards each element to await_write and stops on the first non-success status, in
+     * which case the elements prior to the failing element have been written. Channels override this to pay locking
+     * and wake-up costs once per batch.
+     */
+    virtual Status await_write_n(std::span<T> values)
+    {
+        for (auto& value : values)
+        {
+            auto rc = await_write(std::move(value));
+            if (rc != Status::success)
+            {
+                return rc;
+            }
+        }
+        return Status::success;
+    }
+
+    /**
+     * @brief Number of values which can be written before a writer blocks, i.e. the demand of the downstream.
+     *
+     * Empty if unknown, e.g. for unbounded channels or adaptors which do not map their writes one to one onto a
+     * channel. The value is a snapshot: concurrent readers and writers may change it once it is returned.
+     */
+    virtual std::optional<std::size_t> writable_capacity() const
+    {
+        return std::nullopt;
+    }
 };
 
 }  // namespace mrc::channel
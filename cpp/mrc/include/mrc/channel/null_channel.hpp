@@ -74,7 +74,7 @@ class NullChannel : public Channel<T>
 
     mutable Mutex m_mutex;
     CondV m_cv;
-    bool m_is_shutdown;
+    bool m_is_shutdown{false};
 };
 
 }  // namespace mrc::channel
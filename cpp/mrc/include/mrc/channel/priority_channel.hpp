@@ -0,0 +1,300 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "mrc/channel/channel.hpp"
+#include "mrc/channel/telemetry.hpp"
+#include "mrc/types.hpp"  // for CondV & Mutex
+
+#include <glog/logging.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <span>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace mrc::channel {
+
+namespace detail {
+
+template <typename T>
+struct is_priority_pair : std::false_type  // NOLINT
+{};
+
+template <typename PriorityT, typename ValueT>
+struct is_priority_pair<std::pair<PriorityT, ValueT>> : std::is_integral<PriorityT>  // NOLINT
+{};
+
+}  // namespace detail
+
+/**
+ * @brief Bounded channel which always yields the highest priority element first; elements of equal priority are
+ * yielded in FIFO order.
+ *
+ * The priority of an element is computed by the priority function when it is written. For `std::pair<int, U>` the
+ * default priority function returns `pair.first`; for any other T the priority function is a required constructor
+ * argument.
+ *
+ * Starvation protection: when `starvation_limit` is non-zero, after `starvation_limit` consecutive reads which bypassed
+ * the oldest element in the channel, the next read yields the oldest element regardless of its priority.
+ *
+ * A PriorityChannel can replace the default BufferedChannel of any SinkChannel via update_channel.
+ */
+template <typename T>
+class PriorityChannel final : public Channel<T>
+{
+  public:
+    using priority_t    = std::int64_t;
+    using priority_fn_t = std::function<priority_t(const T&)>;
+
+    // only `std::pair<int, U>` has a default priority function; any other T must be given one
+    explicit PriorityChannel(std::size_t buffer_size = default_channel_size())
+        requires detail::is_priority_pair<T>::value
+      : PriorityChannel(buffer_size, [](const T& data) { return static_cast<priority_t>(data.first); })
+    {}
+
+    PriorityChannel(std::size_t buffer_size, priority_fn_t priority_fn, std::size_t starvation_limit = 0) :
+      m_capacity(buffer_size),
+      m_priority_fn(std::move(priority_fn)),
+      m_starvation_limit(starvation_limit)
+    {
+        CHECK(m_priority_fn) << "PriorityChannel requires a priority function";
+    }
+
+    ~PriorityChannel() final = default;
+
+  private:
+    struct Entry
+    {
+        std::uint64_t sequence;
+        T value;
+    };
+
+    Status do_await_write(T&& val) final
+    {
+        auto priority = m_priority_fn(val);
+
+        std::unique_lock<Mutex> lock(m_mutex);
+        if (!wait_for_space(lock))
+        {
+            return Status::closed;
+        }
+        push_locked(priority, std::move(val));
+        m_readers_cv.notify_one();
+        return Status::success;
+    }
+
+    Status do_await_write_n(std::span<T> values) final
+    {
+        std::unique_lock<Mutex> lock(m_mutex);
+        bool pending = false;
+        for (auto& value : values)
+        {
+            // wake the readers before blocking on a full channel, otherwise nothing drains it
+            if (pending && m_size >= m_capacity)
+            {
+                m_readers_cv.notify_all();
+                pending = false;
+            }
+            if (!wait_for_space(lock))
+            {
+                return Status::closed;
+            }
+            push_locked(m_priority_fn(value), std::move(value));
+            pending = true;
+        }
+        if (pending)
+        {
+            m_readers_cv.notify_all();
+        }
+        return Status::success;
+    }
+
+    Status do_await_read(T& val) final
+    {
+        std::unique_lock<Mutex> lock(m_mutex);
+        if (m_size == 0 && !m_is_closed)
+        {
+            BlockedTimer timer(this->telemetry(), &ChannelTelemetry::record_blocked_reader);
+            m_readers_cv.wait(lock, [this] { return m_is_closed || m_size > 0; });
+        }
+        return pop_locked(val);
+    }
+
+    Status do_try_read(T& val) final
+    {
+        std::lock_guard<Mutex> lock(m_mutex);
+        if (m_size == 0)
+        {
+            return (m_is_closed ? Status::closed : Status::empty);
+        }
+        return pop_locked(val);
+    }
+
+    Status do_await_read_until(T& val, const time_point_t& deadline) final
+    {
+        std::unique_lock<Mutex> lock(m_mutex);
+        if (m_size == 0 && !m_is_closed)
+        {
+            BlockedTimer timer(this->telemetry(), &ChannelTelemetry::record_blocked_reader);
+            if (!m_readers_cv.wait_until(lock, deadline, [this] { return m_is_closed || m_size > 0; }))
+            {
+                return Status::timeout;
+            }
+        }
+        return pop_locked(val);
+    }
+
+    Status do_await_read_n(std::vector<T>& values, std::size_t max_count, const time_point_t* deadline) final
+    {
+        std::unique_lock<Mutex> lock(m_mutex);
+        if (m_size == 0 && !m_is_closed)
+        {
+            BlockedTimer timer(this->telemetry(), &ChannelTelemetry::record_blocked_reader);
+            auto ready = [this] { return m_is_closed || m_size > 0; };
+            if (deadline == nullptr)
+            {
+                m_readers_cv.wait(lock, ready);
+            }
+            else if (!m_readers_cv.wait_until(lock, *deadline, ready))
+            {
+                return Status::timeout;
+            }
+        }
+
+        auto rc = pop_locked(values.emplace_back());
+        if (rc != Status::success)
+        {
+            values.pop_back();
+            return rc;
+        }
+        for (std::size_t i = 1; i < max_count && m_size > 0; i++)
+        {
+            pop_locked(values.emplace_back());
+        }
+        return Status::success;
+    }
+
+    void do_close_channel() final
+    {
+        std::lock_guard<Mutex> lock(m_mutex);
+        m_is_closed = true;
+        m_readers_cv.notify_all();
+        m_writers_cv.notify_all();
+    }
+
+    bool do_is_channel_closed() const final
+    {
+        std::lock_guard<Mutex> lock(m_mutex);
+        return m_is_closed;
+    }
+
+    std::size_t do_capacity() const final
+    {
+        return m_capacity;
+    }
+
+    // returns false if the channel was closed
+    bool wait_for_space(std::unique_lock<Mutex>& lock)
+    {
+        if (m_size >= m_capacity && !m_is_closed)
+        {
+            BlockedTimer timer(this->telemetry(), &ChannelTelemetry::record_blocked_writer);
+            m_writers_cv.wait(lock, [this] { return m_is_closed || m_size < m_capacity; });
+        }
+        return !m_is_closed;
+    }
+
+    void push_locked(priority_t priority, T&& val)
+    {
+        m_levels[priority].push_back(Entry{m_next_sequence++, std::move(val)});
+        m_size++;
+    }
+
+    // elements remaining in a closed channel are drained before closed is reported
+    Status pop_locked(T& val)
+    {
+        if (m_size == 0)
+        {
+            return (m_is_closed ? Status::closed : Status::timeout);
+        }
+
+        // the highest priority level is the first level in the map
+        auto level = m_levels.begin();
+
+        if (m_starvation_limit > 0)
+        {
+            auto oldest = level;
+            for (auto it = std::next(level); it != m_levels.end(); ++it)
+            {
+                if (it->second.front().sequence < oldest->second.front().sequence)
+                {
+                    oldest = it;
+                }
+            }
+
+            if (oldest == level)
+            {
+                m_bypass_count = 0;
+            }
+            else if (++m_bypass_count > m_starvation_limit)
+            {
+                level          = oldest;
+                m_bypass_count = 0;
+            }
+        }
+
+        val = std::move(level->second.front().value);
+        level->second.pop_front();
+        if (level->second.empty())
+        {
+            m_levels.erase(level);
+        }
+        m_size--;
+        m_writers_cv.notify_one();
+        return Status::success;
+    }
+
+    const std::size_t m_capacity;
+    const priority_fn_t m_priority_fn;
+    const std::size_t m_starvation_limit;
+
+    mutable Mutex m_mutex;
+    CondV m_readers_cv;
+    CondV m_writers_cv;
+    bool m_is_closed{false};
+    std::size_t m_size{0};
+    std::size_t m_bypass_count{0};
+    std::uint64_t m_next_sequence{0};
+    std::map<priority_t, std::deque<Entry>, std::greater<>> m_levels;
+};
+
+}  // namespace mrc::channel
+
+namespace mrc {
+
+template <typename T>
+using PriorityChannel = channel::PriorityChannel<T>;  // NOLINT
+
+}
@@ -18,112 +18,216 @@
 #pragma once
 
 #include "mrc/channel/channel.hpp"
+#include "mrc/channel/detail/ring.hpp"
+#include "mrc/channel/telemetry.hpp"
 #include "mrc/types.hpp"  // for CondV & Mutex
 
-#include <boost/fiber/mutex.hpp>
-
+#include <algorithm>
+#include <atomic>
 #include <cstddef>  // for size_t
-#include <deque>
+#include <cstdint>
 #include <mutex>
-#include <thread>  // for lock_guard & unique_lock
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <vector>
 
 namespace mrc::channel {
 
+/**
+ * @brief Channel which never blocks writers; when full, the oldest element is overwritten (dropped) in favor of the
+ * newest, i.e. "latest wins".
+ *
+ * Elements are stored in a fixed-capacity lock-free ring allocated up-front, so writes do not allocate. A writer which
+ * finds the channel full evicts the oldest element with a non-blocking pop, making room for its own element; every
+ * eviction is counted and reported by dropped_count() and statistics().dropped.
+ *
+ * Readers only take the fiber Mutex when the channel is empty.
+ *
+ * @note A read after the channel has been closed returns Status::closed, even if elements remain in the channel.
+ */
 template <typename T>
 class RecentChannel : public Channel<T>
 {
   public:
-    RecentChannel(std::size_t count = default_channel_size()) : m_max_size(count) {}
+    RecentChannel(std::size_t count = default_channel_size()) : m_max_size(count), m_ring(ring_size(count)) {}
     ~RecentChannel() override = default;
 
+    /**
+     * @brief Number of elements overwritten before they could be read
+     */
+    std::uint64_t dropped_count() const
+    {
+        return this->statistics().dropped;
+    }
+
   private:
-    Status do_await_write(T&& data) override
+    static std::size_t ring_size(std::size_t count)
     {
-        std::lock_guard<Mutex> lock(m_mutex);
-        if (m_is_shutdown)
+        if (count == 0)
         {
-            return Status::closed;
+            throw std::invalid_argument("RecentChannel count must be greater than 0");
         }
-        if (m_deque.size() >= m_max_size)
+
+        // the ring requires a power of 2; the logical capacity is enforced by m_max_size
+        std::size_t size = 2;
+        while (size < count)
         {
-            m_deque.pop_front();
+            size <<= 1;
         }
-        m_deque.push_back(std::move(data));
-        m_cv.notify_one();
-        return Status::success;
+        return size;
     }
 
-    Status do_await_read(T& data) override
+    void push_overwrite(T& data)
     {
-        std::unique_lock<Mutex> lock(m_mutex);
-        while (m_deque.empty() && !m_is_shutdown)
+        while (m_ring.size() >= m_max_size || !m_ring.try_push(data))
         {
-            m_cv.wait(lock, [this] { return m_is_shutdown || !m_deque.empty(); });
+            if (m_ring.try_discard())
+            {
+                this->telemetry().record_dropped(1);
+            }
         }
-        if (m_is_shutdown)
+    }
+
+    void notify_readers()
+    {
+        // pairs with the seq_cst increment of m_waiting_readers; see RingChannel::notify
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (m_waiting_readers.load(std::memory_order_relaxed) > 0)
+        {
+            std::lock_guard<Mutex> lock(m_mutex);
+            m_cv.notify_all();
+        }
+    }
+
+    Status do_await_write(T&& data) override
+    {
+        if (m_is_shutdown.load(std::memory_order_acquire))
         {
             return Status::closed;
         }
-        data = std::move(m_deque.front());
-        m_deque.pop_front();
+        push_overwrite(data);
+        notify_readers();
         return Status::success;
     }
 
-    Status do_try_read(T& data) override
+    Status do_await_write_n(std::span<T> values) override
     {
-        std::unique_lock<Mutex> lock(m_mutex);
-        if (m_is_shutdown)
+        if (m_is_shutdown.load(std::memory_order_acquire))
         {
             return Status::closed;
         }
-        if (m_deque.empty())
+        for (auto& value : values)
         {
-            return Status::empty;
+            push_overwrite(value);
         }
-        data = std::move(m_deque.front());
-        m_deque.pop_front();
+        notify_readers();
         return Status::success;
     }
 
-    Status do_await_read_until(T& data, const time_point_t& deadline) override
+    Status do_try_read(T& data) override
     {
-        std::unique_lock<Mutex> lock(m_mutex);
+        if (m_is_shutdown.load(std::memory_order_acquire))
+        {
+            return Status::closed;
+        }
+        return (m_ring.try_pop(data) ? Status::success : Status::empty);
+    }
 
-        while (m_deque.empty() && !m_is_shutdown && deadline < clock_t::now())
+    template <typename WaitFnT>
+    Status await_read_impl(T& data, WaitFnT&& wait_fn)
+    {
+        Status rc;
+        if (this->resolve_without_parking([&] { return (rc = do_try_read(data)) != Status::empty; }))
         {
-            m_cv.wait_until(lock, deadline, [this] { return m_is_shutdown || !m_deque.empty(); });
+            return rc;
         }
-        if (m_is_shutdown)
+
+        std::optional<BlockedTimer> blocked;
+        while (true)
         {
-            return Status::closed;
+            rc = do_try_read(data);
+            if (rc != Status::empty)
+            {
+                return rc;
+            }
+
+            if (!blocked)
+            {
+                blocked.emplace(this->telemetry(), &ChannelTelemetry::record_blocked_reader);
+            }
+            std::unique_lock<Mutex> lock(m_mutex);
+            m_waiting_readers.fetch_add(1, std::memory_order_seq_cst);
+            auto ready = wait_fn(lock, [this] { return m_is_shutdown.load() || !m_ring.empty(); });
+            m_waiting_readers.fetch_sub(1, std::memory_order_relaxed);
+
+            if (!ready)
+            {
+                return Status::timeout;
+            }
+        }
+    }
+
+    Status do_await_read(T& data) override
+    {
+        return await_read_impl(data, [this](auto& lock, auto&& pred) {
+            m_cv.wait(lock, pred);
+            return true;
+        });
+    }
+
+    Status do_await_read_until(T& data, const time_point_t& deadline) override
+    {
+        return await_read_impl(data, [this, &deadline](auto& lock, auto&& pred) {
+            return m_cv.wait_until(lock, deadline, pred);
+        });
+    }
+
+    Status do_await_read_n(std::vector<T>& values, std::size_t max_count, const time_point_t* deadline) override
+    {
+        auto& first = values.emplace_back();
+        auto rc     = (deadline == nullptr ? do_await_read(first) : do_await_read_until(first, *deadline));
+        if (rc != Status::success)
+        {
+            values.pop_back();
+            return rc;
         }
-        if (m_deque.empty())
+        for (std::size_t i = 1; i < max_count; i++)
         {
-            return Status::timeout;
+            if (!m_ring.try_pop(values.emplace_back()))
+            {
+                values.pop_back();
+                break;
+            }
         }
-        data = std::move(m_deque.front());
-        m_deque.pop_front();
         return Status::success;
     }
 
     void do_close_channel() override
     {
         std::lock_guard<Mutex> lock(m_mutex);
-        m_is_shutdown = true;
+        m_is_shutdown.store(true, std::memory_order_release);
         m_cv.notify_all();
     }
 
     bool do_is_channel_closed() const override
     {
-        std::lock_guard<Mutex> lock(m_mutex);
-        return m_is_shutdown;
+        return m_is_shutdown.load(std::memory_order_acquire);
+    }
+
+    std::size_t do_capacity() const override
+    {
+        return m_max_size;
     }
 
-    mutable Mutex m_mutex;
+    const std::size_t m_max_size;
+    detail::MpmcRing<T> m_ring;
+
+    std::atomic<bool> m_is_shutdown{false};
+    std::atomic<std::size_t> m_waiting_readers{0};
+
+    Mutex m_mutex;
     CondV m_cv;
-    bool m_is_shutdown{false};
-    std::size_t m_max_size;
-    std::deque<T> m_deque;
 };
 
 }  // namespace mrc::channel
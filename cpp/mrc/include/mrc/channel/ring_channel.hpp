@@ -0,0 +1,418 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "mrc/channel/channel.hpp"
+#include "mrc/channel/detail/ring.hpp"
+#include "mrc/channel/telemetry.hpp"
+#include "mrc/channel/types.hpp"
+#include "mrc/types.hpp"  // for CondV & Mutex
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace mrc::channel {
+
+/**
+ * @brief Producer/consumer topology of a RingChannel.
+ *
+ * spsc is only valid when exactly one fiber/thread writes and exactly one fiber/thread reads at any given time; mpmc
+ * makes no such assumption.
+ */
+enum class RingTopology
+{
+    spsc,
+    mpmc,
+};
+
+/**
+ * @brief Bounds and thresholds for a RingChannel whose capacity adapts to the observed stall ratio.
+ *
+ * Every `evaluation_interval` reads, the share of blocked time attributed to writers over the elapsed interval is
+ * computed: writer_blocked / (writer_blocked + reader_blocked). Above `grow_threshold` the producer is being stalled
+ * by a full channel and the capacity is doubled; below `shrink_threshold` the consumer is mostly waiting on an empty
+ * channel and the capacity is halved, reducing the number of in-flight elements held by the edge.
+ */
+struct RingAutoTuneOptions
+{
+    std::size_t min_capacity{16};
+    std::size_t max_capacity{1024};
+    std::size_t evaluation_interval{1024};
+    double grow_threshold{0.75};
+    double shrink_threshold{0.25};
+};
+
+/**
+ * @brief Channel backed by a bounded lock-free ring.
+ *
+ * The fast path of both await_write and await_read is a single lock-free push/pop. The fiber Mutex and CondV are only
+ * touched when a writer finds the ring full or a reader finds it empty, and a successful push/pop only takes the lock
+ * to notify when the opposite side has registered itself as waiting.
+ *
+ * Unlike BufferedChannel, the full capacity of the ring is usable, i.e. a RingChannel of size N holds N elements.
+ *
+ * When constructed with RingAutoTuneOptions, the ring is allocated at max_capacity and writers are held to a soft
+ * capacity limit which is adjusted between min_capacity and max_capacity.
+ *
+ * @tparam T
+ * @tparam TopologyV RingTopology::spsc if the edge has exactly one writer and one reader, otherwise RingTopology::mpmc
+ */
+template <typename T, RingTopology TopologyV = RingTopology::mpmc>
+class RingChannel final : public Channel<T>
+{
+    using ring_t = std::conditional_t<TopologyV == RingTopology::spsc, detail::SpscRing<T>, detail::MpmcRing<T>>;
+
+  public:
+    RingChannel(std::size_t buffer_size = default_channel_size()) :
+      m_ring(validate_size(buffer_size)),
+      m_capacity_limit(buffer_size)
+    {}
+
+    RingChannel(RingAutoTuneOptions options) :
+      m_ring(validate_size(options.max_capacity)),
+      m_auto_tune(true),
+      m_options(validate_options(options)),
+      m_capacity_limit(options.min_capacity)
+    {}
+
+    ~RingChannel() final = default;
+
+  private:
+    static std::size_t validate_size(std::size_t buffer_size)
+    {
+        if (buffer_size < 2 || ((buffer_size & (buffer_size - 1)) != 0))
+        {
+            throw std::invalid_argument("RingChannel buffer_size must be greater than 1 and a power of 2.");
+        }
+        return buffer_size;
+    }
+
+    static RingAutoTuneOptions validate_options(const RingAutoTuneOptions& options)
+    {
+        if (options.min_capacity == 0 || options.min_capacity > options.max_capacity)
+        {
+            throw std::invalid_argument("RingAutoTuneOptions requires 0 < min_capacity <= max_capacity");
+        }
+        if (options.evaluation_interval == 0 || options.shrink_threshold > options.grow_threshold)
+        {
+            throw std::invalid_argument(
+                "RingAutoTuneOptions requires evaluation_interval > 0 and shrink_threshold <= grow_threshold");
+        }
+        return options;
+    }
+
+    bool is_full() const
+    {
+        if (m_auto_tune)
+        {
+            return m_ring.size() >= m_capacity_limit.load(std::memory_order_relaxed);
+        }
+        return m_ring.full();
+    }
+
+    bool try_push(T& val)
+    {
+        return (!m_auto_tune || !is_full()) && m_ring.try_push(val);
+    }
+
+    Status do_await_write(T&& val) final
+    {
+        std::optional<BlockedTimer> blocked;
+        while (true)
+        {
+            if (m_is_closed.load(std::memory_order_acquire))
+            {
+                return Status::closed;
+            }
+            if (try_push(val))
+            {
+                notify(m_waiting_readers, m_readers_cv);
+                return Status::success;
+            }
+
+            if (!blocked)
+            {
+                blocked.emplace(this->telemetry(), &ChannelTelemetry::record_blocked_writer);
+            }
+            std::unique_lock<Mutex> lock(m_mutex);
+            m_waiting_writers.fetch_add(1, std::memory_order_seq_cst);
+            m_writers_cv.wait(lock, [this] { return m_is_closed.load() || !is_full(); });
+            m_waiting_writers.fetch_sub(1, std::memory_order_relaxed);
+        }
+    }
+
+    Status do_await_read(T& val) final
+    {
+        Status rc;
+        if (this->resolve_without_parking([&] { return (rc = do_try_read(val)) != Status::empty; }))
+        {
+            return rc;
+        }
+
+        std::optional<BlockedTimer> blocked;
+        while (true)
+        {
+            rc = do_try_read(val);
+            if (rc != Status::empty)
+            {
+                return rc;
+            }
+
+            if (!blocked)
+            {
+                blocked.emplace(this->telemetry(), &ChannelTelemetry::record_blocked_reader);
+            }
+            std::unique_lock<Mutex> lock(m_mutex);
+            m_waiting_readers.fetch_add(1, std::memory_order_seq_cst);
+            m_readers_cv.wait(lock, [this] { return m_is_closed.load() || !m_ring.empty(); });
+            m_waiting_readers.fetch_sub(1, std::memory_order_relaxed);
+        }
+    }
+
+    Status do_try_read(T& val) final
+    {
+        // check closed before popping so that an element pushed prior to close is always drained
+        const bool closed = m_is_closed.load(std::memory_order_acquire);
+        if (m_ring.try_pop(val))
+        {
+            notify(m_waiting_writers, m_writers_cv);
+            maybe_tune(1);
+            return Status::success;
+        }
+        return (closed ? Status::closed : Status::empty);
+    }
+
+    Status do_await_read_until(T& val, const time_point_t& deadline) final
+    {
+        Status rc;
+        if (this->resolve_without_parking([&] { return (rc = do_try_read(val)) != Status::empty; }))
+        {
+            return rc;
+        }
+
+        std::optional<BlockedTimer> blocked;
+        while (true)
+        {
+            rc = do_try_read(val);
+            if (rc != Status::empty)
+            {
+                return rc;
+            }
+
+            if (!blocked)
+            {
+                blocked.emplace(this->telemetry(), &ChannelTelemetry::record_blocked_reader);
+            }
+            std::unique_lock<Mutex> lock(m_mutex);
+            m_waiting_readers.fetch_add(1, std::memory_order_seq_cst);
+            auto ready =
+                m_readers_cv.wait_until(lock, deadline, [this] { return m_is_closed.load() || !m_ring.empty(); });
+            m_waiting_readers.fetch_sub(1, std::memory_order_relaxed);
+
+            if (!ready)
+            {
+                return Status::timeout;
+            }
+        }
+    }
+
+    Status do_await_write_n(std::span<T> values) final
+    {
+        std::optional<BlockedTimer> blocked;
+        std::size_t written = 0;
+        while (written < values.size())
+        {
+            if (m_is_closed.load(std::memory_order_acquire))
+            {
+                return Status::closed;
+            }
+
+            const auto start = written;
+            while (written < values.size() && try_push(values[written]))
+            {
+                written++;
+            }
+            if (written != start)
+            {
+                notify(m_waiting_readers, m_readers_cv);
+                continue;
+            }
+
+            if (!blocked)
+            {
+                blocked.emplace(this->telemetry(), &ChannelTelemetry::record_blocked_writer);
+            }
+            std::unique_lock<Mutex> lock(m_mutex);
+            m_waiting_writers.fetch_add(1, std::memory_order_seq_cst);
+            m_writers_cv.wait(lock, [this] { return m_is_closed.load() || !is_full(); });
+            m_waiting_writers.fetch_sub(1, std::memory_order_relaxed);
+        }
+        return Status::success;
+    }
+
+    Status do_await_read_n(std::vector<T>& values, std::size_t max_count, const time_point_t* deadline) final
+    {
+        auto& first = values.emplace_back();
+        auto rc     = (deadline == nullptr ? do_await_read(first) : do_await_read_until(first, *deadline));
+        if (rc != Status::success)
+        {
+            values.pop_back();
+            return rc;
+        }
+
+        std::size_t count = 1;
+        for (; count < max_count; count++)
+        {
+            if (!m_ring.try_pop(values.emplace_back()))
+            {
+                values.pop_back();
+                break;
+            }
+        }
+        if (count > 1)
+        {
+            notify(m_waiting_writers, m_writers_cv);
+            maybe_tune(count - 1);
+        }
+        return Status::success;
+    }
+
+    void do_close_channel() final
+    {
+        std::lock_guard<Mutex> lock(m_mutex);
+        m_is_closed.store(true, std::memory_order_release);
+        m_readers_cv.notify_all();
+        m_writers_cv.notify_all();
+    }
+
+    bool do_is_channel_closed() const final
+    {
+        return m_is_closed.load(std::memory_order_acquire);
+    }
+
+    std::size_t do_capacity() const final
+    {
+        return m_capacity_limit.load(std::memory_order_relaxed);
+    }
+
+    // the seq_cst fence pairs with the seq_cst increment of the waiter count made before the predicate is evaluated
+    // under the lock; either the waiter observes the new ring state or we observe the waiter
+    void notify(std::atomic<std::size_t>& waiters, CondV& cv)
+    {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (waiters.load(std::memory_order_relaxed) > 0)
+        {
+            std::lock_guard<Mutex> lock(m_mutex);
+            cv.notify_one();
+        }
+    }
+
+    void maybe_tune(std::size_t reads)
+    {
+        if (!m_auto_tune ||
+            m_reads_since_tune.fetch_add(reads, std::memory_order_relaxed) + reads < m_options.evaluation_interval ||
+            m_tuning.exchange(true, std::memory_order_acquire))
+        {
+            return;
+        }
+
+        m_reads_since_tune.store(0, std::memory_order_relaxed);
+
+        const auto writer_time = this->telemetry().blocked_writer_time();
+        const auto reader_time = this->telemetry().blocked_reader_time();
+        const auto writer_wait = (writer_time - m_last_writer_time).count();
+        const auto reader_wait = (reader_time - m_last_reader_time).count();
+        m_last_writer_time     = writer_time;
+        m_last_reader_time     = reader_time;
+
+        if (writer_wait + reader_wait > 0)
+        {
+            const double writer_share = static_cast<double>(writer_wait) / static_cast<double>(writer_wait + reader_wait);
+            const auto limit          = m_capacity_limit.load(std::memory_order_relaxed);
+
+            if (writer_share > m_options.grow_threshold && limit < m_options.max_capacity)
+            {
+                m_capacity_limit.store(std::min(limit * 2, m_options.max_capacity), std::memory_order_relaxed);
+
+                // writers held by the old limit must re-evaluate
+                std::lock_guard<Mutex> lock(m_mutex);
+                m_writers_cv.notify_all();
+            }
+            else if (writer_share < m_options.shrink_threshold && limit > m_options.min_capacity)
+            {
+                m_capacity_limit.store(std::max(limit / 2, m_options.min_capacity), std::memory_order_relaxed);
+            }
+        }
+
+        m_tuning.store(false, std::memory_order_release);
+    }
+
+    ring_t m_ring;
+
+    const bool m_auto_tune{false};
+    const RingAutoTuneOptions m_options{};
+    std::atomic<std::size_t> m_capacity_limit;
+    std::atomic<std::size_t> m_reads_since_tune{0};
+    std::atomic<bool> m_tuning{false};
+    duration_t m_last_writer_time{0};
+    duration_t m_last_reader_time{0};
+
+    alignas(ring_cache_line_size) std::atomic<bool> m_is_closed{false};
+    std::atomic<std::size_t> m_waiting_readers{0};
+    std::atomic<std::size_t> m_waiting_writers{0};
+
+    Mutex m_mutex;
+    CondV m_readers_cv;
+    CondV m_writers_cv;
+};
+
+/**
+ * @brief Construct a RingChannel specialized for the given number of concurrent writers and readers.
+ *
+ * @param buffer_size must be a power of 2
+ * @param writers number of concurrent writers, i.e. the number of upstream runnables connected to the edge
+ * @param readers number of concurrent readers, i.e. the number of runnables draining the channel
+ */
+template <typename T>
+std::unique_ptr<Channel<T>> make_ring_channel(std::size_t buffer_size = default_channel_size(),
+                                              std::size_t writers     = 1,
+                                              std::size_t readers     = 1)
+{
+    if (writers == 1 && readers == 1)
+    {
+        return std::make_unique<RingChannel<T, RingTopology::spsc>>(buffer_size);
+    }
+    return std::make_unique<RingChannel<T, RingTopology::mpmc>>(buffer_size);
+}
+
+}  // namespace mrc::channel
+
+namespace mrc {
+
+template <typename T, channel::RingTopology TopologyV = channel::RingTopology::mpmc>
+using RingChannel = channel::RingChannel<T, TopologyV>;  // NOLINT
+
+}
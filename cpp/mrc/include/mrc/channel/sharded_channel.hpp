@@ -0,0 +1,285 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2021-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "mrc/channel/channel.hpp"
+#include "mrc/channel/telemetry.hpp"
+#include "mrc/types.hpp"  // for CondV & Mutex
+
+#include <boost/fiber/fss.hpp>
+#include <glog/logging.h>
+
+#include <atomic>
+#include <cstddef>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace mrc::channel {
+
+/**
+ * @brief Bounded multi-consumer channel which splits its elements over per-reader shards
+ *
+ * Writers distribute elements round-robin over the shards. Each reader fiber is assigned a home shard on its first
+ * read and only contends with the writers and the other readers of that shard; once its home shard is drained a reader
+ * steals from the other shards before blocking. The buffer size bounds the elements held across all shards;
+ * concurrent writers may exceed it by at most one element each.
+ *
+ * Elements are yielded in FIFO order per shard, not across the channel. Readers block on a channel-wide condition
+ * variable, so the sharding pays off when many readers are busy rather than parked; with a single reader use a
+ * BufferedChannel instead.
+ */
+template <typename T>
+class ShardedChannel final : public Channel<T>
+{
+  public:
+    ShardedChannel(std::size_t shard_count, std::size_t buffer_size = default_channel_size()) : m_capacity(buffer_size)
+    {
+        CHECK_GT(shard_count, 0);
+        CHECK_GT(m_capacity, 0);
+        m_shards.reserve(shard_count);
+        for (std::size_t i = 0; i < shard_count; i++)
+        {
+            m_shards.push_back(std::make_unique<Shard>());
+        }
+    }
+
+    ~ShardedChannel() final = default;
+
+    std::size_t shard_count() const
+    {
+        return m_shards.size();
+    }
+
+  private:
+    struct Shard
+    {
+        Mutex mutex;
+        std::deque<T> data;
+    };
+
+    Status do_await_write(T&& val) final
+    {
+        if (!wait_for_space())
+        {
+            return Status::closed;
+        }
+
+        auto& shard = *m_shards[m_next_write.fetch_add(1, std::memory_order_relaxed) % m_shards.size()];
+        {
+            std::lock_guard<Mutex> lock(shard.mutex);
+            shard.data.push_back(std::move(val));
+        }
+        m_size.fetch_add(1);
+
+        if (m_waiting_readers.load() > 0)
+        {
+            std::lock_guard<Mutex> lock(m_mutex);
+            m_readers_cv.notify_one();
+        }
+        return Status::success;
+    }
+
+    Status do_await_read(T& val) final
+    {
+        return read_until(val, nullptr);
+    }
+
+    Status do_await_read_until(T& val, const time_point_t& deadline) final
+    {
+        return read_until(val, &deadline);
+    }
+
+    Status do_try_read(T& val) final
+    {
+        if (try_pop(val))
+        {
+            return Status::success;
+        }
+        return (m_is_closed.load() && m_size.load() == 0 ? Status::closed : Status::empty);
+    }
+
+    Status do_await_read_n(std::vector<T>& values, std::size_t max_count, const time_point_t* deadline) final
+    {
+        auto rc = read_until(values.emplace_back(), deadline);
+        if (rc != Status::success)
+        {
+            values.pop_back();
+            return rc;
+        }
+
+        // the rest of the batch is drained from the home shard under a single lock
+        std::size_t count = 0;
+        {
+            auto& shard = *m_shards[home_shard()];
+            std::lock_guard<Mutex> lock(shard.mutex);
+            while (values.size() < max_count && !shard.data.empty())
+            {
+                values.push_back(std::move(shard.data.front()));
+                shard.data.pop_front();
+                count++;
+            }
+        }
+        if (count > 0)
+        {
+            on_popped(count);
+        }
+        return Status::success;
+    }
+
+    void do_close_channel() final
+    {
+        std::lock_guard<Mutex> lock(m_mutex);
+        m_is_closed.store(true);
+        m_readers_cv.notify_all();
+        m_writers_cv.notify_all();
+    }
+
+    bool do_is_channel_closed() const final
+    {
+        return m_is_closed.load();
+    }
+
+    std::size_t do_capacity() const final
+    {
+        return m_capacity;
+    }
+
+    // elements remaining in a closed channel are drained before closed is reported
+    Status read_until(T& val, const time_point_t* deadline)
+    {
+        while (!try_pop(val))
+        {
+            std::unique_lock<Mutex> lock(m_mutex);
+            m_waiting_readers.fetch_add(1);
+            auto ready = [this] { return m_is_closed.load() || m_size.load() > 0; };
+
+            bool timed_out = false;
+            if (!ready())
+            {
+                BlockedTimer timer(this->telemetry(), &ChannelTelemetry::record_blocked_reader);
+                if (deadline == nullptr)
+                {
+                    m_readers_cv.wait(lock, ready);
+                }
+                else
+                {
+                    timed_out = !m_readers_cv.wait_until(lock, *deadline, ready);
+                }
+            }
+            m_waiting_readers.fetch_sub(1);
+
+            if (timed_out)
+            {
+                return Status::timeout;
+            }
+            if (m_is_closed.load() && m_size.load() == 0)
+            {
+                return Status::closed;
+            }
+        }
+        return Status::success;
+    }
+
+    // pops from the home shard of the calling fiber, then steals from the other shards in order
+    bool try_pop(T& val)
+    {
+        if (m_size.load() == 0)
+        {
+            return false;
+        }
+
+        const auto home = home_shard();
+        for (std::size_t i = 0; i < m_shards.size(); i++)
+        {
+            auto& shard = *m_shards[(home + i) % m_shards.size()];
+            std::unique_lock<Mutex> lock(shard.mutex);
+            if (!shard.data.empty())
+            {
+                val = std::move(shard.data.front());
+                shard.data.pop_front();
+                lock.unlock();
+                on_popped(1);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void on_popped(std::size_t count)
+    {
+        m_size.fetch_sub(count);
+        if (m_waiting_writers.load() > 0)
+        {
+            std::lock_guard<Mutex> lock(m_mutex);
+            m_writers_cv.notify_all();
+        }
+    }
+
+    // returns false if the channel was closed
+    bool wait_for_space()
+    {
+        if (m_size.load() >= m_capacity && !m_is_closed.load())
+        {
+            std::unique_lock<Mutex> lock(m_mutex);
+            m_waiting_writers.fetch_add(1);
+            BlockedTimer timer(this->telemetry(), &ChannelTelemetry::record_blocked_writer);
+            m_writers_cv.wait(lock, [this] { return m_is_closed.load() || m_size.load() < m_capacity; });
+            m_waiting_writers.fetch_sub(1);
+        }
+        return !m_is_closed.load();
+    }
+
+    std::size_t home_shard()
+    {
+        auto* home = m_home_shard.get();
+        if (home == nullptr)
+        {
+            home = new std::size_t(m_next_reader.fetch_add(1, std::memory_order_relaxed));
+            m_home_shard.reset(home);
+        }
+        return *home % m_shards.size();
+    }
+
+    const std::size_t m_capacity;
+    std::vector<std::unique_ptr<Shard>> m_shards;
+
+    std::atomic<std::size_t> m_size{0};
+    std::atomic<std::size_t> m_next_write{0};
+    std::atomic<std::size_t> m_next_reader{0};
+    boost::fibers::fiber_specific_ptr<std::size_t> m_home_shard;
+
+    // parking of blocked readers and writers; the waiting counters let the fast paths skip the notifications
+    Mutex m_mutex;
+    CondV m_readers_cv;
+    CondV m_writers_cv;
+    std::atomic<bool> m_is_closed{false};
+    std::atomic<std::size_t> m_waiting_readers{0};
+    std::atomic<std::size_t> m_waiting_writers{0};
+};
+
+}  // namespace mrc::channel
+
+namespace mrc {
+
+template <typename T>
+using ShardedChannel = channel::ShardedChannel<T>;  // NOLINT
+
+}
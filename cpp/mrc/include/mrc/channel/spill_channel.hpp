@@ -0,0 +1,265 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "mrc/channel/channel.hpp"
+#include "mrc/channel/telemetry.hpp"
+#include "mrc/codable/spill_log.hpp"
+#include "mrc/codable/type_traits.hpp"
+#include "mrc/types.hpp"  // for CondV & Mutex
+
+#include <glog/logging.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <utility>
+
+namespace mrc::channel {
+
+struct SpillChannelOptions
+{
+    // directory of the log elements are spilled to; the log is created by the first spill and removed with the channel
+    std::filesystem::path directory{std::filesystem::temp_directory_path()};
+    // elements held in memory; once reached, writes spill to the log
+    std::size_t memory_watermark{default_channel_size()};
+    // bytes of spilled elements after which writers block as on a full channel; 0 for no bound
+    std::uint64_t max_spill_bytes{0};
+};
+
+/**
+ * @brief Channel which spills elements to disk rather than blocking its writers when the reader falls behind
+ *
+ * Up to memory_watermark elements are held in memory. Beyond it, writes are encoded with the codable protocol of T
+ * and appended to a codable::SpillLog, so a source feeding a slow stage, e.g. one reading from the network, keeps
+ * accepting data for as long as the disk does. While the log holds elements every write is spilled, and readers
+ * refill memory from the log once it is drained, so elements are read in the order they were written. Writers only
+ * block once the log holds max_spill_bytes.
+ *
+ * Elements are encoded outside of the lock, and only while a write would spill; an element whose write finds the
+ * log drained by then is kept in memory after all. As with a codable::SpillLog, writers and readers must be fibers or
+ * threads of the MRC runtime, and elements holding device memory can not be spilled.
+ *
+ * A SpillChannel can replace the default BufferedChannel of any SinkChannel via update_channel, selecting it per edge.
+ */
+template <typename T>
+class SpillChannel final : public Channel<T>
+{
+    static_assert(codable::is_codable_v<T>, "the elements of a SpillChannel must be codable");
+
+  public:
+    SpillChannel(SpillChannelOptions options = {}) : m_options(std::move(options))
+    {
+        CHECK_GT(m_options.memory_watermark, 0) << "SpillChannel requires a memory_watermark greater than 0";
+    }
+
+    ~SpillChannel() final = default;
+
+    // elements written to the log so far
+    std::uint64_t spilled_count() const
+    {
+        std::lock_guard<Mutex> lock(m_mutex);
+        return m_spilled_count;
+    }
+
+    // bytes of the spilled elements not yet read
+    std::uint64_t spilled_bytes() const
+    {
+        std::lock_guard<Mutex> lock(m_mutex);
+        return (m_log ? m_log->bytes() : 0);
+    }
+
+  private:
+    Status do_await_write(T&& val) final
+    {
+        std::unique_lock<Mutex> lock(m_mutex);
+        if (m_is_closed)
+        {
+            return Status::closed;
+        }
+        if (!must_spill())
+        {
+            push_locked(std::move(val));
+            return Status::success;
+        }
+
+        if (!wait_for_log_space(lock))
+        {
+            return Status::closed;
+        }
+
+        lock.unlock();
+        auto storage = codable::SpillLog::encode_object(val);
+        lock.lock();
+
+        if (m_is_closed)
+        {
+            return Status::closed;
+        }
+        if (!must_spill())
+        {
+            push_locked(std::move(val));
+            return Status::success;
+        }
+
+        if (!m_log)
+        {
+            m_log = std::make_unique<codable::SpillLog>(m_options.directory);
+        }
+        m_log->append(*storage);
+        m_spilled_count++;
+        m_readers_cv.notify_one();
+        return Status::success;
+    }
+
+    Status do_await_read(T& val) final
+    {
+        std::unique_lock<Mutex> lock(m_mutex);
+        if (!readable() && !m_is_closed)
+        {
+            BlockedTimer timer(this->telemetry(), &ChannelTelemetry::record_blocked_reader);
+            m_readers_cv.wait(lock, [this] { return m_is_closed || readable(); });
+        }
+        return pop_locked(val);
+    }
+
+    Status do_try_read(T& val) final
+    {
+        std::lock_guard<Mutex> lock(m_mutex);
+        if (!readable())
+        {
+            return (m_is_closed ? Status::closed : Status::empty);
+        }
+        return pop_locked(val);
+    }
+
+    Status do_await_read_until(T& val, const time_point_t& deadline) final
+    {
+        std::unique_lock<Mutex> lock(m_mutex);
+        if (!readable() && !m_is_closed)
+        {
+            BlockedTimer timer(this->telemetry(), &ChannelTelemetry::record_blocked_reader);
+            if (!m_readers_cv.wait_until(lock, deadline, [this] { return m_is_closed || readable(); }))
+            {
+                return Status::timeout;
+            }
+        }
+        return pop_locked(val);
+    }
+
+    void do_close_channel() final
+    {
+        std::lock_guard<Mutex> lock(m_mutex);
+        m_is_closed = true;
+        m_readers_cv.notify_all();
+        m_writers_cv.notify_all();
+    }
+
+    bool do_is_channel_closed() const final
+    {
+        std::lock_guard<Mutex> lock(m_mutex);
+        return m_is_closed;
+    }
+
+    std::size_t do_capacity() const final
+    {
+        return m_options.memory_watermark;
+    }
+
+    bool log_empty() const
+    {
+        return !m_log || m_log->empty();
+    }
+
+    // elements are spilled once memory is full and for as long as older elements remain in the log
+    bool must_spill() const
+    {
+        return m_memory.size() >= m_options.memory_watermark || !log_empty();
+    }
+
+    bool readable() const
+    {
+        return !m_memory.empty() || !log_empty();
+    }
+
+    // returns false if the channel was closed
+    bool wait_for_log_space(std::unique_lock<Mutex>& lock)
+    {
+        auto has_space = [this] {
+            return m_is_closed || !must_spill() || m_options.max_spill_bytes == 0 || !m_log ||
+                   m_log->bytes() < m_options.max_spill_bytes;
+        };
+        if (!has_space())
+        {
+            BlockedTimer timer(this->telemetry(), &ChannelTelemetry::record_blocked_writer);
+            m_writers_cv.wait(lock, has_space);
+        }
+        return !m_is_closed;
+    }
+
+    void push_locked(T&& val)
+    {
+        m_memory.push_back(std::move(val));
+        m_readers_cv.notify_one();
+    }
+
+    // elements remaining in a closed channel, including those in the log, are drained before closed is reported
+    Status pop_locked(T& val)
+    {
+        if (m_memory.empty())
+        {
+            if (log_empty())
+            {
+                return (m_is_closed ? Status::closed : Status::timeout);
+            }
+
+            // newer elements are all in the log, so memory is refilled from it in order
+            while (m_memory.size() < m_options.memory_watermark && !m_log->empty())
+            {
+                m_memory.push_back(std::move(*m_log->template next<T>()));
+            }
+            m_writers_cv.notify_all();
+        }
+
+        val = std::move(m_memory.front());
+        m_memory.pop_front();
+        return Status::success;
+    }
+
+    const SpillChannelOptions m_options;
+
+    mutable Mutex m_mutex;
+    CondV m_readers_cv;
+    CondV m_writers_cv;
+    bool m_is_closed{false};
+    std::deque<T> m_memory;
+    std::unique_ptr<codable::SpillLog> m_log;
+    std::uint64_t m_spilled_count{0};
+};
+
+}  // namespace mrc::channel
+
+namespace mrc {
+
+template <typename T>
+using SpillChannel = channel::SpillChannel<T>;  // NOLINT
+
+}
@@ -0,0 +1,180 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "mrc/benchmarking/fiber_tracer.hpp"
+#include "mrc/benchmarking/flight_recorder.hpp"
+#include "mrc/channel/types.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace mrc::channel {
+
+/**
+ * @brief Point-in-time view of the backpressure state of a Channel.
+ *
+ * blocked_writer_time/blocked_reader_time accumulate the wall time writers spent waiting on a full channel and readers
+ * spent waiting on an empty channel. A large blocked_writer_time marks the downstream node as the bottleneck; a large
+ * blocked_reader_time marks the upstream node.
+ */
+struct ChannelStatistics
+{
+    std::size_t capacity{0};
+    std::size_t occupancy{0};
+    std::size_t high_water_mark{0};
+    std::uint64_t writes{0};
+    std::uint64_t reads{0};
+    std::uint64_t dropped{0};
+    duration_t blocked_writer_time{0};
+    duration_t blocked_reader_time{0};
+};
+
+/**
+ * @brief Lock-free counters backing ChannelStatistics.
+ *
+ * Writer-side and reader-side counters are kept on separate cache lines so a 1:1 edge does not bounce a shared line
+ * between the producer and consumer.
+ */
+class ChannelTelemetry
+{
+    static constexpr std::size_t CacheLineSize = 64;
+
+  public:
+    void record_writes(std::size_t count)
+    {
+        benchmarking::FlightRecorder::record(benchmarking::FlightEventType::ChannelWrite,
+                                             reinterpret_cast<std::uintptr_t>(this),
+                                             static_cast<std::uint32_t>(count));
+        auto writes = m_writes.fetch_add(count, std::memory_order_relaxed) + count;
+        auto reads  = m_reads.load(std::memory_order_relaxed);
+
+        // a reader woken by this write may record its read before the write is recorded
+        auto occupancy = (writes > reads ? writes - reads : 0);
+        auto hwm       = m_high_water_mark.load(std::memory_order_relaxed);
+        while (occupancy > hwm && !m_high_water_mark.compare_exchange_weak(hwm, occupancy, std::memory_order_relaxed))
+        {}
+    }
+
+    void record_reads(std::size_t count)
+    {
+        benchmarking::FlightRecorder::record(benchmarking::FlightEventType::ChannelRead,
+                                             reinterpret_cast<std::uintptr_t>(this),
+                                             static_cast<std::uint32_t>(count));
+        m_reads.fetch_add(count, std::memory_order_relaxed);
+    }
+
+    // elements which were accepted by the channel but discarded before being read, e.g. RecentChannel evictions
+    void record_dropped(std::size_t count)
+    {
+        m_dropped.fetch_add(count, std::memory_order_relaxed);
+        m_reads.fetch_add(count, std::memory_order_relaxed);
+    }
+
+    void record_blocked_writer(duration_t duration)
+    {
+        m_blocked_writer_ns.fetch_add(duration.count(), std::memory_order_relaxed);
+    }
+
+    void record_blocked_reader(duration_t duration)
+    {
+        m_blocked_reader_ns.fetch_add(duration.count(), std::memory_order_relaxed);
+    }
+
+    std::size_t occupancy() const
+    {
+        auto reads  = m_reads.load(std::memory_order_relaxed);
+        auto writes = m_writes.load(std::memory_order_relaxed);
+        return (writes > reads ? writes - reads : 0);
+    }
+
+    duration_t blocked_writer_time() const
+    {
+        return duration_t(m_blocked_writer_ns.load(std::memory_order_relaxed));
+    }
+
+    duration_t blocked_reader_time() const
+    {
+        return duration_t(m_blocked_reader_ns.load(std::memory_order_relaxed));
+    }
+
+    void reset_high_water_mark()
+    {
+        m_high_water_mark.store(occupancy(), std::memory_order_relaxed);
+    }
+
+    ChannelStatistics statistics(std::size_t capacity) const
+    {
+        ChannelStatistics stats;
+        stats.capacity            = capacity;
+        stats.reads               = m_reads.load(std::memory_order_relaxed) - m_dropped.load(std::memory_order_relaxed);
+        stats.writes              = m_writes.load(std::memory_order_relaxed);
+        stats.dropped             = m_dropped.load(std::memory_order_relaxed);
+        stats.occupancy           = occupancy();
+        stats.high_water_mark     = m_high_water_mark.load(std::memory_order_relaxed);
+        stats.blocked_writer_time = blocked_writer_time();
+        stats.blocked_reader_time = blocked_reader_time();
+        return stats;
+    }
+
+  private:
+    // writer side
+    alignas(CacheLineSize) std::atomic<std::uint64_t> m_writes{0};
+    std::atomic<std::uint64_t> m_high_water_mark{0};
+    std::atomic<std::int64_t> m_blocked_writer_ns{0};
+
+    // reader side
+    alignas(CacheLineSize) std::atomic<std::uint64_t> m_reads{0};
+    std::atomic<std::uint64_t> m_dropped{0};
+    std::atomic<std::int64_t> m_blocked_reader_ns{0};
+};
+
+/**
+ * @brief Accumulates the lifetime of the object as blocked writer or reader time.
+ *
+ * The wait is also attributed to the running fiber when the tracing scheduler is enabled, see FiberTracer.
+ */
+class BlockedTimer
+{
+  public:
+    using record_fn_t = void (ChannelTelemetry::*)(duration_t);
+
+    BlockedTimer(ChannelTelemetry& telemetry, record_fn_t record_fn) :
+      m_telemetry(telemetry),
+      m_record_fn(record_fn),
+      m_start(clock_t::now())
+    {}
+
+    ~BlockedTimer()
+    {
+        auto duration = std::chrono::duration_cast<duration_t>(clock_t::now() - m_start);
+        (m_telemetry.*m_record_fn)(duration);
+        benchmarking::FiberTracer::record_channel_wait(duration);
+    }
+
+    BlockedTimer(const BlockedTimer&)            = delete;
+    BlockedTimer& operator=(const BlockedTimer&) = delete;
+
+  private:
+    ChannelTelemetry& m_telemetry;
+    record_fn_t m_record_fn;
+    time_point_t m_start;
+};
+
+}  // namespace mrc::channel
@@ -0,0 +1,118 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <boost/fiber/operations.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace mrc::channel {
+
+/**
+ * @brief How a reader waits on an empty channel before parking its fiber.
+ *
+ * - park: park immediately (the default, lowest cpu usage)
+ * - spin: busy-poll up to `spin_count` times, then park
+ * - spin_yield: busy-poll up to `spin_count` times, yield the fiber up to `yield_count` times, then park
+ */
+enum class WaitStrategy
+{
+    park,
+    spin,
+    spin_yield,
+};
+
+struct WaitPolicy
+{
+    WaitStrategy strategy{WaitStrategy::park};
+    std::size_t spin_count{1024};
+    std::size_t yield_count{16};
+};
+
+/**
+ * @brief Number of waits that were resolved in each phase of the WaitPolicy.
+ *
+ * Counters are only updated for non-park strategies so the default read path is unchanged.
+ */
+struct WaitCounters
+{
+    std::atomic<std::uint64_t> immediate{0};
+    std::atomic<std::uint64_t> spin{0};
+    std::atomic<std::uint64_t> yield{0};
+    std::atomic<std::uint64_t> park{0};
+};
+
+namespace detail {
+
+inline void spin_pause()
+{
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#elif defined(__aarch64__)
+    asm volatile("yield" ::: "memory");
+#endif
+}
+
+}  // namespace detail
+
+/**
+ * @brief Run the spin and yield phases of the policy.
+ *
+ * @param try_fn callable returning true once the wait has been resolved, e.g. a successful non-blocking pop
+ * @return true if try_fn resolved the wait before the park phase; false if the caller should now park. When false is
+ * returned the park counter has already been incremented.
+ */
+template <typename TryFnT>
+bool spin_before_park(const WaitPolicy& policy, WaitCounters& counters, TryFnT&& try_fn)
+{
+    if (try_fn())
+    {
+        counters.immediate.fetch_add(1, std::memory_order_relaxed);
+        return true;
+    }
+
+    for (std::size_t i = 0; i < policy.spin_count; i++)
+    {
+        detail::spin_pause();
+        if (try_fn())
+        {
+            counters.spin.fetch_add(1, std::memory_order_relaxed);
+            return true;
+        }
+    }
+
+    if (policy.strategy == WaitStrategy::spin_yield)
+    {
+        for (std::size_t i = 0; i < policy.yield_count; i++)
+        {
+            boost::this_fiber::yield();
+            if (try_fn())
+            {
+                counters.yield.fetch_add(1, std::memory_order_relaxed);
+                return true;
+            }
+        }
+    }
+
+    counters.park.fetch_add(1, std::memory_order_relaxed);
+    return false;
+}
+
+}  // namespace mrc::channel
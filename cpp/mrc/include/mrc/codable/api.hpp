@@ -20,11 +20,15 @@
 #include "mrc/codable/codable_protocol.hpp"
 #include "mrc/codable/types.hpp"
 #include "mrc/memory/buffer_view.hpp"
+#include "mrc/memory/iovec_view.hpp"
 
 #include <google/protobuf/message.h>
 
+#include <cstddef>
+#include <functional>
 #include <optional>
 #include <typeindex>
+#include <vector>
 
 namespace mrc::memory {
 struct memory_resource;
@@ -48,6 +52,8 @@ class Decoder;
 
 class EncodingOptions;
 
+enum class CompressionCodec;
+
 /**
  * @brief Interface for an EncodedObject
  *
@@ -147,6 +153,30 @@ class IEncodableStorage : public virtual IStorage
      */
     virtual idx_t copy_to_eager_descriptor(memory::const_buffer_view view) = 0;
 
+    /**
+     * @brief Gather the regions of a scatter/gather view, in order, into a single eager descriptor
+     *
+     * @return idx_t
+     */
+    virtual idx_t gather_to_eager_descriptor(memory::const_iovec_view iov) = 0;
+
+    /**
+     * @brief Copy a host view into a shared memory segment owned by the EncodedObject. Receivers on the same host map
+     * the segment and copy from it directly, without involving the network.
+     *
+     * @return idx_t
+     */
+    virtual idx_t copy_to_shared_memory_descriptor(memory::const_buffer_view view) = 0;
+
+    /**
+     * @brief Compress a host view with codec into a buffer owned by the EncodedObject. Compressed payloads smaller than
+     * the eager threshold are carried by an eager descriptor; larger payloads are registered for a remote get.
+     *
+     * @return std::optional<idx_t> - nullopt if the view did not compress, in which case nothing was added
+     */
+    [[nodiscard]] virtual std::optional<idx_t> copy_to_compressed_descriptor(memory::const_buffer_view view,
+                                                                             CompressionCodec codec) = 0;
+
     /**
      * @brief Add a custom protobuf meta data to the descriptor list
      *
@@ -176,6 +206,14 @@ class IEncodableStorage : public virtual IStorage
      */
     virtual void copy_to_buffer(idx_t buffer_idx, memory::const_buffer_view view) = 0;
 
+    /**
+     * @brief Gather the regions of a scatter/gather view, in order, into the buffer of a descriptor
+     *
+     * @param buffer_idx
+     * @param iov
+     */
+    virtual void gather_to_buffer(idx_t buffer_idx, memory::const_iovec_view iov) = 0;
+
     /**
      * @brief Provide a mutable host buffer view into a descriptor.
      * @note The descriptor must be associated with host memory, not device memory
@@ -220,6 +258,22 @@ class IDecodableStorage : public virtual IStorage
   protected:
     virtual void copy_from_buffer(const idx_t& idx, memory::buffer_view dst_view) const = 0;
 
+    /**
+     * @brief Copy the data of a descriptor, in order, into a sequence of destination views
+     *
+     * The destination views are filled back to back and together may span at most the descriptor. For remote
+     * descriptors the views are pulled as a pipeline of gets, and on_chunk is called with the index of each view, in
+     * order, as soon as its data has arrived while later views are still in flight. This allows large buffers to be
+     * scattered across multiple smaller blocks and consumed before the whole buffer has arrived.
+     *
+     * @param idx
+     * @param dst_views
+     * @param on_chunk
+     */
+    virtual void copy_from_buffer_chunked(const idx_t& idx,
+                                          const std::vector<memory::buffer_view>& dst_views,
+                                          const std::function<void(std::size_t)>& on_chunk) const = 0;
+
     /**
      * @brief Size in bytes of a given descriptor index
      *
@@ -0,0 +1,215 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "mrc/codable/codable_protocol.hpp"
+#include "mrc/codable/decode.hpp"
+#include "mrc/codable/encode.hpp"
+#include "mrc/codable/encoding_options.hpp"
+#include "mrc/codable/fundamental_types.hpp"
+#include "mrc/codable/type_traits.hpp"
+#include "mrc/memory/memory_kind.hpp"
+
+#include <glog/logging.h>
+
+#include <array>
+#include <cstddef>
+#include <map>
+#include <tuple>
+#include <type_traits>
+#include <typeindex>
+#include <utility>
+#include <vector>
+
+/**
+ * Codable protocols for std containers.
+ *
+ * Containers of trivially codable values which store them contiguously are encoded as a single descriptor; all other
+ * containers encode each element, which itself must be codable, as a child object of the container.
+ */
+
+namespace mrc::codable {
+
+namespace detail {
+
+template <typename T>
+void serialize_child(const T& value, Encoder<T>&& encoder, const EncodingOptions& opts)
+{
+    static_assert(is_codable_v<T>, "element type is not codable");
+    encoder.serialize(value, opts);
+}
+
+}  // namespace detail
+
+template <typename T>
+struct codable_protocol<std::vector<T>, std::enable_if_t<is_trivially_codable_v<T> && !std::is_same_v<T, bool>>>
+{
+    static void serialize(const std::vector<T>& obj, Encoder<std::vector<T>>& encoder, const EncodingOptions& opts)
+    {
+        encoder.add_memory_view({obj.data(), obj.size() * sizeof(T), memory::memory_kind::host}, opts);
+    }
+
+    static std::vector<T> deserialize(const Decoder<std::vector<T>>& decoder, std::size_t object_idx)
+    {
+        DCHECK_EQ(std::type_index(typeid(std::vector<T>)).hash_code(), decoder.type_index_hash_for_object(object_idx));
+        auto idx   = decoder.start_idx_for_object(object_idx);
+        auto bytes = decoder.buffer_size(idx);
+        DCHECK_EQ(bytes % sizeof(T), 0);
+
+        std::vector<T> obj(bytes / sizeof(T));
+        decoder.copy_from_buffer(idx, {obj.data(), bytes, memory::memory_kind::host});
+        return obj;
+    }
+};
+
+template <typename T>
+struct codable_protocol<std::vector<T>, std::enable_if_t<!is_trivially_codable_v<T> || std::is_same_v<T, bool>>>
+{
+    static void serialize(const std::vector<T>& obj, Encoder<std::vector<T>>& encoder, const EncodingOptions& opts)
+    {
+        for (const T& value : obj)
+        {
+            detail::serialize_child<T>(value, encoder.template rebind<T>(), opts);
+        }
+    }
+
+    static std::vector<T> deserialize(const Decoder<std::vector<T>>& decoder, std::size_t object_idx)
+    {
+        DCHECK_EQ(std::type_index(typeid(std::vector<T>)).hash_code(), decoder.type_index_hash_for_object(object_idx));
+        std::vector<T> obj;
+        for (auto child_idx : decoder.child_object_indices(object_idx))
+        {
+            obj.push_back(decoder.template deserialize_child<T>(child_idx));
+        }
+        return obj;
+    }
+};
+
+// arrays of trivially codable values are themselves trivially codable
+template <typename T, std::size_t N>
+struct codable_protocol<std::array<T, N>, std::enable_if_t<!is_trivially_codable_v<std::array<T, N>>>>
+{
+    static void serialize(const std::array<T, N>& obj, Encoder<std::array<T, N>>& encoder, const EncodingOptions& opts)
+    {
+        for (const auto& value : obj)
+        {
+            detail::serialize_child<T>(value, encoder.template rebind<T>(), opts);
+        }
+    }
+
+    static std::array<T, N> deserialize(const Decoder<std::array<T, N>>& decoder, std::size_t object_idx)
+    {
+        auto children = decoder.child_object_indices(object_idx);
+        CHECK_EQ(children.size(), N);
+        return deserialize_elements(decoder, children, std::make_index_sequence<N>{});
+    }
+
+  private:
+    template <std::size_t... I>
+    static std::array<T, N> deserialize_elements(const Decoder<std::array<T, N>>& decoder,
+                                                 const std::vector<obj_idx_t>& children,
+                                                 std::index_sequence<I...> /*unused*/)
+    {
+        return {decoder.template deserialize_child<T>(children[I])...};
+    }
+};
+
+template <typename... T>
+struct codable_protocol<std::tuple<T...>, std::enable_if_t<!is_trivially_codable_v<std::tuple<T...>>>>
+{
+    static void serialize(const std::tuple<T...>& obj, Encoder<std::tuple<T...>>& encoder, const EncodingOptions& opts)
+    {
+        serialize_elements(obj, encoder, opts, std::index_sequence_for<T...>{});
+    }
+
+    static std::tuple<T...> deserialize(const Decoder<std::tuple<T...>>& decoder, std::size_t object_idx)
+    {
+        auto children = decoder.child_object_indices(object_idx);
+        CHECK_EQ(children.size(), sizeof...(T));
+        return deserialize_elements(decoder, children, std::index_sequence_for<T...>{});
+    }
+
+  private:
+    template <std::size_t... I>
+    static void serialize_elements(const std::tuple<T...>& obj,
+                                   Encoder<std::tuple<T...>>& encoder,
+                                   const EncodingOptions& opts,
+                                   std::index_sequence<I...> /*unused*/)
+    {
+        (detail::serialize_child<T>(std::get<I>(obj), encoder.template rebind<T>(), opts), ...);
+    }
+
+    template <std::size_t... I>
+    static std::tuple<T...> deserialize_elements(const Decoder<std::tuple<T...>>& decoder,
+                                                 const std::vector<obj_idx_t>& children,
+                                                 std::index_sequence<I...> /*unused*/)
+    {
+        return {decoder.template deserialize_child<T>(children[I])...};
+    }
+};
+
+template <typename T1, typename T2>
+struct codable_protocol<std::pair<T1, T2>, std::enable_if_t<!is_trivially_codable_v<std::pair<T1, T2>>>>
+{
+    static void serialize(const std::pair<T1, T2>& obj,
+                          Encoder<std::pair<T1, T2>>& encoder,
+                          const EncodingOptions& opts)
+    {
+        detail::serialize_child<T1>(obj.first, encoder.template rebind<T1>(), opts);
+        detail::serialize_child<T2>(obj.second, encoder.template rebind<T2>(), opts);
+    }
+
+    static std::pair<T1, T2> deserialize(const Decoder<std::pair<T1, T2>>& decoder, std::size_t object_idx)
+    {
+        auto children = decoder.child_object_indices(object_idx);
+        CHECK_EQ(children.size(), 2);
+        return {decoder.template deserialize_child<T1>(children[0]),
+                decoder.template deserialize_child<T2>(children[1])};
+    }
+};
+
+template <typename KeyT, typename ValueT>
+struct codable_protocol<std::map<KeyT, ValueT>>
+{
+    static void serialize(const std::map<KeyT, ValueT>& obj,
+                          Encoder<std::map<KeyT, ValueT>>& encoder,
+                          const EncodingOptions& opts)
+    {
+        for (const auto& [key, value] : obj)
+        {
+            detail::serialize_child<KeyT>(key, encoder.template rebind<KeyT>(), opts);
+            detail::serialize_child<ValueT>(value, encoder.template rebind<ValueT>(), opts);
+        }
+    }
+
+    static std::map<KeyT, ValueT> deserialize(const Decoder<std::map<KeyT, ValueT>>& decoder, std::size_t object_idx)
+    {
+        auto children = decoder.child_object_indices(object_idx);
+        CHECK_EQ(children.size() % 2, 0);
+
+        std::map<KeyT, ValueT> obj;
+        for (std::size_t i = 0; i < children.size(); i += 2)
+        {
+            obj.emplace(decoder.template deserialize_child<KeyT>(children[i]),
+                        decoder.template deserialize_child<ValueT>(children[i + 1]));
+        }
+        return obj;
+    }
+};
+
+}  // namespace mrc::codable
@@ -20,9 +20,13 @@
 #include "mrc/codable/api.hpp"
 #include "mrc/codable/storage_forwarder.hpp"
 #include "mrc/codable/type_traits.hpp"
+#include "mrc/memory/iovec_view.hpp"
 #include "mrc/utils/sfinae_concept.hpp"
 
+#include <cstddef>
+#include <functional>
 #include <memory>
+#include <vector>
 
 namespace mrc::codable {
 
@@ -43,11 +47,57 @@ struct Decoder final : public StorageForwarder
         m_storage.copy_from_buffer(idx, std::move(dst_view));
     }
 
+    void copy_from_buffer_chunked(const idx_t& idx,
+                                  const std::vector<memory::buffer_view>& dst_views,
+                                  const std::function<void(std::size_t)>& on_chunk) const
+    {
+        m_storage.copy_from_buffer_chunked(idx, dst_views, on_chunk);
+    }
+
+    /**
+     * @brief Scatter the data of a descriptor, in order, into the regions of a scatter/gather view
+     */
+    void copy_from_buffer(const idx_t& idx, const memory::iovec_view& dst_iov) const
+    {
+        m_storage.copy_from_buffer_chunked(idx, dst_iov.segments(), [](std::size_t) {});
+    }
+
     std::size_t buffer_size(const idx_t& idx) const
     {
         return m_storage.buffer_size(idx);
     }
 
+    /**
+     * @brief Indices of the objects encoded as children of object_idx, e.g. by rebinding the Encoder, in encoding order
+     */
+    std::vector<obj_idx_t> child_object_indices(const obj_idx_t& object_idx) const
+    {
+        // objects are stored in pre-order, so the descendants of an object immediately follow it
+        std::vector<obj_idx_t> children;
+        for (obj_idx_t idx = object_idx + 1; idx < object_count(); ++idx)
+        {
+            auto parent = parent_obj_idx_for_object(idx);
+            if (!parent || *parent < object_idx)
+            {
+                break;
+            }
+            if (*parent == object_idx)
+            {
+                children.push_back(idx);
+            }
+        }
+        return children;
+    }
+
+    /**
+     * @brief Decode a child object of type U
+     */
+    template <typename U>
+    U deserialize_child(const obj_idx_t& child_idx) const
+    {
+        return Decoder<U>(m_storage).deserialize(child_idx);
+    }
+
     std::shared_ptr<mrc::memory::memory_resource> host_memory_resource() const
     {
         return m_storage.host_memory_resource();
@@ -55,7 +105,7 @@ struct Decoder final : public StorageForwarder
 
     std::shared_ptr<mrc::memory::memory_resource> device_memory_resource() const
     {
-        return m_storage.host_memory_resource();
+        return m_storage.device_memory_resource();
     }
 
   private:
@@ -0,0 +1,147 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "mrc/codable/codable_protocol.hpp"
+
+#include <glog/logging.h>
+
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <span>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+// IWYU pragma: no_forward_declare mrc::codable::codable_protocol
+
+namespace mrc::codable {
+class EncodingOptions;
+template <typename T>
+class Encoder;
+template <typename T>
+class Decoder;
+
+/**
+ * @brief Batch of keyed records, each delta encoded against the previous record of its key within the batch
+ *
+ * Telemetry streams often carry consecutive records which differ in a few bytes, e.g. a counter or a timestamp, per
+ * key. A record is stored as the xor of its bytes with those of the previous record of its key, with the runs of
+ * zero bytes this leaves for the unchanged bytes collapsed to their lengths; the first record of a key is xor-ed with
+ * nothing and so stored as is. Deltas never reference another batch, so any batch decodes on its own regardless of
+ * which receiver it is routed to or whether an earlier batch of the stream was dropped.
+ *
+ * The encoded bytes are a single host buffer, so encoding options with a compression codec compress the batch as a
+ * whole once it reaches the compression threshold; see Publisher::encoding_options to configure a publishing port.
+ */
+class DeltaBatch
+{
+  public:
+    using record_fn_t = std::function<void(std::uint64_t key, std::span<const std::byte> record)>;
+
+    DeltaBatch() = default;
+
+    /**
+     * @brief Append a record of key; records are decoded in the order they were appended.
+     */
+    void append(std::uint64_t key, std::span<const std::byte> record);
+
+    /**
+     * @brief Invoke on_record with the key and the decoded bytes of each record in order; the bytes are only valid
+     * for the duration of the call.
+     */
+    void for_each(const record_fn_t& on_record) const;
+
+    // number of records
+    std::size_t size() const;
+
+    bool empty() const;
+
+    // bytes of the encoded batch
+    std::size_t bytes() const;
+
+    // bytes of the records before encoding
+    std::size_t record_bytes() const;
+
+    const std::vector<std::byte>& data() const;
+
+    /**
+     * @brief Encode trivially copyable records, keyed by key_fn
+     */
+    template <typename T, typename KeyFnT>
+    static DeltaBatch encode_records(const std::vector<T>& records, KeyFnT&& key_fn)
+    {
+        static_assert(std::is_trivially_copyable_v<T>, "records are delta encoded by their object representation");
+        DeltaBatch batch;
+        for (const auto& record : records)
+        {
+            batch.append(key_fn(record), std::as_bytes(std::span<const T, 1>(&record, 1)));
+        }
+        return batch;
+    }
+
+    /**
+     * @brief Decode the records of a batch of trivially copyable records
+     */
+    template <typename T>
+    std::vector<T> decode_records() const
+    {
+        static_assert(std::is_trivially_copyable_v<T>, "records are delta encoded by their object representation");
+        std::vector<T> records;
+        records.reserve(size());
+        for_each([&records](std::uint64_t /*key*/, std::span<const std::byte> record) {
+            CHECK_EQ(record.size(), sizeof(T));
+
+            // trivially copyable types need not be default constructible
+            alignas(T) std::array<std::byte, sizeof(T)> bytes;
+            std::memcpy(bytes.data(), record.data(), sizeof(T));
+            records.push_back(std::bit_cast<T>(bytes));
+        });
+        return records;
+    }
+
+  private:
+    // restores the previous record of each key from the encoded bytes, e.g. of a decoded batch
+    static DeltaBatch from_bytes(std::vector<std::byte> bytes);
+
+    std::vector<std::byte> m_data;
+    std::size_t m_size{0};
+    std::size_t m_record_bytes{0};
+
+    // previous record of each key, the base of the next delta of the key
+    std::unordered_map<std::uint64_t, std::vector<std::byte>> m_previous;
+
+    friend codable_protocol<DeltaBatch>;
+};
+
+/**
+ * The encoded bytes of a batch are a single descriptor, compressed per the encoding options.
+ */
+template <>
+struct codable_protocol<DeltaBatch>
+{
+    static void serialize(const DeltaBatch& obj, Encoder<DeltaBatch>& encoded, const EncodingOptions& opts);
+
+    static DeltaBatch deserialize(const Decoder<DeltaBatch>& encoded, std::size_t object_idx);
+};
+
+}  // namespace mrc::codable
@@ -19,10 +19,15 @@
 
 #include "mrc/codable/api.hpp"
 #include "mrc/codable/codable_protocol.hpp"
+#include "mrc/codable/encoding_options.hpp"
 #include "mrc/codable/type_traits.hpp"
+#include "mrc/memory/iovec_view.hpp"
+#include "mrc/memory/memory_kind.hpp"
 #include "mrc/utils/sfinae_concept.hpp"
 
 #include <memory>
+#include <optional>
+#include <utility>
 
 namespace mrc::codable {
 
@@ -50,6 +55,83 @@ class Encoder final
         return m_storage.copy_to_eager_descriptor(std::move(view));
     }
 
+    idx_t copy_to_shared_memory_descriptor(memory::const_buffer_view view)
+    {
+        return m_storage.copy_to_shared_memory_descriptor(std::move(view));
+    }
+
+    std::optional<idx_t> copy_to_compressed_descriptor(memory::const_buffer_view view, CompressionCodec codec)
+    {
+        return m_storage.copy_to_compressed_descriptor(std::move(view), codec);
+    }
+
+    /**
+     * @brief Encode a view with an eager descriptor if the view is host accessible and smaller than the eager threshold
+     * of opts; otherwise describe the view in place for a remote get, falling back to an eager descriptor if a host
+     * view is not registered.
+     *
+     * Host views at or above the eager threshold are copied to shared memory if use_shm is set in opts, for receivers on
+     * the same host. Host views of at least the compression threshold of opts are first compressed with the codec of
+     * opts, falling through to the other paths if they do not compress. Views in place are not copied, so the memory
+     * must outlive the encoding, e.g. by the encoded object being owned by an EncodedObject; device views are always
+     * described in place.
+     */
+    idx_t add_memory_view(memory::const_buffer_view view, const EncodingOptions& opts)
+    {
+        const bool is_device = view.kind() == memory::memory_kind::device;
+        if (!is_device && view.bytes() < opts.eager_threshold())
+        {
+            return copy_to_eager_descriptor(std::move(view));
+        }
+
+        if (!is_device && opts.compression() != CompressionCodec::none && view.bytes() >= opts.compression_threshold())
+        {
+            auto idx = copy_to_compressed_descriptor(view, opts.compression());
+            if (idx)
+            {
+                return *idx;
+            }
+        }
+
+        if (!is_device && opts.use_shm())
+        {
+            return copy_to_shared_memory_descriptor(std::move(view));
+        }
+
+        auto idx = register_memory_view(view, is_device);
+        if (idx)
+        {
+            return *idx;
+        }
+        return copy_to_eager_descriptor(std::move(view));
+    }
+
+    /**
+     * @brief Encode the regions of a scatter/gather view, e.g. the columns of a dataframe, as a single descriptor
+     *
+     * A view of a single region is encoded as with add_memory_view. Otherwise the regions are gathered into an eager
+     * descriptor if the view is host accessible and smaller than the eager threshold of opts, or else into a single
+     * registered buffer owned by the encoding, so the receiver pulls every region with one get. The regions are
+     * copied, so the memory of the view does not need to outlive the call. The decoder scatters the descriptor back
+     * with copy_from_buffer into an iovec_view with regions of the same sizes.
+     */
+    idx_t add_memory_iovec(memory::const_iovec_view iov, const EncodingOptions& opts)
+    {
+        if (iov.size() == 1)
+        {
+            return add_memory_view(iov.segments().front(), opts);
+        }
+
+        if (iov.kind() != memory::memory_kind::device && iov.bytes() < opts.eager_threshold())
+        {
+            return m_storage.gather_to_eager_descriptor(std::move(iov));
+        }
+
+        auto idx = create_memory_buffer(iov.bytes());
+        m_storage.gather_to_buffer(idx, std::move(iov));
+        return idx;
+    }
+
     idx_t add_meta_data(const google::protobuf::Message& meta_data)
     {
         return m_storage.add_meta_data(meta_data);
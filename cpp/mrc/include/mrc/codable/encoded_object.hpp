@@ -48,10 +48,20 @@ class EncodedObject final : public EncodedStorage
   public:
     ~EncodedObject() final = default;
 
-    static std::unique_ptr<EncodedObject<T>> create(T&& object, std::unique_ptr<mrc::codable::ICodableStorage> storage)
+    /**
+     * @brief Take ownership of object and encode it in place; descriptors referencing the memory of the object without a
+     * copy remain valid for the lifetime of the EncodedObject.
+     */
+    static std::unique_ptr<EncodedObject<T>> create(T&& object,
+                                                    std::unique_ptr<mrc::codable::ICodableStorage> storage,
+                                                    EncodingOptions opts = {})
     {
-        mrc::codable::encode(object, *storage);
-        return std::unique_ptr<EncodedObject<T>>(new EncodedObject(std::move(object), std::move(storage)));
+        auto& codable_storage = *storage;
+        auto encoded = std::unique_ptr<EncodedObject<T>>(new EncodedObject(std::move(object), std::move(storage)));
+
+        // encode the owned object, since moving an object may relocate its memory, e.g. a small std::string
+        mrc::codable::encode(encoded->m_object, codable_storage, std::move(opts));
+        return encoded;
     }
 
   private:
@@ -68,9 +78,10 @@ class EncodedObject<std::unique_ptr<T>> : public EncodedStorage
 
   public:
     static std::unique_ptr<EncodedObject<T>> create(std::unique_ptr<T> object,
-                                                    std::unique_ptr<mrc::codable::ICodableStorage> storage)
+                                                    std::unique_ptr<mrc::codable::ICodableStorage> storage,
+                                                    EncodingOptions opts = {})
     {
-        mrc::codable::encode(*object, *storage);
+        mrc::codable::encode(*object, *storage, std::move(opts));
         return std::unique_ptr<EncodedObject<T>>(new EncodedObject(std::move(object), std::move(storage)));
     }
 
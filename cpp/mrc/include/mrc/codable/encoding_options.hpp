@@ -17,11 +17,34 @@
 
 #pragma once
 
+#include <cstddef>
+
 namespace mrc::codable {
 
+/**
+ * @brief Codec applied to the host accessible buffers of an encoded object before they are described
+ */
+enum class CompressionCodec
+{
+    none,
+    lz4,
+    zstd,
+};
+
 class EncodingOptions final
 {
   public:
+    /**
+     * @brief Size below which host accessible memory is copied into the encoded object rather than being registered
+     * for a remote get, so that small payloads are carried by the descriptor message itself
+     */
+    static constexpr std::size_t DefaultEagerThreshold = 64UL * 1024;
+
+    /**
+     * @brief Size below which buffers are never compressed, as the codec overhead outweighs the bytes saved
+     */
+    static constexpr std::size_t DefaultCompressionThreshold = 256UL * 1024;
+
     EncodingOptions() = default;
     EncodingOptions(const bool& force_copy, const bool& use_shm) : m_force_copy{force_copy}, m_use_shm{use_shm} {};
 
@@ -45,9 +68,46 @@ class EncodingOptions final
         m_use_shm = flag;
     }
 
+    const std::size_t& eager_threshold() const
+    {
+        return m_eager_threshold;
+    }
+
+    void eager_threshold(const std::size_t& bytes)
+    {
+        m_eager_threshold = bytes;
+    }
+
+    const CompressionCodec& compression() const
+    {
+        return m_compression;
+    }
+
+    /**
+     * @brief Compress host accessible buffers of at least compression_threshold bytes with codec; buffers which do not
+     * compress are described uncompressed. Device memory is never compressed.
+     */
+    void compression(const CompressionCodec& codec)
+    {
+        m_compression = codec;
+    }
+
+    const std::size_t& compression_threshold() const
+    {
+        return m_compression_threshold;
+    }
+
+    void compression_threshold(const std::size_t& bytes)
+    {
+        m_compression_threshold = bytes;
+    }
+
   private:
     bool m_use_shm{false};
     bool m_force_copy{false};
+    std::size_t m_eager_threshold{DefaultEagerThreshold};
+    CompressionCodec m_compression{CompressionCodec::none};
+    std::size_t m_compression_threshold{DefaultCompressionThreshold};
 };
 
 }  // namespace mrc::codable
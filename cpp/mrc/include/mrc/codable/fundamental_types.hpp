@@ -24,28 +24,69 @@
 #include "mrc/memory/buffer_view.hpp"
 #include "mrc/memory/memory_kind.hpp"
 
+#include <glog/logging.h>
+
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <string>
 #include <type_traits>
 #include <typeindex>
 
 namespace mrc::codable {
 
+namespace detail {
+
+template <typename T, typename = void>
+struct has_member_serialize : std::false_type
+{};
+
+template <typename T>
+struct has_member_serialize<T, std::void_t<decltype(&T::serialize)>> : std::true_type
+{};
+
+template <typename T, typename = void>
+struct has_member_deserialize : std::false_type
+{};
+
+template <typename T>
+struct has_member_deserialize<T, std::void_t<decltype(&T::deserialize)>> : std::true_type
+{};
+
+}  // namespace detail
+
+/**
+ * @brief Types encoded by a copy of their object representation: trivially copyable types which are not pointers and
+ * do not provide their own serialize/deserialize members
+ */
+template <typename T>
+struct is_trivially_codable
+  : std::bool_constant<std::is_trivially_copyable_v<T> && !std::is_pointer_v<T> && !std::is_member_pointer_v<T> &&
+                       !detail::has_member_serialize<T>::value && !detail::has_member_deserialize<T>::value>
+{};
+
+template <typename T>
+inline constexpr bool is_trivially_codable_v = is_trivially_codable<T>::value;  // NOLINT
+
 template <typename T>
-struct codable_protocol<T, std::enable_if_t<std::is_fundamental_v<T>>>
+struct codable_protocol<T, std::enable_if_t<is_trivially_codable_v<T>>>
 {
     static void serialize(const T& t, Encoder<T>& encoder, const EncodingOptions& opts)
     {
-        auto index = encoder.copy_to_eager_descriptor({&t, sizeof(t), memory::memory_kind::host});
+        encoder.add_memory_view({&t, sizeof(T), memory::memory_kind::host}, opts);
     }
 
     static T deserialize(const Decoder<T>& decoder, std::size_t object_idx)
     {
         DCHECK_EQ(std::type_index(typeid(T)).hash_code(), decoder.type_index_hash_for_object(object_idx));
         auto idx = decoder.start_idx_for_object(object_idx);
+        DCHECK_EQ(decoder.buffer_size(idx), sizeof(T));
 
-        T val;
-        decoder.copy_from_buffer(object_idx, {&val, sizeof(T), memory::memory_kind::host});
+        // trivially copyable types need not be default constructible
+        alignas(T) std::array<std::byte, sizeof(T)> bytes;
+        decoder.copy_from_buffer(idx, {bytes.data(), sizeof(T), memory::memory_kind::host});
 
-        return val;
+        return std::bit_cast<T>(bytes);
     }
 };
 
@@ -61,11 +102,7 @@ struct codable_protocol<T, std::enable_if_t<std::is_same_v<T, std::string>>>
         }
         else
         {
-            auto idx = encoder.register_memory_view({str.data(), str.size(), memory::memory_kind::host});
-            if (!idx)
-            {
-                encoder.copy_to_eager_descriptor({str.data(), str.size(), memory::memory_kind::host});
-            }
+            encoder.add_memory_view({str.data(), str.size(), memory::memory_kind::host}, opts);
         }
     }
 
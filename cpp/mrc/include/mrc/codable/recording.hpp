@@ -0,0 +1,140 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "mrc/codable/api.hpp"
+#include "mrc/codable/decode.hpp"
+#include "mrc/codable/encode.hpp"
+#include "mrc/codable/encoding_options.hpp"
+
+#include <chrono>
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <optional>
+
+namespace google::protobuf::io {
+class IstreamInputStream;
+}  // namespace google::protobuf::io
+
+namespace mrc::codable {
+
+/**
+ * @brief Object read back from a recording, along with the time it was recorded at relative to the first object
+ */
+template <typename T>
+struct Recorded
+{
+    std::chrono::nanoseconds offset;
+    T object;
+};
+
+/**
+ * @brief Appends timestamped objects, encoded with their codable protocol, to a file which a RecordingReader reads back
+ *
+ * Every host buffer of an object is copied into its record, so a recording is self-contained and can be replayed by
+ * another process; objects holding device memory can not be recorded. A recording is a short header followed by one
+ * length-delimited protos::RecordedObject per object.
+ *
+ * Objects are encoded and decoded with the resources of the partition of the calling thread, so both the writer and
+ * the reader must be used from a thread of the MRC runtime, e.g. from a node.
+ */
+class RecordingWriter final
+{
+  public:
+    explicit RecordingWriter(const std::filesystem::path& path);
+    ~RecordingWriter();
+
+    /**
+     * @brief Append an object recorded offset after the first object of the recording
+     */
+    template <typename T>
+    void append(const T& object, std::chrono::nanoseconds offset)
+    {
+        auto storage = make_storage();
+        encode(object, *storage, encoding_options());
+        write(*storage, offset);
+    }
+
+    /**
+     * @brief Append an object timestamped with the time elapsed since the first object was appended
+     */
+    template <typename T>
+    void append(const T& object)
+    {
+        const auto now = std::chrono::steady_clock::now();
+        if (!m_first)
+        {
+            m_first = now;
+        }
+        append(object, std::chrono::duration_cast<std::chrono::nanoseconds>(now - *m_first));
+    }
+
+    void flush();
+
+    // number of objects appended
+    std::size_t count() const;
+
+  private:
+    static std::unique_ptr<ICodableStorage> make_storage();
+
+    // every host buffer is carried by an eager descriptor
+    static EncodingOptions encoding_options();
+
+    void write(const IStorage& storage, std::chrono::nanoseconds offset);
+
+    const std::filesystem::path m_path;
+    std::ofstream m_stream;
+    std::optional<std::chrono::steady_clock::time_point> m_first;
+    std::size_t m_count{0};
+};
+
+/**
+ * @brief Reads back, in order, the objects of a recording made by a RecordingWriter
+ */
+class RecordingReader final
+{
+  public:
+    explicit RecordingReader(const std::filesystem::path& path);
+    ~RecordingReader();
+
+    /**
+     * @brief The next object of the recording; empty once all objects have been read
+     */
+    template <typename T>
+    std::optional<Recorded<T>> next()
+    {
+        std::chrono::nanoseconds offset{0};
+        auto storage = read(offset);
+        if (!storage)
+        {
+            return std::nullopt;
+        }
+        return Recorded<T>{offset, decode<T>(*storage)};
+    }
+
+  private:
+    std::unique_ptr<ICodableStorage> read(std::chrono::nanoseconds& offset);
+
+    const std::filesystem::path m_path;
+    std::ifstream m_stream;
+    std::unique_ptr<google::protobuf::io::IstreamInputStream> m_input;
+};
+
+}  // namespace mrc::codable
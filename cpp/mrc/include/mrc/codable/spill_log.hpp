@@ -0,0 +1,117 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "mrc/codable/api.hpp"
+#include "mrc/codable/decode.hpp"
+#include "mrc/codable/encode.hpp"
+#include "mrc/codable/encoding_options.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <optional>
+
+namespace mrc::codable {
+
+/**
+ * @brief Append-only file of encoded objects, read back in the order they were appended
+ *
+ * Objects are encoded with their codable protocol with every host buffer copied into the record, as by a
+ * RecordingWriter, and appended to a file created in the directory of the log, which is removed with the log. Reads
+ * follow the appends; once every record has been read the file is truncated, so it only ever holds the records
+ * awaiting a read. A log is not thread safe.
+ *
+ * Objects are encoded and decoded with the resources of the partition of the calling thread, so the log must be used
+ * from a thread of the MRC runtime, e.g. from a node. Files and i/o errors throw std::system_error.
+ */
+class SpillLog final
+{
+  public:
+    explicit SpillLog(const std::filesystem::path& directory);
+    ~SpillLog();
+
+    SpillLog(const SpillLog&)            = delete;
+    SpillLog& operator=(const SpillLog&) = delete;
+
+    /**
+     * @brief Encodes object into a self-contained storage to be appended; as it does not touch the log, it may be
+     * called concurrently with its other methods
+     */
+    template <typename T>
+    static std::unique_ptr<ICodableStorage> encode_object(const T& object)
+    {
+        auto storage = make_storage();
+        encode(object, *storage, encoding_options());
+        return storage;
+    }
+
+    template <typename T>
+    void append(const T& object)
+    {
+        append(*encode_object(object));
+    }
+
+    /**
+     * @brief Append an encoding made by encode_object
+     *
+     * @throws exceptions::MrcRuntimeError if the encoding references memory outside of itself, e.g. device memory
+     */
+    void append(const IStorage& storage);
+
+    /**
+     * @brief The oldest record not yet read; empty if all records have been read
+     */
+    template <typename T>
+    std::optional<T> next()
+    {
+        auto storage = read();
+        if (!storage)
+        {
+            return std::nullopt;
+        }
+        return decode<T>(*storage);
+    }
+
+    // records appended and not yet read
+    std::size_t size() const;
+
+    bool empty() const;
+
+    // bytes of the records appended and not yet read
+    std::uint64_t bytes() const;
+
+    const std::filesystem::path& path() const;
+
+  private:
+    static std::unique_ptr<ICodableStorage> make_storage();
+
+    // every host buffer is carried by an eager descriptor
+    static EncodingOptions encoding_options();
+
+    std::unique_ptr<ICodableStorage> read();
+
+    std::filesystem::path m_path;
+    int m_fd{-1};
+    std::uint64_t m_read_offset{0};
+    std::uint64_t m_write_offset{0};
+    std::size_t m_size{0};
+};
+
+}  // namespace mrc::codable
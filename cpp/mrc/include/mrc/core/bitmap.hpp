@@ -17,10 +17,11 @@
 
 #pragma once
 
+#include <atomic>
+#include <bit>
+#include <climits>
 #include <cstddef>
 #include <cstdint>
-#include <functional>
-#include <mutex>
 #include <ostream>
 #include <string>
 #include <utility>
@@ -130,8 +131,11 @@ class Bitmap
 
     /**
      * @brief execute a lambda with the enumerated ith bit and ith index value as args
+     *
+     * the on bits are enumerated a word at a time, the lambda is invoked inline
      **/
-    void for_each_bit(std::function<void(std::uint32_t, std::uint32_t)>) const;
+    template <typename CallableT>
+    void for_each_bit(CallableT&& lambda) const;
 
     /**
      * @brief Pop first N bits from the current bitmap and transfer them to the returned bitmap
@@ -166,9 +170,31 @@ class Bitmap
     [[nodiscard]] const hwloc_bitmap_s& bitmap() const;
 
   private:
+    // the bitmap as an array of words, least significant word first; the bitmap must be finite
+    [[nodiscard]] std::vector<unsigned long> words() const;
+    static Bitmap from_words(const std::vector<unsigned long>& words);
+
     hwloc_bitmap_t m_bitmap;
 };
 
+template <typename CallableT>
+void Bitmap::for_each_bit(CallableT&& lambda) const
+{
+    constexpr std::uint32_t word_bits = sizeof(unsigned long) * CHAR_BIT;
+
+    std::uint32_t i = 0;
+    std::uint32_t w = 0;
+    for (auto word : words())
+    {
+        while (word != 0)
+        {
+            lambda(i++, w * word_bits + static_cast<std::uint32_t>(std::countr_zero(word)));
+            word &= word - 1;
+        }
+        ++w;
+    }
+}
+
 struct CpuSet : public Bitmap
 {
     using Bitmap::Bitmap;
@@ -192,6 +218,12 @@ struct NumaSet : public Bitmap
     }
 };
 
+/**
+ * @brief Cyclic enumeration of the bits of a CpuSet
+ *
+ * The ids of the set are captured at construction and enumerated by an atomic cursor, so concurrent callers of next
+ * never block one another.
+ */
 class RoundRobinCpuSet
 {
   public:
@@ -230,9 +262,8 @@ class RoundRobinCpuSet
 
   private:
     CpuSet m_bits;
-    int m_prev;
-    int m_index;
-    std::mutex m_mutex;
+    std::vector<int> m_ids;
+    std::atomic<std::size_t> m_cursor{0};
 };
 
 }  // namespace mrc
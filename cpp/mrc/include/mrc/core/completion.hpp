@@ -0,0 +1,236 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "mrc/coroutines/thread_local_context.hpp"
+#include "mrc/utils/macros.hpp"
+
+#include <glog/logging.h>
+
+#include <atomic>
+#include <chrono>
+#include <coroutine>
+#include <optional>
+#include <utility>
+
+namespace mrc {
+
+namespace detail {
+
+/**
+ * @brief Untyped state of a Completion: either not ready, holding the list of its waiters, or ready
+ *
+ * Waiters are intrusive nodes living on the stack of a blocked fiber or thread, or in the frame of a suspended
+ * coroutine, so waiting allocates nothing; only a waiter with a timeout is allocated, since it may leave the list
+ * before the completion is ready.
+ */
+class CompletionBase
+{
+  public:
+    ~CompletionBase();
+
+    DELETE_COPYABILITY(CompletionBase);
+    DELETE_MOVEABILITY(CompletionBase);
+
+    /**
+     * @brief True once the completion is ready; never blocks
+     */
+    bool is_ready() const noexcept
+    {
+        return m_state.load(std::memory_order_acquire) == this;
+    }
+
+    /**
+     * @brief Block the calling fiber, or thread if not called from a fiber, until the completion is ready
+     */
+    void wait() const;
+
+    /**
+     * @brief Block the calling fiber or thread until the completion is ready or the timeout expires; true if ready
+     */
+    bool wait_for(std::chrono::nanoseconds timeout) const;
+
+  protected:
+    class Waiter
+    {
+      public:
+        virtual ~Waiter() = default;
+
+        // called once the completion is ready; the node may be destroyed by its owner as soon as notify returns
+        virtual void notify() = 0;
+
+        // called for a node still in the list when the completion is reset or destroyed
+        virtual void abandon();
+
+        Waiter* m_next{nullptr};
+    };
+
+    class AwaiterBase : public coroutines::ThreadLocalContext, public Waiter
+    {
+      public:
+        explicit AwaiterBase(const CompletionBase& completion) noexcept : m_completion(completion) {}
+
+        bool await_ready() const noexcept
+        {
+            return m_completion.is_ready();
+        }
+
+        bool await_suspend(std::coroutine_handle<> awaiting_coroutine) noexcept;
+
+      protected:
+        void resume_context()
+        {
+            resume_thread_local_context();
+        }
+
+      private:
+        void notify() final;
+
+        const CompletionBase& m_completion;
+        std::coroutine_handle<> m_awaiting_coroutine;
+    };
+
+    CompletionBase() = default;
+
+    // releases the waiters; the completion may be destroyed by a released waiter, so the state is not touched after
+    void set_ready() noexcept;
+
+    // returns a ready completion to the not ready state; requires that no fiber, thread or coroutine is waiting
+    void reset_ready() noexcept;
+
+  private:
+    class BlockingWaiter;
+    class TimedWaiter;
+
+    // false if the completion was ready, in which case the waiter was not added
+    bool push(Waiter* waiter) const noexcept;
+
+    void abandon_waiters(void* state) noexcept;
+
+    // nullptr: not ready without waiters; this: ready; otherwise the head of the list of waiters
+    mutable std::atomic<void*> m_state{nullptr};
+};
+
+}  // namespace detail
+
+/**
+ * @brief Single assignment completion of an asynchronous operation awaitable from fibers, coroutines and threads
+ *
+ * The value is stored in the completion itself, which is owned by the issuer of the operation and neither copied nor
+ * moved while the operation is in flight, e.g. passed as the tag of the operation; unlike a Promise/Future pair there
+ * is no shared state to allocate. A fiber or thread waits with await() or wait_for(), a coroutine with co_await, which
+ * resumes it on the coroutines::ThreadPool it was suspended from. Waiters must not outlive the completion; once a
+ * completion is ready and no longer awaited, reset() prepares it for the next operation.
+ */
+template <typename T>
+class Completion final : public detail::CompletionBase
+{
+  public:
+    class Awaiter : public AwaiterBase
+    {
+      public:
+        explicit Awaiter(Completion& completion) noexcept : AwaiterBase(completion), m_completion(completion) {}
+
+        T& await_resume() noexcept
+        {
+            resume_context();
+            return *m_completion.m_value;
+        }
+
+      private:
+        Completion& m_completion;
+    };
+
+    Completion() = default;
+
+    void complete(T value)
+    {
+        CHECK(!is_ready()) << "a completion may only be completed once";
+        m_value.emplace(std::move(value));
+        set_ready();
+    }
+
+    // blocks the calling fiber or thread until the completion is ready
+    T& await()
+    {
+        wait();
+        return *m_value;
+    }
+
+    // value of a ready completion
+    T& value()
+    {
+        DCHECK(is_ready());
+        return *m_value;
+    }
+
+    void reset()
+    {
+        reset_ready();
+        m_value.reset();
+    }
+
+    Awaiter operator co_await() noexcept
+    {
+        return Awaiter(*this);
+    }
+
+  private:
+    std::optional<T> m_value;
+};
+
+template <>
+class Completion<void> final : public detail::CompletionBase
+{
+  public:
+    class Awaiter : public AwaiterBase
+    {
+      public:
+        explicit Awaiter(Completion& completion) noexcept : AwaiterBase(completion) {}
+
+        void await_resume() noexcept
+        {
+            resume_context();
+        }
+    };
+
+    Completion() = default;
+
+    void complete()
+    {
+        CHECK(!is_ready()) << "a completion may only be completed once";
+        set_ready();
+    }
+
+    void await()
+    {
+        wait();
+    }
+
+    void reset()
+    {
+        reset_ready();
+    }
+
+    Awaiter operator co_await() noexcept
+    {
+        return Awaiter(*this);
+    }
+};
+
+}  // namespace mrc
@@ -19,14 +19,38 @@
 
 #include "mrc/constants.hpp"
 
+#include <chrono>
+#include <cstdint>
+#include <memory>
+
 namespace mrc {
 
+class FiberStackPool;
+
+/**
+ * @brief Weighted group of fibers; among the ready fibers of equal priority on a thread, each group is scheduled in
+ * proportion to its weight. Group 0 holds the unweighted fibers and has a weight of 1.
+ */
+struct FiberShare
+{
+    std::uint32_t group{0};
+    std::uint32_t weight{1};
+};
+
 /**
  * @brief Additional fiber meta data used for when enqueuing work to a TaskQueue
  */
 struct FiberMetaData
 {
     int priority{MRC_DEFAULT_FIBER_PRIORITY};
+
+    // pool from which the stack of the fiber is taken; if null, the fiber is launched with a default stack
+    std::shared_ptr<FiberStackPool> stack_pool{nullptr};
+
+    FiberShare share{};
+
+    // budget of the TimeSlice started each time the fiber is resumed; 0 never yields
+    std::chrono::microseconds time_slice{0};
 };
 
 }  // namespace mrc
@@ -0,0 +1,118 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2021-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "mrc/utils/macros.hpp"
+
+#include <boost/context/stack_context.hpp>
+
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace mrc {
+
+/**
+ * @brief Pool of fixed size fiber stacks shared by the fibers of an engine group
+ *
+ * Stacks are mapped with mmap, optionally with a guard page below the stack and optionally pre-faulted, and are kept
+ * on a freelist when their fiber completes, so launching or restarting engines reuses previously mapped stacks instead
+ * of mapping new ones. Up to capacity free stacks are retained; stacks returned to a full pool are unmapped. Fibers may
+ * complete on a thread other than the one they were launched on, so the pool is thread-safe.
+ */
+class FiberStackPool final : public std::enable_shared_from_this<FiberStackPool>
+{
+  public:
+    /**
+     * @brief boost.context StackAllocator handing out the stacks of a FiberStackPool; holds a reference to the pool
+     * which is released once the fiber has given back its stack
+     */
+    class Allocator
+    {
+      public:
+        explicit Allocator(std::shared_ptr<FiberStackPool> pool);
+
+        boost::context::stack_context allocate();
+        void deallocate(boost::context::stack_context& sctx) noexcept;
+
+      private:
+        std::shared_ptr<FiberStackPool> m_pool;
+    };
+
+    /**
+     * @brief Create a pool of stacks with at least stack_size usable bytes
+     *
+     * @param stack_size - usable size of each stack, rounded up to a multiple of the page size
+     * @param capacity - maximum number of free stacks retained by the pool
+     * @param protect - map a PROT_NONE guard page below each stack so an overflow faults instead of corrupting memory
+     * @param prefault - populate the pages of each stack when it is mapped
+     */
+    static std::shared_ptr<FiberStackPool> create(std::size_t stack_size,
+                                                  std::size_t capacity,
+                                                  bool protect  = false,
+                                                  bool prefault = true);
+
+    ~FiberStackPool();
+
+    DELETE_COPYABILITY(FiberStackPool);
+    DELETE_MOVEABILITY(FiberStackPool);
+
+    /**
+     * @brief StackAllocator to be passed to a boost::fibers::fiber with std::allocator_arg
+     */
+    Allocator allocator();
+
+    /**
+     * @brief Map up to count stacks ahead of the first launches; bounded by the capacity of the pool
+     */
+    void reserve(std::size_t count);
+
+    std::size_t stack_size() const;
+    std::size_t capacity() const;
+    bool protect() const;
+    bool prefault() const;
+
+    // number of free stacks held by the pool
+    std::size_t free_count() const;
+
+    // number of stacks currently mapped by the pool, free or in use
+    std::size_t mapped_count() const;
+
+  private:
+    FiberStackPool(std::size_t stack_size, std::size_t capacity, bool protect, bool prefault);
+
+    boost::context::stack_context pop();
+    void push(boost::context::stack_context& sctx) noexcept;
+
+    void* map_stack() const;
+    void unmap_stack(void* base) const noexcept;
+
+    const std::size_t m_page_size;
+    const std::size_t m_stack_size;
+    const std::size_t m_mapped_size;
+    const std::size_t m_capacity;
+    const bool m_protect;
+    const bool m_prefault;
+
+    mutable std::mutex m_mutex;
+    std::vector<void*> m_free;
+    std::size_t m_mapped_count{0};
+};
+
+}  // namespace mrc
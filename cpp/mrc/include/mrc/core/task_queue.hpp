@@ -57,11 +57,6 @@ class FiberTaskQueue
     auto enqueue(FiberMetaData&& meta_data, F&& f, ArgsT&&... args)
         -> Future<typename std::result_of<F(ArgsT...)>::type>
     {
-        if (task_queue().is_closed())
-        {
-            throw std::runtime_error("enqueue on stopped ws fiber pool");
-        }
-
         using namespace boost::fibers;
         using return_type_t = typename std::result_of<F(ArgsT...)>::type;
 
@@ -75,11 +70,14 @@ class FiberTaskQueue
         });
         ++m_detached;
 
-        // package the wrapped task and meta data as a tuple and push to the buffered channel
+        // package the wrapped task and meta data as a tuple and submit it to the queue
         auto task_package = std::make_pair(std::move(wrapped_task), std::move(meta_data));
 
-        // push the task package to the buffered channel
-        task_queue().push(std::move(task_package));
+        if (!submit(std::move(task_package)))
+        {
+            --m_detached;
+            throw std::runtime_error("enqueue on stopped ws fiber pool");
+        }
 
         // return future
         return future;
@@ -96,7 +94,8 @@ class FiberTaskQueue
     }
 
   private:
-    virtual boost::fibers::buffered_channel<task_pkg_t>& task_queue() = 0;
+    // hands the task package to the fiber thread of the queue; false if the queue is shut down
+    virtual bool submit(task_pkg_t&& task_pkg) = 0;
 
     std::atomic<std::size_t> m_detached{0};
 };
@@ -0,0 +1,117 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace mrc::metrics {
+class Registry;
+}
+
+namespace mrc {
+
+/**
+ * @brief Yields taken by the fibers of a runnable whose time slice had elapsed, and how far they overran it
+ */
+struct TimeSliceUsage
+{
+    std::string name;
+    std::uint64_t yields{0};
+    std::chrono::nanoseconds overrun{0};
+    std::chrono::nanoseconds max_overrun{0};
+};
+
+/**
+ * @brief Cooperative time slices of the fibers launched with a LaunchOptions::time_slice budget
+ *
+ * The FiberPriorityScheduler starts a slice each time it resumes a fiber. The channel operations of a fiber whose
+ * slice has outlasted its budget first yield to the other ready fibers of its thread, so a runnable doing heavy work
+ * per element cannot starve the fibers it shares a thread with, e.g. a network progress engine, for longer than its
+ * budget plus the work between two of its channel operations.
+ *
+ * Fibers without a budget, threads and fibers of other schedulers never yield; their checkpoints cost a thread-local
+ * load. Each yield is accounted, with the overrun of the slice beyond its budget, to the name of the runnable::Context
+ * of the fiber.
+ */
+class TimeSlice
+{
+  public:
+    using clock_type = std::chrono::steady_clock;
+
+    /**
+     * @brief Start a slice of budget on the calling thread; called by the fiber scheduler as it resumes a fiber. A
+     * zero budget disables the checkpoints until the next slice.
+     */
+    static void begin(std::chrono::nanoseconds budget) noexcept
+    {
+        auto& slice  = current();
+        slice.budget = budget;
+        if (budget.count() > 0)
+        {
+            slice.start = clock_type::now();
+        }
+    }
+
+    /**
+     * @brief Yield point; yields the calling fiber if its slice has outlasted its budget
+     */
+    static void checkpoint()
+    {
+        const auto& slice = current();
+        if (slice.budget.count() == 0) [[likely]]
+        {
+            return;
+        }
+        const auto elapsed = clock_type::now() - slice.start;
+        if (elapsed >= slice.budget)
+        {
+            yield(elapsed - slice.budget);
+        }
+    }
+
+    /**
+     * @brief Usage of every runnable which yielded
+     */
+    static std::vector<TimeSliceUsage> collect();
+
+    /**
+     * @brief Increment the mrc_time_slice_yields and mrc_time_slice_overrun_ns counters of the registry by the amounts
+     * accumulated since the previous export and set the mrc_time_slice_max_overrun_ns gauges; all labeled by name
+     */
+    static void export_metrics(metrics::Registry& registry);
+
+  private:
+    struct Slice
+    {
+        std::chrono::nanoseconds budget{0};
+        clock_type::time_point start;
+    };
+
+    static Slice& current() noexcept
+    {
+        thread_local Slice s_slice;
+        return s_slice;
+    }
+
+    static void yield(clock_type::duration overrun);
+};
+
+}  // namespace mrc
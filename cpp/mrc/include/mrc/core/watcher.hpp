@@ -17,19 +17,24 @@
 
 #pragma once
 
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
 #include <memory>
-#include <set>
+#include <utility>
+#include <vector>
 
 namespace mrc {
 
+// MRC_TRACING_DISABLED is defined for builds configured with MRC_BUILD_WATCHERS=OFF; the watcher hooks of channels,
+// sources and sinks then compile to nothing, while watchers may still be added and removed
 #ifdef MRC_TRACING_DISABLED
     #define WATCHER_PROLOGUE(event)
     #define WATCHER_EPILOGUE(event, rc)
-    #define WATCHER_EPILOGUE(event, rc)
 #else
     #define WATCHER_PROLOGUE(event) Watchable::watcher_prologue((event), this)
     #define WATCHER_EPILOGUE(event, rc) Watchable::watcher_epilogue((event), (rc), this)
-    #define WATCHER_EPILOGUE(event, rc) Watchable::watcher_epilogue((event), (rc), this)
 #endif
 
 enum class WatchableEvent
@@ -47,44 +52,177 @@ struct WatcherInterface
     virtual void on_exit(const WatchableEvent&, bool, const void*) = 0;
 };
 
+/**
+ * @brief Process-wide runtime switch for trace watchers and trace taps
+ *
+ * While disabled, trace watchers and trace taps cost a single relaxed atomic load per event rather than a call per
+ * watcher or tap. While enabled, trace taps see 1 in sample_rate elements of each thread; trace watchers see every
+ * event, as their entry and exit events must pair up. Tracing starts enabled if MRC_TRACE_OPERATORS or
+ * MRC_TRACE_CHANNELS is set and follows the flags of TraceStatistics when those are updated.
+ */
+class TraceControl
+{
+  public:
+    static void enable(bool enabled)
+    {
+        s_enabled.store(enabled, std::memory_order_relaxed);
+    }
+
+    static bool is_enabled()
+    {
+        return s_enabled.load(std::memory_order_relaxed);
+    }
+
+    // rates of 0 and 1 both sample every element
+    static void set_sample_rate(std::uint32_t rate)
+    {
+        s_sample_rate.store(rate == 0 ? 1 : rate, std::memory_order_relaxed);
+    }
+
+    static std::uint32_t sample_rate()
+    {
+        return s_sample_rate.load(std::memory_order_relaxed);
+    }
+
+    // true if tracing is enabled and the next element of the calling thread is sampled
+    static bool sample()
+    {
+        if (!is_enabled())
+        {
+            return false;
+        }
+        const auto rate = sample_rate();
+        if (rate == 1)
+        {
+            return true;
+        }
+        thread_local std::uint32_t counter{0};
+        return (++counter % rate) == 0;
+    }
+
+  private:
+    inline static std::atomic<bool> s_enabled{std::getenv("MRC_TRACE_OPERATORS") != nullptr ||
+                                              std::getenv("MRC_TRACE_CHANNELS") != nullptr};
+    inline static std::atomic<std::uint32_t> s_sample_rate{1};
+};
+
+/**
+ * @brief Base of the objects whose events are observed by watchers
+ *
+ * Watchers are kept in flat arrays, so an object without watchers pays a single branch per event and each watcher
+ * is reached without the pointer chasing of a node based container. Adding a watcher twice has no effect.
+ */
 class Watchable
 {
   public:
     void add_watcher(std::shared_ptr<WatcherInterface> /*obs*/);
     void remove_watcher(std::shared_ptr<WatcherInterface> /*obs*/);
 
+    // trace watchers, e.g. TraceStatistics, are only invoked while TraceControl is enabled
+    void add_trace_watcher(std::shared_ptr<WatcherInterface> /*obs*/);
+    void remove_trace_watcher(std::shared_ptr<WatcherInterface> /*obs*/);
+
   protected:
     inline void watcher_prologue(WatchableEvent /*op*/, const void* addr);
     inline void watcher_epilogue(WatchableEvent /*op*/, bool /*rc*/, const void* addr);
 
   private:
-    std::set<std::shared_ptr<WatcherInterface>> m_watchers;
+    using watchers_t = std::vector<std::shared_ptr<WatcherInterface>>;
+
+    static void insert(watchers_t& watchers, std::shared_ptr<WatcherInterface> obs);
+    static void erase(watchers_t& watchers, const std::shared_ptr<WatcherInterface>& obs);
+
+    // true if any watcher or trace watcher is attached; the only check made by the hooks of unwatched objects
+    inline bool is_watched() const;
+
+    watchers_t m_watchers;
+    watchers_t m_trace_watchers;
 };
 
 inline void Watchable::add_watcher(std::shared_ptr<WatcherInterface> obs)
 {
-    m_watchers.insert(obs);
+    insert(m_watchers, std::move(obs));
 }
 
 inline void Watchable::remove_watcher(std::shared_ptr<WatcherInterface> obs)
 {
-    m_watchers.erase(obs);
+    erase(m_watchers, obs);
 }
 
+inline void Watchable::add_trace_watcher(std::shared_ptr<WatcherInterface> obs)
+{
+    insert(m_trace_watchers, std::move(obs));
+}
+
+inline void Watchable::remove_trace_watcher(std::shared_ptr<WatcherInterface> obs)
+{
+    erase(m_trace_watchers, obs);
+}
+
+inline void Watchable::insert(watchers_t& watchers, std::shared_ptr<WatcherInterface> obs)
+{
+    if (obs && std::find(watchers.begin(), watchers.end(), obs) == watchers.end())
+    {
+        watchers.push_back(std::move(obs));
+    }
+}
+
+inline void Watchable::erase(watchers_t& watchers, const std::shared_ptr<WatcherInterface>& obs)
+{
+    watchers.erase(std::remove(watchers.begin(), watchers.end(), obs), watchers.end());
+}
+
+inline bool Watchable::is_watched() const
+{
+    return !m_watchers.empty() || !m_trace_watchers.empty();
+}
+
+#ifdef MRC_TRACING_DISABLED
+
+inline void Watchable::watcher_prologue(WatchableEvent /*op*/, const void* /*addr*/) {}
+
+inline void Watchable::watcher_epilogue(WatchableEvent /*op*/, bool /*rc*/, const void* /*addr*/) {}
+
+#else
+
 inline void Watchable::watcher_prologue(WatchableEvent op, const void* addr)
 {
+    if (!is_watched()) [[likely]]
+    {
+        return;
+    }
     for (const auto& obs : m_watchers)
     {
         obs->on_entry(op, addr);
     }
+    if (!m_trace_watchers.empty() && TraceControl::is_enabled())
+    {
+        for (const auto& obs : m_trace_watchers)
+        {
+            obs->on_entry(op, addr);
+        }
+    }
 }
 
 inline void Watchable::watcher_epilogue(WatchableEvent op, bool rc, const void* addr)
 {
+    if (!is_watched()) [[likely]]
+    {
+        return;
+    }
     for (const auto& obs : m_watchers)
     {
         obs->on_exit(op, rc, addr);
     }
+    if (!m_trace_watchers.empty() && TraceControl::is_enabled())
+    {
+        for (const auto& obs : m_trace_watchers)
+        {
+            obs->on_exit(op, rc, addr);
+        }
+    }
 }
 
+#endif
+
 }  // namespace mrc
@@ -0,0 +1,231 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "mrc/coroutines/frame_pool.hpp"
+
+#include <coroutine>
+#include <exception>
+#include <memory>
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+namespace mrc::coroutines {
+
+template <typename T>
+class AsyncGenerator;
+
+namespace detail {
+
+// resumes the coroutine awaiting the next value once the generator yields or returns
+struct AsyncGeneratorResumeConsumer
+{
+    static auto await_ready() noexcept -> bool
+    {
+        return false;
+    }
+
+    template <typename PromiseT>
+    static auto await_suspend(std::coroutine_handle<PromiseT> handle) noexcept -> std::coroutine_handle<>
+    {
+        return handle.promise().consumer();
+    }
+
+    static auto await_resume() noexcept -> void {}
+};
+
+template <typename T>
+class AsyncGeneratorPromise : public FrameAllocation<use_frame_pool_v<T>>
+{
+  public:
+    AsyncGeneratorPromise() = default;
+
+    auto get_return_object() noexcept -> AsyncGenerator<T>;
+
+    auto initial_suspend() const noexcept
+    {
+        return std::suspend_always{};
+    }
+
+    auto final_suspend() const noexcept
+    {
+        return AsyncGeneratorResumeConsumer{};
+    }
+
+    auto yield_value(T& value) noexcept
+    {
+        m_value = std::addressof(value);
+        return AsyncGeneratorResumeConsumer{};
+    }
+
+    auto yield_value(T&& value) noexcept
+    {
+        m_value = std::addressof(value);
+        return AsyncGeneratorResumeConsumer{};
+    }
+
+    auto unhandled_exception() noexcept -> void
+    {
+        m_exception = std::current_exception();
+    }
+
+    auto return_void() noexcept -> void {}
+
+    auto consumer() const noexcept -> std::coroutine_handle<>
+    {
+        return m_consumer;
+    }
+
+    auto set_consumer(std::coroutine_handle<> consumer) noexcept -> void
+    {
+        m_consumer = consumer;
+        m_value    = nullptr;
+    }
+
+    auto value() const noexcept -> T&
+    {
+        return *m_value;
+    }
+
+    auto rethrow_if_exception() -> void
+    {
+        if (m_exception)
+        {
+            std::rethrow_exception(std::exchange(m_exception, nullptr));
+        }
+    }
+
+  private:
+    T* m_value{nullptr};
+    std::exception_ptr m_exception;
+    std::coroutine_handle<> m_consumer;
+};
+
+}  // namespace detail
+
+/**
+ * @brief Generator whose body may co_await, e.g. to schedule itself onto a ThreadPool or to await i/o, between the
+ * values it yields.
+ *
+ * Values are pulled one at a time by co_awaiting next(), which resumes the body until its next co_yield and returns
+ * the yielded value, or std::nullopt once the body has returned. The body runs only while a next() is awaited, so an
+ * AsyncGenerator does no work ahead of its consumer. The awaiting coroutine is resumed on the execution context the
+ * body yielded from. An exception escaping the body is rethrown by the next() which reaches it.
+ */
+template <typename T>
+class AsyncGenerator
+{
+    static_assert(!std::is_reference_v<T>, "AsyncGenerator yields values");
+
+  public:
+    using promise_type = detail::AsyncGeneratorPromise<T>;
+    using value_type   = T;
+
+    AsyncGenerator() noexcept = default;
+
+    AsyncGenerator(const AsyncGenerator&) = delete;
+    AsyncGenerator(AsyncGenerator&& other) noexcept : m_coroutine(std::exchange(other.m_coroutine, nullptr)) {}
+
+    auto operator=(const AsyncGenerator&) = delete;
+    auto operator=(AsyncGenerator&& other) noexcept -> AsyncGenerator&
+    {
+        if (this != &other)
+        {
+            reset();
+            m_coroutine = std::exchange(other.m_coroutine, nullptr);
+        }
+        return *this;
+    }
+
+    ~AsyncGenerator()
+    {
+        reset();
+    }
+
+    /**
+     * @brief awaitable resuming the body until it yields its next value; must not be awaited concurrently
+     */
+    auto next() noexcept
+    {
+        struct Awaiter
+        {
+            auto await_ready() const noexcept -> bool
+            {
+                return m_coroutine == nullptr || m_coroutine.done();
+            }
+
+            auto await_suspend(std::coroutine_handle<> consumer) noexcept -> std::coroutine_handle<>
+            {
+                m_coroutine.promise().set_consumer(consumer);
+                return m_coroutine;
+            }
+
+            auto await_resume() -> std::optional<T>
+            {
+                if (m_coroutine == nullptr)
+                {
+                    return std::nullopt;
+                }
+                m_coroutine.promise().rethrow_if_exception();
+                if (m_coroutine.done())
+                {
+                    return std::nullopt;
+                }
+                return std::optional<T>(std::move(m_coroutine.promise().value()));
+            }
+
+            std::coroutine_handle<promise_type> m_coroutine;
+        };
+        return Awaiter{m_coroutine};
+    }
+
+    // true once the body has returned
+    auto done() const noexcept -> bool
+    {
+        return m_coroutine == nullptr || m_coroutine.done();
+    }
+
+  private:
+    friend class detail::AsyncGeneratorPromise<T>;
+
+    explicit AsyncGenerator(std::coroutine_handle<promise_type> coroutine) noexcept : m_coroutine(coroutine) {}
+
+    auto reset() noexcept -> void
+    {
+        if (m_coroutine)
+        {
+            m_coroutine.destroy();
+            m_coroutine = nullptr;
+        }
+    }
+
+    std::coroutine_handle<promise_type> m_coroutine{nullptr};
+};
+
+namespace detail {
+
+template <typename T>
+auto AsyncGeneratorPromise<T>::get_return_object() noexcept -> AsyncGenerator<T>
+{
+    return AsyncGenerator<T>{std::coroutine_handle<AsyncGeneratorPromise<T>>::from_promise(*this)};
+}
+
+}  // namespace detail
+
+}  // namespace mrc::coroutines
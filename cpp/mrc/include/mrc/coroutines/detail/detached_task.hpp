@@ -0,0 +1,57 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <coroutine>
+#include <exception>
+
+namespace mrc::coroutines::detail {
+
+/**
+ * Fire-and-forget coroutine; it starts immediately and its frame is destroyed when it completes. The coroutine body
+ * must not let an exception escape.
+ */
+struct DetachedTask
+{
+    struct promise_type  // NOLINT
+    {
+        static auto get_return_object() noexcept -> DetachedTask
+        {
+            return {};
+        }
+
+        static auto initial_suspend() noexcept -> std::suspend_never
+        {
+            return {};
+        }
+
+        static auto final_suspend() noexcept -> std::suspend_never
+        {
+            return {};
+        }
+
+        static auto return_void() noexcept -> void {}
+
+        static auto unhandled_exception() noexcept -> void
+        {
+            std::terminate();
+        }
+    };
+};
+
+}  // namespace mrc::coroutines::detail
@@ -40,9 +40,12 @@
 
 #include "mrc/coroutines/concepts/executor.hpp"
 #include "mrc/coroutines/thread_local_context.hpp"
+#include "mrc/coroutines/timer_wheel.hpp"
 
 #include <atomic>
+#include <chrono>
 #include <coroutine>
+#include <vector>
 
 namespace mrc::coroutines {
 
@@ -75,6 +78,8 @@ t2: resume()
  */
 class Event
 {
+    struct TimedWait;
+
   public:
     struct Awaiter : ThreadLocalContext
     {
@@ -115,6 +120,47 @@ class Event
         std::coroutine_handle<> m_awaiting_coroutine;
         /// The next awaiter in line for this event, nullptr if this is the end.
         Awaiter* m_next{nullptr};
+        /// The timed wait owning this awaiter; nullptr if the awaiter is not waiting with a deadline.
+        TimedWait* m_timed{nullptr};
+    };
+
+    /**
+     * Awaiter returned by wait_until() and wait_for(). The awaiting coroutine is resumed either when the event is set
+     * or when the deadline passes, whichever comes first; in the latter case it is resumed by the timer wheel of the
+     * thread pool it was suspended from (or the process-wide timer wheel) onto that thread pool.
+     */
+    class TimedAwaiter
+    {
+      public:
+        TimedAwaiter(const Event& e, TimerWheel::time_point_t deadline) noexcept : m_event(e), m_deadline(deadline) {}
+        ~TimedAwaiter();
+
+        TimedAwaiter(const TimedAwaiter&)                    = delete;
+        TimedAwaiter(TimedAwaiter&&)                         = delete;
+        auto operator=(const TimedAwaiter&) -> TimedAwaiter& = delete;
+        auto operator=(TimedAwaiter&&) -> TimedAwaiter&      = delete;
+
+        auto await_ready() const noexcept -> bool
+        {
+            return m_event.is_set();
+        }
+
+        /**
+         * Adds a heap allocated waiter to the list of awaiters and arms its timer. The waiter outlives this awaiter
+         * until both the event has released it and the timer has expired or been cancelled.
+         * @return False if the event is already set, otherwise true to suspend this coroutine.
+         */
+        auto await_suspend(std::coroutine_handle<> awaiting_coroutine) -> bool;
+
+        /**
+         * @return True if the event was set, false if the deadline passed first.
+         */
+        auto await_resume() noexcept -> bool;
+
+      private:
+        const Event& m_event;
+        TimerWheel::time_point_t m_deadline;
+        TimedWait* m_wait{nullptr};
     };
 
     /**
@@ -123,7 +169,11 @@ class Event
      *                      set the event to already be triggered.
      */
     explicit Event(bool initially_set = false) noexcept;
-    ~Event() = default;
+
+    /**
+     * Releases the timed waiters still in the list of awaiters; they are resumed when their deadline passes.
+     */
+    ~Event();
 
     Event(const Event&)                    = delete;
     Event(Event&&)                         = delete;
@@ -148,7 +198,9 @@ class Event
 
     /**
      * Sets this event and resumes all awaiters onto the given executor.  This will distribute
-     * the waiters across the executor's threads.
+     * the waiters across the executor's threads.  Executors which resume a range of handles, e.g.
+     * ThreadPool, are handed all of the waiters at once, so the setting thread only unlinks the
+     * waiters rather than scheduling each of them in turn.
      */
     template <concepts::executor ExecutorT>
     auto set(ExecutorT& e, ResumeOrderPolicy policy = ResumeOrderPolicy::lifo) noexcept -> void
@@ -164,11 +216,16 @@ class Event
             // else lifo nothing to do
 
             auto* waiters = static_cast<Awaiter*>(old_value);
-            while (waiters != nullptr)
+            if constexpr (requires(const std::vector<std::coroutine_handle<>>& handles) { e.resume(handles); })
             {
-                auto* next = waiters->m_next;
-                e.resume(waiters->m_awaiting_coroutine);
-                waiters = next;
+                // the handles are collected before any is resumed, as a resumed waiter may destroy its awaiter
+                std::vector<std::coroutine_handle<>> handles;
+                for_each_waiter(waiters, [&](Awaiter& waiter) { handles.push_back(waiter.m_awaiting_coroutine); });
+                e.resume(handles);
+            }
+            else
+            {
+                for_each_waiter(waiters, [&](Awaiter& waiter) { e.resume(waiter.m_awaiting_coroutine); });
             }
         }
     }
@@ -181,6 +238,25 @@ class Event
         return {*this};
     }
 
+    /**
+     * @return An awaiter which resumes the coroutine when the event is set or when the deadline passes; co_await
+     * returns true if the event was set.
+     */
+    [[nodiscard]] auto wait_until(TimerWheel::time_point_t deadline) const noexcept -> TimedAwaiter
+    {
+        return {*this, deadline};
+    }
+
+    /**
+     * @return An awaiter which resumes the coroutine when the event is set or when the duration elapses; co_await
+     * returns true if the event was set.
+     */
+    template <typename RepT, typename PeriodT>
+    [[nodiscard]] auto wait_for(std::chrono::duration<RepT, PeriodT> duration) const noexcept -> TimedAwaiter
+    {
+        return {*this, TimerWheel::clock_t::now() + duration};
+    }
+
     /**
      * Resets the event from set to not set so it can be re-used.  If the event is not currently
      * set then this function has no effect.
@@ -202,6 +278,40 @@ class Event
      * Reverses the set of waiters from LIFO->FIFO and returns the new head.
      */
     static auto reverse(Awaiter* curr) -> Awaiter*;
+
+    /**
+     * Invokes resume_fn with each waiter of the list whose coroutine is to be resumed by the event, i.e. every waiter
+     * but the timed waiters whose deadline has already passed, and drops the references of the list to timed waiters.
+     */
+    template <typename ResumeFnT>
+    static auto for_each_waiter(Awaiter* waiters, ResumeFnT&& resume_fn) noexcept -> void
+    {
+        while (waiters != nullptr)
+        {
+            auto* next  = waiters->m_next;
+            auto* timed = waiters->m_timed;
+            if (timed == nullptr || claim(timed))
+            {
+                resume_fn(*waiters);
+            }
+            if (timed != nullptr)
+            {
+                release(timed);
+            }
+            waiters = next;
+        }
+    }
+
+    /**
+     * Races the timer of a timed waiter to resume its coroutine.
+     * @return True if the caller must resume the coroutine, false if the deadline has already passed.
+     */
+    static auto claim(TimedWait* timed) noexcept -> bool;
+
+    /**
+     * Drops a reference to a timed waiter; it is held by the event, its timer and its TimedAwaiter.
+     */
+    static auto release(TimedWait* timed) noexcept -> void;
 };
 
 }  // namespace mrc::coroutines
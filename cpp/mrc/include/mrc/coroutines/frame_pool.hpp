@@ -0,0 +1,95 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <type_traits>
+
+namespace mrc::coroutines {
+
+/**
+ * Opt-in trait for allocating coroutine frames from the FramePool. Specialize to std::true_type for the value type of
+ * a Task<T> or Generator<T>, e.g. `template <> struct use_frame_pool<MyMessage> : std::true_type {};`, to pool the
+ * frames of every coroutine returning that type. The specialization must be visible wherever such coroutines are
+ * defined.
+ */
+template <typename T>
+struct use_frame_pool : std::false_type
+{};
+
+template <typename T>
+inline constexpr bool use_frame_pool_v = use_frame_pool<T>::value;  // NOLINT
+
+/**
+ * Per-thread, size-classed free lists of coroutine frames.
+ *
+ * Frames of up to MaxFrameSize bytes are rounded up to a multiple of SizeClassBytes; freed frames are kept on the free
+ * list of the freeing thread, up to MaxCachedFrames per size class, and handed out again without a call to the global
+ * allocator. Since coroutines migrate between threads, a frame may be freed to a different thread than it was
+ * allocated on; each free list is only accessed by its thread, so no synchronization is required. Larger frames, and
+ * frames freed once the thread's free lists have been destroyed at thread exit, go to the global allocator.
+ */
+class FramePool
+{
+  public:
+    static constexpr std::size_t SizeClassBytes  = 64;
+    static constexpr std::size_t SizeClassCount  = 16;
+    static constexpr std::size_t MaxFrameSize    = SizeClassBytes * SizeClassCount;
+    static constexpr std::size_t MaxCachedFrames = 256;
+
+    static auto allocate(std::size_t size) -> void*;
+    static auto deallocate(void* ptr, std::size_t size) noexcept -> void;
+
+    /**
+     * @return The number of frames held by the free lists of the calling thread.
+     */
+    static auto cached_frames() noexcept -> std::size_t;
+
+    /**
+     * Returns the frames held by the free lists of the calling thread to the global allocator.
+     */
+    static auto release_cached_frames() noexcept -> void;
+};
+
+namespace detail {
+
+/**
+ * Base of coroutine promises providing the frame allocation functions; frames use the global allocator unless the
+ * promise opts in to the FramePool.
+ */
+template <bool UseFramePoolV>
+struct FrameAllocation
+{};
+
+template <>
+struct FrameAllocation<true>
+{
+    static auto operator new(std::size_t size) -> void*
+    {
+        return FramePool::allocate(size);
+    }
+
+    static auto operator delete(void* ptr, std::size_t size) noexcept -> void
+    {
+        FramePool::deallocate(ptr, size);
+    }
+};
+
+}  // namespace detail
+
+}  // namespace mrc::coroutines
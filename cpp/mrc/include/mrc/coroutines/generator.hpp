@@ -38,6 +38,8 @@
 
 #pragma once
 
+#include "mrc/coroutines/frame_pool.hpp"
+
 #include <coroutine>
 #include <memory>
 #include <type_traits>
@@ -50,7 +52,7 @@ class Generator;
 namespace detail {
 
 template <typename T>
-class GeneratorPromise
+class GeneratorPromise : public FrameAllocation<use_frame_pool_v<T>>
 {
   public:
     using value_type     = std::remove_reference_t<T>;
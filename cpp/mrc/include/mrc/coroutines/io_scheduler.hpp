@@ -0,0 +1,287 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <sys/socket.h>
+
+#include <atomic>
+#include <chrono>
+#include <coroutine>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <string>
+
+namespace mrc::coroutines {
+
+class ThreadPool;
+
+/**
+ * Event loop which lets coroutines co_await file and socket I/O and timers without blocking a thread.
+ *
+ * A single reactor thread owns the kernel interface. With the io_uring backend reads, writes and accepts are submitted
+ * to the submission ring and complete asynchronously, including reads of regular files. With the epoll backend the
+ * operation is attempted non-blocking first and, if it would block, retried once the file descriptor becomes ready;
+ * regular files are always ready under epoll so their reads and writes are performed inline by the awaiting thread.
+ * Sockets and pipes must therefore be opened with O_NONBLOCK when the epoll backend may be selected.
+ * The automatic backend uses io_uring when the kernel supports it and falls back to epoll otherwise.
+ *
+ * Results follow the io_uring convention: a non-negative value is the number of bytes transferred (or the accepted
+ * file descriptor) and a negative value is -errno.
+ *
+ * Awaiting coroutines are resumed on the reactor thread, or on Options::thread_pool when one is provided. Work done
+ * inline on the reactor thread delays every other completion, so long running continuations should either use a
+ * thread pool or co_await ThreadPool::schedule().
+ *
+ * Under the epoll backend at most one operation may be outstanding on a file descriptor at a time.
+ *
+ * IoScheduler satisfies concepts::executor; schedule() and yield() move the awaiting coroutine onto the reactor.
+ * shutdown() waits for every outstanding operation and timer to complete.
+ */
+class IoScheduler
+{
+  public:
+    using clock_t      = std::chrono::steady_clock;
+    using time_point_t = clock_t::time_point;
+
+    enum class Backend
+    {
+        automatic,
+        io_uring,
+        epoll,
+    };
+
+    struct Options
+    {
+        /// Kernel interface used for I/O operations.
+        Backend backend{Backend::automatic};
+        /// Number of submission queue entries requested from io_uring.
+        std::uint32_t queue_depth{256};
+        /// Pool on which completed coroutines are resumed; if null, they are resumed on the reactor thread.
+        ThreadPool* thread_pool{nullptr};
+        /// Description
+        std::string description;
+    };
+
+    /**
+     * Awaitable which switches the awaiting coroutine onto the reactor thread.
+     */
+    class ScheduleOperation
+    {
+        friend class IoScheduler;
+        explicit ScheduleOperation(IoScheduler& scheduler) noexcept : m_scheduler(scheduler) {}
+
+      public:
+        constexpr static auto await_ready() noexcept -> bool
+        {
+            return false;
+        }
+
+        auto await_suspend(std::coroutine_handle<> awaiting_coroutine) noexcept -> void;
+
+        constexpr static auto await_resume() noexcept -> void {}
+
+      private:
+        IoScheduler& m_scheduler;
+    };
+
+    /**
+     * Awaitable which resumes the awaiting coroutine once its deadline has passed.
+     */
+    class TimerOperation
+    {
+        friend class IoScheduler;
+        TimerOperation(IoScheduler& scheduler, time_point_t deadline) noexcept :
+          m_scheduler(scheduler),
+          m_deadline(deadline)
+        {}
+
+      public:
+        auto await_ready() const noexcept -> bool
+        {
+            return m_deadline <= clock_t::now();
+        }
+
+        auto await_suspend(std::coroutine_handle<> awaiting_coroutine) noexcept -> void;
+
+        constexpr static auto await_resume() noexcept -> void {}
+
+      private:
+        IoScheduler& m_scheduler;
+        time_point_t m_deadline;
+    };
+
+    /**
+     * Awaitable for a single read, write or accept; co_await yields the result of the operation.
+     */
+    class IoOperation
+    {
+        friend class IoScheduler;
+
+      public:
+        enum class Kind
+        {
+            read,
+            write,
+            accept,
+        };
+
+        constexpr static auto await_ready() noexcept -> bool
+        {
+            return false;
+        }
+
+        /**
+         * @return False if the operation completed without suspending, e.g. an epoll read of buffered data.
+         */
+        auto await_suspend(std::coroutine_handle<> awaiting_coroutine) noexcept -> bool;
+
+        auto await_resume() const noexcept -> std::int64_t
+        {
+            return m_result;
+        }
+
+      private:
+        IoOperation(IoScheduler& scheduler, Kind kind, int fd, void* buffer, std::size_t size, std::int64_t offset) :
+          m_scheduler(scheduler),
+          m_kind(kind),
+          m_fd(fd),
+          m_buffer(buffer),
+          m_size(size),
+          m_offset(offset)
+        {}
+
+        /// Performs the operation with a non-blocking syscall, storing the result; used by the epoll backend.
+        auto attempt() noexcept -> void;
+
+        IoScheduler& m_scheduler;
+        Kind m_kind;
+        int m_fd;
+        void* m_buffer;
+        std::size_t m_size;
+        std::int64_t m_offset;
+        sockaddr* m_addr{nullptr};
+        socklen_t* m_addrlen{nullptr};
+        std::int64_t m_result{0};
+        std::coroutine_handle<> m_awaiting_coroutine{nullptr};
+    };
+
+    IoScheduler();
+
+    /**
+     * @param opts Io scheduler configuration options.
+     * @throw std::system_error If the requested backend is not available or the reactor could not be created.
+     */
+    explicit IoScheduler(Options opts);
+
+    IoScheduler(const IoScheduler&)                    = delete;
+    IoScheduler(IoScheduler&&)                         = delete;
+    auto operator=(const IoScheduler&) -> IoScheduler& = delete;
+    auto operator=(IoScheduler&&) -> IoScheduler&      = delete;
+
+    ~IoScheduler();
+
+    /**
+     * @return The backend in use; never Backend::automatic.
+     */
+    auto backend() const noexcept -> Backend;
+
+    /**
+     * Moves the awaiting coroutine onto the reactor thread.
+     */
+    [[nodiscard]] auto schedule() -> ScheduleOperation;
+
+    /**
+     * Places the awaiting coroutine behind the completions already waiting on the reactor.
+     */
+    [[nodiscard]] auto yield() -> ScheduleOperation
+    {
+        return schedule();
+    }
+
+    /**
+     * Resumes the handle on the reactor thread.
+     */
+    auto resume(std::coroutine_handle<> handle) noexcept -> void;
+
+    /**
+     * Suspends the awaiting coroutine for at least `duration`.
+     */
+    [[nodiscard]] auto schedule_after(std::chrono::nanoseconds duration) -> TimerOperation;
+
+    /**
+     * Suspends the awaiting coroutine until `deadline`.
+     */
+    [[nodiscard]] auto schedule_at(time_point_t deadline) -> TimerOperation;
+
+    /**
+     * Reads up to buffer.size() bytes from fd.
+     * @param offset File offset to read from, or -1 to read from (and advance) the current file position.
+     */
+    [[nodiscard]] auto read(int fd, std::span<std::byte> buffer, std::int64_t offset = -1) -> IoOperation;
+
+    /**
+     * Writes up to buffer.size() bytes to fd.
+     * @param offset File offset to write to, or -1 to write at (and advance) the current file position.
+     */
+    [[nodiscard]] auto write(int fd, std::span<const std::byte> buffer, std::int64_t offset = -1) -> IoOperation;
+
+    /**
+     * Accepts a connection on the listening socket fd; the accepted socket is created with SOCK_NONBLOCK and
+     * SOCK_CLOEXEC.
+     */
+    [[nodiscard]] auto accept(int fd, sockaddr* addr = nullptr, socklen_t* addrlen = nullptr) -> IoOperation;
+
+    /**
+     * Stops the reactor after every outstanding operation and timer has completed. New operations must not be issued
+     * once shutdown has been called.
+     */
+    auto shutdown() noexcept -> void;
+
+    /**
+     * @return The number of operations, timers and scheduled coroutines which have not yet been resumed.
+     */
+    auto size() const noexcept -> std::size_t
+    {
+        return m_size.load(std::memory_order::acquire);
+    }
+
+    auto empty() const noexcept -> bool
+    {
+        return size() == 0;
+    }
+
+    /**
+     * @return std::string description of the io scheduler
+     */
+    const std::string& description() const;
+
+  private:
+    /// Reactor thread, kernel interfaces and pending work; defined in io_scheduler.cpp.
+    struct Reactor;
+
+    auto submit(IoOperation& op) noexcept -> bool;
+    auto add_timer(TimerOperation& op, std::coroutine_handle<> handle) noexcept -> void;
+
+    Options m_opts;
+    std::atomic<std::size_t> m_size{0};
+    std::unique_ptr<Reactor> m_reactor;
+};
+
+}  // namespace mrc::coroutines
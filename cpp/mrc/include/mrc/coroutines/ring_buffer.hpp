@@ -42,13 +42,17 @@
 #include "mrc/coroutines/schedule_policy.hpp"
 #include "mrc/coroutines/thread_local_context.hpp"
 #include "mrc/coroutines/thread_pool.hpp"
+#include "mrc/coroutines/timer_wheel.hpp"
 
 #include <glog/logging.h>
 
 #include <atomic>
+#include <chrono>
 #include <coroutine>
+#include <cstddef>
 #include <mutex>
 #include <optional>
+#include <type_traits>
 #include <vector>
 
 namespace mrc::coroutines {
@@ -57,8 +61,59 @@ enum class RingBufferOpStatus
 {
     Success,
     Stopped,
+    Timeout,
 };
 
+template <typename ElementT>
+class Select;
+
+namespace detail {
+
+/**
+ * The claim shared by the read operations a Select links into several ring buffers; the first ring buffer to claim it
+ * completes the select, and the read operations left linked in the other ring buffers are skipped.
+ */
+class SelectClaim
+{
+  public:
+    static constexpr std::size_t NoWinner = ~std::size_t{0};
+
+    auto claim(std::size_t index) noexcept -> bool
+    {
+        auto expected = NoWinner;
+        return m_winner.compare_exchange_strong(expected, index, std::memory_order::acq_rel);
+    }
+
+    /**
+     * @return The index of the ring buffer which won the claim, or NoWinner.
+     */
+    auto winner() const noexcept -> std::size_t
+    {
+        return m_winner.load(std::memory_order::acquire);
+    }
+
+    /**
+     * Counts down the linking of the reads by the select and the completion of the read by the winner.
+     * @return True for the last of the two, which is responsible for resuming the awaiting coroutine.
+     */
+    auto arrive() noexcept -> bool
+    {
+        return m_latch.fetch_sub(1, std::memory_order::acq_rel) == 1;
+    }
+
+    auto reset() noexcept -> void
+    {
+        m_winner.store(NoWinner, std::memory_order::relaxed);
+        m_latch.store(2, std::memory_order::relaxed);
+    }
+
+  private:
+    std::atomic<std::size_t> m_winner{NoWinner};
+    std::atomic<std::size_t> m_latch{2};
+};
+
+}  // namespace detail
+
 /**
  * @tparam ElementT The type of element the ring buffer will store.  Note that this type should be
  *         cheap to move if possible as it is moved into and out of the buffer upon write and
@@ -111,12 +166,31 @@ class RingBuffer
     auto operator=(const RingBuffer<ElementT>&) noexcept -> RingBuffer<ElementT>& = delete;
     auto operator=(RingBuffer<ElementT>&&) noexcept -> RingBuffer<ElementT>&      = delete;
 
+  private:
+    /// Expires a suspended operation which has a deadline; armed on the TimerWheel of the suspending thread.
+    template <typename OperationT>
+    struct DeadlineTimer final : TimerWheel::Timer
+    {
+        explicit DeadlineTimer(OperationT& op) : m_op(op) {}
+
+        void on_expired() noexcept final
+        {
+            m_op.m_rb.expire_waiter(m_op);
+        }
+
+        OperationT& m_op;
+    };
+
+  public:
     struct WriteOperation : ThreadLocalContext
     {
-        WriteOperation(RingBuffer<ElementT>& rb, ElementT e) :
+        WriteOperation(RingBuffer<ElementT>& rb,
+                       ElementT e,
+                       std::optional<TimerWheel::time_point_t> deadline = std::nullopt) :
           m_rb(rb),
           m_e(std::move(e)),
-          m_policy(m_rb.m_writer_policy)
+          m_policy(m_rb.m_writer_policy),
+          m_deadline(deadline)
         {}
 
         auto await_ready() noexcept -> bool
@@ -141,21 +215,39 @@ class RingBuffer
             // m_lock was acquired as part of await_ready; await_suspend is responsible for releasing the lock
             auto lock = std::move(m_lock);  // use raii
 
+            // the buffer is full; don't suspend if the deadline has passed
+            if (m_deadline && *m_deadline <= TimerWheel::clock_t::now())
+            {
+                m_timed_out = true;
+                return false;
+            }
+
             ThreadLocalContext::suspend_thread_local_context();
 
             m_awaiting_coroutine = awaiting_coroutine;
             m_next               = m_rb.m_write_waiters;
             m_rb.m_write_waiters = this;
+
+            // the timer expires the operation under the ring buffer lock, so it cannot race the linking above
+            if (m_deadline)
+            {
+                m_wheel = &TimerWheel::current();
+                m_wheel->schedule(m_timer, *m_deadline);
+            }
             return true;
         }
 
         /**
-         * @return write_result
+         * @return write_result; on Stopped or Timeout the element was not written
          */
         auto await_resume() -> RingBufferOpStatus
         {
             ThreadLocalContext::resume_thread_local_context();
-            return (!m_stopped ? RingBufferOpStatus::Success : RingBufferOpStatus::Stopped);
+            if (m_stopped)
+            {
+                return RingBufferOpStatus::Stopped;
+            }
+            return (!m_timed_out ? RingBufferOpStatus::Success : RingBufferOpStatus::Timeout);
         }
 
         WriteOperation& use_scheduling_policy(SchedulePolicy policy)
@@ -179,8 +271,19 @@ class RingBuffer
 
       private:
         friend RingBuffer;
+        friend DeadlineTimer<WriteOperation>;
 
         void resume()
+        {
+            // the timer may be blocked on the ring buffer lock to expire this operation; cancel waits for it to return
+            if (m_wheel != nullptr)
+            {
+                m_wheel->cancel(m_timer);
+            }
+            resume_awaiting();
+        }
+
+        void resume_awaiting()
         {
             if (m_policy == SchedulePolicy::Immediate)
             {
@@ -203,13 +306,25 @@ class RingBuffer
         bool m_stopped{false};
         /// Scheduling Policy - default provided by the RingBuffer, but can be overrided owner of the Awaiter
         SchedulePolicy m_policy;
+        /// If set, the operation returns RingBufferOpStatus::Timeout if it cannot complete by the deadline.
+        std::optional<TimerWheel::time_point_t> m_deadline;
+        /// The timer wheel on which m_timer is armed; nullptr if the operation did not suspend with a deadline.
+        TimerWheel* m_wheel{nullptr};
+        DeadlineTimer<WriteOperation> m_timer{*this};
+        /// Did the deadline pass?
+        bool m_timed_out{false};
         /// Span to measure the duration the writer spent writting data
         // trace::Handle<trace::Span> m_write_span{nullptr};
     };
 
     struct ReadOperation : ThreadLocalContext
     {
-        explicit ReadOperation(RingBuffer<ElementT>& rb) : m_rb(rb), m_policy(m_rb.m_reader_policy) {}
+        explicit ReadOperation(RingBuffer<ElementT>& rb,
+                               std::optional<TimerWheel::time_point_t> deadline = std::nullopt) :
+          m_rb(rb),
+          m_policy(m_rb.m_reader_policy),
+          m_deadline(deadline)
+        {}
 
         auto await_ready() noexcept -> bool
         {
@@ -231,12 +346,26 @@ class RingBuffer
                 return false;
             }
 
+            // the buffer is empty; don't suspend if the deadline has passed
+            if (m_deadline && *m_deadline <= TimerWheel::clock_t::now())
+            {
+                m_timed_out = true;
+                return false;
+            }
+
             // m_read_span->AddEvent("buffer_empty");
             ThreadLocalContext::suspend_thread_local_context();
 
             m_awaiting_coroutine = awaiting_coroutine;
             m_next               = m_rb.m_read_waiters;
             m_rb.m_read_waiters  = this;
+
+            // the timer expires the operation under the ring buffer lock, so it cannot race the linking above
+            if (m_deadline)
+            {
+                m_wheel = &TimerWheel::current();
+                m_wheel->schedule(m_timer, *m_deadline);
+            }
             return true;
         }
 
@@ -252,6 +381,11 @@ class RingBuffer
                 return std23::unexpected<RingBufferOpStatus>(RingBufferOpStatus::Stopped);
             }
 
+            if (m_timed_out)
+            {
+                return std23::unexpected<RingBufferOpStatus>(RingBufferOpStatus::Timeout);
+            }
+
             return std::move(m_e);
         }
 
@@ -276,8 +410,31 @@ class RingBuffer
 
       private:
         friend RingBuffer;
+        friend DeadlineTimer<ReadOperation>;
+        friend Select<ElementT>;
+
+        /// A read linked by a Select may only be completed by the ring buffer which wins the select's claim.
+        auto try_claim() noexcept -> bool
+        {
+            return m_select == nullptr || m_select->claim(m_select_index);
+        }
 
         void resume()
+        {
+            // the timer may be blocked on the ring buffer lock to expire this operation; cancel waits for it to return
+            if (m_wheel != nullptr)
+            {
+                m_wheel->cancel(m_timer);
+            }
+            // a select may still be linking its other reads; the last of it and this completion resumes the coroutine
+            if (m_select != nullptr && !m_select->arrive())
+            {
+                return;
+            }
+            resume_awaiting();
+        }
+
+        void resume_awaiting()
         {
             if (m_policy == SchedulePolicy::Immediate)
             {
@@ -300,6 +457,16 @@ class RingBuffer
         bool m_stopped{false};
         /// Scheduling Policy - default provided by the RingBuffer, but can be overrided owner of the Awaiter
         SchedulePolicy m_policy;
+        /// If set, the operation returns RingBufferOpStatus::Timeout if no element is available by the deadline.
+        std::optional<TimerWheel::time_point_t> m_deadline;
+        /// The timer wheel on which m_timer is armed; nullptr if the operation did not suspend with a deadline.
+        TimerWheel* m_wheel{nullptr};
+        DeadlineTimer<ReadOperation> m_timer{*this};
+        /// Did the deadline pass?
+        bool m_timed_out{false};
+        /// If linked by a Select, the claim shared with its reads of the other ring buffers and the index of this one.
+        detail::SelectClaim* m_select{nullptr};
+        std::size_t m_select_index{0};
         /// Span measure time awaiting on reading data
         // trace::Handle<trace::Span> m_read_span;
     };
@@ -323,6 +490,36 @@ class RingBuffer
         return ReadOperation{*this};
     }
 
+    /**
+     * Produces the given element into the ring buffer, suspending until a slot becomes available or the deadline
+     * passes, in which case the operation returns RingBufferOpStatus::Timeout and the element is dropped.
+     */
+    [[nodiscard]] auto write_until(ElementT e, TimerWheel::time_point_t deadline) -> WriteOperation
+    {
+        return WriteOperation{*this, std::move(e), deadline};
+    }
+
+    template <typename RepT, typename PeriodT>
+    [[nodiscard]] auto write_for(ElementT e, std::chrono::duration<RepT, PeriodT> timeout) -> WriteOperation
+    {
+        return write_until(std::move(e), TimerWheel::clock_t::now() + timeout);
+    }
+
+    /**
+     * Consumes an element from the ring buffer, suspending until an element becomes available or the deadline passes,
+     * in which case the operation returns an unexpected RingBufferOpStatus::Timeout.
+     */
+    [[nodiscard]] auto read_until(TimerWheel::time_point_t deadline) -> ReadOperation
+    {
+        return ReadOperation{*this, deadline};
+    }
+
+    template <typename RepT, typename PeriodT>
+    [[nodiscard]] auto read_for(std::chrono::duration<RepT, PeriodT> timeout) -> ReadOperation
+    {
+        return read_until(TimerWheel::clock_t::now() + timeout);
+    }
+
     void close()
     {
         // if there are awaiting readers, then we must wait them up and signal that the buffer is closed;
@@ -348,9 +545,13 @@ class RingBuffer
             // signal all awaiting readers that the buffer is stopped
             while (m_read_waiters != nullptr)
             {
-                auto* to_resume      = m_read_waiters;
+                auto* to_resume = m_read_waiters;
+                m_read_waiters  = m_read_waiters->m_next;
+                if (!to_resume->try_claim())
+                {
+                    continue;
+                }
                 to_resume->m_stopped = true;
-                m_read_waiters       = m_read_waiters->m_next;
 
                 lk.unlock();
                 to_resume->resume();
@@ -409,9 +610,13 @@ class RingBuffer
 
         while (m_read_waiters != nullptr)
         {
-            auto* to_resume      = m_read_waiters;
+            auto* to_resume = m_read_waiters;
+            m_read_waiters  = m_read_waiters->m_next;
+            if (!to_resume->try_claim())
+            {
+                continue;
+            }
             to_resume->m_stopped = true;
-            m_read_waiters       = m_read_waiters->m_next;
 
             lk.unlock();
             to_resume->resume();
@@ -422,6 +627,86 @@ class RingBuffer
   private:
     friend WriteOperation;
     friend ReadOperation;
+    friend Select<ElementT>;
+
+    /// Called by the DeadlineTimer of a suspended operation; a no-op if the operation has already been dequeued.
+    template <typename OperationT>
+    auto expire_waiter(OperationT& op) noexcept -> void
+    {
+        std::unique_lock lk{m_mutex};
+
+        if (!unlink_waiter_locked(op))
+        {
+            return;
+        }
+        op.m_timed_out = true;
+
+        lk.unlock();
+        op.resume_awaiting();
+    }
+
+    /**
+     * Called by a Select; completes the read if an element is available, or the ring buffer is stopped and empty, and
+     * the select wins the claim. Otherwise, if the select has not been claimed by another ring buffer, links the read.
+     * @return True if the read was completed.
+     */
+    auto select_read(ReadOperation& op) -> bool
+    {
+        std::unique_lock lk{m_mutex};
+
+        if (m_used == 0 && !m_stopped.load(std::memory_order::acquire))
+        {
+            op.m_next      = m_read_waiters;
+            m_read_waiters = &op;
+            return false;
+        }
+
+        if (!op.try_claim())
+        {
+            return false;
+        }
+
+        if (!try_read_locked(lk, &op))
+        {
+            op.m_stopped = true;
+        }
+        return true;
+    }
+
+    /// Called by a Select to unlink the reads which did not win its claim.
+    auto unlink_select_read(ReadOperation& op) -> void
+    {
+        std::unique_lock lk{m_mutex};
+        unlink_waiter_locked(op);
+    }
+
+    /// @return True if the operation was found in, and removed from, its list of waiters.
+    template <typename OperationT>
+    auto unlink_waiter_locked(OperationT& op) noexcept -> bool
+    {
+        OperationT** link = nullptr;
+        if constexpr (std::is_same_v<OperationT, WriteOperation>)
+        {
+            link = &m_write_waiters;
+        }
+        else
+        {
+            link = &m_read_waiters;
+        }
+
+        while (*link != nullptr && *link != &op)
+        {
+            link = &(*link)->m_next;
+        }
+
+        if (*link == nullptr)
+        {
+            return false;
+        }
+
+        *link = op.m_next;
+        return true;
+    }
 
     mutex_type m_mutex{};
 
@@ -459,15 +744,23 @@ class RingBuffer
 
         ReadOperation* to_resume = nullptr;
 
-        if (m_read_waiters != nullptr)
+        while (m_read_waiters != nullptr)
         {
-            to_resume      = m_read_waiters;
+            auto* waiter   = m_read_waiters;
             m_read_waiters = m_read_waiters->m_next;
 
+            // a read linked by a select which has completed on another ring buffer is dropped
+            if (!waiter->try_claim())
+            {
+                continue;
+            }
+
             // Since the read operation suspended it needs to be provided an element to read.
+            to_resume      = waiter;
             to_resume->m_e = std::move(m_elements[m_back]);
             m_back         = (m_back + 1) % m_num_elements;
             --m_used;  // And we just consumed up another item.
+            break;
         }
 
         // release lock
@@ -0,0 +1,211 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "mrc/core/std23_expected.hpp"
+#include "mrc/coroutines/ring_buffer.hpp"
+
+#include <coroutine>
+#include <cstddef>
+#include <optional>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace mrc::coroutines {
+
+template <typename ElementT>
+struct SelectResult
+{
+    /// The index of the ring buffer the element was read from; Select::size() once every ring buffer is drained.
+    std::size_t index;
+    /// The element, or RingBufferOpStatus::Stopped when the ring buffer at index has been closed and drained.
+    std23::expected<ElementT, RingBufferOpStatus> value;
+};
+
+/**
+ * Multiplexes reads over several ring buffers, so that a single coroutine can consume all of its inputs without
+ * spawning a task per input.
+ *
+ * Each read completes with an element of the first ring buffer with one available. The ring buffers are polled in
+ * rotation, starting after the one which completed the previous read, so a busy input cannot starve the others. If no
+ * ring buffer has an element, the read is linked as a waiter into each of them; the first ring buffer to be written to
+ * completes the select and the reads left in the others are unlinked without losing an element.
+ *
+ * A ring buffer which has been closed and drained completes one read with RingBufferOpStatus::Stopped and its index,
+ * and is skipped by subsequent reads; once every ring buffer is drained, reads complete immediately with an index of
+ * size(). Only one read may be outstanding at a time and the ring buffers must outlive the Select.
+ */
+template <typename ElementT>
+class Select
+{
+    using ring_buffer_t = RingBuffer<ElementT>;
+    using read_t        = typename ring_buffer_t::ReadOperation;
+
+  public:
+    /**
+     * @throws std::runtime_error If `buffers` is empty.
+     */
+    explicit Select(std::vector<ring_buffer_t*> buffers) :
+      m_buffers(std::move(buffers)),
+      m_reads(m_buffers.size()),
+      m_drained(m_buffers.size(), false),
+      m_active(m_buffers.size())
+    {
+        if (m_buffers.empty())
+        {
+            throw std::runtime_error{"select requires at least one ring buffer"};
+        }
+    }
+
+    Select(const Select&)                    = delete;
+    Select(Select&&)                         = delete;
+    auto operator=(const Select&) -> Select& = delete;
+    auto operator=(Select&&) -> Select&      = delete;
+
+    struct ReadOperation
+    {
+        explicit ReadOperation(Select& select) : m_select(select) {}
+
+        auto await_ready() const noexcept -> bool
+        {
+            return m_select.m_active == 0;
+        }
+
+        auto await_suspend(std::coroutine_handle<> awaiting_coroutine) -> bool
+        {
+            return m_select.link(awaiting_coroutine);
+        }
+
+        auto await_resume() -> SelectResult<ElementT>
+        {
+            return m_select.complete();
+        }
+
+      private:
+        Select& m_select;
+    };
+
+    /**
+     * Consumes an element from the first ring buffer with one available, suspending until one does.
+     */
+    [[nodiscard]] auto read() -> ReadOperation
+    {
+        return ReadOperation{*this};
+    }
+
+    /**
+     * @return The number of ring buffers.
+     */
+    auto size() const noexcept -> std::size_t
+    {
+        return m_buffers.size();
+    }
+
+    /**
+     * @return The number of ring buffers which have not been closed and drained.
+     */
+    auto active() const noexcept -> std::size_t
+    {
+        return m_active;
+    }
+
+  private:
+    /// @return True if the awaiting coroutine must suspend.
+    auto link(std::coroutine_handle<> awaiting_coroutine) -> bool
+    {
+        m_claim.reset();
+
+        for (std::size_t offset = 0; offset < m_buffers.size(); ++offset)
+        {
+            auto idx = (m_cursor + offset) % m_buffers.size();
+            if (m_drained[idx])
+            {
+                continue;
+            }
+
+            auto& op                = m_reads[idx].emplace(*m_buffers[idx]);
+            op.m_select             = &m_claim;
+            op.m_select_index       = idx;
+            op.m_awaiting_coroutine = awaiting_coroutine;
+            op.suspend_thread_local_context();
+
+            if (m_buffers[idx]->select_read(op))
+            {
+                // completed without another ring buffer claiming the select, so there is no one else to resume it
+                return false;
+            }
+
+            // a ring buffer has completed one of the linked reads; there is no need to link the others
+            if (m_claim.winner() != detail::SelectClaim::NoWinner)
+            {
+                break;
+            }
+        }
+
+        return !m_claim.arrive();
+    }
+
+    auto complete() -> SelectResult<ElementT>
+    {
+        if (m_active == 0)
+        {
+            return {m_buffers.size(), std23::unexpected<RingBufferOpStatus>(RingBufferOpStatus::Stopped)};
+        }
+
+        auto winner = m_claim.winner();
+
+        for (std::size_t idx = 0; idx < m_buffers.size(); ++idx)
+        {
+            if (idx != winner && m_reads[idx].has_value())
+            {
+                m_buffers[idx]->unlink_select_read(*m_reads[idx]);
+                m_reads[idx].reset();
+            }
+        }
+
+        auto& op = *m_reads[winner];
+        op.resume_thread_local_context();
+
+        SelectResult<ElementT> result{winner, std23::unexpected<RingBufferOpStatus>(RingBufferOpStatus::Stopped)};
+        if (op.m_stopped)
+        {
+            m_drained[winner] = true;
+            --m_active;
+        }
+        else
+        {
+            result.value = std::move(op.m_e);
+        }
+
+        m_reads[winner].reset();
+        m_cursor = (winner + 1) % m_buffers.size();
+        return result;
+    }
+
+    std::vector<ring_buffer_t*> m_buffers;
+    /// The reads linked into each ring buffer by the outstanding read of the select.
+    std::vector<std::optional<read_t>> m_reads;
+    std::vector<bool> m_drained;
+    std::size_t m_active;
+    /// The ring buffer polled first by the next read.
+    std::size_t m_cursor{0};
+    detail::SelectClaim m_claim;
+};
+
+}  // namespace mrc::coroutines
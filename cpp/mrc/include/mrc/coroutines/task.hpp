@@ -39,6 +39,7 @@
 #pragma once
 
 #include "mrc/coroutines/concepts/promise.hpp"
+#include "mrc/coroutines/frame_pool.hpp"
 #include "mrc/coroutines/thread_local_context.hpp"
 
 #include <glog/logging.h>
@@ -110,7 +111,7 @@ struct PromiseBase
 };
 
 template <typename ReturnT>
-struct Promise final : public PromiseBase
+struct Promise final : public PromiseBase, public FrameAllocation<use_frame_pool_v<ReturnT>>
 {
     using task_type      = Task<ReturnT>;
     using coroutine_type = std::coroutine_handle<Promise<ReturnT>>;
@@ -150,7 +151,7 @@ struct Promise final : public PromiseBase
 };
 
 template <>
-struct Promise<void> : public PromiseBase
+struct Promise<void> : public PromiseBase, public FrameAllocation<use_frame_pool_v<void>>
 {
     using task_type      = Task<void>;
     using coroutine_type = std::coroutine_handle<Promise<void>>;
@@ -41,12 +41,15 @@
 #include "mrc/coroutines/concepts/range_of.hpp"
 #include "mrc/coroutines/task.hpp"
 #include "mrc/coroutines/thread_local_context.hpp"
+#include "mrc/coroutines/timer_wheel.hpp"
 
 #include <atomic>
+#include <chrono>
 #include <condition_variable>
 #include <coroutine>
 #include <deque>
 #include <functional>
+#include <memory>
 #include <mutex>
 #include <optional>
 #include <ranges>
@@ -59,6 +62,13 @@ namespace mrc::coroutines {
  * Creates a thread pool that executes arbitrary coroutine tasks in a FIFO scheduler policy.
  * The thread pool by default will create an execution thread per available core on the system.
  *
+ * Each executor thread owns a local FIFO queue plus a LIFO slot. Coroutines scheduled or resumed from an executor
+ * thread stay on that thread: resume() places the handle in the LIFO slot, if it is free, so a continuation runs next
+ * while its data is still hot in cache, while schedule() and yield() append to the local queue. A handle is never
+ * displaced from the LIFO slot, so waiters resumed in order, e.g. by Event::set() with ResumeOrderPolicy::fifo, also
+ * run in order. Handles submitted from threads outside the pool go to a global injection queue. An idle executor takes
+ * work from the global queue, then steals half of the local queue of a randomly chosen victim.
+ *
  * When shutting down, either by the thread pool destructing or by manually calling shutdown()
  * the thread pool will stop accepting new tasks but will complete all tasks that were scheduled
  * prior to the shutdown request.
@@ -185,37 +195,25 @@ class ThreadPool
     auto resume(std::coroutine_handle<> handle) noexcept -> void;
 
     /**
-     * Schedules the set of coroutine handles that are ready to be resumed.
+     * Schedules the set of coroutine handles that are ready to be resumed. The handles are queued in bulk, striped
+     * across the executors for large sets, and as many sleeping executors are woken as there are handles to run.
      * @param handles The coroutine handles to schedule.
      */
     template <concepts::range_of<std::coroutine_handle<>> RangeT>
     auto resume(const RangeT& handles) noexcept -> void
     {
-        m_size.fetch_add(std::size(handles), std::memory_order::release);
-
-        size_t null_handles{0};
-
+        std::vector<std::coroutine_handle<>> batch;
+        batch.reserve(std::size(handles));
+        for (const auto& handle : handles)
         {
-            std::scoped_lock lk{m_wait_mutex};
-            for (const auto& handle : handles)
+            if (handle != nullptr) [[likely]]
             {
-                if (handle != nullptr) [[likely]]
-                {
-                    m_queue.emplace_back(handle);
-                }
-                else
-                {
-                    ++null_handles;
-                }
+                batch.emplace_back(handle);
             }
         }
 
-        if (null_handles > 0)
-        {
-            m_size.fetch_sub(null_handles, std::memory_order::release);
-        }
-
-        m_wait_cv.notify_one();
+        m_size.fetch_add(batch.size(), std::memory_order::release);
+        schedule_batch(std::move(batch));
     }
 
     /**
@@ -229,6 +227,32 @@ class ThreadPool
         return schedule();
     }
 
+    /**
+     * Suspends the current task until the deadline, then resumes it on this thread pool. The deadline is tracked by
+     * the timer wheel of this thread pool, so a sleeping task does not occupy an executor thread.
+     */
+    [[nodiscard]] auto sleep_until(TimerWheel::time_point_t deadline) -> TimerWheel::SleepOperation
+    {
+        return TimerWheel::SleepOperation{*m_timer_wheel, deadline, this};
+    }
+
+    /**
+     * Suspends the current task for the duration, then resumes it on this thread pool.
+     */
+    template <typename RepT, typename PeriodT>
+    [[nodiscard]] auto sleep_for(std::chrono::duration<RepT, PeriodT> duration) -> TimerWheel::SleepOperation
+    {
+        return sleep_until(TimerWheel::clock_t::now() + duration);
+    }
+
+    /**
+     * @return The timer wheel owned by this thread pool; its ticker thread is started by the first timer scheduled.
+     */
+    auto timer_wheel() noexcept -> TimerWheel&
+    {
+        return *m_timer_wheel;
+    }
+
     /**
      * Shutsdown the thread pool.  This will finish any tasks scheduled prior to calling this
      * function but will prevent the thread pool from scheduling any new tasks.  This call is
@@ -257,9 +281,7 @@ class ThreadPool
      */
     auto queue_size() const noexcept -> std::size_t
     {
-        // Might not be totally perfect but good enough, avoids acquiring the lock for now.
-        std::atomic_thread_fence(std::memory_order::acquire);
-        return m_queue.size();
+        return m_queued.load(std::memory_order::acquire);
     }
 
     /**
@@ -288,17 +310,29 @@ class ThreadPool
     const std::string& description() const;
 
   private:
+    /// Per-executor local queue and LIFO slot; defined in thread_pool.cpp.
+    struct Worker;
+
     /// The configuration options.
     Options m_opts;
+    /// The per-executor queues, indexed by executor idx.
+    std::vector<std::unique_ptr<Worker>> m_workers;
     /// The background executor threads.
     std::vector<std::jthread> m_threads;
+    /// Timers of the sleep and deadline operations awaited by tasks of this pool.
+    std::unique_ptr<TimerWheel> m_timer_wheel;
 
-    /// Mutex for executor threads to sleep on the condition variable.
+    /// Mutex guarding the global injection queue; executor threads also sleep on it.
     std::mutex m_wait_mutex;
     /// Condition variable for each executor thread to wait on when no tasks are available.
     std::condition_variable_any m_wait_cv;
-    /// FIFO queue of tasks waiting to be executed.
+    /// FIFO queue of tasks submitted from threads outside of the pool.
     std::deque<std::coroutine_handle<>> m_queue;
+    /// The number of handles in the global queue, the local queues and the LIFO slots.
+    std::atomic<std::size_t> m_queued{0};
+    /// The number of executor threads waiting on m_wait_cv.
+    std::atomic<std::size_t> m_sleepers{0};
+
     /**
      * Each background thread runs from this function.
      * @param stop_token Token which signals when shutdown() has been called.
@@ -308,8 +342,32 @@ class ThreadPool
 
     /**
      * @param handle Schedules the given coroutine to be executed upon the first available thread.
+     * @param lifo When called from an executor thread of this pool, place the handle in the LIFO slot, if free, rather
+     * than at the back of the local queue.
+     */
+    auto schedule_impl(std::coroutine_handle<> handle, bool lifo) noexcept -> void;
+
+    /**
+     * @param handles Non-null handles to append to the local queue, or the global queue if called from outside the
+     * pool; large batches are striped across the local queues of all executors.
      */
-    auto schedule_impl(std::coroutine_handle<> handle) noexcept -> void;
+    auto schedule_batch(std::vector<std::coroutine_handle<>>&& handles) noexcept -> void;
+
+    /**
+     * @return The next handle for executor idx to resume: LIFO slot, local queue, global queue, then a stolen handle.
+     */
+    auto next_handle(std::size_t idx) noexcept -> std::coroutine_handle<>;
+
+    /**
+     * @return A handle stolen from a random victim; up to half of the victim's local queue moves to executor idx.
+     */
+    auto steal(std::size_t idx) noexcept -> std::coroutine_handle<>;
+
+    /// Wake a sleeping executor after m_queued has been incremented.
+    auto notify_sleeper() noexcept -> void;
+
+    /// Wake up to count sleeping executors after m_queued has been incremented.
+    auto notify_sleepers(std::size_t count) noexcept -> void;
 
     /// The number of tasks in the queue + currently executing.
     std::atomic<std::size_t> m_size{0};
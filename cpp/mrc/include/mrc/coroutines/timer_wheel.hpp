@@ -0,0 +1,261 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "mrc/coroutines/thread_local_context.hpp"
+
+#include <array>
+#include <chrono>
+#include <condition_variable>
+#include <coroutine>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+
+namespace mrc::coroutines {
+
+/**
+ * Hierarchical timer wheel driven by a single ticker thread.
+ *
+ * Timers are intrusive objects owned by the caller, so scheduling and cancelling a timer never allocates. The wheel has
+ * LevelCount levels of SlotCount slots; level 0 slots are one tick wide, and each level above spans SlotCount times the
+ * level below. A timer is placed on the lowest level which can hold its deadline and is cascaded down a level each time
+ * the wheel reaches the slot it was placed in, so scheduling, cancelling and expiring a timer are all O(1). Deadlines
+ * beyond the range of the top level are parked in its last slot and re-placed when they are cascaded.
+ *
+ * The ticker thread only wakes at the next tick with work to do: the next occupied level 0 slot or the next cascade of
+ * an occupied slot of a higher level. It is started on the first call to schedule(). Expiry callbacks are invoked on
+ * the ticker thread without the wheel lock held and must not block; awaiters built on the wheel hand the coroutine
+ * they resume to the thread pool it was suspended from.
+ *
+ * Timers never expire before their deadline; they expire up to one tick after it.
+ */
+class TimerWheel
+{
+  public:
+    using clock_t      = std::chrono::steady_clock;
+    using time_point_t = clock_t::time_point;
+
+    static constexpr std::size_t SlotBits   = 6;
+    static constexpr std::size_t SlotCount  = 1 << SlotBits;
+    static constexpr std::size_t LevelCount = 4;
+
+    /**
+     * An intrusive timer entry; implementations override on_expired(). A timer may be scheduled again once it has
+     * expired or has been cancelled. A pending timer must be cancelled before it is destroyed.
+     */
+    class Timer
+    {
+      public:
+        Timer()          = default;
+        virtual ~Timer() = default;
+
+        Timer(const Timer&)                    = delete;
+        Timer(Timer&&)                         = delete;
+        auto operator=(const Timer&) -> Timer& = delete;
+        auto operator=(Timer&&) -> Timer&      = delete;
+
+      protected:
+        /**
+         * Called on the ticker thread once the deadline has passed. The wheel does not access the timer after this
+         * returns, so the callback may destroy the object owning the timer.
+         */
+        virtual void on_expired() noexcept = 0;
+
+      private:
+        friend TimerWheel;
+
+        /// Neighbours in the slot (or expired list) holding this timer.
+        Timer* m_prev{nullptr};
+        Timer* m_next{nullptr};
+        /// The tick at which the timer expires.
+        std::uint64_t m_expiry{0};
+        /// The level and slot holding the timer; level == LevelCount is the list of expired timers.
+        std::uint32_t m_level{0};
+        std::uint32_t m_slot{0};
+        /// True while the timer is held by the wheel, i.e. scheduled and not yet handed to on_expired().
+        bool m_pending{false};
+    };
+
+    /**
+     * Awaitable which suspends the awaiting coroutine until a deadline. The coroutine is resumed on the thread pool it
+     * was suspended from, or on the ticker thread if it was not suspended from a thread pool; see resume_on().
+     */
+    class SleepOperation : private Timer, private ThreadLocalContext
+    {
+      public:
+        SleepOperation(TimerWheel& wheel, time_point_t deadline, ThreadPool* thread_pool = nullptr) noexcept;
+
+        auto await_ready() const noexcept -> bool
+        {
+            return m_deadline <= clock_t::now();
+        }
+
+        auto await_suspend(std::coroutine_handle<> awaiting_coroutine) noexcept -> void;
+
+        auto await_resume() noexcept -> void;
+
+        /// Resume the coroutine on the given thread pool rather than on the thread pool it was suspended from.
+        auto resume_on(ThreadPool* thread_pool) noexcept -> SleepOperation&
+        {
+            m_resume_on = thread_pool;
+            return *this;
+        }
+
+      private:
+        void on_expired() noexcept final;
+
+        TimerWheel& m_wheel;
+        time_point_t m_deadline;
+        ThreadPool* m_resume_on;
+        std::coroutine_handle<> m_awaiting_coroutine;
+    };
+
+    struct Options
+    {
+        /// The duration of one tick of the wheel.
+        std::chrono::nanoseconds resolution{std::chrono::milliseconds(1)};
+        /// Description
+        std::string description;
+    };
+
+    TimerWheel();
+    explicit TimerWheel(Options opts);
+
+    TimerWheel(const TimerWheel&)                    = delete;
+    TimerWheel(TimerWheel&&)                         = delete;
+    auto operator=(const TimerWheel&) -> TimerWheel& = delete;
+    auto operator=(TimerWheel&&) -> TimerWheel&      = delete;
+
+    /**
+     * Shuts down the wheel, expiring any pending timers, and joins the ticker thread.
+     */
+    ~TimerWheel();
+
+    /**
+     * Schedules the timer to expire at the deadline; a deadline in the past expires on the next tick.
+     * The timer must not be pending.
+     */
+    auto schedule(Timer& timer, time_point_t deadline) -> void;
+
+    /**
+     * Cancels a pending timer. If the timer has already been handed to on_expired(), waits for the callback to return.
+     * Must not be called from the timer's own on_expired().
+     * @return True if the timer was pending and will not expire, false if it has expired or was never scheduled.
+     */
+    auto cancel(Timer& timer) -> bool;
+
+    /**
+     * Expires all pending timers and waits for their callbacks to return. Timers scheduled after shutdown expire
+     * immediately.
+     */
+    auto shutdown() -> void;
+
+    /**
+     * @return Awaitable which suspends the awaiting coroutine until the deadline.
+     */
+    [[nodiscard]] auto sleep_until(time_point_t deadline) -> SleepOperation
+    {
+        return SleepOperation{*this, deadline};
+    }
+
+    /**
+     * @return Awaitable which suspends the awaiting coroutine for the duration.
+     */
+    template <typename RepT, typename PeriodT>
+    [[nodiscard]] auto sleep_for(std::chrono::duration<RepT, PeriodT> duration) -> SleepOperation
+    {
+        return SleepOperation{*this, clock_t::now() + duration};
+    }
+
+    /**
+     * @return The number of timers which are pending or whose callbacks have not yet been invoked.
+     */
+    auto size() const -> std::size_t;
+
+    auto resolution() const noexcept -> std::chrono::nanoseconds
+    {
+        return m_opts.resolution;
+    }
+
+    /**
+     * @return std::string description of the timer wheel
+     */
+    const std::string& description() const;
+
+    /**
+     * @return The timer wheel of the thread pool owning the calling thread; otherwise, a process-wide timer wheel.
+     */
+    static auto current() -> TimerWheel&;
+
+  private:
+    using bitmap_t = std::uint64_t;
+
+    static constexpr std::uint64_t NoTick = ~std::uint64_t{0};
+
+    auto ticker() -> void;
+
+    auto deadline_to_tick(time_point_t deadline) const -> std::uint64_t;
+    auto tick_to_time_point(std::uint64_t tick) const -> time_point_t;
+    auto current_tick() const -> std::uint64_t;
+
+    /// Places a timer in the slot for its expiry relative to m_now.
+    auto insert_locked(Timer& timer) -> void;
+    /// Appends a timer to the expired list.
+    auto expire_locked(Timer& timer) -> void;
+    auto link_locked(Timer& timer, std::uint32_t level, std::uint32_t slot) -> void;
+    auto unlink_locked(Timer& timer) -> void;
+
+    /// @return The next tick at which a level 0 slot expires or an occupied slot of a higher level cascades.
+    auto next_tick_locked() const -> std::uint64_t;
+    /// Advances m_now to the tick, moving expired timers to the expired list.
+    auto advance_locked(std::uint64_t tick) -> void;
+    auto process_tick_locked(std::uint64_t tick) -> void;
+    auto expire_all_locked() -> void;
+
+    Options m_opts;
+    time_point_t m_epoch;
+
+    mutable std::mutex m_mutex;
+    /// Wakes the ticker thread when a timer is scheduled before its next wake up.
+    std::condition_variable m_ticker_cv;
+    /// Wakes threads in cancel() or shutdown() waiting on expiry callbacks.
+    std::condition_variable m_expired_cv;
+
+    std::array<std::array<Timer*, SlotCount>, LevelCount> m_slots{};
+    std::array<bitmap_t, LevelCount> m_occupied{};
+    Timer* m_expired_head{nullptr};
+    Timer* m_expired_tail{nullptr};
+
+    /// All ticks up to and including m_now have been processed.
+    std::uint64_t m_now{0};
+    /// The tick at which the ticker thread will next wake; NoTick when waiting for a timer to be scheduled.
+    std::uint64_t m_wake_tick{NoTick};
+    /// The number of pending timers plus the timer whose callback is running.
+    std::size_t m_size{0};
+    /// The timer whose callback is running on the ticker thread.
+    Timer* m_firing{nullptr};
+
+    bool m_shutdown{false};
+    bool m_stop{false};
+    std::thread m_thread;
+};
+
+}  // namespace mrc::coroutines
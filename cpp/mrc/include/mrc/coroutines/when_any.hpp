@@ -0,0 +1,234 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "mrc/coroutines/concepts/awaitable.hpp"
+#include "mrc/coroutines/detail/detached_task.hpp"
+#include "mrc/coroutines/detail/void_value.hpp"
+#include "mrc/coroutines/task.hpp"
+#include "mrc/coroutines/thread_local_context.hpp"
+
+#include <atomic>
+#include <coroutine>
+#include <cstddef>
+#include <exception>
+#include <memory>
+#include <optional>
+#include <ranges>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace mrc::coroutines {
+
+namespace detail {
+
+/// The value type of an awaitable; when_any() returns the value of the winner by value, as the winner is destroyed.
+template <typename AwaitableT>
+using when_any_return_t = std::remove_cvref_t<typename concepts::awaitable_traits<AwaitableT>::awaiter_return_type>;
+
+template <typename ReturnT>
+using when_any_value_t = std::conditional_t<std::is_void_v<ReturnT>, VoidValue, ReturnT>;
+
+/**
+ * State shared by the coroutine awaiting when_any() and the detached coroutines running each awaitable; the first
+ * awaitable to complete claims the state and resumes the awaiting coroutine.
+ */
+template <typename ReturnT>
+class WhenAnyState final : public ThreadLocalContext
+{
+  public:
+    using value_t  = when_any_value_t<ReturnT>;
+    using result_t = std::pair<std::size_t, value_t>;
+
+    template <typename... ArgsT>
+    auto set_value(std::size_t index, ArgsT&&... args) -> void
+    {
+        if (claim())
+        {
+            m_result.emplace(index, value_t(std::forward<ArgsT>(args)...));
+            complete();
+        }
+    }
+
+    auto set_exception(std::exception_ptr exception) -> void
+    {
+        if (claim())
+        {
+            m_exception = std::move(exception);
+            complete();
+        }
+    }
+
+    /**
+     * @return True if the awaiting coroutine must suspend; false if an awaitable has already completed.
+     */
+    auto try_await(std::coroutine_handle<> awaiting_coroutine) noexcept -> bool
+    {
+        m_awaiting_coroutine = awaiting_coroutine;
+        ThreadLocalContext::suspend_thread_local_context();
+        return m_latch.fetch_sub(1, std::memory_order::acq_rel) > 1;
+    }
+
+    auto result() -> result_t
+    {
+        ThreadLocalContext::resume_thread_local_context();
+        if (m_exception)
+        {
+            std::rethrow_exception(m_exception);
+        }
+        return std::move(*m_result);
+    }
+
+  private:
+    auto claim() noexcept -> bool
+    {
+        return !m_claimed.exchange(true, std::memory_order::acq_rel);
+    }
+
+    auto complete() noexcept -> void
+    {
+        if (m_latch.fetch_sub(1, std::memory_order::acq_rel) == 1)
+        {
+            resume_coroutine(m_awaiting_coroutine);
+        }
+    }
+
+    std::coroutine_handle<> m_awaiting_coroutine;
+    /// Counts down the suspension of the awaiting coroutine and the completion of the first awaitable.
+    std::atomic<std::size_t> m_latch{2};
+    std::atomic<bool> m_claimed{false};
+    std::optional<result_t> m_result;
+    std::exception_ptr m_exception;
+};
+
+template <typename ReturnT, concepts::awaitable AwaitableT>
+auto run_when_any(std::shared_ptr<WhenAnyState<ReturnT>> state, std::size_t index, AwaitableT awaitable)
+    -> DetachedTask
+{
+    try
+    {
+        if constexpr (std::is_void_v<ReturnT>)
+        {
+            co_await static_cast<AwaitableT&&>(awaitable);
+            state->set_value(index);
+        }
+        else
+        {
+            state->set_value(index, co_await static_cast<AwaitableT&&>(awaitable));
+        }
+    } catch (...)
+    {
+        state->set_exception(std::current_exception());
+    }
+}
+
+template <typename ReturnT, concepts::awaitable AwaitableT>
+class WhenAnyAwaiter
+{
+  public:
+    WhenAnyAwaiter(std::shared_ptr<WhenAnyState<ReturnT>> state, std::vector<AwaitableT> awaitables) :
+      m_state(std::move(state)),
+      m_awaitables(std::move(awaitables))
+    {}
+
+    static auto await_ready() noexcept -> bool
+    {
+        return false;
+    }
+
+    auto await_suspend(std::coroutine_handle<> awaiting_coroutine) -> bool
+    {
+        for (std::size_t idx = 0; idx < m_awaitables.size(); ++idx)
+        {
+            run_when_any<ReturnT>(m_state, idx, std::move(m_awaitables[idx]));
+        }
+        return m_state->try_await(awaiting_coroutine);
+    }
+
+    auto await_resume() -> typename WhenAnyState<ReturnT>::result_t
+    {
+        return m_state->result();
+    }
+
+  private:
+    std::shared_ptr<WhenAnyState<ReturnT>> m_state;
+    std::vector<AwaitableT> m_awaitables;
+};
+
+template <typename ReturnT, concepts::awaitable AwaitableT>
+auto make_when_any_task(std::vector<AwaitableT> awaitables) -> Task<std::pair<std::size_t, when_any_value_t<ReturnT>>>
+{
+    if (awaitables.empty())
+    {
+        throw std::runtime_error{"when_any requires at least one awaitable"};
+    }
+
+    auto state = std::make_shared<WhenAnyState<ReturnT>>();
+    co_return co_await WhenAnyAwaiter<ReturnT, AwaitableT>{std::move(state), std::move(awaitables)};
+}
+
+}  // namespace detail
+
+/**
+ * Races the awaitables, all of which are started when the returned task is awaited, in order, on the awaiting thread.
+ *
+ * @return The index and value of the first awaitable to complete, void values being returned as detail::VoidValue; if
+ * the first awaitable to complete throws, its exception is rethrown. The awaiting coroutine is resumed on the thread
+ * pool it was suspended from, if any. The remaining awaitables keep running detached and their results are discarded,
+ * so they must not reference state owned by the awaiting coroutine.
+ */
+template <concepts::awaitable AwaitableT, concepts::awaitable... AwaitablesT>
+[[nodiscard]] auto when_any(AwaitableT awaitable, AwaitablesT... awaitables)
+    -> Task<std::pair<std::size_t, detail::when_any_value_t<detail::when_any_return_t<AwaitableT>>>>
+{
+    static_assert((std::is_same_v<AwaitablesT, AwaitableT> && ...), "when_any requires awaitables of the same type");
+
+    using return_t = detail::when_any_return_t<AwaitableT>;
+
+    std::vector<AwaitableT> output;
+    output.reserve(1 + sizeof...(AwaitablesT));
+    output.push_back(std::move(awaitable));
+    (output.push_back(std::move(awaitables)), ...);
+
+    return detail::make_when_any_task<return_t>(std::move(output));
+}
+
+template <std::ranges::range RangeT,
+          concepts::awaitable AwaitableT = std::ranges::range_value_t<RangeT>,
+          typename ReturnT               = detail::when_any_return_t<AwaitableT>>
+[[nodiscard]] auto when_any(RangeT awaitables) -> Task<std::pair<std::size_t, detail::when_any_value_t<ReturnT>>>
+{
+    std::vector<AwaitableT> output;
+
+    // If the size is known in constant time reserve the output size.
+    if constexpr (std::ranges::sized_range<RangeT>)
+    {
+        output.reserve(std::size(awaitables));
+    }
+
+    for (auto& a : awaitables)
+    {
+        output.emplace_back(std::move(a));
+    }
+
+    return detail::make_when_any_task<ReturnT>(std::move(output));
+}
+
+}  // namespace mrc::coroutines
@@ -0,0 +1,225 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "mrc/core/std23_expected.hpp"
+#include "mrc/coroutines/detail/detached_task.hpp"
+#include "mrc/coroutines/task.hpp"
+#include "mrc/coroutines/thread_local_context.hpp"
+#include "mrc/coroutines/timer_wheel.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <coroutine>
+#include <cstddef>
+#include <exception>
+#include <memory>
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+namespace mrc::coroutines {
+
+/**
+ * Error returned by with_timeout() when the task did not complete before the timeout.
+ */
+struct Timeout
+{};
+
+namespace detail {
+
+/**
+ * State shared by the coroutine awaiting with_timeout(), the detached coroutine running the task and the timer; the
+ * first of the task and the timer to complete claims the state and resumes the awaiting coroutine.
+ */
+template <typename ReturnT>
+class TimeoutState final : public TimerWheel::Timer, public ThreadLocalContext
+{
+  public:
+    using result_t = std23::expected<ReturnT, Timeout>;
+
+    explicit TimeoutState(TimerWheel& wheel) : m_wheel(wheel) {}
+
+    ~TimeoutState() override = default;
+
+    auto wheel() -> TimerWheel&
+    {
+        return m_wheel;
+    }
+
+    template <typename... ArgsT>
+    auto set_value(ArgsT&&... args) -> void
+    {
+        if (claim())
+        {
+            m_result.emplace(std::forward<ArgsT>(args)...);
+            complete();
+        }
+    }
+
+    auto set_exception(std::exception_ptr exception) -> void
+    {
+        if (claim())
+        {
+            m_exception = std::move(exception);
+            complete();
+        }
+    }
+
+    /**
+     * @return True if the awaiting coroutine must suspend; false if the task or the timer has already completed.
+     */
+    auto try_await(std::coroutine_handle<> awaiting_coroutine) noexcept -> bool
+    {
+        m_awaiting_coroutine = awaiting_coroutine;
+        ThreadLocalContext::suspend_thread_local_context();
+        return m_latch.fetch_sub(1, std::memory_order::acq_rel) > 1;
+    }
+
+    auto result() -> result_t
+    {
+        ThreadLocalContext::resume_thread_local_context();
+        if (m_exception)
+        {
+            std::rethrow_exception(m_exception);
+        }
+        if constexpr (std::is_void_v<ReturnT>)
+        {
+            // moving an expected<void, E> is ambiguous with the converting constructors of std23::expected
+            if (m_result->has_value())
+            {
+                return {};
+            }
+            return std23::unexpected<Timeout>(Timeout{});
+        }
+        else
+        {
+            return std::move(*m_result);
+        }
+    }
+
+  private:
+    void on_expired() noexcept final
+    {
+        if (claim())
+        {
+            m_result.emplace(std23::unexpected<Timeout>(Timeout{}));
+            complete();
+        }
+    }
+
+    auto claim() noexcept -> bool
+    {
+        return !m_claimed.exchange(true, std::memory_order::acq_rel);
+    }
+
+    auto complete() noexcept -> void
+    {
+        if (m_latch.fetch_sub(1, std::memory_order::acq_rel) == 1)
+        {
+            resume_coroutine(m_awaiting_coroutine);
+        }
+    }
+
+    TimerWheel& m_wheel;
+    std::coroutine_handle<> m_awaiting_coroutine;
+    /// Counts down the suspension of the awaiting coroutine and the completion of the winner of the race.
+    std::atomic<std::size_t> m_latch{2};
+    std::atomic<bool> m_claimed{false};
+    std::optional<result_t> m_result;
+    std::exception_ptr m_exception;
+};
+
+template <typename ReturnT>
+auto run_with_timeout(std::shared_ptr<TimeoutState<ReturnT>> state, Task<ReturnT> task) -> DetachedTask
+{
+    try
+    {
+        if constexpr (std::is_void_v<ReturnT>)
+        {
+            co_await std::move(task);
+            state->set_value();
+        }
+        else
+        {
+            state->set_value(co_await std::move(task));
+        }
+    } catch (...)
+    {
+        state->set_exception(std::current_exception());
+    }
+
+    // the timer must not be left pending on, or be expiring, a state which may be released with this frame
+    state->wheel().cancel(*state);
+}
+
+template <typename ReturnT>
+class TimeoutAwaiter
+{
+  public:
+    TimeoutAwaiter(std::shared_ptr<TimeoutState<ReturnT>> state,
+                   Task<ReturnT> task,
+                   TimerWheel::time_point_t deadline) :
+      m_state(std::move(state)),
+      m_task(std::move(task)),
+      m_deadline(deadline)
+    {}
+
+    static auto await_ready() noexcept -> bool
+    {
+        return false;
+    }
+
+    auto await_suspend(std::coroutine_handle<> awaiting_coroutine) -> bool
+    {
+        // armed before the task starts so that only the runner, which always cancels the timer, can release the state
+        m_state->wheel().schedule(*m_state, m_deadline);
+        run_with_timeout(m_state, std::move(m_task));
+        return m_state->try_await(awaiting_coroutine);
+    }
+
+    auto await_resume() -> typename TimeoutState<ReturnT>::result_t
+    {
+        return m_state->result();
+    }
+
+  private:
+    std::shared_ptr<TimeoutState<ReturnT>> m_state;
+    Task<ReturnT> m_task;
+    TimerWheel::time_point_t m_deadline;
+};
+
+}  // namespace detail
+
+/**
+ * Races a task against a timeout tracked by TimerWheel::current().
+ *
+ * The task is started when the returned task is awaited. If the task completes first its value is returned, or its
+ * exception rethrown; otherwise an unexpected Timeout is returned and the task keeps running detached, its eventual
+ * result being discarded. The awaiting coroutine is resumed on the thread pool it was suspended from, if any.
+ */
+template <typename ReturnT, typename RepT, typename PeriodT>
+[[nodiscard]] auto with_timeout(Task<ReturnT> task, std::chrono::duration<RepT, PeriodT> timeout)
+    -> Task<std23::expected<ReturnT, Timeout>>
+{
+    auto state = std::make_shared<detail::TimeoutState<ReturnT>>(TimerWheel::current());
+    co_return co_await detail::TimeoutAwaiter<ReturnT>{
+        std::move(state), std::move(task), TimerWheel::clock_t::now() + timeout};
+}
+
+}  // namespace mrc::coroutines
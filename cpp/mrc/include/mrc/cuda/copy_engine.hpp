@@ -0,0 +1,155 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2021-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "mrc/coroutines/event.hpp"
+#include "mrc/types.hpp"  // for Promise & SharedFuture
+#include "mrc/utils/macros.hpp"
+
+#include <cuda_runtime.h>
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+
+namespace mrc {
+
+class CopyEngine;
+
+/**
+ * @brief Completion of a batch of asynchronous copies issued by a CopyEngine
+ *
+ * Copies are coalesced into a batch until the batch is full or flushed; checking or awaiting a completion flushes its
+ * batch, so a completion is always eventually ready. A completion is both fiber and coroutine awaitable: await()
+ * blocks the calling fiber, while co_await suspends the calling coroutine until the batch completes and resumes it on
+ * the coroutines::ThreadPool it was suspended from.
+ */
+class CopyCompletion
+{
+  public:
+    CopyCompletion() = default;
+
+    /**
+     * @brief True once every copy of the batch completed; flushes the batch
+     */
+    bool is_ready() const;
+
+    /**
+     * @brief Block the calling fiber until every copy of the batch completed; flushes the batch
+     */
+    void await() const;
+
+    auto operator co_await() const
+    {
+        flush();
+        return coroutines::Event::Awaiter(event());
+    }
+
+  private:
+    struct Batch;
+
+    CopyCompletion(std::shared_ptr<Batch> batch);
+
+    void flush() const;
+    const coroutines::Event& event() const;
+
+    std::shared_ptr<Batch> m_batch;
+
+    friend CopyEngine;
+};
+
+/**
+ * @brief Asynchronous copy and prefetch engine of a device
+ *
+ * Host to device, device to host and device to device copies are issued onto dedicated non-blocking streams, one per
+ * direction, so small copies in one direction are never queued behind large copies in another. Instead of
+ * synchronizing each copy, consecutive copies of a direction share a single completion: the host function signalling
+ * a batch is enqueued when max_batch_size copies accumulated, when the batch is flushed, or when one of its
+ * completions is checked or awaited. Prefetches of managed memory are ordered with the copies towards their
+ * destination, and peer copies between devices with the device to device copies.
+ */
+class CopyEngine final
+{
+  public:
+    CopyEngine(int device_id, std::size_t max_batch_size = 32);
+    ~CopyEngine();
+
+    DELETE_COPYABILITY(CopyEngine);
+    DELETE_MOVEABILITY(CopyEngine);
+
+    /**
+     * @brief Enqueue a copy of bytes from src to dst; with cudaMemcpyDefault the direction is inferred from the
+     * pointers, host to host copies are issued on the device to host stream
+     */
+    CopyCompletion copy_async(void* dst, const void* src, std::size_t bytes, cudaMemcpyKind kind = cudaMemcpyDefault);
+
+    /**
+     * @brief Enqueue a copy of bytes from src on src_device to dst on dst_device on the device to device stream; the
+     * copy is direct over NVLink or PCIe where peer access between the devices is enabled, otherwise the driver stages
+     * it through host memory
+     */
+    CopyCompletion copy_peer_async(void* dst, int dst_device, const void* src, int src_device, std::size_t bytes);
+
+    /**
+     * @brief Enqueue a prefetch of managed memory to the device of the engine, or to the host with cudaCpuDeviceId
+     */
+    CopyCompletion prefetch_async(const void* ptr, std::size_t bytes, int device_id);
+    CopyCompletion prefetch_async(const void* ptr, std::size_t bytes);
+
+    /**
+     * @brief Enqueue the completions of all open batches
+     */
+    void flush();
+
+    int device_id() const;
+
+  private:
+    enum Direction
+    {
+        HostToDevice,
+        DeviceToHost,
+        DeviceToDevice,
+        DirectionCount,
+    };
+
+    struct Lane
+    {
+        cudaStream_t stream{nullptr};
+        std::mutex mutex;
+        std::shared_ptr<CopyCompletion::Batch> open;
+    };
+
+    Direction direction_of(cudaMemcpyKind kind, void* dst, const void* src) const;
+
+    // appends an operation enqueued by enqueue_fn on the stream of lane to its open batch
+    template <typename EnqueueFnT>
+    CopyCompletion enqueue(Lane& lane, EnqueueFnT&& enqueue_fn);
+
+    // lane mutex must be held
+    static void close(Lane& lane);
+
+    const int m_device_id;
+    const std::size_t m_max_batch_size;
+    std::array<Lane, DirectionCount> m_lanes;
+
+    friend CopyCompletion;
+};
+
+}  // namespace mrc
@@ -0,0 +1,101 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "mrc/utils/macros.hpp"
+
+#include <cuda_runtime.h>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <map>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace mrc {
+
+/**
+ * @brief Cache of CUDA graphs captured from the work a GPU node enqueues per message, keyed by device and input shape
+ *
+ * The first launch of a shape on a device captures the work enqueued by the capture function onto the stream into a
+ * graph; later launches of the shape replay the instantiated graph with a single cudaGraphLaunch in place of the
+ * launches of its kernels and copies. Each device holds up to capacity graphs, evicting the least recently launched.
+ *
+ * A replay repeats the captured work verbatim, including its kernel arguments and the addresses it reads and writes,
+ * so the work of a shape must use buffers whose addresses are stable for the shape, e.g. input and output buffers
+ * the node allocates once per shape and copies each message through. Replays of a graph are ordered behind its
+ * previous launches, also across streams. Capture functions must only enqueue work onto the stream; synchronizing
+ * calls are invalid while the stream is captured.
+ *
+ * The node owns the cache, as graphs of different nodes with equal shapes capture different work; the graphs of each
+ * device partition the node runs on are kept apart by the device current on the calling thread.
+ */
+class CudaGraphCache final
+{
+  public:
+    using shape_t      = std::vector<std::int64_t>;
+    using capture_fn_t = std::function<void(cudaStream_t stream)>;
+
+    CudaGraphCache(std::size_t capacity = 64);
+    ~CudaGraphCache();
+
+    DELETE_COPYABILITY(CudaGraphCache);
+    DELETE_MOVEABILITY(CudaGraphCache);
+
+    /**
+     * @brief Enqueue the work of shape onto stream on the current device, capturing it with capture_fn on the
+     * first launch of the shape and replaying the captured graph thereafter; exceptions of capture_fn are rethrown
+     * once the capture has ended.
+     */
+    void launch(const shape_t& shape, cudaStream_t stream, const capture_fn_t& capture_fn);
+
+    // drop the graphs of all devices; in-flight launches complete before their graphs are released
+    void clear();
+
+    // number of graphs cached across devices
+    std::size_t size() const;
+
+    // number of launches which captured a graph and which replayed one
+    std::size_t captures() const;
+    std::size_t replays() const;
+
+  private:
+    struct Device
+    {
+        // shapes from the most to the least recently launched
+        std::list<shape_t> lru;
+        std::map<shape_t, std::pair<cudaGraphExec_t, std::list<shape_t>::iterator>> graphs;
+    };
+
+    static cudaGraphExec_t capture(cudaStream_t stream, const capture_fn_t& capture_fn);
+
+    // device mutex must be held
+    void insert(Device& device, const shape_t& shape, cudaGraphExec_t exec);
+
+    const std::size_t m_capacity;
+    mutable std::mutex m_mutex;
+    std::map<int, Device> m_devices;
+    std::atomic<std::size_t> m_captures{0};
+    std::atomic<std::size_t> m_replays{0};
+};
+
+}  // namespace mrc
@@ -0,0 +1,401 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2021-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "mrc/data/reusable_pool.hpp"
+#include "mrc/types.hpp"  // for CondV & Mutex
+#include "mrc/utils/macros.hpp"
+
+#include <glog/logging.h>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+
+namespace mrc::data {
+
+namespace detail {
+
+// stable index of the calling thread, used to pick its magazine in a CachedReusablePool
+inline std::size_t thread_magazine_slot()
+{
+    static std::atomic<std::size_t> next_slot{0};
+    thread_local const std::size_t slot = next_slot.fetch_add(1, std::memory_order_relaxed);
+    return slot;
+}
+
+}  // namespace detail
+
+/**
+ * @brief ReusablePool variant with per-thread magazines in front of a lock-free global freelist
+ *
+ * Items returned on a thread are kept in a small magazine owned by that thread and handed out again to the next
+ * acquisition on the same thread, so the common acquire/release cycle touches a core-local cache line only. Full
+ * magazines spill into a bounded lock-free freelist shared by all threads. Threads are mapped onto a fixed number of
+ * magazines, so threads sharing a magazine remain correct but contend for it.
+ *
+ * Unlike ReusablePool, items are handed out in no particular order: the most recently returned item of a thread is the
+ * first one it gets back. Up to capacity items, which must be a power of 2, are managed by the pool. With a factory,
+ * an acquisition which finds no free item allocates a new item until capacity is reached. When no item is free and the
+ * pool can not grow, await_item steals from the magazines of other threads before blocking the calling fiber, and
+ * try_item returns an empty optional.
+ *
+ * @tparam T
+ */
+template <typename T>
+class CachedReusablePool final : public detail::ReusablePoolBase<T>
+{
+    static constexpr std::size_t MagazineSlots   = 16;
+    static constexpr std::size_t MaxMagazineSize = 8;
+
+  public:
+    using item_t      = std::unique_ptr<T>;
+    using on_return_t = std::function<void(T&)>;
+    using factory_t   = std::function<item_t()>;
+
+    ~CachedReusablePool() final
+    {
+        // items referenced by Reusable objects keep the pool alive, so all items are held by the pool at this point
+        while (auto* item = pop_global())
+        {
+            delete item;
+        }
+        for (std::size_t i = 0; i < MagazineSlots; i++)
+        {
+            auto& magazine = m_magazines[i];
+            for (std::size_t j = 0; j < magazine.count; j++)
+            {
+                delete magazine.items[j];
+            }
+        }
+    }
+
+    DELETE_COPYABILITY(CachedReusablePool);
+    DELETE_MOVEABILITY(CachedReusablePool);
+
+    static std::shared_ptr<CachedReusablePool<T>> create(std::size_t capacity,
+                                                         factory_t factory_fn   = nullptr,
+                                                         on_return_t on_return_fn = nullptr)
+    {
+        return std::shared_ptr<CachedReusablePool>(
+            new CachedReusablePool(capacity, std::move(factory_fn), std::move(on_return_fn)));
+    }
+
+    void add_item(item_t item)
+    {
+        CHECK(item);
+        if (!reserve())
+        {
+            throw std::length_error("pool capacity exceeded");
+        }
+        push_global(item.release());
+    }
+
+    template <typename... ArgsT>
+    void emplace(ArgsT&&... args)
+    {
+        add_item(std::make_unique<T>(std::forward<ArgsT>(args)...));
+    }
+
+    /**
+     * @brief Acquire an item, blocking the calling fiber until one is returned if none are free and the pool can not
+     * grow.
+     */
+    Reusable<T> await_item()
+    {
+        auto* item = acquire();
+        if (item == nullptr)
+        {
+            std::unique_lock<Mutex> lock(m_mutex);
+            m_waiters.fetch_add(1);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            while ((item = acquire()) == nullptr)
+            {
+                m_cv.wait(lock);
+            }
+            m_waiters.fetch_sub(1);
+        }
+        return this->make_reusable(item_t(item));
+    }
+
+    /**
+     * @brief Acquire an item without blocking; empty if no item is free and the pool can not grow.
+     */
+    std::optional<Reusable<T>> try_item()
+    {
+        auto* item = acquire();
+        if (item == nullptr)
+        {
+            return std::nullopt;
+        }
+        return this->make_reusable(item_t(item));
+    }
+
+    /**
+     * @brief Number of items managed by the pool
+     */
+    std::size_t size() const
+    {
+        return m_size.load();
+    }
+
+    std::size_t capacity() const
+    {
+        return m_capacity;
+    }
+
+  private:
+    struct Cell
+    {
+        std::atomic<std::size_t> sequence;
+        T* item;
+    };
+
+    struct alignas(64) Magazine
+    {
+        std::atomic<bool> locked{false};
+        std::size_t count{0};
+        std::array<T*, MaxMagazineSize> items{};
+
+        void lock()
+        {
+            while (locked.exchange(true, std::memory_order_acquire))
+            {
+                std::this_thread::yield();
+            }
+        }
+
+        void unlock()
+        {
+            locked.store(false, std::memory_order_release);
+        }
+    };
+
+    CachedReusablePool(std::size_t capacity, factory_t factory_fn, on_return_t on_return_fn) :
+      m_capacity(capacity),
+      m_mask(capacity - 1),
+      m_magazine_size(std::clamp<std::size_t>(capacity / 16, 1, MaxMagazineSize)),
+      m_factory_fn(std::move(factory_fn)),
+      m_on_return_fn(std::move(on_return_fn)),
+      m_cells(new Cell[capacity]),
+      m_magazines(new Magazine[MagazineSlots])
+    {
+        CHECK(capacity > 0 && (capacity & m_mask) == 0) << "capacity must be a power of 2";
+        for (std::size_t i = 0; i < capacity; i++)
+        {
+            m_cells[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    Magazine& local_magazine()
+    {
+        return m_magazines[detail::thread_magazine_slot() % MagazineSlots];
+    }
+
+    // local magazine, then the global freelist, then growth, then the magazines of the other threads
+    T* acquire()
+    {
+        auto& magazine = local_magazine();
+        magazine.lock();
+        if (magazine.count > 0)
+        {
+            auto* item = magazine.items[--magazine.count];
+            magazine.unlock();
+            return item;
+        }
+        magazine.unlock();
+
+        if (auto* item = pop_global())
+        {
+            return item;
+        }
+
+        if (m_factory_fn && reserve())
+        {
+            try
+            {
+                return m_factory_fn().release();
+            } catch (...)
+            {
+                m_size.fetch_sub(1);
+                throw;
+            }
+        }
+
+        return steal();
+    }
+
+    T* steal()
+    {
+        for (std::size_t i = 0; i < MagazineSlots; i++)
+        {
+            auto& magazine = m_magazines[i];
+            magazine.lock();
+            if (magazine.count > 0)
+            {
+                auto* item = magazine.items[--magazine.count];
+                magazine.unlock();
+                return item;
+            }
+            magazine.unlock();
+        }
+        return nullptr;
+    }
+
+    void return_item(std::unique_ptr<T> unique) final
+    {
+        if (m_on_return_fn)
+        {
+            m_on_return_fn(*unique);
+        }
+        auto* item = unique.release();
+
+        auto& magazine = local_magazine();
+        magazine.lock();
+        if (magazine.count < m_magazine_size)
+        {
+            magazine.items[magazine.count++] = item;
+
+            // waiters are counted before they scan the magazines, so an item cached while nobody was seen waiting is
+            // found by the scan of any later waiter
+            if (m_waiters.load(std::memory_order_relaxed) == 0)
+            {
+                magazine.unlock();
+                return;
+            }
+
+            // hand the cached items of this thread to the waiters
+            while (magazine.count > 0)
+            {
+                push_global(magazine.items[--magazine.count]);
+            }
+            magazine.unlock();
+        }
+        else
+        {
+            magazine.unlock();
+            push_global(item);
+
+            // pairs with the fence of await_item: either the waiter pops the item or it is seen waiting here
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if (m_waiters.load() == 0)
+            {
+                return;
+            }
+        }
+
+        std::lock_guard<Mutex> lock(m_mutex);
+        m_cv.notify_all();
+    }
+
+    // claims a slot for a new item; false if the pool is at capacity
+    bool reserve()
+    {
+        auto size = m_size.load();
+        while (size < m_capacity)
+        {
+            if (m_size.compare_exchange_weak(size, size + 1))
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // bounded mpmc queue; it can not fill up since it holds at most the capacity of the pool
+    void push_global(T* item)
+    {
+        auto pos = m_enqueue_pos.load(std::memory_order_relaxed);
+        while (true)
+        {
+            auto& cell = m_cells[pos & m_mask];
+            auto seq   = cell.sequence.load(std::memory_order_acquire);
+            auto diff  = static_cast<std::intptr_t>(seq) - static_cast<std::intptr_t>(pos);
+            if (diff == 0)
+            {
+                if (m_enqueue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                {
+                    cell.item = item;
+                    cell.sequence.store(pos + 1, std::memory_order_release);
+                    return;
+                }
+            }
+            else
+            {
+                CHECK_GT(diff, 0) << "freelist of a CachedReusablePool overflowed";
+                pos = m_enqueue_pos.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    T* pop_global()
+    {
+        auto pos = m_dequeue_pos.load(std::memory_order_relaxed);
+        while (true)
+        {
+            auto& cell = m_cells[pos & m_mask];
+            auto seq   = cell.sequence.load(std::memory_order_acquire);
+            auto diff  = static_cast<std::intptr_t>(seq) - static_cast<std::intptr_t>(pos + 1);
+            if (diff == 0)
+            {
+                if (m_dequeue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                {
+                    auto* item = cell.item;
+                    cell.sequence.store(pos + m_mask + 1, std::memory_order_release);
+                    return item;
+                }
+            }
+            else if (diff < 0)
+            {
+                return nullptr;
+            }
+            else
+            {
+                pos = m_dequeue_pos.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    const std::size_t m_capacity;
+    const std::size_t m_mask;
+    const std::size_t m_magazine_size;
+    factory_t m_factory_fn;
+    on_return_t m_on_return_fn;
+    std::atomic<std::size_t> m_size{0};
+
+    std::unique_ptr<Cell[]> m_cells;
+    alignas(64) std::atomic<std::size_t> m_enqueue_pos{0};
+    alignas(64) std::atomic<std::size_t> m_dequeue_pos{0};
+    std::unique_ptr<Magazine[]> m_magazines;
+
+    // parking of fibers waiting in await_item
+    Mutex m_mutex;
+    CondV m_cv;
+    std::atomic<std::size_t> m_waiters{0};
+};
+
+}  // namespace mrc::data
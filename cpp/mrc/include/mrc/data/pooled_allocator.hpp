@@ -0,0 +1,272 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2021-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "mrc/utils/macros.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <utility>
+#include <vector>
+
+namespace mrc::data {
+
+namespace detail {
+
+/**
+ * @brief Thread-cached slab heap handing out blocks of BlockSize bytes aligned to BlockAlign
+ *
+ * Each thread owns a heap carving blocks from 64KiB slabs; the owning heap of a block is found by masking its address.
+ * Blocks freed by the owning thread go onto its local freelist without any atomic operation; blocks freed on any other
+ * thread are pushed onto the lock-free remote-free list of the owner, which the owner reclaims in one exchange once
+ * its local freelist runs dry. Freed blocks are recycled by the heap and slabs are never returned to the system.
+ *
+ * The heap of an exiting thread is abandoned, still receiving remote frees, and adopted by the next thread which
+ * allocates blocks of the same size.
+ */
+template <std::size_t BlockSize, std::size_t BlockAlign>
+class SlabHeap final
+{
+    struct FreeBlock
+    {
+        FreeBlock* next;
+    };
+
+    struct SlabHeader
+    {
+        SlabHeap* owner;
+    };
+
+  public:
+    static constexpr std::size_t SlabSize    = 64 * 1024;
+    static constexpr std::size_t Align       = std::max(BlockAlign, alignof(FreeBlock));
+    static constexpr std::size_t BlockStride = (std::max(BlockSize, sizeof(FreeBlock)) + Align - 1) / Align * Align;
+    static constexpr std::size_t FirstBlock  = (sizeof(SlabHeader) + Align - 1) / Align * Align;
+    static constexpr std::size_t SlabBlocks  = (SlabSize - FirstBlock) / BlockStride;
+
+    static_assert(SlabBlocks >= 8, "blocks are too large to be served from slabs");
+    static_assert(SlabSize % Align == 0, "blocks can not be aligned within a slab");
+
+    DELETE_COPYABILITY(SlabHeap);
+    DELETE_MOVEABILITY(SlabHeap);
+
+    static void* allocate()
+    {
+        return local().pop();
+    }
+
+    static void deallocate(void* ptr)
+    {
+        auto* block = static_cast<FreeBlock*>(ptr);
+        auto* owner = slab_of(ptr)->owner;
+        if (owner == t_heap)
+        {
+            block->next    = owner->m_local;
+            owner->m_local = block;
+            return;
+        }
+        owner->push_remote(block);
+    }
+
+  private:
+    SlabHeap() = default;
+
+    // binds a heap to the calling thread until it exits
+    struct ThreadHeap
+    {
+        ThreadHeap() : heap(adopt())
+        {
+            t_heap = heap;
+        }
+
+        ~ThreadHeap()
+        {
+            t_heap = nullptr;
+            abandon(heap);
+        }
+
+        SlabHeap* heap;
+    };
+
+    // abandoned heaps keep the slabs of exited threads allocated for their outstanding blocks
+    struct Registry
+    {
+        std::mutex mutex;
+        std::vector<SlabHeap*> abandoned;
+    };
+
+    static Registry& registry()
+    {
+        // never destroyed, blocks may be released by static destructors of other translation units
+        static auto* s_registry = new Registry();
+        return *s_registry;
+    }
+
+    static SlabHeap* adopt()
+    {
+        auto& r = registry();
+        std::lock_guard<std::mutex> lock(r.mutex);
+        if (r.abandoned.empty())
+        {
+            return new SlabHeap();
+        }
+        auto* heap = r.abandoned.back();
+        r.abandoned.pop_back();
+        return heap;
+    }
+
+    static void abandon(SlabHeap* heap)
+    {
+        auto& r = registry();
+        std::lock_guard<std::mutex> lock(r.mutex);
+        r.abandoned.push_back(heap);
+    }
+
+    static SlabHeap& local()
+    {
+        thread_local ThreadHeap t_thread_heap;
+        return *t_thread_heap.heap;
+    }
+
+    static SlabHeader* slab_of(void* ptr)
+    {
+        return reinterpret_cast<SlabHeader*>(reinterpret_cast<std::uintptr_t>(ptr) & ~(SlabSize - 1));
+    }
+
+    void* pop()
+    {
+        if (m_local == nullptr)
+        {
+            m_local = m_remote.exchange(nullptr, std::memory_order_acquire);
+            if (m_local == nullptr)
+            {
+                carve_slab();
+            }
+        }
+        auto* block = m_local;
+        m_local     = block->next;
+        return block;
+    }
+
+    void push_remote(FreeBlock* block)
+    {
+        // multiple producers, and the single consumer takes the whole list at once, so the push is free of ABA
+        auto* head = m_remote.load(std::memory_order_relaxed);
+        do
+        {
+            block->next = head;
+        } while (!m_remote.compare_exchange_weak(head, block, std::memory_order_release, std::memory_order_relaxed));
+    }
+
+    void carve_slab()
+    {
+        auto* slab = static_cast<std::byte*>(std::aligned_alloc(SlabSize, SlabSize));
+        if (slab == nullptr)
+        {
+            throw std::bad_alloc();
+        }
+        reinterpret_cast<SlabHeader*>(slab)->owner = this;
+
+        for (std::size_t i = SlabBlocks; i > 0; i--)
+        {
+            auto* block = reinterpret_cast<FreeBlock*>(slab + FirstBlock + (i - 1) * BlockStride);
+            block->next = m_local;
+            m_local     = block;
+        }
+    }
+
+    static inline thread_local SlabHeap* t_heap{nullptr};
+
+    FreeBlock* m_local{nullptr};
+    alignas(64) std::atomic<FreeBlock*> m_remote{nullptr};
+};
+
+template <typename T>
+inline constexpr bool is_slab_allocatable_v = (sizeof(T) <= 1024 && alignof(T) <= 64);
+
+}  // namespace detail
+
+/**
+ * @brief Stateless allocator serving single objects from per-size slabs with thread-local recycling
+ *
+ * Intended for message objects created on one thread and destroyed on another as they pass through the edges of a
+ * pipeline: no allocation or deallocation takes a lock, and objects freed on a remote thread are returned to the slab
+ * of the allocating thread without contending with it. Arrays and objects larger than 1KiB are forwarded to
+ * std::allocator.
+ */
+template <typename T>
+class PooledAllocator
+{
+  public:
+    using value_type = T;
+
+    PooledAllocator() noexcept = default;
+
+    template <typename U>
+    PooledAllocator(const PooledAllocator<U>& /*unused*/) noexcept
+    {}
+
+    T* allocate(std::size_t n)
+    {
+        if constexpr (detail::is_slab_allocatable_v<T>)
+        {
+            if (n == 1)
+            {
+                return static_cast<T*>(detail::SlabHeap<sizeof(T), alignof(T)>::allocate());
+            }
+        }
+        return std::allocator<T>{}.allocate(n);
+    }
+
+    void deallocate(T* ptr, std::size_t n) noexcept
+    {
+        if constexpr (detail::is_slab_allocatable_v<T>)
+        {
+            if (n == 1)
+            {
+                detail::SlabHeap<sizeof(T), alignof(T)>::deallocate(ptr);
+                return;
+            }
+        }
+        std::allocator<T>{}.deallocate(ptr, n);
+    }
+
+    template <typename U>
+    bool operator==(const PooledAllocator<U>& /*unused*/) const noexcept
+    {
+        return true;
+    }
+};
+
+/**
+ * @brief Drop-in replacement of std::make_shared which allocates the object and its control block with a
+ * PooledAllocator
+ */
+template <typename T, typename... ArgsT>
+std::shared_ptr<T> make_pooled_shared(ArgsT&&... args)
+{
+    return std::allocate_shared<T>(PooledAllocator<T>{}, std::forward<ArgsT>(args)...);
+}
+
+}  // namespace mrc::data
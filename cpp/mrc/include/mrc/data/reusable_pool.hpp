@@ -46,6 +46,33 @@ class Reusable;
 template <typename T>
 class SharedReusable;
 
+namespace detail {
+
+/**
+ * @brief Common base of the pools handing out Reusable<T> objects; Reusable and SharedReusable objects return their
+ * items through it regardless of the pool implementation.
+ */
+template <typename T>
+class ReusablePoolBase : public std::enable_shared_from_this<ReusablePoolBase<T>>
+{
+  public:
+    virtual ~ReusablePoolBase() = default;
+
+  protected:
+    Reusable<T> make_reusable(std::unique_ptr<T> item)
+    {
+        return Reusable<T>(std::move(item), this->shared_from_this());
+    }
+
+  private:
+    virtual void return_item(std::unique_ptr<T> item) = 0;
+
+    friend Reusable<T>;
+    friend SharedReusable<T>;
+};
+
+}  // namespace detail
+
 /**
  * @brief A resource pool which holds upto capacity of unique_ptr<T> which are provided to the requesting callers as
  * Reusable<T> instead of unique_ptr<T>. Reusable objects are returned to the pool when destroyed.
@@ -62,13 +89,13 @@ class SharedReusable;
  * @tparam T
  */
 template <typename T>
-class ReusablePool final : public std::enable_shared_from_this<ReusablePool<T>>
+class ReusablePool final : public detail::ReusablePoolBase<T>
 {
   public:
     using item_t      = std::unique_ptr<T>;
     using on_return_t = std::function<void(T&)>;
 
-    ~ReusablePool()
+    ~ReusablePool() final
     {
         // this will prevent items from being returned to the pool
         m_channel.close();
@@ -104,7 +131,7 @@ class ReusablePool final : public std::enable_shared_from_this<ReusablePool<T>>
     {
         item_t item;
         m_channel.pop(item);
-        return Reusable<T>(std::move(item), this->shared_from_this());
+        return this->make_reusable(std::move(item));
     }
 
     /**
@@ -122,7 +149,7 @@ class ReusablePool final : public std::enable_shared_from_this<ReusablePool<T>>
       m_channel(capacity)
     {}
 
-    void return_item(std::unique_ptr<T> item)
+    void return_item(std::unique_ptr<T> item) final
     {
         if (m_on_return_fn)
         {
@@ -136,15 +163,12 @@ class ReusablePool final : public std::enable_shared_from_this<ReusablePool<T>>
     const std::size_t m_capacity;
     std::function<void(T&)> m_on_return_fn{nullptr};
     boost::fibers::buffered_channel<item_t> m_channel;
-
-    friend Reusable<T>;
-    friend SharedReusable<T>;
 };
 
 template <typename T>
 class Reusable final
 {
-    using pool_t = ReusablePool<T>;
+    using pool_t = detail::ReusablePoolBase<T>;
 
     Reusable(std::unique_ptr<T> data, std::shared_ptr<pool_t> pool) : m_data(std::move(data)), m_pool(std::move(pool))
     {}
@@ -193,7 +217,7 @@ class Reusable final
 template <typename T>
 class SharedReusable final
 {
-    using pool_t = ReusablePool<T>;
+    using pool_t = detail::ReusablePoolBase<T>;
 
     SharedReusable(std::unique_ptr<T> data, std::shared_ptr<pool_t> pool) :
       m_data(data.release(),
@@ -0,0 +1,398 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <glog/logging.h>
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace mrc::data {
+
+enum class CacheAdmission
+{
+    // new entries are always admitted, evicting the least recently used entries
+    lru,
+    // new entries are only admitted if seen more often than the least recently used entry they would evict
+    tiny_lfu,
+};
+
+struct CacheOptions
+{
+    // shards of the cache, each with its own lock and an equal share of the bounds
+    std::size_t shard_count{16};
+    // entries held; 0 for no bound
+    std::size_t max_entries{64UL * 1024};
+    // bytes held, as charged by the cost function of the cache; 0 for no bound
+    std::size_t max_bytes{0};
+    // time after its insertion at which an entry expires; 0 for never
+    std::chrono::nanoseconds ttl{0};
+    CacheAdmission admission{CacheAdmission::lru};
+};
+
+struct CacheStatistics
+{
+    std::uint64_t hits{0};
+    std::uint64_t misses{0};
+    std::uint64_t insertions{0};
+    // new entries refused by the admission filter or larger than a shard
+    std::uint64_t rejections{0};
+    std::uint64_t evictions{0};
+    std::uint64_t expirations{0};
+    std::size_t entries{0};
+    std::size_t bytes{0};
+
+    double hit_rate() const
+    {
+        const auto lookups = hits + misses;
+        return (lookups == 0 ? 0.0 : static_cast<double>(hits) / static_cast<double>(lookups));
+    }
+};
+
+namespace detail {
+
+/**
+ * @brief Count-min sketch estimating how often keys were seen recently, the frequency filter of TinyLFU
+ *
+ * Counters saturate at 15 and are all halved once 10 increments per counter of a row were recorded, so the estimates
+ * follow shifts in popularity.
+ */
+class FrequencySketch
+{
+    static constexpr std::size_t Depth = 4;
+
+    // keeps the counters of small caches from being saturated by collisions
+    static constexpr std::size_t MinWidth = 1024;
+
+    static constexpr std::array<std::uint64_t, Depth> Seeds{
+        0xc3a5c85c97cb3127ULL, 0xb492b66fbe98f273ULL, 0x9ae16a3b2f90404fULL, 0xcbf29ce484222325ULL};
+
+  public:
+    explicit FrequencySketch(std::size_t capacity) :
+      m_width(std::bit_ceil(std::max<std::size_t>(capacity, MinWidth))),
+      m_counters(Depth * m_width),
+      m_sample_size(10 * m_width)
+    {}
+
+    void increment(std::uint64_t hash)
+    {
+        for (std::size_t row = 0; row < Depth; ++row)
+        {
+            auto& counter = m_counters[index(hash, row)];
+            counter       = std::min<std::uint8_t>(counter + 1, 15);
+        }
+        if (++m_additions >= m_sample_size)
+        {
+            for (auto& counter : m_counters)
+            {
+                counter >>= 1;
+            }
+            m_additions /= 2;
+        }
+    }
+
+    std::uint8_t estimate(std::uint64_t hash) const
+    {
+        std::uint8_t estimate = 15;
+        for (std::size_t row = 0; row < Depth; ++row)
+        {
+            estimate = std::min(estimate, m_counters[index(hash, row)]);
+        }
+        return estimate;
+    }
+
+  private:
+    std::size_t index(std::uint64_t hash, std::size_t row) const
+    {
+        auto mixed = (hash + Seeds[row]) * 0x9e3779b97f4a7c15ULL;
+        return row * m_width + ((mixed ^ (mixed >> 32)) & (m_width - 1));
+    }
+
+    const std::size_t m_width;
+    std::vector<std::uint8_t> m_counters;
+    const std::size_t m_sample_size;
+    std::size_t m_additions{0};
+};
+
+}  // namespace detail
+
+/**
+ * @brief Bounded, thread safe key/value cache split into independently locked shards
+ *
+ * Each shard holds an equal share of max_entries and max_bytes and evicts its least recently used entries to stay
+ * within them; with CacheAdmission::tiny_lfu a new entry is only admitted if a frequency sketch of the shard has seen
+ * its key more often than that of the entry it would evict, which keeps one-off keys from flushing popular ones.
+ * Entries expire ttl after their insertion and are dropped when next looked up or evicted.
+ *
+ * Lookups copy the value out, so large values are best cached as a std::shared_ptr<const T>. The cost of an entry
+ * charged against max_bytes is given by the cost function, sizeof(KeyT) + sizeof(ValueT) by default. Critical
+ * sections are short and never block, so the cache may be shared by threads and fibers alike.
+ */
+template <typename KeyT, typename ValueT, typename HashT = std::hash<KeyT>, typename KeyEqualT = std::equal_to<KeyT>>
+class ShardedCache
+{
+  public:
+    using cost_fn_t = std::function<std::size_t(const KeyT&, const ValueT&)>;
+    using clock_t   = std::chrono::steady_clock;
+
+    ShardedCache(CacheOptions options = {}, cost_fn_t cost_fn = nullptr) :
+      m_options(options),
+      m_cost_fn(std::move(cost_fn)),
+      m_shard_entries(per_shard(options.max_entries, options.shard_count)),
+      m_shard_bytes(per_shard(options.max_bytes, options.shard_count))
+    {
+        CHECK_GT(m_options.shard_count, 0) << "ShardedCache requires at least one shard";
+        CHECK(m_options.admission == CacheAdmission::lru || m_options.max_entries > 0 || m_options.max_bytes > 0)
+            << "CacheAdmission::tiny_lfu requires a bounded cache";
+
+        m_shards.reserve(m_options.shard_count);
+        for (std::size_t i = 0; i < m_options.shard_count; ++i)
+        {
+            auto& shard = m_shards.emplace_back(std::make_unique<Shard>());
+            if (m_options.admission == CacheAdmission::tiny_lfu)
+            {
+                shard->sketch.emplace(m_shard_entries);
+            }
+        }
+    }
+
+    const CacheOptions& options() const
+    {
+        return m_options;
+    }
+
+    /**
+     * @brief Copy of the value cached for key; empty if it is not cached or has expired
+     */
+    std::optional<ValueT> get(const KeyT& key)
+    {
+        const auto hash = m_hash(key);
+        auto& shard     = shard_for(hash);
+
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        if (shard.sketch)
+        {
+            shard.sketch->increment(hash);
+        }
+
+        auto it = shard.index.find(key);
+        if (it == shard.index.end())
+        {
+            ++shard.stats.misses;
+            return std::nullopt;
+        }
+        if (expired(*it->second, clock_t::now()))
+        {
+            ++shard.stats.expirations;
+            ++shard.stats.misses;
+            remove(shard, it->second);
+            return std::nullopt;
+        }
+
+        ++shard.stats.hits;
+        shard.lru.splice(shard.lru.begin(), shard.lru, it->second);
+        return it->second->value;
+    }
+
+    /**
+     * @brief Caches value for key, replacing a cached value; returns false if a new entry was not admitted
+     */
+    bool put(KeyT key, ValueT value)
+    {
+        const auto hash = m_hash(key);
+        const auto cost = (m_cost_fn ? m_cost_fn(key, value) : sizeof(KeyT) + sizeof(ValueT));
+        const auto now  = clock_t::now();
+        auto& shard     = shard_for(hash);
+
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        if (shard.sketch)
+        {
+            shard.sketch->increment(hash);
+        }
+
+        auto it = shard.index.find(key);
+        if (it != shard.index.end())
+        {
+            auto& entry = *it->second;
+            shard.bytes      = shard.bytes - entry.cost + cost;
+            entry.value      = std::move(value);
+            entry.cost       = cost;
+            entry.expires_at = expires_at(now);
+            shard.lru.splice(shard.lru.begin(), shard.lru, it->second);
+            evict(shard, 0, 0, now);
+            return true;
+        }
+
+        if (m_shard_bytes > 0 && cost > m_shard_bytes)
+        {
+            ++shard.stats.rejections;
+            return false;
+        }
+
+        // the admission filter weighs the newcomer against the entry it would evict first
+        if (shard.sketch && !shard.lru.empty() && over_bounds(shard, cost, 1) &&
+            !expired(shard.lru.back(), now) &&
+            shard.sketch->estimate(hash) <= shard.sketch->estimate(m_hash(shard.lru.back().key)))
+        {
+            ++shard.stats.rejections;
+            return false;
+        }
+
+        evict(shard, cost, 1, now);
+        shard.lru.push_front(Entry{key, std::move(value), cost, expires_at(now)});
+        shard.index.emplace(std::move(key), shard.lru.begin());
+        shard.bytes += cost;
+        ++shard.stats.insertions;
+        return true;
+    }
+
+    bool erase(const KeyT& key)
+    {
+        auto& shard = shard_for(m_hash(key));
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        auto it = shard.index.find(key);
+        if (it == shard.index.end())
+        {
+            return false;
+        }
+        remove(shard, it->second);
+        return true;
+    }
+
+    void clear()
+    {
+        for (auto& shard : m_shards)
+        {
+            std::lock_guard<std::mutex> lock(shard->mutex);
+            shard->index.clear();
+            shard->lru.clear();
+            shard->bytes = 0;
+        }
+    }
+
+    // entries held, including expired entries not yet dropped
+    std::size_t size() const
+    {
+        return statistics().entries;
+    }
+
+    CacheStatistics statistics() const
+    {
+        CacheStatistics stats;
+        for (const auto& shard : m_shards)
+        {
+            std::lock_guard<std::mutex> lock(shard->mutex);
+            stats.hits += shard->stats.hits;
+            stats.misses += shard->stats.misses;
+            stats.insertions += shard->stats.insertions;
+            stats.rejections += shard->stats.rejections;
+            stats.evictions += shard->stats.evictions;
+            stats.expirations += shard->stats.expirations;
+            stats.entries += shard->lru.size();
+            stats.bytes += shard->bytes;
+        }
+        return stats;
+    }
+
+  private:
+    struct Entry
+    {
+        KeyT key;
+        ValueT value;
+        std::size_t cost;
+        clock_t::time_point expires_at;
+    };
+
+    using lru_t = std::list<Entry>;
+
+    struct Shard
+    {
+        mutable std::mutex mutex;
+        lru_t lru;
+        std::unordered_map<KeyT, typename lru_t::iterator, HashT, KeyEqualT> index;
+        std::size_t bytes{0};
+        std::optional<detail::FrequencySketch> sketch;
+        CacheStatistics stats;
+    };
+
+    static std::size_t per_shard(std::size_t bound, std::size_t shard_count)
+    {
+        return (bound == 0 ? 0 : std::max<std::size_t>(1, (bound + shard_count - 1) / shard_count));
+    }
+
+    // the high bits pick the shard, leaving the low bits to the buckets of its index
+    Shard& shard_for(std::uint64_t hash)
+    {
+        return *m_shards[((hash * 0x9e3779b97f4a7c15ULL) >> 32) % m_shards.size()];
+    }
+
+    clock_t::time_point expires_at(clock_t::time_point now) const
+    {
+        return (m_options.ttl.count() > 0 ? now + m_options.ttl : clock_t::time_point::max());
+    }
+
+    static bool expired(const Entry& entry, clock_t::time_point now)
+    {
+        return entry.expires_at <= now;
+    }
+
+    bool over_bounds(const Shard& shard, std::size_t extra_bytes, std::size_t extra_entries) const
+    {
+        return (m_shard_entries > 0 && shard.lru.size() + extra_entries > m_shard_entries) ||
+               (m_shard_bytes > 0 && shard.bytes + extra_bytes > m_shard_bytes);
+    }
+
+    // evicts least recently used entries until extra_bytes and extra_entries fit; the front entry is kept
+    void evict(Shard& shard, std::size_t extra_bytes, std::size_t extra_entries, clock_t::time_point now)
+    {
+        while (shard.lru.size() > (extra_entries == 0 ? 1 : 0) && over_bounds(shard, extra_bytes, extra_entries))
+        {
+            auto victim = std::prev(shard.lru.end());
+            ++(expired(*victim, now) ? shard.stats.expirations : shard.stats.evictions);
+            remove(shard, victim);
+        }
+    }
+
+    static void remove(Shard& shard, typename lru_t::iterator entry)
+    {
+        shard.bytes -= entry->cost;
+        shard.index.erase(entry->key);
+        shard.lru.erase(entry);
+    }
+
+    const CacheOptions m_options;
+    const cost_fn_t m_cost_fn;
+    const std::size_t m_shard_entries;
+    const std::size_t m_shard_bytes;
+    const HashT m_hash{};
+    std::vector<std::unique_ptr<Shard>> m_shards;
+};
+
+}  // namespace mrc::data
@@ -17,6 +17,9 @@
 
 #pragma once
 
+#include "mrc/types.hpp"
+
+#include <cstddef>
 #include <memory>
 
 namespace mrc {
@@ -52,8 +55,25 @@ class IExecutor
     IExecutor(std::unique_ptr<system::IResources>);
     virtual ~IExecutor() = 0;
 
-    void register_pipeline(std::unique_ptr<internal::pipeline::IPipeline> pipeline);
+    /**
+     * @brief Register a pipeline to be run on the resources of the executor
+     *
+     * Any number of pipelines may be registered; they share the system and partition resources of the executor.
+     * Pipelines registered before start() are started with the executor, those registered afterwards immediately.
+     * @return Identifies the pipeline to stop_pipeline and join_pipeline.
+     */
+    PipelineID register_pipeline(std::unique_ptr<internal::pipeline::IPipeline> pipeline);
+
+    // stop a running pipeline without affecting the other pipelines of the executor
+    void stop_pipeline(PipelineID id);
+
+    // await the completion of a running pipeline and release it
+    void join_pipeline(PipelineID id);
+
+    // number of pipelines registered and not yet joined
+    std::size_t pipeline_count() const;
 
+    // start, stop and join all pipelines of the executor
     void start();
     void stop();
     void join();
@@ -18,6 +18,12 @@
 #pragma once
 
 #include <memory>
+#include <string>
+
+namespace mrc::runnable {
+struct CostHints;
+struct LaunchOptions;
+}  // namespace mrc::runnable
 
 namespace mrc::internal::segment {
 class IDefinition;
@@ -36,6 +42,9 @@ class IPipeline
 
   protected:
     void register_segment(std::shared_ptr<const segment::IDefinition> segment);
+    void set_manifold_launch_options(const std::string& port_name, const runnable::LaunchOptions& launch_options);
+    void set_port_rate(const std::string& port_name, double elements_per_second);
+    void set_port_cost_hints(const std::string& port_name, const runnable::CostHints& cost_hints);
 
   private:
     void add_segment(std::shared_ptr<const segment::Definition> segment);
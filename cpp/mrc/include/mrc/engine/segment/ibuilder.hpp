@@ -19,8 +19,10 @@
 
 #include "mrc/utils/macros.hpp"
 
+#include <cstddef>
 #include <cstdint>
 #include <functional>
+#include <map>
 #include <memory>
 #include <string>
 
@@ -58,6 +60,24 @@ class IBuilder final
     std::shared_ptr<::mrc::segment::IngressPortBase> get_ingress_base(const std::string& name);
     std::shared_ptr<::mrc::segment::EgressPortBase> get_egress_base(const std::string& name);
     std::function<void(std::int64_t)> make_throughput_counter(const std::string& name);
+    std::function<void(std::int64_t)> make_counter(const std::string& name,
+                                                   std::map<std::string, std::string> labels);
+
+    // deferred fusion of adjacent nodes; see mrc::segment::Builder::enable_fusion
+    void enable_fusion(bool enabled);
+    bool fusion_enabled() const;
+    void add_fusion_candidate(std::shared_ptr<::mrc::segment::ObjectProperties> source,
+                              std::shared_ptr<::mrc::segment::ObjectProperties> sink,
+                              std::function<bool()> fuse_fn,
+                              std::function<void()> edge_fn);
+
+    // deferred selection of ring channels; see mrc::segment::Builder::enable_ring_channels
+    void enable_ring_channels(bool enabled);
+    bool ring_channels_enabled() const;
+    void add_ring_channel_edge(std::shared_ptr<::mrc::segment::ObjectProperties> source,
+                               std::shared_ptr<::mrc::segment::ObjectProperties> sink,
+                               std::function<void(std::size_t, std::size_t)> select_fn,
+                               std::function<void()> edge_fn);
 
   private:
     Builder* m_impl;
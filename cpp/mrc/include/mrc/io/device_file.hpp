@@ -0,0 +1,136 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "mrc/coroutines/ring_buffer.hpp"
+#include "mrc/coroutines/task.hpp"
+#include "mrc/memory/buffer.hpp"
+#include "mrc/memory/buffer_view.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace mrc::coroutines {
+class ThreadPool;
+}  // namespace mrc::coroutines
+
+namespace mrc::memory {
+struct memory_resource;
+}  // namespace mrc::memory
+
+namespace mrc::io {
+
+struct DeviceFileReaderOptions
+{
+    // bytes of each read and of the device buffer of each chunk; rounded up to the direct i/o alignment
+    std::size_t chunk_size{16UL << 20};
+    // number of reads in flight while the chunks of the previous reads are emitted
+    std::size_t read_ahead{4};
+    // cuda device of the memory resource the chunks are allocated from
+    int device_id{0};
+};
+
+/**
+ * @brief Bytes of a file read into a device memory buffer
+ *
+ * Chunks split the file at multiples of DeviceFileReaderOptions::chunk_size; record boundaries are left to the device
+ * parsers consuming them. A chunk is complete when emitted, so kernels may read it on any stream of its device.
+ */
+class DeviceChunk
+{
+  public:
+    DeviceChunk() = default;
+    DeviceChunk(std::shared_ptr<const memory::buffer> storage, std::size_t bytes, std::uint64_t offset);
+
+    const void* data() const;
+
+    // bytes read into the chunk; the buffer holds chunk_size bytes
+    std::size_t bytes() const;
+
+    // offset of the first byte of the chunk in the file
+    std::uint64_t offset() const;
+
+    memory::const_buffer_view view() const;
+
+  private:
+    std::shared_ptr<const memory::buffer> m_storage;
+    std::size_t m_bytes{0};
+    std::uint64_t m_offset{0};
+};
+
+/**
+ * @brief Reads a file into DeviceChunks allocated from a device memory resource
+ *
+ * When libmrc is built with MRC_BUILD_GDS and the cuFile driver opens, the file is read with GPUDirect Storage, i.e.
+ * DMA from the storage device into device memory without a bounce through host memory or the page cache. Otherwise
+ * each read lands in a pinned host staging buffer and is copied to the device on a stream of its own.
+ *
+ * cuFile reads block their thread, so the reads are issued on a thread pool of read_ahead threads owned by the
+ * reader; read_ahead reads are in flight while the chunks of the previous reads are written to the output.
+ *
+ * The file is opened on construction; failures throw std::system_error.
+ */
+class DeviceFileReader
+{
+  public:
+    DeviceFileReader(std::string path,
+                     DeviceFileReaderOptions options,
+                     std::shared_ptr<memory::memory_resource> device_memory_resource);
+    ~DeviceFileReader();
+
+    DeviceFileReader(const DeviceFileReader&)            = delete;
+    DeviceFileReader& operator=(const DeviceFileReader&) = delete;
+
+    /**
+     * @brief reads the file from its start and writes its chunks to output
+     *
+     * returns when the file has been read or output is closed; read errors are thrown
+     */
+    coroutines::Task<void> read(coroutines::RingBuffer<DeviceChunk>& output);
+
+    const std::string& path() const;
+
+    const DeviceFileReaderOptions& options() const;
+
+    // true if the file is read with GPUDirect Storage, false if through pinned host memory
+    bool gpu_direct() const;
+
+    // size of the file when it was opened
+    std::uint64_t file_size() const;
+
+  private:
+    struct Block;
+    class Backend;
+    class GdsBackend;
+    class BounceBackend;
+
+    coroutines::Task<std::vector<Block>> read_blocks(std::uint64_t offset);
+    coroutines::Task<bool> emit_blocks(std::vector<Block> blocks, coroutines::RingBuffer<DeviceChunk>& output);
+
+    const std::string m_path;
+    DeviceFileReaderOptions m_options;
+    std::shared_ptr<memory::memory_resource> m_memory_resource;
+    std::unique_ptr<coroutines::ThreadPool> m_thread_pool;
+    std::unique_ptr<Backend> m_backend;
+    std::uint64_t m_file_size{0};
+};
+
+}  // namespace mrc::io
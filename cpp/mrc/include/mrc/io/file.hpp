@@ -0,0 +1,242 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "mrc/coroutines/ring_buffer.hpp"
+#include "mrc/coroutines/task.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace mrc::coroutines {
+class IoScheduler;
+}  // namespace mrc::coroutines
+
+namespace mrc::io {
+
+enum class RecordFormat
+{
+    // records terminated by '\n'; the final record of a file may lack the terminator
+    lines,
+    // records of FileReaderOptions::record_size bytes
+    fixed,
+    // no records; chunks split the file at arbitrary offsets
+    blob,
+};
+
+struct FileReaderOptions
+{
+    RecordFormat format{RecordFormat::lines};
+    // size of the records of RecordFormat::fixed
+    std::size_t record_size{0};
+    // bytes of each read; rounded up to the direct i/o alignment when direct_io is set
+    std::size_t chunk_size{4UL << 20};
+    // number of reads in flight while the previous reads are emitted
+    std::size_t read_ahead{4};
+    // read with O_DIRECT, bypassing the page cache; falls back to buffered i/o if unsupported by the filesystem
+    bool direct_io{false};
+};
+
+struct FileWriterOptions
+{
+    // bytes staged before a write is issued; rounded up to the direct i/o alignment when direct_io is set
+    std::size_t chunk_size{4UL << 20};
+    // append to an existing file rather than truncating it
+    bool append{false};
+    // write with O_DIRECT, bypassing the page cache; falls back to buffered i/o if unsupported by the filesystem
+    bool direct_io{false};
+};
+
+/**
+ * @brief Contiguous bytes of a file holding whole records
+ *
+ * Chunks are views into the buffers the file was read into, which are recycled once the last chunk referencing them
+ * is destroyed; parsers consume the bytes in place. Only records straddling two reads are copied, into a chunk of
+ * their own.
+ */
+class FileChunk
+{
+  public:
+    FileChunk() = default;
+    FileChunk(std::shared_ptr<const std::byte> storage, std::span<const std::byte> bytes, std::uint64_t offset);
+
+    std::span<const std::byte> bytes() const;
+
+    std::string_view view() const;
+
+    // offset of the first byte of the chunk in the file
+    std::uint64_t offset() const;
+
+    std::size_t size() const;
+
+    bool empty() const;
+
+    // io::for_each_line over the bytes of the chunk
+    template <typename CallableT>
+    void for_each_line(CallableT&& on_line) const;
+
+  private:
+    std::shared_ptr<const std::byte> m_storage;
+    std::span<const std::byte> m_bytes;
+    std::uint64_t m_offset{0};
+};
+
+/**
+ * @brief invokes on_line with a std::string_view of each '\n' terminated line of bytes without its terminator
+ *
+ * a trailing line without terminator is passed on as well
+ */
+template <typename CallableT>
+void for_each_line(std::string_view bytes, CallableT&& on_line)
+{
+    while (!bytes.empty())
+    {
+        auto end = bytes.find('\n');
+        on_line(bytes.substr(0, end));
+        bytes.remove_prefix(end == std::string_view::npos ? bytes.size() : end + 1);
+    }
+}
+
+template <typename CallableT>
+void FileChunk::for_each_line(CallableT&& on_line) const
+{
+    io::for_each_line(view(), std::forward<CallableT>(on_line));
+}
+
+std::span<const std::byte> as_bytes(const FileChunk& chunk);
+std::span<const std::byte> as_bytes(const std::string& data);
+std::span<const std::byte> as_bytes(std::string_view data);
+
+/**
+ * @brief Reads a file into FileChunks with reads issued on a coroutines::IoScheduler
+ *
+ * read_ahead reads of chunk_size bytes are in flight while the chunks of the previous reads are written to the output,
+ * so with the io_uring backend neither the reads nor the emitting coroutine block a thread. Chunks are emitted in file
+ * order and each holds whole records of the format of the reader.
+ *
+ * The file is opened on construction; failures throw std::system_error.
+ */
+class FileReader
+{
+  public:
+    FileReader(std::string path, FileReaderOptions options, std::shared_ptr<coroutines::IoScheduler> scheduler);
+    ~FileReader();
+
+    FileReader(const FileReader&)            = delete;
+    FileReader& operator=(const FileReader&) = delete;
+
+    /**
+     * @brief reads the file from its start and writes its chunks to output
+     *
+     * returns when the file has been read or output is closed; read errors and a trailing partial record of a fixed
+     * record file are thrown
+     */
+    coroutines::Task<void> read(coroutines::RingBuffer<FileChunk>& output);
+
+    const std::string& path() const;
+
+    const FileReaderOptions& options() const;
+
+    // true if the file is read with O_DIRECT
+    bool direct_io() const;
+
+    // size of the file when it was opened
+    std::uint64_t file_size() const;
+
+  private:
+    struct Block;
+    class BufferPool;
+
+    coroutines::Task<std::vector<Block>> read_blocks(std::uint64_t offset);
+    coroutines::Task<bool> emit_blocks(std::vector<Block> blocks, coroutines::RingBuffer<FileChunk>& output);
+
+    // moves the carried bytes into a chunk of their own
+    FileChunk take_carry();
+
+    // index following the first and last record boundaries of a block; npos if it has none
+    std::size_t first_boundary(std::span<const std::byte> bytes, std::uint64_t offset) const;
+    std::size_t last_boundary(std::span<const std::byte> bytes, std::uint64_t offset) const;
+
+    const std::string m_path;
+    FileReaderOptions m_options;
+    std::shared_ptr<coroutines::IoScheduler> m_scheduler;
+    std::shared_ptr<BufferPool> m_pool;
+    int m_fd{-1};
+    bool m_direct_io{false};
+    std::uint64_t m_file_size{0};
+
+    // bytes of a record straddling the blocks emitted so far
+    std::vector<std::byte> m_carry;
+    std::uint64_t m_carry_offset{0};
+};
+
+/**
+ * @brief Writes bytes to a file in chunks of chunk_size with writes issued on a coroutines::IoScheduler
+ *
+ * Bytes are staged until a chunk is full; writes of at least a chunk are issued directly from the caller's bytes
+ * unless the file is written with O_DIRECT, which requires aligned buffers. close must be awaited to write the staged
+ * tail; a writer destroyed before close writes it synchronously.
+ *
+ * The file is opened on construction; failures throw std::system_error.
+ */
+class FileWriter
+{
+  public:
+    FileWriter(std::string path, FileWriterOptions options, std::shared_ptr<coroutines::IoScheduler> scheduler);
+    ~FileWriter();
+
+    FileWriter(const FileWriter&)            = delete;
+    FileWriter& operator=(const FileWriter&) = delete;
+
+    // the bytes may be released once the returned task completes
+    coroutines::Task<void> write(std::span<const std::byte> bytes);
+
+    // writes the staged bytes and closes the file
+    coroutines::Task<void> close();
+
+    const std::string& path() const;
+
+    // true if the file is written with O_DIRECT
+    bool direct_io() const;
+
+    // bytes passed to write, including those still staged
+    std::uint64_t bytes_written() const;
+
+  private:
+    class AlignedBuffer;
+
+    coroutines::Task<void> write_at(std::span<const std::byte> bytes);
+    void clear_direct_io();
+
+    const std::string m_path;
+    FileWriterOptions m_options;
+    std::shared_ptr<coroutines::IoScheduler> m_scheduler;
+    std::unique_ptr<AlignedBuffer> m_staging;
+    std::size_t m_staged{0};
+    int m_fd{-1};
+    bool m_direct_io{false};
+    std::uint64_t m_offset{0};
+};
+
+}  // namespace mrc::io
@@ -0,0 +1,70 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "mrc/io/stream_consumer.hpp"
+
+#include <chrono>
+#include <cstddef>
+#include <map>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace mrc::io {
+
+struct KafkaConsumerOptions
+{
+    // librdkafka configuration properties, e.g. bootstrap.servers and group.id
+    std::map<std::string, std::string> config;
+    // topics the consumer subscribes to
+    std::vector<std::string> topics;
+};
+
+/**
+ * @brief StreamConsumer of a Kafka consumer group, built on librdkafka
+ *
+ * Batches are consumed from the consumer queue with rd_kafka_consume_batch_queue and each message views the payload
+ * of its rd_kafka_message_t, which is destroyed with the last copy of the message. Offsets are committed only by
+ * commit, so enable.auto.commit is always disabled; a consumer joining the group resumes behind the last committed
+ * offsets.
+ *
+ * Available when libmrc is built with MRC_BUILD_KAFKA, otherwise construction throws. Configuration and subscription
+ * errors throw mrc::exceptions::MrcRuntimeError.
+ */
+class KafkaConsumer final : public StreamConsumer
+{
+  public:
+    KafkaConsumer(KafkaConsumerOptions options);
+    ~KafkaConsumer() final;
+
+    KafkaConsumer(const KafkaConsumer&)            = delete;
+    KafkaConsumer& operator=(const KafkaConsumer&) = delete;
+
+    std::optional<std::vector<StreamMessage>> poll(std::size_t max_messages, std::chrono::milliseconds timeout) final;
+
+    void commit(const StreamOffsets& offsets) final;
+
+  private:
+    struct Handle;
+
+    std::unique_ptr<Handle> m_handle;
+};
+
+}  // namespace mrc::io
@@ -0,0 +1,129 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "mrc/io/file.hpp"
+#include "mrc/memory/buffer_view.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <utility>
+
+namespace mrc::io {
+
+struct MappedFileOptions
+{
+    RecordFormat format{RecordFormat::lines};
+    // size of the records of RecordFormat::fixed
+    std::size_t record_size{0};
+    // target size of the views emitted by a source; a view never splits a record, so it may exceed the target when a
+    // single record does
+    std::size_t chunk_size{1UL << 20};
+};
+
+/**
+ * @brief Read-only memory mapping of a whole file
+ *
+ * The mapping is advised for sequential access. Byte ranges of whole records are found by scanning the mapping, which
+ * lets concurrent readers split a file between them without reading it first.
+ */
+class MappedFile
+{
+  public:
+    /**
+     * @brief maps the file at path; failures throw std::system_error
+     */
+    static std::shared_ptr<const MappedFile> open(const std::string& path);
+
+    ~MappedFile();
+
+    MappedFile(const MappedFile&)            = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    const std::string& path() const;
+
+    const std::byte* data() const;
+
+    std::size_t size() const;
+
+    /**
+     * @brief the byte range [begin, end) of the records of partition index out of count
+     *
+     * partitions split the file into count ranges of similar size moved to the next record boundary; the ranges of all
+     * partitions tile the file and some may be empty
+     */
+    std::pair<std::size_t, std::size_t> partition(const MappedFileOptions& options,
+                                                  std::size_t index,
+                                                  std::size_t count) const;
+
+    /**
+     * @brief the end of the view of about options.chunk_size bytes of whole records starting at begin, bounded by end
+     */
+    std::size_t chunk_end(const MappedFileOptions& options, std::size_t begin, std::size_t end) const;
+
+    /**
+     * @brief advises the kernel to read ahead the pages of [offset, offset + bytes)
+     */
+    void will_need(std::size_t offset, std::size_t bytes) const;
+
+  private:
+    MappedFile(std::string path, int fd, std::size_t size, void* data);
+
+    // first record boundary at or after offset
+    std::size_t record_boundary(const MappedFileOptions& options, std::size_t offset) const;
+
+    const std::string m_path;
+    int m_fd;
+    std::size_t m_size;
+    void* m_data;
+};
+
+/**
+ * @brief const_buffer_view of host memory into a MappedFile which keeps the mapping alive
+ *
+ * A copy sliced to its const_buffer_view base is only valid while a MappedView of the same file exists.
+ */
+class MappedView : public memory::const_buffer_view
+{
+  public:
+    MappedView() = default;
+    MappedView(std::shared_ptr<const MappedFile> file, std::size_t offset, std::size_t bytes);
+
+    // offset of the first byte of the view in the file
+    std::uint64_t offset() const;
+
+    std::string_view view() const;
+
+    const std::shared_ptr<const MappedFile>& file() const;
+
+    // io::for_each_line over the bytes of the view
+    template <typename CallableT>
+    void for_each_line(CallableT&& on_line) const
+    {
+        io::for_each_line(view(), std::forward<CallableT>(on_line));
+    }
+
+  private:
+    std::shared_ptr<const MappedFile> m_file;
+    std::uint64_t m_offset{0};
+};
+
+}  // namespace mrc::io
@@ -0,0 +1,123 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "mrc/memory/buffer_view.hpp"
+
+#include <chrono>
+#include <compare>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace mrc::io {
+
+/**
+ * @brief Partition of a topic of a message stream, e.g. of a Kafka cluster
+ */
+struct StreamPartition
+{
+    std::string topic;
+    std::int32_t partition{0};
+
+    auto operator<=>(const StreamPartition&) const = default;
+};
+
+// offset of the next message to consume of each partition
+using StreamOffsets = std::map<StreamPartition, std::int64_t>;
+
+/**
+ * @brief encodes offsets into a checkpoint token of a line "topic\tpartition\toffset" per partition
+ */
+std::string encode_offsets(const StreamOffsets& offsets);
+
+/**
+ * @brief decodes a token of encode_offsets; malformed tokens throw mrc::exceptions::MrcRuntimeError
+ */
+StreamOffsets decode_offsets(std::string_view token);
+
+/**
+ * @brief Message consumed from a stream, viewing its key and payload in place
+ *
+ * The owner holds the memory the consumer received the message into, e.g. the message of the client library or a
+ * pooled receive buffer, which is released once the last copy of the message is destroyed; payloads are passed
+ * downstream without copies.
+ */
+class StreamMessage
+{
+  public:
+    StreamMessage() = default;
+    StreamMessage(std::shared_ptr<const void> owner,
+                  StreamPartition partition,
+                  std::int64_t offset,
+                  std::span<const std::byte> key,
+                  std::span<const std::byte> payload);
+
+    const StreamPartition& partition() const;
+
+    std::int64_t offset() const;
+
+    std::span<const std::byte> key() const;
+
+    std::span<const std::byte> payload() const;
+
+    // the payload as a string_view
+    std::string_view view() const;
+
+    // the payload as a view of host memory
+    memory::const_buffer_view payload_view() const;
+
+  private:
+    std::shared_ptr<const void> m_owner;
+    StreamPartition m_partition;
+    std::int64_t m_offset{0};
+    std::span<const std::byte> m_key;
+    std::span<const std::byte> m_payload;
+};
+
+/**
+ * @brief Client of a message stream consumed in batches by a node::StreamSource
+ */
+class StreamConsumer
+{
+  public:
+    virtual ~StreamConsumer() = default;
+
+    /**
+     * @brief up to max_messages messages, waiting at most timeout for the first one
+     *
+     * an empty batch if none arrived in time; std::nullopt once the stream ended
+     */
+    virtual std::optional<std::vector<StreamMessage>> poll(std::size_t max_messages,
+                                                           std::chrono::milliseconds timeout) = 0;
+
+    /**
+     * @brief commits offsets as the positions the consumers of the stream resume from
+     *
+     * called from the threads of the sinks acknowledging a checkpoint, concurrently with poll
+     */
+    virtual void commit(const StreamOffsets& offsets) = 0;
+};
+
+}  // namespace mrc::io
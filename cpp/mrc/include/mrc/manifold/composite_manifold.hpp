@@ -85,6 +85,21 @@ class CompositeManifold : public Manifold
         });
     }
 
+    void do_drop_output(const SegmentAddress& address) final
+    {
+        // ordered with the enqueued additions
+        m_output_updates.push_back([this, address] {
+            DVLOG(10) << info() << ": egress detaching from downstream segment " << segment::info(address);
+            m_egress->drop_output(address);
+            on_drop_output(address);
+        });
+    }
+
+    void do_set_output_local(const SegmentAddress& address, bool local) final
+    {
+        m_output_updates.push_back([this, address, local] { m_egress->set_output_local(address, local); });
+    }
+
     void update(std::vector<std::function<void()>>& updates)
     {
         resources()
@@ -123,6 +138,7 @@ class CompositeManifold : public Manifold
 
     virtual void on_add_input(const SegmentAddress& address) {}
     virtual void on_add_output(const SegmentAddress& address) {}
+    virtual void on_drop_output(const SegmentAddress& address) {}
 
     virtual void will_update_inputs() {}
     virtual void will_update_outputs() {}
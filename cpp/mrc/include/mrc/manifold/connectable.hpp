@@ -18,6 +18,7 @@
 #pragma once
 
 #include "mrc/manifold/interface.hpp"
+#include "mrc/options/manifolds.hpp"
 #include "mrc/pipeline/resources.hpp"
 
 namespace mrc::manifold {
@@ -28,9 +29,11 @@ struct Connectable
 
     /**
      * @brief Create a Manifold in the typed environment of the Connectable object, e.g. IngressPort, EgressPort
+     * @param options egress policy and batching of the manifold
      * @return std::shared_ptr<manifold::Interface>
      */
-    virtual std::shared_ptr<manifold::Interface> make_manifold(pipeline::Resources&) = 0;
+    virtual std::shared_ptr<manifold::Interface> make_manifold(pipeline::Resources&,
+                                                               const ManifoldOptions& options) = 0;
 
     /**
      * @brief Connect a Connectable to a Manifold
@@ -0,0 +1,194 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2021-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "mrc/exceptions/runtime_error.hpp"
+#include "mrc/manifold/interface.hpp"
+#include "mrc/manifold/manifold.hpp"
+#include "mrc/node/edge_builder.hpp"
+#include "mrc/node/sink_properties.hpp"
+#include "mrc/node/source_properties.hpp"
+#include "mrc/pipeline/resources.hpp"
+#include "mrc/segment/utils.hpp"
+#include "mrc/types.hpp"
+
+#include <glog/logging.h>
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace mrc::manifold {
+
+/**
+ * @brief Manifold connecting the only upstream segment of a port directly to its only downstream segment
+ *
+ * With a single segment on each side, a load balancer forwards every element to the same downstream segment, at the
+ * cost of a muxer channel and a balancer fiber per element. This manifold instead forms a channel edge from the egress
+ * port of the upstream segment to the ingress port of the downstream segment when the first update attaches exactly one
+ * of each. Otherwise, e.g. when several downstream instances are attached at once, it hands all updates to the
+ * manifold built by fallback_fn and behaves as that manifold from then on.
+ *
+ * Once connected, the edge is fixed: attaching further segments throws, and a dropped downstream segment completes
+ * when the upstream segment completes. The pipeline only selects this manifold for ports whose segments are not scaled.
+ */
+template <typename T>
+class DirectManifold final : public Manifold
+{
+  public:
+    using fallback_fn_t = std::function<std::shared_ptr<Interface>()>;
+
+    DirectManifold(PortName port_name, pipeline::Resources& resources, fallback_fn_t fallback_fn) :
+      Manifold(std::move(port_name), resources),
+      m_fallback_fn(std::move(fallback_fn))
+    {
+        CHECK(m_fallback_fn);
+    }
+
+    bool is_direct() const
+    {
+        return m_connected;
+    }
+
+    void start() final
+    {
+        if (m_fallback)
+        {
+            m_fallback->start();
+        }
+    }
+
+    void join() final
+    {
+        if (m_fallback)
+        {
+            m_fallback->join();
+        }
+    }
+
+  private:
+    void do_add_input(const SegmentAddress& address, node::SourcePropertiesBase* input_source) final
+    {
+        m_inputs.emplace_back(address, input_source);
+        m_updates.push_back(
+            [address, input_source](Interface& manifold) { manifold.add_input(address, input_source); });
+    }
+
+    void do_add_output(const SegmentAddress& address, node::SinkPropertiesBase* output_sink) final
+    {
+        m_outputs.emplace_back(address, output_sink);
+        m_updates.push_back([address, output_sink](Interface& manifold) { manifold.add_output(address, output_sink); });
+    }
+
+    void do_drop_output(const SegmentAddress& address) final
+    {
+        ++m_drops;
+        m_updates.push_back([address](Interface& manifold) { manifold.drop_output(address); });
+    }
+
+    void do_set_output_local(const SegmentAddress& address, bool local) final
+    {
+        m_updates.push_back([address, local](Interface& manifold) { manifold.set_output_local(address, local); });
+    }
+
+    // all decisions are taken once both sides of the update are known
+    void update_inputs() final {}
+
+    void update_outputs() final
+    {
+        if (m_fallback)
+        {
+            replay();
+            return;
+        }
+
+        if (m_connected)
+        {
+            if (!m_inputs.empty() || !m_outputs.empty())
+            {
+                LOG(ERROR) << "manifold " << port_name()
+                           << ": a direct connection can not be extended to further segments";
+                throw exceptions::MrcRuntimeError("direct manifold connection can not be extended");
+            }
+            if (m_drops > 0)
+            {
+                DVLOG(10) << "manifold " << port_name()
+                          << ": dropped downstream segment completes with its upstream segment";
+            }
+            clear();
+            return;
+        }
+
+        if (m_updates.empty())
+        {
+            return;
+        }
+
+        if (m_inputs.size() == 1 && m_outputs.size() == 1 && m_drops == 0)
+        {
+            auto* source = dynamic_cast<node::SourceProperties<T>*>(m_inputs.front().second);
+            auto* sink   = dynamic_cast<node::SinkProperties<T>*>(m_outputs.front().second);
+            CHECK(source && sink);
+
+            DVLOG(10) << "manifold " << port_name() << ": connecting " << segment::info(m_inputs.front().first)
+                      << " directly to " << segment::info(m_outputs.front().first);
+            resources().main().enqueue([source, sink] { node::make_edge(*source, *sink); }).get();
+            m_connected = true;
+            clear();
+            return;
+        }
+
+        DVLOG(10) << "manifold " << port_name() << ": " << m_inputs.size() << " upstream and " << m_outputs.size()
+                  << " downstream segments; falling back to a load balancer";
+        m_fallback = m_fallback_fn();
+        replay();
+    }
+
+    void replay()
+    {
+        for (auto& update_fn : m_updates)
+        {
+            update_fn(*m_fallback);
+        }
+        clear();
+        m_fallback->update_inputs();
+        m_fallback->update_outputs();
+    }
+
+    void clear()
+    {
+        m_inputs.clear();
+        m_outputs.clear();
+        m_drops = 0;
+        m_updates.clear();
+    }
+
+    fallback_fn_t m_fallback_fn;
+    std::shared_ptr<Interface> m_fallback;
+    bool m_connected{false};
+
+    // updates since the last update_outputs
+    std::vector<std::pair<SegmentAddress, node::SourcePropertiesBase*>> m_inputs;
+    std::vector<std::pair<SegmentAddress, node::SinkPropertiesBase*>> m_outputs;
+    std::size_t m_drops{0};
+    std::vector<std::function<void(Interface&)>> m_updates;
+};
+
+}  // namespace mrc::manifold
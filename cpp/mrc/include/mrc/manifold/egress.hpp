@@ -17,13 +17,29 @@
 
 #pragma once
 
+#include "mrc/channel/telemetry.hpp"
 #include "mrc/manifold/interface.hpp"
 #include "mrc/node/edge_builder.hpp"
 #include "mrc/node/operators/muxer.hpp"
+#include "mrc/node/sink_channel_base.hpp"
 #include "mrc/node/sink_properties.hpp"
 #include "mrc/node/source_properties.hpp"
+#include "mrc/options/manifolds.hpp"
 
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
 #include <memory>
+#include <optional>
+#include <random>
+#include <span>
+#include <type_traits>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
 
 namespace mrc::manifold {
 
@@ -31,6 +47,11 @@ struct EgressDelegate
 {
     virtual ~EgressDelegate()                                                                     = default;
     virtual void add_output(const SegmentAddress& address, node::SinkPropertiesBase* output_sink) = 0;
+    virtual void drop_output(const SegmentAddress& address)                                       = 0;
+
+    // hints whether the downstream segment runs on the partition of the manifold; ignored by egresses which are not
+    // locality aware
+    virtual void set_output_local(const SegmentAddress& address, bool local) {}
 };
 
 template <typename T>
@@ -44,15 +65,21 @@ class TypedEngress : public EgressDelegate
         do_add_output(address, *sink);
     }
 
+    void drop_output(const SegmentAddress& address) final
+    {
+        do_drop_output(address);
+    }
+
   private:
     virtual void do_add_output(const SegmentAddress& address, node::SinkProperties<T>& output_sink) = 0;
+    virtual void do_drop_output(const SegmentAddress& address)                                      = 0;
 };
 
 template <typename T>
 class MappedEgress : public TypedEngress<T>
 {
   public:
-    using channel_map_t = std::unordered_map<SegmentAddress, std::unique_ptr<node::SourceChannelWriteable<T>>>;
+    using channel_map_t = std::unordered_map<SegmentAddress, std::shared_ptr<node::SourceChannelWriteable<T>>>;
 
     const channel_map_t& output_channels() const
     {
@@ -69,13 +96,21 @@ class MappedEgress : public TypedEngress<T>
     {
         auto search = m_outputs.find(address);
         CHECK(search == m_outputs.end());
-        auto output_channel = std::make_unique<node::SourceChannelWriteable<T>>();
+        auto output_channel = std::make_shared<node::SourceChannelWriteable<T>>();
         node::make_edge(*output_channel, sink);
         m_outputs[address] = std::move(output_channel);
     }
 
+    // releasing the writer closes the downstream ingress once any in-flight write holding it returns
+    void do_drop_output(const SegmentAddress& address) override
+    {
+        auto search = m_outputs.find(address);
+        CHECK(search != m_outputs.end());
+        m_outputs.erase(search);
+    }
+
   private:
-    std::unordered_map<SegmentAddress, std::unique_ptr<node::SourceChannelWriteable<T>>> m_outputs;
+    channel_map_t m_outputs;
 };
 
 template <typename T>
@@ -86,13 +121,25 @@ class RoundRobinEgress : public MappedEgress<T>
     void await_write(T&& data)
     {
         CHECK_LT(m_next, m_pick_list.size());
-        auto next = m_next++;
-        // roll counter before await_write which could yield
+        // hold the output and roll counter before await_write which could yield, possibly to an update dropping it
+        auto output = m_pick_list[m_next++];
         if (m_next == m_pick_list.size())
         {
             m_next = 0;
         }
-        CHECK(m_pick_list[next]->await_write(std::move(data)) == channel::Status::success);
+        CHECK(output->await_write(std::move(data)) == channel::Status::success);
+    }
+
+    // writes the batch to a single output
+    void await_write_n(std::span<T> data)
+    {
+        CHECK_LT(m_next, m_pick_list.size());
+        auto output = m_pick_list[m_next++];
+        if (m_next == m_pick_list.size())
+        {
+            m_next = 0;
+        }
+        CHECK(output->await_write_n(data) == channel::Status::success);
     }
 
   private:
@@ -102,20 +149,505 @@ class RoundRobinEgress : public MappedEgress<T>
         update_pick_list();
     }
 
+    void do_drop_output(const SegmentAddress& address) override
+    {
+        MappedEgress<T>::do_drop_output(address);
+        update_pick_list();
+    }
+
     void update_pick_list()
     {
         m_pick_list.clear();
         m_pick_list.reserve(this->output_channels().size());
         for (const auto& [rank, channel] : this->output_channels())
         {
-            m_pick_list.push_back(channel.get());
+            m_pick_list.push_back(channel);
         }
         std::random_shuffle(m_pick_list.begin(), m_pick_list.end());
         m_next = 0;
     }
 
     std::size_t m_next{0};
-    std::vector<node::SourceChannelWriteable<T>*> m_pick_list;
+    std::vector<std::shared_ptr<node::SourceChannelWriteable<T>>> m_pick_list;
+};
+
+/**
+ * @brief Base of the egress policies which pick an output from the occupancy of the channels of the downstream sinks
+ *
+ * The occupancy of an output is read from the channel of its sink; outputs whose sink does not own a channel are
+ * considered empty.
+ */
+template <typename T>
+class OccupancyEgress : public MappedEgress<T>
+{
+  public:
+    // todo(#189) - use raw_checks for hot path
+    void await_write(T&& data)
+    {
+        CHECK(!m_outputs.empty());
+        // hold the output before await_write which could yield, possibly to an update dropping it
+        auto output = m_outputs[select()].channel;
+        CHECK(output->await_write(std::move(data)) == channel::Status::success);
+    }
+
+    // writes the batch to a single output
+    void await_write_n(std::span<T> data)
+    {
+        CHECK(!m_outputs.empty());
+        auto output = m_outputs[select()].channel;
+        CHECK(output->await_write_n(data) == channel::Status::success);
+    }
+
+    void clear()
+    {
+        MappedEgress<T>::clear();
+        m_sinks.clear();
+        m_outputs.clear();
+        m_indices.clear();
+    }
+
+  protected:
+    std::size_t output_count() const
+    {
+        return m_outputs.size();
+    }
+
+    std::size_t occupancy(std::size_t idx) const
+    {
+        const auto* sink = m_outputs[idx].sink;
+        return (sink == nullptr ? 0 : sink->channel_statistics().occupancy);
+    }
+
+    // 0 if the capacity of the downstream channel is unknown
+    std::size_t capacity(std::size_t idx) const
+    {
+        const auto* sink = m_outputs[idx].sink;
+        return (sink == nullptr ? 0 : sink->channel_statistics().capacity);
+    }
+
+    const SegmentAddress& output_address(std::size_t idx) const
+    {
+        return m_outputs[idx].address;
+    }
+
+    const std::shared_ptr<node::SourceChannelWriteable<T>>& output_channel(std::size_t idx) const
+    {
+        return m_outputs[idx].channel;
+    }
+
+    // counters of the channel of the downstream sink; empty if the sink does not own a channel
+    std::optional<channel::ChannelStatistics> statistics(std::size_t idx) const
+    {
+        const auto* sink = m_outputs[idx].sink;
+        if (sink == nullptr)
+        {
+            return std::nullopt;
+        }
+        return sink->channel_statistics();
+    }
+
+    // indices of all outputs
+    const std::vector<std::size_t>& output_indices() const
+    {
+        return m_indices;
+    }
+
+    // index of the least occupied of the candidate outputs, scanning from next; next is advanced past the selected
+    // candidate so ties are broken round robin
+    std::size_t shortest(const std::vector<std::size_t>& candidates, std::size_t& next) const
+    {
+        const auto count = candidates.size();
+        auto selected    = next % count;
+        auto fewest      = occupancy(candidates[selected]);
+        for (std::size_t i = 1; i < count && fewest != 0; ++i)
+        {
+            const auto idx      = (next + i) % count;
+            const auto elements = occupancy(candidates[idx]);
+            if (elements < fewest)
+            {
+                selected = idx;
+                fewest   = elements;
+            }
+        }
+        next = selected + 1;
+        return candidates[selected];
+    }
+
+    // called once the outputs have been reindexed
+    virtual void on_update_outputs() {}
+
+  private:
+    // index of the output of the next write
+    virtual std::size_t select() = 0;
+
+    struct Output
+    {
+        SegmentAddress address;
+        std::shared_ptr<node::SourceChannelWriteable<T>> channel;
+        const node::SinkChannelBase<T>* sink;
+    };
+
+    void do_add_output(const SegmentAddress& address, node::SinkProperties<T>& sink) override
+    {
+        MappedEgress<T>::do_add_output(address, sink);
+        m_sinks[address] = dynamic_cast<const node::SinkChannelBase<T>*>(&sink);
+        update_outputs();
+    }
+
+    void do_drop_output(const SegmentAddress& address) override
+    {
+        MappedEgress<T>::do_drop_output(address);
+        m_sinks.erase(address);
+        update_outputs();
+    }
+
+    void update_outputs()
+    {
+        m_outputs.clear();
+        m_indices.clear();
+        m_outputs.reserve(this->output_channels().size());
+        for (const auto& [address, channel] : this->output_channels())
+        {
+            m_indices.push_back(m_outputs.size());
+            m_outputs.push_back({address, channel, m_sinks.at(address)});
+        }
+        on_update_outputs();
+    }
+
+    std::unordered_map<SegmentAddress, const node::SinkChannelBase<T>*> m_sinks;
+    std::vector<Output> m_outputs;
+    std::vector<std::size_t> m_indices;
+};
+
+/**
+ * @brief Writes each element to the output whose downstream channel holds the fewest elements; ties are broken round
+ * robin
+ */
+template <typename T>
+class ShortestQueueEgress : public OccupancyEgress<T>
+{
+    std::size_t select() final
+    {
+        return this->shortest(this->output_indices(), m_next);
+    }
+
+    std::size_t m_next{0};
+};
+
+/**
+ * @brief Writes each element to the less occupied of two distinct outputs sampled at random
+ */
+template <typename T>
+class PowerOfTwoChoicesEgress : public OccupancyEgress<T>
+{
+    std::size_t select() final
+    {
+        const auto count = this->output_count();
+        if (count == 1)
+        {
+            return 0;
+        }
+        auto first  = std::uniform_int_distribution<std::size_t>(0, count - 1)(m_generator);
+        auto second = std::uniform_int_distribution<std::size_t>(0, count - 2)(m_generator);
+        if (second >= first)
+        {
+            ++second;
+        }
+        return (this->occupancy(second) < this->occupancy(first) ? second : first);
+    }
+
+    std::minstd_rand m_generator{std::random_device{}()};
+};
+
+/**
+ * @brief Writes each element to the least occupied output on the partition of the manifold as long as that output has
+ * capacity; once every local output is backpressured, elements spill to the least occupied output on any partition
+ */
+template <typename T>
+class LocalityFirstEgress : public OccupancyEgress<T>
+{
+  public:
+    void set_output_local(const SegmentAddress& address, bool local) final
+    {
+        if (local)
+        {
+            m_local_addresses.insert(address);
+        }
+        else
+        {
+            m_local_addresses.erase(address);
+        }
+        on_update_outputs();
+    }
+
+  private:
+    std::size_t select() final
+    {
+        if (!m_local_outputs.empty())
+        {
+            const auto selected = this->shortest(m_local_outputs, m_next_local);
+            const auto capacity = this->capacity(selected);
+            if (capacity == 0 || this->occupancy(selected) < capacity)
+            {
+                return selected;
+            }
+        }
+        return this->shortest(this->output_indices(), m_next);
+    }
+
+    void on_update_outputs() final
+    {
+        m_local_outputs.clear();
+        for (auto idx : this->output_indices())
+        {
+            if (m_local_addresses.contains(this->output_address(idx)))
+            {
+                m_local_outputs.push_back(idx);
+            }
+        }
+    }
+
+    std::unordered_set<SegmentAddress> m_local_addresses;
+    std::vector<std::size_t> m_local_outputs;
+    std::size_t m_next_local{0};
+    std::size_t m_next{0};
+};
+
+/**
+ * @brief Writes each element to the least occupied output, and writes an element again to the least occupied other
+ * output if the downstream segment it was written to has not dequeued it within the hedge threshold
+ *
+ * An element is acknowledged once the channel of its downstream sink has been read past the position at which it was
+ * written, so the threshold applies to the queueing delay of a straggling segment. The threshold is the configured
+ * percentile of the recently observed acknowledgement latencies, bounded below by min_delay. Acknowledgements and
+ * stragglers are detected as elements are written, so latencies are only as fine as the interval between writes.
+ *
+ * A copy of each tracked element is held until it is acknowledged or hedged. Both the original and the hedged element
+ * are processed, so the downstream stages must be idempotent and the consumers of their results must tolerate, or
+ * discard, the later of two results.
+ */
+template <typename T>
+class HedgedEgress : public OccupancyEgress<T>
+{
+    static_assert(std::is_copy_constructible_v<T>, "the elements of a hedged egress must be copyable");
+
+    using clock_t = std::chrono::steady_clock;
+
+    // acknowledgement latencies from which the threshold is computed
+    static constexpr std::size_t LatencyWindow = 256;
+
+    // acknowledgements between two updates of the threshold
+    static constexpr std::size_t UpdateInterval = 32;
+
+  public:
+    void set_hedge_options(const HedgeOptions& options)
+    {
+        CHECK(options.percentile > 0 && options.percentile <= 1);
+        m_options = options;
+    }
+
+    // todo(#189) - use raw_checks for hot path
+    void await_write(T&& data)
+    {
+        // hedging may yield to an update of the outputs, so the output is selected afterwards
+        hedge_stragglers();
+        CHECK(this->output_count() > 0);
+
+        const auto idx      = select();
+        auto output         = this->output_channel(idx);
+        const auto address  = this->output_address(idx);
+        const auto position = write_position(idx, 1);
+
+        std::vector<T> copies;
+        if (position)
+        {
+            copies.push_back(data);
+        }
+        CHECK(output->await_write(std::move(data)) == channel::Status::success);
+        track(address, position, std::move(copies));
+    }
+
+    // writes the batch to a single output; the batch is acknowledged and hedged as a whole
+    void await_write_n(std::span<T> data)
+    {
+        // hedging may yield to an update of the outputs, so the output is selected afterwards
+        hedge_stragglers();
+        CHECK(this->output_count() > 0);
+
+        const auto idx      = select();
+        auto output         = this->output_channel(idx);
+        const auto address  = this->output_address(idx);
+        const auto position = write_position(idx, data.size());
+
+        std::vector<T> copies;
+        if (position)
+        {
+            copies.assign(data.begin(), data.end());
+        }
+        CHECK(output->await_write_n(data) == channel::Status::success);
+        track(address, position, std::move(copies));
+    }
+
+    // number of elements written a second time
+    std::uint64_t hedged_count() const
+    {
+        return m_hedged_count;
+    }
+
+    // current threshold; empty until enough acknowledgements were observed
+    std::optional<clock_t::duration> threshold() const
+    {
+        return m_threshold;
+    }
+
+  private:
+    std::size_t select() final
+    {
+        return this->shortest(this->output_indices(), m_next);
+    }
+
+    struct Pending
+    {
+        // the element is acknowledged once the downstream channel has been read this many times
+        std::uint64_t position;
+        clock_t::time_point written;
+        // empty once hedged
+        std::vector<T> copies;
+    };
+
+    struct PendingQueue
+    {
+        std::deque<Pending> elements;
+        // the first elements, in order of their writes, which were hedged
+        std::size_t hedged{0};
+
+        void pop_front()
+        {
+            elements.pop_front();
+            if (hedged > 0)
+            {
+                --hedged;
+            }
+        }
+    };
+
+    // position of the last of count elements written to the output next; empty if the output can not be tracked
+    std::optional<std::uint64_t> write_position(std::size_t idx, std::size_t count) const
+    {
+        auto stats = this->statistics(idx);
+        if (!stats)
+        {
+            return std::nullopt;
+        }
+        return stats->writes + count;
+    }
+
+    void track(const SegmentAddress& address, std::optional<std::uint64_t> position, std::vector<T>&& copies)
+    {
+        // the output may have been dropped while the write yielded
+        if (!position || !m_addresses.contains(address))
+        {
+            return;
+        }
+        auto& queue = m_pending[address];
+        if (queue.elements.size() >= m_options.max_pending)
+        {
+            queue.pop_front();
+        }
+        queue.elements.push_back({*position, clock_t::now(), std::move(copies)});
+    }
+
+    void hedge_stragglers()
+    {
+        const auto now = clock_t::now();
+        std::vector<std::pair<std::shared_ptr<node::SourceChannelWriteable<T>>, std::vector<T>>> hedges;
+
+        for (auto idx : this->output_indices())
+        {
+            auto search = m_pending.find(this->output_address(idx));
+            auto stats  = this->statistics(idx);
+            if (search == m_pending.end() || !stats)
+            {
+                continue;
+            }
+
+            auto& queue = search->second;
+            while (!queue.elements.empty() && stats->reads >= queue.elements.front().position)
+            {
+                record_latency(now - queue.elements.front().written);
+                queue.pop_front();
+            }
+
+            if (!m_threshold || this->output_count() < 2)
+            {
+                continue;
+            }
+            while (queue.hedged < queue.elements.size() && now - queue.elements[queue.hedged].written > *m_threshold)
+            {
+                auto& pending = queue.elements[queue.hedged++];
+                hedges.emplace_back(this->output_channel(other_than(idx)), std::move(pending.copies));
+                pending.copies.clear();
+            }
+        }
+
+        // the writes may yield, so they are issued once the pending elements are no longer referenced
+        for (auto& [output, copies] : hedges)
+        {
+            m_hedged_count += copies.size();
+            CHECK(output->await_write_n(copies) == channel::Status::success);
+        }
+    }
+
+    // least occupied output other than idx
+    std::size_t other_than(std::size_t idx)
+    {
+        m_candidates.clear();
+        for (auto candidate : this->output_indices())
+        {
+            if (candidate != idx)
+            {
+                m_candidates.push_back(candidate);
+            }
+        }
+        return this->shortest(m_candidates, m_next_hedge);
+    }
+
+    void record_latency(clock_t::duration latency)
+    {
+        m_latencies[m_latency_count++ % LatencyWindow] = latency;
+        if (m_latency_count < m_options.warmup || (m_threshold && m_latency_count % UpdateInterval != 0))
+        {
+            return;
+        }
+
+        const auto count = std::min(m_latency_count, LatencyWindow);
+        std::vector<clock_t::duration> sorted(m_latencies.begin(), m_latencies.begin() + count);
+        const auto rank = std::min(count - 1, static_cast<std::size_t>(m_options.percentile * count));
+        std::nth_element(sorted.begin(), sorted.begin() + rank, sorted.end());
+        m_threshold = std::max<clock_t::duration>(sorted[rank], m_options.min_delay);
+    }
+
+    void on_update_outputs() final
+    {
+        m_addresses.clear();
+        for (auto idx : this->output_indices())
+        {
+            m_addresses.insert(this->output_address(idx));
+        }
+        std::erase_if(m_pending, [this](const auto& entry) { return !m_addresses.contains(entry.first); });
+    }
+
+    HedgeOptions m_options;
+    std::unordered_set<SegmentAddress> m_addresses;
+    std::unordered_map<SegmentAddress, PendingQueue> m_pending;
+    std::vector<std::size_t> m_candidates;
+    std::size_t m_next{0};
+    std::size_t m_next_hedge{0};
+
+    std::array<clock_t::duration, LatencyWindow> m_latencies{};
+    std::size_t m_latency_count{0};
+    std::optional<clock_t::duration> m_threshold;
+    std::uint64_t m_hedged_count{0};
 };
 
 }  // namespace mrc::manifold
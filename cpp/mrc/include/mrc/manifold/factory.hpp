@@ -17,19 +17,65 @@
 
 #pragma once
 
+#include "mrc/manifold/direct.hpp"
+#include "mrc/manifold/egress.hpp"
 #include "mrc/manifold/interface.hpp"
 #include "mrc/manifold/load_balancer.hpp"
+#include "mrc/options/manifolds.hpp"
+
+#include <glog/logging.h>
 
 #include <memory>
+#include <type_traits>
 
 namespace mrc::manifold {
 
 template <typename T>
 struct Factory final
 {
-    static std::shared_ptr<Interface> make_manifold(PortName port_name, pipeline::Resources& resources)
+    static std::shared_ptr<Interface> make_manifold(PortName port_name,
+                                                    pipeline::Resources& resources,
+                                                    const ManifoldOptions& options)
+    {
+        if (options.direct_connection(port_name))
+        {
+            auto fallback_fn = [port_name, &resources, options] {
+                auto balanced = options;
+                balanced.set_direct_connection(port_name, false);
+                return make_manifold(port_name, resources, balanced);
+            };
+            return std::make_shared<DirectManifold<T>>(std::move(port_name), resources, std::move(fallback_fn));
+        }
+
+        switch (options.egress_policy(port_name))
+        {
+        case EgressPolicy::RoundRobin:
+            return make_load_balancer<RoundRobinEgress<T>>(std::move(port_name), resources, options);
+        case EgressPolicy::ShortestQueue:
+            return make_load_balancer<ShortestQueueEgress<T>>(std::move(port_name), resources, options);
+        case EgressPolicy::PowerOfTwoChoices:
+            return make_load_balancer<PowerOfTwoChoicesEgress<T>>(std::move(port_name), resources, options);
+        case EgressPolicy::LocalityFirst:
+            return make_load_balancer<LocalityFirstEgress<T>>(std::move(port_name), resources, options);
+        case EgressPolicy::Hedged:
+            if constexpr (std::is_copy_constructible_v<T>)
+            {
+                return make_load_balancer<HedgedEgress<T>>(std::move(port_name), resources, options);
+            }
+            LOG(WARNING) << "elements of port " << port_name << " can not be copied to be hedged; using ShortestQueue";
+            return make_load_balancer<ShortestQueueEgress<T>>(std::move(port_name), resources, options);
+        }
+        LOG(FATAL) << "unhandled egress policy";
+        return nullptr;
+    }
+
+  private:
+    template <typename EgressT>
+    static std::shared_ptr<Interface> make_load_balancer(PortName port_name,
+                                                         pipeline::Resources& resources,
+                                                         const ManifoldOptions& options)
     {
-        return std::make_shared<LoadBalancer<T>>(std::move(port_name), resources);
+        return std::make_shared<LoadBalancer<T, EgressT>>(std::move(port_name), resources, options);
     }
 };
 
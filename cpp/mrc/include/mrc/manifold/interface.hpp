@@ -31,6 +31,12 @@ struct Interface
     virtual void add_input(const SegmentAddress& address, node::SourcePropertiesBase* input_source) = 0;
     virtual void add_output(const SegmentAddress& address, node::SinkPropertiesBase* output_sink)   = 0;
 
+    // releases the output to a downstream segment; the segment drains the data already routed to it and completes
+    virtual void drop_output(const SegmentAddress& address) = 0;
+
+    // hints whether the downstream segment runs on the same partition as the manifold; ordered with the output updates
+    virtual void set_output_local(const SegmentAddress& address, bool local) = 0;
+
     // updates are ordered
     // first, inputs are updated (upstream segments have not started emitting - this is safe)
     // then, upstream segments are started,
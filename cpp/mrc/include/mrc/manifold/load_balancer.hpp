@@ -17,6 +17,8 @@
 
 #pragma once
 
+#include "mrc/channel/status.hpp"
+#include "mrc/channel/types.hpp"
 #include "mrc/core/addresses.hpp"
 #include "mrc/manifold/composite_manifold.hpp"
 #include "mrc/manifold/interface.hpp"
@@ -24,25 +26,34 @@
 #include "mrc/node/generic_sink.hpp"
 #include "mrc/node/operators/muxer.hpp"
 #include "mrc/node/rx_sink.hpp"
+#include "mrc/node/sink_channel.hpp"
 #include "mrc/node/source_channel.hpp"
+#include "mrc/options/manifolds.hpp"
 #include "mrc/pipeline/resources.hpp"
+#include "mrc/runnable/context.hpp"
 #include "mrc/runnable/launch_options.hpp"
 #include "mrc/runnable/launchable.hpp"
+#include "mrc/runnable/runnable.hpp"
 #include "mrc/runnable/types.hpp"
 #include "mrc/types.hpp"
 
+#include <glog/logging.h>
+
+#include <chrono>
+#include <cstddef>
 #include <memory>
 #include <unordered_map>
+#include <vector>
 
 namespace mrc::manifold {
 
 namespace detail {
 
-template <typename T>
+template <typename T, typename EgressT>
 class Balancer : public node::GenericSink<T>
 {
   public:
-    Balancer(RoundRobinEgress<T>& state) : m_state(state) {}
+    Balancer(EgressT& state) : m_state(state) {}
 
   private:
     void on_data(T&& data) final
@@ -57,28 +68,111 @@ class Balancer : public node::GenericSink<T>
         m_state.clear();
     };
 
-    RoundRobinEgress<T>& m_state;
+    EgressT& m_state;
+};
+
+/**
+ * @brief Balancer which forwards the elements of its input to the egress in batches
+ *
+ * Each engine reads up to batch_size elements, waiting at most batch_window after the first element of a batch for the
+ * batch to fill, then writes the whole batch to a single downstream segment.
+ */
+template <typename T, typename EgressT>
+class BatchingBalancer : public node::SinkChannel<T>, public runnable::RunnableWithContext<>
+{
+  public:
+    BatchingBalancer(EgressT& state, std::size_t batch_size, std::chrono::microseconds batch_window) :
+      m_state(state),
+      m_batch_size(batch_size),
+      m_batch_window(batch_window)
+    {
+        CHECK_GT(m_batch_size, 0);
+    }
+
+  private:
+    void run(runnable::Context& ctx) final
+    {
+        std::vector<T> batch;
+        batch.reserve(m_batch_size);
+
+        while (this->egress().await_read_n(batch, m_batch_size) == channel::Status::success)
+        {
+            // the first read drains whatever is available; linger for the remainder of the batch
+            const channel::time_point_t deadline = channel::clock_t::now() + m_batch_window;
+            while (m_batch_window.count() > 0 && batch.size() < m_batch_size)
+            {
+                if (this->egress().await_read_n(batch, m_batch_size - batch.size(), deadline) !=
+                    channel::Status::success)
+                {
+                    break;
+                }
+            }
+            m_state.await_write_n(batch);
+            batch.clear();
+        }
+
+        ctx.barrier();
+        if (ctx.rank() == 0)
+        {
+            DVLOG(10) << "shutdown batching load-balancer - clear output channels";
+            m_state.clear();
+        }
+        ctx.barrier();
+    }
+
+    void on_state_update(const runnable::Runnable::State& state) final
+    {
+        // the input closes once the upstream edges are released
+        if (state == runnable::Runnable::State::Stop || state == runnable::Runnable::State::Kill)
+        {
+            this->disable_persistence();
+        }
+    }
+
+    EgressT& m_state;
+    const std::size_t m_batch_size;
+    const std::chrono::microseconds m_batch_window;
 };
 
 }  // namespace detail
 
-template <typename T>
-class LoadBalancer : public CompositeManifold<MuxedIngress<T>, RoundRobinEgress<T>>
+/**
+ * @brief Manifold balancing the elements of all upstream segments across the downstream segments
+ *
+ * EgressT picks the downstream segment of each element, e.g. RoundRobinEgress or ShortestQueueEgress. With a batch
+ * size greater than 1, elements are forwarded in batches of up to batch_size elements collected over at most
+ * batch_window, so each downstream segment is handed a batch at a time rather than an element at a time.
+ */
+template <typename T, typename EgressT = RoundRobinEgress<T>>
+class LoadBalancer : public CompositeManifold<MuxedIngress<T>, EgressT>
 {
-    using base_t = CompositeManifold<MuxedIngress<T>, RoundRobinEgress<T>>;
+    using base_t = CompositeManifold<MuxedIngress<T>, EgressT>;
 
   public:
-    LoadBalancer(PortName port_name, pipeline::Resources& resources) : base_t(std::move(port_name), resources)
+    LoadBalancer(PortName port_name, pipeline::Resources& resources, const ManifoldOptions& options = {}) :
+      base_t(std::move(port_name), resources),
+      m_launch_options(options.launch_options(this->port_name()))
     {
-        m_launch_options.engine_factory_name = "main";
-        m_launch_options.pe_count            = 1;
-        m_launch_options.engines_per_pe      = 8;
+        const auto batch_size   = options.batch_size();
+        const auto batch_window = options.batch_window();
+
+        if constexpr (requires(EgressT & egress, const HedgeOptions& hedge) { egress.set_hedge_options(hedge); })
+        {
+            this->egress().set_hedge_options(options.hedge_options());
+        }
 
         // construct any resources
         this->resources()
             .main()
-            .enqueue([this] {
-                m_balancer = std::make_unique<detail::Balancer<T>>(this->egress());
+            .enqueue([this, batch_size, batch_window] {
+                if (batch_size > 1)
+                {
+                    m_batching_balancer = std::make_unique<detail::BatchingBalancer<T, EgressT>>(
+                        this->egress(), batch_size, batch_window);
+                    node::make_edge(this->ingress().source(), *m_batching_balancer);
+                    return;
+                }
+                m_balancer = std::make_unique<detail::Balancer<T, EgressT>>(this->egress());
                 node::make_edge(this->ingress().source(), *m_balancer);
             })
             .get();
@@ -96,6 +190,14 @@ class LoadBalancer : public CompositeManifold<MuxedIngress<T>, RoundRobinEgress<
                     // CHECK(!this->egress().output_channels().empty()) << "no egress channels on manifold";
                     return;
                 }
+                if (m_batching_balancer)
+                {
+                    m_runner = this->resources()
+                                   .launch_control()
+                                   .prepare_launcher(launch_options(), std::move(m_batching_balancer))
+                                   ->ignition();
+                    return;
+                }
                 CHECK(m_balancer);
                 m_runner = this->resources()
                                .launch_control()
@@ -121,6 +223,7 @@ class LoadBalancer : public CompositeManifold<MuxedIngress<T>, RoundRobinEgress<
 
     // this is the progress engine that will drive the load balancer
     std::unique_ptr<node::GenericSink<T>> m_balancer;
+    std::unique_ptr<detail::BatchingBalancer<T, EgressT>> m_batching_balancer;
 
     // runner
     std::unique_ptr<runnable::Runner> m_runner{nullptr};
@@ -47,9 +47,13 @@ class Manifold : public Interface
   private:
     void add_input(const SegmentAddress& address, node::SourcePropertiesBase* input_source) final;
     void add_output(const SegmentAddress& address, node::SinkPropertiesBase* output_sink) final;
+    void drop_output(const SegmentAddress& address) final;
+    void set_output_local(const SegmentAddress& address, bool local) final;
 
     virtual void do_add_input(const SegmentAddress& address, node::SourcePropertiesBase* input_source) = 0;
     virtual void do_add_output(const SegmentAddress& address, node::SinkPropertiesBase* output_sink)   = 0;
+    virtual void do_drop_output(const SegmentAddress& address)                                         = 0;
+    virtual void do_set_output_local(const SegmentAddress& address, bool local)                        = 0;
 
     PortName m_port_name;
     pipeline::Resources& m_resources;
@@ -0,0 +1,148 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2021-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "mrc/memory/buffer_view.hpp"
+#include "mrc/memory/memory_kind.hpp"
+
+#include <glog/logging.h>
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace mrc::memory {
+
+namespace detail {
+
+template <typename ViewT>
+class iovec_view_base  // NOLINT
+{
+  public:
+    iovec_view_base() = default;
+
+    iovec_view_base(std::vector<ViewT> segments)
+    {
+        m_segments.reserve(segments.size());
+        for (auto& segment : segments)
+        {
+            append(std::move(segment));
+        }
+    }
+
+    /**
+     * @brief Append a region to the end of the scatter/gather list; empty regions are skipped
+     *
+     * All regions of a view must be of the same memory_kind, so the view can be transferred as a single operation.
+     *
+     * @param segment
+     */
+    void append(ViewT segment)
+    {
+        if (segment.empty())
+        {
+            return;
+        }
+        CHECK(m_segments.empty() || segment.kind() == m_kind)
+            << "all segments of an iovec_view must share a memory_kind";
+        m_kind = segment.kind();
+        m_bytes += segment.bytes();
+        m_segments.push_back(std::move(segment));
+    }
+
+    /**
+     * @brief Regions described by the view, in order
+     */
+    const std::vector<ViewT>& segments() const
+    {
+        return m_segments;
+    }
+
+    /**
+     * @brief Number of regions
+     */
+    std::size_t size() const
+    {
+        return m_segments.size();
+    }
+
+    /**
+     * @brief Total number of bytes across all regions
+     */
+    std::size_t bytes() const
+    {
+        return m_bytes;
+    }
+
+    /**
+     * @brief Type of memory shared by all regions; memory_kind::none if the view is empty
+     */
+    memory_kind kind() const
+    {
+        return m_kind;
+    }
+
+    bool empty() const
+    {
+        return m_segments.empty();
+    }
+
+  private:
+    std::vector<ViewT> m_segments;
+    std::size_t m_bytes{0UL};
+    memory_kind m_kind{memory_kind::none};
+};
+
+}  // namespace detail
+
+/**
+ * @brief Scatter/gather list of const memory regions of a single memory_kind
+ *
+ * Describes an object made of multiple non-contiguous parts, e.g. the columns of a dataframe, so the parts can be
+ * transferred as a single iov operation or gathered into a single descriptor instead of one transfer per part.
+ *
+ * const_iovec_view is copyable and does not own the described memory.
+ */
+class const_iovec_view : public detail::iovec_view_base<const_buffer_view>  // NOLINT
+{
+  public:
+    using detail::iovec_view_base<const_buffer_view>::iovec_view_base;
+};
+
+/**
+ * @brief Scatter/gather list of mutable memory regions of a single memory_kind
+ *
+ * iovec_view is copyable and does not own the described memory.
+ */
+class iovec_view : public detail::iovec_view_base<buffer_view>  // NOLINT
+{
+  public:
+    using detail::iovec_view_base<buffer_view>::iovec_view_base;
+
+    operator const_iovec_view() const
+    {
+        const_iovec_view view;
+        for (const auto& segment : segments())
+        {
+            view.append(segment);
+        }
+        return view;
+    }
+};
+
+}  // namespace mrc::memory
@@ -0,0 +1,142 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2021-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "mrc/memory/memory_kind.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace mrc::metrics {
+class Registry;
+}
+
+namespace mrc::memory {
+
+/**
+ * @brief Memory held by the runnables of a segment node for one memory_kind
+ *
+ * Allocations made outside of a runnable, e.g. during pipeline construction, are attributed to an empty segment and
+ * node name.
+ */
+struct MemoryUsage
+{
+    std::string segment;
+    std::string node;
+    memory_kind kind;
+    std::size_t live_bytes{0};
+    std::size_t peak_bytes{0};
+    std::uint64_t allocations{0};
+    std::uint64_t allocated_bytes{0};
+};
+
+/**
+ * @brief Attributes the allocations of tracking_resource adaptors to the runnable performing them.
+ *
+ * The owner of an allocation is the name of the runnable::Context of the calling fiber; the segment is the part of the
+ * name preceding the first '/'. Deallocations are credited to the owner of the allocation regardless of the fiber
+ * releasing the memory, so memory handed downstream is accounted to the node which allocated it until it is freed.
+ *
+ * Accounts are never destroyed and are updated with relaxed atomics; the owner of the calling fiber is cached per
+ * fiber, so an allocation costs a lock of one of several pointer-sharded maps to remember its owner.
+ *
+ * The live bytes of all accounts of a segment may be bounded by a quota, checked by reserve before the allocation is
+ * made.
+ */
+class MemoryTracker
+{
+  public:
+    // live bytes of all accounts of a segment and their bound; instances are never destroyed
+    struct SegmentQuota
+    {
+        std::atomic<std::int64_t> live_bytes{0};
+        // 0 is unbounded
+        std::atomic<std::int64_t> limit_bytes{0};
+    };
+
+    // live, lock-free totals of an owner and memory_kind; instances are never destroyed
+    struct Account
+    {
+        Account(std::string segment_name, std::string node_name, memory_kind memory_kind) :
+          segment(std::move(segment_name)),
+          node(std::move(node_name)),
+          kind(memory_kind)
+        {}
+
+        const std::string segment;
+        const std::string node;
+        const memory_kind kind;
+        // null for allocations made outside of a segment
+        SegmentQuota* quota{nullptr};
+        std::atomic<std::int64_t> live_bytes{0};
+        std::atomic<std::int64_t> peak_bytes{0};
+        std::atomic<std::uint64_t> allocations{0};
+        std::atomic<std::uint64_t> allocated_bytes{0};
+
+        // values reported by the last call to export_metrics
+        std::uint64_t exported_allocations{0};
+        std::uint64_t exported_allocated_bytes{0};
+    };
+
+    /**
+     * @brief Reserve bytes against the quota of the segment of the calling fiber before allocating them; throws
+     * std::bad_alloc if the quota would be exceeded. The reservation is released when the memory is deallocated, or by
+     * cancel_reservation if the allocation failed.
+     */
+    static void reserve(std::size_t bytes, memory_kind kind);
+    static void cancel_reservation(std::size_t bytes, memory_kind kind);
+
+    /**
+     * @brief Bound the live bytes of all nodes of a segment across memory kinds; 0 removes the bound. Memory already
+     * held above a lowered quota is not reclaimed, further allocations fail until usage drops below it.
+     */
+    static void set_segment_quota(const std::string& segment, std::size_t bytes);
+
+    /**
+     * @brief Account an allocation of bytes at ptr to the runnable of the calling fiber
+     */
+    static void on_allocate(void* ptr, std::size_t bytes, memory_kind kind);
+
+    /**
+     * @brief Credit the account which allocated ptr; pointers not allocated through a tracking_resource are ignored
+     */
+    static void on_deallocate(void* ptr, std::size_t bytes);
+
+    /**
+     * @brief Usage of every owner and memory_kind which allocated memory
+     */
+    static std::vector<MemoryUsage> collect();
+
+    /**
+     * @brief Set the mrc_memory_{live,peak}_bytes gauges and increment the mrc_memory_allocations and
+     * mrc_memory_allocated_bytes counters of the registry by the amounts accumulated since the previous export; all
+     * labeled by segment, node and kind. Allocation rates are the rates of the counters.
+     */
+    static void export_metrics(metrics::Registry& registry);
+
+    /**
+     * @brief Reset the peak of every account to its live bytes.
+     */
+    static void reset_peaks();
+};
+
+}  // namespace mrc::memory
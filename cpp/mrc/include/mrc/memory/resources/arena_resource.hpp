@@ -18,6 +18,7 @@
 
 #include "mrc/memory/adaptors.hpp"
 #include "mrc/memory/resources/detail/arena.hpp"
+#include "mrc/memory/resources/stream_ordered_resource.hpp"
 #include "mrc/utils/bytes_to_string.hpp"
 
 #include <cuda_runtime_api.h>
@@ -28,8 +29,11 @@
 #include <spdlog/fmt/bundled/ostream.h>
 
 #include <cstddef>
+#include <cstdint>
 #include <map>
-#include <shared_mutex>
+#include <memory>
+#include <mutex>
+#include <thread>
 
 namespace mrc::memory {
 
@@ -42,9 +46,17 @@ namespace mrc::memory {
  * Allocation (do_allocate()) and deallocation (do_deallocate()) are thread-safe. Also,
  * this class is compatible with CUDA per-thread default stream.
  *
- * GPU memory is divided into a global arena, per-thread arenas for default streams, and per-stream
- * arenas for non-default streams. Each arena allocates memory from the global arena in chunks
- * called superblocks.
+ * Memory is divided into a global arena and per-thread arenas. Each arena allocates memory from the
+ * global arena in chunks called superblocks.
+ *
+ * Allocations fall into three size classes:
+ * - small allocations, up to 4 KiB, are served from a per-thread cache of free blocks of the same
+ *   size, which is refilled from and drained to the thread's arena in batches;
+ * - medium allocations are served from the thread's arena;
+ * - large allocations, of at least a superblock, are served directly from the global arena.
+ *
+ * Finding the cache of the calling thread is lock-free; the resource lock is only taken the first
+ * time a thread uses the resource and to defragment when an allocation cannot be served.
  *
  * Blocks in each arena are allocated using address-ordered first fit. When a block is freed, it is
  * coalesced with neighbouring free blocks if the addresses are contiguous. Free superblocks are
@@ -55,10 +67,19 @@ namespace mrc::memory {
  * per-thread arena, adequate performance can be achieved without introducing excessive memory
  * fragmentation under high concurrency.
  *
+ * Device memory can also be allocated in stream order through the stream_ordered_resource
+ * interface. Such allocations are served from per-stream arenas, so memory freed on a stream is
+ * reused by later allocations on the same stream without synchronization. Superblocks leaving a
+ * stream arena, and large blocks freed on a stream, are guarded by an event recorded on that
+ * stream. Another stream reuses them once the event has completed, or by waiting on the event
+ * rather than growing the global arena; the host only synchronizes with the streams when the
+ * arenas are exhausted.
+ *
  * This design is inspired by several existing CPU memory allocators targeting multi-threaded
- * applications (glibc malloc, Hoard, jemalloc, TCMalloc), albeit in a simpler form. Possible future
- * improvements include using size classes, allocation caches, and more fine-grained locking or
- * lock-free approaches.
+ * applications (glibc malloc, Hoard, jemalloc, TCMalloc), albeit in a simpler form.
+ *
+ * Host memory is served by one arena_resource per host partition (see HostResources), whose
+ * threads are bound to the partition's NUMA nodes.
  *
  * \see Wilson, P. R., Johnstone, M. S., Neely, M., & Boles, D. (1995, September). Dynamic storage
  * allocation: A survey and critical review. In International Workshop on Memory Management (pp.
@@ -76,14 +97,16 @@ namespace mrc::memory {
  * rmm::mr::device_memory_resource interface.
  */
 template <typename Upstream>
-class arena_resource final : public adaptor<Upstream>
+class arena_resource final : public adaptor<Upstream>, public stream_ordered_resource
 {
     using pointer_type = typename adaptor<Upstream>::pointer_type;
 
     using global_arena = detail::arena::global_arena<pointer_type>;
     using arena        = detail::arena::arena<pointer_type>;
-    using read_lock    = std::shared_lock<std::shared_timed_mutex>;
-    using write_lock   = std::lock_guard<std::shared_timed_mutex>;
+    using thread_cache = detail::arena::thread_cache<pointer_type>;
+    using stream_arena = detail::arena::stream_arena<pointer_type>;
+    using release_list = detail::arena::stream_release_list<pointer_type>;
+    using write_lock   = std::lock_guard<std::mutex>;
 
   public:
     /**
@@ -107,6 +130,7 @@ class arena_resource final : public adaptor<Upstream>
                             bool dump_log_on_failure = false) :
       adaptor<Upstream>(std::move(upstream_mr)),
       global_arena_(std::make_shared<global_arena>(&this->resource(), initial_size, maximum_size)),
+      release_list_(std::make_shared<release_list>(global_arena_)),
       dump_log_on_failure_(dump_log_on_failure)
     {
         if (dump_log_on_failure_)
@@ -143,14 +167,18 @@ class arena_resource final : public adaptor<Upstream>
         }
 
         bytes         = detail::arena::align_up(bytes);
-        auto& arena   = get_thread_arena();
-        void* pointer = arena.allocate(bytes);
+        auto* cache   = get_thread_cache();
+        void* pointer = allocate_from(cache, bytes);
 
         if (pointer == nullptr)
         {
             write_lock lock(mtx_);
+            if (cache != nullptr)
+            {
+                cache->flush();
+            }
             defragment();
-            pointer = arena.allocate(bytes);
+            pointer = allocate_from(cache, bytes);
             if (pointer == nullptr)
             {
                 if (dump_log_on_failure_)
@@ -180,90 +208,183 @@ class arena_resource final : public adaptor<Upstream>
             return;
         }
 
-        bytes = detail::arena::align_up(bytes);
-        get_thread_arena().deallocate(ptr, bytes);
+        bytes       = detail::arena::align_up(bytes);
+        auto* cache = get_thread_cache();
+        if (cache == nullptr || bytes >= detail::arena::minimum_superblock_size)
+        {
+            global_arena_->deallocate({ptr, bytes});
+        }
+        else if (bytes <= detail::arena::maximum_small_size)
+        {
+            cache->deallocate(ptr, bytes);
+        }
+        else
+        {
+            cache->get_arena().deallocate(ptr, bytes);
+        }
     }
 
     /**
-     * @brief Defragment memory by returning all free blocks to the global arena.
+     * @brief Allocates memory of size at least `bytes` for use by work enqueued on `stream`.
+     *
+     * @param bytes The size in bytes of the allocation.
+     * @param stream The stream to associate this allocation with.
+     * @return void* Pointer to the newly allocated memory.
      */
-    void defragment()
+    void* do_allocate_async(std::size_t bytes, cudaStream_t stream) final
     {
-        // RMM_CUDA_TRY(cudaDeviceSynchronize());
-        for (auto& thread_arena : thread_arenas_)
+        if (bytes <= 0)
         {
-            thread_arena.second->clean();
+            return nullptr;
         }
-        /*
-        for (auto& stream_arena : stream_arenas_)
+
+        bytes           = detail::arena::align_up(bytes);
+        auto* arena_ptr = (bytes < detail::arena::minimum_superblock_size ? &get_stream_arena(stream) : nullptr);
+        void* pointer   = allocate_async_from(arena_ptr, bytes, stream);
+
+        if (pointer == nullptr)
         {
-            stream_arena.second.clean();
+            write_lock lock(mtx_);
+            defragment();
+            pointer = allocate_async_from(arena_ptr, bytes, stream);
+            if (pointer == nullptr)
+            {
+                if (dump_log_on_failure_)
+                {
+                    dump_memory_log(bytes);
+                }
+                LOG(FATAL) << "Maximum pool size exceeded";
+            }
+        }
+
+        return pointer;
+    }
+
+    /**
+     * @brief Deallocate memory pointed to by `ptr` once the work enqueued on `stream` has passed it.
+     *
+     * @param ptr Pointer to be deallocated.
+     * @param bytes The size in bytes of the allocation. This must be equal to the
+     * value of `bytes` that was passed to the `allocate_async` call that returned `p`.
+     * @param stream Stream on which the memory was last used.
+     */
+    void do_deallocate_async(void* ptr, std::size_t bytes, cudaStream_t stream) final
+    {
+        if (ptr == nullptr || bytes <= 0)
+        {
+            return;
+        }
+
+        bytes = detail::arena::align_up(bytes);
+        if (bytes >= detail::arena::minimum_superblock_size)
+        {
+            release_list_->release({ptr, bytes}, stream);
+        }
+        else
+        {
+            get_stream_arena(stream).deallocate(ptr, bytes);
         }
-        */
     }
 
     /**
-     * @brief Get the arena associated with the current thread or the given stream.
+     * @brief Allocate from the cache, arena or global arena by the size class of `bytes`.
      *
-     * @param stream The stream associated with the arena.
-     * @return arena& The arena associated with the current thread or the given stream.
-    arena& get_arena(cuda_stream_view stream)
+     * @param cache The cache of the calling thread, or nullptr to allocate from the global arena.
+     * @return void* Pointer to the newly allocated memory, or nullptr if the arenas are exhausted.
+     */
+    void* allocate_from(thread_cache* cache, std::size_t bytes)
     {
-        if (use_per_thread_arena(stream))
+        if (cache == nullptr || bytes >= detail::arena::minimum_superblock_size)
         {
-            return get_thread_arena();
+            return global_arena_->allocate(bytes).pointer();
         }
-        return get_stream_arena(stream);
+        if (bytes <= detail::arena::maximum_small_size)
+        {
+            return cache->allocate(bytes);
+        }
+        return cache->get_arena().allocate(bytes);
     }
+
+    /**
+     * @brief Allocate from the arena of a stream, or for large allocations from the released blocks.
+     *
+     * @param arena_ptr The arena of the stream, or nullptr for large allocations.
+     * @return void* Pointer to the newly allocated memory, or nullptr if the arenas are exhausted.
      */
+    void* allocate_async_from(stream_arena* arena_ptr, std::size_t bytes, cudaStream_t stream)
+    {
+        if (arena_ptr == nullptr)
+        {
+            return release_list_->get_block(bytes, stream).pointer();
+        }
+        return arena_ptr->allocate(bytes);
+    }
 
     /**
-     * @brief Get the arena associated with the current thread.
+     * @brief Defragment memory by returning all free blocks to the global arena.
      *
-     * @return arena& The arena associated with the current thread.
+     * Blocks released on streams are only returned once their streams have passed them, so this is
+     * where stream-ordered allocations synchronize with the host.
      */
-    arena& get_thread_arena()
+    void defragment()
     {
-        auto const thread_id = std::this_thread::get_id();
+        for (auto& thread_arena : thread_arenas_)
         {
-            read_lock lock(mtx_);
-            auto const iter = thread_arenas_.find(thread_id);
-            if (iter != thread_arenas_.end())
-            {
-                return *iter->second;
-            }
+            thread_arena.second->clean();
         }
+        for (auto& arena_of_stream : stream_arenas_)
         {
-            write_lock lock(mtx_);
-            auto thread_arena = std::make_shared<arena>(global_arena_);
-            thread_arenas_.emplace(thread_id, thread_arena);
-            thread_local detail::arena::arena_cleaner<pointer_type> cleaner{thread_arena};
-            return *thread_arena;
+            arena_of_stream.second->clean();
         }
+        release_list_->synchronize();
     }
 
     /**
-     * @brief Get the arena associated with the given stream.
+     * @brief Get the cache, and through it the arena, associated with the current thread.
      *
-     * @return arena& The arena associated with the given stream.
-    arena& get_stream_arena(cuda_stream_view stream)
+     * @return thread_cache* The cache associated with the current thread, or nullptr if the thread's
+     * caches have already been destroyed by its termination.
+     */
+    thread_cache* get_thread_cache()
     {
-        RMM_LOGGING_ASSERT(!use_per_thread_arena(stream));
+        // trivially destructible, so it remains valid while other thread_local destructors free memory at thread exit
+        thread_local bool registry_destroyed{false};
+        if (registry_destroyed)
         {
-            read_lock lock(mtx_);
-            auto const iter = stream_arenas_.find(stream.value());
-            if (iter != stream_arenas_.end())
-            {
-                return iter->second;
-            }
+            return nullptr;
         }
+        thread_local detail::arena::thread_cache_registry<pointer_type> registry{registry_destroyed};
+
+        auto* cache = registry.find(id_);
+        if (cache != nullptr)
+        {
+            return cache;
+        }
+
+        auto thread_arena = std::make_shared<arena>(global_arena_);
         {
             write_lock lock(mtx_);
-            stream_arenas_.emplace(stream.value(), global_arena_);
-            return stream_arenas_.at(stream.value());
+            // replaces the arena of a terminated thread with the same id, which was cleaned when it terminated
+            thread_arenas_[std::this_thread::get_id()] = thread_arena;
         }
+        return &registry.emplace(id_, thread_arena);
     }
+
+    /**
+     * @brief Get the arena associated with the given stream.
+     *
+     * @return stream_arena& The arena associated with the given stream.
      */
+    stream_arena& get_stream_arena(cudaStream_t stream)
+    {
+        write_lock lock(mtx_);
+        auto& arena = stream_arenas_[stream];
+        if (!arena)
+        {
+            arena = std::make_shared<stream_arena>(stream, release_list_);
+        }
+        return *arena;
+    }
 
     /**
      * Dump memory to log.
@@ -296,31 +417,24 @@ class arena_resource final : public adaptor<Upstream>
         */
     }
 
-    /**
-     * @brief Should a per-thread arena be used given the CUDA stream.
-     *
-     * @param stream to check.
-     * @return true if per-thread arena should be used, false otherwise.
-    static bool use_per_thread_arena(cuda_stream_view stream)
-    {
-        return stream.is_per_thread_default();
-    }
-     */
-
+    /// Unique id of this resource, identifying its thread caches.
+    std::uint64_t const id_{detail::arena::next_resource_id()};  // NOLINT
     /// The global arena to allocate superblocks from.
     std::shared_ptr<global_arena> global_arena_;  // NOLINT
-    /// Arenas for default streams, one per thread.
+    /// Arenas owned by this resource, one per thread.
     /// Implementation note: for small sizes, map is more efficient than unordered_map.
     std::map<std::thread::id, std::shared_ptr<arena>> thread_arenas_;  // NOLINT
-    /// Arenas for non-default streams, one per stream.
+    /// Blocks released on streams, reused by other streams once their stream has passed them.
+    std::shared_ptr<release_list> release_list_;  // NOLINT
+    /// Arenas for stream-ordered allocations, one per stream.
     /// Implementation note: for small sizes, map is more efficient than unordered_map.
-    // std::map<cudaStream_t, arena> stream_arenas_;
+    std::map<cudaStream_t, std::shared_ptr<stream_arena>> stream_arenas_;  // NOLINT
     /// If true, dump memory information to log on allocation failure.
     bool dump_log_on_failure_;  // NOLINT
     /// The logger for memory dump.
     std::shared_ptr<spdlog::logger> logger_{};  // NOLINT
-    /// Mutex for read and write locks.
-    mutable std::shared_timed_mutex mtx_;  // NOLINT
+    /// Mutex guarding the per-thread and per-stream arenas.
+    mutable std::mutex mtx_;  // NOLINT
 };
 
 // NOLINTEND(readability-identifier-naming)
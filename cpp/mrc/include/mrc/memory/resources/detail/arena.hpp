@@ -26,18 +26,29 @@
 #include <spdlog/fmt/bundled/ostream.h>
 
 #include <algorithm>
+#include <array>
+#include <atomic>
 #include <cstddef>
+#include <cstdint>
 #include <limits>
 #include <memory>
 #include <mutex>
 #include <numeric>
 #include <set>
 #include <unordered_map>
+#include <utility>
+#include <vector>
 
 namespace mrc::memory::detail::arena {
 /// Minimum size of a superblock (256 KiB).
 constexpr std::size_t minimum_superblock_size = 1U << 18U;  // NOLINT
 
+/// Maximum size of a small allocation (4 KiB); small allocations are served from per-thread caches.
+constexpr std::size_t maximum_small_size = 1U << 12U;  // NOLINT
+
+/// Number of small size classes; each holds blocks of one multiple of the allocation alignment.
+constexpr std::size_t small_size_class_count = maximum_small_size / rmm::detail::CUDA_ALLOCATION_ALIGNMENT;  // NOLINT
+
 /**
  * @brief Represents a chunk of memory that can be allocated and deallocated.
  *
@@ -374,6 +385,18 @@ class global_arena final
         return get_block(bytes);
     }
 
+    /**
+     * @brief Allocates a block of at least `bytes` from the free blocks only, without growing the arena.
+     *
+     * @param bytes The size in bytes of the allocation.
+     * @return block A block of at least `bytes` bytes, or an invalid block if no free block fits.
+     */
+    block allocate_free(std::size_t bytes)
+    {
+        lock_guard lock(mtx_);
+        return first_fit(free_blocks_, bytes);
+    }
+
     /**
      * @brief Deallocate memory pointed to by `blk`.
      *
@@ -554,6 +577,52 @@ class arena
         shrink_arena(merged);
     }
 
+    /**
+     * @brief Allocates up to `count` blocks of `bytes` each under a single lock.
+     *
+     * The blocks are carved from one contiguous block when possible, so they coalesce again as they are freed.
+     *
+     * @param bytes The size in bytes of each block; no larger than `maximum_small_size`.
+     * @param pointers Output array of at least `count` pointers.
+     * @param count The number of blocks requested.
+     * @return std::size_t The number of blocks allocated.
+     */
+    std::size_t allocate(std::size_t bytes, void** pointers, std::size_t count)
+    {
+        lock_guard lock(mtx_);
+        auto blk = get_block(bytes * count);
+        if (!blk.is_valid())
+        {
+            blk   = get_block(bytes);
+            count = blk.is_valid() ? 1 : 0;
+        }
+
+        auto* pointer = static_cast<char*>(blk.pointer());
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+            pointers[i] = pointer + i * bytes;
+        }
+        return count;
+    }
+
+    /**
+     * @brief Deallocate `count` blocks of `bytes` each under a single lock.
+     *
+     * @param pointers The blocks to deallocate.
+     * @param count The number of blocks.
+     * @param bytes The size in bytes of each block.
+     */
+    void deallocate(void* const* pointers, std::size_t count, std::size_t bytes)
+    {
+        lock_guard lock(mtx_);
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            auto const merged = coalesce_block(free_blocks_, block{pointers[i], bytes});
+            shrink_arena(merged);
+        }
+    }
+
     /**
      * @brief Clean the arena and deallocate free blocks from the global arena.
      */
@@ -649,37 +718,452 @@ class arena
 };
 
 /**
- * @brief RAII-style cleaner for an arena.
+ * @brief Blocks released on CUDA streams which may still be in use by work enqueued on those streams.
+ *
+ * Each released block is guarded by an event recorded on the releasing stream. A block is returned to the global arena
+ * once its event has completed. Until then the releasing stream reuses it without any synchronization, since work on a
+ * stream runs in order, and another stream may adopt it by waiting on the event, which orders the reuse
+ * after the prior work on the device without blocking the host. Adoption creates a dependency between the streams, so
+ * free blocks of the global arena are preferred, and only growing the global arena is avoided by adopting.
+ *
+ * @tparam Upstream Memory resource to use for allocating the global arena.
+ */
+template <typename Upstream>
+class stream_release_list
+{
+  public:
+    explicit stream_release_list(std::shared_ptr<global_arena<Upstream>> global_arena) :
+      global_arena_{std::move(global_arena)}
+    {}
+
+    ~stream_release_list()
+    {
+        synchronize();
+        for (auto* event : events_)
+        {
+            RMM_CUDA_TRY(cudaEventDestroy(event));
+        }
+    }
+
+    stream_release_list(stream_release_list const&) = delete;
+    stream_release_list& operator=(stream_release_list const&) = delete;
+    stream_release_list(stream_release_list&&) noexcept        = delete;
+    stream_release_list& operator=(stream_release_list&&) noexcept = delete;
+
+    /**
+     * @brief Release a block which may be in use by the work enqueued on `stream` so far.
+     */
+    void release(block const& blk, cudaStream_t stream)
+    {
+        lock_guard lock(mtx_);
+        auto* event = get_event();
+        RMM_CUDA_TRY(cudaEventRecord(event, stream));
+        released_.push_back({blk, event, stream});
+    }
+
+    /**
+     * @brief Get a block of at least `size` bytes which `stream` may use for work enqueued after this call.
+     *
+     * @return block The block, or an invalid block if the global arena is exhausted.
+     */
+    block get_block(std::size_t size, cudaStream_t stream)
+    {
+        lock_guard lock(mtx_);
+        collect();
+
+        // blocks still pending on the same stream are reused in stream order
+        auto iter = best_fit(size, [stream](auto const& released) { return released.stream == stream; });
+        if (iter != released_.end())
+        {
+            return take(iter, size);
+        }
+
+        auto blk = global_arena_->allocate_free(size);
+        if (blk.is_valid())
+        {
+            return blk;
+        }
+
+        // adopt a block of another stream rather than growing the global arena
+        iter = best_fit(size, [](auto const& /*released*/) { return true; });
+        if (iter != released_.end())
+        {
+            RMM_CUDA_TRY(cudaStreamWaitEvent(stream, iter->event, 0));
+            return take(iter, size);
+        }
+
+        return global_arena_->allocate(size);
+    }
+
+    /**
+     * @brief Wait for all released blocks to be no longer in use and return them to the global arena.
+     */
+    void synchronize()
+    {
+        lock_guard lock(mtx_);
+        for (auto const& released : released_)
+        {
+            RMM_CUDA_TRY(cudaEventSynchronize(released.event));
+            global_arena_->deallocate(released.blk);
+            events_.push_back(released.event);
+        }
+        released_.clear();
+    }
+
+  private:
+    using lock_guard = std::lock_guard<std::mutex>;
+
+    struct released_block
+    {
+        block blk;
+        cudaEvent_t event;
+        cudaStream_t stream;
+    };
+
+    /// Find the smallest released block of at least `size` bytes matching `pred`.
+    template <typename PredicateT>
+    typename std::vector<released_block>::iterator best_fit(std::size_t size, PredicateT pred)
+    {
+        auto iter = released_.end();
+        for (auto it = released_.begin(); it != released_.end(); ++it)
+        {
+            if (pred(*it) && it->blk.fits(size) && (iter == released_.end() || it->blk.size() < iter->blk.size()))
+            {
+                iter = it;
+            }
+        }
+        return iter;
+    }
+
+    /// Take `size` bytes from a released block; the remainder stays guarded by the same event.
+    block take(typename std::vector<released_block>::iterator iter, std::size_t size)
+    {
+        auto const split = iter->blk.split(size);
+        if (split.second.is_valid())
+        {
+            iter->blk = split.second;
+        }
+        else
+        {
+            events_.push_back(iter->event);
+            released_.erase(iter);
+        }
+        return split.first;
+    }
+
+    /// Return the blocks whose events have completed to the global arena.
+    void collect()
+    {
+        auto const first_pending = std::partition(released_.begin(), released_.end(), [](auto const& released) {
+            return cudaEventQuery(released.event) == cudaSuccess;
+        });
+        for (auto it = released_.begin(); it != first_pending; ++it)
+        {
+            global_arena_->deallocate(it->blk);
+            events_.push_back(it->event);
+        }
+        released_.erase(released_.begin(), first_pending);
+    }
+
+    cudaEvent_t get_event()
+    {
+        if (events_.empty())
+        {
+            cudaEvent_t event{};
+            RMM_CUDA_TRY(cudaEventCreateWithFlags(&event, cudaEventDisableTiming));
+            return event;
+        }
+        auto* event = events_.back();
+        events_.pop_back();
+        return event;
+    }
+
+    /// The global arena to return blocks to.
+    std::shared_ptr<global_arena<Upstream>> global_arena_;  // NOLINT
+    /// Blocks which may still be in use by their releasing stream.
+    std::vector<released_block> released_;  // NOLINT
+    /// Events which are not recorded, for reuse.
+    std::vector<cudaEvent_t> events_;  // NOLINT
+    /// Mutex for exclusive lock.
+    mutable std::mutex mtx_;  // NOLINT
+};
+
+/**
+ * @brief An arena for stream-ordered allocations on a CUDA stream.
+ *
+ * Blocks freed on the stream are reused by later allocations on the same stream without synchronization, since work
+ * enqueued on a stream runs in order. Superblocks are obtained from, and returned to, the global arena through the
+ * stream_release_list so that a superblock leaving the arena is not reused by another stream before the work of this
+ * stream on it has completed.
+ *
+ * @tparam Upstream Memory resource to use for allocating the global arena.
+ */
+template <typename Upstream>
+class stream_arena
+{
+  public:
+    stream_arena(cudaStream_t stream, std::shared_ptr<stream_release_list<Upstream>> release_list) :
+      stream_{stream},
+      release_list_{std::move(release_list)}
+    {}
+
+    ~stream_arena() = default;
+
+    stream_arena(stream_arena const&) = delete;
+    stream_arena& operator=(stream_arena const&) = delete;
+    stream_arena(stream_arena&&) noexcept        = delete;
+    stream_arena& operator=(stream_arena&&) noexcept = delete;
+
+    void* allocate(std::size_t bytes)
+    {
+        lock_guard lock(mtx_);
+        auto blk = first_fit(free_blocks_, bytes);
+        if (!blk.is_valid())
+        {
+            auto const superblock = release_list_->get_block(std::max(bytes, minimum_superblock_size), stream_);
+            if (!superblock.is_valid())
+            {
+                return nullptr;
+            }
+            coalesce_block(free_blocks_, superblock);
+            blk = first_fit(free_blocks_, bytes);
+        }
+        return blk.pointer();
+    }
+
+    void deallocate(void* ptr, std::size_t bytes)
+    {
+        lock_guard lock(mtx_);
+        auto const merged = coalesce_block(free_blocks_, block{ptr, bytes});
+        if (merged.is_superblock() || free_blocks_.size() > max_free_blocks)
+        {
+            free_blocks_.erase(merged);
+            release_list_->release(merged, stream_);
+        }
+    }
+
+    /**
+     * @brief Release all free blocks of the arena.
+     */
+    void clean()
+    {
+        lock_guard lock(mtx_);
+        for (auto const& blk : free_blocks_)
+        {
+            release_list_->release(blk, stream_);
+        }
+        free_blocks_.clear();
+    }
+
+  private:
+    using lock_guard = std::lock_guard<std::mutex>;
+    /// Maximum number of free blocks to keep.
+    static constexpr int max_free_blocks = 16;  // NOLINT
+
+    /// The stream whose allocations are served by this arena.
+    cudaStream_t stream_;  // NOLINT
+    /// The release list to obtain superblocks from and return them to.
+    std::shared_ptr<stream_release_list<Upstream>> release_list_;  // NOLINT
+    /// Free blocks.
+    std::set<block> free_blocks_;  // NOLINT
+    /// Mutex for exclusive lock.
+    mutable std::mutex mtx_;  // NOLINT
+};
+
+/**
+ * @brief Per-thread cache of small blocks for an arena.
+ *
+ * Each small size class is a stack of free blocks of the same size, accessed only by the owning thread and so without
+ * locks. A size class is refilled from, and drained to, the thread's arena in batches of `batch_size` blocks to
+ * amortize the arena lock. The cache only holds pointers, so it works for memory which is not host accessible.
  *
- * This is useful when a thread is about to terminate, and it contains a per-thread arena.
+ * When the thread terminates, the cached blocks are returned to the arena and the arena is cleaned.
  *
  * @tparam Upstream Memory resource to use for allocating the global arena. Implements
  * rmm::mr::device_memory_resource interface.
  */
 template <typename Upstream>
-class arena_cleaner
+class thread_cache
 {
   public:
-    explicit arena_cleaner(std::shared_ptr<arena<Upstream>> const& arena) : arena_(arena) {}
+    /// Maximum number of blocks cached in each size class.
+    static constexpr std::size_t max_cached_blocks = 64;  // NOLINT
+    /// Number of blocks moved between the cache and the arena when a size class is empty or full.
+    static constexpr std::size_t batch_size = max_cached_blocks / 2;  // NOLINT
+
+    explicit thread_cache(std::shared_ptr<arena<Upstream>> const& arena) : arena_(arena.get()), owner_(arena) {}
 
     // Disable copy (and move) semantics.
-    arena_cleaner(arena_cleaner const&) = delete;
-    arena_cleaner& operator=(arena_cleaner const&) = delete;
-    arena_cleaner(arena_cleaner&&) noexcept        = delete;
-    arena_cleaner& operator=(arena_cleaner&&) = delete;
+    thread_cache(thread_cache const&) = delete;
+    thread_cache& operator=(thread_cache const&) = delete;
+    thread_cache(thread_cache&&) noexcept        = delete;
+    thread_cache& operator=(thread_cache&&) = delete;
 
-    ~arena_cleaner()
+    ~thread_cache()
     {
-        if (!arena_.expired())
+        if (auto arena_ptr = owner_.lock())
         {
-            auto arena_ptr = arena_.lock();
+            flush();
             arena_ptr->clean();
         }
     }
 
+    /// Returns the arena of the thread.
+    arena<Upstream>& get_arena()
+    {
+        return *arena_;
+    }
+
+    /// Returns true if the resource owning the arena has been destroyed.
+    [[nodiscard]] bool is_expired() const
+    {
+        return owner_.expired();
+    }
+
+    /**
+     * @brief Allocates a small block, refilling its size class from the arena if it is empty.
+     *
+     * @param bytes The aligned size in bytes of the block; no larger than `maximum_small_size`.
+     * @return void* Pointer to the block, or nullptr if the arena is exhausted.
+     */
+    void* allocate(std::size_t bytes)
+    {
+        auto& cls = classes_[class_index(bytes)];
+        if (cls.count == 0)
+        {
+            cls.count = arena_->allocate(bytes, cls.blocks.data(), batch_size);
+            if (cls.count == 0)
+            {
+                return nullptr;
+            }
+        }
+        return cls.blocks[--cls.count];
+    }
+
+    /**
+     * @brief Caches a small block, draining the oldest blocks of its size class to the arena if it is full.
+     *
+     * @param ptr Pointer to the block.
+     * @param bytes The aligned size in bytes of the block; no larger than `maximum_small_size`.
+     */
+    void deallocate(void* ptr, std::size_t bytes)
+    {
+        auto& cls = classes_[class_index(bytes)];
+        if (cls.count == max_cached_blocks)
+        {
+            arena_->deallocate(cls.blocks.data(), batch_size, bytes);
+            std::move(cls.blocks.begin() + batch_size, cls.blocks.end(), cls.blocks.begin());
+            cls.count -= batch_size;
+        }
+        cls.blocks[cls.count++] = ptr;
+    }
+
+    /**
+     * @brief Return all cached blocks to the arena.
+     */
+    void flush()
+    {
+        for (std::size_t idx = 0; idx < small_size_class_count; ++idx)
+        {
+            auto& cls = classes_[idx];
+            arena_->deallocate(cls.blocks.data(), cls.count, (idx + 1) * rmm::detail::CUDA_ALLOCATION_ALIGNMENT);
+            cls.count = 0;
+        }
+    }
+
   private:
-    /// A non-owning pointer to the arena that may need cleaning.
-    std::weak_ptr<arena<Upstream>> arena_;  // NOLINT
+    struct size_class
+    {
+        std::array<void*, max_cached_blocks> blocks{};  // NOLINT
+        std::size_t count{0};                           // NOLINT
+    };
+
+    static constexpr std::size_t class_index(std::size_t bytes)
+    {
+        return bytes / rmm::detail::CUDA_ALLOCATION_ALIGNMENT - 1;
+    }
+
+    /// The arena of the thread; valid while the owning resource is alive.
+    arena<Upstream>* arena_;  // NOLINT
+    /// A non-owning pointer to the arena used to detect the destruction of the owning resource.
+    std::weak_ptr<arena<Upstream>> owner_;  // NOLINT
+    /// Free blocks of each small size class.
+    std::array<size_class, small_size_class_count> classes_{};  // NOLINT
 };
 
+/**
+ * @brief The thread caches of one thread, one per arena resource used by the thread.
+ *
+ * Lookups are lock-free as the registry is thread local; resources are identified by a unique id rather than their
+ * address, so the cache of a destroyed resource is never handed to a new resource at the same address.
+ *
+ * @tparam Upstream Memory resource to use for allocating the global arena. Implements
+ * rmm::mr::device_memory_resource interface.
+ */
+template <typename Upstream>
+class thread_cache_registry
+{
+  public:
+    /**
+     * @param destroyed Thread local flag set when the registry is destroyed at thread exit.
+     */
+    explicit thread_cache_registry(bool& destroyed) : destroyed_(destroyed) {}
+
+    // Disable copy (and move) semantics.
+    thread_cache_registry(thread_cache_registry const&) = delete;
+    thread_cache_registry& operator=(thread_cache_registry const&) = delete;
+    thread_cache_registry(thread_cache_registry&&) noexcept        = delete;
+    thread_cache_registry& operator=(thread_cache_registry&&) = delete;
+
+    ~thread_cache_registry()
+    {
+        destroyed_ = true;
+        caches_.clear();
+    }
+
+    /// Returns the cache of the resource, or nullptr if the thread has not used the resource.
+    thread_cache<Upstream>* find(std::uint64_t resource_id)
+    {
+        if (resource_id == last_id_)
+        {
+            return last_;
+        }
+        for (auto& [id, cache] : caches_)
+        {
+            if (id == resource_id)
+            {
+                last_id_ = id;
+                last_    = cache.get();
+                return last_;
+            }
+        }
+        return nullptr;
+    }
+
+    /// Creates the cache of the resource for the thread's arena.
+    thread_cache<Upstream>& emplace(std::uint64_t resource_id, std::shared_ptr<arena<Upstream>> const& arena)
+    {
+        // drop the caches of destroyed resources
+        std::erase_if(caches_, [](auto const& entry) { return entry.second->is_expired(); });
+
+        caches_.emplace_back(resource_id, std::make_unique<thread_cache<Upstream>>(arena));
+        last_id_ = resource_id;
+        last_    = caches_.back().second.get();
+        return *last_;
+    }
+
+  private:
+    bool& destroyed_;                                                                         // NOLINT
+    std::vector<std::pair<std::uint64_t, std::unique_ptr<thread_cache<Upstream>>>> caches_;  // NOLINT
+    std::uint64_t last_id_{0};                                                                // NOLINT
+    thread_cache<Upstream>* last_{nullptr};                                                   // NOLINT
+};
+
+/// Returns a unique, non-zero id for an arena resource.
+inline std::uint64_t next_resource_id()
+{
+    static std::atomic<std::uint64_t> next_id{0};
+    return ++next_id;
+}
+
 }  // namespace mrc::memory::detail::arena
@@ -0,0 +1,88 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2021-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <glog/logging.h>
+#include <linux/mempolicy.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace mrc::memory::detail {
+
+/**
+ * @brief Binds the pages of host mappings to a set of numa nodes; must be applied before the pages are first touched
+ *
+ * An empty set of numa nodes binds nothing. If the process lacks the capability to bind memory, a warning is logged
+ * once and the pages are left to the default policy.
+ */
+class numa_binding
+{
+  public:
+    numa_binding(const std::vector<std::uint32_t>& numa_nodes = {})
+    {
+        for (auto node : numa_nodes)
+        {
+            auto word = node / (sizeof(unsigned long) * CHAR_BIT);
+            if (word >= m_numa_mask.size())
+            {
+                m_numa_mask.resize(word + 1, 0);
+            }
+            m_numa_mask[word] |= 1UL << (node % (sizeof(unsigned long) * CHAR_BIT));
+        }
+    }
+
+    void bind(void* ptr, std::size_t length)
+    {
+        if (m_numa_mask.empty() || !m_membind.load(std::memory_order_relaxed))
+        {
+            return;
+        }
+        // the kernel expects the size of the mask in bits plus one
+        auto max_node = m_numa_mask.size() * sizeof(unsigned long) * CHAR_BIT + 1;
+        if (syscall(SYS_mbind, ptr, length, MPOL_BIND, m_numa_mask.data(), max_node, 0) != 0 &&
+            m_membind.exchange(false))
+        {
+            LOG(WARNING) << "unable to bind host memory to its numa nodes - if using docker use: --cap-add=sys_nice";
+        }
+    }
+
+  private:
+    std::vector<unsigned long> m_numa_mask;  // NOLINT
+    std::atomic<bool> m_membind{true};
+};
+
+/**
+ * @brief Faults in the pages of a mapping by writing to each of them, so they are placed at allocation instead of by
+ * whichever thread touches them first
+ */
+inline void prefault(void* ptr, std::size_t length, std::size_t page_size)
+{
+    auto* bytes = static_cast<volatile std::byte*>(ptr);
+    for (std::size_t offset = 0; offset < length; offset += page_size)
+    {
+        bytes[offset] = std::byte{0};
+    }
+}
+
+}  // namespace mrc::memory::detail
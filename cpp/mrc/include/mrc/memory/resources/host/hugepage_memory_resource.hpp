@@ -0,0 +1,176 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2021-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "mrc/memory/resources/detail/numa_binding.hpp"
+#include "mrc/memory/resources/memory_resource.hpp"
+
+#include <cuda_runtime.h>
+#include <glog/logging.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <utility>
+#include <vector>
+
+namespace mrc::memory {
+
+enum class hugepage_kind
+{
+    // anonymous memory aligned to 2MiB and advised to be backed by transparent huge pages
+    transparent,
+    // explicit huge pages from the pools reserved by the system, e.g. /proc/sys/vm/nr_hugepages
+    explicit_2MiB,  // NOLINT
+    explicit_1GiB,  // NOLINT
+};
+
+/**
+ * @brief Host memory resource backed by huge pages, reducing the tlb entries covering large allocations
+ *
+ * Every allocation is mapped separately and rounded up to a multiple of the huge page size, so the resource is meant
+ * to be the upstream of a pool or of other consumers of large blocks. Explicit huge pages must be reserved by the
+ * system beforehand; allocations fail with std::bad_alloc once the reserved pages are exhausted. Transparent huge pages
+ * are best effort and fall back to regular pages.
+ *
+ * The pages are bound to the given numa nodes before they are first touched and, if prefault is set, faulted in when
+ * allocated. If pinned, the allocations are registered with cuda as page-locked memory.
+ */
+class hugepage_memory_resource final : public memory_resource
+{
+    static constexpr std::size_t huge_2MiB = 1UL << 21;  // NOLINT
+    static constexpr std::size_t huge_1GiB = 1UL << 30;  // NOLINT
+
+  public:
+    hugepage_memory_resource(hugepage_kind kind,
+                             std::vector<std::uint32_t> numa_nodes = {},
+                             bool pinned                           = false,
+                             bool prefault                         = false) :
+      m_kind(kind),
+      m_page_size(kind == hugepage_kind::explicit_1GiB ? huge_1GiB : huge_2MiB),
+      m_pinned(pinned),
+      m_prefault(prefault),
+      m_binding(numa_nodes)
+    {}
+
+    ~hugepage_memory_resource() override = default;
+
+    std::size_t page_size() const
+    {
+        return m_page_size;
+    }
+
+  private:
+    void* do_allocate(std::size_t bytes) final
+    {
+        if (bytes == 0)
+        {
+            return nullptr;
+        }
+
+        const auto length = round_up(bytes);
+        void* ptr         = (m_kind == hugepage_kind::transparent ? map_transparent(length) : map_explicit(length));
+        m_binding.bind(ptr, length);
+        if (m_prefault)
+        {
+            // transparent huge pages may be backed by regular pages
+            const std::size_t stride = (m_kind == hugepage_kind::transparent ? sysconf(_SC_PAGESIZE) : m_page_size);
+            detail::prefault(ptr, length, stride);
+        }
+
+        if (m_pinned && cudaHostRegister(ptr, length, cudaHostRegisterDefault) != cudaSuccess)
+        {
+            munmap(ptr, length);
+            throw std::bad_alloc{};
+        }
+        return ptr;
+    }
+
+    void do_deallocate(void* ptr, std::size_t bytes) final
+    {
+        if (ptr == nullptr)
+        {
+            return;
+        }
+        if (m_pinned)
+        {
+            auto status = cudaHostUnregister(ptr);
+            CHECK(status == cudaSuccess);
+        }
+        CHECK_EQ(munmap(ptr, round_up(bytes)), 0);
+    }
+
+    memory_kind do_kind() const final
+    {
+        return (m_pinned ? memory_kind::pinned : memory_kind::host);
+    }
+
+    std::size_t round_up(std::size_t bytes) const
+    {
+        return (bytes + m_page_size - 1) & ~(m_page_size - 1);
+    }
+
+    void* map_explicit(std::size_t length) const
+    {
+        // the log2 of the huge page size selects the huge page pool
+        const int log2_page_size = (m_kind == hugepage_kind::explicit_1GiB ? 30 : 21);
+        const int flags          = MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB | (log2_page_size << MAP_HUGE_SHIFT);
+        void* ptr = mmap(nullptr, length, PROT_READ | PROT_WRITE, flags, -1, 0);
+        if (ptr == MAP_FAILED)
+        {
+            LOG(ERROR) << "unable to map " << length << " bytes of huge pages of " << m_page_size
+                       << " bytes - check the huge pages reserved in /proc/sys/vm/nr_hugepages";
+            throw std::bad_alloc{};
+        }
+        return ptr;
+    }
+
+    // over-maps by a page to align the mapping, then trims the excess
+    void* map_transparent(std::size_t length) const
+    {
+        auto* base = static_cast<std::byte*>(
+            mmap(nullptr, length + m_page_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0));
+        if (base == MAP_FAILED)
+        {
+            throw std::bad_alloc{};
+        }
+
+        auto address  = reinterpret_cast<std::uintptr_t>(base);
+        auto* aligned = base + (((address + m_page_size - 1) & ~(m_page_size - 1)) - address);
+        auto head     = static_cast<std::size_t>(aligned - base);
+        if (head > 0)
+        {
+            munmap(base, head);
+        }
+        munmap(aligned + length, m_page_size - head);
+
+        // advisory only; regular pages back the mapping if transparent huge pages are disabled
+        madvise(aligned, length, MADV_HUGEPAGE);
+        return aligned;
+    }
+
+    const hugepage_kind m_kind;
+    const std::size_t m_page_size;
+    const bool m_pinned;
+    const bool m_prefault;
+    detail::numa_binding m_binding;
+};
+
+}  // namespace mrc::memory
@@ -0,0 +1,109 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2021-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "mrc/memory/resources/detail/numa_binding.hpp"
+#include "mrc/memory/resources/memory_resource.hpp"
+
+#include <cuda_runtime.h>
+#include <glog/logging.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <vector>
+
+namespace mrc::memory {
+
+/**
+ * @brief Host memory resource of regular pages bound to a set of numa nodes and faulted in when allocated
+ *
+ * Every allocation is mapped separately and rounded up to the page size, so the resource is meant to be the upstream
+ * of a pool. Unlike malloc or cudaHostAlloc, the placement of the pages does not depend on the thread which touches
+ * them first: they are bound to the numa nodes before being faulted in by the allocating thread. If pinned, the
+ * allocations are registered with cuda as page-locked memory.
+ */
+class numa_memory_resource final : public memory_resource
+{
+  public:
+    numa_memory_resource(std::vector<std::uint32_t> numa_nodes, bool pinned = false) :
+      m_page_size(sysconf(_SC_PAGESIZE)),
+      m_pinned(pinned),
+      m_binding(numa_nodes)
+    {}
+
+    ~numa_memory_resource() override = default;
+
+  private:
+    void* do_allocate(std::size_t bytes) final
+    {
+        if (bytes == 0)
+        {
+            return nullptr;
+        }
+
+        const auto length = round_up(bytes);
+        void* ptr         = mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (ptr == MAP_FAILED)
+        {
+            throw std::bad_alloc{};
+        }
+
+        m_binding.bind(ptr, length);
+        detail::prefault(ptr, length, m_page_size);
+
+        if (m_pinned && cudaHostRegister(ptr, length, cudaHostRegisterDefault) != cudaSuccess)
+        {
+            munmap(ptr, length);
+            throw std::bad_alloc{};
+        }
+        return ptr;
+    }
+
+    void do_deallocate(void* ptr, std::size_t bytes) final
+    {
+        if (ptr == nullptr)
+        {
+            return;
+        }
+        if (m_pinned)
+        {
+            auto status = cudaHostUnregister(ptr);
+            CHECK(status == cudaSuccess);
+        }
+        CHECK_EQ(munmap(ptr, round_up(bytes)), 0);
+    }
+
+    memory_kind do_kind() const final
+    {
+        return (m_pinned ? memory_kind::pinned : memory_kind::host);
+    }
+
+    std::size_t round_up(std::size_t bytes) const
+    {
+        return (bytes + m_page_size - 1) & ~(m_page_size - 1);
+    }
+
+    const std::size_t m_page_size;
+    const bool m_pinned;
+    detail::numa_binding m_binding;
+};
+
+}  // namespace mrc::memory
@@ -0,0 +1,54 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2021-2022,NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cuda_runtime_api.h>
+
+#include <cstddef>
+
+namespace mrc::memory {
+
+/**
+ * @brief Interface of device memory resources providing stream-ordered allocations
+ *
+ * Memory returned by allocate_async may be used by work enqueued on the stream after the call; memory passed to
+ * deallocate_async may still be used by work enqueued on the stream before the call.
+ */
+struct stream_ordered_resource
+{
+    virtual ~stream_ordered_resource() = default;
+
+    void* allocate_async(std::size_t bytes, cudaStream_t stream)
+    {
+        return do_allocate_async(bytes, stream);
+    }
+
+    void deallocate_async(void* ptr, std::size_t bytes, cudaStream_t stream)
+    {
+        if (ptr != nullptr)
+        {
+            do_deallocate_async(ptr, bytes, stream);
+        }
+    }
+
+  private:
+    virtual void* do_allocate_async(std::size_t bytes, cudaStream_t stream)             = 0;
+    virtual void do_deallocate_async(void* ptr, std::size_t bytes, cudaStream_t stream) = 0;
+};
+
+}  // namespace mrc::memory
@@ -0,0 +1,68 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2021-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "mrc/memory/adaptors.hpp"
+#include "mrc/memory/memory_tracker.hpp"
+
+namespace mrc::memory {
+
+/**
+ * @brief Adaptor accounting the allocations of its upstream resource to the runnable performing them
+ *
+ * Usage is reported by MemoryTracker, labeled by the segment and node of the allocating runnable and by the kind of
+ * the upstream resource. Allocations exceeding the quota of the segment of the allocating runnable throw
+ * std::bad_alloc, see MemoryTracker::set_segment_quota.
+ */
+template <typename Upstream>
+class tracking_resource final : public adaptor<Upstream>
+{
+  public:
+    tracking_resource(Upstream upstream) : adaptor<Upstream>(std::move(upstream)) {}
+    ~tracking_resource() override = default;
+
+  private:
+    void* do_allocate(std::size_t bytes) final
+    {
+        MemoryTracker::reserve(bytes, this->kind());
+        void* ptr = nullptr;
+        try
+        {
+            ptr = this->resource().allocate(bytes);
+        } catch (...)
+        {
+            MemoryTracker::cancel_reservation(bytes, this->kind());
+            throw;
+        }
+        if (ptr == nullptr)
+        {
+            MemoryTracker::cancel_reservation(bytes, this->kind());
+            return ptr;
+        }
+        MemoryTracker::on_allocate(ptr, bytes, this->kind());
+        return ptr;
+    }
+
+    void do_deallocate(void* ptr, std::size_t bytes) final
+    {
+        MemoryTracker::on_deallocate(ptr, bytes);
+        this->resource().deallocate(ptr, bytes);
+    }
+};
+
+}  // namespace mrc::memory
@@ -17,24 +17,27 @@
 
 #pragma once
 
-#include "internal/grpc/progress_engine.hpp"
+namespace prometheus {
+class Gauge;
+}
 
-#include "mrc/node/generic_sink.hpp"
+namespace mrc::metrics {
 
-#include <boost/fiber/all.hpp>
+class Gauge
+{
+  public:
+    explicit Gauge(prometheus::Gauge*);
 
-namespace mrc::internal::rpc {
+    Gauge(const Gauge&) = default;
+    Gauge& operator=(const Gauge&) = default;
 
-/**
- * @brief MRC Sink to handle ProgressEvents which correspond to Promise<bool> tags
- */
-class PromiseHandler final : public mrc::node::GenericSink<ProgressEvent>
-{
-    void on_data(ProgressEvent&& event) final
-    {
-        auto* promise = static_cast<boost::fibers::promise<bool>*>(event.tag);
-        promise->set_value(event.ok);
-    }
+    Gauge(Gauge&&) noexcept = default;
+    Gauge& operator=(Gauge&&) noexcept = default;
+
+    void set(double value);
+
+  private:
+    prometheus::Gauge* m_gauge;
 };
 
-}  // namespace mrc::internal::rpc
+}  // namespace mrc::metrics
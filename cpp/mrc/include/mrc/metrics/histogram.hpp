@@ -0,0 +1,82 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2021-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace mrc::metrics {
+
+namespace detail {
+struct HistogramState;
+}  // namespace detail
+
+/**
+ * @brief Merged view of the values recorded by a Histogram across all threads at the time of the snapshot
+ */
+class HistogramSnapshot
+{
+  public:
+    HistogramSnapshot() = default;
+
+    std::uint64_t count() const;
+    std::uint64_t sum() const;
+    std::uint64_t max() const;
+    double mean() const;
+
+    /**
+     * @brief Value at quantile q in [0, 1], e.g. 0.99 for p99, within the precision of the buckets; 0 if empty
+     */
+    std::uint64_t value_at_quantile(double q) const;
+
+  private:
+    std::vector<std::uint64_t> m_counts;
+    std::uint64_t m_count{0};
+    std::uint64_t m_sum{0};
+    std::uint64_t m_max{0};
+
+    friend class Histogram;
+};
+
+/**
+ * @brief Histogram of non-negative integer values, e.g. latencies in nanoseconds, with HDR style log-linear buckets
+ *
+ * Bucket widths grow with the magnitude of the values, which bounds the relative error of a quantile to 1/64 across
+ * the trackable range [0, 2^40), i.e. about 18 minutes in nanoseconds; larger values are clamped. Each thread records
+ * into its own buckets without locks or read-modify-write operations, and a snapshot merges the buckets of all
+ * threads, so the cost of the histogram is paid on scrape rather than on the hot path.
+ *
+ * Histogram is a copyable handle; copies record into the same buckets.
+ */
+class Histogram
+{
+  public:
+    Histogram();
+
+    void record(std::uint64_t value);
+    void record(std::chrono::nanoseconds duration);
+
+    HistogramSnapshot snapshot() const;
+
+  private:
+    std::shared_ptr<detail::HistogramState> m_state;
+};
+
+}  // namespace mrc::metrics
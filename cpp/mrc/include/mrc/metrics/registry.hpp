@@ -18,10 +18,14 @@
 #pragma once
 
 #include "mrc/metrics/counter.hpp"
+#include "mrc/metrics/gauge.hpp"
+#include "mrc/metrics/histogram.hpp"
+#include "mrc/utils/macros.hpp"
 
 #include <cstddef>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <utility>
 #include <vector>
@@ -33,6 +37,7 @@ class Registry;
 template <typename T>
 class Family;
 class Counter;
+class Gauge;
 
 }  // namespace prometheus
 
@@ -45,20 +50,67 @@ struct CounterReport
     std::size_t count;
 };
 
+struct HistogramReport
+{
+    std::string name;
+    std::map<std::string, std::string> labels;
+    HistogramSnapshot snapshot;
+};
+
 class Registry
 {
   public:
     Registry();
+    ~Registry();
+
+    DELETE_COPYABILITY(Registry);
+    DELETE_MOVEABILITY(Registry);
 
     Counter make_counter(std::string name, std::map<std::string, std::string> labels);
     Counter make_throughput_counter(std::string);
+    Gauge make_gauge(std::string name, std::map<std::string, std::string> labels);
+
+    /**
+     * @brief Histogram exported as a prometheus summary: the p50, p99 and p999 of the recorded values are published
+     * as gauges labeled by quantile, along with the name_count and name_sum gauges, each time the histograms are
+     * collected.
+     */
+    Histogram make_histogram(std::string name, std::map<std::string, std::string> labels);
+
+    /**
+     * @brief Merges the per-thread buckets of each histogram and refreshes its exported gauges
+     */
+    std::vector<HistogramReport> collect_histograms() const;
 
     std::vector<CounterReport> collect_throughput_counters() const;
 
+    /**
+     * @brief All metrics of the registry in the prometheus text exposition format; histograms are collected first
+     */
+    std::string scrape() const;
+
+    /**
+     * @brief Merged scrape of every live Registry in the process
+     */
+    static std::string scrape_all();
+
   protected:
   private:
+    struct RegisteredHistogram
+    {
+        std::string name;
+        std::map<std::string, std::string> labels;
+        Histogram histogram;
+        std::vector<std::pair<double, Gauge>> quantiles;
+        Gauge count;
+        Gauge sum;
+    };
+
     std::shared_ptr<prometheus::Registry> m_registry;
     prometheus::Family<prometheus::Counter>& m_throughput_counters;
+
+    mutable std::mutex m_histograms_mutex;
+    std::vector<RegisteredHistogram> m_histograms;
 };
 
 }  // namespace mrc::metrics
@@ -0,0 +1,106 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2021-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <glog/logging.h>
+#include <nlohmann/json.hpp>
+
+#include <cstddef>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace mrc::modules {
+
+/**
+ * Process wide cache of module configurations compiled from json into the typed struct ConfigT.
+ *
+ * ConfigT is converted with nlohmann's from_json/get<ConfigT>, which is also where a configuration is validated: a
+ * conversion which throws rejects the configuration. Segment instances of a pipeline usually construct their modules
+ * from identical json, so each distinct configuration is parsed once and the compiled struct is shared, immutable,
+ * by all modules configured with it.
+ */
+template <typename ConfigT>
+class CompiledConfigCache
+{
+  public:
+    CompiledConfigCache() = delete;
+
+    /**
+     * Return the compiled form of config, compiling it on first use; throws std::invalid_argument if the
+     * configuration can not be converted to ConfigT.
+     * @param config Module configuration
+     * @return Shared, immutable compiled configuration
+     */
+    static std::shared_ptr<const ConfigT> compile(const nlohmann::json& config)
+    {
+        auto hash = std::hash<nlohmann::json>{}(config);
+
+        std::lock_guard<std::mutex> lock(s_mutex);
+        auto& bucket = s_cache[hash];
+        for (const auto& [json, compiled] : bucket)
+        {
+            if (json == config)
+            {
+                return compiled;
+            }
+        }
+
+        std::shared_ptr<const ConfigT> compiled;
+        try
+        {
+            compiled = std::make_shared<const ConfigT>(config.template get<ConfigT>());
+        } catch (const std::exception& e)
+        {
+            std::stringstream sstream;
+            sstream << "Invalid module configuration -> " << e.what();
+            LOG(ERROR) << sstream.str();
+            throw std::invalid_argument(sstream.str());
+        }
+
+        bucket.emplace_back(config, compiled);
+        return compiled;
+    }
+
+    /**
+     * Number of distinct configurations compiled so far
+     */
+    static std::size_t size()
+    {
+        std::lock_guard<std::mutex> lock(s_mutex);
+        std::size_t count = 0;
+        for (const auto& [hash, bucket] : s_cache)
+        {
+            count += bucket.size();
+        }
+        return count;
+    }
+
+  private:
+    static inline std::mutex s_mutex{};
+    static inline std::map<std::size_t, std::vector<std::pair<nlohmann::json, std::shared_ptr<const ConfigT>>>>
+        s_cache{};
+};
+
+}  // namespace mrc::modules
@@ -30,6 +30,17 @@ namespace mrc::modules {
 
 class SegmentModule;
 
+/**
+ * Module instance to construct from the registry, see segment::Builder::load_modules_from_registry
+ */
+struct RegisteredModuleSpec
+{
+    std::string module_id;
+    std::string registry_namespace{"default"};
+    std::string module_name;
+    nlohmann::json config{};
+};
+
 /**
  * Simple, thread safe, global module registry.
  */
@@ -17,18 +17,31 @@
 
 #pragma once
 
+#include "mrc/modules/module_config.hpp"
 #include "mrc/modules/module_registry.hpp"
 #include "mrc/modules/segment_modules.hpp"
 
 #include <dlfcn.h>
 #include <nlohmann/json.hpp>
 
+#include <type_traits>
+
 namespace mrc::modules {
+
+template <typename ModuleTypeT, typename = void>
+struct has_config_type : std::false_type
+{};
+
+template <typename ModuleTypeT>
+struct has_config_type<ModuleTypeT, std::void_t<typename ModuleTypeT::config_t>> : std::true_type
+{};
+
 struct ModelRegistryUtil
 {
     /**
      * Helper function for registering a new module; automatically check that the type of the object is a segment
-     * module, and build the constructor boiler plate.
+     * module, and build the constructor boiler plate. Modules declaring a typed configuration as `config_t` have
+     * their configuration compiled and validated before the module is constructed, see SegmentModule::typed_config.
      * @tparam ModuleTypeT Module type, must have modules::SegmentModule as a base class
      * @param name Name of the Module
      * @param registry_namespace Namespace where `name` should be registered.
@@ -45,6 +58,10 @@ struct ModelRegistryUtil
                                         std::move(registry_namespace),
                                         release_version,
                                         [](std::string module_name, nlohmann::json config) {
+                                            if constexpr (has_config_type<ModuleTypeT>::value)
+                                            {
+                                                CompiledConfigCache<typename ModuleTypeT::config_t>::compile(config);
+                                            }
                                             return std::make_shared<ModuleTypeT>(std::move(module_name),
                                                                                  std::move(config));
                                         });
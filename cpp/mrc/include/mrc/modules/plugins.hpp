@@ -20,6 +20,7 @@
 #include <map>
 #include <memory>
 #include <mutex>
+#include <optional>
 #include <string>
 #include <vector>
 
@@ -74,7 +75,8 @@ class PluginModule
     void reload();
 
     /**
-     * Return a list of modules published by the plugin
+     * Return a list of modules published by the plugin; queried from the library once and cached until it is
+     * unloaded
      */
     std::vector<std::string> list_modules();
 
@@ -98,6 +100,8 @@ class PluginModule
     bool (*m_plugin_unload)();
     unsigned int (*m_plugin_list)(const char***);
 
+    std::optional<std::vector<std::string>> m_module_names{};
+
     bool try_load_plugin(bool throw_on_error = true);
     bool try_unload_plugin(bool throw_on_error = true);
     bool try_build_plugin_interface(bool throw_on_error = true);
@@ -17,12 +17,16 @@
 
 #pragma once
 
+#include "mrc/modules/module_config.hpp"
+
+#include <glog/logging.h>
 #include <nlohmann/json.hpp>
 
 #include <map>
 #include <memory>
 #include <string>
 #include <typeindex>
+#include <typeinfo>
 #include <vector>
 
 namespace mrc::segment {
@@ -52,6 +56,25 @@ class SegmentModule
     const nlohmann::json& config() const;
     const std::string& name() const;
 
+    /**
+     * Return the module configuration compiled into ConfigT; see CompiledConfigCache. Modules of all segment
+     * instances configured with the same json share one compiled configuration.
+     * @tparam ConfigT Typed configuration, convertible from json
+     * @return Compiled configuration
+     */
+    template <typename ConfigT>
+    const ConfigT& typed_config()
+    {
+        if (!m_typed_config)
+        {
+            m_typed_config      = CompiledConfigCache<ConfigT>::compile(m_config);
+            m_typed_config_type = &typeid(ConfigT);
+        }
+        CHECK(*m_typed_config_type == typeid(ConfigT)) << "module " << name() << " configuration was compiled as a "
+                                                       << m_typed_config_type->name();
+        return *std::static_pointer_cast<const ConfigT>(m_typed_config);
+    }
+
     /**
      * Return vector of input ids -- these are only understood by the SegmentModule
      * @return std::vector
@@ -166,6 +189,9 @@ class SegmentModule
     segment_module_port_map_t m_output_ports{};
 
     const nlohmann::json m_config;
+
+    std::shared_ptr<const void> m_typed_config{};
+    const std::type_info* m_typed_config_type{nullptr};
 };
 
 }  // namespace mrc::modules
@@ -0,0 +1,282 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2021-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "mrc/channel/status.hpp"
+#include "mrc/channel/types.hpp"
+#include "mrc/node/forward.hpp"
+#include "mrc/node/sink_channel.hpp"
+#include "mrc/node/source_channel.hpp"
+#include "mrc/runnable/context.hpp"
+#include "mrc/runnable/runnable.hpp"
+
+#include <boost/fiber/operations.hpp>
+#include <glog/logging.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <utility>
+
+namespace mrc::node {
+
+enum class ShedPolicy
+{
+    // wait for a token, pushing back on the upstream
+    Block,
+    // shed the element which found no token
+    DropNewest,
+    // hold elements without a token back in a bounded backlog, shedding its oldest element once full
+    DropOldest,
+    // shed elements without a token, but admit one in every sample_every of them
+    Sample,
+};
+
+struct AdmissionOptions
+{
+    // sustained admission rate in elements per second; 0 admits every element
+    double rate{0};
+
+    // capacity of the token bucket, i.e. the number of elements admitted back to back after an idle period
+    std::size_t burst{64};
+
+    ShedPolicy policy{ShedPolicy::Block};
+
+    // DropOldest: number of elements held back waiting for a token
+    std::size_t backlog{1024};
+
+    // Sample: one in every sample_every elements without a token is admitted
+    std::size_t sample_every{16};
+};
+
+/**
+ * @brief Token bucket admission control: forwards at most rate elements per second, with bursts of up to burst
+ * elements, and sheds the excess according to the ShedPolicy
+ *
+ * Placed behind an ingress port, it absorbs bursts which would otherwise overrun the stages downstream, and unlike
+ * backpressure alone it does not propagate the overload upstream unless the policy is Block. Shed elements are
+ * counted by shed_count and reported to the counter set by set_shed_counter; Builder::make_admission_node publishes
+ * them as the mrc_admission_shed metric.
+ *
+ * All pes of the node share one token bucket.
+ */
+template <typename T, typename ContextT>
+class AdmissionNode : public SinkChannel<T>, public SourceChannel<T>, public runnable::RunnableWithContext<ContextT>
+{
+  public:
+    using shed_counter_fn_t = std::function<void(std::int64_t)>;
+
+    AdmissionNode(AdmissionOptions options) : m_options(options), m_tokens(static_cast<double>(options.burst))
+    {
+        CHECK_GE(m_options.rate, 0);
+        CHECK_GT(m_options.burst, 0);
+        CHECK_GT(m_options.backlog, 0);
+        CHECK_GT(m_options.sample_every, 0);
+    }
+
+    ~AdmissionNode() override = default;
+
+    const AdmissionOptions& options() const
+    {
+        return m_options;
+    }
+
+    std::uint64_t admitted_count() const
+    {
+        return m_admitted.load(std::memory_order_relaxed);
+    }
+
+    std::uint64_t shed_count() const
+    {
+        return m_shed.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Report shed elements to counter_fn in addition to shed_count; must be set before the node is launched
+     */
+    void set_shed_counter(shed_counter_fn_t counter_fn)
+    {
+        m_shed_counter_fn = std::move(counter_fn);
+    }
+
+  private:
+    // takes a token if one is available; otherwise returns false and sets ready_at to when the next token is
+    bool take_token(channel::time_point_t& ready_at)
+    {
+        if (m_options.rate <= 0)
+        {
+            return true;
+        }
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto now = channel::clock_t::now();
+        if (m_refilled_at.time_since_epoch().count() != 0)
+        {
+            std::chrono::duration<double> elapsed = now - m_refilled_at;
+            m_tokens = std::min(static_cast<double>(m_options.burst), m_tokens + elapsed.count() * m_options.rate);
+        }
+        m_refilled_at = now;
+
+        if (m_tokens >= 1.0)
+        {
+            m_tokens -= 1.0;
+            return true;
+        }
+
+        ready_at = now + std::chrono::duration_cast<channel::duration_t>(
+                             std::chrono::duration<double>((1.0 - m_tokens) / m_options.rate));
+        return false;
+    }
+
+    void admit(T&& data)
+    {
+        m_admitted.fetch_add(1, std::memory_order_relaxed);
+        SourceChannel<T>::await_write(std::move(data));
+    }
+
+    void shed()
+    {
+        m_shed.fetch_add(1, std::memory_order_relaxed);
+        if (m_shed_counter_fn)
+        {
+            m_shed_counter_fn(1);
+        }
+    }
+
+    void on_overflow(T&& data, channel::time_point_t ready_at, std::deque<T>& backlog)
+    {
+        switch (m_options.policy)
+        {
+        case ShedPolicy::Block:
+            do
+            {
+                boost::this_fiber::sleep_until(ready_at);
+            } while (!take_token(ready_at));
+            admit(std::move(data));
+            break;
+        case ShedPolicy::DropNewest:
+            shed();
+            break;
+        case ShedPolicy::DropOldest:
+            if (backlog.size() >= m_options.backlog)
+            {
+                backlog.pop_front();
+                shed();
+            }
+            backlog.push_back(std::move(data));
+            break;
+        case ShedPolicy::Sample:
+            if ((m_overflow.fetch_add(1, std::memory_order_relaxed) + 1) % m_options.sample_every == 0)
+            {
+                admit(std::move(data));
+                break;
+            }
+            shed();
+            break;
+        }
+    }
+
+    void run(ContextT& ctx) final
+    {
+        auto& egress = SinkChannel<T>::egress();
+
+        std::deque<T> backlog;
+        bool closed = false;
+        channel::time_point_t ready_at;
+
+        while (!closed || !backlog.empty())
+        {
+            // the backlog drains as tokens become available, while new elements keep arriving behind it
+            if (!backlog.empty())
+            {
+                if (take_token(ready_at))
+                {
+                    admit(std::move(backlog.front()));
+                    backlog.pop_front();
+                    continue;
+                }
+
+                if (closed)
+                {
+                    boost::this_fiber::sleep_until(ready_at);
+                    continue;
+                }
+
+                T data;
+                auto rc = egress.await_read_until(data, ready_at);
+                if (rc == channel::Status::success)
+                {
+                    on_overflow(std::move(data), ready_at, backlog);
+                }
+                else if (rc != channel::Status::timeout)
+                {
+                    closed = true;
+                }
+                continue;
+            }
+
+            T data;
+            if (egress.await_read(data) != channel::Status::success)
+            {
+                closed = true;
+                continue;
+            }
+
+            if (take_token(ready_at))
+            {
+                admit(std::move(data));
+                continue;
+            }
+            on_overflow(std::move(data), ready_at, backlog);
+        }
+
+        ctx.barrier();
+        if (ctx.rank() == 0)
+        {
+            DVLOG(10) << ctx.info() << " admission node releasing its downstream channel; admitted " << admitted_count()
+                      << ", shed " << shed_count();
+            SourceChannel<T>::release_channel();
+        }
+    }
+
+    void on_state_update(const runnable::Runnable::State& state) final
+    {
+        if (state == runnable::Runnable::State::Stop || state == runnable::Runnable::State::Kill)
+        {
+            SinkChannel<T>::disable_persistence();
+        }
+    }
+
+    const AdmissionOptions m_options;
+    shed_counter_fn_t m_shed_counter_fn;
+
+    std::mutex m_mutex;
+    double m_tokens;
+    channel::time_point_t m_refilled_at{};
+
+    std::atomic<std::uint64_t> m_admitted{0};
+    std::atomic<std::uint64_t> m_shed{0};
+    std::atomic<std::size_t> m_overflow{0};
+};
+
+}  // namespace mrc::node
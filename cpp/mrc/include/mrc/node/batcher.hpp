@@ -0,0 +1,176 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2021-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "mrc/channel/status.hpp"
+#include "mrc/channel/types.hpp"
+#include "mrc/node/forward.hpp"
+#include "mrc/node/sink_channel.hpp"
+#include "mrc/node/source_channel.hpp"
+#include "mrc/runnable/context.hpp"
+#include "mrc/runnable/runnable.hpp"
+
+#include <glog/logging.h>
+
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace mrc::node {
+
+struct BatcherOptions
+{
+    // a batch is emitted once it holds max_count elements
+    std::size_t max_count{64};
+
+    // a batch is emitted at most max_latency after its first element was read
+    std::chrono::microseconds max_latency{1000};
+
+    // a batch is emitted once the estimated size of its elements reaches max_bytes; 0 disables the byte trigger
+    std::size_t max_bytes{0};
+};
+
+/**
+ * @brief Node which collects its inputs into batches, emitting a batch when the first of the count, byte size or
+ * latency triggers of BatcherOptions is reached
+ *
+ * Batches are formed directly on the upstream channel: the first element of a batch is awaited without a deadline, the
+ * remainder are read with the deadline of the batch, so no timer or scheduler thread is involved. The byte size of an
+ * element is estimated by size_fn, sizeof(InputT) by default. The batch_fn converts the collected elements to OutputT
+ * and may be omitted when OutputT is std::vector<InputT>.
+ *
+ * With more than one pe, each context forms its own batches from the shared upstream channel.
+ */
+template <typename InputT, typename OutputT = std::vector<InputT>, typename ContextT = runnable::Context>
+class Batcher : public SinkChannel<InputT>,
+                public SourceChannel<OutputT>,
+                public runnable::RunnableWithContext<ContextT>
+{
+  public:
+    using size_fn_t  = std::function<std::size_t(const InputT&)>;
+    using batch_fn_t = std::function<OutputT(std::vector<InputT>&&)>;
+
+    Batcher(BatcherOptions options = {}, size_fn_t size_fn = nullptr, batch_fn_t batch_fn = nullptr) :
+      m_options(options),
+      m_size_fn(std::move(size_fn)),
+      m_batch_fn(std::move(batch_fn))
+    {
+        CHECK_GT(m_options.max_count, 0);
+
+        if (!m_size_fn)
+        {
+            m_size_fn = [](const InputT& /*data*/) { return sizeof(InputT); };
+        }
+
+        if (!m_batch_fn)
+        {
+            if constexpr (std::is_same_v<OutputT, std::vector<InputT>>)
+            {
+                m_batch_fn = [](std::vector<InputT>&& batch) { return std::move(batch); };
+            }
+            else
+            {
+                LOG(FATAL) << "a batcher emitting a type other than std::vector<InputT> requires a batch_fn";
+            }
+        }
+    }
+
+    ~Batcher() override = default;
+
+    const BatcherOptions& options() const
+    {
+        return m_options;
+    }
+
+  private:
+    // appends the next elements of the batch; without a deadline the read blocks until an element is available
+    channel::Status read(std::vector<InputT>& batch, std::size_t& bytes, const channel::time_point_t* deadline)
+    {
+        auto& egress = SinkChannel<InputT>::egress();
+
+        // without a byte trigger, drain as much of the remainder of the batch as is available
+        if (m_options.max_bytes == 0)
+        {
+            const auto remaining = m_options.max_count - batch.size();
+            return (deadline == nullptr ? egress.await_read_n(batch, remaining)
+                                        : egress.await_read_n(batch, remaining, *deadline));
+        }
+
+        auto& data = batch.emplace_back();
+        auto rc    = (deadline == nullptr ? egress.await_read(data) : egress.await_read_until(data, *deadline));
+        if (rc != channel::Status::success)
+        {
+            batch.pop_back();
+            return rc;
+        }
+        bytes += m_size_fn(data);
+        return rc;
+    }
+
+    bool is_full(const std::vector<InputT>& batch, std::size_t bytes) const
+    {
+        return batch.size() >= m_options.max_count || (m_options.max_bytes > 0 && bytes >= m_options.max_bytes);
+    }
+
+    void run(ContextT& ctx) final
+    {
+        std::vector<InputT> batch;
+        batch.reserve(m_options.max_count);
+
+        while (true)
+        {
+            std::size_t bytes = 0;
+            if (read(batch, bytes, nullptr) != channel::Status::success)
+            {
+                break;
+            }
+
+            const channel::time_point_t deadline = channel::clock_t::now() + m_options.max_latency;
+            while (!is_full(batch, bytes) && read(batch, bytes, &deadline) == channel::Status::success) {}
+
+            SourceChannel<OutputT>::await_write(m_batch_fn(std::move(batch)));
+            batch.clear();
+            batch.reserve(m_options.max_count);
+        }
+
+        ctx.barrier();
+        if (ctx.rank() == 0)
+        {
+            DVLOG(10) << ctx.info() << " batcher releasing its downstream channel";
+            SourceChannel<OutputT>::release_channel();
+        }
+    }
+
+    void on_state_update(const runnable::Runnable::State& state) final
+    {
+        // the upstream channel closes once the upstream edges are released; partial batches are emitted on close
+        if (state == runnable::Runnable::State::Stop || state == runnable::Runnable::State::Kill)
+        {
+            SinkChannel<InputT>::disable_persistence();
+        }
+    }
+
+    const BatcherOptions m_options;
+    size_fn_t m_size_fn;
+    batch_fn_t m_batch_fn;
+};
+
+}  // namespace mrc::node
@@ -0,0 +1,238 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "mrc/channel/status.hpp"
+#include "mrc/data/sharded_cache.hpp"
+#include "mrc/node/forward.hpp"
+#include "mrc/node/sink_channel.hpp"
+#include "mrc/node/source_channel.hpp"
+#include "mrc/runnable/context.hpp"
+#include "mrc/runnable/runnable.hpp"
+
+#include <boost/fiber/future/future.hpp>
+#include <boost/fiber/future/promise.hpp>
+#include <boost/fiber/mutex.hpp>
+#include <glog/logging.h>
+
+#include <atomic>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+
+namespace mrc::node {
+
+/**
+ * @brief Node memoizing a map function in a data::ShardedCache keyed by a key of each input
+ *
+ * The output of an input whose key is cached is emitted without calling the map function. Inputs whose key is being
+ * mapped by another engine of the node when they are read wait on that result rather than mapping it again, so a burst
+ * of the same key costs a single call. The cache is shared by all pes and engines of the node; launch it with more
+ * than one to map keys not yet cached in parallel, in which case outputs may be emitted out of order.
+ *
+ * Outputs are copied out of the cache; cache large outputs as a std::shared_ptr<const T>. If the map function throws,
+ * the exception is reported to the runtime context and the input, as well as those waiting on its key, are skipped;
+ * nothing is cached for the key.
+ *
+ * Lookups are counted by hit_count, miss_count and coalesced_count and reported to the counters set by set_counters;
+ * Builder::make_caching_node publishes them as the mrc_cache_hits, mrc_cache_misses and mrc_cache_coalesced metrics.
+ */
+template <typename InputT, typename OutputT, typename KeyT, typename ContextT>
+class CachingNode : public SinkChannel<InputT>,
+                    public SourceChannel<OutputT>,
+                    public runnable::RunnableWithContext<ContextT>
+{
+  public:
+    using map_fn_t     = std::function<OutputT(InputT&&)>;
+    using key_fn_t     = std::function<KeyT(const InputT&)>;
+    using cache_t      = data::ShardedCache<KeyT, OutputT>;
+    using counter_fn_t = std::function<void(std::int64_t)>;
+
+    CachingNode(map_fn_t map_fn,
+                key_fn_t key_fn,
+                data::CacheOptions options          = {},
+                typename cache_t::cost_fn_t cost_fn = nullptr) :
+      m_map_fn(std::move(map_fn)),
+      m_key_fn(std::move(key_fn)),
+      m_cache(options, std::move(cost_fn))
+    {
+        CHECK(m_map_fn) << "CachingNode requires a map function";
+        CHECK(m_key_fn) << "CachingNode requires a key function";
+    }
+
+    ~CachingNode() override = default;
+
+    const cache_t& cache() const
+    {
+        return m_cache;
+    }
+
+    // inputs whose output was found in the cache
+    std::uint64_t hit_count() const
+    {
+        return m_hits.load(std::memory_order_relaxed);
+    }
+
+    // inputs which were mapped
+    std::uint64_t miss_count() const
+    {
+        return m_misses.load(std::memory_order_relaxed);
+    }
+
+    // inputs which waited on the mapping of the same key by another engine
+    std::uint64_t coalesced_count() const
+    {
+        return m_coalesced.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Report the lookups to counters in addition to the counts of the node; must be set before the node is
+     * launched
+     */
+    void set_counters(counter_fn_t hits, counter_fn_t misses, counter_fn_t coalesced)
+    {
+        m_hit_counter_fn       = std::move(hits);
+        m_miss_counter_fn      = std::move(misses);
+        m_coalesced_counter_fn = std::move(coalesced);
+    }
+
+  private:
+    static void count(std::atomic<std::uint64_t>& counter, const counter_fn_t& counter_fn)
+    {
+        counter.fetch_add(1, std::memory_order_relaxed);
+        if (counter_fn)
+        {
+            counter_fn(1);
+        }
+    }
+
+    void emit(OutputT&& output)
+    {
+        SourceChannel<OutputT>::await_write(std::move(output));
+    }
+
+    void process(InputT&& data, ContextT& ctx)
+    {
+        auto key = m_key_fn(data);
+        if (auto cached = m_cache.get(key))
+        {
+            count(m_hits, m_hit_counter_fn);
+            emit(std::move(*cached));
+            return;
+        }
+
+        std::unique_lock<boost::fibers::mutex> lock(m_in_flight_mutex);
+
+        // the key may have completed between the lookup and taking the lock
+        if (auto cached = m_cache.get(key))
+        {
+            lock.unlock();
+            count(m_hits, m_hit_counter_fn);
+            emit(std::move(*cached));
+            return;
+        }
+
+        auto in_flight = m_in_flight.find(key);
+        if (in_flight != m_in_flight.end())
+        {
+            auto future = in_flight->second;
+            lock.unlock();
+
+            count(m_coalesced, m_coalesced_counter_fn);
+            try
+            {
+                emit(OutputT(future.get()));
+            } catch (...)
+            {
+                // reported by the engine which mapped the key
+            }
+            return;
+        }
+
+        boost::fibers::promise<OutputT> promise;
+        m_in_flight.emplace(key, promise.get_future().share());
+        lock.unlock();
+
+        count(m_misses, m_miss_counter_fn);
+        try
+        {
+            auto output = m_map_fn(std::move(data));
+            m_cache.put(key, output);
+            promise.set_value(output);
+            complete(key);
+            emit(std::move(output));
+        } catch (...)
+        {
+            promise.set_exception(std::current_exception());
+            complete(key);
+            ctx.set_exception(std::current_exception());
+        }
+    }
+
+    // the key is cached, or failed, before it is no longer in flight, so later reads of the key find either
+    void complete(const KeyT& key)
+    {
+        std::lock_guard<boost::fibers::mutex> lock(m_in_flight_mutex);
+        m_in_flight.erase(key);
+    }
+
+    void run(ContextT& ctx) final
+    {
+        InputT data;
+        while (SinkChannel<InputT>::egress().await_read(data) == channel::Status::success)
+        {
+            process(std::move(data), ctx);
+        }
+
+        ctx.barrier();
+        if (ctx.rank() == 0)
+        {
+            DVLOG(10) << ctx.info() << " caching node releasing its downstream channel; hits " << hit_count()
+                      << ", misses " << miss_count() << ", coalesced " << coalesced_count();
+            SourceChannel<OutputT>::release_channel();
+        }
+    }
+
+    void on_state_update(const runnable::Runnable::State& state) final
+    {
+        if (state == runnable::Runnable::State::Stop || state == runnable::Runnable::State::Kill)
+        {
+            SinkChannel<InputT>::disable_persistence();
+        }
+    }
+
+    map_fn_t m_map_fn;
+    key_fn_t m_key_fn;
+    cache_t m_cache;
+
+    counter_fn_t m_hit_counter_fn;
+    counter_fn_t m_miss_counter_fn;
+    counter_fn_t m_coalesced_counter_fn;
+
+    boost::fibers::mutex m_in_flight_mutex;
+    std::unordered_map<KeyT, boost::fibers::shared_future<OutputT>> m_in_flight;
+
+    std::atomic<std::uint64_t> m_hits{0};
+    std::atomic<std::uint64_t> m_misses{0};
+    std::atomic<std::uint64_t> m_coalesced{0};
+};
+
+}  // namespace mrc::node
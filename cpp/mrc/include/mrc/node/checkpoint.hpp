@@ -0,0 +1,164 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2021-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <variant>
+
+namespace mrc::node {
+
+/**
+ * @brief Position of a source from which it can resume, as an opaque token, e.g. a file offset or a stream cursor
+ */
+struct Checkpoint
+{
+    std::uint64_t epoch{0};
+    std::string token;
+};
+
+/**
+ * @brief Durable storage of the last committed checkpoint of each named source
+ */
+class CheckpointStore
+{
+  public:
+    virtual ~CheckpointStore() = default;
+
+    virtual void save(const std::string& source_name, const Checkpoint& checkpoint) = 0;
+    virtual std::optional<Checkpoint> load(const std::string& source_name) = 0;
+};
+
+/**
+ * @brief CheckpointStore which does not outlive the process; restarts within the process resume from it
+ */
+class MemoryCheckpointStore final : public CheckpointStore
+{
+  public:
+    void save(const std::string& source_name, const Checkpoint& checkpoint) final;
+    std::optional<Checkpoint> load(const std::string& source_name) final;
+
+  private:
+    std::mutex m_mutex;
+    std::map<std::string, Checkpoint> m_checkpoints;
+};
+
+/**
+ * @brief CheckpointStore keeping the checkpoint of each source in a file of the given directory
+ *
+ * A checkpoint is written to a temporary file which is renamed into place, so a crash while saving leaves the previous
+ * checkpoint intact. Failing to write a checkpoint throws, since a job which can not checkpoint should not run for
+ * hours assuming it can.
+ */
+class FileCheckpointStore final : public CheckpointStore
+{
+  public:
+    FileCheckpointStore(std::filesystem::path directory);
+
+    void save(const std::string& source_name, const Checkpoint& checkpoint) final;
+    std::optional<Checkpoint> load(const std::string& source_name) final;
+
+    const std::filesystem::path& directory() const;
+
+  private:
+    std::filesystem::path path(const std::string& source_name) const;
+
+    const std::filesystem::path m_directory;
+};
+
+/**
+ * @brief Barrier marker which a checkpointable source injects into its stream behind the elements of an epoch
+ */
+struct CheckpointMarker
+{
+    std::uint64_t epoch{0};
+};
+
+/**
+ * @brief Element type of the edges downstream of a checkpointable source: either data or a checkpoint marker
+ *
+ * Markers travel in order with the data on each edge, so a marker reaching a sink implies all elements emitted before
+ * it along that path have been processed by the sink. Nodes between the source and the sinks forward markers
+ * unchanged, e.g. with std::visit, and must run a single pe so markers are not overtaken by earlier data.
+ */
+template <typename T>
+using Checkpointed = std::variant<T, CheckpointMarker>;
+
+/**
+ * @brief Tracks the epochs of one checkpointable source and commits an epoch to the store once its marker reached
+ * every participating sink
+ *
+ * Epochs commit in order: an epoch acknowledged by all participants also commits every earlier epoch, which is then
+ * superseded. The checkpoint committed by a previous run is loaded on construction and handed to the source as the
+ * position to resume from.
+ */
+class CheckpointCoordinator
+{
+  public:
+    CheckpointCoordinator(std::string source_name,
+                          std::shared_ptr<CheckpointStore> store,
+                          std::size_t participants = 1);
+
+    /**
+     * @brief checkpoint committed by a previous run, if any
+     */
+    const std::optional<Checkpoint>& restored() const;
+
+    /**
+     * @brief open a new epoch ending at token; the returned marker is emitted behind the last element of the epoch
+     */
+    CheckpointMarker begin_epoch(std::string token);
+
+    /**
+     * @brief record that a participating sink received marker
+     */
+    void acknowledge(const CheckpointMarker& marker);
+
+    /**
+     * @brief last epoch committed to the store, either in this run or restored from a previous one
+     */
+    std::optional<Checkpoint> committed() const;
+
+    const std::string& source_name() const;
+    std::size_t participants() const;
+
+  private:
+    struct PendingEpoch
+    {
+        std::string token;
+        std::size_t acknowledgements{0};
+    };
+
+    const std::string m_source_name;
+    const std::shared_ptr<CheckpointStore> m_store;
+    const std::size_t m_participants;
+    const std::optional<Checkpoint> m_restored;
+
+    mutable std::mutex m_mutex;
+    std::uint64_t m_next_epoch;
+    std::map<std::uint64_t, PendingEpoch> m_pending;
+    std::optional<Checkpoint> m_committed;
+};
+
+}  // namespace mrc::node
@@ -0,0 +1,138 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2021-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "mrc/node/checkpoint.hpp"
+#include "mrc/node/forward.hpp"
+#include "mrc/node/generic_source.hpp"
+#include "mrc/runnable/context.hpp"
+
+#include <glog/logging.h>
+#include <rxcpp/rx.hpp>
+
+#include <cstddef>
+#include <exception>
+#include <memory>
+#include <optional>
+#include <string>
+#include <utility>
+#include <variant>
+
+namespace mrc::node {
+
+/**
+ * @brief GenericSource which periodically checkpoints its position, so a restarted job resumes where the last
+ * consistent checkpoint left off instead of replaying its whole input
+ *
+ * The implementation emits plain elements of T to the subscriber handed to data_source. Every interval elements, and
+ * once more when data_source returns, the node asks checkpoint_token for the position following the last emitted
+ * element and injects a CheckpointMarker behind it. The coordinator persists the token once every participating sink
+ * has seen the marker. On construction of the next run, data_source receives the last persisted token as its
+ * resume_token.
+ *
+ * Downstream edges carry Checkpointed<T>; sinks acknowledge markers via acknowledge_checkpoints.
+ */
+template <typename T, typename ContextT>
+class CheckpointableSource : public GenericSource<Checkpointed<T>, ContextT>
+{
+  public:
+    CheckpointableSource(std::shared_ptr<CheckpointCoordinator> coordinator, std::size_t interval = 1024) :
+      m_coordinator(std::move(coordinator)),
+      m_interval(interval)
+    {
+        CHECK(m_coordinator) << "a checkpointable source requires a coordinator";
+        CHECK_GT(m_interval, 0);
+    }
+
+    ~CheckpointableSource() override = default;
+
+    const std::shared_ptr<CheckpointCoordinator>& coordinator() const
+    {
+        return m_coordinator;
+    }
+
+    std::size_t interval() const
+    {
+        return m_interval;
+    }
+
+  private:
+    virtual void data_source(rxcpp::subscriber<T>& s, const std::optional<std::string>& resume_token) = 0;
+
+    // position following the last element emitted by data_source
+    virtual std::string checkpoint_token() = 0;
+
+    void data_source(rxcpp::subscriber<Checkpointed<T>>& s) final
+    {
+        std::size_t since_marker = 0;
+
+        auto emit_marker = [this, &s, &since_marker] {
+            s.on_next(Checkpointed<T>(m_coordinator->begin_epoch(checkpoint_token())));
+            since_marker = 0;
+        };
+
+        // the subscriber of the implementation has its own subscription, so completing it does not complete the
+        // stream before the final marker; stopping the source unsubscribes both
+        auto values = rxcpp::make_subscriber<T>(
+            rxcpp::composite_subscription(),
+            [this, &s, &since_marker, &emit_marker](T value) {
+                if (!s.is_subscribed())
+                {
+                    return;
+                }
+                s.on_next(Checkpointed<T>(std::in_place_index<0>, std::move(value)));
+                if (++since_marker >= m_interval)
+                {
+                    emit_marker();
+                }
+            },
+            [&s](std::exception_ptr e) { s.on_error(std::move(e)); });
+        s.add(values.get_subscription());
+
+        const auto& restored = m_coordinator->restored();
+        data_source(values, restored ? std::optional<std::string>(restored->token) : std::nullopt);
+
+        if (s.is_subscribed() && since_marker > 0)
+        {
+            emit_marker();
+        }
+    }
+
+    const std::shared_ptr<CheckpointCoordinator> m_coordinator;
+    const std::size_t m_interval;
+};
+
+/**
+ * @brief Wraps the on_next function of a sink of T into one consuming Checkpointed<T>, acknowledging markers on
+ * coordinator and passing data on to on_data
+ */
+template <typename T, typename OnDataFnT>
+auto acknowledge_checkpoints(std::shared_ptr<CheckpointCoordinator> coordinator, OnDataFnT on_data)
+{
+    CHECK(coordinator);
+    return [coordinator = std::move(coordinator), on_data = std::move(on_data)](Checkpointed<T> element) mutable {
+        if (auto* marker = std::get_if<CheckpointMarker>(&element))
+        {
+            coordinator->acknowledge(*marker);
+            return;
+        }
+        on_data(std::get<0>(std::move(element)));
+    };
+}
+
+}  // namespace mrc::node
@@ -0,0 +1,175 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "mrc/channel/status.hpp"
+#include "mrc/constants.hpp"
+#include "mrc/coroutines/ring_buffer.hpp"
+#include "mrc/coroutines/task.hpp"
+#include "mrc/coroutines/thread_pool.hpp"
+#include "mrc/coroutines/when_all.hpp"
+#include "mrc/node/coro_runnable.hpp"
+#include "mrc/node/forward.hpp"
+#include "mrc/node/sink_channel.hpp"
+#include "mrc/node/source_channel.hpp"
+
+#include <boost/fiber/fiber.hpp>
+#include <glog/logging.h>
+
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace mrc::node {
+
+/**
+ * @brief Node which transforms each input with a coroutine running on a coroutines::ThreadPool.
+ *
+ * `concurrency` coroutines each read an input from a coroutines::RingBuffer, co_await the user function and write the
+ * result to a second ring buffer. One fiber feeds the input ring buffer from the upstream edge and another drains the
+ * output ring buffer to the downstream edge, so up to `concurrency` calls of the user function may be in flight while
+ * they await, e.g. on an IoScheduler. With a concurrency greater than one, outputs may be emitted out of order.
+ *
+ * If the user function throws, the node stops accepting new inputs and the first exception is reported to the runtime
+ * context once the in-flight coroutines have completed.
+ */
+template <typename InputT, typename OutputT, typename ContextT>
+class CoroNode : public SinkChannel<InputT>, public SourceChannel<OutputT>, public CoroRunnable<ContextT>
+{
+  public:
+    using node_fn_t = std::function<coroutines::Task<OutputT>(InputT)>;
+
+    CoroNode(node_fn_t node_fn,
+             std::size_t concurrency                             = 64,
+             std::shared_ptr<coroutines::ThreadPool> thread_pool = nullptr) :
+      CoroRunnable<ContextT>(std::move(thread_pool)),
+      m_node_fn(std::move(node_fn)),
+      m_concurrency(concurrency),
+      m_input({.capacity = concurrency}),
+      m_output({.capacity = concurrency})
+    {
+        CHECK(m_node_fn) << "CoroNode requires a node function";
+        CHECK_GT(m_concurrency, 0);
+    }
+
+    ~CoroNode() override = default;
+
+  private:
+    coroutines::Task<void> process()
+    {
+        co_await this->thread_pool().schedule();
+        while (!this->has_exception())
+        {
+            auto input = co_await m_input.read();
+            if (!input)
+            {
+                break;
+            }
+
+            try
+            {
+                auto output = co_await m_node_fn(std::move(*input));
+                if (co_await m_output.write(std::move(output)) != coroutines::RingBufferOpStatus::Success)
+                {
+                    break;
+                }
+            } catch (...)
+            {
+                this->set_exception(std::current_exception());
+                m_input.notify_waiters();
+            }
+        }
+    }
+
+    coroutines::Task<void> process_all()
+    {
+        std::vector<coroutines::Task<void>> tasks;
+        tasks.reserve(m_concurrency);
+        for (std::size_t i = 0; i < m_concurrency; i++)
+        {
+            tasks.push_back(process());
+        }
+        co_await coroutines::when_all(std::move(tasks));
+        m_output.close();
+    }
+
+    void do_run(ContextT& ctx) final
+    {
+        boost::fibers::fiber reader([this] {
+            std::vector<InputT> batch;
+            batch.reserve(MRC_DEFAULT_SINK_READ_BATCH_SIZE);
+            while (SinkChannel<InputT>::egress().await_read_n(batch, MRC_DEFAULT_SINK_READ_BATCH_SIZE) ==
+                   channel::Status::success)
+            {
+                for (auto& data : batch)
+                {
+                    if (fiber_await(m_input.write(std::move(data))) != coroutines::RingBufferOpStatus::Success)
+                    {
+                        return;
+                    }
+                }
+                batch.clear();
+            }
+            m_input.close();
+        });
+
+        boost::fibers::fiber writer([this] {
+            while (true)
+            {
+                auto data = fiber_await(m_output.read());
+                if (!data)
+                {
+                    break;
+                }
+                SourceChannel<OutputT>::await_write(std::move(*data));
+            }
+        });
+
+        fiber_await(process_all());
+        writer.join();
+
+        // the reader may be blocked on the upstream edge until the kill issued by the exception reaches it
+        this->report_exception(ctx);
+        reader.join();
+    }
+
+    void on_shutdown_critical_section() final
+    {
+        SourceChannel<OutputT>::release_channel();
+    }
+
+    void on_stop(bool kill) final
+    {
+        // a stopped node drains its upstream edge to completion; a killed node drops inputs which are not in flight
+        SinkChannel<InputT>::disable_persistence();
+        if (kill)
+        {
+            m_input.notify_waiters();
+        }
+    }
+
+    node_fn_t m_node_fn;
+    std::size_t m_concurrency;
+    coroutines::RingBuffer<InputT> m_input;
+    coroutines::RingBuffer<OutputT> m_output;
+};
+
+}  // namespace mrc::node
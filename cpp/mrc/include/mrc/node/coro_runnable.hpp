@@ -0,0 +1,329 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "mrc/coroutines/concepts/awaitable.hpp"
+#include "mrc/coroutines/thread_pool.hpp"
+#include "mrc/node/forward.hpp"
+#include "mrc/runnable/context.hpp"
+#include "mrc/runnable/runnable.hpp"
+
+#include <boost/fiber/future/future.hpp>
+#include <boost/fiber/future/promise.hpp>
+#include <glog/logging.h>
+
+#include <coroutine>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+namespace mrc::node {
+
+namespace detail {
+
+/**
+ * @brief Coroutine used to co_await from a fiber; the fiber is released only once the frame has reached its final
+ * suspend point so the frame can be destroyed by the waiting fiber.
+ */
+class FiberAwaitTask
+{
+  public:
+    struct promise_type  // NOLINT
+    {
+        auto get_return_object() noexcept -> FiberAwaitTask
+        {
+            return FiberAwaitTask{std::coroutine_handle<promise_type>::from_promise(*this)};
+        }
+
+        static auto initial_suspend() noexcept -> std::suspend_always
+        {
+            return {};
+        }
+
+        static auto final_suspend() noexcept
+        {
+            struct Notifier
+            {
+                static auto await_ready() noexcept -> bool
+                {
+                    return false;
+                }
+
+                static auto await_suspend(std::coroutine_handle<promise_type> handle) noexcept -> void
+                {
+                    // the frame may be destroyed as soon as the value is set; the local keeps the shared state alive
+                    auto done = std::move(handle.promise().done);
+                    done.set_value();
+                }
+
+                static auto await_resume() noexcept -> void {}
+            };
+            return Notifier{};
+        }
+
+        static auto return_void() noexcept -> void {}
+
+        auto unhandled_exception() noexcept -> void
+        {
+            exception = std::current_exception();
+        }
+
+        boost::fibers::promise<void> done;
+        std::exception_ptr exception;
+    };
+
+    explicit FiberAwaitTask(std::coroutine_handle<promise_type> handle) : m_handle(handle) {}
+
+    FiberAwaitTask(const FiberAwaitTask&)            = delete;
+    FiberAwaitTask& operator=(const FiberAwaitTask&) = delete;
+
+    ~FiberAwaitTask()
+    {
+        m_handle.destroy();
+    }
+
+    void wait()
+    {
+        auto future = m_handle.promise().done.get_future();
+        m_handle.resume();
+        future.wait();
+        if (m_handle.promise().exception)
+        {
+            std::rethrow_exception(m_handle.promise().exception);
+        }
+    }
+
+  private:
+    std::coroutine_handle<promise_type> m_handle;
+};
+
+// forwards to an awaiter whose await_ready has already been called and returned false
+template <typename AwaiterT>
+struct NotReady
+{
+    static auto await_ready() noexcept -> bool
+    {
+        return false;
+    }
+
+    auto await_suspend(std::coroutine_handle<> handle)
+    {
+        return awaiter.await_suspend(handle);
+    }
+
+    auto await_resume() -> decltype(auto)
+    {
+        return awaiter.await_resume();
+    }
+
+    AwaiterT& awaiter;
+};
+
+template <typename AwaitableT>
+struct AwaitResult
+{
+    using type = typename coroutines::concepts::awaitable_traits<AwaitableT>::awaiter_return_type;  // NOLINT
+};
+
+template <typename AwaitableT>
+requires coroutines::concepts::awaiter<std::remove_cvref_t<AwaitableT>>
+struct AwaitResult<AwaitableT>
+{
+    using type = decltype(std::declval<AwaitableT&>().await_resume());  // NOLINT
+};
+
+template <typename AwaitableT, typename ResultT>
+auto fiber_await_task(AwaitableT&& awaitable, std::optional<ResultT>& result) -> FiberAwaitTask
+{
+    result.emplace(co_await std::forward<AwaitableT>(awaitable));
+}
+
+template <typename AwaitableT>
+auto fiber_await_task(AwaitableT&& awaitable) -> FiberAwaitTask
+{
+    co_await std::forward<AwaitableT>(awaitable);
+}
+
+template <typename AwaitableT>
+auto fiber_await_impl(AwaitableT&& awaitable)
+{
+    using result_t = typename AwaitResult<AwaitableT&&>::type;
+
+    if constexpr (std::is_void_v<result_t>)
+    {
+        auto task = fiber_await_task(std::forward<AwaitableT>(awaitable));
+        task.wait();
+    }
+    else
+    {
+        std::optional<std::remove_cvref_t<result_t>> result;
+        auto task = fiber_await_task(std::forward<AwaitableT>(awaitable), result);
+        task.wait();
+        return std::move(*result);
+    }
+}
+
+}  // namespace detail
+
+/**
+ * @brief Co_await an awaiter or awaitable from a fiber (or any thread which is not an executor of a ThreadPool).
+ *
+ * Awaiters which are ready, e.g. a RingBuffer write with free capacity, complete without creating a coroutine frame;
+ * otherwise the calling fiber is parked until the awaiter is resumed by another execution context. The result of the
+ * await is returned by value.
+ */
+template <typename AwaitableT>
+auto fiber_await(AwaitableT&& awaitable)
+{
+    if constexpr (coroutines::concepts::awaiter<std::remove_cvref_t<AwaitableT>>)
+    {
+        if (awaitable.await_ready())
+        {
+            return awaitable.await_resume();
+        }
+        return detail::fiber_await_impl(detail::NotReady<std::remove_reference_t<AwaitableT>>{awaitable});
+    }
+    else
+    {
+        return detail::fiber_await_impl(std::forward<AwaitableT>(awaitable));
+    }
+}
+
+/**
+ * @brief Runnable base for nodes whose business logic is expressed as coroutines executed on a coroutines::ThreadPool.
+ *
+ * The fibers of the runnable only move data between the channels of the edges and the coroutines::RingBuffers used by
+ * the coroutines; the user coroutines run on the thread pool, so the number of in-flight awaits is not bounded by the
+ * number of fibers. If no thread pool is provided, a single-threaded pool is created when the runnable starts.
+ *
+ * Only the rank 0 context drives the node; the concurrency of a coroutine node is set by its number of coroutines, so
+ * launching with more than one pe only adds idle contexts.
+ */
+template <typename ContextT>
+class CoroRunnable : public runnable::RunnableWithContext<ContextT>
+{
+    using state_t = runnable::Runnable::State;
+
+  public:
+    ~CoroRunnable() override = default;
+
+  protected:
+    CoroRunnable(std::shared_ptr<coroutines::ThreadPool> thread_pool) : m_thread_pool(std::move(thread_pool)) {}
+
+    coroutines::ThreadPool& thread_pool()
+    {
+        DCHECK(m_thread_pool);
+        return *m_thread_pool;
+    }
+
+    // records the first exception thrown by a coroutine; it is reported to the runtime context when the node completes
+    void set_exception(std::exception_ptr exception)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (!m_exception)
+        {
+            m_exception = std::move(exception);
+        }
+    }
+
+    bool has_exception() const
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return bool(m_exception);
+    }
+
+    // reports a recorded exception to the runtime context, which kills the runnable; reported at most once
+    void report_exception(ContextT& ctx)
+    {
+        std::exception_ptr exception;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (m_exception_reported)
+            {
+                return;
+            }
+            m_exception_reported = bool(m_exception);
+            exception            = m_exception;
+        }
+
+        if (exception)
+        {
+            ctx.set_exception(std::move(exception));
+        }
+    }
+
+  private:
+    // implemented by node objects and will be final
+    virtual void do_run(ContextT& ctx)          = 0;
+    virtual void on_shutdown_critical_section() = 0;
+    virtual void on_stop(bool kill)             = 0;
+
+    void run(ContextT& ctx) final;
+    void on_state_update(const state_t& state) final;
+
+    std::shared_ptr<coroutines::ThreadPool> m_thread_pool;
+    mutable std::mutex m_mutex;
+    std::exception_ptr m_exception;
+    bool m_exception_reported{false};
+};
+
+template <typename ContextT>
+void CoroRunnable<ContextT>::run(ContextT& ctx)
+{
+    ctx.barrier();
+    if (ctx.rank() == 0)
+    {
+        if (!m_thread_pool)
+        {
+            m_thread_pool = std::make_shared<coroutines::ThreadPool>(
+                coroutines::ThreadPool::Options{.thread_count = 1, .description = "coro_runnable"});
+        }
+
+        DVLOG(10) << ctx.info() << " running coroutines";
+        do_run(ctx);
+        report_exception(ctx);
+
+        DVLOG(10) << ctx.info() << " critical section shutdown - start";
+        on_shutdown_critical_section();
+        DVLOG(10) << ctx.info() << " critical section shutdown - finish";
+    }
+    ctx.barrier();
+}
+
+template <typename ContextT>
+void CoroRunnable<ContextT>::on_state_update(const state_t& state)
+{
+    switch (state)
+    {
+    case state_t::Stop:
+        on_stop(false);
+        break;
+
+    case state_t::Kill:
+        on_stop(true);
+        break;
+
+    default:
+        break;
+    }
+}
+
+}  // namespace mrc::node
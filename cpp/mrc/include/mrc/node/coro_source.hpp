@@ -0,0 +1,135 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "mrc/coroutines/generator.hpp"
+#include "mrc/coroutines/ring_buffer.hpp"
+#include "mrc/coroutines/task.hpp"
+#include "mrc/coroutines/thread_pool.hpp"
+#include "mrc/node/coro_runnable.hpp"
+#include "mrc/node/forward.hpp"
+#include "mrc/node/source_channel.hpp"
+
+#include <boost/fiber/fiber.hpp>
+#include <glog/logging.h>
+
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+namespace mrc::node {
+
+/**
+ * @brief Source node whose data is produced by a coroutine running on a coroutines::ThreadPool.
+ *
+ * The coroutine is given a coroutines::RingBuffer<T> and co_awaits `write()` on it; a fiber moves elements from the
+ * ring buffer to the downstream edge. The source completes when the coroutine returns. A function returning a
+ * coroutines::Generator<T> is also accepted, in which case the generator is iterated on the thread pool.
+ *
+ * Stopping or killing the source closes the ring buffer, after which writes return RingBufferOpStatus::Stopped and
+ * the coroutine is expected to return.
+ */
+template <typename T, typename ContextT>
+class CoroSource : public SourceChannel<T>, public CoroRunnable<ContextT>
+{
+  public:
+    using source_fn_t = std::function<coroutines::Task<void>(coroutines::RingBuffer<T>&)>;
+
+    template <typename SourceFnT>
+    CoroSource(SourceFnT&& source_fn,
+               std::shared_ptr<coroutines::ThreadPool> thread_pool = nullptr,
+               std::size_t buffer_size                             = 64) :
+      CoroRunnable<ContextT>(std::move(thread_pool)),
+      m_source_fn(make_source_fn(std::forward<SourceFnT>(source_fn))),
+      m_buffer({.capacity = buffer_size})
+    {}
+
+    ~CoroSource() override = default;
+
+  private:
+    template <typename SourceFnT>
+    static source_fn_t make_source_fn(SourceFnT&& source_fn)
+    {
+        if constexpr (std::is_invocable_r_v<coroutines::Generator<T>, SourceFnT>)
+        {
+            return [generator_fn = std::forward<SourceFnT>(source_fn)](
+                       coroutines::RingBuffer<T>& buffer) -> coroutines::Task<void> {
+                for (auto&& value : generator_fn())
+                {
+                    if (co_await buffer.write(std::move(value)) != coroutines::RingBufferOpStatus::Success)
+                    {
+                        break;
+                    }
+                }
+            };
+        }
+        else
+        {
+            return source_fn_t(std::forward<SourceFnT>(source_fn));
+        }
+    }
+
+    coroutines::Task<void> produce()
+    {
+        co_await this->thread_pool().schedule();
+        try
+        {
+            co_await m_source_fn(m_buffer);
+        } catch (...)
+        {
+            this->set_exception(std::current_exception());
+        }
+        m_buffer.close();
+    }
+
+    void do_run(ContextT& /*ctx*/) final
+    {
+        boost::fibers::fiber writer([this] {
+            while (true)
+            {
+                auto data = fiber_await(m_buffer.read());
+                if (!data)
+                {
+                    break;
+                }
+                SourceChannel<T>::await_write(std::move(*data));
+            }
+        });
+
+        fiber_await(produce());
+        writer.join();
+    }
+
+    void on_shutdown_critical_section() final
+    {
+        SourceChannel<T>::release_channel();
+    }
+
+    void on_stop(bool /*kill*/) final
+    {
+        m_buffer.close();
+    }
+
+    source_fn_t m_source_fn;
+    coroutines::RingBuffer<T> m_buffer;
+};
+
+}  // namespace mrc::node
@@ -0,0 +1,199 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "mrc/channel/status.hpp"
+#include "mrc/node/forward.hpp"
+#include "mrc/node/source_channel.hpp"
+#include "mrc/runnable/context.hpp"
+#include "mrc/runnable/runnable.hpp"
+
+#include <boost/fiber/operations.hpp>
+#include <glog/logging.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <span>
+#include <utility>
+#include <vector>
+
+namespace mrc::node {
+
+struct DemandSourceOptions
+{
+    // demand requested when the downstream edge does not report its capacity, e.g. unbounded channels and operators
+    std::size_t default_demand{64};
+    // upper bound of a single request
+    std::size_t max_demand{1024};
+    // smallest request; the source waits for at least this much downstream capacity before fetching
+    std::size_t min_demand{1};
+    // longest sleep between polls of the downstream capacity while it is below min_demand
+    std::chrono::microseconds max_backoff{1000};
+};
+
+/**
+ * @brief Source node fetching its data in batches sized by the demand of its downstream edge
+ *
+ * Unlike RxSource, which only observes backpressure once a write blocks, the source is told how much it may fetch
+ * before fetching: each request(n) passes the free capacity of the downstream channel, split across the engines of the
+ * source and clamped to [min_demand, max_demand], to the fetch function, which appends at most n values to the batch.
+ * The batch is written downstream with a single await_write_n. Sources reading from brokers or databases can size
+ * their reads to the capacity of the pipeline rather than over-reading and blocking on the writes.
+ *
+ * While the downstream capacity is below min_demand the source polls it with a backoff of yields and sleeps of up to
+ * max_backoff. Downstream edges which do not report their capacity are requested default_demand values at a time and
+ * backpressure the source through the blocking writes as usual.
+ *
+ * The fetch function returns false once the upstream is exhausted; the values appended by that call are still
+ * written. Stopping the source ends the requests once the current fetch returns. Exceptions thrown by the fetch
+ * function are reported to the runtime context and complete the source.
+ */
+template <typename T, typename ContextT>
+class DemandSource : public SourceChannel<T>, public runnable::RunnableWithContext<ContextT>
+{
+  public:
+    // appends at most n values to batch; returns false once the upstream is exhausted
+    using fetch_fn_t = std::function<bool(std::size_t n, std::vector<T>& batch)>;
+
+    DemandSource(fetch_fn_t fetch_fn, DemandSourceOptions options = {}) :
+      m_fetch_fn(std::move(fetch_fn)),
+      m_options(options)
+    {
+        CHECK(m_fetch_fn);
+        CHECK_GT(m_options.default_demand, 0);
+        CHECK_GT(m_options.min_demand, 0);
+        CHECK_LE(m_options.min_demand, m_options.max_demand);
+    }
+
+    ~DemandSource() override = default;
+
+    const DemandSourceOptions& options() const
+    {
+        return m_options;
+    }
+
+    // values requested from and fetched by the fetch function across all engines
+    std::uint64_t requested_count() const
+    {
+        return m_requested.load(std::memory_order_relaxed);
+    }
+
+    std::uint64_t fetched_count() const
+    {
+        return m_fetched.load(std::memory_order_relaxed);
+    }
+
+  private:
+    // the demand of the next request of an engine; 0 if the source was stopped while waiting for capacity
+    std::size_t await_demand(std::size_t engines)
+    {
+        auto backoff = std::chrono::microseconds(1);
+        while (!m_stopped.load(std::memory_order_relaxed))
+        {
+            auto capacity = SourceChannel<T>::writable_capacity();
+            if (!capacity)
+            {
+                return m_options.default_demand;
+            }
+
+            // engines share the capacity; the last slots are requested by a single engine rather than by none
+            auto demand = std::min(*capacity / engines, m_options.max_demand);
+            if (demand == 0 && *capacity > 0)
+            {
+                demand = 1;
+            }
+            if (demand >= m_options.min_demand)
+            {
+                return demand;
+            }
+
+            if (backoff.count() == 1)
+            {
+                boost::this_fiber::yield();
+            }
+            else
+            {
+                boost::this_fiber::sleep_for(backoff);
+            }
+            backoff = std::min(backoff * 2, m_options.max_backoff);
+        }
+        return 0;
+    }
+
+    void run(ContextT& ctx) final
+    {
+        try
+        {
+            std::vector<T> batch;
+            bool more = true;
+            while (more)
+            {
+                auto n = await_demand(ctx.size());
+                if (n == 0)
+                {
+                    break;
+                }
+
+                batch.clear();
+                batch.reserve(n);
+                m_requested.fetch_add(n, std::memory_order_relaxed);
+                more = m_fetch_fn(n, batch);
+                DCHECK_LE(batch.size(), n) << ctx.info() << " fetched more values than were requested";
+                m_fetched.fetch_add(batch.size(), std::memory_order_relaxed);
+
+                if (!batch.empty() &&
+                    SourceChannel<T>::await_write_n(std::span<T>(batch)) != channel::Status::success)
+                {
+                    break;
+                }
+            }
+        } catch (...)
+        {
+            ctx.set_exception(std::current_exception());
+        }
+
+        ctx.barrier();
+        if (ctx.rank() == 0)
+        {
+            DVLOG(10) << ctx.info() << " demand source releasing its downstream channel; fetched " << fetched_count();
+            SourceChannel<T>::release_channel();
+        }
+    }
+
+    void on_state_update(const runnable::Runnable::State& state) final
+    {
+        if (state == runnable::Runnable::State::Stop || state == runnable::Runnable::State::Kill)
+        {
+            m_stopped.store(true, std::memory_order_relaxed);
+        }
+    }
+
+    const fetch_fn_t m_fetch_fn;
+    const DemandSourceOptions m_options;
+
+    std::atomic<bool> m_stopped{false};
+    std::atomic<std::uint64_t> m_requested{0};
+    std::atomic<std::uint64_t> m_fetched{0};
+};
+
+}  // namespace mrc::node
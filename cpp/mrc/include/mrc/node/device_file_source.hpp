@@ -0,0 +1,77 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "mrc/coroutines/ring_buffer.hpp"
+#include "mrc/coroutines/thread_pool.hpp"
+#include "mrc/io/device_file.hpp"
+#include "mrc/memory/resources/memory_resource.hpp"
+#include "mrc/node/coro_source.hpp"
+#include "mrc/node/forward.hpp"
+
+#include <memory>
+#include <string>
+#include <utility>
+
+namespace mrc::node {
+
+/**
+ * @brief Source node emitting the io::DeviceChunks of a file, read into device memory by an io::DeviceFileReader
+ *
+ * With GPUDirect Storage the bytes move from the storage device into device memory without a host bounce, leaving the
+ * cpus of the pipeline to other stages; DeviceFileReaderOptions::read_ahead reads are in flight while downstream
+ * kernels consume the previous chunks on their own streams. Chunks are allocated from the device memory resource, e.g.
+ * the arena resource of the partition of the device.
+ *
+ * The file is opened when the node is constructed.
+ */
+template <typename ContextT>
+class DeviceFileSource : public CoroSource<io::DeviceChunk, ContextT>
+{
+  public:
+    DeviceFileSource(std::string path,
+                     std::shared_ptr<memory::memory_resource> device_memory_resource,
+                     io::DeviceFileReaderOptions options                 = {},
+                     std::shared_ptr<coroutines::ThreadPool> thread_pool = nullptr) :
+      DeviceFileSource(
+          std::make_shared<io::DeviceFileReader>(std::move(path), options, std::move(device_memory_resource)),
+          std::move(thread_pool))
+    {}
+
+    ~DeviceFileSource() override = default;
+
+    const io::DeviceFileReader& reader() const
+    {
+        return *m_reader;
+    }
+
+  private:
+    // every buffered chunk holds a device buffer of chunk_size, so only a single round of read-ahead is buffered
+    DeviceFileSource(std::shared_ptr<io::DeviceFileReader> reader,
+                     std::shared_ptr<coroutines::ThreadPool> thread_pool) :
+      CoroSource<io::DeviceChunk, ContextT>(
+          [reader](coroutines::RingBuffer<io::DeviceChunk>& output) { return reader->read(output); },
+          std::move(thread_pool),
+          reader->options().read_ahead),
+      m_reader(std::move(reader))
+    {}
+
+    std::shared_ptr<io::DeviceFileReader> m_reader;
+};
+
+}  // namespace mrc::node
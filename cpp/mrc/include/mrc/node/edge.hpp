@@ -25,7 +25,11 @@
 
 #include <glog/logging.h>
 
+#include <cstddef>
 #include <memory>
+#include <optional>
+#include <span>
+#include <type_traits>
 #include <utility>
 
 namespace mrc::node {
@@ -52,6 +56,11 @@ class EdgeBase : public channel::Ingress<SourceT>
         return *m_ingress;
     }
 
+    inline const channel::Ingress<SinkT>& ingress() const
+    {
+        return *m_ingress;
+    }
+
   private:
     std::shared_ptr<channel::Ingress<SinkT>> m_ingress;
 };
@@ -74,6 +83,25 @@ struct Edge<SourceT, SinkT, std::enable_if_t<std::is_convertible_v<SourceT, Sink
     {
         return this->ingress().await_write(std::move(data));
     }
+
+    inline channel::Status await_write_n(std::span<SourceT> values) final
+    {
+        if constexpr (std::is_same_v<SourceT, SinkT>)
+        {
+            // no conversion required, forward the batch intact
+            return this->ingress().await_write_n(values);
+        }
+        else
+        {
+            return channel::Ingress<SourceT>::await_write_n(values);
+        }
+    }
+
+    // each value is converted into a single value of the sink
+    std::optional<std::size_t> writable_capacity() const final
+    {
+        return this->ingress().writable_capacity();
+    }
 };
 
 }  // namespace mrc::node
@@ -17,11 +17,14 @@
 
 #pragma once
 
+#include "mrc/node/edge_registry.hpp"
+
 #include <functional>
 #include <map>
 #include <memory>
 #include <mutex>
 #include <typeindex>
+#include <utility>
 
 namespace mrc::channel {
 struct IngressHandle;
@@ -51,6 +54,24 @@ struct EdgeAdapterRegistry
     using sink_adapter_fn_t = std::function<std::shared_ptr<channel::IngressHandle>(
         std::type_index, mrc::node::SinkPropertiesBase&, std::shared_ptr<channel::IngressHandle>)>;
 
+    using plan_key_t = std::pair<std::type_index, std::type_index>;
+
+    /**
+     * @brief Strategy resolved by EdgeBuilder for connecting a source type to a sink type. Plans are cached per
+     * (source type, sink type) so the adapter and converter registries are only searched for the first edge between
+     * each pair of types; registering an adapter or converter clears the cached plans.
+     */
+    struct ConversionPlan
+    {
+        // adapter which built the ingress for the first edge; null if none is registered or it declined the types
+        source_adapter_fn_t source_adapter;
+        sink_adapter_fn_t sink_adapter;
+
+        // converter wrapping the sink ingress when no adapter applies; null if the types match and no converter is
+        // registered, in which case the sink ingress is used as is
+        EdgeRegistry::build_fn_t converter;
+    };
+
     EdgeAdapterRegistry() = delete;
 
     /**
@@ -77,9 +98,31 @@ struct EdgeAdapterRegistry
     static source_adapter_fn_t find_source_adapter(std::type_index source_type);
     static sink_adapter_fn_t find_sink_adapter(std::type_index sink_type);
 
+    /**
+     * @brief Cached plans for edges resolved by source adapters (ingress_adapter_for_sink) or sink adapters
+     * (ingress_for_source_type); null if no plan has been cached for the types
+     */
+    static std::shared_ptr<const ConversionPlan> find_source_plan(std::type_index source_type,
+                                                                  std::type_index sink_type);
+    static std::shared_ptr<const ConversionPlan> find_sink_plan(std::type_index source_type,
+                                                                std::type_index sink_type);
+
+    static void cache_source_plan(std::type_index source_type,
+                                  std::type_index sink_type,
+                                  std::shared_ptr<const ConversionPlan> plan);
+    static void cache_sink_plan(std::type_index source_type,
+                                std::type_index sink_type,
+                                std::shared_ptr<const ConversionPlan> plan);
+
+    // called whenever an adapter or converter is registered
+    static void clear_plans();
+
     static std::map<std::type_index, source_adapter_fn_t> registered_source_adapters;
     static std::map<std::type_index, sink_adapter_fn_t> registered_sink_adapters;
 
+    static std::map<plan_key_t, std::shared_ptr<const ConversionPlan>> cached_source_plans;
+    static std::map<plan_key_t, std::shared_ptr<const ConversionPlan>> cached_sink_plans;
+
     static std::recursive_mutex s_mutex;
 };
 }  // namespace mrc::node
@@ -47,7 +47,8 @@ struct EdgeBuilder final
 {
     /**
      * @brief Attempt to look-up a registered ingress adapter given the source and sink properties. If one exists
-     * use it, otherwise fall back to the default adapter lookup.
+     * use it, otherwise fall back to the default adapter lookup. The lookup is resolved once per pair of source and
+     * sink types and cached in the EdgeAdapterRegistry until a new adapter or converter is registered.
      * @param source
      * @param sink
      * @param ingress_handle
@@ -0,0 +1,292 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2021-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "mrc/channel/ingress.hpp"
+#include "mrc/channel/status.hpp"
+#include "mrc/node/forward.hpp"
+#include "mrc/node/sink_properties.hpp"
+#include "mrc/node/source_channel.hpp"
+#include "mrc/runnable/context.hpp"
+#include "mrc/runnable/runnable.hpp"
+
+#include <boost/fiber/condition_variable.hpp>
+#include <boost/fiber/mutex.hpp>
+#include <glog/logging.h>
+
+#include <cstddef>
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <utility>
+#include <vector>
+
+namespace mrc::node {
+
+struct FairMuxerInputOptions
+{
+    // number of elements dequeued from the input at a time before moving on to the next input with queued elements
+    std::size_t weight{1};
+
+    // number of elements the input may queue before its writers block
+    std::size_t capacity{64};
+};
+
+/**
+ * @brief Merges several inputs into a single output, dequeuing from the inputs in weighted round-robin order
+ *
+ * Unlike Muxer, which forwards elements in the order the upstream writers reach it, each input of a FairMuxer has its
+ * own bounded queue, so a chatty input blocks on its own capacity while the other inputs keep their share of the
+ * output. Up to weight elements are taken from an input per turn; with the default weights of 1 the inputs are served
+ * round-robin.
+ *
+ * Inputs are created by input(idx) before the node is started. The output completes once the edges of all inputs have
+ * been released and their queues drained. Only the rank 0 context drives the node.
+ */
+template <typename T, typename ContextT = runnable::Context>
+class FairMuxer : public SourceChannel<T>, public runnable::RunnableWithContext<ContextT>
+{
+    struct Queue
+    {
+        FairMuxerInputOptions options;
+        std::deque<T> data;
+        boost::fibers::condition_variable writable;
+        bool connected{false};
+        bool closed{false};
+    };
+
+    // shared with the ingresses of the inputs, which may outlive the node
+    struct State
+    {
+        channel::Status write(Queue& queue, T&& data)
+        {
+            std::unique_lock<decltype(mutex)> lock(mutex);
+            queue.writable.wait(lock, [this, &queue] { return killed || queue.data.size() < queue.options.capacity; });
+            if (killed)
+            {
+                return channel::Status::closed;
+            }
+            queue.data.push_back(std::move(data));
+            lock.unlock();
+            readable.notify_one();
+            return channel::Status::success;
+        }
+
+        void close(Queue& queue)
+        {
+            {
+                std::lock_guard<decltype(mutex)> lock(mutex);
+                queue.closed = true;
+            }
+            readable.notify_one();
+        }
+
+        boost::fibers::mutex mutex;
+        boost::fibers::condition_variable readable;
+        std::map<std::size_t, std::unique_ptr<Queue>> queues;
+        bool killed{false};
+    };
+
+    class InputIngress : public channel::Ingress<T>
+    {
+      public:
+        InputIngress(std::shared_ptr<State> state, Queue& queue) : m_state(std::move(state)), m_queue(queue) {}
+        ~InputIngress() override
+        {
+            m_state->close(m_queue);
+        }
+
+        channel::Status await_write(T&& data) final
+        {
+            return m_state->write(m_queue, std::move(data));
+        }
+
+      private:
+        std::shared_ptr<State> m_state;
+        Queue& m_queue;
+    };
+
+    class Input : public SinkProperties<T>
+    {
+      public:
+        Input(std::shared_ptr<State> state, Queue& queue) : m_state(std::move(state)), m_queue(queue) {}
+
+      private:
+        // all edges to an input share its ingress; the input closes once the last of them is released
+        std::shared_ptr<channel::Ingress<T>> channel_ingress() final
+        {
+            auto ingress = m_ingress.lock();
+            if (!ingress)
+            {
+                std::lock_guard<decltype(m_state->mutex)> lock(m_state->mutex);
+                CHECK(!m_queue.connected) << "edges to a fair muxer input must be made before the input completes";
+                m_queue.connected = true;
+                ingress           = std::make_shared<InputIngress>(m_state, m_queue);
+                m_ingress         = ingress;
+            }
+            return ingress;
+        }
+
+        std::shared_ptr<State> m_state;
+        Queue& m_queue;
+        std::weak_ptr<InputIngress> m_ingress;
+    };
+
+  public:
+    FairMuxer(FairMuxerInputOptions default_options = {}) :
+      m_default_options(default_options),
+      m_state(std::make_shared<State>())
+    {}
+
+    ~FairMuxer() override = default;
+
+    /**
+     * @brief Sink of the input idx; the input is created with options on first use
+     */
+    SinkProperties<T>& input(std::size_t idx, FairMuxerInputOptions options)
+    {
+        CHECK_GT(options.weight, 0);
+        CHECK_GT(options.capacity, 0);
+
+        auto search = m_inputs.find(idx);
+        if (search != m_inputs.end())
+        {
+            return *search->second;
+        }
+
+        std::lock_guard<decltype(m_state->mutex)> lock(m_state->mutex);
+        auto& queue    = m_state->queues[idx];
+        queue          = std::make_unique<Queue>();
+        queue->options = options;
+        return *(m_inputs[idx] = std::make_unique<Input>(m_state, *queue));
+    }
+
+    SinkProperties<T>& input(std::size_t idx)
+    {
+        return input(idx, m_default_options);
+    }
+
+    std::size_t input_count() const
+    {
+        return m_inputs.size();
+    }
+
+  private:
+    // the next element in weighted round-robin order; nullopt once all inputs have completed and drained
+    std::optional<T> next()
+    {
+        std::unique_lock<decltype(m_state->mutex)> lock(m_state->mutex);
+        auto& queues = m_state->queues;
+
+        while (true)
+        {
+            if (m_state->killed)
+            {
+                return std::nullopt;
+            }
+
+            bool open = false;
+            for (std::size_t i = 0; i < queues.size(); ++i)
+            {
+                if (m_cursor == queues.end())
+                {
+                    m_cursor  = queues.begin();
+                    m_credits = m_cursor->second->options.weight;
+                }
+
+                auto& queue = *m_cursor->second;
+                if (!queue.data.empty())
+                {
+                    auto data = std::move(queue.data.front());
+                    queue.data.pop_front();
+                    queue.writable.notify_one();
+
+                    if (--m_credits == 0 || queue.data.empty())
+                    {
+                        advance();
+                    }
+                    return std::move(data);
+                }
+
+                open |= (queue.connected && !queue.closed);
+                advance();
+            }
+
+            if (!open)
+            {
+                return std::nullopt;
+            }
+
+            m_state->readable.wait(lock);
+        }
+    }
+
+    void advance()
+    {
+        if (++m_cursor == m_state->queues.end())
+        {
+            m_cursor = m_state->queues.begin();
+        }
+        m_credits = m_cursor->second->options.weight;
+    }
+
+    void run(ContextT& ctx) final
+    {
+        if (ctx.rank() == 0)
+        {
+            m_cursor = m_state->queues.end();
+            while (auto data = next())
+            {
+                SourceChannel<T>::await_write(std::move(*data));
+            }
+
+            DVLOG(10) << ctx.info() << " fair muxer releasing its downstream channel";
+            SourceChannel<T>::release_channel();
+        }
+        ctx.barrier();
+    }
+
+    void on_state_update(const runnable::Runnable::State& state) final
+    {
+        // a stopped muxer drains its inputs to completion; a killed muxer drops the queued elements
+        if (state == runnable::Runnable::State::Kill)
+        {
+            {
+                std::lock_guard<decltype(m_state->mutex)> lock(m_state->mutex);
+                m_state->killed = true;
+                for (auto& [idx, queue] : m_state->queues)
+                {
+                    queue->writable.notify_all();
+                }
+            }
+            m_state->readable.notify_all();
+        }
+    }
+
+    const FairMuxerInputOptions m_default_options;
+    std::shared_ptr<State> m_state;
+    std::map<std::size_t, std::unique_ptr<Input>> m_inputs;
+
+    // accessed by the driving context only
+    typename std::map<std::size_t, std::unique_ptr<Queue>>::iterator m_cursor;
+    std::size_t m_credits{0};
+};
+
+}  // namespace mrc::node
@@ -0,0 +1,69 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "mrc/coroutines/io_scheduler.hpp"
+#include "mrc/io/file.hpp"
+#include "mrc/node/coro_runnable.hpp"
+#include "mrc/node/forward.hpp"
+#include "mrc/node/rx_sink.hpp"
+
+#include <rxcpp/rx.hpp>
+
+#include <memory>
+#include <string>
+#include <utility>
+
+namespace mrc::node {
+
+/**
+ * @brief Sink node writing the bytes of each element to a file with an io::FileWriter
+ *
+ * Elements are converted with io::as_bytes, e.g. io::FileChunk or std::string; no separators are added. Bytes are
+ * written in chunks of FileWriterOptions::chunk_size issued on an IoScheduler, which park the sink's fiber rather than
+ * blocking its thread. The file is closed, writing the staged tail, when the upstream edges complete.
+ *
+ * The file is opened when the node is constructed; the node owns an IoScheduler unless one is provided.
+ */
+template <typename T, typename ContextT>
+class FileSink : public RxSink<T, ContextT>
+{
+  public:
+    FileSink(std::string path,
+             io::FileWriterOptions options                      = {},
+             std::shared_ptr<coroutines::IoScheduler> scheduler = nullptr) :
+      m_writer(std::make_shared<io::FileWriter>(
+          std::move(path), options, scheduler ? std::move(scheduler) : std::make_shared<coroutines::IoScheduler>()))
+    {
+        RxSink<T, ContextT>::set_observer(rxcpp::make_observer_dynamic<T>(
+            [writer = m_writer](T data) { fiber_await(writer->write(io::as_bytes(data))); },
+            [writer = m_writer] { fiber_await(writer->close()); }));
+    }
+
+    ~FileSink() override = default;
+
+    const io::FileWriter& writer() const
+    {
+        return *m_writer;
+    }
+
+  private:
+    std::shared_ptr<io::FileWriter> m_writer;
+};
+
+}  // namespace mrc::node
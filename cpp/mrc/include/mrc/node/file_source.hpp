@@ -0,0 +1,77 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "mrc/coroutines/io_scheduler.hpp"
+#include "mrc/coroutines/ring_buffer.hpp"
+#include "mrc/coroutines/thread_pool.hpp"
+#include "mrc/io/file.hpp"
+#include "mrc/node/coro_source.hpp"
+#include "mrc/node/forward.hpp"
+
+#include <memory>
+#include <string>
+#include <utility>
+
+namespace mrc::node {
+
+/**
+ * @brief Source node emitting the io::FileChunks of a file, read by an io::FileReader
+ *
+ * Reads are issued on an IoScheduler, so the source holds no thread while it waits on the disk; with the default
+ * io_uring backend regular files are read asynchronously and read-ahead keeps FileReaderOptions::read_ahead reads in
+ * flight. Chunks hold whole records and view the read buffers, so downstream parsers consume them without copies.
+ *
+ * The file is opened when the node is constructed; the node owns an IoScheduler unless one is provided.
+ */
+template <typename ContextT>
+class FileSource : public CoroSource<io::FileChunk, ContextT>
+{
+  public:
+    FileSource(std::string path,
+               io::FileReaderOptions options                       = {},
+               std::shared_ptr<coroutines::IoScheduler> scheduler  = nullptr,
+               std::shared_ptr<coroutines::ThreadPool> thread_pool = nullptr) :
+      FileSource(std::make_shared<io::FileReader>(std::move(path),
+                                                  options,
+                                                  scheduler ? std::move(scheduler)
+                                                            : std::make_shared<coroutines::IoScheduler>()),
+                 std::move(thread_pool))
+    {}
+
+    ~FileSource() override = default;
+
+    const io::FileReader& reader() const
+    {
+        return *m_reader;
+    }
+
+  private:
+    // chunks of two rounds of read-ahead may be buffered ahead of the downstream edge
+    FileSource(std::shared_ptr<io::FileReader> reader, std::shared_ptr<coroutines::ThreadPool> thread_pool) :
+      CoroSource<io::FileChunk, ContextT>(
+          [reader](coroutines::RingBuffer<io::FileChunk>& output) { return reader->read(output); },
+          std::move(thread_pool),
+          2 * reader->options().read_ahead),
+      m_reader(std::move(reader))
+    {}
+
+    std::shared_ptr<io::FileReader> m_reader;
+};
+
+}  // namespace mrc::node
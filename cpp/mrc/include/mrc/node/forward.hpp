@@ -86,7 +86,52 @@ class GenericSink;
 template <typename T, typename ContextT = runnable::Context>
 class GenericSource;
 
+template <typename T, typename ContextT = runnable::Context>
+class CheckpointableSource;
+
+template <typename T, typename ContextT = runnable::Context>
+class AdmissionNode;
+
+template <typename InputT, typename OutputT, typename KeyT, typename ContextT = runnable::Context>
+class CachingNode;
+
+template <typename InputT, typename OutputT = InputT, typename ContextT = runnable::Context>
+class LazyNode;
+
 template <typename InputT, typename OutputT = InputT, typename ContextT = runnable::Context>
 class GenericNode;
 
+template <typename InputT, typename OutputT = InputT, typename ContextT = runnable::Context>
+class GenericBatchNode;
+
+template <typename ContextT = runnable::Context>
+class CoroRunnable;
+
+template <typename T, typename ContextT = runnable::Context>
+class CoroSource;
+
+template <typename T, typename ContextT = runnable::Context>
+class GeneratorSource;
+
+template <typename T, typename ContextT = runnable::Context>
+class DemandSource;
+
+template <typename InputT, typename OutputT = InputT, typename ContextT = runnable::Context>
+class CoroNode;
+
+template <typename ContextT = runnable::Context>
+class FileSource;
+
+template <typename T, typename ContextT = runnable::Context>
+class FileSink;
+
+template <typename ContextT = runnable::Context>
+class MappedFileSource;
+
+template <typename ContextT = runnable::Context>
+class DeviceFileSource;
+
+template <typename ContextT = runnable::Context>
+class StreamSource;
+
 }  // namespace mrc::node
@@ -0,0 +1,286 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "mrc/channel/status.hpp"
+#include "mrc/coroutines/async_generator.hpp"
+#include "mrc/coroutines/generator.hpp"
+#include "mrc/node/coro_runnable.hpp"
+#include "mrc/node/forward.hpp"
+#include "mrc/node/source_channel.hpp"
+#include "mrc/runnable/context.hpp"
+#include "mrc/runnable/runnable.hpp"
+
+#include <boost/fiber/condition_variable.hpp>
+#include <boost/fiber/fiber.hpp>
+#include <boost/fiber/mutex.hpp>
+#include <glog/logging.h>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+namespace mrc::node {
+
+struct GeneratorSourceOptions
+{
+    // number of values pulled ahead of the downstream edge; 0 pulls each value only once the previous one was written
+    std::size_t prefetch{0};
+};
+
+/**
+ * @brief Source node pulling its data from a coroutines::Generator<T> or coroutines::AsyncGenerator<T> on the fibers
+ * of its engine
+ *
+ * The generator is advanced only when a value is needed: without prefetch the next value is pulled once the previous
+ * one has been written to the downstream edge, so a source whose downstream is saturated does no work. With a prefetch
+ * of K, a second fiber keeps up to K values pulled ahead of the writes, overlapping the work of the generator with the
+ * backpressure of the edge while still bounding the work done ahead of the downstream. The body of an AsyncGenerator
+ * may co_await, e.g. schedule itself onto a ThreadPool, while the fiber pulling from it is parked.
+ *
+ * Each engine of the source invokes the generator function and drives a generator of its own. Stopping the source
+ * ends the pulls once the value being generated has been yielded. Exceptions thrown by the generator are reported to
+ * the runtime context and complete the source.
+ */
+template <typename T, typename ContextT>
+class GeneratorSource : public SourceChannel<T>, public runnable::RunnableWithContext<ContextT>
+{
+  public:
+    using pull_fn_t = std::function<std::optional<T>()>;
+
+    /**
+     * @param generator_fn Function returning either a coroutines::Generator<T> or a coroutines::AsyncGenerator<T>
+     */
+    template <typename GeneratorFnT>
+    GeneratorSource(GeneratorFnT&& generator_fn, GeneratorSourceOptions options = {}) :
+      m_make_pull_fn(make_pull_fn_factory(std::forward<GeneratorFnT>(generator_fn))),
+      m_options(options)
+    {}
+
+    ~GeneratorSource() override = default;
+
+    const GeneratorSourceOptions& options() const
+    {
+        return m_options;
+    }
+
+    // values pulled from the generators of all engines
+    std::uint64_t pulled_count() const
+    {
+        return m_pulled.load(std::memory_order_relaxed);
+    }
+
+  private:
+    template <typename GeneratorFnT>
+    static std::function<pull_fn_t()> make_pull_fn_factory(GeneratorFnT&& generator_fn)
+    {
+        if constexpr (std::is_invocable_r_v<coroutines::AsyncGenerator<T>, GeneratorFnT>)
+        {
+            return [generator_fn = std::forward<GeneratorFnT>(generator_fn)]() -> pull_fn_t {
+                auto generator = std::make_shared<coroutines::AsyncGenerator<T>>(generator_fn());
+                return [generator]() -> std::optional<T> {
+                    return fiber_await(generator->next());
+                };
+            };
+        }
+        else
+        {
+            static_assert(std::is_invocable_r_v<coroutines::Generator<T>, GeneratorFnT>,
+                          "GeneratorSource requires a function returning a Generator<T> or an AsyncGenerator<T>");
+
+            return [generator_fn = std::forward<GeneratorFnT>(generator_fn)]() -> pull_fn_t {
+                struct State
+                {
+                    coroutines::Generator<T> generator;
+                    typename coroutines::Generator<T>::iterator it;
+                    bool started{false};
+                };
+
+                auto state = std::make_shared<State>(State{generator_fn()});
+                return [state]() -> std::optional<T> {
+                    // the body runs to its first co_yield only once the first value is pulled
+                    if (state->started)
+                    {
+                        ++state->it;
+                    }
+                    else
+                    {
+                        state->it      = state->generator.begin();
+                        state->started = true;
+                    }
+
+                    if (state->it == state->generator.end())
+                    {
+                        return std::nullopt;
+                    }
+                    return std::optional<T>(std::move(*state->it));
+                };
+            };
+        }
+    }
+
+    std::optional<T> pull(pull_fn_t& pull_fn)
+    {
+        if (m_stopped.load(std::memory_order_relaxed))
+        {
+            return std::nullopt;
+        }
+
+        auto value = pull_fn();
+        if (value)
+        {
+            m_pulled.fetch_add(1, std::memory_order_relaxed);
+        }
+        return value;
+    }
+
+    void run_unbuffered(pull_fn_t& pull_fn)
+    {
+        while (auto value = pull(pull_fn))
+        {
+            if (SourceChannel<T>::await_write(std::move(*value)) != channel::Status::success)
+            {
+                break;
+            }
+        }
+    }
+
+    // a prefetch fiber pulls into a queue of at most prefetch values while this fiber writes them downstream
+    void run_prefetched(pull_fn_t& pull_fn)
+    {
+        boost::fibers::mutex mutex;
+        boost::fibers::condition_variable cv;
+        std::deque<T> prefetched;
+        bool done   = false;
+        bool closed = false;
+        std::exception_ptr exception;
+
+        boost::fibers::fiber prefetch([&] {
+            try
+            {
+                while (true)
+                {
+                    {
+                        std::unique_lock<boost::fibers::mutex> lock(mutex);
+                        cv.wait(lock, [&] { return closed || prefetched.size() < m_options.prefetch; });
+                        if (closed)
+                        {
+                            break;
+                        }
+                    }
+
+                    auto value = pull(pull_fn);
+                    if (!value)
+                    {
+                        break;
+                    }
+
+                    std::lock_guard<boost::fibers::mutex> lock(mutex);
+                    prefetched.push_back(std::move(*value));
+                    cv.notify_all();
+                }
+            } catch (...)
+            {
+                exception = std::current_exception();
+            }
+
+            std::lock_guard<boost::fibers::mutex> lock(mutex);
+            done = true;
+            cv.notify_all();
+        });
+
+        while (true)
+        {
+            std::unique_lock<boost::fibers::mutex> lock(mutex);
+            cv.wait(lock, [&] { return done || !prefetched.empty(); });
+            if (prefetched.empty())
+            {
+                break;
+            }
+
+            auto value = std::move(prefetched.front());
+            prefetched.pop_front();
+            cv.notify_all();
+            lock.unlock();
+
+            if (SourceChannel<T>::await_write(std::move(value)) != channel::Status::success)
+            {
+                lock.lock();
+                closed = true;
+                cv.notify_all();
+                break;
+            }
+        }
+
+        prefetch.join();
+        if (exception)
+        {
+            std::rethrow_exception(exception);
+        }
+    }
+
+    void run(ContextT& ctx) final
+    {
+        try
+        {
+            auto pull_fn = m_make_pull_fn();
+            if (m_options.prefetch == 0)
+            {
+                run_unbuffered(pull_fn);
+            }
+            else
+            {
+                run_prefetched(pull_fn);
+            }
+        } catch (...)
+        {
+            ctx.set_exception(std::current_exception());
+        }
+
+        ctx.barrier();
+        if (ctx.rank() == 0)
+        {
+            DVLOG(10) << ctx.info() << " generator source releasing its downstream channel; pulled " << pulled_count();
+            SourceChannel<T>::release_channel();
+        }
+    }
+
+    void on_state_update(const runnable::Runnable::State& state) final
+    {
+        if (state == runnable::Runnable::State::Stop || state == runnable::Runnable::State::Kill)
+        {
+            m_stopped.store(true, std::memory_order_relaxed);
+        }
+    }
+
+    const std::function<pull_fn_t()> m_make_pull_fn;
+    const GeneratorSourceOptions m_options;
+
+    std::atomic<bool> m_stopped{false};
+    std::atomic<std::uint64_t> m_pulled{0};
+};
+
+}  // namespace mrc::node
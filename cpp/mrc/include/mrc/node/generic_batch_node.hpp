@@ -0,0 +1,138 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2021-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "mrc/channel/status.hpp"
+#include "mrc/channel/types.hpp"
+#include "mrc/node/forward.hpp"
+#include "mrc/node/sink_channel.hpp"
+#include "mrc/node/source_channel.hpp"
+#include "mrc/runnable/context.hpp"
+#include "mrc/runnable/runnable.hpp"
+
+#include <glog/logging.h>
+
+#include <chrono>
+#include <cstddef>
+#include <span>
+#include <vector>
+
+namespace mrc::node {
+
+/**
+ * @brief Batch-mode counterpart of GenericNode whose hook receives all elements available in the channel at once
+ *
+ * Each iteration blocks for the first element, then drains up to max_batch_size elements without blocking further and
+ * hands them to on_data_batch as a contiguous span, so the node can apply vectorized or device kernels across the
+ * batch. The outputs appended by the hook are written downstream in bulk once it returns. Unlike Batcher, no latency
+ * is added waiting for a batch to fill by default: the batch size adapts to the backlog of the channel. With a non-zero
+ * max_latency, a batch keeps filling for at most max_latency after its first element was read.
+ *
+ * With more than one pe, each context drains its own batches from the shared upstream channel.
+ */
+template <typename InputT, typename OutputT, typename ContextT>
+class GenericBatchNode : public SinkChannel<InputT>,
+                         public SourceChannel<OutputT>,
+                         public runnable::RunnableWithContext<ContextT>
+{
+  public:
+    GenericBatchNode(std::size_t max_batch_size            = 256,
+                     std::chrono::microseconds max_latency = std::chrono::microseconds(0)) :
+      m_max_batch_size(max_batch_size),
+      m_max_latency(max_latency)
+    {
+        CHECK_GT(m_max_batch_size, 0);
+    }
+
+    ~GenericBatchNode() override = default;
+
+    std::size_t max_batch_size() const
+    {
+        return m_max_batch_size;
+    }
+
+    std::chrono::microseconds max_latency() const
+    {
+        return m_max_latency;
+    }
+
+  private:
+    virtual void on_data_batch(std::span<InputT> batch, std::vector<OutputT>& outputs) = 0;
+    virtual void on_completed(std::vector<OutputT>& outputs) {}
+
+    channel::Status write(std::vector<OutputT>& outputs)
+    {
+        auto rc = (outputs.empty() ? channel::Status::success : SourceChannel<OutputT>::await_write_n(outputs));
+        outputs.clear();
+        return rc;
+    }
+
+    channel::Status read(std::vector<InputT>& batch)
+    {
+        auto& egress = SinkChannel<InputT>::egress();
+        auto rc      = egress.await_read_n(batch, m_max_batch_size);
+        if (rc != channel::Status::success || m_max_latency.count() == 0)
+        {
+            return rc;
+        }
+
+        const channel::time_point_t deadline = channel::clock_t::now() + m_max_latency;
+        while (batch.size() < m_max_batch_size &&
+               egress.await_read_n(batch, m_max_batch_size - batch.size(), deadline) == channel::Status::success)
+        {}
+        return channel::Status::success;
+    }
+
+    void run(ContextT& ctx) final
+    {
+        std::vector<InputT> batch;
+        std::vector<OutputT> outputs;
+        batch.reserve(m_max_batch_size);
+        outputs.reserve(m_max_batch_size);
+
+        while (read(batch) == channel::Status::success)
+        {
+            on_data_batch(std::span<InputT>(batch), outputs);
+            batch.clear();
+            write(outputs);
+        }
+
+        on_completed(outputs);
+        write(outputs);
+
+        ctx.barrier();
+        if (ctx.rank() == 0)
+        {
+            DVLOG(10) << ctx.info() << " batch node releasing its downstream channel";
+            SourceChannel<OutputT>::release_channel();
+        }
+    }
+
+    void on_state_update(const runnable::Runnable::State& state) final
+    {
+        if (state == runnable::Runnable::State::Stop || state == runnable::Runnable::State::Kill)
+        {
+            SinkChannel<InputT>::disable_persistence();
+        }
+    }
+
+    const std::size_t m_max_batch_size;
+    const std::chrono::microseconds m_max_latency;
+};
+
+}  // namespace mrc::node
@@ -0,0 +1,202 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "mrc/channel/status.hpp"
+#include "mrc/channel/types.hpp"
+#include "mrc/node/forward.hpp"
+#include "mrc/node/sink_channel.hpp"
+#include "mrc/node/source_channel.hpp"
+#include "mrc/runnable/context.hpp"
+#include "mrc/runnable/runnable.hpp"
+
+#include <boost/fiber/mutex.hpp>
+#include <glog/logging.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <utility>
+
+namespace mrc::node {
+
+struct LazyNodeOptions
+{
+    // the map function is released once no element has arrived for idle_timeout; zero keeps it until completion
+    std::chrono::nanoseconds idle_timeout{0};
+};
+
+/**
+ * @brief Node which defers building its map function until the first element arrives and releases it when idle
+ *
+ * The factory is invoked on the first element rather than when the segment is built, so branches which rarely or
+ * never receive elements, such as the cases of a Router or a Conditional, neither pay for building their state at
+ * startup nor hold on to it, e.g. a loaded model or a connection pool, once idle. The map function owns that state;
+ * it is destroyed once idle_timeout passes without an element and built anew by the factory on the next one.
+ *
+ * All pes of the node share one map function, which must be safe to call concurrently if the node is launched with
+ * more than one engine. An element in flight keeps the map function alive while another engine releases it. If the
+ * factory or the map function throws, the exception is reported to the runtime context and the element is skipped.
+ */
+template <typename InputT, typename OutputT, typename ContextT>
+class LazyNode : public SinkChannel<InputT>,
+                 public SourceChannel<OutputT>,
+                 public runnable::RunnableWithContext<ContextT>
+{
+  public:
+    using map_fn_t     = std::function<OutputT(InputT&&)>;
+    using factory_fn_t = std::function<map_fn_t()>;
+
+    LazyNode(factory_fn_t factory_fn, LazyNodeOptions options = {}) :
+      m_factory_fn(std::move(factory_fn)),
+      m_options(options)
+    {
+        CHECK(m_factory_fn) << "LazyNode requires a factory";
+        CHECK_GE(m_options.idle_timeout.count(), 0);
+    }
+
+    ~LazyNode() override = default;
+
+    const LazyNodeOptions& options() const
+    {
+        return m_options;
+    }
+
+    // true while a map function built by the factory is held
+    bool is_built() const
+    {
+        return m_built.load(std::memory_order_acquire);
+    }
+
+    // number of times the factory was invoked
+    std::uint64_t build_count() const
+    {
+        return m_builds.load(std::memory_order_relaxed);
+    }
+
+    // number of times the map function was released after being idle
+    std::uint64_t release_count() const
+    {
+        return m_releases.load(std::memory_order_relaxed);
+    }
+
+  private:
+    std::shared_ptr<const map_fn_t> acquire()
+    {
+        std::lock_guard<boost::fibers::mutex> lock(m_mutex);
+        if (!m_map_fn)
+        {
+            auto map_fn = m_factory_fn();
+            CHECK(map_fn) << "LazyNode factory returned an empty map function";
+            m_map_fn = std::make_shared<const map_fn_t>(std::move(map_fn));
+            m_builds.fetch_add(1, std::memory_order_relaxed);
+            m_built.store(true, std::memory_order_release);
+        }
+        m_active_at = channel::clock_t::now();
+        return m_map_fn;
+    }
+
+    void touch()
+    {
+        std::lock_guard<boost::fibers::mutex> lock(m_mutex);
+        m_active_at = channel::clock_t::now();
+    }
+
+    // releases the map function unless an element arrived on any engine within the idle timeout
+    void release_if_idle()
+    {
+        std::lock_guard<boost::fibers::mutex> lock(m_mutex);
+        if (m_map_fn && channel::clock_t::now() - m_active_at >= m_options.idle_timeout)
+        {
+            m_map_fn.reset();
+            m_releases.fetch_add(1, std::memory_order_relaxed);
+            m_built.store(false, std::memory_order_release);
+        }
+    }
+
+    void run(ContextT& ctx) final
+    {
+        auto& egress        = SinkChannel<InputT>::egress();
+        const bool releases = m_options.idle_timeout.count() > 0;
+
+        InputT data;
+        while (true)
+        {
+            auto rc = (releases && is_built())
+                          ? egress.await_read_until(data, channel::clock_t::now() + m_options.idle_timeout)
+                          : egress.await_read(data);
+            if (rc == channel::Status::timeout)
+            {
+                release_if_idle();
+                continue;
+            }
+            if (rc != channel::Status::success)
+            {
+                break;
+            }
+
+            try
+            {
+                auto map_fn = acquire();
+                SourceChannel<OutputT>::await_write((*map_fn)(std::move(data)));
+                touch();
+            } catch (...)
+            {
+                ctx.set_exception(std::current_exception());
+            }
+        }
+
+        ctx.barrier();
+        if (ctx.rank() == 0)
+        {
+            DVLOG(10) << ctx.info() << " lazy node releasing its downstream channel; built " << build_count()
+                      << " times, released " << release_count() << " times";
+            {
+                std::lock_guard<boost::fibers::mutex> lock(m_mutex);
+                m_map_fn.reset();
+                m_built.store(false, std::memory_order_release);
+            }
+            SourceChannel<OutputT>::release_channel();
+        }
+    }
+
+    void on_state_update(const runnable::Runnable::State& state) final
+    {
+        if (state == runnable::Runnable::State::Stop || state == runnable::Runnable::State::Kill)
+        {
+            SinkChannel<InputT>::disable_persistence();
+        }
+    }
+
+    const factory_fn_t m_factory_fn;
+    const LazyNodeOptions m_options;
+
+    boost::fibers::mutex m_mutex;
+    std::shared_ptr<const map_fn_t> m_map_fn;
+    channel::time_point_t m_active_at{};
+
+    std::atomic<bool> m_built{false};
+    std::atomic<std::uint64_t> m_builds{0};
+    std::atomic<std::uint64_t> m_releases{0};
+};
+
+}  // namespace mrc::node
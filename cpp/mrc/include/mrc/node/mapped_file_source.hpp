@@ -0,0 +1,90 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "mrc/io/mapped_file.hpp"
+#include "mrc/node/forward.hpp"
+#include "mrc/node/generic_source.hpp"
+#include "mrc/runnable/context.hpp"
+
+#include <rxcpp/rx.hpp>
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <utility>
+
+namespace mrc::node {
+
+/**
+ * @brief Source node emitting io::MappedViews of whole records of a memory mapped file
+ *
+ * Each pe of the source emits the records of its own partition of the file, see io::MappedFile::partition, so the
+ * file is parsed by pe_count engines in parallel without any of them reading bytes of another. Views point into the
+ * mapping, which lives until the last view is destroyed; the page cache is the only copy of the file. The pages of the
+ * next view are prefetched while the current one is processed downstream.
+ *
+ * The file is mapped when the node is constructed; a fixed record file which ends in a partial record throws.
+ */
+template <typename ContextT>
+class MappedFileSource : public GenericSource<io::MappedView, ContextT>
+{
+  public:
+    MappedFileSource(const std::string& path, io::MappedFileOptions options = {}) :
+      m_file(io::MappedFile::open(path)),
+      m_options(options)
+    {
+        // validates the file against the record format
+        m_file->partition(m_options, 0, 1);
+    }
+
+    ~MappedFileSource() override = default;
+
+    const io::MappedFile& file() const
+    {
+        return *m_file;
+    }
+
+    const io::MappedFileOptions& options() const
+    {
+        return m_options;
+    }
+
+  private:
+    void data_source(rxcpp::subscriber<io::MappedView>& s) final
+    {
+        auto& context     = runnable::Context::get_runtime_context();
+        auto [begin, end] = m_file->partition(m_options, context.rank(), context.size());
+        auto chunk_end    = m_file->chunk_end(m_options, begin, end);
+
+        while (begin < end && s.is_subscribed())
+        {
+            auto next_end = m_file->chunk_end(m_options, chunk_end, end);
+            m_file->will_need(chunk_end, next_end - chunk_end);
+
+            s.on_next(io::MappedView(m_file, begin, chunk_end - begin));
+            begin     = chunk_end;
+            chunk_end = next_end;
+        }
+    }
+
+    std::shared_ptr<const io::MappedFile> m_file;
+    const io::MappedFileOptions m_options;
+};
+
+}  // namespace mrc::node
@@ -25,59 +25,373 @@
 #include "mrc/node/source_properties.hpp"
 #include "mrc/type_traits.hpp"
 
+#include <boost/fiber/condition_variable.hpp>
+#include <boost/fiber/fiber.hpp>
+#include <boost/fiber/mutex.hpp>
+#include <glog/logging.h>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <map>
 #include <memory>
+#include <mutex>
+#include <utility>
 #include <vector>
 
 namespace mrc::node {
 
-template <typename T>
-class Broadcast : public Operator<T>, public SourceProperties<T>
+/**
+ * @brief How a Broadcast hands elements to an output which lags behind the writer
+ */
+enum class BroadcastOverflowPolicy
+{
+    // the writer awaits the write to the output; outputs with this policy are written in order by the writer
+    Block,
+    // the output is written by its own fiber; elements are dropped for the output while it lags by capacity elements
+    Drop,
+    // the output is written by its own fiber; elements are buffered without bound while the output lags
+    Buffer,
+};
+
+struct BroadcastOutputOptions
+{
+    BroadcastOverflowPolicy policy{BroadcastOverflowPolicy::Block};
+
+    // maximum number of elements buffered for an output with the Drop policy
+    std::size_t capacity{128};
+};
+
+struct BroadcastOutputStatistics
+{
+    // elements accepted for the output which have not been written to it
+    std::size_t lag{0};
+    std::uint64_t written{0};
+    std::uint64_t dropped{0};
+};
+
+namespace detail {
+
+/**
+ * @brief Fans each element out to all outputs connected to the operator
+ *
+ * The outputs are indexed in the order their edges were made. Outputs with the Block policy are written in order by
+ * the writing fiber, the last of them receiving the element itself and the others a copy. Outputs with the Drop or
+ * Buffer policy never stall the writer: each is written by a fiber launched on the scheduler of the first writer, so
+ * slow taps only fall behind, or drop, on their own output.
+ */
+template <typename InputT, typename OutputT>
+class BroadcastBase : public Operator<InputT>, public SourceProperties<OutputT>
 {
   public:
-    Broadcast(bool deep_copy = false) : m_deep_copy(deep_copy) {}
-    ~Broadcast() = default;
+    ~BroadcastBase() override
+    {
+        close_lanes();
+    }
+
+    /**
+     * @brief Set the options of an output; must be called before the first element is written
+     */
+    void set_output_options(std::size_t output_idx, BroadcastOutputOptions options)
+    {
+        std::lock_guard<decltype(m_mutex)> lock(m_mutex);
+        CHECK(!m_started) << "broadcast output options must be set before the first element is written";
+        m_output_options[output_idx] = options;
+    }
+
+    /**
+     * @brief Set the options of the outputs without output specific options
+     */
+    void set_default_output_options(BroadcastOutputOptions options)
+    {
+        std::lock_guard<decltype(m_mutex)> lock(m_mutex);
+        CHECK(!m_started) << "broadcast output options must be set before the first element is written";
+        m_default_output_options = options;
+    }
+
+    BroadcastOutputStatistics output_statistics(std::size_t output_idx) const
+    {
+        std::lock_guard<decltype(m_mutex)> lock(m_mutex);
+        CHECK_LT(output_idx, m_outputs.size());
+        const auto& output = *m_outputs[output_idx];
+        BroadcastOutputStatistics stats;
+        stats.written = output.written.load(std::memory_order_relaxed);
+        stats.dropped = output.dropped.load(std::memory_order_relaxed);
+        if (output.lane)
+        {
+            std::lock_guard<decltype(output.lane->mutex)> lane_lock(output.lane->mutex);
+            stats.lag = output.lane->queue.size();
+        }
+        return stats;
+    }
+
+    std::size_t output_count() const
+    {
+        std::lock_guard<decltype(m_mutex)> lock(m_mutex);
+        return m_outputs.size();
+    }
 
   protected:
-    // Operator::on_next
-    channel::Status on_next(T&& data) override
+    channel::Status broadcast(OutputT&& data)
     {
-        for (int i = 1; i < m_output_channels.size(); ++i)
+        start_lanes();
+
+        for (auto* lane : m_lanes)
+        {
+            lane->push(copy(data));
+        }
+
+        if (m_blocking.empty())
         {
-            if constexpr (is_shared_ptr<T>::value)
+            return channel::Status::success;
+        }
+
+        for (std::size_t i = 0; i + 1 < m_blocking.size(); ++i)
+        {
+            CHECK(m_blocking[i]->write(copy(data)) == channel::Status::success);
+        }
+
+        return m_blocking.back()->write(std::move(data));
+    }
+
+  private:
+    // copy of an element handed to each output but the last blocking output
+    virtual OutputT copy(const OutputT& data)
+    {
+        return OutputT(data);
+    }
+
+    struct Lane;
+
+    struct Output
+    {
+        std::shared_ptr<channel::Ingress<OutputT>> ingress;
+        std::unique_ptr<Lane> lane;
+        std::atomic<std::uint64_t> written{0};
+        std::atomic<std::uint64_t> dropped{0};
+
+        channel::Status write(OutputT&& data)
+        {
+            auto rc = ingress->await_write(std::move(data));
+            if (rc == channel::Status::success)
             {
-                if (m_deep_copy)
+                written.fetch_add(1, std::memory_order_relaxed);
+            }
+            return rc;
+        }
+    };
+
+    // queue of the elements accepted for a non-blocking output, drained by a dedicated fiber
+    struct Lane
+    {
+        Lane(Output& output, BroadcastOutputOptions options) : output(output), options(options) {}
+
+        void push(OutputT&& data)
+        {
+            {
+                std::lock_guard<decltype(mutex)> lock(mutex);
+                if (closed || (options.policy == BroadcastOverflowPolicy::Drop && queue.size() >= options.capacity))
+                {
+                    output.dropped.fetch_add(1, std::memory_order_relaxed);
+                    return;
+                }
+                queue.push_back(std::move(data));
+            }
+            cv.notify_one();
+        }
+
+        void drain()
+        {
+            while (true)
+            {
+                std::unique_lock<decltype(mutex)> lock(mutex);
+                cv.wait(lock, [this] { return closed || !queue.empty(); });
+                if (queue.empty())
+                {
+                    return;
+                }
+                auto data = std::move(queue.front());
+                queue.pop_front();
+                lock.unlock();
+
+                if (output.write(std::move(data)) != channel::Status::success)
                 {
-                    auto deep_copy = std::make_shared<typename T::element_type>(*data);
-                    CHECK(m_output_channels[i]->await_write(std::move(deep_copy)) == channel::Status::success);
-                    continue;
+                    LOG(ERROR) << "broadcast output failed to accept a write; dropping the output";
+                    lock.lock();
+                    output.dropped.fetch_add(queue.size() + 1, std::memory_order_relaxed);
+                    queue.clear();
+                    closed = true;
+                    return;
                 }
             }
+        }
+
+        void close()
+        {
+            {
+                std::lock_guard<decltype(mutex)> lock(mutex);
+                closed = true;
+            }
+            cv.notify_one();
+        }
+
+        Output& output;
+        const BroadcastOutputOptions options;
+        mutable boost::fibers::mutex mutex;
+        boost::fibers::condition_variable cv;
+        std::deque<OutputT> queue;
+        bool closed{false};
+        boost::fibers::fiber fiber;
+    };
+
+    // launch the fibers of the non-blocking outputs on the scheduler of the first writer
+    void start_lanes()
+    {
+        if (m_started.load(std::memory_order_acquire))
+        {
+            return;
+        }
+
+        std::lock_guard<decltype(m_mutex)> lock(m_mutex);
+        if (m_started.load(std::memory_order_relaxed))
+        {
+            return;
+        }
+
+        for (std::size_t i = 0; i < m_outputs.size(); ++i)
+        {
+            auto& output = *m_outputs[i];
+            auto search  = m_output_options.find(i);
+            auto options = (search == m_output_options.end() ? m_default_output_options : search->second);
+
+            if (options.policy == BroadcastOverflowPolicy::Block)
+            {
+                m_blocking.push_back(&output);
+                continue;
+            }
 
-            T shallow_copy(data);
-            CHECK(m_output_channels[i]->await_write(std::move(shallow_copy)) == channel::Status::success);
+            auto lane   = std::make_unique<Lane>(output, options);
+            lane->fiber = boost::fibers::fiber([lane = lane.get()] { lane->drain(); });
+            m_lanes.push_back(lane.get());
+            output.lane = std::move(lane);
         }
 
-        return m_output_channels[0]->await_write(std::move(data));
+        m_started.store(true, std::memory_order_release);
+    }
+
+    // the lanes write the elements they have accepted before their fibers complete
+    void close_lanes()
+    {
+        for (auto* lane : m_lanes)
+        {
+            lane->close();
+        }
+        for (auto* lane : m_lanes)
+        {
+            if (lane->fiber.joinable())
+            {
+                lane->fiber.join();
+            }
+        }
+        m_lanes.clear();
     }
 
     // Operator::on_complete
     void on_complete() final
     {
-        VLOG(10) << "Closing broadcast with " << m_output_channels.size() << " downstream channels";
-        m_output_channels.clear();
+        VLOG(10) << "Closing broadcast with " << m_outputs.size() << " downstream channels";
+        close_lanes();
+        std::lock_guard<decltype(m_mutex)> lock(m_mutex);
+        m_blocking.clear();
+        for (auto& output : m_outputs)
+        {
+            output->ingress.reset();
+        }
     }
 
     void complete_edge(std::shared_ptr<channel::IngressHandle> ingress) override
     {
-        auto typed_ingress = std::dynamic_pointer_cast<channel::Ingress<T>>(ingress);
+        auto typed_ingress = std::dynamic_pointer_cast<channel::Ingress<OutputT>>(ingress);
 
         CHECK(typed_ingress) << "Invalid ingress type passed to broadcast";
 
-        m_output_channels.push_back(typed_ingress);
+        std::lock_guard<decltype(m_mutex)> lock(m_mutex);
+        CHECK(!m_started) << "edges from a broadcast must be made before the first element is written";
+        auto& output    = m_outputs.emplace_back(std::make_unique<Output>());
+        output->ingress = std::move(typed_ingress);
+    }
+
+    std::vector<std::unique_ptr<Output>> m_outputs;
+    std::map<std::size_t, BroadcastOutputOptions> m_output_options;
+    BroadcastOutputOptions m_default_output_options;
+
+    // set once on the first write, after which the following are immutable until on_complete
+    std::atomic<bool> m_started{false};
+    std::vector<Output*> m_blocking;
+    std::vector<Lane*> m_lanes;
+
+    mutable std::mutex m_mutex;
+};
+
+}  // namespace detail
+
+/**
+ * @brief Writes each element to all outputs
+ *
+ * Unless deep_copy is set, each output receives a copy of the element; with deep_copy, outputs of std::shared_ptr
+ * elements receive a copy of the pointed to object instead. Use SharedBroadcast to hand every output the same
+ * immutable payload.
+ */
+template <typename T>
+class Broadcast : public detail::BroadcastBase<T, T>
+{
+  public:
+    Broadcast(bool deep_copy = false) : m_deep_copy(deep_copy) {}
+    ~Broadcast() override = default;
+
+  protected:
+    // Operator::on_next
+    channel::Status on_next(T&& data) override
+    {
+        return this->broadcast(std::move(data));
+    }
+
+  private:
+    T copy(const T& data) final
+    {
+        if constexpr (is_shared_ptr<T>::value)
+        {
+            if (m_deep_copy)
+            {
+                return std::make_shared<typename T::element_type>(*data);
+            }
+        }
+        return T(data);
     }
 
-    std::vector<std::shared_ptr<channel::Ingress<T>>> m_output_channels;
     bool m_deep_copy;
 };
 
+/**
+ * @brief Wraps each element in a shared immutable handle once and writes the handle to all outputs
+ *
+ * Outputs share the payload rather than receiving a copy of it, so the cost of the fan-out is independent of the size
+ * of the element.
+ */
+template <typename T>
+class SharedBroadcast : public detail::BroadcastBase<T, std::shared_ptr<const T>>
+{
+  public:
+    SharedBroadcast()           = default;
+    ~SharedBroadcast() override = default;
+
+  protected:
+    // Operator::on_next
+    channel::Status on_next(T&& data) override
+    {
+        return this->broadcast(std::make_shared<const T>(std::move(data)));
+    }
+};
+
 }  // namespace mrc::node
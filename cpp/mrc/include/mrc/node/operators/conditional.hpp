@@ -20,6 +20,12 @@
 #include "mrc/node/operators/operator.hpp"
 #include "mrc/node/operators/router.hpp"
 
+#include <cstddef>
+#include <functional>
+#include <span>
+#include <utility>
+#include <vector>
+
 namespace mrc::node {
 
 template <typename T, typename CaseT>
@@ -43,4 +49,103 @@ class Conditional : public Operator<T>, public RouterBase<CaseT, T>
     std::function<CaseT(const T&)> m_predicate;
 };
 
+/**
+ * @brief Conditional over a dense table of cases
+ *
+ * The values of CaseT must be 0 through case_count - 1, e.g. an enum of consecutive cases; the edge of a case is found
+ * by indexing the table with the value of the predicate rather than by a lookup in a map.
+ */
+template <typename T, typename CaseT>
+class DenseConditional : public Operator<T>, public DenseRouterBase<CaseT, T>
+{
+  public:
+    DenseConditional(std::size_t case_count, std::function<CaseT(const T&)> predicate) :
+      DenseRouterBase<CaseT, T>(case_count),
+      m_predicate(std::move(predicate))
+    {}
+
+  private:
+    inline channel::Status on_next(T&& data) final
+    {
+        return this->channel_for_index(this->index_for_key(m_predicate(data))).await_write(std::move(data));
+    }
+
+    // Operator::on_release
+    void on_complete() final
+    {
+        DenseRouterBase<CaseT, T>::release_sources();
+    }
+
+    std::function<CaseT(const T&)> m_predicate;
+};
+
+/**
+ * @brief DenseConditional consuming batches of elements
+ *
+ * The cases of a batch are evaluated in one pass before any element is moved, either element-wise or by a batch
+ * predicate filling the case of each element, e.g. with a vectorized loop. The elements are then scattered into a
+ * batch per case, preserving their order, and each non-empty case batch is written to its edge with a single
+ * await_write_n. The case batches are reused across batches, so a steady stream allocates nothing.
+ */
+template <typename T, typename CaseT>
+class BatchConditional : public Operator<std::vector<T>>, public DenseRouterBase<CaseT, T>
+{
+  public:
+    using batch_predicate_fn_t = std::function<void(std::span<const T>, std::span<CaseT>)>;
+
+    BatchConditional(std::size_t case_count, std::function<CaseT(const T&)> predicate) :
+      BatchConditional(case_count, [predicate = std::move(predicate)](std::span<const T> data, std::span<CaseT> cases) {
+          for (std::size_t i = 0; i < data.size(); ++i)
+          {
+              cases[i] = predicate(data[i]);
+          }
+      })
+    {}
+
+    BatchConditional(std::size_t case_count, batch_predicate_fn_t predicate) :
+      DenseRouterBase<CaseT, T>(case_count),
+      m_predicate(std::move(predicate)),
+      m_batches(case_count)
+    {}
+
+  private:
+    inline channel::Status on_next(std::vector<T>&& data) final
+    {
+        m_cases.resize(data.size());
+        m_predicate(std::span<const T>(data), std::span<CaseT>(m_cases));
+
+        for (std::size_t i = 0; i < data.size(); ++i)
+        {
+            m_batches[this->index_for_key(m_cases[i])].push_back(std::move(data[i]));
+        }
+
+        auto status = channel::Status::success;
+        for (std::size_t index = 0; index < m_batches.size(); ++index)
+        {
+            auto& batch = m_batches[index];
+            if (!batch.empty())
+            {
+                auto batch_status = this->channel_for_index(index).await_write_n(std::span<T>(batch));
+                if (status == channel::Status::success)
+                {
+                    status = batch_status;
+                }
+                batch.clear();
+            }
+        }
+        return status;
+    }
+
+    // Operator::on_release
+    void on_complete() final
+    {
+        DenseRouterBase<CaseT, T>::release_sources();
+        m_batches.clear();
+    }
+
+    batch_predicate_fn_t m_predicate;
+    std::vector<CaseT> m_cases;
+    std::vector<std::vector<T>> m_batches;
+};
+
 }  // namespace mrc::node
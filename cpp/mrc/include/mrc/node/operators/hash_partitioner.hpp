@@ -0,0 +1,94 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2021-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "mrc/node/forward.hpp"
+#include "mrc/node/operators/operator.hpp"
+#include "mrc/node/source_channel.hpp"
+
+#include <glog/logging.h>
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace mrc::node {
+
+/**
+ * @brief Routes each element to one of a fixed number of partitions by the hash of a key extracted from the element
+ *
+ * Elements with equal keys are always routed to the same partition, so each partition may be consumed by its own
+ * downstream node holding the state of the keys of that partition. The partition of an element is computed from the
+ * hash of its key without any lookup. As with Router, elements of a partition without an edge are dropped.
+ */
+template <typename T, typename KeyT>
+class HashPartitioner : public Operator<T>
+{
+  public:
+    using key_fn_t  = std::function<KeyT(const T&)>;
+    using hash_fn_t = std::function<std::size_t(const KeyT&)>;
+
+    HashPartitioner(std::size_t partition_count, key_fn_t key_fn, hash_fn_t hash_fn = std::hash<KeyT>{}) :
+      m_key_fn(std::move(key_fn)),
+      m_hash_fn(std::move(hash_fn))
+    {
+        CHECK_GT(partition_count, 0) << "a hash partitioner requires at least one partition";
+        m_sources.reserve(partition_count);
+        for (std::size_t i = 0; i < partition_count; ++i)
+        {
+            m_sources.push_back(std::make_unique<SourceChannelWriteable<T>>());
+        }
+    }
+
+    SourceChannel<T>& source(std::size_t partition)
+    {
+        CHECK_LT(partition, m_sources.size());
+        return *m_sources[partition];
+    }
+
+    std::size_t partition_count() const
+    {
+        return m_sources.size();
+    }
+
+    std::size_t partition_for(const T& data) const
+    {
+        return m_hash_fn(m_key_fn(data)) % m_sources.size();
+    }
+
+  private:
+    // Operator::on_next
+    inline channel::Status on_next(T&& data) final
+    {
+        return m_sources[partition_for(data)]->await_write(std::move(data));
+    }
+
+    // Operator::on_complete
+    void on_complete() final
+    {
+        m_sources.clear();
+    }
+
+    key_fn_t m_key_fn;
+    hash_fn_t m_hash_fn;
+    std::vector<std::unique_ptr<SourceChannelWriteable<T>>> m_sources;
+};
+
+}  // namespace mrc::node
@@ -0,0 +1,345 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2021-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "mrc/channel/ingress.hpp"
+#include "mrc/channel/status.hpp"
+#include "mrc/channel/types.hpp"
+#include "mrc/node/forward.hpp"
+#include "mrc/node/sink_properties.hpp"
+#include "mrc/node/source_channel.hpp"
+
+#include <boost/fiber/mutex.hpp>
+#include <glog/logging.h>
+
+#include <chrono>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <tuple>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace mrc::node {
+
+struct JoinOptions
+{
+    // time an element is retained for matching against the elements of the other input
+    std::chrono::microseconds retention{1000000};
+
+    // elements of each input retained per key; the oldest element is evicted once exceeded
+    std::size_t max_entries_per_key{1024};
+};
+
+/**
+ * @brief Inner join of two streams on a key, emitting a (key, left, right) tuple for every pair of elements with equal
+ * keys which arrived within the retention of each other
+ *
+ * Matching happens on the fiber of the writer, so the join needs no engine of its own. Each element is retained for
+ * the retention period or until max_entries_per_key newer elements of its input and key arrived; evicted elements are
+ * handed to the evict_fn of their input, e.g. to emit the unmatched side of an outer join. The output completes once
+ * the edges to both inputs have been released, evicting all retained elements.
+ */
+template <typename KeyT, typename LeftT, typename RightT>
+class KeyedJoin : public SourceChannelWriteable<std::tuple<KeyT, LeftT, RightT>>
+{
+  public:
+    using output_t         = std::tuple<KeyT, LeftT, RightT>;
+    using left_key_fn_t    = std::function<KeyT(const LeftT&)>;
+    using right_key_fn_t   = std::function<KeyT(const RightT&)>;
+    using left_evict_fn_t  = std::function<void(const KeyT&, LeftT&&)>;
+    using right_evict_fn_t = std::function<void(const KeyT&, RightT&&)>;
+
+    KeyedJoin(left_key_fn_t left_key_fn,
+              right_key_fn_t right_key_fn,
+              JoinOptions options             = {},
+              left_evict_fn_t left_evict_fn   = nullptr,
+              right_evict_fn_t right_evict_fn = nullptr) :
+      m_left(*this, std::move(left_key_fn), std::move(left_evict_fn)),
+      m_right(*this, std::move(right_key_fn), std::move(right_evict_fn)),
+      m_options(options)
+    {
+        CHECK_GT(m_options.max_entries_per_key, 0);
+    }
+
+    ~KeyedJoin() override = default;
+
+    SinkProperties<LeftT>& left()
+    {
+        return m_left;
+    }
+
+    SinkProperties<RightT>& right()
+    {
+        return m_right;
+    }
+
+  private:
+    template <typename T>
+    struct Entry
+    {
+        channel::time_point_t time;
+        T value;
+    };
+
+    struct KeyState
+    {
+        std::deque<Entry<LeftT>> left;
+        std::deque<Entry<RightT>> right;
+    };
+
+    // elements evicted while holding the state lock; handed to the evict_fns once it is released
+    struct Evicted
+    {
+        std::vector<std::pair<KeyT, LeftT>> left;
+        std::vector<std::pair<KeyT, RightT>> right;
+    };
+
+    template <bool IsLeft>
+    using input_t = std::conditional_t<IsLeft, LeftT, RightT>;
+
+    template <bool IsLeft>
+    class Input : public SinkProperties<input_t<IsLeft>>
+    {
+        using T = input_t<IsLeft>;
+
+      public:
+        using key_fn_t   = std::function<KeyT(const T&)>;
+        using evict_fn_t = std::function<void(const KeyT&, T&&)>;
+
+        Input(KeyedJoin& parent, key_fn_t key_fn, evict_fn_t evict_fn) :
+          m_parent(parent),
+          m_key_fn(std::move(key_fn)),
+          m_evict_fn(std::move(evict_fn))
+        {
+            CHECK(m_key_fn) << "a keyed join requires a key_fn for each input";
+        }
+
+        KeyT key(const T& data) const
+        {
+            return m_key_fn(data);
+        }
+
+        void evict(std::vector<std::pair<KeyT, T>>& evicted) const
+        {
+            if (m_evict_fn)
+            {
+                for (auto& [key, value] : evicted)
+                {
+                    m_evict_fn(key, std::move(value));
+                }
+            }
+        }
+
+      private:
+        class Ingress : public channel::Ingress<T>
+        {
+          public:
+            Ingress(KeyedJoin& parent) : m_parent(parent) {}
+            ~Ingress() override
+            {
+                m_parent.on_input_complete();
+            }
+
+            channel::Status await_write(T&& data) final
+            {
+                return m_parent.template on_next<IsLeft>(std::move(data));
+            }
+
+          private:
+            KeyedJoin& m_parent;
+        };
+
+        // all edges to an input share its ingress; the input completes once the last of them is released
+        std::shared_ptr<channel::Ingress<T>> channel_ingress() final
+        {
+            auto ingress = m_ingress.lock();
+            if (!ingress)
+            {
+                m_parent.on_input_connected();
+                ingress   = std::make_shared<Ingress>(m_parent);
+                m_ingress = ingress;
+            }
+            return ingress;
+        }
+
+        KeyedJoin& m_parent;
+        key_fn_t m_key_fn;
+        evict_fn_t m_evict_fn;
+        std::weak_ptr<Ingress> m_ingress;
+    };
+
+    template <bool IsLeft>
+    channel::Status on_next(input_t<IsLeft>&& data)
+    {
+        auto& input = side<IsLeft>();
+
+        std::vector<output_t> matches;
+        Evicted evicted;
+        {
+            std::lock_guard<decltype(m_mutex)> lock(m_mutex);
+            const auto now = channel::clock_t::now();
+            auto key       = input.key(data);
+            auto& state    = m_states[key];
+
+            expire(key, state, now - m_options.retention, evicted);
+
+            if constexpr (IsLeft)
+            {
+                for (const auto& other : state.right)
+                {
+                    matches.emplace_back(key, data, other.value);
+                }
+                retain(key, state.left, now, std::move(data), evicted.left);
+            }
+            else
+            {
+                for (const auto& other : state.left)
+                {
+                    matches.emplace_back(key, other.value, data);
+                }
+                retain(key, state.right, now, std::move(data), evicted.right);
+            }
+
+            // keys which are no longer written are swept once per retention period
+            if (now >= m_next_sweep)
+            {
+                sweep(now, evicted);
+            }
+        }
+
+        evict(evicted);
+
+        for (auto& match : matches)
+        {
+            auto rc = SourceChannelWriteable<output_t>::await_write(std::move(match));
+            if (rc != channel::Status::success)
+            {
+                return rc;
+            }
+        }
+        return channel::Status::success;
+    }
+
+    template <bool IsLeft>
+    Input<IsLeft>& side()
+    {
+        if constexpr (IsLeft)
+        {
+            return m_left;
+        }
+        else
+        {
+            return m_right;
+        }
+    }
+
+    template <typename T>
+    void retain(const KeyT& key,
+                std::deque<Entry<T>>& entries,
+                channel::time_point_t now,
+                T&& data,
+                std::vector<std::pair<KeyT, T>>& evicted)
+    {
+        entries.push_back(Entry<T>{now, std::move(data)});
+        while (entries.size() > m_options.max_entries_per_key)
+        {
+            evicted.emplace_back(key, std::move(entries.front().value));
+            entries.pop_front();
+        }
+    }
+
+    template <typename T>
+    static void expire(const KeyT& key,
+                       std::deque<Entry<T>>& entries,
+                       channel::time_point_t oldest,
+                       std::vector<std::pair<KeyT, T>>& evicted)
+    {
+        while (!entries.empty() && entries.front().time < oldest)
+        {
+            evicted.emplace_back(key, std::move(entries.front().value));
+            entries.pop_front();
+        }
+    }
+
+    void expire(const KeyT& key, KeyState& state, channel::time_point_t oldest, Evicted& evicted)
+    {
+        expire(key, state.left, oldest, evicted.left);
+        expire(key, state.right, oldest, evicted.right);
+    }
+
+    void sweep(channel::time_point_t now, Evicted& evicted)
+    {
+        for (auto it = m_states.begin(); it != m_states.end();)
+        {
+            expire(it->first, it->second, now - m_options.retention, evicted);
+            it = (it->second.left.empty() && it->second.right.empty() ? m_states.erase(it) : std::next(it));
+        }
+        m_next_sweep = now + m_options.retention;
+    }
+
+    void evict(Evicted& evicted)
+    {
+        m_left.evict(evicted.left);
+        m_right.evict(evicted.right);
+    }
+
+    void on_input_connected()
+    {
+        std::lock_guard<decltype(m_mutex)> lock(m_mutex);
+        ++m_open_inputs;
+    }
+
+    void on_input_complete()
+    {
+        Evicted evicted;
+        {
+            std::lock_guard<decltype(m_mutex)> lock(m_mutex);
+            DCHECK_GT(m_open_inputs, 0);
+            if (--m_open_inputs > 0)
+            {
+                return;
+            }
+
+            for (auto& [key, state] : m_states)
+            {
+                expire(key, state, channel::time_point_t::max(), evicted);
+            }
+            m_states.clear();
+        }
+
+        evict(evicted);
+        this->release_channel();
+    }
+
+    Input<true> m_left;
+    Input<false> m_right;
+    const JoinOptions m_options;
+
+    boost::fibers::mutex m_mutex;
+    std::unordered_map<KeyT, KeyState> m_states;
+    channel::time_point_t m_next_sweep{};
+    std::size_t m_open_inputs{0};
+};
+
+}  // namespace mrc::node
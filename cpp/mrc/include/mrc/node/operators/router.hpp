@@ -24,8 +24,12 @@
 #include "mrc/node/source_channel.hpp"
 #include "mrc/node/source_properties.hpp"
 
+#include <glog/logging.h>
+
+#include <cstddef>
 #include <map>
 #include <memory>
+#include <vector>
 
 namespace mrc::node {
 
@@ -74,6 +78,57 @@ class RouterBase
     }
 };
 
+/**
+ * @brief RouterBase over a dense table of sources indexed by the value of the key
+ *
+ * KeyT is an integral or enum type whose values are 0 through case_count - 1; the source of a key is found by indexing
+ * rather than by a lookup. As with HashPartitioner, elements of a case without an edge are dropped.
+ */
+template <typename KeyT, typename T>
+class DenseRouterBase
+{
+    std::vector<std::unique_ptr<SourceChannelWriteable<T>>> m_sources;
+
+  protected:
+    DenseRouterBase(std::size_t case_count)
+    {
+        CHECK_GT(case_count, 0) << "a dense router requires at least one case";
+        m_sources.reserve(case_count);
+        for (std::size_t i = 0; i < case_count; ++i)
+        {
+            m_sources.push_back(std::make_unique<SourceChannelWriteable<T>>());
+        }
+    }
+
+    inline std::size_t index_for_key(const KeyT& key) const
+    {
+        auto index = static_cast<std::size_t>(key);
+        CHECK_LT(index, m_sources.size()) << "key outside of the cases of the dense router";
+        return index;
+    }
+
+    inline SourceChannelWriteable<T>& channel_for_index(std::size_t index)
+    {
+        return *m_sources[index];
+    }
+
+    void release_sources()
+    {
+        m_sources.clear();
+    }
+
+  public:
+    SourceChannel<T>& source(KeyT key)
+    {
+        return *m_sources[index_for_key(key)];
+    }
+
+    std::size_t case_count() const
+    {
+        return m_sources.size();
+    }
+};
+
 template <typename KeyT, typename T>
 class Router : public Operator<std::pair<KeyT, T>>, public RouterBase<KeyT, T>
 {
@@ -0,0 +1,154 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2021-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "mrc/channel/status.hpp"
+#include "mrc/node/forward.hpp"
+#include "mrc/node/sink_channel.hpp"
+#include "mrc/node/source_channel.hpp"
+#include "mrc/runnable/context.hpp"
+#include "mrc/runnable/runnable.hpp"
+
+#include <boost/fiber/condition_variable.hpp>
+#include <boost/fiber/mutex.hpp>
+#include <glog/logging.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <utility>
+
+namespace mrc::node {
+
+/**
+ * @brief Node which maps its inputs across all of its engines while emitting the outputs in the order of the inputs
+ *
+ * Each input is tagged with a sequence number as it is read. Outputs completed ahead of an earlier input are held in a
+ * reorder buffer until all earlier outputs have been emitted; at most `window` inputs may be in flight or buffered at
+ * once, so a slow input stalls the reads rather than growing the buffer. Launch the node with a pe_count or
+ * engines_per_pe greater than one to process inputs in parallel.
+ *
+ * If the map function throws, the exception is reported to the runtime context and the input is skipped, so the
+ * outputs of the later inputs are not held back.
+ */
+template <typename InputT, typename OutputT, typename ContextT = runnable::Context>
+class OrderedNode : public SinkChannel<InputT>,
+                    public SourceChannel<OutputT>,
+                    public runnable::RunnableWithContext<ContextT>
+{
+  public:
+    using map_fn_t = std::function<OutputT(InputT&&)>;
+
+    OrderedNode(map_fn_t map_fn, std::size_t window = 128) : m_map_fn(std::move(map_fn)), m_window(window)
+    {
+        CHECK(m_map_fn) << "OrderedNode requires a map function";
+        CHECK_GT(m_window, 0);
+    }
+
+    ~OrderedNode() override = default;
+
+  private:
+    // reads the next input and tags it with its sequence number; reads are serialized so tags follow the read order
+    std::optional<std::uint64_t> read(InputT& data)
+    {
+        std::lock_guard<decltype(m_read_mutex)> read_lock(m_read_mutex);
+        {
+            std::unique_lock<decltype(m_mutex)> lock(m_mutex);
+            m_window_cv.wait(lock, [this] { return m_next_seq - m_next_emit < m_window; });
+        }
+
+        if (SinkChannel<InputT>::egress().await_read(data) != channel::Status::success)
+        {
+            return std::nullopt;
+        }
+
+        std::lock_guard<decltype(m_mutex)> lock(m_mutex);
+        return m_next_seq++;
+    }
+
+    // buffers the output of seq, then emits all outputs which are next in order; a skipped input holds no output
+    void complete(std::uint64_t seq, std::optional<OutputT> output)
+    {
+        std::lock_guard<decltype(m_mutex)> lock(m_mutex);
+        m_pending.emplace(seq, std::move(output));
+
+        bool emitted = false;
+        for (auto it = m_pending.begin(); it != m_pending.end() && it->first == m_next_emit; it = m_pending.erase(it))
+        {
+            if (it->second)
+            {
+                SourceChannel<OutputT>::await_write(std::move(*it->second));
+            }
+            ++m_next_emit;
+            emitted = true;
+        }
+
+        if (emitted)
+        {
+            m_window_cv.notify_all();
+        }
+    }
+
+    void run(ContextT& ctx) final
+    {
+        InputT data;
+        while (auto seq = read(data))
+        {
+            try
+            {
+                complete(*seq, m_map_fn(std::move(data)));
+            } catch (...)
+            {
+                ctx.set_exception(std::current_exception());
+                complete(*seq, std::nullopt);
+            }
+        }
+
+        ctx.barrier();
+        if (ctx.rank() == 0)
+        {
+            DCHECK(m_pending.empty());
+            DVLOG(10) << ctx.info() << " ordered node releasing its downstream channel";
+            SourceChannel<OutputT>::release_channel();
+        }
+    }
+
+    void on_state_update(const runnable::Runnable::State& state) final
+    {
+        if (state == runnable::Runnable::State::Stop || state == runnable::Runnable::State::Kill)
+        {
+            SinkChannel<InputT>::disable_persistence();
+        }
+    }
+
+    map_fn_t m_map_fn;
+    const std::size_t m_window;
+
+    boost::fibers::mutex m_read_mutex;
+    boost::fibers::mutex m_mutex;
+    boost::fibers::condition_variable m_window_cv;
+    std::uint64_t m_next_seq{0};
+    std::uint64_t m_next_emit{0};
+    std::map<std::uint64_t, std::optional<OutputT>> m_pending;
+};
+
+}  // namespace mrc::node
@@ -0,0 +1,93 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2021-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "mrc/channel/status.hpp"
+#include "mrc/node/forward.hpp"
+#include "mrc/node/sink_channel.hpp"
+#include "mrc/node/source_channel.hpp"
+#include "mrc/runnable/run_to_completion.hpp"
+
+#include <glog/logging.h>
+
+#include <cstddef>
+#include <functional>
+#include <utility>
+
+namespace mrc::node {
+
+/**
+ * @brief Node transforming its inputs when polled by a RunToCompletion runnable instead of running on its own engine
+ *
+ * Each poll drains up to max_per_poll elements from the input channel with try_read and writes the result of the
+ * transform downstream. Writes to a full downstream channel block the polling core, so the downstream channel should
+ * be sized for the burst of a poll. The node is done and releases its downstream channel once its input is closed and
+ * drained.
+ */
+template <typename InputT, typename OutputT = InputT>
+class PollingNode : public SinkChannel<InputT>, public SourceChannel<OutputT>, public runnable::Pollable
+{
+  public:
+    using transform_fn_t = std::function<OutputT(InputT&&)>;
+
+    PollingNode(transform_fn_t transform_fn, std::size_t max_per_poll = 64) :
+      m_transform_fn(std::move(transform_fn)),
+      m_max_per_poll(max_per_poll)
+    {
+        CHECK(m_transform_fn) << "a polling node requires a transform_fn";
+        CHECK_GT(m_max_per_poll, 0);
+    }
+
+    ~PollingNode() override = default;
+
+    runnable::PollStatus poll() final
+    {
+        auto& egress = SinkChannel<InputT>::egress();
+
+        std::size_t count = 0;
+        while (count < m_max_per_poll)
+        {
+            InputT data;
+            auto rc = egress.try_read(data);
+            if (rc == channel::Status::success)
+            {
+                SourceChannel<OutputT>::await_write(m_transform_fn(std::move(data)));
+                ++count;
+                continue;
+            }
+            if (rc == channel::Status::closed)
+            {
+                SourceChannel<OutputT>::release_channel();
+                return runnable::PollStatus::Done;
+            }
+            break;
+        }
+        return (count > 0 ? runnable::PollStatus::Progress : runnable::PollStatus::Idle);
+    }
+
+    void on_stop() final
+    {
+        SinkChannel<InputT>::disable_persistence();
+    }
+
+  private:
+    transform_fn_t m_transform_fn;
+    const std::size_t m_max_per_poll;
+};
+
+}  // namespace mrc::node
@@ -17,18 +17,37 @@
 
 #pragma once
 
+#include "mrc/channel/channel.hpp"
 #include "mrc/channel/ingress.hpp"
+#include "mrc/channel/sharded_channel.hpp"
 #include "mrc/node/edge_properties.hpp"
 #include "mrc/node/forward.hpp"
 #include "mrc/node/sink_channel_base.hpp"
 
+#include <cstddef>
+#include <memory>
+
 namespace mrc::node {
 
+/**
+ * @brief Channel shared by the writers of its ingress and all downstream nodes reading from it
+ *
+ * By default the downstream readers share a single BufferedChannel. With shard_count > 1 the queue holds a
+ * ShardedChannel instead, giving each reader a home shard and letting it steal from the others once its own is
+ * drained; use it when many consumer engines pull from one queue.
+ */
 template <typename T>
 class Queue : public SinkChannelBase<T>, public SinkProperties<T>, public ChannelProvider<T>
 {
   public:
-    Queue()           = default;
+    Queue() = default;
+    Queue(std::size_t shard_count, std::size_t buffer_size = channel::default_channel_size())
+    {
+        if (shard_count > 1)
+        {
+            SinkChannelBase<T>::update_channel(std::make_unique<channel::ShardedChannel<T>>(shard_count, buffer_size));
+        }
+    }
     ~Queue() override = default;
 
   private:
@@ -0,0 +1,130 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "mrc/codable/recording.hpp"
+#include "mrc/node/forward.hpp"
+#include "mrc/node/generic_source.hpp"
+#include "mrc/node/rx_sink.hpp"
+#include "mrc/types.hpp"
+
+#include <boost/fiber/operations.hpp>
+#include <glog/logging.h>
+#include <rxcpp/rx.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <filesystem>
+#include <mutex>
+#include <utility>
+
+namespace mrc::node {
+
+/**
+ * @brief Sink recording each element and the time of its arrival to a file, from which a ReplaySource reproduces the
+ * traffic of the edge
+ *
+ * Elements are encoded with the codable protocol of T, see codable::RecordingWriter. With more than one pe, the
+ * elements of all pes are recorded to the same file in order of their arrival. The file is flushed once the upstream
+ * completes.
+ */
+template <typename T, typename ContextT = runnable::Context>
+class RecordingSink final : public RxSink<T, ContextT>
+{
+  public:
+    explicit RecordingSink(const std::filesystem::path& path) : m_writer(path)
+    {
+        this->set_observer(
+            [this](T data) {
+                std::lock_guard<Mutex> lock(m_mutex);
+                m_writer.append(data);
+            },
+            [this] {
+                std::lock_guard<Mutex> lock(m_mutex);
+                m_writer.flush();
+            });
+    }
+
+    ~RecordingSink() final = default;
+
+    // number of elements recorded
+    std::size_t count()
+    {
+        std::lock_guard<Mutex> lock(m_mutex);
+        return m_writer.count();
+    }
+
+  private:
+    Mutex m_mutex;
+    codable::RecordingWriter m_writer;
+};
+
+/**
+ * @brief Source emitting the elements of a recording made by a RecordingSink, spaced as they were recorded
+ *
+ * The gaps between elements are those of the recording divided by speedup, e.g. a speedup of 2 replays the recording
+ * at twice its original rate, while a speedup of 0 emits the elements back to back. Each element is scheduled against
+ * the start of the replay, so a downstream which pushes back delays the elements behind it without accumulating drift.
+ * Each pe replays the whole recording, so the source is typically run with a single pe.
+ */
+template <typename T, typename ContextT = runnable::Context>
+class ReplaySource final : public GenericSource<T, ContextT>
+{
+  public:
+    explicit ReplaySource(std::filesystem::path path, double speedup = 1.0) :
+      m_path(std::move(path)),
+      m_speedup(speedup)
+    {
+        CHECK_GE(m_speedup, 0);
+    }
+
+    ~ReplaySource() final = default;
+
+    double speedup() const
+    {
+        return m_speedup;
+    }
+
+  private:
+    void data_source(rxcpp::subscriber<T>& s) final
+    {
+        codable::RecordingReader reader(m_path);
+        const auto start = std::chrono::steady_clock::now();
+
+        while (s.is_subscribed())
+        {
+            auto recorded = reader.template next<T>();
+            if (!recorded)
+            {
+                break;
+            }
+            if (m_speedup > 0)
+            {
+                const std::chrono::duration<double, std::nano> delay(recorded->offset.count() / m_speedup);
+                boost::this_fiber::sleep_until(
+                    start + std::chrono::duration_cast<std::chrono::steady_clock::duration>(delay));
+            }
+            s.on_next(std::move(recorded->object));
+        }
+    }
+
+    const std::filesystem::path m_path;
+    const double m_speedup;
+};
+
+}  // namespace mrc::node
@@ -35,6 +35,7 @@
 #include <rxcpp/rx.hpp>
 
 #include <exception>
+#include <functional>
 #include <memory>
 #include <mutex>
 
@@ -67,6 +68,16 @@ class RxNode : public RxSinkBase<InputT>,
 
     void make_stream(stream_fn_t fn);
 
+    /**
+     * @brief Fuses downstream into this node: the stream of downstream is composed onto the stream of this node and
+     * subscribed by the runnable of this node, which then writes to the output channel of downstream.
+     *
+     * Fusion must happen before either node is launched; downstream must not be launched afterwards. Returns false,
+     * leaving both nodes untouched, if the output of this node is already connected or downstream has other inputs.
+     */
+    template <typename DownstreamOutputT>
+    bool fuse(RxNode<OutputT, DownstreamOutputT, ContextT>& downstream);
+
   private:
     // the following method(s) are moved to private from their original scopes to prevent access from deriving classes
     using RxSinkBase<InputT>::observable;
@@ -75,12 +86,28 @@ class RxNode : public RxSinkBase<InputT>,
     void do_subscribe(rxcpp::composite_subscription& subscription) final;
     void on_shutdown_critical_section() final;
 
+    // applies the taps and the stream to input; the output is subscribed by the fused downstream node or the observer
+    void subscribe_stream(rxcpp::composite_subscription& subscription, const rxcpp::observable<InputT>& input);
+
+    // releases the source channel of this node and of the fused downstream nodes
+    void release_channels();
+
     void on_stop(const rxcpp::subscription& subscription) override;
     void on_kill(const rxcpp::subscription& subscription) final;
 
     // m_stream works like an operator. It is a function taking an observable and returning an observable. Allows
     // delayed construction of the observable chain for prologue/epilogue
     stream_fn_t m_stream;
+
+    // set when a downstream node has been fused into this node
+    std::function<void(rxcpp::composite_subscription&, const rxcpp::observable<OutputT>&)> m_fused_subscribe;
+    std::function<void()> m_fused_release;
+
+    // set when this node has been fused into an upstream node
+    bool m_fused_upstream{false};
+
+    template <typename, typename, typename>
+    friend class RxNode;
 };
 
 template <typename InputT, typename OutputT, typename ContextT>
@@ -104,14 +131,40 @@ void RxNode<InputT, OutputT, ContextT>::make_stream(stream_fn_t fn)
     m_stream = std::move(fn);
 }
 
+template <typename InputT, typename OutputT, typename ContextT>
+template <typename DownstreamOutputT>
+bool RxNode<InputT, OutputT, ContextT>::fuse(RxNode<OutputT, DownstreamOutputT, ContextT>& downstream)
+{
+    if (RxSourceBase<OutputT>::has_channel() || m_fused_subscribe || downstream.use_count() > 0 ||
+        downstream.m_fused_upstream)
+    {
+        return false;
+    }
+
+    downstream.m_fused_upstream = true;
+
+    m_fused_subscribe = [&downstream](rxcpp::composite_subscription& subscription,
+                                      const rxcpp::observable<OutputT>& input) {
+        downstream.subscribe_stream(subscription, input);
+    };
+    m_fused_release = [&downstream] { downstream.release_channels(); };
+
+    return true;
+}
+
 template <typename InputT, typename OutputT, typename ContextT>
 void RxNode<InputT, OutputT, ContextT>::do_subscribe(rxcpp::composite_subscription& subscription)
 {
-    // Start with the base sinke observable
-    auto observable_in = RxSinkBase<InputT>::observable();
+    // Start with the base sink observable
+    subscribe_stream(subscription, RxSinkBase<InputT>::observable());
+}
 
+template <typename InputT, typename OutputT, typename ContextT>
+void RxNode<InputT, OutputT, ContextT>::subscribe_stream(rxcpp::composite_subscription& subscription,
+                                                         const rxcpp::observable<InputT>& input)
+{
     // Apply prologue taps
-    observable_in = this->apply_prologue_taps(observable_in);
+    auto observable_in = this->apply_prologue_taps(input);
 
     // Apply the specified stream
     auto observable_out = m_stream(observable_in);
@@ -119,7 +172,12 @@ void RxNode<InputT, OutputT, ContextT>::do_subscribe(rxcpp::composite_subscripti
     // Apply epilogue taps
     observable_out = this->apply_epilogue_taps(observable_out);
 
-    // Subscribe to the observer
+    // Hand off to the fused downstream node or subscribe to the observer
+    if (m_fused_subscribe)
+    {
+        m_fused_subscribe(subscription, observable_out);
+        return;
+    }
     observable_out.subscribe(subscription, RxSourceBase<OutputT>::observer());
 }
 
@@ -140,7 +198,17 @@ template <typename InputT, typename OutputT, typename ContextT>
 void RxNode<InputT, OutputT, ContextT>::on_shutdown_critical_section()
 {
     DVLOG(10) << runnable::Context::get_runtime_context().info() << " releasing source channel";
+    release_channels();
+}
+
+template <typename InputT, typename OutputT, typename ContextT>
+void RxNode<InputT, OutputT, ContextT>::release_channels()
+{
     RxSourceBase<OutputT>::release_channel();
+    if (m_fused_release)
+    {
+        m_fused_release();
+    }
 }
 
 }  // namespace mrc::node
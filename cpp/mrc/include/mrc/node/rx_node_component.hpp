@@ -0,0 +1,155 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2021-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "mrc/channel/ingress.hpp"
+#include "mrc/channel/status.hpp"
+#include "mrc/node/forward.hpp"
+#include "mrc/node/sink_properties.hpp"
+#include "mrc/node/source_channel.hpp"
+#include "mrc/runnable/context.hpp"
+
+#include <boost/fiber/mutex.hpp>
+#include <glog/logging.h>
+#include <rxcpp/rx.hpp>
+
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <utility>
+
+namespace mrc::node {
+
+/**
+ * @brief Non-runnable node applying an rxcpp operator chain to its inputs inline on the fiber of the upstream writer
+ *
+ * Edges to the component are direct calls: there is no channel, runnable or context switch between the upstream
+ * writer and the operators, which makes it a fit for cheap, non-blocking transforms. Writes from several upstream
+ * edges are serialized. The output completes once the last upstream edge has been released; exceptions raised by the
+ * operators are reported to the runtime context of the writer.
+ */
+template <typename InputT, typename OutputT = InputT>
+class RxNodeComponent : public SinkProperties<InputT>, public SourceChannelWriteable<OutputT>
+{
+  public:
+    // function defining the stream, i.e. operations linking Sink -> Source
+    using stream_fn_t = std::function<rxcpp::observable<OutputT>(const rxcpp::observable<InputT>&)>;
+
+    RxNodeComponent() :
+      m_stream([](const rxcpp::observable<InputT>& obs) {
+          // Default to just returning the input
+          return obs;
+      })
+    {}
+
+    template <typename... OpsT>
+    RxNodeComponent(OpsT&&... ops)
+    {
+        pipe(std::forward<OpsT>(ops)...);
+    }
+
+    ~RxNodeComponent() override = default;
+
+    template <typename... OpsT>
+    RxNodeComponent& pipe(OpsT&&... ops)
+    {
+        make_stream([=](auto start) { return (start | ... | ops); });
+        return *this;
+    }
+
+    void make_stream(stream_fn_t fn)
+    {
+        m_stream = std::move(fn);
+    }
+
+  private:
+    class Ingress : public channel::Ingress<InputT>
+    {
+      public:
+        Ingress(RxNodeComponent& parent) : m_parent(parent) {}
+        ~Ingress() override
+        {
+            m_parent.on_complete();
+        }
+
+        channel::Status await_write(InputT&& data) final
+        {
+            return m_parent.on_next(std::move(data));
+        }
+
+      private:
+        RxNodeComponent& m_parent;
+    };
+
+    // all edges to the component share its ingress; the output completes once the last of them is released
+    std::shared_ptr<channel::Ingress<InputT>> channel_ingress() final
+    {
+        std::lock_guard<decltype(m_mutex)> lock(m_mutex);
+        auto ingress = m_ingress.lock();
+        if (!ingress)
+        {
+            CHECK(!m_completed) << "edges to a node component must be made before its inputs complete";
+            if (!m_subscription.is_subscribed())
+            {
+                subscribe();
+            }
+            ingress   = std::make_shared<Ingress>(*this);
+            m_ingress = ingress;
+        }
+        return ingress;
+    }
+
+    void subscribe()
+    {
+        auto observer = rxcpp::make_observer_dynamic<OutputT>(
+            [this](OutputT data) { SourceChannelWriteable<OutputT>::await_write(std::move(data)); },
+            [](std::exception_ptr ptr) { runnable::Context::get_runtime_context().set_exception(std::move(ptr)); },
+            [this] { SourceChannelWriteable<OutputT>::release_channel(); });
+
+        m_subscription = m_stream(m_subject.get_observable()).subscribe(observer);
+    }
+
+    channel::Status on_next(InputT&& data)
+    {
+        std::lock_guard<decltype(m_mutex)> lock(m_mutex);
+        if (!m_subscription.is_subscribed())
+        {
+            return channel::Status::closed;
+        }
+        m_subject.get_subscriber().on_next(std::move(data));
+        return channel::Status::success;
+    }
+
+    void on_complete()
+    {
+        std::lock_guard<decltype(m_mutex)> lock(m_mutex);
+        m_completed = true;
+        m_subject.get_subscriber().on_completed();
+    }
+
+    stream_fn_t m_stream;
+
+    boost::fibers::mutex m_mutex;
+    rxcpp::subjects::subject<InputT> m_subject;
+    rxcpp::composite_subscription m_subscription{rxcpp::composite_subscription::empty()};
+    std::weak_ptr<Ingress> m_ingress;
+    bool m_completed{false};
+};
+
+}  // namespace mrc::node
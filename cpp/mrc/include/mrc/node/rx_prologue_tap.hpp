@@ -17,6 +17,8 @@
 
 #pragma once
 
+#include "mrc/core/watcher.hpp"
+
 #include <rxcpp/rx.hpp>
 
 #include <functional>
@@ -34,19 +36,43 @@ class RxPrologueTap
         m_taps.push_back(tap_fn);
     }
 
+    // trace taps are only invoked while TraceControl is enabled, for the elements it samples
+    void add_prologue_trace_tap(std::function<void(const T&)> tap_fn)
+    {
+        m_trace_taps.push_back(tap_fn);
+    }
+
   protected:
     rxcpp::observable<T> apply_prologue_taps(rxcpp::observable<T> observable)
     {
         rxcpp::observable<T> obs = observable;
-        for (auto& tap : m_taps)
+        if (!m_taps.empty())
+        {
+            obs = obs.tap([taps = m_taps](const T& data) {
+                for (const auto& tap : taps)
+                {
+                    tap(data);
+                }
+            });
+        }
+        if (!m_trace_taps.empty())
         {
-            obs = obs.tap(tap);
+            obs = obs.tap([taps = m_trace_taps](const T& data) {
+                if (TraceControl::sample())
+                {
+                    for (const auto& tap : taps)
+                    {
+                        tap(data);
+                    }
+                }
+            });
         }
         return obs;
     }
 
   private:
     std::vector<std::function<void(const T&)>> m_taps;
+    std::vector<std::function<void(const T&)>> m_trace_taps;
 };
 
 }  // namespace mrc::node
@@ -27,16 +27,19 @@
 #include "mrc/node/edge.hpp"
 #include "mrc/node/forward.hpp"
 #include "mrc/node/sink_channel.hpp"
+#include "mrc/runnable/context.hpp"
 #include "mrc/utils/type_utils.hpp"
 
 #include <glog/logging.h>
 #include <rxcpp/rx.hpp>
 
+#include <chrono>
 #include <exception>
 #include <iomanip>
 #include <memory>
 #include <mutex>
 #include <string>
+#include <vector>
 
 namespace mrc::node {
 
@@ -47,6 +50,10 @@ class RxSinkBase : public SinkChannel<T>, private Watchable
     void sink_add_watcher(std::shared_ptr<WatcherInterface> watcher);
     void sink_remove_watcher(std::shared_ptr<WatcherInterface> watcher);
 
+    // trace watchers are only invoked while TraceControl is enabled
+    void sink_add_trace_watcher(std::shared_ptr<WatcherInterface> watcher);
+    void sink_remove_trace_watcher(std::shared_ptr<WatcherInterface> watcher);
+
   protected:
     RxSinkBase();
     ~RxSinkBase() override = default;
@@ -60,6 +67,9 @@ class RxSinkBase : public SinkChannel<T>, private Watchable
     // this is our channel reader progress engine
     void progress_engine(rxcpp::subscriber<T>& s);
 
+    // parks an instance held in standby by its runner until it is activated or the channel is closed
+    void await_active(const runnable::Context* ctx);
+
     // observable
     rxcpp::observable<T> m_observable;
 };
@@ -79,18 +89,51 @@ const rxcpp::observable<T>& RxSinkBase<T>::observable() const
 template <typename T>
 void RxSinkBase<T>::progress_engine(rxcpp::subscriber<T>& s)
 {
-    T data;
-    this->watcher_prologue(WatchableEvent::channel_read, &data);
-    while (s.is_subscribed() && (SinkChannel<T>::egress().await_read(data) == channel::Status::success))
+    // drain whatever is available in the channel up to the batch size so that the sink pays for at most one wake-up
+    // per batch rather than one per element
+    std::vector<T> batch;
+    batch.reserve(MRC_DEFAULT_SINK_READ_BATCH_SIZE);
+
+    const auto* ctx =
+        (runnable::Context::has_runtime_context() ? &runnable::Context::get_runtime_context() : nullptr);
+
+    this->watcher_prologue(WatchableEvent::channel_read, &batch);
+    while (s.is_subscribed())
     {
-        this->watcher_epilogue(WatchableEvent::channel_read, true, &data);
-        this->watcher_prologue(WatchableEvent::sink_on_data, &data);
-        s.on_next(std::move(data));
-        this->watcher_prologue(WatchableEvent::channel_read, &data);
+        await_active(ctx);
+        if (SinkChannel<T>::egress().await_read_n(batch, MRC_DEFAULT_SINK_READ_BATCH_SIZE) != channel::Status::success)
+        {
+            break;
+        }
+
+        for (auto& data : batch)
+        {
+            // a subscriber which unsubscribed part way through the batch sees no further elements; the remainder of
+            // the batch is released below
+            if (!s.is_subscribed())
+            {
+                break;
+            }
+            this->watcher_epilogue(WatchableEvent::channel_read, true, &data);
+            this->watcher_prologue(WatchableEvent::sink_on_data, &data);
+            s.on_next(std::move(data));
+            this->watcher_prologue(WatchableEvent::channel_read, &data);
+        }
+        batch.clear();
     }
     s.on_completed();
 }
 
+template <typename T>
+void RxSinkBase<T>::await_active(const runnable::Context* ctx)
+{
+    // the runner wakes standby instances when they are activated or stopped; completion of the channel is polled
+    while (ctx != nullptr && !ctx->is_active() && !SinkChannelBase<T>::channel()->is_channel_closed())
+    {
+        ctx->await_active(std::chrono::milliseconds(10));
+    }
+}
+
 template <typename T>
 void RxSinkBase<T>::sink_add_watcher(std::shared_ptr<WatcherInterface> watcher)
 {
@@ -103,4 +146,16 @@ void RxSinkBase<T>::sink_remove_watcher(std::shared_ptr<WatcherInterface> watche
     Watchable::remove_watcher(std::move(watcher));
 }
 
+template <typename T>
+void RxSinkBase<T>::sink_add_trace_watcher(std::shared_ptr<WatcherInterface> watcher)
+{
+    Watchable::add_trace_watcher(std::move(watcher));
+}
+
+template <typename T>
+void RxSinkBase<T>::sink_remove_trace_watcher(std::shared_ptr<WatcherInterface> watcher)
+{
+    Watchable::remove_trace_watcher(std::move(watcher));
+}
+
 }  // namespace mrc::node
@@ -52,6 +52,10 @@ class RxSourceBase : public SourceChannel<T>, private Watchable
     void source_add_watcher(std::shared_ptr<WatcherInterface> watcher);
     void source_remove_watcher(std::shared_ptr<WatcherInterface> watcher);
 
+    // trace watchers are only invoked while TraceControl is enabled
+    void source_add_trace_watcher(std::shared_ptr<WatcherInterface> watcher);
+    void source_remove_trace_watcher(std::shared_ptr<WatcherInterface> watcher);
+
   protected:
     RxSourceBase();
     ~RxSourceBase() override = default;
@@ -95,4 +99,16 @@ void RxSourceBase<T>::source_remove_watcher(std::shared_ptr<WatcherInterface> wa
     Watchable::remove_watcher(std::move(watcher));
 }
 
+template <typename T>
+void RxSourceBase<T>::source_add_trace_watcher(std::shared_ptr<WatcherInterface> watcher)
+{
+    Watchable::add_trace_watcher(std::move(watcher));
+}
+
+template <typename T>
+void RxSourceBase<T>::source_remove_trace_watcher(std::shared_ptr<WatcherInterface> watcher)
+{
+    Watchable::remove_trace_watcher(std::move(watcher));
+}
+
 }  // namespace mrc::node
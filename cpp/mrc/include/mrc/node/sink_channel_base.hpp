@@ -19,7 +19,10 @@
 
 #include "mrc/channel/buffered_channel.hpp"
 #include "mrc/channel/egress.hpp"
+#include "mrc/channel/in_flight_budget.hpp"
 #include "mrc/channel/ingress.hpp"
+#include "mrc/channel/telemetry.hpp"
+#include "mrc/channel/wait_policy.hpp"
 #include "mrc/constants.hpp"
 #include "mrc/exceptions/runtime_error.hpp"
 #include "mrc/node/edge.hpp"
@@ -28,6 +31,7 @@
 #include "mrc/node/sink_properties.hpp"
 #include "mrc/utils/type_utils.hpp"
 
+#include <memory>
 #include <mutex>
 
 namespace mrc::node {
@@ -87,6 +91,31 @@ class SinkChannelBase
         return m_ingress.use_count();
     }
 
+    /**
+     * @brief Set the WaitPolicy used by readers of the Channel when it is empty.
+     *
+     * @param policy
+     */
+    void set_wait_policy(const channel::WaitPolicy& policy);
+
+    /**
+     * @brief Charge the elements buffered in the Channel to a budget shared with other channels.
+     *
+     * @param budget
+     */
+    void set_in_flight_budget(std::shared_ptr<channel::InFlightBudget> budget);
+
+    /**
+     * @brief Occupancy and throughput counters of the Channel this sink reads from.
+     */
+    channel::ChannelStatistics channel_statistics() const;
+
+    /**
+     * @brief Observer of the Channel this sink currently reads from, which remains valid after the node was moved to
+     * the executor without extending the lifetime of the Channel.
+     */
+    std::weak_ptr<const channel::Channel<T>> channel_observer() const;
+
   protected:
     inline channel::Egress<T>& egress()
     {
@@ -199,6 +228,38 @@ void SinkChannelBase<T>::set_shared_channel(std::shared_ptr<Channel<T>> channel)
     m_unique_channel = false;
 }
 
+template <typename T>
+void SinkChannelBase<T>::set_wait_policy(const channel::WaitPolicy& policy)
+{
+    std::lock_guard<decltype(m_mutex)> lock(m_mutex);
+    CHECK(m_channel);
+    m_channel->set_wait_policy(policy);
+}
+
+template <typename T>
+void SinkChannelBase<T>::set_in_flight_budget(std::shared_ptr<channel::InFlightBudget> budget)
+{
+    std::lock_guard<decltype(m_mutex)> lock(m_mutex);
+    CHECK(m_channel);
+    m_channel->set_in_flight_budget(std::move(budget));
+}
+
+template <typename T>
+channel::ChannelStatistics SinkChannelBase<T>::channel_statistics() const
+{
+    std::lock_guard<decltype(m_mutex)> lock(m_mutex);
+    CHECK(m_channel);
+    return m_channel->statistics();
+}
+
+template <typename T>
+std::weak_ptr<const channel::Channel<T>> SinkChannelBase<T>::channel_observer() const
+{
+    std::lock_guard<decltype(m_mutex)> lock(m_mutex);
+    CHECK(m_channel);
+    return m_channel;
+}
+
 template <typename T>
 bool SinkChannelBase<T>::is_persistent() const
 {
@@ -26,7 +26,10 @@
 #include "mrc/node/source_properties.hpp"
 #include "mrc/utils/type_utils.hpp"
 
+#include <cstddef>
 #include <memory>
+#include <optional>
+#include <span>
 
 namespace mrc::node {
 
@@ -54,6 +57,27 @@ class SourceChannel : public SourceProperties<T>, private channel::Ingress<T>
         return no_channel(std::move(data));
     }
 
+    inline channel::Status await_write_n(std::span<T> values) final
+    {
+        if (m_ingress)
+        {
+            return m_ingress->await_write_n(values);
+        }
+
+        // routes each element through no_channel
+        return channel::Ingress<T>::await_write_n(values);
+    }
+
+    // demand of the downstream edge; empty if unknown or not connected
+    std::optional<std::size_t> writable_capacity() const final
+    {
+        if (m_ingress)
+        {
+            return m_ingress->writable_capacity();
+        }
+        return std::nullopt;
+    }
+
     bool has_channel() const
     {
         return bool(m_ingress);
@@ -95,6 +119,8 @@ class SourceChannelWriteable : public SourceChannel<T>
 {
   public:
     using SourceChannel<T>::await_write;
+    using SourceChannel<T>::await_write_n;
+    using SourceChannel<T>::writable_capacity;
 
   private:
     channel::Status no_channel(T&& data) final
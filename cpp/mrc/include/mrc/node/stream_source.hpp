@@ -0,0 +1,154 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "mrc/io/stream_consumer.hpp"
+#include "mrc/node/checkpoint.hpp"
+#include "mrc/node/checkpointable_source.hpp"
+#include "mrc/node/forward.hpp"
+
+#include <glog/logging.h>
+#include <rxcpp/rx.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <memory>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace mrc::node {
+
+struct StreamSourceOptions
+{
+    // most messages of a batch
+    std::size_t max_batch_size{1024};
+    // longest wait for the first message of a batch; bounds the time the source takes to observe a stop
+    std::chrono::milliseconds poll_timeout{100};
+    // batches between the checkpoints whose acknowledgement commits the offsets of the consumer
+    std::size_t commit_interval{16};
+};
+
+/**
+ * @brief CheckpointStore committing the stream offsets of checkpoint tokens to a consumer
+ *
+ * Nothing is loaded: the stream, e.g. the consumer group of a Kafka cluster, keeps the committed offsets and resumes
+ * its consumers from them.
+ */
+class StreamCommitStore final : public CheckpointStore
+{
+  public:
+    StreamCommitStore(std::shared_ptr<io::StreamConsumer> consumer) : m_consumer(std::move(consumer))
+    {
+        CHECK(m_consumer);
+    }
+
+    void save(const std::string& /*source_name*/, const Checkpoint& checkpoint) final
+    {
+        m_consumer->commit(io::decode_offsets(checkpoint.token));
+    }
+
+    std::optional<Checkpoint> load(const std::string& /*source_name*/) final
+    {
+        return std::nullopt;
+    }
+
+  private:
+    const std::shared_ptr<io::StreamConsumer> m_consumer;
+};
+
+/**
+ * @brief Source node emitting batches of the io::StreamMessages of an io::StreamConsumer, e.g. an io::KafkaConsumer
+ *
+ * Messages are consumed in batches of up to max_batch_size and emitted as a single element, and payloads view the
+ * memory they were received into, so neither the consumer nor the edges touch individual messages. Offsets are
+ * committed once downstream processed them: every commit_interval batches the source emits a checkpoint marker behind
+ * the offsets consumed so far, and the coordinator commits them to the consumer through a StreamCommitStore once every
+ * participating sink acknowledged the marker, see node::acknowledge_checkpoints. A restarted job thus consumes again
+ * at most the messages of the checkpoints not yet acknowledged.
+ *
+ * The source runs until it is stopped or the consumer reports the end of the stream, and must run a single pe, as the
+ * offsets of its checkpoints are those of all messages emitted before the marker.
+ */
+template <typename ContextT>
+class StreamSource : public CheckpointableSource<std::vector<io::StreamMessage>, ContextT>
+{
+  public:
+    StreamSource(std::shared_ptr<io::StreamConsumer> consumer,
+                 StreamSourceOptions options = {},
+                 std::size_t participants    = 1) :
+      StreamSource(consumer,
+                   options,
+                   std::make_shared<CheckpointCoordinator>(
+                       "stream", std::make_shared<StreamCommitStore>(consumer), participants))
+    {}
+
+    ~StreamSource() override = default;
+
+    const StreamSourceOptions& options() const
+    {
+        return m_options;
+    }
+
+  private:
+    StreamSource(std::shared_ptr<io::StreamConsumer> consumer,
+                 StreamSourceOptions options,
+                 std::shared_ptr<CheckpointCoordinator> coordinator) :
+      CheckpointableSource<std::vector<io::StreamMessage>, ContextT>(std::move(coordinator), options.commit_interval),
+      m_consumer(std::move(consumer)),
+      m_options(options)
+    {
+        CHECK_GT(m_options.max_batch_size, 0);
+    }
+
+    // the consumer resumes from the offsets committed to the stream, so the resume token is never set
+    void data_source(rxcpp::subscriber<std::vector<io::StreamMessage>>& s,
+                     const std::optional<std::string>& /*resume_token*/) final
+    {
+        while (s.is_subscribed())
+        {
+            auto batch = m_consumer->poll(m_options.max_batch_size, m_options.poll_timeout);
+            if (!batch)
+            {
+                break;
+            }
+            if (batch->empty())
+            {
+                continue;
+            }
+            for (const auto& message : *batch)
+            {
+                m_offsets[message.partition()] = message.offset() + 1;
+            }
+            s.on_next(std::move(*batch));
+        }
+        s.on_completed();
+    }
+
+    std::string checkpoint_token() final
+    {
+        return io::encode_offsets(m_offsets);
+    }
+
+    const std::shared_ptr<io::StreamConsumer> m_consumer;
+    const StreamSourceOptions m_options;
+    io::StreamOffsets m_offsets;
+};
+
+}  // namespace mrc::node
@@ -0,0 +1,315 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2021-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "mrc/channel/status.hpp"
+#include "mrc/channel/types.hpp"
+#include "mrc/node/forward.hpp"
+#include "mrc/node/sink_channel.hpp"
+#include "mrc/node/source_channel.hpp"
+#include "mrc/runnable/context.hpp"
+#include "mrc/runnable/runnable.hpp"
+
+#include <glog/logging.h>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <queue>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <variant>
+#include <vector>
+
+namespace mrc::node {
+
+enum class WindowKind
+{
+    // closes after size elements; with a slide smaller than size, consecutive windows overlap
+    Count,
+    // closes duration after its first element
+    Time,
+    // closes once no element arrived for gap
+    Session,
+};
+
+struct WindowOptions
+{
+    WindowKind kind{WindowKind::Count};
+
+    // Count: elements per window
+    std::size_t size{64};
+
+    // Count: elements between the starts of consecutive windows; 0 or size gives tumbling windows
+    std::size_t slide{0};
+
+    // Time: length of a window
+    std::chrono::microseconds duration{1000};
+
+    // Session: inactivity after which a window closes
+    std::chrono::microseconds gap{1000};
+
+    // elements pre-allocated for the window of a key; defaults to size for Count windows
+    std::size_t reserve{0};
+
+    // keys with an empty window whose state is retained for reuse; beyond this the state of a key is evicted once its
+    // window closes
+    std::size_t max_idle_keys{1024};
+};
+
+/**
+ * @brief The elements of one window of a key
+ */
+template <typename KeyT, typename T>
+struct KeyedWindow
+{
+    KeyT key;
+    std::vector<T> elements;
+};
+
+/**
+ * @brief Node grouping its inputs by key into count, time or session windows and emitting each window as it closes
+ *
+ * The state of each key, including the pre-allocated storage of its window, is kept across windows so steady keys do
+ * not allocate state per window. Time and session windows are closed by the deadlines of the reads on the upstream
+ * channel rather than a timer. Once more than max_idle_keys keys have empty windows, the state of a key is evicted as
+ * its window closes and evict_fn is called with the key. Windows still open when the input completes are emitted.
+ *
+ * Only the rank 0 context drives the node; to aggregate across engines, partition the keys with a HashPartitioner
+ * into one window node per partition.
+ */
+template <typename T, typename KeyT = std::monostate, typename ContextT = runnable::Context>
+class Window : public SinkChannel<T>,
+               public SourceChannel<KeyedWindow<KeyT, T>>,
+               public runnable::RunnableWithContext<ContextT>
+{
+  public:
+    using output_t   = KeyedWindow<KeyT, T>;
+    using key_fn_t   = std::function<KeyT(const T&)>;
+    using evict_fn_t = std::function<void(const KeyT&)>;
+
+    Window(WindowOptions options, key_fn_t key_fn = nullptr, evict_fn_t evict_fn = nullptr) :
+      m_options(options),
+      m_key_fn(std::move(key_fn)),
+      m_evict_fn(std::move(evict_fn))
+    {
+        CHECK_GT(m_options.size, 0);
+        if (m_options.slide == 0)
+        {
+            m_options.slide = m_options.size;
+        }
+        CHECK_LE(m_options.slide, m_options.size) << "windows with gaps between them are not supported";
+
+        if (m_options.reserve == 0 && m_options.kind == WindowKind::Count)
+        {
+            m_options.reserve = m_options.size;
+        }
+
+        if (!m_key_fn)
+        {
+            if constexpr (std::is_same_v<KeyT, std::monostate>)
+            {
+                m_key_fn = [](const T& /*data*/) { return std::monostate{}; };
+            }
+            else
+            {
+                LOG(FATAL) << "a keyed window requires a key_fn";
+            }
+        }
+    }
+
+    ~Window() override = default;
+
+    std::size_t key_count() const
+    {
+        return m_states.size();
+    }
+
+  private:
+    struct KeyState
+    {
+        std::vector<T> elements;
+        channel::time_point_t deadline;
+        std::uint64_t generation{0};
+    };
+
+    struct Deadline
+    {
+        channel::time_point_t deadline;
+        std::uint64_t generation;
+        KeyT key;
+
+        bool operator>(const Deadline& other) const
+        {
+            return deadline > other.deadline;
+        }
+    };
+
+    void add(T&& data)
+    {
+        auto key            = m_key_fn(data);
+        auto [it, inserted] = m_states.try_emplace(key);
+        auto& state         = it->second;
+        const bool was_idle = state.elements.empty();
+        const auto now      = channel::clock_t::now();
+
+        if (inserted)
+        {
+            state.elements.reserve(m_options.reserve);
+        }
+        else if (was_idle)
+        {
+            --m_idle_keys;
+        }
+
+        state.elements.push_back(std::move(data));
+
+        switch (m_options.kind)
+        {
+        case WindowKind::Count:
+            if (state.elements.size() >= m_options.size)
+            {
+                close(it);
+            }
+            break;
+
+        case WindowKind::Time:
+            if (was_idle)
+            {
+                schedule(key, state, now + m_options.duration);
+            }
+            break;
+
+        case WindowKind::Session:
+            schedule(key, state, now + m_options.gap);
+            break;
+        }
+    }
+
+    // earlier deadlines of the key are invalidated by the generation, so only the latest deadline closes the window
+    void schedule(const KeyT& key, KeyState& state, channel::time_point_t deadline)
+    {
+        state.deadline = deadline;
+        m_deadlines.push(Deadline{deadline, ++state.generation, key});
+    }
+
+    void close(typename std::unordered_map<KeyT, KeyState>::iterator it)
+    {
+        auto& state = it->second;
+
+        if (m_options.kind == WindowKind::Count && state.elements.size() > m_options.slide)
+        {
+            // overlapping count windows keep the elements shared with the next window
+            SourceChannel<output_t>::await_write(output_t{it->first, state.elements});
+            state.elements.erase(state.elements.begin(), state.elements.begin() + m_options.slide);
+            return;
+        }
+
+        SourceChannel<output_t>::await_write(output_t{it->first, std::move(state.elements)});
+        state.elements.clear();
+        ++state.generation;
+
+        if (m_idle_keys >= m_options.max_idle_keys)
+        {
+            auto key = it->first;
+            m_states.erase(it);
+            if (m_evict_fn)
+            {
+                m_evict_fn(key);
+            }
+            return;
+        }
+
+        state.elements.reserve(m_options.reserve);
+        ++m_idle_keys;
+    }
+
+    void close_expired(channel::time_point_t now)
+    {
+        while (!m_deadlines.empty() && m_deadlines.top().deadline <= now)
+        {
+            auto top = m_deadlines.top();
+            m_deadlines.pop();
+
+            auto it = m_states.find(top.key);
+            if (it != m_states.end() && it->second.generation == top.generation && !it->second.elements.empty())
+            {
+                close(it);
+            }
+        }
+    }
+
+    void run(ContextT& ctx) final
+    {
+        if (ctx.rank() == 0)
+        {
+            auto& egress = SinkChannel<T>::egress();
+
+            while (true)
+            {
+                T data;
+                auto rc = (m_deadlines.empty() ? egress.await_read(data)
+                                               : egress.await_read_until(data, m_deadlines.top().deadline));
+                if (rc == channel::Status::success)
+                {
+                    add(std::move(data));
+                }
+                else if (rc != channel::Status::timeout)
+                {
+                    break;
+                }
+
+                close_expired(channel::clock_t::now());
+            }
+
+            // emit the windows which are still open
+            for (auto it = m_states.begin(); it != m_states.end(); ++it)
+            {
+                if (!it->second.elements.empty())
+                {
+                    SourceChannel<output_t>::await_write(output_t{it->first, std::move(it->second.elements)});
+                }
+            }
+            m_states.clear();
+
+            DVLOG(10) << ctx.info() << " window releasing its downstream channel";
+            SourceChannel<output_t>::release_channel();
+        }
+        ctx.barrier();
+    }
+
+    void on_state_update(const runnable::Runnable::State& state) final
+    {
+        if (state == runnable::Runnable::State::Stop || state == runnable::Runnable::State::Kill)
+        {
+            SinkChannel<T>::disable_persistence();
+        }
+    }
+
+    WindowOptions m_options;
+    key_fn_t m_key_fn;
+    evict_fn_t m_evict_fn;
+
+    std::unordered_map<KeyT, KeyState> m_states;
+    std::size_t m_idle_keys{0};
+    std::priority_queue<Deadline, std::vector<Deadline>, std::greater<>> m_deadlines;
+};
+
+}  // namespace mrc::node
@@ -17,6 +17,7 @@
 
 #pragma once
 
+#include "mrc/constants.hpp"
 #include "mrc/runnable/types.hpp"
 
 #include <cstddef>
@@ -36,6 +37,39 @@ namespace mrc {
  */
 extern std::string default_engine_factory_name();
 
+/**
+ * @brief OS scheduling policy of the threads of an engine group
+ */
+enum class ThreadSchedulingPolicy
+{
+    // the policy inherited from the process, usually SCHED_OTHER
+    Default,
+    // SCHED_FIFO - real-time, runs until it blocks or yields
+    Fifo,
+    // SCHED_RR - real-time, round-robin between threads of the same priority
+    RoundRobin,
+    // SCHED_BATCH - cpu-bound threads which yield to interactive threads
+    Batch,
+    // SCHED_IDLE - only runs when nothing else is runnable
+    Idle,
+};
+
+struct ThreadSchedulingOptions
+{
+    ThreadSchedulingPolicy policy{ThreadSchedulingPolicy::Default};
+
+    // static priority of the real-time policies, from 1 (lowest) to 99 (highest); ignored by the other policies
+    int priority{1};
+
+    // nice level of the Default and Batch policies, from -20 (highest) to 19 (lowest); 0 leaves it unchanged
+    int nice{0};
+
+    bool is_default() const
+    {
+        return policy == ThreadSchedulingPolicy::Default && nice == 0;
+    }
+};
+
 struct EngineFactoryOptions
 {
     // number of logical cpus requested
@@ -52,6 +86,53 @@ struct EngineFactoryOptions
     // intersection with the union of all other groups is the nullset.
     // if true, the CpuSet assigned to this group can have full or partial overlap with other groups
     bool allow_overlap{false};
+
+    // numa node - if >= 0, the logical cpus of this group are taken from the given NUMA node of the topology; with
+    // memory binding enabled in the fiber pool options, allocations made on the engines' threads, e.g. by the nodes
+    // they run, are bound to the same NUMA node
+    int numa_node{-1};
+
+    // gpu id - if >= 0, the logical cpus of this group are taken from those local to the given CUDA device; may be
+    // combined with numa_node, in which case the cpus must satisfy both
+    int gpu_id{-1};
+
+    // cache domain - if >= 0, the logical cpus of this group are taken from the given last-level cache domain of the
+    // topology, e.g. the L3 cache of a CCX on chiplet cpus, so that the engines of the group share their cache; may be
+    // combined with numa_node and gpu_id. non-overlapping groups which are not pinned are placed within a single cache
+    // domain when one has enough free cpus
+    int cache_domain{-1};
+
+    // fiber stack size - if > 0, the usable size in bytes of the stacks of the fibers launched by this group, e.g. for
+    // nodes with deep recursion or large stack frames; otherwise the stack size of the fiber pool options is used. the
+    // fibers of a group take their stacks from a pool owned by the group, see FiberPoolOptions::stack_pool_capacity
+    std::size_t fiber_stack_size{0};
+
+    // fiber priority - priority at which the fiber scheduler runs the fibers of this group relative to the other fibers
+    // on the same threads; higher values run first
+    int fiber_priority{MRC_DEFAULT_FIBER_PRIORITY};
+
+    // scheduling - os scheduling policy applied to the threads of the logical cpus of this group, e.g. a real-time
+    // policy for a latency-critical path or Batch/Idle for bulk analytics; real-time policies and negative nice levels
+    // require CAP_SYS_NICE. only applied to groups whose cpus are not shared with other groups
+    ThreadSchedulingOptions scheduling{};
+
+    // cost class - runnables annotated with this cost class and launched on the default engine factory are launched
+    // on this group instead, e.g. a thread group for blocking io or the group pinned next to a gpu for gpu-heavy nodes
+    runnable::CostClass cost_class{runnable::CostClass::Unspecified};
+};
+
+/**
+ * @brief Logical cpus running the ucx progress engines and grpc completion queues of the partitions
+ */
+enum class NetworkThreadPlacement
+{
+    // network progress shares the logical cpu of main on each host partition
+    Main,
+    // each host partition reserves a logical cpu for its network progress, isolated from the compute pools
+    PerPartition,
+    // a single logical cpu reserved by the first host partition runs the network progress of all partitions; this
+    // isolates network progress from the compute pools at the cost of a single core on small machines
+    Shared,
 };
 
 /**
@@ -66,19 +147,29 @@ class EngineGroups final
     void set_engine_factory_options(std::string group_name, std::function<void(EngineFactoryOptions&)> options_fn);
     void set_dedicated_main_thread(bool default_false);
     void set_dedicated_network_thread(bool default_false);
+    void set_network_thread_placement(NetworkThreadPlacement default_main);
+    void set_network_thread_scheduling(ThreadSchedulingOptions scheduling);
     void set_default_engine_type(runnable::EngineType engine_type);
     void set_ignore_hyper_threads(bool default_false);
 
     const EngineFactoryOptions& engine_group_options(const std::string& name) const;
     const std::map<std::string, EngineFactoryOptions>& map() const;
+
+    /**
+     * @brief Name of the first engine group, in name order, serving the cost class; the default engine factory if none
+     */
+    std::string engine_factory_for(runnable::CostClass cost_class) const;
     bool dedicated_main_thread() const;
     bool dedicated_network_thread() const;
+    NetworkThreadPlacement network_thread_placement() const;
+    const ThreadSchedulingOptions& network_thread_scheduling() const;
     bool ignore_hyper_threads() const;
     runnable::EngineType default_engine_type() const;
 
   private:
     bool m_dedicated_main_thread{false};
-    bool m_dedicated_network_thread{false};
+    NetworkThreadPlacement m_network_thread_placement{NetworkThreadPlacement::Main};
+    ThreadSchedulingOptions m_network_thread_scheduling{};
     bool m_ignore_hyper_threads{false};
     runnable::EngineType m_default_engine_type{runnable::EngineType::Fiber};
     std::map<std::string, EngineFactoryOptions> m_engine_resource_groups;
@@ -17,6 +17,8 @@
 
 #pragma once
 
+#include <cstddef>
+
 namespace mrc {
 
 class FiberPoolOptions
@@ -39,14 +41,66 @@ class FiberPoolOptions
      **/
     FiberPoolOptions& enable_tracing_scheduler(bool default_false);
 
+    /**
+     * @brief enable work stealing between the fiber threads of the same host partition
+     *
+     * Ready fibers may migrate to, and resume on, an idle thread of the same host partition. Fibers which depend on
+     * thread-local state or on running on the thread they were enqueued on should not be used with work stealing.
+     **/
+    FiberPoolOptions& enable_work_stealing(bool default_false);
+
+    /**
+     * @brief wake idle fiber threads with a futex instead of a mutex/condition variable pair
+     **/
+    FiberPoolOptions& enable_futex_wakeup(bool default_false);
+
+    /**
+     * @brief number of times an idle fiber thread polls for a wakeup before parking on the futex
+     **/
+    FiberPoolOptions& futex_spin_count(std::size_t default_256);
+
+    /**
+     * @brief usable size in bytes of the stacks of the fibers launched by engine groups which do not set their own
+     **/
+    FiberPoolOptions& stack_size(std::size_t default_128kib);
+
+    /**
+     * @brief maximum number of free fiber stacks each fiber engine group keeps for reuse; 0 disables stack pooling
+     **/
+    FiberPoolOptions& stack_pool_capacity(std::size_t default_256);
+
+    /**
+     * @brief map a guard page below each pooled fiber stack so a stack overflow faults
+     **/
+    FiberPoolOptions& enable_stack_protection(bool default_false);
+
+    /**
+     * @brief populate the pages of pooled fiber stacks when they are mapped
+     **/
+    FiberPoolOptions& enable_stack_prefault(bool default_true);
+
     [[nodiscard]] bool enable_memory_binding() const;
     [[nodiscard]] bool enable_thread_binding() const;
     [[nodiscard]] bool enable_tracing_scheduler() const;
+    [[nodiscard]] bool enable_work_stealing() const;
+    [[nodiscard]] bool enable_futex_wakeup() const;
+    [[nodiscard]] std::size_t futex_spin_count() const;
+    [[nodiscard]] std::size_t stack_size() const;
+    [[nodiscard]] std::size_t stack_pool_capacity() const;
+    [[nodiscard]] bool enable_stack_protection() const;
+    [[nodiscard]] bool enable_stack_prefault() const;
 
   private:
     bool m_enable_memory_binding{true};
     bool m_enable_thread_binding{true};
     bool m_enable_tracing_scheduler{false};
+    bool m_enable_work_stealing{false};
+    bool m_enable_futex_wakeup{false};
+    std::size_t m_futex_spin_count{256};
+    std::size_t m_stack_size{128 * 1024};
+    std::size_t m_stack_pool_capacity{256};
+    bool m_enable_stack_protection{false};
+    bool m_enable_stack_prefault{true};
 };
 
 }  // namespace mrc
@@ -0,0 +1,138 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "mrc/runnable/launch_options.hpp"
+
+#include <chrono>
+#include <cstddef>
+#include <map>
+#include <set>
+#include <string>
+
+namespace mrc {
+
+/**
+ * @brief How the load balancing manifold of a port picks the downstream segment instance of each element
+ */
+enum class EgressPolicy
+{
+    // cycle through the instances
+    RoundRobin,
+    // the instance whose ingress channel holds the fewest elements
+    ShortestQueue,
+    // the less occupied of two instances sampled at random; approximates ShortestQueue without inspecting every
+    // instance on each write
+    PowerOfTwoChoices,
+    // the least occupied instance on the partition of the manifold while it has capacity, otherwise the least occupied
+    // instance on any partition
+    LocalityFirst,
+    // the least occupied instance; an element still queued at its instance past the hedge threshold is written again to
+    // the least occupied other instance, see HedgeOptions. Only for copyable elements and idempotent downstream stages.
+    Hedged,
+};
+
+/**
+ * @brief Threshold past which the Hedged egress policy re-dispatches an element which was not yet dequeued by the
+ * downstream segment it was written to
+ */
+struct HedgeOptions
+{
+    // percentile of the recently observed dequeue latencies used as the threshold
+    double percentile{0.99};
+
+    // lower bound of the threshold
+    std::chrono::microseconds min_delay{1000};
+
+    // latencies observed before the first element is hedged
+    std::size_t warmup{32};
+
+    // elements tracked per downstream segment; the oldest elements are no longer hedged once exceeded
+    std::size_t max_pending{1024};
+};
+
+class ManifoldOptions
+{
+  public:
+    void set_egress_policy(const std::string& port_name, EgressPolicy policy);
+    void set_default_egress_policy(EgressPolicy default_round_robin);
+
+    /**
+     * @brief maximum number of elements the load balancer forwards to a downstream segment at once; 1 forwards each
+     * element as it arrives
+     */
+    void set_batch_size(std::size_t default_1);
+
+    /**
+     * @brief maximum time the load balancer waits for a batch to fill after its first element arrives
+     */
+    void set_batch_window(std::chrono::microseconds default_0us);
+
+    /**
+     * @brief threshold of the ports using the Hedged egress policy
+     */
+    void set_hedge_options(const HedgeOptions& options);
+
+    /**
+     * @brief launch options of the load balancer of a port, e.g. to run it on the engines of a dedicated engine group
+     * rather than the main engine; the engines are taken from the partition on which the manifold is constructed
+     */
+    void set_launch_options(const std::string& port_name, runnable::LaunchOptions launch_options);
+
+    /**
+     * @brief launch options of the load balancers of ports without port specific launch options; defaults to 8 fiber
+     * engines on one pe of the main engine factory
+     */
+    void set_default_launch_options(runnable::LaunchOptions launch_options);
+
+    /**
+     * @brief connect the single upstream segment of eligible ports directly to their single downstream segment, without
+     * a load balancer; a port is eligible if one segment writes to it and one segment reads from it, and neither is
+     * scaled beyond one instance, see manifold::DirectManifold
+     */
+    void set_enable_direct_connections(bool default_true);
+
+    /**
+     * @brief use a direct connection for a port; set by the pipeline on its eligible ports
+     */
+    void set_direct_connection(const std::string& port_name, bool direct);
+
+    [[nodiscard]] EgressPolicy egress_policy(const std::string& port_name) const;
+    [[nodiscard]] bool has_egress_policy(const std::string& port_name) const;
+    [[nodiscard]] EgressPolicy default_egress_policy() const;
+    [[nodiscard]] std::size_t batch_size() const;
+    [[nodiscard]] std::chrono::microseconds batch_window() const;
+    [[nodiscard]] const HedgeOptions& hedge_options() const;
+    [[nodiscard]] const runnable::LaunchOptions& launch_options(const std::string& port_name) const;
+    [[nodiscard]] const runnable::LaunchOptions& default_launch_options() const;
+    [[nodiscard]] bool enable_direct_connections() const;
+    [[nodiscard]] bool direct_connection(const std::string& port_name) const;
+
+  private:
+    std::map<std::string, EgressPolicy> m_egress_policies;
+    EgressPolicy m_default_egress_policy{EgressPolicy::RoundRobin};
+    std::size_t m_batch_size{1};
+    std::chrono::microseconds m_batch_window{0};
+    HedgeOptions m_hedge_options;
+    std::map<std::string, runnable::LaunchOptions> m_launch_options;
+    runnable::LaunchOptions m_default_launch_options{"main", 1, 8};
+    bool m_enable_direct_connections{true};
+    std::set<std::string> m_direct_connections;
+};
+
+}  // namespace mrc
@@ -0,0 +1,253 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+
+namespace mrc {
+
+/**
+ * @brief transports the data plane may use
+ */
+enum class NetworkTransport
+{
+    // transports selected by ucx, falling back to tcp if ucx can not be initialized with them
+    Auto,
+    // tcp sockets only, e.g. for hosts without rdma or containers without access to shared memory transports
+    Tcp,
+};
+
+class NetworkOptions
+{
+  public:
+    NetworkOptions() = default;
+
+    /**
+     * @brief block idle ucx progress engines on the worker's event file descriptor instead of polling
+     *
+     * Requests interrupt notification support from ucx, which may exclude transports without event support.
+     **/
+    NetworkOptions& enable_progress_engine_wakeup(bool default_false);
+
+    /**
+     * @brief number of consecutive polls without work before an idle progress engine blocks for a wakeup
+     **/
+    NetworkOptions& progress_engine_busy_polls(std::size_t default_1024);
+
+    /**
+     * @brief maximum time an idle progress engine blocks the network thread for a wakeup before polling again
+     **/
+    NetworkOptions& progress_engine_wakeup_timeout(std::chrono::microseconds default_1ms);
+
+    /**
+     * @brief restrict the ucx network devices of a gpu partition to the nics with the closest pcie affinity to its gpu
+     *
+     * Ignored if UCX_NET_DEVICES is set in the environment.
+     **/
+    NetworkOptions& enable_nic_affinity(bool default_true);
+
+    /**
+     * @brief maximum number of rails ucx may stripe a single rendezvous or rma transfer across; 0 keeps the ucx default
+     **/
+    NetworkOptions& max_rails(std::size_t default_0);
+
+    /**
+     * @brief size of the stripes large rdma gets are split into, allowing concurrent stripes to proceed on different
+     * rails; 0 disables striping
+     **/
+    NetworkOptions& rma_stripe_size(std::size_t default_4MiB);
+
+    /**
+     * @brief maximum number of bytes of on demand registrations of buffers not owned by a memory pool which are kept
+     * registered once released
+     **/
+    NetworkOptions& registration_cache_size(std::size_t default_1GiB);
+
+    /**
+     * @brief time over which token releases of remote descriptors owned by the same remote instance are coalesced into
+     * a single active message; 0 sends every release immediately
+     **/
+    NetworkOptions& token_release_window(std::chrono::microseconds default_100us);
+
+    /**
+     * @brief maximum number of coalesced token releases sent in a single active message
+     **/
+    NetworkOptions& token_release_batch_size(std::size_t default_64);
+
+    /**
+     * @brief time over which control plane events which are not awaited by the server, e.g. update acknowledgements,
+     * are coalesced into a single write; 0 writes every event immediately
+     **/
+    NetworkOptions& control_plane_batch_window(std::chrono::microseconds default_100us);
+
+    /**
+     * @brief whether the nics can read and write device memory directly; if disabled, point-to-point transfers of
+     * device memory are staged through pinned host buffers
+     **/
+    NetworkOptions& enable_gpudirect(bool default_true);
+
+    /**
+     * @brief size of the pinned host buffers device memory transfers are staged through; must match on all instances
+     **/
+    NetworkOptions& staging_chunk_size(std::size_t default_1MiB);
+
+    /**
+     * @brief maximum number of staging buffers per host partition, rounded up to a power of 2
+     **/
+    NetworkOptions& staging_chunk_count(std::size_t default_8);
+
+    /**
+     * @brief maximum number of cached endpoints to remote instances; the least recently used endpoints which are not
+     * held elsewhere are closed beyond it; 0 does not bound the cache
+     **/
+    NetworkOptions& max_endpoints(std::size_t default_0);
+
+    /**
+     * @brief time after its last use at which a cached endpoint which is not held elsewhere is closed; 0 keeps idle
+     * endpoints open
+     **/
+    NetworkOptions& endpoint_idle_timeout(std::chrono::milliseconds default_0);
+
+    /**
+     * @brief send remote descriptors as ucx active messages instead of tagged messages matched by pre-posted recvs;
+     * must match on all instances
+     **/
+    NetworkOptions& enable_active_messages(bool default_true);
+
+    /**
+     * @brief maximum number of bytes of the messages to a remote instance aggregated into a single active message
+     **/
+    NetworkOptions& active_message_batch_bytes(std::size_t default_64KiB);
+
+    /**
+     * @brief bounds of the pool of recvs pre-posted for eager tagged messages when active messages are disabled; the
+     * pool grows when eager messages arrive with no recv posted and shrinks when idle
+     **/
+    NetworkOptions& min_pre_posted_recvs(std::size_t default_4);
+    NetworkOptions& max_pre_posted_recvs(std::size_t default_64);
+
+    /**
+     * @brief interval over which the arrivals of eager tagged messages are counted to decide whether the pool of
+     * pre-posted recvs shrinks
+     **/
+    NetworkOptions& pre_posted_recv_window(std::chrono::milliseconds default_100ms);
+
+    /**
+     * @brief number of ucx workers of each partition, each progressed on its own cpu of the mrc_network engine
+     * factory, which is given one cpu per worker when network threads are dedicated; endpoints to remote instances are
+     * sharded across the workers, while all messages from remote instances are received by the first worker
+     **/
+    NetworkOptions& workers_per_partition(std::size_t default_1);
+
+    /**
+     * @brief maximum number of bytes of rdma pulls of remote descriptor payloads in flight per partition; a larger pull
+     * is issued once no other pull is in flight; 0 does not bound the bytes in flight
+     **/
+    NetworkOptions& max_pull_bytes_in_flight(std::size_t default_256MiB);
+
+    /**
+     * @brief maximum number of concurrent rdma pulls from a single remote instance per partition
+     **/
+    NetworkOptions& max_pulls_per_instance(std::size_t default_16);
+
+    /**
+     * @brief latency of a single pull above which the concurrent pulls from its remote instance are halved; pulls
+     * within it grow their number back towards max_pulls_per_instance; 0 disables the adaptation
+     **/
+    NetworkOptions& pull_latency_target(std::chrono::microseconds default_0);
+
+    /**
+     * @brief transports of the ucx contexts; with tcp, ucx is not restricted to the nics closest to a gpu and device
+     * memory is staged through pinned host buffers as if gpudirect was disabled
+     *
+     * Ignored if UCX_TLS is set in the environment.
+     **/
+    NetworkOptions& transport(NetworkTransport default_auto);
+
+    /**
+     * @brief subscribers receive remote descriptors from publishers of other processes on the same host through a
+     * shared memory ring instead of the data plane; publishers fall back to the data plane for subscribers without a
+     * ring
+     **/
+    NetworkOptions& enable_shm_rings(bool default_false);
+
+    /**
+     * @brief size of the shared memory ring of each subscriber; bounds the bytes of remote descriptors queued to it
+     **/
+    NetworkOptions& shm_ring_bytes(std::size_t default_4MiB);
+
+    [[nodiscard]] bool enable_progress_engine_wakeup() const;
+    [[nodiscard]] std::size_t progress_engine_busy_polls() const;
+    [[nodiscard]] std::chrono::microseconds progress_engine_wakeup_timeout() const;
+    [[nodiscard]] bool enable_nic_affinity() const;
+    [[nodiscard]] std::size_t max_rails() const;
+    [[nodiscard]] std::size_t rma_stripe_size() const;
+    [[nodiscard]] std::size_t registration_cache_size() const;
+    [[nodiscard]] std::chrono::microseconds token_release_window() const;
+    [[nodiscard]] std::size_t token_release_batch_size() const;
+    [[nodiscard]] std::chrono::microseconds control_plane_batch_window() const;
+    [[nodiscard]] bool enable_gpudirect() const;
+    [[nodiscard]] std::size_t staging_chunk_size() const;
+    [[nodiscard]] std::size_t staging_chunk_count() const;
+    [[nodiscard]] std::size_t max_endpoints() const;
+    [[nodiscard]] std::chrono::milliseconds endpoint_idle_timeout() const;
+    [[nodiscard]] bool enable_active_messages() const;
+    [[nodiscard]] std::size_t active_message_batch_bytes() const;
+    [[nodiscard]] std::size_t min_pre_posted_recvs() const;
+    [[nodiscard]] std::size_t max_pre_posted_recvs() const;
+    [[nodiscard]] std::chrono::milliseconds pre_posted_recv_window() const;
+    [[nodiscard]] std::size_t workers_per_partition() const;
+    [[nodiscard]] std::size_t max_pull_bytes_in_flight() const;
+    [[nodiscard]] std::size_t max_pulls_per_instance() const;
+    [[nodiscard]] std::chrono::microseconds pull_latency_target() const;
+    [[nodiscard]] NetworkTransport transport() const;
+    [[nodiscard]] bool enable_shm_rings() const;
+    [[nodiscard]] std::size_t shm_ring_bytes() const;
+
+  private:
+    bool m_enable_progress_engine_wakeup{false};
+    std::size_t m_progress_engine_busy_polls{1024};
+    std::chrono::microseconds m_progress_engine_wakeup_timeout{1000};
+    bool m_enable_nic_affinity{true};
+    std::size_t m_max_rails{0};
+    std::size_t m_rma_stripe_size{4UL << 20};
+    std::size_t m_registration_cache_size{1UL << 30};
+    std::chrono::microseconds m_token_release_window{100};
+    std::size_t m_token_release_batch_size{64};
+    std::chrono::microseconds m_control_plane_batch_window{100};
+    bool m_enable_gpudirect{true};
+    std::size_t m_staging_chunk_size{1UL << 20};
+    std::size_t m_staging_chunk_count{8};
+    std::size_t m_max_endpoints{0};
+    std::chrono::milliseconds m_endpoint_idle_timeout{0};
+    bool m_enable_active_messages{true};
+    std::size_t m_active_message_batch_bytes{64UL << 10};
+    std::size_t m_min_pre_posted_recvs{4};
+    std::size_t m_max_pre_posted_recvs{64};
+    std::chrono::milliseconds m_pre_posted_recv_window{100};
+    std::size_t m_workers_per_partition{1};
+    std::size_t m_max_pull_bytes_in_flight{256UL << 20};
+    std::size_t m_max_pulls_per_instance{16};
+    std::chrono::microseconds m_pull_latency_target{0};
+    NetworkTransport m_transport{NetworkTransport::Auto};
+    bool m_enable_shm_rings{false};
+    std::size_t m_shm_ring_bytes{4UL << 20};
+};
+
+}  // namespace mrc
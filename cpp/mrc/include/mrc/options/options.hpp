@@ -19,14 +19,20 @@
 
 #include "mrc/options/engine_groups.hpp"
 #include "mrc/options/fiber_pool.hpp"
+#include "mrc/options/manifolds.hpp"
+#include "mrc/options/network.hpp"
 #include "mrc/options/placement.hpp"
+#include "mrc/options/quotas.hpp"
 #include "mrc/options/resources.hpp"
+#include "mrc/options/scaling.hpp"
 #include "mrc/options/services.hpp"
 #include "mrc/options/topology.hpp"
 
+#include <cstddef>
 #include <cstdint>
 #include <memory>
 #include <string>
+#include <vector>
 
 namespace mrc {
 
@@ -37,40 +43,78 @@ class Options
 
     EngineGroups& engine_factories();
     FiberPoolOptions& fiber_pool();
+    ManifoldOptions& manifolds();
+    NetworkOptions& network();
     PlacementOptions& placement();
+    QuotaOptions& quotas();
     ResourceOptions& resources();
+    ScalingOptions& scaling();
     ServiceOptions& services();
     TopologyOptions& topology();
 
+    // a comma separated list of urls is tried in order; the client fails over to the next url if the leader is lost
     void architect_url(std::string url);
     void enable_server(bool default_false);
     void server_port(std::uint16_t port);
+
+    // number of completion queues the client streams of the server are sharded across, each progressed by a dedicated
+    // thread blocking on the queue
+    void server_completion_queues(std::size_t default_1);
+
+    // urls of the other architect replicas; the server is a standby replica of the leader among them, or is promoted
+    // to leader once no peer is the leader and no reachable standby peer has a lower priority
+    void architect_peers(std::vector<std::string> urls);
+    void architect_priority(std::uint32_t default_0);
     void config_request(std::string config);
 
+    // serves the metrics of all registries in the prometheus text format on http://<host>:<metrics_port>/metrics
+    // from a dedicated thread while the executor is running; port 0 binds an ephemeral port
+    void enable_metrics_server(bool default_false);
+    void metrics_port(std::uint16_t default_9464);
+
     [[nodiscard]] const EngineGroups& engine_factories() const;
     [[nodiscard]] const FiberPoolOptions& fiber_pool() const;
+    [[nodiscard]] const ManifoldOptions& manifolds() const;
+    [[nodiscard]] const NetworkOptions& network() const;
     [[nodiscard]] const PlacementOptions& placement() const;
+    [[nodiscard]] const QuotaOptions& quotas() const;
     [[nodiscard]] const ResourceOptions& resources() const;
+    [[nodiscard]] const ScalingOptions& scaling() const;
     [[nodiscard]] const ServiceOptions& services() const;
     [[nodiscard]] const TopologyOptions& topology() const;
 
     [[nodiscard]] const std::string& architect_url() const;
+    [[nodiscard]] std::vector<std::string> architect_urls() const;
+    [[nodiscard]] const std::vector<std::string>& architect_peers() const;
+    [[nodiscard]] std::uint32_t architect_priority() const;
     [[nodiscard]] const std::string& config_request() const;
     [[nodiscard]] bool enable_server() const;
     [[nodiscard]] std::uint16_t server_port() const;
+    [[nodiscard]] std::size_t server_completion_queues() const;
+    [[nodiscard]] bool enable_metrics_server() const;
+    [[nodiscard]] std::uint16_t metrics_port() const;
 
   private:
     std::unique_ptr<EngineGroups> m_engine_groups;
     std::unique_ptr<FiberPoolOptions> m_fiber_pool;
+    std::unique_ptr<ManifoldOptions> m_manifolds;
+    std::unique_ptr<NetworkOptions> m_network;
     std::unique_ptr<PlacementOptions> m_placement;
+    std::unique_ptr<QuotaOptions> m_quotas;
     std::unique_ptr<ResourceOptions> m_resources;
+    std::unique_ptr<ScalingOptions> m_scaling;
     std::unique_ptr<ServiceOptions> m_services;
     std::unique_ptr<TopologyOptions> m_topology;
 
     std::string m_architect_url;
     bool m_enable_server{false};
     std::uint16_t m_server_port{13337};
+    std::size_t m_server_completion_queues{1};
+    std::vector<std::string> m_architect_peers;
+    std::uint32_t m_architect_priority{0};
     std::string m_config_request{"*:1:*"};
+    bool m_enable_metrics_server{false};
+    std::uint16_t m_metrics_port{9464};
 };
 
 }  // namespace mrc
@@ -45,11 +45,10 @@
  * - PlacementStrategy == PerMachine
  * - PlacementResources == Dedicated
  * ==> 4 GpuPartitions are created each with a dedicated HostPartition of 32 unique cpus_ids and 128 GB of host memory
- * ==> the gpus in each host partition not by numa aligned as the order in which the subdivision of host resources is
- * split does not take into consideration numa placement, simply enumerating all the devices, spliting the resources,
- * and making assignments in the order the devices were enumerated
- * ==> todo(create_issue) - an effort should be made to align gpus and paritions similar to the next scenario, but no
- * guarantees
+ * ==> each gpu is given the cores local to its pcie attachment; gpus sharing a locality split its cores evenly, in
+ * the order of their pcie bus ids
+ * ==> if the gpus sharing a locality outnumber its cores, the host resources are split evenly across the gpus and each
+ * split is assigned the gpu with the most overlapping cpus
  *
  * Scenario 2 (optimal for DGX)
  * - the process has access to the entire machine with the default affinity set to all cpus, all GPUs are visible
@@ -65,9 +64,7 @@
  * - PlacementResources == Dedicated
  * ==> PerNumaNode warns of asymmetry; falls back to PerMachine
  * ==> 2 GpuParitions are created each a HostPartition with 64cpus and 256GB memory
- * ==> the gpus may not be optimally aligned
- * ==> todo(create_issue) - an effort should be made to align gpus and paritions similar to the previous scenario, but
- * no guarantees
+ * ==> the gpus are aligned with their local cpus as in Scenario 1
  *
  * Scenario 4
  * - the process has access to the entire machine with the default affinity set to all cpus, all GPUs are visible
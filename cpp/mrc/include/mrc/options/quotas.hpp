@@ -0,0 +1,79 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <string>
+
+namespace mrc {
+
+/**
+ * @brief Limits on the resources used by each instance of a segment, so a noisy segment can not starve the other
+ * segments sharing its partition; a value of 0 leaves the resource unbounded
+ */
+class SegmentQuotaOptions
+{
+  public:
+    SegmentQuotaOptions() = default;
+
+    /**
+     * @brief weight of the fibers of the segment relative to the other weighted segments ready at the same fiber
+     * priority on a thread; unweighted fibers are scheduled as a single group of weight 1.
+     **/
+    SegmentQuotaOptions& cpu_weight(std::uint32_t default_0);
+
+    /**
+     * @brief bytes the nodes of the segment may hold in the tracked host and device memory resources; allocations past
+     * the quota throw std::bad_alloc. Requires ResourceOptions::enable_memory_tracking.
+     **/
+    SegmentQuotaOptions& memory_bytes(std::size_t default_0);
+
+    /**
+     * @brief bytes of data buffered in the input channels of the nodes of an instance, counted as the size of the
+     * channel elements; writers block once the budget of the instance is exhausted, except for a write into a channel
+     * holding none of the budget, so every stage of the segment keeps making progress.
+     **/
+    SegmentQuotaOptions& in_flight_bytes(std::size_t default_0);
+
+    [[nodiscard]] std::uint32_t cpu_weight() const;
+    [[nodiscard]] std::size_t memory_bytes() const;
+    [[nodiscard]] std::size_t in_flight_bytes() const;
+
+  private:
+    std::uint32_t m_cpu_weight{0};
+    std::size_t m_memory_bytes{0};
+    std::size_t m_in_flight_bytes{0};
+};
+
+class QuotaOptions
+{
+  public:
+    void set_segment_options(const std::string& segment_name, const SegmentQuotaOptions& options);
+    void set_default_options(const SegmentQuotaOptions& options);
+
+    [[nodiscard]] const SegmentQuotaOptions& segment_options(const std::string& segment_name) const;
+    [[nodiscard]] const SegmentQuotaOptions& default_options() const;
+
+  private:
+    std::map<std::string, SegmentQuotaOptions> m_segment_options;
+    SegmentQuotaOptions m_default_options;
+};
+
+}  // namespace mrc
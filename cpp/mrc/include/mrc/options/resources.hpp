@@ -21,6 +21,17 @@
 
 namespace mrc {
 
+enum class PageSize
+{
+    // regular pages from the default allocator of the memory kind
+    Default,
+    // 2MiB aligned allocations advised to be backed by transparent huge pages
+    Transparent,
+    // explicit huge pages, which must be reserved by the system
+    Huge2MiB,
+    Huge1GiB,
+};
+
 class MemoryPoolOptions
 {
   public:
@@ -37,6 +48,29 @@ class MemoryPoolOptions
         return *this;
     }
 
+    /**
+     * @brief pages backing the host memory of a partition, bound to the numa nodes of the partition; this applies to
+     * the blocks of the pool as well as the other registered host buffers, e.g. the transient pool. Ignored for the
+     * device memory pool.
+     **/
+    MemoryPoolOptions& page_size(PageSize page_size)
+    {
+        m_page_size = page_size;
+        return *this;
+    }
+
+    /**
+     * @brief bind the pages of the host memory of a partition to the numa nodes of the partition and fault them in when
+     * allocated (default: false); the initial block of the pool is then faulted in by the main thread of the partition
+     * instead of by the first node touching it. Regular pages are mapped per allocation instead of taken from
+     * malloc/cudaHostAlloc. Ignored for the device memory pool.
+     **/
+    MemoryPoolOptions& numa_first_touch(bool default_false)
+    {
+        m_numa_first_touch = default_false;
+        return *this;
+    }
+
     [[nodiscard]] std::size_t block_size() const
     {
         return m_block_size;
@@ -45,10 +79,20 @@ class MemoryPoolOptions
     {
         return m_max_aggregate_bytes;
     }
+    [[nodiscard]] PageSize page_size() const
+    {
+        return m_page_size;
+    }
+    [[nodiscard]] bool numa_first_touch() const
+    {
+        return m_numa_first_touch;
+    }
 
   private:
     std::size_t m_block_size;
     std::size_t m_max_aggregate_bytes;
+    PageSize m_page_size{PageSize::Default};
+    bool m_numa_first_touch{false};
 };
 
 class ResourceOptions
@@ -70,6 +114,14 @@ class ResourceOptions
      */
     ResourceOptions& enable_device_memory_pool(bool);
 
+    /**
+     * @brief account the allocations of the host and device memory resources to the allocating segment node, see
+     * memory::MemoryTracker (default: false)
+     *
+     * @return ResourceOptions&
+     */
+    ResourceOptions& enable_memory_tracking(bool);
+
     /**
      * @brief respect the process affinity as launch by the system (default: true)
      **/
@@ -82,12 +134,14 @@ class ResourceOptions
 
     bool enable_host_memory_pool() const;
     bool enable_device_memory_pool() const;
+    bool enable_memory_tracking() const;
     const MemoryPoolOptions& host_memory_pool() const;
     const MemoryPoolOptions& device_memory_pool() const;
 
   private:
     bool m_enable_host_memory_pool{false};
     bool m_enable_device_memory_pool{false};
+    bool m_enable_memory_tracking{false};
     MemoryPoolOptions m_host_memory_pool;
     MemoryPoolOptions m_device_memory_pool;
 };
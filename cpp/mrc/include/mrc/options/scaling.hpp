@@ -0,0 +1,138 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <map>
+#include <string>
+
+namespace mrc {
+
+enum class ScalingStrategy
+{
+    Static,
+    Dynamic,
+};
+
+/**
+ * @brief Number of instances of a segment; with the Dynamic strategy, instances are added when their ingress queues
+ * back up and drained when the load drops, always staying within [min_count, max_count]
+ */
+class SegmentScalingOptions
+{
+  public:
+    SegmentScalingOptions() = default;
+
+    SegmentScalingOptions& strategy(ScalingStrategy default_static);
+    SegmentScalingOptions& initial_count(std::size_t default_1);
+    SegmentScalingOptions& min_count(std::size_t default_1);
+    SegmentScalingOptions& max_count(std::size_t default_1);
+
+    /**
+     * @brief minimum time between two scaling decisions of the segment
+     **/
+    SegmentScalingOptions& cooldown(std::chrono::milliseconds default_30s);
+
+    /**
+     * @brief mean ingress queue depth per instance above which an instance is added; 0 disables scaling up
+     **/
+    SegmentScalingOptions& scale_up_queue_depth(std::size_t default_64);
+
+    /**
+     * @brief mean ingress queue depth per instance at or below which an instance may be drained
+     **/
+    SegmentScalingOptions& scale_down_queue_depth(std::size_t default_0);
+
+    /**
+     * @brief messages per second a single instance sustains; when set, an instance is only drained if the remaining
+     * instances can carry the observed throughput
+     **/
+    SegmentScalingOptions& instance_throughput(double default_0);
+
+    /**
+     * @brief number of pre-built, un-started instances of the segment kept ready on each partition, so instances added
+     * by an assignment update are only attached to their manifolds and started
+     *
+     * The instances are built for the lowest free ranks of the segment, each on partition rank % partition_count, as
+     * assigned by the Dynamic strategy; other assignments build their instances on demand.
+     **/
+    SegmentScalingOptions& warm_pool_size(std::size_t default_0);
+
+    /**
+     * @brief upper bound on the time a removed instance is given to flush its in-flight data; 0 waits for completion
+     *
+     * When set, instances without ingress ports only stop their sources, so the data already emitted drains through
+     * the downstream nodes of the segment; any node still active at the deadline is killed.
+     **/
+    SegmentScalingOptions& drain_timeout(std::chrono::milliseconds default_0);
+
+    [[nodiscard]] ScalingStrategy strategy() const;
+    [[nodiscard]] std::size_t initial_count() const;
+    [[nodiscard]] std::size_t min_count() const;
+    [[nodiscard]] std::size_t max_count() const;
+    [[nodiscard]] std::chrono::milliseconds cooldown() const;
+    [[nodiscard]] std::size_t scale_up_queue_depth() const;
+    [[nodiscard]] std::size_t scale_down_queue_depth() const;
+    [[nodiscard]] double instance_throughput() const;
+    [[nodiscard]] std::size_t warm_pool_size() const;
+    [[nodiscard]] std::chrono::milliseconds drain_timeout() const;
+
+  private:
+    ScalingStrategy m_strategy{ScalingStrategy::Static};
+    std::size_t m_initial_count{1};
+    std::size_t m_min_count{1};
+    std::size_t m_max_count{1};
+    std::chrono::milliseconds m_cooldown{30000};
+    std::size_t m_scale_up_queue_depth{64};
+    std::size_t m_scale_down_queue_depth{0};
+    double m_instance_throughput{0};
+    std::size_t m_warm_pool_size{0};
+    std::chrono::milliseconds m_drain_timeout{0};
+};
+
+class ScalingOptions
+{
+  public:
+    void set_segment_options(const std::string& segment_name, const SegmentScalingOptions& options);
+    void set_default_options(const SegmentScalingOptions& options);
+
+    /**
+     * @brief interval at which the ingress load of dynamically scaled segments is sampled
+     **/
+    ScalingOptions& evaluation_interval(std::chrono::milliseconds default_1s);
+
+    /**
+     * @brief maximum number of segment instances an assignment update constructs or starts concurrently across the
+     * partitions; 0 is unbounded
+     **/
+    ScalingOptions& startup_parallelism(std::size_t default_16);
+
+    [[nodiscard]] const SegmentScalingOptions& segment_options(const std::string& segment_name) const;
+    [[nodiscard]] const SegmentScalingOptions& default_options() const;
+    [[nodiscard]] std::chrono::milliseconds evaluation_interval() const;
+    [[nodiscard]] std::size_t startup_parallelism() const;
+
+  private:
+    std::map<std::string, SegmentScalingOptions> m_segment_options;
+    SegmentScalingOptions m_default_options;
+    std::chrono::milliseconds m_evaluation_interval{1000};
+    std::size_t m_startup_parallelism{16};
+};
+
+}  // namespace mrc
@@ -19,6 +19,7 @@
 
 #include "mrc/core/bitmap.hpp"
 
+#include <cstddef>
 #include <string>
 
 namespace mrc {
@@ -31,6 +32,9 @@ class TopologyOptions
     // options not implemented
     // restrict gpus to the cpu_set            : default = false; true not implemented
     // restrict nics to the cpu_set            : default = ????? - not sure
+    //
+    // exclusive cpus assigned by the static policy of the kubernetes cpu manager, like any cgroup cpuset, are part of
+    // the process cpu_set; cpu quotas set through the cpu bandwidth controller are honored with use_cpu_quota
   public:
     TopologyOptions() = default;
 
@@ -65,11 +69,41 @@ class TopologyOptions
      */
     TopologyOptions& ignore_dgx_display(bool default_true);
 
+    /**
+     * @brief cache the discovered hardware topology in the file at path and reuse it on later starts on the same host;
+     * the cache is rediscovered if it was written on another host, boot or set of visible devices (default: empty -
+     * caching disabled)
+     */
+    TopologyOptions& cache_path(std::string path);
+
+    /**
+     * @brief limit the topology to as many logical cpus as the cgroup cpu quota of the process grants (default: true);
+     * a fractional quota is rounded down, to at least one logical cpu, so the pools sized by the topology do not
+     * oversubscribe the quota and get throttled
+     */
+    TopologyOptions& use_cpu_quota(bool default_true);
+
+    /**
+     * @brief drop the logical cpus isolated with the isolcpus kernel parameter from the topology, unless the process
+     * is bound to isolated cpus only (default: true)
+     */
+    TopologyOptions& exclude_isolated_cpus(bool default_true);
+
+    /**
+     * @brief upper bound on the number of logical cpus of the topology; logical cpus are kept one per core before any
+     * hyper-thread siblings (default: 0 - unbounded)
+     */
+    TopologyOptions& max_cpu_count(std::size_t default_0);
+
     [[nodiscard]] bool use_process_cpuset() const;
     [[nodiscard]] bool restrict_numa_domains() const;
     [[nodiscard]] bool restrict_gpus() const;
     [[nodiscard]] bool ignore_dgx_display() const;
     [[nodiscard]] const CpuSet& user_cpuset() const;
+    [[nodiscard]] const std::string& cache_path() const;
+    [[nodiscard]] bool use_cpu_quota() const;
+    [[nodiscard]] bool exclude_isolated_cpus() const;
+    [[nodiscard]] std::size_t max_cpu_count() const;
 
   private:
     bool m_use_process_cpuset{true};
@@ -77,6 +111,10 @@ class TopologyOptions
     bool m_restrict_gpus{false};
     bool m_ignore_dgx_display{true};
     CpuSet m_user_cpuset;
+    std::string m_cache_path;
+    bool m_use_cpu_quota{true};
+    bool m_exclude_isolated_cpus{true};
+    std::size_t m_max_cpu_count{0};
 };
 
 }  // namespace mrc
@@ -25,6 +25,10 @@
 #include <string>
 #include <utility>
 
+namespace mrc::runnable {
+struct CostHints;
+struct LaunchOptions;
+}  // namespace mrc::runnable
 namespace mrc::segment {
 struct EgressPortsBase;
 struct IngressPortsBase;
@@ -130,6 +134,30 @@ class Pipeline final : public internal::pipeline::IPipeline
     std::shared_ptr<segment::Definition> make_segment(const std::string& segment_name,
                                                       segment::EgressPortsBase egress_ports,
                                                       segment::segment_initializer_fn_t segment_initializer);
+
+    /**
+     * @brief Set the launch options of the manifold connecting the segments on a port, e.g. to run it on the engines
+     * of a dedicated engine group; overrides the launch options of Options::manifolds()
+     * @param port_name
+     * @param launch_options
+     */
+    void set_manifold_launch_options(const std::string& port_name, const runnable::LaunchOptions& launch_options);
+
+    /**
+     * @brief Declare the expected number of elements per second passing through a port; at registration, the egress
+     * policy of the manifold of the port is chosen from its rate unless Options::manifolds() sets one for the port
+     * @param port_name
+     * @param elements_per_second
+     */
+    void set_port_rate(const std::string& port_name, double elements_per_second);
+
+    /**
+     * @brief Declare the expected traffic through a port in elements and bytes per second; ports carrying a high
+     * bandwidth keep their traffic on the partition of their manifold, see set_port_rate
+     * @param port_name
+     * @param cost_hints
+     */
+    void set_port_cost_hints(const std::string& port_name, const runnable::CostHints& cost_hints);
 };
 
 std::unique_ptr<Pipeline> make_pipeline();
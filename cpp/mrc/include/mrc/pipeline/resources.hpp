@@ -22,6 +22,12 @@
 #include "mrc/metrics/registry.hpp"
 #include "mrc/runnable/launch_control.hpp"
 
+#include <memory>
+
+namespace mrc::coroutines {
+class ThreadPool;
+}  // namespace mrc::coroutines
+
 namespace mrc::pipeline {
 
 struct Resources
@@ -30,6 +36,12 @@ struct Resources
 
     virtual core::FiberTaskQueue& main()              = 0;
     virtual runnable::LaunchControl& launch_control() = 0;
+
+    /**
+     * @brief coroutine scheduler of the partition, with its executor threads pinned to the logical cpus of the default
+     * engine group and their memory bound to the numa nodes of those cpus; created on first use
+     */
+    virtual std::shared_ptr<coroutines::ThreadPool> coroutine_thread_pool() = 0;
     // virtual std::shared_ptr<metrics::Registry> metrics_registry() = 0;
 };
 
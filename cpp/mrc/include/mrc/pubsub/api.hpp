@@ -24,6 +24,7 @@
 #include "mrc/node/source_channel.hpp"
 #include "mrc/runtime/remote_descriptor.hpp"
 
+#include <cstdint>
 #include <string>
 
 namespace mrc::pubsub {
@@ -32,6 +33,10 @@ enum class PublisherPolicy
 {
     Broadcast,
     RoundRobin,
+    LeastOutstanding,
+    PowerOfTwoChoices,
+    LocalityAware,
+    ConsistentHash,
 };
 
 class IPublisherService : public virtual control_plane::ISubscriptionService
@@ -43,6 +48,10 @@ class IPublisherService : public virtual control_plane::ISubscriptionService
 
     virtual channel::Status publish(std::unique_ptr<codable::EncodedStorage> encoded_object) = 0;
     virtual channel::Status publish(runtime::RemoteDescriptor&& remote_descriptor)           = 0;
+
+    // publish an encoded object whose remote descriptor carries routing_key; used by keyed policies
+    virtual channel::Status publish(std::unique_ptr<codable::EncodedStorage> encoded_object,
+                                    std::uint64_t routing_key) = 0;
 };
 
 class ISubscriberService : public virtual control_plane::ISubscriptionService,
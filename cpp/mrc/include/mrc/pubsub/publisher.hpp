@@ -19,6 +19,7 @@
 
 #include "mrc/channel/ingress.hpp"
 #include "mrc/codable/encoded_object.hpp"
+#include "mrc/codable/encoding_options.hpp"
 #include "mrc/control_plane/subscription_service_forwarder.hpp"
 #include "mrc/node/edge_builder.hpp"
 #include "mrc/node/operators/unique_operator.hpp"
@@ -28,6 +29,14 @@
 #include "mrc/runtime/remote_descriptor.hpp"
 #include "mrc/utils/macros.hpp"
 
+#include <glog/logging.h>
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <utility>
+
 namespace mrc::pubsub {
 
 /**
@@ -59,6 +68,23 @@ class Publisher final : public control_plane::SubscriptionServiceForwarder,
         return std::unique_ptr<Publisher>{new Publisher(partition.make_publisher_service(name, policy))};
     }
 
+    /**
+     * @brief Create a publisher which routes all objects with the same key to the same subscriber
+     *
+     * Keys are assigned to subscribers by a consistent hash, so only the keys of a subscriber which leaves, or a share
+     * of keys proportional to one subscriber when one joins, move to a different subscriber.
+     */
+    static std::unique_ptr<Publisher> create(std::string name,
+                                             std::function<std::uint64_t(const T&)> key_extractor,
+                                             runtime::IPartition& partition)
+    {
+        CHECK(key_extractor);
+        auto publisher = std::unique_ptr<Publisher>{
+            new Publisher(partition.make_publisher_service(name, PublisherPolicy::ConsistentHash))};
+        publisher->m_key_extractor = std::move(key_extractor);
+        return publisher;
+    }
+
     ~Publisher() final
     {
         request_stop();
@@ -72,6 +98,20 @@ class Publisher final : public control_plane::SubscriptionServiceForwarder,
     // publisher
     channel::Status await_write(T&& data) final;
 
+    /**
+     * @brief Options every object published by this port is encoded with, e.g. a compression codec for the
+     * codable::DeltaBatch objects of a telemetry stream; set before the first object is published.
+     */
+    void encoding_options(codable::EncodingOptions opts)
+    {
+        m_encoding_options = std::move(opts);
+    }
+
+    const codable::EncodingOptions& encoding_options() const
+    {
+        return m_encoding_options;
+    }
+
     void await_start() final
     {
         // form a persistent connection to the operator
@@ -124,6 +164,11 @@ class Publisher final : public control_plane::SubscriptionServiceForwarder,
     // internal type-erased implementation of publisher
     const std::shared_ptr<IPublisherService> m_service;
 
+    // extracts the routing key of keyed publishers
+    std::function<std::uint64_t(const T&)> m_key_extractor;
+
+    codable::EncodingOptions m_encoding_options;
+
     // this holds the operator open;
     std::unique_ptr<mrc::node::SourceChannelWriteable<T>> m_persistent_channel;
 
@@ -133,7 +178,16 @@ class Publisher final : public control_plane::SubscriptionServiceForwarder,
 template <typename T>
 channel::Status Publisher<T>::await_write(T&& data)
 {
-    auto encoded_object = codable::EncodedObject<T>::create(std::move(data), m_service->create_storage());
+    if (m_key_extractor)
+    {
+        auto key            = m_key_extractor(data);
+        auto encoded_object = codable::EncodedObject<T>::create(
+            std::move(data), m_service->create_storage(), m_encoding_options);
+        return m_service->publish(std::move(encoded_object), key);
+    }
+
+    auto encoded_object =
+        codable::EncodedObject<T>::create(std::move(data), m_service->create_storage(), m_encoding_options);
     return m_service->publish(std::move(encoded_object));
 }
 
@@ -19,6 +19,7 @@
 
 #include <glog/logging.h>
 
+#include <chrono>
 #include <cstddef>
 #include <exception>
 #include <sstream>
@@ -54,8 +55,24 @@ class Context
     void barrier();
     void yield();
 
+    /**
+     * @brief False while the Runner holds this instance in standby, see Runner::set_active_instances
+     */
+    bool is_active() const;
+
+    /**
+     * @brief Fiber yielding call which returns once this instance is active, the Runnable is stopped or the timeout
+     * elapsed; returns is_active()
+     */
+    bool await_active(std::chrono::milliseconds timeout) const;
+
     const std::string& info() const;
 
+    /**
+     * @brief Name of the runnable owning this instance, e.g. "segment/node" for segment nodes; empty if unnamed
+     */
+    virtual const std::string& name() const;
+
     template <typename ContextT>
     ContextT& as()
     {
@@ -65,6 +82,7 @@ class Context
     }
 
     static Context& get_runtime_context();
+    static bool has_runtime_context();
 
     void set_exception(std::exception_ptr exception_ptr);
 
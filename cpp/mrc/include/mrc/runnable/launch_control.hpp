@@ -88,12 +88,12 @@ class LaunchControl final
      * @return std::unique_ptr<Launcher>
      */
     template <template <typename> typename ContextWrapperT, typename RunnableT, typename... ContextArgsT>
-    [[nodiscard]] std::unique_ptr<Launcher> prepare_launcher_with_wrapped_context(const LaunchOptions& options,
-                                                                                  std::unique_ptr<RunnableT> runnable,
-                                                                                  ContextArgsT&&... context_args)
+    [[nodiscard]] std::unique_ptr<Launcher> prepare_launcher_with_wrapped_context(
+        const LaunchOptions& launch_options, std::unique_ptr<RunnableT> runnable, ContextArgsT&&... context_args)
     {
         // inspect runnable to make the proper contexts
         CHECK(runnable) << "Null Runnable detected";
+        const auto options = resolve_cost_hints<RunnableT>(launch_options);
         using context_t = unwrap_context_t<runnable_context_t<RunnableT>>;
 
         VLOG(10) << "preparing engines using engine factory " << options.engine_factory_name
@@ -113,7 +113,7 @@ class LaunchControl final
             contexts = make_contexts<FiberContext<ContextWrapperT<context_t>>>(
                 *engines, std::forward<ContextArgsT>(context_args)...);
         }
-        else if constexpr (is_thread_context_v<RunnableT>)
+        else if constexpr (is_thread_runnable_v<RunnableT>)
         {
             CHECK(get_engine_factory(options.engine_factory_name).backend() == EngineType::Thread)
                 << "Requested ThreadRunnable to be run on a FiberEngine";
@@ -181,12 +181,13 @@ class LaunchControl final
      */
     // std::enable_if_t<not(is_fiber_runnable_v<RunnableT> and is_thread_runnable_v<RunnableT>)>>
     template <typename RunnableT, typename... ContextArgsT>
-    [[nodiscard]] std::unique_ptr<Launcher> prepare_launcher(const LaunchOptions& options,
+    [[nodiscard]] std::unique_ptr<Launcher> prepare_launcher(const LaunchOptions& launch_options,
                                                              std::unique_ptr<RunnableT> runnable,
                                                              ContextArgsT&&... context_args)
     {
         // inspect runnable to make the proper contexts
         CHECK(runnable) << "Null Runnable detected";
+        const auto options = resolve_cost_hints<RunnableT>(launch_options);
         using context_t = runnable_context_t<RunnableT>;
 
         VLOG(10) << "preparing engines using engine factory " << options.engine_factory_name
@@ -204,7 +205,7 @@ class LaunchControl final
                 << "Requested FiberRunnable to be run on a ThreadEngine";
             contexts = make_contexts<context_t>(*engines, std::forward<ContextArgsT>(context_args)...);
         }
-        else if constexpr (is_thread_context_v<RunnableT>)
+        else if constexpr (is_thread_runnable_v<RunnableT>)
         {
             CHECK(get_engine_factory(options.engine_factory_name).backend() == EngineType::Thread)
                 << "Requested ThreadRunnable to be run on a FiberEngine";
@@ -269,6 +270,45 @@ class LaunchControl final
     //     return config().default_options;
     // }
 
+    /**
+     * @brief Launch options with the engine factory selected by the cost hints of a runnable
+     *
+     * A runnable annotated with a cost class and launched on the default engine factory is moved to the first engine
+     * group serving the cost class whose backend can run it; explicitly named engine factories are kept.
+     */
+    template <typename RunnableT>
+    LaunchOptions resolve_cost_hints(const LaunchOptions& launch_options) const
+    {
+        const auto cost_class = launch_options.cost_hints.cost_class;
+        if (cost_class == CostClass::Unspecified || launch_options.engine_factory_name != default_engine_factory_name())
+        {
+            return launch_options;
+        }
+
+        auto search = config().cost_class_groups.find(cost_class);
+        if (search == config().cost_class_groups.end())
+        {
+            return launch_options;
+        }
+
+        for (const auto& name : search->second)
+        {
+            auto backend = get_engine_factory(name).backend();
+            if ((is_fiber_runnable_v<RunnableT> && backend != EngineType::Fiber) ||
+                (is_thread_runnable_v<RunnableT> && backend != EngineType::Thread))
+            {
+                continue;
+            }
+
+            VLOG(10) << "cost hints select engine factory " << name;
+            LaunchOptions resolved       = launch_options;
+            resolved.engine_factory_name = name;
+            return resolved;
+        }
+
+        return launch_options;
+    }
+
     std::shared_ptr<Engines> build_engines(const LaunchOptions& launch_options) const
     {
         return get_engine_factory(launch_options.engine_factory_name).build_engines(launch_options);
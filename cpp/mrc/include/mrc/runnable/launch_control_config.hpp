@@ -21,11 +21,13 @@
 #include "mrc/runnable/engine_factory.hpp"
 #include "mrc/runnable/internal_service.hpp"
 #include "mrc/runnable/launch_options.hpp"
+#include "mrc/runnable/types.hpp"
 #include "mrc/types.hpp"
 
 #include <map>
 #include <memory>
 #include <string>
+#include <vector>
 
 namespace mrc::runnable {
 
@@ -47,6 +49,9 @@ struct LaunchControlConfig
     // default options for all non-service runnables
     LaunchOptions default_options{};
 
+    // engine groups serving each cost class in name order; see LaunchOptions::cost_hints
+    std::map<CostClass, std::vector<std::string>> cost_class_groups;
+
     // service options from public api
     // ServiceOptions services;
 };
@@ -17,13 +17,21 @@
 
 #pragma once
 
+#include "mrc/channel/wait_policy.hpp"
 #include "mrc/constants.hpp"
+#include "mrc/core/fiber_meta_data.hpp"
 #include "mrc/options/engine_groups.hpp"
 #include "mrc/runnable/types.hpp"
 
+#include <chrono>
 #include <cstdint>
+#include <memory>
 #include <string>
 
+namespace mrc::channel {
+class InFlightBudget;
+}  // namespace mrc::channel
+
 namespace mrc::runnable {
 
 struct LaunchOptions
@@ -38,6 +46,22 @@ struct LaunchOptions
     std::size_t pe_count{1};
     std::size_t engines_per_pe{1};
     std::string engine_factory_name{default_engine_factory_name()};
+
+    // applied to the input channel of sink runnables when they are launched
+    channel::WaitPolicy wait_policy{};
+
+    // when launched on the default engine factory, selects an engine group serving the cost class instead
+    CostHints cost_hints{};
+
+    // share of the cpu time of the fiber threads given to the fibers of the runnable; ignored by thread engines
+    FiberShare fiber_share{};
+
+    // time after which the fibers of the runnable yield at their next channel operation; 0 never yields; ignored by
+    // thread engines
+    std::chrono::microseconds time_slice{0};
+
+    // budget charged by the input channel of sink runnables when they are launched; null is unbounded
+    std::shared_ptr<channel::InFlightBudget> in_flight_budget{nullptr};
 };
 
 struct ServiceLaunchOptions : public LaunchOptions
@@ -0,0 +1,168 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2021-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "mrc/runnable/context.hpp"
+#include "mrc/runnable/forward.hpp"
+#include "mrc/runnable/runnable.hpp"
+#include "mrc/runnable/thread_context.hpp"
+
+#include <glog/logging.h>
+
+#include <chrono>
+#include <cstddef>
+#include <memory>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace mrc::runnable {
+
+enum class PollStatus
+{
+    // work was performed; the pollable should be polled again right away
+    Progress,
+    // no work was available
+    Idle,
+    // the pollable finished and is no longer polled
+    Done,
+};
+
+/**
+ * @brief Non-blocking unit of work driven by a RunToCompletion runnable
+ *
+ * Each call to poll should perform a bounded amount of work and return without waiting for more, e.g. by draining a
+ * channel with try_read. Blocking in poll stalls every other pollable sharing the core.
+ */
+class Pollable
+{
+  public:
+    virtual ~Pollable() = default;
+
+    virtual PollStatus poll() = 0;
+
+    /**
+     * @brief Called when the owning runner is stopped; pollables waiting on persistent inputs should let them close
+     */
+    virtual void on_stop() {}
+};
+
+struct RunToCompletionOptions
+{
+    // rounds without progress during which the loop keeps spinning, yielding the cpu between rounds
+    std::size_t spin_rounds{1024};
+
+    // sleep between rounds once spin_rounds rounds in a row made no progress
+    std::chrono::microseconds idle_sleep{50};
+};
+
+/**
+ * @brief Thread runnable polling a fixed set of pollables in turn, with no context switching between them
+ *
+ * Launched on a Thread engine factory, each pe is a thread pinned to its own logical cpu which runs a tight
+ * run-to-completion loop over its share of the pollables: pollable i is driven by the context with rank i % size. This
+ * trades the fiber context switch of a blocking channel read for a poll of the channel, which pays off for
+ * dataplane-style stages with small messages at high rates. A core which finds no work for spin_rounds rounds backs off
+ * by sleeping for idle_sleep between rounds.
+ *
+ * The runnable completes once all of its pollables are done; killing the runner abandons the remaining pollables.
+ */
+class RunToCompletion final : public ThreadRunnable<>
+{
+  public:
+    RunToCompletion(std::vector<std::shared_ptr<Pollable>> pollables, RunToCompletionOptions options = {}) :
+      m_pollables(std::move(pollables)),
+      m_options(options)
+    {
+        for (const auto& pollable : m_pollables)
+        {
+            CHECK(pollable) << "null pollable passed to RunToCompletion";
+        }
+    }
+
+    ~RunToCompletion() final = default;
+
+    std::size_t pollable_count() const
+    {
+        return m_pollables.size();
+    }
+
+  private:
+    void run(ContextType& ctx) final
+    {
+        std::vector<Pollable*> active;
+        for (std::size_t i = ctx.rank(); i < m_pollables.size(); i += ctx.size())
+        {
+            active.push_back(m_pollables[i].get());
+        }
+
+        DVLOG(10) << ctx.info() << " run-to-completion loop over " << active.size() << " pollables";
+
+        std::size_t idle_rounds = 0;
+        while (!active.empty() && state() != State::Kill)
+        {
+            bool progressed = false;
+            for (auto it = active.begin(); it != active.end();)
+            {
+                switch ((*it)->poll())
+                {
+                case PollStatus::Progress:
+                    progressed = true;
+                    ++it;
+                    break;
+                case PollStatus::Idle:
+                    ++it;
+                    break;
+                case PollStatus::Done:
+                    progressed = true;
+                    it         = active.erase(it);
+                    break;
+                }
+            }
+
+            if (progressed)
+            {
+                idle_rounds = 0;
+            }
+            else if (++idle_rounds < m_options.spin_rounds)
+            {
+                std::this_thread::yield();
+            }
+            else
+            {
+                std::this_thread::sleep_for(m_options.idle_sleep);
+            }
+        }
+    }
+
+    void on_state_update(const State& state) final
+    {
+        if (state == State::Stop)
+        {
+            for (auto& pollable : m_pollables)
+            {
+                pollable->on_stop();
+            }
+        }
+    }
+
+    const std::vector<std::shared_ptr<Pollable>> m_pollables;
+    const RunToCompletionOptions m_options;
+};
+
+}  // namespace mrc::runnable
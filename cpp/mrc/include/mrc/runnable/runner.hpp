@@ -29,8 +29,11 @@
 #include <glog/logging.h>
 
 #include <atomic>
+#include <chrono>
 #include <cstddef>
+#include <exception>
 #include <functional>
+#include <limits>
 #include <memory>
 #include <mutex>
 #include <type_traits>
@@ -58,6 +61,12 @@ class Runnable;
  * callback can push the state change data to a queue which can be processed by its own execution engine outside the
  * immediate scope of the callback method.
  *
+ * The Runner can hold instances in standby to scale a running Runnable without relaunching it: launch with the
+ * maximum pe_count/engines_per_pe and call set_active_instances to change how many of the instances pull work.
+ *
+ * Liveness and completion of the instances are tracked by counters behind a single latch per Runner rather than by
+ * futures per instance, so await_live and await_join wait once regardless of the number of instances.
+ *
  * After enqueued, the unique_ptr from make_runner maybe stored in any container that holds unique_ptr<Runnable>.
  */
 class Runner
@@ -104,6 +113,8 @@ class Runner
      *
      * This callback is triggered only one time with a bool, where a true value indicated that all contexts/instances
      * finished without error. A false value indicates that one or more contexts/instances had uncaught exceptions.
+     * A callback set after the Runnable completed is invoked immediately; it is always invoked before await_join
+     * returns.
      */
     void on_completion_callback(on_completion_callback_t callback);
 
@@ -117,6 +128,13 @@ class Runner
      */
     void await_join() const;
 
+    /**
+     * @brief Fiber yielding call which returns true once the Runnable is complete, or false after timeout
+     *
+     * Exceptions of the Runnable are not rethrown; await_join must still be called to collect them.
+     */
+    bool await_join_for(std::chrono::milliseconds timeout) const;
+
     /**
      * @brief Issues a request that the Runner terminates gracefully.
      */
@@ -127,6 +145,21 @@ class Runner
      */
     void kill() const;
 
+    /**
+     * @brief Hold the instances with a rank >= count in standby; thread safe and may be called while running
+     *
+     * Standby instances keep their engine but stop pulling from their input until they are activated again, the
+     * Runnable is stopped or its input completes. Node progress engines check this between batches; custom Runnables
+     * may honor it with Context::is_active and Context::await_active. Instances cannot be added beyond the
+     * pe_count * engines_per_pe instances the Runnable was launched with.
+     */
+    void set_active_instances(std::size_t count);
+
+    /**
+     * @brief Number of instances which are not held in standby
+     */
+    std::size_t active_instances() const;
+
     /**
      * @brief Access the const version of the Runnable
      */
@@ -148,15 +181,10 @@ class Runner
       public:
         std::size_t uid() const;
         State state() const;
-        SharedFuture<void> live_future() const;
-        SharedFuture<void> join_future() const;
 
       private:
         std::size_t m_uid{0};
         State m_state{State::Unqueued};
-        Promise<void> m_live_promise;
-        SharedFuture<void> m_live_future;
-        SharedFuture<void> m_join_future;
         std::shared_ptr<Engine> m_engine;
         std::shared_ptr<Context> m_context;
 
@@ -184,6 +212,17 @@ class Runner
      */
     void update_state(std::size_t launcher_id, State new_state);
 
+    /**
+     * @brief Record the completion of an instance; the last instance to complete releases the latch
+     * @param was_live false if the instance failed before it became live
+     * @param exception exception raised by the instance, if any
+     */
+    void on_instance_complete(bool was_live, std::exception_ptr exception);
+
+    // standby checks on behalf of Context
+    bool is_instance_active(std::size_t rank) const;
+    bool await_instance_active(std::size_t rank, std::chrono::milliseconds timeout) const;
+
     // callback lambda executed on state change
     on_instance_state_change_t m_on_instance_state_change{nullptr};
 
@@ -191,7 +230,18 @@ class Runner
     on_completion_callback_t m_completion_callback{nullptr};
 
     std::atomic<bool> m_status{true};
-    std::atomic<std::size_t> m_remaining_instances{0};
+
+    // latch tracking the instances of the last enqueue
+    mutable Mutex m_latch_mutex;
+    mutable CondV m_latch_cv;
+    std::size_t m_live_instances{0};
+    std::size_t m_remaining_instances{0};
+    bool m_completed{false};
+    bool m_joined{true};
+    mutable std::exception_ptr m_exception{nullptr};
+
+    // instances with a rank >= m_active_instances are held in standby
+    std::atomic<std::size_t> m_active_instances{std::numeric_limits<std::size_t>::max()};
 
     // the runnable owned by the runner
     // using shared_ptr to allow python access; otherwise a unique_ptr woudld used
@@ -205,6 +255,7 @@ class Runner
 
     mutable std::recursive_mutex m_mutex;
 
+    friend class Context;
     friend class Launcher;
 };
 
@@ -225,16 +276,27 @@ class SpecializedRunner : public Runner
     {
         DCHECK(launcher && launcher->size());
 
+        // runnables bound to a fiber or thread context can only be enqueued on engines of the same type
         std::vector<std::shared_ptr<Context>> contexts;
-        if (launcher->engine_type() == EngineType::Fiber)
+        if constexpr (is_fiber_context_v<ContextT>)
+        {
+            CHECK(launcher->engine_type() == EngineType::Fiber)
+                << "Requested FiberRunnable to be run on a ThreadEngine";
+            contexts = make_contexts<ContextT>(*launcher, std::forward<ArgsT>(args)...);
+        }
+        else if constexpr (is_thread_context_v<ContextT>)
+        {
+            CHECK(launcher->engine_type() == EngineType::Thread)
+                << "Requested ThreadRunnable to be run on a FiberEngine";
+            contexts = make_contexts<ContextT>(*launcher, std::forward<ArgsT>(args)...);
+        }
+        else if (launcher->engine_type() == EngineType::Fiber)
         {
-            using ctx_t = std::conditional_t<is_fiber_context_v<ContextT>, ContextT, FiberContext<ContextT>>;
-            contexts    = make_contexts<ctx_t>(*launcher, std::forward<ArgsT>(args)...);
+            contexts = make_contexts<FiberContext<ContextT>>(*launcher, std::forward<ArgsT>(args)...);
         }
         else if (launcher->engine_type() == EngineType::Thread)
         {
-            using ctx_t = std::conditional_t<is_thread_context_v<ContextT>, ContextT, ThreadContext<ContextT>>;
-            contexts    = make_contexts<ctx_t>(*launcher, std::forward<ArgsT>(args)...);
+            contexts = make_contexts<ThreadContext<ContextT>>(*launcher, std::forward<ArgsT>(args)...);
         }
         return Runner::enqueue(launcher, std::move(contexts));
     }
@@ -30,6 +30,36 @@ enum class EngineType
 
 std::string engine_type_string(const EngineType& engine_type);
 
+/**
+ * @brief Dominant resource consumed by a node
+ */
+enum class CostClass
+{
+    Unspecified,
+    Cpu,
+    Gpu,
+    Io,
+};
+
+/**
+ * @brief Optional cost and rate annotations of a node or port, consumed by placement and engine group selection
+ *
+ * A runnable annotated with a cost class and launched on the default engine factory is launched on the first engine
+ * group serving that cost class instead, see EngineFactoryOptions::cost_class. The rates of ports guide the choice of
+ * the egress policy of their manifolds; zero means unknown.
+ */
+struct CostHints
+{
+    CostClass cost_class{CostClass::Unspecified};
+    double elements_per_second{0};
+    double bytes_per_second{0};
+
+    bool empty() const
+    {
+        return cost_class == CostClass::Unspecified && elements_per_second == 0 && bytes_per_second == 0;
+    }
+};
+
 /**
  * @brief Name of the Default EngineFactory
  *
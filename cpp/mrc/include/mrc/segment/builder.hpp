@@ -18,14 +18,33 @@
 #pragma once
 
 #include "mrc/benchmarking/trace_statistics.hpp"
+#include "mrc/benchmarking/tuning_profile.hpp"
+#include "mrc/channel/buffered_channel.hpp"
+#include "mrc/channel/ring_channel.hpp"
 #include "mrc/engine/segment/ibuilder.hpp"  // IWYU pragma: export
 #include "mrc/exceptions/runtime_error.hpp"
+#include "mrc/node/admission_node.hpp"
+#include "mrc/node/batcher.hpp"
+#include "mrc/node/caching_node.hpp"
+#include "mrc/node/coro_node.hpp"
+#include "mrc/node/coro_source.hpp"
+#include "mrc/node/demand_source.hpp"
+#include "mrc/node/device_file_source.hpp"
 #include "mrc/node/edge_builder.hpp"
+#include "mrc/node/file_sink.hpp"
+#include "mrc/node/file_source.hpp"
+#include "mrc/node/generator_source.hpp"
+#include "mrc/node/lazy_node.hpp"
+#include "mrc/node/mapped_file_source.hpp"
+#include "mrc/node/ordered_node.hpp"
 #include "mrc/node/rx_node.hpp"
+#include "mrc/node/rx_node_component.hpp"
 #include "mrc/node/rx_sink.hpp"
 #include "mrc/node/rx_source.hpp"
+#include "mrc/node/window.hpp"
 #include "mrc/node/sink_properties.hpp"    // IWYU pragma: export
 #include "mrc/node/source_properties.hpp"  // IWYU pragma: export
+#include "mrc/node/stream_source.hpp"
 #include "mrc/runnable/context.hpp"
 #include "mrc/runnable/runnable.hpp"  // IWYU pragma: export
 #include "mrc/segment/component.hpp"  // IWYU pragma: export
@@ -40,8 +59,12 @@
 #include <nlohmann/json.hpp>
 #include <rxcpp/rx.hpp>
 
+#include <algorithm>
+#include <bit>
+#include <cstddef>
 #include <cstdint>
 #include <functional>
+#include <map>
 #include <memory>
 #include <ostream>
 #include <string>
@@ -55,6 +78,7 @@ struct WatcherInterface;
 }  // namespace mrc
 namespace mrc::modules {
 class SegmentModule;
+struct RegisteredModuleSpec;
 }  // namespace mrc::modules
 namespace mrc::segment {
 class Definition;
@@ -64,23 +88,23 @@ namespace {
 namespace hana = boost::hana;
 
 template <typename T>
-auto has_source_add_watcher =
-    hana::is_valid([](auto&& thing) -> decltype(std::forward<decltype(thing)>(thing).source_add_watcher(
+auto has_source_add_trace_watcher =
+    hana::is_valid([](auto&& thing) -> decltype(std::forward<decltype(thing)>(thing).source_add_trace_watcher(
                                         std::declval<std::shared_ptr<mrc::WatcherInterface>>())) {});
 
 template <typename T>
-auto has_sink_add_watcher =
-    hana::is_valid([](auto&& thing) -> decltype(std::forward<decltype(thing)>(thing).sink_add_watcher(
+auto has_sink_add_trace_watcher =
+    hana::is_valid([](auto&& thing) -> decltype(std::forward<decltype(thing)>(thing).sink_add_trace_watcher(
                                         std::declval<std::shared_ptr<mrc::WatcherInterface>>())) {});
 
 template <typename T>
 void add_stats_watcher_if_rx_source(T& thing, std::string name)
 {
     return hana::if_(
-        has_source_add_watcher<T>(thing),
+        has_source_add_trace_watcher<T>(thing),
         [name](auto&& object) {
             auto trace_stats = mrc::benchmarking::TraceStatistics::get_or_create(name);
-            std::forward<decltype(object)>(object).source_add_watcher(trace_stats);
+            std::forward<decltype(object)>(object).source_add_trace_watcher(trace_stats);
         },
         [name]([[maybe_unused]] auto&& object) {})(thing);
 }
@@ -89,10 +113,10 @@ template <typename T>
 void add_stats_watcher_if_rx_sink(T& thing, std::string name)
 {
     return hana::if_(
-        has_sink_add_watcher<T>(thing),
+        has_sink_add_trace_watcher<T>(thing),
         [name](auto&& object) {
             auto trace_stats = mrc::benchmarking::TraceStatistics::get_or_create(name);
-            std::forward<decltype(object)>(object).sink_add_watcher(trace_stats);
+            std::forward<decltype(object)>(object).sink_add_trace_watcher(trace_stats);
         },
         [name]([[maybe_unused]] auto&& object) {})(thing);
 }
@@ -117,6 +141,19 @@ class Builder final
     template <typename T>
     std::shared_ptr<Object<node::SourceProperties<T>>> get_ingress(std::string name);
 
+    /**
+     * Ingress port behind admission control: the returned admission node forwards what it admits of the elements
+     * arriving on the ingress port `name`, see make_admission_node.
+     */
+    template <typename T>
+    auto get_ingress(std::string name, node::AdmissionOptions options)
+    {
+        auto ingress   = get_ingress<T>(name);
+        auto admission = make_admission_node<T>(name + "_admission", options);
+        make_edge(ingress, admission);
+        return admission;
+    }
+
     template <typename ObjectT>
     std::shared_ptr<Object<ObjectT>> make_object(std::string name, std::unique_ptr<ObjectT> node);
 
@@ -167,6 +204,227 @@ class Builder final
         return construct_object<NodeTypeT<SinkTypeT, SourceTypeT>>(name, std::forward<ArgsT>(ops)...);
     }
 
+    /**
+     * Create a non-runnable node applying ops inline on the fiber of its upstream writers; edges to it are direct calls
+     * rather than channels, see node::RxNodeComponent.
+     */
+    template <typename SinkTypeT, typename SourceTypeT = SinkTypeT, typename... ArgsT>
+    auto make_node_component(std::string name, ArgsT&&... ops)
+    {
+        return construct_object<node::RxNodeComponent<SinkTypeT, SourceTypeT>>(name, std::forward<ArgsT>(ops)...);
+    }
+
+    /**
+     * Create a source whose data is produced by a coroutine on a coroutines::ThreadPool.
+     * @param create_fn Either `coroutines::Task<void>(coroutines::RingBuffer<SourceTypeT>&)`, which co_awaits writes to
+     * the ring buffer, or `coroutines::Generator<SourceTypeT>()`.
+     * @param thread_pool Pool executing the coroutine; a single-threaded pool owned by the node is used if null.
+     */
+    template <typename SourceTypeT, typename CreateFnT>
+    auto make_coro_source(std::string name,
+                          CreateFnT&& create_fn,
+                          std::shared_ptr<coroutines::ThreadPool> thread_pool = nullptr)
+    {
+        return construct_object<node::CoroSource<SourceTypeT>>(
+            name, std::forward<CreateFnT>(create_fn), std::move(thread_pool));
+    }
+
+    /**
+     * Create a source pulling its data from a generator on the fibers of its engine, see node::GeneratorSource.
+     * @param generator_fn Either `coroutines::Generator<SourceTypeT>()` or `coroutines::AsyncGenerator<SourceTypeT>()`.
+     * @param options Number of values pulled ahead of the downstream edge.
+     */
+    template <typename SourceTypeT, typename GeneratorFnT>
+    auto make_generator_source(std::string name, GeneratorFnT&& generator_fn, node::GeneratorSourceOptions options = {})
+    {
+        return construct_object<node::GeneratorSource<SourceTypeT>>(
+            name, std::forward<GeneratorFnT>(generator_fn), options);
+    }
+
+    /**
+     * Create a source fetching batches sized by the capacity of its downstream edge, see node::DemandSource.
+     * @param fetch_fn `bool(std::size_t n, std::vector<SourceTypeT>& batch)` appending at most n values to the batch
+     * and returning false once the upstream is exhausted.
+     * @param options Demand requested from the fetch function.
+     */
+    template <typename SourceTypeT, typename FetchFnT>
+    auto make_demand_source(std::string name, FetchFnT&& fetch_fn, node::DemandSourceOptions options = {})
+    {
+        return construct_object<node::DemandSource<SourceTypeT>>(name, std::forward<FetchFnT>(fetch_fn), options);
+    }
+
+    /**
+     * Create a node which transforms each input with a `coroutines::Task<SourceTypeT>(SinkTypeT)` function.
+     * @param concurrency Number of coroutines concurrently awaiting the node function; outputs may be reordered when
+     * greater than one.
+     * @param thread_pool Pool executing the coroutines; a single-threaded pool owned by the node is used if null.
+     */
+    template <typename SinkTypeT, typename SourceTypeT = SinkTypeT, typename NodeFnT>
+    auto make_coro_node(std::string name,
+                        NodeFnT&& node_fn,
+                        std::size_t concurrency                             = 64,
+                        std::shared_ptr<coroutines::ThreadPool> thread_pool = nullptr)
+    {
+        return construct_object<node::CoroNode<SinkTypeT, SourceTypeT>>(
+            name, std::forward<NodeFnT>(node_fn), concurrency, std::move(thread_pool));
+    }
+
+    /**
+     * Create a source emitting the io::FileChunks of the file at path, see node::FileSource.
+     * @param options Record format, chunk size, read-ahead and direct i/o of the reads.
+     * @param scheduler Scheduler issuing the reads; an io scheduler owned by the node is used if null.
+     */
+    auto make_file_source(std::string name,
+                          std::string path,
+                          io::FileReaderOptions options                      = {},
+                          std::shared_ptr<coroutines::IoScheduler> scheduler = nullptr)
+    {
+        return construct_object<node::FileSource<>>(name, std::move(path), options, std::move(scheduler));
+    }
+
+    /**
+     * Create a sink writing the bytes of each input to the file at path, see node::FileSink.
+     * @param options Chunk size, append and direct i/o of the writes.
+     * @param scheduler Scheduler issuing the writes; an io scheduler owned by the node is used if null.
+     */
+    template <typename SinkTypeT = io::FileChunk>
+    auto make_file_sink(std::string name,
+                        std::string path,
+                        io::FileWriterOptions options                      = {},
+                        std::shared_ptr<coroutines::IoScheduler> scheduler = nullptr)
+    {
+        return construct_object<node::FileSink<SinkTypeT>>(name, std::move(path), options, std::move(scheduler));
+    }
+
+    /**
+     * Create a source emitting the io::DeviceChunks of the file at path read into device memory, see
+     * node::DeviceFileSource.
+     * @param device_memory_resource Device memory resource the chunks are allocated from.
+     * @param options Chunk size, read-ahead and device of the reads.
+     */
+    auto make_device_file_source(std::string name,
+                                 std::string path,
+                                 std::shared_ptr<memory::memory_resource> device_memory_resource,
+                                 io::DeviceFileReaderOptions options = {})
+    {
+        return construct_object<node::DeviceFileSource<>>(
+            name, std::move(path), std::move(device_memory_resource), options);
+    }
+
+    /**
+     * Create a source emitting io::MappedViews of whole records of the memory mapped file at path, see
+     * node::MappedFileSource; each pe of the source emits the records of a partition of the file.
+     * @param options Record format and target size of the views.
+     */
+    auto make_mapped_file_source(std::string name, const std::string& path, io::MappedFileOptions options = {})
+    {
+        return construct_object<node::MappedFileSource<>>(name, path, options);
+    }
+
+    /**
+     * Create a source emitting batches of the messages of consumer, e.g. an io::KafkaConsumer, see node::StreamSource.
+     * Sinks acknowledge its checkpoints with node::acknowledge_checkpoints and the coordinator of the source.
+     * @param options Batch size, poll timeout and commit interval of the source.
+     * @param participants Number of sinks acknowledging each checkpoint before its offsets are committed.
+     */
+    auto make_stream_source(std::string name,
+                            std::shared_ptr<io::StreamConsumer> consumer,
+                            node::StreamSourceOptions options = {},
+                            std::size_t participants          = 1)
+    {
+        return construct_object<node::StreamSource<>>(name, std::move(consumer), options, participants);
+    }
+
+    /**
+     * Create a node which collects its inputs into `std::vector<SinkTypeT>` batches, see node::Batcher.
+     * @param options Count, byte size and latency triggers of a batch.
+     * @param size_fn Estimates the byte size of an input; sizeof(SinkTypeT) if null.
+     */
+    template <typename SinkTypeT>
+    auto make_batcher(std::string name,
+                      node::BatcherOptions options                         = {},
+                      typename node::Batcher<SinkTypeT>::size_fn_t size_fn = nullptr)
+    {
+        return construct_object<node::Batcher<SinkTypeT>>(name, options, std::move(size_fn));
+    }
+
+    /**
+     * Create a token bucket admission node, see node::AdmissionNode. Shed elements are counted by the
+     * mrc_admission_shed metric, labeled by segment and node name.
+     * @param options Rate, burst and shedding policy.
+     */
+    template <typename T>
+    auto make_admission_node(std::string name, node::AdmissionOptions options)
+    {
+        auto admission = construct_object<node::AdmissionNode<T>>(name, options);
+        admission->object().set_shed_counter(
+            m_backend.make_counter("mrc_admission_shed", {{"segment", m_backend.name()}, {"node", admission->name()}}));
+        return admission;
+    }
+
+    /**
+     * Create a node memoizing map_fn by the key of each input, see node::CachingNode. Cache hits, misses and lookups
+     * coalesced with a mapping in flight are counted by the mrc_cache_hits, mrc_cache_misses and mrc_cache_coalesced
+     * metrics, labeled by segment and node name.
+     * @param key_fn Key of an input, which the cache is keyed by.
+     * @param options Shards, bounds, ttl and admission policy of the cache.
+     * @param cost_fn Bytes charged for a cached output against options.max_bytes; sizeof the key and output if null.
+     */
+    template <typename SinkTypeT, typename SourceTypeT, typename KeyT, typename MapFnT, typename KeyFnT>
+    auto make_caching_node(std::string name,
+                           MapFnT&& map_fn,
+                           KeyFnT&& key_fn,
+                           data::CacheOptions options                                        = {},
+                           typename data::ShardedCache<KeyT, SourceTypeT>::cost_fn_t cost_fn = nullptr)
+    {
+        auto caching = construct_object<node::CachingNode<SinkTypeT, SourceTypeT, KeyT>>(
+            name, std::forward<MapFnT>(map_fn), std::forward<KeyFnT>(key_fn), options, std::move(cost_fn));
+
+        const std::map<std::string, std::string> labels{{"segment", m_backend.name()}, {"node", caching->name()}};
+        caching->object().set_counters(m_backend.make_counter("mrc_cache_hits", labels),
+                                       m_backend.make_counter("mrc_cache_misses", labels),
+                                       m_backend.make_counter("mrc_cache_coalesced", labels));
+        return caching;
+    }
+
+    /**
+     * Create a node whose map function is built by factory_fn on the first element and released once idle, see
+     * node::LazyNode.
+     * @param options Idle timeout after which the map function is released.
+     */
+    template <typename SinkTypeT, typename SourceTypeT = SinkTypeT, typename FactoryFnT>
+    auto make_lazy_node(std::string name, FactoryFnT&& factory_fn, node::LazyNodeOptions options = {})
+    {
+        return construct_object<node::LazyNode<SinkTypeT, SourceTypeT>>(
+            name, std::forward<FactoryFnT>(factory_fn), options);
+    }
+
+    /**
+     * Create a node which maps its inputs across all of its engines and emits the outputs in input order, see
+     * node::OrderedNode.
+     * @param window Maximum number of inputs in flight or held in the reorder buffer.
+     */
+    template <typename SinkTypeT, typename SourceTypeT = SinkTypeT, typename MapFnT>
+    auto make_ordered_node(std::string name, MapFnT&& map_fn, std::size_t window = 128)
+    {
+        return construct_object<node::OrderedNode<SinkTypeT, SourceTypeT>>(
+            name, std::forward<MapFnT>(map_fn), window);
+    }
+
+    /**
+     * Create a node which groups its inputs by key into count, time or session windows, see node::Window.
+     * @param key_fn Key of an input; may be null for unkeyed windows.
+     * @param evict_fn Called with the key whose state is evicted once more than max_idle_keys keys are idle.
+     */
+    template <typename SinkTypeT, typename KeyT = std::monostate>
+    auto make_window(std::string name,
+                     node::WindowOptions options,
+                     typename node::Window<SinkTypeT, KeyT>::key_fn_t key_fn     = nullptr,
+                     typename node::Window<SinkTypeT, KeyT>::evict_fn_t evict_fn = nullptr)
+    {
+        return construct_object<node::Window<SinkTypeT, KeyT>>(name, options, std::move(key_fn), std::move(evict_fn));
+    }
+
     /**
      * Instantiate a segment module of `ModuleTypeT`, intialize it, and return it to the caller
      * @tparam ModuleTypeT Type of module to create
@@ -202,9 +460,9 @@ class Builder final
 
     /**
      * Get the json configuration for the current module under configuration.
-     * @return nlohmann::json object.
+     * @return nlohmann::json object, valid while the module is alive.
      */
-    nlohmann::json get_current_module_config();
+    const nlohmann::json& get_current_module_config();
 
     /**
      * Register an output port on the given module -- note: this in generally only necessary for dynamically
@@ -220,11 +478,41 @@ class Builder final
                                                                            std::string module_name,
                                                                            nlohmann::json config = {});
 
+    /**
+     * Load several modules from the registry. The modules are constructed concurrently, which compiles their
+     * configurations, then initialized in order on this builder.
+     * @param specs Modules to load
+     * @return The initialized modules, in the order of specs
+     */
+    std::vector<std::shared_ptr<mrc::modules::SegmentModule>> load_modules_from_registry(
+        std::vector<mrc::modules::RegisteredModuleSpec> specs);
+
     template <typename SourceNodeTypeT, typename SinkNodeTypeT>
     void make_edge(std::shared_ptr<Object<SourceNodeTypeT>> source, std::shared_ptr<Object<SinkNodeTypeT>> sink)
     {
-        DVLOG(10) << "forming segment edge between two segment objects";
-        node::make_edge(source->object(), sink->object());
+        form_edge(std::move(source), std::move(sink));
+    }
+
+    /**
+     * Edges between two RxNodes are deferred while fusion is enabled; once the segment has been initialized, the
+     * downstream node is fused into the upstream node if it has no other inputs and both share the same launch options.
+     */
+    template <typename InputT, typename OutputT, typename DownstreamOutputT, typename ContextT>
+    void make_edge(std::shared_ptr<Object<node::RxNode<InputT, OutputT, ContextT>>> source,
+                   std::shared_ptr<Object<node::RxNode<OutputT, DownstreamOutputT, ContextT>>> sink)
+    {
+        if (!m_backend.fusion_enabled())
+        {
+            form_edge(std::move(source), std::move(sink));
+            return;
+        }
+
+        DVLOG(10) << "deferring segment edge between two fusable segment objects";
+        m_backend.add_fusion_candidate(
+            source,
+            sink,
+            [source, sink] { return source->object().fuse(sink->object()); },
+            [source, sink] { node::make_edge(source->object(), sink->object()); });
     }
 
     template <typename InputT, typename SinkNodeTypeT>
@@ -327,6 +615,38 @@ class Builder final
         node::make_edge(source->source_typed<SourceNodeTypeT>(), sink->sink_typed<SinkNodeTypeT>());
     }
 
+    /**
+     * Enables fusion of the RxNodes of this segment connected by a single edge: the fused nodes are run by a single
+     * runnable which composes their streams directly, removing the channel and fiber between them. Only edges formed
+     * after fusion has been enabled are considered. The fused nodes are listed in the segment's info.
+     */
+    void enable_fusion(bool enabled = true)
+    {
+        m_backend.enable_fusion(enabled);
+    }
+
+    /**
+     * Enables the selection of RingChannels by topology: edges between two segment objects formed afterwards are
+     * deferred until the segment has been initialized, then the default input channel of each sink is replaced by a
+     * RingChannel of the same capacity (rounded up to a power of 2) before its edges are formed. The ring is
+     * single-producer/single-consumer when the sink and all of its upstream runnables are launched on a single engine,
+     * otherwise multi-producer/multi-consumer. Inputs set via update_channel or connected by other edges are kept.
+     */
+    void enable_ring_channels(bool enabled = true)
+    {
+        m_backend.enable_ring_channels(enabled);
+    }
+
+    /**
+     * Applies the engine counts and input channel sizes of a tuning profile, e.g. found by a benchmarking::AutoTuner
+     * during a warm-up run, to the nodes of this segment created afterwards; nodes are matched by their namespaced
+     * name. Launch options set on a node after its creation take precedence.
+     */
+    void apply_tuning(std::shared_ptr<const benchmarking::TuningProfile> profile)
+    {
+        m_tuning = std::move(profile);
+    }
+
     template <typename ObjectT>
     void add_throughput_counter(std::shared_ptr<segment::Object<ObjectT>> segment_object)
     {
@@ -354,12 +674,60 @@ class Builder final
   private:
     using sp_segment_module_t = std::shared_ptr<mrc::modules::SegmentModule>;
 
+    template <typename SourceNodeTypeT, typename SinkNodeTypeT>
+    void form_edge(std::shared_ptr<Object<SourceNodeTypeT>> source, std::shared_ptr<Object<SinkNodeTypeT>> sink)
+    {
+        if constexpr (requires(SinkNodeTypeT & node) {
+                          node.update_channel(
+                              std::make_unique<channel::BufferedChannel<typename SinkNodeTypeT::sink_type_t>>());
+                          node.channel_observer();
+                      })
+        {
+            if (m_backend.ring_channels_enabled())
+            {
+                DVLOG(10) << "deferring segment edge until the input channel of the sink has been selected";
+                m_backend.add_ring_channel_edge(
+                    source,
+                    sink,
+                    [sink](std::size_t writers, std::size_t readers) {
+                        select_ring_channel(sink->object(), writers, readers);
+                    },
+                    [source, sink] { node::make_edge(source->object(), sink->object()); });
+                return;
+            }
+        }
+
+        DVLOG(10) << "forming segment edge between two segment objects";
+        node::make_edge(source->object(), sink->object());
+    }
+
+    // replaces the default BufferedChannel input of node by a RingChannel for the given number of concurrent writers
+    // and readers; 0 is an unknown number
+    template <typename NodeT>
+    static void select_ring_channel(NodeT& node, std::size_t writers, std::size_t readers)
+    {
+        using sink_type_t = typename NodeT::sink_type_t;
+
+        auto current = node.channel_observer().lock();
+        if (node.use_count() > 0 ||
+            std::dynamic_pointer_cast<const channel::BufferedChannel<sink_type_t>>(current) == nullptr)
+        {
+            return;
+        }
+
+        const auto capacity = std::bit_ceil(std::max<std::size_t>(current->statistics().capacity, 2));
+        current.reset();
+        node.update_channel(channel::make_ring_channel<sink_type_t>(capacity, writers, readers));
+    }
+
     std::string m_namespace_prefix;
     std::vector<std::string> m_namespace_stack{};
     std::vector<sp_segment_module_t> m_module_stack{};
 
     internal::segment::IBuilder& m_backend;
 
+    std::shared_ptr<const benchmarking::TuningProfile> m_tuning;
+
     void ns_push(sp_segment_module_t module);
     void ns_pop();
 
@@ -376,12 +744,31 @@ std::shared_ptr<Object<ObjectT>> Builder::make_object(std::string name, std::uni
         throw exceptions::MrcRuntimeError("duplicate name detected - name owned by a node");
     }
 
+    const auto* tuning = (m_tuning ? m_tuning->find(name) : nullptr);
+
+    // the input channel is replaced before any edge to the node is formed
+    if constexpr (requires(ObjectT & object) {
+                      object.update_channel(
+                          std::make_unique<channel::BufferedChannel<typename ObjectT::sink_type_t>>());
+                  })
+    {
+        if (tuning != nullptr && tuning->channel_size > 0)
+        {
+            node->update_channel(
+                std::make_unique<channel::BufferedChannel<typename ObjectT::sink_type_t>>(tuning->channel_size));
+        }
+    }
+
     std::shared_ptr<Object<ObjectT>> segment_object{nullptr};
 
     if constexpr (std::is_base_of_v<runnable::Runnable, ObjectT>)
     {
         auto segment_name = m_backend.name() + "/" + name;
         auto segment_node = std::make_shared<Runnable<ObjectT>>(segment_name, std::move(node));
+        if (tuning != nullptr)
+        {
+            m_tuning->apply(name, segment_node->launch_options());
+        }
 
         m_backend.add_runnable(name, segment_node);
         m_backend.add_object(name, segment_node);
@@ -17,6 +17,7 @@
 
 #pragma once
 
+#include "mrc/benchmarking/fiber_tracer.hpp"
 #include "mrc/runnable/context.hpp"
 
 #include <string>
@@ -36,11 +37,16 @@ class Context : public ContextT
         VLOG(10) << "Init with name: " << m_name;
     }
 
-    const std::string& name() const;
+    const std::string& name() const override
+    {
+        return m_name;
+    }
 
   protected:
     void init_info(std::stringstream& ss) override
     {
+        // init_info is called on the runnable's fiber before main is run
+        benchmarking::FiberTracer::name_current_fiber(m_name);
         ss << m_name << "; ";
         ContextT::init_info(ss);
     }
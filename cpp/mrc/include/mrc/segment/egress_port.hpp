@@ -80,9 +80,10 @@ class EgressPort final : public Object<node::SinkProperties<T>>,
         return launch_control.prepare_launcher(std::move(m_sink));
     }
 
-    std::shared_ptr<manifold::Interface> make_manifold(pipeline::Resources& resources) final
+    std::shared_ptr<manifold::Interface> make_manifold(pipeline::Resources& resources,
+                                                       const ManifoldOptions& options) final
     {
-        return manifold::Factory<T>::make_manifold(m_port_name, resources);
+        return manifold::Factory<T>::make_manifold(m_port_name, resources, options);
     }
 
     void connect_to_manifold(std::shared_ptr<manifold::Interface> manifold) final
@@ -17,6 +17,7 @@
 
 #pragma once
 
+#include "mrc/channel/telemetry.hpp"
 #include "mrc/manifold/connectable.hpp"
 #include "mrc/manifold/factory.hpp"
 #include "mrc/manifold/interface.hpp"
@@ -40,6 +41,9 @@ class Instance;
 
 struct IngressPortBase : public runnable::Launchable, public manifold::Connectable, public virtual ObjectProperties
 {
+    // load of the channel the port receives into from its manifold
+    virtual channel::ChannelStatistics ingress_statistics() const = 0;
+
     friend Instance;
 };
 
@@ -55,11 +59,18 @@ class IngressPort : public Object<node::SourceProperties<T>>, public IngressPort
     IngressPort(SegmentAddress address, PortName name) :
       m_segment_address(address),
       m_port_name(std::move(name)),
-      m_source(std::make_unique<node::RxNode<T>>())
+      m_source(std::make_unique<node::RxNode<T>>()),
+      m_node(m_source.get())
     {
         this->set_name(m_port_name);
     }
 
+    channel::ChannelStatistics ingress_statistics() const final
+    {
+        // the node is owned by its runner once launched, which lives as long as the segment
+        return m_node->channel_statistics();
+    }
+
   private:
     node::SourceProperties<T>* get_object() const final
     {
@@ -74,9 +85,10 @@ class IngressPort : public Object<node::SourceProperties<T>>, public IngressPort
         return launch_control.prepare_launcher(std::move(m_source));
     }
 
-    std::shared_ptr<manifold::Interface> make_manifold(pipeline::Resources& resources) final
+    std::shared_ptr<manifold::Interface> make_manifold(pipeline::Resources& resources,
+                                                       const ManifoldOptions& options) final
     {
-        return manifold::Factory<T>::make_manifold(m_port_name, resources);
+        return manifold::Factory<T>::make_manifold(m_port_name, resources, options);
     }
 
     void connect_to_manifold(std::shared_ptr<manifold::Interface> manifold) final
@@ -90,6 +102,7 @@ class IngressPort : public Object<node::SourceProperties<T>>, public IngressPort
     SegmentAddress m_segment_address;
     PortName m_port_name;
     std::unique_ptr<node::RxNode<T>> m_source;
+    node::RxNode<T>* m_node;
     std::mutex m_mutex;
 
     friend Instance;
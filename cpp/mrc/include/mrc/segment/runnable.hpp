@@ -17,6 +17,8 @@
 
 #pragma once
 
+#include "mrc/channel/in_flight_budget.hpp"
+#include "mrc/channel/wait_policy.hpp"
 #include "mrc/runnable/launch_control.hpp"
 #include "mrc/runnable/launch_options.hpp"
 #include "mrc/runnable/launchable.hpp"
@@ -71,6 +73,19 @@ std::unique_ptr<runnable::Launcher> Runnable<NodeT>::prepare_launcher(runnable::
     if constexpr (std::is_base_of_v<runnable::Runnable, NodeT>)
     {
         DVLOG(10) << "Preparing launcher for " << this->type_name() << " in segment";
+        if constexpr (requires(NodeT & node, const channel::WaitPolicy& policy) { node.set_wait_policy(policy); })
+        {
+            m_node->set_wait_policy(this->launch_options().wait_policy);
+        }
+        if constexpr (requires(NodeT & node, std::shared_ptr<channel::InFlightBudget> budget) {
+                          node.set_in_flight_budget(budget);
+                      })
+        {
+            if (this->launch_options().in_flight_budget)
+            {
+                m_node->set_in_flight_budget(this->launch_options().in_flight_budget);
+            }
+        }
         return launch_control.prepare_launcher_with_wrapped_context<segment::Context>(
             this->launch_options(), std::move(m_node), this->name());
     }
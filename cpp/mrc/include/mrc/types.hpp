@@ -51,6 +51,8 @@ using ObjectID = std::uint32_t;  // NOLINT(readability-identifier-naming)
 template <typename T>
 using Handle = std::shared_ptr<T>;  // NOLINT(readability-identifier-naming)
 
+using PipelineID = std::uint32_t;  // NOLINT(readability-identifier-naming)
+
 using SegmentName    = std::string;    // NOLINT(readability-identifier-naming)
 using SegmentID      = std::uint16_t;  // NOLINT(readability-identifier-naming)
 using SegmentRank    = std::uint16_t;  // NOLINT(readability-identifier-naming)
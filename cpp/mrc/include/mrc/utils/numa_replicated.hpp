@@ -0,0 +1,182 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "mrc/utils/macros.hpp"
+#include "mrc/utils/read_mostly.hpp"
+
+#include <glog/logging.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace mrc::utils {
+
+namespace detail {
+
+// numa nodes of the host which have memory
+std::vector<std::uint32_t> online_numa_nodes();
+
+// numa node of the cpu the calling thread runs on
+std::uint32_t current_numa_node();
+
+/**
+ * @brief invokes fn(i) concurrently for each numa_nodes[i] on a thread whose cpus and memory allocations are bound to
+ * that node, so the pages first touched by fn are placed on it; rethrows the first exception thrown by fn
+ */
+void run_on_numa_nodes(const std::vector<std::uint32_t>& numa_nodes, const std::function<void(std::size_t)>& fn);
+
+}  // namespace detail
+
+/**
+ * @brief Immutable object, e.g. a lookup table, replicated once per numa node and read through the replica local to
+ * the calling thread
+ *
+ * Each replica is built by the factory on a thread bound to its numa node, so the memory it allocates and touches is
+ * local to the engines of the node; engine threads are bound to the cpus of a single numa node, so their reads never
+ * cross the interconnect. Reads of threads on a numa node without a replica fall back to the replica of the first
+ * node.
+ *
+ * update builds a new replica on every node and publishes the generation with a single swap: readers on all nodes
+ * move from one version to the next at once, and no reader observes a mix of versions. Retired replicas are released
+ * once the last reader drops them, see ReadMostly.
+ */
+template <typename T>
+class NumaReplicated final
+{
+  public:
+    // builds the replica of a numa node; invoked on a thread bound to that node
+    using factory_fn_t = std::function<std::shared_ptr<const T>(std::uint32_t numa_node)>;
+
+    /**
+     * @param factory Builds the replicas of the first version
+     * @param numa_nodes Nodes holding a replica, e.g. the numa nodes of the host partitions; all nodes with memory if
+     * empty
+     */
+    explicit NumaReplicated(factory_fn_t factory, std::vector<std::uint32_t> numa_nodes = {}) :
+      m_numa_nodes(numa_nodes.empty() ? detail::online_numa_nodes() : std::move(numa_nodes)),
+      m_replica_of_node(make_replica_index(m_numa_nodes)),
+      m_generation(build(factory, 0))
+    {}
+
+    ~NumaReplicated() = default;
+
+    DELETE_COPYABILITY(NumaReplicated);
+    DELETE_MOVEABILITY(NumaReplicated);
+
+    /**
+     * @brief the replica local to the calling thread
+     *
+     * the reference is valid until the next read of this handle on the calling thread; it must not be held across a
+     * point where a fiber or coroutine may be suspended or migrate to another thread, use load_local instead
+     */
+    const T& local() const
+    {
+        return *m_generation.read().replicas[replica_of(detail::current_numa_node())];
+    }
+
+    // the replica local to the calling thread, bypassing the thread local cache
+    std::shared_ptr<const T> load_local() const
+    {
+        return m_generation.load()->replicas[replica_of(detail::current_numa_node())];
+    }
+
+    // the replica of numa_node, or of the first node if numa_node holds none
+    std::shared_ptr<const T> load(std::uint32_t numa_node) const
+    {
+        return m_generation.load()->replicas[replica_of(numa_node)];
+    }
+
+    // version of the replicas read by local(); 0 before the first update
+    std::uint64_t version() const
+    {
+        return m_generation.read().version;
+    }
+
+    /**
+     * @brief builds the replicas of a new version with factory and publishes them once all have been built
+     *
+     * the calling thread blocks while the replicas are built; concurrent updates are serialized
+     *
+     * @return the version of the new replicas
+     */
+    std::uint64_t update(factory_fn_t factory)
+    {
+        std::lock_guard<std::mutex> lock(m_update_mutex);
+        auto version = m_generation.load()->version + 1;
+        m_generation.store(build(factory, version));
+        return version;
+    }
+
+    const std::vector<std::uint32_t>& numa_nodes() const
+    {
+        return m_numa_nodes;
+    }
+
+  private:
+    struct Generation
+    {
+        std::uint64_t version{0};
+        // indexed as m_numa_nodes
+        std::vector<std::shared_ptr<const T>> replicas;
+    };
+
+    static std::vector<std::size_t> make_replica_index(const std::vector<std::uint32_t>& numa_nodes)
+    {
+        CHECK(!numa_nodes.empty());
+        std::vector<std::size_t> index(*std::max_element(numa_nodes.begin(), numa_nodes.end()) + 1, 0);
+        for (std::size_t i = numa_nodes.size(); i-- > 0;)
+        {
+            index[numa_nodes[i]] = i;
+        }
+        return index;
+    }
+
+    std::size_t replica_of(std::uint32_t numa_node) const
+    {
+        return (numa_node < m_replica_of_node.size() ? m_replica_of_node[numa_node] : 0);
+    }
+
+    std::shared_ptr<Generation> build(const factory_fn_t& factory, std::uint64_t version) const
+    {
+        CHECK(factory);
+        auto generation     = std::make_shared<Generation>();
+        generation->version = version;
+        generation->replicas.resize(m_numa_nodes.size());
+
+        detail::run_on_numa_nodes(m_numa_nodes, [&](std::size_t i) {
+            generation->replicas[i] = factory(m_numa_nodes[i]);
+            CHECK(generation->replicas[i]) << "the replica of numa node " << m_numa_nodes[i] << " is null";
+        });
+        return generation;
+    }
+
+    const std::vector<std::uint32_t> m_numa_nodes;
+    // position in m_numa_nodes of the replica read by each numa node
+    const std::vector<std::size_t> m_replica_of_node;
+    ReadMostly<Generation> m_generation;
+    std::mutex m_update_mutex;
+};
+
+}  // namespace mrc::utils
@@ -0,0 +1,118 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "mrc/utils/macros.hpp"
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+
+namespace mrc::utils {
+
+/**
+ * @brief Handle to shared state which is read far more often than it is replaced, e.g. registries and resources
+ * accessed on every message
+ *
+ * Copying the std::shared_ptr of the current value on every access makes its reference count a contended cache line
+ * on many-core machines. Instead, each thread caches the value it last read in a thread local slot along with the
+ * version of the handle; a read only loads the version of the handle, which is a shared read-only cache line while the
+ * value is unchanged, and copies the std::shared_ptr once per version and thread.
+ *
+ * A retired value is kept alive by the threads which still cache it until they next read a handle cached in the same
+ * slot, or exit. The reference returned by read() is valid until the next read() on the calling thread, so it must
+ * not be held across a point where a fiber or coroutine may be suspended or migrate to another thread.
+ */
+template <typename T>
+class ReadMostly final
+{
+  public:
+    // number of handles of type T cached by each thread; handles mapped to the same slot evict each other
+    static constexpr std::size_t CacheSize = 64;
+
+    explicit ReadMostly(std::shared_ptr<T> value) : m_value(std::move(value)) {}
+    ~ReadMostly() = default;
+
+    DELETE_COPYABILITY(ReadMostly);
+    DELETE_MOVEABILITY(ReadMostly);
+
+    // the current value as cached by the calling thread
+    const T& read() const
+    {
+        const auto version = m_version.load(std::memory_order_acquire);
+        auto& slot         = cache()[m_id % CacheSize];
+        if (slot.id != m_id || slot.version != version)
+        {
+            slot.value   = std::atomic_load(&m_value);
+            slot.id      = m_id;
+            slot.version = version;
+        }
+        return *slot.value;
+    }
+
+    // the current value, bypassing the thread local cache
+    std::shared_ptr<T> load() const
+    {
+        return std::atomic_load(&m_value);
+    }
+
+    // publish value; threads read it from their next read()
+    void store(std::shared_ptr<T> value)
+    {
+        exchange(std::move(value));
+    }
+
+    std::shared_ptr<T> exchange(std::shared_ptr<T> value)
+    {
+        auto previous = std::atomic_exchange(&m_value, std::move(value));
+        m_version.fetch_add(1, std::memory_order_release);
+        return previous;
+    }
+
+  private:
+    struct Slot
+    {
+        std::uint64_t id{0};
+        std::uint64_t version{0};
+        std::shared_ptr<const T> value;
+    };
+
+    static std::array<Slot, CacheSize>& cache()
+    {
+        thread_local std::array<Slot, CacheSize> slots;
+        return slots;
+    }
+
+    static std::uint64_t next_id()
+    {
+        static std::atomic<std::uint64_t> counter{1};
+        return counter.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    // ids are never reused, so the slot of a destroyed handle is not mistaken for the slot of a new one
+    const std::uint64_t m_id{next_id()};
+    std::atomic<std::uint64_t> m_version{0};
+    // accessed only through the std::atomic_* overloads for std::shared_ptr; std::atomic<std::shared_ptr<T>> needs
+    // libstdc++ 12
+    std::shared_ptr<T> m_value;
+};
+
+}  // namespace mrc::utils
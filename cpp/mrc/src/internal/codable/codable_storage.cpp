@@ -17,18 +17,22 @@
 
 #include "internal/codable/codable_storage.hpp"
 
+#include "internal/codable/compression.hpp"
 #include "internal/data_plane/resources.hpp"
 #include "internal/memory/host_resources.hpp"
+#include "internal/memory/shared_memory.hpp"
 #include "internal/network/resources.hpp"
 #include "internal/resources/partition_resources.hpp"
 #include "internal/ucx/memory_block.hpp"
 #include "internal/ucx/registration_cache.hpp"
 #include "internal/ucx/resources.hpp"
 
+#include "mrc/codable/encoding_options.hpp"
 #include "mrc/codable/memory.hpp"
 #include "mrc/cuda/common.hpp"
 #include "mrc/memory/buffer_view.hpp"
-#include "mrc/memory/literals.hpp"
+#include "mrc/memory/iovec_view.hpp"
+#include "mrc/memory/memory_kind.hpp"
 #include "mrc/protos/codable.pb.h"
 #include "mrc/types.hpp"
 
@@ -36,22 +40,50 @@
 #include <glog/logging.h>
 #include <google/protobuf/any.pb.h>
 
+#include <cstddef>
 #include <cstdint>
+#include <cstring>
 #include <optional>
 #include <ostream>
 #include <utility>
 
-using namespace mrc::memory::literals;
-
 namespace mrc::internal::codable {
 
+namespace {
+
+// copies the regions of iov back to back to dst, which must be host memory
+void gather(const mrc::memory::const_iovec_view& iov, void* dst)
+{
+    auto* ptr = static_cast<std::byte*>(dst);
+    for (const auto& segment : iov.segments())
+    {
+        if (segment.kind() == mrc::memory::memory_kind::device)
+        {
+            MRC_CHECK_CUDA(cudaMemcpy(ptr, segment.data(), segment.bytes(), cudaMemcpyDeviceToHost));
+        }
+        else
+        {
+            std::memcpy(ptr, segment.data(), segment.bytes());
+        }
+        ptr += segment.bytes();
+    }
+}
+
+}  // namespace
+
 CodableStorage::CodableStorage(resources::PartitionResources& resources) : m_resources(resources) {}
 CodableStorage::CodableStorage(mrc::codable::protos::EncodedObject proto, resources::PartitionResources& resources) :
   m_proto(std::move(proto)),
   m_resources(resources)
 {}
 
-CodableStorage::~CodableStorage() = default;
+CodableStorage::~CodableStorage()
+{
+    for (const auto& block : m_temporary_registrations)
+    {
+        m_resources.network()->ucx().registration_cache().release(block);
+    }
+}
 
 mrc::codable::IDecodableStorage& CodableStorage::decodable()
 {
@@ -70,18 +102,21 @@ std::optional<CodableStorage::idx_t> CodableStorage::register_memory_view(mrc::m
     bool should_cache = true;
     auto ucx_block    = m_resources.network()->data_plane().registration_cache().lookup(view.data());
 
-    if (!ucx_block && !force_register && view.bytes() < 64_KiB)
+    // device memory can not be copied into an eager descriptor, so it is always described in place
+    if (!ucx_block && !force_register && view.kind() != mrc::memory::memory_kind::device &&
+        view.bytes() < mrc::codable::EncodingOptions::DefaultEagerThreshold)
     {
         return std::nullopt;
     }
 
     if (!ucx_block)
     {
-        // register memory
+        // acquire a cached registration or register on demand; the registration may be coalesced or evicted once
+        // released, so the remote must not cache its keys
         should_cache = false;
-        m_resources.network()->ucx().registration_cache().add_block(view.data(), view.bytes());
-        ucx_block = m_resources.network()->data_plane().registration_cache().lookup(view.data());
-        m_temporary_registrations.push_back(std::move(view));
+        auto block = m_resources.network()->ucx().registration_cache().acquire(view.data(), view.bytes());
+        m_temporary_registrations.push_back(block);
+        ucx_block.emplace(block);
     }
 
     auto count = descriptor_count();
@@ -104,6 +139,16 @@ void CodableStorage::copy_to_buffer(idx_t buffer_idx, mrc::memory::const_buffer_
     MRC_CHECK_CUDA(cudaMemcpy(dst.data(), view.data(), view.bytes(), cudaMemcpyDefault));
 }
 
+void CodableStorage::gather_to_buffer(idx_t buffer_idx, mrc::memory::const_iovec_view iov)
+{
+    auto search = m_buffers.find(buffer_idx);
+    CHECK(search != m_buffers.end()) << "buffer_idx=" << buffer_idx << " was not created with create_buffer";
+
+    auto& dst = search->second;
+    CHECK_LE(iov.bytes(), dst.bytes());
+    gather(iov, dst.data());
+}
+
 CodableStorage::idx_t CodableStorage::copy_to_eager_descriptor(mrc::memory::const_buffer_view view)
 {
     CHECK(context_acquired());
@@ -113,6 +158,69 @@ CodableStorage::idx_t CodableStorage::copy_to_eager_descriptor(mrc::memory::cons
     return count;
 }
 
+CodableStorage::idx_t CodableStorage::gather_to_eager_descriptor(mrc::memory::const_iovec_view iov)
+{
+    CHECK(context_acquired());
+    auto count = descriptor_count();
+    auto* data = mutable_proto().add_descriptors()->mutable_eager_desc()->mutable_data();
+    data->resize(iov.bytes());
+    gather(iov, data->data());
+    return count;
+}
+
+CodableStorage::idx_t CodableStorage::copy_to_shared_memory_descriptor(mrc::memory::const_buffer_view view)
+{
+    CHECK(context_acquired());
+    CHECK(view.kind() != mrc::memory::memory_kind::device) << "device memory can not be copied to shared memory";
+
+    auto segment = memory::SharedMemorySegment::create(view.bytes());
+    std::memcpy(segment->data(), view.data(), view.bytes());
+
+    auto count = descriptor_count();
+    auto* desc = mutable_proto().add_descriptors()->mutable_shm_desc();
+    desc->set_segment_name(segment->name());
+    desc->set_host_name(memory::SharedMemorySegment::host_name());
+    desc->set_bytes(view.bytes());
+    desc->set_memory_kind(mrc::codable::encode_memory_type(view.kind()));
+
+    m_shared_memory_segments.push_back(std::move(segment));
+    return count;
+}
+
+std::optional<CodableStorage::idx_t> CodableStorage::copy_to_compressed_descriptor(
+    mrc::memory::const_buffer_view view, mrc::codable::CompressionCodec codec)
+{
+    CHECK(context_acquired());
+    CHECK(view.kind() != mrc::memory::memory_kind::device) << "device memory can not be compressed";
+
+    auto compressed = compress(codec, view.data(), view.bytes());
+    if (!compressed)
+    {
+        DVLOG(10) << "buffer of " << view.bytes() << " bytes did not compress; sending uncompressed";
+        return std::nullopt;
+    }
+    DVLOG(10) << "compressed buffer of " << view.bytes() << " bytes to " << compressed->size()
+              << " bytes; process compression ratio " << compression_stats().ratio();
+
+    idx_t idx;
+    if (compressed->size() < mrc::codable::EncodingOptions::DefaultEagerThreshold)
+    {
+        auto count = descriptor_count();
+        mutable_proto().add_descriptors()->mutable_eager_desc()->set_data(std::move(*compressed));
+        idx = count;
+    }
+    else
+    {
+        idx = create_memory_buffer(compressed->size());
+        std::memcpy(mutable_host_buffer_view(idx).data(), compressed->data(), compressed->size());
+    }
+
+    auto& desc = *mutable_proto().mutable_descriptors(idx);
+    desc.set_codec(encode_compression_codec(codec));
+    desc.set_decoded_bytes(view.bytes());
+    return idx;
+}
+
 CodableStorage::idx_t CodableStorage::create_memory_buffer(std::uint64_t bytes)
 {
     CHECK(context_acquired());
@@ -172,7 +280,8 @@ CodableStorage::obj_idx_t CodableStorage::push_context(std::type_index type_inde
     obj->set_starting_descriptor_idx(descriptor_count());
     obj->set_parent_object_idx(initial_parent_object_idx);
 
-    m_parent = object_count();
+    // the object just added is the parent of any object pushed before it is popped
+    m_parent = object_count() - 1;
 
     return initial_parent_object_idx;
 }
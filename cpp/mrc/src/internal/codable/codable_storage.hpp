@@ -19,15 +19,20 @@
 
 #include "internal/codable/decodable_storage_view.hpp"
 #include "internal/codable/storage_view.hpp"
+#include "internal/memory/shared_memory.hpp"
+#include "internal/ucx/memory_block.hpp"
 
 #include "mrc/codable/api.hpp"
+#include "mrc/codable/encoding_options.hpp"
 #include "mrc/memory/buffer.hpp"
 #include "mrc/memory/buffer_view.hpp"
+#include "mrc/memory/iovec_view.hpp"
 #include "mrc/protos/codable.pb.h"
 #include "mrc/types.hpp"
 
 #include <cstddef>
 #include <map>
+#include <memory>
 #include <mutex>
 #include <optional>
 #include <typeindex>
@@ -80,6 +85,16 @@ class CodableStorage final : public mrc::codable::ICodableStorage, public Storag
     // copy to eager descriptor
     idx_t copy_to_eager_descriptor(mrc::memory::const_buffer_view view) final;
 
+    // gather the regions of an iov to a single eager descriptor
+    idx_t gather_to_eager_descriptor(mrc::memory::const_iovec_view iov) final;
+
+    // copy to a shared memory segment owned by this
+    idx_t copy_to_shared_memory_descriptor(mrc::memory::const_buffer_view view) final;
+
+    // compress to an eager descriptor or a buffer owned by this; may return nullopt if the view does not compress
+    std::optional<idx_t> copy_to_compressed_descriptor(mrc::memory::const_buffer_view view,
+                                                       mrc::codable::CompressionCodec codec) final;
+
     // add a meta_data descriptor
     idx_t add_meta_data(const google::protobuf::Message& meta_data) final;
 
@@ -89,6 +104,9 @@ class CodableStorage final : public mrc::codable::ICodableStorage, public Storag
     // copy data to a created buffer
     void copy_to_buffer(idx_t buffer_idx, mrc::memory::const_buffer_view view) final;
 
+    // gather the regions of an iov to a created buffer
+    void gather_to_buffer(idx_t buffer_idx, mrc::memory::const_iovec_view iov) final;
+
     // get a mutable view into the memory of a descriptor
     mrc::memory::buffer_view mutable_host_buffer_view(const idx_t& buffer_idx) final;
 
@@ -112,7 +130,10 @@ class CodableStorage final : public mrc::codable::ICodableStorage, public Storag
     resources::PartitionResources& m_resources;
     mrc::codable::protos::EncodedObject m_proto;
     std::map<idx_t, mrc::memory::buffer> m_buffers;
-    std::vector<mrc::memory::const_buffer_view> m_temporary_registrations;
+    // registrations of views not backed by a registered memory pool; released with the storage
+    std::vector<ucx::MemoryBlock> m_temporary_registrations;
+    // shared memory segments of shm descriptors; unlinked with the storage
+    std::vector<std::unique_ptr<memory::SharedMemorySegment>> m_shared_memory_segments;
     std::optional<obj_idx_t> m_parent{std::nullopt};
     bool m_context_acquired{false};
     mutable std::mutex m_mutex;
@@ -0,0 +1,153 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "internal/codable/compression.hpp"
+
+#include <glog/logging.h>
+#include <lz4.h>
+#include <zstd.h>
+
+#include <atomic>
+#include <climits>
+#include <ostream>
+
+namespace mrc::internal::codable {
+
+namespace {
+
+// favor throughput over ratio; buffers are compressed on the critical path of the sender
+constexpr int ZstdCompressionLevel = 1;
+
+std::atomic<std::size_t> s_uncompressed_bytes{0};
+std::atomic<std::size_t> s_compressed_bytes{0};
+
+std::optional<std::string> compress_lz4(const void* src, std::size_t bytes)
+{
+    if (bytes > LZ4_MAX_INPUT_SIZE)
+    {
+        return std::nullopt;
+    }
+
+    std::string dst(LZ4_compressBound(static_cast<int>(bytes)), '\0');
+    auto size = LZ4_compress_default(
+        static_cast<const char*>(src), dst.data(), static_cast<int>(bytes), static_cast<int>(dst.size()));
+    if (size <= 0)
+    {
+        return std::nullopt;
+    }
+    dst.resize(size);
+    return dst;
+}
+
+std::optional<std::string> compress_zstd(const void* src, std::size_t bytes)
+{
+    std::string dst(ZSTD_compressBound(bytes), '\0');
+    auto size = ZSTD_compress(dst.data(), dst.size(), src, bytes, ZstdCompressionLevel);
+    if (ZSTD_isError(size) != 0U)
+    {
+        DVLOG(10) << "zstd compression failed: " << ZSTD_getErrorName(size);
+        return std::nullopt;
+    }
+    dst.resize(size);
+    return dst;
+}
+
+}  // namespace
+
+std::optional<std::string> compress(mrc::codable::CompressionCodec codec, const void* src, std::size_t bytes)
+{
+    std::optional<std::string> compressed;
+    switch (codec)
+    {
+    case mrc::codable::CompressionCodec::lz4:
+        compressed = compress_lz4(src, bytes);
+        break;
+    case mrc::codable::CompressionCodec::zstd:
+        compressed = compress_zstd(src, bytes);
+        break;
+    case mrc::codable::CompressionCodec::none:
+        return std::nullopt;
+    }
+
+    if (!compressed || compressed->size() > bytes - bytes / 8)
+    {
+        return std::nullopt;
+    }
+
+    s_uncompressed_bytes += bytes;
+    s_compressed_bytes += compressed->size();
+    return compressed;
+}
+
+void decompress(mrc::codable::protos::CompressionCodec codec,
+                const void* src,
+                std::size_t src_bytes,
+                void* dst,
+                std::size_t dst_bytes)
+{
+    switch (codec)
+    {
+    case mrc::codable::protos::CompressionCodec::LZ4: {
+        CHECK_LE(src_bytes, INT_MAX);
+        CHECK_LE(dst_bytes, INT_MAX);
+        auto size = LZ4_decompress_safe(static_cast<const char*>(src),
+                                        static_cast<char*>(dst),
+                                        static_cast<int>(src_bytes),
+                                        static_cast<int>(dst_bytes));
+        CHECK_EQ(size, static_cast<int>(dst_bytes)) << "lz4 payload is corrupt";
+        break;
+    }
+    case mrc::codable::protos::CompressionCodec::Zstd: {
+        auto size = ZSTD_decompress(dst, dst_bytes, src, src_bytes);
+        CHECK_EQ(ZSTD_isError(size), 0U) << "zstd payload is corrupt: " << ZSTD_getErrorName(size);
+        CHECK_EQ(size, dst_bytes) << "zstd payload is truncated";
+        break;
+    }
+    default:
+        LOG(FATAL) << "unknown compression codec: " << codec;
+    }
+}
+
+mrc::codable::protos::CompressionCodec encode_compression_codec(mrc::codable::CompressionCodec codec)
+{
+    switch (codec)
+    {
+    case mrc::codable::CompressionCodec::lz4:
+        return mrc::codable::protos::CompressionCodec::LZ4;
+    case mrc::codable::CompressionCodec::zstd:
+        return mrc::codable::protos::CompressionCodec::Zstd;
+    case mrc::codable::CompressionCodec::none:
+        break;
+    }
+    return mrc::codable::protos::CompressionCodec::Uncompressed;
+}
+
+double CompressionStats::ratio() const
+{
+    if (compressed_bytes == 0)
+    {
+        return 1.0;
+    }
+    return static_cast<double>(uncompressed_bytes) / static_cast<double>(compressed_bytes);
+}
+
+CompressionStats compression_stats()
+{
+    return {s_uncompressed_bytes.load(), s_compressed_bytes.load()};
+}
+
+}  // namespace mrc::internal::codable
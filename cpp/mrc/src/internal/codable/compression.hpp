@@ -0,0 +1,62 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "mrc/codable/encoding_options.hpp"
+#include "mrc/protos/codable.pb.h"
+
+#include <cstddef>
+#include <optional>
+#include <string>
+
+namespace mrc::internal::codable {
+
+/**
+ * @brief Compress bytes bytes at src with codec
+ *
+ * @return std::optional<std::string> - the compressed payload; nullopt if the payload did not shrink by at least an
+ * eighth, in which case the buffer is better sent as is
+ */
+std::optional<std::string> compress(mrc::codable::CompressionCodec codec, const void* src, std::size_t bytes);
+
+/**
+ * @brief Decompress src_bytes bytes at src, compressed with codec, into exactly dst_bytes bytes at dst
+ */
+void decompress(mrc::codable::protos::CompressionCodec codec,
+                const void* src,
+                std::size_t src_bytes,
+                void* dst,
+                std::size_t dst_bytes);
+
+mrc::codable::protos::CompressionCodec encode_compression_codec(mrc::codable::CompressionCodec codec);
+
+/**
+ * @brief Totals of the compressed buffers of this process; only buffers which compressed are counted
+ */
+struct CompressionStats
+{
+    std::size_t uncompressed_bytes{0};
+    std::size_t compressed_bytes{0};
+
+    // ratio of uncompressed to compressed bytes, 1.0 if nothing has been compressed
+    double ratio() const;
+};
+
+CompressionStats compression_stats();
+
+}  // namespace mrc::internal::codable
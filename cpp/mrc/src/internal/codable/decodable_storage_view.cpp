@@ -17,42 +17,83 @@
 
 #include "internal/codable/decodable_storage_view.hpp"
 
+#include "internal/codable/compression.hpp"
 #include "internal/data_plane/client.hpp"
+#include "internal/data_plane/pull_throttle.hpp"
 #include "internal/data_plane/request.hpp"
 #include "internal/data_plane/resources.hpp"
 #include "internal/memory/device_resources.hpp"
 #include "internal/memory/host_resources.hpp"
+#include "internal/memory/shared_memory.hpp"
 #include "internal/network/resources.hpp"
 #include "internal/resources/partition_resources.hpp"
 #include "internal/ucx/endpoint.hpp"
 #include "internal/ucx/remote_registration_cache.hpp"
 
+#include "mrc/data/reusable_pool.hpp"
 #include "mrc/memory/buffer_view.hpp"
 #include "mrc/memory/memory_kind.hpp"
 #include "mrc/protos/codable.pb.h"
 
 #include <glog/logging.h>
+#include <ucp/api/ucp.h>
 #include <ucp/api/ucp_def.h>
 
+#include <cstddef>
 #include <cstring>
-#include <optional>
+#include <deque>
+#include <functional>
+#include <memory>
 #include <ostream>
 #include <string>
+#include <utility>
+#include <vector>
 
 namespace mrc::internal::codable {
 
+namespace {
+
+// number of chunk gets of a chunked copy which may be outstanding at once
+constexpr std::size_t MaxChunksInFlight = 4;
+
+struct InFlightGet
+{
+    mrc::data::Reusable<data_plane::Request> request;
+    data_plane::PullPermit permit;
+};
+
+}  // namespace
+
 std::size_t DecodableStorageView::buffer_size(const idx_t& idx) const
 {
     DCHECK_LT(idx, descriptor_count());
     const auto& desc = proto().descriptors().at(idx);
 
-    CHECK(desc.has_eager_desc() || desc.has_remote_desc());
+    if (desc.codec() != mrc::codable::protos::CompressionCodec::Uncompressed)
+    {
+        return desc.decoded_bytes();
+    }
+
+    return encoded_buffer_size(idx);
+}
+
+std::size_t DecodableStorageView::encoded_buffer_size(const idx_t& idx) const
+{
+    DCHECK_LT(idx, descriptor_count());
+    const auto& desc = proto().descriptors().at(idx);
+
+    CHECK(desc.has_eager_desc() || desc.has_remote_desc() || desc.has_shm_desc());
 
     if (desc.has_eager_desc())
     {
         return desc.eager_desc().data().size();
     }
 
+    if (desc.has_shm_desc())
+    {
+        return desc.shm_desc().bytes();
+    }
+
     // if (desc.has_remote_desc())
     // {
     return desc.remote_desc().bytes();
@@ -60,82 +101,204 @@ std::size_t DecodableStorageView::buffer_size(const idx_t& idx) const
 }
 
 void DecodableStorageView::copy_from_buffer(const idx_t& idx, mrc::memory::buffer_view dst_view) const
+{
+    copy_from_buffer_chunked(idx, {std::move(dst_view)}, [](std::size_t) {});
+}
+
+void DecodableStorageView::copy_from_buffer_chunked(const idx_t& idx,
+                                                    const std::vector<mrc::memory::buffer_view>& dst_views,
+                                                    const std::function<void(std::size_t)>& on_chunk) const
 {
     CHECK_LT(idx, descriptor_count());
+
+    if (proto().descriptors().at(idx).codec() != mrc::codable::protos::CompressionCodec::Uncompressed)
+    {
+        return copy_from_compressed_buffer(idx, dst_views, on_chunk);
+    }
+
+    copy_from_encoded_buffer(idx, dst_views, on_chunk);
+}
+
+void DecodableStorageView::copy_from_encoded_buffer(const idx_t& idx,
+                                                    const std::vector<mrc::memory::buffer_view>& dst_views,
+                                                    const std::function<void(std::size_t)>& on_chunk) const
+{
     const auto& desc = proto().descriptors().at(idx);
 
     if (desc.has_eager_desc())
     {
-        return copy_from_eager_buffer(idx, dst_view);
+        std::size_t offset = 0;
+        for (std::size_t i = 0; i < dst_views.size(); ++i)
+        {
+            copy_from_eager_buffer(idx, offset, dst_views[i]);
+            offset += dst_views[i].bytes();
+            on_chunk(i);
+        }
+        return;
     }
 
     if (desc.has_remote_desc())
     {
-        return copy_from_registered_buffer(idx, dst_view);
+        return copy_from_registered_buffer(idx, dst_views, on_chunk);
+    }
+
+    if (desc.has_shm_desc())
+    {
+        return copy_from_shared_memory_buffer(idx, dst_views, on_chunk);
     }
 
     LOG(FATAL) << "descriptor " << idx << " not backed by a buffered resource";
 }
 
-void DecodableStorageView::copy_from_registered_buffer(const idx_t& idx, mrc::memory::buffer_view& dst_view) const
+void DecodableStorageView::copy_from_compressed_buffer(const idx_t& idx,
+                                                       const std::vector<mrc::memory::buffer_view>& dst_views,
+                                                       const std::function<void(std::size_t)>& on_chunk) const
+{
+    const auto& desc = proto().descriptors().at(idx);
+
+    // the compressed payload is pulled whole; chunks only become available once it has been decompressed
+    std::vector<std::byte> compressed(encoded_buffer_size(idx));
+    copy_from_encoded_buffer(
+        idx, {{compressed.data(), compressed.size(), mrc::memory::memory_kind::host}}, [](std::size_t) {});
+
+    // decompress in place if a single host view receives the entire payload, otherwise stage and scatter
+    if (dst_views.size() == 1 && dst_views[0].kind() != mrc::memory::memory_kind::device &&
+        dst_views[0].bytes() == desc.decoded_bytes())
+    {
+        auto view = dst_views[0];
+        decompress(desc.codec(), compressed.data(), compressed.size(), view.data(), view.bytes());
+        on_chunk(0);
+        return;
+    }
+
+    std::vector<std::byte> decompressed(desc.decoded_bytes());
+    decompress(desc.codec(), compressed.data(), compressed.size(), decompressed.data(), decompressed.size());
+
+    std::size_t offset = 0;
+    for (std::size_t i = 0; i < dst_views.size(); ++i)
+    {
+        auto view = dst_views[i];
+        CHECK_LE(offset + view.bytes(), decompressed.size());
+        CHECK(view.kind() != mrc::memory::memory_kind::device) << "implement async device copies";
+        std::memcpy(view.data(), decompressed.data() + offset, view.bytes());
+        offset += view.bytes();
+        on_chunk(i);
+    }
+}
+
+void DecodableStorageView::copy_from_registered_buffer(const idx_t& idx,
+                                                       const std::vector<mrc::memory::buffer_view>& dst_views,
+                                                       const std::function<void(std::size_t)>& on_chunk) const
 {
     const auto& remote = proto().descriptors().at(idx).remote_desc();
-    CHECK_LE(dst_view.bytes(), remote.bytes());
+
+    std::size_t total_bytes = 0;
+    for (const auto& view : dst_views)
+    {
+        total_bytes += view.bytes();
+    }
+    CHECK_LE(total_bytes, remote.bytes());
 
     // todo(ryan) - check locality, if we are on the same machine but a different instance, use direct method
     if (resources().network()->instance_id() == remote.instance_id())
     {
         LOG(FATAL) << "implement local copy";
     }
+
+    DVLOG(10) << "performing rdma get of " << dst_views.size() << " chunks";
+    data_plane::Client& client = resources().network()->data_plane().client();
+
+    // get endpoint to remote instance_id
+    auto ep     = client.endpoint_shared(remote.instance_id());
+    auto& cache = ep->registration_cache();
+
+    const void* remote_address = reinterpret_cast<const void*>(remote.address());
+    const void* block_address  = reinterpret_cast<const void*>(remote.memory_block_address());
+
+    ucp_rkey_h rkey;
+    if (remote.should_cache())
+    {
+        // the remote key of the block is unpacked on the first pull from the block and reused thereafter
+        rkey = cache.lookup_or_add(remote_address, block_address, remote.memory_block_size(), remote.remote_key())
+                   .remote_key_handle();
+    }
     else
     {
-        LOG(INFO) << "performing rmda get ";
-        bool cached_registration{false};
-        ucp_rkey_h rkey;
-        data_plane::Request request;
-        data_plane::Client& client = resources().network()->data_plane().client();
+        // the remote registration may not outlive the object, so its key must not be cached
+        rkey = cache.unpack(remote.remote_key());
+    }
 
-        // get endpoint to remote instance_id
-        auto ep = client.endpoint_shared(remote.instance_id());
+    // keep a bounded window of gets in flight; chunks complete in order, so the oldest get is always awaited first
+    auto& request_pool = resources().network()->data_plane().request_pool();
+    auto& throttle     = client.pull_throttle();
+    std::deque<InFlightGet> in_flight;
+    std::size_t issued    = 0;
+    std::size_t completed = 0;
+    std::size_t offset    = 0;
 
-        const void* remote_address = reinterpret_cast<const void*>(remote.address());
+    while (completed < dst_views.size())
+    {
+        while (issued < dst_views.size() && in_flight.size() < MaxChunksInFlight)
+        {
+            auto view = dst_views[issued];
 
-        // determine if remote memory region is in the remote memory cache on this endpoint
-        auto block = ep->registration_cache().lookup(remote_address);
+            // the permits of the gets in flight are only released by this fiber, so it may only block for admission
+            // once it has none
+            auto permit = (in_flight.empty() ? throttle.acquire(remote.instance_id(), view.bytes())
+                                             : throttle.try_acquire(remote.instance_id(), view.bytes()));
+            if (!permit)
+            {
+                break;
+            }
 
-        // rkey from cache
-        if (block)
-        {
-            LOG(INFO) << "remote memory region in cache";
-            rkey = block->remote_key_handle();
-        }
-        else
-        {
-            cached_registration = true;
-            auto block =
-                ep->registration_cache().add_block(reinterpret_cast<const void*>(remote.memory_block_address()),
-                                                   remote.memory_block_size(),
-                                                   remote.remote_key());
-            rkey = block.remote_key_handle();
+            auto& get = in_flight.emplace_back(InFlightGet{request_pool.await_item(), std::move(permit)});
+            client.async_striped_get(view.data(), view.bytes(), *ep, remote.address() + offset, rkey, *get.request);
+            offset += view.bytes();
+            issued++;
         }
 
-        // issue rdma get
-        client.async_get(dst_view.data(), dst_view.bytes(), *ep, remote.address(), rkey, request);
+        // await and yield on the oldest get; its permit reports the latency of the get once released
+        in_flight.front().request->await_complete();
+        in_flight.pop_front();
+        on_chunk(completed++);
+    }
 
-        // await and yield on get
-        request.await_complete();
+    if (!remote.should_cache())
+    {
+        ucp_rkey_destroy(rkey);
+    }
+}
 
-        if (cached_registration && !remote.should_cache())
-        {
-            ep->registration_cache().drop_block(reinterpret_cast<const void*>(remote.memory_block_address()));
-        }
+void DecodableStorageView::copy_from_shared_memory_buffer(const idx_t& idx,
+                                                          const std::vector<mrc::memory::buffer_view>& dst_views,
+                                                          const std::function<void(std::size_t)>& on_chunk) const
+{
+    const auto& shm = proto().descriptors().at(idx).shm_desc();
+    CHECK_EQ(shm.host_name(), memory::SharedMemorySegment::host_name())
+        << "shared memory descriptor is not reachable from this host";
+
+    // map the segment once for all chunks
+    auto segment     = memory::SharedMemorySegment::open(shm.segment_name(), shm.bytes());
+    const auto* data = static_cast<const std::byte*>(segment->data());
+
+    std::size_t offset = 0;
+    for (std::size_t i = 0; i < dst_views.size(); ++i)
+    {
+        auto view = dst_views[i];
+        CHECK_LE(offset + view.bytes(), shm.bytes());
+        CHECK(view.kind() != mrc::memory::memory_kind::device) << "implement async device copies";
+        std::memcpy(view.data(), data + offset, view.bytes());
+        offset += view.bytes();
+        on_chunk(i);
     }
 }
 
-void DecodableStorageView::copy_from_eager_buffer(const idx_t& idx, mrc::memory::buffer_view& dst_view) const
+void DecodableStorageView::copy_from_eager_buffer(const idx_t& idx,
+                                                  std::size_t offset,
+                                                  mrc::memory::buffer_view dst_view) const
 {
     const auto& eager_buffer = proto().descriptors().at(idx).eager_desc();
-    CHECK_LE(dst_view.bytes(), eager_buffer.data().size());
+    CHECK_LE(offset + dst_view.bytes(), eager_buffer.data().size());
 
     if (dst_view.kind() == mrc::memory::memory_kind::device)
     {
@@ -146,7 +309,7 @@ void DecodableStorageView::copy_from_eager_buffer(const idx_t& idx, mrc::memory:
     {
         LOG(WARNING) << "got a memory::kind::none";
     }
-    std::memcpy(dst_view.data(), eager_buffer.data().data(), dst_view.bytes());
+    std::memcpy(dst_view.data(), eager_buffer.data().data() + offset, dst_view.bytes());
 }
 
 std::shared_ptr<mrc::memory::memory_resource> DecodableStorageView::host_memory_resource() const
@@ -22,7 +22,9 @@
 #include "mrc/codable/api.hpp"
 
 #include <cstddef>
+#include <functional>
 #include <memory>
+#include <vector>
 
 namespace mrc::memory {
 class buffer_view;
@@ -42,11 +44,33 @@ class DecodableStorageView : public virtual mrc::codable::IDecodableStorage, pub
   protected:
     void copy_from_buffer(const idx_t& idx, mrc::memory::buffer_view dst_view) const final;
 
+    void copy_from_buffer_chunked(const idx_t& idx,
+                                  const std::vector<mrc::memory::buffer_view>& dst_views,
+                                  const std::function<void(std::size_t)>& on_chunk) const final;
+
     std::size_t buffer_size(const idx_t& idx) const final;
 
-    void copy_from_registered_buffer(const idx_t& idx, mrc::memory::buffer_view& dst_view) const;
+    // size of the payload of a descriptor as carried, i.e. before any decompression
+    std::size_t encoded_buffer_size(const idx_t& idx) const;
+
+    // copy the payload of a descriptor as carried, i.e. without decompressing it
+    void copy_from_encoded_buffer(const idx_t& idx,
+                                  const std::vector<mrc::memory::buffer_view>& dst_views,
+                                  const std::function<void(std::size_t)>& on_chunk) const;
+
+    void copy_from_compressed_buffer(const idx_t& idx,
+                                     const std::vector<mrc::memory::buffer_view>& dst_views,
+                                     const std::function<void(std::size_t)>& on_chunk) const;
+
+    void copy_from_registered_buffer(const idx_t& idx,
+                                     const std::vector<mrc::memory::buffer_view>& dst_views,
+                                     const std::function<void(std::size_t)>& on_chunk) const;
+
+    void copy_from_shared_memory_buffer(const idx_t& idx,
+                                        const std::vector<mrc::memory::buffer_view>& dst_views,
+                                        const std::function<void(std::size_t)>& on_chunk) const;
 
-    void copy_from_eager_buffer(const idx_t& idx, mrc::memory::buffer_view& dst_view) const;
+    void copy_from_eager_buffer(const idx_t& idx, std::size_t offset, mrc::memory::buffer_view dst_view) const;
 
     std::shared_ptr<mrc::memory::memory_resource> host_memory_resource() const final;
 
@@ -0,0 +1,178 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "internal/control_plane/batched_event_writer.hpp"
+
+#include "mrc/channel/status.hpp"
+
+#include <glog/logging.h>
+#include <google/protobuf/any.pb.h>
+
+#include <mutex>
+#include <utility>
+
+namespace mrc::internal::control_plane {
+
+BatchedEventWriter::BatchedEventWriter(writer_t writer, std::size_t max_batch_size) :
+  m_writer(std::move(writer)),
+  m_max_batch_size(max_batch_size)
+{
+    CHECK(m_writer);
+    CHECK_GT(m_max_batch_size, 0);
+}
+
+BatchedEventWriter::~BatchedEventWriter()
+{
+    flush();
+}
+
+channel::Status BatchedEventWriter::await_write(protos::Event&& event)
+{
+    std::lock_guard lock(m_mutex);
+
+    // a held request already asks the server for an update
+    if (event.event() == protos::EventType::ClientEventRequestStateUpdate)
+    {
+        if (m_holds_update_request)
+        {
+            return channel::Status::success;
+        }
+        m_holds_update_request = true;
+    }
+
+    const bool awaited = is_awaited(event);
+    m_held.push_back(std::move(event));
+
+    if (awaited || m_held.size() >= m_max_batch_size)
+    {
+        m_holds_update_request = false;
+        return write_events(std::exchange(m_held, {}));
+    }
+    return channel::Status::success;
+}
+
+channel::Status BatchedEventWriter::flush()
+{
+    std::lock_guard lock(m_mutex);
+    if (m_held.empty())
+    {
+        return channel::Status::success;
+    }
+    m_holds_update_request = false;
+    return write_events(std::exchange(m_held, {}));
+}
+
+channel::Status BatchedEventWriter::write_events(std::vector<protos::Event> events)
+{
+    DCHECK(!events.empty());
+
+    if (events.size() == 1)
+    {
+        return m_writer->await_write(std::move(events.front()));
+    }
+
+    protos::EventBatch batch;
+    batch.mutable_events()->Reserve(events.size());
+    for (auto& event : events)
+    {
+        *batch.add_events() = std::move(event);
+    }
+
+    protos::Event event;
+    event.set_event(protos::EventType::Batch);
+    CHECK(event.mutable_message()->PackFrom(batch));
+    return m_writer->await_write(std::move(event));
+}
+
+void BatchedEventWriter::finish()
+{
+    flush();
+    std::lock_guard lock(m_mutex);
+    m_writer->finish();
+}
+
+void BatchedEventWriter::cancel()
+{
+    std::lock_guard lock(m_mutex);
+    m_held.clear();
+    m_holds_update_request = false;
+    m_writer->cancel();
+}
+
+void BatchedEventWriter::reattach(writer_t writer)
+{
+    CHECK(writer);
+    std::lock_guard lock(m_mutex);
+    m_held.clear();
+    m_holds_update_request = false;
+    m_writer               = std::move(writer);
+}
+
+bool BatchedEventWriter::expired() const
+{
+    std::lock_guard lock(m_mutex);
+    return m_writer->expired();
+}
+
+std::size_t BatchedEventWriter::get_id() const
+{
+    std::lock_guard lock(m_mutex);
+    return m_writer->get_id();
+}
+
+std::vector<protos::Event> BatchedEventWriter::unbatch(protos::Event&& event)
+{
+    std::vector<protos::Event> events;
+    if (event.event() != protos::EventType::Batch)
+    {
+        events.push_back(std::move(event));
+        return events;
+    }
+
+    protos::EventBatch batch;
+    CHECK(event.has_message() && event.message().UnpackTo(&batch));
+    events.reserve(batch.events_size());
+    for (auto& batched : *batch.mutable_events())
+    {
+        events.push_back(std::move(batched));
+    }
+    return events;
+}
+
+bool BatchedEventWriter::is_awaited(const protos::Event& event)
+{
+    switch (event.event())
+    {
+    case protos::EventType::Response:
+    case protos::EventType::ControlStop:
+    case protos::EventType::ClientUnaryRegisterWorkers:
+    case protos::EventType::ClientUnaryActivateStream:
+    case protos::EventType::ClientUnaryLookupWorkerAddresses:
+    case protos::EventType::ClientUnaryDropWorker:
+    case protos::EventType::ClientUnaryCreateSubscriptionService:
+    case protos::EventType::ClientUnaryRegisterSubscriptionService:
+    case protos::EventType::ClientUnaryActivateSubscriptionService:
+    case protos::EventType::ClientUnaryDropSubscriptionService:
+    case protos::EventType::ClientUnaryReattachWorkers:
+    case protos::EventType::ClientUnaryArchitectRole:
+        return true;
+    default:
+        return false;
+    }
+}
+
+}  // namespace mrc::internal::control_plane
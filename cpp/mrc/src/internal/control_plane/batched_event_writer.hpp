@@ -0,0 +1,89 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "internal/grpc/stream_writer.hpp"
+
+#include "mrc/protos/architect.pb.h"
+
+#include <boost/fiber/mutex.hpp>
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace mrc::channel {
+enum class Status;
+}  // namespace mrc::channel
+
+namespace mrc::internal::control_plane {
+
+/**
+ * @brief StreamWriter which coalesces the events written to a control plane stream into protos::EventBatch writes
+ *
+ * Events awaited by the peer, i.e. unary requests, their responses and stop requests, flush the held events together
+ * with themselves, so they are never delayed. All other events are held until the next flush(), which the owner issues
+ * periodically or at the end of a burst of writes. A ClientEventRequestStateUpdate is dropped if one is already held.
+ */
+class BatchedEventWriter final : public rpc::StreamWriter<protos::Event>
+{
+  public:
+    using writer_t = std::shared_ptr<rpc::StreamWriter<protos::Event>>;
+
+    // maximum number of held events; reaching it triggers a flush
+    static constexpr std::size_t DefaultMaxBatchSize = 256;
+
+    BatchedEventWriter(writer_t writer, std::size_t max_batch_size = DefaultMaxBatchSize);
+    ~BatchedEventWriter() final;
+
+    // [Ingress<Event>] hold the event for the next flush, or flush immediately if the event is awaited by the peer
+    channel::Status await_write(protos::Event&& event) final;
+
+    // write the held events as a single write
+    channel::Status flush();
+
+    // [StreamWriter] flush the held events, then finish the stream
+    void finish() final;
+
+    // [StreamWriter] drop the held events and cancel the stream
+    void cancel() final;
+
+    // write all subsequent events to writer, e.g. the stream to a new leader after a failover; the events held for the
+    // previous stream are dropped
+    void reattach(writer_t writer);
+
+    bool expired() const final;
+    std::size_t get_id() const final;
+
+    // expand a Batch event into its events; other events are returned as the only element
+    static std::vector<protos::Event> unbatch(protos::Event&& event);
+
+  private:
+    static bool is_awaited(const protos::Event& event);
+
+    // write events as a single event or a single Batch event; m_mutex must be held to keep writes in order
+    channel::Status write_events(std::vector<protos::Event> events);
+
+    writer_t m_writer;
+    const std::size_t m_max_batch_size;
+    std::vector<protos::Event> m_held;
+    bool m_holds_update_request{false};
+    mutable boost::fibers::mutex m_mutex;
+};
+
+}  // namespace mrc::internal::control_plane
@@ -17,16 +17,18 @@
 
 #include "internal/control_plane/client.hpp"
 
+#include "internal/control_plane/batched_event_writer.hpp"
 #include "internal/control_plane/client/connections_manager.hpp"
+#include "internal/grpc/channel.hpp"
 #include "internal/grpc/progress_engine.hpp"
-#include "internal/grpc/promise_handler.hpp"
 #include "internal/runnable/resources.hpp"
 #include "internal/system/system.hpp"
 
 #include "mrc/channel/status.hpp"
-#include "mrc/node/edge_builder.hpp"
+#include "mrc/core/task_queue.hpp"
 #include "mrc/node/rx_sink.hpp"
 #include "mrc/node/source_channel.hpp"
+#include "mrc/options/network.hpp"
 #include "mrc/options/options.hpp"
 #include "mrc/protos/architect.grpc.pb.h"
 #include "mrc/protos/architect.pb.h"
@@ -34,13 +36,17 @@
 #include "mrc/runnable/launcher.hpp"
 #include "mrc/runnable/runner.hpp"
 
+#include <boost/fiber/operations.hpp>
 #include <google/protobuf/any.pb.h>
 #include <grpcpp/completion_queue.h>
 #include <grpcpp/grpcpp.h>
 #include <grpcpp/security/credentials.h>
 #include <rxcpp/rx.hpp>
 
+#include <chrono>
 #include <ostream>
+#include <utility>
+#include <vector>
 
 namespace mrc::internal::control_plane {
 
@@ -67,77 +73,262 @@ void Client::do_service_start()
     m_launch_options.pe_count            = 1;
     m_launch_options.engines_per_pe      = 1;
 
-    auto url = runnable().system().options().architect_url();
-    CHECK(!url.empty());
-    auto channel = grpc::CreateChannel(url, grpc::InsecureChannelCredentials());
-    m_stub       = mrc::protos::Architect::NewStub(channel);
+    m_urls = runnable().system().options().architect_urls();
+    CHECK(!m_urls.empty());
 
     if (m_owns_progress_engine)
     {
         CHECK(m_cq);
-        auto progress_engine  = std::make_unique<rpc::ProgressEngine>(m_cq);
-        auto progress_handler = std::make_unique<rpc::PromiseHandler>();
+        m_progress_engine = std::make_unique<rpc::ProgressEngine>(
+            runnable(), std::vector<std::shared_ptr<grpc::CompletionQueue>>{m_cq});
+    }
+
+    // ensure all downstream event handlers are constructed before constructing and starting the event handler
+    m_connections_update_channel = std::make_unique<mrc::node::SourceChannelWriteable<const protos::StateUpdate>>();
+    m_connections_manager        = std::make_unique<client::ConnectionsManager>(*this, *m_connections_update_channel);
+
+    // await initialization
+    auto writer = connect(false);
+
+    if (!writer)
+    {
+        forward_state(State::FailedToConnect);
+        LOG(FATAL) << "unable to connect to control plane";
+    }
 
-        mrc::node::make_edge(*progress_engine, *progress_handler);
+    // coalesce events not awaited by the server over the batch window
+    const auto batch_window = runnable().system().options().network().control_plane_batch_window();
+    m_writer                = std::make_shared<BatchedEventWriter>(
+        std::move(writer), batch_window.count() > 0 ? BatchedEventWriter::DefaultMaxBatchSize : 1);
 
-        m_progress_handler =
-            runnable().launch_control().prepare_launcher(launch_options(), std::move(progress_handler))->ignition();
-        m_progress_engine =
-            runnable().launch_control().prepare_launcher(launch_options(), std::move(progress_engine))->ignition();
+    if (batch_window.count() > 0)
+    {
+        m_flusher_running = true;
+        m_flusher         = runnable().main().enqueue([this, batch_window] {
+            while (m_flusher_running)
+            {
+                boost::this_fiber::sleep_for(batch_window);
+                m_writer->flush();
+            }
+        });
     }
 
+    forward_state(State::Connected);
+}
+
+Client::writer_t Client::connect(bool retry)
+{
+    const auto deadline = std::chrono::steady_clock::now() + m_failover_timeout;
+    for (;;)
+    {
+        for (std::size_t i = 0; i < m_urls.size(); i++)
+        {
+            if (auto writer = connect(m_urls[m_url_index]))
+            {
+                return writer;
+            }
+            m_url_index = (m_url_index + 1) % m_urls.size();
+        }
+
+        // a standby may not yet have been promoted
+        if (!retry || std::chrono::steady_clock::now() >= deadline)
+        {
+            return nullptr;
+        }
+        boost::this_fiber::sleep_for(m_connect_timeout);
+    }
+}
+
+Client::writer_t Client::connect(const std::string& url)
+{
+    auto channel = grpc::CreateChannel(url, grpc::InsecureChannelCredentials());
+    if (!rpc::await_connected(*channel, *m_cq, m_connect_timeout))
+    {
+        DVLOG(10) << "architect " << url << " is not reachable";
+        return nullptr;
+    }
+    m_channel = std::move(channel);
+    m_stub    = mrc::protos::Architect::NewStub(m_channel);
+
     auto prepare_fn = [this](grpc::ClientContext* context) {
         CHECK(m_stub);
         return m_stub->PrepareAsyncEventStream(context, m_cq.get());
     };
 
-    // event handler - optionally add concurrency here
-    auto event_handler =
-        std::make_unique<node::RxSink<event_t>>([this](event_t event) { do_handle_event(std::move(event)); });
+    // make stream and attach event handler - optionally add concurrency here
+    auto stream        = std::make_shared<stream_t::element_type>(prepare_fn, runnable());
+    auto event_handler = std::make_unique<node::RxSink<event_t>>(
+        [this](event_t event) { do_handle_event(std::move(event)); },
+        [this, id = stream.get()] { on_stream_closed(id); });
+    stream->attach_to(*event_handler);
 
-    // make stream and attach event handler
-    m_stream = std::make_shared<stream_t::element_type>(prepare_fn, runnable());
-    m_stream->attach_to(*event_handler);
+    auto handler = runnable().launch_control().prepare_launcher(launch_options(), std::move(event_handler))->ignition();
 
-    // ensure all downstream event handlers are constructed before constructing and starting the event handler
-    m_connections_update_channel = std::make_unique<mrc::node::SourceChannelWriteable<const protos::StateUpdate>>();
-    m_connections_manager        = std::make_unique<client::ConnectionsManager>(*this, *m_connections_update_channel);
+    auto writer = stream->await_init();
+    if (writer)
+    {
+        // only the leader accepts the requests of clients
+        auto role = await_role(writer);
+        if (role && role->leader())
+        {
+            DVLOG(10) << "connected to architect leader " << url << " of term " << role->term();
+            std::lock_guard<decltype(m_mutex)> lock(m_mutex);
+            m_stream        = std::move(stream);
+            m_event_handler = std::move(handler);
+            return writer;
+        }
 
-    // launch runnables
-    m_event_handler =
-        runnable().launch_control().prepare_launcher(launch_options(), std::move(event_handler))->ignition();
+        DVLOG(10) << "architect " << url << " is not the leader";
+        writer->finish();
+        writer.reset();
+    }
 
-    // await initialization
-    m_writer = m_stream->await_init();
+    handler->await_join();
+    stream->await_fini();
+    return nullptr;
+}
+
+std::optional<protos::ArchitectRole> Client::await_role(const writer_t& writer)
+{
+    Completion<protos::Event> completion;
 
-    if (!m_writer)
+    protos::Event event;
+    event.set_event(protos::EventType::ClientUnaryArchitectRole);
+    event.set_tag(reinterpret_cast<std::uint64_t>(&completion));
+    CHECK(event.mutable_message()->PackFrom(protos::Ack{}));
     {
-        forward_state(State::FailedToConnect);
-        LOG(FATAL) << "unable to connect to control plane";
+        std::lock_guard<decltype(m_mutex)> lock(m_mutex);
+        m_pending_responses.insert(&completion);
     }
 
-    forward_state(State::Connected);
+    const bool written = (writer->await_write(std::move(event)) == channel::Status::success);
+    if (!written || !completion.wait_for(m_connect_timeout))
+    {
+        // the response is set while holding the lock; if it is no longer pending, the completion is ready
+        std::lock_guard<decltype(m_mutex)> lock(m_mutex);
+        if (m_pending_responses.erase(&completion) != 0)
+        {
+            return std::nullopt;
+        }
+    }
+
+    const auto& response = completion.await();
+    protos::ArchitectRole role;
+    if (!response.has_message() || !response.message().UnpackTo(&role))
+    {
+        return std::nullopt;
+    }
+    return role;
+}
+
+void Client::on_stream_closed(const stream_t::element_type* stream)
+{
+    std::lock_guard<decltype(m_mutex)> lock(m_mutex);
+    if (m_stopping || stream != m_stream.get())
+    {
+        return;
+    }
+    m_failover = runnable().main().enqueue([this] { failover(); });
+}
+
+void Client::failover()
+{
+    LOG(WARNING) << "lost the connection to the architect leader " << m_urls[m_url_index] << "; failing over";
+
+    // join the runnables of the lost stream
+    stream_t lost_stream;
+    std::unique_ptr<mrc::runnable::Runner> lost_handler;
+    {
+        std::lock_guard<decltype(m_mutex)> lock(m_mutex);
+        lost_stream  = std::move(m_stream);
+        lost_handler = std::move(m_event_handler);
+    }
+    lost_handler->await_join();
+    lost_stream->await_fini();
+
+    fail_pending_responses();
+
+    m_url_index = (m_url_index + 1) % m_urls.size();
+    auto writer = connect(true);
+    if (!writer)
+    {
+        LOG(FATAL) << "unable to fail over to an architect leader";
+    }
+    m_writer->reattach(std::move(writer));
+
+    State state;
+    {
+        std::lock_guard<decltype(m_mutex)> lock(m_mutex);
+        state = m_state;
+    }
+    if (state == State::Operational)
+    {
+        auto status = m_connections_manager->reattach_instances();
+        if (!status)
+        {
+            LOG(FATAL) << "failed to reattach instances to the architect leader: " << status.error().message();
+        }
+    }
+
+    request_update();
+    LOG(INFO) << "failed over to architect leader " << m_urls[m_url_index];
+}
+
+void Client::await_failover()
+{
+    Future<void> failover;
+    {
+        std::lock_guard<decltype(m_mutex)> lock(m_mutex);
+        m_stopping = true;
+        failover   = std::move(m_failover);
+    }
+    if (failover.valid())
+    {
+        failover.get();
+    }
+}
+
+void Client::fail_pending_responses()
+{
+    std::lock_guard<decltype(m_mutex)> lock(m_mutex);
+    for (auto* completion : m_pending_responses)
+    {
+        protos::Event response;
+        response.set_event(protos::EventType::Response);
+        response.mutable_error()->set_code(protos::ErrorCode::ServerError);
+        response.mutable_error()->set_message("connection to the architect leader was lost before the response");
+        completion->complete(std::move(response));
+    }
+    m_pending_responses.clear();
 }
 
 void Client::do_service_stop()
 {
+    await_failover();
+    stop_flusher();
     m_writer->finish();
     m_writer.reset();
 }
 
 void Client::do_service_kill()
 {
+    await_failover();
+    stop_flusher();
     m_writer->cancel();
     m_writer.reset();
 }
 
-void Client::do_service_await_live()
+void Client::stop_flusher()
 {
-    if (m_owns_progress_engine)
+    if (m_flusher.valid())
     {
-        m_progress_engine->await_live();
-        m_progress_handler->await_live();
+        m_flusher_running = false;
+        m_flusher.get();
     }
+}
+
+void Client::do_service_await_live()
+{
     m_event_handler->await_live();
 }
 
@@ -149,9 +340,8 @@ void Client::do_service_await_join()
 
     if (m_owns_progress_engine)
     {
-        m_cq->Shutdown();
-        m_progress_engine->await_join();
-        m_progress_handler->await_join();
+        m_progress_engine->shutdown();
+        m_progress_engine->join();
     }
 }
 
@@ -159,13 +349,23 @@ void Client::do_handle_event(event_t&& event)
 {
     switch (event.msg.event())
     {
+    case protos::EventType::Batch: {
+        for (auto& msg : BatchedEventWriter::unbatch(std::move(event.msg)))
+        {
+            do_handle_event({std::move(msg), event.stream});
+        }
+    }
+    break;
+
         // handle a subset of events directly on the event handler
 
     case protos::EventType::Response: {
-        auto* promise = reinterpret_cast<Promise<protos::Event>*>(event.msg.tag());
-        if (promise != nullptr)
+        // responses to requests already failed by a failover are dropped
+        auto* completion = reinterpret_cast<Completion<protos::Event>*>(event.msg.tag());
+        std::lock_guard<decltype(m_mutex)> lock(m_mutex);
+        if (m_pending_responses.erase(completion) != 0)
         {
-            promise->set_value(std::move(event.msg));
+            completion->complete(std::move(event.msg));
         }
     }
     break;
@@ -17,6 +17,7 @@
 
 #pragma once
 
+#include "internal/control_plane/batched_event_writer.hpp"
 #include "internal/control_plane/client/instance.hpp"  // IWYU pragma: keep
 #include "internal/expected.hpp"
 #include "internal/grpc/client_streaming.hpp"
@@ -24,6 +25,8 @@
 #include "internal/resources/partition_resources_base.hpp"
 #include "internal/service.hpp"
 
+#include "mrc/channel/status.hpp"
+#include "mrc/core/completion.hpp"
 #include "mrc/node/source_channel.hpp"
 #include "mrc/protos/architect.grpc.pb.h"
 #include "mrc/protos/architect.pb.h"
@@ -34,6 +37,9 @@
 #include <boost/fiber/future/future.hpp>
 #include <glog/logging.h>
 
+#include <atomic>
+#include <chrono>
+#include <cstddef>
 #include <cstdint>
 #include <map>
 #include <memory>
@@ -79,6 +85,10 @@ class AsyncStatus;
  * The event handler with this class will directly handle ClientErrors, while InstanceErrors will be forward via the
  * event router to the specific instance handler.
  *
+ * The architect url may list multiple architect replicas. The client connects to the first replica which reports to be
+ * the leader. If the stream to the leader is lost, the client fails over to the next leader: requests awaiting a
+ * response fail, the registered instances are reattached with their instance_ids and the state of the client is
+ * resynchronized with the snapshots issued by the new leader.
  */
 
 // todo: client should be a holder of the stream (private) and the connection manager (public)
@@ -152,10 +162,29 @@ class Client final : public resources::PartitionResourceBase, public Service
     void do_service_start() final;
     void do_service_stop() final;
     void do_service_kill() final;
+
+    // stop the periodic flush of m_writer
+    void stop_flusher();
     void do_service_await_live() final;
     void do_service_await_join() final;
     void do_handle_event(event_t&& event);
 
+    // connect to the leader among the architect urls, starting at m_url_index; retried until m_failover_timeout if
+    // retry is set; returns nullptr if no leader was reached
+    writer_t connect(bool retry);
+    writer_t connect(const std::string& url);
+
+    // query the role of the architect on the other end of writer; nullopt if it does not respond in m_connect_timeout
+    std::optional<protos::ArchitectRole> await_role(const writer_t& writer);
+
+    // fail over to the next leader if stream is the stream to the current leader
+    void on_stream_closed(const stream_t::element_type* stream);
+    void failover();
+    void await_failover();
+
+    // complete the requests awaiting a response from the lost leader with an error
+    void fail_pending_responses();
+
     void forward_state(State state);
 
     State m_state{State::Disconnected};
@@ -172,8 +201,7 @@ class Client final : public resources::PartitionResourceBase, public Service
     // if true, then the following runners should not be null
     // if false, then the following runners must be null
     const bool m_owns_progress_engine;
-    std::unique_ptr<mrc::runnable::Runner> m_progress_handler;
-    std::unique_ptr<mrc::runnable::Runner> m_progress_engine;
+    std::unique_ptr<rpc::ProgressEngine> m_progress_engine;
     std::unique_ptr<mrc::runnable::Runner> m_event_handler;
 
     // std::map<std::string, std::unique_ptr<node::SourceChannelWriteable<protos::StateUpdate>>> m_update_channels;
@@ -187,12 +215,27 @@ class Client final : public resources::PartitionResourceBase, public Service
     std::unique_ptr<mrc::node::SourceChannelWriteable<const protos::StateUpdate>> m_connections_update_channel;
     std::map<InstanceID, mrc::node::SourceChannelWriteable<const protos::StateUpdate>> m_instance_update_channels;
 
+    // architect replicas; m_url_index is the replica of m_stream
+    std::vector<std::string> m_urls;
+    std::size_t m_url_index{0};
+    std::chrono::milliseconds m_connect_timeout{1000};
+    std::chrono::milliseconds m_failover_timeout{30000};
+
+    // requests awaiting a response; completed by the event handler or failed on a failover
+    std::set<Completion<protos::Event>*> m_pending_responses;
+    bool m_stopping{false};
+    Future<void> m_failover;
+
     // Stream Context
     stream_t m_stream;
 
-    // StreamWriter acquired from m_stream->await_init()
+    // StreamWriter acquired from m_stream->await_init(); events not awaited by the server are coalesced
     // The customer destruction of this object will cause a gRPC WritesDone to be issued to the server.
-    writer_t m_writer;
+    std::shared_ptr<BatchedEventWriter> m_writer;
+
+    // periodically flushes the events held by m_writer
+    std::atomic<bool> m_flusher_running{false};
+    Future<void> m_flusher;
 
     mrc::runnable::LaunchOptions m_launch_options;
 
@@ -216,7 +259,7 @@ class AsyncStatus
     Expected<ResponseT> await_response()
     {
         // todo(ryan): expand this into a wait_until with a deadline and a stop token
-        auto event = m_promise.get_future().get();
+        auto& event = m_completion.await();
 
         if (event.has_error())
         {
@@ -233,7 +276,7 @@ class AsyncStatus
     }
 
   private:
-    Promise<protos::Event> m_promise;
+    Completion<protos::Event> m_completion;
     friend Client;
 };
 
@@ -250,9 +293,24 @@ void Client::async_unary(const protos::EventType& event_type, RequestT&& request
 {
     protos::Event event;
     event.set_event(event_type);
-    event.set_tag(reinterpret_cast<std::uint64_t>(&status.m_promise));
+    event.set_tag(reinterpret_cast<std::uint64_t>(&status.m_completion));
     CHECK(event.mutable_message()->PackFrom(request));
-    m_writer->await_write(std::move(event));
+    {
+        std::lock_guard<decltype(m_mutex)> lock(m_mutex);
+        m_pending_responses.insert(&status.m_completion);
+    }
+    if (m_writer->await_write(std::move(event)) != channel::Status::success)
+    {
+        // the stream to the leader was lost; the request fails unless a failover already failed it
+        std::lock_guard<decltype(m_mutex)> lock(m_mutex);
+        if (m_pending_responses.erase(&status.m_completion) != 0)
+        {
+            protos::Event response;
+            response.mutable_error()->set_code(protos::ErrorCode::ServerError);
+            response.mutable_error()->set_message("unable to write the request to the architect");
+            status.m_completion.complete(std::move(response));
+        }
+    }
 }
 
 template <typename MessageT>
@@ -21,9 +21,13 @@
 #include "internal/control_plane/client/instance.hpp"
 #include "internal/expected.hpp"
 #include "internal/runnable/resources.hpp"
+#include "internal/system/device_partition.hpp"
+#include "internal/system/host_partition.hpp"
+#include "internal/system/partition.hpp"
 #include "internal/ucx/resources.hpp"
 #include "internal/ucx/worker.hpp"
 #include "internal/utils/contains.hpp"
+#include "internal/utils/host_name.hpp"
 
 #include "mrc/core/task_queue.hpp"
 #include "mrc/protos/architect.pb.h"
@@ -62,10 +66,18 @@ std::map<InstanceID, std::unique_ptr<client::Instance>> ConnectionsManager::regi
     CHECK(client().state() == Client::State::RegisteringWorkers);
 
     protos::RegisterWorkersRequest req;
+    std::vector<protos::WorkerLocality> localities;
     for (auto& ucx : ucx_resources)
     {
         DCHECK(ucx);
         req.add_ucx_worker_addresses(ucx->worker().address());
+
+        const auto& partition = ucx->partition();
+        auto& locality        = localities.emplace_back();
+        locality.set_host_name(utils::host_name());
+        locality.set_numa_node(partition.host().numa_set().first());
+        locality.set_cuda_device_id(partition.has_device() ? partition.device().cuda_device_id() : -1);
+        *req.add_localities() = locality;
     }
 
     auto resp =
@@ -80,6 +92,7 @@ std::map<InstanceID, std::unique_ptr<client::Instance>> ConnectionsManager::regi
         auto id = resp->instance_ids().at(i);
         m_instance_ids.push_back(id);
         m_worker_addresses[id] = ucx_resources.at(i)->worker().address();
+        set_locality(id, m_machine_id, localities.at(i));
         m_update_channels[id]  = std::make_unique<update_channel_t>();
         instances[id] =
             std::make_unique<client::Instance>(client(), id, *ucx_resources.at(i), *m_update_channels.at(id));
@@ -92,25 +105,61 @@ std::map<InstanceID, std::unique_ptr<client::Instance>> ConnectionsManager::regi
     return instances;
 }
 
+Expected<> ConnectionsManager::reattach_instances()
+{
+    protos::ReattachWorkersRequest req;
+    req.set_machine_id(m_machine_id);
+    for (const auto& id : m_instance_ids)
+    {
+        auto local = locality(id);
+        CHECK(local);
+
+        auto* worker = req.add_workers();
+        worker->set_machine_id(m_machine_id);
+        worker->set_instance_id(id);
+        worker->set_worker_address(m_worker_addresses.at(id));
+        worker->mutable_locality()->set_host_name(local->host_name);
+        worker->mutable_locality()->set_numa_node(local->numa_node);
+        worker->mutable_locality()->set_cuda_device_id(local->cuda_device_id);
+    }
+
+    auto resp =
+        client().await_unary<protos::RegisterWorkersResponse>(protos::ClientUnaryReattachWorkers, std::move(req));
+    MRC_EXPECT(resp);
+
+    DVLOG(10) << "client - reattached " << resp->instance_ids_size() << " instances of machine_id: " << m_machine_id;
+    return {};
+}
+
 void ConnectionsManager::do_update(const protos::StateUpdate&& update_msg)
 {
     DCHECK(client().runnable().main().caller_on_same_thread());
 
     if (update_msg.has_connections())
     {
-        return do_connections_update(update_msg.connections());
+        return do_connections_update(update_msg.connections(), update_msg.base_nonce() == 0);
     }
 
     LOG(FATAL) << "unhandled update";
 }
 
-void ConnectionsManager::do_connections_update(const protos::UpdateConnectionsState& connections)
+void ConnectionsManager::do_connections_update(const protos::UpdateConnectionsState& connections, bool is_snapshot)
 {
+    // a snapshot holds all connections, a delta the changes to the connections of the previous update
     std::set<InstanceID> new_instance_ids;
+    if (!is_snapshot)
+    {
+        new_instance_ids = m_connected_instance_ids;
+        for (const auto& tagged_instance : connections.removed_tagged_instances())
+        {
+            new_instance_ids.erase(tagged_instance.instance_id());
+        }
+    }
     for (const auto& tagged_instance : connections.tagged_instances())
     {
         new_instance_ids.insert(tagged_instance.instance_id());
     }
+    m_connected_instance_ids = new_instance_ids;
 
     DVLOG(10) << "after update the client will have " << new_instance_ids.size() << " connections";
 
@@ -135,6 +184,10 @@ void ConnectionsManager::do_connections_update(const protos::UpdateConnectionsSt
     for (const auto& id : remove_instances)
     {
         m_worker_addresses.erase(id);
+        {
+            std::lock_guard lock(m_locality_mutex);
+            m_locality_map.erase(id);
+        }
 
         // this will drop the instance and allow the client::Instance to complete destruction
         m_update_channels.erase(id);
@@ -163,16 +216,36 @@ void ConnectionsManager::do_connections_update(const protos::UpdateConnectionsSt
         {
             DVLOG(10) << "registering ucx worker address for instance_id: " << worker.instance_id();
             m_worker_addresses[worker.instance_id()] = worker.worker_address();
+            set_locality(worker.instance_id(), worker.machine_id(), worker.locality());
         }
     }
 }
 
-const std::map<InstanceID, MachineID>& ConnectionsManager::locality_map() const
+const std::map<InstanceID, InstanceLocality>& ConnectionsManager::locality_map() const
 {
     DCHECK(client().runnable().main().caller_on_same_thread());
     return m_locality_map;
 }
 
+std::optional<InstanceLocality> ConnectionsManager::locality(const InstanceID& instance_id) const
+{
+    std::lock_guard lock(m_locality_mutex);
+    auto search = m_locality_map.find(instance_id);
+    if (search == m_locality_map.end())
+    {
+        return std::nullopt;
+    }
+    return search->second;
+}
+
+void ConnectionsManager::set_locality(const InstanceID& instance_id,
+                                      const MachineID& machine_id,
+                                      const protos::WorkerLocality& locality)
+{
+    std::lock_guard lock(m_locality_mutex);
+    m_locality_map[instance_id] = {machine_id, locality.host_name(), locality.numa_node(), locality.cuda_device_id()};
+}
+
 const std::map<InstanceID, ucx::WorkerAddress>& ConnectionsManager::worker_addresses() const
 {
     // DCHECK(client().runnable().main().caller_on_same_thread());
@@ -20,15 +20,20 @@
 #pragma once
 
 #include "internal/control_plane/client/state_manager.hpp"
+#include "internal/expected.hpp"
 #include "internal/ucx/common.hpp"
 
 #include "mrc/node/source_channel.hpp"
 #include "mrc/protos/architect.pb.h"
 #include "mrc/types.hpp"
 
+#include <cstdint>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <optional>
+#include <set>
+#include <string>
 #include <vector>
 
 namespace mrc::internal::control_plane {
@@ -41,6 +46,17 @@ class Resources;
 namespace mrc::internal::control_plane::client {
 class Instance;
 
+/**
+ * @brief Where an instance lives, as registered by the client owning the instance
+ */
+struct InstanceLocality
+{
+    MachineID machine_id;
+    std::string host_name;
+    std::int32_t numa_node{-1};
+    std::int32_t cuda_device_id{-1};
+};
+
 class ConnectionsManager : public StateManager
 {
   public:
@@ -52,22 +68,34 @@ class ConnectionsManager : public StateManager
     std::map<InstanceID, std::unique_ptr<client::Instance>> register_ucx_addresses(
         std::vector<std::optional<ucx::Resources>>& ucx_resources);
 
+    // reattach the registered instances to the architect leader after a failover, retaining their ids and tags
+    Expected<> reattach_instances();
+
     const MachineID& machine_id() const;
     const std::vector<InstanceID>& instance_ids() const;
 
-    const std::map<InstanceID, MachineID>& locality_map() const;
+    const std::map<InstanceID, InstanceLocality>& locality_map() const;
+
+    // thread safe lookup of the locality of an instance; nullopt if the instance is unknown to the client
+    std::optional<InstanceLocality> locality(const InstanceID& instance_id) const;
     const std::map<InstanceID, ucx::WorkerAddress>& worker_addresses() const;
     const std::map<InstanceID, std::unique_ptr<update_channel_t>>& instance_channels() const;
 
   private:
     void do_update(const protos::StateUpdate&& update_msg) final;
-    void do_connections_update(const protos::UpdateConnectionsState& connections);
+    void do_connections_update(const protos::UpdateConnectionsState& connections, bool is_snapshot);
     void do_route_state_update(const protos::StateUpdate&& update_msg);
+    void set_locality(const InstanceID& instance_id,
+                      const MachineID& machine_id,
+                      const protos::WorkerLocality& locality);
 
     MachineID m_machine_id;
     std::vector<InstanceID> m_instance_ids;
-    std::map<InstanceID, MachineID> m_locality_map;
+    std::map<InstanceID, InstanceLocality> m_locality_map;
+    mutable std::mutex m_locality_mutex;
     std::map<InstanceID, ucx::WorkerAddress> m_worker_addresses;
+    // instance ids of the last applied connections update
+    std::set<InstanceID> m_connected_instance_ids;
     std::map<InstanceID, std::unique_ptr<update_channel_t>> m_update_channels;
 };
 
@@ -122,7 +122,7 @@ void Instance::do_handle_state_update(const protos::StateUpdate& update)
         DVLOG(10) << "control plane instance on partition " << partition_id() << " got an update msg for "
                   << update.service_name();
         return do_update_subscription_state(
-            update.service_name(), update.nonce(), update.update_subscription_service());
+            update.service_name(), update.nonce(), update.base_nonce(), update.update_subscription_service());
     }
 
     if (update.has_drop_subscription_service())
@@ -158,29 +158,70 @@ void Instance::do_handle_state_update(const protos::StateUpdate& update)
 
 void Instance::do_update_subscription_state(const std::string& service_name,
                                             const std::uint64_t& nonce,
+                                            const std::uint64_t& base_nonce,
                                             const protos::UpdateSubscriptionServiceState& update)
 {
     auto range = m_subscription_services.equal_range(service_name);
     std::vector<std::uint64_t> tags;
-    std::unordered_map<std::uint64_t, InstanceID> tagged_instances;
     for (auto it = range.first; it != range.second; it++)
     {
-        auto& service = *it->second;
-        if (contains(service.subscribe_to_roles(), update.role()))
+        if (contains(it->second->subscribe_to_roles(), update.role()))
+        {
+            tags.push_back(it->second->tag());
+        }
+    }
+
+    auto& state = m_role_states[{service_name, update.role()}];
+
+    // a delta only applies to the version it was made against; request a snapshot once
+    if (base_nonce != 0 && base_nonce != state.nonce)
+    {
+        DVLOG(10) << "client::Instance[" << partition_id() << "]: delta update of service: " << service_name
+                  << "; role: " << update.role() << " for version " << base_nonce << " does not apply to version "
+                  << state.nonce << "; requesting snapshot";
+        if (!state.resync_requested && !tags.empty())
         {
-            // lazy populate
-            if (tagged_instances.empty())
+            state.resync_requested = true;
+
+            protos::UpdateSubscriptionServiceRequest req;
+            req.set_service_name(service_name);
+            req.set_role(update.role());
+            req.set_nonce(state.nonce);
+            req.set_resync(true);
+            for (const auto& tag : tags)
             {
-                for (const auto& ti : update.tagged_instances())
-                {
-                    tagged_instances[ti.tag()] = ti.instance_id();
-                }
+                req.add_tags(tag);
             }
+            client().issue_event(protos::ClientEventUpdateSubscriptionService, std::move(req));
+        }
+        return;
+    }
+
+    if (base_nonce == 0)
+    {
+        state.tagged_instances.clear();
+        state.resync_requested = false;
+    }
+    for (const auto& ti : update.removed_tagged_instances())
+    {
+        state.tagged_instances.erase(ti.tag());
+    }
+    for (const auto& ti : update.tagged_instances())
+    {
+        state.tagged_instances[ti.tag()] = ti.instance_id();
+    }
+    state.nonce = nonce;
+
+    const auto& tagged_instances = state.tagged_instances;
+    for (auto it = range.first; it != range.second; it++)
+    {
+        auto& service = *it->second;
+        if (contains(service.subscribe_to_roles(), update.role()))
+        {
             DVLOG(10) << "client::Instance[" << partition_id() << "]: updating service: " << service.service_name()
                       << "; role: " << service.role() << "; tag: " << service.tag() << "; with "
                       << tagged_instances.size() << " tagged instances";
             service.subscriptions(update.role()).update_tagged_instances(tagged_instances);
-            tags.push_back(service.tag());
         }
     }
     if (!tags.empty())
@@ -26,6 +26,8 @@
 #include <map>
 #include <memory>
 #include <string>
+#include <unordered_map>
+#include <utility>
 
 namespace mrc::internal::control_plane {
 class Client;
@@ -76,6 +78,7 @@ class Instance final : private resources::PartitionResourceBase, private Service
     void do_handle_state_update(const protos::StateUpdate& update);
     void do_update_subscription_state(const std::string& service_name,
                                       const std::uint64_t& nonce,
+                                      const std::uint64_t& base_nonce,
                                       const protos::UpdateSubscriptionServiceState& update);
     void do_drop_subscription_state(const std::string& service_name,
                                     const protos::DropSubscriptionServiceState& update);
@@ -86,6 +89,17 @@ class Instance final : private resources::PartitionResourceBase, private Service
     std::multimap<std::string, std::shared_ptr<ISubscriptionServiceUpdater>> m_subscription_services;
     std::unique_ptr<mrc::runnable::Runner> m_update_handler;
 
+    // last applied membership of a subscribed role; delta updates are applied to it
+    struct RoleState
+    {
+        std::uint64_t nonce{0};
+        std::unordered_map<std::uint64_t, InstanceID> tagged_instances;
+        bool resync_requested{false};
+    };
+
+    // <<service_name, role>, state>
+    std::map<std::pair<std::string, std::string>, RoleState> m_role_states;
+
     friend network::Resources;
 };
 
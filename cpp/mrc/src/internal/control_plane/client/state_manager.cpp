@@ -34,6 +34,7 @@
 #include <rxcpp/rx.hpp>
 
 #include <exception>
+#include <string>
 #include <utility>
 
 namespace mrc::internal::control_plane::client {
@@ -64,8 +65,26 @@ void StateManager::update(const protos::StateUpdate&& update_msg)
 {
     if (m_nonce < update_msg.nonce())
     {
+        // a delta only applies to the version it was made against; request a snapshot once
+        if (update_msg.base_nonce() != 0 && update_msg.base_nonce() != m_nonce)
+        {
+            DVLOG(10) << "delta update of " << update_msg.service_name() << " for version " << update_msg.base_nonce()
+                      << " does not apply to version " << m_nonce << "; requesting snapshot";
+            if (!m_resync_requested)
+            {
+                m_resync_requested = true;
+                acknowledge(update_msg.service_name(), true);
+            }
+            return;
+        }
+
         m_nonce = update_msg.nonce();
+        if (update_msg.base_nonce() == 0)
+        {
+            m_resync_requested = false;
+        }
         do_update(std::move(update_msg));
+        acknowledge(update_msg.service_name(), false);
         std::lock_guard<decltype(m_mutex)> lock(m_mutex);
         for (auto& p : m_update_promises)
         {
@@ -75,6 +94,15 @@ void StateManager::update(const protos::StateUpdate&& update_msg)
     }
 }
 
+void StateManager::acknowledge(const std::string& service_name, bool resync)
+{
+    protos::AckStateUpdate ack;
+    ack.set_service_name(service_name);
+    ack.set_nonce(m_nonce);
+    ack.set_resync(resync);
+    client().issue_event(protos::ClientEventAckStateUpdate, std::move(ack));
+}
+
 const Client& StateManager::client() const
 {
     return m_client;
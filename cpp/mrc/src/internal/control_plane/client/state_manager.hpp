@@ -23,6 +23,7 @@
 #include <cstddef>
 #include <memory>
 #include <mutex>
+#include <string>
 #include <vector>
 
 namespace mrc::node {
@@ -80,6 +81,9 @@ class StateManager
     /**
      * @brief Triggers a do_update if the StateUpdate is more recent then the current state
      *
+     * A delta StateUpdate is only applied if it was made against the current state; otherwise it is dropped and a
+     * snapshot is requested from the server. Applied updates are acknowledged to the server.
+     *
      * If and only if the current state is updated will the set of awaiting promises be completed.
      *
      * @param update_msg
@@ -88,8 +92,12 @@ class StateManager
 
     virtual void do_update(const protos::StateUpdate&& update_msg) = 0;
 
+    // report the applied version to the server; resync requests a snapshot
+    void acknowledge(const std::string& service_name, bool resync);
+
     Client& m_client;
     std::size_t m_nonce{1};
+    bool m_resync_requested{false};
     mutable std::mutex m_mutex;
     std::vector<Promise<void>> m_update_promises;
     std::unique_ptr<mrc::runnable::Runner> m_runner;
@@ -35,7 +35,12 @@ Resources::Resources(resources::PartitionResourceBase& base) :
 {
     if (system().options().enable_server())
     {
-        m_server = std::make_unique<Server>(runnable());
+        const auto& options = system().options();
+        m_server            = std::make_unique<Server>(runnable(),
+                                                options.server_port(),
+                                                options.server_completion_queues(),
+                                                options.architect_peers(),
+                                                options.architect_priority());
         m_server->service_start();
         m_server->service_await_live();
     }
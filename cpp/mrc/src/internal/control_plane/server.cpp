@@ -17,7 +17,10 @@
 
 #include "internal/control_plane/server.hpp"
 
+#include "internal/control_plane/batched_event_writer.hpp"
 #include "internal/control_plane/proto_helpers.hpp"
+#include "internal/control_plane/server/client_instance.hpp"
+#include "internal/control_plane/server/replica_client.hpp"
 #include "internal/control_plane/server/subscription_manager.hpp"
 #include "internal/grpc/stream_writer.hpp"
 #include "internal/runnable/resources.hpp"
@@ -83,7 +86,53 @@ static Expected<> unary_response(Server::event_t& event, Expected<MessageT>&& me
     return {};
 }
 
-Server::Server(runnable::Resources& runnable) : m_runnable(runnable), m_server(m_runnable) {}
+// respond to a request awaited by the client with a NotLeader error; other events are dropped
+static Expected<> not_leader_response(Server::event_t& event)
+{
+    if (event.msg.tag() == 0)
+    {
+        return {};
+    }
+    mrc::protos::Event out;
+    out.set_tag(event.msg.tag());
+    out.set_event(protos::EventType::Response);
+    auto* error = out.mutable_error();
+    error->set_code(protos::ErrorCode::NotLeader);
+    error->set_message("architect is a standby replica; requests must be sent to the leader");
+    if (event.stream->await_write(std::move(out)) != channel::Status::success)
+    {
+        return Error::create("failed to write to channel");
+    }
+    return {};
+}
+
+// events which change the state replicated to the standby replicas
+static bool modifies_state(const protos::EventType& event_type)
+{
+    switch (event_type)
+    {
+    case protos::EventType::ClientEventRequestStateUpdate:
+    case protos::EventType::ClientEventAckStateUpdate:
+    case protos::EventType::ClientUnaryLookupWorkerAddresses:
+    case protos::EventType::ClientUnaryArchitectRole:
+    case protos::EventType::ReplicaEventSubscribe:
+        return false;
+    default:
+        return true;
+    }
+}
+
+Server::Server(runnable::Resources& runnable,
+               std::uint16_t port,
+               std::size_t cq_count,
+               std::vector<std::string> peers,
+               std::uint32_t priority) :
+  m_runnable(runnable),
+  m_server(m_runnable, port, cq_count),
+  m_peers(std::move(peers)),
+  m_priority(priority),
+  m_is_leader(m_peers.empty())
+{}
 
 Server::~Server() = default;
 
@@ -133,6 +182,13 @@ void Server::do_service_start()
     // start the acceptor - this should be one of the last runnables launch
     // once this goes live, connections will be accepted and data/events can be coming in
     m_stream_acceptor = m_runnable.launch_control().prepare_launcher(std::move(acceptor))->ignition();
+
+    // a standby replicates the state of the leader among its peers until it is promoted
+    if (!m_is_leader)
+    {
+        m_replicator_running = true;
+        m_replicator         = m_runnable.main().enqueue([this] { do_replicate(); });
+    }
 }
 
 void Server::do_service_await_live()
@@ -151,6 +207,7 @@ void Server::do_service_stop()
     // shutdown the server and the cq immeditately.
     // this is future work, for now we will be hard killing the server which will be hard killing the streams, the
     // clients will not gracefully shutdown and enter a kill mode.
+    stop_replicator();
     m_stream_acceptor->stop();
     m_update_handler->stop();
     m_update_cv.notify_all();
@@ -162,6 +219,7 @@ void Server::do_service_kill()
 {
     // this is a hard stop, we are shutting everything down in the proper sequence to ensure clients get the kill
     // signal.
+    stop_replicator();
     m_stream_acceptor->kill();
     m_update_handler->kill();
     m_update_cv.notify_all();
@@ -204,16 +262,16 @@ void Server::do_service_await_join()
  */
 void Server::do_accept_stream(rxcpp::subscriber<stream_t>& s)
 {
-    auto cq = m_server.get_cq();
-
-    auto request_fn = [this, cq](grpc::ServerContext* context,
-                                 grpc::ServerAsyncReaderWriter<mrc::protos::Event, mrc::protos::Event>* stream,
-                                 void* tag) {
-        m_service->RequestEventStream(context, stream, cq.get(), cq.get(), tag);
-    };
-
     while (s.is_subscribed())
     {
+        // shard the streams across the completion queues of the server
+        auto cq         = m_server.get_cq();
+        auto request_fn = [this, cq](grpc::ServerContext* context,
+                                     grpc::ServerAsyncReaderWriter<mrc::protos::Event, mrc::protos::Event>* stream,
+                                     void* tag) {
+            m_service->RequestEventStream(context, stream, cq.get(), cq.get(), tag);
+        };
+
         // create stream
         auto stream = std::make_shared<typename stream_t::element_type>(request_fn, m_runnable);
 
@@ -244,18 +302,49 @@ void Server::do_handle_event(event_t&& event)
 {
     DCHECK(event.stream);
 
+    // events of a batch are handled in order as if each was received on its own
+    if (event.ok && event.msg.event() == protos::EventType::Batch)
+    {
+        for (auto& msg : BatchedEventWriter::unbatch(std::move(event.msg)))
+        {
+            do_handle_event({std::move(msg), event.stream, true});
+        }
+        return;
+    }
+
+    // respond through the batched writer of the stream, so responses are ordered with the held events
+    {
+        std::lock_guard<decltype(m_mutex)> lock(m_mutex);
+        if (auto writer = m_connections.writer(event.stream->get_id()))
+        {
+            event.stream = std::move(writer);
+        }
+    }
+
     try
     {
-        if (event.ok)
+        if (event.ok && !is_leader() && modifies_state(event.msg.event()))
+        {
+            auto status = not_leader_response(event);
+            MRC_THROW_ON_ERROR(status);
+            std::lock_guard<decltype(m_mutex)> lock(m_mutex);
+            m_connections.flush_writers();
+        }
+        else if (event.ok)
         {
             Expected<> status;
             switch (event.msg.event())
             {
             case protos::EventType::ClientEventRequestStateUpdate:
                 DVLOG(10) << "client requested a server update";
-                // todo: add a backoff so if a bunch of clients issue update requests
-                // we don't just keep firing them server side
-                m_update_cv.notify_one();
+                {
+                    std::lock_guard<decltype(m_mutex)> lock(m_mutex);
+                    request_update();
+                }
+                break;
+
+            case protos::EventType::ClientEventAckStateUpdate:
+                status = event_ack_state_update(event);
                 break;
 
             case protos::EventType::ClientUnaryRegisterWorkers:
@@ -294,6 +383,18 @@ void Server::do_handle_event(event_t&& event)
                 status = event_update_subscription_service(event);
                 break;
 
+            case protos::EventType::ClientUnaryReattachWorkers:
+                status = unary_reattach_workers(event);
+                break;
+
+            case protos::EventType::ClientUnaryArchitectRole:
+                status = unary_response(event, unary_architect_role(event));
+                break;
+
+            case protos::EventType::ReplicaEventSubscribe:
+                status = event_replica_subscribe(event);
+                break;
+
             default:
                 LOG(ERROR) << "unhandled event type in server handler";
                 throw Error::create("unhandled event type in server handler");
@@ -303,6 +404,14 @@ void Server::do_handle_event(event_t&& event)
             {
                 throw status.error();
             }
+
+            // events written while handling the event, e.g. drop updates of latched members, are written together
+            std::lock_guard<decltype(m_mutex)> lock(m_mutex);
+            if (m_is_leader && modifies_state(event.msg.event()))
+            {
+                replicate_state();
+            }
+            m_connections.flush_writers();
         }
         else
         {
@@ -331,18 +440,41 @@ void Server::do_handle_event(event_t&& event)
 void Server::do_issue_update(rxcpp::subscriber<void*>& s)
 {
     std::unique_lock<decltype(m_mutex)> lock(m_mutex);
+    auto last_update = std::chrono::steady_clock::now() - m_update_tick;
 
     for (;;)
     {
-        auto status = m_update_cv.wait_for(lock, m_update_period);
+        m_update_cv.wait_for(lock, m_update_period, [this, &s] { return m_update_requested || !s.is_subscribed(); });
+
+        // requests within a tick of the previous update are coalesced into a single update; the state is free to be
+        // modified by the event handler while the tick elapses
+        if (m_update_requested)
+        {
+            m_update_cv.wait_until(lock, last_update + m_update_tick, [&s] { return !s.is_subscribed(); });
+        }
         if (!s.is_subscribed())
         {
             s.on_completed();
             return;
         }
+        m_update_requested = false;
+        last_update        = std::chrono::steady_clock::now();
+
+        // a standby issues no updates; its state is replicated from the leader
+        if (!m_is_leader)
+        {
+            continue;
+        }
 
         DVLOG(10) << "starting - control plane update";
 
+        // restored instances which were not reattached by their clients are dropped
+        if (m_connections.has_detached_instances() &&
+            std::chrono::steady_clock::now() - m_promoted_at >= m_reattach_timeout)
+        {
+            drop_detached_instances();
+        }
+
         // issue worker updates
         m_connections.issue_update();
 
@@ -352,10 +484,19 @@ void Server::do_issue_update(rxcpp::subscriber<void*>& s)
             service->issue_update();
         }
 
+        // write the updates issued to each stream as a single batch
+        m_connections.flush_writers();
+
         DVLOG(10) << "finished - control plane update";
     }
 }
 
+void Server::request_update()
+{
+    m_update_requested = true;
+    m_update_cv.notify_one();
+}
+
 void Server::on_fatal_exception()
 {
     LOG(FATAL) << "fatal error on the control plane server was caught; signal all attached instances to shutdown "
@@ -577,7 +718,237 @@ Expected<> Server::event_update_subscription_service(event_t& event)
     MRC_EXPECT(service_iter);
     auto& service = *(service_iter.value()->second);
 
-    return service.update_role(*req);
+    auto status = service.update_role(*req);
+    MRC_EXPECT(status);
+
+    // a client which failed to apply a delta should not wait on the update period for its snapshot
+    if (req->resync())
+    {
+        request_update();
+    }
+    return {};
+}
+
+Expected<> Server::event_ack_state_update(event_t& event)
+{
+    auto ack = unpack_request<protos::AckStateUpdate>(event);
+    MRC_EXPECT(ack);
+
+    std::lock_guard<decltype(m_mutex)> lock(m_mutex);
+    MRC_CHECK(ack->service_name() == m_connections.service_name());
+    m_connections.acknowledge_update(event.stream->get_id(), *ack);
+
+    if (ack->resync())
+    {
+        request_update();
+    }
+    return {};
+}
+
+Expected<> Server::unary_reattach_workers(event_t& event)
+{
+    auto req = unpack_request<protos::ReattachWorkersRequest>(event);
+    MRC_EXPECT(req);
+
+    DVLOG(10) << "reattaching " << req->workers_size() << " instances of machine " << req->machine_id()
+              << " to stream " << event.stream->get_id();
+    std::lock_guard<decltype(m_mutex)> lock(m_mutex);
+    auto status = unary_response(event, m_connections.reattach_instances(event.stream, *req));
+
+    // the reattached instances receive a snapshot of each state with the next update
+    request_update();
+    return status;
+}
+
+Expected<protos::ArchitectRole> Server::unary_architect_role(event_t& event)
+{
+    std::lock_guard<decltype(m_mutex)> lock(m_mutex);
+    protos::ArchitectRole role;
+    role.set_leader(m_is_leader);
+    role.set_term(m_term);
+    role.set_priority(m_priority);
+    return role;
+}
+
+Expected<> Server::event_replica_subscribe(event_t& event)
+{
+    std::lock_guard<decltype(m_mutex)> lock(m_mutex);
+    if (!m_is_leader)
+    {
+        LOG(WARNING) << "standby architect received a replica subscription from stream " << event.stream->get_id();
+        return {};
+    }
+
+    DVLOG(10) << "stream " << event.stream->get_id() << " subscribed as a standby replica";
+    m_replica_streams.insert(event.stream->get_id());
+    replicate_state();
+    return {};
+}
+
+void Server::replicate_state()
+{
+    if (m_replica_streams.empty())
+    {
+        return;
+    }
+
+    protos::Event event;
+    event.set_event(protos::EventType::ServerReplicaState);
+    event.mutable_message()->PackFrom(snapshot_state());
+
+    for (const auto& stream_id : m_replica_streams)
+    {
+        if (auto writer = m_connections.writer(stream_id))
+        {
+            auto copy = event;
+            LOG_IF(WARNING, writer->await_write(std::move(copy)) != channel::Status::success)
+                << "failed to replicate state to standby stream: " << stream_id;
+        }
+    }
+}
+
+protos::ArchitectState Server::snapshot_state() const
+{
+    protos::ArchitectState state;
+    state.set_term(m_term);
+    m_connections.snapshot(state);
+    for (const auto& [name, service] : m_subscription_services)
+    {
+        service->snapshot(*state.add_subscription_services());
+    }
+    return state;
+}
+
+void Server::restore_state(const protos::ArchitectState& state)
+{
+    m_connections.restore(state);
+
+    auto get_instance = [this](const instance_id_t& instance_id) { return m_connections.get_instance(instance_id); };
+    for (const auto& service_state : state.subscription_services())
+    {
+        auto service = server::SubscriptionService::restore(service_state, state.term(), get_instance);
+        if (!service)
+        {
+            LOG(ERROR) << "failed to restore subscription service " << service_state.service_name() << ": "
+                       << service.error().message();
+            continue;
+        }
+        m_subscription_services[service_state.service_name()] = std::move(*service);
+    }
+}
+
+void Server::drop_detached_instances()
+{
+    for (const auto& instance_id : m_connections.drop_detached_instances())
+    {
+        LOG(WARNING) << "instance_id: " << instance_id << " was not reattached after the promotion; dropping";
+        for (auto& [service_name, service] : m_subscription_services)
+        {
+            service->release_instance(instance_id);
+        }
+    }
+    replicate_state();
+}
+
+void Server::do_replicate()
+{
+    while (m_replicator_running)
+    {
+        std::shared_ptr<server::ReplicaClient> leader;
+        bool outranked = false;
+
+        // query the role of each peer; follow the leader if there is one
+        for (const auto& url : m_peers)
+        {
+            auto peer = std::make_shared<server::ReplicaClient>(url, m_server.get_cq(), m_runnable);
+            auto role = peer->connect(m_replica_probe_timeout);
+            if (!role)
+            {
+                continue;
+            }
+            if (role->leader())
+            {
+                leader = std::move(peer);
+                break;
+            }
+            outranked |= (role->priority() < m_priority);
+        }
+
+        if (leader)
+        {
+            {
+                std::lock_guard<decltype(m_mutex)> lock(m_mutex);
+                if (!m_replicator_running)
+                {
+                    break;
+                }
+                m_leader_peer = leader;
+            }
+
+            LOG(INFO) << "standby architect replicating the state of leader: " << leader->url();
+            leader->subscribe([this](protos::ArchitectState&& state) {
+                std::lock_guard<decltype(m_mutex)> lock(m_mutex);
+                m_replicated_state = std::move(state);
+            });
+            leader->await_closed();
+
+            std::lock_guard<decltype(m_mutex)> lock(m_mutex);
+            m_leader_peer.reset();
+            LOG_IF(WARNING, m_replicator_running) << "lost the architect leader: " << leader->url();
+            continue;
+        }
+
+        // no peer is the leader and none of the reachable standby peers is promoted before this server
+        if (!outranked && m_replicator_running)
+        {
+            promote();
+            return;
+        }
+
+        std::unique_lock<decltype(m_mutex)> lock(m_mutex);
+        m_replica_cv.wait_for(lock, m_replica_probe_timeout, [this] { return !m_replicator_running; });
+    }
+}
+
+void Server::promote()
+{
+    std::lock_guard<decltype(m_mutex)> lock(m_mutex);
+
+    auto state = m_replicated_state.value_or(protos::ArchitectState{});
+    m_term     = state.term() + 1;
+    state.set_term(m_term);
+    restore_state(state);
+
+    m_replicated_state.reset();
+    m_is_leader   = true;
+    m_promoted_at = std::chrono::steady_clock::now();
+    LOG(INFO) << "architect promoted to leader of term " << m_term << "; awaiting " << state.instances_size()
+              << " instances to reattach";
+}
+
+void Server::stop_replicator()
+{
+    {
+        std::lock_guard<decltype(m_mutex)> lock(m_mutex);
+        m_replicator_running = false;
+        if (m_leader_peer)
+        {
+            m_leader_peer->close();
+        }
+    }
+    m_replica_cv.notify_all();
+
+    // the stream to the leader is progressed on a completion queue of the grpc server
+    if (m_replicator.valid())
+    {
+        m_replicator.get();
+    }
+}
+
+bool Server::is_leader() const
+{
+    std::lock_guard<decltype(m_mutex)> lock(m_mutex);
+    return m_is_leader;
 }
 
 void Server::drop_instance(const instance_id_t& instance_id)
@@ -610,6 +981,7 @@ void Server::drop_stream(const stream_id_t& stream_id)
     auto writer = search->second->writer();
 
     DVLOG(10) << "dropping stream with machine_id: " << stream_id;
+    m_replica_streams.erase(stream_id);
 
     // for each instance - iterate over state machines and drop the instance id
     for (const auto& instance_id : m_connections.get_instance_ids(stream_id))
@@ -622,6 +994,12 @@ void Server::drop_stream(const stream_id_t& stream_id)
     writer.reset();
 
     m_connections.drop_stream(stream_id);
+
+    if (m_is_leader)
+    {
+        replicate_state();
+        m_connections.flush_writers();
+    }
 }
 
 void Server::drop_all_streams()
@@ -25,19 +25,26 @@
 
 #include "mrc/node/queue.hpp"
 #include "mrc/protos/architect.grpc.pb.h"
+#include "mrc/types.hpp"
 
 #include <boost/fiber/condition_variable.hpp>
 #include <boost/fiber/mutex.hpp>
 #include <rxcpp/rx.hpp>
 
+#include <atomic>
 #include <chrono>
 #include <cstddef>
+#include <cstdint>
 #include <map>
 #include <memory>
+#include <optional>
+#include <set>
 #include <string>
+#include <vector>
 
 namespace mrc::internal::control_plane::server {
 class ClientInstance;
+class ReplicaClient;
 class SubscriptionService;
 }  // namespace mrc::internal::control_plane::server
 namespace mrc::internal::rpc {
@@ -49,6 +56,8 @@ class Resources;
 }  // namespace mrc::internal::runnable
 namespace mrc::protos {
 class Ack;
+class ArchitectRole;
+class ArchitectState;
 class Event;
 class RegisterSubscriptionServiceResponse;
 }  // namespace mrc::protos
@@ -71,6 +80,13 @@ namespace mrc::internal::control_plane {
  * as failed Expected. All top-level event handlers should return an Expected<Message> where message is the type of
  * message which will be returned to the client. The write methods will check the state of the Expected<Message> and
  * send back either the Message or an Error with the proper error code and error message.
+ *
+ * The server state can be replicated to standby servers configured with the other architects as peers. A standby
+ * follows the leader among its peers, receiving the state of the leader after each change, and responds to every
+ * client request with a NotLeader error. Once no peer is the leader and no reachable standby peer has a lower
+ * priority, the standby is promoted to the leader of the next term. The promoted leader restores the replicated
+ * instances as detached; clients of the previous leader reattach their instances and keep their instance_ids,
+ * subscription tags and machine_id. Priorities must be unique among the architects.
  */
 class Server : public Service
 {
@@ -82,9 +98,16 @@ class Server : public Service
     using stream_id_t   = std::size_t;
     using instance_id_t = std::size_t;
 
-    Server(runnable::Resources& runnable);
+    // client streams are sharded across cq_count completion queues, each progressed by a dedicated thread
+    Server(runnable::Resources& runnable,
+           std::uint16_t port             = 13337,
+           std::size_t cq_count           = 1,
+           std::vector<std::string> peers = {},
+           std::uint32_t priority         = 0);
     ~Server() override;
 
+    bool is_leader() const;
+
   private:
     void do_service_start() final;
     void do_service_stop() final;
@@ -96,6 +119,11 @@ class Server : public Service
     void do_handle_event(event_t&& event);
     void do_issue_update(rxcpp::subscriber<void*>& s);
 
+    // standby loop - follows the leader among the peers until this server is promoted
+    void do_replicate();
+    void promote();
+    void stop_replicator();
+
     // mrc resources
     runnable::Resources& m_runnable;
 
@@ -120,6 +148,28 @@ class Server : public Service
     boost::fibers::condition_variable m_update_cv;
     std::chrono::milliseconds m_update_period{30000};
 
+    // updates requested by clients are issued at most once per tick, so that a burst of requests, e.g. the members of
+    // a subscription service activating together, is issued as a single version
+    bool m_update_requested{false};
+    std::chrono::milliseconds m_update_tick{10};
+
+    // replication
+    const std::vector<std::string> m_peers;
+    const std::uint32_t m_priority;
+    bool m_is_leader;
+    std::uint64_t m_term{1};
+    std::optional<protos::ArchitectState> m_replicated_state;
+    std::set<stream_id_t> m_replica_streams;
+    std::shared_ptr<server::ReplicaClient> m_leader_peer;
+    std::atomic<bool> m_replicator_running{false};
+    Future<void> m_replicator;
+    boost::fibers::condition_variable m_replica_cv;
+    std::chrono::milliseconds m_replica_probe_timeout{1000};
+
+    // restored instances not reattached within the timeout after a promotion are dropped
+    std::chrono::steady_clock::time_point m_promoted_at;
+    std::chrono::milliseconds m_reattach_timeout{30000};
+
     // top-level event handlers - these methods lock internal state
     Expected<> unary_register_workers(event_t& event);
     Expected<> unary_activate_stream(event_t& event);
@@ -131,6 +181,19 @@ class Server : public Service
     Expected<protos::Ack> unary_activate_subscription_service(event_t& event);
     Expected<protos::Ack> unary_drop_subscription_service(event_t& event);
     Expected<> event_update_subscription_service(event_t& event);
+    Expected<> event_ack_state_update(event_t& event);
+    Expected<> unary_reattach_workers(event_t& event);
+    Expected<protos::ArchitectRole> unary_architect_role(event_t& event);
+    Expected<> event_replica_subscribe(event_t& event);
+
+    // write the state of the leader to the subscribed standby replicas
+    void replicate_state();
+    protos::ArchitectState snapshot_state() const;
+    void restore_state(const protos::ArchitectState& state);
+    void drop_detached_instances();
+
+    // wake the updater to issue an update with the next tick; m_mutex must be held
+    void request_update();
 
     void drop_instance(const instance_id_t& instance_id);
     void drop_stream(writer_t& writer);
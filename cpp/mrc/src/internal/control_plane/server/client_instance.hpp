@@ -22,6 +22,10 @@
 #include "mrc/protos/architect.pb.h"
 #include "mrc/utils/macros.hpp"
 
+#include <glog/logging.h>
+
+#include <cstdint>
+#include <memory>
 #include <string>
 
 namespace mrc::internal::control_plane::server {
@@ -32,34 +36,69 @@ class ClientInstance
     using instance_id_t = std::uint64_t;
     using writer_t      = std::shared_ptr<rpc::StreamWriter<mrc::protos::Event>>;
 
-    ClientInstance(writer_t writer, std::string worker_address) :
+    ClientInstance(writer_t writer, std::string worker_address, mrc::protos::WorkerLocality locality = {}) :
+      m_id(reinterpret_cast<instance_id_t>(this)),
+      m_machine_id(writer->get_id()),
       m_stream_writer(std::move(writer)),
-      m_worker_address(std::move(worker_address))
-    {
-        // CHECK(m_stream_writer);
-    }
+      m_worker_address(std::move(worker_address)),
+      m_locality(std::move(locality))
+    {}
+
+    // instance restored from the state replicated by a previous leader; detached until its client reattaches
+    ClientInstance(const mrc::protos::WorkerAddress& worker) :
+      m_id(worker.instance_id()),
+      m_machine_id(worker.machine_id()),
+      m_worker_address(worker.worker_address()),
+      m_locality(worker.locality())
+    {}
 
     DELETE_MOVEABILITY(ClientInstance);
     DELETE_COPYABILITY(ClientInstance);
 
     instance_id_t get_id() const
     {
-        return reinterpret_cast<instance_id_t>(this);
+        return m_id;
+    }
+
+    // machine_id issued on registration; retained across a reattach to the stream of a new leader
+    instance_id_t machine_id() const
+    {
+        return m_machine_id;
     }
 
     rpc::StreamWriter<mrc::protos::Event>& stream_writer() const
     {
+        CHECK(m_stream_writer);
         return *m_stream_writer;
     }
 
+    bool is_attached() const
+    {
+        return static_cast<bool>(m_stream_writer);
+    }
+
+    void attach(writer_t writer)
+    {
+        CHECK(!m_stream_writer);
+        m_stream_writer = std::move(writer);
+    }
+
     const std::string& worker_address() const
     {
         return m_worker_address;
     }
 
+    const mrc::protos::WorkerLocality& locality() const
+    {
+        return m_locality;
+    }
+
   private:
-    const std::shared_ptr<rpc::StreamWriter<mrc::protos::Event>> m_stream_writer;
+    const instance_id_t m_id;
+    const instance_id_t m_machine_id;
+    std::shared_ptr<rpc::StreamWriter<mrc::protos::Event>> m_stream_writer;
     const std::string m_worker_address;
+    const mrc::protos::WorkerLocality m_locality;
 };
 
 }  // namespace mrc::internal::control_plane::server
@@ -43,6 +43,27 @@ void ConnectionManager::add_stream(const stream_t& stream)
         LOG(FATAL) << "non-unique stream registration detected";
     }
     m_streams[stream->get_id()] = stream;
+    m_writers[stream->get_id()] = std::make_shared<BatchedEventWriter>(stream->writer());
+}
+
+ConnectionManager::writer_t ConnectionManager::writer(const stream_id_t& stream_id) const
+{
+    auto search = m_writers.find(stream_id);
+    if (search == m_writers.end())
+    {
+        return nullptr;
+    }
+    return search->second;
+}
+
+void ConnectionManager::flush_writers()
+{
+    for (auto& [stream_id, writer] : m_writers)
+    {
+        auto status = writer->flush();
+        LOG_IF(WARNING, status != channel::Status::success)
+            << "failed to flush events to stream/machine_id: " << stream_id;
+    }
 }
 
 void ConnectionManager::drop_stream(const stream_id_t& stream_id) noexcept
@@ -63,15 +84,22 @@ void ConnectionManager::drop_stream(const stream_id_t& stream_id) noexcept
         DVLOG(10) << "dropping instance_id: " << i->second;
         DCHECK(contains(m_instances, i->second));
         m_instances.erase(i->second);
+        record_removed(stream_id, i->second);
     }
     m_instances_by_stream.erase(stream_id);
+    m_machine_ids.erase(stream_id);
+    drop_client(stream_id);
 
-    // issue finish and await the stream
-    auto writer = stream->second->writer();
-    if (writer)
+    // issue finish and await the stream; finishing the batched writer flushes its held events
+    auto batched = m_writers.find(stream_id);
+    if (batched != m_writers.end())
+    {
+        batched->second->finish();
+        m_writers.erase(batched);
+    }
+    else if (auto writer = stream->second->writer())
     {
         writer->finish();
-        writer.reset();
     }
     stream->second->await_fini();
 
@@ -127,10 +155,13 @@ Expected<protos::RegisterWorkersResponse> ConnectionManager::register_instances(
     protos::RegisterWorkersResponse response;
     response.set_machine_id(stream_id);
 
-    for (const auto& worker_address : req.ucx_worker_addresses())
+    for (int i = 0; i < req.ucx_worker_addresses_size(); i++)
     {
-        // create server-side client instances which hold the worker address and stream writer
-        auto instance = std::make_shared<server::ClientInstance>(writer, worker_address);
+        const auto& worker_address = req.ucx_worker_addresses(i);
+
+        // create server-side client instances which hold the worker address, its locality and stream writer
+        auto locality = (i < req.localities_size() ? req.localities(i) : protos::WorkerLocality{});
+        auto instance = std::make_shared<server::ClientInstance>(writer, worker_address, std::move(locality));
 
         if (contains(m_instances, instance->get_id()))  // todo(cpp20) contains and unlikely
         {
@@ -164,6 +195,7 @@ Expected<protos::Ack> ConnectionManager::drop_instance(const writer_t& writer, c
         if (i->second == req.instance_id())
         {
             m_instances_by_stream.erase(i);
+            record_removed(stream_id, req.instance_id());
             break;
         }
     }
@@ -183,10 +215,130 @@ Expected<protos::Ack> ConnectionManager::activate_stream(const writer_t& writer,
     for (const auto& instance_id : message.instance_ids())
     {
         m_instances_by_stream.insert(std::pair{stream_id, instance_id});
+        record_added(stream_id, instance_id);
     }
+    mark_as_modified();
     return {};
 }
 
+Expected<protos::RegisterWorkersResponse> ConnectionManager::reattach_instances(
+    const writer_t& writer, const protos::ReattachWorkersRequest& req)
+{
+    const auto stream_id = writer->get_id();
+
+    if (m_instances_by_stream.contains(stream_id))
+    {
+        return Error::create(MRC_CONCAT_STR("failed to reattach instances on immutable stream "
+                                            << stream_id << "; streams are immutable after first registration"));
+    }
+
+    // validate the request before updating state
+    for (const auto& worker : req.workers())
+    {
+        auto search = m_instances.find(worker.instance_id());
+        if (search != m_instances.end())
+        {
+            if (search->second->is_attached() || search->second->worker_address() != worker.worker_address())
+            {
+                return Error::create(MRC_CONCAT_STR("unable to reattach instance_id: "
+                                                    << worker.instance_id()
+                                                    << "; instance is attached to another stream or its worker "
+                                                       "address does not match"));
+            }
+        }
+        else if (contains(m_ucx_worker_addresses, worker.worker_address()))
+        {
+            return Error::create("invalid ucx worker address(es) - duplicate registration(s) detected");
+        }
+    }
+
+    protos::RegisterWorkersResponse response;
+    response.set_machine_id(req.machine_id());
+    m_machine_ids[stream_id] = req.machine_id();
+
+    for (const auto& worker : req.workers())
+    {
+        auto& instance = m_instances[worker.instance_id()];
+        if (!instance)
+        {
+            // registered with the previous leader after its last replicated state
+            instance = std::make_shared<server::ClientInstance>(worker);
+            m_ucx_worker_addresses.insert(worker.worker_address());
+        }
+
+        DVLOG(10) << "reattached instance_id: " << worker.instance_id() << " to stream_id: " << stream_id;
+        instance->attach(writer);
+        m_detached.erase(worker.instance_id());
+        m_instances_by_stream.insert(std::pair{stream_id, worker.instance_id()});
+        record_added(stream_id, worker.instance_id());
+        response.add_instance_ids(worker.instance_id());
+    }
+
+    mark_as_modified();
+    return response;
+}
+
+void ConnectionManager::snapshot(protos::ArchitectState& state) const
+{
+    auto add_instance = [&state](const instance_t& instance) {
+        auto* worker = state.add_instances();
+        worker->set_instance_id(instance->get_id());
+        worker->set_machine_id(instance->machine_id());
+        worker->set_worker_address(instance->worker_address());
+        *worker->mutable_locality() = instance->locality();
+    };
+
+    for (const auto& [stream_id, instance_id] : m_instances_by_stream)
+    {
+        add_instance(m_instances.at(instance_id));
+    }
+    for (const auto& instance_id : m_detached)
+    {
+        add_instance(m_instances.at(instance_id));
+    }
+}
+
+void ConnectionManager::restore(const protos::ArchitectState& state)
+{
+    for (const auto& worker : state.instances())
+    {
+        DVLOG(10) << "restoring detached instance_id: " << worker.instance_id();
+        m_ucx_worker_addresses.insert(worker.worker_address());
+        m_instances[worker.instance_id()] = std::make_shared<server::ClientInstance>(worker);
+        m_detached.insert(worker.instance_id());
+    }
+    begin_term(state.term());
+}
+
+bool ConnectionManager::has_detached_instances() const
+{
+    return !m_detached.empty();
+}
+
+std::vector<ConnectionManager::instance_id_t> ConnectionManager::drop_detached_instances()
+{
+    std::vector<instance_id_t> ids(m_detached.begin(), m_detached.end());
+    for (const auto& instance_id : ids)
+    {
+        DVLOG(10) << "dropping detached instance_id: " << instance_id;
+        m_ucx_worker_addresses.erase(m_instances.at(instance_id)->worker_address());
+        m_instances.erase(instance_id);
+    }
+    m_detached.clear();
+
+    if (!ids.empty())
+    {
+        mark_as_modified();
+    }
+    return ids;
+}
+
+MachineID ConnectionManager::machine_id(const stream_id_t& stream_id) const
+{
+    auto search = m_machine_ids.find(stream_id);
+    return (search == m_machine_ids.end()) ? stream_id : search->second;
+}
+
 Expected<protos::LookupWorkersResponse> ConnectionManager::lookup_workers(const writer_t& writer,
                                                                           const protos::LookupWorkersRequest& req) const
 {
@@ -198,8 +350,9 @@ Expected<protos::LookupWorkersResponse> ConnectionManager::lookup_workers(const
         {
             auto* worker = resp.add_worker_addresses();
             worker->set_instance_id(id);
-            worker->set_machine_id(instance.value()->stream_writer().get_id());
+            worker->set_machine_id(instance.value()->machine_id());
             worker->set_worker_address(instance.value()->worker_address());
+            *worker->mutable_locality() = instance.value()->locality();
         }
         else
         {
@@ -217,27 +370,86 @@ bool ConnectionManager::has_update() const
 void ConnectionManager::do_make_update(protos::StateUpdate& update) const
 {
     auto* connections = update.mutable_connections();
-    for (const auto& [machine_id, instance_id] : m_instances_by_stream)
+    for (const auto& [stream_id, instance_id] : m_instances_by_stream)
     {
         auto* msg = connections->add_tagged_instances();
         msg->set_instance_id(instance_id);
+        msg->set_tag(machine_id(stream_id));
+    }
+}
+
+void ConnectionManager::do_make_delta(protos::StateUpdate& update) const
+{
+    auto* connections = update.mutable_connections();
+    for (const auto& [instance_id, machine_id] : m_added)
+    {
+        auto* msg = connections->add_tagged_instances();
+        msg->set_instance_id(instance_id);
+        msg->set_tag(machine_id);
+    }
+    for (const auto& [instance_id, machine_id] : m_removed)
+    {
+        auto* msg = connections->add_removed_tagged_instances();
+        msg->set_instance_id(instance_id);
         msg->set_tag(machine_id);
     }
 }
 
-void ConnectionManager::do_issue_update(const protos::StateUpdate& update)
+void ConnectionManager::clear_delta()
+{
+    m_added.clear();
+    m_removed.clear();
+}
+
+void ConnectionManager::record_added(const stream_id_t& stream_id, const instance_id_t& instance_id)
+{
+    m_added[instance_id] = machine_id(stream_id);
+}
+
+void ConnectionManager::record_removed(const stream_id_t& stream_id, const instance_id_t& instance_id)
+{
+    // an instance activated and removed within the same version never reached the clients
+    if (m_added.erase(instance_id) == 0)
+    {
+        m_removed[instance_id] = machine_id(stream_id);
+    }
+}
+
+void ConnectionManager::acknowledge_update(const stream_id_t& stream_id, const protos::AckStateUpdate& ack)
 {
-    protos::Event event;
-    event.set_event(protos::EventType::ServerStateUpdate);
-    event.set_tag(0);  // explicit broadcast to all partitions
-    event.mutable_message()->PackFrom(update);
+    DVLOG(10) << "stream/machine_id: " << stream_id << " applied connections update " << ack.nonce();
+    if (ack.resync())
+    {
+        DVLOG(10) << "stream/machine_id: " << stream_id << " requested a connections snapshot";
+        request_snapshot(stream_id);
+    }
+}
 
-    for (const auto& [stream_id, stream] : m_streams)
+void ConnectionManager::do_issue_update(const std::optional<protos::StateUpdate>& delta)
+{
+    // events are packed once and shared by all streams; the snapshot is only built if a stream requires it
+    std::optional<protos::Event> delta_event;
+    std::optional<protos::Event> snapshot_event;
+    auto make_event = [](const protos::StateUpdate& update) {
+        protos::Event event;
+        event.set_event(protos::EventType::ServerStateUpdate);
+        event.set_tag(0);  // explicit broadcast to all partitions
+        event.mutable_message()->PackFrom(update);
+        return event;
+    };
+
+    for (const auto& [stream_id, writer] : m_writers)
     {
-        auto writer = stream->writer();
-        if (writer)
+        if (!writer->expired())
         {
-            auto status = writer->await_write(event);
+            const auto* update = select_update(stream_id, delta);
+            auto& event        = (update != nullptr) ? delta_event : snapshot_event;
+            if (!event)
+            {
+                event = make_event((update != nullptr) ? *update : make_update());
+            }
+
+            auto status = writer->await_write(*event);
             LOG_IF(WARNING, status != channel::Status::success)
                 << "failed to issue connections update to stream/machine_id: " << stream_id;
         }
@@ -17,6 +17,7 @@
 
 #pragma once
 
+#include "internal/control_plane/batched_event_writer.hpp"
 #include "internal/control_plane/server/versioned_issuer.hpp"
 #include "internal/expected.hpp"
 #include "internal/grpc/server_streaming.hpp"
@@ -26,6 +27,7 @@
 #include <cstddef>
 #include <map>
 #include <memory>
+#include <optional>
 #include <set>
 #include <string>
 #include <vector>
@@ -36,9 +38,12 @@ struct StreamWriter;
 }  // namespace mrc::internal::rpc
 namespace mrc::protos {
 class Ack;
+class AckStateUpdate;
+class ArchitectState;
 class Event;
 class LookupWorkersRequest;
 class LookupWorkersResponse;
+class ReattachWorkersRequest;
 class RegisterWorkersRequest;
 class RegisterWorkersResponse;
 class StateUpdate;
@@ -58,15 +63,22 @@ class ClientInstance;
  *
  * The ConnectionManager is a VersionedState. When requested, ConnectionManager will issue a single
  * protos::ServerUpdate to all connected stream with the protos::Event::tag() value set to 0, which means that update
- * message will be broadcast to all partition subscribers on the client.
+ * message will be broadcast to all partition subscribers on the client. Streams which hold the previous version
+ * receive only the instances added and removed since, all others the full list.
  *
  * The ServerUpdate event will be composed of a protos::ServerUpdateConnections which is a list of TaggedInstances,
  * where the tag is the stream_id (unique machine_id).
  *
+ * Events written to a stream through writer() are coalesced until the next flush_writers().
+ *
  * The protos::ServerUpdateConnections will not send the UCX worker addresses. It is up to the client to determine the
  * set of UCX worker addresses missing from its local registar and issue an unary rpc to fetch worker addresses request
  * to the control plane.
  *
+ * For replication, the activated instances are captured by snapshot(). A standby which is promoted to leader restores
+ * them as detached instances; each client of the previous leader reattaches its instances to its new stream, keeping
+ * their instance_ids and machine_id. Instances which are not reattached are dropped by drop_detached_instances().
+ *
  * @note This object is not thread-safe. It is assumed the owner of this object will properly control exclusive access.
  */
 class ConnectionManager : public VersionedState
@@ -86,6 +98,12 @@ class ConnectionManager : public VersionedState
 
     const std::map<stream_id_t, stream_t>& streams() const;
 
+    // batched writer of stream_id; nullptr if the stream is not registered
+    writer_t writer(const stream_id_t& stream_id) const;
+
+    // write the events held by the batched writers of all streams
+    void flush_writers();
+
     Expected<instance_t> get_instance(const instance_id_t& instance_id) const;
 
     std::vector<instance_id_t> get_instance_ids(const stream_id_t& stream_id) const;
@@ -100,24 +118,62 @@ class ConnectionManager : public VersionedState
 
     Expected<protos::Ack> drop_instance(const writer_t& writer, const protos::TaggedInstance& req);
 
+    // reattach the instances registered with a previous leader to the stream of writer
+    Expected<protos::RegisterWorkersResponse> reattach_instances(const writer_t& writer,
+                                                                 const protos::ReattachWorkersRequest& req);
+
+    // add the activated and detached instances to the replicated state
+    void snapshot(protos::ArchitectState& state) const;
+
+    // restore the instances of the replicated state as detached instances
+    void restore(const protos::ArchitectState& state);
+
+    bool has_detached_instances() const;
+
+    // drop the restored instances which were not reattached; returns their instance_ids
+    std::vector<instance_id_t> drop_detached_instances();
+
+    // the client of stream_id applied version nonce, or requested a snapshot if a delta did not apply
+    void acknowledge_update(const stream_id_t& stream_id, const protos::AckStateUpdate& ack);
+
     const std::string& service_name() const final;
 
   protected:
   private:
     bool has_update() const final;
     void do_make_update(protos::StateUpdate& update) const final;
-    void do_issue_update(const protos::StateUpdate& update) final;
+    void do_make_delta(protos::StateUpdate& update) const final;
+    void clear_delta() final;
+    void do_issue_update(const std::optional<protos::StateUpdate>& delta) final;
+
+    // machine_id of the instances of stream_id; the stream_id unless the instances were reattached
+    MachineID machine_id(const stream_id_t& stream_id) const;
+
+    // record the change of an activated instance for the next delta
+    void record_added(const stream_id_t& stream_id, const instance_id_t& instance_id);
+    void record_removed(const stream_id_t& stream_id, const instance_id_t& instance_id);
 
     MachineID m_machine_id;
     std::vector<InstanceID> m_instance_ids;
 
     // populated on registration
     std::map<stream_id_t, stream_t> m_streams;
+    std::map<stream_id_t, std::shared_ptr<BatchedEventWriter>> m_writers;
     std::map<instance_id_t, instance_t> m_instances;
     std::set<std::string> m_ucx_worker_addresses;
 
     // populated on activation - updates issued from this map
     std::multimap<stream_id_t, instance_id_t> m_instances_by_stream;
+
+    // <stream_id, machine_id> - machine_ids retained by reattached streams
+    std::map<stream_id_t, MachineID> m_machine_ids;
+
+    // restored instances not yet reattached to a stream
+    std::set<instance_id_t> m_detached;
+
+    // <instance_id, machine_id> - changes of m_instances_by_stream since the last issued update
+    std::map<instance_id_t, stream_id_t> m_added;
+    std::map<instance_id_t, stream_id_t> m_removed;
 };
 
 }  // namespace mrc::internal::control_plane::server
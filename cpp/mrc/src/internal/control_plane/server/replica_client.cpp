@@ -0,0 +1,180 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "internal/control_plane/server/replica_client.hpp"
+
+#include "internal/control_plane/batched_event_writer.hpp"
+#include "internal/grpc/channel.hpp"
+#include "internal/runnable/resources.hpp"
+
+#include "mrc/channel/status.hpp"
+#include "mrc/core/completion.hpp"
+#include "mrc/node/rx_sink.hpp"
+#include "mrc/runnable/launch_control.hpp"
+#include "mrc/runnable/launcher.hpp"
+#include "mrc/runnable/runner.hpp"
+
+#include <glog/logging.h>
+#include <google/protobuf/any.pb.h>
+#include <grpcpp/create_channel.h>
+#include <grpcpp/security/credentials.h>
+
+#include <cstdint>
+#include <utility>
+
+namespace mrc::internal::control_plane::server {
+
+ReplicaClient::ReplicaClient(std::string url,
+                             std::shared_ptr<grpc::CompletionQueue> cq,
+                             runnable::Resources& runnable) :
+  m_url(std::move(url)),
+  m_cq(std::move(cq)),
+  m_runnable(runnable)
+{
+    CHECK(m_cq);
+}
+
+ReplicaClient::~ReplicaClient()
+{
+    close();
+    await_closed();
+}
+
+std::optional<protos::ArchitectRole> ReplicaClient::connect(std::chrono::milliseconds timeout)
+{
+    CHECK(!m_stream);
+
+    m_channel = grpc::CreateChannel(m_url, grpc::InsecureChannelCredentials());
+    if (!rpc::await_connected(*m_channel, *m_cq, timeout))
+    {
+        DVLOG(10) << "architect peer " << m_url << " is not reachable";
+        return std::nullopt;
+    }
+    m_stub = protos::Architect::NewStub(m_channel);
+
+    auto prepare_fn = [this](grpc::ClientContext* context) {
+        return m_stub->PrepareAsyncEventStream(context, m_cq.get());
+    };
+
+    auto handler =
+        std::make_unique<mrc::node::RxSink<event_t>>([this](event_t event) { handle_event(std::move(event)); });
+
+    m_stream = std::make_shared<stream_t::element_type>(prepare_fn, m_runnable);
+    m_stream->attach_to(*handler);
+    m_event_handler = m_runnable.launch_control().prepare_launcher(std::move(handler))->ignition();
+
+    m_writer = m_stream->await_init();
+    if (!m_writer)
+    {
+        DVLOG(10) << "failed to initialize the stream to architect peer " << m_url;
+        return std::nullopt;
+    }
+
+    // the response is matched by the tag of the request
+    protos::Event request;
+    request.set_event(protos::EventType::ClientUnaryArchitectRole);
+    request.set_tag(reinterpret_cast<std::uint64_t>(&m_role));
+    CHECK(request.mutable_message()->PackFrom(protos::Ack{}));
+    if (m_writer->await_write(std::move(request)) != channel::Status::success ||
+        !m_role.wait_for(timeout))
+    {
+        DVLOG(10) << "architect peer " << m_url << " did not respond to a role request";
+        return std::nullopt;
+    }
+
+    protos::ArchitectRole role;
+    const auto& response = m_role.value();
+    if (!response.has_message() || !response.message().UnpackTo(&role))
+    {
+        LOG(WARNING) << "architect peer " << m_url << " responded to a role request with an invalid message";
+        return std::nullopt;
+    }
+    return role;
+}
+
+void ReplicaClient::subscribe(state_fn_t on_state)
+{
+    CHECK(m_writer);
+    m_on_state = std::move(on_state);
+
+    protos::Event request;
+    request.set_event(protos::EventType::ReplicaEventSubscribe);
+    m_writer->await_write(std::move(request));
+}
+
+void ReplicaClient::await_closed()
+{
+    if (m_event_handler)
+    {
+        m_event_handler->await_join();
+        m_event_handler.reset();
+    }
+    if (m_stream)
+    {
+        m_stream->await_fini();
+        m_stream.reset();
+    }
+}
+
+void ReplicaClient::close()
+{
+    if (m_writer)
+    {
+        m_writer->cancel();
+        m_writer.reset();
+    }
+}
+
+const std::string& ReplicaClient::url() const
+{
+    return m_url;
+}
+
+void ReplicaClient::handle_event(event_t&& event)
+{
+    switch (event.msg.event())
+    {
+    case protos::EventType::Batch:
+        for (auto& msg : BatchedEventWriter::unbatch(std::move(event.msg)))
+        {
+            handle_event({std::move(msg), event.stream});
+        }
+        break;
+
+    case protos::EventType::Response:
+        if (event.msg.tag() == reinterpret_cast<std::uint64_t>(&m_role) && !m_role.is_ready())
+        {
+            m_role.complete(std::move(event.msg));
+        }
+        break;
+
+    case protos::EventType::ServerReplicaState: {
+        protos::ArchitectState state;
+        if (m_on_state && event.msg.has_message() && event.msg.message().UnpackTo(&state))
+        {
+            m_on_state(std::move(state));
+        }
+    }
+    break;
+
+    default:
+        // state updates issued to every stream of the leader are not relevant to a standby
+        break;
+    }
+}
+
+}  // namespace mrc::internal::control_plane::server
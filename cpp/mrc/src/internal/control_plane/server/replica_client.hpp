@@ -0,0 +1,97 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "internal/grpc/client_streaming.hpp"
+#include "internal/grpc/stream_writer.hpp"
+
+#include "mrc/core/completion.hpp"
+#include "mrc/protos/architect.grpc.pb.h"
+#include "mrc/protos/architect.pb.h"
+#include "mrc/types.hpp"
+
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <string>
+
+namespace grpc {
+class Channel;
+class CompletionQueue;
+}  // namespace grpc
+namespace mrc::internal::runnable {
+class Resources;
+}  // namespace mrc::internal::runnable
+namespace mrc::runnable {
+class Runner;
+}  // namespace mrc::runnable
+
+namespace mrc::internal::control_plane::server {
+
+/**
+ * @brief Stream of a standby architect to one of its peers
+ *
+ * The standby queries the role of the peer on connect. If the peer is the leader, the standby subscribes to the state
+ * the leader replicates after each change until the stream is closed, either by the loss of the leader or by close().
+ *
+ * The grpc calls of the stream are progressed on cq, which must be progressed by a ProgressEngine.
+ */
+class ReplicaClient final
+{
+  public:
+    using stream_t   = std::shared_ptr<rpc::ClientStream<mrc::protos::Event, mrc::protos::Event>>;
+    using writer_t   = std::shared_ptr<rpc::StreamWriter<mrc::protos::Event>>;
+    using event_t    = stream_t::element_type::IncomingData;
+    using state_fn_t = std::function<void(mrc::protos::ArchitectState&&)>;
+
+    ReplicaClient(std::string url, std::shared_ptr<grpc::CompletionQueue> cq, runnable::Resources& runnable);
+    ~ReplicaClient();
+
+    // connect to the peer and query its role; nullopt if the peer is not reachable within timeout
+    std::optional<mrc::protos::ArchitectRole> connect(std::chrono::milliseconds timeout);
+
+    // request the state of the leader; on_state is called with each replicated state until the stream is closed
+    void subscribe(state_fn_t on_state);
+
+    // yield until the stream to the peer is closed
+    void await_closed();
+
+    // close the stream to the peer
+    void close();
+
+    const std::string& url() const;
+
+  private:
+    void handle_event(event_t&& event);
+
+    const std::string m_url;
+    std::shared_ptr<grpc::CompletionQueue> m_cq;
+    runnable::Resources& m_runnable;
+
+    std::shared_ptr<grpc::Channel> m_channel;
+    std::shared_ptr<mrc::protos::Architect::Stub> m_stub;
+    stream_t m_stream;
+    writer_t m_writer;
+    std::unique_ptr<mrc::runnable::Runner> m_event_handler;
+
+    Completion<mrc::protos::Event> m_role;
+    state_fn_t m_on_state;
+};
+
+}  // namespace mrc::internal::control_plane::server
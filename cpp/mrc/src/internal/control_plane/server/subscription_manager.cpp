@@ -17,6 +17,7 @@
 
 #include "internal/control_plane/server/subscription_manager.hpp"
 
+#include "internal/control_plane/proto_helpers.hpp"
 #include "internal/control_plane/server/client_instance.hpp"
 #include "internal/grpc/stream_writer.hpp"
 #include "internal/utils/contains.hpp"
@@ -28,7 +29,11 @@
 
 #include <algorithm>
 #include <cstdint>
+#include <limits>
+#include <optional>
 #include <ostream>
+#include <stdexcept>
+#include <vector>
 
 namespace mrc::internal::control_plane::server {
 
@@ -37,11 +42,18 @@ Role::Role(std::string service_name, std::string role_name) :
   m_role_name(std::move(role_name))
 {}
 
+Role::Role(std::string service_name, std::string role_name, std::uint64_t term) :
+  Role(std::move(service_name), std::move(role_name))
+{
+    begin_term(term);
+}
+
 void Role::add_member(std::uint64_t tag, std::shared_ptr<server::ClientInstance> instance)
 {
     DCHECK(!contains(m_members, tag));
     DVLOG(10) << "service: " << service_name() << "; role: " << role_name() << "; adding member with tag: " << tag;
-    m_members[tag] = instance;
+    m_members[tag]       = instance;
+    m_added_members[tag] = instance->get_id();
     mark_as_modified();
 }
 
@@ -58,12 +70,56 @@ void Role::add_subscriber(std::uint64_t tag, std::shared_ptr<server::ClientInsta
     // await_update(instance, update);
 }
 
+void Role::add_latched_member(std::uint64_t tag, std::shared_ptr<server::ClientInstance> instance)
+{
+    DCHECK(!contains(m_latched_members, tag));
+    m_latched_members[tag] = std::make_pair(current_nonce(), std::move(instance));
+}
+
+void Role::drop_latched_members(std::uint64_t instance_id)
+{
+    std::erase_if(m_latched_members, [&instance_id](const auto& t_ni) {
+        return t_ni.second.second->get_id() == instance_id;
+    });
+}
+
+void Role::snapshot(std::map<std::uint64_t, protos::SubscriptionServiceMember>& members) const
+{
+    for (const auto& [tag, instance] : m_members)
+    {
+        members[tag].set_role(m_role_name);
+    }
+    for (const auto& [tag, instance] : m_subscribers)
+    {
+        members[tag].add_subscribe_to_roles(m_role_name);
+    }
+    for (const auto& [tag, latched] : m_latched_members)
+    {
+        auto& member = members[tag];
+        member.set_tag(tag);
+        member.set_instance_id(latched.second->get_id());
+        member.set_role(m_role_name);
+        member.set_latched(true);
+    }
+}
+
 void Role::drop_tag(std::uint64_t tag)
 {
-    if (m_subscribers.erase(tag) != 0)
+    auto subscriber = m_subscribers.find(tag);
+    if (subscriber != m_subscribers.end())
     {
         DVLOG(10) << "service: " << service_name() << "; role: " << role_name()
                   << "; dropping subscriber with tag: " << tag;
+        const auto instance_id = subscriber->second->get_id();
+        m_subscribers.erase(subscriber);
+
+        // forget the version sent to the instance once it holds no subscribers
+        if (std::none_of(m_subscribers.begin(), m_subscribers.end(), [&instance_id](const auto& ti) {
+                return ti.second->get_id() == instance_id;
+            }))
+        {
+            drop_client(instance_id);
+        }
     }
     m_subscriber_nonces.erase(tag);
 
@@ -72,6 +128,10 @@ void Role::drop_tag(std::uint64_t tag)
     {
         mark_as_modified();
         m_latched_members[tag] = std::make_pair(current_nonce(), m_members.at(tag));
+        if (m_added_members.erase(tag) == 0)
+        {
+            m_removed_members[tag] = m_members.at(tag)->get_id();
+        }
         m_members.erase(tag);
         // note: the dropped tag instance is still "latched" to the service, i.e. no drop request from the server will
         // be issued until all subscribers have synchronized on the membership update
@@ -83,17 +143,48 @@ void Role::drop_tag(std::uint64_t tag)
 
 void Role::update_subscriber_nonce(const std::uint64_t& tag, const std::uint64_t& nonce)
 {
-    auto search = m_subscriber_nonces.find(tag);
-    if (search != m_subscriber_nonces.end())
+    update_subscriber_nonces({tag}, nonce);
+}
+
+void Role::update_subscriber_nonces(const std::vector<std::uint64_t>& tags, const std::uint64_t& nonce)
+{
+    for (const auto& tag : tags)
     {
-        DVLOG(10) << "updating subscriber with tag: " << tag << " with nonce: " << nonce;
-        search->second = nonce;
+        auto search = m_subscriber_nonces.find(tag);
+        if (search != m_subscriber_nonces.end())
+        {
+            DVLOG(10) << "updating subscriber with tag: " << tag << " with nonce: " << nonce;
+            search->second = nonce;
+        }
     }
     evaluate_latches();
 }
 
+void Role::resync_subscriber(const std::uint64_t& tag)
+{
+    auto search = m_subscribers.find(tag);
+    if (search != m_subscribers.end())
+    {
+        DVLOG(10) << "service: " << service_name() << "; role: " << role_name()
+                  << "; issuing snapshot to subscriber with tag: " << tag;
+        request_snapshot(search->second->get_id());
+    }
+}
+
 void Role::evaluate_latches()
 {
+    if (m_latched_members.empty())
+    {
+        return;
+    }
+
+    // the nonce every subscriber has reached; with no subscribers all latched tags can be dropped
+    auto min_subscriber_nonce = std::numeric_limits<std::uint64_t>::max();
+    for (const auto& [tag, nonce] : m_subscriber_nonces)
+    {
+        min_subscriber_nonce = std::min(min_subscriber_nonce, nonce);
+    }
+
     std::set<std::uint64_t> tags_to_remove;
     for (const auto& t_ni : m_latched_members)
     {
@@ -101,14 +192,17 @@ void Role::evaluate_latches()
         // t_ni => <tag, <nonce, instance>>
         // evalute the nonce of latched tagged instances against the current set of subscriber nonces, i.e. the
         // state of the subscribers
-        if (std::all_of(m_subscriber_nonces.begin(), m_subscriber_nonces.end(), [&nonce](const auto& tn) {
-                // tn => <tag, nonce>
-                return nonce <= tn.second;
-            }))
+        if (nonce <= min_subscriber_nonce)
         {
             const auto tag      = t_ni.first;
             const auto instance = t_ni.second.second;
 
+            // the drop request of a restored instance is issued once its client reattached
+            if (!instance->is_attached())
+            {
+                continue;
+            }
+
             // if the nonce of the latched tag is less than or equal to the nonces of all current subscribers,
             // then we can safely drop the latched instance
             DVLOG(10) << "issuing drop request for former member with tag: " << tag << "; nonce: " << nonce;
@@ -152,15 +246,54 @@ void Role::do_make_update(protos::StateUpdate& update) const
     }
 }
 
-void Role::do_issue_update(const protos::StateUpdate& update)
+void Role::do_make_delta(protos::StateUpdate& update) const
+{
+    auto* service = update.mutable_update_subscription_service();
+    service->set_role(m_role_name);
+    for (const auto& [tag, instance_id] : m_added_members)
+    {
+        auto* tagged_instance = service->add_tagged_instances();
+        tagged_instance->set_tag(tag);
+        tagged_instance->set_instance_id(instance_id);
+    }
+    for (const auto& [tag, instance_id] : m_removed_members)
+    {
+        auto* tagged_instance = service->add_removed_tagged_instances();
+        tagged_instance->set_tag(tag);
+        tagged_instance->set_instance_id(instance_id);
+    }
+}
+
+void Role::clear_delta()
+{
+    m_added_members.clear();
+    m_removed_members.clear();
+}
+
+void Role::do_issue_update(const std::optional<protos::StateUpdate>& delta)
 {
     DVLOG(10) << "issue_update for " << m_service_name << "/" << m_role_name;
+    std::optional<protos::StateUpdate> snapshot;
     std::set<std::uint64_t> unique_instances;
     for (const auto& [tag, instance] : m_subscribers)
     {
+        // a restored instance receives a snapshot once its client reattached
+        if (!instance->is_attached())
+        {
+            continue;
+        }
         if (!contains(unique_instances, instance->get_id()))
         {
-            await_update(instance, update);
+            const auto* update = select_update(instance->get_id(), delta);
+            if (update == nullptr)
+            {
+                if (!snapshot)
+                {
+                    snapshot = make_update();
+                }
+                update = &*snapshot;
+            }
+            await_update(instance, *update);
             unique_instances.insert(instance->get_id());
         }
     }
@@ -195,8 +328,108 @@ SubscriptionService::SubscriptionService(std::string name, std::set<std::string>
     DCHECK_EQ(roles.size(), m_roles.size());
 }
 
+SubscriptionService::SubscriptionService(const protos::SubscriptionServiceState& state, std::uint64_t term) :
+  TaggedIssuer(state.tag_base(), state.last_tag_uid()),
+  m_name(state.service_name())
+{
+    for (const auto& name : state.roles())
+    {
+        m_roles[name] = std::make_unique<Role>(m_name, name, term);
+    }
+}
+
 SubscriptionService::~SubscriptionService() = default;
 
+Expected<std::unique_ptr<SubscriptionService>> SubscriptionService::restore(
+    const protos::SubscriptionServiceState& state, std::uint64_t term, const instance_lookup_fn_t& get_instance)
+{
+    auto roles = check_unique_repeated_field(state.roles());
+    MRC_EXPECT(roles);
+
+    std::unique_ptr<SubscriptionService> service;
+    try
+    {
+        service.reset(new SubscriptionService(state, term));
+    } catch (const std::invalid_argument& e)
+    {
+        return Error::create(e.what());
+    }
+
+    // validate all members before updating state; a service holding tags must not be destroyed
+    std::vector<std::shared_ptr<server::ClientInstance>> instances;
+    for (const auto& member : state.members())
+    {
+        auto instance = get_instance(member.instance_id());
+        MRC_EXPECT(instance);
+        MRC_CHECK(service->is_issued_tag(member.tag()));
+        MRC_CHECK(member.role().empty() || contains(*roles, member.role()));
+        MRC_CHECK(!member.latched() || !member.role().empty());
+        for (const auto& s2r : member.subscribe_to_roles())
+        {
+            MRC_CHECK(contains(*roles, s2r));
+        }
+        instances.push_back(std::move(*instance));
+    }
+
+    for (int i = 0; i < state.members_size(); i++)
+    {
+        const auto& member = state.members(i);
+        if (member.latched())
+        {
+            service->get_role(member.role()).add_latched_member(member.tag(), instances[i]);
+            continue;
+        }
+
+        service->restore_instance_tag(member.instance_id(), member.tag());
+        if (!member.role().empty())
+        {
+            service->get_role(member.role()).add_member(member.tag(), instances[i]);
+        }
+        for (const auto& s2r : member.subscribe_to_roles())
+        {
+            service->get_role(s2r).add_subscriber(member.tag(), instances[i]);
+        }
+    }
+
+    return service;
+}
+
+void SubscriptionService::release_instance(std::uint64_t instance_id)
+{
+    drop_instance(instance_id);
+    for (auto& [name, role] : m_roles)
+    {
+        role->drop_latched_members(instance_id);
+    }
+}
+
+void SubscriptionService::snapshot(protos::SubscriptionServiceState& state) const
+{
+    state.set_service_name(m_name);
+    state.set_tag_base(lower_bound());
+    state.set_last_tag_uid(last_uid());
+
+    // registered and activated tags
+    std::map<std::uint64_t, protos::SubscriptionServiceMember> members;
+    for (const auto& [instance_id, tag] : instance_tags())
+    {
+        auto& member = members[tag];
+        member.set_tag(tag);
+        member.set_instance_id(instance_id);
+    }
+
+    for (const auto& [name, role] : m_roles)
+    {
+        state.add_roles(name);
+        role->snapshot(members);
+    }
+
+    for (auto& [tag, member] : members)
+    {
+        *state.add_members() = std::move(member);
+    }
+}
+
 Expected<TagID> SubscriptionService::register_instance(std::shared_ptr<server::ClientInstance> instance,
                                                        const std::string& role,
                                                        const std::set<std::string>& subscribe_to_roles)
@@ -284,10 +517,17 @@ Expected<> SubscriptionService::update_role(const protos::UpdateSubscriptionServ
     MRC_CHECK(update_req.service_name() == service_name());
     auto search = m_roles.find(update_req.role());
     MRC_CHECK(search != m_roles.end());
-    for (const auto& tag : update_req.tags())
+    if (update_req.resync())
     {
-        search->second->update_subscriber_nonce(tag, update_req.nonce());
+        for (const auto& tag : update_req.tags())
+        {
+            search->second->resync_subscriber(tag);
+        }
+        return {};
     }
+
+    // the subscribers of a client acknowledge a version together; their latches are evaluated once
+    search->second->update_subscriber_nonces({update_req.tags().begin(), update_req.tags().end()}, update_req.nonce());
     return {};
 }
 }  // namespace mrc::internal::control_plane::server
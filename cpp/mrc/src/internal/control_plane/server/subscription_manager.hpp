@@ -24,14 +24,19 @@
 #include "mrc/types.hpp"
 
 #include <cstdint>
+#include <functional>
 #include <map>
 #include <memory>
+#include <optional>
 #include <set>
 #include <string>
 #include <utility>
+#include <vector>
 
 namespace mrc::protos {
 class StateUpdate;
+class SubscriptionServiceMember;
+class SubscriptionServiceState;
 class UpdateSubscriptionServiceRequest;
 }  // namespace mrc::protos
 
@@ -61,13 +66,29 @@ class ClientInstance;
  * server to track the state of the clients. Using the PubSub as an example, this client-side state tracking is
  * necessary to ensure that a Subscriber is not deactivated until all Publishers have updated their internal states to
  * reflect the removal of the Subscriber. When a Subscriber requests to be dropped, it enters a latched state.
+ *
+ * For replication, the tags, roles and latched members are captured by snapshot() and restored with their tags on the
+ * promotion of a standby to leader.
  */
 class SubscriptionService final : public TaggedIssuer
 {
   public:
+    using instance_lookup_fn_t =
+        std::function<Expected<std::shared_ptr<server::ClientInstance>>(const std::uint64_t& instance_id)>;
+
     SubscriptionService(std::string name, std::set<std::string> roles);
     ~SubscriptionService() final;
 
+    // restore the replicated state of a service as the leader of term; instances are resolved with get_instance
+    static Expected<std::unique_ptr<SubscriptionService>> restore(const protos::SubscriptionServiceState& state,
+                                                                  std::uint64_t term,
+                                                                  const instance_lookup_fn_t& get_instance);
+
+    void snapshot(protos::SubscriptionServiceState& state) const;
+
+    // drop the tags and latched members of a restored instance which will not be reattached
+    void release_instance(std::uint64_t instance_id);
+
     const std::string& service_name() const final;
 
     bool has_role(const std::string& role) const;
@@ -85,6 +106,8 @@ class SubscriptionService final : public TaggedIssuer
     Expected<> update_role(const protos::UpdateSubscriptionServiceRequest& update_req);
 
   private:
+    SubscriptionService(const protos::SubscriptionServiceState& state, std::uint64_t term);
+
     void add_role(const std::string& name);
     Role& get_role(const std::string& name);
 
@@ -105,13 +128,17 @@ class SubscriptionService final : public TaggedIssuer
  * nonce is greater than the value of the nonce on last update, an update can be issued by calling issue_update.
  *
  * An issue_update will send a protos::SubscriptionServiceUpdate to all subscribers containing the (tag, instance_id)
- * tuple for each item in the members list.
+ * tuple for each item in the members list, or only the members added and removed since the previous update to
+ * subscribers which hold the previous version.
  */
 class Role final : public VersionedState
 {
   public:
     Role(std::string service_name, std::string role_name);
 
+    // role restored from replicated state by the leader of term
+    Role(std::string service_name, std::string role_name, std::uint64_t term);
+
     // subscribers are notified when new members are added
     void add_member(std::uint64_t tag, std::shared_ptr<server::ClientInstance> instance);
     void add_subscriber(std::uint64_t tag, std::shared_ptr<server::ClientInstance> instance);
@@ -126,16 +153,34 @@ class Role final : public VersionedState
     // the future, all m_subscriber_nonces should be X or greater.
     void update_subscriber_nonce(const std::uint64_t& tag, const std::uint64_t& nonce);
 
+    // update_subscriber_nonce for each of tags with the latches evaluated once for the batch
+    void update_subscriber_nonces(const std::vector<std::uint64_t>& tags, const std::uint64_t& nonce);
+
+    // the subscriber of tag failed to apply a delta update; its instance will be issued a snapshot
+    void resync_subscriber(const std::uint64_t& tag);
+
+    // restore a member which was dropped but not yet released by the previous leader
+    void add_latched_member(std::uint64_t tag, std::shared_ptr<server::ClientInstance> instance);
+
+    // drop the latched members of instance_id without issuing their drop requests
+    void drop_latched_members(std::uint64_t instance_id);
+
+    // add the members, subscribers and latched members of the role to the replicated members of the service
+    void snapshot(std::map<std::uint64_t, protos::SubscriptionServiceMember>& members) const;
+
     const std::string& service_name() const final;
     const std::string& role_name() const;
 
   private:
     bool has_update() const final;
     void do_make_update(protos::StateUpdate& update) const final;
-    void do_issue_update(const protos::StateUpdate& update) final;
+    void do_make_delta(protos::StateUpdate& update) const final;
+    void clear_delta() final;
+    void do_issue_update(const std::optional<protos::StateUpdate>& delta) final;
 
     // this method evaluates the state of the latched tags with respect to the state of the subscribers
-    // once all subscribers are sufficiently up-to-date, latched tags can be dropped.
+    // once all subscribers are sufficiently up-to-date, latched tags can be dropped; the latched tags are compared
+    // against the nonce of the least up-to-date subscriber, so an evaluation is linear in the members of the role
     void evaluate_latches();
 
     // enqueue the state update to be written to the client
@@ -156,6 +201,10 @@ class Role final : public VersionedState
 
     // <tag, <nonce, instance>> - when all m_subscriber_nonces are >= nonce issue drop event
     std::map<std::uint64_t, std::pair<std::uint64_t, std::shared_ptr<server::ClientInstance>>> m_latched_members;
+
+    // <tag, instance_id> - changes of m_members since the last issued update
+    std::map<std::uint64_t, std::uint64_t> m_added_members;
+    std::map<std::uint64_t, std::uint64_t> m_removed_members;
 };
 
 }  // namespace mrc::internal::control_plane::server
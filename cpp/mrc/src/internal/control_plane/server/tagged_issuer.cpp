@@ -21,12 +21,36 @@
 
 #include <glog/logging.h>
 
+#include <algorithm>
 #include <sstream>
 #include <stdexcept>
 #include <utility>
 
 namespace mrc::internal::control_plane::server {
 
+namespace {
+
+// index of the last tag issued by Tagged::next()
+std::uint32_t& tag_counter()
+{
+    static std::uint32_t next_tag = 0;
+    return next_tag;
+}
+
+}  // namespace
+
+Tagged::Tagged(TagID tag, std::uint16_t last_uid) : m_tag(tag), m_uid(last_uid)
+{
+    if ((m_tag & 0xFFFF) != 0 || m_uid == 0)
+    {
+        throw std::invalid_argument(MRC_CONCAT_STR("invalid restored tag " << m_tag << " with uid " << m_uid));
+    }
+
+    // objects created after the restore must not reissue the tag
+    auto& counter = tag_counter();
+    counter       = std::max(counter, static_cast<std::uint32_t>(m_tag >> 16));
+}
+
 Tagged::~Tagged() = default;
 
 TagID Tagged::upper_bound() const
@@ -37,6 +61,10 @@ TagID Tagged::lower_bound() const
 {
     return m_tag;
 }
+std::uint16_t Tagged::last_uid() const
+{
+    return m_uid;
+}
 bool Tagged::is_valid_tag(const TagID& tag) const
 {
     static constexpr std::uint64_t Mask = 0x0000FFFFFFFF0000;
@@ -58,7 +86,7 @@ TagID Tagged::next_tag()
 TagID Tagged::next()
 {
     constexpr std::uint32_t MaxVal = 0x0FFFFFFF;
-    static std::uint32_t next_tag  = 0;
+    auto& next_tag                 = tag_counter();
     if (++next_tag < MaxVal)
     {
         std::uint64_t tag = next_tag;
@@ -67,6 +95,8 @@ TagID Tagged::next()
     throw std::overflow_error("limit of Taggable objects reached; fatal error");
 }
 
+TaggedIssuer::TaggedIssuer(TagID tag, std::uint16_t last_uid) : Tagged(tag, last_uid) {}
+
 TaggedIssuer::~TaggedIssuer()
 {
     if (!m_instance_tags.empty())
@@ -118,6 +148,18 @@ TagID TaggedIssuer::register_instance_id(ClientInstance::instance_id_t instance_
     m_instance_tags.emplace(instance_id, tag);
     return tag;
 }
+void TaggedIssuer::restore_instance_tag(ClientInstance::instance_id_t instance_id, TagID tag)
+{
+    if (!is_issued_tag(tag))
+    {
+        throw std::invalid_argument(MRC_CONCAT_STR("restored tag " << tag << " was not issued by " << lower_bound()));
+    }
+    m_instance_tags.emplace(instance_id, tag);
+}
+const std::multimap<ClientInstance::instance_id_t, TagID>& TaggedIssuer::instance_tags() const
+{
+    return m_instance_tags;
+}
 decltype(TaggedIssuer::m_instance_tags)::iterator TaggedIssuer::drop_tag(decltype(m_instance_tags)::iterator it)
 {
     DVLOG(10) << "dropping tag: " << it->second;
@@ -39,7 +39,11 @@ namespace mrc::internal::control_plane::server {
 class Tagged
 {
   public:
-    Tagged()          = default;
+    Tagged() = default;
+
+    // tagged object restored from replicated state; tag must not be issued by next() to another object
+    Tagged(TagID tag, std::uint16_t last_uid);
+
     virtual ~Tagged() = 0;
 
     DELETE_COPYABILITY(Tagged);
@@ -53,6 +57,9 @@ class Tagged
     TagID upper_bound() const;
     TagID lower_bound() const;
 
+    // uid of the last issued tag
+    std::uint16_t last_uid() const;
+
   protected:
     TagID next_tag();
 
@@ -82,6 +89,8 @@ class TaggedIssuer : public Tagged, public UpdateIssuer
     virtual void do_drop_tag(const TagID& tag) = 0;
 
   public:
+    TaggedIssuer() = default;
+    TaggedIssuer(TagID tag, std::uint16_t last_uid);
     ~TaggedIssuer() override;
 
     void drop_instance(std::shared_ptr<ClientInstance> instance);
@@ -97,6 +106,11 @@ class TaggedIssuer : public Tagged, public UpdateIssuer
   protected:
     TagID register_instance_id(ClientInstance::instance_id_t instance_id);
 
+    // restore the association of a previously issued tag with instance_id
+    void restore_instance_tag(ClientInstance::instance_id_t instance_id, TagID tag);
+
+    const std::multimap<ClientInstance::instance_id_t, TagID>& instance_tags() const;
+
   private:
     std::multimap<ClientInstance::instance_id_t, TagID> m_instance_tags;
 
@@ -22,10 +22,22 @@
 #include "mrc/protos/architect.pb.h"
 #include "mrc/utils/macros.hpp"
 
+#include <cstddef>
 #include <cstdint>
+#include <map>
+#include <optional>
 
 namespace mrc::internal::control_plane::server {
 
+/**
+ * @brief Server-side state issued to clients as versioned updates
+ *
+ * Each issued version is available as a full snapshot and as a delta of the changes since the previously issued
+ * version. A client receives the delta if the previous version was sent to it, otherwise the snapshot; updates are
+ * written in order on the stream of the client, so the client holds the base version of the delta when applying it.
+ * Clients acknowledge each applied version and request a snapshot if a delta does not apply to their version. Every
+ * SnapshotInterval-th version is issued as a snapshot to all clients to recover from any unnoticed divergence.
+ */
 class VersionedState : public UpdateIssuer
 {
   public:
@@ -34,16 +46,33 @@ class VersionedState : public UpdateIssuer
     DELETE_MOVEABILITY(VersionedState);
     DELETE_COPYABILITY(VersionedState);
 
+    // number of issued versions after which every client receives a snapshot
+    static constexpr std::size_t SnapshotInterval = 64;
+
+    // versions of term t start at t << TermShift
+    static constexpr std::size_t TermShift = 40;
+
     void issue_update() final
     {
         if (m_issued_nonce < m_current_nonce)
         {
-            m_issued_nonce = m_current_nonce;
+            const auto base_nonce = m_issued_nonce;
+            m_issued_nonce        = m_current_nonce;
             if (has_update())
             {
-                auto update = make_update();
-                do_issue_update(update);
+                std::optional<protos::StateUpdate> delta;
+                if (++m_issued_since_snapshot < SnapshotInterval)
+                {
+                    delta = make_delta(base_nonce);
+                }
+                else
+                {
+                    m_issued_since_snapshot = 0;
+                    m_sent_nonces.clear();
+                }
+                do_issue_update(delta);
             }
+            clear_delta();
         }
     }
 
@@ -58,6 +87,7 @@ class VersionedState : public UpdateIssuer
         return m_current_nonce;
     }
 
+    // full snapshot of the current state
     protos::StateUpdate make_update() const
     {
         protos::StateUpdate update;
@@ -67,13 +97,72 @@ class VersionedState : public UpdateIssuer
         return update;
     }
 
+    // returns the delta if client_id holds the base version of delta, otherwise nullptr in which case the client must
+    // be sent a snapshot; records the issued version as sent to client_id
+    const protos::StateUpdate* select_update(std::uint64_t client_id, const std::optional<protos::StateUpdate>& delta)
+    {
+        auto& sent_nonce   = m_sent_nonces[client_id];
+        const auto* update = (delta && sent_nonce == delta->base_nonce()) ? &*delta : nullptr;
+        sent_nonce         = m_issued_nonce;
+        return update;
+    }
+
+    // issue a snapshot to client_id with the next update, e.g. when a delta did not apply to its version
+    void request_snapshot(std::uint64_t client_id)
+    {
+        m_sent_nonces.erase(client_id);
+        mark_as_modified();
+    }
+
+    // versions issued after a promotion to leader of term must exceed the versions issued by all previous leaders, as
+    // clients only apply versions above the one they hold; the next update is issued as a snapshot to all clients
+    void begin_term(std::uint64_t term)
+    {
+        const std::size_t nonce = term << TermShift;
+        if (m_current_nonce < nonce)
+        {
+            m_current_nonce = nonce;
+            m_issued_nonce  = nonce - 1;
+        }
+        m_issued_since_snapshot = 0;
+        m_sent_nonces.clear();
+    }
+
+    // forget the version sent to a disconnected client
+    void drop_client(std::uint64_t client_id)
+    {
+        m_sent_nonces.erase(client_id);
+    }
+
   private:
-    virtual bool has_update() const                                 = 0;
-    virtual void do_make_update(protos::StateUpdate& update) const  = 0;
-    virtual void do_issue_update(const protos::StateUpdate& update) = 0;
+    protos::StateUpdate make_delta(std::size_t base_nonce) const
+    {
+        protos::StateUpdate update;
+        update.set_service_name(this->service_name());
+        update.set_nonce(m_current_nonce);
+        update.set_base_nonce(base_nonce);
+        do_make_delta(update);
+        return update;
+    }
+
+    virtual bool has_update() const                                = 0;
+    virtual void do_make_update(protos::StateUpdate& update) const = 0;
+
+    // populate update with the changes since the last issued version
+    virtual void do_make_delta(protos::StateUpdate& update) const = 0;
+
+    // discard the changes recorded for the delta; called after every issued version
+    virtual void clear_delta() = 0;
+
+    // issue the current version to each client; clients for which select_update returns nullptr receive make_update()
+    virtual void do_issue_update(const std::optional<protos::StateUpdate>& delta) = 0;
 
     std::size_t m_current_nonce{1};
     std::size_t m_issued_nonce{1};
+    std::size_t m_issued_since_snapshot{0};
+
+    // <client_id, nonce> - last version sent to each client
+    std::map<std::uint64_t, std::size_t> m_sent_nonces;
 };
 
 }  // namespace mrc::internal::control_plane::server
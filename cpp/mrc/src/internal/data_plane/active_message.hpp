@@ -0,0 +1,60 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace mrc::internal::data_plane {
+
+// active message id of the aggregated messages delivered to the deserialize source of the data plane server
+static constexpr std::uint32_t AM_DATA_PLANE_MSG = 10001;  // NOLINT
+
+/**
+ * @brief Header of a data plane active message
+ *
+ * The active messages sent over an endpoint form a stream, whose id is unique w.h.p. across all senders, numbered
+ * from 0 in the order they were sent. The receiver emits the messages of a stream in sequence, even if a rendezvous
+ * active message completes after eager active messages sent after it.
+ */
+struct ActiveMessageHeader
+{
+    std::uint64_t stream;
+    std::uint64_t sequence;
+};
+
+/**
+ * @brief Header of each message aggregated into a data plane active message
+ *
+ * The payload of the active message is a sequence of frames, each made of this header followed by the bytes of the
+ * message, padded to the alignment of the header. The tag carries the user bits only.
+ */
+struct ActiveMessageFrame
+{
+    std::uint64_t tag;
+    std::uint64_t bytes;
+};
+
+// number of bytes taken by the frame of a message of the given size
+static constexpr std::size_t active_message_frame_bytes(std::size_t bytes)
+{
+    constexpr std::size_t align = alignof(ActiveMessageFrame);
+    return sizeof(ActiveMessageFrame) + (bytes + align - 1) / align * align;
+}
+
+}  // namespace mrc::internal::data_plane
@@ -19,10 +19,13 @@
 
 #include "internal/data_plane/request.hpp"
 
+#include "mrc/benchmarking/flight_recorder.hpp"
+
 #include <glog/logging.h>
 #include <ucp/api/ucp.h>
 
 #include <atomic>
+#include <cstdint>
 #include <ostream>
 
 namespace mrc::internal::data_plane {
@@ -35,6 +38,21 @@ void Callbacks::send(void* request, ucs_status_t status, void* user_data)
     auto* user_req = static_cast<Request*>(user_data);
     DCHECK(user_req->m_state == Request::State::Running);
 
+    // a request issued as multiple operations completes with its last operation
+    if (user_req->m_outstanding.fetch_sub(1, std::memory_order_acq_rel) > 1)
+    {
+        if (status != UCS_OK && status != UCS_ERR_CANCELED)
+        {
+            LOG(FATAL) << "data_plane: send callback failed with status: " << ucs_status_string(status);
+        }
+        ucp_request_free(request);
+        return;
+    }
+
+    benchmarking::FlightRecorder::record(benchmarking::FlightEventType::NetworkSend,
+                                         reinterpret_cast<std::uintptr_t>(user_req),
+                                         static_cast<std::uint32_t>(status));
+
     if (user_req->m_rkey != nullptr)
     {
         ucp_rkey_destroy(reinterpret_cast<ucp_rkey_h>(user_req->m_rkey));
@@ -44,20 +62,20 @@ void Callbacks::send(void* request, ucs_status_t status, void* user_data)
     {
         ucp_request_free(request);
         user_req->m_request = nullptr;
-        user_req->m_state   = Request::State::OK;
+        user_req->complete(Request::State::OK);
     }
 
     else if (status == UCS_ERR_CANCELED)
     {
         ucp_request_free(request);
         user_req->m_request = nullptr;
-        user_req->m_state   = Request::State::Cancelled;
+        user_req->complete(Request::State::Cancelled);
     }
     else
     {
         // todo(ryan) - set the promise exception ptr
         LOG(FATAL) << "data_plane: pre_posted_recv_callback failed with status: " << ucs_status_string(status);
-        user_req->m_state = Request::State::Error;
+        user_req->complete(Request::State::Error);
     }
 }
 
@@ -67,23 +85,27 @@ void Callbacks::recv(void* request, ucs_status_t status, const ucp_tag_recv_info
     auto* user_req = static_cast<Request*>(user_data);
     DCHECK(user_req->m_state == Request::State::Running);
 
+    benchmarking::FlightRecorder::record(benchmarking::FlightEventType::NetworkRecv,
+                                         reinterpret_cast<std::uintptr_t>(user_req),
+                                         static_cast<std::uint32_t>(status));
+
     if (status == UCS_OK)  // cpp20 [[likely]]
     {
         ucp_request_free(request);
         user_req->m_request = nullptr;
-        user_req->m_state   = Request::State::OK;
+        user_req->complete(Request::State::OK);
     }
     else if (status == UCS_ERR_CANCELED)
     {
         ucp_request_free(request);
         user_req->m_request = nullptr;
-        user_req->m_state   = Request::State::Cancelled;
+        user_req->complete(Request::State::Cancelled);
     }
     else
     {
         // todo(ryan) - set the promise exception ptr
         LOG(FATAL) << "data_plane: pre_posted_recv_callback failed with status: " << ucs_status_string(status);
-        user_req->m_state = Request::State::Error;
+        user_req->complete(Request::State::Error);
     }
 }
 
@@ -18,13 +18,19 @@
 #include "internal/data_plane/client.hpp"
 
 #include "internal/control_plane/client/connections_manager.hpp"
+#include "internal/data_plane/active_message.hpp"
 #include "internal/data_plane/callbacks.hpp"
+#include "internal/data_plane/pull_throttle.hpp"
 #include "internal/data_plane/request.hpp"
 #include "internal/data_plane/resources.hpp"
 #include "internal/data_plane/tags.hpp"
+#include "internal/memory/host_resources.hpp"
 #include "internal/memory/transient_pool.hpp"
 #include "internal/remote_descriptor/manager.hpp"
 #include "internal/runnable/resources.hpp"
+#include "internal/system/device_partition.hpp"
+#include "internal/system/partition.hpp"
+#include "internal/system/system.hpp"
 #include "internal/ucx/common.hpp"
 #include "internal/ucx/endpoint.hpp"
 #include "internal/ucx/resources.hpp"
@@ -32,25 +38,44 @@
 
 #include "mrc/channel/buffered_channel.hpp"
 #include "mrc/channel/channel.hpp"
-#include "mrc/memory/literals.hpp"
+#include "mrc/cuda/common.hpp"
+#include "mrc/cuda/device_guard.hpp"
+#include "mrc/data/cached_reusable_pool.hpp"
+#include "mrc/memory/buffer.hpp"
+#include "mrc/memory/iovec_view.hpp"
 #include "mrc/node/edge_builder.hpp"
 #include "mrc/node/rx_sink.hpp"
 #include "mrc/node/source_channel.hpp"
+#include "mrc/options/network.hpp"
+#include "mrc/options/options.hpp"
 #include "mrc/protos/codable.pb.h"
 #include "mrc/runnable/launch_control.hpp"
 #include "mrc/runnable/launcher.hpp"
 #include "mrc/runnable/runner.hpp"
 #include "mrc/runtime/remote_descriptor_handle.hpp"
 #include "mrc/types.hpp"
+#include "mrc/utils/macros.hpp"
 
+#include <boost/fiber/operations.hpp>
+#include <cuda_runtime.h>
 #include <glog/logging.h>
 #include <rxcpp/rx.hpp>
 #include <ucp/api/ucp.h>
 #include <ucs/type/status.h>
 
+#include <algorithm>
 #include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstring>
+#include <deque>
+#include <functional>
+#include <list>
 #include <memory>
+#include <mutex>
+#include <optional>
 #include <ostream>
+#include <random>
 #include <stdexcept>
 #include <string>
 #include <utility>
@@ -58,41 +83,222 @@
 
 namespace mrc::internal::data_plane {
 
-using namespace mrc::memory::literals;
+namespace {
+
+bool is_device_memory(const void* addr)
+{
+    cudaPointerAttributes attributes;
+    if (cudaPointerGetAttributes(&attributes, addr) != cudaSuccess)
+    {
+        // clear the error reported for pointers unknown to cuda
+        cudaGetLastError();
+        return false;
+    }
+    return (attributes.type == cudaMemoryTypeDevice || attributes.type == cudaMemoryTypeManaged);
+}
+
+// a remote descriptor message owned by the host function of its stream
+struct StreamOrderedRemoteDescriptor
+{
+    node::SourceChannelWriteable<RemoteDescriptorMessage>* channel;
+    std::atomic<std::size_t>* pending;
+    RemoteDescriptorMessage msg;
+};
+
+// executed by a cuda runtime thread, which must not call into cuda, once the preceding work of the stream completed
+void issue_stream_ordered_remote_descriptor(void* user_data)
+{
+    std::unique_ptr<StreamOrderedRemoteDescriptor> rd(static_cast<StreamOrderedRemoteDescriptor*>(user_data));
+    CHECK(rd->channel->await_write(std::move(rd->msg)) == channel::Status::success);
+    rd->pending->fetch_sub(1);
+}
+
+void await_event(cudaEvent_t event)
+{
+    cudaError_t rc;
+    while ((rc = cudaEventQuery(event)) == cudaErrorNotReady)
+    {
+        boost::this_fiber::yield();
+    }
+    MRC_CHECK_CUDA(rc);
+}
+
+// event used to await the staging copies of a single transfer
+class StagingEvent
+{
+  public:
+    StagingEvent()
+    {
+        MRC_CHECK_CUDA(cudaEventCreateWithFlags(&m_event, cudaEventDisableTiming));
+    }
+
+    ~StagingEvent()
+    {
+        MRC_CHECK_CUDA(cudaEventDestroy(m_event));
+    }
+
+    DELETE_COPYABILITY(StagingEvent);
+    DELETE_MOVEABILITY(StagingEvent);
+
+    void record_and_await(cudaStream_t stream)
+    {
+        MRC_CHECK_CUDA(cudaEventRecord(m_event, stream));
+        await_event(m_event);
+    }
+
+  private:
+    cudaEvent_t m_event{nullptr};
+};
+
+}  // namespace
+
+struct Client::Chunk
+{
+    std::byte* addr{nullptr};
+    std::size_t bytes{0};
+    mrc::data::Reusable<mrc::memory::buffer> staging;
+    Request request;
+};
 
 Client::Client(resources::PartitionResourceBase& base,
                ucx::Resources& ucx,
                control_plane::client::ConnectionsManager& connections_manager,
+               memory::HostResources& host,
                memory::TransientPool& transient_pool) :
   resources::PartitionResourceBase(base),
   m_ucx(ucx),
   m_connnection_manager(connections_manager),
   m_transient_pool(transient_pool),
+  m_rma_stripe_size(system().options().network().rma_stripe_size()),
+  m_host(host),
+  m_gpudirect(system().options().network().enable_gpudirect() && ucx.transport() != NetworkTransport::Tcp),
+  m_staging_chunk_size(system().options().network().staging_chunk_size()),
+  m_max_endpoints(system().options().network().max_endpoints()),
+  m_idle_timeout(system().options().network().endpoint_idle_timeout()),
+  m_pull_throttle(system().options().network().max_pull_bytes_in_flight(),
+                  system().options().network().max_pulls_per_instance(),
+                  system().options().network().pull_latency_target()),
+  m_enable_active_messages(system().options().network().enable_active_messages()),
+  m_active_message_batch_bytes(system().options().network().active_message_batch_bytes()),
+  m_next_active_message_stream((static_cast<std::uint64_t>(std::random_device()()) << 32) | std::random_device()()),
   m_rd_channel(std::make_unique<node::SourceChannelWriteable<RemoteDescriptorMessage>>())
-{}
+{
+    CHECK_GT(m_staging_chunk_size, 0);
+    if (!m_gpudirect && partition().has_device())
+    {
+        DeviceGuard guard(partition().device().cuda_device_id());
+        MRC_CHECK_CUDA(cudaStreamCreateWithFlags(&m_staging_stream, cudaStreamNonBlocking));
+    }
+}
 
-Client::~Client() = default;
+Client::~Client()
+{
+    if (m_staging_stream != nullptr)
+    {
+        DeviceGuard guard(partition().device().cuda_device_id());
+        MRC_CHECK_CUDA(cudaStreamDestroy(m_staging_stream));
+    }
+}
 
 std::shared_ptr<ucx::Endpoint> Client::endpoint_shared(const InstanceID& id) const
 {
-    auto search_endpoints = m_endpoints.find(id);
-    if (search_endpoints == m_endpoints.end())
+    std::vector<std::shared_ptr<ucx::Endpoint>> evicted;
+    std::shared_ptr<ucx::Endpoint> endpoint;
+    {
+        std::lock_guard<std::mutex> lock(m_endpoints_mutex);
+        const auto now = std::chrono::steady_clock::now();
+
+        auto search_endpoints = m_endpoints.find(id);
+        if (search_endpoints != m_endpoints.end())
+        {
+            auto& cached = search_endpoints->second;
+            DCHECK(cached.endpoint);
+            cached.last_used = now;
+            m_lru.splice(m_lru.begin(), m_lru, cached.lru);
+            endpoint = cached.endpoint;
+        }
+        else
+        {
+            const auto& workers = m_connnection_manager.worker_addresses();
+            auto search_workers = workers.find(id);
+            if (search_workers == workers.end())
+            {
+                LOG(ERROR) << "no endpoint or worker addresss was found for instance_id: " << id;
+                throw std::runtime_error("could not acquire ucx endpoint");
+            }
+
+            // lazy instantiation of the endpoint; the wireup proceeds in the progress engine. endpoints are sharded by
+            // instance across the ucx workers of the partition, so sends to different instances progress on different
+            // network threads
+            DVLOG(10) << "creating endpoint to instance_id: " << id;
+            endpoint = m_ucx.make_ep(search_workers->second, id);
+            m_lru.push_front(id);
+            m_endpoints[id] = {endpoint, now, m_lru.begin()};
+        }
+
+        evicted = evict_endpoints(now);
+    }
+
+    // closing an endpoint flushes its outstanding operations, so it is done outside of the lock
+    forget_active_message_batches(evicted);
+    evicted.clear();
+    return endpoint;
+}
+
+std::vector<std::shared_ptr<ucx::Endpoint>> Client::evict_endpoints(std::chrono::steady_clock::time_point now) const
+{
+    std::vector<std::shared_ptr<ucx::Endpoint>> evicted;
+
+    const bool over_capacity = m_max_endpoints > 0 && m_endpoints.size() > m_max_endpoints;
+    const bool sweep_idle    = m_idle_timeout.count() > 0 && now - m_last_sweep >= m_idle_timeout / 2;
+    if (!over_capacity && !sweep_idle)
+    {
+        return evicted;
+    }
+    if (sweep_idle)
     {
-        const auto& workers = m_connnection_manager.worker_addresses();
-        auto search_workers = workers.find(id);
-        if (search_workers == workers.end())
+        m_last_sweep = now;
+    }
+
+    // from the least recently used; endpoints held elsewhere, e.g. by an in flight operation, are kept
+    for (auto it = m_lru.end(); it != m_lru.begin();)
+    {
+        --it;
+        auto search = m_endpoints.find(*it);
+        DCHECK(search != m_endpoints.end());
+        auto& cached = search->second;
+
+        const bool excess = m_max_endpoints > 0 && m_endpoints.size() > m_max_endpoints;
+        const bool idle   = m_idle_timeout.count() > 0 && now - cached.last_used >= m_idle_timeout;
+        if (!excess && !idle)
+        {
+            if (!sweep_idle)
+            {
+                break;
+            }
+            continue;
+        }
+        if (cached.endpoint.use_count() > 1)
         {
-            LOG(ERROR) << "no endpoint or worker addresss was found for instance_id: " << id;
-            throw std::runtime_error("could not acquire ucx endpoint");
+            continue;
         }
-        // lazy instantiation of the endpoint
-        DVLOG(10) << "creating endpoint to instance_id: " << id;
-        auto endpoint   = m_ucx.make_ep(search_workers->second);
-        m_endpoints[id] = endpoint;
-        return endpoint;
+
+        DVLOG(10) << "closing " << (excess ? "least recently used" : "idle") << " endpoint to instance_id: " << *it;
+        evicted.push_back(std::move(cached.endpoint));
+        m_endpoints.erase(search);
+        it = m_lru.erase(it);
+    }
+    return evicted;
+}
+
+void Client::prepare_endpoints(const std::vector<InstanceID>& instance_ids) const
+{
+    // endpoints are created back to back, so their wireups proceed concurrently in the progress engine instead of one
+    // after the other on the first transfer to each instance
+    for (const auto& id : instance_ids)
+    {
+        endpoint_shared(id);
     }
-    DCHECK(search_endpoints->second);
-    return search_endpoints->second;
 }
 
 const ucx::Endpoint& Client::endpoint(const InstanceID& instance_id) const
@@ -102,11 +308,24 @@ const ucx::Endpoint& Client::endpoint(const InstanceID& instance_id) const
 
 void Client::drop_endpoint(const InstanceID& instance_id)
 {
-    m_endpoints.erase(instance_id);
+    std::vector<std::shared_ptr<ucx::Endpoint>> dropped;
+    {
+        std::lock_guard<std::mutex> lock(m_endpoints_mutex);
+        auto search = m_endpoints.find(instance_id);
+        if (search == m_endpoints.end())
+        {
+            return;
+        }
+        dropped.push_back(std::move(search->second.endpoint));
+        m_lru.erase(search->second.lru);
+        m_endpoints.erase(search);
+    }
+    forget_active_message_batches(dropped);
 }
 
 std::size_t Client::endpoint_count() const
 {
+    std::lock_guard<std::mutex> lock(m_endpoints_mutex);
     return m_endpoints.size();
 }
 
@@ -161,7 +380,228 @@ void Client::async_p2p_send(
     CHECK_LE(tag, TAG_USER_MASK);
     tag |= TAG_P2P_MSG;
 
-    async_send(addr, bytes, tag, endpoint(instance_id), request);
+    // held until the send is issued, in case the endpoint is evicted from the cache meanwhile
+    auto ep = endpoint_shared(instance_id);
+    async_send(addr, bytes, tag, *ep, request);
+}
+
+void Client::async_recv(const mrc::memory::iovec_view& iov,
+                        std::uint64_t tag,
+                        std::uint64_t mask,
+                        const ucx::Worker& worker,
+                        Request& request)
+{
+    CHECK_EQ(request.m_request, nullptr);
+    CHECK(request.m_state == Request::State::Init);
+    request.m_state = Request::State::Running;
+
+    request.m_iov.clear();
+    for (const auto& segment : iov.segments())
+    {
+        request.m_iov.push_back({const_cast<void*>(segment.data()), segment.bytes()});
+    }
+
+    ucp_request_param_t params;
+    params.op_attr_mask = UCP_OP_ATTR_FIELD_CALLBACK | UCP_OP_ATTR_FIELD_USER_DATA | UCP_OP_ATTR_FIELD_DATATYPE |
+                          UCP_OP_ATTR_FLAG_NO_IMM_CMPL;
+    params.cb.recv      = Callbacks::recv;
+    params.user_data    = &request;
+    params.datatype     = ucp_dt_make_iov();
+
+    request.m_request =
+        ucp_tag_recv_nbx(worker.handle(), request.m_iov.data(), request.m_iov.size(), tag, mask, &params);
+    CHECK(request.m_request);
+    CHECK(!UCS_PTR_IS_ERR(request.m_request));
+}
+
+void Client::async_send(const mrc::memory::const_iovec_view& iov,
+                        std::uint64_t tag,
+                        const ucx::Endpoint& endpoint,
+                        Request& request)
+{
+    CHECK_EQ(request.m_request, nullptr);
+    CHECK(request.m_state == Request::State::Init);
+    request.m_state = Request::State::Running;
+
+    request.m_iov.clear();
+    for (const auto& segment : iov.segments())
+    {
+        request.m_iov.push_back({const_cast<void*>(segment.data()), segment.bytes()});
+    }
+
+    ucp_request_param_t send_params;
+    send_params.op_attr_mask = UCP_OP_ATTR_FIELD_CALLBACK | UCP_OP_ATTR_FIELD_USER_DATA | UCP_OP_ATTR_FIELD_DATATYPE |
+                               UCP_OP_ATTR_FLAG_NO_IMM_CMPL;
+    send_params.cb.send      = Callbacks::send;
+    send_params.user_data    = &request;
+    send_params.datatype     = ucp_dt_make_iov();
+
+    request.m_request =
+        ucp_tag_send_nbx(endpoint.handle(), request.m_iov.data(), request.m_iov.size(), tag, &send_params);
+    CHECK(request.m_request);
+    CHECK(!UCS_PTR_IS_ERR(request.m_request));
+}
+
+void Client::async_p2p_recv(const mrc::memory::iovec_view& iov, std::uint64_t tag, Request& request)
+{
+    static constexpr std::uint64_t mask = TAG_P2P_MSG & TAG_USER_MASK;  // NOLINT
+
+    CHECK(iov.empty() || !use_staging(iov.segments().front().data()))
+        << "scatter/gather transfers of device memory require gpudirect";
+    CHECK_LE(tag, TAG_USER_MASK);
+    tag |= TAG_P2P_MSG;
+
+    async_recv(iov, tag, mask, m_ucx.worker(), request);
+}
+
+void Client::async_p2p_send(const mrc::memory::const_iovec_view& iov,
+                            std::uint64_t tag,
+                            InstanceID instance_id,
+                            Request& request) const
+{
+    CHECK(iov.empty() || !use_staging(iov.segments().front().data()))
+        << "scatter/gather transfers of device memory require gpudirect";
+    CHECK_LE(tag, TAG_USER_MASK);
+    tag |= TAG_P2P_MSG;
+
+    auto ep = endpoint_shared(instance_id);
+    async_send(iov, tag, *ep, request);
+}
+
+bool Client::use_staging(const void* addr) const
+{
+    if (m_gpudirect || m_staging_stream == nullptr || !is_device_memory(addr))
+    {
+        return false;
+    }
+    CHECK(m_host.staging_pool()) << "device memory transfers require a staging pool";
+    return true;
+}
+
+std::size_t Client::chunk_count(std::size_t bytes) const
+{
+    // empty messages are transferred as a single empty chunk
+    return std::max<std::size_t>((bytes + m_staging_chunk_size - 1) / m_staging_chunk_size, 1);
+}
+
+void Client::p2p_send(const void* addr, std::size_t bytes, std::uint64_t tag, InstanceID instance_id) const
+{
+    CHECK_LE(tag, TAG_USER_MASK);
+    tag |= TAG_P2P_MSG;
+
+    auto endpoint     = endpoint_shared(instance_id);
+    const auto& ep    = *endpoint;
+    const bool staged = use_staging(addr);
+    auto* src         = static_cast<std::byte*>(const_cast<void*>(addr));
+
+    std::optional<DeviceGuard> guard;
+    std::optional<StagingEvent> event;
+    if (staged)
+    {
+        guard.emplace(partition().device().cuda_device_id());
+        event.emplace();
+    }
+
+    // the sends of the chunks in flight hold their staging buffers; when the pool is drained the oldest send is
+    // awaited to recycle its buffer
+    std::deque<Chunk> inflight;
+    for (std::size_t i = 0; i < chunk_count(bytes); ++i)
+    {
+        auto offset = i * m_staging_chunk_size;
+        auto& chunk = inflight.emplace_back();
+        chunk.addr  = src + offset;
+        chunk.bytes = std::min(m_staging_chunk_size, bytes - offset);
+
+        if (staged)
+        {
+            auto pool = m_host.staging_pool();
+            std::optional<mrc::data::Reusable<mrc::memory::buffer>> staging;
+            while (!(staging = pool->try_item()) && inflight.size() > 1)
+            {
+                inflight.front().request.await_complete();
+                inflight.pop_front();
+            }
+            chunk.staging = (staging ? std::move(*staging) : pool->await_item());
+            chunk.addr    = static_cast<std::byte*>(chunk.staging->data());
+
+            MRC_CHECK_CUDA(cudaMemcpyAsync(
+                chunk.addr, src + offset, chunk.bytes, cudaMemcpyDeviceToHost, m_staging_stream));
+            event->record_and_await(m_staging_stream);
+        }
+
+        async_send(chunk.addr, chunk.bytes, tag, ep, chunk.request);
+    }
+
+    for (auto& chunk : inflight)
+    {
+        chunk.request.await_complete();
+    }
+}
+
+void Client::p2p_recv(void* addr, std::size_t bytes, std::uint64_t tag) const
+{
+    static constexpr std::uint64_t mask = TAG_P2P_MSG & TAG_USER_MASK;  // NOLINT
+
+    CHECK_LE(tag, TAG_USER_MASK);
+    tag |= TAG_P2P_MSG;
+
+    const bool staged = use_staging(addr);
+    auto* dst         = static_cast<std::byte*>(addr);
+
+    std::optional<DeviceGuard> guard;
+    std::optional<StagingEvent> event;
+    if (staged)
+    {
+        guard.emplace(partition().device().cuda_device_id());
+        event.emplace();
+    }
+
+    // receives are posted ahead for as many chunks as there are staging buffers; tag matching fills them in the
+    // order they were posted, so the chunks are completed and copied to the device in order
+    auto complete = [&](Chunk& chunk) {
+        chunk.request.await_complete();
+        if (staged)
+        {
+            MRC_CHECK_CUDA(cudaMemcpyAsync(
+                chunk.addr, chunk.staging->data(), chunk.bytes, cudaMemcpyHostToDevice, m_staging_stream));
+            event->record_and_await(m_staging_stream);
+        }
+    };
+
+    std::deque<Chunk> inflight;
+    for (std::size_t i = 0; i < chunk_count(bytes); ++i)
+    {
+        auto offset = i * m_staging_chunk_size;
+        auto& chunk = inflight.emplace_back();
+        chunk.addr  = dst + offset;
+        chunk.bytes = std::min(m_staging_chunk_size, bytes - offset);
+
+        void* recv_addr = chunk.addr;
+        if (staged)
+        {
+            auto pool = m_host.staging_pool();
+            std::optional<mrc::data::Reusable<mrc::memory::buffer>> staging;
+            while (!(staging = pool->try_item()) && inflight.size() > 1)
+            {
+                complete(inflight.front());
+                inflight.pop_front();
+            }
+            chunk.staging = (staging ? std::move(*staging) : pool->await_item());
+            recv_addr     = chunk.staging->data();
+        }
+
+        async_recv(recv_addr, chunk.bytes, tag, mask, m_ucx.worker(), chunk.request);
+    }
+
+    for (auto& chunk : inflight)
+    {
+        complete(chunk);
+    }
+}
+
+PullThrottle& Client::pull_throttle()
+{
+    return m_pull_throttle;
 }
 
 void Client::async_get(void* addr,
@@ -185,6 +625,43 @@ void Client::async_get(void* addr,
     CHECK(!UCS_PTR_IS_ERR(request.m_request));
 }
 
+void Client::async_striped_get(void* addr,
+                               std::size_t bytes,
+                               const ucx::Endpoint& ep,
+                               std::uint64_t remote_addr,
+                               ucp_rkey_h rkey,
+                               Request& request) const
+{
+    if (m_rma_stripe_size == 0 || bytes <= m_rma_stripe_size)
+    {
+        return async_get(addr, bytes, ep, remote_addr, rkey, request);
+    }
+
+    CHECK_EQ(request.m_request, nullptr);
+    CHECK(request.m_state == Request::State::Init);
+    request.m_state = Request::State::Running;
+
+    // the count must be set before the first stripe is issued, since the stripes may complete in any order
+    const auto stripes    = (bytes + m_rma_stripe_size - 1) / m_rma_stripe_size;
+    request.m_outstanding = stripes;
+
+    ucp_request_param_t params;
+    params.op_attr_mask = UCP_OP_ATTR_FIELD_CALLBACK | UCP_OP_ATTR_FIELD_USER_DATA | UCP_OP_ATTR_FLAG_NO_IMM_CMPL;
+    params.cb.send      = Callbacks::send;
+    params.user_data    = &request;
+
+    for (std::size_t i = 0; i < stripes; ++i)
+    {
+        const auto offset = i * m_rma_stripe_size;
+        const auto length = std::min(m_rma_stripe_size, bytes - offset);
+        auto* stripe_addr = static_cast<std::byte*>(addr) + offset;
+
+        auto* status = ucp_get_nbx(ep.handle(), stripe_addr, length, remote_addr + offset, rkey, &params);
+        CHECK(status);
+        CHECK(!UCS_PTR_IS_ERR(status));
+    }
+}
+
 void Client::async_get(void* addr,
                        std::size_t bytes,
                        InstanceID instance_id,
@@ -195,7 +672,8 @@ void Client::async_get(void* addr,
     CHECK_EQ(request.m_request, nullptr);
     CHECK(request.m_state == Request::State::Init);
 
-    const auto& ep = endpoint(instance_id);
+    auto endpoint  = endpoint_shared(instance_id);
+    const auto& ep = *endpoint;
 
     {
         auto rc =
@@ -207,16 +685,27 @@ void Client::async_get(void* addr,
         }
     }
 
-    async_get(addr,
-              bytes,
-              ep,
-              reinterpret_cast<std::uint64_t>(remote_addr),
-              reinterpret_cast<ucp_rkey_h>(request.m_rkey),
-              request);
+    async_striped_get(addr,
+                      bytes,
+                      ep,
+                      reinterpret_cast<std::uint64_t>(remote_addr),
+                      reinterpret_cast<ucp_rkey_h>(request.m_rkey),
+                      request);
 }
 
 void Client::async_am_send(
     std::uint32_t id, const void* header, std::size_t header_length, const ucx::Endpoint& endpoint, Request& request)
+{
+    async_am_send(id, header, header_length, nullptr, 0, endpoint, request);
+}
+
+void Client::async_am_send(std::uint32_t id,
+                           const void* header,
+                           std::size_t header_length,
+                           const void* data,
+                           std::size_t data_length,
+                           const ucx::Endpoint& endpoint,
+                           Request& request)
 {
     CHECK_EQ(request.m_request, nullptr);
     CHECK(request.m_state == Request::State::Init);
@@ -227,7 +716,7 @@ void Client::async_am_send(
     params.cb.send      = Callbacks::send;
     params.user_data    = &request;
 
-    request.m_request = ucp_am_send_nbx(endpoint.handle(), id, header, header_length, nullptr, 0, &params);
+    request.m_request = ucp_am_send_nbx(endpoint.handle(), id, header, header_length, data, data_length, &params);
     CHECK(request.m_request);
     CHECK(!UCS_PTR_IS_ERR(request.m_request));
 }
@@ -248,23 +737,117 @@ void Client::issue_remote_descriptor(RemoteDescriptorMessage&& msg)
     auto msg_length = proto.ByteSizeLong();
 
     // todo(ryan) - parameterize mrc::data_plane::client::max_remote_descriptor_eager_size
-    if (msg_length <= 1_MiB)
+    // messages which fit into the size of the preposted recvs issued by the data plane are sent eagerly; larger
+    // messages are probed by the data plane server and received into a buffer of the same transient pool block size
+    CHECK_LE(msg_length, m_transient_pool.block_size())
+        << "remote descriptor of " << msg_length << " bytes exceeds the transient pool block size";
+
+    // remote descriptors to the same instance are aggregated into active messages, which need no pre-posted recvs on
+    // the remote side
+    if (m_enable_active_messages)
+    {
+        enqueue_active_message(msg.endpoint, msg.tag, msg_length, [&proto](void* dst) {
+            CHECK(proto.SerializeToArray(dst, proto.GetCachedSize()));
+        });
+        return;
+    }
+
+    msg.tag |= (msg_length <= EGR_MSG_MAX_BYTES ? TAG_EGR_MSG : TAG_RND_MSG);
+
+    auto buffer = m_transient_pool.await_buffer(msg_length);
+    CHECK(proto.SerializeToArray(buffer.data(), buffer.bytes()));
+
+    Request request;
+    async_send(buffer.data(), buffer.bytes(), msg.tag, *msg.endpoint, request);
+
+    // await and yield the userspace thread until completed
+    CHECK(request.await_complete());
+}
+
+void Client::am_send(const InstanceID& instance_id, std::uint64_t tag, const void* data, std::size_t bytes)
+{
+    CHECK_LE(tag, TAG_USER_MASK);
+    auto endpoint = endpoint_shared(instance_id);
+    enqueue_active_message(endpoint, tag, bytes, [data, bytes](void* dst) { std::memcpy(dst, data, bytes); });
+}
+
+void Client::enqueue_active_message(const std::shared_ptr<ucx::Endpoint>& endpoint,
+                                    std::uint64_t tag,
+                                    std::size_t bytes,
+                                    const std::function<void(void*)>& write_fn)
+{
+    DCHECK(endpoint);
+    const auto frame_bytes = active_message_frame_bytes(bytes);
+
+    std::unique_lock<Mutex> lock(m_active_message_mutex);
+    auto [search, created] = m_active_message_batches.try_emplace(endpoint.get());
+    auto& batch            = search->second;
+    if (created)
     {
-        auto buffer = m_transient_pool.await_buffer(msg_length);
-        CHECK(proto.SerializeToArray(buffer.data(), buffer.bytes()));
+        batch.stream = m_next_active_message_stream++;
+    }
+    batch.users++;
+
+    // bound the bytes pending behind the active message in flight; a message larger than a batch is sent on its own
+    m_active_message_cv.wait(lock, [&] {
+        return batch.pending.empty() || batch.pending.size() + frame_bytes <= m_active_message_batch_bytes;
+    });
 
-        // the message fits into the size of the preposted recvs issued by the data plane
-        msg.tag |= TAG_EGR_MSG;
+    const ActiveMessageFrame frame{tag, bytes};
+    const auto offset = batch.pending.size();
+    batch.pending.resize(offset + frame_bytes);
+    std::memcpy(batch.pending.data() + offset, &frame, sizeof(frame));
+    write_fn(batch.pending.data() + offset + sizeof(frame));
 
-        Request request;
-        async_send(buffer.data(), buffer.bytes(), msg.tag, *msg.endpoint, request);
+    if (!batch.sending)
+    {
+        // this fiber sends the pending batches until no more messages were queued while one was in flight
+        batch.sending = true;
+        while (!batch.pending.empty())
+        {
+            std::vector<std::byte> payload;
+            std::swap(payload, batch.spare);
+            std::swap(payload, batch.pending);
+            const ActiveMessageHeader header{batch.stream, batch.next_sequence++};
+            m_active_message_cv.notify_all();
+            lock.unlock();
+
+            DVLOG(20) << "sending active message " << header.sequence << " of " << payload.size() << " bytes";
+            Request request;
+            async_am_send(
+                AM_DATA_PLANE_MSG, &header, sizeof(header), payload.data(), payload.size(), *endpoint, request);
+            CHECK(request.await_complete());
+
+            lock.lock();
+            // keep the allocation of regular batches for the next one
+            if (payload.capacity() <= 2 * m_active_message_batch_bytes)
+            {
+                payload.clear();
+                batch.spare = std::move(payload);
+            }
+        }
+        batch.sending = false;
+    }
 
-        // await and yield the userspace thread until completed
-        CHECK(request.await_complete());
+    // the batch is kept while the endpoint is cached, so its stream continues with the next active message
+    batch.users--;
+}
+
+void Client::forget_active_message_batches(const std::vector<std::shared_ptr<ucx::Endpoint>>& endpoints)
+{
+    if (endpoints.empty())
+    {
+        return;
     }
-    else
+
+    std::lock_guard<Mutex> lock(m_active_message_mutex);
+    for (const auto& endpoint : endpoints)
     {
-        LOG(FATAL) << "implement the rendez-vous path (nb_probe) on the server side";
+        auto search = m_active_message_batches.find(endpoint.get());
+        if (search != m_active_message_batches.end() && search->second.users == 0)
+        {
+            m_active_message_batches.erase(search);
+        }
     }
 }
 
@@ -274,6 +857,24 @@ node::SourceChannelWriteable<RemoteDescriptorMessage>& Client::remote_descriptor
     return *m_rd_channel;
 }
 
+void Client::issue_remote_descriptor(RemoteDescriptorMessage&& msg, cudaStream_t stream)
+{
+    CHECK(m_rd_channel);
+    DCHECK(msg.rd);
+
+    auto rd = std::make_unique<StreamOrderedRemoteDescriptor>();
+    rd->channel = m_rd_channel.get();
+    rd->pending = &m_stream_ordered_rds;
+    rd->msg     = std::move(msg);
+
+    m_stream_ordered_rds++;
+    auto rc = cudaLaunchHostFunc(stream, issue_stream_ordered_remote_descriptor, rd.get());
+    CHECK_EQ(rc, cudaSuccess) << "failed to enqueue a remote descriptor on a stream: " << cudaGetErrorString(rc);
+
+    // owned by the host function once enqueued
+    rd.release();
+}
+
 void Client::do_service_start()
 {
     CHECK(m_rd_channel);
@@ -301,6 +902,11 @@ void Client::do_service_await_live()
 
 void Client::do_service_stop()
 {
+    // the host functions of pending stream-ordered remote descriptors write to the rd channel
+    while (m_stream_ordered_rds > 0)
+    {
+        boost::this_fiber::yield();
+    }
     m_rd_channel.reset();
 }
 
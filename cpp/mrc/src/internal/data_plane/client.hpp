@@ -17,6 +17,7 @@
 
 #pragma once
 
+#include "internal/data_plane/pull_throttle.hpp"
 #include "internal/resources/partition_resources_base.hpp"
 #include "internal/service.hpp"
 #include "internal/ucx/worker.hpp"
@@ -24,24 +25,36 @@
 #include "mrc/runtime/remote_descriptor.hpp"
 #include "mrc/types.hpp"
 
+#include <cuda_runtime_api.h>
 #include <ucp/api/ucp_def.h>
 
+#include <atomic>
+#include <chrono>
 #include <cstddef>
 #include <cstdint>
+#include <functional>
+#include <list>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <vector>
 
 namespace mrc::internal::control_plane::client {
 class ConnectionsManager;
 }  // namespace mrc::internal::control_plane::client
 namespace mrc::internal::memory {
+class HostResources;
 class TransientPool;
 }  // namespace mrc::internal::memory
 namespace mrc::internal::ucx {
 class Endpoint;
 class Resources;
 }  // namespace mrc::internal::ucx
+namespace mrc::memory {
+class const_iovec_view;
+class iovec_view;
+}  // namespace mrc::memory
 namespace mrc::node {
 template <typename T>
 class SourceChannelWriteable;
@@ -67,23 +80,80 @@ class Client final : public resources::PartitionResourceBase, private Service
     Client(resources::PartitionResourceBase& base,
            ucx::Resources& ucx,
            control_plane::client::ConnectionsManager& connections_manager,
+           memory::HostResources& host,
            memory::TransientPool& transient_pool);
     ~Client() final;
 
+    /**
+     * @brief Endpoint to a remote instance, created on first use and cached
+     *
+     * The cache is bounded by NetworkOptions::max_endpoints and NetworkOptions::endpoint_idle_timeout; evicted
+     * endpoints are recreated on their next use. Callers should hold the returned endpoint for as long as they issue
+     * operations on it.
+     */
     std::shared_ptr<ucx::Endpoint> endpoint_shared(const InstanceID& instance_id) const;
 
+    // creates the endpoints of instances expected to be used soon, e.g. the subscribers of a publisher
+    void prepare_endpoints(const std::vector<InstanceID>& instance_ids) const;
+
     // drop endpoint
     void drop_endpoint(const InstanceID& instance_id);
 
-    // number of established remote instances
+    // number of cached endpoints
     std::size_t endpoint_count() const;
 
     void async_p2p_recv(void* addr, std::size_t bytes, std::uint64_t tag, Request& request);
     void async_p2p_send(
         void* addr, std::size_t bytes, std::uint64_t tag, InstanceID instance_id, Request& request) const;
 
+    /**
+     * @brief Scatter/gather point-to-point transfers; all regions of the view are transferred as a single ucx iov
+     * operation, which may be matched by a contiguous transfer of the same total size on the remote side
+     *
+     * Device memory views require NetworkOptions::enable_gpudirect, since they are not staged.
+     */
+    void async_p2p_recv(const mrc::memory::iovec_view& iov, std::uint64_t tag, Request& request);
+    void async_p2p_send(const mrc::memory::const_iovec_view& iov,
+                        std::uint64_t tag,
+                        InstanceID instance_id,
+                        Request& request) const;
+
+    /**
+     * @brief Blocking point-to-point transfers of host or device memory
+     *
+     * Messages are transferred as chunks of NetworkOptions::staging_chunk_size bytes, so a p2p_send must be received
+     * with a p2p_recv of the same size and tag. When NetworkOptions::enable_gpudirect is disabled, device memory is
+     * staged through the pinned staging pool of the host partition: the device to host copy of a chunk overlaps the
+     * send of the previous chunks, and received chunks are copied to the device while the next chunks arrive.
+     */
+    void p2p_send(const void* addr, std::size_t bytes, std::uint64_t tag, InstanceID instance_id) const;
+    void p2p_recv(void* addr, std::size_t bytes, std::uint64_t tag) const;
+
     node::SourceChannelWriteable<RemoteDescriptorMessage>& remote_descriptor_channel();
 
+    /**
+     * @brief Issue a remote descriptor once all work enqueued on stream so far has completed
+     *
+     * Stream-ordered counterpart of writing msg to the remote_descriptor_channel for objects whose device buffers are
+     * produced on stream: neither the stream is synchronized nor the calling fiber blocked. A host function enqueued on
+     * the stream hands msg to the remote descriptor writers once the preceding work completes; the later work of the
+     * stream waits on the host function only while the remote descriptor channel is full.
+     */
+    void issue_remote_descriptor(RemoteDescriptorMessage&& msg, cudaStream_t stream);
+
+    /**
+     * @brief Send a message to the deserialize source of the data plane server of a remote instance as part of an
+     * aggregated active message
+     *
+     * Messages queued for an instance while an active message to it is in flight are aggregated into the next one, up
+     * to NetworkOptions::active_message_batch_bytes. Returns once the message is copied into the pending batch, or once
+     * it is sent if the calling fiber sends the batch.
+     */
+    void am_send(const InstanceID& instance_id, std::uint64_t tag, const void* data, std::size_t bytes);
+
+    // flow control of the rdma pulls of remote descriptor payloads issued by this partition
+    PullThrottle& pull_throttle();
+
     // primitive rdma and send/recv call
 
     static void async_get(void* addr,
@@ -93,6 +163,15 @@ class Client final : public resources::PartitionResourceBase, private Service
                           ucp_rkey_h rkey,
                           Request& request);
 
+    // issues the get as stripes of at most NetworkOptions::rma_stripe_size bytes; the concurrent stripes may be
+    // scheduled by ucx across multiple rails of the endpoint
+    void async_striped_get(void* addr,
+                           std::size_t bytes,
+                           const ucx::Endpoint& ep,
+                           std::uint64_t remote_addr,
+                           ucp_rkey_h rkey,
+                           Request& request) const;
+
     void async_get(void* addr,
                    std::size_t bytes,
                    InstanceID instance_id,
@@ -109,17 +188,76 @@ class Client final : public resources::PartitionResourceBase, private Service
     static void async_send(
         void* addr, std::size_t bytes, std::uint64_t tag, const ucx::Endpoint& endpoint, Request& request);
 
+    static void async_recv(const mrc::memory::iovec_view& iov,
+                           std::uint64_t tag,
+                           std::uint64_t mask,
+                           const ucx::Worker& worker,
+                           Request& request);
+    static void async_send(const mrc::memory::const_iovec_view& iov,
+                           std::uint64_t tag,
+                           const ucx::Endpoint& endpoint,
+                           Request& request);
+
     static void async_am_send(std::uint32_t id,
                               const void* header,
                               std::size_t header_length,
                               const ucx::Endpoint& endpoint,
                               Request& request);
+    static void async_am_send(std::uint32_t id,
+                              const void* header,
+                              std::size_t header_length,
+                              const void* data,
+                              std::size_t data_length,
+                              const ucx::Endpoint& endpoint,
+                              Request& request);
 
+    // the reference is only valid until the endpoint is evicted from the cache; prefer endpoint_shared
     const ucx::Endpoint& endpoint(const InstanceID& instance_id) const;
 
   private:
+    struct Chunk;
+
+    // messages pending to be aggregated into the next active message to an endpoint
+    struct ActiveMessageBatch
+    {
+        std::vector<std::byte> pending;
+        // reused as the payload of the active message in flight
+        std::vector<std::byte> spare;
+        bool sending{false};
+        std::size_t users{0};
+        // stream of the active messages to the endpoint, see ActiveMessageHeader
+        std::uint64_t stream{0};
+        std::uint64_t next_sequence{0};
+    };
+
+    struct CachedEndpoint
+    {
+        std::shared_ptr<ucx::Endpoint> endpoint;
+        std::chrono::steady_clock::time_point last_used;
+        std::list<InstanceID>::iterator lru;
+    };
+
+    // removes the least recently used endpoints beyond the capacity and the idle endpoints of the cache; the lock of
+    // the cache must be held
+    std::vector<std::shared_ptr<ucx::Endpoint>> evict_endpoints(std::chrono::steady_clock::time_point now) const;
+
     void issue_remote_descriptor(RemoteDescriptorMessage&& msg);
 
+    // appends the frame of a message written by write_fn to the batch of the endpoint; the first fiber finding no
+    // active message in flight sends the batches until none are pending
+    void enqueue_active_message(const std::shared_ptr<ucx::Endpoint>& endpoint,
+                                std::uint64_t tag,
+                                std::size_t bytes,
+                                const std::function<void(void*)>& write_fn);
+
+    // drops the active message batches of endpoints closed by the cache which are not in use
+    void forget_active_message_batches(const std::vector<std::shared_ptr<ucx::Endpoint>>& endpoints);
+
+    // true if addr is device memory which the nics can not access directly
+    bool use_staging(const void* addr) const;
+
+    std::size_t chunk_count(std::size_t bytes) const;
+
     void do_service_start() final;
     void do_service_await_live() final;
     void do_service_stop() final;
@@ -129,10 +267,34 @@ class Client final : public resources::PartitionResourceBase, private Service
     ucx::Resources& m_ucx;
     control_plane::client::ConnectionsManager& m_connnection_manager;
     memory::TransientPool& m_transient_pool;
-    mutable std::map<InstanceID, std::shared_ptr<ucx::Endpoint>> m_endpoints;
+    std::size_t m_rma_stripe_size;
+    memory::HostResources& m_host;
+    const bool m_gpudirect;
+    const std::size_t m_staging_chunk_size;
+    // copies between device memory and the staging buffers; null if the partition has no device
+    cudaStream_t m_staging_stream{nullptr};
+    const std::size_t m_max_endpoints;
+    const std::chrono::milliseconds m_idle_timeout;
+
+    mutable std::mutex m_endpoints_mutex;
+    mutable std::map<InstanceID, CachedEndpoint> m_endpoints;
+    // instance ids of the cached endpoints, most recently used first
+    mutable std::list<InstanceID> m_lru;
+    mutable std::chrono::steady_clock::time_point m_last_sweep;
+
+    PullThrottle m_pull_throttle;
+
+    const bool m_enable_active_messages;
+    const std::size_t m_active_message_batch_bytes;
+    Mutex m_active_message_mutex;
+    CondV m_active_message_cv;
+    std::map<const ucx::Endpoint*, ActiveMessageBatch> m_active_message_batches;
+    std::uint64_t m_next_active_message_stream;
 
     std::unique_ptr<mrc::runnable::Runner> m_rd_writer;
     std::unique_ptr<node::SourceChannelWriteable<RemoteDescriptorMessage>> m_rd_channel;
+    // remote descriptors awaiting the completion of their stream; the rd channel is kept open until they are issued
+    std::atomic<std::size_t> m_stream_ordered_rds{0};
 
     friend Resources;
 };
@@ -0,0 +1,171 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "internal/data_plane/pull_throttle.hpp"
+
+#include <glog/logging.h>
+
+#include <algorithm>
+#include <mutex>
+#include <utility>
+
+namespace mrc::internal::data_plane {
+
+PullPermit::PullPermit(PullThrottle* throttle, InstanceID instance_id, std::size_t bytes) :
+  m_throttle(throttle),
+  m_instance_id(instance_id),
+  m_bytes(bytes),
+  m_granted(std::chrono::steady_clock::now())
+{}
+
+PullPermit::~PullPermit()
+{
+    release();
+}
+
+PullPermit::PullPermit(PullPermit&& other) noexcept :
+  m_throttle(std::exchange(other.m_throttle, nullptr)),
+  m_instance_id(other.m_instance_id),
+  m_bytes(other.m_bytes),
+  m_granted(other.m_granted)
+{}
+
+PullPermit& PullPermit::operator=(PullPermit&& other) noexcept
+{
+    if (this != &other)
+    {
+        release();
+        m_throttle    = std::exchange(other.m_throttle, nullptr);
+        m_instance_id = other.m_instance_id;
+        m_bytes       = other.m_bytes;
+        m_granted     = other.m_granted;
+    }
+    return *this;
+}
+
+PullPermit::operator bool() const
+{
+    return m_throttle != nullptr;
+}
+
+void PullPermit::release()
+{
+    if (m_throttle != nullptr)
+    {
+        m_throttle->release(*this);
+        m_throttle = nullptr;
+    }
+}
+
+PullThrottle::PullThrottle(std::size_t max_bytes_in_flight,
+                           std::size_t max_window,
+                           std::chrono::microseconds latency_target) :
+  m_max_bytes_in_flight(max_bytes_in_flight),
+  m_max_window(max_window),
+  m_latency_target(latency_target)
+{
+    CHECK_GT(m_max_window, 0);
+}
+
+PullThrottle::~PullThrottle()
+{
+    DCHECK_EQ(m_bytes_in_flight, 0) << "pull throttle destroyed with pulls in flight";
+}
+
+PullPermit PullThrottle::acquire(InstanceID instance_id, std::size_t bytes)
+{
+    std::unique_lock lock(m_mutex);
+    auto& instance = m_instances.try_emplace(instance_id, Instance{static_cast<double>(m_max_window)}).first->second;
+    m_cv.wait(lock, [&] { return admissible(instance, bytes); });
+    admit(instance, bytes);
+    return {this, instance_id, bytes};
+}
+
+PullPermit PullThrottle::try_acquire(InstanceID instance_id, std::size_t bytes)
+{
+    std::lock_guard lock(m_mutex);
+    auto& instance = m_instances.try_emplace(instance_id, Instance{static_cast<double>(m_max_window)}).first->second;
+    if (!admissible(instance, bytes))
+    {
+        return {};
+    }
+    admit(instance, bytes);
+    return {this, instance_id, bytes};
+}
+
+std::size_t PullThrottle::bytes_in_flight() const
+{
+    std::lock_guard lock(m_mutex);
+    return m_bytes_in_flight;
+}
+
+std::size_t PullThrottle::window(InstanceID instance_id) const
+{
+    std::lock_guard lock(m_mutex);
+    auto search = m_instances.find(instance_id);
+    return (search == m_instances.end() ? m_max_window : static_cast<std::size_t>(search->second.window));
+}
+
+bool PullThrottle::admissible(const Instance& instance, std::size_t bytes) const
+{
+    if (instance.in_flight >= static_cast<std::size_t>(instance.window))
+    {
+        return false;
+    }
+    return (m_max_bytes_in_flight == 0 || m_bytes_in_flight == 0 ||
+            m_bytes_in_flight + bytes <= m_max_bytes_in_flight);
+}
+
+void PullThrottle::admit(Instance& instance, std::size_t bytes)
+{
+    instance.in_flight++;
+    m_bytes_in_flight += bytes;
+}
+
+void PullThrottle::release(const PullPermit& permit)
+{
+    const auto latency = std::chrono::steady_clock::now() - permit.m_granted;
+
+    std::lock_guard lock(m_mutex);
+    auto& instance = m_instances.at(permit.m_instance_id);
+    DCHECK_GT(instance.in_flight, 0);
+    DCHECK_GE(m_bytes_in_flight, permit.m_bytes);
+    instance.in_flight--;
+    m_bytes_in_flight -= permit.m_bytes;
+
+    if (m_latency_target.count() > 0)
+    {
+        instance.since_decrease++;
+        if (latency <= m_latency_target)
+        {
+            // additive increase of one pull per window of pulls
+            instance.window = std::min<double>(m_max_window, instance.window + 1.0 / instance.window);
+        }
+        else if (instance.since_decrease >= static_cast<std::size_t>(instance.window))
+        {
+            // multiplicative decrease, once per window so the pulls issued before the decrease do not compound it
+            instance.window         = std::max(1.0, instance.window / 2);
+            instance.since_decrease = 0;
+            DVLOG(10) << "pull latency target exceeded; window of instance " << permit.m_instance_id
+                      << " decreased to " << instance.window;
+        }
+    }
+
+    m_cv.notify_all();
+}
+
+}  // namespace mrc::internal::data_plane
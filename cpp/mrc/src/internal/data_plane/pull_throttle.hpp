@@ -0,0 +1,122 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "mrc/types.hpp"
+#include "mrc/utils/macros.hpp"
+
+#include <chrono>
+#include <cstddef>
+#include <map>
+
+namespace mrc::internal::data_plane {
+
+class PullThrottle;
+
+/**
+ * @brief Admission of a single rdma pull by a PullThrottle
+ *
+ * Releasing the permit, or destroying it, returns its bytes and its slot in the window of the remote instance and
+ * reports the time since the permit was granted as the latency of the pull.
+ */
+class PullPermit final
+{
+  public:
+    PullPermit() = default;
+    ~PullPermit();
+
+    PullPermit(PullPermit&& other) noexcept;
+    PullPermit& operator=(PullPermit&& other) noexcept;
+
+    DELETE_COPYABILITY(PullPermit);
+
+    // false for the empty permit returned by a rejected try_acquire
+    explicit operator bool() const;
+
+    void release();
+
+  private:
+    PullPermit(PullThrottle* throttle, InstanceID instance_id, std::size_t bytes);
+
+    PullThrottle* m_throttle{nullptr};
+    InstanceID m_instance_id{0};
+    std::size_t m_bytes{0};
+    std::chrono::steady_clock::time_point m_granted;
+
+    friend PullThrottle;
+};
+
+/**
+ * @brief Receiver side flow control of the rdma pulls of remote descriptor payloads
+ *
+ * Bounds the bytes of all pulls in flight and the number of concurrent pulls from each remote instance to a window of
+ * at most max_window pulls. A pull larger than max_bytes_in_flight is admitted once no other pull is in flight.
+ *
+ * With a latency target, the window of a remote instance adapts AIMD-style: every window of pulls completing within the
+ * target grows it by one pull, while a pull exceeding the target halves it, at most once per window of pulls. Rising
+ * latencies of the pulls from an instance indicate that its nic is saturated, e.g. by many subscribers pulling from one
+ * publisher, so backing off avoids the collapse of the throughput of all of them.
+ */
+class PullThrottle final
+{
+  public:
+    PullThrottle(std::size_t max_bytes_in_flight, std::size_t max_window, std::chrono::microseconds latency_target);
+    ~PullThrottle();
+
+    DELETE_COPYABILITY(PullThrottle);
+    DELETE_MOVEABILITY(PullThrottle);
+
+    // blocks the calling fiber until the pull may be issued
+    PullPermit acquire(InstanceID instance_id, std::size_t bytes);
+
+    // empty permit if the pull may not be issued now
+    PullPermit try_acquire(InstanceID instance_id, std::size_t bytes);
+
+    std::size_t bytes_in_flight() const;
+
+    // concurrent pulls currently allowed from instance_id
+    std::size_t window(InstanceID instance_id) const;
+
+  private:
+    struct Instance
+    {
+        double window;
+        std::size_t in_flight{0};
+        // completions since the window was last decreased
+        std::size_t since_decrease{0};
+    };
+
+    // the lock must be held
+    bool admissible(const Instance& instance, std::size_t bytes) const;
+    void admit(Instance& instance, std::size_t bytes);
+
+    void release(const PullPermit& permit);
+
+    const std::size_t m_max_bytes_in_flight;
+    const std::size_t m_max_window;
+    const std::chrono::microseconds m_latency_target;
+
+    mutable Mutex m_mutex;
+    CondV m_cv;
+    std::size_t m_bytes_in_flight{0};
+    std::map<InstanceID, Instance> m_instances;
+
+    friend PullPermit;
+};
+
+}  // namespace mrc::internal::data_plane
@@ -17,13 +17,30 @@
 
 #include "internal/data_plane/request.hpp"
 
-#include <boost/fiber/operations.hpp>
+#include "mrc/coroutines/when_all.hpp"
+
 #include <glog/logging.h>
 
 #include <ostream>
+#include <utility>
 
 namespace mrc::internal::data_plane {
 
+namespace {
+
+// awaitable of a request by reference, as coroutines::when_all moves its awaitables
+struct RequestRef
+{
+    Request* request;
+
+    Request::Awaiter operator co_await() const noexcept
+    {
+        return request->operator co_await();
+    }
+};
+
+}  // namespace
+
 Request::Request() = default;
 
 Request::~Request()
@@ -33,18 +50,33 @@ Request::~Request()
 
 void Request::reset()
 {
-    m_state   = State::Init;
-    m_request = nullptr;
+    m_state       = State::Init;
+    m_request     = nullptr;
+    m_outstanding = 1;
+    m_completion.reset();
+    m_iov.clear();
+}
+
+bool Request::in_use() const
+{
+    return m_state != State::Init;
 }
 
 bool Request::await_complete()
 {
     CHECK(m_state > State::Init);
-    while (m_state == State::Running)
-    {
-        boost::this_fiber::yield();
-    }
+    m_completion.await();
+    return finish();
+}
 
+void Request::complete(State state)
+{
+    m_state.store(state, std::memory_order_release);
+    m_completion.complete();
+}
+
+bool Request::finish()
+{
     if (m_state == State::OK)
     {
         reset();
@@ -60,4 +92,28 @@ bool Request::await_complete()
     LOG(FATAL) << "error in ucx callback";
 }
 
+bool Request::Awaiter::await_resume()
+{
+    Completion<void>::Awaiter::await_resume();
+    CHECK(m_request->m_state > State::Running);
+    return m_request->finish();
+}
+
+coroutines::Task<bool> when_all(std::vector<std::reference_wrapper<Request>> requests)
+{
+    std::vector<RequestRef> awaiters;
+    awaiters.reserve(requests.size());
+    for (auto& request : requests)
+    {
+        awaiters.push_back({&request.get()});
+    }
+
+    bool completed = true;
+    for (auto& task : co_await coroutines::when_all(std::move(awaiters)))
+    {
+        completed = task.return_value() && completed;
+    }
+    co_return completed;
+}
+
 }  // namespace mrc::internal::data_plane
@@ -17,18 +17,49 @@
 
 #pragma once
 
+#include "mrc/core/completion.hpp"
+#include "mrc/coroutines/task.hpp"
 #include "mrc/utils/macros.hpp"
 
+#include <ucp/api/ucp_def.h>
+
 #include <atomic>
+#include <cstddef>
+#include <functional>
+#include <vector>
 
 namespace mrc::internal::data_plane {
 
 class Callbacks;
 class Client;
 
+/**
+ * @brief Completion state of an asynchronous data plane operation
+ *
+ * A request is either awaited by a fiber or thread with await_complete, which blocks until the operation completes, or
+ * by a coroutine with co_await, which suspends until the completion callback of the operation resumes it onto the
+ * thread pool it was suspended from; both wait on the Completion embedded in the request. Both return true if the
+ * operation completed and false if it was cancelled; afterwards the request may be reused for another operation.
+ */
 class Request final
 {
+    enum class State;
+
   public:
+    class Awaiter : public Completion<void>::Awaiter
+    {
+      public:
+        explicit Awaiter(Request& request) noexcept :
+          Completion<void>::Awaiter(request.m_completion),
+          m_request(&request)
+        {}
+
+        bool await_resume();
+
+      private:
+        Request* m_request;
+    };
+
     Request();
     ~Request();
 
@@ -38,6 +69,14 @@ class Request final
     // std::optional<Status> is_complete();
     bool await_complete();
 
+    Awaiter operator co_await() noexcept
+    {
+        return Awaiter(*this);
+    }
+
+    // true from issuing an operation until it has been awaited
+    bool in_use() const;
+
     // attempts to cancel the request
     // the request will either be cancelled or completed
     // void try_cancel();
@@ -45,6 +84,12 @@ class Request final
   private:
     void reset();
 
+    // result of a completed operation; resets the request
+    bool finish();
+
+    // called by the completion callbacks; releases the awaiting fiber, thread or coroutine, if any
+    void complete(State state);
+
     enum class State
     {
         Init,
@@ -54,11 +99,21 @@ class Request final
         Error
     };
     std::atomic<State> m_state{State::Init};
+    Completion<void> m_completion;
     void* m_request{nullptr};
     void* m_rkey{nullptr};
+    // number of ucx operations, e.g. the stripes of a get, which must complete before the request completes
+    std::atomic<std::size_t> m_outstanding{1};
+    // iov list of a scatter/gather transfer, which ucx requires to remain valid until the transfer completes
+    std::vector<ucp_dt_iov_t> m_iov;
 
     friend Client;
     friend Callbacks;
 };
 
+/**
+ * @brief Awaits all requests, e.g. the gets of a pipelined transfer; true if none of the requests was cancelled
+ */
+coroutines::Task<bool> when_all(std::vector<std::reference_wrapper<Request>> requests);
+
 }  // namespace mrc::internal::data_plane
@@ -19,6 +19,7 @@
 
 #include "internal/control_plane/client.hpp"
 #include "internal/data_plane/client.hpp"
+#include "internal/data_plane/request.hpp"
 #include "internal/data_plane/server.hpp"
 #include "internal/memory/host_resources.hpp"
 #include "internal/ucx/resources.hpp"
@@ -26,12 +27,22 @@
 
 #include "mrc/memory/literals.hpp"
 
+#include <glog/logging.h>
+
+#include <cstddef>
 #include <memory>
 
 namespace mrc::internal::data_plane {
 
 using namespace mrc::memory::literals;
 
+namespace {
+
+// upper bound of the pooled requests of a partition; requests beyond it are awaited from the pool
+constexpr std::size_t RequestPoolCapacity = 4096;
+
+}  // namespace
+
 Resources::Resources(resources::PartitionResourceBase& base,
                      ucx::Resources& ucx,
                      memory::HostResources& host,
@@ -43,8 +54,12 @@ Resources::Resources(resources::PartitionResourceBase& base,
   m_control_plane_client(control_plane_client),
   m_instance_id(instance_id),
   m_transient_pool(32_MiB, 4, m_host.registered_memory_resource()),
+  m_request_pool(mrc::data::CachedReusablePool<Request>::create(
+      RequestPoolCapacity,
+      [] { return std::make_unique<Request>(); },
+      [](Request& request) { CHECK(!request.in_use()) << "a request was returned to the pool before being awaited"; })),
   m_server(std::make_unique<Server>(base, ucx, host, m_transient_pool, m_instance_id)),
-  m_client(std::make_unique<Client>(base, ucx, m_control_plane_client.connections(), m_transient_pool))
+  m_client(std::make_unique<Client>(base, ucx, m_control_plane_client.connections(), host, m_transient_pool))
 {
     // ensure the data plane progress engine is up and running
     service_start();
@@ -61,6 +76,11 @@ Client& Resources::client()
     return *m_client;
 }
 
+mrc::data::CachedReusablePool<Request>& Resources::request_pool()
+{
+    return *m_request_pool;
+}
+
 // Server& Resources::server()
 // {
 //     return m_server;
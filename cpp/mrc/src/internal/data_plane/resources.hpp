@@ -21,6 +21,7 @@
 #include "internal/resources/partition_resources_base.hpp"
 #include "internal/service.hpp"
 
+#include "mrc/data/cached_reusable_pool.hpp"
 #include "mrc/runnable/launch_options.hpp"
 #include "mrc/types.hpp"
 
@@ -44,6 +45,7 @@ class Resources;
 
 namespace mrc::internal::data_plane {
 class Client;
+class Request;
 class Server;
 
 /**
@@ -63,6 +65,10 @@ class Resources final : private Service, private resources::PartitionResourceBas
     Client& client();
     Server& server();
 
+    // requests reused across operations, so issuing an operation does not allocate; a request must be awaited before
+    // it is returned to the pool
+    mrc::data::CachedReusablePool<Request>& request_pool();
+
     const InstanceID& instance_id() const;
     std::string ucx_address() const;
     const ucx::RegistrationCache& registration_cache() const;
@@ -82,6 +88,7 @@ class Resources final : private Service, private resources::PartitionResourceBas
     InstanceID m_instance_id;
 
     memory::TransientPool m_transient_pool;
+    std::shared_ptr<mrc::data::CachedReusablePool<Request>> m_request_pool;
     std::unique_ptr<Server> m_server;
     std::unique_ptr<Client> m_client;
 
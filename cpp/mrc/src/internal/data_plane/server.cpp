@@ -17,18 +17,22 @@
 
 #include "internal/data_plane/server.hpp"
 
+#include "internal/data_plane/active_message.hpp"
 #include "internal/data_plane/tags.hpp"
 #include "internal/runnable/resources.hpp"
+#include "internal/system/system.hpp"
 #include "internal/ucx/common.hpp"
 #include "internal/ucx/resources.hpp"
 #include "internal/ucx/worker.hpp"
 
 #include "mrc/core/task_queue.hpp"
-#include "mrc/memory/literals.hpp"
+#include "mrc/metrics/registry.hpp"
 #include "mrc/node/edge_builder.hpp"
 #include "mrc/node/generic_source.hpp"
 #include "mrc/node/operators/router.hpp"
 #include "mrc/node/source_channel.hpp"
+#include "mrc/options/network.hpp"
+#include "mrc/options/options.hpp"
 #include "mrc/runnable/context.hpp"
 #include "mrc/runnable/launch_control.hpp"
 #include "mrc/runnable/launch_options.hpp"
@@ -44,10 +48,17 @@
 #include <ucp/api/ucp_def.h>
 #include <ucs/type/status.h>
 
+#include <algorithm>
+#include <chrono>
 #include <cstddef>
 #include <cstdint>
-#include <cstdlib>
+#include <cstring>
+#include <list>
+#include <map>
+#include <memory>
+#include <new>
 #include <ostream>
+#include <string>
 #include <utility>
 
 namespace mrc::internal::data_plane {
@@ -66,6 +77,46 @@ void zero_bytes_completion_handler(void* request,
     ucp_request_free(request);
 }
 
+/**
+ * Header of the TransientBuffer a rendezvous message is received into. The message is received into the bytes which
+ * follow the header, so a single pooled allocation, already registered with ucx, carries both the message and its
+ * in-flight state. The header is destroyed when the recv completes; the message is returned to the pool when the
+ * decoded object releases it.
+ */
+struct InFlightRecv
+{
+    memory::TransientBuffer block;
+    std::uint64_t tag;
+    void* data;
+    std::size_t bytes;
+    rxcpp::subscriber<network_event_t>* subscriber;
+};
+
+void rendezvous_recv_callback(void* request, ucs_status_t status, const ucp_tag_recv_info_t* msg_info, void* user_data)
+{
+    DCHECK(user_data);
+    if (status != UCS_OK)
+    {
+        LOG(FATAL) << "data_plane: rendezvous_recv_callback failed with status: " << ucs_status_string(status);
+    }
+    ucp_request_free(request);
+
+    // unpack the header before destroying it; the block holding the header and the message is kept alive by block
+    auto* in_flight  = static_cast<InFlightRecv*>(user_data);
+    auto block       = std::move(in_flight->block);
+    auto tag         = in_flight->tag;
+    auto* data       = in_flight->data;
+    auto bytes       = in_flight->bytes;
+    auto* subscriber = in_flight->subscriber;
+    in_flight->~InFlightRecv();
+
+    // create a shallow copy of the transient buffer covering only the received message
+    memory::TransientBuffer buffer(data, bytes, block);
+    block.release();
+
+    subscriber->on_next(std::make_pair(tag, std::move(buffer)));
+}
+
 static void pre_post_recv(detail::PrePostedRecvInfo* info);
 
 void pre_posted_recv_callback(void* request, ucs_status_t status, const ucp_tag_recv_info_t* msg_info, void* user_data)
@@ -78,6 +129,9 @@ void pre_posted_recv_callback(void* request, ucs_status_t status, const ucp_tag_
         auto tag    = decode_user_bits(msg_info->sender_tag);
         auto length = msg_info->length;
         ucp_request_free(request);
+        info->request = nullptr;
+        info->busy    = true;
+        info->owner->on_arrival();
 
         // create a shallow copy of the transient buffer with received buffer size
         DCHECK_LE(length, info->buffer.bytes());
@@ -85,6 +139,15 @@ void pre_posted_recv_callback(void* request, ucs_status_t status, const ucp_tag_
 
         // write tag to channel - create a shallow copy of the transient buffer with received buffer size
         info->channel->await_write(std::make_pair(tag, std::move(buffer)));
+        info->busy = false;
+        info->owner->on_emitted();
+
+        // the pool shrank while the message was emitted
+        if (info->retiring)
+        {
+            info->buffer.release();
+            return;
+        }
 
         // create a new transient buffer
         info->buffer = info->pool->await_buffer(info->buffer.bytes());
@@ -96,6 +159,7 @@ void pre_posted_recv_callback(void* request, ucs_status_t status, const ucp_tag_
     {
         ucp_request_free(info->request);
         info->request = nullptr;  // this ensures than cancel will not be called again if a kill is issued after stop
+        info->buffer.release();
     }
     else
     {
@@ -117,14 +181,161 @@ void pre_post_recv(detail::PrePostedRecvInfo* info)
     CHECK(!UCS_PTR_IS_ERR(info->request));
 }
 
-}  // namespace
+// emits each message aggregated into an active message as a shallow copy of the block holding the active message
+void emit_active_message_frames(const memory::TransientBuffer& block,
+                                std::byte* data,
+                                std::size_t bytes,
+                                node::SourceChannelWriteable<network_event_t>& channel)
+{
+    std::size_t offset = 0;
+    while (offset < bytes)
+    {
+        ActiveMessageFrame frame;
+        CHECK_LE(offset + sizeof(frame), bytes) << "truncated data plane active message";
+        std::memcpy(&frame, data + offset, sizeof(frame));
+        CHECK_LE(offset + active_message_frame_bytes(frame.bytes), bytes) << "truncated data plane active message";
+
+        memory::TransientBuffer buffer(data + offset + sizeof(frame), frame.bytes, block);
+        channel.await_write(std::make_pair(frame.tag, std::move(buffer)));
+        offset += active_message_frame_bytes(frame.bytes);
+    }
+}
 
-using namespace mrc::memory::literals;
+// emits the messages of an active message once all earlier active messages of its stream have been emitted
+void deliver_active_message(detail::ActiveMessageInfo& info,
+                            const ActiveMessageHeader& header,
+                            memory::TransientBuffer block,
+                            std::byte* data,
+                            std::size_t bytes)
+{
+    auto& stream = info.streams[header.stream];
+    if (header.sequence != stream.next_sequence)
+    {
+        DCHECK_GT(header.sequence, stream.next_sequence);
+        stream.pending.emplace(header.sequence, detail::PendingActiveMessage{std::move(block), data, bytes});
+        return;
+    }
+
+    emit_active_message_frames(block, data, bytes, *info.channel);
+    stream.next_sequence++;
+
+    // emit the active messages which overtook this one
+    auto it = stream.pending.begin();
+    while (it != stream.pending.end() && it->first == stream.next_sequence)
+    {
+        emit_active_message_frames(it->second.block, it->second.data, it->second.bytes, *info.channel);
+        stream.next_sequence++;
+        it = stream.pending.erase(it);
+    }
+}
+
+/**
+ * Header of the TransientBuffer a rendezvous active message is received into, laid out as InFlightRecv.
+ */
+struct InFlightActiveMessage
+{
+    memory::TransientBuffer block;
+    std::byte* data;
+    std::size_t bytes;
+    ActiveMessageHeader header;
+    detail::ActiveMessageInfo* info;
+};
+
+void active_message_rndv_callback(void* request, ucs_status_t status, std::size_t length, void* user_data)
+{
+    DCHECK(user_data);
+    if (status != UCS_OK)
+    {
+        LOG(FATAL) << "data_plane: active_message_rndv_callback failed with status: " << ucs_status_string(status);
+    }
+    ucp_request_free(request);
+
+    auto* in_flight = static_cast<InFlightActiveMessage*>(user_data);
+    auto block      = std::move(in_flight->block);
+    auto* data      = in_flight->data;
+    auto bytes      = in_flight->bytes;
+    auto header     = in_flight->header;
+    auto* info      = in_flight->info;
+    in_flight->~InFlightActiveMessage();
+
+    DCHECK_EQ(length, bytes);
+    deliver_active_message(*info, header, std::move(block), data, bytes);
+}
+
+ucs_status_t active_message_callback(
+    void* arg, const void* header, size_t header_length, void* data, size_t length, const ucp_am_recv_param_t* param)
+{
+    auto* info = static_cast<detail::ActiveMessageInfo*>(arg);
+
+    ActiveMessageHeader am_header;
+    CHECK_EQ(header_length, sizeof(am_header)) << "data plane active message without a stream header";
+    std::memcpy(&am_header, header, sizeof(am_header));
+
+    if ((param->recv_attr & UCP_AM_RECV_ATTR_FLAG_RNDV) != 0)
+    {
+        // zero-copy: the rendezvous payload is received directly into a registered block of the transient pool; the
+        // messages it aggregates are emitted once the recv completes
+        const std::size_t block_bytes = sizeof(InFlightActiveMessage) + alignof(InFlightActiveMessage) + length;
+        CHECK_LE(block_bytes, info->pool->block_size())
+            << "active message of " << length << " bytes exceeds the transient pool block size";
+
+        auto block       = info->pool->await_buffer(block_bytes);
+        void* addr       = block.data();
+        std::size_t size = block.bytes();
+        CHECK(std::align(alignof(InFlightActiveMessage), sizeof(InFlightActiveMessage), addr, size));
+
+        auto* recv_addr = static_cast<std::byte*>(addr) + sizeof(InFlightActiveMessage);
+        auto* in_flight = new (addr) InFlightActiveMessage{std::move(block), recv_addr, length, am_header, info};
+
+        ucp_request_param_t params;
+        params.op_attr_mask = UCP_OP_ATTR_FIELD_CALLBACK | UCP_OP_ATTR_FIELD_USER_DATA | UCP_OP_ATTR_FLAG_NO_IMM_CMPL;
+        params.cb.recv_am   = active_message_rndv_callback;
+        params.user_data    = in_flight;
+
+        auto* request = ucp_am_recv_data_nbx(info->worker, data, recv_addr, length, &params);
+        CHECK(request);
+        CHECK(!UCS_PTR_IS_ERR(request));
+        return UCS_OK;
+    }
+
+    // eager payloads are only valid for the duration of the callback; they are copied once into a pooled block which
+    // the messages they aggregate share
+    CHECK_LE(length, info->pool->block_size())
+        << "active message of " << length << " bytes exceeds the transient pool block size";
+    auto block = info->pool->await_buffer(length);
+    std::memcpy(block.data(), data, length);
+    auto* block_data = static_cast<std::byte*>(block.data());
+    deliver_active_message(*info, am_header, std::move(block), block_data, length);
+    return UCS_OK;
+}
+
+std::map<std::string, std::string> instance_labels(InstanceID instance_id)
+{
+    return {{"instance_id", std::to_string(instance_id)}};
+}
+
+void set_active_message_handler(ucp_worker_h worker, detail::ActiveMessageInfo* info)
+{
+    ucp_am_handler_param params;
+    params.field_mask = UCP_AM_HANDLER_PARAM_FIELD_ID | UCP_AM_HANDLER_PARAM_FIELD_FLAGS |
+                        UCP_AM_HANDLER_PARAM_FIELD_CB | UCP_AM_HANDLER_PARAM_FIELD_ARG;
+    params.id    = AM_DATA_PLANE_MSG;
+    params.flags = UCP_AM_FLAG_WHOLE_MSG;
+    params.cb    = (info != nullptr ? active_message_callback : nullptr);
+    params.arg   = info;
+
+    CHECK_EQ(ucp_worker_set_am_recv_handler(worker, &params), UCS_OK);
+}
+
+}  // namespace
 
 class DataPlaneServerWorker final : public node::GenericSource<network_event_t>
 {
   public:
-    DataPlaneServerWorker(ucx::Worker& worker);
+    DataPlaneServerWorker(ucx::Worker& worker,
+                          memory::TransientPool& transient_pool,
+                          detail::PrePostedRecvPool* pre_posted_recvs,
+                          const NetworkOptions& options);
 
   private:
     void data_source(rxcpp::subscriber<network_event_t>& s) final;
@@ -134,11 +345,14 @@ class DataPlaneServerWorker final : public node::GenericSource<network_event_t>
                        const ucp_tag_recv_info_t& msg_info);
 
     ucx::Worker& m_worker;
+    memory::TransientPool& m_transient_pool;
+    detail::PrePostedRecvPool* m_pre_posted_recvs;
+    ucx::IdlePolicy m_idle_policy;
 
     // modify these to adjust the tag matching
-    // 0/0 is the equivalent of match all tags
-    ucp_tag_t m_tag{0};
-    ucp_tag_t m_tag_mask{0};
+    // only rendezvous messages are probed; eager messages are matched by the pre-posted recvs
+    ucp_tag_t m_tag{TAG_RND_MSG};
+    ucp_tag_t m_tag_mask{TAG_MSG_MASK};
 };
 
 Server::Server(resources::PartitionResourceBase& provider,
@@ -166,18 +380,21 @@ void Server::do_service_start()
             // this recv has no recv payload, we simply write the tag to the channel
             m_prepost_channel = std::make_unique<node::SourceChannelWriteable<network_event_t>>();
 
-            m_pre_posted_recv_info.resize(m_pre_posted_recv_count);
-            for (auto& info : m_pre_posted_recv_info)
+            // active messages aggregating eager sends are emitted on the same channel
+            m_active_message_info = {m_ucx.worker().handle(), m_prepost_channel.get(), &m_transient_pool};
+            set_active_message_handler(m_ucx.worker().handle(), &m_active_message_info);
+
+            // recvs only need to be pre-posted for eager tagged sends
+            if (!system().options().network().enable_active_messages())
             {
-                info.worker  = m_ucx.worker().handle();
-                info.channel = m_prepost_channel.get();
-                info.pool    = &m_transient_pool;
-                info.buffer  = m_transient_pool.await_buffer(1_MiB);
-                pre_post_recv(&info);
+                m_pre_posted_recvs = std::make_unique<detail::PrePostedRecvPool>(
+                    m_ucx.worker(), *m_prepost_channel, m_transient_pool, system().options().network(), m_instance_id);
+                m_pre_posted_recvs->start();
             }
 
             // source for ucx tag recvs with data
-            auto progress_engine = std::make_unique<DataPlaneServerWorker>(m_ucx.worker());
+            auto progress_engine = std::make_unique<DataPlaneServerWorker>(
+                m_ucx.worker(), m_transient_pool, m_pre_posted_recvs.get(), system().options().network());
 
             // router for ucx tag recvs with data
             m_deserialize_source = std::make_shared<node::Router<PortAddress, memory::TransientBuffer>>();
@@ -209,20 +426,12 @@ void Server::do_service_stop()
     m_ucx.network_task_queue()
         .enqueue([this] {
             // we need to cancel all preposted recvs before shutting down the progress engine
+            set_active_message_handler(m_ucx.worker().handle(), nullptr);
+
             DVLOG(10) << "data_plane server: cancelling all outstanding pre-posted recvs";
-            for (auto& info : m_pre_posted_recv_info)
+            if (m_pre_posted_recvs)
             {
-                if (info.request != nullptr)
-                {
-                    ucp_request_cancel(m_ucx.worker().handle(), info.request);
-                }
-
-                // we are on the network task queue thread, so we can pump the progress engine until
-                // the cancelled request is complete
-                while (info.request != nullptr)
-                {
-                    m_ucx.worker().progress();
-                }
+                m_pre_posted_recvs->cancel_all();
             }
         })
         .get();
@@ -256,46 +465,226 @@ node::Router<std::uint64_t, memory::TransientBuffer>& Server::deserialize_source
     return *m_deserialize_source;
 }
 
+PrePostedRecvStats Server::pre_posted_recv_stats() const
+{
+    return (m_pre_posted_recvs ? m_pre_posted_recvs->stats() : PrePostedRecvStats{});
+}
+
+// PrePostedRecvPool
+
+namespace detail {
+
+PrePostedRecvPool::PrePostedRecvPool(ucx::Worker& worker,
+                                     node::SourceChannelWriteable<network_event_t>& channel,
+                                     memory::TransientPool& transient_pool,
+                                     const NetworkOptions& options,
+                                     InstanceID instance_id) :
+  m_worker(worker),
+  m_channel(channel),
+  m_transient_pool(transient_pool),
+  m_min_recvs(options.min_pre_posted_recvs()),
+  m_max_recvs(options.max_pre_posted_recvs()),
+  m_window(options.pre_posted_recv_window()),
+  m_registry(std::make_unique<metrics::Registry>()),
+  m_recvs_gauge(m_registry->make_gauge("mrc_data_plane_pre_posted_recvs", instance_labels(instance_id))),
+  m_busy_gauge(m_registry->make_gauge("mrc_data_plane_pre_posted_recvs_busy", instance_labels(instance_id))),
+  m_arrivals_gauge(m_registry->make_gauge("mrc_data_plane_pre_posted_recv_arrivals", instance_labels(instance_id))),
+  m_unexpected_gauge(m_registry->make_gauge("mrc_data_plane_unexpected_eager_messages", instance_labels(instance_id)))
+{
+    CHECK_GT(m_min_recvs, 0);
+    CHECK_LE(m_min_recvs, m_max_recvs);
+}
+
+PrePostedRecvPool::~PrePostedRecvPool() = default;
+
+void PrePostedRecvPool::start()
+{
+    m_window_start = std::chrono::steady_clock::now();
+    resize(std::clamp<std::size_t>(InitialRecvs, m_min_recvs, m_max_recvs));
+    publish_metrics();
+}
+
+void PrePostedRecvPool::adapt()
+{
+    // recvs posted by resize match the unexpected messages already queued, so an unexpected message found here arrived
+    // after the last progress of the worker with all recvs busy or consumed
+    ucp_tag_recv_info_t msg_info;
+    if (ucp_tag_probe_nb(m_worker.handle(), TAG_EGR_MSG, TAG_MSG_MASK, 0, &msg_info) != nullptr)
+    {
+        m_unexpected.fetch_add(1, std::memory_order_relaxed);
+        m_window_unexpected++;
+        if (m_target < m_max_recvs)
+        {
+            DVLOG(10) << "data_plane server: growing the pre-posted recvs from " << m_target;
+            resize(std::min(m_target * 2, m_max_recvs));
+        }
+    }
+
+    const auto now = std::chrono::steady_clock::now();
+    if (now - m_window_start < m_window)
+    {
+        return;
+    }
+
+    if (m_window_unexpected == 0 && m_window_arrivals * 4 < m_target && m_target > m_min_recvs)
+    {
+        DVLOG(10) << "data_plane server: shrinking the pre-posted recvs from " << m_target;
+        resize(std::max(m_target / 2, m_min_recvs));
+    }
+
+    // erase the retired recvs whose cancellation or last message completed
+    m_recvs.remove_if([](const PrePostedRecvInfo& info) {
+        return info.retiring && info.request == nullptr && !info.busy;
+    });
+
+    m_window_start      = now;
+    m_window_arrivals   = 0;
+    m_window_unexpected = 0;
+    publish_metrics();
+}
+
+void PrePostedRecvPool::resize(std::size_t count)
+{
+    while (m_target < count)
+    {
+        auto& info   = m_recvs.emplace_back();
+        info.worker  = m_worker.handle();
+        info.channel = &m_channel;
+        info.pool    = &m_transient_pool;
+        info.owner   = this;
+        info.buffer  = m_transient_pool.await_buffer(EGR_MSG_MAX_BYTES);
+        pre_post_recv(&info);
+        m_target++;
+    }
+
+    // retire the most recently added recvs; busy recvs are retired once their message is emitted
+    for (auto it = m_recvs.rbegin(); it != m_recvs.rend() && m_target > count; ++it)
+    {
+        if (it->retiring)
+        {
+            continue;
+        }
+        it->retiring = true;
+        if (it->request != nullptr)
+        {
+            ucp_request_cancel(m_worker.handle(), it->request);
+        }
+        m_target--;
+    }
+
+    m_recvs_published.store(m_target, std::memory_order_relaxed);
+}
+
+void PrePostedRecvPool::cancel_all()
+{
+    for (auto& info : m_recvs)
+    {
+        info.retiring = true;
+        if (info.request != nullptr)
+        {
+            ucp_request_cancel(m_worker.handle(), info.request);
+        }
+
+        // we are on the network task queue thread, so we can pump the progress engine until
+        // the cancelled request is complete
+        while (info.request != nullptr)
+        {
+            m_worker.progress();
+        }
+    }
+    m_target = 0;
+    m_recvs_published.store(0, std::memory_order_relaxed);
+}
+
+PrePostedRecvStats PrePostedRecvPool::stats() const
+{
+    PrePostedRecvStats stats;
+    stats.recvs                = m_recvs_published.load(std::memory_order_relaxed);
+    stats.busy                 = m_busy.load(std::memory_order_relaxed);
+    stats.busy_high_water_mark = m_busy_high_water_mark.load(std::memory_order_relaxed);
+    stats.arrivals             = m_arrivals.load(std::memory_order_relaxed);
+    stats.unexpected           = m_unexpected.load(std::memory_order_relaxed);
+    return stats;
+}
+
+void PrePostedRecvPool::on_arrival()
+{
+    m_window_arrivals++;
+    m_arrivals.fetch_add(1, std::memory_order_relaxed);
+
+    auto busy = m_busy.fetch_add(1, std::memory_order_relaxed) + 1;
+    if (busy > m_busy_high_water_mark.load(std::memory_order_relaxed))
+    {
+        m_busy_high_water_mark.store(busy, std::memory_order_relaxed);
+    }
+}
+
+void PrePostedRecvPool::on_emitted()
+{
+    m_busy.fetch_sub(1, std::memory_order_relaxed);
+}
+
+void PrePostedRecvPool::publish_metrics()
+{
+    m_recvs_gauge.set(static_cast<double>(m_target));
+    m_busy_gauge.set(static_cast<double>(m_busy.load(std::memory_order_relaxed)));
+    m_arrivals_gauge.set(static_cast<double>(m_arrivals.load(std::memory_order_relaxed)));
+    m_unexpected_gauge.set(static_cast<double>(m_unexpected.load(std::memory_order_relaxed)));
+}
+
+}  // namespace detail
+
 // NetworkEventProgressEngine
 
-DataPlaneServerWorker::DataPlaneServerWorker(ucx::Worker& worker) : m_worker(worker) {}
+DataPlaneServerWorker::DataPlaneServerWorker(ucx::Worker& worker,
+                                             memory::TransientPool& transient_pool,
+                                             detail::PrePostedRecvPool* pre_posted_recvs,
+                                             const NetworkOptions& options) :
+  m_worker(worker),
+  m_transient_pool(transient_pool),
+  m_pre_posted_recvs(pre_posted_recvs),
+  m_idle_policy(worker, options)
+{}
 
 void DataPlaneServerWorker::data_source(rxcpp::subscriber<network_event_t>& s)
 {
     ucp_tag_message_h msg;
     ucp_tag_recv_info_t msg_info;
-    std::uint32_t backoff = 1;
 
     DVLOG(10) << "starting data plane server progress engine loop";
 
-    // the progress loop has tag_probe_nb disabled
-    // this should be re-enabled to accept tagged messages that have payloads
-    // larger than the pre-posted recv buffers
-
+    // eager messages are matched by the pre-posted recvs; messages larger than the pre-posted recv buffers are
+    // probed and received into a right-sized buffer from the transient pool
     while (true)
     {
         for (;;)
         {
-            // msg = ucp_tag_probe_nb(m_worker->handle(), m_tag, m_tag_mask, 1, &msg_info);
+            msg = ucp_tag_probe_nb(m_worker.handle(), m_tag, m_tag_mask, 1, &msg_info);
             if (!s.is_subscribed())
             {
                 DVLOG(10) << "exiting data plane server progress engine loop";
                 return;
             }
-            // if (msg != nullptr)
-            // {
-            //     break;
-            // }
+            if (msg != nullptr)
+            {
+                break;
+            }
             while (m_worker.progress() != 0U)
             {
-                backoff = 1;
+                m_idle_policy.reset();
+            }
+            if (m_pre_posted_recvs != nullptr)
+            {
+                m_pre_posted_recvs->adapt();
             }
 
+            // busy-poll under load; block on the worker's event fd once idle
+            m_idle_policy.wait_if_idle();
             boost::this_fiber::yield();
         }
 
-        // on_tagged_msg(s, msg, msg_info);
-        // backoff = 1;
+        on_tagged_msg(s, msg, msg_info);
+        m_idle_policy.reset();
     }
 }
 
@@ -322,17 +711,21 @@ void DataPlaneServerWorker::on_tagged_msg(rxcpp::subscriber<network_event_t>& su
                               UCP_OP_ATTR_FIELD_RECV_INFO |  // not sure if this is needed
                               UCP_OP_ATTR_FLAG_NO_IMM_CMPL;  // force the completion handler to be used
 
-        // todo(#139) - replace malloc with an unexpected receive / transactional memory_resource for
-        // ultra fast allocation
-        // in that work create a struct InFlightEncodedObject and allocate msg_info.length +
-        // sizeof(InFightEncodedObject) + alignment, and pass the starting pointer of that block to the user_data void*
-        // of the callback. Then unpack the struct and blob in the callback. The pointer to the subscriber is part of
-        // the InFlightEncodedObject which will remove the thread local storage pointer we are doing now.
+        // allocate the in-flight header and the message from the registered transient pool
+        const std::size_t block_bytes = sizeof(InFlightRecv) + alignof(InFlightRecv) + msg_info.length;
+        CHECK_LE(block_bytes, m_transient_pool.block_size())
+            << "rendezvous message of " << msg_info.length << " bytes exceeds the transient pool block size";
+
+        auto block       = m_transient_pool.await_buffer(block_bytes);
+        void* addr       = block.data();
+        std::size_t size = block.bytes();
+        CHECK(std::align(alignof(InFlightRecv), sizeof(InFlightRecv), addr, size));
 
         recv_bytes       = msg_info.length;
-        recv_addr        = std::malloc(recv_bytes);
-        params.user_data = recv_addr;
-        // params.cb.recv   = recv_completion_handler;
+        recv_addr        = static_cast<std::byte*>(addr) + sizeof(InFlightRecv);
+        params.user_data = new (addr) InFlightRecv{
+            std::move(block), decode_user_bits(msg_info.sender_tag), recv_addr, recv_bytes, &subscriber};
+        params.cb.recv = rendezvous_recv_callback;
         break;
     }
 
@@ -343,7 +736,7 @@ void DataPlaneServerWorker::on_tagged_msg(rxcpp::subscriber<network_event_t>& su
     void* status = ucp_tag_msg_recv_nbx(m_worker.handle(), recv_addr, recv_bytes, msg, &params);
     if (UCS_PTR_IS_ERR(status))
     {
-        LOG(FATAL) << "ucp_tag_msg_recv_nbx for 0-byte event failed";
+        LOG(FATAL) << "ucp_tag_msg_recv_nbx failed with status: " << ucs_status_string(UCS_PTR_STATUS(status));
     }
 }
 
@@ -22,22 +22,30 @@
 #include "internal/service.hpp"
 #include "internal/ucx/common.hpp"
 
+#include "mrc/metrics/gauge.hpp"
 #include "mrc/types.hpp"
 
 #include <ucp/api/ucp_def.h>
 
+#include <atomic>
+#include <chrono>
 #include <cstddef>
 #include <cstdint>
+#include <list>
+#include <map>
 #include <memory>
 #include <utility>
-#include <vector>
 
 namespace mrc::internal::memory {
 class HostResources;
 }  // namespace mrc::internal::memory
 namespace mrc::internal::ucx {
 class Resources;
+class Worker;
 }  // namespace mrc::internal::ucx
+namespace mrc::metrics {
+class Registry;
+}  // namespace mrc::metrics
 namespace mrc::node {
 template <typename KeyT, typename T>
 class Router;
@@ -47,6 +55,9 @@ class SourceChannelWriteable;
 namespace mrc::runnable {
 class Runner;
 }  // namespace mrc::runnable
+namespace mrc {
+class NetworkOptions;
+}  // namespace mrc
 
 // this node gets ucx tagged messages from ucp_tag_probe_nb
 // events which do not required a recv get pushed immediately to their downstream
@@ -73,7 +84,23 @@ namespace mrc::internal::data_plane {
 
 using network_event_t = std::pair<std::uint64_t, memory::TransientBuffer>;
 
+struct PrePostedRecvStats
+{
+    // recvs currently kept posted
+    std::size_t recvs{0};
+    // recvs whose message is being emitted before the recv is posted again
+    std::size_t busy{0};
+    // highest number of busy recvs observed
+    std::size_t busy_high_water_mark{0};
+    // eager messages received by the pre-posted recvs
+    std::size_t arrivals{0};
+    // number of times an eager message was found waiting with no recv posted
+    std::size_t unexpected{0};
+};
+
 namespace detail {
+class PrePostedRecvPool;
+
 struct PrePostedRecvInfo
 {
     ucp_worker_h worker;
@@ -81,6 +108,101 @@ struct PrePostedRecvInfo
     void* request;
     memory::TransientBuffer buffer;
     memory::TransientPool* pool;
+    PrePostedRecvPool* owner;
+    bool busy{false};
+    // not posted again once its request completes
+    bool retiring{false};
+};
+
+/**
+ * @brief Recvs pre-posted for eager tagged messages, resized by the progress engine from the observed traffic
+ *
+ * Each time the progress engine finds an eager message which arrived with no recv posted, the pool doubles, up to
+ * NetworkOptions::max_pre_posted_recvs. Once a window passes without unexpected messages and with fewer arrivals than
+ * a quarter of the posted recvs, the pool halves, down to NetworkOptions::min_pre_posted_recvs, returning the buffers
+ * of the retired recvs to the transient pool. Apart from stats, which may be called from any thread, the pool must be
+ * used from the thread which progresses the worker.
+ */
+class PrePostedRecvPool final
+{
+  public:
+    PrePostedRecvPool(ucx::Worker& worker,
+                      node::SourceChannelWriteable<network_event_t>& channel,
+                      memory::TransientPool& transient_pool,
+                      const NetworkOptions& options,
+                      InstanceID instance_id);
+    ~PrePostedRecvPool();
+
+    void start();
+
+    // checks for unexpected eager messages and resizes the pool; called by the progress engine on every iteration
+    void adapt();
+
+    // cancels all recvs, progressing the worker until their cancellation completed
+    void cancel_all();
+
+    PrePostedRecvStats stats() const;
+
+    // recv callbacks
+    void on_arrival();
+    void on_emitted();
+
+  private:
+    static constexpr std::size_t InitialRecvs = 16;
+
+    // posts or retires recvs until count recvs are kept posted
+    void resize(std::size_t count);
+    void publish_metrics();
+
+    ucx::Worker& m_worker;
+    node::SourceChannelWriteable<network_event_t>& m_channel;
+    memory::TransientPool& m_transient_pool;
+    const std::size_t m_min_recvs;
+    const std::size_t m_max_recvs;
+    const std::chrono::milliseconds m_window;
+
+    // stable addresses, since the recv callbacks hold a pointer to their element
+    std::list<PrePostedRecvInfo> m_recvs;
+    std::size_t m_target{0};
+
+    std::chrono::steady_clock::time_point m_window_start;
+    std::size_t m_window_arrivals{0};
+    std::size_t m_window_unexpected{0};
+
+    std::atomic<std::size_t> m_recvs_published{0};
+    std::atomic<std::size_t> m_busy{0};
+    std::atomic<std::size_t> m_busy_high_water_mark{0};
+    std::atomic<std::size_t> m_arrivals{0};
+    std::atomic<std::size_t> m_unexpected{0};
+
+    std::unique_ptr<metrics::Registry> m_registry;
+    metrics::Gauge m_recvs_gauge;
+    metrics::Gauge m_busy_gauge;
+    metrics::Gauge m_arrivals_gauge;
+    metrics::Gauge m_unexpected_gauge;
+};
+
+// a received active message whose predecessors in its stream are still in flight
+struct PendingActiveMessage
+{
+    memory::TransientBuffer block;
+    std::byte* data;
+    std::size_t bytes;
+};
+
+struct ActiveMessageStream
+{
+    std::uint64_t next_sequence{0};
+    std::map<std::uint64_t, PendingActiveMessage> pending;
+};
+
+struct ActiveMessageInfo
+{
+    ucp_worker_h worker;
+    node::SourceChannelWriteable<network_event_t>* channel;
+    memory::TransientPool* pool;
+    // <stream, state>; only accessed by the progress engine of the worker
+    std::map<std::uint64_t, ActiveMessageStream> streams;
 };
 }  // namespace detail
 
@@ -98,6 +220,9 @@ class Server final : public Service, public resources::PartitionResourceBase
 
     node::Router<PortAddress, memory::TransientBuffer>& deserialize_source();
 
+    // occupancy of the pre-posted recvs; all zeros if remote descriptors are sent as active messages
+    PrePostedRecvStats pre_posted_recv_stats() const;
+
   private:
     void do_service_start() final;
     void do_service_await_live() final;
@@ -105,8 +230,6 @@ class Server final : public Service, public resources::PartitionResourceBase
     void do_service_kill() final;
     void do_service_await_join() final;
 
-    const std::size_t m_pre_posted_recv_count{16};
-
     // ucx resources
     ucx::Resources& m_ucx;
     memory::HostResources& m_host;
@@ -123,8 +246,11 @@ class Server final : public Service, public resources::PartitionResourceBase
     // data will be emitted on this source as a conditional branch of data source
     std::unique_ptr<node::SourceChannelWriteable<network_event_t>> m_prepost_channel;
 
-    // pre-posted recv state
-    std::vector<detail::PrePostedRecvInfo> m_pre_posted_recv_info;
+    // recvs are only pre-posted if remote descriptors are not sent as active messages
+    std::unique_ptr<detail::PrePostedRecvPool> m_pre_posted_recvs;
+
+    // state of the active message handler, which emits on the same channel as the pre-posted recvs
+    detail::ActiveMessageInfo m_active_message_info{};
 
     // runner for the ucx progress engine event source
     std::unique_ptr<mrc::runnable::Runner> m_progress_engine;
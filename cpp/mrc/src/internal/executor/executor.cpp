@@ -17,24 +17,34 @@
 
 #include "internal/executor/executor.hpp"
 
+#include "internal/executor/metrics_server.hpp"
+#include "internal/pipeline/autoscaler.hpp"
+#include "internal/pipeline/graph_optimizer.hpp"
 #include "internal/pipeline/manager.hpp"
 #include "internal/pipeline/pipeline.hpp"
 #include "internal/pipeline/port_graph.hpp"
 #include "internal/pipeline/types.hpp"
 #include "internal/resources/manager.hpp"
+#include "internal/resources/partition_resources.hpp"
+#include "internal/segment/definition.hpp"
 #include "internal/system/resources.hpp"
 #include "internal/system/system.hpp"
 
 #include "mrc/core/addresses.hpp"
 #include "mrc/exceptions/runtime_error.hpp"
+#include "mrc/options/options.hpp"
+#include "mrc/options/scaling.hpp"
 
 #include <glog/logging.h>
 
+#include <exception>
 #include <map>
+#include <mutex>
 #include <ostream>
 #include <set>
 #include <string>
 #include <utility>
+#include <vector>
 
 namespace mrc::internal::executor {
 
@@ -55,10 +65,9 @@ Executor::~Executor()
     Service::call_in_destructor();
 }
 
-void Executor::register_pipeline(std::unique_ptr<pipeline::IPipeline> ipipeline)
+PipelineID Executor::register_pipeline(std::unique_ptr<pipeline::IPipeline> ipipeline)
 {
     CHECK(ipipeline);
-    CHECK(m_pipeline_manager == nullptr);
 
     auto pipeline = pipeline::Pipeline::unwrap(*ipipeline);
 
@@ -67,42 +76,170 @@ void Executor::register_pipeline(std::unique_ptr<pipeline::IPipeline> ipipeline)
         throw exceptions::MrcRuntimeError("pipeline validation failed");
     }
 
-    m_pipeline_manager = std::make_unique<pipeline::Manager>(pipeline, *m_resources_manager);
+    // rewrite placement and manifold policies from the segment/port graph
+    pipeline::GraphOptimizer optimizer(
+        *pipeline, system().options().manifolds(), m_resources_manager->partition_count());
+    optimizer.apply(*pipeline);
+
+    std::lock_guard lock(m_mutex);
+    auto id = m_next_pipeline_id++;
+    m_pipelines.emplace(id, std::move(pipeline));
+    if (m_started)
+    {
+        start_pipeline(id);
+    }
+    return id;
 }
 
-void Executor::do_service_start()
+void Executor::start_pipeline(PipelineID id)
 {
-    CHECK(m_pipeline_manager);
-    m_pipeline_manager->service_start();
+    auto pipeline = m_pipelines.at(id);
+    auto manager  = std::make_unique<pipeline::Manager>(pipeline, *m_resources_manager);
+
+    const auto& scaling_options = system().options().scaling();
+    const auto partition_count  = m_resources_manager->partition_count();
+
+    // ranks are spread round-robin over the partitions starting at the partition chosen by the graph optimizer,
+    // rotated by the partition assigned to the pipeline
+    const auto& definition = *pipeline;
+    const auto first       = m_next_partition;
+    m_next_partition       = (m_next_partition + 1) % partition_count;
 
     pipeline::SegmentAddresses initial_segments;
-    for (const auto& [id, segment] : m_pipeline_manager->pipeline().segments())
+    for (const auto& [segment_id, segment] : definition.segments())
     {
-        auto address              = segment_address_encode(id, 0);  // rank 0
-        initial_segments[address] = 0;                              // partition 0;
+        auto count = pipeline::Autoscaler::initial_count(
+            pipeline::Autoscaler::encode(scaling_options.segment_options(segment->name())));
+        auto offset = definition.partition_offset(segment->name()) + first;
+        for (SegmentRank rank = 0; rank < count; ++rank)
+        {
+            initial_segments[segment_address_encode(segment_id, rank)] = (offset + rank) % partition_count;
+        }
     }
-    m_pipeline_manager->push_updates(std::move(initial_segments));
+    manager->push_updates(std::move(initial_segments));
+
+    VLOG(10) << "executor started pipeline " << id << " from partition " << first;
+    m_pipeline_managers.emplace(id, std::move(manager));
+}
+
+void Executor::stop_pipeline(PipelineID id)
+{
+    std::lock_guard lock(m_mutex);
+    auto search = m_pipeline_managers.find(id);
+    if (search == m_pipeline_managers.end())
+    {
+        throw exceptions::MrcRuntimeError("pipeline " + std::to_string(id) + " is not running");
+    }
+    search->second->service_stop();
+}
+
+void Executor::join_pipeline(PipelineID id)
+{
+    std::unique_ptr<pipeline::Manager> manager;
+    {
+        std::lock_guard lock(m_mutex);
+        auto search = m_pipeline_managers.find(id);
+        if (search == m_pipeline_managers.end())
+        {
+            throw exceptions::MrcRuntimeError("pipeline " + std::to_string(id) + " is not running");
+        }
+        manager = std::move(search->second);
+        m_pipeline_managers.erase(search);
+        m_pipelines.erase(id);
+    }
+
+    // the other pipelines keep running while this one is awaited
+    manager->service_await_join();
+}
+
+std::size_t Executor::pipeline_count() const
+{
+    std::lock_guard lock(m_mutex);
+    return m_pipelines.size();
+}
+
+std::vector<pipeline::Manager*> Executor::managers() const
+{
+    std::lock_guard lock(m_mutex);
+    std::vector<pipeline::Manager*> managers;
+    for (const auto& [id, manager] : m_pipeline_managers)
+    {
+        managers.push_back(manager.get());
+    }
+    return managers;
+}
+
+void Executor::do_service_start()
+{
+    std::lock_guard lock(m_mutex);
+    CHECK(!m_pipelines.empty()) << "at least one pipeline must be registered before the executor is started";
+
+    if (system().options().enable_metrics_server())
+    {
+        m_metrics_server = std::make_unique<MetricsServer>(m_resources_manager->partition(0).runnable(),
+                                                           system().options().metrics_port());
+    }
+
+    for (const auto& [id, pipeline] : m_pipelines)
+    {
+        start_pipeline(id);
+    }
+    m_started = true;
 }
 
 void Executor::do_service_stop()
 {
-    CHECK(m_pipeline_manager);
-    m_pipeline_manager->service_stop();
+    for (auto* manager : managers())
+    {
+        manager->service_stop();
+    }
 }
 void Executor::do_service_kill()
 {
-    CHECK(m_pipeline_manager);
-    return m_pipeline_manager->service_kill();
+    for (auto* manager : managers())
+    {
+        manager->service_kill();
+    }
 }
 void Executor::do_service_await_live()
 {
-    CHECK(m_pipeline_manager);
-    m_pipeline_manager->service_await_live();
+    for (auto* manager : managers())
+    {
+        manager->service_await_live();
+    }
 }
 void Executor::do_service_await_join()
 {
-    CHECK(m_pipeline_manager);
-    m_pipeline_manager->service_await_join();
+    std::map<PipelineID, std::unique_ptr<pipeline::Manager>> managers;
+    {
+        std::lock_guard lock(m_mutex);
+        managers = std::move(m_pipeline_managers);
+        m_pipeline_managers.clear();
+        m_pipelines.clear();
+    }
+
+    // every pipeline is joined before the first error is rethrown
+    std::exception_ptr first_error;
+    for (auto& [id, manager] : managers)
+    {
+        try
+        {
+            manager->service_await_join();
+        } catch (...)
+        {
+            if (!first_error)
+            {
+                first_error = std::current_exception();
+            }
+        }
+    }
+    managers.clear();
+    m_metrics_server.reset();
+
+    if (first_error)
+    {
+        std::rethrow_exception(first_error);
+    }
 }
 
 // convert to std::expect
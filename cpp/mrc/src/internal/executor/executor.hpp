@@ -20,7 +20,14 @@
 #include "internal/service.hpp"
 #include "internal/system/system_provider.hpp"
 
+#include "mrc/types.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
 #include <memory>
+#include <mutex>
+#include <vector>
 
 namespace mrc {
 class Options;
@@ -28,6 +35,7 @@ class Options;
 namespace mrc::internal::pipeline {
 class IPipeline;
 class Manager;
+class Pipeline;
 }  // namespace mrc::internal::pipeline
 namespace mrc::internal::resources {
 class Manager;
@@ -37,10 +45,19 @@ class Resources;
 }  // namespace mrc::internal::system
 
 namespace mrc::internal::executor {
+class MetricsServer;
 
 /**
  * @brief Common Executor code used by both the Standalone and Architect Executors
  *
+ * An Executor hosts any number of pipelines on one set of system and partition resources, so the fiber pools, memory
+ * pools and network contexts are shared rather than duplicated per pipeline. Pipelines registered before the executor
+ * is started start with it; pipelines registered while it is running start immediately. Each pipeline can be stopped
+ * and joined independently of the others, while stopping, killing or joining the executor applies to all of them.
+ *
+ * The segments of successive pipelines are placed starting at successive partitions, so small pipelines spread over
+ * the partitions rather than all loading partition 0.
+ *
  * Issues #149 will begin to separate some of the functionality of ExeuctorBase into individual components.
  */
 class Executor : public Service, public system::SystemProvider
@@ -50,7 +67,16 @@ class Executor : public Service, public system::SystemProvider
     Executor(std::unique_ptr<system::Resources> resources);
     ~Executor() override;
 
-    void register_pipeline(std::unique_ptr<pipeline::IPipeline> ipipeline);
+    PipelineID register_pipeline(std::unique_ptr<pipeline::IPipeline> ipipeline);
+
+    // stop the sources of a pipeline; the pipeline completes once its segments have drained
+    void stop_pipeline(PipelineID id);
+
+    // await the completion of a pipeline and release it; rethrows the first error of the pipeline
+    void join_pipeline(PipelineID id);
+
+    // number of pipelines registered and not yet joined
+    std::size_t pipeline_count() const;
 
   private:
     void do_service_start() final;
@@ -59,8 +85,21 @@ class Executor : public Service, public system::SystemProvider
     void do_service_await_live() final;
     void do_service_await_join() final;
 
+    // constructs the manager of a registered pipeline and pushes its initial segments; called with m_mutex held
+    void start_pipeline(PipelineID id);
+
+    std::vector<pipeline::Manager*> managers() const;
+
     std::unique_ptr<resources::Manager> m_resources_manager;
-    std::unique_ptr<pipeline::Manager> m_pipeline_manager;
+    std::unique_ptr<MetricsServer> m_metrics_server;
+
+    mutable std::mutex m_mutex;
+    bool m_started{false};
+    PipelineID m_next_pipeline_id{0};
+    // partition the segments of the next pipeline started are placed from
+    std::uint32_t m_next_partition{0};
+    std::map<PipelineID, std::shared_ptr<pipeline::Pipeline>> m_pipelines;
+    std::map<PipelineID, std::unique_ptr<pipeline::Manager>> m_pipeline_managers;
 };
 
 std::unique_ptr<Executor> make_executor(std::shared_ptr<Options> options);
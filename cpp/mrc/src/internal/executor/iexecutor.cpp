@@ -24,6 +24,7 @@
 
 #include <glog/logging.h>
 
+#include <cstddef>
 #include <memory>
 #include <utility>
 
@@ -38,10 +39,28 @@ IExecutor::IExecutor(std::unique_ptr<system::IResources> resources) :
 
 IExecutor::~IExecutor() = default;
 
-void IExecutor::register_pipeline(std::unique_ptr<internal::pipeline::IPipeline> pipeline)
+PipelineID IExecutor::register_pipeline(std::unique_ptr<internal::pipeline::IPipeline> pipeline)
 {
     CHECK(m_impl);
-    m_impl->register_pipeline(std::move(pipeline));
+    return m_impl->register_pipeline(std::move(pipeline));
+}
+
+void IExecutor::stop_pipeline(PipelineID id)
+{
+    CHECK(m_impl);
+    m_impl->stop_pipeline(id);
+}
+
+void IExecutor::join_pipeline(PipelineID id)
+{
+    CHECK(m_impl);
+    m_impl->join_pipeline(id);
+}
+
+std::size_t IExecutor::pipeline_count() const
+{
+    CHECK(m_impl);
+    return m_impl->pipeline_count();
 }
 
 void IExecutor::start()
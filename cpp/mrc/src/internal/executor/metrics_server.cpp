@@ -0,0 +1,183 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2021-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "internal/executor/metrics_server.hpp"
+
+#include "internal/runnable/resources.hpp"
+#include "internal/system/resources.hpp"
+#include "internal/system/thread.hpp"
+
+#include "mrc/core/task_queue.hpp"
+#include "mrc/exceptions/runtime_error.hpp"
+#include "mrc/metrics/registry.hpp"
+
+#include <glog/logging.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <unistd.h>
+
+#include <array>
+#include <cerrno>
+#include <cstring>
+#include <string>
+#include <utility>
+
+namespace mrc::internal::executor {
+
+namespace {
+
+// interval at which the serving thread checks for shutdown while idle
+constexpr int ShutdownPollMs = 100;
+
+// requests larger than this are answered without reading the remainder
+constexpr std::size_t MaxRequestSize = 8192;
+
+void send_all(int fd, const std::string& data)
+{
+    std::size_t sent = 0;
+    while (sent < data.size())
+    {
+        auto rc = ::send(fd, data.data() + sent, data.size() - sent, MSG_NOSIGNAL);
+        if (rc <= 0)
+        {
+            if (rc < 0 && errno == EINTR)
+            {
+                continue;
+            }
+            DVLOG(10) << "metrics server: scraper disconnected before the response was sent";
+            return;
+        }
+        sent += rc;
+    }
+}
+
+std::string make_response(const std::string& status, const std::string& content_type, const std::string& body)
+{
+    std::string response = "HTTP/1.1 " + status + "\r\n";
+    response += "Content-Type: " + content_type + "\r\n";
+    response += "Content-Length: " + std::to_string(body.size()) + "\r\n";
+    response += "Connection: close\r\n\r\n";
+    response += body;
+    return response;
+}
+
+}  // namespace
+
+MetricsServer::MetricsServer(runnable::Resources& runnable, std::uint16_t port)
+{
+    m_listen_fd = ::socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (m_listen_fd < 0)
+    {
+        throw exceptions::MrcRuntimeError("metrics server: socket() failed: " + std::string(std::strerror(errno)));
+    }
+
+    int reuse = 1;
+    ::setsockopt(m_listen_fd, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+
+    sockaddr_in addr{};
+    addr.sin_family      = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_ANY);
+    addr.sin_port        = htons(port);
+
+    socklen_t addr_len = sizeof(addr);
+    if (::bind(m_listen_fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0 ||
+        ::listen(m_listen_fd, SOMAXCONN) != 0 ||
+        ::getsockname(m_listen_fd, reinterpret_cast<sockaddr*>(&addr), &addr_len) != 0)
+    {
+        auto error = std::string(std::strerror(errno));
+        ::close(m_listen_fd);
+        throw exceptions::MrcRuntimeError("metrics server: unable to listen on port " + std::to_string(port) + ": " +
+                                          error);
+    }
+    m_port = ntohs(addr.sin_port);
+
+    m_thread = std::make_unique<system::Thread>(
+        runnable.system_resources().make_thread("metrics_server", runnable.main().affinity(), [this] { serve(); }));
+
+    VLOG(1) << "metrics server listening on port " << m_port;
+}
+
+MetricsServer::~MetricsServer()
+{
+    m_running = false;
+    m_thread->join();
+    ::close(m_listen_fd);
+}
+
+std::uint16_t MetricsServer::port() const
+{
+    return m_port;
+}
+
+void MetricsServer::serve()
+{
+    while (m_running)
+    {
+        pollfd pfd{m_listen_fd, POLLIN, 0};
+        if (::poll(&pfd, 1, ShutdownPollMs) <= 0)
+        {
+            continue;
+        }
+
+        auto fd = ::accept4(m_listen_fd, nullptr, nullptr, SOCK_CLOEXEC);
+        if (fd < 0)
+        {
+            continue;
+        }
+
+        // a stalled scraper must not hold up the serving thread
+        timeval timeout{1, 0};
+        ::setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+        ::setsockopt(fd, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof(timeout));
+
+        respond(fd);
+        ::close(fd);
+    }
+}
+
+void MetricsServer::respond(int fd)
+{
+    // read the request headers; only the request line is used
+    std::string request;
+    std::array<char, 1024> buffer{};
+    while (request.find("\r\n\r\n") == std::string::npos && request.size() < MaxRequestSize)
+    {
+        auto rc = ::recv(fd, buffer.data(), buffer.size(), 0);
+        if (rc <= 0)
+        {
+            if (rc < 0 && errno == EINTR)
+            {
+                continue;
+            }
+            break;
+        }
+        request.append(buffer.data(), rc);
+    }
+
+    auto request_line = request.substr(0, request.find("\r\n"));
+    if (request_line.rfind("GET /metrics ", 0) != 0 && request_line.rfind("GET /metrics?", 0) != 0)
+    {
+        send_all(fd, make_response("404 Not Found", "text/plain", "metrics are served on /metrics\n"));
+        return;
+    }
+
+    send_all(fd, make_response("200 OK", "text/plain; version=0.0.4", metrics::Registry::scrape_all()));
+}
+
+}  // namespace mrc::internal::executor
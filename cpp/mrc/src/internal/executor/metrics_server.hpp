@@ -0,0 +1,65 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2021-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "mrc/utils/macros.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+
+namespace mrc::internal::runnable {
+class Resources;
+}  // namespace mrc::internal::runnable
+namespace mrc::internal::system {
+class Thread;
+}  // namespace mrc::internal::system
+
+namespace mrc::internal::executor {
+
+/**
+ * @brief Minimal http endpoint serving metrics::Registry::scrape_all() on GET /metrics for prometheus scrapers
+ *
+ * Requests are served one at a time on a dedicated thread sharing the cpu of main, which is blocked in poll() while
+ * no scraper is connected. A scrape reads the lock-free counters of the registries and never waits on the fibers
+ * and threads running the pipeline.
+ */
+class MetricsServer final
+{
+  public:
+    // port 0 binds an ephemeral port; throws if the port can not be bound
+    MetricsServer(runnable::Resources& runnable, std::uint16_t port);
+    ~MetricsServer();
+
+    DELETE_COPYABILITY(MetricsServer);
+    DELETE_MOVEABILITY(MetricsServer);
+
+    // port the server is listening on
+    std::uint16_t port() const;
+
+  private:
+    void serve();
+    void respond(int fd);
+
+    int m_listen_fd{-1};
+    std::uint16_t m_port{0};
+    std::atomic<bool> m_running{true};
+    std::unique_ptr<system::Thread> m_thread;
+};
+
+}  // namespace mrc::internal::executor
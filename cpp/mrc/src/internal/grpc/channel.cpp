@@ -0,0 +1,51 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "internal/grpc/channel.hpp"
+
+#include "mrc/core/completion.hpp"
+
+#include <grpcpp/channel.h>
+#include <grpcpp/completion_queue.h>
+
+namespace mrc::internal::rpc {
+
+bool await_connected(grpc::Channel& channel, grpc::CompletionQueue& cq, std::chrono::milliseconds timeout)
+{
+    const auto deadline = std::chrono::system_clock::now() + timeout;
+
+    auto state = channel.GetState(true);
+    while (state != GRPC_CHANNEL_READY)
+    {
+        if (state == GRPC_CHANNEL_SHUTDOWN)
+        {
+            return false;
+        }
+
+        // the notification completes with ok == false if the deadline expired before the state changed
+        Completion<bool> completion;
+        channel.NotifyOnStateChange(state, deadline, &cq, &completion);
+        if (!completion.await())
+        {
+            return false;
+        }
+        state = channel.GetState(true);
+    }
+    return true;
+}
+
+}  // namespace mrc::internal::rpc
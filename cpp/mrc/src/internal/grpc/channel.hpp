@@ -0,0 +1,38 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <chrono>
+
+namespace grpc {
+class Channel;
+class CompletionQueue;
+}  // namespace grpc
+
+namespace mrc::internal::rpc {
+
+/**
+ * @brief Yields the calling fiber until the channel is connected
+ *
+ * The state changes of the channel are notified on cq, which must be progressed by a ProgressEngine.
+ *
+ * @return false if the channel did not connect within timeout
+ */
+bool await_connected(grpc::Channel& channel, grpc::CompletionQueue& cq, std::chrono::milliseconds timeout);
+
+}  // namespace mrc::internal::rpc
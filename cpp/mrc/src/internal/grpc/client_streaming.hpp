@@ -25,6 +25,7 @@
 #include "mrc/channel/channel.hpp"
 #include "mrc/channel/ingress.hpp"
 #include "mrc/channel/status.hpp"
+#include "mrc/core/completion.hpp"
 #include "mrc/node/edge_builder.hpp"
 #include "mrc/node/edge_properties.hpp"
 #include "mrc/node/forward.hpp"
@@ -36,7 +37,6 @@
 #include "mrc/runnable/runner.hpp"
 
 #include <boost/fiber/all.hpp>
-#include <boost/fiber/future/future_status.hpp>
 #include <boost/fiber/operations.hpp>
 #include <glog/logging.h>
 #include <grpcpp/client_context.h>
@@ -200,10 +200,10 @@ class ClientStream : private Service, public std::enable_shared_from_this<Client
         while (s.is_subscribed())
         {
             CHECK(m_stream);
-            Promise<bool> read;
+            Completion<bool> read;
             IncomingData data;
             m_stream->Read(&data.msg, &read);
-            auto ok = read.get_future().get();
+            auto ok = read.await();
             if (!ok)
             {
                 m_write_channel.reset();
@@ -221,9 +221,9 @@ class ClientStream : private Service, public std::enable_shared_from_this<Client
         CHECK(m_stream);
         if (m_can_write)
         {
-            Promise<bool> promise;
-            m_stream->Write(request, &promise);
-            auto ok = promise.get_future().get();
+            Completion<bool> completion;
+            m_stream->Write(request, &completion);
+            auto ok = completion.await();
             if (!ok)
             {
                 m_can_write = false;
@@ -239,9 +239,9 @@ class ClientStream : private Service, public std::enable_shared_from_this<Client
         CHECK(m_stream);
         if (m_can_write)
         {
-            Promise<bool> writes_done;
+            Completion<bool> writes_done;
             m_stream->WritesDone(&writes_done);
-            writes_done.get_future().get();
+            writes_done.await();
             DVLOG(10) << "client issued writes done to server";
         };
     }
@@ -283,9 +283,9 @@ class ClientStream : private Service, public std::enable_shared_from_this<Client
         m_stream = m_prepare_fn(&m_context);
 
         DVLOG(10) << "starting grpc bidi client stream";
-        Promise<bool> promise;
-        m_stream->StartCall(&promise);
-        auto ok = promise.get_future().get();
+        Completion<bool> completion;
+        m_stream->StartCall(&completion);
+        auto ok = completion.await();
 
         if (!ok)
         {
@@ -327,9 +327,9 @@ class ClientStream : private Service, public std::enable_shared_from_this<Client
             m_writer->await_join();
             m_reader->await_join();
 
-            Promise<bool> finish;
+            Completion<bool> finish;
             m_stream->Finish(&m_status, &finish);
-            auto ok = finish.get_future().get();
+            auto ok = finish.await();
         }
     }
 
@@ -17,54 +17,82 @@
 
 #include "internal/grpc/progress_engine.hpp"
 
-#include <boost/fiber/operations.hpp>
+#include "internal/runnable/resources.hpp"
+#include "internal/system/engine_factory_cpu_sets.hpp"
+#include "internal/system/host_partition.hpp"
+#include "internal/system/resources.hpp"
+#include "internal/system/thread.hpp"
+
+#include "mrc/core/bitmap.hpp"
+#include "mrc/core/completion.hpp"
+#include "mrc/core/task_queue.hpp"
+#include "mrc/types.hpp"
+
 #include <glog/logging.h>
-#include <grpc/support/time.h>
 #include <grpcpp/grpcpp.h>
 
-#include <chrono>
-#include <cstdint>
 #include <ostream>
 #include <utility>
 
 namespace mrc::internal::rpc {
 
-ProgressEngine::ProgressEngine(std::shared_ptr<grpc::CompletionQueue> cq) : m_cq(std::move(cq)) {}
-
-void ProgressEngine::data_source(rxcpp::subscriber<ProgressEvent>& s)
+ProgressEngine::ProgressEngine(runnable::Resources& runnable, std::vector<std::shared_ptr<grpc::CompletionQueue>> cqs) :
+  m_cqs(std::move(cqs))
 {
-    ProgressEvent event;
-    std::uint64_t backoff = 128;
+    CHECK(!m_cqs.empty());
+
+    // progress threads share the network cpu of the partition, which is the cpu of main unless a dedicated network
+    // thread is configured; the threads are blocked in Next() while the queues are idle
+    const auto& fiber_cpu_sets = runnable.host_partition().engine_factory_cpu_sets().fiber_cpu_sets;
+    auto network               = fiber_cpu_sets.find("mrc_network");
+
+    CpuSet affinity = (network != fiber_cpu_sets.end() ? CpuSet(network->second) : runnable.main().affinity());
+
+    for (const auto& cq : m_cqs)
+    {
+        CHECK(cq);
+        m_threads.push_back(
+            runnable.system_resources().make_thread("grpc_progress", affinity, [cq] {
+                void* tag = nullptr;
+                bool ok   = false;
+
+                DVLOG(10) << "starting progress engine";
+                while (cq->Next(&tag, &ok))
+                {
+                    DVLOG(20) << "progress engine got event";
+                    static_cast<Completion<bool>*>(tag)->complete(ok);
+                }
+                DVLOG(10) << "progress engine complete";
+            }));
+    }
+}
 
-    DVLOG(10) << "starting progress engine";
+ProgressEngine::~ProgressEngine()
+{
+    shutdown();
+    join();
+}
 
-    while (s.is_subscribed())
+void ProgressEngine::shutdown()
+{
+    if (!m_shutdown)
     {
-        switch (m_cq->AsyncNext<gpr_timespec>(&event.tag, &event.ok, gpr_time_0(GPR_CLOCK_REALTIME)))
+        m_shutdown = true;
+        for (auto& cq : m_cqs)
         {
-        case grpc::CompletionQueue::NextStatus::GOT_EVENT: {
-            backoff = 1;
-            DVLOG(20) << "progress engine got event";
-            s.on_next(event);
-        }
-        break;
-        case grpc::CompletionQueue::NextStatus::TIMEOUT: {
-            // if (backoff < 1048576)
-            if (backoff < 1024)
-            {
-                backoff = (backoff << 1);
-            }
-            boost::this_fiber::sleep_for(std::chrono::microseconds(backoff));
-        }
-        break;
-        case grpc::CompletionQueue::NextStatus::SHUTDOWN: {
-            DVLOG(10) << "progress engine complete";
-            return;
-        }
+            cq->Shutdown();
         }
     }
 }
 
-void ProgressEngine::on_stop(const rxcpp::subscription& subscription) {}
+void ProgressEngine::join()
+{
+    CHECK(m_shutdown);
+    for (auto& thread : m_threads)
+    {
+        thread.join();
+    }
+    m_threads.clear();
+}
 
 }  // namespace mrc::internal::rpc
@@ -17,10 +17,7 @@
 
 #pragma once
 
-#include "mrc/node/generic_source.hpp"
-#include "mrc/runnable/context.hpp"
-
-#include <rxcpp/rx.hpp>
+#include "mrc/utils/macros.hpp"
 
 #include <memory>
 #include <vector>
@@ -28,43 +25,43 @@
 namespace grpc {
 class CompletionQueue;
 }  // namespace grpc
+namespace mrc::internal::runnable {
+class Resources;
+}  // namespace mrc::internal::runnable
+namespace mrc::internal::system {
+class Thread;
+}  // namespace mrc::internal::system
 
 namespace mrc::internal::rpc {
 
 /**
- * @brief gRPC event data pulled from a CQ
- *
- * @param void* tag - pointer to a user-defined specific to a given request
- * @param bool ok - boolean to indicate if the event pulled from the CQ succeeded or not.
- */
-struct ProgressEvent
-{
-    void* tag;
-    bool ok;
-};
-
-/**
- * @brief gRPC Progress Engine which pulls ProgressEvents off the CompletionQueue
+ * @brief Progresses a set of grpc completion queues, each on a dedicated thread blocking on CompletionQueue::Next()
  *
- * This is a MRC Source and only emit ProgressEvents which consist of a void* tag and a bool ok. The user must define
- * what the void* tag means and pair the appropriate handler as a Sink.
+ * The tag of every event on the queues must be a Completion<bool>*, which is completed with the ok value of the event
+ * on the thread of the queue, waking the fiber awaiting the event without the latency of polling.
  *
- * For the majority of the internal gRPC use cases, we will use the PromiseHandler which assumes the void* tag can be
- * statically cast to a mrc::Promise<bool>, which is a fiber yielding promise.
+ * Streams are sharded across the queues by their owner; the completion queue of a stream is chosen when its call is
+ * issued. A progress thread completes once its queue has been shut down and drained.
  */
-class ProgressEngine final : public mrc::node::GenericSource<ProgressEvent>
+class ProgressEngine final
 {
   public:
-    ProgressEngine(std::shared_ptr<grpc::CompletionQueue> cq);
+    ProgressEngine(runnable::Resources& runnable, std::vector<std::shared_ptr<grpc::CompletionQueue>> cqs);
+    ~ProgressEngine();
 
-  private:
-    void data_source(rxcpp::subscriber<ProgressEvent>& s) final;
+    DELETE_COPYABILITY(ProgressEngine);
+    DELETE_MOVEABILITY(ProgressEngine);
 
-    // disabling stop on this source
-    // the proper way to stop this source is to issue a CompletionQueue::Shutdown()
-    void on_stop(const rxcpp::subscription& subscription) final;
+    // shutdown all completion queues; pending events are still delivered
+    void shutdown();
 
-    std::shared_ptr<grpc::CompletionQueue> m_cq;
+    // join all progress threads; the completion queues must be shut down
+    void join();
+
+  private:
+    std::vector<std::shared_ptr<grpc::CompletionQueue>> m_cqs;
+    std::vector<system::Thread> m_threads;
+    bool m_shutdown{false};
 };
 
 }  // namespace mrc::internal::rpc
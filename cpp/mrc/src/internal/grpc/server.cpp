@@ -18,25 +18,25 @@
 #include "internal/grpc/server.hpp"
 
 #include "internal/grpc/progress_engine.hpp"
-#include "internal/grpc/promise_handler.hpp"
 #include "internal/runnable/resources.hpp"
 
-#include "mrc/node/edge_builder.hpp"
-#include "mrc/runnable/launch_control.hpp"
-#include "mrc/runnable/launcher.hpp"
-#include "mrc/runnable/runner.hpp"
-
+#include <glog/logging.h>
 #include <grpcpp/security/server_credentials.h>
 
 #include <memory>
+#include <string>
 #include <utility>
 
 namespace mrc::internal::rpc {
 
-Server::Server(runnable::Resources& runnable) : m_runnable(runnable)
+Server::Server(runnable::Resources& runnable, std::uint16_t port, std::size_t cq_count) : m_runnable(runnable)
 {
-    m_cq = m_builder.AddCompletionQueue();
-    m_builder.AddListeningPort("0.0.0.0:13337", grpc::InsecureServerCredentials());
+    CHECK_GT(cq_count, 0);
+    for (std::size_t i = 0; i < cq_count; i++)
+    {
+        m_cqs.push_back(m_builder.AddCompletionQueue());
+    }
+    m_builder.AddListeningPort("0.0.0.0:" + std::to_string(port), grpc::InsecureServerCredentials());
 }
 
 Server::~Server()
@@ -48,12 +48,8 @@ void Server::do_service_start()
 {
     m_server = m_builder.BuildAndStart();
 
-    auto progress_engine = std::make_unique<ProgressEngine>(m_cq);
-    auto event_handler   = std::make_unique<PromiseHandler>();
-    mrc::node::make_edge(*progress_engine, *event_handler);
-
-    m_progress_engine = m_runnable.launch_control().prepare_launcher(std::move(progress_engine))->ignition();
-    m_event_hander    = m_runnable.launch_control().prepare_launcher(std::move(event_handler))->ignition();
+    m_progress_engine = std::make_unique<ProgressEngine>(
+        m_runnable, std::vector<std::shared_ptr<grpc::CompletionQueue>>(m_cqs.begin(), m_cqs.end()));
 }
 
 void Server::do_service_stop()
@@ -66,25 +62,20 @@ void Server::do_service_kill()
     if (m_server)
     {
         m_server->Shutdown();
-        m_cq->Shutdown();
+        m_progress_engine->shutdown();
     }
 }
 
 void Server::do_service_await_live()
 {
-    if (m_progress_engine && m_event_hander)
-    {
-        m_progress_engine->await_live();
-        m_event_hander->await_live();
-    }
+    // the progress threads are live once started
 }
 
 void Server::do_service_await_join()
 {
-    if (m_progress_engine && m_event_hander)
+    if (m_progress_engine)
     {
-        m_progress_engine->await_join();
-        m_event_hander->await_join();
+        m_progress_engine->join();
     }
 }
 
@@ -92,9 +83,9 @@ runnable::Resources& Server::runnable()
 {
     return m_runnable;
 }
-std::shared_ptr<grpc::ServerCompletionQueue> Server::get_cq() const
+std::shared_ptr<grpc::ServerCompletionQueue> Server::get_cq()
 {
-    return m_cq;
+    return m_cqs.at(m_next_cq++ % m_cqs.size());
 }
 void Server::register_service(std::shared_ptr<grpc::Service> service)
 {
@@ -21,6 +21,9 @@
 
 #include <grpcpp/grpcpp.h>
 
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
 #include <memory>
 #include <vector>
 
@@ -30,21 +33,21 @@ class Service;
 namespace mrc::internal::runnable {
 class Resources;
 }  // namespace mrc::internal::runnable
-namespace mrc::runnable {
-class Runner;
-}  // namespace mrc::runnable
 
 namespace mrc::internal::rpc {
+class ProgressEngine;
 
 class Server : public Service
 {
   public:
-    Server(runnable::Resources& runnable);
+    // streams are sharded across cq_count completion queues, each progressed by a dedicated thread
+    Server(runnable::Resources& runnable, std::uint16_t port = 13337, std::size_t cq_count = 1);
     ~Server() override;
 
     void register_service(std::shared_ptr<grpc::Service> service);
 
-    std::shared_ptr<grpc::ServerCompletionQueue> get_cq() const;
+    // completion queue of the next stream; the queues are issued round robin
+    std::shared_ptr<grpc::ServerCompletionQueue> get_cq();
 
     runnable::Resources& runnable();
 
@@ -58,10 +61,10 @@ class Server : public Service
     grpc::ServerBuilder m_builder;
     runnable::Resources& m_runnable;
     std::vector<std::shared_ptr<grpc::Service>> m_services;
-    std::shared_ptr<grpc::ServerCompletionQueue> m_cq;
+    std::vector<std::shared_ptr<grpc::ServerCompletionQueue>> m_cqs;
+    std::atomic<std::size_t> m_next_cq{0};
     std::unique_ptr<grpc::Server> m_server;
-    std::unique_ptr<mrc::runnable::Runner> m_progress_engine;
-    std::unique_ptr<mrc::runnable::Runner> m_event_hander;
+    std::unique_ptr<ProgressEngine> m_progress_engine;
 };
 
 }  // namespace mrc::internal::rpc
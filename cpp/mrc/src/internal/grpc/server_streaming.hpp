@@ -25,6 +25,7 @@
 #include "mrc/channel/channel.hpp"
 #include "mrc/channel/ingress.hpp"
 #include "mrc/channel/status.hpp"
+#include "mrc/core/completion.hpp"
 #include "mrc/node/edge_builder.hpp"
 #include "mrc/node/edge_properties.hpp"
 #include "mrc/node/forward.hpp"
@@ -37,7 +38,6 @@
 #include "mrc/runnable/runner.hpp"
 
 #include <boost/fiber/all.hpp>
-#include <boost/fiber/future/future_status.hpp>
 #include <boost/fiber/operations.hpp>
 #include <glog/logging.h>
 #include <grpc/grpc_security.h>
@@ -227,10 +227,10 @@ class ServerStream : private Service, public std::enable_shared_from_this<Server
         while (s.is_subscribed())
         {
             CHECK(m_stream);
-            Promise<bool> read;
+            Completion<bool> read;
             IncomingData data;
             m_stream->Read(&data.msg, &read);
-            auto ok     = read.get_future().get();
+            auto ok     = read.await();
             data.ok     = ok;
             data.stream = writer();
             s.on_next(std::move(data));
@@ -251,9 +251,9 @@ class ServerStream : private Service, public std::enable_shared_from_this<Server
         CHECK(m_stream);
         if (m_can_write)
         {
-            Promise<bool> promise;
-            m_stream->Write(request, &promise);
-            auto ok = promise.get_future().get();
+            Completion<bool> completion;
+            m_stream->Write(request, &completion);
+            auto ok = completion.await();
             if (!ok)
             {
                 DVLOG(10) << "server failed to write to client; disabling writes and beginning shutdown";
@@ -276,9 +276,9 @@ class ServerStream : private Service, public std::enable_shared_from_this<Server
             }
 
             DVLOG(10) << "server issuing finish";
-            Promise<bool> finish;
+            Completion<bool> finish;
             m_stream->Finish(*m_status, &finish);
-            auto ok = finish.get_future().get();
+            auto ok = finish.await();
             DVLOG(10) << "server done with finish";
         }
     }
@@ -315,9 +315,9 @@ class ServerStream : private Service, public std::enable_shared_from_this<Server
 
     void do_service_start() final
     {
-        Promise<bool> promise;
-        m_init_fn(&promise);
-        auto ok = promise.get_future().get();
+        Completion<bool> completion;
+        m_init_fn(&completion);
+        auto ok = completion.await();
 
         if (!ok)
         {
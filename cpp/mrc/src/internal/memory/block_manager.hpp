@@ -19,16 +19,38 @@
 
 #include "internal/memory/memory_block.hpp"
 
+#include "mrc/utils/read_mostly.hpp"
+
 #include <glog/logging.h>
 
+#include <atomic>
+#include <bit>
 #include <cstddef>
+#include <cstdint>
 #include <functional>
-#include <map>
-#include <queue>
+#include <memory>
+#include <optional>
+#include <type_traits>
 #include <utility>
+#include <vector>
 
 namespace mrc::internal::memory {
 
+/**
+ * @brief Read-optimized set of non-overlapping memory blocks searchable by any address they contain
+ *
+ * The blocks are held in an immutable snapshot: a vector sorted by address along with the end addresses of the blocks
+ * in Eytzinger (breadth-first) layout, so a lookup walks a single cache-friendly array with a branch-free descent.
+ * Modifications copy the snapshot and atomically swap it in, which makes add_block and drop_block O(n); they are
+ * expected to be rare compared to lookups. The storage of the retired snapshot is reused by the next modification once
+ * no reader holds it, so steady-state modifications do not allocate.
+ *
+ * Each thread caches the snapshot it last searched, so a lookup does not copy the std::shared_ptr of the snapshot and
+ * concurrent lookups do not contend on its reference count.
+ *
+ * Modifications must be serialized by the caller. lookup may be called concurrently with a modification; pointers
+ * returned by find_block are only valid until the next modification.
+ */
 template <typename BlockTypeT>
 class BlockManager final
 {
@@ -40,11 +62,12 @@ class BlockManager final
     BlockManager()  = default;
     ~BlockManager() = default;
 
-    BlockManager(BlockManager&& other) noexcept : m_block_map(std::move(other.m_block_map)) {}
+    BlockManager(BlockManager&& other) noexcept : m_snapshot(other.m_snapshot.exchange(empty_snapshot())) {}
 
     BlockManager& operator=(BlockManager&& other)
     {
-        m_block_map = std::move(other.m_block_map);
+        m_snapshot.store(other.m_snapshot.exchange(empty_snapshot()));
+        m_spare.reset();
         return *this;
     }
 
@@ -57,54 +80,86 @@ class BlockManager final
         DCHECK(!owns(block.data()) && !owns(reinterpret_cast<void*>(key - 1)))
             << "block manager already owns a block with an overlapping address";
         DVLOG(10) << "adding block: " << key << " - " << block.data() << "; " << block.bytes();
-        m_block_map[key] = std::move(block);
-        return m_block_map[key];
+
+        auto current = m_snapshot.load();
+        auto next    = make_snapshot(current->blocks.size() + 1);
+        auto index   = current->blocks.size();
+        for (const auto& existing : current->blocks)
+        {
+            if (index == current->blocks.size() && key < end_of(existing))
+            {
+                index = next->blocks.size();
+                next->blocks.push_back(block);
+            }
+            next->blocks.push_back(existing);
+        }
+        if (index == current->blocks.size())
+        {
+            next->blocks.push_back(block);
+        }
+
+        const auto& added = next->blocks[index];
+        publish(std::move(next));
+        return added;
     }
 
     const block_type* find_block(const void* ptr) const
     {
-        auto search = find_entry(ptr);
-        if (search != m_block_map.end() && search->second.contains(ptr))
+        return find_block(m_snapshot.read(), ptr);
+    }
+
+    /**
+     * @brief Copy of the block containing ptr; safe to call concurrently with a modification
+     */
+    std::optional<block_type> lookup(const void* ptr) const
+    {
+        const auto* block = find_block(m_snapshot.read(), ptr);
+        if (block == nullptr)
         {
-            DVLOG(20) << this << ": block found";
-            return &search->second;
+            return std::nullopt;
         }
-        DVLOG(20) << this << ": no block found for " << ptr;
-        return nullptr;
+        return {*block};
     }
 
     void drop_block(const void* ptr)
     {
         DVLOG(10) << "dropping block: " << ptr;
-        auto search = find_entry(ptr);
-        if (search != m_block_map.end() && search->second.contains(ptr))
+        auto current      = m_snapshot.load();
+        const auto* block = find_block(*current, ptr);
+        if (block == nullptr)
         {
-            DVLOG(20) << "found block; dropping block: " << search->first << "; " << search->second.data();
-            m_block_map.erase(search);
+            return;
         }
+
+        DVLOG(20) << "found block; dropping block: " << end_of(*block) << "; " << block->data();
+        auto next = make_snapshot(current->blocks.size() - 1);
+        for (const auto& existing : current->blocks)
+        {
+            if (&existing != block)
+            {
+                next->blocks.push_back(existing);
+            }
+        }
+        publish(std::move(next));
     }
 
     auto size() const noexcept
     {
-        return m_block_map.size();
+        return m_snapshot.read().blocks.size();
     }
 
     void clear() noexcept
     {
         DVLOG(10) << "clearing block map";
-        m_block_map.clear();
+        m_snapshot.store(empty_snapshot());
+        m_spare.reset();
     }
 
     std::vector<BlockTypeT> blocks() const noexcept
     {
-        DVLOG(20) << "getting a vector of blocks - " << m_block_map.size();
-        std::vector<BlockTypeT> v;
-        v.reserve(m_block_map.size());
-        for (const auto& it : m_block_map)
-        {
-            v.push_back(it.second.pointer());
-        }
-        return v;
+        auto snapshot = m_snapshot.load();
+        DVLOG(20) << "getting a vector of blocks - " << snapshot->blocks.size();
+        return snapshot->blocks;
     }
 
     bool owns(void* addr)
@@ -115,22 +170,109 @@ class BlockManager final
 
     void for_each_block(std::function<void(const block_type& block)> lambda)
     {
-        for (const auto& [key, block] : m_block_map)
+        auto snapshot = m_snapshot.load();
+        for (const auto& block : snapshot->blocks)
         {
             lambda(block);
         }
     }
 
   private:
-    inline auto find_entry(const void* ptr) const
+    struct Snapshot
+    {
+        // blocks sorted by address
+        std::vector<block_type> blocks;
+        // end addresses of the blocks in Eytzinger layout, 1-based; ranks[i] is the index in blocks of keys[i]
+        std::vector<std::uintptr_t> keys;
+        std::vector<std::size_t> ranks;
+    };
+
+    static std::uintptr_t end_of(const block_type& block)
+    {
+        return reinterpret_cast<std::uintptr_t>(block.data()) + block.bytes();
+    }
+
+    static std::shared_ptr<Snapshot> empty_snapshot()
+    {
+        auto snapshot = std::make_shared<Snapshot>();
+        snapshot->keys.resize(1);
+        snapshot->ranks.resize(1);
+        return snapshot;
+    }
+
+    // reuses the storage of the retired snapshot once the last reader has released it
+    std::shared_ptr<Snapshot> make_snapshot(std::size_t count)
+    {
+        std::shared_ptr<Snapshot> snapshot;
+        if (m_spare && m_spare.use_count() == 1)
+        {
+            // pairs with the release of the reference dropped by the last reader
+            std::atomic_thread_fence(std::memory_order_acquire);
+            snapshot = std::move(m_spare);
+            snapshot->blocks.clear();
+        }
+        else
+        {
+            snapshot = std::make_shared<Snapshot>();
+        }
+        snapshot->blocks.reserve(count);
+        return snapshot;
+    }
+
+    void publish(std::shared_ptr<Snapshot> snapshot)
+    {
+        auto count = snapshot->blocks.size();
+        snapshot->keys.resize(count + 1);
+        snapshot->ranks.resize(count + 1);
+        std::size_t rank = 0;
+        build_layout(*snapshot, rank, 1);
+        m_spare = m_snapshot.exchange(std::move(snapshot));
+    }
+
+    // in-order traversal of the implicit tree assigns the sorted blocks to the Eytzinger positions
+    static void build_layout(Snapshot& snapshot, std::size_t& rank, std::size_t pos)
+    {
+        if (pos < snapshot.keys.size())
+        {
+            build_layout(snapshot, rank, 2 * pos);
+            snapshot.keys[pos]  = end_of(snapshot.blocks[rank]);
+            snapshot.ranks[pos] = rank++;
+            build_layout(snapshot, rank, 2 * pos + 1);
+        }
+    }
+
+    // finds the first block ending after ptr, which is the only block which may contain it
+    static const block_type* find_block(const Snapshot& snapshot, const void* ptr)
     {
         DVLOG(20) << "looking for block containing: " << ptr;
-        auto key = reinterpret_cast<std::uintptr_t>(ptr);
-        return m_block_map.upper_bound(key);
+        const auto key  = reinterpret_cast<std::uintptr_t>(ptr);
+        const auto* keys = snapshot.keys.data();
+        const auto size  = snapshot.keys.size();
+
+        std::size_t pos = 1;
+        while (pos < size)
+        {
+            pos = 2 * pos + static_cast<std::size_t>(keys[pos] <= key);
+        }
+        // drop the trailing right turns and the final left turn to land on the last node where the descent went left
+        pos >>= std::countr_one(pos) + 1;
+
+        if (pos != 0)
+        {
+            const auto& block = snapshot.blocks[snapshot.ranks[pos]];
+            if (block.contains(ptr))
+            {
+                return &block;
+            }
+        }
+        DVLOG(20) << "no block found for " << ptr;
+        return nullptr;
     }
 
-    // todo: used a static block allocator here to avoid allocation issues
-    std::map<std::uintptr_t, block_type> m_block_map;
+    mrc::utils::ReadMostly<Snapshot> m_snapshot{empty_snapshot()};
+
+    // retired snapshot whose storage is recycled by the next modification
+    std::shared_ptr<Snapshot> m_spare;
 };
 
 }  // namespace mrc::internal::memory
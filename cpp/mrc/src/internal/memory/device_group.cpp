@@ -0,0 +1,204 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "internal/memory/device_group.hpp"
+
+#include "internal/memory/device_resources.hpp"
+
+#include "mrc/cuda/common.hpp"
+#include "mrc/cuda/device_guard.hpp"
+
+#include <cuda_runtime.h>
+#include <glog/logging.h>
+
+#include <cstddef>
+#include <utility>
+
+namespace mrc::internal::memory {
+
+bool DeviceGroup::Completion::is_ready() const
+{
+    for (const auto& completion : m_completions)
+    {
+        if (!completion.is_ready())
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+void DeviceGroup::Completion::await() const
+{
+    for (const auto& completion : m_completions)
+    {
+        completion.await();
+    }
+}
+
+DeviceGroup::DeviceGroup(std::vector<DeviceResources*> members) :
+  m_members(std::move(members)),
+  m_peer_access(m_members.size() * m_members.size(), false)
+{
+    CHECK(!m_members.empty()) << "a device group requires at least one member";
+
+    for (std::size_t from = 0; from < size(); ++from)
+    {
+        CHECK(m_members[from] != nullptr);
+        auto device_id = m_members[from]->cuda_device_id();
+        DeviceGuard guard(device_id);
+
+        for (std::size_t to = 0; to < size(); ++to)
+        {
+            auto peer_id = m_members[to]->cuda_device_id();
+            if (peer_id == device_id)
+            {
+                m_peer_access[from * size() + to] = true;
+                continue;
+            }
+
+            int can_access = 0;
+            MRC_CHECK_CUDA(cudaDeviceCanAccessPeer(&can_access, device_id, peer_id));
+            if (can_access != 0)
+            {
+                // peer access is a property of the device context; other groups may have enabled it already
+                auto status = cudaDeviceEnablePeerAccess(peer_id, 0);
+                if (status == cudaErrorPeerAccessAlreadyEnabled)
+                {
+                    cudaGetLastError();
+                }
+                else
+                {
+                    MRC_CHECK_CUDA(status);
+                }
+                m_peer_access[from * size() + to] = true;
+            }
+
+            VLOG(10) << "device group copies from cuda_device_id: " << device_id << " to: " << peer_id << " are "
+                     << (can_access != 0 ? "direct" : "staged through host memory");
+        }
+    }
+}
+
+std::size_t DeviceGroup::size() const
+{
+    return m_members.size();
+}
+
+DeviceResources& DeviceGroup::member(std::size_t rank) const
+{
+    CHECK_LT(rank, size());
+    return *m_members[rank];
+}
+
+bool DeviceGroup::peer_access(std::size_t from, std::size_t to) const
+{
+    CHECK_LT(from, size());
+    CHECK_LT(to, size());
+    return m_peer_access[from * size() + to];
+}
+
+std::vector<std::size_t> DeviceGroup::shard_offsets(std::size_t count) const
+{
+    std::vector<std::size_t> offsets;
+    offsets.reserve(size() + 1);
+
+    const auto per_rank  = count / size();
+    const auto remainder = count % size();
+
+    std::size_t offset = 0;
+    for (std::size_t rank = 0; rank < size(); ++rank)
+    {
+        offsets.push_back(offset);
+        offset += per_rank + (rank < remainder ? 1 : 0);
+    }
+    offsets.push_back(offset);
+    return offsets;
+}
+
+DeviceGroup::Completion DeviceGroup::scatter(const void* src,
+                                             int src_device_id,
+                                             std::size_t count,
+                                             std::size_t element_size,
+                                             std::vector<mrc::memory::buffer>& shards) const
+{
+    const auto offsets = shard_offsets(count);
+    const auto* bytes  = static_cast<const std::byte*>(src);
+
+    Completion completion;
+    shards.clear();
+    shards.reserve(size());
+    for (std::size_t rank = 0; rank < size(); ++rank)
+    {
+        const auto shard_bytes = (offsets[rank + 1] - offsets[rank]) * element_size;
+        if (shard_bytes == 0)
+        {
+            shards.emplace_back();
+            continue;
+        }
+
+        auto& shard           = shards.emplace_back(member(rank).make_buffer(shard_bytes));
+        const auto* shard_src = bytes + offsets[rank] * element_size;
+        auto& engine          = *member(rank).copy_engine();
+        if (src_device_id == cudaCpuDeviceId)
+        {
+            completion.m_completions.push_back(
+                engine.copy_async(shard.data(), shard_src, shard_bytes, cudaMemcpyHostToDevice));
+        }
+        else
+        {
+            completion.m_completions.push_back(engine.copy_peer_async(
+                shard.data(), member(rank).cuda_device_id(), shard_src, src_device_id, shard_bytes));
+        }
+    }
+    return completion;
+}
+
+DeviceGroup::Completion DeviceGroup::gather(const std::vector<mrc::memory::buffer>& shards,
+                                            void* dst,
+                                            int dst_device_id) const
+{
+    CHECK_EQ(shards.size(), size()) << "gather requires one shard per member";
+    auto* bytes = static_cast<std::byte*>(dst);
+
+    Completion completion;
+    std::size_t offset = 0;
+    for (std::size_t rank = 0; rank < size(); ++rank)
+    {
+        const auto& shard = shards[rank];
+        if (shard.bytes() == 0)
+        {
+            continue;
+        }
+
+        auto& engine = *member(rank).copy_engine();
+        if (dst_device_id == cudaCpuDeviceId)
+        {
+            completion.m_completions.push_back(
+                engine.copy_async(bytes + offset, shard.data(), shard.bytes(), cudaMemcpyDeviceToHost));
+        }
+        else
+        {
+            completion.m_completions.push_back(engine.copy_peer_async(
+                bytes + offset, dst_device_id, shard.data(), member(rank).cuda_device_id(), shard.bytes()));
+        }
+        offset += shard.bytes();
+    }
+    return completion;
+}
+
+}  // namespace mrc::internal::memory
@@ -0,0 +1,98 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "mrc/cuda/copy_engine.hpp"
+#include "mrc/memory/buffer.hpp"
+
+#include <cstddef>
+#include <vector>
+
+namespace mrc::internal::memory {
+
+class DeviceResources;
+
+/**
+ * @brief Set of device partitions a node spans, scattering batches across their devices and gathering the results
+ *
+ * Peer access is enabled between every pair of member devices able to access each other, so shards move between
+ * devices directly over NVLink or PCIe rather than being staged through host memory; copies between devices without
+ * peer access are staged by the driver. A batch of count elements is split into one contiguous shard per member, in
+ * member order, with the first count % size() members holding one element more than the others.
+ *
+ * Scatters issue the copy of each shard on the copy engine of its destination device and gathers on that of its
+ * source device, so the copies of all members are in flight at once on the streams of their devices.
+ */
+class DeviceGroup final
+{
+  public:
+    /**
+     * @brief Completion of the copies of a scatter or gather; awaiting it blocks the calling fiber until every copy
+     * completed
+     */
+    class Completion
+    {
+      public:
+        bool is_ready() const;
+        void await() const;
+
+      private:
+        std::vector<CopyCompletion> m_completions;
+
+        friend DeviceGroup;
+    };
+
+    DeviceGroup(std::vector<DeviceResources*> members);
+
+    // number of member devices
+    std::size_t size() const;
+
+    DeviceResources& member(std::size_t rank) const;
+
+    // true if the device of rank from accesses the memory of the device of rank to directly
+    bool peer_access(std::size_t from, std::size_t to) const;
+
+    // element offset of the shard of each rank into a batch of count elements, followed by count
+    std::vector<std::size_t> shard_offsets(std::size_t count) const;
+
+    /**
+     * @brief Split the count elements of element_size bytes at src into one shard per member, each allocated from the
+     * arena of its member; src is device memory of src_device_id, or host memory for cudaCpuDeviceId
+     *
+     * src must remain valid until the completion is ready.
+     */
+    Completion scatter(const void* src,
+                       int src_device_id,
+                       std::size_t count,
+                       std::size_t element_size,
+                       std::vector<mrc::memory::buffer>& shards) const;
+
+    /**
+     * @brief Concatenate the shards of the members, in member order, into dst; dst is device memory of dst_device_id,
+     * or host memory for cudaCpuDeviceId
+     */
+    Completion gather(const std::vector<mrc::memory::buffer>& shards, void* dst, int dst_device_id) const;
+
+  private:
+    std::vector<DeviceResources*> m_members;
+
+    // m_peer_access[from * size() + to]
+    std::vector<bool> m_peer_access;
+};
+
+}  // namespace mrc::internal::memory
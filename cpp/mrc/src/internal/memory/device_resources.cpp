@@ -24,12 +24,15 @@
 #include "internal/ucx/resources.hpp"
 
 #include "mrc/core/task_queue.hpp"
+#include "mrc/cuda/copy_engine.hpp"
 #include "mrc/cuda/device_guard.hpp"
 #include "mrc/memory/adaptors.hpp"
 #include "mrc/memory/resources/arena_resource.hpp"
 #include "mrc/memory/resources/device/cuda_malloc_resource.hpp"
 #include "mrc/memory/resources/logging_resource.hpp"
 #include "mrc/memory/resources/memory_resource.hpp"
+#include "mrc/memory/resources/stream_ordered_resource.hpp"
+#include "mrc/memory/resources/tracking_resource.hpp"
 #include "mrc/options/options.hpp"
 #include "mrc/options/resources.hpp"
 #include "mrc/types.hpp"
@@ -66,6 +69,8 @@ DeviceResources::DeviceResources(resources::PartitionResourceBase& base, std::op
             m_system         = mrc::memory::make_shared_resource<mrc::memory::logging_resource>(std::move(cuda_malloc),
                                                                                         device_prefix.str());
 
+            m_copy_engine = std::make_shared<CopyEngine>(cuda_device_id());
+
             if (ucx)
             {
                 m_registered = ucx->adapt_to_registered_resource(m_system, cuda_device_id());
@@ -83,13 +88,20 @@ DeviceResources::DeviceResources(resources::PartitionResourceBase& base, std::op
                          << " constructing arena memory_resource with initial=" << bytes_to_string(opts.block_size())
                          << "; max bytes=" << bytes_to_string(opts.max_aggreate_bytes());
 
-                m_arena = mrc::memory::make_shared_resource<mrc::memory::arena_resource>(
+                auto arena = mrc::memory::make_shared_resource<mrc::memory::arena_resource>(
                     m_registered, opts.block_size(), opts.max_aggreate_bytes());
+                m_stream_ordered = arena;
+                m_arena          = std::move(arena);
             }
             else
             {
                 m_arena = m_registered;
             }
+
+            if (system().options().resources().enable_memory_tracking())
+            {
+                m_arena = mrc::memory::make_shared_resource<mrc::memory::tracking_resource>(std::move(m_arena));
+            }
         })
         .get();
 }
@@ -115,4 +127,12 @@ std::shared_ptr<mrc::memory::memory_resource> DeviceResources::arena_memory_reso
 {
     return m_arena;
 }
+std::shared_ptr<mrc::memory::stream_ordered_resource> DeviceResources::stream_ordered_memory_resource() const
+{
+    return m_stream_ordered;
+}
+std::shared_ptr<CopyEngine> DeviceResources::copy_engine() const
+{
+    return m_copy_engine;
+}
 }  // namespace mrc::internal::memory
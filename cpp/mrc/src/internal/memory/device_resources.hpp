@@ -25,8 +25,13 @@
 #include <memory>
 #include <optional>
 
+namespace mrc {
+class CopyEngine;
+}  // namespace mrc
+
 namespace mrc::memory {
 struct memory_resource;
+struct stream_ordered_resource;
 }  // namespace mrc::memory
 
 namespace mrc::internal::ucx {
@@ -51,10 +56,22 @@ class DeviceResources : private resources::PartitionResourceBase
     std::shared_ptr<mrc::memory::memory_resource> registered_memory_resource() const;
     std::shared_ptr<mrc::memory::memory_resource> arena_memory_resource() const;
 
+    /**
+     * @brief Stream-ordered view of the arena, or nullptr if the device memory pool is disabled
+     */
+    std::shared_ptr<mrc::memory::stream_ordered_resource> stream_ordered_memory_resource() const;
+
+    /**
+     * @brief Engine batching the asynchronous copies and prefetches of the device onto its dedicated streams
+     */
+    std::shared_ptr<CopyEngine> copy_engine() const;
+
   private:
     std::shared_ptr<mrc::memory::memory_resource> m_system;
     std::shared_ptr<mrc::memory::memory_resource> m_registered;
     std::shared_ptr<mrc::memory::memory_resource> m_arena;
+    std::shared_ptr<mrc::memory::stream_ordered_resource> m_stream_ordered;
+    std::shared_ptr<CopyEngine> m_copy_engine;
 };
 
 }  // namespace mrc::internal::memory
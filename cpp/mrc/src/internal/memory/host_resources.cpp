@@ -24,12 +24,17 @@
 #include "internal/ucx/registation_callback_builder.hpp"
 
 #include "mrc/core/task_queue.hpp"
+#include "mrc/data/cached_reusable_pool.hpp"
 #include "mrc/memory/adaptors.hpp"
 #include "mrc/memory/resources/arena_resource.hpp"
+#include "mrc/memory/resources/host/hugepage_memory_resource.hpp"
 #include "mrc/memory/resources/host/malloc_memory_resource.hpp"
+#include "mrc/memory/resources/host/numa_memory_resource.hpp"
 #include "mrc/memory/resources/host/pinned_memory_resource.hpp"
 #include "mrc/memory/resources/logging_resource.hpp"
 #include "mrc/memory/resources/memory_resource.hpp"
+#include "mrc/memory/resources/tracking_resource.hpp"
+#include "mrc/options/network.hpp"
 #include "mrc/options/options.hpp"
 #include "mrc/options/resources.hpp"
 #include "mrc/types.hpp"
@@ -39,6 +44,8 @@
 #include <glog/logging.h>
 #include <spdlog/sinks/basic_file_sink.h>
 
+#include <algorithm>
+#include <bit>
 #include <map>
 #include <memory>
 #include <ostream>
@@ -50,6 +57,23 @@
 
 namespace mrc::internal::memory {
 
+namespace {
+
+mrc::memory::hugepage_kind hugepage_kind_for(PageSize page_size)
+{
+    switch (page_size)
+    {
+    case PageSize::Huge2MiB:
+        return mrc::memory::hugepage_kind::explicit_2MiB;
+    case PageSize::Huge1GiB:
+        return mrc::memory::hugepage_kind::explicit_1GiB;
+    default:
+        return mrc::memory::hugepage_kind::transparent;
+    }
+}
+
+}  // namespace
+
 HostResources::HostResources(runnable::Resources& runnable, ucx::RegistrationCallbackBuilder&& callbacks) :
   system::HostPartitionProvider(runnable)
 {
@@ -58,8 +82,26 @@ HostResources::HostResources(runnable::Resources& runnable, ucx::RegistrationCal
             // logging prefix
             std::stringstream prefix;
 
-            // construct raw memory_resource from malloc or pinned if device(s) present
-            if (host_partition().device_partition_ids().empty())
+            const auto& pool_options = system().options().resources().host_memory_pool();
+            const auto page_size     = pool_options.page_size();
+            const bool first_touch   = pool_options.numa_first_touch();
+            const bool pinned        = !host_partition().device_partition_ids().empty();
+
+            // construct raw memory_resource from malloc or pinned if device(s) present, optionally from huge pages or
+            // from pages bound to the numa nodes of the partition
+            if (page_size != PageSize::Default)
+            {
+                m_system = std::make_shared<mrc::memory::hugepage_memory_resource>(
+                    hugepage_kind_for(page_size), host_partition().numa_set().vec(), pinned, first_touch);
+                prefix << (pinned ? "hugepage_pinned" : "hugepage");
+            }
+            else if (first_touch)
+            {
+                m_system =
+                    std::make_shared<mrc::memory::numa_memory_resource>(host_partition().numa_set().vec(), pinned);
+                prefix << (pinned ? "numa_pinned" : "numa");
+            }
+            else if (!pinned)
             {
                 m_system = std::make_shared<mrc::memory::malloc_memory_resource>();
                 prefix << "malloc";
@@ -85,6 +127,17 @@ HostResources::HostResources(runnable::Resources& runnable, ucx::RegistrationCal
                     mrc::memory::make_shared_resource<memory::CallbackAdaptor>(m_system, std::move(callbacks));
             }
 
+            // staging buffers are allocated on first use, so partitions transferring no device memory pin none
+            if (!host_partition().device_partition_ids().empty())
+            {
+                const auto& network = system().options().network();
+                auto capacity       = std::bit_ceil(std::max<std::size_t>(network.staging_chunk_count(), 1));
+                m_staging_pool      = StagingPool::create(
+                    capacity, [resource = m_registered, chunk_size = network.staging_chunk_size()] {
+                        return std::make_unique<mrc::memory::buffer>(chunk_size, resource);
+                    });
+            }
+
             // adapt to arena
             if (system().options().resources().enable_host_memory_pool())
             {
@@ -101,6 +154,11 @@ HostResources::HostResources(runnable::Resources& runnable, ucx::RegistrationCal
             {
                 m_arena = m_registered;
             }
+
+            if (system().options().resources().enable_memory_tracking())
+            {
+                m_arena = mrc::memory::make_shared_resource<mrc::memory::tracking_resource>(std::move(m_arena));
+            }
         })
         .get();
 }
@@ -121,4 +179,8 @@ std::shared_ptr<mrc::memory::memory_resource> HostResources::arena_memory_resour
 {
     return m_arena;
 }
+std::shared_ptr<StagingPool> HostResources::staging_pool()
+{
+    return m_staging_pool;
+}
 }  // namespace mrc::internal::memory
@@ -24,6 +24,10 @@
 #include <cstddef>
 #include <memory>
 
+namespace mrc::data {
+template <typename T>
+class CachedReusablePool;
+}  // namespace mrc::data
 namespace mrc::internal::runnable {
 class Resources;
 }  // namespace mrc::internal::runnable
@@ -36,6 +40,8 @@ struct memory_resource;
 
 namespace mrc::internal::memory {
 
+using StagingPool = mrc::data::CachedReusablePool<mrc::memory::buffer>;  // NOLINT
+
 /**
  * @brief Object that provides access to host memory_resource objects for a given host partition
  */
@@ -50,10 +56,17 @@ class HostResources final : private system::HostPartitionProvider
     std::shared_ptr<mrc::memory::memory_resource> registered_memory_resource();
     std::shared_ptr<mrc::memory::memory_resource> arena_memory_resource();
 
+    /**
+     * @brief Pool of registered pinned buffers of NetworkOptions::staging_chunk_size bytes which device memory is
+     * staged through when the nics cannot access it directly; nullptr if the partition has no devices
+     */
+    std::shared_ptr<StagingPool> staging_pool();
+
   private:
     std::shared_ptr<mrc::memory::memory_resource> m_system;
     std::shared_ptr<mrc::memory::memory_resource> m_registered;
     std::shared_ptr<mrc::memory::memory_resource> m_arena;
+    std::shared_ptr<StagingPool> m_staging_pool;
 };
 
 }  // namespace mrc::internal::memory
@@ -0,0 +1,177 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "internal/memory/shared_memory.hpp"
+
+#include "internal/utils/host_name.hpp"
+
+#include <fcntl.h>
+#include <glog/logging.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstring>
+#include <ostream>
+#include <stdexcept>
+#include <utility>
+
+namespace mrc::internal::memory {
+
+namespace {
+
+[[noreturn]] void throw_errno(const std::string& what, const std::string& name)
+{
+    LOG(ERROR) << what << " failed for shared memory segment " << name << " - " << std::strerror(errno);
+    throw std::runtime_error(what + " failed");
+}
+
+void* map_segment(int fd, std::size_t bytes, int protection, const std::string& name)
+{
+    auto* data = mmap(nullptr, bytes, protection, MAP_SHARED, fd, 0);
+    if (data == MAP_FAILED)
+    {
+        ::close(fd);
+        throw_errno("mmap", name);
+    }
+    ::close(fd);
+    return data;
+}
+
+}  // namespace
+
+SharedMemorySegment::SharedMemorySegment(std::string name, void* data, std::size_t bytes, bool owner) :
+  m_name(std::move(name)),
+  m_data(data),
+  m_bytes(bytes),
+  m_owner(owner)
+{}
+
+SharedMemorySegment::~SharedMemorySegment()
+{
+    munmap(m_data, m_bytes);
+    if (m_owner && shm_unlink(m_name.c_str()) != 0)
+    {
+        LOG(WARNING) << "shm_unlink failed for shared memory segment " << m_name << " - " << std::strerror(errno);
+    }
+}
+
+std::unique_ptr<SharedMemorySegment> SharedMemorySegment::create(std::size_t bytes)
+{
+    static std::atomic<std::size_t> counter{0};
+    return create("/mrc_" + std::to_string(::getpid()) + "_" + std::to_string(counter++), bytes);
+}
+
+std::unique_ptr<SharedMemorySegment> SharedMemorySegment::create(std::string name, std::size_t bytes)
+{
+    // mappings may not be empty
+    bytes = std::max<std::size_t>(bytes, 1);
+
+    auto fd = shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, S_IRUSR | S_IWUSR);
+    if (fd < 0 && errno == EEXIST)
+    {
+        LOG(WARNING) << "replacing stale shared memory segment " << name;
+        shm_unlink(name.c_str());
+        fd = shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, S_IRUSR | S_IWUSR);
+    }
+    if (fd < 0)
+    {
+        throw_errno("shm_open", name);
+    }
+    if (ftruncate(fd, static_cast<off_t>(bytes)) != 0)
+    {
+        ::close(fd);
+        shm_unlink(name.c_str());
+        throw_errno("ftruncate", name);
+    }
+
+    void* data = nullptr;
+    try
+    {
+        data = map_segment(fd, bytes, PROT_READ | PROT_WRITE, name);
+    } catch (...)
+    {
+        shm_unlink(name.c_str());
+        throw;
+    }
+
+    return std::unique_ptr<SharedMemorySegment>(new SharedMemorySegment(std::move(name), data, bytes, true));
+}
+
+std::unique_ptr<SharedMemorySegment> SharedMemorySegment::open(const std::string& name, std::size_t bytes)
+{
+    bytes = std::max<std::size_t>(bytes, 1);
+
+    auto fd = shm_open(name.c_str(), O_RDONLY, 0);
+    if (fd < 0)
+    {
+        throw_errno("shm_open", name);
+    }
+
+    auto* data = map_segment(fd, bytes, PROT_READ, name);
+    return std::unique_ptr<SharedMemorySegment>(new SharedMemorySegment(name, data, bytes, false));
+}
+
+std::unique_ptr<SharedMemorySegment> SharedMemorySegment::open_writable(const std::string& name)
+{
+    auto fd = shm_open(name.c_str(), O_RDWR, 0);
+    if (fd < 0)
+    {
+        throw_errno("shm_open", name);
+    }
+
+    struct stat st;
+    if (fstat(fd, &st) != 0)
+    {
+        ::close(fd);
+        throw_errno("fstat", name);
+    }
+    const auto bytes = std::max<std::size_t>(static_cast<std::size_t>(st.st_size), 1);
+
+    auto* data = map_segment(fd, bytes, PROT_READ | PROT_WRITE, name);
+    return std::unique_ptr<SharedMemorySegment>(new SharedMemorySegment(name, data, bytes, false));
+}
+
+const std::string& SharedMemorySegment::host_name()
+{
+    return utils::host_name();
+}
+
+const std::string& SharedMemorySegment::name() const
+{
+    return m_name;
+}
+
+void* SharedMemorySegment::data()
+{
+    return m_data;
+}
+
+const void* SharedMemorySegment::data() const
+{
+    return m_data;
+}
+
+std::size_t SharedMemorySegment::bytes() const
+{
+    return m_bytes;
+}
+
+}  // namespace mrc::internal::memory
@@ -0,0 +1,85 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "mrc/utils/macros.hpp"
+
+#include <cstddef>
+#include <memory>
+#include <string>
+
+namespace mrc::internal::memory {
+
+/**
+ * @brief A POSIX shared memory segment mapped into the address space of the process
+ *
+ * Segments created by a process are uniquely named and owned by the process; the owner unlinks the segment when the
+ * object is destroyed, while processes on the same host which have opened the segment by name keep their mapping
+ * valid until they release it.
+ */
+class SharedMemorySegment final
+{
+  public:
+    ~SharedMemorySegment();
+
+    DELETE_COPYABILITY(SharedMemorySegment);
+    DELETE_MOVEABILITY(SharedMemorySegment);
+
+    /**
+     * @brief Create and map a new read-write segment of at least bytes bytes
+     */
+    static std::unique_ptr<SharedMemorySegment> create(std::size_t bytes);
+
+    /**
+     * @brief Create and map a new read-write segment of name, which other processes know; a segment left behind by a
+     * process which did not unlink it is replaced
+     */
+    static std::unique_ptr<SharedMemorySegment> create(std::string name, std::size_t bytes);
+
+    /**
+     * @brief Map an existing segment read-only; throws if the segment does not exist on this host
+     */
+    static std::unique_ptr<SharedMemorySegment> open(const std::string& name, std::size_t bytes);
+
+    /**
+     * @brief Map all of an existing segment read-write; throws if the segment does not exist on this host
+     */
+    static std::unique_ptr<SharedMemorySegment> open_writable(const std::string& name);
+
+    /**
+     * @brief Name of the host, used to determine whether a segment is reachable from this process
+     */
+    static const std::string& host_name();
+
+    const std::string& name() const;
+
+    void* data();
+    const void* data() const;
+
+    std::size_t bytes() const;
+
+  private:
+    SharedMemorySegment(std::string name, void* data, std::size_t bytes, bool owner);
+
+    const std::string m_name;
+    void* const m_data;
+    const std::size_t m_bytes;
+    const bool m_owner;
+};
+
+}  // namespace mrc::internal::memory
@@ -0,0 +1,219 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "internal/memory/shared_memory_ring.hpp"
+
+#include "internal/memory/shared_memory.hpp"
+#include "internal/system/futex_event.hpp"
+
+#include <glog/logging.h>
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <new>
+#include <stdexcept>
+#include <utility>
+
+namespace mrc::internal::memory {
+
+namespace {
+
+// "MRCRING1"
+constexpr std::uint64_t RingMagic = 0x31474e495243524d;
+
+}  // namespace
+
+// atomics are shared by processes mapping the segment, which requires them to be free of locks
+static_assert(std::atomic<std::uint64_t>::is_always_lock_free);
+static_assert(std::atomic<std::uint32_t>::is_always_lock_free);
+
+struct SharedMemoryRing::Header
+{
+    explicit Header(std::uint64_t slots) : slot_count(slots) {}
+
+    const std::uint64_t magic{RingMagic};
+    const std::uint64_t slot_count;
+
+    // claimed by producers
+    alignas(64) std::atomic<std::uint64_t> enqueue_position{0};
+
+    // advanced by the consumer
+    alignas(64) std::atomic<std::uint64_t> dequeue_position{0};
+
+    // signaled by producers after writing a message
+    alignas(64) system::FutexEvent readable{0, true};
+    std::atomic<std::uint32_t> closed{0};
+};
+
+struct SharedMemoryRing::Slot
+{
+    // position + 1 once the message of position is written; position + slot_count once it has been read, which is the
+    // position of the next message the slot holds
+    std::atomic<std::uint64_t> sequence;
+    std::uint64_t bytes;
+    std::byte data[MaxMessageBytes];
+};
+
+SharedMemoryRing::SharedMemoryRing(std::unique_ptr<SharedMemorySegment> segment, bool consumer) :
+  m_segment(std::move(segment)),
+  m_header(static_cast<Header*>(m_segment->data())),
+  m_slots(reinterpret_cast<Slot*>(static_cast<std::byte*>(m_segment->data()) + sizeof(Header))),
+  m_consumer(consumer)
+{
+    static_assert(sizeof(Slot) == SlotBytes);
+}
+
+SharedMemoryRing::~SharedMemoryRing()
+{
+    if (m_consumer)
+    {
+        close();
+    }
+}
+
+std::unique_ptr<SharedMemoryRing> SharedMemoryRing::create(std::string name, std::size_t bytes)
+{
+    const auto slots = std::bit_floor(std::max<std::size_t>(bytes / SlotBytes, 2));
+    auto segment     = SharedMemorySegment::create(std::move(name), sizeof(Header) + slots * SlotBytes);
+
+    auto* header = new (segment->data()) Header(slots);
+    auto* first  = reinterpret_cast<Slot*>(static_cast<std::byte*>(segment->data()) + sizeof(Header));
+    for (std::uint64_t i = 0; i < header->slot_count; ++i)
+    {
+        new (&first[i].sequence) std::atomic<std::uint64_t>(i);
+    }
+
+    DVLOG(10) << "created shared memory ring " << segment->name() << " of " << slots << " slots";
+    return std::unique_ptr<SharedMemoryRing>(new SharedMemoryRing(std::move(segment), true));
+}
+
+std::unique_ptr<SharedMemoryRing> SharedMemoryRing::open(const std::string& name)
+{
+    auto segment = SharedMemorySegment::open_writable(name);
+
+    const auto* header = static_cast<const Header*>(segment->data());
+    if (segment->bytes() < sizeof(Header) || header->magic != RingMagic ||
+        segment->bytes() < sizeof(Header) + header->slot_count * SlotBytes)
+    {
+        LOG(ERROR) << "shared memory segment " << name << " does not hold a ring";
+        throw std::runtime_error("invalid shared memory ring");
+    }
+
+    return std::unique_ptr<SharedMemoryRing>(new SharedMemoryRing(std::move(segment), false));
+}
+
+channel::Status SharedMemoryRing::try_write(std::size_t bytes, const std::function<void(void*)>& write_fn)
+{
+    DCHECK(!m_consumer);
+    CHECK_LE(bytes, MaxMessageBytes);
+
+    if (is_closed())
+    {
+        return channel::Status::closed;
+    }
+
+    auto position = m_header->enqueue_position.load(std::memory_order_relaxed);
+    while (true)
+    {
+        const auto sequence = slot(position).sequence.load(std::memory_order_acquire);
+        const auto lag      = static_cast<std::int64_t>(sequence - position);
+        if (lag == 0)
+        {
+            if (m_header->enqueue_position.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+            {
+                break;
+            }
+        }
+        else if (lag < 0)
+        {
+            // the slot still holds the message of the previous lap
+            return channel::Status::full;
+        }
+        else
+        {
+            position = m_header->enqueue_position.load(std::memory_order_relaxed);
+        }
+    }
+
+    auto& claimed = slot(position);
+    claimed.bytes = bytes;
+    write_fn(claimed.data);
+    claimed.sequence.store(position + 1, std::memory_order_release);
+
+    m_header->readable.notify();
+    return channel::Status::success;
+}
+
+channel::Status SharedMemoryRing::read(const std::function<void(const void*, std::size_t)>& read_fn,
+                                       std::chrono::steady_clock::time_point deadline)
+{
+    DCHECK(m_consumer);
+
+    while (true)
+    {
+        const auto position = m_header->dequeue_position.load(std::memory_order_relaxed);
+        auto& next          = slot(position);
+        if (next.sequence.load(std::memory_order_acquire) == position + 1)
+        {
+            read_fn(next.data, next.bytes);
+            next.sequence.store(position + m_header->slot_count, std::memory_order_release);
+            m_header->dequeue_position.store(position + 1, std::memory_order_relaxed);
+            return channel::Status::success;
+        }
+
+        // a slot claimed before the ring was closed is awaited
+        if (is_closed() && m_header->enqueue_position.load(std::memory_order_relaxed) == position)
+        {
+            return channel::Status::closed;
+        }
+        if (std::chrono::steady_clock::now() >= deadline)
+        {
+            return channel::Status::timeout;
+        }
+        m_header->readable.wait_until(deadline);
+    }
+}
+
+void SharedMemoryRing::close()
+{
+    DCHECK(m_consumer);
+    m_header->closed.store(1, std::memory_order_release);
+    m_header->readable.notify();
+}
+
+bool SharedMemoryRing::is_closed() const
+{
+    return m_header->closed.load(std::memory_order_acquire) != 0;
+}
+
+const std::string& SharedMemoryRing::name() const
+{
+    return m_segment->name();
+}
+
+std::size_t SharedMemoryRing::slot_count() const
+{
+    return m_header->slot_count;
+}
+
+SharedMemoryRing::Slot& SharedMemoryRing::slot(std::uint64_t position)
+{
+    return m_slots[position & (m_header->slot_count - 1)];
+}
+
+}  // namespace mrc::internal::memory
@@ -0,0 +1,113 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "mrc/channel/status.hpp"
+#include "mrc/utils/macros.hpp"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+
+namespace mrc::internal::memory {
+
+class SharedMemorySegment;
+
+/**
+ * @brief Bounded multi-producer single-consumer queue of messages in a POSIX shared memory segment
+ *
+ * The consumer creates the ring under a name known to the producers, which open it from other processes on the same
+ * host. Messages are copied into fixed size slots; each slot carries a sequence number which orders the hand-off of
+ * the slot between producers and the consumer, so neither side takes a lock and a producer only claims a slot with a
+ * compare-and-swap of the shared enqueue position. Messages larger than MaxMessageBytes are not accepted.
+ *
+ * An idle consumer parks on a process-shared futex which producers signal after writing a message; producers never
+ * block, a full ring is returned to them as channel::Status::full.
+ *
+ * A producer which dies between claiming a slot and writing it stalls the consumer at that slot; rings are meant for
+ * processes of the same pipeline, which fail together.
+ */
+class SharedMemoryRing final
+{
+  public:
+    // bytes of a slot, including the header of its message
+    static constexpr std::size_t SlotBytes = 1024;
+
+    // largest message accepted by try_write
+    static constexpr std::size_t MaxMessageBytes = SlotBytes - 16;
+
+    ~SharedMemoryRing();
+
+    DELETE_COPYABILITY(SharedMemoryRing);
+    DELETE_MOVEABILITY(SharedMemoryRing);
+
+    /**
+     * @brief Create the ring of the consumer with the slots fitting into bytes, rounded down to a power of 2
+     */
+    static std::unique_ptr<SharedMemoryRing> create(std::string name, std::size_t bytes);
+
+    /**
+     * @brief Open the ring of a consumer as a producer; throws if the ring does not exist on this host
+     */
+    static std::unique_ptr<SharedMemoryRing> open(const std::string& name);
+
+    /**
+     * @brief Claim a slot and write a message of bytes into it with write_fn
+     *
+     * Returns Status::full if every slot holds a message, Status::closed once the consumer closed the ring.
+     */
+    channel::Status try_write(std::size_t bytes, const std::function<void(void*)>& write_fn);
+
+    /**
+     * @brief Consumer only: pass the oldest message to read_fn and release its slot
+     *
+     * Blocks until a message is written or deadline; returns Status::timeout at the deadline, and Status::closed once
+     * the ring is closed and every message written before has been read.
+     */
+    channel::Status read(const std::function<void(const void*, std::size_t)>& read_fn,
+                         std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::time_point::max());
+
+    /**
+     * @brief Consumer only: refuse further writes and wake the consumer; messages already written remain readable
+     */
+    void close();
+
+    bool is_closed() const;
+
+    const std::string& name() const;
+
+    std::size_t slot_count() const;
+
+  private:
+    struct Header;
+    struct Slot;
+
+    SharedMemoryRing(std::unique_ptr<SharedMemorySegment> segment, bool consumer);
+
+    Slot& slot(std::uint64_t position);
+
+    std::unique_ptr<SharedMemorySegment> m_segment;
+    Header* m_header;
+    Slot* m_slots;
+    const bool m_consumer;
+};
+
+}  // namespace mrc::internal::memory
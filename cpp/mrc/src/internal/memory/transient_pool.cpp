@@ -17,29 +17,172 @@
 
 #include "internal/memory/transient_pool.hpp"
 
+#include <chrono>
+#include <mutex>
 #include <ostream>
 
 #define MRC_DEBUG 1
 
 namespace mrc::internal::memory {
 
-TransientBuffer::TransientBuffer(void* addr, std::size_t bytes, mrc::data::SharedReusable<mrc::memory::buffer> buffer) :
+TransientBlock::TransientBlock(mrc::data::Reusable<mrc::memory::buffer> buffer,
+                               std::shared_ptr<detail::TransientBlockOwner> owner) :
+  m_thread(std::this_thread::get_id()),
+  m_buffer(std::move(buffer)),
+  m_owner(std::move(owner))
+{
+    // link into the unmerged blocks of the owner
+    m_next = m_owner->unmerged;
+    if (m_next != nullptr)
+    {
+        m_next->m_prev = this;
+    }
+    m_owner->unmerged = this;
+}
+
+TransientBlock::~TransientBlock()
+{
+    // returning the buffer to the pool may wake a TransientPool waiting for a block
+    m_buffer.release();
+    std::lock_guard<Mutex> lock(m_owner->mutex);
+    m_owner->returned++;
+    m_owner->cv.notify_all();
+}
+
+void* TransientBlock::data()
+{
+    return m_buffer->data();
+}
+
+std::size_t TransientBlock::bytes()
+{
+    return m_buffer->bytes();
+}
+
+bool TransientBlock::is_biased() const
+{
+    // the merged flag is only read and written by the owning thread
+    return (std::this_thread::get_id() == m_thread && !m_merged);
+}
+
+void TransientBlock::acquire(std::size_t count)
+{
+    if (is_biased())
+    {
+        m_biased += count;
+        return;
+    }
+    m_state.fetch_add(One * static_cast<std::int64_t>(count), std::memory_order_relaxed);
+}
+
+void TransientBlock::release(std::size_t count)
+{
+    if (is_biased())
+    {
+        DCHECK_GE(m_biased, count);
+        m_biased -= count;
+        if (m_biased == 0)
+        {
+            merge();
+        }
+        return;
+    }
+
+    // a count dropping below zero before the merge means the owning thread holds the outstanding references
+    auto state = m_state.load(std::memory_order_relaxed);
+    std::int64_t next;
+    do
+    {
+        next = state - One * static_cast<std::int64_t>(count);
+        if ((next & (Merged | Queued)) == 0 && next < 0)
+        {
+            next |= Queued;
+        }
+    } while (!m_state.compare_exchange_weak(state, next, std::memory_order_acq_rel, std::memory_order_relaxed));
+
+    if ((next & Queued) != 0 && (state & Queued) == 0)
+    {
+        // a queued block is only freed by the owner once dequeued
+        std::lock_guard<Mutex> lock(m_owner->mutex);
+        m_owner->queued.push_back(this);
+        m_owner->has_queued.store(true, std::memory_order_release);
+        m_owner->cv.notify_all();
+        return;
+    }
+
+    if (next == Merged)
+    {
+        delete this;
+    }
+}
+
+void TransientBlock::merge()
+{
+    DCHECK(!m_merged);
+    unlink();
+    m_merged    = true;
+    auto biased = One * static_cast<std::int64_t>(std::exchange(m_biased, 0));
+    auto next   = m_state.fetch_add(biased + Merged, std::memory_order_acq_rel) + biased + Merged;
+    if (next == Merged)
+    {
+        delete this;
+    }
+}
+
+void TransientBlock::on_dequeued()
+{
+    if (!m_merged)
+    {
+        unlink();
+        m_merged    = true;
+        auto biased = One * static_cast<std::int64_t>(std::exchange(m_biased, 0));
+        m_state.fetch_add(biased + Merged, std::memory_order_acq_rel);
+    }
+    auto state = m_state.fetch_and(~Queued, std::memory_order_acq_rel);
+    if ((state & ~Queued) == Merged)
+    {
+        delete this;
+    }
+}
+
+void TransientBlock::unlink()
+{
+    if (m_prev != nullptr)
+    {
+        m_prev->m_next = m_next;
+    }
+    else
+    {
+        m_owner->unmerged = m_next;
+    }
+    if (m_next != nullptr)
+    {
+        m_next->m_prev = m_prev;
+    }
+    m_prev = m_next = nullptr;
+}
+
+TransientBuffer::TransientBuffer(void* addr, std::size_t bytes, TransientBlock* block) :
   m_addr(addr),
   m_bytes(bytes),
-  m_buffer(std::move(buffer))
-{}
+  m_block(block)
+{
+    DCHECK(m_block);
+}
 
 TransientBuffer::TransientBuffer(void* addr, std::size_t bytes, const TransientBuffer& buffer) :
   m_addr(addr),
   m_bytes(bytes),
-  m_buffer(buffer.m_buffer)
+  m_block(buffer.m_block)
 {
+    CHECK(m_block);
     auto* c = static_cast<std::byte*>(addr);
     auto* b = static_cast<std::byte*>(const_cast<void*>(buffer.data()));
     CHECK_GE(c, b);
     c += bytes;
     b += buffer.bytes();
     CHECK_LE(c, b);
+    m_block->acquire();
 }
 
 TransientBuffer::~TransientBuffer()
@@ -50,14 +193,15 @@ TransientBuffer::~TransientBuffer()
 TransientBuffer::TransientBuffer(TransientBuffer&& other) noexcept :
   m_addr(std::exchange(other.m_addr, nullptr)),
   m_bytes(std::exchange(other.m_bytes, 0UL)),
-  m_buffer(std::move(other.m_buffer))
+  m_block(std::exchange(other.m_block, nullptr))
 {}
 
 TransientBuffer& TransientBuffer::operator=(TransientBuffer&& other) noexcept
 {
-    m_addr   = std::exchange(other.m_addr, nullptr);
-    m_bytes  = std::exchange(other.m_bytes, 0UL);
-    m_buffer = std::move(other.m_buffer);
+    release();
+    m_addr  = std::exchange(other.m_addr, nullptr);
+    m_bytes = std::exchange(other.m_bytes, 0UL);
+    m_block = std::exchange(other.m_block, nullptr);
     return *this;
 }
 
@@ -78,11 +222,40 @@ std::size_t TransientBuffer::bytes() const
 
 void TransientBuffer::release()
 {
-    if (m_addr != nullptr)
+    if (m_block != nullptr)
     {
         m_addr  = nullptr;
         m_bytes = 0;
-        m_buffer.release();
+        std::exchange(m_block, nullptr)->release();
+    }
+}
+
+void TransientBuffer::release_all(std::span<TransientBuffer> buffers)
+{
+    TransientBlock* block = nullptr;
+    std::size_t count     = 0;
+    for (auto& buffer : buffers)
+    {
+        if (buffer.m_block != block)
+        {
+            if (block != nullptr)
+            {
+                block->release(count);
+            }
+            block = buffer.m_block;
+            count = 0;
+        }
+        if (buffer.m_block != nullptr)
+        {
+            buffer.m_addr  = nullptr;
+            buffer.m_bytes = 0;
+            buffer.m_block = nullptr;
+            count++;
+        }
+    }
+    if (block != nullptr)
+    {
+        block->release(count);
     }
 }
 
@@ -91,7 +264,8 @@ TransientPool::TransientPool(std::size_t block_size,
                              std::shared_ptr<mrc::memory::memory_resource> mr,
                              std::size_t capacity) :
   m_block_size(block_size),
-  m_pool(mrc::data::ReusablePool<mrc::memory::buffer>::create(capacity))
+  m_owner(std::make_shared<detail::TransientBlockOwner>()),
+  m_pool(mrc::data::CachedReusablePool<mrc::memory::buffer>::create(capacity))
 {
     CHECK(m_pool);
     CHECK_LT(block_count, capacity);
@@ -101,6 +275,21 @@ TransientPool::TransientPool(std::size_t block_size,
     }
 }
 
+TransientPool::~TransientPool()
+{
+    if (m_block != nullptr)
+    {
+        m_block->release();
+    }
+    merge_queued();
+
+    // blocks still referenced hand their biased count over, so they are freed wherever they are released last
+    while (m_owner->unmerged != nullptr)
+    {
+        m_owner->unmerged->merge();
+    }
+}
+
 TransientBuffer TransientPool::await_buffer(std::size_t bytes)
 {
     if (bytes > m_block_size)  // todo(#54) [[unlikely]]
@@ -111,10 +300,14 @@ TransientBuffer TransientPool::await_buffer(std::size_t bytes)
 
     if (m_remaining < bytes)
     {
-        auto buffer = m_pool->await_item();
-        m_addr      = static_cast<std::byte*>(buffer->data());
-        m_remaining = buffer->bytes();
-        m_buffer    = std::move(buffer);
+        if (m_block != nullptr)
+        {
+            std::exchange(m_block, nullptr)->release();
+        }
+        m_block = new TransientBlock(await_block_buffer(), m_owner);
+        m_block->acquire();
+        m_addr      = static_cast<std::byte*>(m_block->data());
+        m_remaining = m_block->bytes();
     }
 
     // align + bytes
@@ -122,7 +315,51 @@ TransientBuffer TransientPool::await_buffer(std::size_t bytes)
     m_addr += bytes;
     m_remaining -= bytes;
 
-    return {addr, bytes, m_buffer};
+    m_block->acquire();
+    return {addr, bytes, m_block};
+}
+
+mrc::data::Reusable<mrc::memory::buffer> TransientPool::await_block_buffer()
+{
+    while (true)
+    {
+        merge_queued();
+        auto returned = m_owner->returned.load();
+        if (auto buffer = m_pool->try_item())
+        {
+            return std::move(*buffer);
+        }
+
+        // blocks freed on any thread notify the owner; the timeout covers a buffer still on its way into the pool
+        std::unique_lock<Mutex> lock(m_owner->mutex);
+        m_owner->cv.wait_for(lock, std::chrono::milliseconds(1), [this, returned] {
+            return m_owner->returned != returned || !m_owner->queued.empty();
+        });
+    }
+}
+
+void TransientPool::merge_queued()
+{
+    if (!m_owner->has_queued.load(std::memory_order_acquire))
+    {
+        return;
+    }
+
+    std::vector<TransientBlock*> queued;
+    {
+        std::lock_guard<Mutex> lock(m_owner->mutex);
+        queued.swap(m_owner->queued);
+        m_owner->has_queued.store(false, std::memory_order_relaxed);
+    }
+    for (auto* block : queued)
+    {
+        block->on_dequeued();
+    }
+}
+
+std::size_t TransientPool::block_size() const
+{
+    return m_block_size;
 }
 
 }  // namespace mrc::internal::memory
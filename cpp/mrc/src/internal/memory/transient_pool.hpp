@@ -17,16 +17,23 @@
 
 #pragma once
 
+#include "mrc/data/cached_reusable_pool.hpp"
 #include "mrc/data/reusable_pool.hpp"
 #include "mrc/memory/buffer.hpp"
+#include "mrc/types.hpp"  // for CondV & Mutex
 #include "mrc/utils/macros.hpp"
 
 #include <glog/logging.h>
 
+#include <atomic>
 #include <cstddef>
+#include <cstdint>
 #include <memory>
 #include <new>
+#include <span>
+#include <thread>
 #include <utility>
+#include <vector>
 
 namespace mrc::memory {
 struct memory_resource;
@@ -34,8 +41,81 @@ struct memory_resource;
 
 namespace mrc::internal::memory {
 
+class TransientBlock;
+
+namespace detail {
+
+/**
+ * @brief State shared by a TransientPool and the blocks it carved
+ */
+struct TransientBlockOwner
+{
+    // blocks released on other threads by more references than were acquired there; merged by the owning thread
+    Mutex mutex;
+    CondV cv;
+    std::vector<TransientBlock*> queued;
+    std::atomic<std::uint64_t> returned{0};
+    std::atomic<bool> has_queued{false};
+
+    // blocks still counting references of the owning thread in their biased count; owning thread only
+    TransientBlock* unmerged{nullptr};
+};
+
+}  // namespace detail
+
 /**
- * @brief A short-lived buffer based on a portion of a data::SharedResable<memory::buffer>
+ * @brief Intrusively reference-counted block of a TransientPool, returning its memory::buffer to the pool once the
+ * last TransientBuffer carved from it is released.
+ *
+ * The count is biased towards the thread which created the block: references acquired and released on that thread
+ * update a plain counter, while all other threads update an atomic counter. The owning thread merges its counter into
+ * the atomic one once its own references are gone, after which the block is freed by whichever thread releases the
+ * last reference. When other threads release references which the owning thread acquired, the atomic counter drops
+ * below zero and the block is queued back to its TransientPool, which merges it on its next refill.
+ */
+class TransientBlock final
+{
+  public:
+    DELETE_COPYABILITY(TransientBlock);
+    DELETE_MOVEABILITY(TransientBlock);
+
+    void* data();
+    std::size_t bytes();
+
+    void acquire(std::size_t count = 1);
+    void release(std::size_t count = 1);
+
+  private:
+    // the atomic state holds the references counted outside the biased count in multiples of One and two flags
+    static constexpr std::int64_t Merged = 1;
+    static constexpr std::int64_t Queued = 2;
+    static constexpr std::int64_t One    = 4;
+
+    TransientBlock(mrc::data::Reusable<mrc::memory::buffer> buffer, std::shared_ptr<detail::TransientBlockOwner> owner);
+    ~TransientBlock();
+
+    bool is_biased() const;
+
+    // owning thread only
+    void merge();
+    void on_dequeued();
+    void unlink();
+
+    const std::thread::id m_thread;
+    std::size_t m_biased{0};
+    bool m_merged{false};
+    TransientBlock* m_prev{nullptr};
+    TransientBlock* m_next{nullptr};
+
+    alignas(64) std::atomic<std::int64_t> m_state{0};
+    mrc::data::Reusable<mrc::memory::buffer> m_buffer;
+    const std::shared_ptr<detail::TransientBlockOwner> m_owner;
+
+    friend class TransientPool;
+};
+
+/**
+ * @brief A short-lived buffer based on a portion of a TransientBlock
  *
  * @see TransientPool for more details.
  */
@@ -48,9 +128,9 @@ class TransientBuffer
      *
      * @param addr - starting address of the buffer
      * @param bytes - number of bytes allocated to this buffer starting at addr
-     * @param buffer - reference counted holder to the SharedReusable, this is held for reference counting only
+     * @param block - block holding the buffer; the TransientBuffer adopts a reference acquired by the caller
      */
-    TransientBuffer(void* addr, std::size_t bytes, mrc::data::SharedReusable<mrc::memory::buffer> buffer);
+    TransientBuffer(void* addr, std::size_t bytes, TransientBlock* block);
     TransientBuffer(void* addr, std::size_t bytes, const TransientBuffer& buffer);
 
     TransientBuffer() = default;
@@ -77,10 +157,16 @@ class TransientBuffer
      */
     void release();
 
+    /**
+     * @brief Release many buffers at once; buffers adjacent in the span which share a block release their references
+     * with a single update of the block's count.
+     */
+    static void release_all(std::span<TransientBuffer> buffers);
+
   private:
     void* m_addr{nullptr};
     std::size_t m_bytes{0};
-    mrc::data::SharedReusable<mrc::memory::buffer> m_buffer;
+    TransientBlock* m_block{nullptr};
 };
 
 /**
@@ -152,17 +238,18 @@ class Transient final : private TransientBuffer
 };
 
 /**
- * @brief ReusablePool of memory::buffers that are used as reusable reference-counted monotonic memory resources
+ * @brief CachedReusablePool of memory::buffers that are used as reusable reference-counted monotonic memory resources
  *
- * TransientPool is a ReusablePool of memory::buffers from which smaller buffers are allocated similar to a monotonic
- * memory resource, i.e. pointer pushing stack; however the TransientBuffer or Transient<T> object pull from the pool
- * hold a SharedReusable<memory::buffer> which keeps the entire monotonic stack from returning to the resuable pool
- * until all objects created on a given stack are deallocated.
+ * TransientPool is a CachedReusablePool of memory::buffers from which smaller buffers are allocated similar to a
+ * monotonic memory resource, i.e. pointer pushing stack; however the TransientBuffer or Transient<T> object pull from
+ * the pool hold a reference to the TransientBlock which keeps the entire monotonic stack from returning to the resuable
+ * pool until all objects created on a given stack are deallocated.
  *
  * Allocation of Transisent object should be incredibly fast; even faster than the Reusable/SharedResuable on which they
  * are based, since a single Reusable<memory::buffer> might back 10s-1000s of allocations dependending on size.
  *
- * It is critical that all Transient object allocated from a pool have similar life cycles
+ * It is critical that all Transient object allocated from a pool have similar life cycles. A pool is used from a
+ * single thread, which is the owning thread of its blocks, and must be destroyed on that thread.
  */
 class TransientPool
 {
@@ -171,6 +258,10 @@ class TransientPool
                   std::size_t block_count,
                   std::shared_ptr<mrc::memory::memory_resource> mr,
                   std::size_t capacity = 64);
+    ~TransientPool();
+
+    DELETE_COPYABILITY(TransientPool);
+    DELETE_MOVEABILITY(TransientPool);
 
     /**
      * @brief Acquire a TransientBuffer of size bytes.
@@ -197,12 +288,22 @@ class TransientPool
         return Transient<T>(std::move(buffer), std::forward<ArgsT>(args)...);
     }
 
+    /**
+     * @brief The size of each block in the pool; the largest TransientBuffer which can be acquired.
+     */
+    std::size_t block_size() const;
+
   private:
+    // merges the blocks queued back by other threads, then waits for a buffer to be returned to the pool
+    mrc::data::Reusable<mrc::memory::buffer> await_block_buffer();
+    void merge_queued();
+
     const std::size_t m_block_size;
-    const std::shared_ptr<mrc::data::ReusablePool<mrc::memory::buffer>> m_pool;
+    const std::shared_ptr<detail::TransientBlockOwner> m_owner;
+    const std::shared_ptr<mrc::data::CachedReusablePool<mrc::memory::buffer>> m_pool;
     std::byte* m_addr{nullptr};
     std::size_t m_remaining{0};
-    mrc::data::SharedReusable<mrc::memory::buffer> m_buffer;
+    TransientBlock* m_block{nullptr};
 };
 
 }  // namespace mrc::internal::memory
@@ -0,0 +1,231 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "internal/pipeline/autoscaler.hpp"
+
+#include "mrc/core/addresses.hpp"
+#include "mrc/options/scaling.hpp"
+
+#include <glog/logging.h>
+
+#include <algorithm>
+#include <chrono>
+#include <ostream>
+#include <tuple>
+#include <utility>
+
+namespace mrc::internal::pipeline {
+
+namespace {
+
+std::pair<std::size_t, std::size_t> count_bounds(const protos::ScalingOptions& options)
+{
+    auto min_count = std::max<std::size_t>(options.min_count(), 1);
+    auto max_count = std::max<std::size_t>(options.max_count(), min_count);
+    return {min_count, max_count};
+}
+
+}  // namespace
+
+Autoscaler::Autoscaler(std::map<SegmentID, protos::ScalingOptions> options, std::size_t partition_count) :
+  m_partition_count(partition_count)
+{
+    CHECK_GT(m_partition_count, 0);
+    for (auto& [id, segment_options] : options)
+    {
+        if (segment_options.strategy() == protos::ScalingOptions::Dynamic)
+        {
+            m_segments[id].options = std::move(segment_options);
+        }
+    }
+}
+
+protos::ScalingOptions Autoscaler::encode(const SegmentScalingOptions& options)
+{
+    protos::ScalingOptions proto;
+    proto.set_strategy(options.strategy() == ScalingStrategy::Dynamic ? protos::ScalingOptions::Dynamic
+                                                                       : protos::ScalingOptions::Static);
+    proto.set_initial_count(options.initial_count());
+    proto.set_min_count(options.min_count());
+    proto.set_max_count(options.max_count());
+    proto.set_cooldown_ms(options.cooldown().count());
+    proto.set_scale_up_queue_depth(options.scale_up_queue_depth());
+    proto.set_scale_down_queue_depth(options.scale_down_queue_depth());
+    proto.set_instance_throughput(options.instance_throughput());
+    return proto;
+}
+
+std::size_t Autoscaler::initial_count(const protos::ScalingOptions& options)
+{
+    auto count = std::max<std::size_t>(options.initial_count(), 1);
+    if (options.strategy() == protos::ScalingOptions::Dynamic)
+    {
+        auto [min_count, max_count] = count_bounds(options);
+        count                       = std::clamp(count, min_count, max_count);
+    }
+    return count;
+}
+
+std::size_t Autoscaler::target_count(const protos::ScalingOptions& options,
+                                     std::size_t count,
+                                     std::size_t queue_depth,
+                                     double throughput)
+{
+    auto [min_count, max_count] = count_bounds(options);
+    if (count < min_count || count > max_count)
+    {
+        return std::clamp(count, min_count, max_count);
+    }
+
+    // compare the total depth against the per instance thresholds scaled by the count to stay in integers
+    if (options.scale_up_queue_depth() > 0 && queue_depth > options.scale_up_queue_depth() * count &&
+        count < max_count)
+    {
+        return count + 1;
+    }
+
+    if (queue_depth <= options.scale_down_queue_depth() * count && count > min_count)
+    {
+        // only drain an instance if the remaining instances sustain the observed throughput
+        if (options.instance_throughput() <= 0 || throughput <= options.instance_throughput() * (count - 1))
+        {
+            return count - 1;
+        }
+    }
+
+    return count;
+}
+
+bool Autoscaler::empty() const
+{
+    return m_segments.empty();
+}
+
+std::optional<SegmentAddresses> Autoscaler::evaluate(
+    const SegmentAddresses& current,
+    const std::map<SegmentAddress, channel::ChannelStatistics>& ingress,
+    channel::time_point_t now)
+{
+    bool scaled = false;
+    auto next   = current;
+
+    for (auto& [id, state] : m_segments)
+    {
+        // running instances of the segment ordered by rank
+        std::map<SegmentRank, SegmentAddress> instances;
+        for (const auto& [address, partition_id] : current)
+        {
+            auto [segment_id, rank] = segment_address_decode(address);
+            if (segment_id == id)
+            {
+                instances[rank] = address;
+            }
+        }
+
+        if (instances.empty())
+        {
+            continue;
+        }
+
+        // reads are only counted for instances sampled at both evaluations
+        std::size_t queue_depth = 0;
+        std::uint64_t reads     = 0;
+        std::map<SegmentAddress, std::uint64_t> sampled_reads;
+        for (const auto& [rank, address] : instances)
+        {
+            auto search = ingress.find(address);
+            if (search == ingress.end())
+            {
+                continue;
+            }
+
+            queue_depth += search->second.occupancy;
+            sampled_reads[address] = search->second.reads;
+
+            auto previous = state.reads.find(address);
+            if (previous != state.reads.end() && search->second.reads >= previous->second)
+            {
+                reads += search->second.reads - previous->second;
+            }
+        }
+        state.reads = std::move(sampled_reads);
+
+        // the first sample only establishes the baseline and starts the cooldown
+        if (!state.last_sample)
+        {
+            state.last_sample = now;
+            state.last_scaled = now;
+            continue;
+        }
+
+        auto elapsed      = std::chrono::duration<double>(now - *state.last_sample).count();
+        state.last_sample = now;
+
+        if (now - state.last_scaled < std::chrono::milliseconds(state.options.cooldown_ms()))
+        {
+            continue;
+        }
+
+        auto throughput = (elapsed > 0 ? static_cast<double>(reads) / elapsed : 0.0);
+        auto count      = instances.size();
+        auto target     = target_count(state.options, count, queue_depth, throughput);
+
+        if (target == count)
+        {
+            continue;
+        }
+
+        if (target > count)
+        {
+            // fill the lowest free ranks
+            SegmentRank rank = 0;
+            for (auto added = count; added < target; ++rank)
+            {
+                if (instances.contains(rank))
+                {
+                    continue;
+                }
+                next[segment_address_encode(id, rank)] = rank % m_partition_count;
+                ++added;
+            }
+        }
+        else
+        {
+            // drain the highest ranks
+            auto it = instances.rbegin();
+            for (auto removed = target; removed < count; ++removed, ++it)
+            {
+                next.erase(it->second);
+            }
+        }
+
+        VLOG(10) << "autoscaler: scaling segment " << id << " from " << count << " to " << target
+                 << " instances; ingress queue depth: " << queue_depth << "; throughput: " << throughput << "/s";
+
+        state.last_scaled = now;
+        scaled            = true;
+    }
+
+    if (!scaled)
+    {
+        return std::nullopt;
+    }
+
+    return next;
+}
+
+}  // namespace mrc::internal::pipeline
@@ -0,0 +1,89 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "internal/pipeline/types.hpp"
+
+#include "mrc/channel/telemetry.hpp"
+#include "mrc/channel/types.hpp"
+#include "mrc/protos/architect.pb.h"
+#include "mrc/types.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <optional>
+
+namespace mrc {
+class SegmentScalingOptions;
+}  // namespace mrc
+
+namespace mrc::internal::pipeline {
+
+/**
+ * @brief Decides the instance counts of the Dynamic segments of a pipeline from the load on their ingress ports.
+ *
+ * Each evaluation samples the combined ingress queue depth and the read throughput of every instance of a segment.
+ * A segment whose mean queue depth per instance exceeds scale_up_queue_depth gains an instance; a segment whose mean
+ * queue depth is at or below scale_down_queue_depth, and whose throughput the remaining instances can carry, loses its
+ * highest ranked instance. Counts move by one instance per decision, a segment is not scaled again within its cooldown
+ * and counts always stay within [min_count, max_count].
+ */
+class Autoscaler
+{
+  public:
+    Autoscaler(std::map<SegmentID, protos::ScalingOptions> options, std::size_t partition_count);
+
+    static protos::ScalingOptions encode(const SegmentScalingOptions& options);
+
+    // number of instances a segment with the given scaling options runs with on start
+    static std::size_t initial_count(const protos::ScalingOptions& options);
+
+    // instance count the load calls for, ignoring the cooldown
+    static std::size_t target_count(const protos::ScalingOptions& options,
+                                    std::size_t count,
+                                    std::size_t queue_depth,
+                                    double throughput);
+
+    bool empty() const;
+
+    /**
+     * @brief Evaluate the scaling decisions of all Dynamic segments
+     *
+     * @param current assignments of all running segments
+     * @param ingress ingress statistics of each of the running segments
+     * @return the new assignments if any segment was scaled; removed addresses are expected to be drained
+     */
+    std::optional<SegmentAddresses> evaluate(const SegmentAddresses& current,
+                                             const std::map<SegmentAddress, channel::ChannelStatistics>& ingress,
+                                             channel::time_point_t now);
+
+  private:
+    struct SegmentState
+    {
+        protos::ScalingOptions options;
+        std::optional<channel::time_point_t> last_sample;
+        channel::time_point_t last_scaled;
+        std::map<SegmentAddress, std::uint64_t> reads;
+    };
+
+    std::map<SegmentID, SegmentState> m_segments;
+    std::size_t m_partition_count;
+};
+
+}  // namespace mrc::internal::pipeline
@@ -17,9 +17,12 @@
 
 #include "internal/pipeline/controller.hpp"
 
+#include "internal/pipeline/autoscaler.hpp"
 #include "internal/pipeline/instance.hpp"
 #include "internal/pipeline/types.hpp"
 
+#include "mrc/channel/telemetry.hpp"
+#include "mrc/channel/types.hpp"
 #include "mrc/core/utils.hpp"
 #include "mrc/runnable/context.hpp"
 #include "mrc/segment/utils.hpp"
@@ -40,7 +43,9 @@
 
 namespace mrc::internal::pipeline {
 
-Controller::Controller(std::unique_ptr<Instance> pipeline) : m_pipeline(std::move(pipeline))
+Controller::Controller(std::unique_ptr<Instance> pipeline, std::unique_ptr<Autoscaler> autoscaler) :
+  m_pipeline(std::move(pipeline)),
+  m_autoscaler(std::move(autoscaler))
 {
     CHECK(m_pipeline);
     m_pipeline->service_start();
@@ -66,6 +71,17 @@ void Controller::on_data(ControlMessage&& message)
             std::rethrow_exception(std::current_exception());
         }
         break;
+    case ControlMessageType::Scale:
+        try
+        {
+            scale();
+        } catch (...)
+        {
+            LOG(ERROR) << "exception caught while scaling - this is fatal - issuing kill";
+            kill();
+            std::rethrow_exception(std::current_exception());
+        }
+        break;
     case ControlMessageType::Stop:
         stop();
         break;
@@ -117,26 +133,39 @@ void Controller::update(SegmentAddresses&& new_segments_map)
                         std::inserter(remove_segments, remove_segments.end()));
     DVLOG(10) << info() << remove_segments.size() << " segments marked for removal";
 
-    // construct new segments and attach to manifold
+    // construct new segments concurrently and attach to manifold
+    SegmentAddresses new_segment_partitions;
     for (const auto& address : create_segments)
     {
         auto partition_id = new_segments_map.at(address);
         DVLOG(10) << info() << ": create segment for address " << ::mrc::segment::info(address)
                   << " on resource partition: " << partition_id;
-        m_pipeline->create_segment(address, partition_id);
+        new_segment_partitions[address] = partition_id;
     }
+    m_pipeline->create_segments(new_segment_partitions);
 
     // detach from manifold or stop old segments
     for (const auto& address : remove_segments)
     {
-        DVLOG(10) << info() << ": stop segment for address " << ::mrc::segment::info(address);
-        m_pipeline->stop_segment(address);
+        DVLOG(10) << info() << ": drain segment for address " << ::mrc::segment::info(address);
+        m_pipeline->drain_segment(address);
     }
 
     // m_pipeline->manifold_update_inputs();
 
     m_pipeline->update();
 
+    // detached segments complete once they have processed the data routed to them before the update
+    for (const auto& address : remove_segments)
+    {
+        DVLOG(10) << info() << ": awaiting drained segment for address " << ::mrc::segment::info(address);
+        m_pipeline->join_segment(address);
+        m_pipeline->remove_segment(address);
+    }
+
+    // prepare the instances of the next scale out once the update is live
+    m_pipeline->refill_warm_segments();
+
     // when ready issue update
     // this should start all segments
     // m_pipeline->update();
@@ -151,6 +180,28 @@ void Controller::update(SegmentAddresses&& new_segments_map)
     VLOG(10) << info() << ": update complete";
 }
 
+void Controller::scale()
+{
+    m_pipeline->export_metrics();
+
+    if (!m_autoscaler)
+    {
+        return;
+    }
+
+    std::map<SegmentAddress, channel::ChannelStatistics> ingress;
+    for (const auto& [address, partition_id] : m_current_segments)
+    {
+        ingress[address] = m_pipeline->ingress_statistics(address);
+    }
+
+    auto new_segments = m_autoscaler->evaluate(m_current_segments, ingress, channel::clock_t::now());
+    if (new_segments)
+    {
+        update(std::move(*new_segments));
+    }
+}
+
 void Controller::did_complete()
 {
     VLOG(10) << info() << ": received shutdown notification - channel closed no new assigments will be issued";
@@ -25,12 +25,13 @@
 #include <string>
 
 namespace mrc::internal::pipeline {
+class Autoscaler;
 class Instance;
 
 class Controller final : public node::GenericSink<ControlMessage>
 {
   public:
-    Controller(std::unique_ptr<Instance> pipeline);
+    Controller(std::unique_ptr<Instance> pipeline, std::unique_ptr<Autoscaler> autoscaler = nullptr);
     ~Controller() override;
 
     void await_on_pipeline() const;
@@ -40,12 +41,14 @@ class Controller final : public node::GenericSink<ControlMessage>
     void did_complete() final;
 
     void update(SegmentAddresses&& new_segments);
+    void scale();
     void stop();
     void kill();
 
     static const std::string& info();
 
     std::unique_ptr<Instance> m_pipeline;
+    std::unique_ptr<Autoscaler> m_autoscaler;
     SegmentAddresses m_current_segments;
 };
 
@@ -0,0 +1,171 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2021-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "internal/pipeline/graph_optimizer.hpp"
+
+#include "internal/pipeline/pipeline.hpp"
+#include "internal/pipeline/port_graph.hpp"
+#include "internal/segment/definition.hpp"
+
+#include <glog/logging.h>
+
+#include <algorithm>
+#include <functional>
+#include <memory>
+#include <ostream>
+#include <utility>
+
+namespace mrc::internal::pipeline {
+
+GraphOptimizer::GraphOptimizer(const Pipeline& pipeline, const ManifoldOptions& manifolds, std::size_t partition_count)
+{
+    CHECK_GT(partition_count, 0);
+    PortGraph port_graph(pipeline);
+
+    // union-find over segment names; every port joins the segments writing to and reading from it
+    std::map<std::string, std::string> parent;
+    std::function<std::string(const std::string&)> find = [&](const std::string& name) -> std::string {
+        auto& p = parent[name];
+        if (p.empty() || p == name)
+        {
+            p = name;
+            return name;
+        }
+        p = find(p);
+        return p;
+    };
+
+    for (const auto& [id, definition] : pipeline.segments())
+    {
+        find(definition->name());
+        if (definition->ingress_port_names().size() == 1 && definition->egress_port_names().size() == 1)
+        {
+            m_relay_segments.insert(definition->name());
+        }
+    }
+
+    for (const auto& [port_name, connections] : port_graph.port_map())
+    {
+        std::set<std::string> segments = connections.ingress_segments;
+        segments.insert(connections.egress_segments.begin(), connections.egress_segments.end());
+        for (const auto& name : segments)
+        {
+            parent[find(name)] = find(*segments.begin());
+        }
+    }
+
+    std::map<std::string, std::set<std::string>> groups;
+    for (const auto& [name, p] : parent)
+    {
+        groups[find(name)].insert(name);
+    }
+    for (auto& [root, members] : groups)
+    {
+        m_coupled_groups.push_back(std::move(members));
+    }
+
+    // largest groups first, each onto the partition holding the fewest segments so far
+    std::stable_sort(m_coupled_groups.begin(), m_coupled_groups.end(), [](const auto& lhs, const auto& rhs) {
+        return lhs.size() > rhs.size();
+    });
+
+    std::vector<std::size_t> load(partition_count, 0);
+    for (const auto& members : m_coupled_groups)
+    {
+        auto partition = static_cast<std::uint32_t>(std::min_element(load.begin(), load.end()) - load.begin());
+        load[partition] += members.size();
+        for (const auto& name : members)
+        {
+            m_partition_offsets[name] = partition;
+        }
+        DVLOG(10) << "graph optimizer: coupled group of " << members.size() << " segments placed from partition "
+                  << partition;
+    }
+
+    for (const auto& name : m_relay_segments)
+    {
+        VLOG(1) << "graph optimizer: segment " << name << " relays one ingress port to one egress port; co-located "
+                << "with its neighbours";
+    }
+
+    for (const auto& [port_name, cost_hints] : pipeline.port_cost_hints())
+    {
+        if (!port_graph.port_map().contains(port_name))
+        {
+            LOG(WARNING) << "graph optimizer: cost hints were declared for port " << port_name
+                         << " which is not used by any segment";
+            continue;
+        }
+        if (manifolds.has_egress_policy(port_name))
+        {
+            continue;
+        }
+        m_egress_policies[port_name] = egress_policy_for(cost_hints, partition_count);
+        DVLOG(10) << "graph optimizer: port " << port_name << " at " << cost_hints.elements_per_second
+                  << " elements/s and " << cost_hints.bytes_per_second << " bytes/s uses egress policy "
+                  << static_cast<int>(m_egress_policies[port_name]);
+    }
+}
+
+void GraphOptimizer::apply(Pipeline& pipeline) const
+{
+    for (const auto& [name, offset] : m_partition_offsets)
+    {
+        pipeline.set_partition_offset(name, offset);
+    }
+    for (const auto& [port_name, policy] : m_egress_policies)
+    {
+        pipeline.set_egress_policy(port_name, policy);
+    }
+}
+
+const std::vector<std::set<std::string>>& GraphOptimizer::coupled_groups() const
+{
+    return m_coupled_groups;
+}
+
+const std::set<std::string>& GraphOptimizer::relay_segments() const
+{
+    return m_relay_segments;
+}
+
+const std::map<std::string, std::uint32_t>& GraphOptimizer::partition_offsets() const
+{
+    return m_partition_offsets;
+}
+
+const std::map<std::string, EgressPolicy>& GraphOptimizer::egress_policies() const
+{
+    return m_egress_policies;
+}
+
+EgressPolicy GraphOptimizer::egress_policy_for(const ::mrc::runnable::CostHints& cost_hints,
+                                               std::size_t partition_count)
+{
+    bool high_rate = cost_hints.elements_per_second >= HighRate || cost_hints.bytes_per_second >= HighBandwidth;
+    if (high_rate && partition_count > 1)
+    {
+        return EgressPolicy::LocalityFirst;
+    }
+    if (high_rate || cost_hints.elements_per_second >= ModerateRate)
+    {
+        return EgressPolicy::PowerOfTwoChoices;
+    }
+    return EgressPolicy::ShortestQueue;
+}
+
+}  // namespace mrc::internal::pipeline
@@ -0,0 +1,81 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2021-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "mrc/options/manifolds.hpp"
+#include "mrc/runnable/types.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace mrc::internal::pipeline {
+
+class Pipeline;
+
+/**
+ * @brief Optimization pass over the segment/port graph of a Pipeline, run when the pipeline is registered
+ *
+ * Segments connected through ports, directly or transitively, form a coupled group. The initial instances of all
+ * segments of a group are placed on the same partitions so that the manifolds between them stay local, while the groups
+ * themselves are spread over the partitions, largest first, to balance the number of segments per partition.
+ *
+ * Segments with exactly one ingress and one egress port are reported as relay segments. Segment initializers are
+ * opaque, so a relay can not be proven to be a pass-through and is not removed; it is co-located with its neighbours,
+ * which reduces it to a pair of partition local hops.
+ *
+ * Ports with declared cost hints and without a port specific egress policy in the manifold options get a policy
+ * matching their rate: ShortestQueue for low rates, where inspecting every instance is cheap, PowerOfTwoChoices for
+ * moderate rates and, with more than one partition, LocalityFirst for high element rates or bandwidths, which keeps
+ * most elements on the partition of the manifold.
+ */
+class GraphOptimizer
+{
+  public:
+    // rates, in elements per second, from which a port is considered moderate or high rate
+    static constexpr double ModerateRate = 1e3;
+    static constexpr double HighRate     = 1e5;
+
+    // bandwidth, in bytes per second, from which a port is considered high rate regardless of its element rate
+    static constexpr double HighBandwidth = 1e9;
+
+    GraphOptimizer(const Pipeline& pipeline, const ManifoldOptions& manifolds, std::size_t partition_count);
+
+    /**
+     * @brief Record the placement and egress policies chosen by the pass on the pipeline
+     */
+    void apply(Pipeline& pipeline) const;
+
+    const std::vector<std::set<std::string>>& coupled_groups() const;
+    const std::set<std::string>& relay_segments() const;
+    const std::map<std::string, std::uint32_t>& partition_offsets() const;
+    const std::map<std::string, EgressPolicy>& egress_policies() const;
+
+    static EgressPolicy egress_policy_for(const ::mrc::runnable::CostHints& cost_hints, std::size_t partition_count);
+
+  private:
+    std::vector<std::set<std::string>> m_coupled_groups;
+    std::set<std::string> m_relay_segments;
+    std::map<std::string, std::uint32_t> m_partition_offsets;
+    std::map<std::string, EgressPolicy> m_egress_policies;
+};
+
+}  // namespace mrc::internal::pipeline
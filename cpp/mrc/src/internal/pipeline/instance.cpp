@@ -18,24 +18,37 @@
 #include "internal/pipeline/instance.hpp"
 
 #include "internal/pipeline/pipeline.hpp"
+#include "internal/pipeline/port_graph.hpp"
 #include "internal/pipeline/resources.hpp"
 #include "internal/resources/manager.hpp"
 #include "internal/resources/partition_resources.hpp"
 #include "internal/runnable/resources.hpp"
 #include "internal/segment/definition.hpp"
 #include "internal/segment/instance.hpp"
+#include "internal/system/system.hpp"
 
+#include "mrc/channel/telemetry.hpp"
 #include "mrc/core/addresses.hpp"
 #include "mrc/core/task_queue.hpp"
+#include "mrc/core/time_slice.hpp"
 #include "mrc/manifold/interface.hpp"
+#include "mrc/metrics/gauge.hpp"
+#include "mrc/metrics/registry.hpp"
+#include "mrc/options/manifolds.hpp"
+#include "mrc/options/options.hpp"
+#include "mrc/options/scaling.hpp"
 #include "mrc/segment/utils.hpp"
 #include "mrc/types.hpp"
 
 #include <boost/fiber/future/future.hpp>
 #include <glog/logging.h>
 
+#include <chrono>
+#include <deque>
 #include <exception>
+#include <map>
 #include <ostream>
+#include <set>
 #include <string>
 #include <utility>
 #include <vector>
@@ -44,9 +57,41 @@ namespace mrc::internal::pipeline {
 
 Instance::Instance(std::shared_ptr<const Pipeline> definition, resources::Manager& resources) :
   Resources(resources),
-  m_definition(std::move(definition))
+  m_definition(std::move(definition)),
+  m_manifold_options(resources.system().options().manifolds())
 {
     CHECK(m_definition);
+    for (const auto& [port_name, launch_options] : m_definition->manifold_launch_options())
+    {
+        m_manifold_options.set_launch_options(port_name, launch_options);
+    }
+    for (const auto& [port_name, policy] : m_definition->egress_policies())
+    {
+        m_manifold_options.set_egress_policy(port_name, policy);
+    }
+
+    // ports between one upstream and one downstream segment, neither of which is scaled, skip the load balancer
+    if (m_manifold_options.enable_direct_connections())
+    {
+        const auto& scaling = resources.system().options().scaling();
+        auto single_instance = [&scaling](const std::string& segment_name) {
+            const auto& options = scaling.segment_options(segment_name);
+            return options.strategy() == ScalingStrategy::Static && options.initial_count() <= 1 &&
+                   options.warm_pool_size() == 0;
+        };
+
+        PortGraph port_graph(*m_definition);
+        for (const auto& [port_name, connections] : port_graph.port_map())
+        {
+            if (connections.egress_segments.size() == 1 && connections.ingress_segments.size() == 1 &&
+                single_instance(*connections.egress_segments.begin()) &&
+                single_instance(*connections.ingress_segments.begin()))
+            {
+                DVLOG(10) << "port " << port_name << " is eligible for a direct connection";
+                m_manifold_options.set_direct_connection(port_name, true);
+            }
+        }
+    }
     m_joinable_future = m_joinable_promise.get_future().share();
 }
 
@@ -60,11 +105,21 @@ void Instance::update()
         manifold->update_outputs();
         manifold->start();
     }
+
+    // segments await their runnables going live independently of each other
+    std::vector<std::pair<std::uint32_t, std::function<void()>>> tasks;
     for (const auto& [address, segment] : m_segments)
     {
-        segment->service_start();
-        segment->service_await_live();
+        if (segment->is_service_startable())
+        {
+            tasks.emplace_back(segment->partition_id(), [segment = segment.get()] {
+                segment->service_start();
+                segment->service_await_live();
+            });
+        }
     }
+    run_on_partitions(std::move(tasks));
+
     mark_joinable();
 }
 
@@ -79,9 +134,28 @@ void Instance::join_segment(const SegmentAddress& address)
 {
     auto search = m_segments.find(address);
     CHECK(search != m_segments.end());
+
+    const auto timeout = drain_timeout(address);
+    if (timeout.count() > 0)
+    {
+        auto report = search->second->await_drain(timeout);
+        VLOG(1) << ::mrc::segment::info(address) << " drained " << report.drained.size() << " runners within "
+                << timeout.count() << "ms; killed " << report.killed.size();
+    }
     search->second->service_await_join();
 }
 
+std::chrono::milliseconds Instance::drain_timeout(const SegmentAddress& address) const
+{
+    auto [id, rank] = segment_address_decode(address);
+    return resources()
+        .system()
+        .options()
+        .scaling()
+        .segment_options(m_definition->find_segment(id)->name())
+        .drain_timeout();
+}
+
 void Instance::stop_segment(const SegmentAddress& address)
 {
     auto search = m_segments.find(address);
@@ -99,52 +173,234 @@ void Instance::stop_segment(const SegmentAddress& address)
     search->second->service_stop();
 }
 
-void Instance::create_segment(const SegmentAddress& address, std::uint32_t partition_id)
+void Instance::drain_segment(const SegmentAddress& address)
+{
+    auto search = m_segments.find(address);
+    CHECK(search != m_segments.end());
+
+    if (!search->second->has_ingress_ports())
+    {
+        if (drain_timeout(address).count() > 0)
+        {
+            DVLOG(3) << "Stopping the sources of " << ::mrc::segment::info(address) << " which has no IngressPorts";
+            search->second->stop_sources();
+            return;
+        }
+        DVLOG(3) << "Stopping " << ::mrc::segment::info(address) << " which has no IngressPorts to drain";
+        search->second->service_stop();
+        return;
+    }
+
+    auto [id, rank]    = segment_address_decode(address);
+    const auto& segdef = m_definition->find_segment(id);
+
+    for (const auto& name : segdef->ingress_port_names())
+    {
+        DVLOG(3) << "Draining IngressPort for " << ::mrc::segment::info(address) << " from manifold " << name;
+        manifold(name).drop_output(address);
+    }
+}
+
+channel::ChannelStatistics Instance::ingress_statistics(const SegmentAddress& address) const
 {
-    // perform our allocations on the numa domain of the intended target
-    // CHECK_LT(partition_id, m_resources->host_resources().size());
-    CHECK_LT(partition_id, resources().partition_count());
-    resources()
-        .partition(partition_id)
-        .runnable()
-        .main()
-        .enqueue([this, address, partition_id] {
-            auto search = m_segments.find(address);
-            CHECK(search == m_segments.end());
+    auto search = m_segments.find(address);
+    CHECK(search != m_segments.end());
+    return search->second->ingress_statistics();
+}
+
+void Instance::export_metrics()
+{
+    auto& registry = metrics_registry();
+    for (const auto& [address, segment] : m_segments)
+    {
+        const std::map<std::string, std::string> labels{{"segment", segment->name()},
+                                                        {"rank", std::to_string(segment->rank())}};
+        auto stats          = segment->ingress_statistics();
+        auto blocked_writer = std::chrono::duration<double>(stats.blocked_writer_time).count();
+        auto blocked_reader = std::chrono::duration<double>(stats.blocked_reader_time).count();
 
-            auto [id, rank] = segment_address_decode(address);
-            auto definition = m_definition->find_segment(id);
-            auto segment    = std::make_unique<segment::Instance>(definition, rank, *this, partition_id);
+        registry.make_gauge("mrc_segment_ingress_capacity", labels).set(stats.capacity);
+        registry.make_gauge("mrc_segment_ingress_occupancy", labels).set(stats.occupancy);
+        registry.make_gauge("mrc_segment_ingress_high_water_mark", labels).set(stats.high_water_mark);
+        registry.make_gauge("mrc_segment_ingress_reads", labels).set(stats.reads);
+        registry.make_gauge("mrc_segment_ingress_blocked_writer_seconds", labels).set(blocked_writer);
+        registry.make_gauge("mrc_segment_ingress_blocked_reader_seconds", labels).set(blocked_reader);
+    }
 
-            for (const auto& name : definition->egress_port_names())
+    TimeSlice::export_metrics(registry);
+}
+
+void Instance::create_segments(const SegmentAddresses& segments)
+{
+    std::vector<std::pair<std::uint32_t, std::function<void()>>> tasks;
+    for (const auto& [address, partition_id] : segments)
+    {
+        // perform our allocations on the numa domain of the intended target
+        CHECK_LT(partition_id, resources().partition_count());
+        tasks.emplace_back(partition_id, [this, address = address, partition_id = partition_id] {
+            do_create_segment(address, partition_id);
+        });
+    }
+    run_on_partitions(std::move(tasks));
+}
+
+void Instance::do_create_segment(const SegmentAddress& address, std::uint32_t partition_id)
+{
+    auto [id, rank] = segment_address_decode(address);
+    auto definition = m_definition->find_segment(id);
+
+    // take over a warm segment built for the address on the same partition
+    std::unique_ptr<segment::Instance> segment;
+    {
+        std::lock_guard<decltype(m_mutex)> lock(m_mutex);
+        CHECK(!m_segments.contains(address));
+
+        auto search = m_warm_segments.find(address);
+        if (search != m_warm_segments.end())
+        {
+            if (search->second->partition_id() == partition_id)
             {
-                VLOG(10) << ::mrc::segment::info(address) << " configuring manifold for egress port " << name;
-                std::shared_ptr<manifold::Interface> manifold = get_manifold(name);
-                if (!manifold)
-                {
-                    VLOG(10) << ::mrc::segment::info(address) << " creating manifold for egress port " << name;
-                    manifold          = segment->create_manifold(name);
-                    m_manifolds[name] = manifold;
-                }
-                segment->attach_manifold(manifold);
+                DVLOG(10) << ::mrc::segment::info(address) << " taking over warm segment";
+                segment = std::move(search->second);
             }
+            m_warm_segments.erase(search);
+        }
+    }
 
-            for (const auto& name : definition->ingress_port_names())
+    // the definition of the segment is built outside the lock, concurrently with the other segments
+    if (!segment)
+    {
+        segment = std::make_unique<segment::Instance>(definition, rank, *this, partition_id);
+    }
+
+    // manifolds are shared by all segments with the same port, so they are created and attached under the lock
+    std::lock_guard<decltype(m_mutex)> lock(m_mutex);
+
+    for (const auto& name : definition->egress_port_names())
+    {
+        VLOG(10) << ::mrc::segment::info(address) << " configuring manifold for egress port " << name;
+        std::shared_ptr<manifold::Interface> manifold = get_manifold(name);
+        if (!manifold)
+        {
+            VLOG(10) << ::mrc::segment::info(address) << " creating manifold for egress port " << name;
+            manifold                    = segment->create_manifold(name, m_manifold_options);
+            m_manifolds[name]           = manifold;
+            m_manifold_partitions[name] = partition_id;
+        }
+        segment->attach_manifold(manifold);
+    }
+
+    for (const auto& name : definition->ingress_port_names())
+    {
+        VLOG(10) << ::mrc::segment::info(address) << " configuring manifold for ingress port " << name;
+        std::shared_ptr<manifold::Interface> manifold = get_manifold(name);
+        if (!manifold)
+        {
+            VLOG(10) << ::mrc::segment::info(address) << " creating manifold for ingress port " << name;
+            manifold                    = segment->create_manifold(name, m_manifold_options);
+            m_manifolds[name]           = manifold;
+            m_manifold_partitions[name] = partition_id;
+        }
+        segment->attach_manifold(manifold);
+        manifold->set_output_local(address, m_manifold_partitions.at(name) == partition_id);
+    }
+
+    m_segments[address] = std::move(segment);
+}
+
+void Instance::refill_warm_segments()
+{
+    const auto& scaling        = resources().system().options().scaling();
+    const auto partition_count = resources().partition_count();
+
+    std::map<SegmentAddress, std::uint32_t> warm;
+    for (const auto& [id, definition] : m_definition->segments())
+    {
+        const auto pool_size = scaling.segment_options(definition->name()).warm_pool_size();
+
+        // walk the free ranks in order, each on partition rank % partition_count, until every partition is full
+        std::vector<std::size_t> counts(pool_size == 0 ? 0 : partition_count, 0);
+        std::size_t full_partitions = 0;
+        for (SegmentRank rank = 0; full_partitions < counts.size(); ++rank)
+        {
+            auto address = segment_address_encode(id, rank);
+            auto& count  = counts[rank % partition_count];
+            if (m_segments.contains(address) || count == pool_size)
             {
-                VLOG(10) << ::mrc::segment::info(address) << " configuring manifold for ingress port " << name;
-                std::shared_ptr<manifold::Interface> manifold = get_manifold(name);
-                if (!manifold)
-                {
-                    VLOG(10) << ::mrc::segment::info(address) << " creating manifold for ingress port " << name;
-                    manifold          = segment->create_manifold(name);
-                    m_manifolds[name] = manifold;
-                }
-                segment->attach_manifold(manifold);
+                continue;
             }
+            warm[address] = rank % partition_count;
+            if (++count == pool_size)
+            {
+                ++full_partitions;
+            }
+        }
+    }
 
-            m_segments[address] = std::move(segment);
-        })
-        .get();
+    std::vector<std::pair<std::uint32_t, std::function<void()>>> tasks;
+    {
+        std::lock_guard<decltype(m_mutex)> lock(m_mutex);
+        std::erase_if(m_warm_segments, [&warm](const auto& pair) { return !warm.contains(pair.first); });
+
+        for (const auto& [address, partition_id] : warm)
+        {
+            if (!m_warm_segments.contains(address))
+            {
+                tasks.emplace_back(partition_id, [this, address = address, partition_id = partition_id] {
+                    auto [id, rank] = segment_address_decode(address);
+                    auto segment =
+                        std::make_unique<segment::Instance>(m_definition->find_segment(id), rank, *this, partition_id);
+
+                    std::lock_guard<decltype(m_mutex)> lock(m_mutex);
+                    m_warm_segments[address] = std::move(segment);
+                });
+            }
+        }
+    }
+
+    DVLOG(10) << "building " << tasks.size() << " warm segments";
+    run_on_partitions(std::move(tasks));
+}
+
+void Instance::run_on_partitions(std::vector<std::pair<std::uint32_t, std::function<void()>>>&& tasks)
+{
+    const auto max_in_flight = resources().system().options().scaling().startup_parallelism();
+
+    std::deque<Future<void>> in_flight;
+    std::exception_ptr first_exception = nullptr;
+
+    auto await_oldest = [&in_flight, &first_exception] {
+        try
+        {
+            in_flight.front().get();
+        } catch (...)
+        {
+            if (first_exception == nullptr)
+            {
+                first_exception = std::current_exception();
+            }
+        }
+        in_flight.pop_front();
+    };
+
+    for (auto& [partition_id, task] : tasks)
+    {
+        if (max_in_flight != 0 && in_flight.size() >= max_in_flight)
+        {
+            await_oldest();
+        }
+        in_flight.push_back(resources().partition(partition_id).runnable().main().enqueue(std::move(task)));
+    }
+
+    while (!in_flight.empty())
+    {
+        await_oldest();
+    }
+
+    if (first_exception)
+    {
+        std::rethrow_exception(std::move(first_exception));
+    }
 }
 
 manifold::Interface& Instance::manifold(const PortName& port_name)
@@ -18,13 +18,22 @@
 #pragma once
 
 #include "internal/pipeline/resources.hpp"
+#include "internal/pipeline/types.hpp"
 #include "internal/service.hpp"
 
+#include "mrc/channel/telemetry.hpp"
+#include "mrc/options/manifolds.hpp"
 #include "mrc/types.hpp"
 
+#include <boost/fiber/mutex.hpp>
+
+#include <chrono>
 #include <cstdint>
+#include <functional>
 #include <map>
 #include <memory>
+#include <utility>
+#include <vector>
 
 namespace mrc::internal::resources {
 class Manager;
@@ -45,15 +54,46 @@ class Instance final : public Service, public Resources
     Instance(std::shared_ptr<const Pipeline> definition, resources::Manager& resources);
     ~Instance() override;
 
-    // currently we are passing the instance back to the executor
-    // we should own the instance here in the pipeline instance
-    // we need to stage those object that are created into some struct/container so we can mass start them after all
-    // object have been created
-    void create_segment(const SegmentAddress& address, std::uint32_t partition_id);
+    /**
+     * @brief Construct Segments concurrently, each on the main task queue of its resource partition
+     *
+     * At most ScalingOptions::startup_parallelism segments are constructed at once.
+     */
+    void create_segments(const SegmentAddresses& segments);
     void stop_segment(const SegmentAddress& address);
     void join_segment(const SegmentAddress& address);
     void remove_segment(const SegmentAddress& address);
 
+    /**
+     * @brief Gracefully retire a Segment
+     *
+     * The segment is detached from the manifolds feeding its ingress ports on the next update, after which it
+     * processes the data already routed to it and completes. Segments without ingress ports are stopped; with a
+     * SegmentScalingOptions::drain_timeout, only their sources are stopped and join_segment bounds the time the
+     * remaining nodes are given to flush their in-flight data.
+     */
+    void drain_segment(const SegmentAddress& address);
+
+    channel::ChannelStatistics ingress_statistics(const SegmentAddress& address) const;
+
+    /**
+     * @brief Publish the ingress statistics of each running Segment as gauges of the metrics registry, along with the
+     * TimeSlice overruns of the runnables
+     *
+     * Ingress gauges are labeled by segment name and rank. Called from the controller, which serializes it with updates.
+     */
+    void export_metrics();
+
+    /**
+     * @brief Build the warm Segments of each segment definition with a SegmentScalingOptions::warm_pool_size
+     *
+     * Warm segments are constructed, but neither attached to manifolds nor started, for the lowest free ranks of the
+     * definition on partition rank % partition_count, until each partition holds warm_pool_size of them. A segment
+     * created for the address and partition of a warm segment takes it over instead of being built; warm segments
+     * which no longer fall within the pool are released.
+     */
+    void refill_warm_segments();
+
     /**
      * @brief Start all Segments and Manifolds
      *
@@ -61,6 +101,8 @@ class Instance final : public Service, public Resources
      * pipeline instance have been started. Any Segment that natually shutdowns down is still owned by the Pipeline
      * Instance until the configuration manager explicitly tells the Pipeline Instace to remove it.
      *
+     * Segments which have not been started are started and awaited concurrently on the main task queues of their
+     * resource partitions, at most ScalingOptions::startup_parallelism at once.
      */
     void update();
 
@@ -73,13 +115,31 @@ class Instance final : public Service, public Resources
 
     void mark_joinable();
 
+    // SegmentScalingOptions::drain_timeout of the segment at address
+    std::chrono::milliseconds drain_timeout(const SegmentAddress& address) const;
+
+    void do_create_segment(const SegmentAddress& address, std::uint32_t partition_id);
+
+    // run each task on the main task queue of its partition with a bounded number of tasks in flight; the first
+    // exception is rethrown once all tasks have completed
+    void run_on_partitions(std::vector<std::pair<std::uint32_t, std::function<void()>>>&& tasks);
+
     manifold::Interface& manifold(const PortName& port_name);
     std::shared_ptr<manifold::Interface> get_manifold(const PortName& port_name);
 
     std::shared_ptr<const Pipeline> m_definition;  // convert to pipeline::Pipeline
 
     std::map<SegmentAddress, std::unique_ptr<segment::Instance>> m_segments;
+    std::map<SegmentAddress, std::unique_ptr<segment::Instance>> m_warm_segments;
     std::map<PortName, std::shared_ptr<manifold::Interface>> m_manifolds;
+    // partition each manifold was constructed on; downstream segments on the same partition are local to it
+    std::map<PortName, std::uint32_t> m_manifold_partitions;
+
+    // options of Options::manifolds() with the launch options of the pipeline definition applied
+    ManifoldOptions m_manifold_options;
+
+    // protects the segments, warm segments and manifolds while segments are constructed concurrently
+    boost::fibers::mutex m_mutex;
 
     bool m_joinable{false};
     Promise<void> m_joinable_promise;
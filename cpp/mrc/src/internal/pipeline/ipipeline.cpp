@@ -20,9 +20,12 @@
 #include "internal/pipeline/pipeline.hpp"
 
 #include "mrc/engine/segment/idefinition.hpp"
+#include "mrc/runnable/launch_options.hpp"
+#include "mrc/runnable/types.hpp"
 
 #include <glog/logging.h>
 
+#include <string>
 #include <utility>
 
 namespace mrc::internal::pipeline {
@@ -36,6 +39,25 @@ void IPipeline::register_segment(std::shared_ptr<const segment::IDefinition> seg
     add_segment(segment->m_impl);
 }
 
+void IPipeline::set_manifold_launch_options(const std::string& port_name,
+                                            const runnable::LaunchOptions& launch_options)
+{
+    CHECK(m_impl);
+    m_impl->set_manifold_launch_options(port_name, launch_options);
+}
+
+void IPipeline::set_port_rate(const std::string& port_name, double elements_per_second)
+{
+    CHECK(m_impl);
+    m_impl->set_port_rate(port_name, elements_per_second);
+}
+
+void IPipeline::set_port_cost_hints(const std::string& port_name, const runnable::CostHints& cost_hints)
+{
+    CHECK(m_impl);
+    m_impl->set_port_cost_hints(port_name, cost_hints);
+}
+
 void IPipeline::add_segment(std::shared_ptr<const segment::Definition> segment)
 {
     CHECK(segment);
@@ -17,14 +17,22 @@
 
 #include "internal/pipeline/manager.hpp"
 
+#include "internal/pipeline/autoscaler.hpp"
 #include "internal/pipeline/controller.hpp"
 #include "internal/pipeline/instance.hpp"
+#include "internal/pipeline/pipeline.hpp"
 #include "internal/resources/manager.hpp"
 #include "internal/resources/partition_resources.hpp"
 #include "internal/runnable/resources.hpp"
+#include "internal/segment/definition.hpp"
+#include "internal/system/system.hpp"
 
+#include "mrc/core/task_queue.hpp"
 #include "mrc/node/edge_builder.hpp"
 #include "mrc/node/source_channel.hpp"
+#include "mrc/options/options.hpp"
+#include "mrc/options/scaling.hpp"
+#include "mrc/protos/architect.pb.h"
 #include "mrc/runnable/launch_control.hpp"
 #include "mrc/runnable/launch_options.hpp"
 #include "mrc/runnable/launcher.hpp"
@@ -32,7 +40,10 @@
 
 #include <glog/logging.h>
 
+#include <chrono>
 #include <exception>
+#include <map>
+#include <mutex>
 #include <ostream>
 #include <string>
 #include <utility>
@@ -67,8 +78,18 @@ void Manager::do_service_start()
     main.pe_count            = 1;
     main.engines_per_pe      = 1;
 
+    const auto& scaling_options = m_resources.system().options().scaling();
+
+    std::map<SegmentID, protos::ScalingOptions> segment_scaling;
+    for (const auto& [id, definition] : m_pipeline->segments())
+    {
+        segment_scaling[id] = Autoscaler::encode(scaling_options.segment_options(definition->name()));
+    }
+    auto autoscaler = std::make_unique<Autoscaler>(std::move(segment_scaling), m_resources.partition_count());
+    auto dynamic    = !autoscaler->empty();
+
     auto instance    = std::make_unique<Instance>(m_pipeline, m_resources);
-    auto controller  = std::make_unique<Controller>(std::move(instance));
+    auto controller  = std::make_unique<Controller>(std::move(instance), std::move(autoscaler));
     m_update_channel = std::make_unique<node::SourceChannelWriteable<ControlMessage>>();
 
     // form edge
@@ -87,6 +108,43 @@ void Manager::do_service_start()
         });
     });
     m_controller = launcher->ignition();
+
+    // the scaling loop also refreshes the segment metrics served by the metrics server
+    if (dynamic || m_resources.system().options().enable_metrics_server())
+    {
+        start_scaling(scaling_options.evaluation_interval());
+    }
+}
+
+void Manager::start_scaling(std::chrono::milliseconds evaluation_interval)
+{
+    m_scaling_running = true;
+    m_scaling_loop    = resources().partition(0).runnable().main().enqueue([this, evaluation_interval] {
+        std::unique_lock lock(m_scaling_mutex);
+        while (m_scaling_running)
+        {
+            m_scaling_cv.wait_for(lock, evaluation_interval, [this] { return !m_scaling_running; });
+            if (m_scaling_running)
+            {
+                // ordered with the updates pushed by the owner of the manager
+                m_update_channel->await_write({ControlMessageType::Scale});
+            }
+        }
+    });
+}
+
+void Manager::stop_scaling()
+{
+    {
+        std::lock_guard lock(m_scaling_mutex);
+        if (!m_scaling_running)
+        {
+            return;
+        }
+        m_scaling_running = false;
+    }
+    m_scaling_cv.notify_all();
+    m_scaling_loop.get();
 }
 
 void Manager::do_service_await_live()
@@ -97,12 +155,14 @@ void Manager::do_service_await_live()
 void Manager::do_service_stop()
 {
     VLOG(10) << "stop: closing update channels";
+    stop_scaling();
     m_update_channel->await_write({ControlMessageType::Stop});
 }
 
 void Manager::do_service_kill()
 {
     VLOG(10) << "kill: closing update channels; issuing kill to controllers";
+    stop_scaling();
     m_update_channel->await_write({ControlMessageType::Kill});
 }
 
@@ -116,6 +176,7 @@ void Manager::do_service_await_join()
     {
         ptr = std::current_exception();
     }
+    stop_scaling();
     m_update_channel.reset();
     m_controller->await_join();
     if (ptr)
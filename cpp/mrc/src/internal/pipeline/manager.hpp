@@ -20,6 +20,12 @@
 #include "internal/pipeline/types.hpp"
 #include "internal/service.hpp"
 
+#include "mrc/types.hpp"
+
+#include <boost/fiber/condition_variable.hpp>
+#include <boost/fiber/mutex.hpp>
+
+#include <chrono>
 #include <memory>
 
 namespace mrc::internal::resources {
@@ -63,10 +69,19 @@ class Manager : public Service
     void do_service_kill() final;
     void do_service_await_join() final;
 
+    // periodically requests the controller to evaluate the scaling of Dynamic segments
+    void start_scaling(std::chrono::milliseconds evaluation_interval);
+    void stop_scaling();
+
     resources::Manager& m_resources;
     std::shared_ptr<Pipeline> m_pipeline;
     std::unique_ptr<node::SourceChannelWriteable<ControlMessage>> m_update_channel;
     std::unique_ptr<mrc::runnable::Runner> m_controller;
+
+    bool m_scaling_running{false};
+    boost::fibers::mutex m_scaling_mutex;
+    boost::fibers::condition_variable m_scaling_cv;
+    Future<void> m_scaling_loop;
 };
 
 }  // namespace mrc::internal::pipeline
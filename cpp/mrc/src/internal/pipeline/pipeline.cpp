@@ -25,6 +25,8 @@
 
 #include <glog/logging.h>
 
+#include <cstdint>
+#include <map>
 #include <ostream>
 #include <string>
 #include <utility>
@@ -70,6 +72,56 @@ const std::map<SegmentID, std::shared_ptr<const segment::Definition>>& Pipeline:
 {
     return m_segments;
 }
+
+void Pipeline::set_manifold_launch_options(const std::string& port_name, mrc::runnable::LaunchOptions launch_options)
+{
+    m_manifold_launch_options[port_name] = std::move(launch_options);
+}
+
+const std::map<std::string, mrc::runnable::LaunchOptions>& Pipeline::manifold_launch_options() const
+{
+    return m_manifold_launch_options;
+}
+
+void Pipeline::set_port_rate(const std::string& port_name, double elements_per_second)
+{
+    CHECK_GE(elements_per_second, 0.0);
+    m_port_cost_hints[port_name].elements_per_second = elements_per_second;
+}
+
+void Pipeline::set_port_cost_hints(const std::string& port_name, mrc::runnable::CostHints cost_hints)
+{
+    CHECK_GE(cost_hints.elements_per_second, 0.0);
+    CHECK_GE(cost_hints.bytes_per_second, 0.0);
+    m_port_cost_hints[port_name] = cost_hints;
+}
+
+const std::map<std::string, mrc::runnable::CostHints>& Pipeline::port_cost_hints() const
+{
+    return m_port_cost_hints;
+}
+
+void Pipeline::set_egress_policy(const std::string& port_name, EgressPolicy policy)
+{
+    m_egress_policies[port_name] = policy;
+}
+
+const std::map<std::string, EgressPolicy>& Pipeline::egress_policies() const
+{
+    return m_egress_policies;
+}
+
+void Pipeline::set_partition_offset(const std::string& segment_name, std::uint32_t offset)
+{
+    m_partition_offsets[segment_name] = offset;
+}
+
+std::uint32_t Pipeline::partition_offset(const std::string& segment_name) const
+{
+    auto search = m_partition_offsets.find(segment_name);
+    return (search == m_partition_offsets.end() ? 0 : search->second);
+}
+
 std::shared_ptr<Pipeline> Pipeline::unwrap(IPipeline& pipeline)
 {
     return pipeline.m_impl;
@@ -19,10 +19,15 @@
 
 #include "internal/utils/collision_detector.hpp"
 
+#include "mrc/options/manifolds.hpp"
+#include "mrc/runnable/launch_options.hpp"
+#include "mrc/runnable/types.hpp"
 #include "mrc/types.hpp"
 
+#include <cstdint>
 #include <map>
 #include <memory>
+#include <string>
 
 namespace mrc::internal::segment {
 class Definition;
@@ -42,11 +47,33 @@ class Pipeline
 
     std::shared_ptr<const segment::Definition> find_segment(SegmentID segment_id) const;
 
+    // launch options of the manifolds of ports, overriding Options::manifolds()
+    void set_manifold_launch_options(const std::string& port_name, mrc::runnable::LaunchOptions launch_options);
+    const std::map<std::string, mrc::runnable::LaunchOptions>& manifold_launch_options() const;
+
+    // expected traffic through a port, used by the GraphOptimizer
+    void set_port_rate(const std::string& port_name, double elements_per_second);
+    void set_port_cost_hints(const std::string& port_name, mrc::runnable::CostHints cost_hints);
+    const std::map<std::string, mrc::runnable::CostHints>& port_cost_hints() const;
+
+    // egress policies of the manifolds of ports chosen by the GraphOptimizer for ports without a policy in
+    // Options::manifolds()
+    void set_egress_policy(const std::string& port_name, EgressPolicy policy);
+    const std::map<std::string, EgressPolicy>& egress_policies() const;
+
+    // partition of the initial rank 0 of a segment; rank r is placed on partition (offset + r) % partition_count
+    void set_partition_offset(const std::string& segment_name, std::uint32_t offset);
+    std::uint32_t partition_offset(const std::string& segment_name) const;
+
   private:
     utils::CollisionDetector m_segment_hasher;
     utils::CollisionDetector m_port_hasher;
 
     std::map<SegmentID, std::shared_ptr<const segment::Definition>> m_segments;
+    std::map<std::string, mrc::runnable::LaunchOptions> m_manifold_launch_options;
+    std::map<std::string, mrc::runnable::CostHints> m_port_cost_hints;
+    std::map<std::string, EgressPolicy> m_egress_policies;
+    std::map<std::string, std::uint32_t> m_partition_offsets;
 };
 
 }  // namespace mrc::internal::pipeline
@@ -29,6 +29,7 @@ using SegmentAddresses = std::map<SegmentAddress, PartitionID>;  // NOLINT
 enum ControlMessageType
 {
     Update,
+    Scale,
     Stop,
     Kill
 };
@@ -22,6 +22,7 @@
 #include "internal/resources/partition_resources.hpp"
 #include "internal/runtime/runtime.hpp"
 
+#include <cstdint>
 #include <string>
 
 namespace mrc::internal::pubsub {
@@ -52,6 +53,12 @@ class Base : public control_plane::client::SubscriptionService
         return name;
     }
 
+    // name of the shared memory ring of a subscriber, which its publishers on the same host derive from its tag
+    static std::string ring_name(const InstanceID& instance_id, std::uint64_t tag)
+    {
+        return "/mrc_ring_" + std::to_string(instance_id) + "_" + std::to_string(tag);
+    }
+
     const std::set<std::string>& roles() const final
     {
         static std::set<std::string> r = {role_publisher(), role_subscriber()};
@@ -23,6 +23,11 @@ class PublisherService;
 class SubscriberService;
 
 // Specific types of Publishers
+class PublisherBroadcast;
+class PublisherConsistentHash;
+class PublisherLeastOutstanding;
+class PublisherLocalityAware;
+class PublisherPowerOfTwoChoices;
 class PublisherRoundRobin;
 
 }  // namespace mrc::internal::pubsub
@@ -0,0 +1,54 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "internal/pubsub/publisher_broadcast.hpp"
+
+#include "internal/remote_descriptor/manager.hpp"
+#include "internal/resources/partition_resources.hpp"
+#include "internal/runnable/resources.hpp"
+#include "internal/runtime/partition.hpp"
+
+#include "mrc/core/task_queue.hpp"
+#include "mrc/runtime/remote_descriptor.hpp"
+
+#include <glog/logging.h>
+
+#include <ostream>
+#include <utility>
+
+namespace mrc::internal::pubsub {
+
+void PublisherBroadcast::apply_policy(mrc::runtime::RemoteDescriptor&& rd)
+{
+    DCHECK(this->resources().runnable().main().caller_on_same_thread());
+
+    if (tagged_instances().empty())
+    {
+        LOG_EVERY_N(WARNING, 1000) << "publisher dropping object because no subscribers are active";  // NOLINT
+        return;
+    }
+
+    auto rds = runtime().remote_descriptor_manager().split(std::move(rd), tagged_instances().size());
+
+    auto it = rds.begin();
+    for (const auto& [tag, instance_id] : tagged_instances())
+    {
+        publish(std::move(*it++), tag, instance_id);
+    }
+}
+
+}  // namespace mrc::internal::pubsub
@@ -0,0 +1,51 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "internal/pubsub/publisher_service.hpp"
+
+namespace mrc::internal::runtime {
+class Partition;
+}  // namespace mrc::internal::runtime
+namespace mrc::runtime {
+class RemoteDescriptor;
+}  // namespace mrc::runtime
+
+namespace mrc::internal::pubsub {
+
+/**
+ * @brief Publishes every remote descriptor to all subscribers; the tokens of the descriptor are split across the
+ * subscribers so the object is released once every subscriber has released its copy.
+ */
+class PublisherBroadcast final : public PublisherService
+{
+    using PublisherService::PublisherService;
+
+  public:
+    ~PublisherBroadcast() final = default;
+
+  private:
+    void on_update() final {}
+
+    // apply the broadcast policy
+    void apply_policy(mrc::runtime::RemoteDescriptor&& rd) final;
+
+    friend runtime::Partition;
+};
+
+}  // namespace mrc::internal::pubsub
@@ -0,0 +1,98 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "internal/pubsub/publisher_consistent_hash.hpp"
+
+#include "internal/remote_descriptor/manager.hpp"
+#include "internal/resources/partition_resources.hpp"
+#include "internal/runnable/resources.hpp"
+#include "internal/runtime/partition.hpp"
+
+#include "mrc/core/task_queue.hpp"
+#include "mrc/runtime/remote_descriptor.hpp"
+
+#include <glog/logging.h>
+
+#include <algorithm>
+#include <optional>
+#include <ostream>
+#include <utility>
+
+namespace mrc::internal::pubsub {
+
+namespace {
+
+// splitmix64 finalizer; scores must be well mixed in every bit for the highest score to be uniformly distributed
+std::uint64_t mix(std::uint64_t value)
+{
+    value ^= value >> 30;
+    value *= 0xbf58476d1ce4e5b9ULL;
+    value ^= value >> 27;
+    value *= 0x94d049bb133111ebULL;
+    value ^= value >> 31;
+    return value;
+}
+
+}  // namespace
+
+std::uint64_t PublisherConsistentHash::select_subscriber(std::uint64_t key, const std::vector<std::uint64_t>& tags)
+{
+    DCHECK(!tags.empty());
+
+    const auto hashed_key = mix(key);
+
+    auto best       = tags.front();
+    auto best_score = mix(hashed_key ^ mix(best));
+    for (std::size_t i = 1; i < tags.size(); ++i)
+    {
+        auto score = mix(hashed_key ^ mix(tags[i]));
+        if (score > best_score)
+        {
+            best       = tags[i];
+            best_score = score;
+        }
+    }
+    return best;
+}
+
+void PublisherConsistentHash::on_update()
+{
+    m_tags.clear();
+    for (const auto& [tag, instance_id] : tagged_instances())
+    {
+        m_tags.push_back(tag);
+    }
+    std::sort(m_tags.begin(), m_tags.end());
+}
+
+void PublisherConsistentHash::apply_policy(mrc::runtime::RemoteDescriptor&& rd)
+{
+    DCHECK(this->resources().runnable().main().caller_on_same_thread());
+
+    if (m_tags.empty())
+    {
+        LOG_EVERY_N(WARNING, 1000) << "publisher dropping object because no subscribers are active";  // NOLINT
+        return;
+    }
+
+    auto key = remote_descriptor::Manager::routing_key(rd).value_or(remote_descriptor::Manager::object_id(rd));
+    auto tag = select_subscriber(key, m_tags);
+
+    publish(std::move(rd), tag, tagged_instances().at(tag));
+}
+
+}  // namespace mrc::internal::pubsub
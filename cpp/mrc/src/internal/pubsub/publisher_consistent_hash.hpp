@@ -0,0 +1,63 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "internal/pubsub/publisher_service.hpp"
+
+#include <cstdint>
+#include <vector>
+
+namespace mrc::internal::runtime {
+class Partition;
+}  // namespace mrc::internal::runtime
+namespace mrc::runtime {
+class RemoteDescriptor;
+}  // namespace mrc::runtime
+
+namespace mrc::internal::pubsub {
+
+/**
+ * @brief Routes all remote descriptors with the same routing key to the same subscriber
+ *
+ * Keys are assigned by rendezvous hashing over the tags of the current subscribers: each key goes to the subscriber
+ * whose tag scores highest for that key. When a subscriber leaves, only its keys move; when one joins, it takes over
+ * only the keys for which it scores highest. Descriptors without a routing key are routed by their object id.
+ */
+class PublisherConsistentHash final : public PublisherService
+{
+    using PublisherService::PublisherService;
+
+  public:
+    ~PublisherConsistentHash() final = default;
+
+    // tag of the subscriber assigned to key; tags must not be empty
+    static std::uint64_t select_subscriber(std::uint64_t key, const std::vector<std::uint64_t>& tags);
+
+  private:
+    // update the set of tags
+    void on_update() final;
+
+    // apply the consistent hash policy
+    void apply_policy(mrc::runtime::RemoteDescriptor&& rd) final;
+
+    std::vector<std::uint64_t> m_tags;
+
+    friend runtime::Partition;
+};
+
+}  // namespace mrc::internal::pubsub
@@ -0,0 +1,215 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "internal/pubsub/publisher_load_balanced.hpp"
+
+#include "internal/control_plane/client.hpp"
+#include "internal/control_plane/client/connections_manager.hpp"
+#include "internal/control_plane/client/instance.hpp"
+#include "internal/network/resources.hpp"
+#include "internal/remote_descriptor/manager.hpp"
+#include "internal/resources/partition_resources.hpp"
+#include "internal/runnable/resources.hpp"
+#include "internal/runtime/partition.hpp"
+
+#include "mrc/core/task_queue.hpp"
+#include "mrc/runtime/remote_descriptor.hpp"
+
+#include <glog/logging.h>
+
+#include <algorithm>
+#include <optional>
+#include <ostream>
+#include <utility>
+
+namespace mrc::internal::pubsub {
+
+const std::vector<std::uint64_t>& PublisherLoadBalanced::tags() const
+{
+    return m_tags;
+}
+
+std::size_t PublisherLoadBalanced::outstanding(const std::uint64_t& tag) const
+{
+    return m_outstanding.at(tag)->load(std::memory_order_relaxed);
+}
+
+void PublisherLoadBalanced::on_update()
+{
+    std::unordered_map<std::uint64_t, std::shared_ptr<std::atomic<std::size_t>>> outstanding;
+
+    m_tags.clear();
+    for (const auto& [tag, instance_id] : tagged_instances())
+    {
+        m_tags.push_back(tag);
+
+        // subscribers which remain keep their load
+        auto search = m_outstanding.find(tag);
+        if (search != m_outstanding.end())
+        {
+            outstanding[tag] = search->second;
+        }
+        else
+        {
+            outstanding[tag] = std::make_shared<std::atomic<std::size_t>>(0);
+        }
+    }
+    std::sort(m_tags.begin(), m_tags.end());
+
+    m_outstanding = std::move(outstanding);
+
+    on_subscribers_update();
+}
+
+void PublisherLoadBalanced::apply_policy(mrc::runtime::RemoteDescriptor&& rd)
+{
+    DCHECK(this->resources().runnable().main().caller_on_same_thread());
+
+    if (m_tags.empty())
+    {
+        LOG_EVERY_N(WARNING, 1000) << "publisher dropping object because no subscribers are active";  // NOLINT
+        return;
+    }
+
+    auto tag     = select_subscriber();
+    auto counter = m_outstanding.at(tag);
+
+    // count the descriptor before it can be released
+    counter->fetch_add(1, std::memory_order_relaxed);
+    if (!runtime().remote_descriptor_manager().on_release(
+            rd, [counter] { counter->fetch_sub(1, std::memory_order_relaxed); }))
+    {
+        counter->fetch_sub(1, std::memory_order_relaxed);
+    }
+
+    publish(std::move(rd), tag, tagged_instances().at(tag));
+}
+
+std::uint64_t PublisherLeastOutstanding::select_subscriber()
+{
+    const auto& current = tags();
+
+    // scan from the subscriber after the last selected, so subscribers with equal load are selected in turn
+    auto start = m_next % current.size();
+    auto best  = start;
+    for (std::size_t i = 1; i < current.size(); ++i)
+    {
+        auto idx = (start + i) % current.size();
+        if (outstanding(current[idx]) < outstanding(current[best]))
+        {
+            best = idx;
+        }
+    }
+
+    m_next = best + 1;
+    return current[best];
+}
+
+void PublisherLocalityAware::on_subscribers_update()
+{
+    auto& connections = resources().network()->control_plane().client().connections();
+
+    const auto instance_id = resources().network()->instance_id();
+    const auto self        = connections.locality(instance_id);
+
+    m_tiers.assign(static_cast<std::size_t>(Tier::Remote) + 1, {});
+    for (const auto& tag : tags())
+    {
+        const auto subscriber_id = tagged_instances().at(tag);
+        const auto subscriber    = connections.locality(subscriber_id);
+
+        auto tier = Tier::Remote;
+        if (subscriber_id == instance_id)
+        {
+            tier = Tier::Instance;
+        }
+        else if (self && subscriber && subscriber->machine_id == self->machine_id)
+        {
+            tier = Tier::Process;
+        }
+        else if (self && subscriber && subscriber->host_name == self->host_name)
+        {
+            if (subscriber->cuda_device_id >= 0 && subscriber->cuda_device_id == self->cuda_device_id)
+            {
+                tier = Tier::Device;
+            }
+            else if (subscriber->numa_node == self->numa_node)
+            {
+                tier = Tier::NumaNode;
+            }
+            else
+            {
+                tier = Tier::Host;
+            }
+        }
+
+        m_tiers[static_cast<std::size_t>(tier)].push_back(tag);
+    }
+}
+
+std::uint64_t PublisherLocalityAware::select_subscriber()
+{
+    std::optional<std::uint64_t> fallback;
+    for (const auto& tier : m_tiers)
+    {
+        if (tier.empty())
+        {
+            continue;
+        }
+
+        auto best = *std::min_element(tier.begin(), tier.end(), [this](const auto& a, const auto& b) {
+            return outstanding(a) < outstanding(b);
+        });
+
+        if (outstanding(best) < SpillThreshold)
+        {
+            return best;
+        }
+
+        // every tier is saturated; fall back to the least loaded subscriber, preferring the closest
+        if (!fallback || outstanding(best) < outstanding(*fallback))
+        {
+            fallback = best;
+        }
+    }
+
+    DCHECK(fallback);
+    return *fallback;
+}
+
+std::uint64_t PublisherPowerOfTwoChoices::select_subscriber()
+{
+    const auto& current = tags();
+    if (current.size() == 1)
+    {
+        return current[0];
+    }
+
+    // two distinct subscribers chosen uniformly at random
+    auto first  = std::uniform_int_distribution<std::size_t>(0, current.size() - 1)(m_generator);
+    auto second = std::uniform_int_distribution<std::size_t>(0, current.size() - 2)(m_generator);
+    if (second >= first)
+    {
+        ++second;
+    }
+
+    auto a = current[first];
+    auto b = current[second];
+    return (outstanding(b) < outstanding(a) ? b : a);
+}
+
+}  // namespace mrc::internal::pubsub
@@ -0,0 +1,158 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "internal/pubsub/publisher_service.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+namespace mrc::internal::runtime {
+class Partition;
+}  // namespace mrc::internal::runtime
+namespace mrc::runtime {
+class RemoteDescriptor;
+}  // namespace mrc::runtime
+
+namespace mrc::internal::pubsub {
+
+/**
+ * @brief Base of the publishers which balance on the load of their subscribers
+ *
+ * The load of a subscriber is the number of remote descriptors published to it whose global object has not yet been
+ * released. Subscribers release their descriptors once decoded, so a slow subscriber accumulates outstanding
+ * descriptors and receives a smaller share. The count is driven by the token releases of the subscribers, which are
+ * coalesced over NetworkOptions::token_release_window. Descriptors of objects not owned by this instance can not be
+ * tracked and do not count towards the load of the subscriber.
+ */
+class PublisherLoadBalanced : public PublisherService
+{
+  protected:
+    using PublisherService::PublisherService;
+
+  public:
+    ~PublisherLoadBalanced() override = default;
+
+  protected:
+    // sorted tags of the current subscribers
+    const std::vector<std::uint64_t>& tags() const;
+
+    // number of descriptors published to the subscriber of tag which have not yet been released
+    std::size_t outstanding(const std::uint64_t& tag) const;
+
+    // called at the end of on_update once tags() reflects the current subscribers
+    virtual void on_subscribers_update() {}
+
+  private:
+    // update the set of tags and their outstanding counters
+    void on_update() final;
+
+    // publish to the subscriber selected by the derived policy
+    void apply_policy(mrc::runtime::RemoteDescriptor&& rd) final;
+
+    // select the tag of the subscriber to receive the next descriptor; tags() is never empty when called
+    virtual std::uint64_t select_subscriber() = 0;
+
+    std::vector<std::uint64_t> m_tags;
+
+    // counters are shared with the release callbacks, which may outlive the subscriber of the tag
+    std::unordered_map<std::uint64_t, std::shared_ptr<std::atomic<std::size_t>>> m_outstanding;
+};
+
+/**
+ * @brief Publishes to the subscriber with the fewest outstanding descriptors; ties are broken round robin
+ */
+class PublisherLeastOutstanding final : public PublisherLoadBalanced
+{
+    using PublisherLoadBalanced::PublisherLoadBalanced;
+
+  public:
+    ~PublisherLeastOutstanding() final = default;
+
+  private:
+    std::uint64_t select_subscriber() final;
+
+    std::size_t m_next{0};
+
+    friend runtime::Partition;
+};
+
+/**
+ * @brief Publishes to the least loaded of the closest subscribers, spilling over to more distant subscribers once all
+ * of the closer ones have at least SpillThreshold outstanding descriptors
+ *
+ * Subscribers are ranked, from closest to farthest: the same instance, the same process, the same gpu on the same
+ * host, the same numa node on the same host, the same host and finally remote hosts. Only descriptors sent to remote
+ * hosts need to cross the nic. Subscribers of unknown locality are ranked as remote.
+ */
+class PublisherLocalityAware final : public PublisherLoadBalanced
+{
+    using PublisherLoadBalanced::PublisherLoadBalanced;
+
+  public:
+    ~PublisherLocalityAware() final = default;
+
+    // outstanding descriptors of the least loaded subscriber of a tier at which the next tier is considered
+    static constexpr std::size_t SpillThreshold = 8;
+
+  private:
+    enum class Tier : std::uint8_t
+    {
+        Instance,
+        Process,
+        Device,
+        NumaNode,
+        Host,
+        Remote,
+    };
+
+    void on_subscribers_update() final;
+
+    std::uint64_t select_subscriber() final;
+
+    // subscribers grouped by tier, indexed by the tier
+    std::vector<std::vector<std::uint64_t>> m_tiers;
+
+    friend runtime::Partition;
+};
+
+/**
+ * @brief Publishes to the less loaded of two randomly chosen subscribers, which avoids herding on the single least
+ * loaded subscriber while the load information lags behind
+ */
+class PublisherPowerOfTwoChoices final : public PublisherLoadBalanced
+{
+    using PublisherLoadBalanced::PublisherLoadBalanced;
+
+  public:
+    ~PublisherPowerOfTwoChoices() final = default;
+
+  private:
+    std::uint64_t select_subscriber() final;
+
+    std::minstd_rand m_generator{std::random_device{}()};
+
+    friend runtime::Partition;
+};
+
+}  // namespace mrc::internal::pubsub
@@ -33,7 +33,7 @@ namespace mrc::internal::pubsub {
 
 void PublisherRoundRobin::on_update()
 {
-    m_next = this->tagged_endpoints().cbegin();
+    m_next = this->tagged_instances().cbegin();
 }
 
 void PublisherRoundRobin::apply_policy(mrc::runtime::RemoteDescriptor&& rd)
@@ -57,9 +57,9 @@ void PublisherRoundRobin::apply_policy(mrc::runtime::RemoteDescriptor&& rd)
 
     publish(std::move(rd), m_next->first, m_next->second);
 
-    if (++m_next == this->tagged_endpoints().cend())
+    if (++m_next == this->tagged_instances().cend())
     {
-        m_next = this->tagged_endpoints().cbegin();
+        m_next = this->tagged_instances().cbegin();
     }
 }
 
@@ -26,9 +26,6 @@
 namespace mrc::internal::runtime {
 class Partition;
 }  // namespace mrc::internal::runtime
-namespace mrc::internal::ucx {
-class Endpoint;
-}  // namespace mrc::internal::ucx
 namespace mrc::runtime {
 class RemoteDescriptor;
 }  // namespace mrc::runtime
@@ -49,7 +46,7 @@ class PublisherRoundRobin final : public PublisherService
     // apply the round robin policy
     void apply_policy(mrc::runtime::RemoteDescriptor&& rd) final;
 
-    std::unordered_map<std::uint64_t, std::shared_ptr<ucx::Endpoint>>::const_iterator m_next;
+    std::unordered_map<std::uint64_t, InstanceID>::const_iterator m_next;
 
     friend runtime::Partition;
 };
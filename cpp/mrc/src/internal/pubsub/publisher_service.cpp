@@ -18,8 +18,11 @@
 #include "internal/pubsub/publisher_service.hpp"
 
 #include "internal/codable/codable_storage.hpp"
+#include "internal/control_plane/client.hpp"
+#include "internal/control_plane/client/connections_manager.hpp"
 #include "internal/data_plane/client.hpp"
 #include "internal/data_plane/resources.hpp"
+#include "internal/memory/shared_memory_ring.hpp"
 #include "internal/network/resources.hpp"
 #include "internal/remote_descriptor/manager.hpp"
 #include "internal/resources/partition_resources.hpp"
@@ -30,13 +33,21 @@
 #include "mrc/core/utils.hpp"
 #include "mrc/node/edge_builder.hpp"
 #include "mrc/node/rx_sink.hpp"
+#include "mrc/options/network.hpp"
+#include "mrc/options/options.hpp"
+#include "mrc/protos/codable.pb.h"
 #include "mrc/runnable/launch_control.hpp"
 #include "mrc/runnable/launcher.hpp"
 #include "mrc/runtime/remote_descriptor.hpp"
+#include "mrc/runtime/remote_descriptor_handle.hpp"
 
 #include <glog/logging.h>
+#include <boost/fiber/operations.hpp>
 #include <rxcpp/rx.hpp>
 
+#include <algorithm>
+#include <chrono>
+#include <exception>
 #include <optional>
 #include <utility>
 #include <vector>
@@ -48,6 +59,8 @@ PublisherService::PublisherService(std::string service_name, runtime::Partition&
   m_runtime(runtime)
 {}
 
+PublisherService::~PublisherService() = default;
+
 channel::Status PublisherService::publish(mrc::runtime::RemoteDescriptor&& rd)
 {
     return this->await_write(std::move(rd));
@@ -59,6 +72,13 @@ channel::Status PublisherService::publish(std::unique_ptr<mrc::codable::EncodedS
     return this->await_write(std::move(rd));
 }
 
+channel::Status PublisherService::publish(std::unique_ptr<mrc::codable::EncodedStorage> encoded_object,
+                                          std::uint64_t routing_key)
+{
+    auto rd = m_runtime.remote_descriptor_manager().register_encoded_object(std::move(encoded_object), routing_key);
+    return this->await_write(std::move(rd));
+}
+
 std::unique_ptr<mrc::codable::ICodableStorage> PublisherService::create_storage()
 {
     return std::make_unique<codable::CodableStorage>(m_runtime.resources());
@@ -83,18 +103,17 @@ void PublisherService::update_tagged_instances(const std::string& role,
     auto new_tags         = extract_keys(tagged_instances);
     auto [added, removed] = set_compare(cur_tags, new_tags);
 
-    for (const auto& tag : removed)
-    {
-        CHECK_EQ(m_tagged_endpoints.erase(tag), 1);
-    }
-
+    // endpoints are resolved on publish, so the cached endpoints of the data plane client are not pinned by the
+    // publisher; the endpoints of new subscribers are created up front so their wireups proceed concurrently
+    std::vector<InstanceID> added_instances;
     for (const auto& tag : added)
     {
-        m_tagged_endpoints[tag] =
-            resources().network()->data_plane().client().endpoint_shared(tagged_instances.at(tag));
+        added_instances.push_back(tagged_instances.at(tag));
     }
+    resources().network()->data_plane().client().prepare_endpoints(added_instances);
 
     m_tagged_instances = std::move(tagged_instances);
+    update_rings(added, removed);
 
     // allow derived classes to take some action on_update
     on_update();
@@ -130,20 +149,107 @@ void PublisherService::do_subscription_service_join()
 
 void PublisherService::publish(mrc::runtime::RemoteDescriptor&& rd,
                                const std::uint64_t& tag,
-                               std::shared_ptr<ucx::Endpoint> endpoint)
+                               const InstanceID& instance_id)
 {
+    auto search = m_rings.find(tag);
+    if (search != m_rings.end())
+    {
+        auto ring = search->second;
+        if (publish_to_ring(rd, *ring))
+        {
+            return;
+        }
+        // a closed ring belongs to a subscriber being torn down; its removal is not necessarily applied yet
+        search = m_rings.find(tag);
+        if (ring->is_closed() && search != m_rings.end() && search->second == ring)
+        {
+            m_rings.erase(search);
+        }
+    }
+
+    auto endpoint = resources().network()->data_plane().client().endpoint_shared(instance_id);
     // todo(cpp20) - bracket initializer
     // {.rd = std::move(rd), .endpoint = std::move(endpoint), .tag = tag}
     resources().network()->data_plane().client().remote_descriptor_channel().await_write(
         {std::move(rd), std::move(endpoint), tag});
 }
 
-const std::unordered_map<std::uint64_t, InstanceID>& PublisherService::tagged_instances() const
+void PublisherService::update_rings(const std::set<std::uint64_t>& added, const std::set<std::uint64_t>& removed)
 {
-    return m_tagged_instances;
+    for (const auto& tag : removed)
+    {
+        m_rings.erase(tag);
+    }
+
+    if (!resources().system().options().network().enable_shm_rings())
+    {
+        return;
+    }
+
+    auto& connections = resources().network()->control_plane().client().connections();
+    const auto self   = connections.locality(resources().network()->instance_id());
+
+    for (const auto& tag : added)
+    {
+        const auto instance_id = m_tagged_instances.at(tag);
+        const auto subscriber  = connections.locality(instance_id);
+
+        // subscribers of the same process are reached through the data plane's loopback
+        if (!self || !subscriber || subscriber->host_name != self->host_name ||
+            subscriber->machine_id == self->machine_id)
+        {
+            continue;
+        }
+
+        try
+        {
+            m_rings[tag] = memory::SharedMemoryRing::open(ring_name(instance_id, tag));
+            DVLOG(10) << "publisher " << service_name() << ": subscriber " << tag << " is reached through its ring";
+        } catch (const std::exception& e)
+        {
+            // the subscriber has no ring, or its shared memory is not visible from this process, e.g. in another
+            // container of the host
+            DVLOG(10) << "publisher " << service_name() << ": subscriber " << tag
+                      << " is reached through the data plane - " << e.what();
+        }
+    }
 }
-const std::unordered_map<std::uint64_t, std::shared_ptr<ucx::Endpoint>>& PublisherService::tagged_endpoints() const
+
+bool PublisherService::publish_to_ring(mrc::runtime::RemoteDescriptor& rd, memory::SharedMemoryRing& ring)
 {
-    return m_tagged_endpoints;
+    // detach handle from remote descriptor to ensure that the tokens are not decremented
+    auto handle       = remote_descriptor::Manager::unwrap_handle(std::move(rd));
+    const auto& proto = handle->remote_descriptor_proto();
+    const auto bytes  = proto.ByteSizeLong();
+
+    if (bytes <= memory::SharedMemoryRing::MaxMessageBytes)
+    {
+        // the ring has no waiters on the producer side; a full ring is polled with a backoff which yields the fiber
+        auto backoff = std::chrono::microseconds(10);
+        while (true)
+        {
+            auto status = ring.try_write(bytes, [&proto, bytes](void* dst) {
+                CHECK(proto.SerializeToArray(dst, static_cast<int>(bytes)));
+            });
+            if (status == channel::Status::success)
+            {
+                return true;
+            }
+            if (status != channel::Status::full)
+            {
+                break;
+            }
+            boost::this_fiber::sleep_for(backoff);
+            backoff = std::min<std::chrono::microseconds>(2 * backoff, std::chrono::milliseconds(1));
+        }
+    }
+
+    rd = m_runtime.remote_descriptor_manager().make_remote_descriptor(std::move(handle));
+    return false;
+}
+
+const std::unordered_map<std::uint64_t, InstanceID>& PublisherService::tagged_instances() const
+{
+    return m_tagged_instances;
 }
 }  // namespace mrc::internal::pubsub
@@ -39,12 +39,12 @@ namespace mrc::codable {
 class EncodedStorage;
 struct ICodableStorage;
 }  // namespace mrc::codable
+namespace mrc::internal::memory {
+class SharedMemoryRing;
+}  // namespace mrc::internal::memory
 namespace mrc::internal::runtime {
 class Partition;
 }  // namespace mrc::internal::runtime
-namespace mrc::internal::ucx {
-class Endpoint;
-}  // namespace mrc::internal::ucx
 
 namespace mrc::internal::pubsub {
 
@@ -56,7 +56,7 @@ class PublisherService : public Base,
     PublisherService(std::string service_name, runtime::Partition& runtime);
 
   public:
-    ~PublisherService() override = default;
+    ~PublisherService() override;
 
     DELETE_COPYABILITY(PublisherService);
     DELETE_MOVEABILITY(PublisherService);
@@ -67,6 +67,10 @@ class PublisherService : public Base,
     // [IPublisherService] publish an encoded object
     channel::Status publish(std::unique_ptr<mrc::codable::EncodedStorage> encoded_object) final;
 
+    // [IPublisherService] publish an encoded object with a routing key
+    channel::Status publish(std::unique_ptr<mrc::codable::EncodedStorage> encoded_object,
+                            std::uint64_t routing_key) final;
+
     // [ISubscriptionServiceIdentity] provide the value for the role of this instance
     const std::string& role() const final;
 
@@ -74,18 +78,16 @@ class PublisherService : public Base,
     const std::set<std::string>& subscribe_to_roles() const final;
 
   protected:
-    // sends a remote descriptor to a remote endpoint over the data plane with a globally unique tag
+    // sends a remote descriptor to a remote endpoint over the data plane with a globally unique tag, or through the
+    // shared memory ring of a subscriber in another process on the same host
     // note: the tag is required to differentiate multiple subscribers on the same endpoint
     void publish(mrc::runtime::RemoteDescriptor&& rd,
                  const std::uint64_t& tag,
-                 std::shared_ptr<ucx::Endpoint> endpoint);
+                 const InstanceID& instance_id);
 
     // current set of tagged instances
     const std::unordered_map<std::uint64_t, InstanceID>& tagged_instances() const;
 
-    // current set of tagged endpoints
-    const std::unordered_map<std::uint64_t, std::shared_ptr<ucx::Endpoint>>& tagged_endpoints() const;
-
   private:
     // [IPublisherService] provides a runtime dependent codable storage object
     std::unique_ptr<mrc::codable::ICodableStorage> create_storage() final;
@@ -107,6 +109,12 @@ class PublisherService : public Base,
     void update_tagged_instances(const std::string& role,
                                  const std::unordered_map<std::uint64_t, InstanceID>& tagged_instances) final;
 
+    // opens the rings of the added subscribers in other processes on this host and closes those of removed subscribers
+    void update_rings(const std::set<std::uint64_t>& added, const std::set<std::uint64_t>& removed);
+
+    // writes rd into ring; on false, rd is restored and must be sent over the data plane
+    bool publish_to_ring(mrc::runtime::RemoteDescriptor& rd, memory::SharedMemoryRing& ring);
+
     // apply policy
     virtual void apply_policy(mrc::runtime::RemoteDescriptor&& rd) = 0;
 
@@ -122,8 +130,9 @@ class PublisherService : public Base,
     // set of active tagged instances for subscribers
     std::unordered_map<std::uint64_t, InstanceID> m_tagged_instances;
 
-    // set of current tagged endpoints for subscribers
-    std::unordered_map<std::uint64_t, std::shared_ptr<ucx::Endpoint>> m_tagged_endpoints;
+    // shared memory rings of subscribers on this host by tag; held by publishes waiting for a slot while the
+    // subscriber is removed
+    std::unordered_map<std::uint64_t, std::shared_ptr<memory::SharedMemoryRing>> m_rings;
 };
 
 }  // namespace mrc::internal::pubsub
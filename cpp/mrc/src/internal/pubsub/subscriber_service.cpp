@@ -19,16 +19,22 @@
 
 #include "internal/data_plane/resources.hpp"
 #include "internal/data_plane/server.hpp"
+#include "internal/memory/shared_memory_ring.hpp"
 #include "internal/memory/transient_pool.hpp"
 #include "internal/network/resources.hpp"
 #include "internal/remote_descriptor/manager.hpp"
 #include "internal/resources/partition_resources.hpp"
 #include "internal/runnable/resources.hpp"
 #include "internal/runtime/partition.hpp"
+#include "internal/system/resources.hpp"
+#include "internal/system/thread.hpp"
+#include "internal/utils/protobuf_arena_pool.hpp"
 
 #include "mrc/node/edge_builder.hpp"
 #include "mrc/node/operators/router.hpp"
 #include "mrc/node/rx_node.hpp"
+#include "mrc/options/network.hpp"
+#include "mrc/options/options.hpp"
 #include "mrc/protos/codable.pb.h"
 #include "mrc/runnable/launch_control.hpp"
 #include "mrc/runnable/launcher.hpp"
@@ -38,8 +44,11 @@
 #include <glog/logging.h>
 #include <rxcpp/rx.hpp>
 
+#include <cstddef>
+#include <memory>
 #include <optional>
 #include <ostream>
+#include <utility>
 #include <vector>
 
 namespace mrc::internal::pubsub {
@@ -48,7 +57,14 @@ SubscriberService::SubscriberService(std::string service_name, runtime::Partitio
   Base(std::move(service_name), runtime)
 {}
 
-SubscriberService::~SubscriberService() = default;
+SubscriberService::~SubscriberService()
+{
+    // unblocks the reader of a subscriber which was not torn down
+    if (m_ring)
+    {
+        m_ring->close();
+    }
+}
 
 void SubscriberService::do_subscription_service_setup()
 {
@@ -73,11 +89,29 @@ void SubscriberService::do_subscription_service_setup()
         resources().runnable().launch_control().prepare_launcher(std::move(network_handler))->ignition();
 
     m_network_handler->await_live();
+
+    // the ring exists before the tag of the subscriber is announced to publishers by the control plane
+    const auto& options = resources().system().options().network();
+    if (options.enable_shm_rings())
+    {
+        auto name     = ring_name(resources().network()->instance_id(), tag());
+        m_ring        = memory::SharedMemoryRing::create(std::move(name), options.shm_ring_bytes());
+        m_ring_reader = std::make_unique<system::Thread>(resources().runnable().system_resources().make_thread(
+            "shm_ring", resources().runnable().main().affinity(), [this] { read_ring(); }));
+    }
+
     DVLOG(10) << "finished internal:pubsub::SubscriberService setup";
 }
 
 void SubscriberService::do_subscription_service_teardown()
 {
+    // the remote descriptors already in the ring are forwarded before the channel is released by the network handler
+    if (m_ring)
+    {
+        m_ring->close();
+        m_ring_reader->join();
+    }
+
     // disconnect from the deserialize source router
     // this will create a cascading shutdown
     resources().network()->data_plane().server().deserialize_source().drop_edge(tag());
@@ -92,9 +126,9 @@ mrc::runtime::RemoteDescriptor SubscriberService::network_handler(memory::Transi
 {
     DVLOG(10) << "transient buffer holding the rd: " << mrc::bytes_to_string(buffer.bytes());
 
-    // deserialize remote descriptor handle/proto from transient buffer
-    mrc::codable::protos::RemoteDescriptor proto;
-    CHECK(proto.ParseFromArray(buffer.data(), buffer.bytes()));
+    // deserialize remote descriptor handle/proto from transient buffer onto a pooled arena
+    auto proto = utils::ProtobufArenaPool::global().make_message<mrc::codable::protos::RemoteDescriptor>();
+    CHECK(proto->ParseFromArray(buffer.data(), buffer.bytes()));
 
     // release transient buffer so it can be reused
     buffer.release();
@@ -103,6 +137,26 @@ mrc::runtime::RemoteDescriptor SubscriberService::network_handler(memory::Transi
     return runtime().remote_descriptor_manager().make_remote_descriptor(std::move(proto));
 }
 
+void SubscriberService::read_ring()
+{
+    while (true)
+    {
+        auto proto  = utils::ProtobufArenaPool::global().make_message<mrc::codable::protos::RemoteDescriptor>();
+        auto status = m_ring->read([&proto](const void* data, std::size_t bytes) {
+            CHECK(proto->ParseFromArray(data, static_cast<int>(bytes)));
+        });
+        if (status != channel::Status::success)
+        {
+            DCHECK(status == channel::Status::closed);
+            break;
+        }
+
+        auto rd = runtime().remote_descriptor_manager().make_remote_descriptor(std::move(proto));
+        SourceChannelWriteable<mrc::runtime::RemoteDescriptor>::await_write(std::move(rd));
+    }
+    DVLOG(10) << "subscriber " << service_name() << ": ring closed";
+}
+
 const std::string& SubscriberService::role() const
 {
     return role_subscriber();
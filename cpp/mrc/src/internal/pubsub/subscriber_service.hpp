@@ -41,11 +41,15 @@ namespace mrc::channel {
 enum class Status;
 }  // namespace mrc::channel
 namespace mrc::internal::memory {
+class SharedMemoryRing;
 class TransientBuffer;
 }  // namespace mrc::internal::memory
 namespace mrc::internal::runtime {
 class Partition;
 }  // namespace mrc::internal::runtime
+namespace mrc::internal::system {
+class Thread;
+}  // namespace mrc::internal::system
 
 namespace mrc::internal::pubsub {
 
@@ -104,9 +108,16 @@ class SubscriberService final : public Base,
     // deserialize the incoming protobuf and create a local remote descriptor
     mrc::runtime::RemoteDescriptor network_handler(memory::TransientBuffer& buffer);
 
+    // forwards the remote descriptors written to the ring by publishers of other processes until the ring is closed
+    void read_ring();
+
     // runner for the network handler node
     std::unique_ptr<mrc::runnable::Runner> m_network_handler;
 
+    // ring of the subscriber when shared memory rings are enabled, and the thread reading it
+    std::unique_ptr<memory::SharedMemoryRing> m_ring;
+    std::unique_ptr<system::Thread> m_ring_reader;
+
     // limit access to the constructor; this object must be constructed as a shared_ptr
     friend runtime::Partition;
 };
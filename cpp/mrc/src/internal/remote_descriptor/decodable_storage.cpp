@@ -21,7 +21,7 @@
 
 namespace mrc::internal::remote_descriptor {
 
-DecodableStorage::DecodableStorage(mrc::codable::protos::RemoteDescriptor&& proto,
+DecodableStorage::DecodableStorage(utils::ArenaMessage<mrc::codable::protos::RemoteDescriptor>&& proto,
                                    resources::PartitionResources& resources) :
   m_proto(std::move(proto)),
   m_resources(resources)
@@ -31,7 +31,7 @@ DecodableStorage::~DecodableStorage() = default;
 
 const mrc::codable::protos::EncodedObject& DecodableStorage::get_proto() const
 {
-    return m_proto.encoded_object();
+    return m_proto->encoded_object();
 }
 
 resources::PartitionResources& DecodableStorage::resources() const
@@ -41,6 +41,6 @@ resources::PartitionResources& DecodableStorage::resources() const
 
 const mrc::codable::protos::RemoteDescriptor& DecodableStorage::remote_descriptor_proto() const
 {
-    return m_proto;
+    return *m_proto;
 }
 }  // namespace mrc::internal::remote_descriptor
@@ -20,6 +20,7 @@
 #include "internal/codable/decodable_storage_view.hpp"
 #include "internal/codable/storage_view.hpp"
 #include "internal/resources/forward.hpp"
+#include "internal/utils/protobuf_arena_pool.hpp"
 
 #include "mrc/protos/codable.pb.h"
 #include "mrc/runtime/remote_descriptor_handle.hpp"
@@ -36,7 +37,8 @@ class DecodableStorage final : public codable::DecodableStorageView,
                                public mrc::runtime::IRemoteDescriptorHandle
 {
   public:
-    DecodableStorage(mrc::codable::protos::RemoteDescriptor&& proto, resources::PartitionResources& resources);
+    DecodableStorage(utils::ArenaMessage<mrc::codable::protos::RemoteDescriptor>&& proto,
+                     resources::PartitionResources& resources);
     ~DecodableStorage() final;
 
     DELETE_COPYABILITY(DecodableStorage);
@@ -50,7 +52,7 @@ class DecodableStorage final : public codable::DecodableStorageView,
     resources::PartitionResources& resources() const final;
 
   private:
-    mrc::codable::protos::RemoteDescriptor m_proto;
+    utils::ArenaMessage<mrc::codable::protos::RemoteDescriptor> m_proto;
     resources::PartitionResources& m_resources;
 };
 
@@ -26,8 +26,11 @@
 #include "internal/remote_descriptor/storage.hpp"
 #include "internal/resources/partition_resources.hpp"
 #include "internal/runnable/resources.hpp"
+#include "internal/system/system.hpp"
 #include "internal/ucx/resources.hpp"
 #include "internal/ucx/worker.hpp"
+#include "internal/utils/id_allocator.hpp"
+#include "internal/utils/protobuf_arena_pool.hpp"
 
 #include "mrc/channel/buffered_channel.hpp"
 #include "mrc/channel/channel.hpp"
@@ -37,6 +40,8 @@
 #include "mrc/node/edge_builder.hpp"
 #include "mrc/node/rx_sink.hpp"
 #include "mrc/node/source_channel.hpp"
+#include "mrc/options/network.hpp"
+#include "mrc/options/options.hpp"
 #include "mrc/protos/codable.pb.h"
 #include "mrc/runnable/launch_control.hpp"
 #include "mrc/runnable/launch_options.hpp"
@@ -51,7 +56,10 @@
 #include <ucp/api/ucp.h>
 #include <ucs/type/status.h>
 
+#include <algorithm>
 #include <atomic>
+#include <chrono>
+#include <cstddef>
 #include <optional>
 #include <sstream>
 #include <string>
@@ -65,14 +73,19 @@ namespace {
 ucs_status_t active_message_callback(
     void* arg, const void* header, size_t header_length, void* data, size_t length, const ucp_am_recv_param_t* param)
 {
-    DCHECK_EQ(header_length, sizeof(RemoteDescriptorDecrementMessage));
+    // the header carries a batch of decrements
+    DCHECK_EQ(header_length % sizeof(RemoteDescriptorDecrementMessage), 0);
 
-    const auto* const_msg   = static_cast<const RemoteDescriptorDecrementMessage*>(header);
+    const auto* const_msgs  = static_cast<const RemoteDescriptorDecrementMessage*>(header);
+    const auto count        = header_length / sizeof(RemoteDescriptorDecrementMessage);
     auto* decrement_channel = static_cast<node::SourceChannelWriteable<RemoteDescriptorDecrementMessage>*>(arg);
 
-    // make a copy of the message and write it to the channel
-    auto msg = *const_msg;
-    CHECK(decrement_channel->await_write(std::move(msg)) == channel::Status::success);
+    // make a copy of each message and write it to the channel
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        auto msg = const_msgs[i];
+        CHECK(decrement_channel->await_write(std::move(msg)) == channel::Status::success);
+    }
 
     // we are done and data will not be used
     return UCS_OK;
@@ -82,7 +95,9 @@ ucs_status_t active_message_callback(
 
 Manager::Manager(const InstanceID& instance_id, resources::PartitionResources& resources) :
   m_instance_id(instance_id),
-  m_resources(resources)
+  m_resources(resources),
+  m_token_release_window(resources.system().options().network().token_release_window()),
+  m_token_release_batch_size(resources.system().options().network().token_release_batch_size())
 {
     service_set_description(MRC_CONCAT_STR("mrc::remote_description_manager[" << instance_id << "]"));
     service_start();
@@ -94,7 +109,8 @@ Manager::~Manager()
     Service::call_in_destructor();
 }
 
-mrc::runtime::RemoteDescriptor Manager::make_remote_descriptor(mrc::codable::protos::RemoteDescriptor&& proto)
+mrc::runtime::RemoteDescriptor Manager::make_remote_descriptor(
+    utils::ArenaMessage<mrc::codable::protos::RemoteDescriptor>&& proto)
 {
     // attach the resources for the partition in which this manager is operating to the rd's protobuf
     auto handle = std::make_unique<DecodableStorage>(std::move(proto), m_resources);
@@ -102,20 +118,55 @@ mrc::runtime::RemoteDescriptor Manager::make_remote_descriptor(mrc::codable::pro
 }
 
 mrc::runtime::RemoteDescriptor Manager::register_encoded_object(std::unique_ptr<mrc::codable::EncodedStorage> object)
+{
+    return register_encoded_object(std::move(object), std::nullopt);
+}
+
+mrc::runtime::RemoteDescriptor Manager::register_encoded_object(std::unique_ptr<mrc::codable::EncodedStorage> object,
+                                                                std::uint64_t routing_key)
+{
+    return register_encoded_object(std::move(object), std::optional<std::uint64_t>(routing_key));
+}
+
+std::optional<std::uint64_t> Manager::routing_key(const mrc::runtime::RemoteDescriptor& rd)
+{
+    CHECK(rd);
+    const auto& proto = rd.m_handle->remote_descriptor_proto();
+    if (proto.has_routing_key())
+    {
+        return proto.routing_key();
+    }
+    return std::nullopt;
+}
+
+std::uint64_t Manager::object_id(const mrc::runtime::RemoteDescriptor& rd)
+{
+    CHECK(rd);
+    return rd.m_handle->remote_descriptor_proto().object_id();
+}
+
+mrc::runtime::RemoteDescriptor Manager::register_encoded_object(std::unique_ptr<mrc::codable::EncodedStorage> object,
+                                                                std::optional<std::uint64_t> routing_key)
 {
     CHECK(object);
 
-    auto object_id = reinterpret_cast<std::size_t>(object.get());
+    // ids are never reissued, so a decrement in flight for a destroyed object can not reach an object stored later
+    const auto object_id = utils::IdAllocator<Manager>::next();
 
     Storage storage(std::move(object));
-    mrc::codable::protos::RemoteDescriptor rd;
+    // the rd and its copy of the encoded object are allocated on a pooled arena owned by the local handle
+    auto rd = utils::ProtobufArenaPool::global().make_message<mrc::codable::protos::RemoteDescriptor>();
 
     DVLOG(10) << "storing object_id: " << object_id << " with " << storage.tokens_count() << " tokens";
 
-    rd.set_instance_id(m_instance_id);
-    rd.set_object_id(object_id);
-    rd.set_tokens(storage.tokens_count());
-    *(rd.mutable_encoded_object()) = storage.encoding().proto();  // copy the proto::EncodedObject
+    rd->set_instance_id(m_instance_id);
+    rd->set_object_id(object_id);
+    rd->set_tokens(storage.tokens_count());
+    *(rd->mutable_encoded_object()) = storage.encoding().proto();  // copy the proto::EncodedObject
+    if (routing_key)
+    {
+        rd->set_routing_key(*routing_key);
+    }
 
     {
         // lock when modifying the map
@@ -128,6 +179,49 @@ mrc::runtime::RemoteDescriptor Manager::register_encoded_object(std::unique_ptr<
     return make_remote_descriptor(std::move(rd));
 }
 
+std::vector<mrc::runtime::RemoteDescriptor> Manager::split(mrc::runtime::RemoteDescriptor&& rd, std::size_t count)
+{
+    CHECK_GT(count, 0);
+
+    // the tokens of the unwrapped handle are transferred to the split descriptors, not released
+    auto handle       = unwrap_handle(std::move(rd));
+    const auto& proto = handle->remote_descriptor_proto();
+    CHECK_GE(proto.tokens(), count) << "remote descriptor does not hold enough tokens to be split " << count << " ways";
+
+    const auto share     = proto.tokens() / count;
+    const auto remainder = proto.tokens() % count;
+
+    std::vector<mrc::runtime::RemoteDescriptor> rds;
+    rds.reserve(count);
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        auto split_proto = utils::ProtobufArenaPool::global().make_message<mrc::codable::protos::RemoteDescriptor>();
+        *split_proto     = proto;
+        split_proto->set_tokens(share + (i < remainder ? 1 : 0));
+        rds.push_back(make_remote_descriptor(std::move(split_proto)));
+    }
+    return rds;
+}
+
+bool Manager::on_release(const mrc::runtime::RemoteDescriptor& rd, std::function<void()> callback)
+{
+    CHECK(rd);
+    const auto& proto = rd.m_handle->remote_descriptor_proto();
+    if (proto.instance_id() != m_instance_id)
+    {
+        return false;
+    }
+
+    std::lock_guard lock(m_mutex);
+    auto search = m_stored_objects.find(proto.object_id());
+    if (search == m_stored_objects.end())
+    {
+        return false;
+    }
+    search->second.on_release(std::move(callback));
+    return true;
+}
+
 std::unique_ptr<mrc::codable::ICodableStorage> Manager::create_storage()
 {
     return std::make_unique<codable::CodableStorage>(m_resources);
@@ -149,30 +243,98 @@ void Manager::release_handle(std::unique_ptr<mrc::runtime::IRemoteDescriptorHand
     }
     else
     {
-        // issue active message to remote instance_id to decrement tokens on remote object_id
+        // queue an active message to remote instance_id to decrement tokens on remote object_id
         RemoteDescriptorDecrementMessage msg;
         msg.object_id = rd.object_id();
         msg.tokens    = rd.tokens();
-        auto endpoint = m_resources.network()->data_plane().client().endpoint_shared(rd.instance_id());
+        enqueue_remote_decrement(rd.instance_id(), msg);
+    }
+}
 
-        data_plane::Request request;
-        data_plane::Client::async_am_send(active_message_id(), &msg, sizeof(msg), *endpoint, request);
-        CHECK(request.await_complete());
+void Manager::enqueue_remote_decrement(const InstanceID& instance_id, RemoteDescriptorDecrementMessage msg)
+{
+    std::vector<RemoteDescriptorDecrementMessage> full_batch;
+    {
+        std::lock_guard<decltype(m_pending_mutex)> lock(m_pending_mutex);
+        auto& batch = m_pending_decrements[instance_id];
+
+        // releases of the same object within a window collapse into a single decrement
+        auto search = std::find_if(batch.begin(), batch.end(), [&msg](const auto& pending) {
+            return pending.object_id == msg.object_id;
+        });
+        if (search != batch.end())
+        {
+            search->tokens += msg.tokens;
+        }
+        else
+        {
+            batch.push_back(msg);
+        }
+
+        if (batch.size() >= m_token_release_batch_size || !m_flusher_running)
+        {
+            full_batch = std::move(batch);
+            m_pending_decrements.erase(instance_id);
+        }
+    }
+
+    if (!full_batch.empty())
+    {
+        send_remote_decrements(instance_id, full_batch);
+    }
+}
+
+void Manager::flush_remote_decrements()
+{
+    decltype(m_pending_decrements) pending;
+    {
+        std::lock_guard<decltype(m_pending_mutex)> lock(m_pending_mutex);
+        std::swap(pending, m_pending_decrements);
+    }
+
+    for (const auto& [instance_id, msgs] : pending)
+    {
+        send_remote_decrements(instance_id, msgs);
     }
 }
 
+void Manager::send_remote_decrements(const InstanceID& instance_id,
+                                     const std::vector<RemoteDescriptorDecrementMessage>& msgs)
+{
+    DVLOG(10) << "sending " << msgs.size() << " token decrements to instance_id: " << instance_id;
+    auto endpoint = m_resources.network()->data_plane().client().endpoint_shared(instance_id);
+
+    data_plane::Request request;
+    data_plane::Client::async_am_send(active_message_id(),
+                                      msgs.data(),
+                                      msgs.size() * sizeof(RemoteDescriptorDecrementMessage),
+                                      *endpoint,
+                                      request);
+    CHECK(request.await_complete());
+}
+
 void Manager::decrement_tokens(std::size_t object_id, std::size_t token_count)
 {
-    std::lock_guard<decltype(m_mutex)> lock(m_mutex);
-    LOG(INFO) << "decrementing " << token_count << " tokens from object_id: " << object_id;
-    DVLOG(10) << "decrementing " << token_count << " tokens from object_id: " << object_id;
-    auto search = m_stored_objects.find(object_id);
-    CHECK(search != m_stored_objects.end());
-    auto remaining = search->second.decrement_tokens(token_count);
-    if (remaining == 0)
+    std::vector<std::function<void()>> release_callbacks;
     {
-        DVLOG(10) << "destroying object_id: " << object_id;
-        m_stored_objects.erase(search);
+        std::lock_guard<decltype(m_mutex)> lock(m_mutex);
+        LOG(INFO) << "decrementing " << token_count << " tokens from object_id: " << object_id;
+        DVLOG(10) << "decrementing " << token_count << " tokens from object_id: " << object_id;
+        auto search = m_stored_objects.find(object_id);
+        CHECK(search != m_stored_objects.end());
+        auto remaining = search->second.decrement_tokens(token_count);
+        if (remaining == 0)
+        {
+            DVLOG(10) << "destroying object_id: " << object_id;
+            release_callbacks = search->second.release_callbacks();
+            m_stored_objects.erase(search);
+        }
+    }
+
+    // invoked outside the lock, the callbacks may interact with this manager
+    for (auto& callback : release_callbacks)
+    {
+        callback();
     }
 }
 
@@ -203,10 +365,31 @@ void Manager::do_service_start()
     params.arg   = m_decrement_channel.get();
 
     CHECK_EQ(ucp_worker_set_am_recv_handler(m_resources.network()->ucx().worker().handle(), &params), UCS_OK);
+
+    // periodically flush the batches of token releases to remote instances
+    if (m_token_release_window.count() > 0)
+    {
+        m_flusher_running   = true;
+        m_decrement_flusher = m_resources.runnable().main().enqueue([this] {
+            while (m_flusher_running)
+            {
+                boost::this_fiber::sleep_for(m_token_release_window);
+                flush_remote_decrements();
+            }
+        });
+    }
 }
 
 void Manager::do_service_stop()
 {
+    // release the tokens of remote objects before awaiting the release of local objects by remote instances
+    if (m_decrement_flusher.valid())
+    {
+        m_flusher_running = false;
+        m_decrement_flusher.get();
+    }
+    flush_remote_decrements();
+
     while (!m_stored_objects.empty())
     {
         LOG_EVERY_N(WARNING, INT32_MAX) << "awaiting release of remote descriptors";  // NOLINT
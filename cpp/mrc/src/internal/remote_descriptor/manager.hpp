@@ -20,16 +20,22 @@
 #include "internal/remote_descriptor/messages.hpp"
 #include "internal/remote_descriptor/storage.hpp"
 #include "internal/service.hpp"
+#include "internal/utils/protobuf_arena_pool.hpp"
 
 #include "mrc/runtime/remote_descriptor.hpp"
 #include "mrc/runtime/remote_descriptor_manager.hpp"
 #include "mrc/types.hpp"
 
+#include <atomic>
+#include <chrono>
 #include <cstddef>
 #include <cstdint>
+#include <functional>
 #include <map>
 #include <memory>
 #include <mutex>
+#include <optional>
+#include <vector>
 
 namespace mrc::codable {
 class EncodedStorage;
@@ -65,7 +71,9 @@ namespace mrc::internal::remote_descriptor {
  * ownership of the object and hold it until the all RemoteDescriptor (RD) reference count tokens are released.
  *
  * The manager is also responsible for decrement the global reference count when a remote descriptor is released. This
- * is done via a ucx active message.
+ * is done via a ucx active message. Releases of objects owned by the same remote instance are coalesced over a short
+ * window, see NetworkOptions::token_release_window, and sent as a single active message carrying a batch of
+ * decrements; pending releases are flushed when the manager is stopped.
  *
  * This object will register an active message handler with the data plane's ucx worker. The registered callback will be
  * triggered and executed by the thread running the ucx worker progress engine, i.e. the data plane's io thread. To
@@ -87,7 +95,8 @@ class Manager final : private Service,
 
     ~Manager() override;
 
-    mrc::runtime::RemoteDescriptor make_remote_descriptor(mrc::codable::protos::RemoteDescriptor&& proto);
+    mrc::runtime::RemoteDescriptor make_remote_descriptor(
+        utils::ArenaMessage<mrc::codable::protos::RemoteDescriptor>&& proto);
     mrc::runtime::RemoteDescriptor make_remote_descriptor(
         std::unique_ptr<mrc::runtime::IRemoteDescriptorHandle> handle);
 
@@ -101,15 +110,56 @@ class Manager final : private Service,
 
     mrc::runtime::RemoteDescriptor register_encoded_object(std::unique_ptr<mrc::codable::EncodedStorage> object) final;
 
+    /**
+     * @brief Register an encoded object whose remote descriptors carry routing_key, which is preserved when the
+     * descriptor is transferred or split
+     */
+    mrc::runtime::RemoteDescriptor register_encoded_object(std::unique_ptr<mrc::codable::EncodedStorage> object,
+                                                           std::uint64_t routing_key);
+
+    /**
+     * @brief Routing key of rd if one was set when its object was registered
+     */
+    static std::optional<std::uint64_t> routing_key(const mrc::runtime::RemoteDescriptor& rd);
+
+    /**
+     * @brief Global object id of rd; unique among the objects of the instance owning the object
+     */
+    static std::uint64_t object_id(const mrc::runtime::RemoteDescriptor& rd);
+
+    /**
+     * @brief Split the tokens held by rd across count remote descriptors of the same global object, e.g. to send the
+     * object to multiple remote instances; rd must hold at least count tokens
+     */
+    std::vector<mrc::runtime::RemoteDescriptor> split(mrc::runtime::RemoteDescriptor&& rd, std::size_t count);
+
+    /**
+     * @brief Invoke callback once all tokens of the global object of rd have been released
+     *
+     * @return false if the object of rd is not stored by this manager, in which case the callback is dropped
+     */
+    bool on_release(const mrc::runtime::RemoteDescriptor& rd, std::function<void()> callback);
     static std::unique_ptr<mrc::runtime::IRemoteDescriptorHandle> unwrap_handle(mrc::runtime::RemoteDescriptor&& rd);
 
   private:
     static std::uint32_t active_message_id();
 
+    mrc::runtime::RemoteDescriptor register_encoded_object(std::unique_ptr<mrc::codable::EncodedStorage> object,
+                                                           std::optional<std::uint64_t> routing_key);
+
     std::unique_ptr<mrc::codable::ICodableStorage> create_storage() final;
 
     void decrement_tokens(std::size_t object_id, std::size_t token_count);
 
+    // queue a decrement of an object owned by a remote instance, sending the batch of the instance once full
+    void enqueue_remote_decrement(const InstanceID& instance_id, RemoteDescriptorDecrementMessage msg);
+
+    // send the pending batches of decrements of all remote instances
+    void flush_remote_decrements();
+
+    void send_remote_decrements(const InstanceID& instance_id,
+                                const std::vector<RemoteDescriptorDecrementMessage>& msgs);
+
     void do_service_start() final;
     void do_service_stop() final;
     void do_service_kill() final;
@@ -126,6 +176,14 @@ class Manager final : private Service,
 
     mutable std::mutex m_mutex;
 
+    // <instance_id, decrements> of remote objects awaiting a batched release
+    std::map<InstanceID, std::vector<RemoteDescriptorDecrementMessage>> m_pending_decrements;
+    std::mutex m_pending_mutex;
+    const std::chrono::microseconds m_token_release_window;
+    const std::size_t m_token_release_batch_size;
+    std::atomic<bool> m_flusher_running{false};
+    Future<void> m_decrement_flusher;
+
     friend internal::runtime::Partition;
 };
 
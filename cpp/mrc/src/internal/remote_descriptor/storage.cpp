@@ -50,4 +50,15 @@ std::size_t Storage::decrement_tokens(std::size_t decrement_count)
     return m_tokens;
 }
 
+void Storage::on_release(std::function<void()> callback)
+{
+    CHECK(callback);
+    m_release_callbacks.push_back(std::move(callback));
+}
+
+std::vector<std::function<void()>> Storage::release_callbacks()
+{
+    return std::exchange(m_release_callbacks, {});
+}
+
 }  // namespace mrc::internal::remote_descriptor
@@ -21,7 +21,9 @@
 
 #include <cstddef>
 #include <cstdint>
+#include <functional>
 #include <memory>
+#include <vector>
 
 namespace mrc::codable {
 class IDecodableStorage;
@@ -47,9 +49,16 @@ class Storage final
 
     std::size_t decrement_tokens(std::size_t decrement_count);
 
+    // register a callback to be invoked once all tokens have been released
+    void on_release(std::function<void()> callback);
+
+    // take ownership of the release callbacks; the owner of the storage invokes them once it has been destroyed
+    std::vector<std::function<void()>> release_callbacks();
+
   private:
     std::unique_ptr<mrc::codable::EncodedStorage> m_storage;
     std::int32_t m_tokens{INT32_MAX};
+    std::vector<std::function<void()>> m_release_callbacks;
 };
 
 }  // namespace mrc::internal::remote_descriptor
@@ -22,6 +22,7 @@
 #include "internal/control_plane/client/instance.hpp"
 #include "internal/control_plane/resources.hpp"
 #include "internal/data_plane/resources.hpp"  // IWYU pragma: keep
+#include "internal/memory/device_group.hpp"
 #include "internal/memory/device_resources.hpp"
 #include "internal/network/resources.hpp"
 #include "internal/resources/partition_resources_base.hpp"
@@ -32,6 +33,7 @@
 #include "internal/system/partitions.hpp"
 #include "internal/system/resources.hpp"
 #include "internal/system/system.hpp"
+#include "internal/system/thread_scheduling.hpp"
 #include "internal/ucx/registation_callback_builder.hpp"
 #include "internal/ucx/resources.hpp"
 #include "internal/utils/contains.hpp"
@@ -39,21 +41,107 @@
 #include "mrc/core/bitmap.hpp"
 #include "mrc/core/task_queue.hpp"
 #include "mrc/exceptions/runtime_error.hpp"
+#include "mrc/options/network.hpp"
 #include "mrc/options/options.hpp"
 #include "mrc/options/placement.hpp"
 
 #include <boost/fiber/future/future.hpp>
 #include <glog/logging.h>
 
+#include <chrono>
+#include <cstddef>
+#include <exception>
 #include <map>
 #include <optional>
 #include <ostream>
+#include <sstream>
 #include <string>
 #include <thread>
 #include <utility>
+#include <vector>
 
 namespace mrc::internal::resources {
 
+namespace {
+
+/**
+ * @brief Runs build_fn(i) for each i in [0, count) on a thread of its own and rethrows the first exception once all
+ * of them have returned.
+ *
+ * The resources of a partition are built on the task queues of the partition, so the builds of different partitions,
+ * e.g. the cuda contexts and ucx contexts of each gpu, only contend where partitions share a task queue.
+ */
+template <typename BuildFnT>
+void build_in_parallel(std::size_t count, BuildFnT&& build_fn)
+{
+    if (count <= 1)
+    {
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            build_fn(i);
+        }
+        return;
+    }
+
+    std::vector<std::exception_ptr> errors(count);
+    std::vector<std::thread> threads;
+    threads.reserve(count);
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        threads.emplace_back([&build_fn, &errors, i] {
+            try
+            {
+                build_fn(i);
+            } catch (...)
+            {
+                errors[i] = std::current_exception();
+            }
+        });
+    }
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+    for (auto& error : errors)
+    {
+        if (error)
+        {
+            std::rethrow_exception(error);
+        }
+    }
+}
+
+// wall time of each stage of the construction of the resources, logged once all stages are built
+class StartupTimings
+{
+  public:
+    void lap(std::string stage)
+    {
+        auto now = std::chrono::steady_clock::now();
+        m_stages.emplace_back(std::move(stage), now - m_lap);
+        m_lap = now;
+    }
+
+    std::string summary() const
+    {
+        std::stringstream ss;
+        ss << std::chrono::duration_cast<std::chrono::milliseconds>(m_lap - m_start).count() << " ms;";
+        for (const auto& [stage, elapsed] : m_stages)
+        {
+            ss << " " << stage << ": " << std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count()
+               << " ms";
+        }
+        return ss.str();
+    }
+
+  private:
+    const std::chrono::steady_clock::time_point m_start{std::chrono::steady_clock::now()};
+    std::chrono::steady_clock::time_point m_lap{m_start};
+    std::vector<std::pair<std::string, std::chrono::steady_clock::duration>> m_stages;
+};
+
+}  // namespace
+
 thread_local Manager* Manager::m_thread_resources{nullptr};
 thread_local PartitionResources* Manager::m_thread_partition{nullptr};
 
@@ -67,12 +155,25 @@ Manager::Manager(std::unique_ptr<system::Resources> resources) :
     const auto& host_partitions = system().partitions().host_partitions();
     const bool network_enabled  = !system().options().architect_url().empty();
 
+    StartupTimings timings;
+
+    // scheduling classes of the engine groups are applied to their threads before any runnable resources are built
+    system::register_engine_group_scheduling(*m_system);
+
     // construct the runnable resources on each host_partition - launch control and main
-    for (std::size_t i = 0; i < host_partitions.size(); ++i)
+    // each stage below builds the resources of every partition concurrently; stages depend on the previous ones
     {
-        VLOG(1) << "building runnable/launch_control resources on host_partition: " << i;
-        m_runnable.emplace_back(*m_system, i);
+        std::vector<std::optional<runnable::Resources>> runnable(host_partitions.size());
+        build_in_parallel(host_partitions.size(), [&](std::size_t i) {
+            VLOG(1) << "building runnable/launch_control resources on host_partition: " << i;
+            runnable[i].emplace(*m_system, i);
+        });
+        for (auto& r : runnable)
+        {
+            m_runnable.emplace_back(std::move(*r));
+        }
     }
+    timings.lap("runnable");
 
     std::vector<PartitionResourceBase> base_partition_resources;
     for (int i = 0; i < partitions.size(); i++)
@@ -83,22 +184,34 @@ Manager::Manager(std::unique_ptr<system::Resources> resources) :
 
     // construct ucx resources on each flattened partition
     // this provides a ucx context, ucx worker and registration cache per partition
-    for (auto& base : base_partition_resources)
+    m_ucx.resize(base_partition_resources.size());
+    if (network_enabled)
     {
-        if (network_enabled)
-        {
+        build_in_parallel(base_partition_resources.size(), [&](std::size_t partition_id) {
+            auto& base = base_partition_resources.at(partition_id);
             VLOG(1) << "building ucx resources for partition " << base.partition_id();
             auto network_task_queue_cpuset =
                 base.partition().host().engine_factory_cpu_sets().fiber_cpu_sets.at("mrc_network");
             auto& network_fiber_queue = m_system->get_task_queue(network_task_queue_cpuset.first());
-            std::optional<ucx::Resources> ucx;
-            ucx.emplace(base, network_fiber_queue);
-            m_ucx.push_back(std::move(ucx));
-        }
-        else
-        {
-            m_ucx.emplace_back(std::nullopt);
-        }
+
+            // additional ucx workers are progressed on the other cpus of the network engine factory
+            const auto worker_count = system().options().network().workers_per_partition();
+            const auto network_cpus = network_task_queue_cpuset.vec();
+            std::vector<system::FiberTaskQueue*> worker_task_queues;
+            for (std::size_t i = 1; i < worker_count && i < network_cpus.size(); i++)
+            {
+                worker_task_queues.push_back(&m_system->get_task_queue(network_cpus[i]));
+            }
+            if (worker_count > network_cpus.size())
+            {
+                LOG(WARNING) << "partition " << base.partition_id() << " has " << network_cpus.size()
+                             << " network cpus; using " << network_cpus.size() << " of the " << worker_count
+                             << " requested ucx workers";
+            }
+
+            m_ucx.at(partition_id).emplace(base, network_fiber_queue, std::move(worker_task_queues));
+        });
+        timings.lap("ucx");
     }
 
     // create control plane and register worker addresses
@@ -108,63 +221,71 @@ Manager::Manager(std::unique_ptr<system::Resources> resources) :
         m_control_plane   = std::make_shared<control_plane::Resources>(base_partition_resources.at(0));
         control_instances = m_control_plane->client().register_ucx_addresses(m_ucx);
         CHECK_EQ(m_control_plane->client().connections().instance_ids().size(), m_ucx.size());
+        timings.lap("control_plane");
     }
 
     // construct the host memory resources for each host_partition
-    for (std::size_t i = 0; i < host_partitions.size(); ++i)
     {
-        ucx::RegistrationCallbackBuilder builder;
-        for (auto& ucx : m_ucx)
-        {
-            if (ucx)
+        std::vector<std::optional<memory::HostResources>> host(host_partitions.size());
+        build_in_parallel(host_partitions.size(), [&](std::size_t i) {
+            ucx::RegistrationCallbackBuilder builder;
+            for (auto& ucx : m_ucx)
             {
-                if (ucx->partition().host_partition_id() == i)
+                if (ucx)
                 {
-                    ucx->add_registration_cache_to_builder(builder);
+                    if (ucx->partition().host_partition_id() == i)
+                    {
+                        ucx->add_registration_cache_to_builder(builder);
+                    }
                 }
             }
+            VLOG(1) << "building host resources for host_partition: " << i;
+            host[i].emplace(m_runnable.at(i), std::move(builder));
+        });
+        for (auto& h : host)
+        {
+            m_host.emplace_back(std::move(*h));
         }
-        VLOG(1) << "building host resources for host_partition: " << i;
-        m_host.emplace_back(m_runnable.at(i), std::move(builder));
     }
+    timings.lap("host");
 
     // devices resources
-    for (auto& base : base_partition_resources)
-    {
+    m_device.resize(base_partition_resources.size());
+    build_in_parallel(base_partition_resources.size(), [&](std::size_t partition_id) {
+        auto& base = base_partition_resources.at(partition_id);
         VLOG(1) << "building device resources for partition: " << base.partition_id();
         if (base.partition().has_device())
         {
             DCHECK_LT(base.partition_id(), device_count());
-            std::optional<memory::DeviceResources> device;
-            device.emplace(base, m_ucx.at(base.partition_id()));
-            m_device.emplace_back(std::move(device));
+            m_device.at(partition_id).emplace(base, m_ucx.at(base.partition_id()));
         }
-        else
-        {
-            m_device.emplace_back(std::nullopt);
-        }
-    }
+    });
+    timings.lap("device");
 
     // network resources
-    for (auto& base : base_partition_resources)
+    m_network.resize(base_partition_resources.size());
+    if (network_enabled)
     {
-        if (network_enabled)
+        // the instances are taken out of the map before the partitions are built concurrently
+        std::vector<std::unique_ptr<control_plane::client::Instance>> instances;
+        for (auto& base : base_partition_resources)
         {
-            VLOG(1) << "building network resources for partition: " << base.partition_id();
-            CHECK(m_ucx.at(base.partition_id()));
             auto instance_id = m_control_plane->client().connections().instance_ids().at(base.partition_id());
             DCHECK(contains(control_instances, instance_id));  // todo(cpp20) contains
-            auto instance = std::move(control_instances.at(instance_id));
-            network::Resources network(base,
-                                       *m_ucx.at(base.partition_id()),
-                                       m_host.at(base.partition().host_partition_id()),
-                                       std::move(instance));
-            m_network.emplace_back(std::move(network));
-        }
-        else
-        {
-            m_network.emplace_back(std::nullopt);
+            instances.push_back(std::move(control_instances.at(instance_id)));
         }
+
+        build_in_parallel(base_partition_resources.size(), [&](std::size_t partition_id) {
+            auto& base = base_partition_resources.at(partition_id);
+            VLOG(1) << "building network resources for partition: " << base.partition_id();
+            CHECK(m_ucx.at(base.partition_id()));
+            m_network.at(partition_id)
+                .emplace(base,
+                         *m_ucx.at(base.partition_id()),
+                         m_host.at(base.partition().host_partition_id()),
+                         std::move(instances.at(partition_id)));
+        });
+        timings.lap("network");
     }
 
     // partition resources
@@ -187,8 +308,9 @@ Manager::Manager(std::unique_ptr<system::Resources> resources) :
             }
         });
     }
+    timings.lap("partitions");
 
-    VLOG(10) << "resources::Manager initialized";
+    LOG(INFO) << "resources::Manager initialized " << partition_count() << " partitions in " << timings.summary();
 }
 
 Manager::~Manager()
@@ -212,6 +334,31 @@ PartitionResources& Manager::partition(std::size_t partition_id)
     return m_partitions.at(partition_id);
 }
 
+memory::DeviceGroup Manager::make_device_group(const std::vector<std::size_t>& partition_ids)
+{
+    std::vector<memory::DeviceResources*> members;
+    for (auto partition_id : partition_ids)
+    {
+        auto& device = partition(partition_id).device();
+        CHECK(device) << "partition " << partition_id << " has no device to join a device group";
+        members.push_back(&*device);
+    }
+    return memory::DeviceGroup(std::move(members));
+}
+
+memory::DeviceGroup Manager::make_device_group()
+{
+    std::vector<std::size_t> partition_ids;
+    for (std::size_t partition_id = 0; partition_id < partition_count(); ++partition_id)
+    {
+        if (partition(partition_id).device())
+        {
+            partition_ids.push_back(partition_id);
+        }
+    }
+    return make_device_group(partition_ids);
+}
+
 Manager& Manager::get_resources()
 {
     if (m_thread_resources == nullptr)  // todo(cpp20) [[unlikely]]
@@ -36,6 +36,7 @@ namespace mrc::internal::control_plane {
 class Resources;
 }  // namespace mrc::internal::control_plane
 namespace mrc::internal::memory {
+class DeviceGroup;
 class DeviceResources;
 }  // namespace mrc::internal::memory
 namespace mrc::internal::system {
@@ -65,6 +66,15 @@ class Manager final : public system::SystemProvider
 
     PartitionResources& partition(std::size_t partition_id);
 
+    /**
+     * @brief Group of the device resources of partition_ids for nodes spanning multiple gpus; every partition must
+     * have a device
+     */
+    memory::DeviceGroup make_device_group(const std::vector<std::size_t>& partition_ids);
+
+    // group of the devices of all partitions
+    memory::DeviceGroup make_device_group();
+
   private:
     Future<void> shutdown();
 
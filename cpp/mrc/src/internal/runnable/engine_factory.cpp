@@ -25,6 +25,8 @@
 
 #include "mrc/constants.hpp"
 #include "mrc/core/bitmap.hpp"
+#include "mrc/core/fiber_meta_data.hpp"
+#include "mrc/core/fiber_stack_pool.hpp"
 #include "mrc/exceptions/runtime_error.hpp"
 #include "mrc/runnable/engine_factory.hpp"
 #include "mrc/runnable/launch_options.hpp"
@@ -44,6 +46,11 @@ namespace mrc::internal::runnable {
 class FiberEngineFactory : public ::mrc::runnable::EngineFactory
 {
   public:
+    FiberEngineFactory(std::shared_ptr<FiberStackPool> stack_pool, int fiber_priority) :
+      m_stack_pool(std::move(stack_pool)),
+      m_fiber_priority(fiber_priority)
+    {}
+
     /**
      * @brief FiberEngines will be build on N pes/threads with fibers per thread equivalent to engines_per_pe.
      *
@@ -56,7 +63,9 @@ class FiberEngineFactory : public ::mrc::runnable::EngineFactory
     {
         std::lock_guard<decltype(m_mutex)> lock(m_mutex);
         return std::make_shared<FiberEngines>(
-            launch_options, get_next_n_queues(launch_options.pe_count), MRC_DEFAULT_FIBER_PRIORITY);
+            launch_options,
+            get_next_n_queues(launch_options.pe_count),
+            FiberMetaData{m_fiber_priority, m_stack_pool, launch_options.fiber_share, launch_options.time_slice});
     }
 
     ::mrc::runnable::EngineType backend() const final
@@ -66,6 +75,12 @@ class FiberEngineFactory : public ::mrc::runnable::EngineFactory
 
   private:
     virtual std::vector<std::reference_wrapper<core::FiberTaskQueue>> get_next_n_queues(std::size_t count) = 0;
+
+    // the fibers of all engines built by the factory share its stack pool, so relaunched engines reuse their stacks
+    std::shared_ptr<FiberStackPool> m_stack_pool;
+
+    // fibers of latency-critical groups are scheduled ahead of the other fibers sharing their threads
+    int m_fiber_priority;
     std::mutex m_mutex;
 };
 
@@ -75,7 +90,11 @@ class FiberEngineFactory : public ::mrc::runnable::EngineFactory
 class ReusableFiberEngineFactory final : public FiberEngineFactory
 {
   public:
-    ReusableFiberEngineFactory(const system::Resources& system_resources, const CpuSet& cpu_set) :
+    ReusableFiberEngineFactory(const system::Resources& system_resources,
+                               const CpuSet& cpu_set,
+                               std::shared_ptr<FiberStackPool> stack_pool,
+                           int fiber_priority) :
+      FiberEngineFactory(std::move(stack_pool), fiber_priority),
       m_pool(system_resources.make_fiber_pool(cpu_set))
     {}
     ~ReusableFiberEngineFactory() final = default;
@@ -114,7 +133,11 @@ class ReusableFiberEngineFactory final : public FiberEngineFactory
 class SingleUseFiberEngineFactory final : public FiberEngineFactory
 {
   public:
-    SingleUseFiberEngineFactory(const system::Resources& system_resources, const CpuSet& cpu_set) :
+    SingleUseFiberEngineFactory(const system::Resources& system_resources,
+                                const CpuSet& cpu_set,
+                                std::shared_ptr<FiberStackPool> stack_pool,
+                           int fiber_priority) :
+      FiberEngineFactory(std::move(stack_pool), fiber_priority),
       m_pool(system_resources.make_fiber_pool(cpu_set))
     {}
     ~SingleUseFiberEngineFactory() final = default;
@@ -240,15 +263,19 @@ class SingleUseThreadEngineFactory final : public ThreadEngineFactory
 std::shared_ptr<::mrc::runnable::EngineFactory> make_engine_factory(const system::Resources& system_resources,
                                                                     EngineType engine_type,
                                                                     const CpuSet& cpu_set,
-                                                                    bool reusable)
+                                                                    bool reusable,
+                                                                    std::shared_ptr<FiberStackPool> stack_pool,
+                                                                    int fiber_priority)
 {
     if (engine_type == EngineType::Fiber)
     {
         if (reusable)
         {
-            return std::make_shared<ReusableFiberEngineFactory>(system_resources, cpu_set);
+            return std::make_shared<ReusableFiberEngineFactory>(
+            system_resources, cpu_set, std::move(stack_pool), fiber_priority);
         }
-        return std::make_shared<SingleUseFiberEngineFactory>(system_resources, cpu_set);
+        return std::make_shared<SingleUseFiberEngineFactory>(
+            system_resources, cpu_set, std::move(stack_pool), fiber_priority);
     }
 
     if (engine_type == EngineType::Thread)
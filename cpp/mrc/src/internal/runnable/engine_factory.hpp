@@ -20,10 +20,14 @@
 #include "internal/runnable/engines.hpp"
 #include "internal/system/resources.hpp"
 
+#include "mrc/constants.hpp"
 #include "mrc/core/bitmap.hpp"
 
 #include <memory>
 
+namespace mrc {
+class FiberStackPool;
+}  // namespace mrc
 namespace mrc::runnable {
 enum class EngineType;
 struct EngineFactory;
@@ -34,6 +38,8 @@ namespace mrc::internal::runnable {
 std::shared_ptr<::mrc::runnable::EngineFactory> make_engine_factory(const system::Resources& system,
                                                                     EngineType engine_type,
                                                                     const CpuSet& cpu_set,
-                                                                    bool reusable);
+                                                                    bool reusable,
+                                                                    std::shared_ptr<FiberStackPool> stack_pool,
+                                                                    int fiber_priority = MRC_DEFAULT_FIBER_PRIORITY);
 
 }  // namespace mrc::internal::runnable
@@ -70,6 +70,15 @@ FiberEngines::FiberEngines(mrc::runnable::LaunchOptions launch_options,
 {
     initialize_launchers();
 }
+FiberEngines::FiberEngines(mrc::runnable::LaunchOptions launch_options,
+                           std::vector<std::reference_wrapper<core::FiberTaskQueue>>&& task_queues,
+                           const FiberMetaData& meta) :
+  Engines(std::move(launch_options)),
+  m_task_queues(std::move(task_queues)),
+  m_meta(meta)
+{
+    initialize_launchers();
+}
 void FiberEngines::initialize_launchers()
 {
     CHECK_EQ(launch_options().pe_count, m_task_queues.size())
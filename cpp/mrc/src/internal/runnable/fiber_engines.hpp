@@ -53,6 +53,10 @@ class FiberEngines final : public Engines
                  std::vector<std::reference_wrapper<core::FiberTaskQueue>>&& task_queues,
                  int priority = MRC_DEFAULT_FIBER_PRIORITY);
 
+    FiberEngines(::mrc::runnable::LaunchOptions launch_options,
+                 std::vector<std::reference_wrapper<core::FiberTaskQueue>>&& task_queues,
+                 const FiberMetaData& meta);
+
     ~FiberEngines() final = default;
 
     EngineType engine_type() const final;
@@ -22,8 +22,15 @@
 #include "internal/system/engine_factory_cpu_sets.hpp"
 #include "internal/system/fiber_task_queue.hpp"
 #include "internal/system/host_partition.hpp"
+#include "internal/system/system.hpp"
 
+#include "mrc/constants.hpp"
 #include "mrc/core/bitmap.hpp"
+#include "mrc/core/fiber_stack_pool.hpp"
+#include "mrc/coroutines/thread_pool.hpp"
+#include "mrc/options/engine_groups.hpp"
+#include "mrc/options/fiber_pool.hpp"
+#include "mrc/options/options.hpp"
 #include "mrc/runnable/launch_control_config.hpp"
 #include "mrc/runnable/types.hpp"
 #include "mrc/types.hpp"
@@ -32,14 +39,49 @@
 #include <glog/logging.h>
 
 #include <map>
+#include <memory>
+#include <mutex>
 #include <ostream>
 #include <string>
 #include <utility>
 
 namespace mrc::internal::runnable {
 
+namespace {
+
+// each fiber engine group owns the pool of its fiber stacks; without pooling, only groups with their own stack size
+// get a pool, which then maps and unmaps a stack per fiber
+std::shared_ptr<FiberStackPool> make_stack_pool(const Options& options, const std::string& group_name)
+{
+    const auto& fiber_pool = options.fiber_pool();
+    const auto& groups     = options.engine_factories().map();
+
+    auto search          = groups.find(group_name);
+    std::size_t own_size = (search == groups.end() ? 0 : search->second.fiber_stack_size);
+
+    if (fiber_pool.stack_pool_capacity() == 0 && own_size == 0)
+    {
+        return nullptr;
+    }
+
+    return FiberStackPool::create((own_size > 0 ? own_size : fiber_pool.stack_size()),
+                                  fiber_pool.stack_pool_capacity(),
+                                  fiber_pool.enable_stack_protection(),
+                                  fiber_pool.enable_stack_prefault());
+}
+
+int fiber_priority(const Options& options, const std::string& group_name)
+{
+    const auto& groups = options.engine_factories().map();
+    auto search        = groups.find(group_name);
+    return (search == groups.end() ? MRC_DEFAULT_FIBER_PRIORITY : search->second.fiber_priority);
+}
+
+}  // namespace
+
 Resources::Resources(const system::Resources& system_resources, std::size_t _host_partition_id) :
   HostPartitionProvider(system_resources, _host_partition_id),
+  m_system_resources(system_resources),
   m_main(system_resources.get_task_queue(host_partition().engine_factory_cpu_sets().main_cpu_id()))
 {
     const auto& host_partition = this->host_partition();
@@ -52,14 +94,19 @@ Resources::Resources(const system::Resources& system_resources, std::size_t _hos
         .enqueue([this, &system_resources, &host_partition]() mutable {
             DVLOG(10) << "constructing engine factories on main for host partition " << host_partition.cpu_set().str();
             mrc::runnable::LaunchControlConfig config;
+            const auto& options = system_resources.system().options();
 
             for (const auto& [name, cpu_set] : host_partition.engine_factory_cpu_sets().fiber_cpu_sets)
             {
                 auto reusable = host_partition.engine_factory_cpu_sets().is_resuable(name);
                 DVLOG(10) << "fiber engine factory: " << name << " using " << cpu_set.str() << " is "
                           << (reusable ? "resuable" : "not reusable");
-                config.resource_groups[name] =
-                    runnable::make_engine_factory(system_resources, runnable::EngineType::Fiber, cpu_set, reusable);
+                config.resource_groups[name] = runnable::make_engine_factory(system_resources,
+                                                                             runnable::EngineType::Fiber,
+                                                                             cpu_set,
+                                                                             reusable,
+                                                                             make_stack_pool(options, name),
+                                                                             fiber_priority(options, name));
             }
 
             for (const auto& [name, cpu_set] : host_partition.engine_factory_cpu_sets().thread_cpu_sets)
@@ -67,8 +114,17 @@ Resources::Resources(const system::Resources& system_resources, std::size_t _hos
                 auto reusable = host_partition.engine_factory_cpu_sets().is_resuable(name);
                 DVLOG(10) << "thread engine factory: " << name << " using " << cpu_set.str() << " is "
                           << (reusable ? "resuable" : "not reusable");
-                config.resource_groups[name] =
-                    runnable::make_engine_factory(system_resources, runnable::EngineType::Thread, cpu_set, reusable);
+                config.resource_groups[name] = runnable::make_engine_factory(
+                    system_resources, runnable::EngineType::Thread, cpu_set, reusable, nullptr);
+            }
+
+            // engine groups serving a cost class, see LaunchOptions::cost_hints
+            for (const auto& [name, group] : options.engine_factories().map())
+            {
+                if (group.cost_class != mrc::runnable::CostClass::Unspecified && config.resource_groups.contains(name))
+                {
+                    config.cost_class_groups[group.cost_class].push_back(name);
+                }
             }
 
             // construct launch control
@@ -93,8 +149,40 @@ mrc::runnable::LaunchControl& Resources::launch_control()
     return *m_launch_control;
 }
 
+std::shared_ptr<coroutines::ThreadPool> Resources::coroutine_thread_pool()
+{
+    std::lock_guard<std::mutex> lock(*m_coroutine_mutex);
+    if (!m_coroutine_thread_pool)
+    {
+        // the executor threads share the logical cpus of the default engine group, keeping them off main and the
+        // network threads of the partition
+        const auto& cpu_sets = host_partition().engine_factory_cpu_sets();
+        const auto name      = default_engine_factory_name();
+
+        auto cpu_set = host_partition().cpu_set();
+        if (auto search = cpu_sets.fiber_cpu_sets.find(name); search != cpu_sets.fiber_cpu_sets.end())
+        {
+            cpu_set = search->second;
+        }
+        else if (auto search = cpu_sets.thread_cpu_sets.find(name); search != cpu_sets.thread_cpu_sets.end())
+        {
+            cpu_set = search->second;
+        }
+
+        DVLOG(10) << "creating the coroutine thread pool of host partition " << host_partition_id() << " on cpus "
+                  << cpu_set.str();
+        m_coroutine_thread_pool = m_system_resources.make_coroutine_thread_pool("coro", cpu_set);
+    }
+    return m_coroutine_thread_pool;
+}
+
 const mrc::core::FiberTaskQueue& Resources::main() const
 {
     return m_main;
 }
+
+const system::Resources& Resources::system_resources() const
+{
+    return m_system_resources;
+}
 }  // namespace mrc::internal::runnable
@@ -26,7 +26,11 @@
 
 #include <cstddef>
 #include <memory>
+#include <mutex>
 
+namespace mrc::coroutines {
+class ThreadPool;
+}  // namespace mrc::coroutines
 namespace mrc::internal::system {
 class FiberTaskQueue;
 }  // namespace mrc::internal::system
@@ -43,10 +47,17 @@ class Resources final : public system::HostPartitionProvider, public mrc::pipeli
     mrc::core::FiberTaskQueue& main() final;
     const mrc::core::FiberTaskQueue& main() const;
     mrc::runnable::LaunchControl& launch_control() final;
+    std::shared_ptr<coroutines::ThreadPool> coroutine_thread_pool() final;
+
+    // system resources used to create dedicated threads outside of the engine factories
+    const system::Resources& system_resources() const;
 
   private:
+    const system::Resources& m_system_resources;
     system::FiberTaskQueue& m_main;
     std::unique_ptr<mrc::runnable::LaunchControl> m_launch_control;
+    std::shared_ptr<coroutines::ThreadPool> m_coroutine_thread_pool;
+    std::unique_ptr<std::mutex> m_coroutine_mutex{std::make_unique<std::mutex>()};
 };
 
 }  // namespace mrc::internal::runnable
@@ -19,6 +19,9 @@
 
 #include "internal/codable/codable_storage.hpp"
 #include "internal/network/resources.hpp"
+#include "internal/pubsub/publisher_broadcast.hpp"
+#include "internal/pubsub/publisher_consistent_hash.hpp"
+#include "internal/pubsub/publisher_load_balanced.hpp"
 #include "internal/pubsub/publisher_round_robin.hpp"
 #include "internal/pubsub/subscriber_service.hpp"
 #include "internal/remote_descriptor/manager.hpp"
@@ -69,6 +72,32 @@ std::shared_ptr<mrc::pubsub::IPublisherService> Partition::make_publisher_servic
         return std::shared_ptr<pubsub::PublisherRoundRobin>(new pubsub::PublisherRoundRobin(name, *this));
     }
 
+    if (policy == mrc::pubsub::PublisherPolicy::Broadcast)
+    {
+        return std::shared_ptr<pubsub::PublisherBroadcast>(new pubsub::PublisherBroadcast(name, *this));
+    }
+
+    if (policy == mrc::pubsub::PublisherPolicy::ConsistentHash)
+    {
+        return std::shared_ptr<pubsub::PublisherConsistentHash>(new pubsub::PublisherConsistentHash(name, *this));
+    }
+
+    if (policy == mrc::pubsub::PublisherPolicy::LeastOutstanding)
+    {
+        return std::shared_ptr<pubsub::PublisherLeastOutstanding>(new pubsub::PublisherLeastOutstanding(name, *this));
+    }
+
+    if (policy == mrc::pubsub::PublisherPolicy::LocalityAware)
+    {
+        return std::shared_ptr<pubsub::PublisherLocalityAware>(new pubsub::PublisherLocalityAware(name, *this));
+    }
+
+    if (policy == mrc::pubsub::PublisherPolicy::PowerOfTwoChoices)
+    {
+        return std::shared_ptr<pubsub::PublisherPowerOfTwoChoices>(
+            new pubsub::PublisherPowerOfTwoChoices(name, *this));
+    }
+
     LOG(FATAL) << "PublisherPolicy not implemented";
     return nullptr;
 }
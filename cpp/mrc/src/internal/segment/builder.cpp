@@ -28,11 +28,13 @@
 #include "mrc/segment/egress_port.hpp"   // IWYU pragma: keep
 #include "mrc/segment/ingress_port.hpp"  // IWYU pragma: keep
 #include "mrc/segment/initializers.hpp"
+#include "mrc/segment/object.hpp"
 #include "mrc/types.hpp"
 
 #include <glog/logging.h>
 
 #include <ostream>
+#include <sstream>
 #include <utility>
 
 namespace mrc::internal::segment {
@@ -65,6 +67,9 @@ Builder::Builder(std::shared_ptr<const Definition> segdef,
 
     IBuilder builder(this);
     definition().initializer_fn()(builder);
+
+    select_ring_channels();
+    fuse_nodes();
 }
 
 const std::string& Builder::name() const
@@ -154,4 +159,189 @@ std::function<void(std::int64_t)> Builder::make_throughput_counter(const std::st
     auto counter = m_resources.metrics_registry().make_throughput_counter(name);
     return [counter](std::int64_t ticks) mutable { counter.increment(ticks); };
 }
+
+std::function<void(std::int64_t)> Builder::make_counter(const std::string& name,
+                                                        std::map<std::string, std::string> labels)
+{
+    auto counter = m_resources.metrics_registry().make_counter(name, std::move(labels));
+    return [counter](std::int64_t ticks) mutable { counter.increment(ticks); };
+}
+
+void Builder::enable_fusion(bool enabled)
+{
+    m_fusion_enabled = enabled;
+}
+
+bool Builder::fusion_enabled() const
+{
+    return m_fusion_enabled;
+}
+
+void Builder::add_fusion_candidate(std::shared_ptr<::mrc::segment::ObjectProperties> source,
+                                   std::shared_ptr<::mrc::segment::ObjectProperties> sink,
+                                   std::function<bool()> fuse_fn,
+                                   std::function<void()> edge_fn)
+{
+    CHECK(source && sink && fuse_fn && edge_fn);
+    for (const auto& candidate : m_fusion_candidates)
+    {
+        if (candidate.source == source)
+        {
+            LOG(ERROR) << "multiple edges from " << source->name() << " detected";
+            throw exceptions::MrcRuntimeError(
+                "multiple edges to a source detected; use an operator to select proper behavior");
+        }
+    }
+    m_fusion_candidates.push_back({std::move(source), std::move(sink), std::move(fuse_fn), std::move(edge_fn)});
+}
+
+void Builder::enable_ring_channels(bool enabled)
+{
+    m_ring_channels_enabled = enabled;
+}
+
+bool Builder::ring_channels_enabled() const
+{
+    return m_ring_channels_enabled;
+}
+
+void Builder::add_ring_channel_edge(std::shared_ptr<::mrc::segment::ObjectProperties> source,
+                                    std::shared_ptr<::mrc::segment::ObjectProperties> sink,
+                                    std::function<void(std::size_t, std::size_t)> select_fn,
+                                    std::function<void()> edge_fn)
+{
+    CHECK(source && sink && select_fn && edge_fn);
+    m_ring_channel_edges.push_back({std::move(source), std::move(sink), std::move(select_fn), std::move(edge_fn)});
+}
+
+void Builder::select_ring_channels()
+{
+    // number of engines which may access the channel concurrently; 0 if not known, e.g. for components and ports
+    auto concurrency = [](const ::mrc::segment::ObjectProperties& object) -> std::size_t {
+        if (!object.is_runnable())
+        {
+            return 0;
+        }
+        const auto& options = object.launch_options();
+        return options.pe_count * options.engines_per_pe;
+    };
+
+    // writers of each sink, including the upstream nodes of fusion candidates which may end up connected by an edge
+    std::map<const ::mrc::segment::ObjectProperties*, std::vector<const ::mrc::segment::ObjectProperties*>> upstream;
+    for (const auto& edge : m_ring_channel_edges)
+    {
+        upstream[edge.sink.get()].push_back(edge.source.get());
+    }
+    for (const auto& candidate : m_fusion_candidates)
+    {
+        auto search = upstream.find(candidate.sink.get());
+        if (search != upstream.end())
+        {
+            search->second.push_back(candidate.source.get());
+        }
+    }
+
+    for (const auto& edge : m_ring_channel_edges)
+    {
+        auto search = upstream.find(edge.sink.get());
+        if (search == upstream.end())
+        {
+            // the input of this sink has already been selected
+            continue;
+        }
+
+        std::size_t writers = 0;
+        for (const auto* source : search->second)
+        {
+            const auto count = concurrency(*source);
+            if (count == 0)
+            {
+                writers = 0;
+                break;
+            }
+            writers += count;
+        }
+
+        DVLOG(10) << "selecting the input channel of " << object_name(*edge.sink) << " for " << writers
+                  << " writers and " << concurrency(*edge.sink) << " readers";
+        edge.select_fn(writers, concurrency(*edge.sink));
+        upstream.erase(search);
+    }
+
+    for (auto& edge : m_ring_channel_edges)
+    {
+        edge.edge_fn();
+    }
+    m_ring_channel_edges.clear();
+}
+
+void Builder::fuse_nodes()
+{
+    // a node with more than one upstream candidate keeps its input channel
+    std::map<const ::mrc::segment::ObjectProperties*, std::size_t> upstream_counts;
+    for (const auto& candidate : m_fusion_candidates)
+    {
+        ++upstream_counts[candidate.sink.get()];
+    }
+
+    for (auto& candidate : m_fusion_candidates)
+    {
+        const auto& source_options = candidate.source->launch_options();
+        const auto& sink_options   = candidate.sink->launch_options();
+
+        bool fusable = upstream_counts[candidate.sink.get()] == 1 &&
+                       source_options.pe_count == sink_options.pe_count &&
+                       source_options.engines_per_pe == sink_options.engines_per_pe &&
+                       source_options.engine_factory_name == sink_options.engine_factory_name &&
+                       source_options.cost_hints.cost_class == sink_options.cost_hints.cost_class;
+
+        if (fusable && candidate.fuse_fn())
+        {
+            auto source_name = object_name(*candidate.source);
+            auto sink_name   = object_name(*candidate.sink);
+            DVLOG(10) << "fusing node " << sink_name << " into " << source_name;
+            m_nodes.erase(sink_name);
+            m_fused_downstream[source_name] = sink_name;
+        }
+        else
+        {
+            candidate.edge_fn();
+        }
+    }
+
+    m_fusion_candidates.clear();
+}
+
+std::string Builder::object_name(const ::mrc::segment::ObjectProperties& object) const
+{
+    for (const auto& [name, candidate] : m_objects)
+    {
+        if (candidate.get() == &object)
+        {
+            return name;
+        }
+    }
+    LOG(FATAL) << "object " << object.name() << " is not owned by segment " << this->name();
+    return {};
+}
+
+std::string Builder::fusion_description() const
+{
+    std::stringstream ss;
+    for (const auto& [name, node] : m_nodes)
+    {
+        auto search = m_fused_downstream.find(name);
+        if (search == m_fused_downstream.end())
+        {
+            continue;
+        }
+
+        ss << (ss.tellp() > 0 ? ", " : "") << name;
+        for (; search != m_fused_downstream.end(); search = m_fused_downstream.find(search->second))
+        {
+            ss << "+" << search->second;
+        }
+    }
+    return ss.str();
+}
 }  // namespace mrc::internal::segment
@@ -25,6 +25,7 @@
 #include <map>
 #include <memory>
 #include <string>
+#include <vector>
 
 namespace mrc::internal::pipeline {
 class Resources;
@@ -56,12 +57,31 @@ class Builder final
     const std::map<std::string, std::shared_ptr<mrc::segment::EgressPortBase>>& egress_ports() const;
     const std::map<std::string, std::shared_ptr<mrc::segment::IngressPortBase>>& ingress_ports() const;
 
-  private:
-    const std::string& name() const;
+    // chains of fused nodes, e.g. "a+b+c, d+e"; empty if no nodes were fused
+    std::string fusion_description() const;
 
     bool has_object(const std::string& name) const;
     ::mrc::segment::ObjectProperties& find_object(const std::string& name);
 
+  private:
+    struct FusionCandidate
+    {
+        std::shared_ptr<::mrc::segment::ObjectProperties> source;
+        std::shared_ptr<::mrc::segment::ObjectProperties> sink;
+        std::function<bool()> fuse_fn;
+        std::function<void()> edge_fn;
+    };
+
+    struct RingChannelEdge
+    {
+        std::shared_ptr<::mrc::segment::ObjectProperties> source;
+        std::shared_ptr<::mrc::segment::ObjectProperties> sink;
+        std::function<void(std::size_t, std::size_t)> select_fn;
+        std::function<void()> edge_fn;
+    };
+
+    const std::string& name() const;
+
     void add_object(const std::string& name, std::shared_ptr<::mrc::segment::ObjectProperties> object);
     void add_runnable(const std::string& name, std::shared_ptr<mrc::runnable::Launchable> runnable);
 
@@ -70,6 +90,28 @@ class Builder final
 
     // temporary metrics interface
     std::function<void(std::int64_t)> make_throughput_counter(const std::string& name);
+    std::function<void(std::int64_t)> make_counter(const std::string& name, std::map<std::string, std::string> labels);
+
+    void enable_fusion(bool enabled);
+    bool fusion_enabled() const;
+    void add_fusion_candidate(std::shared_ptr<::mrc::segment::ObjectProperties> source,
+                              std::shared_ptr<::mrc::segment::ObjectProperties> sink,
+                              std::function<bool()> fuse_fn,
+                              std::function<void()> edge_fn);
+
+    void enable_ring_channels(bool enabled);
+    bool ring_channels_enabled() const;
+    void add_ring_channel_edge(std::shared_ptr<::mrc::segment::ObjectProperties> source,
+                               std::shared_ptr<::mrc::segment::ObjectProperties> sink,
+                               std::function<void(std::size_t, std::size_t)> select_fn,
+                               std::function<void()> edge_fn);
+
+    // selects the input channel of the sinks of the deferred ring channel edges, then forms those edges
+    void select_ring_channels();
+
+    // fuses the eligible candidates once the segment has been initialized; the others are connected by an edge
+    void fuse_nodes();
+    std::string object_name(const ::mrc::segment::ObjectProperties& object) const;
 
     // definition
     std::shared_ptr<const Definition> m_definition;
@@ -84,6 +126,17 @@ class Builder final
     std::map<std::string, std::shared_ptr<::mrc::segment::IngressPortBase>> m_ingress_ports;
     std::map<std::string, std::shared_ptr<::mrc::segment::EgressPortBase>> m_egress_ports;
 
+    // edges between fusable nodes, deferred until the segment has been initialized
+    bool m_fusion_enabled{false};
+    std::vector<FusionCandidate> m_fusion_candidates;
+
+    // edges whose sink may be given a RingChannel, deferred until the segment has been initialized
+    bool m_ring_channels_enabled{false};
+    std::vector<RingChannelEdge> m_ring_channel_edges;
+
+    // name of the node fused into each node
+    std::map<std::string, std::string> m_fused_downstream;
+
     pipeline::Resources& m_resources;
     const std::size_t m_default_partition_id;
 
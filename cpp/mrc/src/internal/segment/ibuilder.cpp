@@ -80,4 +80,53 @@ std::function<void(std::int64_t)> IBuilder::make_throughput_counter(const std::s
     return m_impl->make_throughput_counter(name);
 }
 
+std::function<void(std::int64_t)> IBuilder::make_counter(const std::string& name,
+                                                         std::map<std::string, std::string> labels)
+{
+    CHECK(m_impl);
+    return m_impl->make_counter(name, std::move(labels));
+}
+
+void IBuilder::enable_fusion(bool enabled)
+{
+    CHECK(m_impl);
+    m_impl->enable_fusion(enabled);
+}
+
+bool IBuilder::fusion_enabled() const
+{
+    CHECK(m_impl);
+    return m_impl->fusion_enabled();
+}
+
+void IBuilder::add_fusion_candidate(std::shared_ptr<::mrc::segment::ObjectProperties> source,
+                                    std::shared_ptr<::mrc::segment::ObjectProperties> sink,
+                                    std::function<bool()> fuse_fn,
+                                    std::function<void()> edge_fn)
+{
+    CHECK(m_impl);
+    m_impl->add_fusion_candidate(std::move(source), std::move(sink), std::move(fuse_fn), std::move(edge_fn));
+}
+
+void IBuilder::enable_ring_channels(bool enabled)
+{
+    CHECK(m_impl);
+    m_impl->enable_ring_channels(enabled);
+}
+
+bool IBuilder::ring_channels_enabled() const
+{
+    CHECK(m_impl);
+    return m_impl->ring_channels_enabled();
+}
+
+void IBuilder::add_ring_channel_edge(std::shared_ptr<::mrc::segment::ObjectProperties> source,
+                                     std::shared_ptr<::mrc::segment::ObjectProperties> sink,
+                                     std::function<void(std::size_t, std::size_t)> select_fn,
+                                     std::function<void()> edge_fn)
+{
+    CHECK(m_impl);
+    m_impl->add_ring_channel_edge(std::move(source), std::move(sink), std::move(select_fn), std::move(edge_fn));
+}
+
 }  // namespace mrc::internal::segment
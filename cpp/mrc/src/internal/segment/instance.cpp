@@ -23,22 +23,35 @@
 #include "internal/runnable/resources.hpp"
 #include "internal/segment/builder.hpp"
 #include "internal/segment/definition.hpp"
+#include "internal/system/system.hpp"
 
+#include "mrc/channel/in_flight_budget.hpp"
+#include "mrc/channel/telemetry.hpp"
 #include "mrc/core/addresses.hpp"
+#include "mrc/core/fiber_meta_data.hpp"
 #include "mrc/core/task_queue.hpp"
 #include "mrc/exceptions/runtime_error.hpp"
 #include "mrc/manifold/interface.hpp"
+#include "mrc/memory/memory_tracker.hpp"
+#include "mrc/options/manifolds.hpp"
+#include "mrc/options/options.hpp"
+#include "mrc/options/quotas.hpp"
+#include "mrc/options/resources.hpp"
 #include "mrc/runnable/launchable.hpp"
 #include "mrc/runnable/launcher.hpp"
 #include "mrc/runnable/runner.hpp"
 #include "mrc/segment/egress_port.hpp"
 #include "mrc/segment/ingress_port.hpp"
+#include "mrc/segment/object.hpp"
 #include "mrc/segment/utils.hpp"
 #include "mrc/types.hpp"
 
 #include <boost/fiber/future/future.hpp>
 #include <glog/logging.h>
 
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
 #include <exception>
 #include <map>
 #include <memory>
@@ -47,6 +60,7 @@
 #include <string>
 #include <type_traits>
 #include <utility>
+#include <vector>
 
 namespace mrc::internal::segment {
 
@@ -71,6 +85,13 @@ Instance::Instance(std::shared_ptr<const Definition> definition,
                         return std::make_unique<Builder>(definition, rank, m_resources, m_default_partition_id);
                     })
                     .get();
+
+    auto fused = m_builder->fusion_description();
+    if (!fused.empty())
+    {
+        m_info += "[Fused: " + fused + "]";
+        DVLOG(10) << info() << " constructed with fused nodes";
+    }
 }
 
 Instance::~Instance() = default;
@@ -95,8 +116,59 @@ const SegmentAddress& Instance::address() const
     return m_address;
 }
 
+std::size_t Instance::partition_id() const
+{
+    return m_default_partition_id;
+}
+
+void Instance::apply_quotas()
+{
+    const auto& options = m_resources.resources().system().options();
+    const auto& quota   = options.quotas().segment_options(m_name);
+
+    if (quota.memory_bytes() > 0)
+    {
+        LOG_IF(WARNING, !options.resources().enable_memory_tracking())
+            << info() << " memory quota is ignored unless memory tracking is enabled";
+        memory::MemoryTracker::set_segment_quota(m_name, quota.memory_bytes());
+    }
+
+    std::shared_ptr<channel::InFlightBudget> budget;
+    if (quota.in_flight_bytes() > 0)
+    {
+        budget = std::make_shared<channel::InFlightBudget>(quota.in_flight_bytes());
+    }
+
+    if (quota.cpu_weight() == 0 && !budget)
+    {
+        return;
+    }
+
+    // the instances of a segment share a fiber share group; group 0 holds the unweighted fibers
+    const FiberShare share{quota.cpu_weight() == 0 ? 0U : static_cast<std::uint32_t>(m_id) + 1, quota.cpu_weight()};
+
+    for (const auto& [name, node] : m_builder->nodes())
+    {
+        if (!m_builder->has_object(name))
+        {
+            continue;
+        }
+        auto& launch_options = m_builder->find_object(name).launch_options();
+        if (quota.cpu_weight() > 0)
+        {
+            launch_options.fiber_share = share;
+        }
+        launch_options.in_flight_budget = budget;
+    }
+
+    DVLOG(10) << info() << " applied quotas; cpu_weight: " << quota.cpu_weight()
+              << "; in_flight_bytes: " << quota.in_flight_bytes() << "; memory_bytes: " << quota.memory_bytes();
+}
+
 void Instance::do_service_start()
 {
+    apply_quotas();
+
     // prepare launchers from m_builder
     std::map<std::string, std::unique_ptr<mrc::runnable::Launcher>> m_launchers;
     std::map<std::string, std::unique_ptr<mrc::runnable::Launcher>> m_egress_launchers;
@@ -267,6 +339,85 @@ void Instance::do_service_await_join()
     }
 }
 
+void Instance::stop_sources()
+{
+    for (const auto& [name, runner] : m_runners)
+    {
+        if (!m_builder->has_object(name))
+        {
+            continue;
+        }
+        const auto& object = m_builder->find_object(name);
+        if (object.is_source() && !object.is_sink())
+        {
+            DVLOG(10) << info() << " issuing stop for source " << name;
+            runner->stop();
+        }
+    }
+}
+
+DrainReport Instance::await_drain(std::chrono::milliseconds timeout)
+{
+    using clock_t = std::chrono::steady_clock;
+
+    // poll interval of the remaining runners, so progress is reported as runners complete in any order
+    constexpr std::chrono::milliseconds PollInterval{10};
+
+    DrainReport report;
+    const auto started  = clock_t::now();
+    const auto deadline = started + timeout;
+
+    std::vector<std::pair<std::string, mrc::runnable::Runner*>> pending;
+    for (const auto& runners : {&m_ingress_runners, &m_runners, &m_egress_runners})
+    {
+        for (const auto& [name, runner] : *runners)
+        {
+            pending.emplace_back(name, runner.get());
+        }
+    }
+
+    while (!pending.empty())
+    {
+        const auto now = clock_t::now();
+        if (now >= deadline)
+        {
+            break;
+        }
+        auto wait = std::min<clock_t::duration>(PollInterval, deadline - now);
+
+        for (auto it = pending.begin(); it != pending.end();)
+        {
+            if (it->second->await_join_for(std::chrono::duration_cast<std::chrono::milliseconds>(wait)))
+            {
+                auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(clock_t::now() - started);
+                DVLOG(10) << info() << " drained " << it->first << " after " << elapsed.count() << "ms; "
+                          << pending.size() - 1 << " runners remaining";
+                report.drained[it->first] = elapsed;
+                it                        = pending.erase(it);
+                continue;
+            }
+            // only the first pending runner waits; the others are probed until the next round
+            wait = std::chrono::milliseconds(0);
+            ++it;
+        }
+    }
+
+    if (!pending.empty())
+    {
+        std::string names;
+        for (const auto& [name, runner] : pending)
+        {
+            report.killed.push_back(name);
+            names += (names.empty() ? "" : ", ") + name;
+        }
+        LOG(WARNING) << info() << " drain deadline of " << timeout.count() << "ms exceeded; killing " << pending.size()
+                     << " runners which are still active: " << names;
+        service_kill();
+    }
+
+    return report;
+}
+
 void Instance::attach_manifold(std::shared_ptr<manifold::Interface> manifold)
 {
     auto port_name = manifold->port_name();
@@ -295,12 +446,35 @@ void Instance::attach_manifold(std::shared_ptr<manifold::Interface> manifold)
     throw exceptions::MrcRuntimeError("invalid manifold for segment");
 }
 
+bool Instance::has_ingress_ports() const
+{
+    return !m_builder->ingress_ports().empty();
+}
+
+channel::ChannelStatistics Instance::ingress_statistics() const
+{
+    channel::ChannelStatistics total;
+    for (const auto& [name, port] : m_builder->ingress_ports())
+    {
+        auto stats = port->ingress_statistics();
+        total.capacity += stats.capacity;
+        total.occupancy += stats.occupancy;
+        total.writes += stats.writes;
+        total.reads += stats.reads;
+        total.dropped += stats.dropped;
+        total.high_water_mark = std::max(total.high_water_mark, stats.high_water_mark);
+        total.blocked_writer_time += stats.blocked_writer_time;
+        total.blocked_reader_time += stats.blocked_reader_time;
+    }
+    return total;
+}
+
 const std::string& Instance::info() const
 {
     return m_info;
 }
 
-std::shared_ptr<manifold::Interface> Instance::create_manifold(const PortName& name)
+std::shared_ptr<manifold::Interface> Instance::create_manifold(const PortName& name, const ManifoldOptions& options)
 {
     std::lock_guard<decltype(m_mutex)> lock(m_mutex);
     DVLOG(10) << info() << " attempting to build manifold for port " << name;
@@ -308,14 +482,16 @@ std::shared_ptr<manifold::Interface> Instance::create_manifold(const PortName& n
         auto search = m_builder->egress_ports().find(name);
         if (search != m_builder->egress_ports().end())
         {
-            return search->second->make_manifold(m_resources.resources().partition(m_default_partition_id).runnable());
+            return search->second->make_manifold(m_resources.resources().partition(m_default_partition_id).runnable(),
+                                                 options);
         }
     }
     {
         auto search = m_builder->ingress_ports().find(name);
         if (search != m_builder->ingress_ports().end())
         {
-            return search->second->make_manifold(m_resources.resources().partition(m_default_partition_id).runnable());
+            return search->second->make_manifold(m_resources.resources().partition(m_default_partition_id).runnable(),
+                                                 options);
         }
     }
     LOG(FATAL) << info() << " unable to match ingress or egress port name";
@@ -19,15 +19,21 @@
 
 #include "internal/service.hpp"
 
+#include "mrc/channel/telemetry.hpp"
 #include "mrc/runnable/runner.hpp"
 #include "mrc/types.hpp"
 
+#include <chrono>
 #include <cstddef>
 #include <map>
 #include <memory>
 #include <mutex>
 #include <string>
+#include <vector>
 
+namespace mrc {
+class ManifoldOptions;
+}  // namespace mrc
 namespace mrc::internal::pipeline {
 class Resources;
 }  // namespace mrc::internal::pipeline
@@ -39,6 +45,18 @@ namespace mrc::internal::segment {
 class Definition;
 class Builder;
 
+// outcome of a bounded drain: the time each runner took to complete and the runners killed at the deadline
+struct DrainReport
+{
+    std::map<std::string, std::chrono::milliseconds> drained;
+    std::vector<std::string> killed;
+
+    bool complete() const
+    {
+        return killed.empty();
+    }
+};
+
 // todo(ryan) - inherit from service
 class Instance final : public Service
 {
@@ -54,9 +72,23 @@ class Instance final : public Service
     const SegmentRank& rank() const;
     const SegmentAddress& address() const;
 
-    std::shared_ptr<manifold::Interface> create_manifold(const PortName& name);
+    // resource partition the segment was constructed on
+    std::size_t partition_id() const;
+
+    std::shared_ptr<manifold::Interface> create_manifold(const PortName& name, const ManifoldOptions& options);
     void attach_manifold(std::shared_ptr<manifold::Interface> manifold);
 
+    bool has_ingress_ports() const;
+
+    // combined occupancy and reads of the ingress port channels
+    channel::ChannelStatistics ingress_statistics() const;
+
+    // stops the runners of the nodes which are pure sources; downstream nodes complete once their inputs are flushed
+    void stop_sources();
+
+    // awaits the completion of every runner until timeout, then kills the segment if any runner is still active
+    DrainReport await_drain(std::chrono::milliseconds timeout);
+
   protected:
     const std::string& info() const;
 
@@ -67,6 +99,10 @@ class Instance final : public Service
     void do_service_kill() final;
     void do_service_await_join() final;
 
+    // sets the fiber share and in-flight budget of the nodes and the memory quota of the segment from its
+    // SegmentQuotaOptions
+    void apply_quotas();
+
     void callback_on_state_change(const std::string& name, const mrc::runnable::Runner::State& new_state);
 
     std::string m_name;
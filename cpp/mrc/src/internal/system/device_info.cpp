@@ -202,6 +202,30 @@ std::string DeviceInfo::PCIeBusID(int device_id)
     return info.busId;
 }
 
+std::vector<std::string> DeviceInfo::NvLinkPeers(int device_id)
+{
+    std::vector<std::string> peers;
+    auto* device = DeviceInfo::GetHandleById(device_id);
+
+    for (unsigned int link = 0; link < NVML_NVLINK_MAX_LINKS; ++link)
+    {
+        nvmlEnableState_t is_active;
+        // devices without nvlink report the links as not supported
+        if (nvmlDeviceGetNvLinkState(device, link, &is_active) != NVML_SUCCESS || is_active != NVML_FEATURE_ENABLED)
+        {
+            continue;
+        }
+
+        nvmlPciInfo_t remote;
+        if (nvmlDeviceGetNvLinkRemotePciInfo_v2(device, link, &remote) == NVML_SUCCESS)
+        {
+            peers.emplace_back(remote.busId);
+        }
+    }
+
+    return peers;
+}
+
 std::size_t DeviceInfo::AccessibleDevices()
 {
     return NvmlState::instance().accessible_nvml_device_indexes().size();
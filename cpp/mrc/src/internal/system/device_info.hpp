@@ -22,6 +22,7 @@
 #include <cstddef>
 #include <set>
 #include <string>
+#include <vector>
 
 namespace mrc::internal::system {
 
@@ -29,16 +30,17 @@ struct DeviceInfo
 {
     static nvmlDevice_t GetHandleById(unsigned int device_id);  // NOLINT
     // static auto Affinity(int device_id) -> cpu_set;
-    static auto Alignment() -> std::size_t;                           // NOLINT
-    static auto EnergyConsumption(int device_id) -> double;           // NOLINT
-    static auto MemoryInfo(int device_id) -> nvmlMemory_t;            // NOLINT
-    static auto PowerUsage(int device_id) -> double;                  // NOLINT
-    static auto PowerLimit(int device_id) -> double;                  // NOLINT
-    static auto UUID(int device_id) -> std::string;                   // NOLINT
-    static auto PCIeBusID(int device_id) -> std::string;              // NOLINT
-    static auto Name(int) -> std::string;                             // NOLINT
-    static auto AccessibleDeviceIndexes() -> std::set<unsigned int>;  // NOLINT
-    static auto AccessibleDevices() -> std::size_t;                   // NOLINT
+    static auto Alignment() -> std::size_t;                              // NOLINT
+    static auto EnergyConsumption(int device_id) -> double;              // NOLINT
+    static auto MemoryInfo(int device_id) -> nvmlMemory_t;               // NOLINT
+    static auto PowerUsage(int device_id) -> double;                     // NOLINT
+    static auto PowerLimit(int device_id) -> double;                     // NOLINT
+    static auto UUID(int device_id) -> std::string;                      // NOLINT
+    static auto PCIeBusID(int device_id) -> std::string;                 // NOLINT
+    static auto NvLinkPeers(int device_id) -> std::vector<std::string>;  // NOLINT
+    static auto Name(int) -> std::string;                                // NOLINT
+    static auto AccessibleDeviceIndexes() -> std::set<unsigned int>;     // NOLINT
+    static auto AccessibleDevices() -> std::size_t;                      // NOLINT
 };
 
 }  // namespace mrc::internal::system
@@ -50,6 +50,11 @@ const std::string& DevicePartition::pcie_bus_id() const
 {
     return GpuInfo::pcie_bus_id();
 }
+
+const std::vector<std::string>& DevicePartition::nics() const
+{
+    return GpuInfo::nics();
+}
 const HostPartition& DevicePartition::host() const
 {
     CHECK(m_host_partition);
@@ -22,6 +22,7 @@
 #include <cstddef>
 #include <memory>
 #include <string>
+#include <vector>
 
 namespace mrc::internal::system {
 class HostPartition;
@@ -38,6 +39,7 @@ class DevicePartition final : private GpuInfo
     const std::string& name() const;
     const std::string& uuid() const;
     const std::string& pcie_bus_id() const;
+    const std::vector<std::string>& nics() const;
 
     const HostPartition& host() const;
 
@@ -22,6 +22,7 @@
 #include "mrc/core/bitmap.hpp"
 #include "mrc/exceptions/runtime_error.hpp"
 #include "mrc/options/engine_groups.hpp"
+#include "mrc/options/network.hpp"
 #include "mrc/options/options.hpp"
 #include "mrc/runnable/types.hpp"
 
@@ -30,7 +31,11 @@
 
 #include <algorithm>
 #include <cstddef>
+#include <cstdint>
+#include <map>
+#include <optional>
 #include <ostream>
+#include <string>
 #include <utility>
 
 namespace mrc::internal::system {
@@ -42,9 +47,105 @@ bool EngineFactoryCpuSets::is_resuable(const std::string& name) const
     return search->second;
 }
 
+// logical cpus of the topology an engine group may be placed on
+static CpuSet group_local_cpu_set(const Topology& topology, const std::string& name, const EngineFactoryOptions& group)
+{
+    CpuSet local_cpu_set = topology.cpu_set();
+
+    if (group.numa_node >= 0)
+    {
+        if (group.numa_node >= topology.numa_count())
+        {
+            LOG(ERROR) << "engine group `" << name << "` requested numa node " << group.numa_node << "; only "
+                       << topology.numa_count() << " numa nodes detected";
+            throw exceptions::MrcRuntimeError("engine group requested an invalid numa node");
+        }
+        local_cpu_set = local_cpu_set.set_intersect(topology.numa_cpuset(group.numa_node));
+    }
+
+    if (group.gpu_id >= 0)
+    {
+        auto search = topology.gpu_info().find(group.gpu_id);
+        if (search == topology.gpu_info().end())
+        {
+            LOG(ERROR) << "engine group `" << name << "` requested gpu " << group.gpu_id
+                       << " which is not part of the topology";
+            throw exceptions::MrcRuntimeError("engine group requested an invalid gpu");
+        }
+        local_cpu_set = local_cpu_set.set_intersect(search->second.cpu_set());
+    }
+
+    if (group.cache_domain >= 0)
+    {
+        if (group.cache_domain >= topology.cache_domain_count())
+        {
+            LOG(ERROR) << "engine group `" << name << "` requested cache domain " << group.cache_domain << "; only "
+                       << topology.cache_domain_count() << " cache domains detected";
+            throw exceptions::MrcRuntimeError("engine group requested an invalid cache domain");
+        }
+        local_cpu_set = local_cpu_set.set_intersect(topology.cache_domain_cpuset(group.cache_domain));
+    }
+
+    return local_cpu_set;
+}
+
+static bool is_pinned(const EngineFactoryOptions& group)
+{
+    return (group.numa_node >= 0 || group.gpu_id >= 0 || group.cache_domain >= 0);
+}
+
+// pops count logical cpus from remaining_cpu_set, taken from the cache domain with the fewest free cpus which can hold
+// all of them so that the engines of a group share their last-level cache and larger domains stay free for larger
+// groups; if no cache domain has count free cpus, the lowest free cpus are taken
+static CpuSet pop_cache_local_cpu_set(const Topology& topology, std::size_t count, CpuSet& remaining_cpu_set)
+{
+    int best_domain       = -1;
+    std::size_t best_free = 0;
+
+    for (int i = 0; i < topology.cache_domain_count(); i++)
+    {
+        std::size_t free = remaining_cpu_set.set_intersect(topology.cache_domain_cpuset(i)).weight();
+        if (free >= count && (best_domain == -1 || free < best_free))
+        {
+            best_domain = i;
+            best_free   = free;
+        }
+    }
+
+    if (best_domain == -1)
+    {
+        return remaining_cpu_set.pop(count);
+    }
+
+    CpuSet candidates = remaining_cpu_set.set_intersect(topology.cache_domain_cpuset(best_domain));
+    CpuSet this_set   = candidates.pop(count);
+    this_set.for_each_bit([&remaining_cpu_set](std::uint32_t idx, std::uint32_t bit) { remaining_cpu_set.off(bit); });
+    return this_set;
+}
+
+// pops count logical cpus local to the group from remaining_cpu_set
+static CpuSet pop_pinned_cpu_set(const Topology& topology,
+                                 const std::string& name,
+                                 const EngineFactoryOptions& group,
+                                 CpuSet& remaining_cpu_set)
+{
+    CpuSet candidates = remaining_cpu_set.set_intersect(group_local_cpu_set(topology, name, group));
+    if (candidates.weight() < group.cpu_count)
+    {
+        LOG(ERROR) << "engine group `" << name << "` requires " << group.cpu_count << " logical cpus local to its "
+                   << "numa node/gpu/cache domain; only " << candidates.weight() << " available: " << candidates;
+        throw exceptions::MrcRuntimeError("insufficient number of logical cpus local to the engine group placement");
+    }
+
+    CpuSet this_set = candidates.pop(group.cpu_count);
+    this_set.for_each_bit([&remaining_cpu_set](std::uint32_t idx, std::uint32_t bit) { remaining_cpu_set.off(bit); });
+    return this_set;
+}
+
 EngineFactoryCpuSets generate_engine_factory_cpu_sets(const Topology& topology,
                                                       const Options& options,
-                                                      const CpuSet& cpu_set)
+                                                      const CpuSet& cpu_set,
+                                                      const std::optional<CpuSet>& network_cpu_set)
 {
     CpuSet pe_set;
     EngineFactoryCpuSets config;
@@ -80,8 +181,10 @@ EngineFactoryCpuSets generate_engine_factory_cpu_sets(const Topology& topology,
     auto engine_groups_map = options.engine_factories().map();
 
     const bool specialized_main = options.engine_factories().dedicated_main_thread();
+    // a network thread shared with another host partition takes no logical cpu of this partition
+    const bool shared_network = !options.architect_url().empty() && network_cpu_set.has_value();
     const bool specialized_network =
-        !options.architect_url().empty() && options.engine_factories().dedicated_network_thread();
+        !options.architect_url().empty() && options.engine_factories().dedicated_network_thread() && !shared_network;
 
     if (specialized_main)
     {
@@ -97,9 +200,10 @@ EngineFactoryCpuSets generate_engine_factory_cpu_sets(const Topology& topology,
 
     if (specialized_network)
     {
+        // one network thread per ucx worker of the partition
         EngineFactoryOptions net;
         net.engine_type                  = runnable::EngineType::Fiber;
-        net.cpu_count                    = 1;
+        net.cpu_count                    = std::max<std::size_t>(1, options.network().workers_per_partition());
         net.allow_overlap                = false;
         net.reusable                     = true;
         engine_groups_map["mrc_network"] = std::move(net);
@@ -153,7 +257,19 @@ EngineFactoryCpuSets generate_engine_factory_cpu_sets(const Topology& topology,
     // the remaining logical cpus will be reserved for thread pools or thread runnables
 
     DVLOG(10) << "allocating logical cpus for `" << default_engine_factory_name() << "`` pool";
-    auto remaining_cpu_set             = pe_set;
+    auto remaining_cpu_set = pe_set;
+
+    // non-overlapping groups pinned to a numa node, gpu or cache domain reserve their logical cpus before the default
+    // pool is allocated so that the default pool can not take them
+    std::map<std::string, CpuSet> pinned_cpu_sets;
+    for (const auto& kv : engine_groups_map)
+    {
+        if (!kv.second.allow_overlap && is_pinned(kv.second))
+        {
+            pinned_cpu_sets[kv.first] = pop_pinned_cpu_set(topology, kv.first, kv.second, remaining_cpu_set);
+        }
+    }
+
     std::size_t default_pool_cpu_count = cpu_count - min_cpu_count;
     auto default_pool_cpu_set          = remaining_cpu_set.pop(default_pool_cpu_count);
     if (options.engine_factories().default_engine_type() == runnable::EngineType::Fiber)
@@ -184,8 +300,14 @@ EngineFactoryCpuSets generate_engine_factory_cpu_sets(const Topology& topology,
     config.reusable[default_engine_factory_name()] = true;
     config.reusable["main"]                        = true;
 
+    if (shared_network)
+    {
+        config.fiber_cpu_sets["mrc_network"] = *network_cpu_set;
+        config.reusable["mrc_network"]       = true;
+        DVLOG(10) << "- cpu_set for shared `mrc_network`: " << config.fiber_cpu_sets["mrc_network"];
+    }
     // if we are not using a dedicated network thread, use the same fiber queue as main for mrc_network
-    if (!options.architect_url().empty() && !specialized_network)
+    else if (!options.architect_url().empty() && !specialized_network)
     {
         config.fiber_cpu_sets["mrc_network"] = config.fiber_cpu_sets.at("main");
         config.reusable["mrc_network"]       = true;
@@ -200,7 +322,9 @@ EngineFactoryCpuSets generate_engine_factory_cpu_sets(const Topology& topology,
 
         if (!kv.second.allow_overlap)
         {
-            auto this_set = remaining_cpu_set.pop(kv.second.cpu_count);
+            auto this_set = (is_pinned(kv.second)
+                                 ? pinned_cpu_sets.at(kv.first)
+                                 : pop_cache_local_cpu_set(topology, kv.second.cpu_count, remaining_cpu_set));
             DVLOG(10) << "- cpu_set for non-overlapping `" << kv.first << "` pool: " << this_set;
             if (kv.second.engine_type == runnable::EngineType::Fiber)
             {
@@ -223,15 +347,41 @@ EngineFactoryCpuSets generate_engine_factory_cpu_sets(const Topology& topology,
         {
             CpuSet this_set;
 
-            for (int i = 0; i < kv.second.cpu_count; ++i)
+            if (is_pinned(kv.second))
             {
-                // allow round robin distribution
-                do
+                // round robin over the shared cpus local to the group
+                CpuSet local_cpu_set =
+                    remaining_cpu_set.set_intersect(group_local_cpu_set(topology, kv.first, kv.second));
+                if (local_cpu_set.empty())
+                {
+                    LOG(ERROR) << "no shared logical cpus are local to the numa node/gpu/cache domain of engine group `"
+                               << kv.first << "`";
+                    throw exceptions::MrcRuntimeError("no shared logical cpus local to the engine group placement");
+                }
+
+                int local_idx = -1;
+                for (int i = 0; i < kv.second.cpu_count; ++i)
                 {
-                    idx = remaining_cpu_set.next(idx);
-                } while (idx == -1);
+                    do
+                    {
+                        local_idx = local_cpu_set.next(local_idx);
+                    } while (local_idx == -1);
 
-                this_set.on(idx);
+                    this_set.on(local_idx);
+                }
+            }
+            else
+            {
+                for (int i = 0; i < kv.second.cpu_count; ++i)
+                {
+                    // allow round robin distribution
+                    do
+                    {
+                        idx = remaining_cpu_set.next(idx);
+                    } while (idx == -1);
+
+                    this_set.on(idx);
+                }
             }
 
             DVLOG(10) << "- cpu_set for overlapping `" << kv.first << "` pool: " << this_set;
@@ -21,6 +21,7 @@
 
 #include <cstddef>
 #include <map>
+#include <optional>
 #include <string>
 
 namespace mrc {
@@ -52,10 +53,14 @@ struct EngineFactoryCpuSets
  *
  * @param options
  * @param cpu_set
+ * @param network_cpu_set logical cpu of a network thread reserved by another host partition; if set, it is used for
+ * `mrc_network` instead of reserving a logical cpu of cpu_set
  * @return LaunchControlPlacementCpuSets
  */
-extern EngineFactoryCpuSets generate_engine_factory_cpu_sets(const Topology& topology,
-                                                             const Options& options,
-                                                             const CpuSet& cpu_set);
+extern EngineFactoryCpuSets generate_engine_factory_cpu_sets(
+    const Topology& topology,
+    const Options& options,
+    const CpuSet& cpu_set,
+    const std::optional<CpuSet>& network_cpu_set = std::nullopt);
 
 }  // namespace mrc::internal::system
@@ -18,6 +18,8 @@
 #include "internal/system/fiber_manager.hpp"
 
 #include "internal/system/fiber_pool.hpp"
+#include "internal/system/fiber_priority_scheduler.hpp"
+#include "internal/system/partitions.hpp"
 #include "internal/system/resources.hpp"
 #include "internal/system/system.hpp"
 #include "internal/system/topology.hpp"
@@ -28,6 +30,7 @@
 #include "mrc/options/options.hpp"
 
 #include <functional>
+#include <map>
 #include <memory>
 
 namespace mrc::internal::system {
@@ -41,10 +44,26 @@ FiberManager::FiberManager(const Resources& resources) : m_cpu_set(resources.sys
     VLOG(1) << "creating fiber task queues on " << cpu_count << " threads";
     VLOG(1) << "thread_binding : " << (options.fiber_pool().enable_thread_binding() ? " TRUE" : "FALSE");
     VLOG(1) << "memory_binding : " << (options.fiber_pool().enable_memory_binding() ? " TRUE" : "FALSE");
+    VLOG(1) << "work_stealing  : " << (options.fiber_pool().enable_work_stealing() ? " TRUE" : "FALSE");
+    VLOG(1) << "futex_wakeup   : " << (options.fiber_pool().enable_futex_wakeup() ? " TRUE" : "FALSE");
+
+    // fibers may only be stolen by threads of the same host partition
+    std::map<std::uint32_t, std::shared_ptr<FiberStealingGroup>> stealing_groups;
+    if (options.fiber_pool().enable_work_stealing())
+    {
+        for (const auto& host_partition : resources.system().partitions().host_partitions())
+        {
+            auto group = std::make_shared<FiberStealingGroup>();
+            host_partition.cpu_set().for_each_bit(
+                [&](std::int32_t idx, std::int32_t cpu_id) { stealing_groups[cpu_id] = group; });
+        }
+    }
 
     topology.cpu_set().for_each_bit([&](std::int32_t idx, std::int32_t cpu_id) {
         DVLOG(10) << "initializing fiber queue " << idx << " of " << cpu_count << " on cpu_id " << cpu_id;
-        m_queues[cpu_id] = std::make_unique<FiberTaskQueue>(resources, cpu_id);
+        auto group       = stealing_groups.find(cpu_id);
+        m_queues[cpu_id] = std::make_unique<FiberTaskQueue>(
+            resources, cpu_id, 64, (group != stealing_groups.end() ? group->second : nullptr));
     });
 }
 
@@ -0,0 +1,354 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "internal/system/fiber_priority_scheduler.hpp"
+
+#include "mrc/benchmarking/flight_recorder.hpp"
+#include "mrc/core/time_slice.hpp"
+
+#include <boost/fiber/context.hpp>
+#include <boost/fiber/type.hpp>
+
+#include <algorithm>
+#include <utility>
+
+namespace mrc::internal::system {
+
+boost::fibers::context* FiberStealingGroup::steal(const FiberPriorityScheduler* thief)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    FiberPriorityScheduler* victim = nullptr;
+    std::size_t victim_load        = 0;
+    for (auto* scheduler : m_schedulers)
+    {
+        auto load = scheduler->ready_count();
+        if (scheduler != thief && load > victim_load)
+        {
+            victim      = scheduler;
+            victim_load = load;
+        }
+    }
+
+    if (victim == nullptr)
+    {
+        return nullptr;
+    }
+
+    auto* ctx = victim->steal();
+    if (ctx != nullptr)
+    {
+        m_steal_count.fetch_add(1, std::memory_order_relaxed);
+    }
+    return ctx;
+}
+
+void FiberStealingGroup::wake_one(const FiberPriorityScheduler* caller)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    for (auto* scheduler : m_schedulers)
+    {
+        if (scheduler != caller && scheduler->m_sleeping.load(std::memory_order_relaxed))
+        {
+            scheduler->notify();
+            return;
+        }
+    }
+}
+
+void FiberStealingGroup::register_scheduler(FiberPriorityScheduler* scheduler)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_schedulers.push_back(scheduler);
+}
+
+void FiberStealingGroup::unregister_scheduler(FiberPriorityScheduler* scheduler)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_schedulers.erase(std::remove(m_schedulers.begin(), m_schedulers.end(), scheduler), m_schedulers.end());
+}
+
+FiberPriorityScheduler::FiberPriorityScheduler(std::shared_ptr<FiberStealingGroup> group,
+                                               FiberSuspendOptions suspend,
+                                               bool tracing) :
+  m_group(std::move(group)),
+  m_last_level(m_levels.end())
+{
+    if (tracing)
+    {
+        m_trace_buffer = benchmarking::FiberTracer::make_thread_buffer();
+    }
+
+    if (suspend.futex)
+    {
+        m_futex.emplace(suspend.spin_count);
+    }
+
+    if (m_group)
+    {
+        m_group->register_scheduler(this);
+    }
+}
+
+FiberPriorityScheduler::~FiberPriorityScheduler()
+{
+    if (m_group)
+    {
+        m_group->unregister_scheduler(this);
+    }
+}
+
+void FiberPriorityScheduler::awakened(boost::fibers::context* ctx, FiberPriorityProps& props) noexcept
+{
+    // a ready fiber is detached from this thread so that it may be attached to a thief's thread
+    if (m_group && !ctx->is_context(boost::fibers::type::pinned_context))
+    {
+        ctx->detach();
+    }
+
+    if (m_trace_buffer)
+    {
+        props.trace().on_ready(benchmarking::FiberTracer::clock_t::now());
+    }
+
+    {
+        auto lock = lock_queue();
+        push_locked(ctx, props.get_priority(), props.get_share());
+    }
+
+    if (m_group && ready_count() > 1 && m_group->sleepers() > 0)
+    {
+        m_group->wake_one(this);
+    }
+}
+
+boost::fibers::context* FiberPriorityScheduler::pick_next() noexcept
+{
+    boost::fibers::context* ctx = nullptr;
+    {
+        auto lock = lock_queue();
+        ctx       = pop_locked();
+    }
+
+    if (m_group)
+    {
+        if (ctx == nullptr)
+        {
+            ctx = m_group->steal(this);
+        }
+        if (ctx != nullptr && !ctx->is_context(boost::fibers::type::pinned_context))
+        {
+            boost::fibers::context::active()->attach(ctx);
+        }
+    }
+
+    if (m_trace_buffer)
+    {
+        trace_switch(ctx);
+    }
+    if (ctx != nullptr)
+    {
+        benchmarking::FlightRecorder::record(benchmarking::FlightEventType::FiberSwitch,
+                                             reinterpret_cast<std::uintptr_t>(ctx));
+        TimeSlice::begin(properties(ctx).get_time_slice());
+    }
+
+    return ctx;
+}
+
+bool FiberPriorityScheduler::has_ready_fibers() const noexcept
+{
+    return ready_count() > 0;
+}
+
+void FiberPriorityScheduler::property_change(boost::fibers::context* ctx, FiberPriorityProps& props) noexcept
+{
+    auto lock = lock_queue();
+
+    // 'ctx' might not be in our queue at all, if caller is changing the
+    // priority of (say) the running fiber. If it's not there, no need to
+    // move it: we'll handle it next time it hits awakened().
+    if (!ctx->ready_is_linked())
+    {
+        return;
+    }
+
+    // requeue at the end of its new priority level and share group; the context is already detached if work stealing
+    // is enabled
+    ctx->ready_unlink();
+    m_ready_count.store(ready_count() - 1, std::memory_order_relaxed);
+    push_locked(ctx, props.get_priority(), props.get_share());
+}
+
+void FiberPriorityScheduler::suspend_until(std::chrono::steady_clock::time_point const& time_point) noexcept
+{
+    if (m_group)
+    {
+        m_sleeping.store(true, std::memory_order_relaxed);
+        m_group->m_sleepers.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    if (m_futex)
+    {
+        m_futex->wait_until(time_point);
+    }
+    else if ((std::chrono::steady_clock::time_point::max)() == time_point)
+    {
+        std::unique_lock<std::mutex> lk(m_mtx);
+        m_cnd.wait(lk, [this]() { return m_flag; });
+        m_flag = false;
+    }
+    else
+    {
+        std::unique_lock<std::mutex> lk(m_mtx);
+        m_cnd.wait_until(lk, time_point, [this]() { return m_flag; });
+        m_flag = false;
+    }
+
+    if (m_group)
+    {
+        m_group->m_sleepers.fetch_sub(1, std::memory_order_relaxed);
+        m_sleeping.store(false, std::memory_order_relaxed);
+    }
+}
+
+void FiberPriorityScheduler::notify() noexcept
+{
+    if (m_futex)
+    {
+        m_futex->notify();
+        return;
+    }
+
+    std::unique_lock<std::mutex> lk(m_mtx);
+    m_flag = true;
+    lk.unlock();
+    m_cnd.notify_all();
+}
+
+std::unique_lock<std::mutex> FiberPriorityScheduler::lock_queue() const
+{
+    if (m_group)
+    {
+        return std::unique_lock<std::mutex>(m_queue_mutex);
+    }
+    return {};
+}
+
+void FiberPriorityScheduler::push_locked(boost::fibers::context* ctx, int priority, const FiberShare& share)
+{
+    // consecutive wakeups overwhelmingly share a priority level, e.g. MRC_DEFAULT_FIBER_PRIORITY
+    if (m_last_level == m_levels.end() || m_last_level->first != priority)
+    {
+        m_last_level = m_levels.try_emplace(priority).first;
+    }
+
+    auto& level = m_last_level->second;
+    auto& group = level.groups.try_emplace(share.group).first->second;
+    if (group.queue.empty())
+    {
+        group.pass = std::max(group.pass, level.virtual_time);
+    }
+    group.weight = std::clamp<std::uint32_t>(share.weight, 1, ShareStride);
+    group.queue.push_back(*ctx);
+    m_ready_count.store(ready_count() + 1, std::memory_order_relaxed);
+}
+
+boost::fibers::context* FiberPriorityScheduler::pop_locked()
+{
+    if (ready_count() == 0)
+    {
+        return nullptr;
+    }
+
+    for (auto& [priority, level] : m_levels)
+    {
+        ShareQueue* next = nullptr;
+        for (auto& [id, group] : level.groups)
+        {
+            if (!group.queue.empty() && (next == nullptr || group.pass < next->pass))
+            {
+                next = &group;
+            }
+        }
+        if (next == nullptr)
+        {
+            continue;
+        }
+
+        boost::fibers::context* ctx(&next->queue.front());
+        next->queue.pop_front();
+        m_ready_count.store(ready_count() - 1, std::memory_order_relaxed);
+
+        // a level holding only the unweighted group is served in plain FIFO order
+        if (level.groups.size() > 1)
+        {
+            level.virtual_time = next->pass;
+            next->pass += ShareStride / next->weight;
+        }
+        return ctx;
+    }
+
+    return nullptr;
+}
+
+boost::fibers::context* FiberPriorityScheduler::steal()
+{
+    auto lock = lock_queue();
+
+    // take the most recently readied fiber of the highest priority level so the victim's next fiber is unchanged
+    for (auto& [priority, level] : m_levels)
+    {
+        for (auto& [id, group] : level.groups)
+        {
+            auto& queue = group.queue;
+            for (auto it = queue.rbegin(); it != queue.rend(); ++it)
+            {
+                if (!it->is_context(boost::fibers::type::pinned_context))
+                {
+                    boost::fibers::context* ctx(&*it);
+                    queue.erase(queue.iterator_to(*ctx));
+                    m_ready_count.store(ready_count() - 1, std::memory_order_relaxed);
+                    return ctx;
+                }
+            }
+        }
+    }
+
+    return nullptr;
+}
+
+void FiberPriorityScheduler::trace_switch(boost::fibers::context* next)
+{
+    // the active context is about to be switched out; the dispatcher context has no properties and is not traced
+    auto now    = benchmarking::FiberTracer::clock_t::now();
+    auto cpu    = benchmarking::FiberTracer::thread_cpu_time();
+    auto* props = static_cast<FiberPriorityProps*>(boost::fibers::context::active()->get_properties());
+    if (props != nullptr)
+    {
+        props->trace().on_stopped(now, cpu, *m_trace_buffer);
+    }
+
+    props = (next != nullptr ? static_cast<FiberPriorityProps*>(next->get_properties()) : nullptr);
+    if (props != nullptr)
+    {
+        props->trace().on_running(now, cpu);
+    }
+    benchmarking::FiberTracer::set_current_fiber(props != nullptr ? &props->trace() : nullptr);
+}
+
+}  // namespace mrc::internal::system
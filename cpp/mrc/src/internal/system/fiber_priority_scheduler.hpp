@@ -17,9 +17,26 @@
 
 #pragma once
 
+#include "internal/system/futex_event.hpp"
+
+#include "mrc/benchmarking/fiber_tracer.hpp"
+#include "mrc/core/fiber_meta_data.hpp"
+
 #include <boost/fiber/all.hpp>
 #include <boost/fiber/scheduler.hpp>
 
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <vector>
+
 namespace mrc::internal::system {
 
 class FiberPriorityProps : public boost::fibers::fiber_properties
@@ -45,107 +62,213 @@ class FiberPriorityProps : public boost::fibers::fiber_properties
         }
     }
 
+    const FiberShare& get_share() const
+    {
+        return m_share;
+    }
+
+    // moves the fiber to another share group, or changes the weight of its group
+    void set_share(const FiberShare& share)
+    {
+        if (share.group != m_share.group || share.weight != m_share.weight)
+        {
+            m_share = share;
+            notify();
+        }
+    }
+
+    std::chrono::nanoseconds get_time_slice() const
+    {
+        return m_time_slice;
+    }
+
+    // takes effect the next time the fiber is resumed; the ready queues are not affected
+    void set_time_slice(std::chrono::nanoseconds time_slice)
+    {
+        m_time_slice = time_slice;
+    }
+
+    // only updated by a tracing FiberPriorityScheduler
+    benchmarking::FiberTracer::FiberState& trace()
+    {
+        return m_trace;
+    }
+
   private:
     int m_priority;
+    FiberShare m_share;
+    std::chrono::nanoseconds m_time_slice{0};
+    benchmarking::FiberTracer::FiberState m_trace;
 };
 
-class FiberPriorityScheduler : public boost::fibers::algo::algorithm_with_properties<FiberPriorityProps>
-{
-  private:
-    using rqueue_t = boost::fibers::scheduler::ready_queue_type;
+class FiberPriorityScheduler;
 
-    rqueue_t m_rqueue;
-    std::mutex m_mtx{};
-    std::condition_variable m_cnd{};
-    bool m_flag{false};
+/**
+ * @brief How an idle FiberPriorityScheduler suspends its thread and is woken by other threads.
+ *
+ * By default a mutex/condition variable pair is used; with `futex` enabled the thread polls for a wakeup up to
+ * `spin_count` times, then parks on a FutexEvent.
+ */
+struct FiberSuspendOptions
+{
+    bool futex{false};
+    std::size_t spin_count{0};
+};
 
+/**
+ * @brief Set of FiberPriorityScheduler instances, one per fiber thread, which are allowed to steal ready fibers from
+ * one another; the FiberManager creates one group per HostPartition so fibers never migrate across NUMA nodes.
+ *
+ * Stolen fibers resume on the thief's thread; a fiber which relies on thread-local state or on running on the cpu of
+ * the task queue it was enqueued on must not be launched on a FiberPool with work stealing enabled.
+ *
+ * The group also counts the fibers launched by its members which have not yet completed; a fiber thread must not exit
+ * while any of those fibers are outstanding since a stolen fiber may be owned by its scheduler.
+ */
+class FiberStealingGroup
+{
   public:
-    FiberPriorityScheduler() : m_rqueue() {}  // NOLINT
+    // attempt to steal a ready fiber from the most loaded member other than thief
+    boost::fibers::context* steal(const FiberPriorityScheduler* thief);
 
-    // For a subclass of algorithm_with_properties<>, it's important to
-    // override the correct awakened() overload.
-    void awakened(boost::fibers::context* ctx, FiberPriorityProps& props) noexcept final
+    // resume one sleeping member other than caller
+    void wake_one(const FiberPriorityScheduler* caller);
+
+    void fiber_launched()
     {
-        int ctx_priority = props.get_priority();
-        // With this scheduler, fibers with higher priority values are
-        // preferred over fibers with lower priority values. But fibers with
-        // equal priority values are processed in round-robin fashion. So when
-        // we're handed a new context*, put it at the end of the fibers
-        // with that same priority. In other words: search for the first fiber
-        // in the queue with LOWER priority, and insert before that one.
-        rqueue_t::iterator i(
-            std::find_if(m_rqueue.begin(), m_rqueue.end(), [this, ctx_priority](boost::fibers::context& c) {
-                return properties(&c).get_priority() < ctx_priority;
-            }));
-        // Now, whether or not we found a fiber with lower priority,
-        // insert this new fiber here.
-        m_rqueue.insert(i, *ctx);
+        m_outstanding.fetch_add(1, std::memory_order_relaxed);
     }
 
-    boost::fibers::context* pick_next() noexcept final
+    void fiber_completed()
     {
-        // if ready queue is empty, just tell caller
-        if (m_rqueue.empty())
-        {
-            return nullptr;
-        }
-        boost::fibers::context* ctx(&m_rqueue.front());
-        m_rqueue.pop_front();
-        return ctx;
+        m_outstanding.fetch_sub(1, std::memory_order_release);
     }
 
-    bool has_ready_fibers() const noexcept final
+    [[nodiscard]] std::size_t outstanding() const
     {
-        return !m_rqueue.empty();
+        return m_outstanding.load(std::memory_order_acquire);
     }
 
-    void property_change(boost::fibers::context* ctx, FiberPriorityProps& props) noexcept final
+    [[nodiscard]] std::size_t sleepers() const
     {
-        // Although our priority_props class defines multiple properties, only
-        // one of them (priority) actually calls notify() when changed. The
-        // point of a property_change() override is to reshuffle the ready
-        // queue according to the updated priority value.
-
-        // 'ctx' might not be in our queue at all, if caller is changing the
-        // priority of (say) the running fiber. If it's not there, no need to
-        // move it: we'll handle it next time it hits awakened().
-        if (!ctx->ready_is_linked())
-        {
-            return;
-        }
-
-        // Found ctx: unlink it
-        ctx->ready_unlink();
-
-        // Here we know that ctx was in our ready queue, but we've unlinked
-        // it. We happen to have a method that will (re-)add a context* to the
-        // right place in the ready queue.
-        awakened(ctx, props);
+        return m_sleepers.load(std::memory_order_relaxed);
     }
 
-    void suspend_until(std::chrono::steady_clock::time_point const& time_point) noexcept final
+    [[nodiscard]] std::uint64_t steal_count() const
     {
-        if ((std::chrono::steady_clock::time_point::max)() == time_point)
-        {
-            std::unique_lock<std::mutex> lk(m_mtx);
-            m_cnd.wait(lk, [this]() { return m_flag; });
-            m_flag = false;
-        }
-        else
-        {
-            std::unique_lock<std::mutex> lk(m_mtx);
-            m_cnd.wait_until(lk, time_point, [this]() { return m_flag; });
-            m_flag = false;
-        }
+        return m_steal_count.load(std::memory_order_relaxed);
     }
 
-    void notify() noexcept final
+  private:
+    void register_scheduler(FiberPriorityScheduler* scheduler);
+    void unregister_scheduler(FiberPriorityScheduler* scheduler);
+
+    std::mutex m_mutex;
+    std::vector<FiberPriorityScheduler*> m_schedulers;
+    std::atomic<std::size_t> m_outstanding{0};
+    std::atomic<std::size_t> m_sleepers{0};
+    std::atomic<std::uint64_t> m_steal_count{0};
+
+    friend FiberPriorityScheduler;
+};
+
+/**
+ * @brief Fiber scheduler with one intrusive FIFO ready queue per priority level.
+ *
+ * Fibers with higher priority values are preferred over fibers with lower priority values; fibers with equal priority
+ * values are processed in round-robin fashion. Inserting a ready fiber is O(1) with respect to the number of ready
+ * fibers; only the number of distinct priority levels in use, which is small in practice, is ever scanned.
+ *
+ * Within a priority level, fibers are grouped by their FiberShare. Groups are served by stride scheduling, each group
+ * receiving a number of turns proportional to its weight while it has ready fibers, and fibers of a group in FIFO
+ * order. A group which was idle rejoins at the current virtual time of its level, so it does not bank turns.
+ *
+ * When constructed with a FiberStealingGroup, an idle scheduler steals ready fibers from the most loaded member of the
+ * group before suspending its thread, and a scheduler with surplus ready fibers wakes a sleeping member. Pinned
+ * contexts, i.e. the main and dispatcher fibers of a thread, are never stolen.
+ *
+ * Each time a fiber is resumed, a TimeSlice of its budget is started on the thread.
+ *
+ * When constructed with `tracing` enabled, every ready/running/blocked transition of a fiber is recorded with the
+ * benchmarking::FiberTracer.
+ */
+class FiberPriorityScheduler : public boost::fibers::algo::algorithm_with_properties<FiberPriorityProps>
+{
+  public:
+    FiberPriorityScheduler(std::shared_ptr<FiberStealingGroup> group = nullptr,
+                           FiberSuspendOptions suspend               = {},
+                           bool tracing                              = false);
+    ~FiberPriorityScheduler() override;
+
+    // For a subclass of algorithm_with_properties<>, it's important to
+    // override the correct awakened() overload.
+    void awakened(boost::fibers::context* ctx, FiberPriorityProps& props) noexcept final;
+
+    boost::fibers::context* pick_next() noexcept final;
+
+    bool has_ready_fibers() const noexcept final;
+
+    void property_change(boost::fibers::context* ctx, FiberPriorityProps& props) noexcept final;
+
+    void suspend_until(std::chrono::steady_clock::time_point const& time_point) noexcept final;
+
+    void notify() noexcept final;
+
+  private:
+    using rqueue_t = boost::fibers::scheduler::ready_queue_type;
+
+    // virtual time advanced by a turn of a group of weight 1
+    static constexpr std::uint64_t ShareStride = 1 << 16;
+
+    struct ShareQueue
+    {
+        rqueue_t queue;
+        std::uint32_t weight{1};
+        // virtual time of the next turn of the group
+        std::uint64_t pass{0};
+    };
+
+    struct Level
     {
-        std::unique_lock<std::mutex> lk(m_mtx);
-        m_flag = true;
-        lk.unlock();
-        m_cnd.notify_all();
+        std::map<std::uint32_t, ShareQueue> groups;
+        std::uint64_t virtual_time{0};
+    };
+
+    // levels and groups are never erased, so iterators, and the cached m_last_level, remain valid for the life of the
+    // scheduler
+    using levels_t = std::map<int, Level, std::greater<>>;
+
+    // queue locking is only required when other threads may steal from this scheduler
+    std::unique_lock<std::mutex> lock_queue() const;
+
+    void push_locked(boost::fibers::context* ctx, int priority, const FiberShare& share);
+    boost::fibers::context* pop_locked();
+
+    // called by a thief with the FiberStealingGroup mutex held
+    boost::fibers::context* steal();
+
+    void trace_switch(boost::fibers::context* next);
+
+    std::size_t ready_count() const
+    {
+        return m_ready_count.load(std::memory_order_relaxed);
     }
+
+    const std::shared_ptr<FiberStealingGroup> m_group;
+
+    mutable std::mutex m_queue_mutex;
+    levels_t m_levels;
+    levels_t::iterator m_last_level;
+    std::atomic<std::size_t> m_ready_count{0};
+
+    std::optional<FutexEvent> m_futex;
+    std::shared_ptr<benchmarking::FiberTracer::ThreadBuffer> m_trace_buffer;
+    std::mutex m_mtx{};
+    std::condition_variable m_cnd{};
+    bool m_flag{false};
+    std::atomic<bool> m_sleeping{false};
+
+    friend FiberStealingGroup;
 };
 
 }  // namespace mrc::internal::system
@@ -19,19 +19,25 @@
 
 #include "internal/system/fiber_priority_scheduler.hpp"
 #include "internal/system/resources.hpp"
+#include "internal/system/system.hpp"
 
 #include "mrc/core/bitmap.hpp"
 #include "mrc/core/fiber_meta_data.hpp"
+#include "mrc/core/fiber_stack_pool.hpp"
 #include "mrc/core/task_queue.hpp"
+#include "mrc/options/fiber_pool.hpp"
+#include "mrc/options/options.hpp"
 #include "mrc/types.hpp"
 
-#include <boost/fiber/channel_op_status.hpp>
 #include <boost/fiber/context.hpp>
 #include <boost/fiber/fiber.hpp>
 #include <boost/fiber/future/future.hpp>
 #include <boost/fiber/operations.hpp>
 #include <glog/logging.h>
 
+#include <atomic>
+#include <memory>
+#include <mutex>
 #include <ostream>
 #include <string>
 #include <thread>
@@ -39,11 +45,19 @@
 
 namespace mrc::internal::system {
 
-FiberTaskQueue::FiberTaskQueue(const Resources& resources, CpuSet cpu_affinity, std::size_t channel_size) :
-  m_queue(channel_size),
+FiberTaskQueue::FiberTaskQueue(const Resources& resources,
+                               CpuSet cpu_affinity,
+                               std::size_t batch_size,
+                               std::shared_ptr<FiberStealingGroup> stealing_group) :
+  m_batch_size(batch_size),
   m_cpu_affinity(std::move(cpu_affinity)),
+  m_stealing_group(std::move(stealing_group)),
+  m_suspend_options{resources.system().options().fiber_pool().enable_futex_wakeup(),
+                    resources.system().options().fiber_pool().futex_spin_count()},
+  m_tracing(resources.system().options().fiber_pool().enable_tracing_scheduler()),
   m_thread(resources.make_thread("fiberq", m_cpu_affinity, [this] { main(); }))
 {
+    CHECK_GT(m_batch_size, 0);
     DVLOG(10) << "awaiting fiber task queue worker thread running on cpus " << m_cpu_affinity;
     enqueue([] {}).get();
     DVLOG(10) << *this << ": ready";
@@ -59,25 +73,74 @@ const CpuSet& FiberTaskQueue::affinity() const
     return m_cpu_affinity;
 }
 
-boost::fibers::buffered_channel<core::FiberTaskQueue::task_pkg_t>& FiberTaskQueue::task_queue()
+bool FiberTaskQueue::submit(task_pkg_t&& pkg)
 {
-    return m_queue;
+    if (m_closed.load(std::memory_order_acquire))
+    {
+        return false;
+    }
+
+    // the scheduler of the calling thread is the one the task is destined for
+    if (caller_on_same_thread())
+    {
+        launch(std::move(pkg));
+        return true;
+    }
+
+    m_queue.push(std::move(pkg));
+
+    // pairs with the fence in wait: either the fiber thread sees the task or it is seen parked here
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (m_sleeping.load(std::memory_order_relaxed))
+    {
+        std::lock_guard<boost::fibers::mutex> lock(m_mutex);
+        m_cv.notify_one();
+    }
+    return true;
+}
+
+std::size_t FiberTaskQueue::drain()
+{
+    std::size_t count = 0;
+    task_pkg_t task_pkg;
+    while (count < m_batch_size && m_queue.try_pop(task_pkg))
+    {
+        launch(std::move(task_pkg));
+        ++count;
+    }
+    return count;
+}
+
+void FiberTaskQueue::wait()
+{
+    std::unique_lock<boost::fibers::mutex> lock(m_mutex);
+    m_sleeping.store(true, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    while (m_queue.empty() && !m_closed.load(std::memory_order_acquire))
+    {
+        m_cv.wait(lock);
+    }
+    m_sleeping.store(false, std::memory_order_relaxed);
 }
 
 void FiberTaskQueue::main()
 {
     // enable priority scheduler
-    boost::fibers::use_scheduling_algorithm<FiberPriorityScheduler>();
+    boost::fibers::use_scheduling_algorithm<FiberPriorityScheduler>(m_stealing_group, m_suspend_options, m_tracing);
 
-    task_pkg_t task_pkg;
     while (true)
     {
-        auto rc = m_queue.pop(task_pkg);
-        if (rc == boost::fibers::channel_op_status::closed)
+        if (drain() == m_batch_size)
+        {
+            // let the launched fibers run before draining the next batch
+            boost::this_fiber::yield();
+            continue;
+        }
+        if (m_closed.load(std::memory_order_acquire) && m_queue.empty())
         {
             break;
         }
-        launch(std::move(task_pkg));
+        wait();
     }
 
     if (detached() != 0U)
@@ -90,20 +153,50 @@ void FiberTaskQueue::main()
         boost::this_fiber::yield();
     }
 
+    // fibers of other queues may have been stolen by this thread, so keep scheduling until the entire group is done
+    if (m_stealing_group)
+    {
+        while (m_stealing_group->outstanding() != 0U)
+        {
+            boost::this_fiber::yield();
+        }
+    }
+
     VLOG(10) << *this << ": completed";
 }
 
 void FiberTaskQueue::shutdown()
 {
-    m_queue.close();
+    m_closed.store(true, std::memory_order_release);
+    std::lock_guard<boost::fibers::mutex> lock(m_mutex);
+    m_cv.notify_one();
 }
 
 void FiberTaskQueue::launch(task_pkg_t&& pkg) const
 {
+    if (m_stealing_group)
+    {
+        m_stealing_group->fiber_launched();
+        pkg.first = task_t([task = std::move(pkg.first), group = m_stealing_group]() mutable {
+            task();
+            group->fiber_completed();
+        });
+    }
+
     // default is a post, not a dispatch, so the task is only enqueued with the fiber scheduler
-    boost::fibers::fiber fiber(std::move(pkg.first));
+    boost::fibers::fiber fiber;
+    if (pkg.second.stack_pool)
+    {
+        fiber = boost::fibers::fiber(std::allocator_arg, pkg.second.stack_pool->allocator(), std::move(pkg.first));
+    }
+    else
+    {
+        fiber = boost::fibers::fiber(std::move(pkg.first));
+    }
     auto& props(fiber.properties<FiberPriorityProps>());
     props.set_priority(pkg.second.priority);
+    props.set_share(pkg.second.share);
+    props.set_time_slice(pkg.second.time_slice);
     DVLOG(10) << *this << ": created fiber " << fiber.get_id() << " with priority " << pkg.second.priority;
     fiber.detach();
 }
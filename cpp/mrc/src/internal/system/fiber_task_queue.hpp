@@ -17,26 +17,42 @@
 
 #pragma once
 
+#include "internal/system/fiber_priority_scheduler.hpp"
+#include "internal/system/mpsc_queue.hpp"
 #include "internal/system/thread.hpp"
 
 #include "mrc/core/bitmap.hpp"
 #include "mrc/core/task_queue.hpp"
 #include "mrc/utils/macros.hpp"
 
-#include <boost/fiber/buffered_channel.hpp>
+#include <boost/fiber/condition_variable.hpp>
+#include <boost/fiber/mutex.hpp>
 
+#include <atomic>
 #include <cstddef>
 #include <iosfwd>
+#include <memory>
 #include <thread>
 
 namespace mrc::internal::system {
 
 class Resources;
 
+/**
+ * @brief Task queue feeding the fiber scheduler of a single thread
+ *
+ * Tasks submitted from other threads are pushed onto a lock-free mpsc queue which the fiber thread drains in batches of
+ * up to batch_size tasks, yielding to the launched fibers between full batches. A submitting thread only takes the
+ * wakeup mutex when the fiber thread is parked waiting for tasks. Tasks submitted from the fiber thread itself are
+ * launched directly without passing through the queue.
+ */
 class FiberTaskQueue final : public core::FiberTaskQueue
 {
   public:
-    FiberTaskQueue(const Resources& resources, CpuSet cpu_affinity, std::size_t channel_size = 64);
+    FiberTaskQueue(const Resources& resources,
+                   CpuSet cpu_affinity,
+                   std::size_t batch_size                             = 64,
+                   std::shared_ptr<FiberStealingGroup> stealing_group = nullptr);
     ~FiberTaskQueue() final;
 
     DELETE_COPYABILITY(FiberTaskQueue);
@@ -55,10 +71,24 @@ class FiberTaskQueue final : public core::FiberTaskQueue
     void main();
     void launch(task_pkg_t&& pkg) const;
 
-    boost::fibers::buffered_channel<task_pkg_t>& task_queue() final;
+    bool submit(task_pkg_t&& pkg) final;
+
+    // launches up to m_batch_size queued tasks; returns the number launched
+    std::size_t drain();
+
+    // parks the fiber thread until a task is queued or the queue is shut down
+    void wait();
 
-    boost::fibers::buffered_channel<task_pkg_t> m_queue;
+    MpscQueue<task_pkg_t> m_queue;
+    const std::size_t m_batch_size;
+    std::atomic<bool> m_closed{false};
+    std::atomic<bool> m_sleeping{false};
+    boost::fibers::mutex m_mutex;
+    boost::fibers::condition_variable m_cv;
     CpuSet m_cpu_affinity;
+    std::shared_ptr<FiberStealingGroup> m_stealing_group;
+    FiberSuspendOptions m_suspend_options;
+    bool m_tracing;
     Thread m_thread;
 };
 
@@ -0,0 +1,105 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "internal/system/futex_event.hpp"
+
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <ctime>
+
+namespace mrc::internal::system {
+
+namespace {
+
+inline void pause_cpu()
+{
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#elif defined(__aarch64__)
+    asm volatile("yield" ::: "memory");
+#endif
+}
+
+void futex_wait(std::atomic<std::uint32_t>& word,
+                std::uint32_t expected,
+                const std::chrono::steady_clock::time_point& time_point,
+                bool process_shared)
+{
+    // FUTEX_WAIT_BITSET takes an absolute timeout; std::chrono::steady_clock is CLOCK_MONOTONIC on linux
+    struct timespec deadline;
+    struct timespec* timeout = nullptr;
+    if ((std::chrono::steady_clock::time_point::max)() != time_point)
+    {
+        auto ns          = std::chrono::duration_cast<std::chrono::nanoseconds>(time_point.time_since_epoch()).count();
+        deadline.tv_sec  = ns / 1'000'000'000;
+        deadline.tv_nsec = ns % 1'000'000'000;
+        timeout          = &deadline;
+    }
+    ::syscall(SYS_futex,
+              reinterpret_cast<std::uint32_t*>(&word),
+              (process_shared ? FUTEX_WAIT_BITSET : FUTEX_WAIT_BITSET_PRIVATE),
+              expected,
+              timeout,
+              nullptr,
+              FUTEX_BITSET_MATCH_ANY);
+}
+
+void futex_wake(std::atomic<std::uint32_t>& word, bool process_shared)
+{
+    ::syscall(SYS_futex,
+              reinterpret_cast<std::uint32_t*>(&word),
+              (process_shared ? FUTEX_WAKE : FUTEX_WAKE_PRIVATE),
+              1,
+              nullptr,
+              nullptr,
+              0);
+}
+
+}  // namespace
+
+void FutexEvent::wait_until(const std::chrono::steady_clock::time_point& time_point) noexcept
+{
+    for (std::size_t i = 0; i < m_spin_count; i++)
+    {
+        if (m_state.load(std::memory_order_relaxed) == Notified)
+        {
+            break;
+        }
+        pause_cpu();
+    }
+
+    std::uint32_t expected = Idle;
+    if (m_state.compare_exchange_strong(expected, Parked, std::memory_order_acq_rel))
+    {
+        // a notify() between the exchange and the syscall changes the word, so the kernel returns immediately
+        futex_wait(m_state, Parked, time_point, m_process_shared);
+    }
+
+    m_state.store(Idle, std::memory_order_release);
+}
+
+void FutexEvent::notify() noexcept
+{
+    if (m_state.exchange(Notified, std::memory_order_acq_rel) == Parked)
+    {
+        futex_wake(m_state, m_process_shared);
+    }
+}
+
+}  // namespace mrc::internal::system
@@ -0,0 +1,62 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+namespace mrc::internal::system {
+
+/**
+ * @brief Single-waiter wakeup event backed by a Linux futex.
+ *
+ * notify() only enters the kernel when the waiter is parked. wait_until() first polls for a pending notification up to
+ * `spin_count` times, which lets a handoff from another thread complete without a syscall on either side when the
+ * waiter has only just gone idle.
+ *
+ * A `process_shared` event may be placed in shared memory to wake a waiter of another process.
+ */
+class FutexEvent
+{
+  public:
+    FutexEvent(std::size_t spin_count = 0, bool process_shared = false) :
+      m_spin_count(spin_count),
+      m_process_shared(process_shared)
+    {}
+
+    // returns when notified, on timeout, or spuriously; time_point::max() waits without a timeout
+    void wait_until(const std::chrono::steady_clock::time_point& time_point) noexcept;
+
+    void notify() noexcept;
+
+  private:
+    enum State : std::uint32_t
+    {
+        Idle     = 0,
+        Notified = 1,
+        Parked   = 2,
+    };
+
+    std::atomic<std::uint32_t> m_state{Idle};
+    const std::size_t m_spin_count;
+    const bool m_process_shared;
+};
+
+}  // namespace mrc::internal::system
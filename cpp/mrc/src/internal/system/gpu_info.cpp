@@ -49,6 +49,14 @@ int GpuInfo::cuda_device_id() const
 {
     return m_cuda_device_id;
 }
+const std::vector<std::string>& GpuInfo::nics() const
+{
+    return m_nics;
+}
+const std::vector<std::string>& GpuInfo::nvlink_peers() const
+{
+    return m_nvlink_peers;
+}
 protos::GpuInfo GpuInfo::serialize() const
 {
     protos::GpuInfo info;
@@ -58,6 +66,14 @@ protos::GpuInfo GpuInfo::serialize() const
     info.set_pcie_bus_id(m_pcie_bus_id);
     info.set_memory_capacity(m_memory_capacity);
     info.set_cuda_device_id(m_cuda_device_id);
+    for (const auto& nic : m_nics)
+    {
+        info.add_nics(nic);
+    }
+    for (const auto& peer : m_nvlink_peers)
+    {
+        info.add_nvlink_peers(peer);
+    }
     return info;
 }
 
@@ -72,6 +88,8 @@ GpuInfo GpuInfo::deserialize(const protos::GpuInfo& msg)
     info.m_pcie_bus_id     = msg.pcie_bus_id();
     info.m_memory_capacity = msg.memory_capacity();
     info.m_cuda_device_id  = msg.cuda_device_id();
+    info.m_nics.assign(msg.nics().begin(), msg.nics().end());
+    info.m_nvlink_peers.assign(msg.nvlink_peers().begin(), msg.nvlink_peers().end());
 
     return info;
 }
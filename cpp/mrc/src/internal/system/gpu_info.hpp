@@ -24,6 +24,7 @@
 #include <cstdint>
 #include <ostream>
 #include <string>
+#include <vector>
 
 namespace mrc::internal::system {
 
@@ -48,6 +49,17 @@ class GpuInfo
     [[nodiscard]] const std::string& pcie_bus_id() const;
     [[nodiscard]] int cuda_device_id() const;
 
+    /**
+     * @brief names of the network devices, e.g. mlx5_0, with the closest pcie affinity to the gpu
+     */
+    [[nodiscard]] const std::vector<std::string>& nics() const;
+
+    /**
+     * @brief pcie bus ids of the remote ends of the active nvlinks of the gpu, one entry per link; the remote end is
+     * either a peer gpu or an nvswitch
+     */
+    [[nodiscard]] const std::vector<std::string>& nvlink_peers() const;
+
     protos::GpuInfo serialize() const;
     static GpuInfo deserialize(const protos::GpuInfo&);
 
@@ -63,6 +75,9 @@ class GpuInfo
 
     int m_cuda_device_id;
 
+    std::vector<std::string> m_nics;
+    std::vector<std::string> m_nvlink_peers;
+
     // std::uint32_t m_compute_capability_major;
     // std::uint32_t m_compute_capability_minor;
 
@@ -51,9 +51,11 @@ void HostPartition::add_device_partition_id(int gpu_id)
     m_device_partitions.push_back(gpu_id);
 }
 
-void HostPartition::set_engine_factory_cpu_sets(const Topology& topology, const Options& options)
+void HostPartition::set_engine_factory_cpu_sets(const Topology& topology,
+                                                const Options& options,
+                                                const std::optional<CpuSet>& network_cpu_set)
 {
-    m_engine_factory_cpu_sets = generate_engine_factory_cpu_sets(topology, options, cpu_set());
+    m_engine_factory_cpu_sets = generate_engine_factory_cpu_sets(topology, options, cpu_set(), network_cpu_set);
 }
 
 const EngineFactoryCpuSets& HostPartition::engine_factory_cpu_sets() const
@@ -22,6 +22,7 @@
 #include "mrc/core/bitmap.hpp"
 
 #include <cstddef>
+#include <optional>
 #include <vector>
 
 namespace mrc {
@@ -43,7 +44,9 @@ class HostPartition
     const std::vector<int>& device_partition_ids() const;
 
     void add_device_partition_id(int gpu_id);
-    void set_engine_factory_cpu_sets(const Topology& topology, const Options& options);
+    void set_engine_factory_cpu_sets(const Topology& topology,
+                                     const Options& options,
+                                     const std::optional<CpuSet>& network_cpu_set = std::nullopt);
 
     const EngineFactoryCpuSets& engine_factory_cpu_sets() const;
 
@@ -0,0 +1,95 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2021-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "mrc/utils/macros.hpp"
+
+#include <atomic>
+#include <optional>
+#include <utility>
+
+namespace mrc::internal::system {
+
+/**
+ * @brief Unbounded lock-free multi-producer single-consumer queue
+ *
+ * Producers link a node with a single atomic exchange, so a push never waits on other producers or on the consumer.
+ * try_pop must only be called by the single consumer. A node whose producer has not yet linked it is not visible, so
+ * try_pop may briefly return false while a push is in flight; producers which need to wake the consumer should do so
+ * after push returns.
+ */
+template <typename T>
+class MpscQueue
+{
+  public:
+    MpscQueue() : m_head(new Node), m_tail(m_head.load()) {}
+
+    ~MpscQueue()
+    {
+        T value;
+        while (try_pop(value)) {}
+        delete m_tail;
+    }
+
+    DELETE_COPYABILITY(MpscQueue);
+    DELETE_MOVEABILITY(MpscQueue);
+
+    void push(T&& value)
+    {
+        auto* node = new Node;
+        node->value.emplace(std::move(value));
+        auto* prev = m_head.exchange(node, std::memory_order_acq_rel);
+        prev->next.store(node, std::memory_order_release);
+    }
+
+    // consumer only
+    bool try_pop(T& value)
+    {
+        auto* tail = m_tail;
+        auto* next = tail->next.load(std::memory_order_acquire);
+        if (next == nullptr)
+        {
+            return false;
+        }
+
+        // next becomes the new stub node
+        value = std::move(*next->value);
+        next->value.reset();
+        m_tail = next;
+        delete tail;
+        return true;
+    }
+
+    // consumer only
+    bool empty() const
+    {
+        return m_tail->next.load(std::memory_order_acquire) == nullptr;
+    }
+
+  private:
+    struct Node
+    {
+        std::atomic<Node*> next{nullptr};
+        std::optional<T> value;
+    };
+
+    alignas(64) std::atomic<Node*> m_head;
+    alignas(64) Node* m_tail;
+};
+
+}  // namespace mrc::internal::system
@@ -24,6 +24,7 @@
 #include "internal/utils/shared_resource_bit_map.hpp"
 
 #include "mrc/core/bitmap.hpp"
+#include "mrc/options/engine_groups.hpp"
 #include "mrc/options/options.hpp"
 #include "mrc/options/placement.hpp"
 #include "mrc/utils/bytes_to_string.hpp"
@@ -36,9 +37,11 @@
 #include <cstdint>
 #include <map>
 #include <memory>
+#include <optional>
 #include <ostream>
 #include <string>
 #include <utility>
+#include <vector>
 
 static void div_even(std::int32_t n, std::int32_t np, std::int32_t me, std::int32_t& nr, std::int32_t& sr)
 {
@@ -58,6 +61,144 @@ static void div_even(std::int32_t n, std::int32_t np, std::int32_t me, std::int3
 
 namespace mrc::internal::system {
 
+namespace {
+
+// number of nvlinks between two gpus; gpus attached to a common nvswitch count as a single link
+std::size_t nvlink_connectivity(const GpuInfo& lhs, const GpuInfo& rhs)
+{
+    const auto& lhs_peers = lhs.nvlink_peers();
+    const auto& rhs_peers = rhs.nvlink_peers();
+
+    auto direct = std::count(lhs_peers.begin(), lhs_peers.end(), rhs.pcie_bus_id());
+    if (direct > 0)
+    {
+        return direct;
+    }
+
+    for (const auto& peer : lhs_peers)
+    {
+        if (std::find(rhs_peers.begin(), rhs_peers.end(), peer) != rhs_peers.end())
+        {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+// splits the cores of root among the gpus so that each gpu is given the cores local to its pcie attachment, i.e. the
+// cpus reported for the device by nvml/hwloc; gpus sharing a locality split its cores evenly in pcie bus id order and
+// cores local to none of the gpus are spread evenly over all splits. returns pairs of cpu_set and cuda device id
+// ordered by cpu, or an empty vector if the gpus sharing a locality outnumber its cores
+std::vector<std::pair<CpuSet, int>> split_by_locality(const Topology& topology,
+                                                      hwloc_obj_t root,
+                                                      const std::vector<int>& gpu_ids)
+{
+    struct Locality
+    {
+        CpuSet pool;
+        std::vector<int> gpu_ids;
+        std::vector<CpuSet> cores;
+    };
+
+    CpuSet root_set(root->cpuset);
+    std::map<std::string, Locality> by_pool;
+
+    for (const auto& gpu_id : gpu_ids)
+    {
+        CpuSet local = root_set.set_intersect(topology.gpu_info().at(gpu_id).cpu_set());
+        if (local.weight() == 0)
+        {
+            local = root_set;
+        }
+        auto& locality = by_pool[local.str()];
+        locality.pool  = local;
+        locality.gpu_ids.push_back(gpu_id);
+    }
+
+    std::vector<Locality*> localities;
+    for (auto& [key, locality] : by_pool)
+    {
+        localities.push_back(&locality);
+    }
+
+    auto core_count = hwloc_get_nbobjs_inside_cpuset_by_type(topology.handle(), root->cpuset, HWLOC_OBJ_CORE);
+    CHECK_NE(core_count, -1);
+
+    std::vector<CpuSet> unclaimed;
+    for (int ic = 0; ic < core_count; ic++)
+    {
+        auto* core_obj = hwloc_get_obj_inside_cpuset_by_type(topology.handle(), root->cpuset, HWLOC_OBJ_CORE, ic);
+        unclaimed.emplace_back(core_obj->cpuset);
+    }
+
+    // the narrowest localities claim their cores first, so a gpu local to the whole root is given what is left
+    std::stable_sort(localities.begin(), localities.end(), [](const Locality* lhs, const Locality* rhs) {
+        return lhs->pool.weight() < rhs->pool.weight();
+    });
+
+    for (auto* locality : localities)
+    {
+        for (auto it = unclaimed.begin(); it != unclaimed.end();)
+        {
+            if (locality->pool.contains(*it))
+            {
+                locality->cores.push_back(std::move(*it));
+                it = unclaimed.erase(it);
+            }
+            else
+            {
+                ++it;
+            }
+        }
+
+        if (locality->cores.size() < locality->gpu_ids.size())
+        {
+            VLOG(10) << "locality " << locality->pool.str() << " has " << locality->cores.size() << " free cores for "
+                     << locality->gpu_ids.size() << " gpus";
+            return {};
+        }
+    }
+
+    std::sort(localities.begin(), localities.end(), [](const Locality* lhs, const Locality* rhs) {
+        return lhs->pool.first() < rhs->pool.first();
+    });
+
+    std::vector<std::pair<CpuSet, int>> splits;
+    for (auto* locality : localities)
+    {
+        std::sort(locality->gpu_ids.begin(), locality->gpu_ids.end(), [&topology](int lhs, int rhs) {
+            return topology.gpu_info().at(lhs).pcie_bus_id() < topology.gpu_info().at(rhs).pcie_bus_id();
+        });
+
+        const auto count = locality->gpu_ids.size();
+        std::size_t next = 0;
+        for (std::size_t i = 0; i < count; i++)
+        {
+            CpuSet cpu_set;
+            auto ncores = locality->cores.size() / count + (i < locality->cores.size() % count ? 1 : 0);
+            for (std::size_t ic = 0; ic < ncores; ic++)
+            {
+                cpu_set.append(locality->cores[next++]);
+            }
+            splits.emplace_back(std::move(cpu_set), locality->gpu_ids[i]);
+        }
+    }
+
+    std::size_t next = 0;
+    for (std::size_t i = 0; i < splits.size(); i++)
+    {
+        auto ncores = unclaimed.size() / splits.size() + (i < unclaimed.size() % splits.size() ? 1 : 0);
+        for (std::size_t ic = 0; ic < ncores; ic++)
+        {
+            splits[i].first.append(unclaimed[next++]);
+        }
+    }
+
+    return splits;
+}
+
+}  // namespace
+
 Partitions::Partitions(const System& system) : Partitions(system.topology(), system.options()) {}
 
 Partitions::Partitions(const Topology& topology, const Options& options)
@@ -147,36 +288,88 @@ Partitions::Partitions(const Topology& topology, const Options& options)
     // GPU selection by cpu_set/numa_set with max overlap
     std::map<int, GpuInfo> remaining_gpus(topology.gpu_info());
 
-    // for each remaining gpu, score the gpu's cpu_set against the host_partition's cpu_set, pick the gpu with the
-    // highest overlap and use the lowest indexed gpu in case of a tie
-    auto device_best_match = [&remaining_gpus, &topology](const CpuSet& cpu_set) mutable {
-        int top_idx    = -1;
-        long top_score = -1;
+    // greedily select count of the remaining gpus for a host cpu/memory domain: score each gpu's cpu_set against the
+    // domain's cpu_set, break ties by the number of nvlinks to the gpus already selected, then by the lowest index
+    auto select_devices = [&remaining_gpus, &topology](const CpuSet& cpu_set, int count) {
+        std::vector<int> selected;
+
+        while (selected.size() < static_cast<std::size_t>(count) && !remaining_gpus.empty())
+        {
+            int top_idx           = -1;
+            int top_overlap       = -1;
+            std::size_t top_links = 0;
+
+            for (const auto& [gpu_id, info] : remaining_gpus)
+            {
+                auto overlap      = cpu_set.set_intersect(info.cpu_set()).weight();
+                std::size_t links = 0;
+                for (const auto& selected_id : selected)
+                {
+                    links += nvlink_connectivity(info, topology.gpu_info().at(selected_id));
+                }
+
+                if (overlap > top_overlap || (overlap == top_overlap && links > top_links))
+                {
+                    top_idx     = gpu_id;
+                    top_overlap = overlap;
+                    top_links   = links;
+                }
+            }
+
+            remaining_gpus.erase(top_idx);
+            selected.push_back(top_idx);
+        }
+
+        return selected;
+    };
+
+    // pick the candidate whose cpu_set has the highest overlap with cpu_set, the lowest indexed gpu in case of a tie
+    auto device_best_match = [&topology](const CpuSet& cpu_set, std::vector<int>& candidates) {
+        auto top      = candidates.end();
+        int top_score = -1;
 
-        for (const auto& [gpu_id, info] : remaining_gpus)
+        for (auto it = candidates.begin(); it != candidates.end(); ++it)
         {
-            auto intersection = cpu_set.set_intersect(info.cpu_set());
-            if (intersection.weight() > top_score)
+            auto score = cpu_set.set_intersect(topology.gpu_info().at(*it).cpu_set()).weight();
+            if (score > top_score || (score == top_score && *it < *top))
             {
-                top_idx = gpu_id;
+                top       = it;
+                top_score = score;
             }
         }
-        remaining_gpus.erase(top_idx);
+
+        auto top_idx = *top;
+        candidates.erase(top);
         return top_idx;
     };
 
+    // assigns a device partition to the most recently added host partition
+    auto add_device_partition = [&](int cuda_id) {
+        CHECK_GT(host_partitions.size(), 0);
+        auto host_partition_id   = host_partitions.size() - 1;
+        auto device_partition_id = device_partitions.size();
+        device_partitions.push_back(std::make_shared<DevicePartition>(topology.gpu_info().at(cuda_id),
+                                                                      host_partitions.at(host_partition_id)));
+        host_partitions[host_partition_id]->add_device_partition_id(device_partition_id);
+
+        VLOG(10) << "assigning cuda_device_id: " << device_partitions.back()->cuda_device_id()
+                 << "; pcie: " << device_partitions.back()->pcie_bus_id()
+                 << " to host_partition_id: " << host_partition_id;
+    };
+
     for (int p_id = 0; p_id < partition_size; p_id++)
     {
         auto* obj   = topology.object_at_depth(partition_depth, p_id);
         auto pieces = std::max(gpus_per_partition, 1);
 
-        std::vector<CpuSet> cpu_sets;
         std::size_t partition_memory = obj->total_memory;
 
         CpuSet cpu_set(obj->cpuset);
         VLOG(10) << "host cpu/memory domain: " << p_id << " has " << cpu_set.weight() << " logical cpus ("
                  << cpu_set.str() << ") with " << bytes_to_string(partition_memory) << " memory";
 
+        auto gpu_ids = select_devices(cpu_set, gpus_per_partition);
+
         if (m_device_to_host_strategy == PlacementResources::Dedicated)
         {
             auto* root      = topology.object_at_depth(partition_depth, p_id);
@@ -186,28 +379,61 @@ Partitions::Partitions(const Topology& topology, const Options& options)
             VLOG(10) << "host resources will be split into " << pieces << " partitions across " << core_count
                      << " cores";
 
-            for (int i = 0; i < pieces; i++)
+            // pairs of cpu_set and the cuda device id assigned to it, -1 if none
+            std::vector<std::pair<CpuSet, int>> splits;
+            if (!gpu_ids.empty())
             {
-                std::int32_t nc;
-                std::int32_t sc;
-                CpuSet cpu_set;
-                div_even(core_count, pieces, i, nc, sc);
-
-                DVLOG(20) << "split " << i << ": start_core: " << sc << "; ncores: " << nc;
+                splits = split_by_locality(topology, root, gpu_ids);
+            }
 
-                for (int ic = sc; ic < sc + nc; ic++)
+            if (splits.empty())
+            {
+                if (!gpu_ids.empty())
                 {
-                    auto* core_obj =
-                        hwloc_get_obj_inside_cpuset_by_type(topology.handle(), root->cpuset, HWLOC_OBJ_CORE, ic);
-                    CpuSet core_cpuset(core_obj->cpuset);
-                    DVLOG(30) << "ic: " << ic << "; cpuset: " << core_cpuset.str();
-                    cpu_set.append(CpuSet(core_obj->cpuset));
+                    VLOG(10) << "unable to split host resources by gpu locality; splitting them evenly";
                 }
 
-                cpu_sets.push_back(std::move(cpu_set));
-                DVLOG(20) << "split cpuset: " << cpu_sets.back();
+                for (int i = 0; i < pieces; i++)
+                {
+                    std::int32_t nc;
+                    std::int32_t sc;
+                    CpuSet cpu_set;
+                    div_even(core_count, pieces, i, nc, sc);
+
+                    DVLOG(20) << "split " << i << ": start_core: " << sc << "; ncores: " << nc;
+
+                    for (int ic = sc; ic < sc + nc; ic++)
+                    {
+                        auto* core_obj =
+                            hwloc_get_obj_inside_cpuset_by_type(topology.handle(), root->cpuset, HWLOC_OBJ_CORE, ic);
+                        CpuSet core_cpuset(core_obj->cpuset);
+                        DVLOG(30) << "ic: " << ic << "; cpuset: " << core_cpuset.str();
+                        cpu_set.append(CpuSet(core_obj->cpuset));
+                    }
+
+                    auto cuda_id = (gpu_ids.empty() ? -1 : device_best_match(cpu_set, gpu_ids));
+                    splits.emplace_back(std::move(cpu_set), cuda_id);
+                }
             }
             partition_memory /= pieces;
+
+            // if dedicated, we push back 1 HostPartition for each dedicated partition
+            for (auto& [split_cpu_set, cuda_id] : splits)
+            {
+                DVLOG(20) << "split cpuset: " << split_cpu_set;
+                host_partitions.push_back(std::make_shared<HostPartition>(
+                    split_cpu_set, topology.numaset_for_cpuset(split_cpu_set), partition_memory));
+
+                VLOG(10) << "host_partition_id: " << host_partitions.size() - 1 << " contains "
+                         << host_partitions.back()->cpu_set().weight() << " logical cpus ("
+                         << host_partitions.back()->cpu_set().str() << ") with " << bytes_to_string(partition_memory)
+                         << " memory";
+
+                if (cuda_id != -1)
+                {
+                    add_device_partition(cuda_id);
+                }
+            }
         }
         else
         {
@@ -223,38 +449,10 @@ Partitions::Partitions(const Topology& topology, const Options& options)
                      << host_partitions.back()->cpu_set().weight() << " logical cpus ("
                      << host_partitions.back()->cpu_set().str() << ") with " << bytes_to_string(partition_memory)
                      << " memory";
-        }
-
-        for (int s_id = 0; s_id < pieces; s_id++)
-        {
-            if (m_device_to_host_strategy == PlacementResources::Dedicated)
-            {
-                // if dedicated, we push back 1 HostPartition for each dedicated partition
-                CHECK_LT(s_id, cpu_sets.size());
-                host_partitions.push_back(std::make_shared<HostPartition>(
-                    cpu_sets[s_id], topology.numaset_for_cpuset(cpu_sets[s_id]), partition_memory));
-
-                VLOG(10) << "host_partition_id: " << host_partitions.size() - 1 << " contains "
-                         << host_partitions.back()->cpu_set().weight() << " logical cpus ("
-                         << host_partitions.back()->cpu_set().str() << ") with " << bytes_to_string(partition_memory)
-                         << " memory";
-            }
 
-            CHECK_GT(host_partitions.size(), 0);
-            auto host_partition_id = host_partitions.size() - 1;
-
-            if (!remaining_gpus.empty())
+            for (const auto& cuda_id : gpu_ids)
             {
-                auto cuda_id = device_best_match(host_partitions[host_partition_id]->cpu_set());
-
-                auto device_partition_id = device_partitions.size();
-                device_partitions.push_back(std::make_shared<DevicePartition>(topology.gpu_info().at(cuda_id),
-                                                                              host_partitions.at(host_partition_id)));
-                host_partitions[host_partition_id]->add_device_partition_id(device_partition_id);
-
-                VLOG(10) << "assigning cuda_device_id: " << device_partitions.back()->cuda_device_id()
-                         << "; pcie: " << device_partitions.back()->pcie_bus_id()
-                         << " to host_partition_id: " << host_partition_id;
+                add_device_partition(cuda_id);
             }
         }
     }
@@ -262,10 +460,22 @@ Partitions::Partitions(const Topology& topology, const Options& options)
     CHECK_EQ(topology.gpu_count(), device_partitions.size());
     CHECK_EQ(remaining_gpus.size(), 0);
 
+    // with a shared network thread, the first host partition reserves the logical cpu used by all partitions
+    const bool shared_network = !options.architect_url().empty() &&
+                                options.engine_factories().network_thread_placement() == NetworkThreadPlacement::Shared;
+    std::optional<CpuSet> network_cpu_set;
+
     for (auto& partition : host_partitions)
     {
         VLOG(10) << "evaluating engine factory cpu sets for host_partition " << partition->cpu_set().str();
-        partition->set_engine_factory_cpu_sets(topology, options);
+        partition->set_engine_factory_cpu_sets(topology, options, network_cpu_set);
+
+        if (shared_network && !network_cpu_set)
+        {
+            network_cpu_set = CpuSet(partition->engine_factory_cpu_sets().fiber_cpu_sets.at("mrc_network"));
+            VLOG(10) << "sharing the network thread on logical cpu " << network_cpu_set->str()
+                     << " across all host partitions";
+        }
     }
 
     auto partition_sorter = [](const Partition& lhs, const Partition& rhs) -> bool {
@@ -19,11 +19,16 @@
 
 #include "internal/system/fiber_manager.hpp"
 
+#include "mrc/coroutines/thread_pool.hpp"
 #include "mrc/engine/system/iresources.hpp"
 
 #include <boost/fiber/future/future.hpp>
 
+#include <cstddef>
 #include <map>
+#include <memory>
+#include <string>
+#include <utility>
 #include <vector>
 
 namespace mrc::internal::system {
@@ -44,6 +49,28 @@ FiberPool Resources::make_fiber_pool(const CpuSet& cpu_set) const
     return m_fiber_manager.make_pool(cpu_set);
 }
 
+std::shared_ptr<coroutines::ThreadPool> Resources::make_coroutine_thread_pool(std::string desc,
+                                                                             const CpuSet& cpu_set) const
+{
+    CHECK(m_thread_resources);
+    CHECK(!cpu_set.empty());
+    CHECK(system().topology().contains(cpu_set));
+
+    auto cpus = cpu_set.vec();
+
+    coroutines::ThreadPool::Options options;
+    options.thread_count            = cpus.size();
+    options.description             = desc;
+    options.on_thread_start_functor = [resources = m_thread_resources, desc, cpus](std::size_t idx) {
+        resources->initialize_thread(desc, CpuSet(cpus.at(idx)));
+    };
+    options.on_thread_stop_functor = [resources = m_thread_resources, cpus](std::size_t idx) {
+        resources->finalize_thread(CpuSet(cpus.at(idx)));
+    };
+
+    return std::make_shared<coroutines::ThreadPool>(std::move(options));
+}
+
 void Resources::register_thread_local_initializer(const CpuSet& cpu_set, std::function<void()> initializer)
 {
     CHECK(initializer);
@@ -35,6 +35,10 @@
 #include <string>
 #include <utility>
 
+namespace mrc::coroutines {
+class ThreadPool;
+}  // namespace mrc::coroutines
+
 namespace mrc::internal::system {
 class FiberTaskQueue;
 class IResources;
@@ -55,6 +59,14 @@ class Resources final : public SystemProvider
     [[nodiscard]] Thread make_thread(std::string desc, CpuSet cpu_affinity, CallableT&& callable) const;
 
     FiberPool make_fiber_pool(const CpuSet& cpu_set) const;
+
+    /**
+     * @brief coroutines::ThreadPool with an executor thread per logical cpu of cpu_set
+     *
+     * Like the threads of make_thread, each executor thread is pinned to its logical cpu, binds its memory to the numa
+     * node of the cpu and runs the thread local initializers and finalizers registered for the cpu.
+     */
+    std::shared_ptr<coroutines::ThreadPool> make_coroutine_thread_pool(std::string desc, const CpuSet& cpu_set) const;
     FiberTaskQueue& get_task_queue(std::uint32_t cpu_id) const;
 
     template <typename ResourceT>
@@ -36,6 +36,7 @@
 
 namespace mrc::internal::system {
 
+class Resources;
 class ThreadResources;
 
 /**
@@ -87,6 +88,9 @@ class ThreadResources final : private SystemProvider, public std::enable_shared_
     std::multimap<int, std::function<void()>> m_thread_initializers;
     std::multimap<int, std::function<void()>> m_thread_finalizers;
     mutable std::atomic<bool> m_cap_membind{true};
+
+    // initializes the executor threads of coroutine thread pools, which are not spawned by make_thread
+    friend Resources;
 };
 
 template <typename CallableT>
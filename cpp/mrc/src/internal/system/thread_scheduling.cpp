@@ -0,0 +1,208 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2021-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "internal/system/thread_scheduling.hpp"
+
+#include "internal/system/engine_factory_cpu_sets.hpp"
+#include "internal/system/host_partition.hpp"
+#include "internal/system/partitions.hpp"
+#include "internal/system/resources.hpp"
+#include "internal/system/system.hpp"
+
+#include "mrc/core/bitmap.hpp"
+#include "mrc/exceptions/runtime_error.hpp"
+#include "mrc/options/engine_groups.hpp"
+#include "mrc/options/options.hpp"
+
+#include <glog/logging.h>
+#include <pthread.h>
+#include <sched.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstring>
+#include <map>
+#include <optional>
+#include <string>
+
+namespace mrc::internal::system {
+
+namespace {
+
+bool is_realtime(ThreadSchedulingPolicy policy)
+{
+    return policy == ThreadSchedulingPolicy::Fifo || policy == ThreadSchedulingPolicy::RoundRobin;
+}
+
+int native_policy(ThreadSchedulingPolicy policy)
+{
+    switch (policy)
+    {
+    case ThreadSchedulingPolicy::Fifo:
+        return SCHED_FIFO;
+    case ThreadSchedulingPolicy::RoundRobin:
+        return SCHED_RR;
+    case ThreadSchedulingPolicy::Batch:
+        return SCHED_BATCH;
+    case ThreadSchedulingPolicy::Idle:
+        return SCHED_IDLE;
+    default:
+        return SCHED_OTHER;
+    }
+}
+
+void validate(const std::string& name, const ThreadSchedulingOptions& scheduling)
+{
+    if (is_realtime(scheduling.policy))
+    {
+        auto policy = native_policy(scheduling.policy);
+        if (scheduling.priority < sched_get_priority_min(policy) ||
+            scheduling.priority > sched_get_priority_max(policy))
+        {
+            throw exceptions::MrcRuntimeError("invalid real-time priority " + std::to_string(scheduling.priority) +
+                                              " for the threads of " + name);
+        }
+    }
+    if (scheduling.nice < -20 || scheduling.nice > 19)
+    {
+        throw exceptions::MrcRuntimeError("invalid nice level " + std::to_string(scheduling.nice) +
+                                          " for the threads of " + name);
+    }
+}
+
+void register_scheduling(Resources& resources,
+                         const std::string& name,
+                         const CpuSet& cpu_set,
+                         const ThreadSchedulingOptions& scheduling)
+{
+    VLOG(1) << "applying the scheduling options of " << name << " to the threads of cpus " << cpu_set.str();
+    resources.register_thread_local_initializer(cpu_set, [scheduling] { set_current_thread_scheduling(scheduling); });
+}
+
+std::optional<CpuSet> group_cpu_set(const EngineFactoryCpuSets& cpu_sets, const std::string& name)
+{
+    if (auto search = cpu_sets.fiber_cpu_sets.find(name); search != cpu_sets.fiber_cpu_sets.end())
+    {
+        return search->second;
+    }
+    if (auto search = cpu_sets.thread_cpu_sets.find(name); search != cpu_sets.thread_cpu_sets.end())
+    {
+        return search->second;
+    }
+    return std::nullopt;
+}
+
+}  // namespace
+
+bool set_current_thread_scheduling(const ThreadSchedulingOptions& scheduling)
+{
+    if (scheduling.policy != ThreadSchedulingPolicy::Default)
+    {
+        sched_param param{};
+        param.sched_priority = (is_realtime(scheduling.policy) ? scheduling.priority : 0);
+
+        auto rc = pthread_setschedparam(pthread_self(), native_policy(scheduling.policy), &param);
+        if (rc != 0)
+        {
+            LOG(WARNING) << "unable to set the scheduling policy of a thread: " << std::strerror(rc)
+                         << "; real-time policies require CAP_SYS_NICE";
+            return false;
+        }
+    }
+
+    // the nice level is a per-thread attribute on linux; it has no effect on real-time threads
+    if (scheduling.nice != 0 && !is_realtime(scheduling.policy))
+    {
+        auto tid = static_cast<id_t>(::syscall(SYS_gettid));
+        if (::setpriority(PRIO_PROCESS, tid, scheduling.nice) != 0)
+        {
+            LOG(WARNING) << "unable to set the nice level of a thread to " << scheduling.nice << ": "
+                         << std::strerror(errno) << "; negative nice levels require CAP_SYS_NICE";
+            return false;
+        }
+    }
+
+    return true;
+}
+
+void register_engine_group_scheduling(Resources& resources)
+{
+    const auto& groups  = resources.system().options().engine_factories();
+    const auto& network = groups.network_thread_scheduling();
+
+    for (const auto& [name, group] : groups.map())
+    {
+        if (!group.scheduling.is_default())
+        {
+            validate("engine group " + name, group.scheduling);
+        }
+    }
+
+    if (!network.is_default())
+    {
+        validate("network threads", network);
+        if (groups.network_thread_placement() == NetworkThreadPlacement::Main)
+        {
+            LOG(WARNING) << "network threads share the logical cpu of main; their scheduling options are not applied";
+        }
+    }
+
+    // with a shared network thread, every host partition names the same logical cpu
+    CpuSet network_cpus;
+
+    for (const auto& host_partition : resources.system().partitions().host_partitions())
+    {
+        const auto& cpu_sets = host_partition.engine_factory_cpu_sets();
+
+        for (const auto& [name, group] : groups.map())
+        {
+            if (group.scheduling.is_default())
+            {
+                continue;
+            }
+
+            auto cpu_set = group_cpu_set(cpu_sets, name);
+            if (!cpu_set)
+            {
+                continue;
+            }
+
+            if (group.allow_overlap || !cpu_set->set_intersect(cpu_sets.shared_cpus_set).empty())
+            {
+                LOG(WARNING) << "engine group " << name
+                             << " shares its logical cpus with other groups; its scheduling options are not applied";
+                continue;
+            }
+
+            register_scheduling(resources, "engine group " + name, *cpu_set, group.scheduling);
+        }
+
+        if (!network.is_default() && groups.network_thread_placement() != NetworkThreadPlacement::Main)
+        {
+            auto cpu_set = group_cpu_set(cpu_sets, "mrc_network");
+            if (cpu_set && !network_cpus.contains(*cpu_set))
+            {
+                network_cpus.append(*cpu_set);
+                register_scheduling(resources, "network threads", *cpu_set, network);
+            }
+        }
+    }
+}
+
+}  // namespace mrc::internal::system
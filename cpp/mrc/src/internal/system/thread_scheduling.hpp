@@ -0,0 +1,46 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2021-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+namespace mrc {
+struct ThreadSchedulingOptions;
+}  // namespace mrc
+
+namespace mrc::internal::system {
+
+class Resources;
+
+/**
+ * @brief Apply the os scheduling policy, priority and nice level to the calling thread
+ *
+ * @return false if the os refused the change, e.g. a real-time policy without CAP_SYS_NICE; the thread keeps its
+ * previous scheduling in that case
+ */
+bool set_current_thread_scheduling(const ThreadSchedulingOptions& scheduling);
+
+/**
+ * @brief Register thread local initializers applying the scheduling options of the engine groups, and of the network
+ * threads, to the threads of their logical cpus
+ *
+ * Both the fiber threads already running on those cpus and the threads created on them later are updated. Groups whose
+ * logical cpus are shared with other groups are skipped with a warning, as would be the network threads if they share
+ * the logical cpu of main.
+ */
+void register_engine_group_scheduling(Resources& resources);
+
+}  // namespace mrc::internal::system
@@ -31,22 +31,337 @@
 #include <hwloc/bitmap.h>
 #include <hwloc/nvml.h>
 #include <nvml.h>
+#include <unistd.h>
 
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
 #include <cstdio>
+#include <cstdlib>
 #include <cstring>
+#include <fstream>
+#include <limits>
+#include <optional>
 #include <ostream>
 #include <set>
+#include <sstream>
 #include <string>
 #include <utility>
-
-// work-around for known iwyu issue
-// https://github.com/include-what-you-use/include-what-you-use/issues/908
-// IWYU pragma: no_include <algorithm>
+#include <vector>
 
 // Topology
 
 namespace mrc::internal::system {
 
+namespace {
+
+/**
+ * @brief names of the OpenFabrics devices with the fewest hops to the pci device with bus id pcie_bus_id, i.e. those
+ * behind the same pcie switch before those behind the same host bridge before those on the same package
+ */
+std::vector<std::string> nearest_nics(hwloc_topology_t io_topology, const std::string& pcie_bus_id)
+{
+    std::vector<std::string> nics;
+
+    auto* device = hwloc_get_pcidev_by_busidstring(io_topology, pcie_bus_id.c_str());
+    if (device == nullptr)
+    {
+        return nics;
+    }
+
+    std::vector<hwloc_obj_t> device_ancestors;
+    for (auto* obj = device; obj != nullptr; obj = obj->parent)
+    {
+        device_ancestors.push_back(obj);
+    }
+
+    // hops from obj up to its first common ancestor with the device plus the hops from there down to the device
+    auto hops_to_device = [&device_ancestors](hwloc_obj_t obj) {
+        for (std::size_t up = 0; obj != nullptr; obj = obj->parent, ++up)
+        {
+            for (std::size_t down = 0; down < device_ancestors.size(); ++down)
+            {
+                if (device_ancestors[down] == obj)
+                {
+                    return up + down;
+                }
+            }
+        }
+        return std::numeric_limits<std::size_t>::max();
+    };
+
+    auto nearest = std::numeric_limits<std::size_t>::max();
+    for (auto* osdev = hwloc_get_next_osdev(io_topology, nullptr); osdev != nullptr;
+         osdev       = hwloc_get_next_osdev(io_topology, osdev))
+    {
+        if (osdev->attr->osdev.type != HWLOC_OBJ_OSDEV_OPENFABRICS || osdev->name == nullptr)
+        {
+            continue;
+        }
+
+        auto hops = hops_to_device(osdev);
+        if (hops < nearest)
+        {
+            nearest = hops;
+            nics.clear();
+        }
+        if (hops == nearest && hops != std::numeric_limits<std::size_t>::max())
+        {
+            nics.emplace_back(osdev->name);
+        }
+    }
+
+    return nics;
+}
+
+std::string export_xml_string(hwloc_topology_t topology)
+{
+    char* buffer = nullptr;
+    int length   = 0;
+
+    CHECK_HWLOC(hwloc_topology_export_xmlbuffer(topology, &buffer, &length, 0));
+
+    std::string xml;
+    xml.resize(length);
+    std::memcpy(xml.data(), buffer, length);
+    hwloc_free_xmlbuffer(topology, buffer);
+
+    return xml;
+}
+
+// identifies the host, boot and set of visible devices a topology was discovered on; a cached topology is only reused
+// when its fingerprint matches, so that hardware changes, which require a reboot, or a different CUDA_VISIBLE_DEVICES
+// trigger a new discovery
+std::string host_fingerprint()
+{
+    std::array<char, 256> hostname{};
+    gethostname(hostname.data(), hostname.size() - 1);
+
+    std::string boot_id;
+    std::ifstream boot_id_file("/proc/sys/kernel/random/boot_id");
+    std::getline(boot_id_file, boot_id);
+
+    const auto* visible_devices = std::getenv("CUDA_VISIBLE_DEVICES");
+
+    std::stringstream ss;
+    ss << "host=" << hostname.data() << ";boot=" << boot_id << ";hwloc=" << HWLOC_API_VERSION
+       << ";cuda_visible_devices=" << (visible_devices != nullptr ? visible_devices : "<unset>");
+    return ss.str();
+}
+
+std::optional<protos::Topology> load_cached_topology(const std::string& path)
+{
+    std::ifstream file(path, std::ios::binary);
+    if (!file)
+    {
+        VLOG(1) << "no cached topology found at " << path << "; discovering the topology";
+        return std::nullopt;
+    }
+
+    protos::Topology msg;
+    if (!msg.ParseFromIstream(&file))
+    {
+        LOG(WARNING) << "unable to parse the cached topology at " << path << "; discovering the topology";
+        return std::nullopt;
+    }
+
+    if (msg.fingerprint() != host_fingerprint())
+    {
+        VLOG(1) << "cached topology at " << path << " was discovered on " << msg.fingerprint()
+                << "; discovering the topology";
+        return std::nullopt;
+    }
+
+    VLOG(1) << "using cached topology from " << path;
+    return msg;
+}
+
+// the cache is written to a temporary file which is renamed into place, so concurrent processes never read a partial
+// cache; failing to write the cache is not an error
+void store_cached_topology(const std::string& path, hwloc_topology_t topology, const std::map<int, GpuInfo>& gpus)
+{
+    protos::Topology msg;
+    msg.set_hwloc_xml_string(export_xml_string(topology));
+    msg.set_cpu_set(CpuSet(hwloc_topology_get_complete_cpuset(topology)).str());
+    msg.set_fingerprint(host_fingerprint());
+    for (const auto& [id, info] : gpus)
+    {
+        *msg.add_gpu_info() = info.serialize();
+    }
+
+    auto tmp_path = path + ".tmp." + std::to_string(getpid());
+    {
+        std::ofstream file(tmp_path, std::ios::binary | std::ios::trunc);
+        if (!file || !msg.SerializeToOstream(&file))
+        {
+            LOG(WARNING) << "unable to write the topology cache to " << tmp_path;
+            std::remove(tmp_path.c_str());
+            return;
+        }
+    }
+
+    if (std::rename(tmp_path.c_str(), path.c_str()) != 0)
+    {
+        LOG(WARNING) << "unable to move the topology cache into place at " << path;
+        std::remove(tmp_path.c_str());
+        return;
+    }
+
+    VLOG(1) << "cached the discovered topology at " << path;
+}
+
+// ratio of the quota to the period of a cpu bandwidth limit; empty if either is not positive, e.g. for an unlimited
+// cgroup v1 quota of -1
+std::optional<double> quota_ratio(double quota, double period)
+{
+    if (quota <= 0 || period <= 0)
+    {
+        return std::nullopt;
+    }
+    return quota / period;
+}
+
+/**
+ * @brief number of cpus, possibly fractional, granted to the process by the cpu bandwidth controller; empty if the
+ * process is not limited
+ *
+ * With cgroup v2, the cpu.max of the cgroup of the process and of all its ancestors is read and the most restrictive
+ * limit is returned. Otherwise the cgroup v1 cfs quota at the root of the cpu controller is read, which is the cgroup
+ * of the process from within a container.
+ */
+std::optional<double> cgroup_cpu_quota()
+{
+    std::optional<double> limit;
+    auto update = [&limit](std::optional<double> ratio) {
+        if (ratio && (!limit || *ratio < *limit))
+        {
+            limit = ratio;
+        }
+    };
+
+    std::string cgroup_path;
+    std::ifstream cgroups("/proc/self/cgroup");
+    for (std::string line; std::getline(cgroups, line);)
+    {
+        // the unified hierarchy is listed as "0::<path>"
+        if (line.rfind("0::", 0) == 0)
+        {
+            cgroup_path = line.substr(3);
+        }
+    }
+
+    bool found_v2 = false;
+    if (!cgroup_path.empty())
+    {
+        if (cgroup_path == "/")
+        {
+            cgroup_path.clear();
+        }
+        while (true)
+        {
+            // "<quota> <period>" or "max <period>"
+            std::ifstream file("/sys/fs/cgroup" + cgroup_path + "/cpu.max");
+            std::string quota;
+            double period = 0;
+            if (file >> quota >> period)
+            {
+                found_v2 = true;
+                if (quota != "max")
+                {
+                    update(quota_ratio(std::strtod(quota.c_str(), nullptr), period));
+                }
+            }
+            if (cgroup_path.empty())
+            {
+                break;
+            }
+            cgroup_path = cgroup_path.substr(0, cgroup_path.rfind('/'));
+        }
+    }
+
+    if (!found_v2)
+    {
+        std::ifstream quota_file("/sys/fs/cgroup/cpu/cpu.cfs_quota_us");
+        std::ifstream period_file("/sys/fs/cgroup/cpu/cpu.cfs_period_us");
+        double quota  = 0;
+        double period = 0;
+        if (quota_file >> quota && period_file >> period)
+        {
+            update(quota_ratio(quota, period));
+        }
+    }
+
+    return limit;
+}
+
+/**
+ * @brief logical cpus removed from the general scheduler with the isolcpus kernel parameter
+ */
+Bitmap isolated_cpus()
+{
+    std::ifstream file("/sys/devices/system/cpu/isolated");
+    std::string cpustr;
+    if (!std::getline(file, cpustr) || cpustr.empty())
+    {
+        return {};
+    }
+    return {cpustr};
+}
+
+/**
+ * @brief the first count logical cpus of cpu_set in the order of the topology, taking one logical cpu of each core
+ * before any of their hyper-thread siblings
+ */
+Bitmap limit_cpu_count(hwloc_topology_t topology, const Bitmap& cpu_set, std::size_t count)
+{
+    std::vector<std::vector<std::uint32_t>> cores;
+    hwloc_obj_t core = nullptr;
+    while ((core = hwloc_get_next_obj_inside_cpuset_by_type(topology, &cpu_set.bitmap(), HWLOC_OBJ_CORE, core)) !=
+           nullptr)
+    {
+        cores.push_back(cpu_set.set_intersect(Bitmap(core->cpuset)).vec());
+    }
+
+    Bitmap limited;
+    std::size_t selected = 0;
+    for (std::size_t sibling = 0; selected < count; sibling++)
+    {
+        bool remaining = false;
+        for (const auto& pus : cores)
+        {
+            if (sibling < pus.size() && selected < count)
+            {
+                limited.on(pus[sibling]);
+                selected++;
+                remaining = true;
+            }
+        }
+        if (!remaining)
+        {
+            break;
+        }
+    }
+
+    // logical cpus outside of any core, if the topology has none
+    for (auto cpu : cpu_set.vec())
+    {
+        if (selected >= count)
+        {
+            break;
+        }
+        if (!limited.is_set(cpu))
+        {
+            limited.on(cpu);
+            selected++;
+        }
+    }
+
+    return limited;
+}
+
+}  // namespace
+
 std::shared_ptr<Topology> Topology::Create()
 {
     TopologyOptions options;
@@ -55,11 +370,20 @@ std::shared_ptr<Topology> Topology::Create()
 
 std::shared_ptr<Topology> Topology::Create(const TopologyOptions& options)
 {
-    hwloc_topology_t system_topology;
-    Bitmap cpu_set;
+    std::optional<protos::Topology> cached;
+    if (!options.cache_path().empty())
+    {
+        cached = load_cached_topology(options.cache_path());
+    }
 
-    CHECK_HWLOC(hwloc_topology_init(&system_topology));
-    CHECK_HWLOC(hwloc_topology_load(system_topology));
+    auto [system_topology, gpu_info] = (cached ? Topology::Deserialize(*cached, true) : Topology::Discover());
+
+    if (!cached && !options.cache_path().empty())
+    {
+        store_cached_topology(options.cache_path(), system_topology, gpu_info);
+    }
+
+    Bitmap cpu_set;
 
     // use cpu_set of the process (default) or not
     if (options.use_process_cpuset())
@@ -73,10 +397,55 @@ std::shared_ptr<Topology> Topology::Create(const TopologyOptions& options)
         cpu_set = Topology::cpuset_for_object(system_topology, HWLOC_OBJ_MACHINE, 0);
     }
 
+    // isolated cpus are only kept if the process was explicitly bound to them
+    if (options.exclude_isolated_cpus())
+    {
+        auto isolated = isolated_cpus();
+        auto shared   = cpu_set;
+        for (auto cpu : isolated.vec())
+        {
+            shared.off(cpu);
+        }
+        if (!shared.empty() && shared.weight() != cpu_set.weight())
+        {
+            VLOG(1) << "excluding the isolated cpus " << isolated.str() << " from the topology";
+            cpu_set = std::move(shared);
+        }
+    }
+
+    // a fractional quota is rounded down so the pools sized by the topology do not oversubscribe it and get throttled
+    std::size_t cpu_limit = 0;
+    if (options.use_cpu_quota())
+    {
+        if (auto quota = cgroup_cpu_quota())
+        {
+            cpu_limit = std::max<std::size_t>(1, static_cast<std::size_t>(*quota));
+            VLOG(1) << "cgroup cpu quota of " << *quota << " cpus limits the topology to " << cpu_limit
+                    << " logical cpus";
+        }
+    }
+
+    return Topology::Create(options, system_topology, cpu_set, std::move(gpu_info), cpu_limit);
+}
+
+std::pair<hwloc_topology_t, std::map<int, GpuInfo>> Topology::Discover()
+{
+    hwloc_topology_t system_topology;
+
+    CHECK_HWLOC(hwloc_topology_init(&system_topology));
+    CHECK_HWLOC(hwloc_topology_load(system_topology));
+
     // auto gpu_count                 = DeviceInfo::();
     auto accessible_device_indexes = DeviceInfo::AccessibleDeviceIndexes();
     std::map<int, GpuInfo> gpu_info;  // GpuInfo indexed by CUDA Device ID
 
+    // the system topology is loaded without i/o objects; a second topology with pci and os devices is used to find the
+    // nics closest to each gpu
+    hwloc_topology_t io_topology;
+    CHECK_HWLOC(hwloc_topology_init(&io_topology));
+    CHECK_HWLOC(hwloc_topology_set_io_types_filter(io_topology, HWLOC_TYPE_FILTER_KEEP_IMPORTANT));
+    CHECK_HWLOC(hwloc_topology_load(io_topology));
+
     for (const auto& i : accessible_device_indexes)
     {
         GpuInfo info;
@@ -91,6 +460,9 @@ std::shared_ptr<Topology> Topology::Create(const TopologyOptions& options)
 
         auto v        = info.cpu_set().vec();
         info.m_cpustr = print_ranges(find_ranges(v));
+        info.m_nics   = nearest_nics(io_topology, info.m_pcie_bus_id);
+
+        info.m_nvlink_peers = DeviceInfo::NvLinkPeers(i);
 
         // lastly, determine the cuda device id
         auto cuda_rc = cudaDeviceGetByPCIBusId(&info.m_cuda_device_id, info.m_pcie_bus_id.c_str());
@@ -103,8 +475,9 @@ std::shared_ptr<Topology> Topology::Create(const TopologyOptions& options)
 
         gpu_info[info.cuda_device_id()] = std::move(info);
     }
+    hwloc_topology_destroy(io_topology);
 
-    return Topology::Create(options, system_topology, cpu_set, std::move(gpu_info));
+    return std::make_pair(system_topology, std::move(gpu_info));
 }
 
 std::shared_ptr<Topology> Topology::Create(const TopologyOptions& options, const protos::Topology& msg)
@@ -117,7 +490,8 @@ std::shared_ptr<Topology> Topology::Create(const TopologyOptions& options, const
 std::shared_ptr<Topology> Topology::Create(const TopologyOptions& options,
                                            hwloc_topology_t system_topology,
                                            Bitmap topo_cpu_set,
-                                           std::map<int, GpuInfo> gpus)
+                                           std::map<int, GpuInfo> gpus,
+                                           std::size_t cpu_limit)
 {
     hwloc_topology_t topology;
 
@@ -148,6 +522,17 @@ std::shared_ptr<Topology> Topology::Create(const TopologyOptions& options,
         topo_cpu_set = std::move(intersection);
     }
 
+    // bound the number of logical cpus by the cpu quota and the user limit, whichever is lower
+    if (options.max_cpu_count() > 0 && (cpu_limit == 0 || options.max_cpu_count() < cpu_limit))
+    {
+        cpu_limit = options.max_cpu_count();
+    }
+    if (cpu_limit > 0 && static_cast<std::size_t>(topo_cpu_set.weight()) > cpu_limit)
+    {
+        topo_cpu_set = limit_cpu_count(system_topology, topo_cpu_set, cpu_limit);
+        VLOG(1) << "topology limited to " << cpu_limit << " logical cpus: " << topo_cpu_set.str();
+    }
+
     // restrict topology to the topo cpu_set
     CHECK_HWLOC(hwloc_topology_restrict(topology, &topo_cpu_set.bitmap(), restrict_numa_flag));
     CHECK_HWLOC(hwloc_topology_refresh(topology));
@@ -192,11 +577,16 @@ std::shared_ptr<Topology> Topology::Create(const protos::Topology& msg)
     return std::shared_ptr<Topology>(new Topology(topology, std::move(cpu_set), std::move(gpus)));
 }
 
-std::pair<hwloc_topology_t, std::map<int, GpuInfo>> Topology::Deserialize(const protos::Topology& msg)
+std::pair<hwloc_topology_t, std::map<int, GpuInfo>> Topology::Deserialize(const protos::Topology& msg, bool this_system)
 {
     hwloc_topology_t topology;
     CHECK_HWLOC(hwloc_topology_init(&topology));
     CHECK_HWLOC(hwloc_topology_set_xmlbuffer(topology, msg.hwloc_xml_string().data(), msg.hwloc_xml_string().size()));
+    if (this_system)
+    {
+        // a topology cached on this host describes the running system, so binding queries and calls are honored
+        CHECK_HWLOC(hwloc_topology_set_flags(topology, HWLOC_TOPOLOGY_FLAG_IS_THISSYSTEM));
+    }
     CHECK_HWLOC(hwloc_topology_load(topology));
 
     std::map<int, GpuInfo> gpu_info;
@@ -229,6 +619,18 @@ Topology::Topology(hwloc_topology_t topology, CpuSet&& cpu_set, std::map<int, Gp
         auto* obj = hwloc_get_obj_by_type(m_topology, HWLOC_OBJ_NUMANODE, i);
         m_numa_cpusets.emplace_back(obj->cpuset);
     }
+
+    // collect last-level cache domains
+    auto cache_count = hwloc_get_nbobjs_by_type(m_topology, HWLOC_OBJ_L3CACHE);
+    for (int i = 0; i < cache_count; i++)
+    {
+        auto* obj = hwloc_get_obj_by_type(m_topology, HWLOC_OBJ_L3CACHE, i);
+        m_cache_domain_cpusets.emplace_back(obj->cpuset);
+    }
+    if (m_cache_domain_cpusets.empty())
+    {
+        m_cache_domain_cpusets = m_numa_cpusets;
+    }
 }
 
 Topology::~Topology()
@@ -296,6 +698,15 @@ const CpuSet& Topology::numa_cpuset(std::uint32_t id) const
     CHECK_LT(id, m_numa_cpusets.size());
     return m_numa_cpusets.at(id);
 }
+const CpuSet& Topology::cache_domain_cpuset(std::uint32_t id) const
+{
+    CHECK_LT(id, m_cache_domain_cpusets.size());
+    return m_cache_domain_cpusets.at(id);
+}
+std::uint32_t Topology::cache_domain_count() const
+{
+    return m_cache_domain_cpusets.size();
+}
 
 std::uint32_t Topology::object_count_at_depth(int depth) const
 {
@@ -335,16 +746,7 @@ Bitmap& Topology::topo_bitset()
 }
 std::string Topology::export_xml() const
 {
-    char* buffer = nullptr;
-    int length   = 0;
-
-    CHECK_HWLOC(hwloc_topology_export_xmlbuffer(m_topology, &buffer, &length, 0));
-
-    std::string xml;
-    xml.resize(length);
-    std::memcpy(xml.data(), buffer, length);
-
-    return xml;
+    return export_xml_string(m_topology);
 }
 protos::Topology Topology::serialize() const
 {
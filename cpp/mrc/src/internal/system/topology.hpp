@@ -26,6 +26,7 @@
 #include <glog/logging.h>
 #include <hwloc.h>
 
+#include <cstddef>
 #include <cstdint>
 #include <map>
 #include <memory>
@@ -59,9 +60,17 @@ class Topology final
     static std::shared_ptr<Topology> Create(const TopologyOptions& options,    // NOLINT
                                             hwloc_topology_t system_topology,  // NOLINT
                                             Bitmap cpu_set,
-                                            std::map<int, GpuInfo>);
+                                            std::map<int, GpuInfo>,
+                                            std::size_t cpu_limit = 0);
+
+    static std::pair<hwloc_topology_t, std::map<int, GpuInfo>> Deserialize(const protos::Topology& msg,  // NOLINT
+                                                                           bool this_system = false);
+
+    /**
+     * @brief discover the hardware topology of the machine and the accessible gpus
+     */
+    static std::pair<hwloc_topology_t, std::map<int, GpuInfo>> Discover();  // NOLINT
 
-    static std::pair<hwloc_topology_t, std::map<int, GpuInfo>> Deserialize(const protos::Topology& msg);  // NOLINT
     virtual ~Topology();
 
     DELETE_COPYABILITY(Topology);
@@ -82,6 +91,22 @@ class Topology final
      */
     const CpuSet& numa_cpuset(std::uint32_t id) const;
 
+    /**
+     * @brief CpuSet for the last-level cache domain id in the requested topology, e.g. an L3 cache shared by the cores
+     * of a CCX on chiplet cpus; numa nodes are used as cache domains if the topology reports no L3 caches
+     *
+     * @param id
+     * @return const CpuSet&
+     */
+    const CpuSet& cache_domain_cpuset(std::uint32_t id) const;
+
+    /**
+     * @brief number of last-level cache domains in the requested topology
+     *
+     * @return std::uint32_t
+     */
+    std::uint32_t cache_domain_count() const;
+
     /**
      * @brief number of cores in the requested topology
      *
@@ -204,6 +229,7 @@ class Topology final
     int m_depth_cpu;
     int m_depth_numa;
     std::vector<CpuSet> m_numa_cpusets;
+    std::vector<CpuSet> m_cache_domain_cpusets;
     std::map<int, GpuInfo> m_gpu_info;
 };
 
@@ -22,15 +22,55 @@
 #include <ucp/api/ucp_def.h>
 #include <ucs/type/status.h>  // for ucs_status_string, UCS_OK
 
+#include <cstdlib>  // for getenv
 #include <cstring>
 #include <new>        // for bad_alloc
 #include <ostream>    // for logging
 #include <stdexcept>  // for runtime_error
-#include <tuple>      // for make_tuple, tuple
+#include <string>
+#include <tuple>  // for make_tuple, tuple
 
 namespace mrc::internal::ucx {
 
-Context::Context()
+namespace {
+
+void modify_config(ucp_config_t* cfg, const std::string& name, const std::string& value)
+{
+    // ucx variables set explicitly in the environment take precedence
+    if (std::getenv(("UCX_" + name).c_str()) != nullptr)
+    {
+        return;
+    }
+
+    auto status = ucp_config_modify(cfg, name.c_str(), value.c_str());
+    if (status != UCS_OK)
+    {
+        LOG(WARNING) << "ucp_config_modify " << name << "=" << value << " failed: " << ucs_status_string(status);
+    }
+}
+
+}  // namespace
+
+Context::Context(const NetworkOptions& options, const std::vector<std::string>& net_devices) :
+  m_wakeup_enabled(options.enable_progress_engine_wakeup()),
+  m_transport(options.transport())
+{
+    if (m_transport == NetworkTransport::Tcp)
+    {
+        // the nics of a gpu are usually rdma devices and not tcp interfaces
+        init(options, {}, true);
+        return;
+    }
+
+    if (!init(options, net_devices, false))
+    {
+        LOG(WARNING) << "ucx could not be initialized with its default transports; falling back to tcp";
+        m_transport = NetworkTransport::Tcp;
+        init(options, {}, true);
+    }
+}
+
+bool Context::init(const NetworkOptions& options, const std::vector<std::string>& net_devices, bool tcp_only)
 {
     ucp_config_t* cfg = nullptr;
     ucp_params_t ucp_params;
@@ -43,21 +83,56 @@ Context::Context()
         throw std::runtime_error("ucp_config_read failed");
     }
 
+    if (tcp_only)
+    {
+        // ucx sends over tcp with scatter/gather io, loopback within a worker uses self and device memory is copied
+        // with cuda_copy
+        VLOG(1) << "restricting ucx transports to tcp";
+        modify_config(cfg, "TLS", "tcp,self,cuda_copy");
+    }
+
+    if (!net_devices.empty())
+    {
+        std::string devices;
+        for (const auto& device : net_devices)
+        {
+            devices += (devices.empty() ? "" : ",") + device + ":1";
+        }
+        VLOG(1) << "restricting ucx network devices to " << devices;
+        modify_config(cfg, "NET_DEVICES", devices);
+    }
+
+    if (options.max_rails() > 0)
+    {
+        modify_config(cfg, "MAX_RNDV_RAILS", std::to_string(options.max_rails()));
+        modify_config(cfg, "MAX_RMA_RAILS", std::to_string(options.max_rails()));
+    }
+
     // UCP initialization
     ucp_params.field_mask = UCP_PARAM_FIELD_FEATURES;  // | UCP_PARAM_FIELD_MT_WORKERS_SHARED;
 
     // add rdma and am flags here
     ucp_params.features = UCP_FEATURE_TAG | UCP_FEATURE_AM | UCP_FEATURE_RMA;
+    if (m_wakeup_enabled)
+    {
+        ucp_params.features |= UCP_FEATURE_WAKEUP;
+    }
 
     // MT_WORKERS_SHARED could be true if the comms and event workers are on different threads
     // ucp_params.mt_workers_shared = 1;
 
     status = ucp_init(&ucp_params, cfg, &m_handle);
+    ucp_config_release(cfg);
     if (status != UCS_OK)
     {
         LOG(ERROR) << "ucp_init failed: " << ucs_status_string(status);
-        throw std::runtime_error("ucp_init failed");
+        if (tcp_only)
+        {
+            throw std::runtime_error("ucp_init failed");
+        }
+        return false;
     }
+    return true;
 }
 
 Context::~Context()
@@ -66,6 +141,16 @@ Context::~Context()
     ucp_cleanup(m_handle);
 }
 
+bool Context::wakeup_enabled() const
+{
+    return m_wakeup_enabled;
+}
+
+NetworkTransport Context::transport() const
+{
+    return m_transport;
+}
+
 ucp_mem_h Context::register_memory(const void* address, std::size_t length)
 {
     ucp_mem_map_params params;
@@ -19,24 +19,46 @@
 
 #include "internal/ucx/primitive.hpp"
 
+#include "mrc/options/network.hpp"
+
 #include <ucp/api/ucp_def.h>  // for ucp_mem_h, ucp_context_h
 
 #include <cstddef>  // for size_t
+#include <string>
 #include <tuple>
+#include <vector>
 
 namespace mrc::internal::ucx {
 
 class Context final : public Primitive<ucp_context_h>
 {
   public:
-    Context();
+    /**
+     * @param options - wakeup support is requested if progress engine wakeup is enabled; max_rails and transport are
+     * applied; with NetworkTransport::Auto, the context is initialized with tcp only if ucx fails to initialize with
+     * its default transports
+     * @param net_devices - network devices, e.g. mlx5_0, ucx is restricted to; empty for all devices
+     */
+    explicit Context(const NetworkOptions& options = {}, const std::vector<std::string>& net_devices = {});
     ~Context() override;
 
+    bool wakeup_enabled() const;
+
+    // transport the context was initialized with; Tcp if an Auto context fell back to tcp
+    NetworkTransport transport() const;
+
     ucp_mem_h register_memory(const void*, std::size_t);
 
     std::tuple<ucp_mem_h, void*, std::size_t> register_memory_with_rkey(const void*, std::size_t);
 
     void unregister_memory(ucp_mem_h, void* rbuffer = nullptr);
+
+  private:
+    // false if ucp_init failed with the default transports
+    bool init(const NetworkOptions& options, const std::vector<std::string>& net_devices, bool tcp_only);
+
+    bool m_wakeup_enabled;
+    NetworkTransport m_transport;
 };
 
 }  // namespace mrc::internal::ucx
@@ -20,6 +20,7 @@
 #include "internal/ucx/common.hpp"
 #include "internal/ucx/worker.hpp"
 
+#include "mrc/benchmarking/flight_recorder.hpp"
 #include "mrc/types.hpp"
 
 #include <boost/fiber/future/async.hpp>
@@ -34,10 +35,14 @@
 
 namespace mrc::internal::ucx {
 
-TaggedReceiveManager::TaggedReceiveManager(Handle<Worker> worker, ucp_tag_t tag, ucp_tag_t task_mask) :
+TaggedReceiveManager::TaggedReceiveManager(Handle<Worker> worker,
+                                           ucp_tag_t tag,
+                                           ucp_tag_t task_mask,
+                                           const NetworkOptions& options) :
   m_worker(std::move(worker)),
   m_tag(tag),
   m_tag_mask(task_mask),
+  m_idle_policy(*m_worker, options),
   m_running(false)
 {}
 
@@ -86,11 +91,17 @@ void TaggedReceiveManager::progress_engine()
             while (m_worker->progress() != 0U)
             {
                 backoff = 1;
+                m_idle_policy.reset();
             }
             if (!m_running)
             {
                 return;
             }
+            if (m_idle_policy.wait_if_idle())
+            {
+                boost::this_fiber::yield();
+                continue;
+            }
 
             if (backoff < 1048576)
             {
@@ -106,8 +117,12 @@ void TaggedReceiveManager::progress_engine()
             }
         }
 
+        benchmarking::FlightRecorder::record(benchmarking::FlightEventType::NetworkTaggedMessage,
+                                             msg_info.sender_tag,
+                                             static_cast<std::uint32_t>(msg_info.length));
         on_tagged_msg(msg, msg_info);
         backoff = 0;
+        m_idle_policy.reset();
     }
 }
 
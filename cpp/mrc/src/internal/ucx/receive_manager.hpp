@@ -19,6 +19,9 @@
 
 #include "internal/ucx/common.hpp"
 
+#include "internal/ucx/worker.hpp"
+
+#include "mrc/options/network.hpp"
 #include "mrc/types.hpp"
 
 #include <ucp/api/ucp_def.h>  // for ucp_tag_t, ucp_tag_message_h, ucp_tag_recv_info_t
@@ -26,14 +29,16 @@
 #include <memory>  // for enable_shared_from_this
 
 namespace mrc::internal::ucx {
-class Worker;
 
 class TaggedReceiveManager : public std::enable_shared_from_this<TaggedReceiveManager>
 {
     static constexpr ucp_tag_t MATCH_ALL_BITS = 0x0000000000000000;  // NOLINT
 
   public:
-    TaggedReceiveManager(Handle<Worker> worker, ucp_tag_t tag = 0, ucp_tag_t task_mask = MATCH_ALL_BITS);
+    TaggedReceiveManager(Handle<Worker> worker,
+                         ucp_tag_t tag                 = 0,
+                         ucp_tag_t task_mask           = MATCH_ALL_BITS,
+                         const NetworkOptions& options = {});
     virtual ~TaggedReceiveManager();
 
     WorkerAddress local_address();
@@ -57,6 +62,7 @@ class TaggedReceiveManager : public std::enable_shared_from_this<TaggedReceiveMa
     Handle<Worker> m_worker;
     ucp_tag_t m_tag;
     ucp_tag_t m_tag_mask;
+    IdlePolicy m_idle_policy;
 
     Future<void> m_shutdown_complete;
     mutable Mutex m_mutex;
@@ -22,10 +22,19 @@
 #include "internal/ucx/memory_block.hpp"
 
 #include <glog/logging.h>
+#include <ucp/api/ucp_def.h>
 
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <map>
 #include <memory>
 #include <mutex>
+#include <new>
 #include <optional>
+#include <unordered_map>
+#include <vector>
 
 namespace mrc::internal::ucx {
 
@@ -35,15 +44,40 @@ namespace mrc::internal::ucx {
  * UCX memory registration object that will both register/deregister memory as well as cache the set of local and remote
  * keys for each registration. The cache can be queried for the original memory block by providing any valid address
  * contained in the contiguous block.
+ *
+ * Blocks owned by the memory pools are added and dropped explicitly and are never evicted. Arbitrary buffers are
+ * registered on demand by acquire(): the page aligned range is coalesced with any cached registrations it overlaps or
+ * abuts, and released registrations are kept, up to max_cached_bytes, in least-recently-used order so that later
+ * acquisitions of any sub-range are served without a call to ucp_mem_map.
  */
 class RegistrationCache final
 {
+    static constexpr std::size_t PageSize = 4096;
+
   public:
-    RegistrationCache(std::shared_ptr<ucx::Context> context) : m_context(std::move(context))
+    RegistrationCache(std::shared_ptr<ucx::Context> context, std::size_t max_cached_bytes = 1UL << 30) :
+      m_context(std::move(context)),
+      m_max_cached_bytes(max_cached_bytes)
     {
         CHECK(m_context);
     }
 
+    ~RegistrationCache()
+    {
+        LOG_IF(WARNING, std::any_of(m_by_handle.begin(), m_by_handle.end(), [](const auto& it) {
+            return it.second->refs > 0;
+        })) << "destroying a registration cache with acquired registrations";
+
+        for (auto& registration : m_lru)
+        {
+            unregister(registration);
+        }
+        for (auto& registration : m_retired)
+        {
+            unregister(registration);
+        }
+    }
+
     /**
      * @brief Register a contiguous block of memory starting at addr and spanning `bytes` bytes.
      *
@@ -70,11 +104,13 @@ class RegistrationCache final
      */
     std::size_t drop_block(const void* addr, std::size_t bytes)
     {
-        const auto* block = m_blocks.find_block(addr);
+        std::lock_guard<decltype(m_mutex)> lock(m_mutex);
+        auto block = m_blocks.lookup(addr);
         CHECK(block);
         bytes = block->bytes();
-        m_context->unregister_memory(block->local_handle(), block->remote_handle());
+        // lookups do not take the lock, so the block is removed before it is unregistered
         m_blocks.drop_block(addr);
+        m_context->unregister_memory(block->local_handle(), block->remote_handle());
         return bytes;
     }
 
@@ -84,26 +120,225 @@ class RegistrationCache final
      * This method queries the registration cache to find the UcxMemoryBlock containing the original address and size as
      * well as the local and remote keys associated with the memory block.
      *
-     * Any address contained within a registered block can be used to query the UcxMemoryBlock
+     * Any address contained within a registered block can be used to query the UcxMemoryBlock. Only blocks added with
+     * add_block are considered; registrations made by acquire must be acquired.
      *
      * @param addr
      * @return const MemoryBlock&
      */
     std::optional<ucx::MemoryBlock> lookup(const void* addr) const noexcept
+    {
+        // served from the current snapshot of the block manager without taking the lock
+        return m_blocks.lookup(addr);
+    }
+
+    /**
+     * @brief Acquire a registration covering [addr, addr + bytes), registering the range if it is not yet covered.
+     *
+     * Blocks added with add_block are returned as is. Any other registration remains valid until it has been released
+     * with release(); the returned block may be larger than the requested range.
+     *
+     * @throws std::bad_alloc if the range could not be registered
+     */
+    ucx::MemoryBlock acquire(const void* addr, std::size_t bytes)
+    {
+        DCHECK(addr && bytes);
+        std::lock_guard<decltype(m_mutex)> lock(m_mutex);
+
+        const auto begin = reinterpret_cast<std::uintptr_t>(addr);
+        const auto end   = begin + bytes;
+
+        const auto* block = m_blocks.find_block(addr);
+        if (block != nullptr && end <= start_of(*block) + block->bytes())
+        {
+            return *block;
+        }
+
+        auto search = m_ranges.upper_bound(begin);
+        if (search != m_ranges.end() && start_of(search->second->block) <= begin && end <= search->first)
+        {
+            auto registration = search->second;
+            ++registration->refs;
+            m_lru.splice(m_lru.begin(), m_lru, registration);
+            return registration->block;
+        }
+
+        // coalesce the page aligned range with the cached registrations it overlaps or abuts; a coalesced range may
+        // span distinct allocations which cannot be registered together, e.g. of device memory, in which case only the
+        // requested range is registered, replacing the registrations it overlaps
+        auto lo = begin & ~(PageSize - 1);
+        auto hi = (end + PageSize - 1) & ~(PageSize - 1);
+        auto merged = overlapping(lo, hi, true);
+        for (const auto& it : merged)
+        {
+            lo = std::min(lo, start_of(it->block));
+            hi = std::max(hi, start_of(it->block) + it->block.bytes());
+        }
+
+        registration_t registration;
+        try
+        {
+            registration = register_range(lo, hi - lo);
+        } catch (const std::bad_alloc&)
+        {
+            lo           = begin;
+            hi           = end;
+            merged       = overlapping(lo, hi, false);
+            registration = register_range(lo, hi - lo);
+        }
+
+        for (const auto& it : merged)
+        {
+            retire(it);
+        }
+        registration->refs = 1;
+        m_ranges[hi]       = registration;
+
+        evict();
+        return registration->block;
+    }
+
+    /**
+     * @brief Release a registration returned by acquire; blocks added with add_block are ignored.
+     */
+    void release(const ucx::MemoryBlock& block)
     {
         std::lock_guard<decltype(m_mutex)> lock(m_mutex);
-        const auto* ptr = m_blocks.find_block(addr);
-        if (ptr == nullptr)
+        auto search = m_by_handle.find(block.local_handle());
+        if (search == m_by_handle.end())
         {
-            return std::nullopt;
+            return;
         }
-        return {*ptr};
+
+        auto registration = search->second;
+        CHECK_GT(registration->refs, 0);
+        if (--registration->refs == 0 && registration->retired)
+        {
+            erase(registration, m_retired);
+            return;
+        }
+        evict();
+    }
+
+    /**
+     * @brief Number of bytes registered by acquire which have not been deregistered.
+     */
+    std::size_t cached_bytes() const
+    {
+        std::lock_guard<decltype(m_mutex)> lock(m_mutex);
+        return m_cached_bytes;
+    }
+
+    /**
+     * @brief Number of registrations made by acquire which have not been deregistered.
+     */
+    std::size_t cached_registrations() const
+    {
+        std::lock_guard<decltype(m_mutex)> lock(m_mutex);
+        return m_by_handle.size();
     }
 
   private:
+    struct Registration
+    {
+        Registration(const void* addr, std::size_t bytes, ucp_mem_h lkey, void* rkey, std::size_t rkey_size) :
+          block(addr, bytes, lkey, rkey, rkey_size)
+        {}
+
+        ucx::MemoryBlock block;
+        std::size_t refs{0};
+        // replaced by a coalesced registration, but still acquired
+        bool retired{false};
+    };
+
+    using registration_t = std::list<Registration>::iterator;  // NOLINT
+
+    static std::uintptr_t start_of(const memory::MemoryBlock& block)
+    {
+        return reinterpret_cast<std::uintptr_t>(block.data());
+    }
+
+    // registers the range as the most recently used registration; it is not yet added to the ranges
+    registration_t register_range(std::uintptr_t addr, std::size_t bytes)
+    {
+        const auto* ptr              = reinterpret_cast<const void*>(addr);
+        auto [lkey, rkey, rkey_size] = m_context->register_memory_with_rkey(ptr, bytes);
+        m_lru.emplace_front(ptr, bytes, lkey, rkey, rkey_size);
+        m_by_handle[lkey] = m_lru.begin();
+        m_cached_bytes += bytes;
+        return m_lru.begin();
+    }
+
+    void unregister(Registration& registration)
+    {
+        m_context->unregister_memory(registration.block.local_handle(), registration.block.remote_handle());
+    }
+
+    // cached registrations overlapping [lo, hi), or also abutting it if abutting is true
+    std::vector<registration_t> overlapping(std::uintptr_t lo, std::uintptr_t hi, bool abutting) const
+    {
+        std::vector<registration_t> found;
+        auto it = abutting ? m_ranges.lower_bound(lo) : m_ranges.upper_bound(lo);
+        for (; it != m_ranges.end(); ++it)
+        {
+            auto start = start_of(it->second->block);
+            if (abutting ? start > hi : start >= hi)
+            {
+                break;
+            }
+            found.push_back(it->second);
+        }
+        return found;
+    }
+
+    // removes a registration from the ranges; it is deregistered once it is no longer acquired
+    void retire(registration_t registration)
+    {
+        m_ranges.erase(start_of(registration->block) + registration->block.bytes());
+        if (registration->refs == 0)
+        {
+            erase(registration, m_lru);
+            return;
+        }
+        registration->retired = true;
+        m_retired.splice(m_retired.begin(), m_lru, registration);
+    }
+
+    registration_t erase(registration_t registration, std::list<Registration>& list)
+    {
+        unregister(*registration);
+        m_cached_bytes -= registration->block.bytes();
+        m_by_handle.erase(registration->block.local_handle());
+        return list.erase(registration);
+    }
+
+    // deregisters the least recently used registrations which are not acquired until within budget
+    void evict()
+    {
+        auto it = m_lru.end();
+        while (m_cached_bytes > m_max_cached_bytes && it != m_lru.begin())
+        {
+            --it;
+            if (it->refs == 0)
+            {
+                m_ranges.erase(start_of(it->block) + it->block.bytes());
+                it = erase(it, m_lru);
+            }
+        }
+    }
+
     mutable std::mutex m_mutex;
     const std::shared_ptr<ucx::Context> m_context;
     memory::BlockManager<MemoryBlock> m_blocks;
+
+    // registrations made by acquire; m_lru holds the current registrations, most recently acquired first, and
+    // m_retired those replaced by a coalesced registration which are still acquired
+    const std::size_t m_max_cached_bytes;
+    std::size_t m_cached_bytes{0};
+    std::list<Registration> m_lru;
+    std::list<Registration> m_retired;
+    std::map<std::uintptr_t, registration_t> m_ranges;  // keyed by the end address of the current registrations
+    std::unordered_map<ucp_mem_h, registration_t> m_by_handle;
 };
 
 }  // namespace mrc::internal::ucx
@@ -23,11 +23,15 @@
 #include "internal/ucx/memory_block.hpp"
 
 #include <glog/logging.h>
+#include <ucp/api/ucp.h>
 #include <ucp/api/ucp_def.h>
 
+#include <atomic>
+#include <cstddef>
 #include <memory>
 #include <mutex>
 #include <optional>
+#include <string>
 
 namespace mrc::internal::ucx {
 
@@ -37,6 +41,11 @@ namespace mrc::internal::ucx {
  * UCX memory registration object that will both register/deregister memory as well as cache the set of local and remote
  * keys for each registration. The cache can be queried for the original memory block by providing any valid address
  * contained in the contiguous block.
+ *
+ * The data plane client holds a single endpoint per remote instance, so the cache of that endpoint holds the unpacked
+ * remote keys of the instance keyed by the memory block address of each remote registration; remote keys of blocks
+ * which are not to be cached, e.g. ad hoc registrations whose lifetime is bound to a single object, are unpacked for a
+ * single use and never enter the cache.
  */
 class RemoteRegistrationCache final
 {
@@ -69,6 +78,7 @@ class RemoteRegistrationCache final
     }
     ~RemoteRegistrationCache()
     {
+        DVLOG(10) << "remote registration cache: " << hits() << " hits; " << misses() << " misses";
         m_blocks.for_each_block([this](const MemoryBlock& block) { ucp_rkey_destroy(block.remote_key_handle()); });
     }
 
@@ -84,15 +94,53 @@ class RemoteRegistrationCache final
     MemoryBlock add_block(const void* addr, std::size_t bytes, const std::string& packed_remote_key)
     {
         DCHECK(addr && bytes);
-        ucp_rkey_h rkey;
-        auto rc = ucp_ep_rkey_unpack(m_endpoint, packed_remote_key.data(), &rkey);
-        CHECK_EQ(rc, UCS_OK);
         std::lock_guard<decltype(m_mutex)> lock(m_mutex);
-        MemoryBlock block{addr, bytes, rkey};
+        // concurrent pulls from the same block may race to add it
+        const auto* ptr = m_blocks.find_block(addr);
+        if (ptr != nullptr)
+        {
+            return *ptr;
+        }
+        MemoryBlock block{addr, bytes, unpack(packed_remote_key)};
         m_blocks.add_block(block);
         return block;
     }
 
+    /**
+     * @brief Look up the block containing addr, unpacking and caching the remote key of the block on a miss
+     *
+     * @param addr address of the remote data
+     * @param block_addr starting address of the remote registration containing addr
+     * @param block_bytes size of the remote registration
+     * @param packed_remote_key packed remote key of the remote registration
+     * @return MemoryBlock
+     */
+    MemoryBlock lookup_or_add(const void* addr,
+                              const void* block_addr,
+                              std::size_t block_bytes,
+                              const std::string& packed_remote_key)
+    {
+        auto block = lookup(addr);
+        if (block)
+        {
+            return *block;
+        }
+        return add_block(block_addr, block_bytes, packed_remote_key);
+    }
+
+    /**
+     * @brief Unpack a remote key to the endpoint without caching it; the caller owns the returned handle and must
+     * release it with ucp_rkey_destroy
+     */
+    ucp_rkey_h unpack(const std::string& packed_remote_key) const
+    {
+        ucp_rkey_h rkey;
+        auto rc = ucp_ep_rkey_unpack(m_endpoint, packed_remote_key.data(), &rkey);
+        CHECK_EQ(rc, UCS_OK);
+        m_misses.fetch_add(1, std::memory_order_relaxed);
+        return rkey;
+    }
+
     /**
      * @brief Deregister a contiguous block of memory from the ucx context and remove the cache entry
      *
@@ -102,10 +150,12 @@ class RemoteRegistrationCache final
      */
     void drop_block(const void* addr)
     {
-        const auto* block = m_blocks.find_block(addr);
+        std::lock_guard<decltype(m_mutex)> lock(m_mutex);
+        auto block = m_blocks.lookup(addr);
         CHECK(block);
-        ucp_rkey_destroy(block->remote_key_handle());
+        // lookups do not take the lock, so the block is removed before its key is destroyed
         m_blocks.drop_block(addr);
+        ucp_rkey_destroy(block->remote_key_handle());
     }
 
     /**
@@ -121,13 +171,29 @@ class RemoteRegistrationCache final
      */
     std::optional<MemoryBlock> lookup(const void* addr) const noexcept
     {
-        std::lock_guard<decltype(m_mutex)> lock(m_mutex);
-        const auto* ptr = m_blocks.find_block(addr);
-        if (ptr == nullptr)
+        // served from the current snapshot of the block manager without taking the lock
+        auto block = m_blocks.lookup(addr);
+        if (block)
         {
-            return std::nullopt;
+            m_hits.fetch_add(1, std::memory_order_relaxed);
         }
-        return {*ptr};
+        return block;
+    }
+
+    /**
+     * @brief Number of lookups served from the cache
+     */
+    std::size_t hits() const
+    {
+        return m_hits.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Number of remote keys unpacked, i.e. cache misses and single use unpacks of uncached blocks
+     */
+    std::size_t misses() const
+    {
+        return m_misses.load(std::memory_order_relaxed);
     }
 
     ucp_ep_h endpoint() const
@@ -139,6 +205,8 @@ class RemoteRegistrationCache final
     mutable std::mutex m_mutex;
     const ucp_ep_h m_endpoint;
     memory::BlockManager<MemoryBlock> m_blocks;
+    mutable std::atomic<std::size_t> m_hits{0};
+    mutable std::atomic<std::size_t> m_misses{0};
 };
 
 }  // namespace mrc::internal::ucx
@@ -21,6 +21,7 @@
 #include "internal/system/device_partition.hpp"
 #include "internal/system/fiber_task_queue.hpp"
 #include "internal/system/partition.hpp"
+#include "internal/system/system.hpp"
 #include "internal/ucx/context.hpp"
 #include "internal/ucx/endpoint.hpp"
 #include "internal/ucx/registation_callback_builder.hpp"
@@ -28,13 +29,20 @@
 #include "internal/ucx/worker.hpp"
 
 #include "mrc/cuda/common.hpp"
+#include "mrc/options/network.hpp"
+#include "mrc/options/options.hpp"
 #include "mrc/types.hpp"
 
 #include <boost/fiber/future/future.hpp>
+#include <boost/fiber/operations.hpp>
 #include <cuda_runtime.h>
 #include <glog/logging.h>
 
+#include <atomic>
 #include <ostream>
+#include <string>
+#include <utility>
+#include <vector>
 
 namespace mrc::core {
 class FiberTaskQueue;
@@ -42,13 +50,31 @@ class FiberTaskQueue;
 
 namespace mrc::internal::ucx {
 
-Resources::Resources(resources::PartitionResourceBase& base, system::FiberTaskQueue& network_task_queue) :
+struct Resources::ProgressEngines
+{
+    ~ProgressEngines()
+    {
+        running->store(false);
+        for (auto& loop : loops)
+        {
+            loop.get();
+        }
+    }
+
+    std::shared_ptr<std::atomic<bool>> running{std::make_shared<std::atomic<bool>>(true)};
+    std::vector<Future<void>> loops;
+};
+
+Resources::Resources(resources::PartitionResourceBase& base,
+                     system::FiberTaskQueue& network_task_queue,
+                     std::vector<system::FiberTaskQueue*> worker_task_queues) :
   resources::PartitionResourceBase(base),
-  m_network_task_queue(network_task_queue)
+  m_network_task_queue(network_task_queue),
+  m_progress_engines(std::make_shared<ProgressEngines>())
 {
     VLOG(1) << "constructing network resources for partition: " << partition_id() << " on partitions main task queue";
     m_network_task_queue
-        .enqueue([this] {
+        .enqueue([this, &worker_task_queues] {
             if (partition().has_device())
             {
                 void* tmp = nullptr;
@@ -62,18 +88,58 @@ Resources::Resources(resources::PartitionResourceBase& base, system::FiberTaskQu
             // we need to create both the context and the workers to ensure ucx and cuda are aligned
 
             DVLOG(10) << "initializing ucx context";
-            m_ucx_context = std::make_shared<Context>();
+            const auto& options = system().options().network();
+            std::vector<std::string> net_devices;
+            if (partition().has_device() && options.enable_nic_affinity())
+            {
+                net_devices = partition().device().nics();
+            }
+            m_ucx_context = std::make_shared<Context>(options, net_devices);
 
             DVLOG(10) << "initialize a ucx data_plane worker";
             m_worker = std::make_shared<Worker>(m_ucx_context);
+            m_workers.push_back(m_worker);
+            for (std::size_t i = 0; i < worker_task_queues.size(); i++)
+            {
+                DVLOG(10) << "initialize additional ucx worker " << i + 1;
+                m_workers.push_back(std::make_shared<Worker>(m_ucx_context));
+            }
 
             DVLOG(10) << "initialize the registration cache for this context";
-            m_registration_cache = std::make_shared<RegistrationCache>(m_ucx_context);
+            m_registration_cache =
+                std::make_shared<RegistrationCache>(m_ucx_context, options.registration_cache_size());
 
             // flush any work that needs to be done by the workers
-            while (m_worker->progress() != 0) {}
+            for (auto& worker : m_workers)
+            {
+                while (worker->progress() != 0) {}
+            }
         })
         .get();
+
+    // the additional workers are progressed by a loop on their own network thread
+    const auto& options = system().options().network();
+    for (std::size_t i = 0; i < worker_task_queues.size(); i++)
+    {
+        CHECK(worker_task_queues[i]);
+        auto worker  = m_workers.at(i + 1);
+        auto running = m_progress_engines->running;
+        m_progress_engines->loops.push_back(worker_task_queues[i]->enqueue([worker, running, &options] {
+            IdlePolicy idle_policy(*worker, options);
+            while (running->load(std::memory_order_relaxed))
+            {
+                if (worker->progress() != 0U)
+                {
+                    idle_policy.reset();
+                }
+                else
+                {
+                    idle_policy.wait_if_idle();
+                }
+                boost::this_fiber::yield();
+            }
+        }));
+    }
 }
 
 void Resources::add_registration_cache_to_builder(RegistrationCallbackBuilder& builder)
@@ -81,6 +147,12 @@ void Resources::add_registration_cache_to_builder(RegistrationCallbackBuilder& b
     builder.add_registration_cache(m_registration_cache);
 }
 
+NetworkTransport Resources::transport() const
+{
+    CHECK(m_ucx_context);
+    return m_ucx_context->transport();
+}
+
 mrc::core::FiberTaskQueue& Resources::network_task_queue()
 {
     return m_network_task_queue;
@@ -98,11 +170,27 @@ Worker& Resources::worker()
     return *m_worker;
 }
 
+std::size_t Resources::worker_count() const
+{
+    return m_workers.size();
+}
+
+Worker& Resources::worker(std::size_t index)
+{
+    CHECK_LT(index, m_workers.size());
+    return *m_workers[index];
+}
+
 std::shared_ptr<ucx::Endpoint> Resources::make_ep(const std::string& worker_address) const
 {
     return std::make_shared<ucx::Endpoint>(m_worker, worker_address);
 }
 
+std::shared_ptr<ucx::Endpoint> Resources::make_ep(const std::string& worker_address, std::uint64_t shard) const
+{
+    return std::make_shared<ucx::Endpoint>(m_workers.at(shard % m_workers.size()), worker_address);
+}
+
 mrc::runnable::LaunchOptions Resources::launch_options(std::uint64_t concurrency)
 {
     mrc::runnable::LaunchOptions launch_options;
@@ -21,11 +21,14 @@
 #include "internal/ucx/registration_resource.hpp"
 
 #include "mrc/memory/adaptors.hpp"
+#include "mrc/options/network.hpp"
 #include "mrc/runnable/launch_options.hpp"
 
+#include <cstddef>
 #include <cstdint>
 #include <memory>
 #include <string>
+#include <vector>
 
 namespace mrc::core {
 class FiberTaskQueue;
@@ -47,17 +50,31 @@ class Worker;
 
 /**
  * @brief UCX Resources - if networking is enabled, there should be 1 UCX Resource per "flattened" partition
+ *
+ * Besides the worker progressed by the data plane server, whose address is registered with the control plane, the
+ * partition may own additional workers of the same context, one per task queue in worker_task_queues, each
+ * progressed by a loop on its task queue. Endpoints to remote instances are sharded across all workers, so sends to
+ * different instances are progressed by different threads.
  */
 class Resources final : public resources::PartitionResourceBase
 {
   public:
-    Resources(resources::PartitionResourceBase& base, system::FiberTaskQueue& network_task_queue);
+    Resources(resources::PartitionResourceBase& base,
+              system::FiberTaskQueue& network_task_queue,
+              std::vector<system::FiberTaskQueue*> worker_task_queues = {});
 
     using resources::PartitionResourceBase::partition;
 
     // ucx worker associated with this partitions ucx context
     Worker& worker();
 
+    // number of ucx workers of the partition; worker(0) is worker()
+    std::size_t worker_count() const;
+    Worker& worker(std::size_t index);
+
+    // transport the ucx context of the partition was initialized with
+    NetworkTransport transport() const;
+
     // task queue used to run the data plane's progress engine
     mrc::core::FiberTaskQueue& network_task_queue();
 
@@ -77,12 +94,20 @@ class Resources final : public resources::PartitionResourceBase
 
     std::shared_ptr<ucx::Endpoint> make_ep(const std::string& worker_address) const;
 
+    // endpoint created on the worker shard % worker_count()
+    std::shared_ptr<ucx::Endpoint> make_ep(const std::string& worker_address, std::uint64_t shard) const;
+
     static mrc::runnable::LaunchOptions launch_options(std::uint64_t concurrency);
 
   private:
+    struct ProgressEngines;
+
     system::FiberTaskQueue& m_network_task_queue;
     std::shared_ptr<Context> m_ucx_context;
     std::shared_ptr<Worker> m_worker;
+    std::vector<std::shared_ptr<Worker>> m_workers;
+    // stops the progress loops of the additional workers once the last copy of these resources is destroyed
+    std::shared_ptr<ProgressEngines> m_progress_engines;
     std::shared_ptr<RegistrationCache> m_registration_cache;
 
     // enable direct access to context and workers
@@ -21,6 +21,7 @@
 #include "internal/ucx/context.hpp"
 #include "internal/ucx/endpoint.hpp"
 
+#include "mrc/options/network.hpp"
 #include "mrc/types.hpp"
 
 #include <glog/logging.h>
@@ -29,7 +30,11 @@
 #include <ucs/type/status.h>       // for ucs_status_string, UCS_OK
 #include <ucs/type/thread_mode.h>  // for UCS_THREAD_MODE_MULTI
 
+#include <poll.h>  // for ppoll
+
+#include <cerrno>
 #include <cstring>  // for memset
+#include <ctime>    // for timespec
 #include <memory>
 #include <ostream>    // for logging
 #include <stdexcept>  // for runtime_error
@@ -80,6 +85,40 @@ unsigned Worker::progress()
     return ucp_worker_progress(m_handle);
 }
 
+bool Worker::wait_for_events(std::chrono::microseconds timeout)
+{
+    DCHECK(m_context->wakeup_enabled());
+    if (m_event_fd < 0)
+    {
+        auto status = ucp_worker_get_efd(m_handle, &m_event_fd);
+        if (status != UCS_OK)
+        {
+            LOG(FATAL) << "ucp_worker_get_efd failed - " << ucs_status_string(status);
+        }
+    }
+
+    auto status = ucp_worker_arm(m_handle);
+    if (status == UCS_ERR_BUSY)
+    {
+        return false;
+    }
+    if (status != UCS_OK)
+    {
+        LOG(FATAL) << "ucp_worker_arm failed - " << ucs_status_string(status);
+    }
+
+    auto seconds = std::chrono::duration_cast<std::chrono::seconds>(timeout);
+    auto nanos   = std::chrono::duration_cast<std::chrono::nanoseconds>(timeout - seconds);
+    std::timespec ts{seconds.count(), nanos.count()};
+    pollfd pfd{m_event_fd, POLLIN, 0};
+
+    if (ppoll(&pfd, 1, &ts, nullptr) < 0 && errno != EINTR)
+    {
+        LOG(FATAL) << "ppoll on ucp worker event fd failed - " << std::strerror(errno);
+    }
+    return true;
+}
+
 const std::string& Worker::address()
 {
     if (m_address_pointer == nullptr)
@@ -114,4 +153,21 @@ Context& Worker::context()
     return *m_context;
 }
 
+IdlePolicy::IdlePolicy(Worker& worker, const NetworkOptions& options) :
+  m_worker(worker),
+  m_enabled(options.enable_progress_engine_wakeup() && worker.context().wakeup_enabled()),
+  m_busy_polls(options.progress_engine_busy_polls()),
+  m_wakeup_timeout(options.progress_engine_wakeup_timeout())
+{}
+
+bool IdlePolicy::wait_if_idle()
+{
+    if (!m_enabled || m_idle_polls < m_busy_polls)
+    {
+        ++m_idle_polls;
+        return false;
+    }
+    return m_worker.wait_for_events(m_wakeup_timeout);
+}
+
 }  // namespace mrc::internal::ucx
@@ -24,9 +24,14 @@
 
 #include <ucp/api/ucp_def.h>  // for ucp_worker_h, ucp_address_t
 
+#include <chrono>
 #include <cstddef>  // for size_t
 #include <string>
 
+namespace mrc {
+class NetworkOptions;
+}  // namespace mrc
+
 namespace mrc::internal::ucx {
 class Context;
 class Endpoint;
@@ -39,6 +44,15 @@ class Worker : public Primitive<ucp_worker_h>
 
     unsigned progress();
 
+    /**
+     * @brief Arm the worker and block the calling thread until the worker has events to progress or timeout elapses.
+     *
+     * Requires a context created with wakeup enabled.
+     *
+     * @return false if the worker could not be armed since it has events pending and must be progressed first
+     */
+    bool wait_for_events(std::chrono::microseconds timeout);
+
     const std::string& address();
     void release_address();
 
@@ -51,6 +65,43 @@ class Worker : public Primitive<ucp_worker_h>
     std::string m_address;
     ucp_address_t* m_address_pointer;
     std::size_t m_address_length;
+    int m_event_fd{-1};
+};
+
+/**
+ * @brief Idle strategy of a progress engine loop driving a Worker.
+ *
+ * The loop busy-polls while the worker has work. Once busy_polls consecutive polls have found none, and wakeup is
+ * enabled, every further idle poll blocks the thread on the worker's event fd for up to wakeup_timeout, until a poll
+ * finds work again. The thread is blocked, not only the calling fiber, so the timeout bounds the latency seen by other
+ * fibers sharing the network thread.
+ */
+class IdlePolicy
+{
+  public:
+    IdlePolicy(Worker& worker, const NetworkOptions& options);
+
+    /**
+     * @brief Record that a poll found work, returning the loop to busy-polling.
+     */
+    void reset()
+    {
+        m_idle_polls = 0;
+    }
+
+    /**
+     * @brief Record that a poll found no work.
+     *
+     * @return true if the thread was blocked for a wakeup; otherwise the loop should apply its own backoff
+     */
+    bool wait_if_idle();
+
+  private:
+    Worker& m_worker;
+    bool m_enabled;
+    std::size_t m_busy_polls;
+    std::chrono::microseconds m_wakeup_timeout;
+    std::size_t m_idle_polls{0};
 };
 
 }  // namespace mrc::internal::ucx
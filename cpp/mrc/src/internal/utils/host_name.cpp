@@ -0,0 +1,38 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "internal/utils/host_name.hpp"
+
+#include <glog/logging.h>
+#include <unistd.h>
+
+#include <climits>
+
+namespace mrc::internal::utils {
+
+const std::string& host_name()
+{
+    static const std::string name = [] {
+        char buffer[HOST_NAME_MAX + 1];
+        CHECK_EQ(gethostname(buffer, sizeof(buffer)), 0);
+        buffer[HOST_NAME_MAX] = '\0';
+        return std::string(buffer);
+    }();
+    return name;
+}
+
+}  // namespace mrc::internal::utils
@@ -0,0 +1,63 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+namespace mrc::internal::utils {
+
+/**
+ * @brief Allocates monotonic ids which are unique within the process for the objects of DomainT
+ *
+ * Each thread leases blocks of BlockSize ids from a counter shared by the threads and allocates ids from its block
+ * without synchronization; a thread touches the shared counter once per BlockSize ids. Unlike the address of an object,
+ * an id is never reissued after the object is destroyed, so a stale id held by a peer can not alias a newer object.
+ *
+ * The ids of a thread are increasing; ids allocated by different threads are not ordered. Id 0 is never issued.
+ */
+template <typename DomainT, std::uint64_t BlockSize = 1024>
+class IdAllocator
+{
+    static_assert(BlockSize > 0);
+
+  public:
+    IdAllocator() = delete;
+
+    static std::uint64_t next()
+    {
+        thread_local Lease lease;
+        if (lease.next == lease.end)
+        {
+            lease.next = s_counter.fetch_add(BlockSize, std::memory_order_relaxed);
+            lease.end  = lease.next + BlockSize;
+        }
+        return lease.next++;
+    }
+
+  private:
+    struct Lease
+    {
+        std::uint64_t next{0};
+        std::uint64_t end{0};
+    };
+
+    static inline std::atomic<std::uint64_t> s_counter{1};
+};
+
+}  // namespace mrc::internal::utils
@@ -0,0 +1,137 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "internal/utils/protobuf_arena_pool.hpp"
+
+#include <glog/logging.h>
+
+namespace mrc::internal::utils {
+
+struct PooledArena::Block
+{
+    explicit Block(std::size_t bytes) : memory(std::make_unique<char[]>(bytes)), arena(options(memory.get(), bytes)) {}
+
+    static google::protobuf::ArenaOptions options(char* initial_block, std::size_t bytes)
+    {
+        google::protobuf::ArenaOptions opts;
+        opts.initial_block      = initial_block;
+        opts.initial_block_size = bytes;
+        return opts;
+    }
+
+    // the initial block is retained by the arena across resets, so a recycled arena does not touch the heap until it
+    // outgrows the block
+    std::unique_ptr<char[]> memory;
+    google::protobuf::Arena arena;
+};
+
+PooledArena::PooledArena(ProtobufArenaPool& pool, std::unique_ptr<Block> block) :
+  m_pool(&pool),
+  m_block(std::move(block))
+{}
+
+PooledArena::~PooledArena()
+{
+    release();
+}
+
+PooledArena::PooledArena(PooledArena&& other) noexcept :
+  m_pool(std::exchange(other.m_pool, nullptr)),
+  m_block(std::move(other.m_block))
+{}
+
+PooledArena& PooledArena::operator=(PooledArena&& other) noexcept
+{
+    if (this != &other)
+    {
+        release();
+        m_pool  = std::exchange(other.m_pool, nullptr);
+        m_block = std::move(other.m_block);
+    }
+    return *this;
+}
+
+google::protobuf::Arena* PooledArena::get() const
+{
+    CHECK(m_block);
+    return &m_block->arena;
+}
+
+void PooledArena::release()
+{
+    if (m_block)
+    {
+        DCHECK(m_pool);
+        m_pool->recycle(std::move(m_block));
+    }
+    m_pool = nullptr;
+}
+
+ProtobufArenaPool::ProtobufArenaPool(std::size_t block_size, std::size_t max_idle_arenas) :
+  m_block_size(block_size),
+  m_max_idle_arenas(max_idle_arenas)
+{
+    CHECK_GT(m_block_size, 0);
+}
+
+ProtobufArenaPool::~ProtobufArenaPool() = default;
+
+ProtobufArenaPool& ProtobufArenaPool::global()
+{
+    static auto* pool = new ProtobufArenaPool();  // NOLINT(cppcoreguidelines-owning-memory)
+    return *pool;
+}
+
+PooledArena ProtobufArenaPool::acquire()
+{
+    std::unique_ptr<PooledArena::Block> block;
+    {
+        std::lock_guard lock(m_mutex);
+        if (!m_idle.empty())
+        {
+            block = std::move(m_idle.back());
+            m_idle.pop_back();
+        }
+    }
+
+    if (!block)
+    {
+        block = std::make_unique<PooledArena::Block>(m_block_size);
+    }
+
+    return {*this, std::move(block)};
+}
+
+void ProtobufArenaPool::recycle(std::unique_ptr<PooledArena::Block> block)
+{
+    // destroys the messages on the arena and frees any blocks allocated beyond the initial block
+    block->arena.Reset();
+
+    std::lock_guard lock(m_mutex);
+    if (m_idle.size() < m_max_idle_arenas)
+    {
+        m_idle.push_back(std::move(block));
+    }
+}
+
+std::size_t ProtobufArenaPool::idle_arenas() const
+{
+    std::lock_guard lock(m_mutex);
+    return m_idle.size();
+}
+
+}  // namespace mrc::internal::utils
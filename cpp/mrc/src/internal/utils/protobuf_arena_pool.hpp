@@ -0,0 +1,143 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "mrc/utils/macros.hpp"
+
+#include <google/protobuf/arena.h>
+
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace mrc::internal::utils {
+
+class ProtobufArenaPool;
+
+/**
+ * @brief Handle to an arena acquired from a ProtobufArenaPool; the arena is reset and returned to the pool when the
+ * handle is destroyed, releasing every message allocated on it.
+ */
+class PooledArena final
+{
+  public:
+    PooledArena() = default;
+    ~PooledArena();
+
+    DELETE_COPYABILITY(PooledArena);
+
+    PooledArena(PooledArena&& other) noexcept;
+    PooledArena& operator=(PooledArena&& other) noexcept;
+
+    google::protobuf::Arena* get() const;
+
+  private:
+    struct Block;
+
+    PooledArena(ProtobufArenaPool& pool, std::unique_ptr<Block> block);
+
+    void release();
+
+    ProtobufArenaPool* m_pool{nullptr};
+    std::unique_ptr<Block> m_block;
+
+    friend ProtobufArenaPool;
+};
+
+/**
+ * @brief A protobuf message allocated on, and owning, a pooled arena
+ *
+ * Moving an ArenaMessage moves the arena with it, so the message itself is never copied.
+ */
+template <typename MessageT>
+class ArenaMessage final
+{
+  public:
+    explicit ArenaMessage(PooledArena arena) :
+      m_arena(std::move(arena)),
+      m_message(google::protobuf::Arena::CreateMessage<MessageT>(m_arena.get()))
+    {}
+
+    MessageT& operator*() const
+    {
+        return *m_message;
+    }
+
+    MessageT* operator->() const
+    {
+        return m_message;
+    }
+
+    MessageT* get() const
+    {
+        return m_message;
+    }
+
+  private:
+    PooledArena m_arena;
+    MessageT* m_message;
+};
+
+/**
+ * @brief Recycles protobuf arenas, each with a preallocated initial block, so that the nested messages of short lived
+ * protobufs, e.g. remote descriptors, are bump allocated rather than allocated and freed one by one on the heap.
+ */
+class ProtobufArenaPool final
+{
+  public:
+    // size of the initial block of each arena, large enough for the encoded object of a typical remote descriptor
+    static constexpr std::size_t DefaultBlockSize = 4096;
+
+    // maximum number of idle arenas kept by the pool; arenas released beyond this are freed
+    static constexpr std::size_t DefaultMaxIdleArenas = 256;
+
+    ProtobufArenaPool(std::size_t block_size = DefaultBlockSize, std::size_t max_idle_arenas = DefaultMaxIdleArenas);
+    ~ProtobufArenaPool();
+
+    DELETE_COPYABILITY(ProtobufArenaPool);
+    DELETE_MOVEABILITY(ProtobufArenaPool);
+
+    /**
+     * @brief Process-wide pool; never destroyed, so arenas may be released during static destruction
+     */
+    static ProtobufArenaPool& global();
+
+    PooledArena acquire();
+
+    template <typename MessageT>
+    ArenaMessage<MessageT> make_message()
+    {
+        return ArenaMessage<MessageT>(acquire());
+    }
+
+    std::size_t idle_arenas() const;
+
+  private:
+    void recycle(std::unique_ptr<PooledArena::Block> block);
+
+    const std::size_t m_block_size;
+    const std::size_t m_max_idle_arenas;
+    std::vector<std::unique_ptr<PooledArena::Block>> m_idle;
+    mutable std::mutex m_mutex;
+
+    friend PooledArena;
+};
+
+}  // namespace mrc::internal::utils
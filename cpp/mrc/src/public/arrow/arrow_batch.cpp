@@ -0,0 +1,467 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "mrc/arrow/arrow_batch.hpp"
+
+#include "mrc/exceptions/runtime_error.hpp"
+#include "mrc/memory/memory_kind.hpp"
+
+#include <glog/logging.h>
+
+#include <cstring>
+#include <string_view>
+#include <utility>
+
+namespace mrc::arrow {
+
+namespace {
+
+// byte width of the values of a fixed width format; 0 for other formats
+std::int64_t fixed_width(std::string_view format)
+{
+    if (format.size() == 1)
+    {
+        switch (format[0])
+        {
+        case 'c':
+        case 'C':
+            return 1;
+        case 's':
+        case 'S':
+        case 'e':
+            return 2;
+        case 'i':
+        case 'I':
+        case 'f':
+            return 4;
+        case 'l':
+        case 'L':
+        case 'g':
+            return 8;
+        default:
+            return 0;
+        }
+    }
+
+    if (format.starts_with("w:"))
+    {
+        return std::stoll(std::string(format.substr(2)));
+    }
+
+    // decimals are "d:precision,scale[,bitwidth]" with a bitwidth of 128 if omitted
+    if (format.starts_with("d:"))
+    {
+        auto params = format.substr(2);
+        auto scale  = params.find(',');
+        auto bits   = (scale == std::string_view::npos ? scale : params.find(',', scale + 1));
+        return (bits == std::string_view::npos ? 128 : std::stoll(std::string(params.substr(bits + 1)))) / 8;
+    }
+
+    // dates, times, timestamps, durations and intervals
+    if (format == "tdD" || format == "tts" || format == "ttm" || format == "tiM")
+    {
+        return 4;
+    }
+    if (format == "tdm" || format == "ttu" || format == "ttn" || format == "tiD" || format.starts_with("ts") ||
+        format.starts_with("tD"))
+    {
+        return 8;
+    }
+    if (format == "tin")
+    {
+        return 16;
+    }
+    return 0;
+}
+
+// sizes in bytes of the buffers an array of format holds, in the order of the columnar format
+std::vector<std::int64_t> buffer_sizes(std::string_view format, const ArrowArray& array)
+{
+    const auto elements = array.offset + array.length;
+    const auto bitmap   = (elements + 7) / 8;
+
+    auto expect_buffers = [&](std::int64_t count) {
+        if (array.n_buffers != count)
+        {
+            throw exceptions::MrcRuntimeError("arrow array of format " + std::string(format) + " has " +
+                                              std::to_string(array.n_buffers) + " buffers; expected " +
+                                              std::to_string(count));
+        }
+    };
+
+    if (format == "n")
+    {
+        expect_buffers(0);
+        return {};
+    }
+    if (format == "+s" || format.starts_with("+w:"))
+    {
+        expect_buffers(1);
+        return {bitmap};
+    }
+    if (format == "+l" || format == "+m" || format == "+L")
+    {
+        expect_buffers(2);
+        return {bitmap, (elements + 1) * (format == "+L" ? 8 : 4)};
+    }
+    if (format == "b")
+    {
+        expect_buffers(2);
+        return {bitmap, bitmap};
+    }
+    if (format == "u" || format == "z" || format == "U" || format == "Z")
+    {
+        expect_buffers(3);
+
+        // the values span up to the last offset
+        const bool large   = (format == "U" || format == "Z");
+        std::int64_t bytes = 0;
+        if (array.buffers[1] != nullptr)
+        {
+            bytes = (large ? static_cast<const std::int64_t*>(array.buffers[1])[elements]
+                           : static_cast<const std::int32_t*>(array.buffers[1])[elements]);
+        }
+        return {bitmap, (elements + 1) * (large ? 8 : 4), bytes};
+    }
+
+    auto width = fixed_width(format);
+    if (width > 0)
+    {
+        expect_buffers(2);
+        return {bitmap, elements * width};
+    }
+
+    throw exceptions::MrcRuntimeError("arrow format " + std::string(format) + " is not supported");
+}
+
+// length of metadata in the binary encoding of the C data interface: an int32 count of key / value pairs, each an
+// int32 length followed by its bytes
+std::size_t metadata_size(const char* metadata)
+{
+    if (metadata == nullptr)
+    {
+        return 0;
+    }
+
+    auto read_int32 = [metadata](std::size_t pos) {
+        std::int32_t value;
+        std::memcpy(&value, metadata + pos, sizeof(value));
+        return static_cast<std::size_t>(value);
+    };
+
+    const auto pairs = read_int32(0);
+    std::size_t pos  = sizeof(std::int32_t);
+    for (std::size_t i = 0; i < 2 * pairs; ++i)
+    {
+        pos += sizeof(std::int32_t) + read_int32(pos);
+    }
+    return pos;
+}
+
+// private data of the structs exported by mrc; each struct owns those of its children
+struct ExportedSchema
+{
+    std::string format;
+    std::string name;
+    std::string metadata;
+    std::vector<ArrowSchema> children;
+    std::vector<ArrowSchema*> child_ptrs;
+};
+
+struct ExportedArray
+{
+    std::shared_ptr<const void> owner;
+    std::vector<const void*> buffers;
+    std::vector<ArrowArray> children;
+    std::vector<ArrowArray*> child_ptrs;
+};
+
+// children moved out by the consumer have been marked released and are skipped
+void release_schema(ArrowSchema* schema)
+{
+    auto* exported = static_cast<ExportedSchema*>(schema->private_data);
+    for (auto* child : exported->child_ptrs)
+    {
+        if (child->release != nullptr)
+        {
+            child->release(child);
+        }
+    }
+    delete exported;
+    schema->release = nullptr;
+}
+
+void release_array(ArrowArray* array)
+{
+    auto* exported = static_cast<ExportedArray*>(array->private_data);
+    for (auto* child : exported->child_ptrs)
+    {
+        if (child->release != nullptr)
+        {
+            child->release(child);
+        }
+    }
+    delete exported;
+    array->release = nullptr;
+}
+
+void export_schema(const ArrowArrayLayout& layout, ArrowSchema* schema)
+{
+    auto exported      = std::make_unique<ExportedSchema>();
+    exported->format   = layout.format;
+    exported->name     = layout.name;
+    exported->metadata = layout.metadata;
+    exported->children.resize(layout.children.size());
+    for (std::size_t i = 0; i < layout.children.size(); ++i)
+    {
+        export_schema(layout.children[i], &exported->children[i]);
+        exported->child_ptrs.push_back(&exported->children[i]);
+    }
+
+    schema->format       = exported->format.c_str();
+    schema->name         = exported->name.c_str();
+    schema->metadata     = (exported->metadata.empty() ? nullptr : exported->metadata.data());
+    schema->flags        = layout.flags;
+    schema->n_children   = static_cast<std::int64_t>(exported->child_ptrs.size());
+    schema->children     = exported->child_ptrs.data();
+    schema->dictionary   = nullptr;
+    schema->release      = release_schema;
+    schema->private_data = exported.release();
+}
+
+void export_array(const ArrowArrayLayout& layout, const std::shared_ptr<const void>& owner, ArrowArray* array)
+{
+    auto exported   = std::make_unique<ExportedArray>();
+    exported->owner = owner;
+    for (const auto& buffer : layout.buffers)
+    {
+        exported->buffers.push_back(buffer.data());
+    }
+    exported->children.resize(layout.children.size());
+    for (std::size_t i = 0; i < layout.children.size(); ++i)
+    {
+        export_array(layout.children[i], owner, &exported->children[i]);
+        exported->child_ptrs.push_back(&exported->children[i]);
+    }
+
+    array->length       = layout.length;
+    array->null_count   = layout.null_count;
+    array->offset       = layout.offset;
+    array->n_buffers    = static_cast<std::int64_t>(exported->buffers.size());
+    array->n_children   = static_cast<std::int64_t>(exported->child_ptrs.size());
+    array->buffers      = exported->buffers.data();
+    array->children     = exported->child_ptrs.data();
+    array->dictionary   = nullptr;
+    array->release      = release_array;
+    array->private_data = exported.release();
+}
+
+void collect_buffers(const ArrowArrayLayout& layout, std::vector<memory::const_buffer_view>& buffers)
+{
+    for (const auto& buffer : layout.buffers)
+    {
+        if (buffer.data() != nullptr)
+        {
+            buffers.push_back(buffer);
+        }
+    }
+    for (const auto& child : layout.children)
+    {
+        collect_buffers(child, buffers);
+    }
+}
+
+void check_record_batch(const ArrowSchema& schema)
+{
+    if (std::string_view(schema.format) != "+s")
+    {
+        throw exceptions::MrcRuntimeError("an arrow record batch is a struct array of format +s; got " +
+                                          std::string(schema.format));
+    }
+}
+
+}  // namespace
+
+// the structs of an imported batch are released by the release callbacks of their producer
+struct ArrowBatch::State
+{
+    State() = default;
+
+    ~State()
+    {
+        if (array.release != nullptr)
+        {
+            array.release(&array);
+        }
+        if (schema.release != nullptr)
+        {
+            schema.release(&schema);
+        }
+    }
+
+    State(const State&)            = delete;
+    State& operator=(const State&) = delete;
+
+    ArrowSchema schema{};
+    ArrowArray array{};
+};
+
+ArrowBatch::ArrowBatch(std::shared_ptr<const State> state) : m_state(std::move(state)) {}
+
+ArrowBatch ArrowBatch::import_from_c(ArrowSchema* schema, ArrowArray* array)
+{
+    CHECK(schema != nullptr && array != nullptr);
+    if (schema->release == nullptr || array->release == nullptr)
+    {
+        throw exceptions::MrcRuntimeError("cannot import a released arrow schema or array");
+    }
+
+    auto state    = std::make_shared<State>();
+    state->schema = *schema;
+    state->array  = *array;
+
+    // moved structs are marked released
+    schema->release = nullptr;
+    array->release  = nullptr;
+
+    // validates the layout before the batch is handed out
+    check_record_batch(state->schema);
+    make_layout(state->schema, state->array);
+
+    return ArrowBatch(std::move(state));
+}
+
+ArrowBatch ArrowBatch::from_layout(const ArrowArrayLayout& layout, std::shared_ptr<const void> owner)
+{
+    auto state = std::make_shared<State>();
+    export_schema(layout, &state->schema);
+    export_array(layout, owner, &state->array);
+    check_record_batch(state->schema);
+
+    return ArrowBatch(std::move(state));
+}
+
+void ArrowBatch::export_to_c(ArrowSchema* schema, ArrowArray* array) const
+{
+    CHECK(m_state);
+    auto exported = layout();
+    export_schema(exported, schema);
+    export_array(exported, m_state, array);
+}
+
+ArrowBatch::operator bool() const
+{
+    return static_cast<bool>(m_state);
+}
+
+std::int64_t ArrowBatch::num_rows() const
+{
+    CHECK(m_state);
+    return m_state->array.length;
+}
+
+std::int64_t ArrowBatch::num_columns() const
+{
+    CHECK(m_state);
+    return m_state->schema.n_children;
+}
+
+std::vector<std::string> ArrowBatch::column_names() const
+{
+    CHECK(m_state);
+    std::vector<std::string> names;
+    for (std::int64_t i = 0; i < m_state->schema.n_children; ++i)
+    {
+        const auto* name = m_state->schema.children[i]->name;
+        names.emplace_back(name == nullptr ? "" : name);
+    }
+    return names;
+}
+
+const ArrowSchema& ArrowBatch::schema() const
+{
+    CHECK(m_state);
+    return m_state->schema;
+}
+
+const ArrowArray& ArrowBatch::array() const
+{
+    CHECK(m_state);
+    return m_state->array;
+}
+
+ArrowArrayLayout ArrowBatch::layout() const
+{
+    CHECK(m_state);
+    return make_layout(m_state->schema, m_state->array);
+}
+
+std::vector<memory::const_buffer_view> ArrowBatch::buffers() const
+{
+    std::vector<memory::const_buffer_view> buffers;
+    collect_buffers(layout(), buffers);
+    return buffers;
+}
+
+std::size_t ArrowBatch::nbytes() const
+{
+    std::size_t bytes = 0;
+    for (const auto& buffer : buffers())
+    {
+        bytes += buffer.bytes();
+    }
+    return bytes;
+}
+
+ArrowArrayLayout make_layout(const ArrowSchema& schema, const ArrowArray& array)
+{
+    const std::string_view format(schema.format);
+    if (schema.dictionary != nullptr || array.dictionary != nullptr)
+    {
+        throw exceptions::MrcRuntimeError("dictionary encoded arrow arrays are not supported");
+    }
+    if (schema.n_children != array.n_children)
+    {
+        throw exceptions::MrcRuntimeError("arrow array of format " + std::string(format) + " has " +
+                                          std::to_string(array.n_children) + " children; its schema has " +
+                                          std::to_string(schema.n_children));
+    }
+
+    ArrowArrayLayout layout;
+    layout.format     = format;
+    layout.name       = (schema.name == nullptr ? "" : schema.name);
+    layout.metadata   = std::string(schema.metadata == nullptr ? "" : schema.metadata, metadata_size(schema.metadata));
+    layout.flags      = schema.flags;
+    layout.length     = array.length;
+    layout.null_count = array.null_count;
+    layout.offset     = array.offset;
+
+    auto sizes = buffer_sizes(format, array);
+    for (std::size_t i = 0; i < sizes.size(); ++i)
+    {
+        const auto* data = array.buffers[i];
+        layout.buffers.emplace_back(data, (data == nullptr ? 0 : sizes[i]), memory::memory_kind::host);
+    }
+
+    for (std::int64_t i = 0; i < array.n_children; ++i)
+    {
+        layout.children.push_back(make_layout(*schema.children[i], *array.children[i]));
+    }
+    return layout;
+}
+
+}  // namespace mrc::arrow
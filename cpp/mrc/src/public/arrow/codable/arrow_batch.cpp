@@ -0,0 +1,228 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "mrc/arrow/codable/arrow_batch.hpp"
+
+#include "mrc/codable/decode.hpp"
+#include "mrc/codable/encode.hpp"
+#include "mrc/exceptions/runtime_error.hpp"
+#include "mrc/memory/buffer.hpp"
+#include "mrc/memory/memory_kind.hpp"
+
+#include <glog/logging.h>
+
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <string>
+#include <typeindex>
+#include <utility>
+#include <vector>
+
+namespace mrc::codable {
+
+namespace {
+
+// size recorded for an absent buffer
+constexpr std::int64_t AbsentBuffer = -1;
+
+// non-null address of the empty buffers of decoded batches
+alignas(64) constexpr std::byte EmptyBuffer[64]{};
+
+// the arrays of a batch are packed in depth first order, each as its strings, lengths, buffer sizes and child count
+void pack_layout(const arrow::ArrowArrayLayout& layout, std::vector<std::byte>& header)
+{
+    auto put = [&header](const void* src, std::size_t count) {
+        const auto* bytes = static_cast<const std::byte*>(src);
+        header.insert(header.end(), bytes, bytes + count);
+    };
+    auto put_string = [&put](const std::string& str) {
+        auto size = static_cast<std::uint32_t>(str.size());
+        put(&size, sizeof(size));
+        put(str.data(), size);
+    };
+
+    put_string(layout.format);
+    put_string(layout.name);
+    put_string(layout.metadata);
+    put(&layout.flags, sizeof(layout.flags));
+    put(&layout.length, sizeof(layout.length));
+    put(&layout.null_count, sizeof(layout.null_count));
+    put(&layout.offset, sizeof(layout.offset));
+
+    auto n_buffers = static_cast<std::uint32_t>(layout.buffers.size());
+    put(&n_buffers, sizeof(n_buffers));
+    for (const auto& buffer : layout.buffers)
+    {
+        auto size = (buffer.data() == nullptr ? AbsentBuffer : static_cast<std::int64_t>(buffer.bytes()));
+        put(&size, sizeof(size));
+    }
+
+    auto n_children = static_cast<std::uint32_t>(layout.children.size());
+    put(&n_children, sizeof(n_children));
+    for (const auto& child : layout.children)
+    {
+        pack_layout(child, header);
+    }
+}
+
+// the buffers with any bytes, in the order they are encoded
+void collect_buffers(const arrow::ArrowArrayLayout& layout, std::vector<memory::const_buffer_view>& buffers)
+{
+    for (const auto& buffer : layout.buffers)
+    {
+        if (buffer.data() != nullptr && buffer.bytes() > 0)
+        {
+            buffers.push_back(buffer);
+        }
+    }
+    for (const auto& child : layout.children)
+    {
+        collect_buffers(child, buffers);
+    }
+}
+
+// unpacks the arrays of a header; the buffers with any bytes are obtained from decode_buffer in encoding order
+class LayoutReader
+{
+  public:
+    using decode_buffer_fn_t = std::function<memory::const_buffer_view(std::size_t bytes)>;
+
+    LayoutReader(std::vector<std::byte> header, decode_buffer_fn_t decode_buffer) :
+      m_header(std::move(header)),
+      m_decode_buffer(std::move(decode_buffer))
+    {}
+
+    arrow::ArrowArrayLayout read()
+    {
+        arrow::ArrowArrayLayout layout;
+        layout.format   = get_string();
+        layout.name     = get_string();
+        layout.metadata = get_string();
+        get(&layout.flags, sizeof(layout.flags));
+        get(&layout.length, sizeof(layout.length));
+        get(&layout.null_count, sizeof(layout.null_count));
+        get(&layout.offset, sizeof(layout.offset));
+
+        std::uint32_t n_buffers;
+        get(&n_buffers, sizeof(n_buffers));
+        for (std::uint32_t i = 0; i < n_buffers; ++i)
+        {
+            std::int64_t size;
+            get(&size, sizeof(size));
+            if (size == AbsentBuffer)
+            {
+                layout.buffers.emplace_back();
+            }
+            else if (size == 0)
+            {
+                layout.buffers.emplace_back(EmptyBuffer, 0, memory::memory_kind::host);
+            }
+            else
+            {
+                layout.buffers.push_back(m_decode_buffer(size));
+            }
+        }
+
+        std::uint32_t n_children;
+        get(&n_children, sizeof(n_children));
+        for (std::uint32_t i = 0; i < n_children; ++i)
+        {
+            layout.children.push_back(read());
+        }
+        return layout;
+    }
+
+  private:
+    void get(void* dst, std::size_t count)
+    {
+        if (m_pos + count > m_header.size())
+        {
+            throw exceptions::MrcRuntimeError("truncated arrow batch header");
+        }
+        std::memcpy(dst, m_header.data() + m_pos, count);
+        m_pos += count;
+    }
+
+    std::string get_string()
+    {
+        std::uint32_t size;
+        get(&size, sizeof(size));
+        std::string str(size, '\0');
+        get(str.data(), size);
+        return str;
+    }
+
+    const std::vector<std::byte> m_header;
+    const decode_buffer_fn_t m_decode_buffer;
+    std::size_t m_pos{0};
+};
+
+}  // namespace
+
+void codable_protocol<arrow::ArrowBatch>::serialize(const arrow::ArrowBatch& obj,
+                                                    Encoder<arrow::ArrowBatch>& encoded,
+                                                    const EncodingOptions& opts)
+{
+    auto layout = obj.layout();
+
+    std::vector<std::byte> header;
+    pack_layout(layout, header);
+    encoded.copy_to_eager_descriptor({header.data(), header.size(), memory::memory_kind::host});
+
+    std::vector<memory::const_buffer_view> buffers;
+    collect_buffers(layout, buffers);
+    for (const auto& buffer : buffers)
+    {
+        if (opts.force_copy())
+        {
+            auto idx = encoded.create_memory_buffer(buffer.bytes());
+            encoded.copy_to_buffer(idx, buffer);
+            continue;
+        }
+
+        // each column buffer is a descriptor of its own, described in place once above the eager threshold
+        encoded.add_memory_view(buffer, opts);
+    }
+}
+
+arrow::ArrowBatch codable_protocol<arrow::ArrowBatch>::deserialize(const Decoder<arrow::ArrowBatch>& encoded,
+                                                                   std::size_t object_idx)
+{
+    DCHECK_EQ(std::type_index(typeid(arrow::ArrowBatch)).hash_code(), encoded.type_index_hash_for_object(object_idx));
+
+    auto idx = encoded.start_idx_for_object(object_idx);
+
+    std::vector<std::byte> header(encoded.buffer_size(idx));
+    encoded.copy_from_buffer(idx, {header.data(), header.size(), memory::memory_kind::host});
+
+    // the buffers are decoded into memory of the host pool and owned by the batch
+    auto storage = std::make_shared<std::vector<memory::buffer>>();
+    LayoutReader reader(std::move(header), [&](std::size_t bytes) {
+        ++idx;
+        DCHECK_EQ(encoded.buffer_size(idx), bytes);
+        auto& buffer = storage->emplace_back(bytes, encoded.host_memory_resource());
+        encoded.copy_from_buffer(idx, buffer);
+        return memory::const_buffer_view(buffer);
+    });
+    auto layout = reader.read();
+
+    return arrow::ArrowBatch::from_layout(layout, std::move(storage));
+}
+
+}  // namespace mrc::codable
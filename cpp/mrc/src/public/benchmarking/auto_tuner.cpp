@@ -0,0 +1,252 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "mrc/benchmarking/auto_tuner.hpp"
+
+#include "mrc/benchmarking/bottleneck.hpp"
+
+#include <glog/logging.h>
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <limits>
+#include <utility>
+#include <vector>
+
+namespace mrc::benchmarking {
+
+AutoTuner::AutoTuner(AutoTunerOptions options, TuningProfile initial) :
+  m_options(std::move(options)),
+  m_profile(std::move(initial))
+{
+    CHECK_GT(m_options.target_utilization, 0.0);
+    CHECK_GT(m_options.max_pe_count, 0);
+    CHECK_GT(m_options.max_engines_per_pe, 0);
+    CHECK(m_options.min_channel_size > 0 && m_options.min_channel_size <= m_options.max_channel_size);
+}
+
+void AutoTuner::observe(const LiveSample& sample)
+{
+    std::lock_guard<decltype(m_mutex)> lock(m_mutex);
+    if (m_skipped < m_options.warm_up_samples)
+    {
+        ++m_skipped;
+        return;
+    }
+
+    ++m_samples;
+    m_interval_seconds += sample.interval_seconds;
+    for (const auto& node : sample.nodes)
+    {
+        auto& totals = m_nodes[node.name];
+        totals.received += node.received;
+        totals.emitted += node.emitted;
+        totals.read_wait_ns += node.read_wait_ns;
+        totals.write_wait_ns += node.write_wait_ns;
+        totals.latency_ns += node.mean_latency_ns * node.emitted;
+    }
+    for (const auto& queue : sample.queues)
+    {
+        auto& totals    = m_queues[queue.name];
+        totals.capacity = queue.capacity;
+        totals.occupancy_seconds += queue.occupancy * sample.interval_seconds;
+    }
+}
+
+TuningProfile AutoTuner::profile() const
+{
+    std::lock_guard<decltype(m_mutex)> lock(m_mutex);
+    return m_profile;
+}
+
+TuningProfile AutoTuner::next_round()
+{
+    std::lock_guard<decltype(m_mutex)> lock(m_mutex);
+    if (m_samples == 0 || m_interval_seconds <= 0.0)
+    {
+        LOG(WARNING) << "auto tuner round without samples; the profile is unchanged";
+        return m_profile;
+    }
+
+    auto sample = round_sample();
+    auto round  = score_round(sample);
+    VLOG(1) << "auto tuner round over " << round.samples << " samples: throughput " << round.throughput
+            << "/s, latency " << round.latency_seconds << "s";
+
+    const bool better = !m_best || (round.meets_latency_target
+                                        ? (!m_best->meets_latency_target || round.throughput > m_best->throughput)
+                                        : (!m_best->meets_latency_target &&
+                                           round.latency_seconds < m_best->latency_seconds));
+    if (better)
+    {
+        m_best = round;
+    }
+
+    auto next   = recommend(sample);
+    m_converged = (next == m_profile);
+    m_profile   = next;
+
+    m_samples          = 0;
+    m_skipped          = 0;
+    m_interval_seconds = 0.0;
+    m_nodes.clear();
+    m_queues.clear();
+    return next;
+}
+
+bool AutoTuner::converged() const
+{
+    std::lock_guard<decltype(m_mutex)> lock(m_mutex);
+    return m_converged;
+}
+
+std::optional<TuningRound> AutoTuner::best() const
+{
+    std::lock_guard<decltype(m_mutex)> lock(m_mutex);
+    return m_best;
+}
+
+LiveSample AutoTuner::round_sample() const
+{
+    LiveSample sample;
+    sample.sequence         = m_samples;
+    sample.interval_seconds = m_interval_seconds;
+    for (const auto& [name, totals] : m_nodes)
+    {
+        LiveNodeSample node;
+        node.name            = name;
+        node.received        = totals.received;
+        node.emitted         = totals.emitted;
+        node.receive_rate    = totals.received / m_interval_seconds;
+        node.emit_rate       = totals.emitted / m_interval_seconds;
+        node.mean_latency_ns = (totals.emitted > 0 ? totals.latency_ns / totals.emitted : 0.0);
+        node.read_wait_ns    = static_cast<std::size_t>(totals.read_wait_ns);
+        node.write_wait_ns   = static_cast<std::size_t>(totals.write_wait_ns);
+        sample.nodes.push_back(std::move(node));
+    }
+    for (const auto& [name, totals] : m_queues)
+    {
+        LiveQueueSample queue;
+        queue.name      = name;
+        queue.capacity  = totals.capacity;
+        queue.occupancy = static_cast<std::size_t>(totals.occupancy_seconds / m_interval_seconds);
+        sample.queues.push_back(std::move(queue));
+    }
+    return sample;
+}
+
+double AutoTuner::queueing_seconds(const LiveNodeSample& node) const
+{
+    auto queue = m_queues.find(node.name);
+    if (queue == m_queues.end() || node.receive_rate <= 0.0)
+    {
+        return 0.0;
+    }
+    return (queue->second.occupancy_seconds / m_interval_seconds) / node.receive_rate;
+}
+
+TuningRound AutoTuner::score_round(const LiveSample& sample) const
+{
+    TuningRound round;
+    round.profile = m_profile;
+    round.samples = m_samples;
+
+    double sink_rate     = 0.0;
+    double min_emit_rate = std::numeric_limits<double>::max();
+    for (const auto& node : sample.nodes)
+    {
+        if (node.emitted == 0 && node.received > 0)
+        {
+            sink_rate += node.receive_rate;
+        }
+        else if (node.emitted > 0)
+        {
+            min_emit_rate = std::min(min_emit_rate, node.emit_rate);
+        }
+        round.latency_seconds += node.mean_latency_ns * 1e-9 + queueing_seconds(node);
+    }
+
+    // without sinks among the traced nodes, the slowest traced node bounds the throughput
+    round.throughput = (sink_rate > 0.0 || min_emit_rate == std::numeric_limits<double>::max() ? sink_rate
+                                                                                                 : min_emit_rate);
+    round.meets_latency_target =
+        (round.latency_seconds <= std::chrono::duration<double>(m_options.latency_target).count());
+    return round;
+}
+
+NodeTuning AutoTuner::tuning_of(const std::string& name) const
+{
+    const auto* tuning = m_profile.find(name);
+    return (tuning != nullptr ? *tuning : NodeTuning{});
+}
+
+TuningProfile AutoTuner::recommend(const LiveSample& sample) const
+{
+    BottleneckOptions bottleneck_options;
+    bottleneck_options.target_utilization = m_options.target_utilization;
+
+    // service times are spent on the fast path; what remains of the latency target is shared by the input channels
+    double service_seconds = 0.0;
+    std::size_t queued     = 0;
+    for (const auto& node : sample.nodes)
+    {
+        auto tuning = tuning_of(node.name);
+        bottleneck_options.pe_counts[node.name] = tuning.pe_count * tuning.engines_per_pe;
+        service_seconds += node.mean_latency_ns * 1e-9;
+        queued += (node.received > 0 ? 1 : 0);
+    }
+    const double latency_budget = std::max(
+        0.0, std::chrono::duration<double>(m_options.latency_target).count() - service_seconds);
+    const double node_budget = (queued > 0 ? latency_budget / queued : 0.0);
+
+    std::map<std::string, const LiveNodeSample*> nodes;
+    for (const auto& node : sample.nodes)
+    {
+        nodes[node.name] = &node;
+    }
+
+    TuningProfile profile = m_profile;
+    for (const auto& diagnosis : analyze_bottlenecks(sample, bottleneck_options).nodes)
+    {
+        const auto& node = *nodes.at(diagnosis.name);
+        if (node.received == 0 && node.emitted == 0)
+        {
+            continue;
+        }
+
+        // engines beyond max_pe_count are run as more engines per pe
+        NodeTuning tuning;
+        const auto engines    = diagnosis.recommended_pe_count;
+        tuning.pe_count       = std::min(engines, m_options.max_pe_count);
+        const auto per_pe     = (engines + tuning.pe_count - 1) / tuning.pe_count;
+        tuning.engines_per_pe = std::min(per_pe, m_options.max_engines_per_pe);
+
+        // nodes without input, i.e. sources, have no channel to size
+        if (node.received > 0)
+        {
+            const auto elements = static_cast<std::size_t>(std::ceil(node.receive_rate * node_budget));
+            tuning.channel_size = std::clamp(std::bit_ceil(std::max<std::size_t>(elements, 1)),
+                                             m_options.min_channel_size,
+                                             m_options.max_channel_size);
+        }
+        profile.set(diagnosis.name, tuning);
+    }
+    return profile;
+}
+
+}  // namespace mrc::benchmarking
@@ -0,0 +1,179 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "mrc/benchmarking/bottleneck.hpp"
+
+#include <glog/logging.h>
+#include <nlohmann/json.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <sstream>
+#include <utility>
+
+using nlohmann::json;
+
+namespace mrc::benchmarking {
+
+namespace {
+
+std::size_t scaled_pe_count(std::size_t pe_count, double utilization, double target_utilization)
+{
+    return std::max<std::size_t>(1, std::ceil(pe_count * utilization / target_utilization));
+}
+
+}  // namespace
+
+const char* node_state_name(NodeState state)
+{
+    switch (state)
+    {
+    case NodeState::Saturated:
+        return "saturated";
+    case NodeState::Backpressured:
+        return "backpressured";
+    case NodeState::Starved:
+        return "starved";
+    case NodeState::Balanced:
+        return "balanced";
+    }
+    return "unknown";
+}
+
+json BottleneckReport::to_json() const
+{
+    json j;
+    j["sequence"]         = sequence;
+    j["interval_seconds"] = interval_seconds;
+    j["critical_node"]    = (critical_node ? json(*critical_node) : json(nullptr));
+
+    j["nodes"] = json::array();
+    for (const auto& node : nodes)
+    {
+        j["nodes"].push_back({{"name", node.name},
+                              {"state", node_state_name(node.state)},
+                              {"utilization", node.utilization},
+                              {"read_wait_fraction", node.read_wait_fraction},
+                              {"write_wait_fraction", node.write_wait_fraction},
+                              {"input_fill", (node.input_fill ? json(*node.input_fill) : json(nullptr))},
+                              {"pe_count", node.pe_count},
+                              {"recommended_pe_count", node.recommended_pe_count}});
+    }
+    return j;
+}
+
+std::string BottleneckReport::summary() const
+{
+    std::stringstream ss;
+    ss << "bottleneck report " << sequence << " over " << interval_seconds << "s";
+    if (critical_node)
+    {
+        ss << ", critical node: " << *critical_node;
+    }
+    for (const auto& node : nodes)
+    {
+        if (node.state == NodeState::Balanced)
+        {
+            continue;
+        }
+        ss << "\n  " << node.name << ": " << node_state_name(node.state) << ", utilization " << node.utilization
+           << ", pe_count " << node.pe_count << " -> " << node.recommended_pe_count;
+    }
+    return ss.str();
+}
+
+BottleneckReport analyze_bottlenecks(const LiveSample& sample, const BottleneckOptions& options)
+{
+    CHECK_GT(options.target_utilization, 0.0);
+
+    std::map<std::string, const LiveQueueSample*> queues;
+    for (const auto& queue : sample.queues)
+    {
+        queues[queue.name] = &queue;
+    }
+
+    BottleneckReport report;
+    report.sequence         = sample.sequence;
+    report.interval_seconds = sample.interval_seconds;
+
+    const double interval_ns = sample.interval_seconds * 1e9;
+    for (const auto& node : sample.nodes)
+    {
+        NodeDiagnosis diagnosis;
+        diagnosis.name = node.name;
+
+        auto pe_count = options.pe_counts.find(node.name);
+        if (pe_count != options.pe_counts.end())
+        {
+            diagnosis.pe_count = std::max<std::size_t>(1, pe_count->second);
+        }
+        diagnosis.recommended_pe_count = diagnosis.pe_count;
+
+        auto queue = queues.find(node.name);
+        if (queue != queues.end() && queue->second->capacity > 0)
+        {
+            diagnosis.input_fill = static_cast<double>(queue->second->occupancy) / queue->second->capacity;
+        }
+
+        if (interval_ns <= 0.0 || (node.received == 0 && node.emitted == 0))
+        {
+            report.nodes.push_back(std::move(diagnosis));
+            continue;
+        }
+
+        // wait times are summed over the pes of the node
+        const double pe_time_ns = interval_ns * diagnosis.pe_count;
+
+        diagnosis.read_wait_fraction  = std::min(1.0, node.read_wait_ns / pe_time_ns);
+        diagnosis.write_wait_fraction = std::min(1.0, node.write_wait_ns / pe_time_ns);
+        diagnosis.utilization         = 1.0 - std::min(1.0, (node.read_wait_ns + node.write_wait_ns) / pe_time_ns);
+
+        const bool input_full = diagnosis.input_fill && *diagnosis.input_fill >= options.input_fill_threshold;
+        if (diagnosis.write_wait_fraction >= options.wait_threshold)
+        {
+            diagnosis.state = NodeState::Backpressured;
+        }
+        else if (diagnosis.utilization >= options.saturation_threshold || input_full)
+        {
+            auto scaled = scaled_pe_count(diagnosis.pe_count, diagnosis.utilization, options.target_utilization);
+            diagnosis.state                = NodeState::Saturated;
+            diagnosis.recommended_pe_count = std::max(diagnosis.pe_count + 1, scaled);
+        }
+        else if (diagnosis.read_wait_fraction >= options.wait_threshold)
+        {
+            auto scaled = scaled_pe_count(diagnosis.pe_count, diagnosis.utilization, options.target_utilization);
+            diagnosis.state                = NodeState::Starved;
+            diagnosis.recommended_pe_count = std::min(diagnosis.pe_count, scaled);
+        }
+
+        report.nodes.push_back(std::move(diagnosis));
+    }
+
+    std::stable_sort(report.nodes.begin(), report.nodes.end(), [](const NodeDiagnosis& lhs, const NodeDiagnosis& rhs) {
+        return lhs.utilization > rhs.utilization;
+    });
+
+    auto critical = std::find_if(report.nodes.begin(), report.nodes.end(), [](const NodeDiagnosis& node) {
+        return node.state == NodeState::Saturated;
+    });
+    if (critical != report.nodes.end())
+    {
+        report.critical_node = critical->name;
+    }
+    return report;
+}
+
+}  // namespace mrc::benchmarking
@@ -0,0 +1,411 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "mrc/benchmarking/fiber_tracer.hpp"
+
+#include "mrc/metrics/counter.hpp"
+#include "mrc/metrics/registry.hpp"
+
+#include <glog/logging.h>
+#include <nlohmann/json.hpp>
+#include <time.h>
+
+#include <algorithm>
+#include <deque>
+#include <fstream>
+#include <map>
+#include <utility>
+
+using nlohmann::json;
+
+namespace mrc::benchmarking {
+
+namespace {
+
+// number of completed fibers retained by completed_fibers()
+constexpr std::size_t MaxCompletedFibers = 1 << 16;
+
+struct TracerState
+{
+    std::mutex mutex;
+    std::map<std::string, std::unique_ptr<FiberTracer::NameStatistics>> names;
+    std::deque<std::shared_ptr<FiberTracer::ThreadBuffer>> buffers;
+    std::deque<FiberStatistics> completed;
+    std::atomic<std::uint64_t> next_fiber_id{0};
+    std::atomic<std::size_t> max_slices_per_thread{1 << 20};
+    std::uint32_t next_thread_index{0};
+};
+
+TracerState& state()
+{
+    static TracerState s_state;
+    return s_state;
+}
+
+thread_local FiberTracer::FiberState* t_current_fiber{nullptr};
+
+std::int64_t to_ns(std::chrono::nanoseconds duration)
+{
+    return duration.count();
+}
+
+FiberStatistics to_statistics(const FiberTracer::NameStatistics& name)
+{
+    FiberStatistics stats;
+    stats.name             = name.name;
+    stats.fiber_count      = name.fiber_count.load(std::memory_order_relaxed);
+    stats.context_switches = name.context_switches.load(std::memory_order_relaxed);
+    stats.running          = std::chrono::nanoseconds(name.running_ns.load(std::memory_order_relaxed));
+    stats.ready            = std::chrono::nanoseconds(name.ready_ns.load(std::memory_order_relaxed));
+    stats.blocked          = std::chrono::nanoseconds(name.blocked_ns.load(std::memory_order_relaxed));
+    stats.cpu              = std::chrono::nanoseconds(name.cpu_ns.load(std::memory_order_relaxed));
+    stats.channel_wait     = std::chrono::nanoseconds(name.channel_wait_ns.load(std::memory_order_relaxed));
+    return stats;
+}
+
+}  // namespace
+
+FiberTracer::FiberState::~FiberState()
+{
+    if (m_name != nullptr)
+    {
+        accumulate(clock_t::now());
+        record_completed(statistics());
+    }
+}
+
+void FiberTracer::FiberState::on_ready(clock_t::time_point now)
+{
+    if (m_state == State::Created)
+    {
+        static auto& unnamed = find_or_create_name("unnamed");
+        m_name               = &unnamed;
+        m_fiber_id = next_fiber_id();
+        m_name->fiber_count.fetch_add(1, std::memory_order_relaxed);
+        m_last = now;
+    }
+    else
+    {
+        accumulate(now);
+    }
+    m_state = State::Ready;
+}
+
+void FiberTracer::FiberState::on_running(clock_t::time_point now, std::chrono::nanoseconds thread_cpu)
+{
+    accumulate(now);
+    m_state         = State::Running;
+    m_running_since = now;
+    m_cpu_since     = thread_cpu;
+    m_context_switches++;
+    m_name->context_switches.fetch_add(1, std::memory_order_relaxed);
+}
+
+void FiberTracer::FiberState::on_stopped(clock_t::time_point now,
+                                         std::chrono::nanoseconds thread_cpu,
+                                         ThreadBuffer& buffer)
+{
+    if (m_state != State::Running)
+    {
+        return;
+    }
+    accumulate(now);
+
+    auto cpu = thread_cpu - m_cpu_since;
+    m_cpu += cpu;
+    m_name->cpu_ns.fetch_add(to_ns(cpu), std::memory_order_relaxed);
+
+    // running -> blocked is provisional; a fiber which yielded is made ready again immediately after the switch
+    m_state = State::Blocked;
+
+    std::lock_guard<std::mutex> lock(buffer.mutex);
+    if (buffer.slices.size() < max_slices_per_thread())
+    {
+        buffer.slices.push_back(Slice{m_name, m_fiber_id, m_running_since, now});
+    }
+    else
+    {
+        buffer.dropped++;
+    }
+}
+
+void FiberTracer::FiberState::add_channel_wait(std::chrono::nanoseconds duration)
+{
+    if (m_name == nullptr)
+    {
+        return;
+    }
+    m_channel_wait += duration;
+    m_name->channel_wait_ns.fetch_add(to_ns(duration), std::memory_order_relaxed);
+}
+
+void FiberTracer::FiberState::set_name(const std::string& name)
+{
+    auto& next = find_or_create_name(name);
+    if (m_name == &next)
+    {
+        return;
+    }
+
+    // time accumulated so far belongs to the previous name
+    accumulate(clock_t::now());
+    if (m_name != nullptr)
+    {
+        m_name->fiber_count.fetch_sub(1, std::memory_order_relaxed);
+    }
+    m_name = &next;
+    m_name->fiber_count.fetch_add(1, std::memory_order_relaxed);
+}
+
+FiberStatistics FiberTracer::FiberState::statistics() const
+{
+    FiberStatistics stats;
+    stats.name             = (m_name != nullptr ? m_name->name : "unnamed");
+    stats.fiber_count      = 1;
+    stats.context_switches = m_context_switches;
+    stats.running          = m_running;
+    stats.ready            = m_ready;
+    stats.blocked          = m_blocked;
+    stats.cpu              = m_cpu;
+    stats.channel_wait     = m_channel_wait;
+    return stats;
+}
+
+void FiberTracer::FiberState::accumulate(clock_t::time_point now)
+{
+    if (m_name == nullptr)
+    {
+        return;
+    }
+
+    auto delta = std::chrono::duration_cast<std::chrono::nanoseconds>(now - m_last);
+    m_last     = now;
+
+    switch (m_state)
+    {
+    case State::Running:
+        m_running += delta;
+        m_name->running_ns.fetch_add(to_ns(delta), std::memory_order_relaxed);
+        break;
+    case State::Ready:
+        m_ready += delta;
+        m_name->ready_ns.fetch_add(to_ns(delta), std::memory_order_relaxed);
+        break;
+    case State::Blocked:
+        m_blocked += delta;
+        m_name->blocked_ns.fetch_add(to_ns(delta), std::memory_order_relaxed);
+        break;
+    case State::Created:
+        break;
+    }
+}
+
+void FiberTracer::name_current_fiber(const std::string& name)
+{
+    if (t_current_fiber != nullptr)
+    {
+        t_current_fiber->set_name(name);
+    }
+}
+
+void FiberTracer::record_channel_wait(std::chrono::nanoseconds duration)
+{
+    if (t_current_fiber != nullptr)
+    {
+        t_current_fiber->add_channel_wait(duration);
+    }
+}
+
+std::chrono::nanoseconds FiberTracer::thread_cpu_time()
+{
+    timespec ts{};
+    ::clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+    return std::chrono::seconds(ts.tv_sec) + std::chrono::nanoseconds(ts.tv_nsec);
+}
+
+std::vector<FiberStatistics> FiberTracer::collect()
+{
+    auto& s = state();
+    std::lock_guard<std::mutex> lock(s.mutex);
+
+    std::vector<FiberStatistics> results;
+    for (const auto& [name, stats] : s.names)
+    {
+        results.push_back(to_statistics(*stats));
+    }
+    return results;
+}
+
+std::vector<FiberStatistics> FiberTracer::completed_fibers()
+{
+    auto& s = state();
+    std::lock_guard<std::mutex> lock(s.mutex);
+    return {s.completed.begin(), s.completed.end()};
+}
+
+void FiberTracer::export_metrics(metrics::Registry& registry)
+{
+    auto& s = state();
+    std::lock_guard<std::mutex> lock(s.mutex);
+
+    for (auto& [name, stats] : s.names)
+    {
+        auto running  = stats->running_ns.load(std::memory_order_relaxed);
+        auto ready    = stats->ready_ns.load(std::memory_order_relaxed);
+        auto blocked  = stats->blocked_ns.load(std::memory_order_relaxed);
+        auto cpu      = stats->cpu_ns.load(std::memory_order_relaxed);
+        auto wait     = stats->channel_wait_ns.load(std::memory_order_relaxed);
+        auto switches = stats->context_switches.load(std::memory_order_relaxed);
+
+        registry.make_counter("mrc_fiber_running_ns", {{"name", name}}).increment(running - stats->exported_running_ns);
+        registry.make_counter("mrc_fiber_ready_ns", {{"name", name}}).increment(ready - stats->exported_ready_ns);
+        registry.make_counter("mrc_fiber_blocked_ns", {{"name", name}}).increment(blocked - stats->exported_blocked_ns);
+        registry.make_counter("mrc_fiber_cpu_ns", {{"name", name}}).increment(cpu - stats->exported_cpu_ns);
+        registry.make_counter("mrc_fiber_channel_wait_ns", {{"name", name}})
+            .increment(wait - stats->exported_channel_wait_ns);
+        registry.make_counter("mrc_fiber_context_switches", {{"name", name}})
+            .increment(switches - stats->exported_context_switches);
+
+        stats->exported_running_ns       = running;
+        stats->exported_ready_ns         = ready;
+        stats->exported_blocked_ns       = blocked;
+        stats->exported_cpu_ns           = cpu;
+        stats->exported_channel_wait_ns  = wait;
+        stats->exported_context_switches = switches;
+    }
+}
+
+void FiberTracer::write_chrome_trace(const std::string& filename)
+{
+    auto& s = state();
+    std::lock_guard<std::mutex> lock(s.mutex);
+
+    // timestamps are relative to the earliest slice, in microseconds as required by the trace event format
+    auto origin = clock_t::time_point::max();
+    for (const auto& buffer : s.buffers)
+    {
+        std::lock_guard<std::mutex> buffer_lock(buffer->mutex);
+        for (const auto& slice : buffer->slices)
+        {
+            origin = std::min(origin, slice.start);
+        }
+    }
+
+    auto to_us = [origin](clock_t::time_point tp) {
+        return std::chrono::duration<double, std::micro>(tp - origin).count();
+    };
+
+    json events = json::array();
+    for (const auto& buffer : s.buffers)
+    {
+        std::lock_guard<std::mutex> buffer_lock(buffer->mutex);
+        events.push_back({{"name", "process_name"},
+                          {"ph", "M"},
+                          {"pid", buffer->thread_index},
+                          {"args", {{"name", "fiber thread " + std::to_string(buffer->thread_index)}}}});
+        for (const auto& slice : buffer->slices)
+        {
+            events.push_back({{"name", slice.name->name},
+                              {"cat", "fiber"},
+                              {"ph", "X"},
+                              {"pid", buffer->thread_index},
+                              {"tid", slice.fiber_id},
+                              {"ts", to_us(slice.start)},
+                              {"dur", to_us(slice.end) - to_us(slice.start)}});
+        }
+        if (buffer->dropped != 0)
+        {
+            LOG(WARNING) << "fiber thread " << buffer->thread_index << " dropped " << buffer->dropped
+                         << " trace slices; increase FiberTracer::max_slices_per_thread";
+        }
+    }
+
+    std::ofstream file(filename);
+    CHECK(file.good()) << "unable to open " << filename << " for writing";
+    file << json{{"traceEvents", std::move(events)}, {"displayTimeUnit", "ns"}}.dump();
+}
+
+void FiberTracer::max_slices_per_thread(std::size_t count)
+{
+    state().max_slices_per_thread.store(count, std::memory_order_relaxed);
+}
+
+std::size_t FiberTracer::max_slices_per_thread()
+{
+    return state().max_slices_per_thread.load(std::memory_order_relaxed);
+}
+
+void FiberTracer::reset()
+{
+    auto& s = state();
+    std::lock_guard<std::mutex> lock(s.mutex);
+    s.completed.clear();
+    for (const auto& buffer : s.buffers)
+    {
+        std::lock_guard<std::mutex> buffer_lock(buffer->mutex);
+        buffer->slices.clear();
+        buffer->dropped = 0;
+    }
+}
+
+std::shared_ptr<FiberTracer::ThreadBuffer> FiberTracer::make_thread_buffer()
+{
+    auto& s = state();
+    std::lock_guard<std::mutex> lock(s.mutex);
+
+    // buffers are retained after their thread exits so the trace can be written once the pipeline completes
+    auto buffer          = std::make_shared<ThreadBuffer>();
+    buffer->thread_index = s.next_thread_index++;
+    s.buffers.push_back(buffer);
+    return buffer;
+}
+
+void FiberTracer::set_current_fiber(FiberState* state)
+{
+    t_current_fiber = state;
+}
+
+FiberTracer::NameStatistics& FiberTracer::find_or_create_name(const std::string& name)
+{
+    auto& s = state();
+    std::lock_guard<std::mutex> lock(s.mutex);
+
+    auto& stats = s.names[name];
+    if (!stats)
+    {
+        stats = std::unique_ptr<NameStatistics>(new NameStatistics{name});
+    }
+    return *stats;
+}
+
+void FiberTracer::record_completed(FiberStatistics&& statistics)
+{
+    auto& s = state();
+    std::lock_guard<std::mutex> lock(s.mutex);
+    s.completed.push_back(std::move(statistics));
+    if (s.completed.size() > MaxCompletedFibers)
+    {
+        s.completed.pop_front();
+    }
+}
+
+std::uint64_t FiberTracer::next_fiber_id()
+{
+    return state().next_fiber_id.fetch_add(1, std::memory_order_relaxed);
+}
+
+}  // namespace mrc::benchmarking
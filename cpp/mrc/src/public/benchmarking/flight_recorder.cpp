@@ -0,0 +1,358 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "mrc/benchmarking/flight_recorder.hpp"
+
+#include <glog/logging.h>
+#include <nlohmann/json.hpp>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <bit>
+#include <csignal>
+#include <cstdlib>
+#include <fstream>
+#include <mutex>
+#include <optional>
+#include <sstream>
+#include <thread>
+#include <utility>
+
+using nlohmann::json;
+
+namespace mrc::benchmarking {
+
+namespace {
+
+constexpr std::chrono::seconds MinDumpInterval{1};
+
+struct RecorderState
+{
+    std::mutex mutex;
+    std::vector<std::unique_ptr<detail::FlightRing>> rings;
+    std::vector<detail::FlightRing*> free_rings;
+    std::size_t capacity_per_thread{1 << 14};
+
+    // dumps run on a background thread woken through a pipe, which the signal handler may write to
+    std::string dump_directory{"."};
+    std::string pending_reason;
+    std::optional<std::chrono::steady_clock::time_point> last_dump;
+    std::size_t dump_count{0};
+    int pipe_fds[2]{-1, -1};
+};
+
+RecorderState& state()
+{
+    // never destroyed, so threads exiting after static destruction can still return their rings
+    static auto* s_state = new RecorderState;
+    return *s_state;
+}
+
+// returns the ring of an exiting thread to the free list
+struct RingOwner
+{
+    detail::FlightRing* ring{nullptr};
+
+    ~RingOwner()
+    {
+        if (ring != nullptr)
+        {
+            auto& s = state();
+            std::lock_guard<std::mutex> lock(s.mutex);
+            s.free_rings.push_back(ring);
+            detail::t_flight_ring = nullptr;
+        }
+    }
+};
+
+thread_local RingOwner t_ring_owner;
+
+std::int32_t current_thread_id()
+{
+    return static_cast<std::int32_t>(::syscall(SYS_gettid));
+}
+
+std::string dump_trace(const std::string& reason)
+{
+    std::string filename;
+    {
+        auto& s = state();
+        std::lock_guard<std::mutex> lock(s.mutex);
+        std::stringstream ss;
+        ss << s.dump_directory << "/mrc_flight_recorder_" << ::getpid() << "_" << s.dump_count++ << ".json";
+        filename = ss.str();
+    }
+    FlightRecorder::write_trace(filename);
+    LOG(WARNING) << "flight recorder dumped to " << filename << ": " << reason;
+    return filename;
+}
+
+void dump_loop(int fd)
+{
+    char reason_code = 0;
+    while (::read(fd, &reason_code, 1) == 1)
+    {
+        std::string reason = "received signal";
+        if (reason_code == 't')
+        {
+            auto& s = state();
+            std::lock_guard<std::mutex> lock(s.mutex);
+            reason = std::move(s.pending_reason);
+        }
+        dump_trace(reason);
+    }
+}
+
+// lazily creates the pipe and the dump thread; state().mutex must be held
+int dump_pipe_locked()
+{
+    auto& s = state();
+    if (s.pipe_fds[1] < 0)
+    {
+        CHECK_EQ(::pipe(s.pipe_fds), 0) << "unable to create the flight recorder dump pipe";
+        std::thread(dump_loop, s.pipe_fds[0]).detach();
+    }
+    return s.pipe_fds[1];
+}
+
+// the write end of the pipe, read by the signal handler; only written once
+std::atomic<int> s_signal_fd{-1};
+
+void on_dump_signal(int /*signum*/)
+{
+    const char code = 's';
+    auto fd         = s_signal_fd.load(std::memory_order_relaxed);
+    if (fd >= 0)
+    {
+        [[maybe_unused]] auto rc = ::write(fd, &code, 1);
+    }
+}
+
+}  // namespace
+
+std::atomic<bool> FlightRecorder::s_enabled{std::getenv("MRC_FLIGHT_RECORDER") != nullptr};
+
+const char* flight_event_name(FlightEventType type)
+{
+    switch (type)
+    {
+    case FlightEventType::ChannelWrite:
+        return "channel_write";
+    case FlightEventType::ChannelRead:
+        return "channel_read";
+    case FlightEventType::FiberSwitch:
+        return "fiber_switch";
+    case FlightEventType::NetworkSend:
+        return "network_send";
+    case FlightEventType::NetworkRecv:
+        return "network_recv";
+    case FlightEventType::NetworkTaggedMessage:
+        return "network_tagged_message";
+    case FlightEventType::Mark:
+        return "mark";
+    }
+    return "unknown";
+}
+
+namespace detail {
+
+FlightRing::FlightRing(std::size_t capacity) : m_mask(std::bit_ceil(capacity) - 1), m_slots(new Slot[m_mask + 1])
+{
+    adopt();
+}
+
+void FlightRing::read(std::vector<FlightEvent>& events) const
+{
+    const auto head      = m_head.load(std::memory_order_acquire);
+    const auto start     = std::max(m_start.load(std::memory_order_acquire), head > capacity() ? head - capacity() : 0);
+    const auto thread_id = m_thread_id.load(std::memory_order_relaxed);
+
+    // newest first, stopping at the first slot the owner overwrote while it was read: all older slots are gone too
+    const auto first = events.size();
+    for (auto pos = head; pos > start; pos--)
+    {
+        const auto& slot = m_slots[(pos - 1) & m_mask];
+
+        auto sequence  = slot.sequence.load(std::memory_order_acquire);
+        auto timestamp = slot.timestamp.load(std::memory_order_relaxed);
+        auto meta      = slot.meta.load(std::memory_order_relaxed);
+        auto id        = slot.id.load(std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_acquire);
+
+        if (sequence != 2 * pos || slot.sequence.load(std::memory_order_relaxed) != sequence)
+        {
+            break;
+        }
+
+        events.push_back(FlightEvent{
+            std::chrono::steady_clock::time_point(std::chrono::steady_clock::duration(timestamp)),
+            static_cast<FlightEventType>(meta >> 32),
+            static_cast<std::uint32_t>(meta),
+            id,
+            thread_id,
+        });
+    }
+    std::reverse(events.begin() + static_cast<std::ptrdiff_t>(first), events.end());
+}
+
+void FlightRing::adopt()
+{
+    m_thread_id.store(current_thread_id(), std::memory_order_relaxed);
+    m_start.store(m_head.load(std::memory_order_relaxed), std::memory_order_release);
+}
+
+}  // namespace detail
+
+void FlightRecorder::enable(bool flag)
+{
+    s_enabled.store(flag);
+}
+
+bool FlightRecorder::enabled()
+{
+    return s_enabled.load();
+}
+
+void FlightRecorder::capacity_per_thread(std::size_t count)
+{
+    CHECK_GT(count, 0);
+    auto& s = state();
+    std::lock_guard<std::mutex> lock(s.mutex);
+    s.capacity_per_thread = count;
+}
+
+std::vector<FlightEvent> FlightRecorder::snapshot()
+{
+    std::vector<FlightEvent> events;
+    {
+        auto& s = state();
+        std::lock_guard<std::mutex> lock(s.mutex);
+        for (const auto& ring : s.rings)
+        {
+            ring->read(events);
+        }
+    }
+
+    std::stable_sort(events.begin(), events.end(), [](const FlightEvent& lhs, const FlightEvent& rhs) {
+        return lhs.timestamp < rhs.timestamp;
+    });
+    return events;
+}
+
+void FlightRecorder::write_trace(const std::string& filename)
+{
+    auto events = snapshot();
+
+    // timestamps are relative to the earliest event, in microseconds as required by the trace event format
+    auto origin = (events.empty() ? std::chrono::steady_clock::time_point{} : events.front().timestamp);
+    auto pid    = ::getpid();
+
+    json trace_events = json::array();
+    std::vector<std::int32_t> threads;
+    for (const auto& event : events)
+    {
+        if (std::find(threads.begin(), threads.end(), event.thread_id) == threads.end())
+        {
+            threads.push_back(event.thread_id);
+            trace_events.push_back({{"name", "thread_name"},
+                                    {"ph", "M"},
+                                    {"pid", pid},
+                                    {"tid", event.thread_id},
+                                    {"args", {{"name", "thread " + std::to_string(event.thread_id)}}}});
+        }
+
+        std::stringstream id;
+        id << "0x" << std::hex << event.id;
+        trace_events.push_back({{"name", flight_event_name(event.type)},
+                                {"cat", "flight_recorder"},
+                                {"ph", "i"},
+                                {"s", "t"},
+                                {"pid", pid},
+                                {"tid", event.thread_id},
+                                {"ts", std::chrono::duration<double, std::micro>(event.timestamp - origin).count()},
+                                {"args", {{"id", id.str()}, {"value", event.value}}}});
+    }
+
+    std::ofstream file(filename);
+    CHECK(file.good()) << "unable to open " << filename << " for writing";
+    file << json{{"traceEvents", std::move(trace_events)}, {"displayTimeUnit", "ns"}}.dump();
+}
+
+void FlightRecorder::dump_directory(std::string directory)
+{
+    auto& s = state();
+    std::lock_guard<std::mutex> lock(s.mutex);
+    s.dump_directory = std::move(directory);
+}
+
+bool FlightRecorder::trigger_dump(const std::string& reason)
+{
+    auto& s = state();
+    std::lock_guard<std::mutex> lock(s.mutex);
+
+    auto now = std::chrono::steady_clock::now();
+    if (s.last_dump && now - *s.last_dump < MinDumpInterval)
+    {
+        return false;
+    }
+    s.last_dump      = now;
+    s.pending_reason = reason;
+
+    const char code = 't';
+    return ::write(dump_pipe_locked(), &code, 1) == 1;
+}
+
+void FlightRecorder::dump_on_signal(int signum)
+{
+    {
+        auto& s = state();
+        std::lock_guard<std::mutex> lock(s.mutex);
+        s_signal_fd.store(dump_pipe_locked());
+    }
+
+    struct sigaction action
+    {};
+    action.sa_handler = on_dump_signal;
+    sigemptyset(&action.sa_mask);
+    action.sa_flags = SA_RESTART;
+    CHECK_EQ(::sigaction(signum, &action, nullptr), 0) << "unable to install the flight recorder signal handler";
+}
+
+detail::FlightRing* FlightRecorder::acquire_ring()
+{
+    auto& s = state();
+    std::lock_guard<std::mutex> lock(s.mutex);
+
+    detail::FlightRing* ring = nullptr;
+    if (!s.free_rings.empty())
+    {
+        ring = s.free_rings.back();
+        s.free_rings.pop_back();
+        ring->adopt();
+    }
+    else
+    {
+        s.rings.push_back(std::make_unique<detail::FlightRing>(s.capacity_per_thread));
+        ring = s.rings.back().get();
+    }
+
+    detail::t_flight_ring = ring;
+    t_ring_owner.ring     = ring;
+    return ring;
+}
+
+}  // namespace mrc::benchmarking
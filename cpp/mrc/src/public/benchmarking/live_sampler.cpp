@@ -0,0 +1,218 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "mrc/benchmarking/live_sampler.hpp"
+
+#include <glog/logging.h>
+#include <nlohmann/json.hpp>
+
+#include <utility>
+
+using nlohmann::json;
+
+namespace mrc::benchmarking {
+
+namespace {
+
+// totals restart from zero after TraceStatistics::reset; the interval then counts from the reset
+template <typename T>
+T delta(T current, T previous)
+{
+    return (current >= previous ? current - previous : current);
+}
+
+double per_second(std::size_t count, double seconds)
+{
+    return (seconds > 0.0 ? count / seconds : 0.0);
+}
+
+}  // namespace
+
+json LiveSample::to_json() const
+{
+    json j;
+    j["sequence"]         = sequence;
+    j["interval_seconds"] = interval_seconds;
+
+    j["nodes"] = json::array();
+    for (const auto& node : nodes)
+    {
+        j["nodes"].push_back({{"name", node.name},
+                              {"received", node.received},
+                              {"emitted", node.emitted},
+                              {"receive_rate", node.receive_rate},
+                              {"emit_rate", node.emit_rate},
+                              {"mean_latency_ns", node.mean_latency_ns},
+                              {"read_wait_ns", node.read_wait_ns},
+                              {"write_wait_ns", node.write_wait_ns}});
+    }
+
+    j["queues"] = json::array();
+    for (const auto& queue : queues)
+    {
+        j["queues"].push_back({{"name", queue.name},
+                               {"capacity", queue.capacity},
+                               {"occupancy", queue.occupancy},
+                               {"high_water_mark", queue.high_water_mark},
+                               {"reads", queue.reads},
+                               {"writes", queue.writes},
+                               {"blocked_writer_seconds", queue.blocked_writer_seconds},
+                               {"blocked_reader_seconds", queue.blocked_reader_seconds}});
+    }
+    return j;
+}
+
+LiveSampler::LiveSampler(std::chrono::milliseconds period, callback_t on_sample) :
+  m_period(period),
+  m_on_sample(std::move(on_sample)),
+  m_last_sample(std::chrono::steady_clock::now())
+{
+    CHECK_GT(m_period.count(), 0);
+    CHECK(m_on_sample) << "a live sampler requires a callback";
+}
+
+LiveSampler::~LiveSampler()
+{
+    stop();
+}
+
+void LiveSampler::watch_queue(std::string name, queue_probe_t probe)
+{
+    CHECK(probe);
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_queue_probes[std::move(name)] = std::move(probe);
+}
+
+void LiveSampler::start()
+{
+    if (is_running())
+    {
+        return;
+    }
+
+    // the discarded sample is the baseline of the first one, so samples only cover activity from here on
+    sample();
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_sequence = 0;
+    m_running  = true;
+    m_thread   = std::thread([this] { sampling_loop(); });
+}
+
+void LiveSampler::stop()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_running = false;
+    }
+    m_cv.notify_all();
+    if (m_thread.joinable())
+    {
+        CHECK(m_thread.get_id() != std::this_thread::get_id()) << "LiveSampler::stop called from its callback";
+        m_thread.join();
+    }
+}
+
+bool LiveSampler::is_running() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_running;
+}
+
+LiveSample LiveSampler::sample()
+{
+    auto nodes = TraceStatistics::snapshot();
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto now = std::chrono::steady_clock::now();
+
+    LiveSample sample;
+    sample.sequence         = m_sequence++;
+    sample.interval_seconds = std::chrono::duration<double>(now - m_last_sample).count();
+    m_last_sample           = now;
+
+    for (auto& current : nodes)
+    {
+        auto& previous = m_last_nodes[current.name];
+
+        LiveNodeSample node;
+        node.name          = current.name;
+        node.received      = delta(current.receive_count, previous.receive_count);
+        node.emitted       = delta(current.emission_count, previous.emission_count);
+        node.receive_rate  = per_second(node.received, sample.interval_seconds);
+        node.emit_rate     = per_second(node.emitted, sample.interval_seconds);
+        node.read_wait_ns  = delta(current.total_ch_read_elapsed_ns, previous.total_ch_read_elapsed_ns);
+        node.write_wait_ns = delta(current.total_ch_write_elapsed_ns, previous.total_ch_write_elapsed_ns);
+
+        auto internal_ns = delta(current.total_internal_elapsed_ns, previous.total_internal_elapsed_ns);
+        if (node.emitted > 0)
+        {
+            node.mean_latency_ns = static_cast<double>(internal_ns) / node.emitted;
+        }
+
+        sample.nodes.push_back(std::move(node));
+        previous = std::move(current);
+    }
+
+    for (auto it = m_queue_probes.begin(); it != m_queue_probes.end();)
+    {
+        auto current = it->second();
+        if (!current)
+        {
+            m_last_queues.erase(it->first);
+            it = m_queue_probes.erase(it);
+            continue;
+        }
+
+        auto& previous = m_last_queues[it->first];
+
+        LiveQueueSample queue;
+        queue.name            = it->first;
+        queue.capacity        = current->capacity;
+        queue.occupancy       = current->occupancy;
+        queue.high_water_mark = current->high_water_mark;
+        queue.reads           = delta(current->reads, previous.reads);
+        queue.writes          = delta(current->writes, previous.writes);
+        queue.blocked_writer_seconds =
+            std::chrono::duration<double>(delta(current->blocked_writer_time, previous.blocked_writer_time)).count();
+        queue.blocked_reader_seconds =
+            std::chrono::duration<double>(delta(current->blocked_reader_time, previous.blocked_reader_time)).count();
+
+        sample.queues.push_back(std::move(queue));
+        previous = *current;
+        ++it;
+    }
+
+    return sample;
+}
+
+void LiveSampler::sampling_loop()
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while (m_running)
+    {
+        if (m_cv.wait_for(lock, m_period, [this] { return !m_running; }))
+        {
+            break;
+        }
+
+        lock.unlock();
+        m_on_sample(sample());
+        lock.lock();
+    }
+}
+
+}  // namespace mrc::benchmarking
@@ -0,0 +1,358 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2021-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "mrc/benchmarking/message_trace.hpp"
+
+#include <glog/logging.h>
+#include <nlohmann/json.hpp>
+#include <unistd.h>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <climits>
+#include <cstring>
+#include <iomanip>
+#include <random>
+#include <sstream>
+
+namespace mrc::benchmarking {
+
+namespace {
+
+std::atomic<double> s_sample_rate{0.0};
+
+std::mutex& exporter_mutex()
+{
+    static std::mutex mutex;
+    return mutex;
+}
+
+std::shared_ptr<TraceExporter>& exporter_instance()
+{
+    static std::shared_ptr<TraceExporter> exporter;
+    return exporter;
+}
+
+std::string& location_instance()
+{
+    static std::string location = [] {
+        std::array<char, HOST_NAME_MAX + 1> hostname{};
+        if (::gethostname(hostname.data(), hostname.size()) != 0)
+        {
+            return std::string("unknown");
+        }
+        return std::string(hostname.data());
+    }();
+    return location;
+}
+
+std::mt19937_64& thread_rng()
+{
+    thread_local std::mt19937_64 rng(std::random_device{}());
+    return rng;
+}
+
+// ids are never 0, which marks an unsampled context
+std::uint64_t random_id()
+{
+    std::uint64_t id = 0;
+    while (id == 0)
+    {
+        id = thread_rng()();
+    }
+    return id;
+}
+
+std::int64_t to_ns(TraceContext::clock_t::time_point time)
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(time.time_since_epoch()).count();
+}
+
+std::string to_hex(std::uint64_t value)
+{
+    std::ostringstream ss;
+    ss << std::hex << std::setw(16) << std::setfill('0') << value;
+    return ss.str();
+}
+
+template <typename T>
+void pack_value(std::vector<std::byte>& bytes, const T& value)
+{
+    const auto* data = reinterpret_cast<const std::byte*>(&value);
+    bytes.insert(bytes.end(), data, data + sizeof(T));
+}
+
+void pack_string(std::vector<std::byte>& bytes, const std::string& str)
+{
+    pack_value(bytes, static_cast<std::uint32_t>(str.size()));
+    const auto* data = reinterpret_cast<const std::byte*>(str.data());
+    bytes.insert(bytes.end(), data, data + str.size());
+}
+
+class Unpacker
+{
+  public:
+    Unpacker(const std::byte* data, std::size_t size) : m_data(data), m_size(size) {}
+
+    template <typename T>
+    T value()
+    {
+        CHECK_LE(m_offset + sizeof(T), m_size) << "truncated trace context";
+        T value;
+        std::memcpy(&value, m_data + m_offset, sizeof(T));
+        m_offset += sizeof(T);
+        return value;
+    }
+
+    std::string string()
+    {
+        auto length = value<std::uint32_t>();
+        CHECK_LE(m_offset + length, m_size) << "truncated trace context";
+        std::string str(reinterpret_cast<const char*>(m_data + m_offset), length);
+        m_offset += length;
+        return str;
+    }
+
+  private:
+    const std::byte* m_data;
+    std::size_t m_size;
+    std::size_t m_offset{0};
+};
+
+}  // namespace
+
+TraceContext TraceContext::start(std::string name)
+{
+    TraceContext context;
+    auto rate = s_sample_rate.load(std::memory_order_relaxed);
+    if (rate <= 0.0 || std::uniform_real_distribution<double>(0.0, 1.0)(thread_rng()) >= rate)
+    {
+        return context;
+    }
+
+    context.m_trace_id = {random_id(), random_id()};
+    context.m_span_id  = random_id();
+    context.m_start_ns = to_ns(clock_t::now());
+    context.m_name     = std::move(name);
+    return context;
+}
+
+void TraceContext::set_sample_rate(double rate)
+{
+    CHECK(rate >= 0.0 && rate <= 1.0) << "sample rate must be within [0, 1]";
+    s_sample_rate.store(rate);
+}
+
+double TraceContext::sample_rate()
+{
+    return s_sample_rate.load();
+}
+
+void TraceContext::set_location(std::string location)
+{
+    location_instance() = std::move(location);
+}
+
+const std::string& TraceContext::location()
+{
+    return location_instance();
+}
+
+bool TraceContext::sampled() const
+{
+    return m_span_id != 0;
+}
+
+const std::string& TraceContext::name() const
+{
+    return m_name;
+}
+
+const std::vector<TraceHop>& TraceContext::hops() const
+{
+    return m_hops;
+}
+
+const std::array<std::uint64_t, 2>& TraceContext::trace_id() const
+{
+    return m_trace_id;
+}
+
+std::uint64_t TraceContext::span_id() const
+{
+    return m_span_id;
+}
+
+std::int64_t TraceContext::start_ns() const
+{
+    return m_start_ns;
+}
+
+void TraceContext::record_hop(std::string name, clock_t::time_point start, clock_t::time_point end)
+{
+    if (!sampled())
+    {
+        return;
+    }
+    m_hops.push_back({std::move(name), location(), to_ns(start), to_ns(end)});
+}
+
+void TraceContext::finish()
+{
+    if (!sampled())
+    {
+        return;
+    }
+
+    if (auto exporter = TraceExporter::exporter())
+    {
+        exporter->export_trace(*this);
+    }
+    *this = TraceContext();
+}
+
+std::vector<std::byte> TraceContext::pack() const
+{
+    std::vector<std::byte> bytes;
+    pack_value(bytes, m_trace_id[0]);
+    pack_value(bytes, m_trace_id[1]);
+    pack_value(bytes, m_span_id);
+    if (!sampled())
+    {
+        return bytes;
+    }
+
+    pack_value(bytes, m_start_ns);
+    pack_string(bytes, m_name);
+    pack_value(bytes, static_cast<std::uint32_t>(m_hops.size()));
+    for (const auto& hop : m_hops)
+    {
+        pack_string(bytes, hop.name);
+        pack_string(bytes, hop.location);
+        pack_value(bytes, hop.start_ns);
+        pack_value(bytes, hop.end_ns);
+    }
+    return bytes;
+}
+
+TraceContext TraceContext::unpack(const std::byte* data, std::size_t size)
+{
+    Unpacker unpacker(data, size);
+
+    TraceContext context;
+    context.m_trace_id[0] = unpacker.value<std::uint64_t>();
+    context.m_trace_id[1] = unpacker.value<std::uint64_t>();
+    context.m_span_id     = unpacker.value<std::uint64_t>();
+    if (!context.sampled())
+    {
+        return context;
+    }
+
+    context.m_start_ns = unpacker.value<std::int64_t>();
+    context.m_name     = unpacker.string();
+    auto hop_count     = unpacker.value<std::uint32_t>();
+    context.m_hops.reserve(hop_count);
+    for (std::uint32_t i = 0; i < hop_count; i++)
+    {
+        auto& hop    = context.m_hops.emplace_back();
+        hop.name     = unpacker.string();
+        hop.location = unpacker.string();
+        hop.start_ns = unpacker.value<std::int64_t>();
+        hop.end_ns   = unpacker.value<std::int64_t>();
+    }
+    return context;
+}
+
+TraceScope::TraceScope(TraceContext& context, std::string name) :
+  m_context(context),
+  m_name(std::move(name)),
+  m_start(TraceContext::clock_t::now())
+{}
+
+TraceScope::~TraceScope()
+{
+    m_context.record_hop(std::move(m_name), m_start, TraceContext::clock_t::now());
+}
+
+void TraceExporter::set_exporter(std::shared_ptr<TraceExporter> exporter)
+{
+    std::lock_guard<std::mutex> lock(exporter_mutex());
+    exporter_instance() = std::move(exporter);
+}
+
+std::shared_ptr<TraceExporter> TraceExporter::exporter()
+{
+    std::lock_guard<std::mutex> lock(exporter_mutex());
+    return exporter_instance();
+}
+
+OtlpJsonTraceExporter::OtlpJsonTraceExporter(std::ostream& stream, std::string service_name) :
+  m_stream(stream),
+  m_service_name(std::move(service_name))
+{}
+
+void OtlpJsonTraceExporter::export_trace(const TraceContext& context)
+{
+    auto line = to_otlp_json(context, m_service_name);
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_stream << line << '\n';
+    m_stream.flush();
+}
+
+std::string OtlpJsonTraceExporter::to_otlp_json(const TraceContext& context, const std::string& service_name)
+{
+    using nlohmann::json;
+
+    auto string_attribute = [](const std::string& key, const std::string& value) {
+        return json{{"key", key}, {"value", {{"stringValue", value}}}};
+    };
+
+    const auto trace_id = to_hex(context.trace_id()[0]) + to_hex(context.trace_id()[1]);
+    const auto root_id  = to_hex(context.span_id());
+
+    // otlp/json encodes 64-bit integers as strings
+    auto end_ns = std::max(context.start_ns(), to_ns(TraceContext::clock_t::now()));
+    auto spans  = json::array();
+    spans.push_back({{"traceId", trace_id},
+                     {"spanId", root_id},
+                     {"name", context.name()},
+                     {"kind", 1},
+                     {"startTimeUnixNano", std::to_string(context.start_ns())},
+                     {"endTimeUnixNano", std::to_string(end_ns)},
+                     {"attributes", json::array({string_attribute("host.name", TraceContext::location())})}});
+
+    for (const auto& hop : context.hops())
+    {
+        spans.push_back({{"traceId", trace_id},
+                         {"spanId", to_hex(random_id())},
+                         {"parentSpanId", root_id},
+                         {"name", hop.name},
+                         {"kind", 1},
+                         {"startTimeUnixNano", std::to_string(hop.start_ns)},
+                         {"endTimeUnixNano", std::to_string(hop.end_ns)},
+                         {"attributes", json::array({string_attribute("host.name", hop.location)})}});
+    }
+
+    json otlp = {
+        {"resourceSpans",
+         json::array({{{"resource", {{"attributes", json::array({string_attribute("service.name", service_name)})}}},
+                       {"scopeSpans", json::array({{{"scope", {{"name", "mrc"}}}, {"spans", spans}}})}}})}};
+    return otlp.dump();
+}
+
+}  // namespace mrc::benchmarking
@@ -0,0 +1,134 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "mrc/benchmarking/trace_columns.hpp"
+
+#include <glog/logging.h>
+
+#include <algorithm>
+#include <initializer_list>
+#include <utility>
+
+namespace mrc::benchmarking {
+
+namespace {
+
+// nearest rank of percentile of count sorted samples
+std::size_t rank_of(std::size_t count, std::size_t percentile)
+{
+    return std::max<std::size_t>((count * percentile + 99) / 100, 1) - 1;
+}
+
+}  // namespace
+
+TraceColumns::TraceColumns(std::size_t column_count, std::size_t capacity) :
+  m_column_count(column_count),
+  m_capacity(capacity),
+  m_values(column_count * capacity, 0),
+  m_scratch(capacity)
+{}
+
+std::size_t TraceColumns::column_count() const
+{
+    return m_column_count;
+}
+
+std::size_t TraceColumns::capacity() const
+{
+    return m_capacity;
+}
+
+std::size_t TraceColumns::rows() const
+{
+    return m_rows;
+}
+
+std::size_t TraceColumns::append_row()
+{
+    if (m_rows == m_capacity)
+    {
+        return npos;
+    }
+    for (std::size_t column = 0; column < m_column_count; ++column)
+    {
+        m_values[column * m_capacity + m_rows] = 0;
+    }
+    return m_rows++;
+}
+
+void TraceColumns::set(std::size_t row, std::size_t column, std::uint64_t value)
+{
+    DCHECK_LT(row, m_rows);
+    DCHECK_LT(column, m_column_count);
+    m_values[column * m_capacity + row] = value;
+}
+
+std::span<const std::uint64_t> TraceColumns::column(std::size_t column) const
+{
+    CHECK_LT(column, m_column_count);
+    return {m_values.data() + column * m_capacity, m_rows};
+}
+
+ColumnSummary TraceColumns::summarize(std::size_t column) const
+{
+    const auto samples = this->column(column);
+
+    // branch free reductions over the contiguous column; zero samples are rows which did not traverse the cell
+    std::uint64_t sum = 0;
+    std::uint64_t min = std::numeric_limits<std::uint64_t>::max();
+    std::uint64_t max = 0;
+    std::size_t count = 0;
+    for (const auto value : samples)
+    {
+        sum += value;
+        min = std::min(min, value == 0 ? std::numeric_limits<std::uint64_t>::max() : value);
+        max = std::max(max, value);
+        count += static_cast<std::size_t>(value != 0);
+    }
+
+    ColumnSummary summary;
+    if (count == 0)
+    {
+        return summary;
+    }
+    summary.count = count;
+    summary.sum   = sum;
+    summary.min   = min;
+    summary.max   = max;
+
+    // percentiles by successive selection over the non-zero samples, each within the upper part of the previous one
+    auto end = std::copy_if(samples.begin(), samples.end(), m_scratch.begin(), [](auto value) { return value != 0; });
+    auto begin = m_scratch.begin();
+    for (auto [percentile, target] : {std::pair{50UL, &summary.p50}, {90UL, &summary.p90}, {99UL, &summary.p99}})
+    {
+        auto nth = m_scratch.begin() + rank_of(count, percentile);
+        if (nth >= begin)
+        {
+            std::nth_element(begin, nth, end);
+            begin = nth + 1;
+        }
+        *target = *nth;
+    }
+    return summary;
+}
+
+void TraceColumns::clear()
+{
+    m_rows = 0;
+}
+
+}  // namespace mrc::benchmarking
@@ -18,132 +18,250 @@
 #include "mrc/benchmarking/trace_statistics.hpp"
 
 #include "mrc/benchmarking/util.hpp"
-#include "mrc/core/watcher.hpp"  // for WatchableEvent
+#include "mrc/core/watcher.hpp"  // for TraceControl, WatchableEvent
 
 #include <glog/logging.h>
 #include <nlohmann/json.hpp>
 
+#include <algorithm>
+#include <array>
 #include <chrono>
-#include <compare>
 #include <cstdlib>
-#include <iostream>
 #include <map>
-#include <stdexcept>
+#include <mutex>
 #include <string>
-#include <thread>
-#include <utility>  // for pair, make_pair
+#include <utility>
 
 using nlohmann::json;
 
 namespace mrc::benchmarking {
 
-thread_local std::map<std::string, std::shared_ptr<TraceStatistics>> TraceStatistics::TraceObjectMap{};
-std::multimap<std::string, std::shared_ptr<TraceStatistics>> TraceStatistics::TraceObjectMultimap{};
-std::recursive_mutex TraceStatistics::s_state_mutex{};
+namespace {
 
-bool TraceStatistics::s_trace_operators              = (std::getenv("MRC_TRACE_OPERATORS") != nullptr);
-bool TraceStatistics::s_trace_operators_set_manually = false;
-bool TraceStatistics::s_trace_channels               = (std::getenv("MRC_TRACE_CHANNELS") != nullptr);
-bool TraceStatistics::s_trace_channels_set_manually  = false;
-bool TraceStatistics::s_initialized                  = false;
-
-void TraceStatistics::init()
+enum Counter : std::size_t
 {
-    if (s_initialized)
+    Emissions,
+    Receives,
+    ChannelReads,
+    ChannelWrites,
+    InternalElapsedNs,
+    ChannelReadElapsedNs,
+    ChannelWriteElapsedNs,
+    CounterCount,
+};
+
+using counters_t = std::array<std::atomic<std::size_t>, CounterCount>;
+
+// ids index slots in fixed size chunks, so a slot never moves once its chunk is published and is read without locks
+constexpr std::size_t SlotsPerChunk = 64;
+constexpr std::size_t MaxChunks     = 1024;
+
+template <typename SlotT>
+class SlotTable
+{
+    using chunk_t = std::array<SlotT, SlotsPerChunk>;
+
+  public:
+    ~SlotTable()
     {
-        return;
+        for (auto& chunk : m_chunks)
+        {
+            delete chunk.load();
+        }
     }
 
-    TimeUtil::estimate_steady_clock_delay();
-    s_initialized = true;
-}
+    // slot of id, or nullptr if the chunk of id was never created
+    SlotT* find(std::size_t id) const
+    {
+        auto* chunk = m_chunks[id / SlotsPerChunk].load(std::memory_order_acquire);
+        return (chunk == nullptr ? nullptr : &(*chunk)[id % SlotsPerChunk]);
+    }
 
-std::shared_ptr<TraceStatistics> TraceStatistics::get_or_create(const std::string& name)
+    // creates the chunk of id if needed; chunks of a table must only be created by one thread at a time
+    SlotT& get(std::size_t id)
+    {
+        auto& chunk = m_chunks[id / SlotsPerChunk];
+        auto* ptr   = chunk.load(std::memory_order_relaxed);
+        if (ptr == nullptr)
+        {
+            ptr = new chunk_t();
+            chunk.store(ptr, std::memory_order_release);
+        }
+        return (*ptr)[id % SlotsPerChunk];
+    }
+
+  private:
+    std::array<std::atomic<chunk_t*>, MaxChunks> m_chunks{};
+};
+
+// counters of a stats object on one thread; the counters are only written by the owning thread
+struct ThreadSlot
 {
-    std::lock_guard<std::recursive_mutex> lock(s_state_mutex);
+    counters_t counters{};
 
-    auto it = TraceObjectMap.find(name);
-    if (it == TraceObjectMap.end())
-    {
-        std::stringstream sstream;
-        sstream << name << "_" << std::this_thread::get_id();
+    // starts of the intervals being timed, only accessed by the owning thread
+    bool started{false};
+    TimeUtil::time_pt_t internal_chain_start;
+    TimeUtil::time_pt_t channel_read_start;
+    TimeUtil::time_pt_t channel_write_start;
+};
 
-        // TraceStatistics constructor is private to force per-thread unique names and to ensure objects are
-        //  tracked correctly via the cross thread multi-map.
-        auto stats           = std::shared_ptr<TraceStatistics>(new TraceStatistics(name));
-        TraceObjectMap[name] = stats;
-        TraceObjectMultimap.insert(std::make_pair(name, stats));
+// slots of a thread; released when the thread exits and adopted by a later thread along with their totals
+struct ThreadSlots
+{
+    SlotTable<ThreadSlot> slots;
+    std::atomic<bool> in_use{true};
+    ThreadSlots* next{nullptr};
+};
 
-        VLOG(5) << "Creating TracerObjectMap entry for " << sstream.str() << " at 0x" << stats.get() << std::endl;
-    }
+struct Entry
+{
+    std::string name;
+    // totals at the last reset, subtracted from the current totals
+    counters_t baseline{};
+    std::atomic<TimeUtil::time_pt_t::rep> start_time{0};
+};
 
-    return TraceObjectMap[name];
-}
+struct State
+{
+    // only guards the creation of stats objects
+    std::mutex mutex;
+    std::map<std::string, std::shared_ptr<TraceStatistics>> objects;
 
-TraceStatistics::TraceStatistics(const std::string& name) :
-  m_name(name),
-  m_start_time(TimeUtil::get_delay_compensated_time_point()),
-  m_internal_chain_start(m_start_time),
-  m_channel_read_start(m_start_time),
-  m_channel_write_start(m_start_time),
-  m_parent_id(std::this_thread::get_id())
+    SlotTable<Entry> entries;
+    std::atomic<std::size_t> entry_count{0};
+    std::atomic<ThreadSlots*> threads{nullptr};
+};
+
+State& state()
 {
-    initialize_lookup_tables();
+    // leaked, since threads may report to their slots during static destruction
+    static auto* state = new State;
+    return *state;
 }
 
-const std::multimap<std::string, std::shared_ptr<TraceStatistics>>& TraceStatistics::get_thread_local_results_map()
+ThreadSlots* acquire_thread_slots()
 {
-    return TraceObjectMultimap;
+    auto& head = state().threads;
+    for (auto* slots = head.load(std::memory_order_acquire); slots != nullptr; slots = slots->next)
+    {
+        bool expected = false;
+        if (!slots->in_use.load(std::memory_order_relaxed) &&
+            slots->in_use.compare_exchange_strong(expected, true, std::memory_order_acquire))
+        {
+            return slots;
+        }
+    }
+
+    auto* slots = new ThreadSlots;
+    slots->next = head.load(std::memory_order_relaxed);
+    while (!head.compare_exchange_weak(slots->next, slots, std::memory_order_release, std::memory_order_relaxed)) {}
+    return slots;
 }
 
-void TraceStatistics::trace_operators(bool flag, bool sync_immediate)
+struct ThreadSlotsHandle
 {
-    s_trace_operators              = flag;
-    s_trace_operators_set_manually = true;
+    ThreadSlots* slots{nullptr};
 
-    if (sync_immediate)
+    ~ThreadSlotsHandle()
     {
-        sync_state();
+        if (slots != nullptr)
+        {
+            slots->in_use.store(false, std::memory_order_release);
+        }
+    }
+};
+
+ThreadSlot& local_slot(std::size_t id)
+{
+    thread_local ThreadSlotsHandle handle;
+    if (handle.slots == nullptr)
+    {
+        handle.slots = acquire_thread_slots();
+    }
+
+    auto& slot = handle.slots->slots.get(id);
+    if (!slot.started)
+    {
+        slot.started              = true;
+        slot.internal_chain_start = TimeUtil::get_delay_compensated_time_point();
+        slot.channel_read_start   = slot.internal_chain_start;
+        slot.channel_write_start  = slot.internal_chain_start;
     }
+    return slot;
 }
 
-std::tuple<bool, bool> TraceStatistics::trace_operators()
+// counters are single writer, so increments do not need a read-modify-write
+void add(std::atomic<std::size_t>& counter, std::size_t value)
 {
-    return std::make_pair(s_trace_operators, s_trace_operators_set_manually);
+    counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
 }
 
-void TraceStatistics::trace_channels(bool flag, bool sync_immediate)
+std::array<std::size_t, CounterCount> sum_counters(std::size_t id)
 {
-    s_trace_channels              = flag;
-    s_trace_channels_set_manually = true;
+    std::array<std::size_t, CounterCount> totals{};
+    for (auto* slots = state().threads.load(std::memory_order_acquire); slots != nullptr; slots = slots->next)
+    {
+        if (const auto* slot = slots->slots.find(id))
+        {
+            for (std::size_t i = 0; i < CounterCount; i++)
+            {
+                totals[i] += slot->counters[i].load(std::memory_order_relaxed);
+            }
+        }
+    }
+    return totals;
+}
 
-    if (sync_immediate)
+TimeUtil::time_pt_t::rep now_rep()
+{
+    return TimeUtil::get_delay_compensated_time_point().time_since_epoch().count();
+}
+
+TraceStatisticsSnapshot collect(std::size_t id)
+{
+    auto& entry = *state().entries.find(id);
+    auto totals = sum_counters(id);
+    for (std::size_t i = 0; i < CounterCount; i++)
     {
-        sync_state();
+        totals[i] -= entry.baseline[i].load(std::memory_order_relaxed);
     }
+
+    TraceStatisticsSnapshot stats;
+    stats.name                      = entry.name;
+    stats.emission_count            = totals[Emissions];
+    stats.receive_count             = totals[Receives];
+    stats.channel_sink_reads        = totals[ChannelReads];
+    stats.channel_source_writes     = totals[ChannelWrites];
+    stats.total_internal_elapsed_ns = totals[InternalElapsedNs];
+    stats.total_ch_read_elapsed_ns  = totals[ChannelReadElapsedNs];
+    stats.total_ch_write_elapsed_ns = totals[ChannelWriteElapsedNs];
+
+    auto start = TimeUtil::time_pt_t(TimeUtil::time_pt_t::duration(entry.start_time.load(std::memory_order_relaxed)));
+    stats.total_elapsed_ns = TimeUtil::time_resolution_unit_t(TimeUtil::get_current_time_point() - start).count();
+    return stats;
 }
 
-std::tuple<bool, bool> TraceStatistics::trace_channels()
+std::size_t elapsed_ns(const TimeUtil::time_pt_t& start)
 {
-    return std::make_pair(s_trace_channels, s_trace_channels_set_manually);
+    auto now = TimeUtil::get_current_time_point();
+    return (now > start ? TimeUtil::time_resolution_unit_t(now - start) : TimeUtil::s_minimum_resolution).count();
 }
 
 /*
- * @brief return a snapshot in time of the current state. This does race with the writing thread, so it
+ * @brief return a snapshot in time of the current state. This does race with the writing threads, so it
  * should be considered approximately accurate.
  */
-json TraceStatistics::to_json() const
+json snapshot_to_json(const TraceStatisticsSnapshot& stats)
 {
-    std::size_t total_elapsed_ns =
-        TimeUtil::time_resolution_unit_t(TimeUtil::get_current_time_point() - m_start_time).count();
-
-    std::size_t emission_count            = m_emission_count;
-    std::size_t receive_count             = m_receive_count;
-    std::size_t ch_read_count             = m_channel_sink_reads;
-    std::size_t ch_write_count            = m_channel_source_writes;
-    std::size_t total_internal_elapsed_ns = m_total_internal_elapsed_ns;
-    std::size_t total_ch_read_elapsed_ns  = m_total_ch_read_elapsed_ns;
-    std::size_t total_ch_write_elapsed_ns = m_total_ch_write_elapsed_ns;
+    std::size_t total_elapsed_ns          = stats.total_elapsed_ns;
+    std::size_t emission_count            = stats.emission_count;
+    std::size_t receive_count             = stats.receive_count;
+    std::size_t ch_read_count             = stats.channel_sink_reads;
+    std::size_t ch_write_count            = stats.channel_source_writes;
+    std::size_t total_internal_elapsed_ns = stats.total_internal_elapsed_ns;
+    std::size_t total_ch_read_elapsed_ns  = stats.total_ch_read_elapsed_ns;
+    std::size_t total_ch_write_elapsed_ns = stats.total_ch_write_elapsed_ns;
 
     double scaling_coef         = total_elapsed_ns * TimeUtil::NsToSec;
     double emissions_per_second = emission_count / scaling_coef;
@@ -168,6 +286,110 @@ json TraceStatistics::to_json() const
                          {"component_elapsed_total_seconds", total_elapsed_ns * TimeUtil::NsToSec}});
 }
 
+}  // namespace
+
+std::atomic<bool> TraceStatistics::s_trace_operators{std::getenv("MRC_TRACE_OPERATORS") != nullptr};
+std::atomic<bool> TraceStatistics::s_trace_operators_set_manually{false};
+std::atomic<bool> TraceStatistics::s_trace_channels{std::getenv("MRC_TRACE_CHANNELS") != nullptr};
+std::atomic<bool> TraceStatistics::s_trace_channels_set_manually{false};
+
+void TraceStatistics::init()
+{
+    static std::once_flag once;
+    std::call_once(once, [] { TimeUtil::estimate_steady_clock_delay(); });
+}
+
+std::shared_ptr<TraceStatistics> TraceStatistics::get_or_create(const std::string& name)
+{
+    if (s_trace_operators || s_trace_channels)
+    {
+        init();
+    }
+
+    auto& state = benchmarking::state();
+    std::lock_guard<std::mutex> lock(state.mutex);
+
+    auto& stats = state.objects[name];
+    if (!stats)
+    {
+        auto id = state.entry_count.load(std::memory_order_relaxed);
+        CHECK_LT(id, SlotsPerChunk * MaxChunks) << "too many TraceStatistics objects";
+
+        auto& entry = state.entries.get(id);
+        entry.name  = name;
+        entry.start_time.store(now_rep(), std::memory_order_relaxed);
+
+        // TraceStatistics constructor is private to force unique names, so each name has a single id
+        stats = std::shared_ptr<TraceStatistics>(new TraceStatistics(name, id));
+        state.entry_count.store(id + 1, std::memory_order_release);
+
+        VLOG(5) << "Creating TraceStatistics " << name << " with id " << id << " at 0x" << stats.get();
+    }
+
+    return stats;
+}
+
+TraceStatistics::TraceStatistics(std::string name, std::size_t id) : m_name(std::move(name)), m_id(id) {}
+
+std::vector<TraceStatisticsSnapshot> TraceStatistics::snapshot()
+{
+    auto count = state().entry_count.load(std::memory_order_acquire);
+
+    std::vector<TraceStatisticsSnapshot> snapshots;
+    snapshots.reserve(count);
+    for (std::size_t id = 0; id < count; id++)
+    {
+        snapshots.push_back(collect(id));
+    }
+
+    std::sort(snapshots.begin(), snapshots.end(), [](const auto& lhs, const auto& rhs) { return lhs.name < rhs.name; });
+    return snapshots;
+}
+
+void TraceStatistics::trace_operators(bool flag, bool sync_immediate)
+{
+    s_trace_operators              = flag;
+    s_trace_operators_set_manually = true;
+    TraceControl::enable(s_trace_operators || s_trace_channels);
+
+    if (sync_immediate)
+    {
+        sync_state();
+    }
+}
+
+std::tuple<bool, bool> TraceStatistics::trace_operators()
+{
+    return std::make_pair(s_trace_operators.load(), s_trace_operators_set_manually.load());
+}
+
+void TraceStatistics::trace_channels(bool flag, bool sync_immediate)
+{
+    s_trace_channels              = flag;
+    s_trace_channels_set_manually = true;
+    TraceControl::enable(s_trace_operators || s_trace_channels);
+
+    if (sync_immediate)
+    {
+        sync_state();
+    }
+}
+
+std::tuple<bool, bool> TraceStatistics::trace_channels()
+{
+    return std::make_pair(s_trace_channels.load(), s_trace_channels_set_manually.load());
+}
+
+json TraceStatistics::to_json() const
+{
+    return snapshot_to_json(collect(m_id));
+}
+
+std::size_t TraceStatistics::id() const
+{
+    return m_id;
+}
+
 json TraceStatistics::aggregate()
 {
     json aggregation = {{"aggregations",
@@ -210,78 +432,21 @@ json TraceStatistics::aggregate()
 
     json& counters          = aggregation["aggregations"]["metrics"]["counter"];
     json& component_metrics = aggregation["aggregations"]["components"]["metrics"];
-    json& metadata          = aggregation["metadata"];
-    json& data_types        = metadata["metric_data_types"];
-
-    json current_object = {};
-    std::string current_component;
-    std::size_t count = 0;
-    for (auto& it : TraceObjectMultimap)
-    {
-        if (current_component != it.first)
-        {
-            for (json::iterator current_it = current_object.begin(); current_it != current_object.end(); current_it++)
-            {
-                auto key   = current_it.key();
-                auto value = current_it.value();
-
-                // Prometheus style metric storage -- each metric is stored with entries for each component
-                counters[key].push_back({{"labels", {{"component_id", current_component}}}, {"value", value}});
-
-                // Component based metric storage
-                component_metrics[current_component][key] = value;
-            }
-
-            count                                = 0;
-            current_component                    = it.first;
-            current_object                       = it.second->to_json();
-            component_metrics[current_component] = json::object();
-
-            continue;
-        }
-
-        auto sibling = it.second->to_json();
-
-        /*
-         * Note: Sanity check for posterity: obj.get<type> will try to return the underlying memory as the
-         * specified type, it will not do any kind of conversion. So, if your field contains an int and you
-         * make a .get<double> call, you will get back gibberish. The correct way to do the cast would be:
-         * static_cast<double>(obj.get<int>)
-         */
-        for (json::iterator sibling_it = sibling.begin(); sibling_it != sibling.end(); sibling_it++)
-        {
-            auto key   = sibling_it.key();
-            auto value = sibling_it.value();
-
-            if (data_types[key] == "ui")
-            {
-                current_object[key] = current_object[key].get<std::size_t>() + value.get<std::size_t>();
-            }
-            else if (data_types[key] == "d")
-            {
-                current_object[key] = current_object[key].get<double>() + value.get<double>();
-            }
-            else
-            {
-                std::stringstream sstream;
-
-                sstream << "Unknown metric data type: " << key << " -- " << data_types[key];
-                throw std::runtime_error(sstream.str());
-            }
-        }
-
-        count++;
-    }
 
+    // each snapshot already sums the counters of all threads reporting to a component
+    for (const auto& stats : snapshot())
     {
+        auto current_object = snapshot_to_json(stats);
         for (json::iterator current_it = current_object.begin(); current_it != current_object.end(); current_it++)
         {
             auto key   = current_it.key();
             auto value = current_it.value();
 
             // Prometheus style metric storage -- each metric is stored with entries for each component
-            counters[key].push_back({{"labels", {{"component_id", current_component}}}, {"value", value}});
-            component_metrics[current_component][key] = value;
+            counters[key].push_back({{"labels", {{"component_id", stats.name}}}, {"value", value}});
+
+            // Component based metric storage
+            component_metrics[stats.name][key] = value;
         }
     }
 
@@ -290,84 +455,31 @@ json TraceStatistics::aggregate()
 
 void TraceStatistics::channel_read_start()
 {
-    m_channel_read_start = TimeUtil::get_delay_compensated_time_point();
+    local_slot(m_id).channel_read_start = TimeUtil::get_delay_compensated_time_point();
 }
 
 void TraceStatistics::channel_read_end()
 {
-    auto now     = TimeUtil::get_current_time_point();
-    auto elapsed = now > m_channel_read_start ? TimeUtil::time_resolution_unit_t(now - m_channel_write_start)
-                                              : TimeUtil::s_minimum_resolution;
-    m_total_ch_read_elapsed_ns += elapsed.count();
-    m_channel_sink_reads += 1;
+    auto& slot = local_slot(m_id);
+    add(slot.counters[ChannelReadElapsedNs], elapsed_ns(slot.channel_read_start));
+    add(slot.counters[ChannelReads], 1);
 }
 
 void TraceStatistics::channel_write_start()
 {
-    m_channel_write_start = TimeUtil::get_delay_compensated_time_point();
+    local_slot(m_id).channel_write_start = TimeUtil::get_delay_compensated_time_point();
 }
 
 void TraceStatistics::channel_write_end()
 {
-    auto now     = TimeUtil::get_current_time_point();
-    auto elapsed = now > m_channel_write_start ? TimeUtil::time_resolution_unit_t(now - m_channel_write_start)
-                                               : TimeUtil::s_minimum_resolution;
-    m_total_ch_write_elapsed_ns += elapsed.count();
-    m_channel_source_writes += 1;
-    m_internal_chain_start = TimeUtil::get_delay_compensated_time_point();
-}
-
-void TraceStatistics::clear()
-{
-    m_emission_count            = 0;
-    m_receive_count             = 0;
-    m_channel_sink_reads        = 0;
-    m_channel_source_writes     = 0;
-    m_total_ch_read_elapsed_ns  = 0;
-    m_total_ch_write_elapsed_ns = 0;
-    m_total_internal_elapsed_ns = 0;
-    m_start_time                = TimeUtil::get_delay_compensated_time_point();
-}
-
-void TraceStatistics::initialize_lookup_tables()
-{
-    std::function<void(void)> emit_           = []() {};
-    std::function<void(void)> receive_        = []() {};
-    std::function<void(void)> ch_read_start_  = []() {};
-    std::function<void(void)> ch_read_end_    = []() {};
-    std::function<void(void)> ch_write_start_ = []() {};
-    std::function<void(void)> ch_write_end_   = []() {};
-
-    if (TraceStatistics::s_trace_operators)
-    {
-        init();
-        emit_    = [this]() { emit(); };
-        receive_ = [this]() { receive(); };
-    }
-
-    if (TraceStatistics::s_trace_channels)
-    {
-        init();
-        ch_read_start_ = [this]() { channel_read_start(); };
-        ch_read_end_   = [this]() { channel_read_end(); };
-
-        ch_write_start_ = [this]() { channel_write_start(); };
-        ch_write_end_   = [this]() { channel_write_end(); };
-    }
-
-    m_entry_lookup_table[static_cast<std::size_t>(WatchableEvent::sink_on_data)]  = receive_;
-    m_entry_lookup_table[static_cast<std::size_t>(WatchableEvent::channel_read)]  = ch_read_start_;
-    m_entry_lookup_table[static_cast<std::size_t>(WatchableEvent::channel_write)] = ch_write_start_;
-
-    m_exit_lookup_table[static_cast<std::size_t>(WatchableEvent::sink_on_data)]  = emit_;
-    m_exit_lookup_table[static_cast<std::size_t>(WatchableEvent::channel_read)]  = ch_read_end_;
-    m_exit_lookup_table[static_cast<std::size_t>(WatchableEvent::channel_write)] = ch_write_end_;
+    auto& slot = local_slot(m_id);
+    add(slot.counters[ChannelWriteElapsedNs], elapsed_ns(slot.channel_write_start));
+    add(slot.counters[ChannelWrites], 1);
+    slot.internal_chain_start = TimeUtil::get_delay_compensated_time_point();
 }
 
 void TraceStatistics::reset()
 {
-    std::lock_guard<std::recursive_mutex> lock(s_state_mutex);
-
     s_trace_operators              = false;
     s_trace_operators_set_manually = false;
 
@@ -375,60 +487,103 @@ void TraceStatistics::reset()
     s_trace_channels_set_manually = false;
 
     sync_state();
-    for (auto& mm_iter : TraceObjectMultimap)
+
+    // counters are only written by their threads, so a reset records the current totals as the new baseline
+    auto& state = benchmarking::state();
+    auto count  = state.entry_count.load(std::memory_order_acquire);
+    for (std::size_t id = 0; id < count; id++)
     {
-        mm_iter.second->clear();
+        auto& entry = *state.entries.find(id);
+        auto totals = sum_counters(id);
+        for (std::size_t i = 0; i < CounterCount; i++)
+        {
+            entry.baseline[i].store(totals[i], std::memory_order_relaxed);
+        }
+        entry.start_time.store(now_rep(), std::memory_order_relaxed);
     }
 }
 
 void TraceStatistics::sync_state()
 {
-    std::lock_guard<std::recursive_mutex> lock(s_state_mutex);
-
     TraceStatistics::s_trace_operators =
-        s_trace_operators_set_manually ? s_trace_operators : (std::getenv("MRC_TRACE_OPERATORS") != nullptr);
+        s_trace_operators_set_manually ? s_trace_operators.load() : (std::getenv("MRC_TRACE_OPERATORS") != nullptr);
     TraceStatistics::s_trace_channels =
-        s_trace_channels_set_manually ? s_trace_channels : (std::getenv("MRC_TRACE_CHANNELS") != nullptr);
+        s_trace_channels_set_manually ? s_trace_channels.load() : (std::getenv("MRC_TRACE_CHANNELS") != nullptr);
+    TraceControl::enable(s_trace_operators || s_trace_channels);
 
-    for (auto& mm_iter : TraceObjectMultimap)
+    if (s_trace_operators || s_trace_channels)
     {
-        mm_iter.second->initialize_lookup_tables();
+        init();
     }
 }
 
 void TraceStatistics::emit()
 {
-    auto now     = TimeUtil::get_current_time_point();
-    auto elapsed = now > m_internal_chain_start ? TimeUtil::time_resolution_unit_t(now - m_internal_chain_start)
-                                                : TimeUtil::s_minimum_resolution;
-    m_emission_count++;
-    m_total_internal_elapsed_ns += elapsed.count();
+    auto& slot = local_slot(m_id);
+    add(slot.counters[Emissions], 1);
+    add(slot.counters[InternalElapsedNs], elapsed_ns(slot.internal_chain_start));
 
     /* If we're an internal node, this will be re-set on the next receive call; otherwise, we'll use emit->emit timings
      *  to produce a sane metric to report for source node operator latency.
      */
-    m_internal_chain_start = TimeUtil::get_delay_compensated_time_point();
+    slot.internal_chain_start = TimeUtil::get_delay_compensated_time_point();
 }
 
 void TraceStatistics::on_entry(const WatchableEvent& e, const void* data)
 {
-    m_entry_lookup_table[static_cast<std::size_t>(e)]();
+    switch (e)
+    {
+    case WatchableEvent::sink_on_data:
+        if (s_trace_operators.load(std::memory_order_relaxed))
+        {
+            receive();
+        }
+        break;
+    case WatchableEvent::channel_read:
+        if (s_trace_channels.load(std::memory_order_relaxed))
+        {
+            channel_read_start();
+        }
+        break;
+    case WatchableEvent::channel_write:
+        if (s_trace_channels.load(std::memory_order_relaxed))
+        {
+            channel_write_start();
+        }
+        break;
+    }
 }
 
 void TraceStatistics::on_exit(const WatchableEvent& e, bool rc, const void* data)
 {
-    m_exit_lookup_table[static_cast<std::size_t>(e)]();
-}
-
-std::thread::id TraceStatistics::parent_id() const
-{
-    return m_parent_id;
+    switch (e)
+    {
+    case WatchableEvent::sink_on_data:
+        if (s_trace_operators.load(std::memory_order_relaxed))
+        {
+            emit();
+        }
+        break;
+    case WatchableEvent::channel_read:
+        if (s_trace_channels.load(std::memory_order_relaxed))
+        {
+            channel_read_end();
+        }
+        break;
+    case WatchableEvent::channel_write:
+        if (s_trace_channels.load(std::memory_order_relaxed))
+        {
+            channel_write_end();
+        }
+        break;
+    }
 }
 
 void TraceStatistics::receive()
 {
-    m_internal_chain_start = TimeUtil::get_delay_compensated_time_point();
-    m_receive_count++;
+    auto& slot                = local_slot(m_id);
+    slot.internal_chain_start = TimeUtil::get_delay_compensated_time_point();
+    add(slot.counters[Receives], 1);
 }
 
 }  // namespace mrc::benchmarking
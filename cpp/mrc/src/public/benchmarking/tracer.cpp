@@ -17,16 +17,36 @@
 
 #include "mrc/benchmarking/tracer.hpp"
 
+#include "mrc/benchmarking/trace_columns.hpp"
 #include "mrc/benchmarking/util.hpp"
 
 #include <nlohmann/json.hpp>
 
+#include <map>
+#include <memory>
 #include <mutex>
+#include <string>
+#include <vector>
 
 namespace mrc::benchmarking {
 
 using nlohmann::json;
 
+namespace {
+
+json cell_labels(std::size_t emit_idx, std::size_t recv_idx, const json& id_map)
+{
+    auto name_of = [&id_map](std::size_t idx) -> json {
+        auto key = std::to_string(idx);
+        return id_map.contains(key) ? id_map[key] : json("");
+    };
+    return {{"type", emit_idx == recv_idx ? "operator" : "channel"},
+            {"source_name", name_of(emit_idx)},
+            {"dest_name", name_of(recv_idx)}};
+}
+
+}  // namespace
+
 /** Tracer Base **/
 TracerBase::TracerBase(const std::size_t max_nodes) : m_max_nodes(max_nodes) {}
 
@@ -38,64 +58,65 @@ std::size_t TracerBase::max_nodes() const
 /** Latency Tracer **/
 LatencyTracer::LatencyTracer(std::size_t max_nodes) : TracerBase(max_nodes), m_latencies(max_nodes * max_nodes, 0) {}
 
-void LatencyTracer::aggregate(std::vector<std::shared_ptr<TracerBase>> tracers, json& j)
+std::size_t LatencyTracer::column_count(std::size_t max_nodes)
+{
+    return max_nodes * max_nodes;
+}
 
+void LatencyTracer::aggregate(const TraceColumns& columns, std::size_t first_column, json& j)
 {
-    json& metrics           = j["aggregations"]["metrics"]["counter"];
-    json& component_metrics = j["aggregations"]["components"]["metrics"];
-    json& metadata          = j["metadata"];
-    json& id_map            = metadata["id_map"];
+    json& metrics  = j["aggregations"]["metrics"]["counter"];
+    json& metadata = j["metadata"];
+    json& id_map   = metadata["id_map"];
 
     std::size_t node_count = metadata["node_count"];
 
-    /*
-     * Aggregate latency counters
-     */
-    std::vector<double> latencies(node_count * node_count, 0.0);
-    for (auto& _tracer : tracers)
+    for (const auto* name : {"mean", "min", "max", "p50", "p90", "p99"})
     {
-        auto tracer = std::dynamic_pointer_cast<LatencyTracer>(_tracer);
-        CHECK(tracer->max_nodes() == node_count);
-
-        for (std::size_t emit_idx = 0; emit_idx < node_count; ++emit_idx)
-        {
-            for (std::size_t recv_idx = 0; recv_idx < node_count; ++recv_idx)
-            {
-                std::size_t offset = emit_idx * node_count + recv_idx;
-                latencies[offset] += tracer->m_latencies[offset];
-            }
-        }
+        metrics[std::string("component_latency_seconds_") + name] = json::array();
     }
-
-    metrics["component_latency_seconds_mean"] = json::array();
-    json& latency_counters_mean               = metrics["component_latency_seconds_mean"];
+    json& latency_counters_mean = metrics["component_latency_seconds_mean"];
+    json& latency_counters_min  = metrics["component_latency_seconds_min"];
+    json& latency_counters_max  = metrics["component_latency_seconds_max"];
+    json& latency_counters_p50  = metrics["component_latency_seconds_p50"];
+    json& latency_counters_p90  = metrics["component_latency_seconds_p90"];
+    json& latency_counters_p99  = metrics["component_latency_seconds_p99"];
 
     /*
-     * Convert nano-seconds to seconds compute mean latency values.
+     * Summarize the latency column of each cell, converting nano-seconds to seconds; the mean is taken over all
+     * tracers, the min, max and percentiles over the tracers which traversed the cell.
      */
     for (std::size_t emit_idx = 0; emit_idx < node_count; ++emit_idx)
     {
         for (std::size_t recv_idx = 0; recv_idx < node_count; ++recv_idx)
         {
-            std::size_t offset          = emit_idx * node_count + recv_idx;
-            double latency_mean_seconds = ((latencies[offset] * TimeUtil::NsToSec) / tracers.size());
-
-            const std::string cmpt_type = (emit_idx == recv_idx ? "operator" : "channel");
-            if (latency_mean_seconds > 0.0)
+            std::size_t offset = emit_idx * node_count + recv_idx;
+            auto summary       = columns.summarize(first_column + offset);
+            if (summary.count == 0)
             {
-                latency_counters_mean.push_back(
-                    {{"labels",
-                      {{"type", cmpt_type},
-                       {"source_name",
-                        id_map.contains(std::to_string(emit_idx)) ? id_map[std::to_string(emit_idx)] : ""},
-                       {"dest_name",
-                        id_map.contains(std::to_string(recv_idx)) ? id_map[std::to_string(recv_idx)] : ""}}},
-                     {"value", latency_mean_seconds}});
+                continue;
             }
+
+            auto labels = cell_labels(emit_idx, recv_idx, id_map);
+            latency_counters_mean.push_back(
+                {{"labels", labels}, {"value", (summary.sum * TimeUtil::NsToSec) / columns.rows()}});
+            latency_counters_min.push_back({{"labels", labels}, {"value", summary.min * TimeUtil::NsToSec}});
+            latency_counters_max.push_back({{"labels", labels}, {"value", summary.max * TimeUtil::NsToSec}});
+            latency_counters_p50.push_back({{"labels", labels}, {"value", summary.p50 * TimeUtil::NsToSec}});
+            latency_counters_p90.push_back({{"labels", labels}, {"value", summary.p90 * TimeUtil::NsToSec}});
+            latency_counters_p99.push_back({{"labels", labels}, {"value", summary.p99 * TimeUtil::NsToSec}});
         }
     }
 }
 
+void LatencyTracer::write_columns(TraceColumns& columns, std::size_t row, std::size_t first_column) const
+{
+    for (std::size_t offset = 0; offset < m_latencies.size(); ++offset)
+    {
+        columns.set(row, first_column + offset, m_latencies[offset]);
+    }
+}
+
 void LatencyTracer::emit(const std::size_t emit_id,
                          const std::size_t recv_id,
                          const time_pt_t& emit_ts,
@@ -129,7 +150,12 @@ ThroughputTracer::ThroughputTracer(std::size_t max_nodes) :
   m_emitted_by(max_nodes, 0)
 {}
 
-void ThroughputTracer::aggregate(std::vector<std::shared_ptr<TracerBase>> tracers, json& j)
+std::size_t ThroughputTracer::column_count(std::size_t max_nodes)
+{
+    return max_nodes * max_nodes + 2 * max_nodes;
+}
+
+void ThroughputTracer::aggregate(const TraceColumns& columns, std::size_t first_column, json& j)
 {
     json& metrics  = j["aggregations"]["metrics"]["counter"];
     json& metadata = j["metadata"];
@@ -137,22 +163,11 @@ void ThroughputTracer::aggregate(std::vector<std::shared_ptr<TracerBase>> tracer
 
     std::size_t node_count = metadata["node_count"];
 
+    const auto emitted_column = first_column + node_count * node_count;
     std::vector<double> processed(node_count, 0.0);
-    std::vector<double> latencies(node_count * node_count, 0.0);
-    for (auto& _tracer : tracers)
+    for (std::size_t emit_idx = 0; emit_idx < node_count; ++emit_idx)
     {
-        auto tracer = std::dynamic_pointer_cast<ThroughputTracer>(_tracer);
-        CHECK(tracer->max_nodes() == node_count);
-
-        for (std::size_t emit_idx = 0; emit_idx < node_count; ++emit_idx)
-        {
-            processed[emit_idx] += tracer->m_emitted_by[emit_idx];
-            for (std::size_t recv_idx = 0; recv_idx < node_count; ++recv_idx)
-            {
-                std::size_t offset = emit_idx * node_count + recv_idx;
-                latencies[offset] += tracer->m_latencies[offset];
-            }
-        }
+        processed[emit_idx] = columns.summarize(emitted_column + emit_idx).sum;
     }
 
     json& tracer_processed_total  = metrics["component_processed_tracers_total"];
@@ -162,33 +177,33 @@ void ThroughputTracer::aggregate(std::vector<std::shared_ptr<TracerBase>> tracer
         for (std::size_t recv_idx = 0; recv_idx < node_count; recv_idx++)
         {
             std::size_t offset           = emit_idx * node_count + recv_idx;
-            double total_elapsed_seconds = latencies[offset] * TimeUtil::NsToSec;
-            std::string cmpt_type        = (emit_idx == recv_idx ? "operator" : "channel");
+            double total_elapsed_seconds = columns.summarize(first_column + offset).sum * TimeUtil::NsToSec;
 
             if (total_elapsed_seconds > 0.0)
             {
-                tracer_processed_total.push_back(
-                    {{"labels",
-                      {{"type", cmpt_type},
-                       {"source_name",
-                        id_map.contains(std::to_string(emit_idx)) ? id_map[std::to_string(emit_idx)] : ""},
-                       {"dest_name",
-                        id_map.contains(std::to_string(recv_idx)) ? id_map[std::to_string(recv_idx)] : ""}}},
-                     {"value", processed[emit_idx]}});
-
+                auto labels = cell_labels(emit_idx, recv_idx, id_map);
+                tracer_processed_total.push_back({{"labels", labels}, {"value", processed[emit_idx]}});
                 tracer_throughput_total.push_back(
-                    {{"labels",
-                      {{"type", cmpt_type},
-                       {"source_name",
-                        id_map.contains(std::to_string(emit_idx)) ? id_map[std::to_string(emit_idx)] : ""},
-                       {"dest_name",
-                        id_map.contains(std::to_string(recv_idx)) ? id_map[std::to_string(recv_idx)] : ""}}},
-                     {"value", processed[emit_idx] / total_elapsed_seconds}});
+                    {{"labels", labels}, {"value", processed[emit_idx] / total_elapsed_seconds}});
             }
         }
     }
 }
 
+void ThroughputTracer::write_columns(TraceColumns& columns, std::size_t row, std::size_t first_column) const
+{
+    for (std::size_t offset = 0; offset < m_latencies.size(); ++offset)
+    {
+        columns.set(row, first_column + offset, m_latencies[offset]);
+    }
+    first_column += m_latencies.size();
+    for (std::size_t node = 0; node < max_nodes(); ++node)
+    {
+        columns.set(row, first_column + node, m_emitted_by[node]);
+        columns.set(row, first_column + max_nodes() + node, m_received_by[node]);
+    }
+}
+
 void ThroughputTracer::emit(const std::size_t emit_id,
                             const std::size_t recv_id,
                             const time_pt_t& emit_ts,
@@ -225,12 +240,21 @@ void TraceAggregatorBase::process_tracer_data(const std::vector<std::shared_ptr<
                                               double trace_time_elapsed_seconds,
                                               std::size_t segment_node_count,
                                               const std::map<std::size_t, std::string>& cmpt_id_to_name)
+{
+    process_tracer_columns(
+        make_columns(tracers, segment_node_count), trace_time_elapsed_seconds, segment_node_count, cmpt_id_to_name);
+}
+
+void TraceAggregatorBase::process_tracer_columns(const TraceColumns& columns,
+                                                 double trace_time_elapsed_seconds,
+                                                 std::size_t segment_node_count,
+                                                 const std::map<std::size_t, std::string>& cmpt_id_to_name)
 {
     std::lock_guard<std::mutex> lock(m_update_mutex);
 
     m_elapsed_seconds = trace_time_elapsed_seconds;
     m_node_count      = segment_node_count;
-    m_tracer_count    = tracers.size();
+    m_tracer_count    = columns.rows();
     m_json_data       = {
         {
             "metadata",
@@ -243,7 +267,7 @@ void TraceAggregatorBase::process_tracer_data(const std::vector<std::shared_ptr<
         m_json_data["metadata"]["id_map"] = convert_to_string_key_map(cmpt_id_to_name);
     }
 
-    this->aggregate(tracers, m_json_data);
+    this->aggregate(columns, m_json_data);
 }
 
 const json& TraceAggregatorBase::to_json()
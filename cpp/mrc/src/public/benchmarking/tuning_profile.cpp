@@ -0,0 +1,121 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "mrc/benchmarking/tuning_profile.hpp"
+
+#include "mrc/exceptions/runtime_error.hpp"
+
+#include <glog/logging.h>
+#include <nlohmann/json.hpp>
+
+#include <fstream>
+#include <utility>
+
+using nlohmann::json;
+
+namespace mrc::benchmarking {
+
+void TuningProfile::set(std::string name, NodeTuning tuning)
+{
+    CHECK_GT(tuning.pe_count, 0);
+    CHECK_GT(tuning.engines_per_pe, 0);
+    m_nodes[std::move(name)] = tuning;
+}
+
+const NodeTuning* TuningProfile::find(const std::string& name) const
+{
+    auto search = m_nodes.find(name);
+    return (search != m_nodes.end() ? &search->second : nullptr);
+}
+
+const std::map<std::string, NodeTuning>& TuningProfile::nodes() const
+{
+    return m_nodes;
+}
+
+bool TuningProfile::empty() const
+{
+    return m_nodes.empty();
+}
+
+bool TuningProfile::apply(const std::string& name, runnable::LaunchOptions& options) const
+{
+    const auto* tuning = find(name);
+    if (tuning == nullptr)
+    {
+        return false;
+    }
+    options.pe_count       = tuning->pe_count;
+    options.engines_per_pe = tuning->engines_per_pe;
+    return true;
+}
+
+json TuningProfile::to_json() const
+{
+    json j = json::object();
+    for (const auto& [name, tuning] : m_nodes)
+    {
+        j[name] = {{"pe_count", tuning.pe_count},
+                   {"engines_per_pe", tuning.engines_per_pe},
+                   {"channel_size", tuning.channel_size}};
+    }
+    return {{"nodes", std::move(j)}};
+}
+
+TuningProfile TuningProfile::from_json(const json& j)
+{
+    TuningProfile profile;
+    for (const auto& [name, node] : j.at("nodes").items())
+    {
+        NodeTuning tuning;
+        tuning.pe_count       = node.value("pe_count", tuning.pe_count);
+        tuning.engines_per_pe = node.value("engines_per_pe", tuning.engines_per_pe);
+        tuning.channel_size   = node.value("channel_size", tuning.channel_size);
+        profile.set(name, tuning);
+    }
+    return profile;
+}
+
+void TuningProfile::save(const std::string& path) const
+{
+    std::ofstream file(path, std::ios::trunc);
+    file << to_json().dump(2) << '\n';
+    file.flush();
+    if (!file)
+    {
+        throw exceptions::MrcRuntimeError("unable to write the tuning profile to " + path);
+    }
+}
+
+TuningProfile TuningProfile::load(const std::string& path)
+{
+    std::ifstream file(path);
+    if (!file)
+    {
+        throw exceptions::MrcRuntimeError("unable to read the tuning profile from " + path);
+    }
+
+    try
+    {
+        return from_json(json::parse(file));
+    } catch (const json::exception& e)
+    {
+        throw exceptions::MrcRuntimeError("invalid tuning profile " + path + ": " + e.what());
+    }
+}
+
+}  // namespace mrc::benchmarking
@@ -0,0 +1,218 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "mrc/codable/delta_batch.hpp"
+
+#include "mrc/codable/decode.hpp"
+#include "mrc/codable/encode.hpp"
+#include "mrc/codable/encoding_options.hpp"
+#include "mrc/memory/buffer_view.hpp"
+#include "mrc/memory/memory_kind.hpp"
+
+#include <glog/logging.h>
+
+#include <typeindex>
+#include <utility>
+
+namespace mrc::codable {
+
+namespace {
+
+// zero runs shorter than this are kept within a literal, as the lengths of a run cost about as much as its bytes
+constexpr std::size_t MinZeroRun = 4;
+
+void put_varint(std::vector<std::byte>& out, std::uint64_t value)
+{
+    while (value >= 0x80)
+    {
+        out.push_back(static_cast<std::byte>((value & 0x7F) | 0x80));
+        value >>= 7;
+    }
+    out.push_back(static_cast<std::byte>(value));
+}
+
+std::uint64_t get_varint(std::span<const std::byte> in, std::size_t& pos)
+{
+    std::uint64_t value = 0;
+    for (int shift = 0; shift < 64; shift += 7)
+    {
+        CHECK_LT(pos, in.size()) << "truncated delta batch";
+        auto byte = std::to_integer<std::uint64_t>(in[pos++]);
+        value |= (byte & 0x7F) << shift;
+        if ((byte & 0x80) == 0)
+        {
+            return value;
+        }
+    }
+    LOG(FATAL) << "malformed varint in delta batch";
+    return value;
+}
+
+// byte i of the base a record is delta encoded against; the base is zero beyond the previous record
+std::byte base_at(const std::vector<std::byte>& base, std::size_t i)
+{
+    return i < base.size() ? base[i] : std::byte{0};
+}
+
+}  // namespace
+
+void DeltaBatch::append(std::uint64_t key, std::span<const std::byte> record)
+{
+    auto& base = m_previous[key];
+    auto delta = [&](std::size_t i) { return record[i] ^ base_at(base, i); };
+
+    put_varint(m_data, key);
+    put_varint(m_data, record.size());
+
+    // segments of a run of unchanged bytes followed by a literal of changed bytes, until the record is covered
+    std::size_t pos = 0;
+    while (pos < record.size())
+    {
+        auto zeros_end = pos;
+        while (zeros_end < record.size() && delta(zeros_end) == std::byte{0})
+        {
+            ++zeros_end;
+        }
+
+        auto literal_end = zeros_end;
+        while (literal_end < record.size())
+        {
+            if (delta(literal_end) == std::byte{0})
+            {
+                auto run_end = literal_end;
+                while (run_end < record.size() && run_end - literal_end < MinZeroRun &&
+                       delta(run_end) == std::byte{0})
+                {
+                    ++run_end;
+                }
+                if (run_end == record.size() || run_end - literal_end == MinZeroRun)
+                {
+                    break;
+                }
+                literal_end = run_end;
+                continue;
+            }
+            ++literal_end;
+        }
+
+        put_varint(m_data, zeros_end - pos);
+        put_varint(m_data, literal_end - zeros_end);
+        for (auto i = zeros_end; i < literal_end; ++i)
+        {
+            m_data.push_back(delta(i));
+        }
+        pos = literal_end;
+    }
+
+    base.assign(record.begin(), record.end());
+    ++m_size;
+    m_record_bytes += record.size();
+}
+
+void DeltaBatch::for_each(const record_fn_t& on_record) const
+{
+    std::unordered_map<std::uint64_t, std::vector<std::byte>> previous;
+    std::vector<std::byte> record;
+    std::span<const std::byte> in(m_data);
+
+    std::size_t pos = 0;
+    while (pos < in.size())
+    {
+        auto key    = get_varint(in, pos);
+        auto length = get_varint(in, pos);
+        auto& base  = previous[key];
+
+        record.resize(length);
+        std::size_t offset = 0;
+        while (offset < length)
+        {
+            auto zeros   = get_varint(in, pos);
+            auto literal = get_varint(in, pos);
+            CHECK_LE(offset + zeros + literal, length) << "malformed delta batch";
+            CHECK_LE(pos + literal, in.size()) << "truncated delta batch";
+
+            for (auto end = offset + zeros; offset < end; ++offset)
+            {
+                record[offset] = base_at(base, offset);
+            }
+            for (auto end = offset + literal; offset < end; ++offset)
+            {
+                record[offset] = in[pos++] ^ base_at(base, offset);
+            }
+        }
+
+        base = record;
+        on_record(key, record);
+    }
+}
+
+std::size_t DeltaBatch::size() const
+{
+    return m_size;
+}
+
+bool DeltaBatch::empty() const
+{
+    return m_size == 0;
+}
+
+std::size_t DeltaBatch::bytes() const
+{
+    return m_data.size();
+}
+
+std::size_t DeltaBatch::record_bytes() const
+{
+    return m_record_bytes;
+}
+
+const std::vector<std::byte>& DeltaBatch::data() const
+{
+    return m_data;
+}
+
+DeltaBatch DeltaBatch::from_bytes(std::vector<std::byte> bytes)
+{
+    DeltaBatch batch;
+    batch.m_data = std::move(bytes);
+    batch.for_each([&batch](std::uint64_t key, std::span<const std::byte> record) {
+        batch.m_previous[key].assign(record.begin(), record.end());
+        ++batch.m_size;
+        batch.m_record_bytes += record.size();
+    });
+    return batch;
+}
+
+void codable_protocol<DeltaBatch>::serialize(const DeltaBatch& obj,
+                                             Encoder<DeltaBatch>& encoded,
+                                             const EncodingOptions& opts)
+{
+    encoded.add_memory_view({obj.m_data.data(), obj.m_data.size(), memory::memory_kind::host}, opts);
+}
+
+DeltaBatch codable_protocol<DeltaBatch>::deserialize(const Decoder<DeltaBatch>& encoded, std::size_t object_idx)
+{
+    DCHECK_EQ(std::type_index(typeid(DeltaBatch)).hash_code(), encoded.type_index_hash_for_object(object_idx));
+
+    auto idx = encoded.start_idx_for_object(object_idx);
+    std::vector<std::byte> bytes(encoded.buffer_size(idx));
+    encoded.copy_from_buffer(idx, {bytes.data(), bytes.size(), memory::memory_kind::host});
+
+    return DeltaBatch::from_bytes(std::move(bytes));
+}
+
+}  // namespace mrc::codable
@@ -0,0 +1,139 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "mrc/codable/recording.hpp"
+
+#include "internal/codable/codable_storage.hpp"
+#include "internal/resources/manager.hpp"
+
+#include "mrc/exceptions/runtime_error.hpp"
+#include "mrc/protos/codable.pb.h"
+
+#include <glog/logging.h>
+#include <google/protobuf/io/zero_copy_stream_impl.h>
+#include <google/protobuf/util/delimited_message_util.h>
+
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <utility>
+
+namespace mrc::codable {
+
+namespace {
+
+constexpr std::array<char, 8> RecordingMagic{'M', 'R', 'C', 'R', 'E', 'C', '0', '1'};
+
+}  // namespace
+
+RecordingWriter::RecordingWriter(const std::filesystem::path& path) :
+  m_path(path),
+  m_stream(path, std::ios::binary | std::ios::trunc)
+{
+    m_stream.write(RecordingMagic.data(), RecordingMagic.size());
+    if (!m_stream)
+    {
+        throw exceptions::MrcRuntimeError("unable to create the recording " + m_path.string());
+    }
+}
+
+RecordingWriter::~RecordingWriter()
+{
+    m_stream.flush();
+}
+
+void RecordingWriter::flush()
+{
+    m_stream.flush();
+}
+
+std::size_t RecordingWriter::count() const
+{
+    return m_count;
+}
+
+std::unique_ptr<ICodableStorage> RecordingWriter::make_storage()
+{
+    return std::make_unique<internal::codable::CodableStorage>(internal::resources::Manager::get_partition());
+}
+
+EncodingOptions RecordingWriter::encoding_options()
+{
+    EncodingOptions options;
+    options.eager_threshold(std::numeric_limits<std::size_t>::max());
+    return options;
+}
+
+void RecordingWriter::write(const IStorage& storage, std::chrono::nanoseconds offset)
+{
+    CHECK_GE(offset.count(), 0);
+
+    // descriptors referencing memory outside of the encoding, e.g. device memory described in place, do not outlive it
+    for (const auto& desc : storage.proto().descriptors())
+    {
+        if (!desc.has_eager_desc() && !desc.has_meta_data_desc())
+        {
+            throw exceptions::MrcRuntimeError("unable to record an object referencing memory outside of its encoding, "
+                                              "e.g. device memory, to " +
+                                              m_path.string());
+        }
+    }
+
+    protos::RecordedObject record;
+    record.set_offset_ns(offset.count());
+    *record.mutable_encoded_object() = storage.proto();
+    if (!google::protobuf::util::SerializeDelimitedToOstream(record, &m_stream))
+    {
+        throw exceptions::MrcRuntimeError("unable to append to the recording " + m_path.string());
+    }
+    ++m_count;
+}
+
+RecordingReader::RecordingReader(const std::filesystem::path& path) :
+  m_path(path),
+  m_stream(path, std::ios::binary)
+{
+    std::array<char, RecordingMagic.size()> magic{};
+    m_stream.read(magic.data(), magic.size());
+    if (!m_stream || magic != RecordingMagic)
+    {
+        throw exceptions::MrcRuntimeError(m_path.string() + " is not a recording");
+    }
+    m_input = std::make_unique<google::protobuf::io::IstreamInputStream>(&m_stream);
+}
+
+RecordingReader::~RecordingReader() = default;
+
+std::unique_ptr<ICodableStorage> RecordingReader::read(std::chrono::nanoseconds& offset)
+{
+    protos::RecordedObject record;
+    bool clean_eof = false;
+    if (!google::protobuf::util::ParseDelimitedFromZeroCopyStream(&record, m_input.get(), &clean_eof))
+    {
+        if (!clean_eof)
+        {
+            throw exceptions::MrcRuntimeError("the recording " + m_path.string() + " is truncated or corrupt");
+        }
+        return nullptr;
+    }
+
+    offset = std::chrono::nanoseconds(record.offset_ns());
+    return std::make_unique<internal::codable::CodableStorage>(std::move(*record.mutable_encoded_object()),
+                                                               internal::resources::Manager::get_partition());
+}
+
+}  // namespace mrc::codable
@@ -0,0 +1,202 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "mrc/codable/spill_log.hpp"
+
+#include "internal/codable/codable_storage.hpp"
+#include "internal/resources/manager.hpp"
+
+#include "mrc/exceptions/runtime_error.hpp"
+#include "mrc/protos/codable.pb.h"
+
+#include <glog/logging.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstdlib>
+#include <limits>
+#include <string>
+#include <system_error>
+#include <utility>
+
+namespace mrc::codable {
+
+namespace {
+
+std::system_error make_system_error(int err, const std::string& what, const std::filesystem::path& path)
+{
+    return std::system_error(err, std::generic_category(), what + " " + path.string());
+}
+
+// records are the size of the serialized protos::EncodedObject followed by its bytes
+using record_size_t = std::uint64_t;
+
+void write_all(int fd, const void* data, std::size_t bytes, std::uint64_t offset, const std::filesystem::path& path)
+{
+    const auto* pos = static_cast<const char*>(data);
+    while (bytes > 0)
+    {
+        auto written = ::pwrite(fd, pos, bytes, static_cast<off_t>(offset));
+        if (written < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            throw make_system_error(errno, "pwrite", path);
+        }
+        pos += written;
+        offset += written;
+        bytes -= written;
+    }
+}
+
+void read_all(int fd, void* data, std::size_t bytes, std::uint64_t offset, const std::filesystem::path& path)
+{
+    auto* pos = static_cast<char*>(data);
+    while (bytes > 0)
+    {
+        auto read = ::pread(fd, pos, bytes, static_cast<off_t>(offset));
+        if (read < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            throw make_system_error(errno, "pread", path);
+        }
+        if (read == 0)
+        {
+            throw exceptions::MrcRuntimeError("the spill log " + path.string() + " is truncated");
+        }
+        pos += read;
+        offset += read;
+        bytes -= read;
+    }
+}
+
+}  // namespace
+
+SpillLog::SpillLog(const std::filesystem::path& directory)
+{
+    auto path = (directory / "mrc_spill_XXXXXX").string();
+    m_fd      = ::mkstemp(path.data());
+    if (m_fd < 0)
+    {
+        throw make_system_error(errno, "mkstemp", path);
+    }
+    m_path = path;
+}
+
+SpillLog::~SpillLog()
+{
+    ::close(m_fd);
+    ::unlink(m_path.c_str());
+}
+
+void SpillLog::append(const IStorage& storage)
+{
+    for (const auto& desc : storage.proto().descriptors())
+    {
+        if (!desc.has_eager_desc() && !desc.has_meta_data_desc())
+        {
+            throw exceptions::MrcRuntimeError("unable to spill an object referencing memory outside of its encoding, "
+                                              "e.g. device memory, to " +
+                                              m_path.string());
+        }
+    }
+
+    std::string record(sizeof(record_size_t), '\0');
+    if (!storage.proto().AppendToString(&record))
+    {
+        throw exceptions::MrcRuntimeError("unable to serialize an object spilled to " + m_path.string());
+    }
+    const record_size_t size = record.size() - sizeof(record_size_t);
+    record.replace(0, sizeof(size), reinterpret_cast<const char*>(&size), sizeof(size));
+
+    write_all(m_fd, record.data(), record.size(), m_write_offset, m_path);
+    m_write_offset += record.size();
+    ++m_size;
+}
+
+std::unique_ptr<ICodableStorage> SpillLog::read()
+{
+    if (m_size == 0)
+    {
+        return nullptr;
+    }
+
+    record_size_t size;
+    read_all(m_fd, &size, sizeof(size), m_read_offset, m_path);
+    std::string record(size, '\0');
+    read_all(m_fd, record.data(), size, m_read_offset + sizeof(size), m_path);
+
+    protos::EncodedObject encoded_object;
+    if (!encoded_object.ParseFromString(record))
+    {
+        throw exceptions::MrcRuntimeError("the spill log " + m_path.string() + " is corrupt");
+    }
+
+    m_read_offset += sizeof(size) + size;
+    if (--m_size == 0)
+    {
+        // the log is drained; the file is truncated rather than growing with every spill
+        if (::ftruncate(m_fd, 0) != 0)
+        {
+            throw make_system_error(errno, "ftruncate", m_path);
+        }
+        m_read_offset  = 0;
+        m_write_offset = 0;
+    }
+
+    return std::make_unique<internal::codable::CodableStorage>(std::move(encoded_object),
+                                                               internal::resources::Manager::get_partition());
+}
+
+std::size_t SpillLog::size() const
+{
+    return m_size;
+}
+
+bool SpillLog::empty() const
+{
+    return m_size == 0;
+}
+
+std::uint64_t SpillLog::bytes() const
+{
+    return m_write_offset - m_read_offset;
+}
+
+const std::filesystem::path& SpillLog::path() const
+{
+    return m_path;
+}
+
+std::unique_ptr<ICodableStorage> SpillLog::make_storage()
+{
+    return std::make_unique<internal::codable::CodableStorage>(internal::resources::Manager::get_partition());
+}
+
+EncodingOptions SpillLog::encoding_options()
+{
+    EncodingOptions options;
+    options.eager_threshold(std::numeric_limits<std::size_t>::max());
+    return options;
+}
+
+}  // namespace mrc::codable
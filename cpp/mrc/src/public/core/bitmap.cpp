@@ -142,32 +142,33 @@ Bitmap Bitmap::set_union(const Bitmap& other) const
 
 void Bitmap::append(const Bitmap& bitmap)
 {
-    bitmap.for_each_bit([this](std::uint32_t idx, std::uint32_t bit) { this->on(bit); });
+    CHECK_HWLOC(hwloc_bitmap_or(m_bitmap, m_bitmap, &bitmap.bitmap()));
 }
 
 std::vector<std::uint32_t> Bitmap::vec() const
 {
-    std::uint32_t index;
     std::vector<std::uint32_t> v;
-    hwloc_bitmap_foreach_begin(index, m_bitmap)
-    {
-        v.push_back(index);
-    }
-    hwloc_bitmap_foreach_end();
+    v.reserve(weight());
+    for_each_bit([&v](std::uint32_t /*idx*/, std::uint32_t bit) { v.push_back(bit); });
     return v;
 }
 std::string Bitmap::str() const
 {
     return print_ranges(find_ranges(vec()));
 }
-void Bitmap::for_each_bit(std::function<void(std::uint32_t, std::uint32_t)> lambda) const
+std::vector<unsigned long> Bitmap::words() const
 {
-    const auto count = weight();
-    for (int i = 0, prev = -1; i < count; i++)
-    {
-        prev = next(prev);
-        lambda(i, prev);
-    }
+    auto nr = hwloc_bitmap_nr_ulongs(m_bitmap);
+    CHECK_NE(nr, -1) << "word access requires a finite bitmap";
+    std::vector<unsigned long> words(nr);
+    CHECK_HWLOC(hwloc_bitmap_to_ulongs(m_bitmap, nr, words.data()));
+    return words;
+}
+Bitmap Bitmap::from_words(const std::vector<unsigned long>& words)
+{
+    Bitmap bitmap;
+    CHECK_HWLOC(hwloc_bitmap_from_ulongs(bitmap.m_bitmap, words.size(), words.data()));
+    return bitmap;
 }
 void Bitmap::zero()
 {
@@ -176,57 +177,73 @@ void Bitmap::zero()
 
 Bitmap Bitmap::pop(std::size_t nbits)
 {
-    Bitmap rv;
     CHECK_LE(nbits, weight()) << "pop requesting more bits than set in bitmap";
 
-    for (long i = 0, prev = -1; i < nbits; ++i)
+    // the lowest nbits on bits are moved a word at a time
+    auto remaining = words();
+    std::vector<unsigned long> popped(remaining.size(), 0);
+    for (std::size_t w = 0; w < remaining.size() && nbits > 0; ++w)
     {
-        prev = next(prev);
-        DCHECK_NE(prev, -1);
-        rv.on(prev);
-        off(prev);
+        auto& word = remaining[w];
+        while (word != 0 && nbits > 0)
+        {
+            const auto lowest = word & (~word + 1);
+            popped[w] |= lowest;
+            word &= ~lowest;
+            --nbits;
+        }
     }
 
-    return rv;
+    CHECK_HWLOC(hwloc_bitmap_from_ulongs(m_bitmap, remaining.size(), remaining.data()));
+    return from_words(popped);
 }
 
 std::vector<Bitmap> Bitmap::split(int nways) const
 {
     CHECK_GT(nways, 0);
-    int div = weight() / nways;
-    int rem = weight() % nways;
+    const int div = weight() / nways;
+    const int rem = weight() % nways;
 
-    Bitmap copy = *this;
-    std::vector<Bitmap> v;
-    for (int i = 0; i < nways; ++i)
+    // bits are dealt to the groups in order in a single pass over the words of the bitmap
+    const auto source = words();
+    std::vector<std::vector<unsigned long>> groups(nways, std::vector<unsigned long>(source.size(), 0));
+    int group = 0;
+    int count = 0;
+    for (std::size_t w = 0; w < source.size(); ++w)
     {
-        int count = div + (i < rem ? 1 : 0);
-        if (count != 0)
+        auto word = source[w];
+        while (word != 0)
         {
-            v.push_back(copy.pop(count));
-        }
-        else
-        {
-            v.emplace_back();
+            while (count == div + (group < rem ? 1 : 0))
+            {
+                ++group;
+                count = 0;
+            }
+            const auto lowest = word & (~word + 1);
+            groups[group][w] |= lowest;
+            word &= ~lowest;
+            ++count;
         }
     }
+
+    std::vector<Bitmap> v;
+    v.reserve(nways);
+    for (const auto& group_words : groups)
+    {
+        v.push_back(from_words(group_words));
+    }
     return v;
 }
 
-RoundRobinCpuSet::RoundRobinCpuSet(CpuSet bits) : m_bits(std::move(bits)), m_prev(-1), m_index(-1) {}
+RoundRobinCpuSet::RoundRobinCpuSet(CpuSet bits) : m_bits(std::move(bits))
+{
+    m_bits.for_each_bit([this](std::uint32_t /*idx*/, std::uint32_t id) { m_ids.push_back(id); });
+}
 std::pair<int, int> RoundRobinCpuSet::next()
 {
-    std::unique_lock<std::mutex> lock(m_mutex);
-    auto id = hwloc_bitmap_next(&m_bits.bitmap(), m_prev);
-    m_prev  = id;
-    m_index++;
-    if (id == -1)
-    {
-        m_index = -1;
-        lock.unlock();
-        return next();
-    }
-    return std::make_pair(m_index, id);
+    CHECK(!m_ids.empty()) << "round robin over an empty cpu_set";
+    const auto index = m_cursor.fetch_add(1, std::memory_order_relaxed) % m_ids.size();
+    return std::make_pair(static_cast<int>(index), m_ids[index]);
 }
 int RoundRobinCpuSet::next_index()
 {
@@ -247,7 +264,7 @@ CpuSet RoundRobinCpuSet::next_binding()
 }
 void RoundRobinCpuSet::reset()
 {
-    m_prev = m_index = -1;
+    m_cursor.store(0, std::memory_order_relaxed);
 }
 const CpuSet& RoundRobinCpuSet::cpu_set() const
 {
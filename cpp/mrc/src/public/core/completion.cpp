@@ -0,0 +1,196 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "mrc/core/completion.hpp"
+
+#include "mrc/types.hpp"
+
+#include <glog/logging.h>
+
+#include <mutex>
+
+namespace mrc::detail {
+
+// waiter on the stack of a fiber or thread blocked in wait(); fiber synchronization primitives also block plain threads
+class CompletionBase::BlockingWaiter : public Waiter
+{
+  public:
+    void notify() override
+    {
+        // the waiter may be destroyed as soon as it observes the notification; notify while holding the lock
+        std::lock_guard<Mutex> lock(m_mutex);
+        m_notified = true;
+        m_cv.notify_all();
+    }
+
+    void wait()
+    {
+        std::unique_lock<Mutex> lock(m_mutex);
+        m_cv.wait(lock, [this] { return m_notified; });
+    }
+
+    bool wait_for(std::chrono::nanoseconds timeout)
+    {
+        std::unique_lock<Mutex> lock(m_mutex);
+        return m_cv.wait_for(lock, timeout, [this] { return m_notified; });
+    }
+
+  private:
+    Mutex m_mutex;
+    CondV m_cv;
+    bool m_notified{false};
+};
+
+// waiter of wait_for; owned by both the list and the waiting fiber or thread, since the timeout may expire while the
+// waiter is still in the list
+class CompletionBase::TimedWaiter final : public BlockingWaiter
+{
+  public:
+    void notify() final
+    {
+        BlockingWaiter::notify();
+        release();
+    }
+
+    void abandon() final
+    {
+        release();
+    }
+
+    void release()
+    {
+        if (m_references.fetch_sub(1, std::memory_order_acq_rel) == 1)
+        {
+            delete this;
+        }
+    }
+
+  private:
+    std::atomic<int> m_references{2};
+};
+
+CompletionBase::~CompletionBase()
+{
+    auto* state = m_state.load(std::memory_order_acquire);
+    if (state != this && state != nullptr)
+    {
+        abandon_waiters(state);
+    }
+}
+
+void CompletionBase::Waiter::abandon()
+{
+    LOG(FATAL) << "a completion was reset or destroyed while being awaited";
+}
+
+void CompletionBase::wait() const
+{
+    if (is_ready())
+    {
+        return;
+    }
+
+    BlockingWaiter waiter;
+    if (push(&waiter))
+    {
+        waiter.wait();
+    }
+}
+
+bool CompletionBase::wait_for(std::chrono::nanoseconds timeout) const
+{
+    if (is_ready())
+    {
+        return true;
+    }
+
+    auto* waiter = new TimedWaiter;
+    if (!push(waiter))
+    {
+        delete waiter;
+        return true;
+    }
+
+    const bool ready = waiter->wait_for(timeout);
+    waiter->release();
+    return ready;
+}
+
+bool CompletionBase::push(Waiter* waiter) const noexcept
+{
+    void* state = m_state.load(std::memory_order_acquire);
+    do
+    {
+        if (state == this)
+        {
+            return false;
+        }
+        waiter->m_next = static_cast<Waiter*>(state);
+    } while (!m_state.compare_exchange_weak(state, waiter, std::memory_order_release, std::memory_order_acquire));
+    return true;
+}
+
+void CompletionBase::set_ready() noexcept
+{
+    auto* state = m_state.exchange(this, std::memory_order_acq_rel);
+    DCHECK(state != this);
+
+    auto* waiter = static_cast<Waiter*>(state);
+    while (waiter != nullptr)
+    {
+        // the node may be destroyed by notify
+        auto* next = waiter->m_next;
+        waiter->notify();
+        waiter = next;
+    }
+}
+
+void CompletionBase::reset_ready() noexcept
+{
+    auto* state = m_state.exchange(nullptr, std::memory_order_acq_rel);
+    if (state != this && state != nullptr)
+    {
+        abandon_waiters(state);
+    }
+}
+
+void CompletionBase::abandon_waiters(void* state) noexcept
+{
+    auto* waiter = static_cast<Waiter*>(state);
+    while (waiter != nullptr)
+    {
+        auto* next = waiter->m_next;
+        waiter->abandon();
+        waiter = next;
+    }
+}
+
+bool CompletionBase::AwaiterBase::await_suspend(std::coroutine_handle<> awaiting_coroutine) noexcept
+{
+    m_awaiting_coroutine = awaiting_coroutine;
+
+    // captured before the awaiter is published, since the completion may resume it right away
+    suspend_thread_local_context();
+    return m_completion.push(this);
+}
+
+void CompletionBase::AwaiterBase::notify()
+{
+    resume_coroutine(m_awaiting_coroutine);
+}
+
+}  // namespace mrc::detail
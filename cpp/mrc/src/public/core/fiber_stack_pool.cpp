@@ -0,0 +1,214 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2021-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "mrc/core/fiber_stack_pool.hpp"
+
+#include <boost/context/stack_traits.hpp>
+#include <glog/logging.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <new>
+#include <utility>
+
+namespace mrc {
+
+namespace {
+
+std::size_t round_up(std::size_t size, std::size_t alignment)
+{
+    return (size + alignment - 1) / alignment * alignment;
+}
+
+}  // namespace
+
+FiberStackPool::Allocator::Allocator(std::shared_ptr<FiberStackPool> pool) : m_pool(std::move(pool))
+{
+    CHECK(m_pool);
+}
+
+boost::context::stack_context FiberStackPool::Allocator::allocate()
+{
+    return m_pool->pop();
+}
+
+void FiberStackPool::Allocator::deallocate(boost::context::stack_context& sctx) noexcept
+{
+    m_pool->push(sctx);
+}
+
+std::shared_ptr<FiberStackPool> FiberStackPool::create(std::size_t stack_size,
+                                                       std::size_t capacity,
+                                                       bool protect,
+                                                       bool prefault)
+{
+    return std::shared_ptr<FiberStackPool>(new FiberStackPool(stack_size, capacity, protect, prefault));
+}
+
+FiberStackPool::FiberStackPool(std::size_t stack_size, std::size_t capacity, bool protect, bool prefault) :
+  m_page_size(::sysconf(_SC_PAGESIZE)),
+  m_stack_size(round_up(std::max(stack_size, boost::context::stack_traits::minimum_size()), m_page_size)),
+  m_mapped_size(m_stack_size + (protect ? m_page_size : 0)),
+  m_capacity(capacity),
+  m_protect(protect),
+  m_prefault(prefault)
+{
+    m_free.reserve(m_capacity);
+}
+
+FiberStackPool::~FiberStackPool()
+{
+    // fibers hold a reference to the pool until they have returned their stack, so only free stacks are left
+    DCHECK_EQ(m_free.size(), m_mapped_count);
+    for (auto* base : m_free)
+    {
+        unmap_stack(base);
+    }
+}
+
+FiberStackPool::Allocator FiberStackPool::allocator()
+{
+    return Allocator(shared_from_this());
+}
+
+void FiberStackPool::reserve(std::size_t count)
+{
+    count = std::min(count, m_capacity);
+    std::lock_guard<decltype(m_mutex)> lock(m_mutex);
+    while (m_free.size() < count)
+    {
+        m_free.push_back(map_stack());
+        m_mapped_count++;
+    }
+}
+
+boost::context::stack_context FiberStackPool::pop()
+{
+    void* base = nullptr;
+    {
+        std::lock_guard<decltype(m_mutex)> lock(m_mutex);
+        if (!m_free.empty())
+        {
+            base = m_free.back();
+            m_free.pop_back();
+        }
+        else
+        {
+            // count the stack before mapping it so the accounting stays consistent if mapping throws
+            m_mapped_count++;
+        }
+    }
+
+    if (base == nullptr)
+    {
+        try
+        {
+            base = map_stack();
+        } catch (...)
+        {
+            std::lock_guard<decltype(m_mutex)> lock(m_mutex);
+            m_mapped_count--;
+            throw;
+        }
+    }
+
+    boost::context::stack_context sctx;
+    sctx.size = m_stack_size;
+    sctx.sp   = static_cast<char*>(base) + m_mapped_size;
+    return sctx;
+}
+
+void FiberStackPool::push(boost::context::stack_context& sctx) noexcept
+{
+    void* base = static_cast<char*>(sctx.sp) - m_mapped_size;
+    {
+        std::lock_guard<decltype(m_mutex)> lock(m_mutex);
+        if (m_free.size() < m_capacity)
+        {
+            m_free.push_back(base);
+            return;
+        }
+        m_mapped_count--;
+    }
+    unmap_stack(base);
+}
+
+void* FiberStackPool::map_stack() const
+{
+    int flags = MAP_PRIVATE | MAP_ANONYMOUS | MAP_STACK;
+    if (m_prefault)
+    {
+        flags |= MAP_POPULATE;
+    }
+
+    void* base = ::mmap(nullptr, m_mapped_size, PROT_READ | PROT_WRITE, flags, -1, 0);
+    if (base == MAP_FAILED)
+    {
+        LOG(ERROR) << "failed to map a fiber stack of " << m_mapped_size << " bytes";
+        throw std::bad_alloc();
+    }
+
+    // stacks grow down, so the guard page is the lowest page of the mapping
+    if (m_protect && ::mprotect(base, m_page_size, PROT_NONE) != 0)
+    {
+        ::munmap(base, m_mapped_size);
+        LOG(ERROR) << "failed to protect the guard page of a fiber stack";
+        throw std::bad_alloc();
+    }
+
+    return base;
+}
+
+void FiberStackPool::unmap_stack(void* base) const noexcept
+{
+    ::munmap(base, m_mapped_size);
+}
+
+std::size_t FiberStackPool::stack_size() const
+{
+    return m_stack_size;
+}
+
+std::size_t FiberStackPool::capacity() const
+{
+    return m_capacity;
+}
+
+bool FiberStackPool::protect() const
+{
+    return m_protect;
+}
+
+bool FiberStackPool::prefault() const
+{
+    return m_prefault;
+}
+
+std::size_t FiberStackPool::free_count() const
+{
+    std::lock_guard<decltype(m_mutex)> lock(m_mutex);
+    return m_free.size();
+}
+
+std::size_t FiberStackPool::mapped_count() const
+{
+    std::lock_guard<decltype(m_mutex)> lock(m_mutex);
+    return m_mapped_count;
+}
+
+}  // namespace mrc
@@ -0,0 +1,135 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "mrc/core/time_slice.hpp"
+
+#include "mrc/metrics/counter.hpp"
+#include "mrc/metrics/gauge.hpp"
+#include "mrc/metrics/registry.hpp"
+#include "mrc/runnable/context.hpp"
+
+#include <boost/fiber/operations.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <map>
+#include <memory>
+#include <mutex>
+
+namespace mrc {
+
+namespace {
+
+// totals of a runnable; instances are never destroyed
+struct Account
+{
+    std::atomic<std::uint64_t> yields{0};
+    std::atomic<std::int64_t> overrun_ns{0};
+    std::atomic<std::int64_t> max_overrun_ns{0};
+
+    // values reported by the last call to export_metrics
+    std::uint64_t exported_yields{0};
+    std::int64_t exported_overrun_ns{0};
+};
+
+struct AccountsState
+{
+    std::mutex mutex;
+    std::map<std::string, std::unique_ptr<Account>> accounts;
+};
+
+AccountsState& state()
+{
+    // never destroyed, fibers may yield while static destructors run
+    static auto* s_state = new AccountsState();
+    return *s_state;
+}
+
+Account& current_account()
+{
+    static const std::string unnamed;
+    const auto& name =
+        (runnable::Context::has_runtime_context() ? runnable::Context::get_runtime_context().name() : unnamed);
+
+    // yields are at most one per budget of a fiber, so the lookup is off the hot path
+    auto& s = state();
+    std::lock_guard<std::mutex> lock(s.mutex);
+    auto& account = s.accounts[name];
+    if (!account)
+    {
+        account = std::make_unique<Account>();
+    }
+    return *account;
+}
+
+}  // namespace
+
+void TimeSlice::yield(clock_type::duration overrun)
+{
+    const auto overrun_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(overrun).count();
+
+    auto& account = current_account();
+    account.yields.fetch_add(1, std::memory_order_relaxed);
+    account.overrun_ns.fetch_add(overrun_ns, std::memory_order_relaxed);
+    auto max = account.max_overrun_ns.load(std::memory_order_relaxed);
+    while (overrun_ns > max && !account.max_overrun_ns.compare_exchange_weak(max, overrun_ns))
+    {}
+
+    // the scheduler starts a new slice when the fiber is resumed
+    boost::this_fiber::yield();
+}
+
+std::vector<TimeSliceUsage> TimeSlice::collect()
+{
+    auto& s = state();
+    std::lock_guard<std::mutex> lock(s.mutex);
+
+    std::vector<TimeSliceUsage> results;
+    for (const auto& [name, account] : s.accounts)
+    {
+        auto& usage       = results.emplace_back();
+        usage.name        = name;
+        usage.yields      = account->yields.load(std::memory_order_relaxed);
+        usage.overrun     = std::chrono::nanoseconds(account->overrun_ns.load(std::memory_order_relaxed));
+        usage.max_overrun = std::chrono::nanoseconds(account->max_overrun_ns.load(std::memory_order_relaxed));
+    }
+    return results;
+}
+
+void TimeSlice::export_metrics(metrics::Registry& registry)
+{
+    auto& s = state();
+    std::lock_guard<std::mutex> lock(s.mutex);
+
+    for (auto& [name, account] : s.accounts)
+    {
+        const std::map<std::string, std::string> labels{{"name", name}};
+        auto yields     = account->yields.load(std::memory_order_relaxed);
+        auto overrun_ns = account->overrun_ns.load(std::memory_order_relaxed);
+
+        registry.make_counter("mrc_time_slice_yields", labels).increment(yields - account->exported_yields);
+        registry.make_counter("mrc_time_slice_overrun_ns", labels)
+            .increment(overrun_ns - account->exported_overrun_ns);
+        registry.make_gauge("mrc_time_slice_max_overrun_ns", labels)
+            .set(account->max_overrun_ns.load(std::memory_order_relaxed));
+
+        account->exported_yields     = yields;
+        account->exported_overrun_ns = overrun_ns;
+    }
+}
+
+}  // namespace mrc
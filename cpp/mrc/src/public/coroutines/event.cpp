@@ -40,9 +40,39 @@
 
 #include "mrc/coroutines/thread_local_context.hpp"
 #include "mrc/coroutines/thread_pool.hpp"
+#include "mrc/coroutines/timer_wheel.hpp"
+
+#include <atomic>
 
 namespace mrc::coroutines {
 
+struct Event::TimedWait final : TimerWheel::Timer
+{
+    TimedWait(const Event& e, TimerWheel& timer_wheel) : awaiter(e), wheel(timer_wheel)
+    {
+        awaiter.m_timed = this;
+    }
+
+    void on_expired() noexcept final
+    {
+        if (!claimed.exchange(true, std::memory_order::acq_rel))
+        {
+            timed_out = true;
+            awaiter.resume();
+        }
+        Event::release(this);
+    }
+
+    /// Linked into the list of awaiters of the event in place of the TimedAwaiter.
+    Awaiter awaiter;
+    TimerWheel& wheel;
+    /// Set by whichever of the event and the timer resumes the coroutine.
+    std::atomic<bool> claimed{false};
+    /// References held by the list of awaiters, the timer and the TimedAwaiter.
+    std::atomic<int> refs{3};
+    bool timed_out{false};
+};
+
 auto Event::Awaiter::await_suspend(std::coroutine_handle<> awaiting_coroutine) noexcept -> bool
 {
     const void* const set_state = &m_event;
@@ -77,8 +107,79 @@ void Event::Awaiter::resume()
     resume_coroutine(m_awaiting_coroutine);
 }
 
+auto Event::TimedAwaiter::await_suspend(std::coroutine_handle<> awaiting_coroutine) -> bool
+{
+    const void* const set_state = &m_event;
+
+    auto& wheel   = TimerWheel::current();
+    auto deadline = m_deadline;
+    auto* wait    = new TimedWait(m_event, wheel);
+
+    wait->awaiter.m_awaiting_coroutine = awaiting_coroutine;
+    wait->awaiter.suspend_thread_local_context();
+    m_wait = wait;
+
+    void* old_value = m_event.m_state.load(std::memory_order::acquire);
+    do
+    {
+        if (old_value == set_state)
+        {
+            m_wait = nullptr;
+            delete wait;
+            return false;
+        }
+
+        wait->awaiter.m_next = static_cast<Awaiter*>(old_value);
+    } while (!m_event.m_state.compare_exchange_weak(
+        old_value, &wait->awaiter, std::memory_order::release, std::memory_order::acquire));
+
+    // once linked the event may resume the coroutine and destroy this awaiter; only locals are used from here on
+    if (wait->claimed.load(std::memory_order::acquire))
+    {
+        release(wait);
+    }
+    else
+    {
+        wheel.schedule(*wait, deadline);
+    }
+    return true;
+}
+
+auto Event::TimedAwaiter::await_resume() noexcept -> bool
+{
+    return m_wait == nullptr || !m_wait->timed_out;
+}
+
+Event::TimedAwaiter::~TimedAwaiter()
+{
+    if (m_wait != nullptr)
+    {
+        release(m_wait);
+    }
+}
+
 Event::Event(bool initially_set) noexcept : m_state((initially_set) ? static_cast<void*>(this) : nullptr) {}
 
+Event::~Event()
+{
+    void* state = m_state.load(std::memory_order::acquire);
+    if (state == this)
+    {
+        return;
+    }
+
+    auto* waiters = static_cast<Awaiter*>(state);
+    while (waiters != nullptr)
+    {
+        auto* next = waiters->m_next;
+        if (waiters->m_timed != nullptr)
+        {
+            release(waiters->m_timed);
+        }
+        waiters = next;
+    }
+}
+
 auto Event::set(ResumeOrderPolicy policy) noexcept -> void
 {
     // Exchange the state to this, if the state was previously not this, then traverse the list
@@ -93,14 +194,7 @@ auto Event::set(ResumeOrderPolicy policy) noexcept -> void
         }
         // else lifo nothing to do
 
-        auto* waiters = static_cast<Awaiter*>(old_value);
-        while (waiters != nullptr)
-        {
-            auto* next = waiters->m_next;
-            // waiters->m_awaiting_coroutine.resume();
-            waiters->resume();
-            waiters = next;
-        }
+        for_each_waiter(static_cast<Awaiter*>(old_value), [](Awaiter& waiter) { waiter.resume(); });
     }
 }
 
@@ -124,6 +218,29 @@ auto Event::reverse(Awaiter* curr) -> Awaiter*
     return prev;
 }
 
+auto Event::claim(TimedWait* timed) noexcept -> bool
+{
+    if (timed->claimed.exchange(true, std::memory_order::acq_rel))
+    {
+        return false;
+    }
+
+    // if the timer has not been armed yet, TimedAwaiter::await_suspend drops its reference instead of arming it
+    if (timed->wheel.cancel(*timed))
+    {
+        release(timed);
+    }
+    return true;
+}
+
+auto Event::release(TimedWait* timed) noexcept -> void
+{
+    if (timed->refs.fetch_sub(1, std::memory_order::acq_rel) == 1)
+    {
+        delete timed;
+    }
+}
+
 auto Event::reset() noexcept -> void
 {
     void* old_value = this;
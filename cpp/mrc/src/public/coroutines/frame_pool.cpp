@@ -0,0 +1,160 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "mrc/coroutines/frame_pool.hpp"
+
+#include <array>
+#include <new>
+
+namespace mrc::coroutines {
+
+namespace {
+
+struct FreeFrame
+{
+    FreeFrame* next;
+};
+
+struct FrameCache
+{
+    FrameCache();
+    ~FrameCache();
+
+    void release() noexcept
+    {
+        for (std::size_t idx = 0; idx < FramePool::SizeClassCount; ++idx)
+        {
+            while (heads[idx] != nullptr)
+            {
+                auto* frame = heads[idx];
+                heads[idx]  = frame->next;
+                ::operator delete(frame, (idx + 1) * FramePool::SizeClassBytes);
+            }
+            counts[idx] = 0;
+        }
+    }
+
+    std::array<FreeFrame*, FramePool::SizeClassCount> heads{};
+    std::array<std::size_t, FramePool::SizeClassCount> counts{};
+};
+
+enum class CacheState
+{
+    Uninitialized,
+    Alive,
+    Destroyed,
+};
+
+// trivially destructible, so it remains valid while other thread_local destructors free frames at thread exit
+thread_local CacheState t_cache_state{CacheState::Uninitialized};
+thread_local FrameCache t_cache;
+
+FrameCache::FrameCache()
+{
+    t_cache_state = CacheState::Alive;
+}
+
+FrameCache::~FrameCache()
+{
+    release();
+    t_cache_state = CacheState::Destroyed;
+}
+
+auto cache() noexcept -> FrameCache*
+{
+    if (t_cache_state == CacheState::Destroyed) [[unlikely]]
+    {
+        return nullptr;
+    }
+    return &t_cache;
+}
+
+constexpr auto size_class(std::size_t size) -> std::size_t
+{
+    return (size + FramePool::SizeClassBytes - 1) / FramePool::SizeClassBytes - 1;
+}
+
+}  // namespace
+
+auto FramePool::allocate(std::size_t size) -> void*
+{
+    if (size == 0 || size > MaxFrameSize)
+    {
+        return ::operator new(size);
+    }
+
+    auto idx = size_class(size);
+    auto* c  = cache();
+    if (c != nullptr && c->heads[idx] != nullptr)
+    {
+        auto* frame   = c->heads[idx];
+        c->heads[idx] = frame->next;
+        --c->counts[idx];
+        return frame;
+    }
+
+    return ::operator new((idx + 1) * SizeClassBytes);
+}
+
+auto FramePool::deallocate(void* ptr, std::size_t size) noexcept -> void
+{
+    if (size == 0 || size > MaxFrameSize)
+    {
+        ::operator delete(ptr, size);
+        return;
+    }
+
+    auto idx = size_class(size);
+    auto* c  = cache();
+    if (c == nullptr || c->counts[idx] >= MaxCachedFrames)
+    {
+        ::operator delete(ptr, (idx + 1) * SizeClassBytes);
+        return;
+    }
+
+    auto* frame   = static_cast<FreeFrame*>(ptr);
+    frame->next   = c->heads[idx];
+    c->heads[idx] = frame;
+    ++c->counts[idx];
+}
+
+auto FramePool::cached_frames() noexcept -> std::size_t
+{
+    auto* c = cache();
+    if (c == nullptr)
+    {
+        return 0;
+    }
+
+    std::size_t count = 0;
+    for (auto n : c->counts)
+    {
+        count += n;
+    }
+    return count;
+}
+
+auto FramePool::release_cached_frames() noexcept -> void
+{
+    auto* c = cache();
+    if (c != nullptr)
+    {
+        c->release();
+    }
+}
+
+}  // namespace mrc::coroutines
@@ -0,0 +1,656 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "mrc/coroutines/io_scheduler.hpp"
+
+#include "mrc/coroutines/thread_pool.hpp"
+
+#include <glog/logging.h>
+#include <linux/io_uring.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/timerfd.h>
+#include <unistd.h>
+
+#include <array>
+#include <cerrno>
+#include <cstring>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <system_error>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace mrc::coroutines {
+
+namespace {
+
+/// epoll_event::data.ptr tags of the reactor's own file descriptors; every other tag is an IoOperation*
+char WakeTag;
+char TimerTag;
+
+auto make_system_error(const char* what) -> std::system_error
+{
+    return std::system_error(errno, std::generic_category(), what);
+}
+
+/**
+ * Minimal io_uring wrapper over the raw syscalls. Submissions are serialized by the caller; completions are only
+ * reaped by the reactor thread.
+ */
+class IoUring
+{
+  public:
+    explicit IoUring(std::uint32_t entries)
+    {
+        io_uring_params params{};
+        params.flags      = IORING_SETUP_CQSIZE;
+        params.cq_entries = entries * 4;
+
+        m_fd = static_cast<int>(::syscall(__NR_io_uring_setup, entries, &params));
+        if (m_fd < 0)
+        {
+            throw make_system_error("io_uring_setup");
+        }
+
+        // IORING_OP_READ/WRITE with offset -1 (the current file position) require IORING_FEAT_RW_CUR_POS
+        if ((params.features & IORING_FEAT_RW_CUR_POS) == 0)
+        {
+            ::close(m_fd);
+            throw std::system_error(ENOTSUP, std::generic_category(), "io_uring lacks IORING_FEAT_RW_CUR_POS");
+        }
+
+        m_sq_size = params.sq_off.array + params.sq_entries * sizeof(std::uint32_t);
+        m_cq_size = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+        if ((params.features & IORING_FEAT_SINGLE_MMAP) != 0)
+        {
+            m_sq_size = m_cq_size = std::max(m_sq_size, m_cq_size);
+        }
+        m_sqes_size = params.sq_entries * sizeof(io_uring_sqe);
+
+        m_sq_ptr = map(m_sq_size, IORING_OFF_SQ_RING);
+        m_cq_ptr = ((params.features & IORING_FEAT_SINGLE_MMAP) != 0) ? m_sq_ptr : map(m_cq_size, IORING_OFF_CQ_RING);
+        m_sqes   = static_cast<io_uring_sqe*>(map(m_sqes_size, IORING_OFF_SQES));
+
+        auto* sq     = static_cast<char*>(m_sq_ptr);
+        m_sq_head    = reinterpret_cast<std::uint32_t*>(sq + params.sq_off.head);
+        m_sq_tail    = reinterpret_cast<std::uint32_t*>(sq + params.sq_off.tail);
+        m_sq_mask    = *reinterpret_cast<std::uint32_t*>(sq + params.sq_off.ring_mask);
+        m_sq_array   = reinterpret_cast<std::uint32_t*>(sq + params.sq_off.array);
+        m_sq_entries = params.sq_entries;
+
+        auto* cq  = static_cast<char*>(m_cq_ptr);
+        m_cq_head = reinterpret_cast<std::uint32_t*>(cq + params.cq_off.head);
+        m_cq_tail = reinterpret_cast<std::uint32_t*>(cq + params.cq_off.tail);
+        m_cq_mask = *reinterpret_cast<std::uint32_t*>(cq + params.cq_off.ring_mask);
+        m_cqes    = reinterpret_cast<io_uring_cqe*>(cq + params.cq_off.cqes);
+    }
+
+    ~IoUring()
+    {
+        ::munmap(m_sqes, m_sqes_size);
+        if (m_cq_ptr != m_sq_ptr)
+        {
+            ::munmap(m_cq_ptr, m_cq_size);
+        }
+        ::munmap(m_sq_ptr, m_sq_size);
+        ::close(m_fd);
+    }
+
+    IoUring(const IoUring&)            = delete;
+    IoUring& operator=(const IoUring&) = delete;
+
+    /// signal eventfd on every completion so the reactor can wait on it with epoll
+    void register_eventfd(int eventfd)
+    {
+        if (::syscall(__NR_io_uring_register, m_fd, IORING_REGISTER_EVENTFD, &eventfd, 1) < 0)
+        {
+            throw make_system_error("io_uring_register");
+        }
+    }
+
+    /**
+     * Fills and submits a single sqe.
+     * @return 0 once the kernel consumed the sqe, its completion is then reported by a cqe; otherwise -errno
+     */
+    template <typename PrepareFnT>
+    int submit(PrepareFnT&& prepare_fn)
+    {
+        auto tail = *m_sq_tail;
+        if (tail - __atomic_load_n(m_sq_head, __ATOMIC_ACQUIRE) >= m_sq_entries)
+        {
+            return -EBUSY;
+        }
+
+        auto index  = tail & m_sq_mask;
+        auto& sqe   = m_sqes[index];
+        std::memset(&sqe, 0, sizeof(sqe));
+        prepare_fn(sqe);
+        m_sq_array[index] = index;
+        __atomic_store_n(m_sq_tail, tail + 1, __ATOMIC_RELEASE);
+
+        long rc;
+        do
+        {
+            rc = ::syscall(__NR_io_uring_enter, m_fd, 1, 0, 0, nullptr, 0);
+        } while (rc < 0 && errno == EINTR);
+        int error = (rc < 0 ? -errno : -EBUSY);
+
+        // without SQPOLL the kernel only consumes sqes inside io_uring_enter, which is serialized by the caller: an
+        // sqe it consumed completes through its cqe even if the call failed, one it did not consume is retracted
+        if (__atomic_load_n(m_sq_head, __ATOMIC_ACQUIRE) != tail)
+        {
+            return 0;
+        }
+        __atomic_store_n(m_sq_tail, tail, __ATOMIC_RELEASE);
+        return error;
+    }
+
+    /// invokes fn(cqe) for every available completion
+    template <typename FnT>
+    void reap(FnT&& fn)
+    {
+        auto head = *m_cq_head;
+        auto tail = __atomic_load_n(m_cq_tail, __ATOMIC_ACQUIRE);
+        while (head != tail)
+        {
+            fn(m_cqes[head & m_cq_mask]);
+            head++;
+        }
+        __atomic_store_n(m_cq_head, head, __ATOMIC_RELEASE);
+    }
+
+  private:
+    void* map(std::size_t size, off_t offset)
+    {
+        auto* ptr = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, m_fd, offset);
+        if (ptr == MAP_FAILED)
+        {
+            throw make_system_error("io_uring mmap");
+        }
+        return ptr;
+    }
+
+    int m_fd{-1};
+
+    void* m_sq_ptr{nullptr};
+    std::size_t m_sq_size{0};
+    std::uint32_t* m_sq_head{nullptr};
+    std::uint32_t* m_sq_tail{nullptr};
+    std::uint32_t* m_sq_array{nullptr};
+    std::uint32_t m_sq_mask{0};
+    std::uint32_t m_sq_entries{0};
+
+    io_uring_sqe* m_sqes{nullptr};
+    std::size_t m_sqes_size{0};
+
+    void* m_cq_ptr{nullptr};
+    std::size_t m_cq_size{0};
+    std::uint32_t* m_cq_head{nullptr};
+    std::uint32_t* m_cq_tail{nullptr};
+    std::uint32_t m_cq_mask{0};
+    io_uring_cqe* m_cqes{nullptr};
+};
+
+}  // namespace
+
+struct IoScheduler::Reactor
+{
+    Reactor(IoScheduler& parent, const Options& opts) : m_parent(parent)
+    {
+        m_epoll_fd = ::epoll_create1(EPOLL_CLOEXEC);
+        m_wake_fd  = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+        m_timer_fd = ::timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+        if (m_epoll_fd < 0 || m_wake_fd < 0 || m_timer_fd < 0)
+        {
+            auto error = make_system_error("io scheduler reactor");
+            close_fds();
+            throw error;
+        }
+
+        try
+        {
+            if (opts.backend != Backend::epoll)
+            {
+                try
+                {
+                    m_uring.emplace(opts.queue_depth);
+                    m_uring->register_eventfd(m_wake_fd);
+                } catch (const std::system_error& e)
+                {
+                    m_uring.reset();
+                    if (opts.backend == Backend::io_uring)
+                    {
+                        throw;
+                    }
+                    LOG(WARNING) << "io_uring unavailable (" << e.what() << "); IoScheduler falling back to epoll";
+                }
+            }
+            m_backend = (m_uring ? Backend::io_uring : Backend::epoll);
+
+            watch(m_wake_fd, &WakeTag);
+            watch(m_timer_fd, &TimerTag);
+        } catch (...)
+        {
+            m_uring.reset();
+            close_fds();
+            throw;
+        }
+
+        m_thread = std::thread([this] { run(); });
+    }
+
+    ~Reactor()
+    {
+        stop();
+        m_uring.reset();
+        close_fds();
+    }
+
+    void stop() noexcept
+    {
+        m_stop_requested.store(true, std::memory_order_release);
+        wake();
+        if (m_thread.joinable())
+        {
+            m_thread.join();
+        }
+    }
+
+    void wake() noexcept
+    {
+        std::uint64_t value = 1;
+        [[maybe_unused]] auto rc = ::write(m_wake_fd, &value, sizeof(value));
+    }
+
+    void watch(int fd, void* tag) const
+    {
+        epoll_event event{};
+        event.events   = EPOLLIN;
+        event.data.ptr = tag;
+        if (::epoll_ctl(m_epoll_fd, EPOLL_CTL_ADD, fd, &event) < 0)
+        {
+            throw make_system_error("epoll_ctl");
+        }
+    }
+
+    void close_fds() noexcept
+    {
+        for (auto fd : {m_timer_fd, m_wake_fd, m_epoll_fd})
+        {
+            if (fd >= 0)
+            {
+                ::close(fd);
+            }
+        }
+    }
+
+    // resume a handle accounted for in m_parent.m_size
+    void dispatch(std::coroutine_handle<> handle) noexcept
+    {
+        m_parent.m_size.fetch_sub(1, std::memory_order::release);
+        if (m_parent.m_opts.thread_pool != nullptr)
+        {
+            m_parent.m_opts.thread_pool->resume(handle);
+        }
+        else
+        {
+            handle.resume();
+        }
+    }
+
+    // returns -errno if the operation could not be registered
+    int arm(IoOperation& op) const noexcept
+    {
+        epoll_event event{};
+        event.events   = (op.m_kind == IoOperation::Kind::write ? EPOLLOUT : EPOLLIN) | EPOLLONESHOT;
+        event.data.ptr = &op;
+        if (::epoll_ctl(m_epoll_fd, EPOLL_CTL_MOD, op.m_fd, &event) == 0 ||
+            (errno == ENOENT && ::epoll_ctl(m_epoll_fd, EPOLL_CTL_ADD, op.m_fd, &event) == 0))
+        {
+            return 0;
+        }
+        return -errno;
+    }
+
+    // timerfd is armed for the earliest deadline, or disarmed when there are no timers
+    void arm_timer_locked() noexcept
+    {
+        itimerspec spec{};
+        if (!m_timers.empty())
+        {
+            auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(m_timers.begin()->first.time_since_epoch());
+            // a zero it_value disarms the timer
+            spec.it_value.tv_sec  = ns.count() / 1000000000;
+            spec.it_value.tv_nsec = std::max<std::int64_t>(ns.count() % 1000000000, 1);
+        }
+        ::timerfd_settime(m_timer_fd, TFD_TIMER_ABSTIME, &spec, nullptr);
+    }
+
+    void on_timer() noexcept
+    {
+        std::uint64_t expirations;
+        [[maybe_unused]] auto rc = ::read(m_timer_fd, &expirations, sizeof(expirations));
+
+        std::vector<std::coroutine_handle<>> expired;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            auto now = clock_t::now();
+            auto end = m_timers.upper_bound(now);
+            for (auto it = m_timers.begin(); it != end; ++it)
+            {
+                expired.push_back(it->second);
+            }
+            m_timers.erase(m_timers.begin(), end);
+            arm_timer_locked();
+        }
+
+        for (auto handle : expired)
+        {
+            dispatch(handle);
+        }
+    }
+
+    void on_wake() noexcept
+    {
+        std::uint64_t count;
+        [[maybe_unused]] auto rc = ::read(m_wake_fd, &count, sizeof(count));
+
+        if (m_uring)
+        {
+            std::vector<IoOperation*> completed;
+            m_uring->reap([&completed](const io_uring_cqe& cqe) {
+                auto* op     = reinterpret_cast<IoOperation*>(cqe.user_data);
+                op->m_result = cqe.res;
+                completed.push_back(op);
+            });
+
+            // the ring is released before resuming so continuations may submit new operations
+            for (auto* op : completed)
+            {
+                dispatch(op->m_awaiting_coroutine);
+            }
+        }
+
+        std::deque<std::coroutine_handle<>> ready;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            std::swap(ready, m_ready);
+        }
+        for (auto handle : ready)
+        {
+            dispatch(handle);
+        }
+    }
+
+    void on_ready(IoOperation& op) noexcept
+    {
+        op.attempt();
+        if (op.m_result == -EAGAIN || op.m_result == -EWOULDBLOCK)
+        {
+            auto rc = arm(op);
+            if (rc == 0)
+            {
+                return;
+            }
+            op.m_result = rc;
+        }
+
+        ::epoll_ctl(m_epoll_fd, EPOLL_CTL_DEL, op.m_fd, nullptr);
+        dispatch(op.m_awaiting_coroutine);
+    }
+
+    void run() noexcept
+    {
+        std::array<epoll_event, 64> events;
+
+        while (!m_stop_requested.load(std::memory_order_acquire) || !m_parent.empty())
+        {
+            auto count = ::epoll_wait(m_epoll_fd, events.data(), events.size(), -1);
+            if (count < 0)
+            {
+                LOG_IF(FATAL, errno != EINTR) << "epoll_wait failed: " << std::strerror(errno);
+                continue;
+            }
+
+            for (int i = 0; i < count; i++)
+            {
+                auto* tag = events[i].data.ptr;
+                if (tag == &WakeTag)
+                {
+                    on_wake();
+                }
+                else if (tag == &TimerTag)
+                {
+                    on_timer();
+                }
+                else
+                {
+                    on_ready(*static_cast<IoOperation*>(tag));
+                }
+            }
+        }
+    }
+
+    IoScheduler& m_parent;
+    Backend m_backend{Backend::epoll};
+    int m_epoll_fd{-1};
+    int m_wake_fd{-1};
+    int m_timer_fd{-1};
+    std::optional<IoUring> m_uring;
+
+    /// serializes io_uring submissions
+    std::mutex m_submit_mutex;
+
+    /// guards m_ready and m_timers
+    std::mutex m_mutex;
+    std::deque<std::coroutine_handle<>> m_ready;
+    std::multimap<time_point_t, std::coroutine_handle<>> m_timers;
+
+    std::atomic<bool> m_stop_requested{false};
+    std::thread m_thread;
+};
+
+auto IoScheduler::ScheduleOperation::await_suspend(std::coroutine_handle<> awaiting_coroutine) noexcept -> void
+{
+    m_scheduler.resume(awaiting_coroutine);
+}
+
+auto IoScheduler::TimerOperation::await_suspend(std::coroutine_handle<> awaiting_coroutine) noexcept -> void
+{
+    m_scheduler.add_timer(*this, awaiting_coroutine);
+}
+
+auto IoScheduler::IoOperation::await_suspend(std::coroutine_handle<> awaiting_coroutine) noexcept -> bool
+{
+    m_awaiting_coroutine = awaiting_coroutine;
+    return m_scheduler.submit(*this);
+}
+
+auto IoScheduler::IoOperation::attempt() noexcept -> void
+{
+    ssize_t rc = -1;
+    switch (m_kind)
+    {
+    case Kind::read:
+        rc = (m_offset < 0 ? ::read(m_fd, m_buffer, m_size) : ::pread(m_fd, m_buffer, m_size, m_offset));
+        break;
+    case Kind::write:
+        rc = (m_offset < 0 ? ::write(m_fd, m_buffer, m_size) : ::pwrite(m_fd, m_buffer, m_size, m_offset));
+        break;
+    case Kind::accept:
+        rc = ::accept4(m_fd, m_addr, m_addrlen, SOCK_NONBLOCK | SOCK_CLOEXEC);
+        break;
+    }
+    m_result = (rc < 0 ? -errno : rc);
+}
+
+IoScheduler::IoScheduler() : IoScheduler(Options{}) {}
+
+IoScheduler::IoScheduler(Options opts) : m_opts(std::move(opts))
+{
+    m_reactor = std::make_unique<Reactor>(*this, m_opts);
+}
+
+IoScheduler::~IoScheduler()
+{
+    shutdown();
+}
+
+auto IoScheduler::backend() const noexcept -> Backend
+{
+    return m_reactor->m_backend;
+}
+
+auto IoScheduler::schedule() -> ScheduleOperation
+{
+    return ScheduleOperation{*this};
+}
+
+auto IoScheduler::resume(std::coroutine_handle<> handle) noexcept -> void
+{
+    if (handle == nullptr)
+    {
+        return;
+    }
+
+    m_size.fetch_add(1, std::memory_order::release);
+    {
+        std::lock_guard<std::mutex> lock(m_reactor->m_mutex);
+        m_reactor->m_ready.push_back(handle);
+    }
+    m_reactor->wake();
+}
+
+auto IoScheduler::schedule_after(std::chrono::nanoseconds duration) -> TimerOperation
+{
+    return schedule_at(clock_t::now() + duration);
+}
+
+auto IoScheduler::schedule_at(time_point_t deadline) -> TimerOperation
+{
+    return TimerOperation{*this, deadline};
+}
+
+auto IoScheduler::read(int fd, std::span<std::byte> buffer, std::int64_t offset) -> IoOperation
+{
+    return IoOperation{*this, IoOperation::Kind::read, fd, buffer.data(), buffer.size(), offset};
+}
+
+auto IoScheduler::write(int fd, std::span<const std::byte> buffer, std::int64_t offset) -> IoOperation
+{
+    return IoOperation{
+        *this, IoOperation::Kind::write, fd, const_cast<std::byte*>(buffer.data()), buffer.size(), offset};
+}
+
+auto IoScheduler::accept(int fd, sockaddr* addr, socklen_t* addrlen) -> IoOperation
+{
+    IoOperation op{*this, IoOperation::Kind::accept, fd, nullptr, 0, 0};
+    op.m_addr    = addr;
+    op.m_addrlen = addrlen;
+    return op;
+}
+
+auto IoScheduler::shutdown() noexcept -> void
+{
+    if (m_reactor)
+    {
+        m_reactor->stop();
+    }
+}
+
+const std::string& IoScheduler::description() const
+{
+    return m_opts.description;
+}
+
+auto IoScheduler::submit(IoOperation& op) noexcept -> bool
+{
+    if (m_reactor->m_uring)
+    {
+        m_size.fetch_add(1, std::memory_order::release);
+
+        std::lock_guard<std::mutex> lock(m_reactor->m_submit_mutex);
+        auto rc = m_reactor->m_uring->submit([&op](io_uring_sqe& sqe) {
+            sqe.fd        = op.m_fd;
+            sqe.user_data = reinterpret_cast<std::uint64_t>(&op);
+            switch (op.m_kind)
+            {
+            case IoOperation::Kind::read:
+            case IoOperation::Kind::write:
+                sqe.opcode = (op.m_kind == IoOperation::Kind::read ? IORING_OP_READ : IORING_OP_WRITE);
+                sqe.addr   = reinterpret_cast<std::uint64_t>(op.m_buffer);
+                sqe.len    = static_cast<std::uint32_t>(op.m_size);
+                sqe.off    = static_cast<std::uint64_t>(op.m_offset);
+                break;
+            case IoOperation::Kind::accept:
+                sqe.opcode       = IORING_OP_ACCEPT;
+                sqe.addr         = reinterpret_cast<std::uint64_t>(op.m_addr);
+                sqe.addr2        = reinterpret_cast<std::uint64_t>(op.m_addrlen);
+                sqe.accept_flags = SOCK_NONBLOCK | SOCK_CLOEXEC;
+                break;
+            }
+        });
+
+        if (rc == 0)
+        {
+            // op may already have been resumed by the reactor and must not be touched
+            return true;
+        }
+
+        m_size.fetch_sub(1, std::memory_order::release);
+        op.m_result = rc;
+        return false;
+    }
+
+    op.attempt();
+    if (op.m_result != -EAGAIN && op.m_result != -EWOULDBLOCK)
+    {
+        return false;
+    }
+
+    m_size.fetch_add(1, std::memory_order::release);
+    auto rc = m_reactor->arm(op);
+    if (rc == 0)
+    {
+        return true;
+    }
+
+    m_size.fetch_sub(1, std::memory_order::release);
+    op.m_result = rc;
+    return false;
+}
+
+auto IoScheduler::add_timer(TimerOperation& op, std::coroutine_handle<> handle) noexcept -> void
+{
+    m_size.fetch_add(1, std::memory_order::release);
+
+    std::lock_guard<std::mutex> lock(m_reactor->m_mutex);
+    auto it = m_reactor->m_timers.emplace(op.m_deadline, handle);
+    if (it == m_reactor->m_timers.begin())
+    {
+        m_reactor->arm_timer_locked();
+    }
+}
+
+}  // namespace mrc::coroutines
@@ -43,12 +43,41 @@
 
 #include <glog/logging.h>
 
+#include <algorithm>
 #include <cstddef>
 #include <iostream>
+#include <random>
 #include <sstream>
 
 namespace mrc::coroutines {
 
+namespace {
+
+/// consecutive LIFO slot resumptions before the local queue is served, so a pair of coroutines handing work back and
+/// forth cannot starve the rest of the local queue
+constexpr std::size_t MaxLifoStreak = 3;
+
+/// the global queue is checked first every GlobalQueueInterval resumptions so external submissions cannot be starved
+/// by executors with non-empty local queues
+constexpr std::size_t GlobalQueueInterval = 61;
+
+/// batches of at least BatchStripeThreshold handles per executor are striped across the local queues of the executors
+constexpr std::size_t BatchStripeThreshold = 4;
+
+}  // namespace
+
+struct ThreadPool::Worker
+{
+    alignas(64) std::mutex mutex;
+    std::deque<std::coroutine_handle<>> queue;
+    std::coroutine_handle<> lifo{nullptr};
+
+    // only accessed by the owning executor thread
+    std::size_t lifo_streak{0};
+    std::size_t tick{0};
+    std::minstd_rand rng;
+};
+
 thread_local ThreadPool* ThreadPool::m_self{nullptr};
 thread_local std::size_t ThreadPool::m_thread_id{0};
 
@@ -73,7 +102,7 @@ auto ThreadPool::Operation::await_suspend(std::coroutine_handle<> awaiting_corou
 
     // capture the coroutine handle and schedule it to be resumed
     m_awaiting_coroutine = awaiting_coroutine;
-    m_thread_pool.schedule_impl(m_awaiting_coroutine);
+    m_thread_pool.schedule_impl(m_awaiting_coroutine, false);
 }
 
 auto ThreadPool::Operation::await_resume() noexcept -> void
@@ -102,6 +131,15 @@ ThreadPool::ThreadPool(Options opts) : m_opts(std::move(opts))
         m_opts.description = ss.str();
     }
 
+    m_workers.reserve(m_opts.thread_count);
+    for (uint32_t i = 0; i < m_opts.thread_count; ++i)
+    {
+        m_workers.emplace_back(std::make_unique<Worker>());
+        m_workers.back()->rng.seed(i + 1);
+    }
+
+    m_timer_wheel = std::make_unique<TimerWheel>(TimerWheel::Options{.description = m_opts.description + "_timers"});
+
     m_threads.reserve(m_opts.thread_count);
 
     for (uint32_t i = 0; i < m_opts.thread_count; ++i)
@@ -134,7 +172,7 @@ auto ThreadPool::resume(std::coroutine_handle<> handle) noexcept -> void
     }
 
     m_size.fetch_add(1, std::memory_order::release);
-    schedule_impl(handle);
+    schedule_impl(handle, true);
 }
 
 auto ThreadPool::shutdown() noexcept -> void
@@ -142,6 +180,9 @@ auto ThreadPool::shutdown() noexcept -> void
     // Only allow shutdown to occur once.
     if (!m_shutdown_requested.exchange(true, std::memory_order::acq_rel))
     {
+        // pending timers expire now so their tasks are resumed before the executors drain
+        m_timer_wheel->shutdown();
+
         for (auto& thread : m_threads)
         {
             thread.request_stop();
@@ -167,27 +208,27 @@ auto ThreadPool::executor(std::stop_token stop_token, std::size_t idx) -> void
         m_opts.on_thread_start_functor(idx);
     }
 
-    while (!stop_token.stop_requested())
+    while (true)
     {
-        // Wait until the queue has operations to execute or shutdown has been requested.
-        while (true)
+        auto handle = next_handle(idx);
+        if (handle)
         {
-            std::unique_lock<std::mutex> lk{m_wait_mutex};
-            m_wait_cv.wait(lk, stop_token, [this] { return !m_queue.empty(); });
-            if (m_queue.empty())
-            {
-                lk.unlock();  // would happen on scope destruction, but being explicit/faster(?)
-                break;
-            }
-
-            auto handle = m_queue.front();
-            m_queue.pop_front();
-
-            lk.unlock();  // Not needed for processing the coroutine.
-
             handle.resume();
             m_size.fetch_sub(1, std::memory_order::release);
+            continue;
         }
+
+        // all queues are drained before honoring a stop request
+        if (stop_token.stop_requested())
+        {
+            break;
+        }
+
+        // Wait until a queue has operations to execute or shutdown has been requested.
+        std::unique_lock<std::mutex> lk{m_wait_mutex};
+        m_sleepers.fetch_add(1, std::memory_order::seq_cst);
+        m_wait_cv.wait(lk, stop_token, [this] { return m_queued.load(std::memory_order::seq_cst) > 0; });
+        m_sleepers.fetch_sub(1, std::memory_order::relaxed);
     }
 
     if (m_opts.on_thread_stop_functor != nullptr)
@@ -196,19 +237,216 @@ auto ThreadPool::executor(std::stop_token stop_token, std::size_t idx) -> void
     }
 }
 
-auto ThreadPool::schedule_impl(std::coroutine_handle<> handle) noexcept -> void
+auto ThreadPool::schedule_impl(std::coroutine_handle<> handle, bool lifo) noexcept -> void
 {
     if (handle == nullptr)
     {
         return;
     }
 
+    m_queued.fetch_add(1, std::memory_order::seq_cst);
+
+    if (m_self == this)
+    {
+        auto& worker = *m_workers[m_thread_id];
+        std::lock_guard<std::mutex> lk{worker.mutex};
+        if (lifo && !worker.lifo)
+        {
+            worker.lifo = handle;
+        }
+        else
+        {
+            worker.queue.push_back(handle);
+        }
+    }
+    else
     {
         std::scoped_lock lk{m_wait_mutex};
         m_queue.emplace_back(handle);
     }
 
-    m_wait_cv.notify_one();
+    notify_sleeper();
+}
+
+auto ThreadPool::schedule_batch(std::vector<std::coroutine_handle<>>&& handles) noexcept -> void
+{
+    if (handles.empty())
+    {
+        return;
+    }
+
+    m_queued.fetch_add(handles.size(), std::memory_order::seq_cst);
+
+    const auto worker_count = m_workers.size();
+    if (worker_count > 1 && handles.size() >= BatchStripeThreshold * worker_count)
+    {
+        // large batches, e.g. the waiters of an event, are striped across the local queues so every executor starts
+        // on its share without contending on a single queue; the caller's own queue receives the first stripe
+        const auto stripe = (handles.size() + worker_count - 1) / worker_count;
+        const auto first  = (m_self == this) ? m_thread_id : 0;
+
+        auto begin = handles.begin();
+        for (std::size_t i = 0; i < worker_count && begin != handles.end(); ++i)
+        {
+            auto end     = begin + std::min<std::size_t>(stripe, handles.end() - begin);
+            auto& worker = *m_workers[(first + i) % worker_count];
+            {
+                std::lock_guard<std::mutex> lk{worker.mutex};
+                worker.queue.insert(worker.queue.end(), begin, end);
+            }
+            begin = end;
+        }
+
+        notify_sleepers(worker_count);
+        return;
+    }
+
+    if (m_self == this)
+    {
+        auto& worker = *m_workers[m_thread_id];
+        std::lock_guard<std::mutex> lk{worker.mutex};
+        worker.queue.insert(worker.queue.end(), handles.begin(), handles.end());
+    }
+    else
+    {
+        std::scoped_lock lk{m_wait_mutex};
+        m_queue.insert(m_queue.end(), handles.begin(), handles.end());
+    }
+
+    notify_sleepers(handles.size());
+}
+
+auto ThreadPool::next_handle(std::size_t idx) noexcept -> std::coroutine_handle<>
+{
+    auto& worker = *m_workers[idx];
+    std::coroutine_handle<> handle{nullptr};
+
+    auto pop_global = [this, &handle] {
+        std::scoped_lock lk{m_wait_mutex};
+        if (!m_queue.empty())
+        {
+            handle = m_queue.front();
+            m_queue.pop_front();
+        }
+    };
+
+    if (++worker.tick % GlobalQueueInterval == 0)
+    {
+        pop_global();
+    }
+
+    if (!handle)
+    {
+        std::lock_guard<std::mutex> lk{worker.mutex};
+        if (worker.lifo && (worker.lifo_streak < MaxLifoStreak || worker.queue.empty()))
+        {
+            handle      = worker.lifo;
+            worker.lifo = nullptr;
+            worker.lifo_streak++;
+        }
+        else if (!worker.queue.empty())
+        {
+            handle = worker.queue.front();
+            worker.queue.pop_front();
+            worker.lifo_streak = 0;
+        }
+    }
+
+    if (!handle)
+    {
+        pop_global();
+    }
+
+    if (!handle)
+    {
+        handle = steal(idx);
+    }
+
+    if (handle)
+    {
+        m_queued.fetch_sub(1, std::memory_order::relaxed);
+    }
+
+    return handle;
+}
+
+auto ThreadPool::steal(std::size_t idx) noexcept -> std::coroutine_handle<>
+{
+    const auto count = m_workers.size();
+    if (count < 2)
+    {
+        return nullptr;
+    }
+
+    auto& thief = *m_workers[idx];
+    auto start  = thief.rng() % count;
+
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        auto victim_idx = (start + i) % count;
+        if (victim_idx == idx)
+        {
+            continue;
+        }
+
+        auto& victim = *m_workers[victim_idx];
+        std::scoped_lock lk{thief.mutex, victim.mutex};
+
+        if (!victim.queue.empty())
+        {
+            // take the oldest half; the first handle is resumed immediately, the rest move to the thief's local queue
+            auto take   = (victim.queue.size() + 1) / 2;
+            auto handle = victim.queue.front();
+            victim.queue.pop_front();
+            for (std::size_t j = 1; j < take; ++j)
+            {
+                thief.queue.push_back(victim.queue.front());
+                victim.queue.pop_front();
+            }
+            return handle;
+        }
+
+        if (victim.lifo)
+        {
+            auto handle = victim.lifo;
+            victim.lifo = nullptr;
+            return handle;
+        }
+    }
+
+    return nullptr;
+}
+
+auto ThreadPool::notify_sleeper() noexcept -> void
+{
+    if (m_sleepers.load(std::memory_order::seq_cst) > 0)
+    {
+        // acquiring the mutex orders this notification after a sleeper's predicate check
+        {
+            std::scoped_lock lk{m_wait_mutex};
+        }
+        m_wait_cv.notify_one();
+    }
+}
+
+auto ThreadPool::notify_sleepers(std::size_t count) noexcept -> void
+{
+    const auto sleepers = m_sleepers.load(std::memory_order::seq_cst);
+    if (sleepers > 0)
+    {
+        {
+            std::scoped_lock lk{m_wait_mutex};
+        }
+        if (count >= sleepers)
+        {
+            m_wait_cv.notify_all();
+            return;
+        }
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            m_wait_cv.notify_one();
+        }
+    }
 }
 
 auto ThreadPool::from_current_thread() -> ThreadPool*
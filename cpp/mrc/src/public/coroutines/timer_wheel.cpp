@@ -0,0 +1,442 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "mrc/coroutines/timer_wheel.hpp"
+
+#include "mrc/coroutines/thread_pool.hpp"
+
+#include <glog/logging.h>
+
+#include <algorithm>
+#include <bit>
+#include <sstream>
+#include <utility>
+
+namespace mrc::coroutines {
+
+namespace {
+
+constexpr auto level_shift(std::size_t level) -> std::uint64_t
+{
+    return level * TimerWheel::SlotBits;
+}
+
+/// the furthest tick from m_now which can be placed without being parked in the last slot of the top level
+constexpr std::uint64_t MaxSpan = std::uint64_t{1} << level_shift(TimerWheel::LevelCount);
+
+}  // namespace
+
+TimerWheel::SleepOperation::SleepOperation(TimerWheel& wheel,
+                                           time_point_t deadline,
+                                           ThreadPool* thread_pool) noexcept :
+  m_wheel(wheel),
+  m_deadline(deadline),
+  m_resume_on(thread_pool)
+{}
+
+auto TimerWheel::SleepOperation::await_suspend(std::coroutine_handle<> awaiting_coroutine) noexcept -> void
+{
+    ThreadLocalContext::suspend_thread_local_context();
+    if (m_resume_on != nullptr)
+    {
+        set_resume_on_thread_pool(m_resume_on);
+    }
+
+    m_awaiting_coroutine = awaiting_coroutine;
+    m_wheel.schedule(*this, m_deadline);
+}
+
+auto TimerWheel::SleepOperation::await_resume() noexcept -> void
+{
+    ThreadLocalContext::resume_thread_local_context();
+}
+
+void TimerWheel::SleepOperation::on_expired() noexcept
+{
+    resume_coroutine(m_awaiting_coroutine);
+}
+
+TimerWheel::TimerWheel() : TimerWheel(Options{}) {}
+
+TimerWheel::TimerWheel(Options opts) : m_opts(std::move(opts)), m_epoch(clock_t::now())
+{
+    CHECK_GT(m_opts.resolution.count(), 0) << "timer wheel resolution must be positive";
+
+    if (m_opts.description.empty())
+    {
+        std::stringstream ss;
+        ss << "timer_wheel_" << this;
+        m_opts.description = ss.str();
+    }
+}
+
+TimerWheel::~TimerWheel()
+{
+    shutdown();
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stop = true;
+    }
+    m_ticker_cv.notify_one();
+
+    if (m_thread.joinable())
+    {
+        m_thread.join();
+    }
+}
+
+auto TimerWheel::schedule(Timer& timer, time_point_t deadline) -> void
+{
+    bool notify = false;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        CHECK(!timer.m_pending) << "timer is already scheduled on " << m_opts.description;
+        CHECK(!m_stop) << "timer scheduled on " << m_opts.description << " after its destruction began";
+
+        if (!m_thread.joinable())
+        {
+            m_thread = std::thread([this] { ticker(); });
+        }
+
+        // m_now may lag the clock while the ticker sleeps; placing relative to m_now stays correct, only coarser
+        timer.m_expiry  = std::max(deadline_to_tick(deadline), m_now + 1);
+        timer.m_pending = true;
+        ++m_size;
+
+        if (m_shutdown)
+        {
+            expire_locked(timer);
+            notify = true;
+        }
+        else
+        {
+            insert_locked(timer);
+            notify = timer.m_expiry < m_wake_tick;
+        }
+    }
+
+    if (notify)
+    {
+        m_ticker_cv.notify_one();
+    }
+}
+
+auto TimerWheel::cancel(Timer& timer) -> bool
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    if (timer.m_pending)
+    {
+        unlink_locked(timer);
+        timer.m_pending = false;
+        --m_size;
+        m_expired_cv.notify_all();
+        return true;
+    }
+
+    DCHECK(!(m_firing == &timer && std::this_thread::get_id() == m_thread.get_id()))
+        << "a timer cannot be cancelled from its own callback";
+    m_expired_cv.wait(lock, [this, &timer] { return m_firing != &timer; });
+    return false;
+}
+
+auto TimerWheel::shutdown() -> void
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    if (!m_shutdown)
+    {
+        m_shutdown = true;
+        expire_all_locked();
+        m_ticker_cv.notify_one();
+    }
+
+    DCHECK(m_size == 0 || std::this_thread::get_id() != m_thread.get_id())
+        << "a timer wheel cannot be shut down from an expiry callback";
+    m_expired_cv.wait(lock, [this] { return m_size == 0; });
+}
+
+auto TimerWheel::size() const -> std::size_t
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_size;
+}
+
+const std::string& TimerWheel::description() const
+{
+    return m_opts.description;
+}
+
+auto TimerWheel::current() -> TimerWheel&
+{
+    auto* thread_pool = ThreadPool::from_current_thread();
+    if (thread_pool != nullptr)
+    {
+        return thread_pool->timer_wheel();
+    }
+
+    static TimerWheel wheel(Options{.description = "default_timer_wheel"});
+    return wheel;
+}
+
+auto TimerWheel::ticker() -> void
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while (true)
+    {
+        if (!m_shutdown)
+        {
+            advance_locked(current_tick());
+        }
+
+        while (m_expired_head != nullptr)
+        {
+            auto* timer = m_expired_head;
+            unlink_locked(*timer);
+            timer->m_pending = false;
+            m_firing         = timer;
+
+            lock.unlock();
+            timer->on_expired();
+            lock.lock();
+
+            m_firing = nullptr;
+            --m_size;
+            m_expired_cv.notify_all();
+        }
+
+        if (m_stop)
+        {
+            break;
+        }
+
+        m_wake_tick = m_shutdown ? NoTick : next_tick_locked();
+        if (m_wake_tick == NoTick)
+        {
+            m_ticker_cv.wait(lock);
+        }
+        else
+        {
+            m_ticker_cv.wait_until(lock, tick_to_time_point(m_wake_tick));
+        }
+    }
+}
+
+auto TimerWheel::deadline_to_tick(time_point_t deadline) const -> std::uint64_t
+{
+    if (deadline <= m_epoch)
+    {
+        return 0;
+    }
+
+    // round up so a timer never expires before its deadline
+    auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(deadline - m_epoch);
+    if (elapsed.count() > std::chrono::nanoseconds::max().count() - m_opts.resolution.count())
+    {
+        return NoTick - 1;
+    }
+    return (elapsed.count() + m_opts.resolution.count() - 1) / m_opts.resolution.count();
+}
+
+auto TimerWheel::tick_to_time_point(std::uint64_t tick) const -> time_point_t
+{
+    return m_epoch + std::chrono::duration_cast<clock_t::duration>(m_opts.resolution * tick);
+}
+
+auto TimerWheel::current_tick() const -> std::uint64_t
+{
+    auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(clock_t::now() - m_epoch);
+    return elapsed.count() / m_opts.resolution.count();
+}
+
+auto TimerWheel::insert_locked(Timer& timer) -> void
+{
+    DCHECK_GE(timer.m_expiry, m_now);
+    auto delta = timer.m_expiry - m_now;
+
+    std::size_t level = 0;
+    while (level + 1 < LevelCount && delta >= (std::uint64_t{1} << level_shift(level + 1)))
+    {
+        ++level;
+    }
+
+    // parked in the furthest slot of the top level, then re-placed when that slot is cascaded
+    auto expiry = delta < MaxSpan ? timer.m_expiry : m_now + MaxSpan - 1;
+    auto slot   = (expiry >> level_shift(level)) & (SlotCount - 1);
+
+    link_locked(timer, level, slot);
+}
+
+auto TimerWheel::expire_locked(Timer& timer) -> void
+{
+    timer.m_level = LevelCount;
+    timer.m_slot  = 0;
+    timer.m_next  = nullptr;
+    timer.m_prev  = m_expired_tail;
+
+    if (m_expired_tail != nullptr)
+    {
+        m_expired_tail->m_next = &timer;
+    }
+    else
+    {
+        m_expired_head = &timer;
+    }
+    m_expired_tail = &timer;
+}
+
+auto TimerWheel::link_locked(Timer& timer, std::uint32_t level, std::uint32_t slot) -> void
+{
+    auto& head = m_slots[level][slot];
+
+    timer.m_level = level;
+    timer.m_slot  = slot;
+    timer.m_prev  = nullptr;
+    timer.m_next  = head;
+
+    if (head != nullptr)
+    {
+        head->m_prev = &timer;
+    }
+    head = &timer;
+
+    m_occupied[level] |= bitmap_t{1} << slot;
+}
+
+auto TimerWheel::unlink_locked(Timer& timer) -> void
+{
+    if (timer.m_next != nullptr)
+    {
+        timer.m_next->m_prev = timer.m_prev;
+    }
+
+    if (timer.m_level == LevelCount)
+    {
+        (timer.m_prev != nullptr ? timer.m_prev->m_next : m_expired_head) = timer.m_next;
+        if (m_expired_tail == &timer)
+        {
+            m_expired_tail = timer.m_prev;
+        }
+    }
+    else
+    {
+        auto& head = m_slots[timer.m_level][timer.m_slot];
+        (timer.m_prev != nullptr ? timer.m_prev->m_next : head) = timer.m_next;
+        if (head == nullptr)
+        {
+            m_occupied[timer.m_level] &= ~(bitmap_t{1} << timer.m_slot);
+        }
+    }
+
+    timer.m_prev = nullptr;
+    timer.m_next = nullptr;
+}
+
+auto TimerWheel::next_tick_locked() const -> std::uint64_t
+{
+    auto next = NoTick;
+
+    for (std::size_t level = 0; level < LevelCount; ++level)
+    {
+        if (m_occupied[level] == 0)
+        {
+            continue;
+        }
+
+        // distance, in slots of this level, from the current position to the next occupied slot; the current slot
+        // itself was processed at level 0 and is a full rotation away at the levels above
+        auto position = (m_now >> level_shift(level)) & (SlotCount - 1);
+        auto rotated  = std::rotr(m_occupied[level], static_cast<int>((position + 1) & (SlotCount - 1)));
+        auto distance = static_cast<std::uint64_t>(std::countr_zero(rotated)) + 1;
+
+        auto tick = level == 0 ? m_now + distance : ((m_now >> level_shift(level)) + distance) << level_shift(level);
+        next      = std::min(next, tick);
+    }
+
+    return next;
+}
+
+auto TimerWheel::advance_locked(std::uint64_t tick) -> void
+{
+    // ticks without an occupied slot to expire or cascade are skipped
+    while (m_now < tick)
+    {
+        auto next = next_tick_locked();
+        if (next > tick)
+        {
+            m_now = tick;
+            break;
+        }
+        process_tick_locked(next);
+    }
+}
+
+auto TimerWheel::process_tick_locked(std::uint64_t tick) -> void
+{
+    m_now = tick;
+
+    // cascade from the top so timers moved down a level are cascaded again in the same tick if they are due
+    for (auto level = LevelCount - 1; level > 0; --level)
+    {
+        if ((tick & ((std::uint64_t{1} << level_shift(level)) - 1)) != 0)
+        {
+            continue;
+        }
+
+        auto slot   = (tick >> level_shift(level)) & (SlotCount - 1);
+        auto* timer = std::exchange(m_slots[level][slot], nullptr);
+        m_occupied[level] &= ~(bitmap_t{1} << slot);
+
+        while (timer != nullptr)
+        {
+            auto* next = timer->m_next;
+            insert_locked(*timer);
+            timer = next;
+        }
+    }
+
+    auto slot   = tick & (SlotCount - 1);
+    auto* timer = std::exchange(m_slots[0][slot], nullptr);
+    m_occupied[0] &= ~(bitmap_t{1} << slot);
+
+    while (timer != nullptr)
+    {
+        auto* next = timer->m_next;
+        DCHECK_EQ(timer->m_expiry, tick);
+        expire_locked(*timer);
+        timer = next;
+    }
+}
+
+auto TimerWheel::expire_all_locked() -> void
+{
+    for (std::size_t level = 0; level < LevelCount; ++level)
+    {
+        for (auto& head : m_slots[level])
+        {
+            auto* timer = std::exchange(head, nullptr);
+            while (timer != nullptr)
+            {
+                auto* next = timer->m_next;
+                expire_locked(*timer);
+                timer = next;
+            }
+        }
+        m_occupied[level] = 0;
+    }
+}
+
+}  // namespace mrc::coroutines
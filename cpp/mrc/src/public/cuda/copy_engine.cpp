@@ -0,0 +1,229 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2021-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "mrc/cuda/copy_engine.hpp"
+
+#include "mrc/cuda/common.hpp"
+#include "mrc/cuda/device_guard.hpp"
+
+#include <glog/logging.h>
+
+#include <utility>
+
+namespace mrc {
+
+namespace {
+
+bool is_device_accessible(const void* ptr)
+{
+    cudaPointerAttributes attributes;
+    if (cudaPointerGetAttributes(&attributes, ptr) != cudaSuccess)
+    {
+        // clear the error reported for pointers unknown to cuda
+        cudaGetLastError();
+        return false;
+    }
+    return (attributes.type == cudaMemoryTypeDevice || attributes.type == cudaMemoryTypeManaged);
+}
+
+}  // namespace
+
+struct CopyCompletion::Batch
+{
+    Batch(CopyEngine& copy_engine, CopyEngine::Lane& copy_lane) :
+      engine(copy_engine),
+      lane(copy_lane),
+      future(promise.get_future().share())
+    {}
+
+    CopyEngine& engine;
+    CopyEngine::Lane& lane;
+    Promise<void> promise;
+    SharedFuture<void> future;
+    coroutines::Event event;
+    std::size_t size{0};
+    std::atomic<bool> closed{false};
+};
+
+CopyCompletion::CopyCompletion(std::shared_ptr<Batch> batch) : m_batch(std::move(batch)) {}
+
+bool CopyCompletion::is_ready() const
+{
+    flush();
+    return (!m_batch || m_batch->event.is_set());
+}
+
+void CopyCompletion::await() const
+{
+    flush();
+    if (m_batch)
+    {
+        m_batch->future.get();
+    }
+}
+
+void CopyCompletion::flush() const
+{
+    if (!m_batch || m_batch->closed.load(std::memory_order_acquire))
+    {
+        return;
+    }
+
+    DeviceGuard guard(m_batch->engine.device_id());
+    std::lock_guard<std::mutex> lock(m_batch->lane.mutex);
+    if (m_batch->lane.open == m_batch)
+    {
+        CopyEngine::close(m_batch->lane);
+    }
+}
+
+const coroutines::Event& CopyCompletion::event() const
+{
+    CHECK(m_batch) << "awaiting an empty CopyCompletion";
+    return m_batch->event;
+}
+
+CopyEngine::CopyEngine(int device_id, std::size_t max_batch_size) :
+  m_device_id(device_id),
+  m_max_batch_size(max_batch_size)
+{
+    CHECK_GT(m_max_batch_size, 0);
+    DeviceGuard guard(m_device_id);
+    for (auto& lane : m_lanes)
+    {
+        MRC_CHECK_CUDA(cudaStreamCreateWithFlags(&lane.stream, cudaStreamNonBlocking));
+    }
+}
+
+CopyEngine::~CopyEngine()
+{
+    flush();
+    DeviceGuard guard(m_device_id);
+    for (auto& lane : m_lanes)
+    {
+        MRC_CHECK_CUDA(cudaStreamSynchronize(lane.stream));
+        MRC_CHECK_CUDA(cudaStreamDestroy(lane.stream));
+    }
+}
+
+int CopyEngine::device_id() const
+{
+    return m_device_id;
+}
+
+CopyCompletion CopyEngine::copy_async(void* dst, const void* src, std::size_t bytes, cudaMemcpyKind kind)
+{
+    return enqueue(m_lanes[direction_of(kind, dst, src)], [&](cudaStream_t stream) {
+        MRC_CHECK_CUDA(cudaMemcpyAsync(dst, src, bytes, kind, stream));
+    });
+}
+
+CopyCompletion CopyEngine::copy_peer_async(void* dst,
+                                           int dst_device,
+                                           const void* src,
+                                           int src_device,
+                                           std::size_t bytes)
+{
+    return enqueue(m_lanes[DeviceToDevice], [&](cudaStream_t stream) {
+        MRC_CHECK_CUDA(cudaMemcpyPeerAsync(dst, dst_device, src, src_device, bytes, stream));
+    });
+}
+
+CopyCompletion CopyEngine::prefetch_async(const void* ptr, std::size_t bytes, int device_id)
+{
+    auto& lane = m_lanes[device_id == cudaCpuDeviceId ? DeviceToHost : HostToDevice];
+    return enqueue(lane, [&](cudaStream_t stream) {
+        MRC_CHECK_CUDA(cudaMemPrefetchAsync(ptr, bytes, device_id, stream));
+    });
+}
+
+CopyCompletion CopyEngine::prefetch_async(const void* ptr, std::size_t bytes)
+{
+    return prefetch_async(ptr, bytes, m_device_id);
+}
+
+void CopyEngine::flush()
+{
+    DeviceGuard guard(m_device_id);
+    for (auto& lane : m_lanes)
+    {
+        std::lock_guard<std::mutex> lock(lane.mutex);
+        if (lane.open)
+        {
+            close(lane);
+        }
+    }
+}
+
+CopyEngine::Direction CopyEngine::direction_of(cudaMemcpyKind kind, void* dst, const void* src) const
+{
+    switch (kind)
+    {
+    case cudaMemcpyHostToDevice:
+        return HostToDevice;
+    case cudaMemcpyDeviceToDevice:
+        return DeviceToDevice;
+    case cudaMemcpyDefault: {
+        auto device_dst = is_device_accessible(dst);
+        auto device_src = is_device_accessible(src);
+        if (device_dst)
+        {
+            return (device_src ? DeviceToDevice : HostToDevice);
+        }
+        return DeviceToHost;
+    }
+    default:
+        return DeviceToHost;
+    }
+}
+
+template <typename EnqueueFnT>
+CopyCompletion CopyEngine::enqueue(Lane& lane, EnqueueFnT&& enqueue_fn)
+{
+    DeviceGuard guard(m_device_id);
+    std::lock_guard<std::mutex> lock(lane.mutex);
+
+    enqueue_fn(lane.stream);
+    if (!lane.open)
+    {
+        lane.open = std::make_shared<CopyCompletion::Batch>(*this, lane);
+    }
+    CopyCompletion completion(lane.open);
+    if (++lane.open->size >= m_max_batch_size)
+    {
+        close(lane);
+    }
+    return completion;
+}
+
+void CopyEngine::close(Lane& lane)
+{
+    // the host function holds a reference to the batch until it signals its completion
+    auto* batch = new std::shared_ptr<CopyCompletion::Batch>(std::move(lane.open));
+    (*batch)->closed.store(true, std::memory_order_release);
+    MRC_CHECK_CUDA(cudaLaunchHostFunc(
+        lane.stream,
+        [](void* user_data) {
+            auto* batch = static_cast<std::shared_ptr<CopyCompletion::Batch>*>(user_data);
+            (*batch)->promise.set_value();
+            (*batch)->event.set();
+            delete batch;
+        },
+        batch));
+}
+
+}  // namespace mrc
@@ -0,0 +1,154 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "mrc/cuda/graph_cache.hpp"
+
+#include "mrc/cuda/common.hpp"
+
+#include <glog/logging.h>
+
+#include <exception>
+
+namespace mrc {
+
+CudaGraphCache::CudaGraphCache(std::size_t capacity) : m_capacity(capacity)
+{
+    CHECK_GT(m_capacity, 0);
+}
+
+CudaGraphCache::~CudaGraphCache()
+{
+    clear();
+}
+
+void CudaGraphCache::launch(const shape_t& shape, cudaStream_t stream, const capture_fn_t& capture_fn)
+{
+    int device_id;
+    MRC_CHECK_CUDA(cudaGetDevice(&device_id));
+
+    {
+        std::lock_guard lock(m_mutex);
+        auto& device = m_devices[device_id];
+        auto search  = device.graphs.find(shape);
+        if (search != device.graphs.end())
+        {
+            // launches of a graph exec must not overlap; the mutex serializes them
+            device.lru.splice(device.lru.begin(), device.lru, search->second.second);
+            MRC_CHECK_CUDA(cudaGraphLaunch(search->second.first, stream));
+            m_replays.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+    }
+
+    // capture outside of the lock; the capture function enqueues the work of a message and may be long running
+    auto exec = capture(stream, capture_fn);
+
+    std::lock_guard lock(m_mutex);
+    auto& device = m_devices[device_id];
+    auto search  = device.graphs.find(shape);
+    if (search != device.graphs.end())
+    {
+        // another thread captured the shape concurrently; keep its graph
+        MRC_CHECK_CUDA(cudaGraphExecDestroy(exec));
+        exec = search->second.first;
+        device.lru.splice(device.lru.begin(), device.lru, search->second.second);
+    }
+    else
+    {
+        insert(device, shape, exec);
+    }
+    MRC_CHECK_CUDA(cudaGraphLaunch(exec, stream));
+    m_captures.fetch_add(1, std::memory_order_relaxed);
+}
+
+cudaGraphExec_t CudaGraphCache::capture(cudaStream_t stream, const capture_fn_t& capture_fn)
+{
+    cudaGraph_t graph{nullptr};
+    cudaGraphExec_t exec{nullptr};
+
+    // thread local capture mode: other threads of the partition may keep calling unsafe cuda apis meanwhile
+    MRC_CHECK_CUDA(cudaStreamBeginCapture(stream, cudaStreamCaptureModeThreadLocal));
+    try
+    {
+        capture_fn(stream);
+    } catch (...)
+    {
+        // end the capture so the stream remains usable, then discard the partial graph
+        if (cudaStreamEndCapture(stream, &graph) == cudaSuccess && graph != nullptr)
+        {
+            cudaGraphDestroy(graph);
+        }
+        cudaGetLastError();
+        throw;
+    }
+    MRC_CHECK_CUDA(cudaStreamEndCapture(stream, &graph));
+    CHECK(graph != nullptr) << "cuda graph capture was invalidated";
+
+    MRC_CHECK_CUDA(cudaGraphInstantiateWithFlags(&exec, graph, 0));
+    MRC_CHECK_CUDA(cudaGraphDestroy(graph));
+    return exec;
+}
+
+void CudaGraphCache::insert(Device& device, const shape_t& shape, cudaGraphExec_t exec)
+{
+    if (device.graphs.size() >= m_capacity)
+    {
+        // destroying the exec of a graph in flight is safe; its launches complete before it is released
+        auto evicted = device.graphs.find(device.lru.back());
+        MRC_CHECK_CUDA(cudaGraphExecDestroy(evicted->second.first));
+        device.graphs.erase(evicted);
+        device.lru.pop_back();
+    }
+    device.lru.push_front(shape);
+    device.graphs.emplace(shape, std::make_pair(exec, device.lru.begin()));
+}
+
+void CudaGraphCache::clear()
+{
+    std::lock_guard lock(m_mutex);
+    for (auto& [device_id, device] : m_devices)
+    {
+        for (auto& [shape, entry] : device.graphs)
+        {
+            MRC_CHECK_CUDA(cudaGraphExecDestroy(entry.first));
+        }
+    }
+    m_devices.clear();
+}
+
+std::size_t CudaGraphCache::size() const
+{
+    std::lock_guard lock(m_mutex);
+    std::size_t size = 0;
+    for (const auto& [device_id, device] : m_devices)
+    {
+        size += device.graphs.size();
+    }
+    return size;
+}
+
+std::size_t CudaGraphCache::captures() const
+{
+    return m_captures.load(std::memory_order_relaxed);
+}
+
+std::size_t CudaGraphCache::replays() const
+{
+    return m_replays.load(std::memory_order_relaxed);
+}
+
+}  // namespace mrc
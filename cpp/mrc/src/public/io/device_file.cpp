@@ -0,0 +1,429 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "mrc/io/device_file.hpp"
+
+#include "mrc/coroutines/thread_pool.hpp"
+#include "mrc/coroutines/when_all.hpp"
+#include "mrc/cuda/common.hpp"
+#include "mrc/cuda/device_guard.hpp"
+#include "mrc/exceptions/runtime_error.hpp"
+#include "mrc/memory/memory_kind.hpp"
+#include "mrc/memory/resources/host/pinned_memory_resource.hpp"
+#include "mrc/memory/resources/memory_resource.hpp"
+
+#include <cuda_runtime.h>
+#include <fcntl.h>
+#include <glog/logging.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#ifdef MRC_HAS_CUFILE
+    #include <cufile.h>
+#endif
+
+#include <cerrno>
+#include <mutex>
+#include <system_error>
+#include <utility>
+
+namespace mrc::io {
+
+using coroutines::RingBufferOpStatus;
+
+namespace {
+
+// alignment of the offsets and sizes of O_DIRECT i/o; the logical block size of common devices
+constexpr std::size_t DirectIoAlignment = 4096;
+
+std::system_error make_system_error(int err, const std::string& what, const std::string& path)
+{
+    return std::system_error(err, std::generic_category(), what + " " + path);
+}
+
+int open_file(const std::string& path, int flags)
+{
+    int fd = ::open(path.c_str(), flags | O_CLOEXEC);
+    if (fd < 0)
+    {
+        throw make_system_error(errno, "open", path);
+    }
+    return fd;
+}
+
+#ifdef MRC_HAS_CUFILE
+// the driver is opened once and left open for the lifetime of the process, as closing it while another reader holds
+// registered handles would invalidate them
+bool open_cufile_driver()
+{
+    static std::once_flag once;
+    static bool opened = false;
+    std::call_once(once, [] {
+        auto status = cuFileDriverOpen();
+        opened      = (status.err == CU_FILE_SUCCESS);
+        if (!opened)
+        {
+            VLOG(1) << "cuFileDriverOpen failed with cuFile error " << status.err
+                    << "; device files are read through pinned host memory";
+        }
+    });
+    return opened;
+}
+#endif
+
+}  // namespace
+
+DeviceChunk::DeviceChunk(std::shared_ptr<const memory::buffer> storage, std::size_t bytes, std::uint64_t offset) :
+  m_storage(std::move(storage)),
+  m_bytes(bytes),
+  m_offset(offset)
+{
+    CHECK(m_storage && m_bytes <= m_storage->bytes());
+}
+
+const void* DeviceChunk::data() const
+{
+    return m_storage ? m_storage->data() : nullptr;
+}
+
+std::size_t DeviceChunk::bytes() const
+{
+    return m_bytes;
+}
+
+std::uint64_t DeviceChunk::offset() const
+{
+    return m_offset;
+}
+
+memory::const_buffer_view DeviceChunk::view() const
+{
+    return {data(), m_bytes, m_storage ? m_storage->kind() : memory::memory_kind::none};
+}
+
+// reads bytes at offset into device memory on the calling thread; slot is the index of the read within its batch, so
+// the reads in flight never share a slot
+class DeviceFileReader::Backend
+{
+  public:
+    virtual ~Backend() = default;
+
+    virtual std::int64_t read(void* device_ptr, std::size_t bytes, std::uint64_t offset, std::size_t slot) = 0;
+
+    virtual bool gpu_direct() const = 0;
+
+    virtual int fd() const = 0;
+};
+
+#ifdef MRC_HAS_CUFILE
+class DeviceFileReader::GdsBackend final : public Backend
+{
+  public:
+    // null if the file does not support GPUDirect Storage, e.g. O_DIRECT is unsupported by its filesystem
+    static std::unique_ptr<GdsBackend> open(const std::string& path)
+    {
+        if (!open_cufile_driver())
+        {
+            return nullptr;
+        }
+
+        int fd = ::open(path.c_str(), O_RDONLY | O_DIRECT | O_CLOEXEC);
+        if (fd < 0)
+        {
+            VLOG(1) << "O_DIRECT is not supported for " << path << "; reading through pinned host memory";
+            return nullptr;
+        }
+
+        CUfileDescr_t descr{};
+        descr.handle.fd = fd;
+        descr.type      = CU_FILE_HANDLE_TYPE_OPAQUE_FD;
+        CUfileHandle_t handle{};
+        auto status = cuFileHandleRegister(&handle, &descr);
+        if (status.err != CU_FILE_SUCCESS)
+        {
+            VLOG(1) << "cuFileHandleRegister failed for " << path << " with cuFile error " << status.err
+                    << "; reading through pinned host memory";
+            ::close(fd);
+            return nullptr;
+        }
+        return std::unique_ptr<GdsBackend>(new GdsBackend(path, fd, handle));
+    }
+
+    ~GdsBackend() final
+    {
+        cuFileHandleDeregister(m_handle);
+        ::close(m_fd);
+    }
+
+    std::int64_t read(void* device_ptr, std::size_t bytes, std::uint64_t offset, std::size_t /*slot*/) final
+    {
+        auto rc = cuFileRead(m_handle, device_ptr, bytes, static_cast<off_t>(offset), 0);
+        if (rc == -1)
+        {
+            throw make_system_error(errno, "cuFileRead", m_path);
+        }
+        if (rc < 0)
+        {
+            throw exceptions::MrcRuntimeError("cuFileRead of " + m_path + " failed with cuFile error " +
+                                              std::to_string(-rc));
+        }
+        return rc;
+    }
+
+    bool gpu_direct() const final
+    {
+        return true;
+    }
+
+    int fd() const final
+    {
+        return m_fd;
+    }
+
+  private:
+    GdsBackend(std::string path, int fd, CUfileHandle_t handle) : m_path(std::move(path)), m_fd(fd), m_handle(handle) {}
+
+    const std::string m_path;
+    const int m_fd;
+    CUfileHandle_t m_handle;
+};
+#endif
+
+class DeviceFileReader::BounceBackend final : public Backend
+{
+  public:
+    BounceBackend(const std::string& path, const DeviceFileReaderOptions& options) :
+      m_path(path),
+      m_fd(open_file(path, O_RDONLY)),
+      m_device_id(options.device_id)
+    {
+        auto pinned = std::make_shared<memory::pinned_memory_resource>();
+
+        DeviceGuard guard(m_device_id);
+        for (std::size_t i = 0; i < options.read_ahead; ++i)
+        {
+            auto& slot = m_slots.emplace_back(Slot{memory::buffer(options.chunk_size, pinned), nullptr});
+            MRC_CHECK_CUDA(cudaStreamCreateWithFlags(&slot.stream, cudaStreamNonBlocking));
+        }
+    }
+
+    ~BounceBackend() final
+    {
+        DeviceGuard guard(m_device_id);
+        for (auto& slot : m_slots)
+        {
+            MRC_CHECK_CUDA(cudaStreamDestroy(slot.stream));
+        }
+        ::close(m_fd);
+    }
+
+    std::int64_t read(void* device_ptr, std::size_t bytes, std::uint64_t offset, std::size_t slot_index) final
+    {
+        CHECK_LT(slot_index, m_slots.size());
+        auto& slot = m_slots[slot_index];
+        CHECK_LE(bytes, slot.staging.bytes());
+
+        auto rc = ::pread(m_fd, slot.staging.data(), bytes, static_cast<off_t>(offset));
+        if (rc < 0)
+        {
+            throw make_system_error(errno, "read", m_path);
+        }
+        if (rc > 0)
+        {
+            DeviceGuard guard(m_device_id);
+            auto status = cudaMemcpyAsync(device_ptr, slot.staging.data(), rc, cudaMemcpyHostToDevice, slot.stream);
+            if (status == cudaSuccess)
+            {
+                status = cudaStreamSynchronize(slot.stream);
+            }
+            if (status != cudaSuccess)
+            {
+                throw exceptions::MrcRuntimeError("copy of " + m_path + " to the device failed: " +
+                                                  cudaGetErrorString(status));
+            }
+        }
+        return rc;
+    }
+
+    bool gpu_direct() const final
+    {
+        return false;
+    }
+
+    int fd() const final
+    {
+        return m_fd;
+    }
+
+  private:
+    // staging buffer and stream of the read of a slot
+    struct Slot
+    {
+        memory::buffer staging;
+        cudaStream_t stream;
+    };
+
+    const std::string m_path;
+    const int m_fd;
+    const int m_device_id;
+    std::vector<Slot> m_slots;
+};
+
+struct DeviceFileReader::Block
+{
+    std::shared_ptr<memory::buffer> storage;
+    std::size_t bytes;
+    std::uint64_t offset;
+};
+
+DeviceFileReader::DeviceFileReader(std::string path,
+                                   DeviceFileReaderOptions options,
+                                   std::shared_ptr<memory::memory_resource> device_memory_resource) :
+  m_path(std::move(path)),
+  m_options(options),
+  m_memory_resource(std::move(device_memory_resource))
+{
+    CHECK(m_memory_resource) << "a device file reader requires a device memory resource";
+    CHECK(m_memory_resource->kind() == memory::memory_kind::device ||
+          m_memory_resource->kind() == memory::memory_kind::managed)
+        << "device file chunks must be allocated from device or managed memory";
+    CHECK_GT(m_options.chunk_size, 0);
+    CHECK_GT(m_options.read_ahead, 0);
+
+    // cuFile requires O_DIRECT reads at aligned offsets
+    m_options.chunk_size = (m_options.chunk_size + DirectIoAlignment - 1) / DirectIoAlignment * DirectIoAlignment;
+
+#ifdef MRC_HAS_CUFILE
+    if (m_memory_resource->kind() == memory::memory_kind::device)
+    {
+        m_backend = GdsBackend::open(m_path);
+    }
+#endif
+    if (!m_backend)
+    {
+        m_backend = std::make_unique<BounceBackend>(m_path, m_options);
+    }
+
+    struct stat st
+    {};
+    if (::fstat(m_backend->fd(), &st) != 0)
+    {
+        throw make_system_error(errno, "fstat", m_path);
+    }
+    m_file_size = st.st_size;
+
+    // the reads block their threads, which issue them on the device of the memory resource
+    const auto device_id = m_options.device_id;
+    m_thread_pool        = std::make_unique<coroutines::ThreadPool>(coroutines::ThreadPool::Options{
+               .thread_count            = static_cast<std::uint32_t>(m_options.read_ahead),
+               .on_thread_start_functor = [device_id](std::size_t) { MRC_CHECK_CUDA(cudaSetDevice(device_id)); },
+               .description             = "device_file_reader"});
+}
+
+DeviceFileReader::~DeviceFileReader() = default;
+
+const std::string& DeviceFileReader::path() const
+{
+    return m_path;
+}
+
+const DeviceFileReaderOptions& DeviceFileReader::options() const
+{
+    return m_options;
+}
+
+bool DeviceFileReader::gpu_direct() const
+{
+    return m_backend->gpu_direct();
+}
+
+std::uint64_t DeviceFileReader::file_size() const
+{
+    return m_file_size;
+}
+
+coroutines::Task<void> DeviceFileReader::read(coroutines::RingBuffer<DeviceChunk>& output)
+{
+    std::uint64_t offset = 0;
+    auto blocks          = co_await read_blocks(offset);
+
+    // a short read marks the end of the file
+    while (!blocks.empty() && blocks.back().bytes == m_options.chunk_size)
+    {
+        offset += blocks.size() * m_options.chunk_size;
+
+        // the next reads are in flight while the chunks of the current ones are emitted
+        auto [next, emitted] =
+            co_await coroutines::when_all(read_blocks(offset), emit_blocks(std::move(blocks), output));
+        if (!emitted.return_value())
+        {
+            co_return;
+        }
+        blocks = std::move(next.return_value());
+    }
+
+    co_await emit_blocks(std::move(blocks), output);
+}
+
+coroutines::Task<std::vector<DeviceFileReader::Block>> DeviceFileReader::read_blocks(std::uint64_t offset)
+{
+    auto read_block = [this](void* buffer, std::uint64_t offset, std::size_t slot) -> coroutines::Task<std::int64_t> {
+        co_await m_thread_pool->schedule();
+        co_return m_backend->read(buffer, m_options.chunk_size, offset, slot);
+    };
+
+    std::vector<Block> blocks;
+    std::vector<coroutines::Task<std::int64_t>> reads;
+    for (std::size_t i = 0; i < m_options.read_ahead && offset + i * m_options.chunk_size < m_file_size; ++i)
+    {
+        auto storage = std::make_shared<memory::buffer>(m_options.chunk_size, m_memory_resource);
+        auto& block  = blocks.emplace_back(Block{std::move(storage), 0, offset + i * m_options.chunk_size});
+        reads.push_back(read_block(block.storage->data(), block.offset, i));
+    }
+    if (reads.empty())
+    {
+        co_return blocks;
+    }
+
+    auto results = co_await coroutines::when_all(std::move(reads));
+    for (std::size_t i = 0; i < blocks.size(); ++i)
+    {
+        blocks[i].bytes = results[i].return_value();
+        if (blocks[i].bytes < m_options.chunk_size)
+        {
+            blocks.resize(i + 1);
+            break;
+        }
+    }
+    co_return blocks;
+}
+
+coroutines::Task<bool> DeviceFileReader::emit_blocks(std::vector<Block> blocks,
+                                                     coroutines::RingBuffer<DeviceChunk>& output)
+{
+    for (auto& block : blocks)
+    {
+        DeviceChunk chunk(std::move(block.storage), block.bytes, block.offset);
+        if (co_await output.write(std::move(chunk)) != RingBufferOpStatus::Success)
+        {
+            co_return false;
+        }
+    }
+    co_return true;
+}
+
+}  // namespace mrc::io
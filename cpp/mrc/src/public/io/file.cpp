@@ -0,0 +1,592 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "mrc/io/file.hpp"
+
+#include "mrc/coroutines/io_scheduler.hpp"
+#include "mrc/coroutines/when_all.hpp"
+#include "mrc/exceptions/runtime_error.hpp"
+
+#include <fcntl.h>
+#include <glog/logging.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <system_error>
+#include <tuple>
+#include <utility>
+
+namespace mrc::io {
+
+using coroutines::RingBufferOpStatus;
+
+namespace {
+
+// alignment of the buffers, offsets and sizes of O_DIRECT i/o; the logical block size of common devices
+constexpr std::size_t DirectIoAlignment = 4096;
+
+std::size_t align_up(std::size_t bytes, std::size_t alignment)
+{
+    return (bytes + alignment - 1) / alignment * alignment;
+}
+
+std::system_error make_system_error(int err, const std::string& what, const std::string& path)
+{
+    return std::system_error(err, std::generic_category(), what + " " + path);
+}
+
+// opens path with O_DIRECT if requested and supported, returning the file descriptor and whether O_DIRECT is set
+std::pair<int, bool> open_file(const std::string& path, int flags, bool direct_io)
+{
+    if (direct_io)
+    {
+        int fd = ::open(path.c_str(), flags | O_DIRECT, 0644);
+        if (fd >= 0)
+        {
+            return {fd, true};
+        }
+        if (errno != EINVAL)
+        {
+            throw make_system_error(errno, "open", path);
+        }
+        VLOG(1) << "O_DIRECT is not supported for " << path << "; falling back to buffered i/o";
+    }
+
+    int fd = ::open(path.c_str(), flags, 0644);
+    if (fd < 0)
+    {
+        throw make_system_error(errno, "open", path);
+    }
+    return {fd, false};
+}
+
+std::uint64_t stat_size(int fd, const std::string& path)
+{
+    struct stat st
+    {};
+    if (::fstat(fd, &st) != 0)
+    {
+        throw make_system_error(errno, "fstat", path);
+    }
+    return st.st_size;
+}
+
+// shares the ownership of the bytes of a vector
+std::shared_ptr<const std::byte> share_bytes(std::vector<std::byte>&& bytes)
+{
+    auto owner = std::make_shared<std::vector<std::byte>>(std::move(bytes));
+    return {owner, owner->data()};
+}
+
+}  // namespace
+
+FileChunk::FileChunk(std::shared_ptr<const std::byte> storage, std::span<const std::byte> bytes, std::uint64_t offset) :
+  m_storage(std::move(storage)),
+  m_bytes(bytes),
+  m_offset(offset)
+{}
+
+std::span<const std::byte> FileChunk::bytes() const
+{
+    return m_bytes;
+}
+
+std::string_view FileChunk::view() const
+{
+    return {reinterpret_cast<const char*>(m_bytes.data()), m_bytes.size()};
+}
+
+std::uint64_t FileChunk::offset() const
+{
+    return m_offset;
+}
+
+std::size_t FileChunk::size() const
+{
+    return m_bytes.size();
+}
+
+bool FileChunk::empty() const
+{
+    return m_bytes.empty();
+}
+
+std::span<const std::byte> as_bytes(const FileChunk& chunk)
+{
+    return chunk.bytes();
+}
+
+std::span<const std::byte> as_bytes(const std::string& data)
+{
+    return std::as_bytes(std::span(data));
+}
+
+std::span<const std::byte> as_bytes(std::string_view data)
+{
+    return std::as_bytes(std::span(data));
+}
+
+/**
+ * @brief Aligned read buffers of chunk_size bytes; buffers return to the pool once the last chunk viewing them is
+ * destroyed, on whichever thread that happens
+ */
+class FileReader::BufferPool : public std::enable_shared_from_this<FileReader::BufferPool>
+{
+  public:
+    explicit BufferPool(std::size_t buffer_size) : m_buffer_size(buffer_size) {}
+
+    ~BufferPool()
+    {
+        for (auto* buffer : m_free)
+        {
+            std::free(buffer);
+        }
+    }
+
+    std::shared_ptr<std::byte> acquire()
+    {
+        std::byte* buffer = nullptr;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (!m_free.empty())
+            {
+                buffer = m_free.back();
+                m_free.pop_back();
+            }
+        }
+        if (buffer == nullptr)
+        {
+            buffer = static_cast<std::byte*>(std::aligned_alloc(DirectIoAlignment, m_buffer_size));
+            CHECK(buffer != nullptr) << "failed to allocate a read buffer of " << m_buffer_size << " bytes";
+        }
+        return {buffer, [pool = shared_from_this()](std::byte* released) { pool->release(released); }};
+    }
+
+    std::size_t buffer_size() const
+    {
+        return m_buffer_size;
+    }
+
+  private:
+    void release(std::byte* buffer)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_free.push_back(buffer);
+    }
+
+    const std::size_t m_buffer_size;
+    std::mutex m_mutex;
+    std::vector<std::byte*> m_free;
+};
+
+struct FileReader::Block
+{
+    std::shared_ptr<std::byte> storage;
+    std::size_t bytes;
+    std::uint64_t offset;
+};
+
+FileReader::FileReader(std::string path,
+                       FileReaderOptions options,
+                       std::shared_ptr<coroutines::IoScheduler> scheduler) :
+  m_path(std::move(path)),
+  m_options(options),
+  m_scheduler(std::move(scheduler))
+{
+    CHECK(m_scheduler) << "a file reader requires an io scheduler";
+    CHECK_GT(m_options.chunk_size, 0);
+    CHECK_GT(m_options.read_ahead, 0);
+    if (m_options.format == RecordFormat::fixed)
+    {
+        CHECK_GT(m_options.record_size, 0) << "fixed record files require a record_size";
+    }
+
+    std::tie(m_fd, m_direct_io) = open_file(m_path, O_RDONLY | O_CLOEXEC, m_options.direct_io);
+    m_file_size                 = stat_size(m_fd, m_path);
+
+    // direct i/o requires reads at aligned offsets of aligned sizes
+    if (m_direct_io)
+    {
+        m_options.chunk_size = align_up(m_options.chunk_size, DirectIoAlignment);
+    }
+    m_pool = std::make_shared<BufferPool>(align_up(m_options.chunk_size, DirectIoAlignment));
+}
+
+FileReader::~FileReader()
+{
+    if (m_fd >= 0)
+    {
+        ::close(m_fd);
+    }
+}
+
+const std::string& FileReader::path() const
+{
+    return m_path;
+}
+
+const FileReaderOptions& FileReader::options() const
+{
+    return m_options;
+}
+
+bool FileReader::direct_io() const
+{
+    return m_direct_io;
+}
+
+std::uint64_t FileReader::file_size() const
+{
+    return m_file_size;
+}
+
+coroutines::Task<void> FileReader::read(coroutines::RingBuffer<FileChunk>& output)
+{
+    m_carry.clear();
+    m_carry_offset = 0;
+
+    std::uint64_t offset = 0;
+    auto blocks          = co_await read_blocks(offset);
+
+    // a short read marks the end of the file
+    while (!blocks.empty() && blocks.back().bytes == m_options.chunk_size)
+    {
+        offset += blocks.size() * m_options.chunk_size;
+
+        // the next reads are in flight while the chunks of the current ones are emitted
+        auto [next, emitted] =
+            co_await coroutines::when_all(read_blocks(offset), emit_blocks(std::move(blocks), output));
+        if (!emitted.return_value())
+        {
+            co_return;
+        }
+        blocks = std::move(next.return_value());
+    }
+
+    if (!co_await emit_blocks(std::move(blocks), output) || m_carry.empty())
+    {
+        co_return;
+    }
+
+    if (m_options.format == RecordFormat::fixed)
+    {
+        throw mrc::exceptions::MrcRuntimeError("trailing partial record of " + std::to_string(m_carry.size()) +
+                                               " bytes in " + m_path);
+    }
+
+    // the last line of the file lacks a terminator
+    co_await output.write(take_carry());
+}
+
+coroutines::Task<std::vector<FileReader::Block>> FileReader::read_blocks(std::uint64_t offset)
+{
+    auto read_block = [this](std::byte* buffer, std::uint64_t offset) -> coroutines::Task<std::int64_t> {
+        co_return co_await m_scheduler->read(m_fd, {buffer, m_options.chunk_size}, static_cast<std::int64_t>(offset));
+    };
+
+    std::vector<Block> blocks;
+    std::vector<coroutines::Task<std::int64_t>> reads;
+    for (std::size_t i = 0; i < m_options.read_ahead && offset + i * m_options.chunk_size < m_file_size; ++i)
+    {
+        auto& block = blocks.emplace_back(Block{m_pool->acquire(), 0, offset + i * m_options.chunk_size});
+        reads.push_back(read_block(block.storage.get(), block.offset));
+    }
+    if (reads.empty())
+    {
+        co_return blocks;
+    }
+
+    auto results = co_await coroutines::when_all(std::move(reads));
+    for (std::size_t i = 0; i < blocks.size(); ++i)
+    {
+        auto rc = results[i].return_value();
+        if (rc < 0)
+        {
+            throw make_system_error(static_cast<int>(-rc), "read", m_path);
+        }
+        blocks[i].bytes = rc;
+        if (blocks[i].bytes < m_options.chunk_size)
+        {
+            blocks.resize(i + 1);
+            break;
+        }
+    }
+    co_return blocks;
+}
+
+coroutines::Task<bool> FileReader::emit_blocks(std::vector<Block> blocks, coroutines::RingBuffer<FileChunk>& output)
+{
+    for (auto& block : blocks)
+    {
+        const std::span<const std::byte> bytes(block.storage.get(), block.bytes);
+        const std::shared_ptr<const std::byte> storage = std::move(block.storage);
+
+        if (m_options.format == RecordFormat::blob)
+        {
+            if (!bytes.empty() &&
+                co_await output.write(FileChunk(storage, bytes, block.offset)) != RingBufferOpStatus::Success)
+            {
+                co_return false;
+            }
+            continue;
+        }
+
+        auto first = first_boundary(bytes, block.offset);
+        if (first == std::string_view::npos)
+        {
+            // the block lies within a single record
+            m_carry.insert(m_carry.end(), bytes.begin(), bytes.end());
+            continue;
+        }
+
+        // the only copy: a record straddling the previous reads and this one
+        std::size_t begin = 0;
+        if (!m_carry.empty())
+        {
+            m_carry.insert(m_carry.end(), bytes.begin(), bytes.begin() + first);
+            if (co_await output.write(take_carry()) != RingBufferOpStatus::Success)
+            {
+                co_return false;
+            }
+            begin = first;
+        }
+
+        auto last = last_boundary(bytes, block.offset);
+        if (last > begin &&
+            co_await output.write(FileChunk(storage, bytes.subspan(begin, last - begin), block.offset + begin)) !=
+                RingBufferOpStatus::Success)
+        {
+            co_return false;
+        }
+
+        m_carry.assign(bytes.begin() + last, bytes.end());
+        m_carry_offset = block.offset + last;
+    }
+    co_return true;
+}
+
+FileChunk FileReader::take_carry()
+{
+    const auto bytes = m_carry.size();
+    auto storage     = share_bytes(std::move(m_carry));
+    m_carry.clear();
+    return {storage, {storage.get(), bytes}, m_carry_offset};
+}
+
+std::size_t FileReader::first_boundary(std::span<const std::byte> bytes, std::uint64_t offset) const
+{
+    if (m_options.format == RecordFormat::fixed)
+    {
+        const auto size  = m_options.record_size;
+        const auto first = (size - offset % size) % size;
+        return first <= bytes.size() ? first : std::string_view::npos;
+    }
+
+    auto found = std::find(bytes.begin(), bytes.end(), std::byte{'\n'});
+    return found == bytes.end() ? std::string_view::npos : (found - bytes.begin()) + 1;
+}
+
+std::size_t FileReader::last_boundary(std::span<const std::byte> bytes, std::uint64_t offset) const
+{
+    if (m_options.format == RecordFormat::fixed)
+    {
+        const auto size  = m_options.record_size;
+        const auto first = (size - offset % size) % size;
+        return first + (bytes.size() - first) / size * size;
+    }
+
+    auto found = std::find(bytes.rbegin(), bytes.rend(), std::byte{'\n'});
+    return bytes.size() - (found - bytes.rbegin());
+}
+
+class FileWriter::AlignedBuffer
+{
+  public:
+    explicit AlignedBuffer(std::size_t bytes) :
+      m_data(static_cast<std::byte*>(std::aligned_alloc(DirectIoAlignment, align_up(bytes, DirectIoAlignment))))
+    {
+        CHECK(m_data != nullptr) << "failed to allocate a staging buffer of " << bytes << " bytes";
+    }
+
+    ~AlignedBuffer()
+    {
+        std::free(m_data);
+    }
+
+    AlignedBuffer(const AlignedBuffer&)            = delete;
+    AlignedBuffer& operator=(const AlignedBuffer&) = delete;
+
+    std::byte* data() const
+    {
+        return m_data;
+    }
+
+  private:
+    std::byte* m_data;
+};
+
+FileWriter::FileWriter(std::string path,
+                       FileWriterOptions options,
+                       std::shared_ptr<coroutines::IoScheduler> scheduler) :
+  m_path(std::move(path)),
+  m_options(options),
+  m_scheduler(std::move(scheduler))
+{
+    CHECK(m_scheduler) << "a file writer requires an io scheduler";
+    CHECK_GT(m_options.chunk_size, 0);
+
+    const int flags = O_WRONLY | O_CREAT | O_CLOEXEC | (m_options.append ? 0 : O_TRUNC);
+    std::tie(m_fd, m_direct_io) = open_file(m_path, flags, m_options.direct_io);
+    m_offset                    = m_options.append ? stat_size(m_fd, m_path) : 0;
+
+    // direct i/o writes aligned chunks at aligned offsets; an unaligned end of an appended file is written buffered
+    if (m_direct_io)
+    {
+        m_options.chunk_size = align_up(m_options.chunk_size, DirectIoAlignment);
+        if (m_offset % DirectIoAlignment != 0)
+        {
+            clear_direct_io();
+        }
+    }
+    m_staging = std::make_unique<AlignedBuffer>(m_options.chunk_size);
+}
+
+FileWriter::~FileWriter()
+{
+    if (m_fd < 0)
+    {
+        return;
+    }
+
+    // close was not awaited; the staged tail is written synchronously
+    if (m_direct_io)
+    {
+        ::fcntl(m_fd, F_SETFL, ::fcntl(m_fd, F_GETFL) & ~O_DIRECT);
+    }
+    std::size_t written = 0;
+    while (written < m_staged)
+    {
+        auto rc = ::pwrite(m_fd, m_staging->data() + written, m_staged - written, m_offset + written);
+        if (rc < 0)
+        {
+            LOG(ERROR) << "failed to write the staged bytes of " << m_path << ": " << std::strerror(errno);
+            break;
+        }
+        written += rc;
+    }
+    ::close(m_fd);
+}
+
+const std::string& FileWriter::path() const
+{
+    return m_path;
+}
+
+bool FileWriter::direct_io() const
+{
+    return m_direct_io;
+}
+
+std::uint64_t FileWriter::bytes_written() const
+{
+    return m_offset + m_staged;
+}
+
+coroutines::Task<void> FileWriter::write(std::span<const std::byte> bytes)
+{
+    CHECK_GE(m_fd, 0) << "write to closed file " << m_path;
+
+    while (!bytes.empty())
+    {
+        // whole chunks are written from the caller's bytes when nothing is staged
+        if (m_staged == 0 && !m_direct_io && bytes.size() >= m_options.chunk_size)
+        {
+            auto direct = bytes.size() / m_options.chunk_size * m_options.chunk_size;
+            co_await write_at(bytes.first(direct));
+            bytes = bytes.subspan(direct);
+            continue;
+        }
+
+        auto count = std::min(bytes.size(), m_options.chunk_size - m_staged);
+        std::memcpy(m_staging->data() + m_staged, bytes.data(), count);
+        m_staged += count;
+        bytes = bytes.subspan(count);
+
+        if (m_staged == m_options.chunk_size)
+        {
+            co_await write_at({m_staging->data(), m_staged});
+            m_staged = 0;
+        }
+    }
+}
+
+coroutines::Task<void> FileWriter::close()
+{
+    if (m_fd < 0)
+    {
+        co_return;
+    }
+
+    if (m_staged > 0)
+    {
+        // the tail is not a whole number of aligned blocks
+        if (m_direct_io && m_staged % DirectIoAlignment != 0)
+        {
+            clear_direct_io();
+        }
+        co_await write_at({m_staging->data(), m_staged});
+        m_staged = 0;
+    }
+
+    ::close(m_fd);
+    m_fd = -1;
+}
+
+coroutines::Task<void> FileWriter::write_at(std::span<const std::byte> bytes)
+{
+    while (!bytes.empty())
+    {
+        auto rc = co_await m_scheduler->write(m_fd, bytes, static_cast<std::int64_t>(m_offset));
+        if (rc < 0)
+        {
+            throw make_system_error(static_cast<int>(-rc), "write", m_path);
+        }
+        m_offset += rc;
+        bytes = bytes.subspan(rc);
+    }
+}
+
+void FileWriter::clear_direct_io()
+{
+    if (!m_direct_io)
+    {
+        return;
+    }
+    auto flags = ::fcntl(m_fd, F_GETFL);
+    if (flags < 0 || ::fcntl(m_fd, F_SETFL, flags & ~O_DIRECT) < 0)
+    {
+        throw make_system_error(errno, "fcntl", m_path);
+    }
+    m_direct_io = false;
+}
+
+}  // namespace mrc::io
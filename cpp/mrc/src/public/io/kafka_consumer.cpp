@@ -0,0 +1,200 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "mrc/io/kafka_consumer.hpp"
+
+#include "mrc/exceptions/runtime_error.hpp"
+
+#include <glog/logging.h>
+
+#ifdef MRC_HAS_RDKAFKA
+    #include <librdkafka/rdkafka.h>
+#endif
+
+#include <cstddef>
+#include <span>
+#include <string>
+#include <utility>
+
+namespace mrc::io {
+
+#ifdef MRC_HAS_RDKAFKA
+
+struct KafkaConsumer::Handle
+{
+    rd_kafka_t* consumer{nullptr};
+    rd_kafka_queue_t* queue{nullptr};
+};
+
+namespace {
+
+// messages are destroyed by the last copy of the StreamMessages viewing them
+std::shared_ptr<const void> own_message(rd_kafka_message_t* message)
+{
+    return {message, [](const void* ptr) {
+                rd_kafka_message_destroy(static_cast<rd_kafka_message_t*>(const_cast<void*>(ptr)));
+            }};
+}
+
+std::span<const std::byte> as_span(const void* data, std::size_t bytes)
+{
+    return {static_cast<const std::byte*>(data), data == nullptr ? 0 : bytes};
+}
+
+}  // namespace
+
+KafkaConsumer::KafkaConsumer(KafkaConsumerOptions options) : m_handle(std::make_unique<Handle>())
+{
+    CHECK(!options.topics.empty()) << "a kafka consumer requires a topic";
+
+    // offsets are committed on the acknowledgement of checkpoints only
+    options.config["enable.auto.commit"] = "false";
+
+    char errstr[512];
+    auto* conf = rd_kafka_conf_new();
+    for (const auto& [name, value] : options.config)
+    {
+        if (rd_kafka_conf_set(conf, name.c_str(), value.c_str(), errstr, sizeof(errstr)) != RD_KAFKA_CONF_OK)
+        {
+            rd_kafka_conf_destroy(conf);
+            throw exceptions::MrcRuntimeError("kafka configuration " + name + ": " + errstr);
+        }
+    }
+
+    // rd_kafka_new takes ownership of conf on success only
+    m_handle->consumer = rd_kafka_new(RD_KAFKA_CONSUMER, conf, errstr, sizeof(errstr));
+    if (m_handle->consumer == nullptr)
+    {
+        rd_kafka_conf_destroy(conf);
+        throw exceptions::MrcRuntimeError(std::string("rd_kafka_new: ") + errstr);
+    }
+    rd_kafka_poll_set_consumer(m_handle->consumer);
+    m_handle->queue = rd_kafka_queue_get_consumer(m_handle->consumer);
+
+    auto* topics = rd_kafka_topic_partition_list_new(static_cast<int>(options.topics.size()));
+    for (const auto& topic : options.topics)
+    {
+        rd_kafka_topic_partition_list_add(topics, topic.c_str(), RD_KAFKA_PARTITION_UA);
+    }
+    auto err = rd_kafka_subscribe(m_handle->consumer, topics);
+    rd_kafka_topic_partition_list_destroy(topics);
+    if (err != RD_KAFKA_RESP_ERR_NO_ERROR)
+    {
+        rd_kafka_queue_destroy(m_handle->queue);
+        rd_kafka_destroy(m_handle->consumer);
+        throw exceptions::MrcRuntimeError(std::string("rd_kafka_subscribe: ") + rd_kafka_err2str(err));
+    }
+}
+
+KafkaConsumer::~KafkaConsumer()
+{
+    rd_kafka_queue_destroy(m_handle->queue);
+    rd_kafka_consumer_close(m_handle->consumer);
+    rd_kafka_destroy(m_handle->consumer);
+}
+
+std::optional<std::vector<StreamMessage>> KafkaConsumer::poll(std::size_t max_messages,
+                                                              std::chrono::milliseconds timeout)
+{
+    std::vector<rd_kafka_message_t*> received(max_messages);
+    auto count = rd_kafka_consume_batch_queue(
+        m_handle->queue, static_cast<int>(timeout.count()), received.data(), received.size());
+    if (count < 0)
+    {
+        throw exceptions::MrcRuntimeError(std::string("rd_kafka_consume_batch_queue: ") +
+                                          rd_kafka_err2str(rd_kafka_last_error()));
+    }
+
+    std::vector<StreamMessage> messages;
+    messages.reserve(count);
+    for (std::size_t i = 0; i < static_cast<std::size_t>(count); ++i)
+    {
+        auto owner = own_message(received[i]);
+        auto* msg  = received[i];
+        if (msg->err == RD_KAFKA_RESP_ERR__FATAL)
+        {
+            for (std::size_t j = i + 1; j < static_cast<std::size_t>(count); ++j)
+            {
+                rd_kafka_message_destroy(received[j]);
+            }
+            throw exceptions::MrcRuntimeError(std::string("kafka consume: ") + rd_kafka_message_errstr(msg));
+        }
+
+        // other consumer errors, e.g. broker transport errors, are retried by librdkafka
+        if (msg->err != RD_KAFKA_RESP_ERR_NO_ERROR)
+        {
+            if (msg->err != RD_KAFKA_RESP_ERR__PARTITION_EOF)
+            {
+                LOG(WARNING) << "kafka consume: " << rd_kafka_message_errstr(msg);
+            }
+            continue;
+        }
+
+        messages.emplace_back(std::move(owner),
+                              StreamPartition{rd_kafka_topic_name(msg->rkt), msg->partition},
+                              msg->offset,
+                              as_span(msg->key, msg->key_len),
+                              as_span(msg->payload, msg->len));
+    }
+    return messages;
+}
+
+void KafkaConsumer::commit(const StreamOffsets& offsets)
+{
+    if (offsets.empty())
+    {
+        return;
+    }
+
+    auto* list = rd_kafka_topic_partition_list_new(static_cast<int>(offsets.size()));
+    for (const auto& [partition, offset] : offsets)
+    {
+        rd_kafka_topic_partition_list_add(list, partition.topic.c_str(), partition.partition)->offset = offset;
+    }
+
+    // a failed commit, e.g. of partitions revoked by a rebalance, is superseded by the next one
+    auto err = rd_kafka_commit(m_handle->consumer, list, 0);
+    rd_kafka_topic_partition_list_destroy(list);
+    if (err != RD_KAFKA_RESP_ERR_NO_ERROR)
+    {
+        LOG(WARNING) << "kafka offset commit failed: " << rd_kafka_err2str(err);
+    }
+}
+
+#else
+
+struct KafkaConsumer::Handle
+{};
+
+KafkaConsumer::KafkaConsumer(KafkaConsumerOptions /*options*/)
+{
+    throw exceptions::MrcRuntimeError("kafka consumers require libmrc to be built with MRC_BUILD_KAFKA");
+}
+
+KafkaConsumer::~KafkaConsumer() = default;
+
+std::optional<std::vector<StreamMessage>> KafkaConsumer::poll(std::size_t /*max_messages*/,
+                                                              std::chrono::milliseconds /*timeout*/)
+{
+    return std::nullopt;
+}
+
+void KafkaConsumer::commit(const StreamOffsets& /*offsets*/) {}
+
+#endif
+
+}  // namespace mrc::io
@@ -0,0 +1,244 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "mrc/io/mapped_file.hpp"
+
+#include "mrc/exceptions/runtime_error.hpp"
+#include "mrc/memory/memory_kind.hpp"
+
+#include <fcntl.h>
+#include <glog/logging.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <system_error>
+
+namespace mrc::io {
+
+namespace {
+
+std::system_error make_system_error(int err, const std::string& what, const std::string& path)
+{
+    return std::system_error(err, std::generic_category(), what + " " + path);
+}
+
+std::size_t page_size()
+{
+    static const auto size = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+    return size;
+}
+
+}  // namespace
+
+std::shared_ptr<const MappedFile> MappedFile::open(const std::string& path)
+{
+    int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0)
+    {
+        throw make_system_error(errno, "open", path);
+    }
+
+    struct stat st
+    {};
+    if (::fstat(fd, &st) != 0)
+    {
+        auto err = errno;
+        ::close(fd);
+        throw make_system_error(err, "fstat", path);
+    }
+
+    // a mapping of zero bytes is invalid; empty files are described without one
+    const auto size = static_cast<std::size_t>(st.st_size);
+    void* data      = nullptr;
+    if (size > 0)
+    {
+        data = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (data == MAP_FAILED)
+        {
+            auto err = errno;
+            ::close(fd);
+            throw make_system_error(err, "mmap", path);
+        }
+        if (::madvise(data, size, MADV_SEQUENTIAL) != 0)
+        {
+            VLOG(1) << "madvise(MADV_SEQUENTIAL) failed for " << path << ": " << std::strerror(errno);
+        }
+    }
+
+    return std::shared_ptr<const MappedFile>(new MappedFile(path, fd, size, data));
+}
+
+MappedFile::MappedFile(std::string path, int fd, std::size_t size, void* data) :
+  m_path(std::move(path)),
+  m_fd(fd),
+  m_size(size),
+  m_data(data)
+{}
+
+MappedFile::~MappedFile()
+{
+    if (m_data != nullptr)
+    {
+        ::munmap(m_data, m_size);
+    }
+    ::close(m_fd);
+}
+
+const std::string& MappedFile::path() const
+{
+    return m_path;
+}
+
+const std::byte* MappedFile::data() const
+{
+    return static_cast<const std::byte*>(m_data);
+}
+
+std::size_t MappedFile::size() const
+{
+    return m_size;
+}
+
+std::pair<std::size_t, std::size_t> MappedFile::partition(const MappedFileOptions& options,
+                                                          std::size_t index,
+                                                          std::size_t count) const
+{
+    CHECK_GT(count, 0);
+    CHECK_LT(index, count);
+
+    if (options.format == RecordFormat::fixed)
+    {
+        CHECK_GT(options.record_size, 0) << "fixed record files require a record_size";
+        if (m_size % options.record_size != 0)
+        {
+            throw exceptions::MrcRuntimeError(m_path + " ends with a partial record of " +
+                                              std::to_string(m_size % options.record_size) + " bytes");
+        }
+    }
+
+    // the products of at most 64-bit sizes and partition counts do not overflow in 128 bits
+    auto split = [this, count](std::size_t i) {
+        return static_cast<std::size_t>(static_cast<unsigned __int128>(m_size) * i / count);
+    };
+
+    return {record_boundary(options, split(index)), record_boundary(options, split(index + 1))};
+}
+
+std::size_t MappedFile::chunk_end(const MappedFileOptions& options, std::size_t begin, std::size_t end) const
+{
+    CHECK_LE(begin, end);
+    CHECK_LE(end, m_size);
+    const auto chunk_size = std::max<std::size_t>(options.chunk_size, 1);
+
+    if (end - begin <= chunk_size)
+    {
+        return end;
+    }
+
+    switch (options.format)
+    {
+    case RecordFormat::lines: {
+        const std::string_view bytes(reinterpret_cast<const char*>(data()), end);
+
+        // the last record ending within the target, else the record overrunning it
+        auto last = bytes.substr(begin, chunk_size).rfind('\n');
+        if (last != std::string_view::npos)
+        {
+            return begin + last + 1;
+        }
+        auto next = bytes.find('\n', begin + chunk_size);
+        return next == std::string_view::npos ? end : next + 1;
+    }
+    case RecordFormat::fixed: {
+        const auto records = std::max<std::size_t>(chunk_size / options.record_size, 1);
+        return std::min(end, begin + records * options.record_size);
+    }
+    case RecordFormat::blob:
+        return begin + chunk_size;
+    }
+
+    return end;
+}
+
+void MappedFile::will_need(std::size_t offset, std::size_t bytes) const
+{
+    if (m_data == nullptr || offset >= m_size)
+    {
+        return;
+    }
+
+    // madvise requires a page aligned address
+    const auto aligned = offset / page_size() * page_size();
+    const auto length  = std::min(m_size, offset + bytes) - aligned;
+    if (::madvise(static_cast<std::byte*>(m_data) + aligned, length, MADV_WILLNEED) != 0)
+    {
+        VLOG(10) << "madvise(MADV_WILLNEED) failed for " << m_path << ": " << std::strerror(errno);
+    }
+}
+
+std::size_t MappedFile::record_boundary(const MappedFileOptions& options, std::size_t offset) const
+{
+    if (offset == 0 || offset >= m_size)
+    {
+        return std::min(offset, m_size);
+    }
+
+    switch (options.format)
+    {
+    case RecordFormat::lines: {
+        // a record starts after each '\n'; the one ending at offset - 1 makes offset a boundary itself
+        const std::string_view bytes(reinterpret_cast<const char*>(data()), m_size);
+        auto pos = bytes.find('\n', offset - 1);
+        return pos == std::string_view::npos ? m_size : pos + 1;
+    }
+    case RecordFormat::fixed:
+        return std::min(m_size, (offset + options.record_size - 1) / options.record_size * options.record_size);
+    case RecordFormat::blob:
+        return offset;
+    }
+
+    return offset;
+}
+
+MappedView::MappedView(std::shared_ptr<const MappedFile> file, std::size_t offset, std::size_t bytes) :
+  memory::const_buffer_view(file->data() + offset, bytes, memory::memory_kind::host),
+  m_file(std::move(file)),
+  m_offset(offset)
+{
+    CHECK_LE(offset + bytes, m_file->size());
+}
+
+std::uint64_t MappedView::offset() const
+{
+    return m_offset;
+}
+
+std::string_view MappedView::view() const
+{
+    return {static_cast<const char*>(data()), bytes()};
+}
+
+const std::shared_ptr<const MappedFile>& MappedView::file() const
+{
+    return m_file;
+}
+
+}  // namespace mrc::io
@@ -0,0 +1,125 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "mrc/io/stream_consumer.hpp"
+
+#include "mrc/exceptions/runtime_error.hpp"
+#include "mrc/memory/memory_kind.hpp"
+
+#include <glog/logging.h>
+
+#include <charconv>
+#include <system_error>
+#include <utility>
+
+namespace mrc::io {
+
+namespace {
+
+template <typename T>
+T parse_number(std::string_view field, std::string_view token)
+{
+    T value{};
+    auto [end, ec] = std::from_chars(field.data(), field.data() + field.size(), value);
+    if (ec != std::errc() || end != field.data() + field.size())
+    {
+        throw exceptions::MrcRuntimeError("malformed stream offsets: " + std::string(token));
+    }
+    return value;
+}
+
+}  // namespace
+
+std::string encode_offsets(const StreamOffsets& offsets)
+{
+    std::string token;
+    for (const auto& [partition, offset] : offsets)
+    {
+        CHECK(partition.topic.find_first_of("\t\n") == std::string::npos)
+            << "stream topics may not contain tabs or newlines";
+        token += partition.topic + '\t' + std::to_string(partition.partition) + '\t' + std::to_string(offset) + '\n';
+    }
+    return token;
+}
+
+StreamOffsets decode_offsets(std::string_view token)
+{
+    StreamOffsets offsets;
+    auto lines = token;
+    while (!lines.empty())
+    {
+        auto end  = lines.find('\n');
+        auto line = lines.substr(0, end);
+        lines.remove_prefix(end == std::string_view::npos ? lines.size() : end + 1);
+
+        auto first = line.find('\t');
+        auto last  = line.rfind('\t');
+        if (first == std::string_view::npos || first == last)
+        {
+            throw exceptions::MrcRuntimeError("malformed stream offsets: " + std::string(token));
+        }
+
+        StreamPartition partition{std::string(line.substr(0, first)),
+                                  parse_number<std::int32_t>(line.substr(first + 1, last - first - 1), token)};
+        offsets[std::move(partition)] = parse_number<std::int64_t>(line.substr(last + 1), token);
+    }
+    return offsets;
+}
+
+StreamMessage::StreamMessage(std::shared_ptr<const void> owner,
+                             StreamPartition partition,
+                             std::int64_t offset,
+                             std::span<const std::byte> key,
+                             std::span<const std::byte> payload) :
+  m_owner(std::move(owner)),
+  m_partition(std::move(partition)),
+  m_offset(offset),
+  m_key(key),
+  m_payload(payload)
+{}
+
+const StreamPartition& StreamMessage::partition() const
+{
+    return m_partition;
+}
+
+std::int64_t StreamMessage::offset() const
+{
+    return m_offset;
+}
+
+std::span<const std::byte> StreamMessage::key() const
+{
+    return m_key;
+}
+
+std::span<const std::byte> StreamMessage::payload() const
+{
+    return m_payload;
+}
+
+std::string_view StreamMessage::view() const
+{
+    return {reinterpret_cast<const char*>(m_payload.data()), m_payload.size()};
+}
+
+memory::const_buffer_view StreamMessage::payload_view() const
+{
+    return {m_payload.data(), m_payload.size(), memory::memory_kind::host};
+}
+
+}  // namespace mrc::io
@@ -64,4 +64,17 @@ void Manifold::add_output(const SegmentAddress& address, node::SinkPropertiesBas
               << segment::info(address);
 }
 
+void Manifold::drop_output(const SegmentAddress& address)
+{
+    DVLOG(3) << "manifold " << this->port_name() << ": dropping downstream segment " << segment::info(address);
+    do_drop_output(address);
+}
+
+void Manifold::set_output_local(const SegmentAddress& address, bool local)
+{
+    DVLOG(10) << "manifold " << this->port_name() << ": downstream segment " << segment::info(address) << " is "
+              << (local ? "local" : "remote");
+    do_set_output_local(address, local);
+}
+
 }  // namespace mrc::manifold
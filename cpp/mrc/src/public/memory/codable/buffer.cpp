@@ -22,7 +22,6 @@
 
 #include <glog/logging.h>
 
-#include <optional>
 #include <typeindex>
 #include <utility>
 
@@ -32,11 +31,15 @@ void codable_protocol<mrc::memory::buffer>::serialize(const memory::buffer& obj,
                                                       Encoder<memory::buffer>& encoded,
                                                       const EncodingOptions& opts)
 {
-    auto idx = encoded.register_memory_view(obj);
-    if (!idx)
+    if (opts.force_copy())
     {
-        encoded.copy_to_eager_descriptor(obj);
+        auto idx = encoded.create_memory_buffer(obj.bytes());
+        encoded.copy_to_buffer(idx, obj);
+        return;
     }
+
+    // the buffer is described in place if it is registered, or large enough to be registered on demand
+    encoded.add_memory_view(obj, opts);
 }
 
 memory::buffer codable_protocol<mrc::memory::buffer>::deserialize(const Decoder<memory::buffer>& encoded,
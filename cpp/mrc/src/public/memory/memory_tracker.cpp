@@ -0,0 +1,281 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2021-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "mrc/memory/memory_tracker.hpp"
+
+#include "mrc/metrics/counter.hpp"
+#include "mrc/metrics/gauge.hpp"
+#include "mrc/metrics/registry.hpp"
+#include "mrc/runnable/context.hpp"
+
+#include <boost/fiber/fss.hpp>
+#include <glog/logging.h>
+
+#include <array>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <tuple>
+#include <unordered_map>
+
+namespace mrc::memory {
+
+namespace {
+
+constexpr std::size_t OwnerShards = 64;
+
+constexpr std::size_t MemoryKinds = static_cast<std::size_t>(memory_kind::managed) + 1;
+
+// owners of the live allocations whose address hashes to the shard
+struct alignas(64) OwnerShard
+{
+    std::mutex mutex;
+    std::unordered_map<void*, MemoryTracker::Account*> owners;
+};
+
+struct TrackerState
+{
+    std::mutex mutex;
+    std::map<std::tuple<std::string, memory_kind>, std::unique_ptr<MemoryTracker::Account>> accounts;
+    std::map<std::string, std::unique_ptr<MemoryTracker::SegmentQuota>> quotas;
+    std::array<OwnerShard, OwnerShards> shards;
+};
+
+// accounts of the runnable executing on a fiber, resolved on the first allocation of each memory_kind
+struct FiberAccounts
+{
+    const runnable::Context* context{nullptr};
+    std::array<MemoryTracker::Account*, MemoryKinds> accounts{};
+};
+
+TrackerState& state()
+{
+    // never destroyed, memory may be released by static destructors running after this translation unit's
+    static auto* s_state = new TrackerState();
+    return *s_state;
+}
+
+OwnerShard& shard_for(void* ptr)
+{
+    return state().shards[std::hash<void*>{}(ptr) % OwnerShards];
+}
+
+// requires the state mutex
+MemoryTracker::SegmentQuota& lookup_quota(TrackerState& s, const std::string& segment)
+{
+    auto& quota = s.quotas[segment];
+    if (!quota)
+    {
+        quota = std::make_unique<MemoryTracker::SegmentQuota>();
+    }
+    return *quota;
+}
+
+MemoryTracker::Account& lookup_account(const std::string& name, memory_kind kind)
+{
+    auto& s = state();
+    std::lock_guard<std::mutex> lock(s.mutex);
+
+    auto& account = s.accounts[std::make_tuple(name, kind)];
+    if (!account)
+    {
+        // names of segment nodes are "segment/node"
+        auto pos = name.find('/');
+        if (pos == std::string::npos)
+        {
+            account = std::make_unique<MemoryTracker::Account>("", name, kind);
+        }
+        else
+        {
+            account = std::make_unique<MemoryTracker::Account>(name.substr(0, pos), name.substr(pos + 1), kind);
+            account->quota = &lookup_quota(s, account->segment);
+        }
+    }
+    return *account;
+}
+
+MemoryTracker::Account& current_account(memory_kind kind)
+{
+    static boost::fibers::fiber_specific_ptr<FiberAccounts> s_fiber_accounts;
+
+    const runnable::Context* context =
+        (runnable::Context::has_runtime_context() ? &runnable::Context::get_runtime_context() : nullptr);
+
+    auto* cache = s_fiber_accounts.get();
+    if (cache == nullptr)
+    {
+        cache = new FiberAccounts();
+        s_fiber_accounts.reset(cache);
+    }
+    if (cache->context != context)
+    {
+        *cache         = FiberAccounts();
+        cache->context = context;
+    }
+
+    auto& account = cache->accounts[static_cast<std::size_t>(kind)];
+    if (account == nullptr)
+    {
+        static const std::string unnamed;
+        account = &lookup_account(context == nullptr ? unnamed : context->name(), kind);
+    }
+    return *account;
+}
+
+std::map<std::string, std::string> labels(const MemoryTracker::Account& account)
+{
+    return {{"segment", account.segment}, {"node", account.node}, {"kind", kind_string(account.kind)}};
+}
+
+}  // namespace
+
+void MemoryTracker::reserve(std::size_t bytes, memory_kind kind)
+{
+    auto* quota = current_account(kind).quota;
+    if (quota == nullptr)
+    {
+        return;
+    }
+
+    const auto delta = static_cast<std::int64_t>(bytes);
+    const auto live  = quota->live_bytes.fetch_add(delta, std::memory_order_relaxed) + delta;
+    const auto limit = quota->limit_bytes.load(std::memory_order_relaxed);
+    if (limit > 0 && live > limit)
+    {
+        quota->live_bytes.fetch_sub(delta, std::memory_order_relaxed);
+        throw std::bad_alloc();
+    }
+}
+
+void MemoryTracker::cancel_reservation(std::size_t bytes, memory_kind kind)
+{
+    auto* quota = current_account(kind).quota;
+    if (quota != nullptr)
+    {
+        quota->live_bytes.fetch_sub(static_cast<std::int64_t>(bytes), std::memory_order_relaxed);
+    }
+}
+
+void MemoryTracker::set_segment_quota(const std::string& segment, std::size_t bytes)
+{
+    auto& s = state();
+    std::lock_guard<std::mutex> lock(s.mutex);
+    lookup_quota(s, segment).limit_bytes.store(static_cast<std::int64_t>(bytes), std::memory_order_relaxed);
+}
+
+void MemoryTracker::on_allocate(void* ptr, std::size_t bytes, memory_kind kind)
+{
+    if (ptr == nullptr)
+    {
+        return;
+    }
+
+    auto& account = current_account(kind);
+    {
+        auto& shard = shard_for(ptr);
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        shard.owners[ptr] = &account;
+    }
+
+    account.allocations.fetch_add(1, std::memory_order_relaxed);
+    account.allocated_bytes.fetch_add(bytes, std::memory_order_relaxed);
+
+    const auto delta = static_cast<std::int64_t>(bytes);
+    const auto live  = account.live_bytes.fetch_add(delta, std::memory_order_relaxed) + delta;
+    auto peak       = account.peak_bytes.load(std::memory_order_relaxed);
+    while (peak < live && !account.peak_bytes.compare_exchange_weak(peak, live, std::memory_order_relaxed)) {}
+}
+
+void MemoryTracker::on_deallocate(void* ptr, std::size_t bytes)
+{
+    Account* account = nullptr;
+    {
+        auto& shard = shard_for(ptr);
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        auto it = shard.owners.find(ptr);
+        if (it == shard.owners.end())
+        {
+            return;
+        }
+        account = it->second;
+        shard.owners.erase(it);
+    }
+    account->live_bytes.fetch_sub(static_cast<std::int64_t>(bytes), std::memory_order_relaxed);
+    if (account->quota != nullptr)
+    {
+        account->quota->live_bytes.fetch_sub(static_cast<std::int64_t>(bytes), std::memory_order_relaxed);
+    }
+}
+
+std::vector<MemoryUsage> MemoryTracker::collect()
+{
+    auto& s = state();
+    std::lock_guard<std::mutex> lock(s.mutex);
+
+    std::vector<MemoryUsage> results;
+    for (const auto& [key, account] : s.accounts)
+    {
+        auto& usage           = results.emplace_back();
+        usage.segment         = account->segment;
+        usage.node            = account->node;
+        usage.kind            = account->kind;
+        usage.live_bytes      = account->live_bytes.load(std::memory_order_relaxed);
+        usage.peak_bytes      = account->peak_bytes.load(std::memory_order_relaxed);
+        usage.allocations     = account->allocations.load(std::memory_order_relaxed);
+        usage.allocated_bytes = account->allocated_bytes.load(std::memory_order_relaxed);
+    }
+    return results;
+}
+
+void MemoryTracker::export_metrics(metrics::Registry& registry)
+{
+    auto& s = state();
+    std::lock_guard<std::mutex> lock(s.mutex);
+
+    for (auto& [key, account] : s.accounts)
+    {
+        auto allocations     = account->allocations.load(std::memory_order_relaxed);
+        auto allocated_bytes = account->allocated_bytes.load(std::memory_order_relaxed);
+
+        registry.make_gauge("mrc_memory_live_bytes", labels(*account))
+            .set(account->live_bytes.load(std::memory_order_relaxed));
+        registry.make_gauge("mrc_memory_peak_bytes", labels(*account))
+            .set(account->peak_bytes.load(std::memory_order_relaxed));
+        registry.make_counter("mrc_memory_allocations", labels(*account))
+            .increment(allocations - account->exported_allocations);
+        registry.make_counter("mrc_memory_allocated_bytes", labels(*account))
+            .increment(allocated_bytes - account->exported_allocated_bytes);
+
+        account->exported_allocations     = allocations;
+        account->exported_allocated_bytes = allocated_bytes;
+    }
+}
+
+void MemoryTracker::reset_peaks()
+{
+    auto& s = state();
+    std::lock_guard<std::mutex> lock(s.mutex);
+
+    for (auto& [key, account] : s.accounts)
+    {
+        account->peak_bytes.store(account->live_bytes.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    }
+}
+
+}  // namespace mrc::memory
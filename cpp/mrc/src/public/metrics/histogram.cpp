@@ -0,0 +1,249 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2021-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "mrc/metrics/histogram.hpp"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cmath>
+#include <cstddef>
+#include <unordered_map>
+#include <utility>
+
+namespace mrc::metrics {
+
+namespace {
+
+// values below 2^SubBucketBits are counted exactly; above, each power of 2 is split into HalfBucketCount buckets
+constexpr std::size_t SubBucketBits   = 7;
+constexpr std::size_t HalfBucketCount = std::size_t(1) << (SubBucketBits - 1);
+constexpr std::size_t MaxValueBits    = 40;
+constexpr std::uint64_t HighestValue  = (std::uint64_t(1) << MaxValueBits) - 1;
+constexpr std::size_t BucketCount     = (MaxValueBits - SubBucketBits + 2) * HalfBucketCount;
+
+std::size_t bucket_index(std::uint64_t value)
+{
+    const std::size_t msb = std::bit_width(value | 1) - 1;
+    if (msb < SubBucketBits)
+    {
+        return value;
+    }
+    const std::size_t shift = msb - (SubBucketBits - 1);
+    return shift * HalfBucketCount + (value >> shift);
+}
+
+// highest value counted by the bucket at idx
+std::uint64_t bucket_highest_value(std::size_t idx)
+{
+    if (idx < 2 * HalfBucketCount)
+    {
+        return idx;
+    }
+    const std::size_t shift = idx / HalfBucketCount - 1;
+    const std::uint64_t sub = idx - shift * HalfBucketCount;
+    return ((sub + 1) << shift) - 1;
+}
+
+std::atomic<std::uint64_t> s_next_histogram_id{0};
+
+}  // namespace
+
+namespace detail {
+
+// buckets of one thread; only written by the thread holding the slot
+struct HistogramSlot
+{
+    std::array<std::atomic<std::uint64_t>, BucketCount> counts{};
+    std::atomic<std::uint64_t> sum{0};
+    std::atomic<std::uint64_t> max{0};
+    std::atomic<bool> in_use{true};
+    HistogramSlot* next{nullptr};
+};
+
+struct HistogramState
+{
+    HistogramState() : id(s_next_histogram_id.fetch_add(1, std::memory_order_relaxed)) {}
+
+    ~HistogramState()
+    {
+        auto* slot = slots.load();
+        while (slot != nullptr)
+        {
+            delete std::exchange(slot, slot->next);
+        }
+    }
+
+    // slots released by exited threads are adopted, along with their counts, before new slots are allocated
+    HistogramSlot& acquire_slot()
+    {
+        for (auto* slot = slots.load(std::memory_order_acquire); slot != nullptr; slot = slot->next)
+        {
+            bool expected = false;
+            if (!slot->in_use.load(std::memory_order_relaxed) &&
+                slot->in_use.compare_exchange_strong(expected, true, std::memory_order_acquire))
+            {
+                return *slot;
+            }
+        }
+
+        auto* slot = new HistogramSlot;
+        slot->next = slots.load(std::memory_order_relaxed);
+        while (!slots.compare_exchange_weak(slot->next, slot, std::memory_order_release, std::memory_order_relaxed))
+        {}
+        return *slot;
+    }
+
+    // ids are never reused, so a thread never mistakes the slot of a destroyed histogram for the slot of a new one
+    const std::uint64_t id;
+    std::atomic<HistogramSlot*> slots{nullptr};
+};
+
+}  // namespace detail
+
+namespace {
+
+// slots held by the calling thread, released to their histograms when the thread exits
+class ThreadSlots
+{
+  public:
+    ~ThreadSlots()
+    {
+        for (auto& [id, entry] : m_slots)
+        {
+            if (auto state = entry.first.lock())
+            {
+                entry.second->in_use.store(false, std::memory_order_release);
+            }
+        }
+    }
+
+    detail::HistogramSlot& slot(const std::shared_ptr<detail::HistogramState>& state)
+    {
+        if (m_last_id == state->id)
+        {
+            return *m_last_slot;
+        }
+
+        auto& entry = m_slots[state->id];
+        if (entry.second == nullptr)
+        {
+            entry.first  = state;
+            entry.second = &state->acquire_slot();
+        }
+        m_last_id   = state->id;
+        m_last_slot = entry.second;
+        return *entry.second;
+    }
+
+  private:
+    std::unordered_map<std::uint64_t, std::pair<std::weak_ptr<detail::HistogramState>, detail::HistogramSlot*>>
+        m_slots;
+    std::uint64_t m_last_id{~std::uint64_t(0)};
+    detail::HistogramSlot* m_last_slot{nullptr};
+};
+
+// slots are single writer, so updates do not need a read-modify-write
+void add(std::atomic<std::uint64_t>& counter, std::uint64_t value)
+{
+    counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+}
+
+}  // namespace
+
+std::uint64_t HistogramSnapshot::count() const
+{
+    return m_count;
+}
+
+std::uint64_t HistogramSnapshot::sum() const
+{
+    return m_sum;
+}
+
+std::uint64_t HistogramSnapshot::max() const
+{
+    return m_max;
+}
+
+double HistogramSnapshot::mean() const
+{
+    return (m_count == 0 ? 0.0 : static_cast<double>(m_sum) / m_count);
+}
+
+std::uint64_t HistogramSnapshot::value_at_quantile(double q) const
+{
+    if (m_count == 0)
+    {
+        return 0;
+    }
+
+    auto target = std::max<std::uint64_t>(1, static_cast<std::uint64_t>(std::ceil(std::clamp(q, 0.0, 1.0) * m_count)));
+
+    std::uint64_t cumulative = 0;
+    for (std::size_t idx = 0; idx < m_counts.size(); idx++)
+    {
+        cumulative += m_counts[idx];
+        if (cumulative >= target)
+        {
+            return std::min(bucket_highest_value(idx), m_max);
+        }
+    }
+    return m_max;
+}
+
+Histogram::Histogram() : m_state(std::make_shared<detail::HistogramState>()) {}
+
+void Histogram::record(std::uint64_t value)
+{
+    thread_local ThreadSlots thread_slots;
+    auto& slot = thread_slots.slot(m_state);
+
+    value = std::min(value, HighestValue);
+    add(slot.counts[bucket_index(value)], 1);
+    add(slot.sum, value);
+    if (value > slot.max.load(std::memory_order_relaxed))
+    {
+        slot.max.store(value, std::memory_order_relaxed);
+    }
+}
+
+void Histogram::record(std::chrono::nanoseconds duration)
+{
+    record(static_cast<std::uint64_t>(std::max<std::chrono::nanoseconds::rep>(duration.count(), 0)));
+}
+
+HistogramSnapshot Histogram::snapshot() const
+{
+    HistogramSnapshot snapshot;
+    snapshot.m_counts.resize(BucketCount);
+    for (auto* slot = m_state->slots.load(std::memory_order_acquire); slot != nullptr; slot = slot->next)
+    {
+        for (std::size_t idx = 0; idx < BucketCount; idx++)
+        {
+            auto count = slot->counts[idx].load(std::memory_order_relaxed);
+            snapshot.m_counts[idx] += count;
+            snapshot.m_count += count;
+        }
+        snapshot.m_sum += slot->sum.load(std::memory_order_relaxed);
+        snapshot.m_max = std::max(snapshot.m_max, slot->max.load(std::memory_order_relaxed));
+    }
+    return snapshot;
+}
+
+}  // namespace mrc::metrics
@@ -20,28 +20,60 @@
 #include "prometheus/metric_family.h"
 
 #include "mrc/metrics/counter.hpp"
+#include "mrc/metrics/gauge.hpp"
+#include "mrc/metrics/histogram.hpp"
 
 #include <glog/logging.h>
 #include <prometheus/client_metric.h>
 #include <prometheus/counter.h>
 #include <prometheus/family.h>
+#include <prometheus/gauge.h>
 #include <prometheus/registry.h>
+#include <prometheus/text_serializer.h>
 
 #include <map>
 #include <memory>
+#include <mutex>
+#include <set>
 #include <string>
 #include <utility>
 #include <vector>
 
 namespace mrc::metrics {
 
+namespace {
+
+// live registries served by scrape_all; a registry is only destroyed once no scrape is using it
+std::mutex& live_registries_mutex()
+{
+    static std::mutex mutex;
+    return mutex;
+}
+
+std::set<const Registry*>& live_registries()
+{
+    static std::set<const Registry*> registries;
+    return registries;
+}
+
+}  // namespace
+
 Registry::Registry() :
   m_registry(std::make_shared<prometheus::Registry>()),
   m_throughput_counters(prometheus::BuildCounter()
                             .Name("mrc_throughput_counters")
                             .Help("number of data elements passing thru a given pipeline object")
                             .Register(*m_registry))
-{}
+{
+    std::lock_guard<std::mutex> lock(live_registries_mutex());
+    live_registries().insert(this);
+}
+
+Registry::~Registry()
+{
+    std::lock_guard<std::mutex> lock(live_registries_mutex());
+    live_registries().erase(this);
+}
 
 Counter Registry::make_counter(std::string name, std::map<std::string, std::string> labels)
 {
@@ -50,6 +82,55 @@ Counter Registry::make_counter(std::string name, std::map<std::string, std::stri
     return Counter(&counter);
 }
 
+Gauge Registry::make_gauge(std::string name, std::map<std::string, std::string> labels)
+{
+    auto& family = prometheus::BuildGauge().Name(std::move(name)).Register(*m_registry);
+    auto& gauge  = family.Add(std::move(labels));
+    return Gauge(&gauge);
+}
+
+Histogram Registry::make_histogram(std::string name, std::map<std::string, std::string> labels)
+{
+    auto& family = prometheus::BuildGauge().Name(name).Register(*m_registry);
+
+    std::vector<std::pair<double, Gauge>> quantiles;
+    for (const auto& [quantile, label] : {std::pair{0.5, "0.5"}, std::pair{0.99, "0.99"}, std::pair{0.999, "0.999"}})
+    {
+        auto quantile_labels        = labels;
+        quantile_labels["quantile"] = label;
+        quantiles.emplace_back(quantile, Gauge(&family.Add(std::move(quantile_labels))));
+    }
+    auto count = make_gauge(name + "_count", labels);
+    auto sum   = make_gauge(name + "_sum", labels);
+
+    Histogram histogram;
+    std::lock_guard<std::mutex> lock(m_histograms_mutex);
+    m_histograms.push_back(
+        {std::move(name), std::move(labels), histogram, std::move(quantiles), std::move(count), std::move(sum)});
+    return histogram;
+}
+
+std::vector<HistogramReport> Registry::collect_histograms() const
+{
+    std::vector<HistogramReport> report;
+    std::lock_guard<std::mutex> lock(m_histograms_mutex);
+    for (const auto& registered : m_histograms)
+    {
+        auto snapshot = registered.histogram.snapshot();
+        // gauges are handles to the prometheus metrics, so setting a copy updates the exported value
+        for (auto [quantile, gauge] : registered.quantiles)
+        {
+            gauge.set(static_cast<double>(snapshot.value_at_quantile(quantile)));
+        }
+        auto count = registered.count;
+        auto sum   = registered.sum;
+        count.set(static_cast<double>(snapshot.count()));
+        sum.set(static_cast<double>(snapshot.sum()));
+        report.push_back({registered.name, registered.labels, std::move(snapshot)});
+    }
+    return report;
+}
+
 Counter Registry::make_throughput_counter(std::string name)
 {
     auto& counter = m_throughput_counters.Add({{"name", name}});
@@ -68,4 +149,35 @@ std::vector<CounterReport> Registry::collect_throughput_counters() const
     return report;
 }
 
+std::string Registry::scrape() const
+{
+    collect_histograms();
+    return prometheus::TextSerializer().Serialize(m_registry->Collect());
+}
+
+std::string Registry::scrape_all()
+{
+    // families of the same name are merged since the exposition format allows a single family per name
+    std::vector<prometheus::MetricFamily> families;
+    std::map<std::string, std::size_t> family_index;
+
+    std::lock_guard<std::mutex> lock(live_registries_mutex());
+    for (const auto* registry : live_registries())
+    {
+        registry->collect_histograms();
+        for (auto& family : registry->m_registry->Collect())
+        {
+            auto [it, inserted] = family_index.emplace(family.name, families.size());
+            if (inserted)
+            {
+                families.push_back(std::move(family));
+                continue;
+            }
+            auto& metrics = families[it->second].metric;
+            metrics.insert(metrics.end(), family.metric.begin(), family.metric.end());
+        }
+    }
+    return prometheus::TextSerializer().Serialize(families);
+}
+
 }  // namespace mrc::metrics
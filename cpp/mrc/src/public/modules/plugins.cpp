@@ -26,6 +26,7 @@
 #include <exception>
 #include <memory>
 #include <mutex>
+#include <optional>
 #include <sstream>
 #include <stdexcept>
 #include <string>
@@ -103,16 +104,23 @@ void PluginModule::get_entrypoint(const std::string& entrypoint_name, void** ent
 
 std::vector<std::string> PluginModule::list_modules()
 {
-    const char** module_list;
-    unsigned int module_count = m_plugin_list(&module_list);
+    std::lock_guard<decltype(s_mutex)> lock(s_mutex);
 
-    std::vector<std::string> ret{};
-    for (int i = 0; i < module_count; i++)
+    if (!m_module_names)
     {
-        ret.emplace_back(module_list[i]);
+        const char** module_list;
+        unsigned int module_count = m_plugin_list(&module_list);
+
+        std::vector<std::string> ret{};
+        for (int i = 0; i < module_count; i++)
+        {
+            ret.emplace_back(module_list[i]);
+        }
+
+        m_module_names = std::move(ret);
     }
 
-    return ret;
+    return *m_module_names;
 }
 
 bool PluginModule::load(bool throw_on_error)
@@ -308,6 +316,7 @@ void PluginModule::clear_plugin_interface()
     m_plugin_list   = nullptr;
     m_plugin_load   = nullptr;
     m_plugin_unload = nullptr;
+    m_module_names.reset();
 }
 
 }  // namespace mrc::modules
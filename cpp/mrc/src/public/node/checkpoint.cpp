@@ -0,0 +1,200 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2021-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "mrc/node/checkpoint.hpp"
+
+#include "mrc/exceptions/runtime_error.hpp"
+
+#include <glog/logging.h>
+#include <unistd.h>
+
+#include <cstdio>
+#include <exception>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <utility>
+
+namespace mrc::node {
+
+void MemoryCheckpointStore::save(const std::string& source_name, const Checkpoint& checkpoint)
+{
+    std::lock_guard<decltype(m_mutex)> lock(m_mutex);
+    m_checkpoints[source_name] = checkpoint;
+}
+
+std::optional<Checkpoint> MemoryCheckpointStore::load(const std::string& source_name)
+{
+    std::lock_guard<decltype(m_mutex)> lock(m_mutex);
+    auto search = m_checkpoints.find(source_name);
+    if (search == m_checkpoints.end())
+    {
+        return std::nullopt;
+    }
+    return search->second;
+}
+
+FileCheckpointStore::FileCheckpointStore(std::filesystem::path directory) : m_directory(std::move(directory))
+{
+    std::filesystem::create_directories(m_directory);
+}
+
+const std::filesystem::path& FileCheckpointStore::directory() const
+{
+    return m_directory;
+}
+
+std::filesystem::path FileCheckpointStore::path(const std::string& source_name) const
+{
+    auto filename = source_name;
+    for (auto& c : filename)
+    {
+        if (c == '/')
+        {
+            c = '_';
+        }
+    }
+    return m_directory / (filename + ".checkpoint");
+}
+
+// the file holds the epoch on its first line followed by the raw bytes of the token
+void FileCheckpointStore::save(const std::string& source_name, const Checkpoint& checkpoint)
+{
+    auto final_path = path(source_name);
+    auto tmp_path   = final_path.string() + ".tmp." + std::to_string(getpid());
+    {
+        std::ofstream file(tmp_path, std::ios::binary | std::ios::trunc);
+        file << checkpoint.epoch << '\n' << checkpoint.token;
+        file.flush();
+        if (!file)
+        {
+            std::remove(tmp_path.c_str());
+            throw exceptions::MrcRuntimeError("unable to write the checkpoint of source " + source_name + " to " +
+                                              tmp_path);
+        }
+    }
+
+    if (std::rename(tmp_path.c_str(), final_path.c_str()) != 0)
+    {
+        std::remove(tmp_path.c_str());
+        throw exceptions::MrcRuntimeError("unable to move the checkpoint of source " + source_name + " into place at " +
+                                          final_path.string());
+    }
+
+    DVLOG(10) << "saved checkpoint epoch " << checkpoint.epoch << " of source " << source_name;
+}
+
+std::optional<Checkpoint> FileCheckpointStore::load(const std::string& source_name)
+{
+    auto file_path = path(source_name);
+    std::ifstream file(file_path, std::ios::binary);
+    if (!file)
+    {
+        return std::nullopt;
+    }
+
+    Checkpoint checkpoint;
+    std::string epoch;
+    if (!std::getline(file, epoch))
+    {
+        LOG(WARNING) << "ignoring the empty checkpoint of source " << source_name << " at " << file_path;
+        return std::nullopt;
+    }
+
+    try
+    {
+        checkpoint.epoch = std::stoull(epoch);
+    } catch (const std::exception&)
+    {
+        LOG(WARNING) << "ignoring the malformed checkpoint of source " << source_name << " at " << file_path;
+        return std::nullopt;
+    }
+    checkpoint.token.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    return checkpoint;
+}
+
+CheckpointCoordinator::CheckpointCoordinator(std::string source_name,
+                                             std::shared_ptr<CheckpointStore> store,
+                                             std::size_t participants) :
+  m_source_name(std::move(source_name)),
+  m_store(std::move(store)),
+  m_participants(participants),
+  m_restored(m_store ? m_store->load(m_source_name) : std::nullopt),
+  m_next_epoch(m_restored ? m_restored->epoch + 1 : 1),
+  m_committed(m_restored)
+{
+    CHECK(m_store) << "a checkpoint coordinator requires a store";
+    CHECK_GT(m_participants, 0);
+
+    if (m_restored)
+    {
+        VLOG(1) << "source " << m_source_name << " resumes from checkpoint epoch " << m_restored->epoch;
+    }
+}
+
+const std::optional<Checkpoint>& CheckpointCoordinator::restored() const
+{
+    return m_restored;
+}
+
+CheckpointMarker CheckpointCoordinator::begin_epoch(std::string token)
+{
+    std::lock_guard<decltype(m_mutex)> lock(m_mutex);
+    auto epoch = m_next_epoch++;
+    m_pending.emplace(epoch, PendingEpoch{std::move(token)});
+    return CheckpointMarker{epoch};
+}
+
+void CheckpointCoordinator::acknowledge(const CheckpointMarker& marker)
+{
+    std::lock_guard<decltype(m_mutex)> lock(m_mutex);
+
+    auto search = m_pending.find(marker.epoch);
+    if (search == m_pending.end())
+    {
+        // superseded by a later epoch which committed first
+        return;
+    }
+
+    if (++search->second.acknowledgements < m_participants)
+    {
+        return;
+    }
+
+    Checkpoint checkpoint{marker.epoch, std::move(search->second.token)};
+    m_store->save(m_source_name, checkpoint);
+    m_pending.erase(m_pending.begin(), std::next(search));
+    m_committed = std::move(checkpoint);
+}
+
+std::optional<Checkpoint> CheckpointCoordinator::committed() const
+{
+    std::lock_guard<decltype(m_mutex)> lock(m_mutex);
+    return m_committed;
+}
+
+const std::string& CheckpointCoordinator::source_name() const
+{
+    return m_source_name;
+}
+
+std::size_t CheckpointCoordinator::participants() const
+{
+    return m_participants;
+}
+
+}  // namespace mrc::node
@@ -18,6 +18,8 @@
 #include "mrc/node/edge_adapter_registry.hpp"
 
 #include <map>
+#include <memory>
+#include <mutex>
 #include <stdexcept>
 #include <typeindex>
 #include <utility>
@@ -27,6 +29,11 @@ namespace mrc::node {
 std::map<std::type_index, EdgeAdapterRegistry::source_adapter_fn_t> EdgeAdapterRegistry::registered_source_adapters{};
 std::map<std::type_index, EdgeAdapterRegistry::sink_adapter_fn_t> EdgeAdapterRegistry::registered_sink_adapters{};
 
+std::map<EdgeAdapterRegistry::plan_key_t, std::shared_ptr<const EdgeAdapterRegistry::ConversionPlan>>
+    EdgeAdapterRegistry::cached_source_plans{};
+std::map<EdgeAdapterRegistry::plan_key_t, std::shared_ptr<const EdgeAdapterRegistry::ConversionPlan>>
+    EdgeAdapterRegistry::cached_sink_plans{};
+
 std::recursive_mutex EdgeAdapterRegistry::s_mutex{};
 
 void EdgeAdapterRegistry::register_source_adapter(std::type_index source_type, source_adapter_fn_t adapter_fn)
@@ -39,6 +46,7 @@ void EdgeAdapterRegistry::register_source_adapter(std::type_index source_type, s
     }
 
     EdgeAdapterRegistry::registered_source_adapters[source_type] = adapter_fn;
+    clear_plans();
 }
 
 void EdgeAdapterRegistry::register_sink_adapter(std::type_index sink_type, sink_adapter_fn_t adapter_fn)
@@ -51,6 +59,7 @@ void EdgeAdapterRegistry::register_sink_adapter(std::type_index sink_type, sink_
     }
 
     EdgeAdapterRegistry::registered_sink_adapters[sink_type] = adapter_fn;
+    clear_plans();
 }
 
 bool EdgeAdapterRegistry::has_source_adapter(std::type_index source_type)
@@ -86,4 +95,43 @@ EdgeAdapterRegistry::sink_adapter_fn_t EdgeAdapterRegistry::find_sink_adapter(st
 
     return iter_sink->second;
 }
+
+std::shared_ptr<const EdgeAdapterRegistry::ConversionPlan> EdgeAdapterRegistry::find_source_plan(
+    std::type_index source_type, std::type_index sink_type)
+{
+    std::lock_guard<std::recursive_mutex> lock(s_mutex);
+    auto search = cached_source_plans.find({source_type, sink_type});
+    return (search == cached_source_plans.end() ? nullptr : search->second);
+}
+
+std::shared_ptr<const EdgeAdapterRegistry::ConversionPlan> EdgeAdapterRegistry::find_sink_plan(
+    std::type_index source_type, std::type_index sink_type)
+{
+    std::lock_guard<std::recursive_mutex> lock(s_mutex);
+    auto search = cached_sink_plans.find({source_type, sink_type});
+    return (search == cached_sink_plans.end() ? nullptr : search->second);
+}
+
+void EdgeAdapterRegistry::cache_source_plan(std::type_index source_type,
+                                            std::type_index sink_type,
+                                            std::shared_ptr<const ConversionPlan> plan)
+{
+    std::lock_guard<std::recursive_mutex> lock(s_mutex);
+    cached_source_plans.insert_or_assign({source_type, sink_type}, std::move(plan));
+}
+
+void EdgeAdapterRegistry::cache_sink_plan(std::type_index source_type,
+                                          std::type_index sink_type,
+                                          std::shared_ptr<const ConversionPlan> plan)
+{
+    std::lock_guard<std::recursive_mutex> lock(s_mutex);
+    cached_sink_plans.insert_or_assign({source_type, sink_type}, std::move(plan));
+}
+
+void EdgeAdapterRegistry::clear_plans()
+{
+    std::lock_guard<std::recursive_mutex> lock(s_mutex);
+    cached_source_plans.clear();
+    cached_sink_plans.clear();
+}
 }  // namespace mrc::node
@@ -26,7 +26,6 @@
 
 #include <functional>
 #include <memory>
-#include <stdexcept>
 #include <string>
 #include <typeindex>
 
@@ -41,36 +40,57 @@ std::shared_ptr<channel::IngressHandle> EdgeBuilder::ingress_adapter_for_sink(
     mrc::node::SinkPropertiesBase& sink,
     std::shared_ptr<channel::IngressHandle> ingress_handle)
 {
-    VLOG(2) << "Looking for edge adapter: (" << source.source_type_name() << ", " << sink.sink_type_name() << ")";
-    VLOG(2) << "- (" << source.source_type_hash() << ", " << sink.sink_type_hash() << ")";
+    auto plan = EdgeAdapterRegistry::find_source_plan(source.source_type(), sink.sink_type());
 
-    if (EdgeAdapterRegistry::has_source_adapter(source.source_type()))
+    if (plan != nullptr && plan->source_adapter)
     {
-        auto adapter = EdgeAdapterRegistry::find_source_adapter(source.source_type());
-
-        // Try and build the handle
-        auto handle = adapter(source, sink, sink.ingress_handle());
+        auto handle = plan->source_adapter(source, sink, sink.ingress_handle());
         if (handle)
         {
             return handle;
         }
+
+        // adapters may register a converter for the types while building the edge, after which they decline it
+        plan = nullptr;
     }
 
-    // Fallback -- probably fail
-    try
-    {
-        auto fn_converter = mrc::node::EdgeRegistry::find_converter(source.source_type(), sink.sink_type());
-        return fn_converter(ingress_handle);
-    } catch (std::runtime_error e)
+    if (plan == nullptr)
     {
-        // Last attempt, check if types are the same and return ingress handle.
-        if (source.source_type() == sink.sink_type())
+        VLOG(2) << "Looking for edge adapter: (" << source.source_type_name() << ", " << sink.sink_type_name() << ")";
+        VLOG(2) << "- (" << source.source_type_hash() << ", " << sink.sink_type_hash() << ")";
+
+        auto resolved = std::make_shared<EdgeAdapterRegistry::ConversionPlan>();
+
+        if (EdgeAdapterRegistry::has_source_adapter(source.source_type()))
+        {
+            auto adapter = EdgeAdapterRegistry::find_source_adapter(source.source_type());
+
+            // Try and build the handle
+            auto handle = adapter(source, sink, sink.ingress_handle());
+            if (handle)
+            {
+                resolved->source_adapter = std::move(adapter);
+                EdgeAdapterRegistry::cache_source_plan(source.source_type(), sink.sink_type(), std::move(resolved));
+                return handle;
+            }
+        }
+
+        // Fallback -- a registered converter, otherwise the types must match
+        if (EdgeRegistry::has_converter(source.source_type(), sink.sink_type()))
         {
-            return ingress_handle;
+            resolved->converter = EdgeRegistry::find_converter(source.source_type(), sink.sink_type());
+        }
+        else if (source.source_type() != sink.sink_type())
+        {
+            // throws a descriptive error
+            EdgeRegistry::find_converter(source.source_type(), sink.sink_type());
         }
 
-        throw e;
+        plan = resolved;
+        EdgeAdapterRegistry::cache_source_plan(source.source_type(), sink.sink_type(), std::move(resolved));
     }
+
+    return (plan->converter ? plan->converter(ingress_handle) : ingress_handle);
 }
 
 std::shared_ptr<channel::IngressHandle> EdgeBuilder::ingress_for_source_type(
@@ -78,21 +98,46 @@ std::shared_ptr<channel::IngressHandle> EdgeBuilder::ingress_for_source_type(
     mrc::node::SinkPropertiesBase& sink,
     std::shared_ptr<channel::IngressHandle> ingress_handle)
 {
-    if (EdgeAdapterRegistry::has_sink_adapter(sink.sink_type()))
-    {
-        auto adapter = EdgeAdapterRegistry::find_sink_adapter(sink.sink_type());
+    auto plan = EdgeAdapterRegistry::find_sink_plan(source_type, sink.sink_type());
 
-        // Try and build the handle
-        auto handle = adapter(source_type, sink, sink.ingress_handle());
+    if (plan != nullptr && plan->sink_adapter)
+    {
+        auto handle = plan->sink_adapter(source_type, sink, sink.ingress_handle());
         if (handle)
         {
             return handle;
         }
+
+        // adapters may register a converter for the types while building the edge, after which they decline it
+        plan = nullptr;
+    }
+
+    if (plan == nullptr)
+    {
+        auto resolved = std::make_shared<EdgeAdapterRegistry::ConversionPlan>();
+
+        if (EdgeAdapterRegistry::has_sink_adapter(sink.sink_type()))
+        {
+            auto adapter = EdgeAdapterRegistry::find_sink_adapter(sink.sink_type());
+
+            // Try and build the handle
+            auto handle = adapter(source_type, sink, sink.ingress_handle());
+            if (handle)
+            {
+                resolved->sink_adapter = std::move(adapter);
+                EdgeAdapterRegistry::cache_sink_plan(source_type, sink.sink_type(), std::move(resolved));
+                return handle;
+            }
+        }
+
+        // Fallback -- probably fail
+        resolved->converter = EdgeRegistry::find_converter(source_type, sink.sink_type());
+
+        plan = resolved;
+        EdgeAdapterRegistry::cache_sink_plan(source_type, sink.sink_type(), std::move(resolved));
     }
 
-    // Fallback -- probably fail
-    auto fn_converter = mrc::node::EdgeRegistry::find_converter(source_type, sink.sink_type());
-    return fn_converter(ingress_handle);
+    return plan->converter(ingress_handle);
 }
 
 }  // namespace mrc::node
@@ -17,6 +17,8 @@
 
 #include "mrc/node/edge_registry.hpp"
 
+#include "mrc/node/edge_adapter_registry.hpp"
+
 #include <glog/logging.h>
 
 #include <map>
@@ -40,6 +42,7 @@ void EdgeRegistry::register_converter(std::type_index writer_type, std::type_ind
     }
 
     EdgeRegistry::registered_converters[writer_type][reader_type] = converter;
+    EdgeAdapterRegistry::clear_plans();
 }
 
 bool EdgeRegistry::has_converter(std::type_index writer_type, std::type_index reader_type)
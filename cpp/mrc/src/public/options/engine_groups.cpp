@@ -46,6 +46,21 @@ void EngineGroups::set_engine_factory_options(std::string group_name,
     set_engine_factory_options(std::move(group_name), std::move(options));
 }
 
+std::string EngineGroups::engine_factory_for(runnable::CostClass cost_class) const
+{
+    if (cost_class != runnable::CostClass::Unspecified)
+    {
+        for (const auto& [name, options] : m_engine_resource_groups)
+        {
+            if (options.cost_class == cost_class)
+            {
+                return name;
+            }
+        }
+    }
+    return default_engine_factory_name();
+}
+
 const EngineFactoryOptions& EngineGroups::engine_group_options(const std::string& name) const
 {
     auto search = m_engine_resource_groups.find(name);
@@ -63,7 +78,17 @@ void EngineGroups::set_dedicated_main_thread(bool default_false)
 
 void EngineGroups::set_dedicated_network_thread(bool default_false)
 {
-    m_dedicated_network_thread = default_false;
+    m_network_thread_placement = (default_false ? NetworkThreadPlacement::PerPartition : NetworkThreadPlacement::Main);
+}
+
+void EngineGroups::set_network_thread_placement(NetworkThreadPlacement default_main)
+{
+    m_network_thread_placement = default_main;
+}
+
+void EngineGroups::set_network_thread_scheduling(ThreadSchedulingOptions scheduling)
+{
+    m_network_thread_scheduling = scheduling;
 }
 
 bool EngineGroups::dedicated_main_thread() const
@@ -73,7 +98,17 @@ bool EngineGroups::dedicated_main_thread() const
 
 bool EngineGroups::dedicated_network_thread() const
 {
-    return m_dedicated_network_thread;
+    return m_network_thread_placement != NetworkThreadPlacement::Main;
+}
+
+NetworkThreadPlacement EngineGroups::network_thread_placement() const
+{
+    return m_network_thread_placement;
+}
+
+const ThreadSchedulingOptions& EngineGroups::network_thread_scheduling() const
+{
+    return m_network_thread_scheduling;
 }
 
 runnable::EngineType EngineGroups::default_engine_type() const
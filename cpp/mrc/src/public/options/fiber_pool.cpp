@@ -31,7 +31,42 @@ FiberPoolOptions& FiberPoolOptions::enable_thread_binding(bool default_true)
 }
 FiberPoolOptions& FiberPoolOptions::enable_tracing_scheduler(bool default_false)
 {
-    m_enable_tracing_scheduler = false;
+    m_enable_tracing_scheduler = default_false;
+    return *this;
+}
+FiberPoolOptions& FiberPoolOptions::enable_work_stealing(bool default_false)
+{
+    m_enable_work_stealing = default_false;
+    return *this;
+}
+FiberPoolOptions& FiberPoolOptions::enable_futex_wakeup(bool default_false)
+{
+    m_enable_futex_wakeup = default_false;
+    return *this;
+}
+FiberPoolOptions& FiberPoolOptions::futex_spin_count(std::size_t default_256)
+{
+    m_futex_spin_count = default_256;
+    return *this;
+}
+FiberPoolOptions& FiberPoolOptions::stack_size(std::size_t default_128kib)
+{
+    m_stack_size = default_128kib;
+    return *this;
+}
+FiberPoolOptions& FiberPoolOptions::stack_pool_capacity(std::size_t default_256)
+{
+    m_stack_pool_capacity = default_256;
+    return *this;
+}
+FiberPoolOptions& FiberPoolOptions::enable_stack_protection(bool default_false)
+{
+    m_enable_stack_protection = default_false;
+    return *this;
+}
+FiberPoolOptions& FiberPoolOptions::enable_stack_prefault(bool default_true)
+{
+    m_enable_stack_prefault = default_true;
     return *this;
 }
 bool FiberPoolOptions::enable_memory_binding() const
@@ -46,5 +81,33 @@ bool FiberPoolOptions::enable_tracing_scheduler() const
 {
     return m_enable_tracing_scheduler;
 }
+bool FiberPoolOptions::enable_work_stealing() const
+{
+    return m_enable_work_stealing;
+}
+bool FiberPoolOptions::enable_futex_wakeup() const
+{
+    return m_enable_futex_wakeup;
+}
+std::size_t FiberPoolOptions::futex_spin_count() const
+{
+    return m_futex_spin_count;
+}
+std::size_t FiberPoolOptions::stack_size() const
+{
+    return m_stack_size;
+}
+std::size_t FiberPoolOptions::stack_pool_capacity() const
+{
+    return m_stack_pool_capacity;
+}
+bool FiberPoolOptions::enable_stack_protection() const
+{
+    return m_enable_stack_protection;
+}
+bool FiberPoolOptions::enable_stack_prefault() const
+{
+    return m_enable_stack_prefault;
+}
 
 }  // namespace mrc
@@ -0,0 +1,134 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "mrc/options/manifolds.hpp"
+
+#include <utility>
+
+namespace mrc {
+
+void ManifoldOptions::set_egress_policy(const std::string& port_name, EgressPolicy policy)
+{
+    m_egress_policies[port_name] = policy;
+}
+
+void ManifoldOptions::set_default_egress_policy(EgressPolicy default_round_robin)
+{
+    m_default_egress_policy = default_round_robin;
+}
+
+void ManifoldOptions::set_batch_size(std::size_t default_1)
+{
+    m_batch_size = default_1;
+}
+
+void ManifoldOptions::set_batch_window(std::chrono::microseconds default_0us)
+{
+    m_batch_window = default_0us;
+}
+
+void ManifoldOptions::set_hedge_options(const HedgeOptions& options)
+{
+    m_hedge_options = options;
+}
+
+void ManifoldOptions::set_launch_options(const std::string& port_name, runnable::LaunchOptions launch_options)
+{
+    m_launch_options[port_name] = std::move(launch_options);
+}
+
+void ManifoldOptions::set_default_launch_options(runnable::LaunchOptions launch_options)
+{
+    m_default_launch_options = std::move(launch_options);
+}
+
+void ManifoldOptions::set_enable_direct_connections(bool default_true)
+{
+    m_enable_direct_connections = default_true;
+}
+
+void ManifoldOptions::set_direct_connection(const std::string& port_name, bool direct)
+{
+    if (direct)
+    {
+        m_direct_connections.insert(port_name);
+        return;
+    }
+    m_direct_connections.erase(port_name);
+}
+
+EgressPolicy ManifoldOptions::egress_policy(const std::string& port_name) const
+{
+    auto search = m_egress_policies.find(port_name);
+    if (search == m_egress_policies.end())
+    {
+        return m_default_egress_policy;
+    }
+    return search->second;
+}
+
+bool ManifoldOptions::has_egress_policy(const std::string& port_name) const
+{
+    return m_egress_policies.contains(port_name);
+}
+
+EgressPolicy ManifoldOptions::default_egress_policy() const
+{
+    return m_default_egress_policy;
+}
+
+std::size_t ManifoldOptions::batch_size() const
+{
+    return m_batch_size;
+}
+
+std::chrono::microseconds ManifoldOptions::batch_window() const
+{
+    return m_batch_window;
+}
+
+const HedgeOptions& ManifoldOptions::hedge_options() const
+{
+    return m_hedge_options;
+}
+
+const runnable::LaunchOptions& ManifoldOptions::launch_options(const std::string& port_name) const
+{
+    auto search = m_launch_options.find(port_name);
+    if (search == m_launch_options.end())
+    {
+        return m_default_launch_options;
+    }
+    return search->second;
+}
+
+const runnable::LaunchOptions& ManifoldOptions::default_launch_options() const
+{
+    return m_default_launch_options;
+}
+
+bool ManifoldOptions::enable_direct_connections() const
+{
+    return m_enable_direct_connections;
+}
+
+bool ManifoldOptions::direct_connection(const std::string& port_name) const
+{
+    return m_direct_connections.contains(port_name);
+}
+
+}  // namespace mrc
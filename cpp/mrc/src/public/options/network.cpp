@@ -0,0 +1,266 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "mrc/options/network.hpp"
+
+namespace mrc {
+
+NetworkOptions& NetworkOptions::enable_progress_engine_wakeup(bool default_false)
+{
+    m_enable_progress_engine_wakeup = default_false;
+    return *this;
+}
+NetworkOptions& NetworkOptions::progress_engine_busy_polls(std::size_t default_1024)
+{
+    m_progress_engine_busy_polls = default_1024;
+    return *this;
+}
+NetworkOptions& NetworkOptions::progress_engine_wakeup_timeout(std::chrono::microseconds default_1ms)
+{
+    m_progress_engine_wakeup_timeout = default_1ms;
+    return *this;
+}
+NetworkOptions& NetworkOptions::enable_nic_affinity(bool default_true)
+{
+    m_enable_nic_affinity = default_true;
+    return *this;
+}
+NetworkOptions& NetworkOptions::max_rails(std::size_t default_0)
+{
+    m_max_rails = default_0;
+    return *this;
+}
+NetworkOptions& NetworkOptions::rma_stripe_size(std::size_t default_4MiB)
+{
+    m_rma_stripe_size = default_4MiB;
+    return *this;
+}
+NetworkOptions& NetworkOptions::registration_cache_size(std::size_t default_1GiB)
+{
+    m_registration_cache_size = default_1GiB;
+    return *this;
+}
+NetworkOptions& NetworkOptions::token_release_window(std::chrono::microseconds default_100us)
+{
+    m_token_release_window = default_100us;
+    return *this;
+}
+NetworkOptions& NetworkOptions::token_release_batch_size(std::size_t default_64)
+{
+    m_token_release_batch_size = default_64;
+    return *this;
+}
+NetworkOptions& NetworkOptions::control_plane_batch_window(std::chrono::microseconds default_100us)
+{
+    m_control_plane_batch_window = default_100us;
+    return *this;
+}
+NetworkOptions& NetworkOptions::enable_gpudirect(bool default_true)
+{
+    m_enable_gpudirect = default_true;
+    return *this;
+}
+NetworkOptions& NetworkOptions::staging_chunk_size(std::size_t default_1MiB)
+{
+    m_staging_chunk_size = default_1MiB;
+    return *this;
+}
+NetworkOptions& NetworkOptions::staging_chunk_count(std::size_t default_8)
+{
+    m_staging_chunk_count = default_8;
+    return *this;
+}
+NetworkOptions& NetworkOptions::max_endpoints(std::size_t default_0)
+{
+    m_max_endpoints = default_0;
+    return *this;
+}
+NetworkOptions& NetworkOptions::endpoint_idle_timeout(std::chrono::milliseconds default_0)
+{
+    m_endpoint_idle_timeout = default_0;
+    return *this;
+}
+NetworkOptions& NetworkOptions::enable_active_messages(bool default_true)
+{
+    m_enable_active_messages = default_true;
+    return *this;
+}
+NetworkOptions& NetworkOptions::active_message_batch_bytes(std::size_t default_64KiB)
+{
+    m_active_message_batch_bytes = default_64KiB;
+    return *this;
+}
+NetworkOptions& NetworkOptions::min_pre_posted_recvs(std::size_t default_4)
+{
+    m_min_pre_posted_recvs = default_4;
+    return *this;
+}
+NetworkOptions& NetworkOptions::max_pre_posted_recvs(std::size_t default_64)
+{
+    m_max_pre_posted_recvs = default_64;
+    return *this;
+}
+NetworkOptions& NetworkOptions::pre_posted_recv_window(std::chrono::milliseconds default_100ms)
+{
+    m_pre_posted_recv_window = default_100ms;
+    return *this;
+}
+NetworkOptions& NetworkOptions::workers_per_partition(std::size_t default_1)
+{
+    m_workers_per_partition = default_1;
+    return *this;
+}
+NetworkOptions& NetworkOptions::max_pull_bytes_in_flight(std::size_t default_256MiB)
+{
+    m_max_pull_bytes_in_flight = default_256MiB;
+    return *this;
+}
+NetworkOptions& NetworkOptions::max_pulls_per_instance(std::size_t default_16)
+{
+    m_max_pulls_per_instance = default_16;
+    return *this;
+}
+NetworkOptions& NetworkOptions::pull_latency_target(std::chrono::microseconds default_0)
+{
+    m_pull_latency_target = default_0;
+    return *this;
+}
+NetworkOptions& NetworkOptions::transport(NetworkTransport default_auto)
+{
+    m_transport = default_auto;
+    return *this;
+}
+NetworkOptions& NetworkOptions::enable_shm_rings(bool default_false)
+{
+    m_enable_shm_rings = default_false;
+    return *this;
+}
+NetworkOptions& NetworkOptions::shm_ring_bytes(std::size_t default_4MiB)
+{
+    m_shm_ring_bytes = default_4MiB;
+    return *this;
+}
+bool NetworkOptions::enable_progress_engine_wakeup() const
+{
+    return m_enable_progress_engine_wakeup;
+}
+std::size_t NetworkOptions::progress_engine_busy_polls() const
+{
+    return m_progress_engine_busy_polls;
+}
+std::chrono::microseconds NetworkOptions::progress_engine_wakeup_timeout() const
+{
+    return m_progress_engine_wakeup_timeout;
+}
+bool NetworkOptions::enable_nic_affinity() const
+{
+    return m_enable_nic_affinity;
+}
+std::size_t NetworkOptions::max_rails() const
+{
+    return m_max_rails;
+}
+std::size_t NetworkOptions::rma_stripe_size() const
+{
+    return m_rma_stripe_size;
+}
+std::size_t NetworkOptions::registration_cache_size() const
+{
+    return m_registration_cache_size;
+}
+std::chrono::microseconds NetworkOptions::token_release_window() const
+{
+    return m_token_release_window;
+}
+std::size_t NetworkOptions::token_release_batch_size() const
+{
+    return m_token_release_batch_size;
+}
+std::chrono::microseconds NetworkOptions::control_plane_batch_window() const
+{
+    return m_control_plane_batch_window;
+}
+bool NetworkOptions::enable_gpudirect() const
+{
+    return m_enable_gpudirect;
+}
+std::size_t NetworkOptions::staging_chunk_size() const
+{
+    return m_staging_chunk_size;
+}
+std::size_t NetworkOptions::staging_chunk_count() const
+{
+    return m_staging_chunk_count;
+}
+std::size_t NetworkOptions::max_endpoints() const
+{
+    return m_max_endpoints;
+}
+std::chrono::milliseconds NetworkOptions::endpoint_idle_timeout() const
+{
+    return m_endpoint_idle_timeout;
+}
+bool NetworkOptions::enable_active_messages() const
+{
+    return m_enable_active_messages;
+}
+std::size_t NetworkOptions::active_message_batch_bytes() const
+{
+    return m_active_message_batch_bytes;
+}
+std::size_t NetworkOptions::min_pre_posted_recvs() const
+{
+    return m_min_pre_posted_recvs;
+}
+std::size_t NetworkOptions::max_pre_posted_recvs() const
+{
+    return m_max_pre_posted_recvs;
+}
+std::chrono::milliseconds NetworkOptions::pre_posted_recv_window() const
+{
+    return m_pre_posted_recv_window;
+}
+std::size_t NetworkOptions::workers_per_partition() const
+{
+    return m_workers_per_partition;
+}
+std::size_t NetworkOptions::max_pull_bytes_in_flight() const
+{
+    return m_max_pull_bytes_in_flight;
+}
+std::size_t NetworkOptions::max_pulls_per_instance() const
+{
+    return m_max_pulls_per_instance;
+}
+std::chrono::microseconds NetworkOptions::pull_latency_target() const
+{
+    return m_pull_latency_target;
+}
+NetworkTransport NetworkOptions::transport() const
+{
+    return m_transport;
+}
+bool NetworkOptions::enable_shm_rings() const
+{
+    return m_enable_shm_rings;
+}
+std::size_t NetworkOptions::shm_ring_bytes() const
+{
+    return m_shm_ring_bytes;
+}
+
+}  // namespace mrc
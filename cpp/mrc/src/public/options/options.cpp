@@ -19,13 +19,18 @@
 
 #include "mrc/options/engine_groups.hpp"
 #include "mrc/options/fiber_pool.hpp"
+#include "mrc/options/manifolds.hpp"
+#include "mrc/options/network.hpp"
 #include "mrc/options/placement.hpp"
+#include "mrc/options/quotas.hpp"
 #include "mrc/options/resources.hpp"
+#include "mrc/options/scaling.hpp"
 #include "mrc/options/services.hpp"
 #include "mrc/options/topology.hpp"
 
 #include <glog/logging.h>
 
+#include <sstream>
 #include <utility>  // for move
 
 namespace mrc {
@@ -33,8 +38,12 @@ namespace mrc {
 Options::Options() :
   m_engine_groups(std::make_unique<EngineGroups>()),
   m_fiber_pool(std::make_unique<FiberPoolOptions>()),
+  m_manifolds(std::make_unique<ManifoldOptions>()),
+  m_network(std::make_unique<NetworkOptions>()),
   m_placement(std::make_unique<PlacementOptions>()),
+  m_quotas(std::make_unique<QuotaOptions>()),
   m_resources(std::make_unique<ResourceOptions>()),
+  m_scaling(std::make_unique<ScalingOptions>()),
   m_services(std::make_unique<ServiceOptions>()),
   m_topology(std::make_unique<TopologyOptions>())
 {}
@@ -61,6 +70,28 @@ const FiberPoolOptions& Options::fiber_pool() const
     return *m_fiber_pool;
 }
 
+ManifoldOptions& Options::manifolds()
+{
+    CHECK(m_manifolds);
+    return *m_manifolds;
+}
+const ManifoldOptions& Options::manifolds() const
+{
+    CHECK(m_manifolds);
+    return *m_manifolds;
+}
+
+NetworkOptions& Options::network()
+{
+    CHECK(m_network);
+    return *m_network;
+}
+const NetworkOptions& Options::network() const
+{
+    CHECK(m_network);
+    return *m_network;
+}
+
 PlacementOptions& Options::placement()
 {
     CHECK(m_placement);
@@ -72,6 +103,17 @@ const PlacementOptions& Options::placement() const
     return *m_placement;
 }
 
+QuotaOptions& Options::quotas()
+{
+    CHECK(m_quotas);
+    return *m_quotas;
+}
+const QuotaOptions& Options::quotas() const
+{
+    CHECK(m_quotas);
+    return *m_quotas;
+}
+
 ResourceOptions& Options::resources()
 {
     CHECK(m_resources);
@@ -83,6 +125,17 @@ const ResourceOptions& Options::resources() const
     return *m_resources;
 }
 
+ScalingOptions& Options::scaling()
+{
+    CHECK(m_scaling);
+    return *m_scaling;
+}
+const ScalingOptions& Options::scaling() const
+{
+    CHECK(m_scaling);
+    return *m_scaling;
+}
+
 const std::string& Options::architect_url() const
 {
     return m_architect_url;
@@ -93,6 +146,41 @@ void Options::architect_url(std::string url)
     m_architect_url = std::move(url);
 }
 
+std::vector<std::string> Options::architect_urls() const
+{
+    std::vector<std::string> urls;
+    std::stringstream ss(m_architect_url);
+    std::string url;
+    while (std::getline(ss, url, ','))
+    {
+        if (!url.empty())
+        {
+            urls.push_back(std::move(url));
+        }
+    }
+    return urls;
+}
+
+const std::vector<std::string>& Options::architect_peers() const
+{
+    return m_architect_peers;
+}
+
+void Options::architect_peers(std::vector<std::string> urls)
+{
+    m_architect_peers = std::move(urls);
+}
+
+std::uint32_t Options::architect_priority() const
+{
+    return m_architect_priority;
+}
+
+void Options::architect_priority(std::uint32_t default_0)
+{
+    m_architect_priority = default_0;
+}
+
 void Options::enable_server(bool default_false)
 {
     m_enable_server = default_false;
@@ -145,4 +233,28 @@ void Options::server_port(std::uint16_t port)
 {
     m_server_port = port;
 }
+std::size_t Options::server_completion_queues() const
+{
+    return m_server_completion_queues;
+}
+void Options::server_completion_queues(std::size_t default_1)
+{
+    m_server_completion_queues = default_1;
+}
+bool Options::enable_metrics_server() const
+{
+    return m_enable_metrics_server;
+}
+void Options::enable_metrics_server(bool default_false)
+{
+    m_enable_metrics_server = default_false;
+}
+std::uint16_t Options::metrics_port() const
+{
+    return m_metrics_port;
+}
+void Options::metrics_port(std::uint16_t default_9464)
+{
+    m_metrics_port = default_9464;
+}
 }  // namespace mrc
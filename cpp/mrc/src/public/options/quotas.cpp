@@ -0,0 +1,75 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "mrc/options/quotas.hpp"
+
+namespace mrc {
+
+SegmentQuotaOptions& SegmentQuotaOptions::cpu_weight(std::uint32_t default_0)
+{
+    m_cpu_weight = default_0;
+    return *this;
+}
+SegmentQuotaOptions& SegmentQuotaOptions::memory_bytes(std::size_t default_0)
+{
+    m_memory_bytes = default_0;
+    return *this;
+}
+SegmentQuotaOptions& SegmentQuotaOptions::in_flight_bytes(std::size_t default_0)
+{
+    m_in_flight_bytes = default_0;
+    return *this;
+}
+std::uint32_t SegmentQuotaOptions::cpu_weight() const
+{
+    return m_cpu_weight;
+}
+std::size_t SegmentQuotaOptions::memory_bytes() const
+{
+    return m_memory_bytes;
+}
+std::size_t SegmentQuotaOptions::in_flight_bytes() const
+{
+    return m_in_flight_bytes;
+}
+
+void QuotaOptions::set_segment_options(const std::string& segment_name, const SegmentQuotaOptions& options)
+{
+    m_segment_options[segment_name] = options;
+}
+
+void QuotaOptions::set_default_options(const SegmentQuotaOptions& options)
+{
+    m_default_options = options;
+}
+
+const SegmentQuotaOptions& QuotaOptions::segment_options(const std::string& segment_name) const
+{
+    auto search = m_segment_options.find(segment_name);
+    if (search == m_segment_options.end())
+    {
+        return m_default_options;
+    }
+    return search->second;
+}
+
+const SegmentQuotaOptions& QuotaOptions::default_options() const
+{
+    return m_default_options;
+}
+
+}  // namespace mrc
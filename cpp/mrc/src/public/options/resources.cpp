@@ -64,6 +64,12 @@ ResourceOptions& ResourceOptions::enable_device_memory_pool(bool value)
     return *this;
 }
 
+ResourceOptions& ResourceOptions::enable_memory_tracking(bool value)
+{
+    m_enable_memory_tracking = value;
+    return *this;
+}
+
 bool ResourceOptions::enable_host_memory_pool() const
 {
     return m_enable_host_memory_pool;
@@ -74,4 +80,9 @@ bool ResourceOptions::enable_device_memory_pool() const
     return m_enable_device_memory_pool;
 }
 
+bool ResourceOptions::enable_memory_tracking() const
+{
+    return m_enable_memory_tracking;
+}
+
 }  // namespace mrc
@@ -0,0 +1,160 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "mrc/options/scaling.hpp"
+
+namespace mrc {
+
+SegmentScalingOptions& SegmentScalingOptions::strategy(ScalingStrategy default_static)
+{
+    m_strategy = default_static;
+    return *this;
+}
+SegmentScalingOptions& SegmentScalingOptions::initial_count(std::size_t default_1)
+{
+    m_initial_count = default_1;
+    return *this;
+}
+SegmentScalingOptions& SegmentScalingOptions::min_count(std::size_t default_1)
+{
+    m_min_count = default_1;
+    return *this;
+}
+SegmentScalingOptions& SegmentScalingOptions::max_count(std::size_t default_1)
+{
+    m_max_count = default_1;
+    return *this;
+}
+SegmentScalingOptions& SegmentScalingOptions::cooldown(std::chrono::milliseconds default_30s)
+{
+    m_cooldown = default_30s;
+    return *this;
+}
+SegmentScalingOptions& SegmentScalingOptions::scale_up_queue_depth(std::size_t default_64)
+{
+    m_scale_up_queue_depth = default_64;
+    return *this;
+}
+SegmentScalingOptions& SegmentScalingOptions::scale_down_queue_depth(std::size_t default_0)
+{
+    m_scale_down_queue_depth = default_0;
+    return *this;
+}
+SegmentScalingOptions& SegmentScalingOptions::instance_throughput(double default_0)
+{
+    m_instance_throughput = default_0;
+    return *this;
+}
+SegmentScalingOptions& SegmentScalingOptions::warm_pool_size(std::size_t default_0)
+{
+    m_warm_pool_size = default_0;
+    return *this;
+}
+SegmentScalingOptions& SegmentScalingOptions::drain_timeout(std::chrono::milliseconds default_0)
+{
+    m_drain_timeout = default_0;
+    return *this;
+}
+ScalingStrategy SegmentScalingOptions::strategy() const
+{
+    return m_strategy;
+}
+std::size_t SegmentScalingOptions::initial_count() const
+{
+    return m_initial_count;
+}
+std::size_t SegmentScalingOptions::min_count() const
+{
+    return m_min_count;
+}
+std::size_t SegmentScalingOptions::max_count() const
+{
+    return m_max_count;
+}
+std::chrono::milliseconds SegmentScalingOptions::cooldown() const
+{
+    return m_cooldown;
+}
+std::size_t SegmentScalingOptions::scale_up_queue_depth() const
+{
+    return m_scale_up_queue_depth;
+}
+std::size_t SegmentScalingOptions::scale_down_queue_depth() const
+{
+    return m_scale_down_queue_depth;
+}
+double SegmentScalingOptions::instance_throughput() const
+{
+    return m_instance_throughput;
+}
+std::size_t SegmentScalingOptions::warm_pool_size() const
+{
+    return m_warm_pool_size;
+}
+std::chrono::milliseconds SegmentScalingOptions::drain_timeout() const
+{
+    return m_drain_timeout;
+}
+
+void ScalingOptions::set_segment_options(const std::string& segment_name, const SegmentScalingOptions& options)
+{
+    m_segment_options[segment_name] = options;
+}
+
+void ScalingOptions::set_default_options(const SegmentScalingOptions& options)
+{
+    m_default_options = options;
+}
+
+ScalingOptions& ScalingOptions::evaluation_interval(std::chrono::milliseconds default_1s)
+{
+    m_evaluation_interval = default_1s;
+    return *this;
+}
+
+ScalingOptions& ScalingOptions::startup_parallelism(std::size_t default_16)
+{
+    m_startup_parallelism = default_16;
+    return *this;
+}
+
+const SegmentScalingOptions& ScalingOptions::segment_options(const std::string& segment_name) const
+{
+    auto search = m_segment_options.find(segment_name);
+    if (search == m_segment_options.end())
+    {
+        return m_default_options;
+    }
+    return search->second;
+}
+
+const SegmentScalingOptions& ScalingOptions::default_options() const
+{
+    return m_default_options;
+}
+
+std::chrono::milliseconds ScalingOptions::evaluation_interval() const
+{
+    return m_evaluation_interval;
+}
+
+std::size_t ScalingOptions::startup_parallelism() const
+{
+    return m_startup_parallelism;
+}
+
+}  // namespace mrc
@@ -19,6 +19,7 @@
 
 #include "mrc/core/bitmap.hpp"  // for CpuSet
 
+#include <cstddef>
 #include <utility>  // for move
 
 namespace mrc {
@@ -77,4 +78,40 @@ TopologyOptions& TopologyOptions::ignore_dgx_display(bool default_true)
     m_ignore_dgx_display = default_true;
     return *this;
 }
+const std::string& TopologyOptions::cache_path() const
+{
+    return m_cache_path;
+}
+TopologyOptions& TopologyOptions::cache_path(std::string path)
+{
+    m_cache_path = std::move(path);
+    return *this;
+}
+TopologyOptions& TopologyOptions::use_cpu_quota(bool default_true)
+{
+    m_use_cpu_quota = default_true;
+    return *this;
+}
+TopologyOptions& TopologyOptions::exclude_isolated_cpus(bool default_true)
+{
+    m_exclude_isolated_cpus = default_true;
+    return *this;
+}
+TopologyOptions& TopologyOptions::max_cpu_count(std::size_t default_0)
+{
+    m_max_cpu_count = default_0;
+    return *this;
+}
+bool TopologyOptions::use_cpu_quota() const
+{
+    return m_use_cpu_quota;
+}
+bool TopologyOptions::exclude_isolated_cpus() const
+{
+    return m_exclude_isolated_cpus;
+}
+std::size_t TopologyOptions::max_cpu_count() const
+{
+    return m_max_cpu_count;
+}
 }  // namespace mrc
@@ -17,6 +17,8 @@
 
 #include "mrc/pipeline/pipeline.hpp"
 
+#include "mrc/runnable/launch_options.hpp"
+#include "mrc/runnable/types.hpp"
 #include "mrc/segment/definition.hpp"
 #include "mrc/segment/egress_ports.hpp"
 #include "mrc/segment/ingress_ports.hpp"
@@ -69,6 +71,22 @@ std::shared_ptr<segment::Definition> Pipeline::make_segment(const std::string& s
     return segdef;
 };
 
+void Pipeline::set_manifold_launch_options(const std::string& port_name,
+                                           const runnable::LaunchOptions& launch_options)
+{
+    base_t::set_manifold_launch_options(port_name, launch_options);
+}
+
+void Pipeline::set_port_rate(const std::string& port_name, double elements_per_second)
+{
+    base_t::set_port_rate(port_name, elements_per_second);
+}
+
+void Pipeline::set_port_cost_hints(const std::string& port_name, const runnable::CostHints& cost_hints)
+{
+    base_t::set_port_cost_hints(port_name, cost_hints);
+}
+
 std::unique_ptr<Pipeline> make_pipeline()
 {
     return Pipeline::create();
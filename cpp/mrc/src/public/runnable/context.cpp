@@ -22,6 +22,7 @@
 #include <boost/fiber/fss.hpp>
 #include <glog/logging.h>
 
+#include <chrono>
 #include <cstddef>
 #include <exception>
 #include <sstream>
@@ -93,6 +94,16 @@ void Context::yield()
     do_yield();
 }
 
+bool Context::is_active() const
+{
+    return (m_runner == nullptr || m_runner->is_instance_active(m_rank));
+}
+
+bool Context::await_active(std::chrono::milliseconds timeout) const
+{
+    return (m_runner == nullptr || m_runner->await_instance_active(m_rank, timeout));
+}
+
 void Context::init(const Runner& runner)
 {
     auto& fiber_local = FiberLocalContext::get();
@@ -140,6 +151,12 @@ Context& Context::get_runtime_context()
     return *fiber_local->m_context;
 }
 
+bool Context::has_runtime_context()
+{
+    auto& fiber_local = FiberLocalContext::get();
+    return (fiber_local.get() != nullptr && fiber_local->m_context != nullptr);
+}
+
 void Context::init_info(std::stringstream& ss)
 {
     ss << "rank: " << rank() << "; size: " << size();
@@ -150,6 +167,12 @@ const std::string& Context::info() const
     return m_info;
 }
 
+const std::string& Context::name() const
+{
+    static const std::string unnamed;
+    return unnamed;
+}
+
 bool Context::status() const
 {
     return (m_exception_ptr == nullptr);
@@ -23,10 +23,11 @@
 #include "mrc/runnable/runnable.hpp"
 #include "mrc/types.hpp"
 
-#include <boost/fiber/future/future.hpp>
 #include <glog/logging.h>
 
+#include <algorithm>
 #include <atomic>
+#include <chrono>
 #include <cstddef>
 #include <exception>
 #include <functional>
@@ -37,9 +38,6 @@
 #include <utility>
 #include <vector>
 
-// IWYU thinks we need std::max for calling m_instances.resize()
-// IWYU pragma: no_include <algorithm>
-
 namespace mrc::runnable {
 
 static std::string runnable_state_str(const Runner::State& state)
@@ -79,10 +77,7 @@ Runner::~Runner()
     if (is_running)
     {
         m_runnable->update_state(Runnable::State::Kill);
-        for (auto& instance : m_instances)
-        {
-            await_join();
-        }
+        await_join();
     }
 }
 
@@ -102,10 +97,9 @@ void Runner::enqueue(std::shared_ptr<Engines> launcher, std::vector<std::shared_
         m_instances.resize(contexts.size());
         for (int i = 0; i < contexts.size(); ++i)
         {
-            m_instances[i].m_uid         = contexts[i]->rank();
-            m_instances[i].m_live_future = m_instances[i].m_live_promise.get_future().share();
-            m_instances[i].m_context     = contexts[i];
-            m_instances[i].m_engine      = launcher->launchers()[i];
+            m_instances[i].m_uid     = contexts[i]->rank();
+            m_instances[i].m_context = contexts[i];
+            m_instances[i].m_engine  = launcher->launchers()[i];
             update_state(contexts[i]->rank(), State::Queued);
         }
 
@@ -122,36 +116,88 @@ void Runner::enqueue(std::shared_ptr<Engines> launcher, std::vector<std::shared_
 
     CHECK_EQ(m_instances.size(), launcher->launchers().size());
 
-    m_remaining_instances = launcher->size();
+    {
+        std::lock_guard<Mutex> lock(m_latch_mutex);
+        m_live_instances      = 0;
+        m_remaining_instances = m_instances.size();
+        m_completed           = false;
+        m_joined              = false;
+    }
 
     for (auto& instance : m_instances)
     {
         auto context = instance.m_context;
-        auto engine  = instance.m_engine;
-
-        auto f = engine->launch_task([this, context, &instance] {
-            context->init(*this);
-            update_state(context->rank(), State::Running);
-            instance.m_live_promise.set_value();
-            m_runnable->main(*context);
-            if (!context->status())
-            {
-                update_state(context->rank(), State::Error);
-            }
-            update_state(context->rank(), State::Completed);
-            m_status = m_status && context->status();
-            if (--m_remaining_instances == 0)
+
+        // the runner tracks completion through its latch, the future of the engine is not needed
+        instance.m_engine->launch_task([this, context] {
+            bool was_live = false;
+            std::exception_ptr exception{nullptr};
+            try
             {
-                if (m_completion_callback)
+                context->init(*this);
+                update_state(context->rank(), State::Running);
+                {
+                    std::lock_guard<Mutex> lock(m_latch_mutex);
+                    was_live = true;
+                    if (++m_live_instances == m_instances.size())
+                    {
+                        m_latch_cv.notify_all();
+                    }
+                }
+                m_runnable->main(*context);
+                if (!context->status())
                 {
-                    m_completion_callback(m_status);
+                    update_state(context->rank(), State::Error);
                 }
+                update_state(context->rank(), State::Completed);
+                m_status = m_status && context->status();
+                context->finish();
+            } catch (...)
+            {
+                exception = std::current_exception();
             }
-            context->finish();
+            on_instance_complete(was_live, std::move(exception));
         });
+    }
+}
+
+void Runner::on_instance_complete(bool was_live, std::exception_ptr exception)
+{
+    on_completion_callback_t callback{nullptr};
+    {
+        std::lock_guard<Mutex> lock(m_latch_mutex);
+        if (exception)
+        {
+            m_status = false;
+            if (m_exception == nullptr)
+            {
+                m_exception = std::move(exception);
+            }
+        }
+
+        // instances which failed before becoming live must not block await_live
+        if (!was_live && ++m_live_instances == m_instances.size())
+        {
+            m_latch_cv.notify_all();
+        }
+
+        if (--m_remaining_instances > 0)
+        {
+            return;
+        }
+        m_completed = true;
+        callback    = m_completion_callback;
+    }
 
-        instance.m_join_future = f.share();
+    if (callback)
+    {
+        callback(m_status);
     }
+
+    // the runner may be destroyed as soon as the latch is released; notify while holding the lock
+    std::lock_guard<Mutex> lock(m_latch_mutex);
+    m_joined = true;
+    m_latch_cv.notify_all();
 }
 
 const std::vector<Runner::Instance>& Runner::instances() const
@@ -161,47 +207,79 @@ const std::vector<Runner::Instance>& Runner::instances() const
 
 void Runner::await_live() const
 {
-    for (const auto& instance : instances())
-    {
-        instance.live_future().get();
-    }
+    std::unique_lock<Mutex> lock(m_latch_mutex);
+    m_latch_cv.wait(lock, [this] { return m_joined || m_live_instances == m_instances.size(); });
 }
 
 void Runner::await_join() const
 {
-    std::exception_ptr first_exception{nullptr};
-    for (const auto& instance : instances())
+    std::exception_ptr exception{nullptr};
     {
-        try
-        {
-            instance.join_future().get();
-        } catch (...)
-        {
-            if (first_exception == nullptr)
-            {
-                first_exception = std::current_exception();
-            }
-        }
+        std::unique_lock<Mutex> lock(m_latch_mutex);
+        m_latch_cv.wait(lock, [this] { return m_joined; });
+        std::swap(exception, m_exception);
     }
     m_instances.clear();
-    if (first_exception)
+    if (exception)
     {
         LOG(ERROR) << "Runner::await_join - an exception was caught while awaiting on one or more contexts/instances - "
                       "rethrowing";
-        std::rethrow_exception(std::move(first_exception));
+        std::rethrow_exception(std::move(exception));
     }
 }
 
+bool Runner::await_join_for(std::chrono::milliseconds timeout) const
+{
+    std::unique_lock<Mutex> lock(m_latch_mutex);
+    return m_latch_cv.wait_for(lock, timeout, [this] { return m_joined; });
+}
+
 void Runner::stop() const
 {
-    std::lock_guard<decltype(m_mutex)> lock(m_mutex);
-    m_runnable->update_state(Runnable::State::Stop);
+    {
+        std::lock_guard<decltype(m_mutex)> lock(m_mutex);
+        m_runnable->update_state(Runnable::State::Stop);
+    }
+
+    // release the instances held in standby
+    std::lock_guard<Mutex> lock(m_latch_mutex);
+    m_latch_cv.notify_all();
 }
 
 void Runner::kill() const
 {
-    std::lock_guard<decltype(m_mutex)> lock(m_mutex);
-    m_runnable->update_state(Runnable::State::Kill);
+    {
+        std::lock_guard<decltype(m_mutex)> lock(m_mutex);
+        m_runnable->update_state(Runnable::State::Kill);
+    }
+
+    std::lock_guard<Mutex> lock(m_latch_mutex);
+    m_latch_cv.notify_all();
+}
+
+void Runner::set_active_instances(std::size_t count)
+{
+    CHECK_GT(count, 0) << "a runner requires at least one active instance";
+    std::lock_guard<Mutex> lock(m_latch_mutex);
+    m_active_instances = count;
+    m_latch_cv.notify_all();
+}
+
+std::size_t Runner::active_instances() const
+{
+    std::lock_guard<Mutex> lock(m_latch_mutex);
+    return std::min<std::size_t>(m_active_instances, m_instances.size());
+}
+
+bool Runner::is_instance_active(std::size_t rank) const
+{
+    return (rank < m_active_instances.load(std::memory_order_relaxed) || m_runnable->state() >= Runnable::State::Stop);
+}
+
+bool Runner::await_instance_active(std::size_t rank, std::chrono::milliseconds timeout) const
+{
+    std::unique_lock<Mutex> lock(m_latch_mutex);
+    return m_latch_cv.wait_for(lock, timeout, [this, rank] { return is_instance_active(rank); });
 }
 
 void Runner::update_state(std::size_t launcher_id, State new_state)
@@ -230,16 +308,6 @@ Runner::State Runner::Instance::state() const
     return m_state;
 }
 
-SharedFuture<void> Runner::Instance::live_future() const
-{
-    return m_live_future;
-}
-
-SharedFuture<void> Runner::Instance::join_future() const
-{
-    return m_join_future;
-}
-
 void Runner::on_instance_state_change_callback(on_instance_state_change_t callback)
 {
     CHECK(m_on_instance_state_change == nullptr);
@@ -254,7 +322,15 @@ Runnable& Runner::runnable()
 
 void Runner::on_completion_callback(on_completion_callback_t callback)
 {
-    CHECK(m_completion_callback == nullptr);
-    m_completion_callback = callback;
+    {
+        std::lock_guard<Mutex> lock(m_latch_mutex);
+        CHECK(m_completion_callback == nullptr);
+        m_completion_callback = callback;
+        if (!m_completed)
+        {
+            return;
+        }
+    }
+    callback(m_status);
 }
 }  // namespace mrc::runnable
@@ -23,8 +23,11 @@
 
 #include <nlohmann/json.hpp>
 
+#include <future>
 #include <numeric>
 #include <stdexcept>
+#include <utility>
+#include <vector>
 
 namespace {
 
@@ -100,6 +103,42 @@ std::shared_ptr<mrc::modules::SegmentModule> Builder::load_module_from_registry(
     return module;
 }
 
+std::vector<std::shared_ptr<mrc::modules::SegmentModule>> Builder::load_modules_from_registry(
+    std::vector<mrc::modules::RegisteredModuleSpec> specs)
+{
+    // constructing a module depends on neither the builder nor the other modules, while initializing it adds objects
+    // to the builder, which is not thread safe
+    const auto policy = (specs.size() > 1 ? std::launch::async : std::launch::deferred);
+
+    std::vector<std::future<sp_segment_module_t>> constructed;
+    constructed.reserve(specs.size());
+    for (auto& spec : specs)
+    {
+        auto fn_module_constructor = mrc::modules::ModuleRegistry::get_module_constructor(spec.module_id,
+                                                                                          spec.registry_namespace);
+        constructed.push_back(std::async(policy,
+                                         [fn_module_constructor = std::move(fn_module_constructor),
+                                          module_name           = std::move(spec.module_name),
+                                          config                = std::move(spec.config)]() mutable {
+                                             return fn_module_constructor(std::move(module_name), std::move(config));
+                                         }));
+    }
+
+    std::vector<sp_segment_module_t> modules;
+    modules.reserve(constructed.size());
+    for (auto& module : constructed)
+    {
+        modules.push_back(module.get());
+    }
+
+    for (auto& module : modules)
+    {
+        init_module(module);
+    }
+
+    return modules;
+}
+
 /** private implementations **/
 
 void Builder::ns_push(sp_segment_module_t module)
@@ -151,7 +190,7 @@ void Builder::register_module_output(std::string output_name, std::shared_ptr<se
     current_module->register_output_port(std::move(output_name), object);
 }
 
-nlohmann::json Builder::get_current_module_config()
+const nlohmann::json& Builder::get_current_module_config()
 {
     if (m_module_stack.empty())
     {
@@ -163,9 +202,7 @@ nlohmann::json Builder::get_current_module_config()
         throw std::invalid_argument(sstream.str());
     }
 
-    auto current_module = m_module_stack.back();
-
-    return current_module->config();
+    return m_module_stack.back()->config();
 }
 
 }  // namespace mrc::segment
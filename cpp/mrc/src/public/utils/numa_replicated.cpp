@@ -0,0 +1,158 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "mrc/utils/numa_replicated.hpp"
+
+#include "mrc/core/bitmap.hpp"
+
+#include <glog/logging.h>
+#include <linux/mempolicy.h>
+#include <sched.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <climits>
+#include <cstddef>
+#include <exception>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace mrc::utils::detail {
+
+namespace {
+
+// contents of a sysfs list file, e.g. "0-3,8"; empty if it cannot be read
+std::string read_sysfs_list(const std::string& path)
+{
+    std::string list;
+    std::ifstream(path) >> list;
+    return list;
+}
+
+// binds the cpus and memory allocations of the calling thread to numa_node; binding failures leave the thread to the
+// default policies of the process
+void bind_to_numa_node(std::uint32_t numa_node)
+{
+    static std::atomic<bool> s_warned{false};
+
+    auto cpus = read_sysfs_list("/sys/devices/system/node/node" + std::to_string(numa_node) + "/cpulist");
+    if (!cpus.empty())
+    {
+        cpu_set_t cpu_set;
+        CPU_ZERO(&cpu_set);
+        for (auto cpu : CpuSet(cpus).vec())
+        {
+            CPU_SET(cpu, &cpu_set);
+        }
+        if (sched_setaffinity(0, sizeof(cpu_set), &cpu_set) != 0 && !s_warned.exchange(true))
+        {
+            LOG(WARNING) << "unable to bind the replica builder to the cpus of numa node " << numa_node;
+        }
+    }
+
+    std::vector<unsigned long> mask(numa_node / (sizeof(unsigned long) * CHAR_BIT) + 1, 0);  // NOLINT
+    mask.back() |= 1UL << (numa_node % (sizeof(unsigned long) * CHAR_BIT));
+    // the kernel expects the size of the mask in bits plus one
+    auto max_node = mask.size() * sizeof(unsigned long) * CHAR_BIT + 1;
+    if (syscall(SYS_set_mempolicy, MPOL_BIND, mask.data(), max_node) != 0 && !s_warned.exchange(true))
+    {
+        LOG(WARNING) << "unable to bind replica memory to numa node " << numa_node
+                     << " - if using docker use: --cap-add=sys_nice";
+    }
+}
+
+}  // namespace
+
+std::vector<std::uint32_t> online_numa_nodes()
+{
+    auto nodes = read_sysfs_list("/sys/devices/system/node/has_memory");
+    if (nodes.empty())
+    {
+        return {0};
+    }
+    return NumaSet(nodes).vec();
+}
+
+std::uint32_t current_numa_node()
+{
+    // cpu -> numa node, built once; sched_getcpu is served from the vdso/rseq area, so no lookup enters the kernel
+    static const std::vector<std::uint32_t> s_node_of_cpu = [] {
+        std::vector<std::uint32_t> node_of_cpu;
+        auto nodes = read_sysfs_list("/sys/devices/system/node/online");
+        for (auto node : (nodes.empty() ? std::vector<std::uint32_t>{} : NumaSet(nodes).vec()))
+        {
+            auto cpus = read_sysfs_list("/sys/devices/system/node/node" + std::to_string(node) + "/cpulist");
+            for (auto cpu : (cpus.empty() ? std::vector<std::uint32_t>{} : CpuSet(cpus).vec()))
+            {
+                if (cpu >= node_of_cpu.size())
+                {
+                    node_of_cpu.resize(cpu + 1, 0);
+                }
+                node_of_cpu[cpu] = node;
+            }
+        }
+        return node_of_cpu;
+    }();
+
+    auto cpu = sched_getcpu();
+    if (cpu < 0 || static_cast<std::size_t>(cpu) >= s_node_of_cpu.size())
+    {
+        return 0;
+    }
+    return s_node_of_cpu[cpu];
+}
+
+void run_on_numa_nodes(const std::vector<std::uint32_t>& numa_nodes, const std::function<void(std::size_t)>& fn)
+{
+    std::mutex mutex;
+    std::exception_ptr exception;
+    std::vector<std::thread> threads;
+    threads.reserve(numa_nodes.size());
+
+    for (std::size_t i = 0; i < numa_nodes.size(); ++i)
+    {
+        threads.emplace_back([&, i] {
+            bind_to_numa_node(numa_nodes[i]);
+            try
+            {
+                fn(i);
+            } catch (...)
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                if (!exception)
+                {
+                    exception = std::current_exception();
+                }
+            }
+        });
+    }
+
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+    if (exception)
+    {
+        std::rethrow_exception(exception);
+    }
+}
+
+}  // namespace mrc::utils::detail
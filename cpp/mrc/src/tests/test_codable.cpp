@@ -26,15 +26,25 @@
 #include "internal/runtime/runtime.hpp"
 #include "internal/system/system_provider.hpp"
 #include "internal/ucx/registration_cache.hpp"
+#include "internal/utils/protobuf_arena_pool.hpp"
 
+#include "mrc/arrow/arrow_batch.hpp"
+#include "mrc/arrow/codable/arrow_batch.hpp"  // IWYU pragma: keep
+#include "mrc/benchmarking/message_trace.hpp"
 #include "mrc/codable/api.hpp"
 #include "mrc/codable/codable_protocol.hpp"
+#include "mrc/codable/containers.hpp"  // IWYU pragma: keep
 #include "mrc/codable/decode.hpp"
+#include "mrc/codable/delta_batch.hpp"
 #include "mrc/codable/encode.hpp"
+#include "mrc/codable/encoding_options.hpp"
 #include "mrc/codable/fundamental_types.hpp"  // IWYU pragma: keep
 #include "mrc/codable/protobuf_message.hpp"   // IWYU pragma: keep
 #include "mrc/codable/type_traits.hpp"
+#include "mrc/memory/buffer_view.hpp"
 #include "mrc/memory/codable/buffer.hpp"  // IWYU pragma: keep
+#include "mrc/memory/iovec_view.hpp"
+#include "mrc/memory/memory_kind.hpp"
 #include "mrc/options/options.hpp"
 #include "mrc/options/placement.hpp"
 #include "mrc/protos/codable.pb.h"  // IWYU pragma: keep
@@ -42,13 +52,20 @@
 #include <gtest/gtest.h>
 
 #include <algorithm>
+#include <array>
+#include <cstddef>
 #include <cstdint>
 #include <cstdlib>
+#include <cstring>
 #include <ctime>
+#include <map>
 #include <memory>
 #include <optional>
+#include <span>
 #include <string>
+#include <tuple>
 #include <utility>
+#include <vector>
 
 namespace mrc::codable {
 class EncodingOptions;
@@ -104,10 +121,104 @@ struct codable_protocol<CodableViaExternalStruct>
 
 };  // namespace mrc::codable
 
+struct ChunkedObject
+{
+    std::string data;
+    std::vector<std::string> chunks;
+    std::vector<std::size_t> completed;
+};
+
+namespace mrc::codable {
+
+template <>
+struct codable_protocol<ChunkedObject>
+{
+    static void serialize(const ChunkedObject& obj, Encoder<ChunkedObject>& encoder)
+    {
+        encoder.copy_to_eager_descriptor({obj.data.data(), obj.data.size(), memory::memory_kind::host});
+    }
+
+    static ChunkedObject deserialize(const Decoder<ChunkedObject>& decoder, std::size_t object_idx)
+    {
+        auto idx   = decoder.start_idx_for_object(object_idx);
+        auto bytes = decoder.buffer_size(idx);
+
+        // scatter the descriptor across chunks of at most 4 bytes
+        ChunkedObject obj;
+        std::vector<memory::buffer_view> views;
+        for (std::size_t offset = 0; offset < bytes; offset += 4)
+        {
+            auto& chunk = obj.chunks.emplace_back(std::min<std::size_t>(4, bytes - offset), '\0');
+            views.emplace_back(chunk.data(), chunk.size(), memory::memory_kind::host);
+        }
+        decoder.copy_from_buffer_chunked(
+            idx, views, [&obj](std::size_t chunk_idx) { obj.completed.push_back(chunk_idx); });
+        return obj;
+    }
+};
+
+};  // namespace mrc::codable
+
+struct ColumnarObject
+{
+    std::vector<std::vector<int>> columns;
+};
+
+namespace mrc::codable {
+
+template <>
+struct codable_protocol<ColumnarObject>
+{
+    static void serialize(const ColumnarObject& obj, Encoder<ColumnarObject>& encoder, const EncodingOptions& opts)
+    {
+        // the column sizes are followed by a single descriptor for all columns
+        std::vector<std::uint64_t> sizes;
+        memory::const_iovec_view iov;
+        for (const auto& column : obj.columns)
+        {
+            sizes.push_back(column.size());
+            iov.append({column.data(), column.size() * sizeof(int), memory::memory_kind::host});
+        }
+        encoder.copy_to_eager_descriptor(
+            {sizes.data(), sizes.size() * sizeof(std::uint64_t), memory::memory_kind::host});
+        encoder.add_memory_iovec(std::move(iov), opts);
+    }
+
+    static ColumnarObject deserialize(const Decoder<ColumnarObject>& decoder, std::size_t object_idx)
+    {
+        auto idx = decoder.start_idx_for_object(object_idx);
+
+        std::vector<std::uint64_t> sizes(decoder.buffer_size(idx) / sizeof(std::uint64_t));
+        decoder.copy_from_buffer(idx, {sizes.data(), sizes.size() * sizeof(std::uint64_t), memory::memory_kind::host});
+
+        ColumnarObject obj;
+        memory::iovec_view iov;
+        for (auto size : sizes)
+        {
+            auto& column = obj.columns.emplace_back(size);
+            iov.append({column.data(), column.size() * sizeof(int), memory::memory_kind::host});
+        }
+        decoder.copy_from_buffer(idx + 1, iov);
+        return obj;
+    }
+};
+
+};  // namespace mrc::codable
+
 namespace mrc::codable {}
 
+// trivially copyable types are codable, so this must not be one
 struct NotCodableObject
-{};
+{
+    NotCodableObject(const NotCodableObject& /*unused*/) {}
+};
+
+struct TrivialObject
+{
+    int i;
+    double d;
+    char c[4];
+};
 
 class TestCodable : public ::testing::Test
 {
@@ -177,6 +288,153 @@ TEST_F(TestCodable, String)
     EXPECT_STREQ(str.c_str(), decoded_str.c_str());
 }
 
+TEST_F(TestCodable, EagerThreshold)
+{
+    std::string str(128 * 1024, 'm');
+
+    auto encodable_storage = m_runtime->partition(0).make_codable_storage();
+
+    // above the default threshold the string is registered for a remote get
+    encode(str, *encodable_storage);
+    EXPECT_EQ(encodable_storage->descriptor_count(), 1);
+    EXPECT_TRUE(encodable_storage->proto().descriptors(0).has_remote_desc());
+
+    // raising the threshold carries the string in the encoded object itself
+    EncodingOptions opts;
+    opts.eager_threshold(256 * 1024);
+
+    auto eager_storage = m_runtime->partition(0).make_codable_storage();
+    encode(str, *eager_storage, opts);
+    EXPECT_EQ(eager_storage->descriptor_count(), 1);
+    EXPECT_TRUE(eager_storage->proto().descriptors(0).has_eager_desc());
+
+    auto decoded_str = decode<std::string>(*eager_storage);
+    EXPECT_EQ(str, decoded_str);
+}
+
+TEST_F(TestCodable, SharedMemory)
+{
+    std::string str(128 * 1024, 's');
+
+    EncodingOptions opts;
+    opts.use_shm(true);
+
+    auto encodable_storage = m_runtime->partition(0).make_codable_storage();
+    encode(str, *encodable_storage, opts);
+    EXPECT_EQ(encodable_storage->descriptor_count(), 1);
+    EXPECT_TRUE(encodable_storage->proto().descriptors(0).has_shm_desc());
+
+    auto decoded_str = decode<std::string>(*encodable_storage);
+    EXPECT_EQ(str, decoded_str);
+}
+
+TEST_F(TestCodable, Compression)
+{
+    std::string str(1024 * 1024, 'z');
+
+    for (auto codec : {CompressionCodec::lz4, CompressionCodec::zstd})
+    {
+        EncodingOptions opts;
+        opts.compression(codec);
+
+        // a repetitive payload compresses below the eager threshold and is carried by the encoded object itself
+        auto encodable_storage = m_runtime->partition(0).make_codable_storage();
+        encode(str, *encodable_storage, opts);
+        EXPECT_EQ(encodable_storage->descriptor_count(), 1);
+        EXPECT_TRUE(encodable_storage->proto().descriptors(0).has_eager_desc());
+        EXPECT_NE(encodable_storage->proto().descriptors(0).codec(),
+                  mrc::codable::protos::CompressionCodec::Uncompressed);
+        EXPECT_EQ(encodable_storage->proto().descriptors(0).decoded_bytes(), str.size());
+
+        auto decoded_str = decode<std::string>(*encodable_storage);
+        EXPECT_EQ(str, decoded_str);
+    }
+
+    // below the compression threshold buffers are never compressed
+    EncodingOptions opts;
+    opts.compression(CompressionCodec::lz4);
+    opts.compression_threshold(2 * str.size());
+
+    auto encodable_storage = m_runtime->partition(0).make_codable_storage();
+    encode(str, *encodable_storage, opts);
+    EXPECT_EQ(encodable_storage->proto().descriptors(0).codec(), mrc::codable::protos::CompressionCodec::Uncompressed);
+}
+
+TEST_F(TestCodable, ChunkedDecode)
+{
+    ChunkedObject obj;
+    obj.data = "Hello MRC chunks";
+
+    auto encodable_storage = m_runtime->partition(0).make_codable_storage();
+    encode(obj, *encodable_storage);
+
+    auto decoded = decode<ChunkedObject>(*encodable_storage);
+    EXPECT_EQ(decoded.chunks.size(), 4);
+    EXPECT_EQ(decoded.completed, std::vector<std::size_t>({0, 1, 2, 3}));
+
+    std::string joined;
+    for (const auto& chunk : decoded.chunks)
+    {
+        joined += chunk;
+    }
+    EXPECT_EQ(joined, obj.data);
+}
+
+TEST_F(TestCodable, ScatterGather)
+{
+    ColumnarObject obj;
+    for (int i = 0; i < 8; i++)
+    {
+        obj.columns.emplace_back(16 + i, i);
+    }
+
+    // small columns are gathered into a single eager descriptor and scattered back on decode
+    auto encodable_storage = m_runtime->partition(0).make_codable_storage();
+    encode(obj, *encodable_storage);
+    EXPECT_EQ(encodable_storage->descriptor_count(), 2);
+    EXPECT_TRUE(encodable_storage->proto().descriptors(1).has_eager_desc());
+
+    auto decoded = decode<ColumnarObject>(*encodable_storage);
+    EXPECT_EQ(decoded.columns, obj.columns);
+
+    // large columns are gathered into a single registered buffer, pulled with one get
+    ColumnarObject large;
+    for (int i = 0; i < 4; i++)
+    {
+        large.columns.emplace_back(64 * 1024, i);
+    }
+
+    auto large_storage = m_runtime->partition(0).make_codable_storage();
+    encode(large, *large_storage);
+    EXPECT_EQ(large_storage->descriptor_count(), 2);
+    EXPECT_TRUE(large_storage->proto().descriptors(1).has_remote_desc());
+    EXPECT_EQ(large_storage->proto().descriptors(1).remote_desc().bytes(), 4 * 64 * 1024 * sizeof(int));
+}
+
+TEST_F(TestCodable, TracedMessage)
+{
+    using benchmarking::TraceContext;
+
+    TraceContext::set_sample_rate(1.0);
+    auto msg = benchmarking::make_traced(std::string("payload"), "traced_message");
+    TraceContext::set_sample_rate(0.0);
+    {
+        benchmarking::TraceScope scope(msg.trace, "source");
+    }
+
+    auto encodable_storage = m_runtime->partition(0).make_codable_storage();
+    encode(msg, *encodable_storage);
+
+    // the trace travels with the payload and further hops are recorded on the receiving side
+    auto decoded = decode<benchmarking::Traced<std::string>>(*encodable_storage);
+    EXPECT_EQ(decoded.payload, "payload");
+    EXPECT_EQ(decoded.trace.trace_id(), msg.trace.trace_id());
+    EXPECT_EQ(decoded.trace.name(), "traced_message");
+    ASSERT_EQ(decoded.trace.hops().size(), 1);
+    EXPECT_EQ(decoded.trace.hops()[0].name, "source");
+    EXPECT_EQ(decoded.trace.hops()[0].end_ns, msg.trace.hops()[0].end_ns);
+}
+
 int random_number()
 {
     return (std::rand() % 50 + 1);
@@ -250,9 +508,182 @@ TEST_F(TestCodable, Composite)
     EXPECT_EQ(ans, decoded_ans);
 }
 
+TEST_F(TestCodable, TriviallyCopyable)
+{
+    static_assert(is_codable<TrivialObject>::value, "should be codable");
+    static_assert(is_codable<std::array<int, 4>>::value, "should be codable");
+
+    TrivialObject obj{42, 3.14, {'m', 'r', 'c', '\0'}};
+
+    auto encodable_storage = m_runtime->partition(0).make_codable_storage();
+    encode(obj, *encodable_storage);
+    EXPECT_EQ(encodable_storage->descriptor_count(), 1);
+
+    auto decoded = decode<TrivialObject>(*encodable_storage);
+    EXPECT_EQ(decoded.i, obj.i);
+    EXPECT_DOUBLE_EQ(decoded.d, obj.d);
+    EXPECT_STREQ(decoded.c, obj.c);
+}
+
+TEST_F(TestCodable, Containers)
+{
+    std::vector<std::uint64_t> vec{1, 2, 3, 5, 8};
+    std::map<std::string, std::pair<int, std::vector<std::string>>> map{{"a", {1, {"x", "y"}}}, {"b", {2, {}}}};
+    std::tuple<int, std::string, std::array<std::string, 2>> tuple{7, "seven", {"s", "v"}};
+
+    auto encodable_storage = m_runtime->partition(0).make_codable_storage();
+
+    // the vector of trivially copyable values is encoded with a single descriptor
+    encode(vec, *encodable_storage);
+    EXPECT_EQ(encodable_storage->descriptor_count(), 1);
+
+    encode(map, *encodable_storage);
+    auto tuple_object_idx = encodable_storage->object_count();
+    encode(tuple, *encodable_storage);
+
+    EXPECT_EQ(decode<decltype(vec)>(*encodable_storage, 0), vec);
+    EXPECT_EQ(decode<decltype(map)>(*encodable_storage, 1), map);
+    EXPECT_EQ(decode<decltype(tuple)>(*encodable_storage, tuple_object_idx), tuple);
+}
+
+TEST_F(TestCodable, ArrowBatch)
+{
+    // an int64 column above the eager threshold and a utf8 column below it, without validity bitmaps
+    std::vector<std::int64_t> ids(64 * 1024);
+    std::vector<std::int32_t> offsets(ids.size() + 1);
+    std::string names;
+    for (std::size_t i = 0; i < ids.size(); ++i)
+    {
+        ids[i]         = static_cast<std::int64_t>(i);
+        offsets[i + 1] = offsets[i] + (i % 2 == 0 ? 1 : 0);
+        names += (i % 2 == 0 ? "x" : "");
+    }
+
+    arrow::ArrowArrayLayout id_column{"l", "id", "", 0, static_cast<std::int64_t>(ids.size()), 0, 0};
+    id_column.buffers = {{}, {ids.data(), ids.size() * sizeof(std::int64_t), memory::memory_kind::host}};
+    arrow::ArrowArrayLayout name_column{"u", "name", "", 0, static_cast<std::int64_t>(ids.size()), 0, 0};
+    name_column.buffers = {{},
+                           {offsets.data(), offsets.size() * sizeof(std::int32_t), memory::memory_kind::host},
+                           {names.data(), names.size(), memory::memory_kind::host}};
+    arrow::ArrowArrayLayout root{"+s", "", "", 0, static_cast<std::int64_t>(ids.size()), 0, 0};
+    root.buffers  = {{}};
+    root.children = {id_column, name_column};
+    auto batch    = arrow::ArrowBatch::from_layout(root, nullptr);
+
+    auto encodable_storage = m_runtime->partition(0).make_codable_storage();
+    encode(batch, *encodable_storage);
+
+    // the header, then a descriptor per column buffer; the large columns are pulled by the receiver
+    ASSERT_EQ(encodable_storage->descriptor_count(), 4);
+    EXPECT_TRUE(encodable_storage->proto().descriptors(0).has_eager_desc());
+    EXPECT_TRUE(encodable_storage->proto().descriptors(1).has_remote_desc());
+    EXPECT_TRUE(encodable_storage->proto().descriptors(3).has_eager_desc());
+
+    auto decoded = decode<arrow::ArrowBatch>(*encodable_storage);
+    EXPECT_EQ(decoded.num_rows(), batch.num_rows());
+    EXPECT_EQ(decoded.column_names(), batch.column_names());
+
+    auto buffers = decoded.buffers();
+    ASSERT_EQ(buffers.size(), 3);
+    EXPECT_EQ(decoded.layout().children[0].buffers[0].data(), nullptr);
+    EXPECT_EQ(std::memcmp(buffers[0].data(), ids.data(), buffers[0].bytes()), 0);
+    EXPECT_EQ(std::memcmp(buffers[1].data(), offsets.data(), buffers[1].bytes()), 0);
+    EXPECT_EQ(std::string(static_cast<const char*>(buffers[2].data()), buffers[2].bytes()), names);
+}
+
+TEST_F(TestCodable, DeltaBatch)
+{
+    struct Telemetry
+    {
+        std::uint64_t sensor;
+        std::uint64_t sequence;
+        std::array<double, 30> readings;
+    };
+
+    // consecutive records of a sensor differ in their sequence and one reading
+    std::vector<Telemetry> records(4096);
+    for (std::size_t i = 0; i < records.size(); ++i)
+    {
+        records[i].sensor   = i % 4;
+        records[i].sequence = i;
+        records[i].readings.fill(20.5);
+        records[i].readings[i % records[i].readings.size()] = static_cast<double>(i);
+    }
+
+    auto batch = DeltaBatch::encode_records(records, [](const Telemetry& record) { return record.sensor; });
+    EXPECT_EQ(batch.size(), records.size());
+    EXPECT_EQ(batch.record_bytes(), records.size() * sizeof(Telemetry));
+    EXPECT_LT(batch.bytes() * 8, batch.record_bytes());
+
+    EncodingOptions opts;
+    opts.compression(CompressionCodec::lz4);
+    opts.compression_threshold(0);
+
+    auto encodable_storage = m_runtime->partition(0).make_codable_storage();
+    encode(batch, *encodable_storage, opts);
+    ASSERT_EQ(encodable_storage->descriptor_count(), 1);
+    EXPECT_NE(encodable_storage->proto().descriptors(0).codec(), mrc::codable::protos::CompressionCodec::Uncompressed);
+
+    auto decoded = decode<DeltaBatch>(*encodable_storage);
+    EXPECT_EQ(decoded.size(), batch.size());
+    auto decoded_records = decoded.decode_records<Telemetry>();
+    ASSERT_EQ(decoded_records.size(), records.size());
+    EXPECT_EQ(std::memcmp(decoded_records.data(), records.data(), records.size() * sizeof(Telemetry)), 0);
+
+    // records of varying lengths; a decoded batch keeps delta encoding appended records against its last ones
+    std::vector<std::string> values = {"status=ok;load=0.51", "status=ok;load=0.52", "status=degraded", ""};
+    for (const auto& value : values)
+    {
+        decoded.append(7, std::as_bytes(std::span(value)));
+    }
+
+    std::vector<std::string> decoded_values;
+    decoded.for_each([&](std::uint64_t key, std::span<const std::byte> record) {
+        if (key == 7)
+        {
+            decoded_values.emplace_back(reinterpret_cast<const char*>(record.data()), record.size());
+        }
+    });
+    EXPECT_EQ(decoded_values, values);
+}
+
 TEST_F(TestCodable, EncodedObjectProto)
 {
     static_assert(codable::is_encodable<mrc::codable::protos::EncodedObject>::value, "should be encodable");
     static_assert(codable::is_decodable<mrc::codable::protos::EncodedObject>::value, "should be decodable");
     static_assert(is_codable<mrc::codable::protos::EncodedObject>::value, "should be codable");
 }
+
+TEST_F(TestCodable, ProtobufArenaPool)
+{
+    internal::utils::ProtobufArenaPool pool(1024, 1);
+
+    google::protobuf::Arena* arena = nullptr;
+    {
+        auto rd = pool.make_message<mrc::codable::protos::RemoteDescriptor>();
+        arena   = rd->GetArena();
+        EXPECT_NE(arena, nullptr);
+
+        // outgrow the initial block of the arena
+        for (int i = 0; i < 64; i++)
+        {
+            rd->mutable_encoded_object()->add_descriptors()->mutable_eager_desc()->set_data(std::string(256, 'a'));
+        }
+
+        // moving the message moves its arena
+        auto moved = std::move(rd);
+        EXPECT_EQ(moved->encoded_object().descriptors_size(), 64);
+        EXPECT_EQ(pool.idle_arenas(), 0);
+    }
+
+    // the released arena is reset and reused
+    EXPECT_EQ(pool.idle_arenas(), 1);
+    auto rd = pool.make_message<mrc::codable::protos::RemoteDescriptor>();
+    EXPECT_EQ(rd->GetArena(), arena);
+    EXPECT_EQ(rd->encoded_object().descriptors_size(), 0);
+
+    // only one idle arena is kept
+    auto other = pool.acquire();
+    other      = pool.acquire();
+    EXPECT_EQ(pool.idle_arenas(), 1);
+}
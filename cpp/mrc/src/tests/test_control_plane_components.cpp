@@ -40,6 +40,8 @@ class TestControlPlaneComponents : public ::testing::Test
 
 struct TaggedObject : public server::Tagged
 {
+    using server::Tagged::Tagged;
+    TaggedObject() = default;
     ~TaggedObject() override = default;
     using server::Tagged::next_tag;
 };
@@ -91,6 +93,34 @@ TEST_F(TestControlPlaneComponents, Tagged)
     EXPECT_ANY_THROW(tagged1.next_tag());
 }
 
+TEST_F(TestControlPlaneComponents, TaggedRestore)
+{
+    std::vector<TagID> tags;
+    auto original = std::make_unique<TaggedObject>();
+    for (int i = 0; i < 3; i++)
+    {
+        tags.push_back(original->next_tag());
+    }
+    const auto base     = original->lower_bound();
+    const auto last_uid = original->last_uid();
+    original.reset();
+
+    // a restored object recognizes the tags issued before the restore and does not reissue them
+    TaggedObject restored(base, last_uid);
+    for (const auto& tag : tags)
+    {
+        EXPECT_TRUE(restored.is_issued_tag(tag));
+    }
+    EXPECT_GT(restored.next_tag(), tags.back());
+
+    // objects created after the restore do not reuse its tag
+    TaggedObject created;
+    EXPECT_GT(created.lower_bound(), restored.upper_bound());
+
+    EXPECT_ANY_THROW(TaggedObject(base + 1, last_uid));
+    EXPECT_ANY_THROW(TaggedObject(base, 0));
+}
+
 TEST_F(TestControlPlaneComponents, TaggedIssuer)
 {
     std::atomic<std::size_t> counter = 0;
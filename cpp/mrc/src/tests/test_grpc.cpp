@@ -282,6 +282,93 @@ TEST_F(TestRPC, StreamingPingPong)
     handler_runner->await_join();
 }
 
+// two streams, each on its own completion queue progressed by a dedicated thread
+TEST_F(TestRPC, StreamingPingPongShardedCompletionQueues)
+{
+    m_server = std::make_unique<internal::rpc::Server>(m_resources->partition(0).runnable(), 13337, 2);
+
+    auto service = std::make_shared<mrc::testing::TestService::AsyncService>();
+    m_server->register_service(service);
+
+    std::vector<std::shared_ptr<stream_server_t>> streams;
+    std::vector<std::unique_ptr<mrc::runnable::Runner>> handler_runners;
+    std::vector<std::shared_ptr<grpc::ServerCompletionQueue>> cqs;
+
+    for (int i = 0; i < 2; i++)
+    {
+        auto cq           = cqs.emplace_back(m_server->get_cq());
+        auto service_init = [service, cq](
+                                grpc::ServerContext* context,
+                                grpc::ServerAsyncReaderWriter<mrc::testing::Output, mrc::testing::Input>* stream,
+                                void* tag) { service->RequestStreaming(context, stream, cq.get(), cq.get(), tag); };
+
+        auto& stream = streams.emplace_back(
+            std::make_shared<stream_server_t>(service_init, m_resources->partition(0).runnable()));
+        auto handler = std::make_unique<ServerHandler>();
+        handler->enable_persistence();
+        stream->attach_to(*handler);
+
+        handler_runners.push_back(
+            m_resources->partition(0).runnable().launch_control().prepare_launcher(std::move(handler))->ignition());
+        handler_runners.back()->await_live();
+    }
+    EXPECT_NE(cqs[0], cqs[1]);
+
+    m_server->service_start();
+    m_server->service_await_live();
+
+    for (auto& stream : streams)
+    {
+        m_resources->partition(0).runnable().main().enqueue([stream] { return stream->await_init(); });
+    }
+    m_resources->partition(0).runnable().main().enqueue([] {}).get();  // this is a fence
+
+    for (auto& cq : cqs)
+    {
+        auto prepare_fn = [this, cq](grpc::ClientContext* context) {
+            return m_stub->PrepareAsyncStreaming(context, cq.get());
+        };
+
+        auto client = std::make_shared<stream_client_t>(prepare_fn, m_resources->partition(0).runnable());
+        mrc::node::SinkChannelReadable<typename stream_client_t::IncomingData> client_handler;
+        client->attach_to(client_handler);
+
+        auto client_writer = client->await_init();
+        ASSERT_TRUE(client_writer);
+        for (int i = 0; i < 10; i++)
+        {
+            mrc::testing::Input request;
+            request.set_batch_id(i);
+            client_writer->await_write(std::move(request));
+
+            typename stream_client_t::IncomingData response;
+            client_handler.egress().await_read(response);
+            EXPECT_EQ(response.msg.batch_id(), i);
+        }
+
+        client_writer->finish();
+        client_writer.reset();
+
+        auto client_status = client->await_fini();
+        EXPECT_TRUE(client_status.ok());
+    }
+
+    m_server->service_stop();
+    m_server->service_await_join();
+
+    for (auto& stream : streams)
+    {
+        auto status = stream->await_fini();
+        EXPECT_TRUE(status.ok());
+    }
+
+    for (auto& runner : handler_runners)
+    {
+        runner->stop();
+        runner->await_join();
+    }
+}
+
 TEST_F(TestRPC, StreamingPingPongEarlyServerFinish)
 {
     auto service = std::make_shared<mrc::testing::TestService::AsyncService>();
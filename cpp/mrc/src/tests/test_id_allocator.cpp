@@ -0,0 +1,79 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "internal/utils/id_allocator.hpp"
+
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <set>
+#include <thread>
+#include <vector>
+
+using namespace mrc::internal;
+
+class TestIdAllocator : public ::testing::Test
+{};
+
+TEST_F(TestIdAllocator, IncreasingOnThread)
+{
+    struct Domain;
+    using allocator_t = utils::IdAllocator<Domain, 4>;
+
+    auto previous = allocator_t::next();
+    EXPECT_GT(previous, 0);
+    for (int i = 0; i < 16; ++i)
+    {
+        auto id = allocator_t::next();
+        EXPECT_GT(id, previous);
+        previous = id;
+    }
+}
+
+TEST_F(TestIdAllocator, UniqueAcrossThreads)
+{
+    struct Domain;
+    using allocator_t = utils::IdAllocator<Domain, 8>;
+
+    constexpr std::size_t ThreadCount = 8;
+    constexpr std::size_t IdCount     = 1000;
+
+    std::vector<std::vector<std::uint64_t>> ids(ThreadCount);
+    std::vector<std::thread> threads;
+    for (std::size_t t = 0; t < ThreadCount; ++t)
+    {
+        threads.emplace_back([&ids, t] {
+            for (std::size_t i = 0; i < IdCount; ++i)
+            {
+                ids[t].push_back(allocator_t::next());
+            }
+        });
+    }
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+
+    std::set<std::uint64_t> unique;
+    for (const auto& thread_ids : ids)
+    {
+        unique.insert(thread_ids.begin(), thread_ids.end());
+    }
+    EXPECT_EQ(unique.size(), ThreadCount * IdCount);
+    EXPECT_EQ(unique.count(0), 0);
+}
@@ -15,35 +15,55 @@
  * limitations under the License.
  */
 
+#include "internal/memory/block_manager.hpp"
 #include "internal/memory/callback_adaptor.hpp"
+#include "internal/memory/shared_memory_ring.hpp"
 #include "internal/memory/transient_pool.hpp"
 #include "internal/ucx/context.hpp"
 #include "internal/ucx/memory_block.hpp"
 #include "internal/ucx/registration_cache.hpp"
 #include "internal/ucx/registration_resource.hpp"
 
+#include "mrc/channel/status.hpp"
+#include "mrc/cuda/common.hpp"
+#include "mrc/cuda/copy_engine.hpp"
+#include "mrc/cuda/graph_cache.hpp"
 #include "mrc/memory/adaptors.hpp"
 #include "mrc/memory/buffer.hpp"
 #include "mrc/memory/literals.hpp"
 #include "mrc/memory/memory_kind.hpp"
+#include "mrc/memory/memory_tracker.hpp"
 #include "mrc/memory/resources/arena_resource.hpp"
 #include "mrc/memory/resources/device/cuda_malloc_resource.hpp"
+#include "mrc/memory/resources/host/hugepage_memory_resource.hpp"
+#include "mrc/memory/resources/host/numa_memory_resource.hpp"
 #include "mrc/memory/resources/host/malloc_memory_resource.hpp"
 #include "mrc/memory/resources/host/pinned_memory_resource.hpp"
 #include "mrc/memory/resources/logging_resource.hpp"
+#include "mrc/memory/resources/stream_ordered_resource.hpp"
+#include "mrc/memory/resources/tracking_resource.hpp"
 
+#include <cuda_runtime.h>
 #include <glog/logging.h>
 #include <gtest/gtest.h>
 #include <spdlog/sinks/basic_file_sink.h>
+#include <sys/wait.h>
+#include <unistd.h>
 
+#include <algorithm>
 #include <array>
 #include <atomic>
+#include <chrono>
 #include <cstddef>
+#include <cstdint>
+#include <cstring>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <optional>
 #include <ostream>
 #include <set>
+#include <stdexcept>
 #include <string>
 #include <thread>
 #include <utility>
@@ -112,6 +132,391 @@ TEST_F(TestMemory, UcxRegisteredCudaMemoryArena)
     VLOG(1) << "ucx rbuffer size: " << ucx_block->remote_handle_size();
 }
 
+TEST_F(TestMemory, UcxRegistrationCacheOnDemand)
+{
+    auto context  = std::make_shared<internal::ucx::Context>();
+    auto regcache = std::make_shared<internal::ucx::RegistrationCache>(context, 1_MiB);
+
+    std::vector<std::byte> host(4_MiB);
+    auto* base = host.data();
+
+    // sub-ranges of a cached registration are served without registering again
+    auto first  = regcache->acquire(base + 100, 1000);
+    auto second = regcache->acquire(base + 200, 100);
+    EXPECT_EQ(first.local_handle(), second.local_handle());
+    EXPECT_TRUE(first.contains(base + 100) && first.contains(base + 1099));
+    EXPECT_EQ(regcache->cached_registrations(), 1);
+
+    // an abutting range is coalesced; the replaced registration stays valid while acquired
+    auto coalesced = regcache->acquire(first.offset(first.bytes()), 4_KiB);
+    EXPECT_NE(coalesced.local_handle(), first.local_handle());
+    EXPECT_TRUE(coalesced.contains(base + 100) && coalesced.contains(first.offset(first.bytes())));
+    EXPECT_EQ(regcache->cached_registrations(), 2);
+    regcache->release(first);
+    regcache->release(second);
+    EXPECT_EQ(regcache->cached_registrations(), 1);
+    regcache->release(coalesced);
+
+    // released registrations are evicted in lru order once over budget
+    for (std::size_t offset = 1_MiB; offset < 4_MiB; offset += 512_KiB)
+    {
+        regcache->release(regcache->acquire(base + offset, 256_KiB));
+    }
+    EXPECT_LE(regcache->cached_bytes(), 1_MiB);
+
+    // blocks added explicitly are returned as is and never evicted
+    auto pinned = std::make_unique<pinned_memory_resource>();
+    auto* ptr   = pinned->allocate(1_MiB);
+    regcache->add_block(ptr, 1_MiB);
+    auto block = regcache->acquire(static_cast<std::byte*>(ptr) + 64, 64);
+    EXPECT_EQ(block.data(), ptr);
+    regcache->release(block);
+    regcache->drop_block(ptr, 1_MiB);
+    pinned->deallocate(ptr, 1_MiB);
+}
+
+TEST_F(TestMemory, BlockManagerLookup)
+{
+    internal::memory::BlockManager<internal::ucx::MemoryBlock> blocks;
+    std::vector<std::byte> storage(64_KiB);
+
+    // blocks are added out of address order and found by any address they contain
+    const std::set<std::size_t> starts{32_KiB, 0_KiB, 48_KiB, 8_KiB};
+    for (auto start : starts)
+    {
+        blocks.add_block({storage.data() + start, 4_KiB});
+    }
+    EXPECT_EQ(blocks.size(), 4);
+
+    for (std::size_t offset = 0; offset < storage.size(); offset += 512)
+    {
+        const auto* block = blocks.find_block(storage.data() + offset);
+        auto start        = offset - offset % 8_KiB;
+        bool owned        = (offset % 8_KiB < 4_KiB && starts.contains(start));
+        ASSERT_EQ(block != nullptr, owned) << "offset " << offset;
+        if (owned)
+        {
+            EXPECT_EQ(block->data(), storage.data() + start);
+        }
+    }
+
+    blocks.drop_block(storage.data() + 32_KiB + 100);
+    EXPECT_EQ(blocks.size(), 3);
+    EXPECT_FALSE(blocks.lookup(storage.data() + 32_KiB));
+    EXPECT_TRUE(blocks.lookup(storage.data() + 48_KiB + 4_KiB - 1));
+    EXPECT_FALSE(blocks.lookup(storage.data() + 48_KiB + 4_KiB));
+}
+
+TEST_F(TestMemory, ArenaSizeClasses)
+{
+    auto malloc = std::make_shared<malloc_memory_resource>();
+    auto arena  = memory::make_shared_resource<arena_resource>(malloc, 64_MiB, 256_MiB);
+
+    // small blocks are cached by the thread and handed out again most recently freed first
+    auto* small = arena->allocate(100);
+    arena->deallocate(small, 100);
+    EXPECT_EQ(arena->allocate(256), small);
+    arena->deallocate(small, 256);
+
+    // concurrent allocations of every size class never overlap, including blocks freed by another thread
+    constexpr int Threads    = 4;
+    constexpr int Iterations = 2000;
+    const std::array<std::size_t, 7> sizes{64, 256, 1000, 4_KiB, 5000, 64_KiB, 300_KiB};
+
+    std::mutex mutex;
+    std::vector<std::pair<std::byte*, std::size_t>> handoff;
+    std::atomic<bool> overlapped{false};
+
+    auto worker = [&](int id) {
+        std::vector<std::pair<std::byte*, std::size_t>> live;
+        for (int i = 0; i < Iterations; i++)
+        {
+            auto bytes = sizes.at((i + id) % sizes.size());
+            auto* ptr  = static_cast<std::byte*>(arena->allocate(bytes));
+            std::fill(ptr, ptr + bytes, static_cast<std::byte>(id));
+            live.emplace_back(ptr, bytes);
+
+            if (live.size() == 8)
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                for (auto [block, size] : live)
+                {
+                    if (std::any_of(block, block + size, [id](std::byte b) { return b != static_cast<std::byte>(id); }))
+                    {
+                        overlapped = true;
+                    }
+                }
+                // free half of the blocks here and hand the rest to the next thread to free
+                for (auto [block, size] : handoff)
+                {
+                    arena->deallocate(block, size);
+                }
+                handoff.assign(live.begin() + 4, live.end());
+                live.resize(4);
+                for (auto [block, size] : live)
+                {
+                    arena->deallocate(block, size);
+                }
+                live.clear();
+            }
+        }
+        for (auto [block, size] : live)
+        {
+            arena->deallocate(block, size);
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for (int i = 0; i < Threads; i++)
+    {
+        threads.emplace_back(worker, i);
+    }
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+    for (auto [block, size] : handoff)
+    {
+        arena->deallocate(block, size);
+    }
+
+    EXPECT_FALSE(overlapped);
+}
+
+TEST_F(TestMemory, HugepageResource)
+{
+    auto hugepages = std::make_shared<hugepage_memory_resource>(hugepage_kind::transparent);
+    EXPECT_EQ(hugepages->kind(), memory_kind::host);
+    EXPECT_EQ(hugepages->page_size(), 2_MiB);
+
+    // allocations are aligned to and rounded up to the huge page size
+    for (std::size_t bytes : {100UL, 2_MiB, 3_MiB})
+    {
+        auto* ptr = hugepages->allocate(bytes);
+        EXPECT_EQ(reinterpret_cast<std::uintptr_t>(ptr) % 2_MiB, 0);
+        std::memset(ptr, 1, bytes);
+        hugepages->deallocate(ptr, bytes);
+    }
+
+    // blocks of an arena over huge pages
+    auto arena = memory::make_shared_resource<arena_resource>(hugepages, 8_MiB, 16_MiB);
+    auto block = buffer(1_MiB, arena);
+    std::memset(block.data(), 1, block.bytes());
+}
+
+TEST_F(TestMemory, NumaResource)
+{
+    auto numa = std::make_shared<numa_memory_resource>(std::vector<std::uint32_t>{0});
+    EXPECT_EQ(numa->kind(), memory_kind::host);
+
+    // allocations are page aligned and already faulted in
+    for (std::size_t bytes : {100UL, 4_KiB, 3_MiB})
+    {
+        auto* ptr = numa->allocate(bytes);
+        EXPECT_EQ(reinterpret_cast<std::uintptr_t>(ptr) % sysconf(_SC_PAGESIZE), 0);
+        std::memset(ptr, 1, bytes);
+        numa->deallocate(ptr, bytes);
+    }
+
+    // blocks of an arena over numa bound pages
+    auto arena = memory::make_shared_resource<arena_resource>(numa, 8_MiB, 16_MiB);
+    auto block = buffer(1_MiB, arena);
+    std::memset(block.data(), 1, block.bytes());
+}
+
+TEST_F(TestMemory, ArenaStreamOrdered)
+{
+    auto cuda  = std::make_shared<cuda_malloc_resource>(0);
+    auto arena = memory::make_shared_resource<arena_resource>(cuda, 4_MiB, 4_MiB);
+    stream_ordered_resource& mr = *arena;
+
+    cudaStream_t stream_a = nullptr;
+    cudaStream_t stream_b = nullptr;
+    MRC_CHECK_CUDA(cudaStreamCreate(&stream_a));
+    MRC_CHECK_CUDA(cudaStreamCreate(&stream_b));
+
+    // memory freed on a stream is reused by the same stream, but not by another stream still running behind it
+    auto* ptr = mr.allocate_async(1000, stream_a);
+    MRC_CHECK_CUDA(cudaMemsetAsync(ptr, 0, 1000, stream_a));
+    mr.deallocate_async(ptr, 1000, stream_a);
+    EXPECT_EQ(mr.allocate_async(1000, stream_a), ptr);
+
+    auto* other = mr.allocate_async(1000, stream_b);
+    EXPECT_NE(other, ptr);
+    mr.deallocate_async(other, 1000, stream_b);
+    mr.deallocate_async(ptr, 1000, stream_a);
+
+    // large blocks released on one stream are adopted by another instead of exceeding the maximum size
+    std::vector<void*> blocks;
+    for (int i = 0; i < 3; i++)
+    {
+        blocks.push_back(mr.allocate_async(1_MiB, stream_a));
+        MRC_CHECK_CUDA(cudaMemsetAsync(blocks.back(), 0, 1_MiB, stream_a));
+    }
+    for (auto* block : blocks)
+    {
+        mr.deallocate_async(block, 1_MiB, stream_a);
+    }
+    blocks.clear();
+    for (int i = 0; i < 3; i++)
+    {
+        blocks.push_back(mr.allocate_async(1_MiB, stream_b));
+        MRC_CHECK_CUDA(cudaMemsetAsync(blocks.back(), 1, 1_MiB, stream_b));
+    }
+    for (auto* block : blocks)
+    {
+        mr.deallocate_async(block, 1_MiB, stream_b);
+    }
+
+    // an allocation which only fits once all released blocks are returned synchronizes with the streams
+    auto* large = mr.allocate_async(3_MiB + 512_KiB, stream_b);
+    EXPECT_NE(large, nullptr);
+    mr.deallocate_async(large, 3_MiB + 512_KiB, stream_b);
+
+    MRC_CHECK_CUDA(cudaStreamSynchronize(stream_a));
+    MRC_CHECK_CUDA(cudaStreamSynchronize(stream_b));
+    MRC_CHECK_CUDA(cudaStreamDestroy(stream_a));
+    MRC_CHECK_CUDA(cudaStreamDestroy(stream_b));
+}
+
+TEST_F(TestMemory, CopyEngine)
+{
+    CopyEngine engine(0, 4);
+    auto pinned = std::make_shared<pinned_memory_resource>();
+    auto cuda   = std::make_shared<cuda_malloc_resource>(0);
+
+    auto* host   = static_cast<int*>(pinned->allocate(16 * sizeof(int)));
+    auto* result = static_cast<int*>(pinned->allocate(16 * sizeof(int)));
+    auto* device = static_cast<int*>(cuda->allocate(16 * sizeof(int)));
+    std::fill(host, host + 16, 42);
+    std::fill(result, result + 16, 0);
+
+    // the first four copies fill a batch, the remaining ones share a batch signalled once it is awaited
+    std::vector<CopyCompletion> to_device;
+    for (int i = 0; i < 6; i++)
+    {
+        to_device.push_back(engine.copy_async(device + i, host + i, sizeof(int)));
+    }
+    to_device.back().await();
+    for (const auto& completion : to_device)
+    {
+        EXPECT_TRUE(completion.is_ready());
+    }
+
+    auto to_host = engine.copy_async(result, device, 6 * sizeof(int), cudaMemcpyDeviceToHost);
+    to_host.await();
+    EXPECT_TRUE(std::all_of(result, result + 6, [](int val) { return val == 42; }));
+    EXPECT_EQ(result[6], 0);
+
+    pinned->deallocate(host, 16 * sizeof(int));
+    pinned->deallocate(result, 16 * sizeof(int));
+    cuda->deallocate(device, 16 * sizeof(int));
+}
+
+TEST_F(TestMemory, CudaGraphCache)
+{
+    CudaGraphCache cache(2);
+    auto pinned = std::make_shared<pinned_memory_resource>();
+    auto cuda   = std::make_shared<cuda_malloc_resource>(0);
+
+    auto* result = static_cast<int*>(pinned->allocate(16 * sizeof(int)));
+    auto* device = static_cast<int*>(cuda->allocate(16 * sizeof(int)));
+
+    cudaStream_t stream;
+    MRC_CHECK_CUDA(cudaStreamCreateWithFlags(&stream, cudaStreamNonBlocking));
+
+    // the work of a shape clears its prefix of the buffer and copies the buffer out
+    auto work = [&](std::int64_t count) {
+        return [&, count](cudaStream_t capture_stream) {
+            MRC_CHECK_CUDA(cudaMemsetAsync(device, 0, 16 * sizeof(int), capture_stream));
+            MRC_CHECK_CUDA(cudaMemsetAsync(device, 1, count * sizeof(int), capture_stream));
+            MRC_CHECK_CUDA(cudaMemcpyAsync(result, device, 16 * sizeof(int), cudaMemcpyDeviceToHost, capture_stream));
+        };
+    };
+    auto is_set = [&](std::int64_t count) {
+        return std::all_of(result, result + count, [](int val) { return val == 0x01010101; }) &&
+               std::all_of(result + count, result + 16, [](int val) { return val == 0; });
+    };
+
+    for (int i = 0; i < 3; i++)
+    {
+        std::fill(result, result + 16, -1);
+        cache.launch({4}, stream, work(4));
+        MRC_CHECK_CUDA(cudaStreamSynchronize(stream));
+        EXPECT_TRUE(is_set(4));
+    }
+    EXPECT_EQ(cache.captures(), 1);
+    EXPECT_EQ(cache.replays(), 2);
+
+    // a third shape evicts the least recently launched one
+    cache.launch({8}, stream, work(8));
+    cache.launch({4}, stream, work(4));
+    cache.launch({12}, stream, work(12));
+    cache.launch({4}, stream, work(4));
+    MRC_CHECK_CUDA(cudaStreamSynchronize(stream));
+    EXPECT_TRUE(is_set(4));
+    EXPECT_EQ(cache.size(), 2);
+    EXPECT_EQ(cache.captures(), 3);
+    EXPECT_EQ(cache.replays(), 4);
+
+    cache.launch({8}, stream, work(8));
+    MRC_CHECK_CUDA(cudaStreamSynchronize(stream));
+    EXPECT_TRUE(is_set(8));
+    EXPECT_EQ(cache.captures(), 4);
+
+    // a throwing capture function leaves the stream usable
+    EXPECT_ANY_THROW(cache.launch({16}, stream, [](cudaStream_t) { throw std::runtime_error("capture failed"); }));
+    cache.launch({4}, stream, work(4));
+    MRC_CHECK_CUDA(cudaStreamSynchronize(stream));
+    EXPECT_TRUE(is_set(4));
+    EXPECT_EQ(cache.size(), 2);
+
+    cache.clear();
+    EXPECT_EQ(cache.size(), 0);
+
+    MRC_CHECK_CUDA(cudaStreamDestroy(stream));
+    pinned->deallocate(result, 16 * sizeof(int));
+    cuda->deallocate(device, 16 * sizeof(int));
+}
+
+TEST_F(TestMemory, TrackingResource)
+{
+    auto tracked = make_shared_resource<tracking_resource>(std::make_shared<malloc_memory_resource>());
+    EXPECT_EQ(tracked->kind(), memory_kind::host);
+
+    // allocations made outside of a runnable are owned by the unnamed account
+    auto unnamed_host = [] {
+        for (const auto& usage : MemoryTracker::collect())
+        {
+            if (usage.segment.empty() && usage.node.empty() && usage.kind == memory_kind::host)
+            {
+                return usage;
+            }
+        }
+        return MemoryUsage{"", "", memory_kind::host};
+    };
+
+    MemoryTracker::reset_peaks();
+    auto before = unnamed_host();
+
+    auto* a             = tracked->allocate(1_MiB);
+    auto* b             = tracked->allocate(2_MiB);
+    auto after_allocate = unnamed_host();
+    EXPECT_EQ(after_allocate.live_bytes, before.live_bytes + 3_MiB);
+    EXPECT_EQ(after_allocate.peak_bytes, before.live_bytes + 3_MiB);
+    EXPECT_EQ(after_allocate.allocations, before.allocations + 2);
+    EXPECT_EQ(after_allocate.allocated_bytes, before.allocated_bytes + 3_MiB);
+
+    // memory released on another thread is credited to the account which allocated it
+    std::thread([&] { tracked->deallocate(b, 2_MiB); }).join();
+    auto after_release = unnamed_host();
+    EXPECT_EQ(after_release.live_bytes, before.live_bytes + 1_MiB);
+    EXPECT_EQ(after_release.peak_bytes, before.live_bytes + 3_MiB);
+
+    tracked->deallocate(a, 1_MiB);
+    EXPECT_EQ(unnamed_host().live_bytes, before.live_bytes);
+}
+
 TEST_F(TestMemory, CallbackAdaptor)
 {
     internal::memory::CallbackBuilder builder;
@@ -252,3 +657,120 @@ TEST_F(TestMemory, TransientPool)
     EXPECT_FALSE(other_tick);
     EXPECT_EQ(some_int, 42);
 }
+
+TEST_F(TestMemory, TransientPoolCrossThread)
+{
+    auto malloc = std::make_shared<mrc::memory::malloc_memory_resource>();
+    internal::memory::TransientPool pool(1_MiB, 4, malloc);
+
+    // buffers carved on this thread are released in batches on another one, so the blocks are queued back to the
+    // pool; the pool only keeps up if every block is returned once its last buffer is released
+    for (int round = 0; round < 64; round++)
+    {
+        std::vector<internal::memory::TransientBuffer> buffers;
+        for (int i = 0; i < 48; i++)
+        {
+            buffers.push_back(pool.await_buffer(64_KiB));
+        }
+
+        // a shallow copy made on the owning thread but released remotely
+        internal::memory::TransientBuffer copy(buffers.back().data(), 1_KiB, buffers.back());
+
+        std::thread([&] {
+            internal::memory::TransientBuffer::release_all(buffers);
+            copy.release();
+        }).join();
+
+        for (const auto& buffer : buffers)
+        {
+            EXPECT_EQ(buffer.data(), nullptr);
+        }
+    }
+
+    // a buffer held past the end of a round and released on the owning thread
+    auto held = pool.await_buffer(64_KiB);
+    for (int i = 0; i < 64; i++)
+    {
+        std::thread([buffer = pool.await_buffer(1_MiB)]() mutable { buffer.release(); }).join();
+    }
+    held.release();
+}
+
+TEST_F(TestMemory, SharedMemoryRing)
+{
+    using internal::memory::SharedMemoryRing;
+
+    auto name = "/mrc_test_ring_" + std::to_string(::getpid());
+    auto ring = SharedMemoryRing::create(name, 16 * SharedMemoryRing::SlotBytes);
+    EXPECT_EQ(ring->slot_count(), 16);
+
+    // two producer processes each write 1000 sequenced messages through 16 slots
+    constexpr std::uint32_t Count = 1000;
+    std::vector<pid_t> children;
+    for (std::uint32_t producer = 0; producer < 2; producer++)
+    {
+        auto pid = ::fork();
+        ASSERT_GE(pid, 0);
+        if (pid == 0)
+        {
+            auto writer = SharedMemoryRing::open(name);
+            for (std::uint32_t i = 0; i < Count; i++)
+            {
+                const std::array<std::uint32_t, 2> message{producer, i};
+                while (writer->try_write(sizeof(message), [&message](void* dst) {
+                    std::memcpy(dst, message.data(), sizeof(message));
+                }) == channel::Status::full)
+                {
+                    std::this_thread::yield();
+                }
+            }
+            ::_exit(0);
+        }
+        children.push_back(pid);
+    }
+
+    std::array<std::uint32_t, 2> next{0, 0};
+    for (std::uint32_t i = 0; i < 2 * Count; i++)
+    {
+        std::array<std::uint32_t, 2> message{};
+        ASSERT_EQ(ring->read([&message](const void* data, std::size_t bytes) {
+            ASSERT_EQ(bytes, sizeof(message));
+            std::memcpy(message.data(), data, bytes);
+        }),
+                  channel::Status::success);
+        ASSERT_LT(message[0], 2);
+        EXPECT_EQ(message[1], next[message[0]]++);
+    }
+    for (auto pid : children)
+    {
+        int status = 0;
+        ::waitpid(pid, &status, 0);
+        EXPECT_TRUE(WIFEXITED(status) && WEXITSTATUS(status) == 0);
+    }
+
+    auto writer = SharedMemoryRing::open(name);
+    std::uint32_t value = 42;
+    auto write = [&value](void* dst) { std::memcpy(dst, &value, sizeof(value)); };
+    for (std::size_t i = 0; i < ring->slot_count(); i++)
+    {
+        EXPECT_EQ(writer->try_write(sizeof(value), write), channel::Status::success);
+    }
+    EXPECT_EQ(writer->try_write(sizeof(value), write), channel::Status::full);
+
+    auto empty = SharedMemoryRing::create(name + "_empty", 4 * SharedMemoryRing::SlotBytes);
+    auto noop  = [](const void*, std::size_t) {};
+    EXPECT_EQ(empty->read(noop, std::chrono::steady_clock::now() + std::chrono::milliseconds(1)),
+              channel::Status::timeout);
+
+    // messages written before the ring is closed are still read
+    ring->close();
+    EXPECT_EQ(writer->try_write(sizeof(value), write), channel::Status::closed);
+    for (std::size_t i = 0; i < ring->slot_count(); i++)
+    {
+        EXPECT_EQ(ring->read(noop), channel::Status::success);
+    }
+    EXPECT_EQ(ring->read(noop), channel::Status::closed);
+
+    ring.reset();
+    EXPECT_THROW(SharedMemoryRing::open(name), std::runtime_error);
+}
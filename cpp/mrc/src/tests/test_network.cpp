@@ -19,6 +19,7 @@
 #include "internal/control_plane/client/connections_manager.hpp"
 #include "internal/control_plane/client/instance.hpp"
 #include "internal/data_plane/client.hpp"
+#include "internal/data_plane/pull_throttle.hpp"
 #include "internal/data_plane/request.hpp"
 #include "internal/data_plane/resources.hpp"
 #include "internal/data_plane/server.hpp"
@@ -34,10 +35,16 @@
 #include "internal/system/system_provider.hpp"
 #include "internal/ucx/memory_block.hpp"
 #include "internal/ucx/registration_cache.hpp"
+#include "internal/ucx/resources.hpp"
 
+#include "mrc/core/task_queue.hpp"
+#include "mrc/coroutines/sync_wait.hpp"
+#include "mrc/cuda/common.hpp"
 #include "mrc/memory/adaptors.hpp"
 #include "mrc/memory/buffer.hpp"
+#include "mrc/memory/iovec_view.hpp"
 #include "mrc/memory/literals.hpp"
+#include "mrc/memory/memory_kind.hpp"
 #include "mrc/memory/resources/arena_resource.hpp"
 #include "mrc/memory/resources/host/pinned_memory_resource.hpp"
 #include "mrc/memory/resources/logging_resource.hpp"
@@ -46,6 +53,7 @@
 #include "mrc/node/operators/router.hpp"
 #include "mrc/node/rx_sink.hpp"
 #include "mrc/node/source_channel.hpp"
+#include "mrc/options/network.hpp"
 #include "mrc/options/options.hpp"
 #include "mrc/options/placement.hpp"
 #include "mrc/options/resources.hpp"
@@ -54,14 +62,18 @@
 #include "mrc/runnable/runner.hpp"
 #include "mrc/types.hpp"
 
+#include <cuda_runtime.h>
 #include <glog/logging.h>
 #include <gtest/gtest.h>
 #include <rxcpp/rx.hpp>
 #include <spdlog/sinks/basic_file_sink.h>
 
+#include <array>
 #include <atomic>
+#include <chrono>
 #include <cstddef>
 #include <cstdint>
+#include <cstring>
 #include <functional>
 #include <map>
 #include <memory>
@@ -102,6 +114,42 @@ TEST_F(TestNetwork, Arena)
     f->deallocate(ptr, 1024);
 }
 
+TEST_F(TestNetwork, PullThrottle)
+{
+    internal::data_plane::PullThrottle throttle(1_KiB, 4, std::chrono::milliseconds(10));
+
+    // the window of an instance bounds its concurrent pulls, independent of the other instances
+    std::vector<internal::data_plane::PullPermit> permits;
+    for (int i = 0; i < 4; i++)
+    {
+        permits.push_back(throttle.try_acquire(1, 100));
+        EXPECT_TRUE(permits.back());
+    }
+    EXPECT_FALSE(throttle.try_acquire(1, 100));
+    permits.push_back(throttle.try_acquire(2, 100));
+    EXPECT_TRUE(permits.back());
+    EXPECT_EQ(throttle.bytes_in_flight(), 500);
+
+    // a pull exceeding the bytes in flight waits for all others to complete
+    EXPECT_FALSE(throttle.try_acquire(3, 2_KiB));
+    permits.pop_back();
+
+    // a window of slow pulls halves the window once
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    permits.clear();
+    EXPECT_EQ(throttle.window(1), 2);
+    EXPECT_EQ(throttle.bytes_in_flight(), 0);
+    EXPECT_TRUE(throttle.try_acquire(3, 2_KiB));
+
+    // fast pulls grow it back additively
+    for (int i = 0; i < 3; i++)
+    {
+        throttle.acquire(1, 100).release();
+    }
+    EXPECT_EQ(throttle.window(1), 3);
+    EXPECT_EQ(throttle.window(2), 4);
+}
+
 TEST_F(TestNetwork, ResourceManager)
 {
     // using options.placement().resources_strategy(PlacementResources::Shared)
@@ -162,6 +210,51 @@ TEST_F(TestNetwork, ResourceManager)
     d_buffer_0.release();
 }
 
+TEST_F(TestNetwork, MultipleWorkers)
+{
+    auto resources = std::make_unique<internal::resources::Manager>(
+        internal::system::SystemProvider(make_system([](Options& options) {
+            options.enable_server(true);
+            options.architect_url("localhost:13337");
+            options.placement().resources_strategy(PlacementResources::Dedicated);
+            options.engine_factories().set_dedicated_network_thread(true);
+            options.network().workers_per_partition(2);
+        })));
+
+    if (resources->partition_count() < 2)
+    {
+        GTEST_SKIP() << "this test only works with 2 partitions";
+    }
+
+    auto f1 = resources->partition(0).network()->control_plane().client().connections().update_future();
+    auto f2 = resources->partition(1).network()->control_plane().client().connections().update_future();
+    resources->partition(0).network()->control_plane().client().request_update();
+    f1.get();
+    f2.get();
+
+    auto& ucx = resources->partition(1).network()->ucx();
+    EXPECT_EQ(ucx.worker_count(), 2);
+    EXPECT_EQ(&ucx.worker(0), &ucx.worker());
+
+    // the endpoint is created on the worker its instance is sharded to, which is progressed on its own thread
+    auto& r0 = resources->partition(0).network()->data_plane();
+    auto& r1 = resources->partition(1).network()->data_plane();
+
+    auto src = resources->partition(1).host().make_buffer(4_KiB);
+    auto dst = resources->partition(0).host().make_buffer(4_KiB);
+    std::memset(src.data(), 0x5A, src.bytes());
+
+    internal::data_plane::Request send_req;
+    internal::data_plane::Request recv_req;
+    r0.client().async_p2p_recv(dst.data(), dst.bytes(), 42, recv_req);
+    r1.client().async_p2p_send(src.data(), src.bytes(), 42, r0.instance_id(), send_req);
+    EXPECT_TRUE(send_req.await_complete());
+    EXPECT_TRUE(recv_req.await_complete());
+    EXPECT_EQ(std::memcmp(src.data(), dst.data(), src.bytes()), 0);
+
+    resources.reset();
+}
+
 TEST_F(TestNetwork, CommsSendRecv)
 {
     // using options.placement().resources_strategy(PlacementResources::Shared)
@@ -220,10 +313,104 @@ TEST_F(TestNetwork, CommsSendRecv)
 
     EXPECT_EQ(src, dst);
 
+    // a gather send scattered into a receive with differently sized regions
+    std::array<int, 3> src_a{1, 2, 3};
+    std::array<int, 5> src_b{4, 5, 6, 7, 8};
+    std::array<int, 6> dst_a{};
+    std::array<int, 2> dst_b{};
+
+    mrc::memory::const_iovec_view send_iov;
+    send_iov.append({src_a.data(), sizeof(src_a), mrc::memory::memory_kind::host});
+    send_iov.append({src_b.data(), sizeof(src_b), mrc::memory::memory_kind::host});
+    mrc::memory::iovec_view recv_iov;
+    recv_iov.append({dst_a.data(), sizeof(dst_a), mrc::memory::memory_kind::host});
+    recv_iov.append({dst_b.data(), sizeof(dst_b), mrc::memory::memory_kind::host});
+
+    r1.client().async_p2p_recv(recv_iov, 1, recv_req);
+    r0.client().async_p2p_send(send_iov, 1, id_1, send_req);
+    recv_req.await_complete();
+    send_req.await_complete();
+
+    EXPECT_EQ(dst_a, (std::array<int, 6>{1, 2, 3, 4, 5, 6}));
+    EXPECT_EQ(dst_b, (std::array<int, 2>{7, 8}));
+
+    // pooled requests awaited by a coroutine, which the completion callbacks resume
+    {
+        auto pooled_recv = r1.request_pool().await_item();
+        auto pooled_send = r0.request_pool().await_item();
+
+        dst = -1;
+        r1.client().async_p2p_recv(&dst, sizeof(int), 2, *pooled_recv);
+        r0.client().async_p2p_send(&src, sizeof(int), 2, id_1, *pooled_send);
+        EXPECT_TRUE(coroutines::sync_wait(internal::data_plane::when_all({*pooled_recv, *pooled_send})));
+        EXPECT_EQ(src, dst);
+    }
+
     // expect that the buffers are allowed to survive pass the resource manager
     resources.reset();
 }
 
+TEST_F(TestNetwork, CommsStagedSendRecv)
+{
+    auto resources = std::make_unique<internal::resources::Manager>(
+        internal::system::SystemProvider(make_system([](Options& options) {
+            options.enable_server(true);
+            options.architect_url("localhost:13337");
+            options.placement().resources_strategy(PlacementResources::Dedicated);
+            options.resources().enable_device_memory_pool(true);
+            options.resources().enable_host_memory_pool(true);
+            options.resources().host_memory_pool().block_size(32_MiB);
+            options.resources().host_memory_pool().max_aggregate_bytes(128_MiB);
+            options.resources().device_memory_pool().block_size(64_MiB);
+            options.resources().device_memory_pool().max_aggregate_bytes(128_MiB);
+            // stage device memory through host buffers, with fewer buffers than chunks per message
+            options.network().enable_gpudirect(false);
+            options.network().staging_chunk_size(256_KiB);
+            options.network().staging_chunk_count(2);
+        })));
+
+    if (resources->partition_count() < 2 && resources->device_count() < 2)
+    {
+        GTEST_SKIP() << "this test only works with 2 device partitions";
+    }
+
+    EXPECT_TRUE(resources->partition(0).host().staging_pool());
+    EXPECT_TRUE(resources->partition(1).host().staging_pool());
+
+    auto& r0 = resources->partition(0).network()->data_plane();
+    auto& r1 = resources->partition(1).network()->data_plane();
+
+    auto f1 = resources->partition(0).network()->control_plane().client().connections().update_future();
+    auto f2 = resources->partition(1).network()->control_plane().client().connections().update_future();
+    resources->partition(0).network()->control_plane().client().request_update();
+    f1.get();
+    f2.get();
+
+    auto id_1 = resources->partition(1).network()->control_plane().instance_id();
+
+    // a partial last chunk
+    constexpr std::size_t bytes = 1_MiB + 100;
+    std::vector<std::uint8_t> src(bytes);
+    std::vector<std::uint8_t> dst(bytes, 0);
+    for (std::size_t i = 0; i < bytes; ++i)
+    {
+        src[i] = static_cast<std::uint8_t>(i % 251);
+    }
+
+    auto d_src = resources->partition(0).device()->make_buffer(bytes);
+    auto d_dst = resources->partition(1).device()->make_buffer(bytes);
+    MRC_CHECK_CUDA(cudaMemcpy(d_src.data(), src.data(), bytes, cudaMemcpyHostToDevice));
+
+    std::thread receiver([&] { r1.client().p2p_recv(d_dst.data(), bytes, 7); });
+    r0.client().p2p_send(d_src.data(), bytes, 7, id_1);
+    receiver.join();
+
+    MRC_CHECK_CUDA(cudaMemcpy(dst.data(), d_dst.data(), bytes, cudaMemcpyDeviceToHost));
+    EXPECT_EQ(src, dst);
+
+    resources.reset();
+}
+
 TEST_F(TestNetwork, CommsGet)
 {
     // using options.placement().resources_strategy(PlacementResources::Shared)
@@ -295,6 +482,65 @@ TEST_F(TestNetwork, CommsGet)
     resources.reset();
 }
 
+TEST_F(TestNetwork, RemoteRegistrationCacheHits)
+{
+    auto resources = std::make_unique<internal::resources::Manager>(
+        internal::system::SystemProvider(make_system([](Options& options) {
+            options.enable_server(true);
+            options.architect_url("localhost:13337");
+            options.placement().resources_strategy(PlacementResources::Dedicated);
+            options.resources().enable_host_memory_pool(true);
+            options.resources().host_memory_pool().block_size(32_MiB);
+            options.resources().host_memory_pool().max_aggregate_bytes(128_MiB);
+        })));
+
+    if (resources->partition_count() < 2 && resources->device_count() < 2)
+    {
+        GTEST_SKIP() << "this test only works with 2 device partitions";
+    }
+
+    auto src = resources->partition(0).host().make_buffer(1_MiB);
+    auto dst = resources->partition(1).host().make_buffer(1_MiB);
+
+    auto block = resources->partition(0).network()->data_plane().registration_cache().lookup(src.data());
+    EXPECT_TRUE(block);
+
+    auto f1 = resources->partition(0).network()->control_plane().client().connections().update_future();
+    auto f2 = resources->partition(1).network()->control_plane().client().connections().update_future();
+    resources->partition(0).network()->control_plane().client().request_update();
+    f1.get();
+    f2.get();
+
+    auto id_0   = resources->partition(0).network()->control_plane().instance_id();
+    auto& r1    = resources->partition(1).network()->data_plane();
+    auto ep     = r1.client().endpoint_shared(id_0);
+    auto& cache = ep->registration_cache();
+
+    // pulls of two halves of the buffer share the remote key of the pool block backing it
+    auto* src_bytes = static_cast<std::byte*>(src.data());
+    auto* dst_bytes = static_cast<std::byte*>(dst.data());
+    for (std::size_t offset : {std::size_t{0}, 512_KiB})
+    {
+        auto remote =
+            cache.lookup_or_add(src_bytes + offset, block->data(), block->bytes(), block->packed_remote_keys());
+
+        internal::data_plane::Request request;
+        r1.client().async_striped_get(dst_bytes + offset,
+                                      512_KiB,
+                                      *ep,
+                                      reinterpret_cast<std::uintptr_t>(src_bytes + offset),
+                                      remote.remote_key_handle(),
+                                      request);
+        request.await_complete();
+    }
+
+    EXPECT_EQ(cache.misses(), 1);
+    EXPECT_EQ(cache.hits(), 1);
+
+    ep.reset();
+    resources.reset();
+}
+
 TEST_F(TestNetwork, PersistentEagerDataPlaneTaggedRecv)
 {
     // using options.placement().resources_strategy(PlacementResources::Shared)
@@ -311,6 +557,7 @@ TEST_F(TestNetwork, PersistentEagerDataPlaneTaggedRecv)
             options.resources().host_memory_pool().max_aggregate_bytes(128_MiB);
             options.resources().device_memory_pool().block_size(64_MiB);
             options.resources().device_memory_pool().max_aggregate_bytes(128_MiB);
+            options.network().enable_active_messages(false);
         })));
 
     if (resources->partition_count() < 2 && resources->device_count() < 2)
@@ -362,8 +609,251 @@ TEST_F(TestNetwork, PersistentEagerDataPlaneTaggedRecv)
     recv_runner->await_join();
     EXPECT_EQ(counter, 1);
 
+    auto stats = r0.server().pre_posted_recv_stats();
+    EXPECT_EQ(stats.arrivals, 1);
+    EXPECT_GE(stats.recvs, 4);
+    EXPECT_LE(stats.recvs, 64);
+    EXPECT_EQ(stats.busy, 0);
+
+    // cached endpoints are reused until dropped, then recreated on their next use
+    EXPECT_EQ(r1.client().endpoint_shared(r0.instance_id()), endpoint);
+    EXPECT_EQ(r1.client().endpoint_count(), 1);
+    r1.client().drop_endpoint(r0.instance_id());
+    EXPECT_EQ(r1.client().endpoint_count(), 0);
+    EXPECT_NE(r1.client().endpoint_shared(r0.instance_id()), endpoint);
+    EXPECT_EQ(r1.client().endpoint_count(), 1);
+
     resources.reset();
 }
+
+TEST_F(TestNetwork, RendezvousDataPlaneTaggedRecv)
+{
+    auto resources = std::make_unique<internal::resources::Manager>(
+        internal::system::SystemProvider(make_system([](Options& options) {
+            options.enable_server(true);
+            options.architect_url("localhost:13337");
+            options.placement().resources_strategy(PlacementResources::Dedicated);
+            options.resources().enable_device_memory_pool(true);
+            options.resources().enable_host_memory_pool(true);
+            options.resources().host_memory_pool().block_size(32_MiB);
+            options.resources().host_memory_pool().max_aggregate_bytes(128_MiB);
+            options.resources().device_memory_pool().block_size(64_MiB);
+            options.resources().device_memory_pool().max_aggregate_bytes(128_MiB);
+        })));
+
+    if (resources->partition_count() < 2 && resources->device_count() < 2)
+    {
+        GTEST_SKIP() << "this test only works with 2 device partitions";
+    }
+
+    // here we are exchanging internal ucx worker addresses without the need of the control plane
+    auto f1 = resources->partition(0).network()->control_plane().client().connections().update_future();
+    auto f2 = resources->partition(1).network()->control_plane().client().connections().update_future();
+    resources->partition(0).network()->control_plane().client().request_update();
+    f1.get();
+    f2.get();
+
+    EXPECT_TRUE(resources->partition(0).network());
+    EXPECT_TRUE(resources->partition(1).network());
+
+    auto& r0 = resources->partition(0).network()->data_plane();
+    auto& r1 = resources->partition(1).network()->data_plane();
+
+    const std::uint64_t tag          = 20919;
+    std::atomic<std::size_t> counter = 0;
+
+    auto recv_sink = std::make_unique<node::RxSink<internal::memory::TransientBuffer>>(
+        [&](internal::memory::TransientBuffer buffer) {
+            EXPECT_EQ(buffer.bytes(), 4_MiB);
+            counter++;
+            r0.server().deserialize_source().drop_edge(tag);
+        });
+
+    mrc::node::make_edge(r0.server().deserialize_source().source(tag), *recv_sink);
+
+    auto launch_opts = resources->partition(0).network()->data_plane().launch_options(1);
+    auto recv_runner = resources->partition(0)
+                           .runnable()
+                           .launch_control()
+                           .prepare_launcher(launch_opts, std::move(recv_sink))
+                           ->ignition();
+
+    auto endpoint = r1.client().endpoint_shared(r0.instance_id());
+
+    internal::data_plane::Request req;
+    auto buffer   = resources->partition(1).host().make_buffer(4_MiB);
+    auto send_tag = tag | TAG_RND_MSG;
+
+    // larger than the pre-posted recvs, so the message is probed by the data plane server
+    ASSERT_GT(buffer.bytes(), EGR_MSG_MAX_BYTES);
+    r1.client().async_send(buffer.data(), buffer.bytes(), send_tag, *endpoint, req);
+    EXPECT_TRUE(req.await_complete());
+
+    // the channel will be dropped when the first message goes thru
+    recv_runner->await_join();
+    EXPECT_EQ(counter, 1);
+
+    resources.reset();
+}
+
+TEST_F(TestNetwork, ActiveMessageDataPlaneRecv)
+{
+    auto resources = std::make_unique<internal::resources::Manager>(
+        internal::system::SystemProvider(make_system([](Options& options) {
+            options.enable_server(true);
+            options.architect_url("localhost:13337");
+            options.placement().resources_strategy(PlacementResources::Dedicated);
+            options.resources().enable_device_memory_pool(true);
+            options.resources().enable_host_memory_pool(true);
+            options.resources().host_memory_pool().block_size(32_MiB);
+            options.resources().host_memory_pool().max_aggregate_bytes(128_MiB);
+            options.resources().device_memory_pool().block_size(64_MiB);
+            options.resources().device_memory_pool().max_aggregate_bytes(128_MiB);
+            options.network().active_message_batch_bytes(4_KiB);
+        })));
+
+    if (resources->partition_count() < 2 && resources->device_count() < 2)
+    {
+        GTEST_SKIP() << "this test only works with 2 device partitions";
+    }
+
+    auto f1 = resources->partition(0).network()->control_plane().client().connections().update_future();
+    auto f2 = resources->partition(1).network()->control_plane().client().connections().update_future();
+    resources->partition(0).network()->control_plane().client().request_update();
+    f1.get();
+    f2.get();
+
+    auto& r0 = resources->partition(0).network()->data_plane();
+    auto& r1 = resources->partition(1).network()->data_plane();
+
+    const std::uint64_t tag          = 20919;
+    const std::size_t count          = 32;
+    std::atomic<std::size_t> counter = 0;
+    std::atomic<std::size_t> bytes   = 0;
+
+    // messages of varying sizes, the largest one exceeding a batch, each filled with its size modulo 256
+    auto message_bytes = [](std::size_t i) { return (i == count - 1 ? 1_MiB : 1 + i * 97); };
+
+    auto recv_sink = std::make_unique<node::RxSink<internal::memory::TransientBuffer>>(
+        [&](internal::memory::TransientBuffer buffer) {
+            const auto* data = static_cast<const std::uint8_t*>(buffer.data());
+            EXPECT_EQ(data[0], static_cast<std::uint8_t>(buffer.bytes()));
+            EXPECT_EQ(data[buffer.bytes() - 1], static_cast<std::uint8_t>(buffer.bytes()));
+            bytes += buffer.bytes();
+            if (++counter == count)
+            {
+                r0.server().deserialize_source().drop_edge(tag);
+            }
+        });
+
+    mrc::node::make_edge(r0.server().deserialize_source().source(tag), *recv_sink);
+
+    auto launch_opts = resources->partition(0).network()->data_plane().launch_options(1);
+    auto recv_runner = resources->partition(0)
+                           .runnable()
+                           .launch_control()
+                           .prepare_launcher(launch_opts, std::move(recv_sink))
+                           ->ignition();
+
+    // concurrent senders to the same instance have their messages aggregated while an active message is in flight
+    std::vector<Future<void>> sends;
+    std::size_t expected_bytes = 0;
+    for (std::size_t i = 0; i < count; i++)
+    {
+        expected_bytes += message_bytes(i);
+        sends.push_back(resources->partition(1).runnable().main().enqueue([&, i] {
+            std::vector<std::uint8_t> message(message_bytes(i), static_cast<std::uint8_t>(message_bytes(i)));
+            r1.client().am_send(r0.instance_id(), tag, message.data(), message.size());
+        }));
+    }
+    for (auto& send : sends)
+    {
+        send.get();
+    }
+
+    recv_runner->await_join();
+    EXPECT_EQ(counter, count);
+    EXPECT_EQ(bytes, expected_bytes);
+
+    // no recvs are pre-posted when remote descriptors are sent as active messages
+    EXPECT_EQ(r0.server().pre_posted_recv_stats().recvs, 0);
+
+    resources.reset();
+}
+TEST_F(TestNetwork, ActiveMessageStreamOrder)
+{
+    auto resources = std::make_unique<internal::resources::Manager>(
+        internal::system::SystemProvider(make_system([](Options& options) {
+            options.enable_server(true);
+            options.architect_url("localhost:13337");
+            options.placement().resources_strategy(PlacementResources::Dedicated);
+            options.resources().enable_device_memory_pool(true);
+            options.resources().enable_host_memory_pool(true);
+            options.resources().host_memory_pool().block_size(32_MiB);
+            options.resources().host_memory_pool().max_aggregate_bytes(128_MiB);
+            options.resources().device_memory_pool().block_size(64_MiB);
+            options.resources().device_memory_pool().max_aggregate_bytes(128_MiB);
+        })));
+
+    if (resources->partition_count() < 2 && resources->device_count() < 2)
+    {
+        GTEST_SKIP() << "this test only works with 2 device partitions";
+    }
+
+    auto f1 = resources->partition(0).network()->control_plane().client().connections().update_future();
+    auto f2 = resources->partition(1).network()->control_plane().client().connections().update_future();
+    resources->partition(0).network()->control_plane().client().request_update();
+    f1.get();
+    f2.get();
+
+    auto& r0 = resources->partition(0).network()->data_plane();
+    auto& r1 = resources->partition(1).network()->data_plane();
+
+    const std::uint64_t tag = 20920;
+    const std::size_t count = 16;
+    std::size_t counter     = 0;
+
+    // rendezvous messages interleaved with eager messages, each filled with its index
+    auto message_bytes = [](std::size_t i) { return (i % 4 == 0 ? 1_MiB : 64); };
+
+    auto recv_sink = std::make_unique<node::RxSink<internal::memory::TransientBuffer>>(
+        [&](internal::memory::TransientBuffer buffer) {
+            // messages sent by a single fiber are received in the order they were sent
+            EXPECT_EQ(buffer.bytes(), message_bytes(counter));
+            EXPECT_EQ(static_cast<const std::uint8_t*>(buffer.data())[0], counter);
+            if (++counter == count)
+            {
+                r0.server().deserialize_source().drop_edge(tag);
+            }
+        });
+
+    mrc::node::make_edge(r0.server().deserialize_source().source(tag), *recv_sink);
+
+    auto launch_opts = resources->partition(0).network()->data_plane().launch_options(1);
+    auto recv_runner = resources->partition(0)
+                           .runnable()
+                           .launch_control()
+                           .prepare_launcher(launch_opts, std::move(recv_sink))
+                           ->ignition();
+
+    resources->partition(1)
+        .runnable()
+        .main()
+        .enqueue([&] {
+            for (std::size_t i = 0; i < count; i++)
+            {
+                std::vector<std::uint8_t> message(message_bytes(i), static_cast<std::uint8_t>(i));
+                r1.client().am_send(r0.instance_id(), tag, message.data(), message.size());
+            }
+        })
+        .get();
+
+    recv_runner->await_join();
+    EXPECT_EQ(counter, count);
+
+    resources.reset();
+}
+
 // TEST_F(TestNetwork, NetworkEventsManagerLifeCycle)
 // {
 //     auto launcher = m_launch_control->prepare_launcher(std::move(m_mutable_nem));
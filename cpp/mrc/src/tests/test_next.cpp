@@ -23,11 +23,15 @@
 #include "mrc/channel/egress.hpp"
 #include "mrc/channel/ingress.hpp"
 #include "mrc/data/reusable_pool.hpp"
+#include "mrc/node/edge_adapter_registry.hpp"
 #include "mrc/node/edge_builder.hpp"
+#include "mrc/node/edge_connector.hpp"
+#include "mrc/node/generic_batch_node.hpp"
 #include "mrc/node/generic_node.hpp"
 #include "mrc/node/generic_sink.hpp"
 #include "mrc/node/generic_source.hpp"
 #include "mrc/node/operators/conditional.hpp"
+#include "mrc/node/operators/hash_partitioner.hpp"
 #include "mrc/node/rx_execute.hpp"
 #include "mrc/node/rx_node.hpp"
 #include "mrc/node/rx_sink.hpp"
@@ -56,14 +60,18 @@
 #include <gtest/gtest.h>
 #include <rxcpp/rx.hpp>
 
+#include <algorithm>
 #include <atomic>
 #include <chrono>
 #include <cstddef>
 #include <exception>
 #include <functional>
+#include <map>
 #include <memory>
 #include <ostream>
+#include <span>
 #include <string>
+#include <typeinfo>
 #include <utility>
 #include <vector>
 
@@ -215,6 +223,50 @@ TEST_F(TestNext, UniqueToConstShared)
     EXPECT_EQ(input_addr, output_addr);
 }
 
+TEST_F(TestNext, EdgeConversionPlanCache)
+{
+    // typeless edges resolve their conversion once per pair of types
+    ExampleSourceChannel<float> source;
+    ExampleSinkChannel<float> sink;
+    node::EdgeBuilder::make_edge_typeless(source, sink);
+
+    auto identity = node::EdgeAdapterRegistry::find_source_plan(typeid(float), typeid(float));
+    ASSERT_NE(identity, nullptr);
+    EXPECT_FALSE(identity->converter);
+
+    ExampleSourceChannel<float> other_source;
+    ExampleSinkChannel<float> other_sink;
+    node::EdgeBuilder::make_edge_typeless(other_source, other_sink);
+    EXPECT_EQ(node::EdgeAdapterRegistry::find_source_plan(typeid(float), typeid(float)), identity);
+
+    float output = 0.0;
+    other_source.ingress().await_write(2.0F);
+    other_sink.egress().await_read(output);
+    EXPECT_FLOAT_EQ(output, 2.0F);
+
+    // unknown conversions are not cached
+    ExampleSourceChannel<ExampleObject*> object_source;
+    ExampleSinkChannel<float> object_sink;
+    EXPECT_ANY_THROW(node::EdgeBuilder::make_edge_typeless(object_source, object_sink));
+    EXPECT_EQ(node::EdgeAdapterRegistry::find_source_plan(typeid(ExampleObject*), typeid(float)), nullptr);
+
+    // registering a converter invalidates the cached plans
+    node::EdgeConnector<double, float>::register_converter();
+    EXPECT_EQ(node::EdgeAdapterRegistry::find_source_plan(typeid(float), typeid(float)), nullptr);
+
+    ExampleSourceChannel<double> double_source;
+    ExampleSinkChannel<float> float_sink;
+    node::EdgeBuilder::make_edge_typeless(double_source, float_sink);
+
+    auto converter = node::EdgeAdapterRegistry::find_source_plan(typeid(double), typeid(float));
+    ASSERT_NE(converter, nullptr);
+    EXPECT_TRUE(converter->converter);
+
+    double_source.ingress().await_write(3.14);
+    float_sink.egress().await_read(output);
+    EXPECT_FLOAT_EQ(output, 3.14F);
+}
+
 TEST_F(TestNext, MakeEdgeConvertible)
 {
     using input_t  = double;
@@ -371,6 +423,53 @@ TEST_F(TestNext, GenericNodeAndSink)
     EXPECT_EQ(const_sink.counter(), 3);
 }
 
+class ExampleGenericBatchNode : public node::GenericBatchNode<int, int>
+{
+  public:
+    std::size_t largest_batch() const
+    {
+        return m_largest_batch;
+    }
+
+  private:
+    void on_data_batch(std::span<int> batch, std::vector<int>& outputs) final
+    {
+        m_largest_batch = std::max(m_largest_batch, batch.size());
+        for (auto& data : batch)
+        {
+            outputs.push_back(data * 2);
+        }
+    }
+
+    std::size_t m_largest_batch{0};
+};
+
+TEST_F(TestNext, GenericBatchNode)
+{
+    auto source = std::make_unique<ExampleSourceChannel<int>>();
+    auto node   = std::make_unique<ExampleGenericBatchNode>();
+    auto sink   = std::make_unique<ExampleGenericSink>();
+
+    node::make_edge(*source, *node);
+    node::make_edge(*node, *sink);
+
+    // the elements written before the node is launched are handed to the node as a single batch
+    for (int i = 0; i < 10; i++)
+    {
+        source->ingress().await_write(i);
+    }
+    source.reset();
+
+    auto runner_node = m_resources->launch_control().prepare_launcher(std::move(node))->ignition();
+    auto runner_sink = m_resources->launch_control().prepare_launcher(std::move(sink))->ignition();
+
+    runner_node->await_join();
+    runner_sink->await_join();
+
+    EXPECT_EQ(runner_node->runnable_as<ExampleGenericBatchNode>().largest_batch(), 10U);
+    EXPECT_EQ(runner_sink->runnable_as<ExampleGenericSink>().counter(), 10U);
+}
+
 TEST_F(TestNext, ConcurrentSinkRxRunnable)
 {
     using input_t  = double;
@@ -651,6 +750,123 @@ TEST_F(TestNext, Conditional)
     EXPECT_EQ(output, 1);
 }
 
+TEST_F(TestNext, DenseConditional)
+{
+    enum Routes : std::size_t
+    {
+        Even,
+        Odd,
+        RouteCount
+    };
+
+    auto source = std::make_unique<ExampleSourceChannel<int>>();
+    auto even   = std::make_unique<ExampleSinkChannel<int>>();
+    auto odd    = std::make_unique<ExampleSinkChannel<int>>();
+
+    auto cond = std::make_shared<node::DenseConditional<int, Routes>>(
+        RouteCount, [](const int& i) { return static_cast<Routes>(i % 2); });
+
+    (*source | *cond);
+    (cond->source(Odd) | *odd);
+    (cond->source(Even) | *even);
+
+    source->ingress().await_write(0);
+    source->ingress().await_write(1);
+    source->ingress().await_write(2);
+    source.reset();
+
+    int output;
+    even->egress().await_read(output);
+    EXPECT_EQ(output, 0);
+    even->egress().await_read(output);
+    EXPECT_EQ(output, 2);
+    odd->egress().await_read(output);
+    EXPECT_EQ(output, 1);
+}
+
+TEST_F(TestNext, BatchConditional)
+{
+    auto source = std::make_unique<ExampleSourceChannel<std::vector<int>>>();
+    std::vector<std::unique_ptr<ExampleSinkChannel<int>>> sinks;
+
+    // cases of a whole batch filled by a single loop
+    auto cond = std::make_shared<node::BatchConditional<int, std::size_t>>(
+        3, [](std::span<const int> data, std::span<std::size_t> cases) {
+            for (std::size_t i = 0; i < data.size(); ++i)
+            {
+                cases[i] = static_cast<std::size_t>(data[i]) % 3;
+            }
+        });
+
+    (*source | *cond);
+    for (std::size_t i = 0; i < cond->case_count(); ++i)
+    {
+        sinks.push_back(std::make_unique<ExampleSinkChannel<int>>());
+        (cond->source(i) | *sinks.back());
+    }
+
+    source->ingress().await_write(std::vector<int>{0, 1, 2, 3, 4, 5});
+    source->ingress().await_write(std::vector<int>{6, 9, 7});
+    source.reset();
+
+    // each case receives its elements in order across batches
+    std::vector<std::vector<int>> expected = {{0, 3, 6, 9}, {1, 4, 7}, {2, 5}};
+    for (std::size_t i = 0; i < sinks.size(); ++i)
+    {
+        std::vector<int> received;
+        int output;
+        while (sinks[i]->egress().await_read(output) == channel::Status::success)
+        {
+            received.push_back(output);
+        }
+        EXPECT_EQ(received, expected[i]);
+    }
+}
+
+TEST_F(TestNext, HashPartitioner)
+{
+    using data_t = std::pair<int, int>;
+
+    auto source = std::make_unique<ExampleSourceChannel<data_t>>();
+    std::vector<std::unique_ptr<ExampleSinkChannel<data_t>>> sinks;
+
+    auto partitioner = std::make_shared<node::HashPartitioner<data_t, int>>(
+        3, [](const data_t& data) { return data.first; });
+
+    (*source | *partitioner);
+    for (std::size_t i = 0; i < partitioner->partition_count(); ++i)
+    {
+        sinks.push_back(std::make_unique<ExampleSinkChannel<data_t>>());
+        (partitioner->source(i) | *sinks.back());
+    }
+
+    for (int i = 0; i < 12; ++i)
+    {
+        source->ingress().await_write(data_t{i % 4, i});
+    }
+    source.reset();
+
+    // every element of a key lands on the partition of the key, in order
+    std::map<int, int> last_value;
+    std::size_t count = 0;
+    for (std::size_t i = 0; i < sinks.size(); ++i)
+    {
+        data_t output;
+        while (sinks[i]->egress().await_read(output) == channel::Status::success)
+        {
+            EXPECT_EQ(static_cast<std::size_t>(output.first % 3), i);
+            auto search = last_value.find(output.first);
+            if (search != last_value.end())
+            {
+                EXPECT_LT(search->second, output.second);
+            }
+            last_value[output.first] = output.second;
+            ++count;
+        }
+    }
+    EXPECT_EQ(count, 12U);
+}
+
 class PrivateSource : private node::SourceChannel<int>
 {
   public:
@@ -125,7 +125,7 @@ class TestPartitions : public testing::TestWithParam<const char*>
         return options;
     }
 
-    static std::unique_ptr<Partitions> make_partitions(std::shared_ptr<Options> options)
+    static std::shared_ptr<Topology> make_topology(std::shared_ptr<Options> options)
     {
         std::string root_path;
         std::stringstream path;
@@ -142,7 +142,12 @@ class TestPartitions : public testing::TestWithParam<const char*>
         VLOG(10) << "root_data_path: " << path.str();
         // todo(backlog) - assert the the fixture fie exists
         auto topo_proto = Topology::deserialize_from_file(path.str());
-        auto topology   = Topology::Create(options->topology(), topo_proto);
+        return Topology::Create(options->topology(), topo_proto);
+    }
+
+    static std::unique_ptr<Partitions> make_partitions(std::shared_ptr<Options> options)
+    {
+        auto topology = make_topology(options);
         return std::make_unique<Partitions>(*topology, *options);
     }
 };
@@ -178,15 +183,15 @@ TEST_P(TestPartitions, Scenario2)
     // todo(ryan) - coded loop based on json structure of fixture
     EXPECT_EQ(partitions->device_partitions().size(), 5);
     EXPECT_EQ(partitions->host_partitions().size(), 5);
-    EXPECT_EQ(partitions->device_partitions().at(0).host().cpu_set().str(), "0-11,64-75");
+    EXPECT_EQ(partitions->device_partitions().at(0).host().cpu_set().str(), "0-7,64-71");
     EXPECT_EQ(partitions->device_partitions().at(0).pcie_bus_id(), "00000000:C1:00.0");
-    EXPECT_EQ(partitions->device_partitions().at(1).host().cpu_set().str(), "13-24,77-88");
+    EXPECT_EQ(partitions->device_partitions().at(1).host().cpu_set().str(), "8-15,72-79");
     EXPECT_EQ(partitions->device_partitions().at(1).pcie_bus_id(), "00000000:C2:00.0");
-    EXPECT_EQ(partitions->device_partitions().at(2).host().cpu_set().str(), "26-37,90-101");
+    EXPECT_EQ(partitions->device_partitions().at(2).host().cpu_set().str(), "16-31,80-95");
     EXPECT_EQ(partitions->device_partitions().at(2).pcie_bus_id(), "00000000:81:00.0");
-    EXPECT_EQ(partitions->device_partitions().at(3).host().cpu_set().str(), "39-50,103-114");
+    EXPECT_EQ(partitions->device_partitions().at(3).host().cpu_set().str(), "32-47,96-111");
     EXPECT_EQ(partitions->device_partitions().at(3).pcie_bus_id(), "00000000:47:00.0");
-    EXPECT_EQ(partitions->device_partitions().at(4).host().cpu_set().str(), "52-63,116-127");
+    EXPECT_EQ(partitions->device_partitions().at(4).host().cpu_set().str(), "48-63,112-127");
     EXPECT_EQ(partitions->device_partitions().at(4).pcie_bus_id(), "00000000:01:00.0");
 }
 
@@ -202,15 +207,15 @@ TEST_P(TestPartitions, Scenario3)
     // todo(ryan) - coded loop based on json structure of fixture
     EXPECT_EQ(partitions->device_partitions().size(), 5);
     EXPECT_EQ(partitions->host_partitions().size(), 5);
-    EXPECT_EQ(partitions->device_partitions().at(0).host().cpu_set().str(), "0-11,64-75");
+    EXPECT_EQ(partitions->device_partitions().at(0).host().cpu_set().str(), "0-7,64-71");
     EXPECT_EQ(partitions->device_partitions().at(0).pcie_bus_id(), "00000000:C1:00.0");
-    EXPECT_EQ(partitions->device_partitions().at(1).host().cpu_set().str(), "13-24,77-88");
+    EXPECT_EQ(partitions->device_partitions().at(1).host().cpu_set().str(), "8-15,72-79");
     EXPECT_EQ(partitions->device_partitions().at(1).pcie_bus_id(), "00000000:C2:00.0");
-    EXPECT_EQ(partitions->device_partitions().at(2).host().cpu_set().str(), "26-37,90-101");
+    EXPECT_EQ(partitions->device_partitions().at(2).host().cpu_set().str(), "16-31,80-95");
     EXPECT_EQ(partitions->device_partitions().at(2).pcie_bus_id(), "00000000:81:00.0");
-    EXPECT_EQ(partitions->device_partitions().at(3).host().cpu_set().str(), "39-50,103-114");
+    EXPECT_EQ(partitions->device_partitions().at(3).host().cpu_set().str(), "32-47,96-111");
     EXPECT_EQ(partitions->device_partitions().at(3).pcie_bus_id(), "00000000:47:00.0");
-    EXPECT_EQ(partitions->device_partitions().at(4).host().cpu_set().str(), "52-63,116-127");
+    EXPECT_EQ(partitions->device_partitions().at(4).host().cpu_set().str(), "48-63,112-127");
     EXPECT_EQ(partitions->device_partitions().at(4).pcie_bus_id(), "00000000:01:00.0");
     EXPECT_TRUE(partitions->cpu_strategy() == PlacementStrategy::PerMachine)
         << "requested PerNuma should fall back to PerMachine if the topology is asymmetric";
@@ -531,6 +536,35 @@ TEST_P(TestPartitions, EngineFactoryScenario5)
     EXPECT_NE(cpu_sets.fiber_cpu_sets.at("main").first(), cpu_sets.fiber_cpu_sets.at("mrc_network").first());
 }
 
+TEST_P(TestPartitions, EngineFactorySharedNetworkThread)
+{
+    auto options = make_options([](Options& options) {
+        options.architect_url("localhost:13337");
+        options.engine_factories().set_network_thread_placement(NetworkThreadPlacement::Shared);
+        options.topology().user_cpuset("0-15");
+        options.topology().restrict_gpus(true);
+        options.placement().cpu_strategy(PlacementStrategy::PerNumaNode);
+        options.placement().resources_strategy(PlacementResources::Dedicated);
+    });
+
+    auto partitions = make_partitions(options);
+    ASSERT_EQ(partitions->host_partitions().size(), 2);
+
+    const auto& first  = partitions->host_partitions().at(0).engine_factory_cpu_sets();
+    const auto& second = partitions->host_partitions().at(1).engine_factory_cpu_sets();
+
+    // the network thread is reserved once by the first host partition and isolated from its compute pools
+    const auto& network = first.fiber_cpu_sets.at("mrc_network");
+    EXPECT_EQ(network.weight(), 1);
+    EXPECT_NE(network.first(), first.fiber_cpu_sets.at("main").first());
+    EXPECT_EQ(network.set_intersect(first.fiber_cpu_sets.at("default")).weight(), 0);
+
+    // the second host partition uses the network thread of the first and reserves none of its own cpus
+    EXPECT_EQ(second.fiber_cpu_sets.at("mrc_network").str(), network.str());
+    EXPECT_EQ(partitions->host_partitions().at(1).cpu_set().set_intersect(network).weight(), 0);
+    EXPECT_EQ(second.fiber_cpu_sets.at("default").weight(), partitions->host_partitions().at(1).cpu_set().weight());
+}
+
 TEST_P(TestPartitions, EngineFactoryScenario6)
 {
     auto focus = [](Options& options) {
@@ -736,4 +770,134 @@ TEST_P(TestPartitions, EngineFactoryScenario11)
     EXPECT_FALSE(cpu_sets.shared_cpus_has_fibers);
 }
 
+TEST_P(TestPartitions, EngineFactoryNumaPinned)
+{
+    auto options = make_options([](Options& options) {
+        options.topology().user_cpuset("0-7");
+        options.topology().restrict_gpus(true);
+        options.placement().cpu_strategy(PlacementStrategy::PerMachine);
+        options.placement().resources_strategy(PlacementResources::Shared);
+        add_engine_factory_services(options);
+
+        EngineFactoryOptions group;
+        group.engine_type   = runnable::EngineType::Fiber;
+        group.allow_overlap = false;
+        group.reusable      = false;
+        group.cpu_count     = 2;
+        group.numa_node     = 0;
+        options.engine_factories().set_engine_factory_options("numa_pinned", std::move(group));
+    });
+
+    auto topology       = make_topology(options);
+    auto partitions     = make_partitions(options);
+    const auto cpu_sets = partitions->host_partitions().at(0).engine_factory_cpu_sets();
+
+    const auto& pinned = cpu_sets.fiber_cpu_sets.at("numa_pinned");
+    EXPECT_EQ(pinned.weight(), 2);
+    EXPECT_EQ(pinned.set_intersect(topology->numa_cpuset(0)).weight(), 2);
+    EXPECT_EQ(pinned.set_intersect(cpu_sets.fiber_cpu_sets.at("default")).weight(), 0);
+
+    // pinning to a numa node which is not part of the topology is an error
+    auto invalid = make_options([&topology](Options& options) {
+        options.topology().user_cpuset("0-7");
+        options.topology().restrict_gpus(true);
+        options.placement().cpu_strategy(PlacementStrategy::PerMachine);
+
+        EngineFactoryOptions group;
+        group.cpu_count = 1;
+        group.numa_node = topology->numa_count();
+        options.engine_factories().set_engine_factory_options("numa_pinned", std::move(group));
+    });
+
+    EXPECT_ANY_THROW(make_partitions(invalid));
+}
+
+TEST_P(TestPartitions, EngineFactoryCacheDomain)
+{
+    auto options = make_options([](Options& options) {
+        options.topology().user_cpuset("0-15");
+        options.topology().restrict_gpus(true);
+        options.placement().cpu_strategy(PlacementStrategy::PerMachine);
+        options.placement().resources_strategy(PlacementResources::Shared);
+
+        EngineFactoryOptions pinned;
+        pinned.allow_overlap = false;
+        pinned.reusable      = false;
+        pinned.cpu_count     = 2;
+        pinned.cache_domain  = 1;
+        options.engine_factories().set_engine_factory_options("cache_pinned", std::move(pinned));
+
+        EngineFactoryOptions unpinned;
+        unpinned.allow_overlap = false;
+        unpinned.reusable      = false;
+        unpinned.cpu_count     = 2;
+        options.engine_factories().set_engine_factory_options("cache_local", std::move(unpinned));
+    });
+
+    auto topology       = make_topology(options);
+    auto partitions     = make_partitions(options);
+    const auto cpu_sets = partitions->host_partitions().at(0).engine_factory_cpu_sets();
+
+    ASSERT_GT(topology->cache_domain_count(), 1);
+
+    const auto& pinned = cpu_sets.fiber_cpu_sets.at("cache_pinned");
+    EXPECT_EQ(pinned.weight(), 2);
+    EXPECT_EQ(pinned.set_intersect(topology->cache_domain_cpuset(1)).weight(), 2);
+
+    // groups which are not pinned are placed within a single cache domain
+    const auto& local = cpu_sets.fiber_cpu_sets.at("cache_local");
+    EXPECT_EQ(local.weight(), 2);
+    EXPECT_EQ(local.set_intersect(pinned).weight(), 0);
+    bool single_domain = false;
+    for (int i = 0; i < topology->cache_domain_count(); i++)
+    {
+        single_domain |= (local.set_intersect(topology->cache_domain_cpuset(i)).weight() == 2);
+    }
+    EXPECT_TRUE(single_domain);
+
+    // pinning to a cache domain which is not part of the topology is an error
+    auto invalid = make_options([&topology](Options& options) {
+        options.topology().user_cpuset("0-15");
+        options.topology().restrict_gpus(true);
+        options.placement().cpu_strategy(PlacementStrategy::PerMachine);
+
+        EngineFactoryOptions group;
+        group.cpu_count    = 1;
+        group.cache_domain = topology->cache_domain_count();
+        options.engine_factories().set_engine_factory_options("cache_pinned", std::move(group));
+    });
+
+    EXPECT_ANY_THROW(make_partitions(invalid));
+}
+
+TEST_P(TestPartitions, MaxCpuCount)
+{
+    // logical cpus are kept one per core before any hyper-thread siblings
+    auto options  = make_options([](Options& options) { options.topology().max_cpu_count(6); });
+    auto topology = make_topology(options);
+    EXPECT_EQ(topology->cpu_count(), 6);
+    EXPECT_EQ(topology->cpu_set().str(), "0-5");
+
+    options  = make_options([](Options& options) { options.topology().max_cpu_count(70); });
+    topology = make_topology(options);
+    EXPECT_EQ(topology->cpu_set().str(), "0-69");
+
+    // the limit applies to the cpus left by the user cpu_set
+    options = make_options([](Options& options) {
+        options.topology().user_cpuset("0-7,64-71");
+        options.topology().max_cpu_count(10);
+    });
+    topology = make_topology(options);
+    EXPECT_EQ(topology->cpu_set().str(), "0-7,64-65");
+
+    // sizing the partitions by the limited topology
+    options = make_options([](Options& options) {
+        options.topology().max_cpu_count(8);
+        options.placement().cpu_strategy(PlacementStrategy::PerMachine);
+    });
+    auto partitions = make_partitions(options);
+    ASSERT_EQ(partitions->host_partitions().size(), 1);
+    EXPECT_EQ(partitions->host_partitions().at(0).cpu_set().weight(), 8);
+}
+
 INSTANTIATE_TEST_SUITE_P(Topos, TestPartitions, testing::Values("dgx_a100_station_topology"));
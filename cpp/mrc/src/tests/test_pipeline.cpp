@@ -18,6 +18,8 @@
 #include "nodes/common_nodes.hpp"
 #include "pipelines/common_pipelines.hpp"
 
+#include "internal/pipeline/autoscaler.hpp"
+#include "internal/pipeline/graph_optimizer.hpp"
 #include "internal/pipeline/manager.hpp"
 #include "internal/pipeline/pipeline.hpp"
 #include "internal/pipeline/types.hpp"
@@ -29,6 +31,8 @@
 
 #include "mrc/channel/channel.hpp"
 #include "mrc/channel/status.hpp"
+#include "mrc/channel/telemetry.hpp"
+#include "mrc/channel/types.hpp"
 #include "mrc/core/addresses.hpp"
 #include "mrc/core/executor.hpp"
 #include "mrc/data/reusable_pool.hpp"
@@ -38,11 +42,14 @@
 #include "mrc/node/rx_sink.hpp"
 #include "mrc/node/rx_source.hpp"
 #include "mrc/options/engine_groups.hpp"
+#include "mrc/options/manifolds.hpp"
 #include "mrc/options/options.hpp"
 #include "mrc/options/placement.hpp"
+#include "mrc/options/scaling.hpp"
 #include "mrc/options/topology.hpp"
 #include "mrc/pipeline/pipeline.hpp"
 #include "mrc/runnable/context.hpp"
+#include "mrc/runnable/launch_options.hpp"
 #include "mrc/runnable/types.hpp"
 #include "mrc/segment/builder.hpp"
 #include "mrc/segment/egress_ports.hpp"
@@ -56,6 +63,7 @@
 #include <rxcpp/rx.hpp>
 
 #include <array>
+#include <atomic>
 #include <chrono>
 #include <cstddef>
 #include <functional>
@@ -63,7 +71,9 @@
 #include <map>
 #include <memory>
 #include <mutex>
+#include <optional>
 #include <ostream>
+#include <set>
 #include <stdexcept>
 #include <string>
 #include <system_error>
@@ -97,11 +107,13 @@ static std::shared_ptr<internal::pipeline::Pipeline> unwrap(internal::pipeline::
 
 static void run_custom_manager(std::unique_ptr<internal::pipeline::IPipeline> pipeline,
                                internal::pipeline::SegmentAddresses&& update,
-                               bool delayed_stop = false)
+                               bool delayed_stop                = false,
+                               const ManifoldOptions& manifolds = {})
 {
-    auto resources = internal::resources::Manager(internal::system::SystemProvider(make_system([](Options& options) {
+    auto resources = internal::resources::Manager(internal::system::SystemProvider(make_system([&](Options& options) {
         options.topology().user_cpuset("0-1");
         options.topology().restrict_gpus(true);
+        options.manifolds() = manifolds;
     })));
 
     auto manager = std::make_unique<internal::pipeline::Manager>(unwrap(*pipeline), resources);
@@ -245,6 +257,33 @@ TEST_F(TestPipeline, ExecutorLifeCycle)
     executor.join();
 }
 
+// pipelines share the resources of one executor and are started and joined independently of each other
+TEST_F(TestPipeline, MultiplePipelines)
+{
+    auto options = std::make_shared<Options>();
+    options->topology().user_cpuset("0-1");
+    options->topology().restrict_gpus(true);
+
+    Executor executor(options);
+    auto first  = executor.register_pipeline(test::pipelines::finite_single_segment());
+    auto second = executor.register_pipeline(test::pipelines::finite_multisegment());
+    EXPECT_NE(first, second);
+    EXPECT_EQ(executor.pipeline_count(), 2);
+
+    executor.start();
+
+    // registered while the executor is running, so started immediately
+    auto third = executor.register_pipeline(test::pipelines::finite_single_segment());
+    EXPECT_EQ(executor.pipeline_count(), 3);
+
+    executor.join_pipeline(third);
+    EXPECT_EQ(executor.pipeline_count(), 2);
+    EXPECT_ANY_THROW(executor.join_pipeline(third));
+
+    executor.join();
+    EXPECT_EQ(executor.pipeline_count(), 0);
+}
+
 TEST_F(TestPipeline, MultiSegment)
 {
     auto options = std::make_shared<Options>();
@@ -257,7 +296,8 @@ TEST_F(TestPipeline, MultiSegment)
     executor.join();
 }
 
-TEST_F(TestPipeline, MultiSegmentLoadBalancer)
+static void run_load_balanced_segments(const ManifoldOptions& manifolds,
+                                       const std::optional<runnable::LaunchOptions>& launch_options = std::nullopt)
 {
     // the default connection/manifold type between segments is a load balancer
     // this test we create one copy of our source segment (seg_1) and two copies of our sink segment (seg_2)
@@ -286,13 +326,18 @@ TEST_F(TestPipeline, MultiSegmentLoadBalancer)
         s.make_edge(ingress, sink);
     });
 
+    if (launch_options)
+    {
+        pipeline->set_manifold_launch_options("i", *launch_options);
+    }
+
     // run 1 copy of seg_1 and 2 copies of seg_2 all on parition 0
     internal::pipeline::SegmentAddresses update;
     update[segment_address_encode(segment_name_hash("seg_1"), 0)] = 0;
     update[segment_address_encode(segment_name_hash("seg_2"), 0)] = 0;
     update[segment_address_encode(segment_name_hash("seg_2"), 1)] = 0;
 
-    run_custom_manager(std::move(pipeline), std::move(update));
+    run_custom_manager(std::move(pipeline), std::move(update), false, manifolds);
 
     std::map<boost::fibers::fiber::id, int> count_by_rank;
 
@@ -305,6 +350,172 @@ TEST_F(TestPipeline, MultiSegmentLoadBalancer)
     EXPECT_EQ(count_by_rank.size(), 2);
 }
 
+static void run_load_balanced_segments(EgressPolicy egress_policy)
+{
+    ManifoldOptions manifolds;
+    manifolds.set_default_egress_policy(egress_policy);
+    run_load_balanced_segments(manifolds);
+}
+
+TEST_F(TestPipeline, MultiSegmentLoadBalancer)
+{
+    run_load_balanced_segments(EgressPolicy::RoundRobin);
+}
+
+TEST_F(TestPipeline, MultiSegmentShortestQueue)
+{
+    // idle sinks are tied at an empty queue, so writes still spread round robin across both copies
+    run_load_balanced_segments(EgressPolicy::ShortestQueue);
+}
+
+TEST_F(TestPipeline, MultiSegmentPowerOfTwoChoices)
+{
+    run_load_balanced_segments(EgressPolicy::PowerOfTwoChoices);
+}
+
+TEST_F(TestPipeline, MultiSegmentLocalityFirst)
+{
+    // both copies share the partition of the manifold, so neither spills and writes spread across both
+    run_load_balanced_segments(EgressPolicy::LocalityFirst);
+}
+
+// runs one copy of seg_1 and two copies of seg_2, the first of which processes each element slowly; returns the
+// number of elements received by the slow and the fast copy
+static std::pair<std::size_t, std::size_t> run_backed_up_segments(EgressPolicy egress_policy)
+{
+    auto pipeline = pipeline::make_pipeline();
+
+    int count = 2000;
+    std::atomic<std::size_t> copies{0};
+    std::atomic<std::size_t> slow_count{0};
+    std::atomic<std::size_t> fast_count{0};
+
+    pipeline->make_segment("seg_1", segment::EgressPorts<int>({"i"}), [count](segment::Builder& s) {
+        auto src    = s.make_object("src", test::nodes::finite_int_rx_source(count));
+        auto egress = s.get_egress<int>("i");
+        s.make_edge(src, egress);
+    });
+
+    pipeline->make_segment("seg_2", segment::IngressPorts<int>({"i"}), [&](segment::Builder& s) {
+        const bool slow = (copies++ == 0);
+        auto sink       = s.make_sink<int>("sink", [slow, &slow_count, &fast_count](int x) {
+            if (slow)
+            {
+                boost::this_fiber::sleep_for(std::chrono::milliseconds(1));
+                ++slow_count;
+            }
+            else
+            {
+                ++fast_count;
+            }
+        });
+        auto ingress    = s.get_ingress<int>("i");
+        s.make_edge(ingress, sink);
+    });
+
+    internal::pipeline::SegmentAddresses update;
+    update[segment_address_encode(segment_name_hash("seg_1"), 0)] = 0;
+    update[segment_address_encode(segment_name_hash("seg_2"), 0)] = 0;
+    update[segment_address_encode(segment_name_hash("seg_2"), 1)] = 0;
+
+    ManifoldOptions manifolds;
+    manifolds.set_default_egress_policy(egress_policy);
+    run_custom_manager(std::move(pipeline), std::move(update), false, manifolds);
+
+    EXPECT_EQ(copies.load(), 2);
+    EXPECT_EQ(slow_count.load() + fast_count.load(), count);
+    return {slow_count.load(), fast_count.load()};
+}
+
+TEST_F(TestPipeline, MultiSegmentShortestQueueBackedUp)
+{
+    // once the channels of the slow copy fill up, every element goes to the fast copy
+    auto [slow, fast] = run_backed_up_segments(EgressPolicy::ShortestQueue);
+    EXPECT_GT(fast, 3 * slow);
+}
+
+TEST_F(TestPipeline, MultiSegmentPowerOfTwoChoicesBackedUp)
+{
+    // with two copies both are sampled for every element, so the less occupied fast copy is chosen
+    auto [slow, fast] = run_backed_up_segments(EgressPolicy::PowerOfTwoChoices);
+    EXPECT_GT(fast, 3 * slow);
+}
+
+TEST_F(TestPipeline, MultiSegmentLocalityFirstBackedUp)
+{
+    // both copies are local, so the least occupied of them is chosen
+    auto [slow, fast] = run_backed_up_segments(EgressPolicy::LocalityFirst);
+    EXPECT_GT(fast, 3 * slow);
+}
+
+TEST_F(TestPipeline, MultiSegmentHedged)
+{
+    // the idle sinks dequeue well within the minimum delay, so elements are tracked but never hedged and each element
+    // is seen exactly once
+    ManifoldOptions manifolds;
+    HedgeOptions hedge;
+    hedge.min_delay = std::chrono::seconds(10);
+    hedge.warmup    = 8;
+    manifolds.set_default_egress_policy(EgressPolicy::Hedged);
+    manifolds.set_hedge_options(hedge);
+    run_load_balanced_segments(manifolds);
+}
+
+TEST_F(TestPipeline, ManifoldLaunchOptions)
+{
+    // launch options of the pipeline definition take precedence over Options::manifolds()
+    ManifoldOptions manifolds;
+    manifolds.set_launch_options("i", runnable::LaunchOptions("main", 1, 4));
+    run_load_balanced_segments(manifolds);
+    run_load_balanced_segments(manifolds, runnable::LaunchOptions("main", 1, 2));
+}
+
+TEST_F(TestPipeline, MultiSegmentBatchedLoadBalancer)
+{
+    ManifoldOptions manifolds;
+    manifolds.set_batch_size(16);
+    manifolds.set_batch_window(std::chrono::microseconds(100));
+    run_load_balanced_segments(manifolds);
+}
+
+static std::size_t run_linear_segments(const ManifoldOptions& manifolds)
+{
+    auto pipeline = pipeline::make_pipeline();
+
+    int count = 1000;
+    std::atomic<std::size_t> received{0};
+
+    pipeline->make_segment("seg_1", segment::EgressPorts<int>({"i"}), [count](segment::Builder& s) {
+        auto src    = s.make_object("src", test::nodes::finite_int_rx_source(count));
+        auto egress = s.get_egress<int>("i");
+        s.make_edge(src, egress);
+    });
+
+    pipeline->make_segment("seg_2", segment::IngressPorts<int>({"i"}), [&received](segment::Builder& s) {
+        auto sink    = s.make_sink<int>("sink", [&received](int x) { ++received; });
+        auto ingress = s.get_ingress<int>("i");
+        s.make_edge(ingress, sink);
+    });
+
+    internal::pipeline::SegmentAddresses update;
+    update[segment_address_encode(segment_name_hash("seg_1"), 0)] = 0;
+    update[segment_address_encode(segment_name_hash("seg_2"), 0)] = 0;
+
+    run_custom_manager(std::move(pipeline), std::move(update), false, manifolds);
+
+    return received.load();
+}
+
+TEST_F(TestPipeline, DirectConnection)
+{
+    // a single copy of each segment connects port "i" directly; disabling direct connections uses a load balancer
+    ManifoldOptions manifolds;
+    EXPECT_EQ(run_linear_segments(manifolds), 1000);
+
+    manifolds.set_enable_direct_connections(false);
+    EXPECT_EQ(run_linear_segments(manifolds), 1000);
+}
+
 TEST_F(TestPipeline, UnmatchedIngress)
 {
     std::function<void(mrc::segment::Builder&)> init = [](mrc::segment::Builder& builder) {};
@@ -358,6 +569,58 @@ TEST_F(TestPipeline, RequiresMoreManifolds)
     EXPECT_ANY_THROW(exec1.register_pipeline(std::move(pipe)));
 }
 
+TEST_F(TestPipeline, GraphOptimizer)
+{
+    std::function<void(mrc::segment::Builder&)> init = [](mrc::segment::Builder& builder) {};
+
+    auto pipe = pipeline::make_pipeline();
+
+    // a source -> relay -> sink chain on ports a and b, and an unrelated standalone segment
+    pipe->make_segment("source", segment::EgressPorts<int>({"a"}), init);
+    pipe->make_segment("relay", segment::IngressPorts<int>({"a"}), segment::EgressPorts<int>({"b"}), init);
+    pipe->make_segment("sink", segment::IngressPorts<int>({"b"}), init);
+    pipe->make_segment("standalone", init);
+
+    pipe->set_port_rate("a", 1e6);
+    pipe->set_port_rate("b", 10);
+
+    auto definition = unwrap(*pipe);
+
+    ManifoldOptions manifolds;
+    internal::pipeline::GraphOptimizer optimizer(*definition, manifolds, 2);
+
+    ASSERT_EQ(optimizer.coupled_groups().size(), 2);
+    EXPECT_EQ(optimizer.coupled_groups().at(0), (std::set<std::string>{"relay", "sink", "source"}));
+    EXPECT_EQ(optimizer.relay_segments(), std::set<std::string>{"relay"});
+
+    // the chain stays together, the standalone segment is placed on the other partition
+    const auto& offsets = optimizer.partition_offsets();
+    EXPECT_EQ(offsets.at("source"), 0);
+    EXPECT_EQ(offsets.at("relay"), 0);
+    EXPECT_EQ(offsets.at("sink"), 0);
+    EXPECT_EQ(offsets.at("standalone"), 1);
+
+    EXPECT_EQ(optimizer.egress_policies().at("a"), EgressPolicy::LocalityFirst);
+    EXPECT_EQ(optimizer.egress_policies().at("b"), EgressPolicy::ShortestQueue);
+
+    // a single partition has no locality to exploit
+    EXPECT_EQ(internal::pipeline::GraphOptimizer::egress_policy_for({.elements_per_second = 1e6}, 1),
+              EgressPolicy::PowerOfTwoChoices);
+
+    // a few large elements per second still make a high rate port
+    runnable::CostHints large_elements{.elements_per_second = 10, .bytes_per_second = 1e10};
+    EXPECT_EQ(internal::pipeline::GraphOptimizer::egress_policy_for(large_elements, 2), EgressPolicy::LocalityFirst);
+
+    // port specific policies of the options take precedence over declared rates
+    manifolds.set_egress_policy("a", EgressPolicy::RoundRobin);
+    internal::pipeline::GraphOptimizer with_policy(*definition, manifolds, 2);
+    EXPECT_FALSE(with_policy.egress_policies().contains("a"));
+
+    optimizer.apply(*definition);
+    EXPECT_EQ(definition->partition_offset("standalone"), 1);
+    EXPECT_EQ(definition->egress_policies().at("b"), EgressPolicy::ShortestQueue);
+}
+
 class Buffer
 {
   public:
@@ -544,3 +807,228 @@ TEST_F(TestPipeline, EngineFactories)
     executor.start();
     executor.join();
 }
+
+// warm segments are built after each update without being started; a scale out takes them over and warm segments
+// which no longer fall within the pool are released
+TEST_F(TestPipeline, WarmSegmentPool)
+{
+    auto pipeline = pipeline::make_pipeline();
+
+    std::atomic<std::size_t> constructed{0};
+    std::atomic<std::size_t> started{0};
+    auto released = std::make_shared<std::atomic<std::size_t>>(0);
+
+    pipeline->make_segment("seg_1", [&constructed, &started, released](segment::Builder& s) {
+        ++constructed;
+
+        // counts the segment as released once its nodes are destroyed
+        std::shared_ptr<void> tracker(nullptr, [released](void* /*unused*/) { ++(*released); });
+
+        auto src  = s.make_source<int>("src", [&started](rxcpp::subscriber<int>& sub) {
+            ++started;
+            while (sub.is_subscribed())
+            {
+                boost::this_fiber::sleep_for(std::chrono::milliseconds(1));
+            }
+            sub.on_completed();
+        });
+        auto sink = s.make_sink<int>("sink", [tracker](int x) {});
+        s.make_edge(src, sink);
+    });
+
+    auto resources = internal::resources::Manager(internal::system::SystemProvider(make_system([](Options& options) {
+        options.topology().user_cpuset("0");
+        options.topology().restrict_gpus(true);
+        options.scaling().set_default_options(SegmentScalingOptions().warm_pool_size(2));
+    })));
+
+    auto manager = std::make_unique<internal::pipeline::Manager>(unwrap(*pipeline), resources);
+
+    // updates are applied asynchronously by the controller
+    auto await_counts = [&](std::size_t constructed_count, std::size_t started_count, std::size_t released_count) {
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+        while ((constructed.load() != constructed_count || started.load() != started_count ||
+                released->load() != released_count) &&
+               std::chrono::steady_clock::now() < deadline)
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        EXPECT_EQ(constructed.load(), constructed_count);
+        EXPECT_EQ(started.load(), started_count);
+        EXPECT_EQ(released->load(), released_count);
+    };
+
+    auto address = [](SegmentRank rank) {
+        return segment_address_encode(segment_name_hash("seg_1"), rank);
+    };
+
+    manager->service_start();
+
+    // rank 0 is started; ranks 1 and 2 are built warm
+    manager->push_updates({{address(0), 0}});
+    await_counts(3, 1, 0);
+
+    // rank 1 takes over its warm segment instead of being built; rank 3 is built warm to refill the pool
+    manager->push_updates({{address(0), 0}, {address(1), 0}});
+    await_counts(4, 2, 0);
+
+    // the retired rank 1 is rebuilt warm as one of the two lowest free ranks; rank 3 falls out of the pool and is
+    // released along with the retired segment
+    manager->push_updates({{address(0), 0}});
+    await_counts(5, 2, 2);
+
+    manager->service_stop();
+    manager->service_await_join();
+}
+
+struct DrainResult
+{
+    std::size_t emitted{0};
+    std::size_t received{0};
+    std::chrono::milliseconds elapsed{0};
+};
+
+// removes a segment with an endless source while its sink, which takes element_delay per element, is backed up;
+// elapsed is the time from the removal until the pipeline has joined
+static DrainResult run_drained_segment(std::chrono::milliseconds element_delay, std::chrono::milliseconds timeout)
+{
+    auto pipeline = pipeline::make_pipeline();
+
+    std::atomic<std::size_t> emitted{0};
+    std::atomic<std::size_t> received{0};
+
+    pipeline->make_segment("seg_1", [&emitted, &received, element_delay](segment::Builder& s) {
+        auto src  = s.make_source<int>("src", [&emitted](rxcpp::subscriber<int>& sub) {
+            while (sub.is_subscribed())
+            {
+                sub.on_next(static_cast<int>(emitted.load()));
+                ++emitted;
+            }
+            sub.on_completed();
+        });
+        auto sink = s.make_sink<int>("sink", [&received, element_delay](int x) {
+            boost::this_fiber::sleep_for(element_delay);
+            ++received;
+        });
+        s.make_edge(src, sink);
+    });
+
+    auto resources = internal::resources::Manager(internal::system::SystemProvider(make_system([&](Options& options) {
+        options.topology().user_cpuset("0");
+        options.topology().restrict_gpus(true);
+        options.scaling().set_default_options(SegmentScalingOptions().drain_timeout(timeout));
+    })));
+
+    auto manager = std::make_unique<internal::pipeline::Manager>(unwrap(*pipeline), resources);
+
+    internal::pipeline::SegmentAddresses update;
+    update[segment_address_encode(segment_name_hash("seg_1"), 0)] = 0;
+
+    manager->service_start();
+    manager->push_updates(std::move(update));
+
+    // wait for the channel of the sink to back up
+    while (received.load() < 10)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    manager->push_updates({});
+    manager->service_stop();
+    manager->service_await_join();
+
+    DrainResult result;
+    result.emitted  = emitted.load();
+    result.received = received.load();
+    result.elapsed  = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start);
+    return result;
+}
+
+// segments retired with a drain timeout stop their sources and flush the data already emitted before completing
+TEST_F(TestPipeline, DrainTimeout)
+{
+    auto result = run_drained_segment(std::chrono::milliseconds(1), std::chrono::seconds(10));
+
+    EXPECT_GT(result.emitted, 10);
+    EXPECT_EQ(result.received, result.emitted);
+    EXPECT_LT(result.elapsed, std::chrono::seconds(10));
+}
+
+// segments which do not flush their data within the drain timeout are killed once it has expired
+TEST_F(TestPipeline, DrainTimeoutExceeded)
+{
+    // the backed up channel of the sink needs several seconds to flush
+    auto result = run_drained_segment(std::chrono::milliseconds(50), std::chrono::milliseconds(200));
+
+    EXPECT_LT(result.received, result.emitted);
+    EXPECT_GE(result.elapsed, std::chrono::milliseconds(200));
+    EXPECT_LT(result.elapsed, std::chrono::seconds(2));
+}
+
+TEST_F(TestPipeline, AutoscalerTargetCount)
+{
+    auto options = internal::pipeline::Autoscaler::encode(SegmentScalingOptions()
+                                                              .strategy(ScalingStrategy::Dynamic)
+                                                              .min_count(1)
+                                                              .max_count(4)
+                                                              .scale_up_queue_depth(16)
+                                                              .scale_down_queue_depth(2)
+                                                              .instance_throughput(100));
+
+    using internal::pipeline::Autoscaler;
+
+    // backed up ingress queues add an instance, bounded by max_count
+    EXPECT_EQ(Autoscaler::target_count(options, 2, 40, 0), 3);
+    EXPECT_EQ(Autoscaler::target_count(options, 4, 400, 0), 4);
+
+    // idle queues drain an instance only if the remaining instances carry the throughput
+    EXPECT_EQ(Autoscaler::target_count(options, 3, 2, 150), 2);
+    EXPECT_EQ(Autoscaler::target_count(options, 3, 2, 250), 3);
+    EXPECT_EQ(Autoscaler::target_count(options, 1, 0, 0), 1);
+
+    // out of bound counts are clamped
+    EXPECT_EQ(Autoscaler::target_count(options, 6, 0, 0), 4);
+    EXPECT_EQ(Autoscaler::initial_count(options), 1);
+}
+
+TEST_F(TestPipeline, AutoscalerCooldown)
+{
+    using internal::pipeline::Autoscaler;
+
+    const SegmentID id = 1;
+    auto options       = Autoscaler::encode(SegmentScalingOptions()
+                                          .strategy(ScalingStrategy::Dynamic)
+                                          .max_count(3)
+                                          .cooldown(std::chrono::seconds(10))
+                                          .scale_up_queue_depth(8));
+
+    Autoscaler autoscaler({{id, options}}, 2);
+
+    internal::pipeline::SegmentAddresses current{{segment_address_encode(id, 0), 0}};
+    std::map<SegmentAddress, channel::ChannelStatistics> ingress;
+    ingress[segment_address_encode(id, 0)].occupancy = 64;
+
+    auto start = channel::clock_t::now();
+
+    // the first sample establishes the baseline
+    EXPECT_FALSE(autoscaler.evaluate(current, ingress, start));
+    EXPECT_FALSE(autoscaler.evaluate(current, ingress, start + std::chrono::seconds(5)));
+
+    auto scaled = autoscaler.evaluate(current, ingress, start + std::chrono::seconds(10));
+    ASSERT_TRUE(scaled);
+    EXPECT_EQ(scaled->size(), 2);
+    EXPECT_EQ(scaled->at(segment_address_encode(id, 1)), 1);
+
+    // within the cooldown of the last decision
+    ingress[segment_address_encode(id, 1)].occupancy = 64;
+    EXPECT_FALSE(autoscaler.evaluate(*scaled, ingress, start + std::chrono::seconds(15)));
+
+    // idle queues drain the highest rank
+    ingress[segment_address_encode(id, 0)].occupancy = 0;
+    ingress[segment_address_encode(id, 1)].occupancy = 0;
+    auto drained = autoscaler.evaluate(*scaled, ingress, start + std::chrono::seconds(20));
+    ASSERT_TRUE(drained);
+    EXPECT_EQ(drained->size(), 1);
+    EXPECT_TRUE(drained->contains(segment_address_encode(id, 0)));
+}
@@ -20,7 +20,12 @@
 #include "internal/control_plane/client.hpp"
 #include "internal/control_plane/client/connections_manager.hpp"
 #include "internal/control_plane/client/instance.hpp"
+#include "internal/data_plane/client.hpp"
+#include "internal/data_plane/resources.hpp"
+#include "internal/data_plane/server.hpp"
+#include "internal/memory/transient_pool.hpp"
 #include "internal/network/resources.hpp"
+#include "internal/pubsub/publisher_consistent_hash.hpp"
 #include "internal/remote_descriptor/manager.hpp"
 #include "internal/remote_descriptor/storage.hpp"
 #include "internal/resources/manager.hpp"
@@ -29,23 +34,38 @@
 #include "internal/runtime/partition.hpp"
 #include "internal/runtime/runtime.hpp"
 #include "internal/system/system_provider.hpp"
+#include "internal/utils/protobuf_arena_pool.hpp"
 
 #include "mrc/codable/fundamental_types.hpp"  // IWYU pragma: keep
 #include "mrc/core/task_queue.hpp"
+#include "mrc/cuda/common.hpp"
+#include "mrc/node/edge_builder.hpp"
+#include "mrc/node/rx_sink.hpp"
 #include "mrc/options/options.hpp"
 #include "mrc/options/placement.hpp"
+#include "mrc/protos/codable.pb.h"
+#include "mrc/runnable/launch_control.hpp"
+#include "mrc/runnable/launcher.hpp"
+#include "mrc/runnable/runner.hpp"
 #include "mrc/runtime/remote_descriptor.hpp"
 #include "mrc/runtime/remote_descriptor_handle.hpp"
 #include "mrc/types.hpp"
 
 #include <boost/fiber/future/future.hpp>
 #include <boost/fiber/operations.hpp>
+#include <cuda_runtime.h>
 #include <gtest/gtest.h>
+#include <rxcpp/rx.hpp>
 
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <map>
 #include <memory>
 #include <optional>
 #include <string>
 #include <utility>
+#include <vector>
 
 using namespace mrc;
 using namespace mrc::codable;
@@ -153,3 +173,163 @@ TEST_F(TestRD, RemoteRelease)
         })
         .get();
 }
+
+TEST_F(TestRD, StreamOrderedIssue)
+{
+    if (m_runtime->resources().partition_count() < 2)
+    {
+        GTEST_SKIP() << "this test only works with 2 or more partitions";
+    }
+
+    auto f1 = m_runtime->partition(0).resources().network()->control_plane().client().connections().update_future();
+    m_runtime->partition(0).resources().network()->control_plane().client().request_update();
+    f1.get();
+
+    auto& network_0 = *m_runtime->partition(0).resources().network();
+    auto& network_1 = *m_runtime->partition(1).resources().network();
+
+    const std::uint64_t tag = 4242;
+    std::atomic<bool> received{false};
+
+    // take ownership of the received rd on partition 1 and release its tokens
+    auto recv_sink = std::make_unique<node::RxSink<internal::memory::TransientBuffer>>(
+        [&](internal::memory::TransientBuffer buffer) {
+            auto proto =
+                internal::utils::ProtobufArenaPool::global().make_message<mrc::codable::protos::RemoteDescriptor>();
+            EXPECT_TRUE(proto->ParseFromArray(buffer.data(), buffer.bytes()));
+            EXPECT_EQ(proto->instance_id(), network_0.instance_id());
+            buffer.release();
+
+            auto rd = m_runtime->partition(1).remote_descriptor_manager().make_remote_descriptor(std::move(proto));
+            EXPECT_EQ(rd.decode<std::string>(), "Hi MRC");
+            rd.release_ownership();
+
+            received = true;
+            network_1.data_plane().server().deserialize_source().drop_edge(tag);
+        });
+
+    node::make_edge(network_1.data_plane().server().deserialize_source().source(tag), *recv_sink);
+
+    auto recv_runner = m_runtime->partition(1)
+                           .resources()
+                           .runnable()
+                           .launch_control()
+                           .prepare_launcher(internal::data_plane::Resources::launch_options(1), std::move(recv_sink))
+                           ->ignition();
+
+    m_runtime->partition(0)
+        .resources()
+        .runnable()
+        .main()
+        .enqueue([&] {
+            auto& rd_manager_0 = m_runtime->partition(0).remote_descriptor_manager();
+
+            cudaStream_t stream;
+            MRC_CHECK_CUDA(cudaStreamCreateWithFlags(&stream, cudaStreamNonBlocking));
+
+            auto rd       = rd_manager_0.register_object(std::string("Hi MRC"));
+            auto endpoint = network_0.data_plane().client().endpoint_shared(network_1.instance_id());
+
+            // issued once the work of the stream completes, without synchronizing the stream
+            network_0.data_plane().client().issue_remote_descriptor({std::move(rd), std::move(endpoint), tag}, stream);
+            EXPECT_FALSE(rd);
+
+            while (rd_manager_0.size() != 0)
+            {
+                boost::this_fiber::yield();
+            }
+
+            MRC_CHECK_CUDA(cudaStreamDestroy(stream));
+        })
+        .get();
+
+    recv_runner->await_join();
+    EXPECT_TRUE(received);
+}
+
+TEST_F(TestRD, SplitAndRelease)
+{
+    m_runtime->partition(0)
+        .resources()
+        .runnable()
+        .main()
+        .enqueue([this] {
+            auto& rd_manager = m_runtime->partition(0).remote_descriptor_manager();
+
+            std::string test("Hi MRC");
+            auto rd = rd_manager.register_object(std::move(test));
+
+            bool released = false;
+            EXPECT_TRUE(rd_manager.on_release(rd, [&released] { released = true; }));
+
+            // the tokens of rd are shared by the split descriptors
+            auto rds = rd_manager.split(std::move(rd), 3);
+            EXPECT_FALSE(rd);
+            EXPECT_EQ(rds.size(), 3);
+            EXPECT_EQ(rd_manager.size(), 1);
+            EXPECT_EQ(rds[2].decode<std::string>(), "Hi MRC");
+
+            rds[0].release_ownership();
+            rds[1].release_ownership();
+            EXPECT_FALSE(released);
+            EXPECT_EQ(rd_manager.size(), 1);
+
+            // the object is destroyed and the release callback invoked with the release of the last tokens
+            rds[2].release_ownership();
+            EXPECT_TRUE(released);
+            EXPECT_EQ(rd_manager.size(), 0);
+        })
+        .get();
+}
+
+TEST_F(TestRD, RoutingKey)
+{
+    m_runtime->partition(0)
+        .resources()
+        .runnable()
+        .main()
+        .enqueue([this] {
+            auto& rd_manager = m_runtime->partition(0).remote_descriptor_manager();
+
+            auto unkeyed = rd_manager.register_object(std::string("unkeyed"));
+            EXPECT_FALSE(internal::remote_descriptor::Manager::routing_key(unkeyed));
+
+            auto keyed = rd_manager.register_encoded_object(
+                EncodedObject<std::string>::create(std::string("keyed"), rd_manager.create_storage()), 42);
+            EXPECT_EQ(internal::remote_descriptor::Manager::routing_key(keyed), 42);
+
+            // the key is carried by every split descriptor
+            auto rds = rd_manager.split(std::move(keyed), 2);
+            EXPECT_EQ(internal::remote_descriptor::Manager::routing_key(rds[1]), 42);
+        })
+        .get();
+}
+
+TEST_F(TestRD, ConsistentHashKeyMovement)
+{
+    using internal::pubsub::PublisherConsistentHash;
+
+    std::vector<std::uint64_t> tags{11, 22, 33, 44};
+    std::vector<std::uint64_t> without_33{11, 22, 44};
+
+    std::map<std::uint64_t, std::size_t> counts;
+    for (std::uint64_t key = 0; key < 4000; ++key)
+    {
+        auto tag = PublisherConsistentHash::select_subscriber(key, tags);
+        counts[tag]++;
+
+        // only the keys of the departed subscriber move
+        auto moved = PublisherConsistentHash::select_subscriber(key, without_33);
+        if (tag != 33)
+        {
+            EXPECT_EQ(moved, tag);
+        }
+    }
+
+    // keys are spread over all subscribers
+    EXPECT_EQ(counts.size(), tags.size());
+    for (const auto& [tag, count] : counts)
+    {
+        EXPECT_GT(count, 800);
+    }
+}
@@ -15,6 +15,9 @@
  * limitations under the License.
  */
 
+#include "internal/executor/metrics_server.hpp"
+#include "internal/memory/device_group.hpp"
+#include "internal/memory/device_resources.hpp"
 #include "internal/resources/forward.hpp"
 #include "internal/resources/manager.hpp"
 #include "internal/resources/partition_resources.hpp"
@@ -23,16 +26,27 @@
 #include "internal/system/system_provider.hpp"
 
 #include "mrc/core/task_queue.hpp"
+#include "mrc/memory/buffer.hpp"
+#include "mrc/metrics/registry.hpp"
 #include "mrc/options/options.hpp"
 #include "mrc/options/placement.hpp"
 #include "mrc/types.hpp"
 
 #include <boost/fiber/future/future.hpp>
+#include <cuda_runtime.h>
 #include <gtest/gtest.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
 
+#include <array>
+#include <cstddef>
 #include <functional>
 #include <memory>
+#include <numeric>
+#include <string>
 #include <utility>
+#include <vector>
 
 using namespace mrc;
 using namespace internal;
@@ -97,3 +111,91 @@ TEST_F(TestResources, GetRuntimeShared)
         })
         .get();
 }
+
+TEST_F(TestResources, MetricsServer)
+{
+    auto resources = std::make_unique<internal::resources::Manager>(internal::system::SystemProvider(make_system()));
+
+    metrics::Registry registry;
+    registry.make_gauge("mrc_test_metrics_server", {{"name", "test"}}).set(7);
+
+    internal::executor::MetricsServer server(resources->partition(0).runnable(), 0);
+    ASSERT_NE(server.port(), 0);
+
+    auto scrape = [&](const std::string& request) {
+        auto fd = ::socket(AF_INET, SOCK_STREAM, 0);
+        sockaddr_in addr{};
+        addr.sin_family      = AF_INET;
+        addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        addr.sin_port        = htons(server.port());
+        EXPECT_EQ(::connect(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)), 0);
+        EXPECT_EQ(::send(fd, request.data(), request.size(), 0), static_cast<ssize_t>(request.size()));
+
+        std::string response;
+        std::array<char, 1024> buffer{};
+        ssize_t rc;
+        while ((rc = ::recv(fd, buffer.data(), buffer.size(), 0)) > 0)
+        {
+            response.append(buffer.data(), rc);
+        }
+        ::close(fd);
+        return response;
+    };
+
+    auto response = scrape("GET /metrics HTTP/1.1\r\nHost: localhost\r\n\r\n");
+    EXPECT_EQ(response.rfind("HTTP/1.1 200 OK", 0), 0);
+    EXPECT_NE(response.find("mrc_test_metrics_server{name=\"test\"} 7"), std::string::npos);
+
+    response = scrape("GET /other HTTP/1.1\r\n\r\n");
+    EXPECT_EQ(response.rfind("HTTP/1.1 404", 0), 0);
+}
+
+TEST_F(TestResources, DeviceGroupScatterGather)
+{
+    auto resources = std::make_unique<internal::resources::Manager>(
+        internal::system::SystemProvider(make_system([](Options& options) {
+            options.placement().resources_strategy(PlacementResources::Dedicated);
+        })));
+
+    if (resources->device_count() == 0)
+    {
+        GTEST_SKIP() << "device groups require a gpu";
+    }
+
+    auto group = resources->make_device_group();
+    EXPECT_EQ(group.size(), resources->device_count());
+
+    // an uneven batch leaves the first ranks with one more element
+    const std::size_t count = 4 * group.size() + 1;
+    auto offsets            = group.shard_offsets(count);
+    ASSERT_EQ(offsets.size(), group.size() + 1);
+    EXPECT_EQ(offsets.front(), 0);
+    EXPECT_EQ(offsets.back(), count);
+    EXPECT_EQ(offsets[1], 5);
+
+    std::vector<int> input(count);
+    std::iota(input.begin(), input.end(), 0);
+    std::vector<int> output(count, -1);
+
+    resources->partition(0)
+        .runnable()
+        .main()
+        .enqueue([&] {
+            // host batch scattered onto the devices and gathered onto the first device
+            std::vector<mrc::memory::buffer> shards;
+            group.scatter(input.data(), cudaCpuDeviceId, count, sizeof(int), shards).await();
+            ASSERT_EQ(shards.size(), group.size());
+            EXPECT_EQ(shards[0].bytes(), 5 * sizeof(int));
+
+            auto gathered = group.member(0).make_buffer(count * sizeof(int));
+            group.gather(shards, gathered.data(), group.member(0).cuda_device_id()).await();
+
+            // device batch scattered peer to peer and gathered back to the host
+            std::vector<mrc::memory::buffer> peer_shards;
+            group.scatter(gathered.data(), group.member(0).cuda_device_id(), count, sizeof(int), peer_shards).await();
+            group.gather(peer_shards, output.data(), cudaCpuDeviceId).await();
+        })
+        .get();
+
+    EXPECT_EQ(output, input);
+}
@@ -16,14 +16,22 @@
  */
 
 #include "mrc/channel/status.hpp"
+#include "mrc/data/cached_reusable_pool.hpp"
+#include "mrc/data/pooled_allocator.hpp"
 #include "mrc/data/reusable_pool.hpp"
 
 #include <gtest/gtest.h>
 
 #include <atomic>
+#include <array>
 #include <cstddef>
+#include <cstdint>
 #include <memory>
+#include <optional>
+#include <set>
+#include <thread>
 #include <utility>
+#include <vector>
 
 using namespace mrc;
 
@@ -118,3 +126,173 @@ TEST_F(TestReusablePool, Immutable)
 
     EXPECT_EQ(counter, 13);
 }
+
+TEST_F(TestReusablePool, CachedCapacity)
+{
+    auto pool = data::CachedReusablePool<int>::create(4);
+
+    pool->emplace(1);
+    pool->emplace(2);
+    pool->emplace(3);
+    pool->emplace(4);
+
+    EXPECT_EQ(pool->size(), 4U);
+    EXPECT_ANY_THROW(pool->emplace(5));
+}
+
+TEST_F(TestReusablePool, CachedGrowth)
+{
+    std::atomic<std::size_t> created = 0;
+    std::atomic<std::size_t> counter = 0;
+
+    auto pool = data::CachedReusablePool<int>::create(
+        4,
+        [&] {
+            created++;
+            return std::make_unique<int>(0);
+        },
+        [&](int& i) {
+            i = 42;
+            counter++;
+        });
+
+    EXPECT_EQ(pool->size(), 0U);
+
+    {
+        std::vector<data::Reusable<int>> items;
+        for (int i = 0; i < 4; i++)
+        {
+            auto item = pool->try_item();
+            ASSERT_TRUE(item);
+            items.push_back(std::move(*item));
+        }
+
+        // at capacity with every item in use
+        EXPECT_FALSE(pool->try_item());
+        EXPECT_EQ(created, 4);
+    }
+
+    EXPECT_EQ(counter, 4);
+
+    // returned items are reused rather than allocating new ones
+    for (int i = 0; i < 10; i++)
+    {
+        auto item = pool->await_item();
+        EXPECT_EQ(*item, 42);
+    }
+    EXPECT_EQ(created, 4);
+    EXPECT_EQ(pool->size(), 4U);
+}
+
+TEST_F(TestReusablePool, CachedMultiThreaded)
+{
+    auto pool = data::CachedReusablePool<int>::create(8);
+    for (int i = 0; i < 4; i++)
+    {
+        pool->emplace(0);
+    }
+
+    // more threads than items, so threads block in await_item on items cached by the other threads
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 8; t++)
+    {
+        threads.emplace_back([pool] {
+            for (int i = 0; i < 10000; i++)
+            {
+                auto item = pool->await_item();
+                (*item)++;
+            }
+        });
+    }
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+
+    int total = 0;
+    std::vector<data::Reusable<int>> items;
+    for (int i = 0; i < 4; i++)
+    {
+        auto item = pool->try_item();
+        ASSERT_TRUE(item);
+        total += **item;
+        items.push_back(std::move(*item));
+    }
+    EXPECT_EQ(total, 80000);
+    EXPECT_FALSE(pool->try_item());
+}
+
+TEST_F(TestReusablePool, PooledShared)
+{
+    struct Message
+    {
+        Message(int v, std::atomic<int>& d) : value(v), destroyed(d) {}
+        ~Message()
+        {
+            destroyed++;
+        }
+
+        int value;
+        std::atomic<int>& destroyed;
+    };
+
+    std::atomic<int> destroyed = 0;
+
+    auto first = data::make_pooled_shared<Message>(42, destroyed);
+    EXPECT_EQ(first->value, 42);
+    const auto* address = first.get();
+    first.reset();
+    EXPECT_EQ(destroyed, 1);
+
+    // a block freed by its owning thread is the next one handed out
+    auto second = data::make_pooled_shared<Message>(7, destroyed);
+    EXPECT_EQ(second.get(), address);
+
+    // arrays and large objects are not served from slabs
+    auto large = data::make_pooled_shared<std::array<std::byte, 4096>>();
+    EXPECT_TRUE(large);
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(second.get()) % alignof(Message), 0);
+}
+
+TEST_F(TestReusablePool, PooledSharedRemoteFree)
+{
+    constexpr int Count = 100000;
+
+    // objects allocated by one thread and destroyed by another are recycled by the allocating thread
+    std::vector<std::shared_ptr<std::uint64_t>> messages;
+    messages.reserve(Count);
+    std::thread producer([&] {
+        for (int i = 0; i < Count; i++)
+        {
+            messages.push_back(data::make_pooled_shared<std::uint64_t>(i));
+        }
+    });
+    producer.join();
+
+    std::set<const std::uint64_t*> addresses;
+    std::thread consumer([&] {
+        std::uint64_t sum = 0;
+        for (auto& message : messages)
+        {
+            sum += *message;
+            addresses.insert(message.get());
+            message.reset();
+        }
+        EXPECT_EQ(sum, std::uint64_t(Count) * (Count - 1) / 2);
+    });
+    consumer.join();
+
+    // the heap of the exited producer is adopted; past the unused tail of its last slab, the blocks freed remotely
+    // are handed out again
+    std::thread reuser([&] {
+        std::size_t fresh = 0;
+        for (int i = 0; i < Count; i++)
+        {
+            messages[i] = data::make_pooled_shared<std::uint64_t>(i);
+            fresh += (addresses.contains(messages[i].get()) ? 0 : 1);
+        }
+        messages.clear();
+        EXPECT_LT(fresh, 64 * 1024 / 24);
+    });
+    reuser.join();
+}
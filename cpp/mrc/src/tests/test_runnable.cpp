@@ -29,6 +29,7 @@
 #include "mrc/runnable/launch_control.hpp"
 #include "mrc/runnable/launch_options.hpp"
 #include "mrc/runnable/launcher.hpp"
+#include "mrc/runnable/run_to_completion.hpp"
 #include "mrc/runnable/runnable.hpp"
 #include "mrc/runnable/runner.hpp"
 #include "mrc/runnable/thread_context.hpp"
@@ -38,17 +39,22 @@
 #include <boost/fiber/operations.hpp>
 #include <glog/logging.h>
 #include <gtest/gtest.h>
+#include <sched.h>
 
+#include <array>
 #include <atomic>
 #include <chrono>
 #include <cstddef>
 #include <functional>
 #include <memory>
+#include <mutex>
+#include <set>
 #include <sstream>
 #include <string>
 #include <thread>
 #include <type_traits>
 #include <utility>
+#include <vector>
 
 using namespace mrc;
 
@@ -78,6 +84,7 @@ class TestRunnable : public ::testing::Test
                     options.engine_type   = runnable::EngineType::Thread;
                     options.allow_overlap = false;
                     options.cpu_count     = 2;
+                    options.cost_class    = runnable::CostClass::Io;
                 });
             })));
 
@@ -142,6 +149,89 @@ class TestThreadRunnable final : public runnable::ThreadRunnable<>
     }
 };
 
+// records the engine type and the cpu of each engine running it
+template <typename RunnableT>
+class TestRecordingRunnable final : public RunnableT
+{
+  public:
+    struct Record
+    {
+        runnable::EngineType engine_type;
+        int cpu;
+    };
+
+    std::mutex mutex;
+    std::vector<Record> records;
+
+  private:
+    using State = runnable::Runnable::State;
+
+    void run(typename RunnableT::ContextType& ctx) final
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            records.push_back({ctx.execution_context(), sched_getcpu()});
+        }
+        while (this->state() == State::Run)
+        {
+            boost::this_fiber::sleep_for(std::chrono::milliseconds(10));
+        }
+    }
+};
+
+class TestStandbyRunnable final : public runnable::RunnableWithContext<>
+{
+  public:
+    std::array<std::atomic<std::size_t>, 4> counts{};
+
+  private:
+    void run(ContextType& ctx) final
+    {
+        while (state() == State::Run)
+        {
+            if (ctx.is_active())
+            {
+                ++counts.at(ctx.rank());
+                boost::this_fiber::sleep_for(std::chrono::milliseconds(1));
+            }
+            else
+            {
+                ctx.await_active(std::chrono::milliseconds(10));
+            }
+        }
+    }
+};
+
+class TestCountingPollable final : public runnable::Pollable
+{
+  public:
+    TestCountingPollable(std::size_t limit) : m_limit(limit) {}
+
+    std::atomic<std::size_t> count{0};
+    std::atomic<std::thread::id> thread_id{};
+
+  private:
+    runnable::PollStatus poll() final
+    {
+        thread_id = std::this_thread::get_id();
+        if (count == m_limit)
+        {
+            return runnable::PollStatus::Done;
+        }
+        // idle on every other poll to exercise the back off
+        m_idle = !m_idle;
+        if (m_idle)
+        {
+            return runnable::PollStatus::Idle;
+        }
+        ++count;
+        return runnable::PollStatus::Progress;
+    }
+
+    const std::size_t m_limit;
+    bool m_idle{false};
+};
+
 TEST_F(TestRunnable, TypeTraitsGeneric)
 {
     using ctx_t = runnable::runnable_context_t<TestGenericRunnable>;
@@ -200,6 +290,80 @@ TEST_F(TestRunnable, GenericRunnableRunWithFiber)
     EXPECT_EQ(counter, 3 * main.pe_count * main.engines_per_pe);
 }
 
+TEST_F(TestRunnable, RunnerCompletionCallback)
+{
+    runnable::LaunchOptions factory;
+    factory.engine_factory_name = "default";
+    factory.pe_count            = 2;
+    factory.engines_per_pe      = 4;
+
+    std::atomic<std::size_t> completions = 0;
+    auto launcher = m_resources->launch_control().prepare_launcher(factory, std::make_unique<TestGenericRunnable>());
+    launcher->apply([&completions](runnable::Runner& runner) {
+        runner.on_completion_callback([&completions](bool ok) {
+            EXPECT_TRUE(ok);
+            ++completions;
+        });
+    });
+
+    auto runner = launcher->ignition();
+    runner->await_live();
+    EXPECT_EQ(runner->instances().size(), factory.pe_count * factory.engines_per_pe);
+    runner->stop();
+    runner->await_join();
+    EXPECT_EQ(completions, 1U);
+
+    // a callback added after completion is invoked immediately
+    auto late_runner =
+        m_resources->launch_control().prepare_launcher(factory, std::make_unique<TestGenericRunnable>())->ignition();
+    late_runner->await_live();
+    late_runner->stop();
+    late_runner->await_join();
+    late_runner->on_completion_callback([&completions](bool ok) {
+        EXPECT_TRUE(ok);
+        ++completions;
+    });
+    EXPECT_EQ(completions, 2U);
+}
+
+TEST_F(TestRunnable, RunnerStandbyInstances)
+{
+    runnable::LaunchOptions factory;
+    factory.engine_factory_name = "default";
+    factory.pe_count            = 2;
+    factory.engines_per_pe      = 2;
+
+    auto runnable = std::make_unique<TestStandbyRunnable>();
+    auto& counts  = runnable->counts;
+    auto launcher = m_resources->launch_control().prepare_launcher(factory, std::move(runnable));
+    launcher->apply([](runnable::Runner& runner) { runner.set_active_instances(2); });
+
+    auto runner = launcher->ignition();
+    runner->await_live();
+    EXPECT_EQ(runner->active_instances(), 2U);
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    EXPECT_GT(counts[1], 0U);
+    EXPECT_EQ(counts[2], 0U);
+    EXPECT_EQ(counts[3], 0U);
+
+    // scale up the running instances
+    runner->set_active_instances(4);
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    EXPECT_GT(counts[3], 0U);
+
+    // and back down
+    runner->set_active_instances(1);
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    std::size_t standby_count = counts[3];
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    EXPECT_EQ(counts[3], standby_count);
+
+    // standby instances are released by stop
+    runner->stop();
+    runner->await_join();
+}
+
 TEST_F(TestRunnable, GenericRunnableRunWithLaunchControl)
 {
     auto runnable = std::make_unique<TestGenericRunnable>();
@@ -227,6 +391,35 @@ TEST_F(TestRunnable, GenericRunnableRunWithThread)
     runner->await_join();
 }
 
+TEST_F(TestRunnable, RunToCompletion)
+{
+    runnable::LaunchOptions thread_pool;
+    thread_pool.engine_factory_name = "thread_pool";
+    thread_pool.pe_count            = 2;
+
+    std::vector<std::shared_ptr<TestCountingPollable>> pollables;
+    std::vector<std::shared_ptr<runnable::Pollable>> base;
+    for (int i = 0; i < 4; ++i)
+    {
+        pollables.push_back(std::make_shared<TestCountingPollable>(1000));
+        base.push_back(pollables.back());
+    }
+
+    auto runnable = std::make_unique<runnable::RunToCompletion>(std::move(base));
+    auto runner   = m_resources->launch_control().prepare_launcher(thread_pool, std::move(runnable))->ignition();
+    runner->await_join();
+
+    for (const auto& pollable : pollables)
+    {
+        EXPECT_EQ(pollable->count, 1000U);
+    }
+
+    // pollables are assigned round-robin to the cores, each of which polls its own pollables in turn
+    EXPECT_EQ(pollables[0]->thread_id.load(), pollables[2]->thread_id.load());
+    EXPECT_EQ(pollables[1]->thread_id.load(), pollables[3]->thread_id.load());
+    EXPECT_NE(pollables[0]->thread_id.load(), pollables[1]->thread_id.load());
+}
+
 TEST_F(TestRunnable, FiberRunnable)
 {
     runnable::LaunchOptions factory;
@@ -254,6 +447,56 @@ TEST_F(TestRunnable, FiberRunnableMisMatch)
     EXPECT_DEATH(auto launcher = m_resources->launch_control().prepare_launcher(factory, std::move(runnable)), "");
 }
 
+TEST_F(TestRunnable, CostHintsSelectEngineGroup)
+{
+    using thread_runnable_t = TestRecordingRunnable<runnable::ThreadRunnable<>>;
+    using fiber_runnable_t  = TestRecordingRunnable<runnable::FiberRunnable<>>;
+
+    auto launch = [this](const runnable::LaunchOptions& options, auto runnable) {
+        auto* observed = runnable.get();
+        auto runner    = m_resources->launch_control().prepare_launcher(options, std::move(runnable))->ignition();
+        runner->await_live();
+
+        // each engine records itself when it begins to run
+        auto recorded = [observed, &options] {
+            std::lock_guard<std::mutex> lock(observed->mutex);
+            return observed->records.size() == options.pe_count;
+        };
+        while (!recorded())
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        runner->stop();
+        runner->await_join();
+        return observed->records;
+    };
+
+    // the thread runnable can not run on the default fiber engine factory; its cost class selects the thread pool
+    runnable::LaunchOptions io_bound;
+    io_bound.pe_count              = 2;
+    io_bound.cost_hints.cost_class = runnable::CostClass::Io;
+
+    auto thread_records = launch(io_bound, std::make_unique<thread_runnable_t>());
+
+    // no group serving the cost class can run a fiber runnable, which stays on the default engine factory
+    auto fiber_records = launch(io_bound, std::make_unique<fiber_runnable_t>());
+
+    // the thread pool does not overlap the default engine factory, so the cpus tell the engine groups apart
+    std::set<int> thread_cpus;
+    for (const auto& record : thread_records)
+    {
+        EXPECT_EQ(record.engine_type, runnable::EngineType::Thread);
+        thread_cpus.insert(record.cpu);
+    }
+    EXPECT_EQ(thread_cpus.size(), 2);
+
+    for (const auto& record : fiber_records)
+    {
+        EXPECT_EQ(record.engine_type, runnable::EngineType::Fiber);
+        EXPECT_FALSE(thread_cpus.contains(record.cpu)) << "fiber runnable ran on cpu " << record.cpu;
+    }
+}
+
 TEST_F(TestRunnable, RunnerOutOfScope)
 {
     runnable::LaunchOptions factory;
@@ -15,33 +15,62 @@
  * limitations under the License.
  */
 
+#include "internal/system/engine_factory_cpu_sets.hpp"
 #include "internal/system/fiber_pool.hpp"
+#include "internal/system/fiber_priority_scheduler.hpp"
+#include "internal/system/host_partition.hpp"
+#include "internal/system/partitions.hpp"
 #include "internal/system/resources.hpp"
 #include "internal/system/system.hpp"
 #include "internal/system/system_provider.hpp"
 #include "internal/system/thread.hpp"
 #include "internal/system/thread_pool.hpp"
+#include "internal/system/thread_scheduling.hpp"
 #include "internal/system/topology.hpp"
 
+#include "mrc/benchmarking/fiber_tracer.hpp"
+#include "mrc/channel/buffered_channel.hpp"
+#include "mrc/channel/telemetry.hpp"
 #include "mrc/core/bitmap.hpp"
+#include "mrc/core/fiber_meta_data.hpp"
+#include "mrc/core/fiber_stack_pool.hpp"
+#include "mrc/core/time_slice.hpp"
+#include "mrc/coroutines/sync_wait.hpp"
+#include "mrc/coroutines/thread_pool.hpp"
+#include "mrc/options/engine_groups.hpp"
 #include "mrc/options/options.hpp"
 #include "mrc/options/topology.hpp"
+#include "mrc/runnable/types.hpp"
 #include "mrc/types.hpp"
 #include "mrc/utils/thread_local_shared_pointer.hpp"
 
+#include <boost/fiber/buffered_channel.hpp>
+#include <boost/fiber/channel_op_status.hpp>
 #include <boost/fiber/future/async.hpp>
 #include <boost/fiber/future/future.hpp>
 #include <boost/fiber/operations.hpp>
 #include <glog/logging.h>
 #include <gtest/gtest.h>
+#include <nlohmann/json.hpp>
+#include <pthread.h>
+#include <sched.h>
+#include <sys/resource.h>
 
+#include <algorithm>
 #include <atomic>
+#include <cerrno>
 #include <chrono>
 #include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
 #include <functional>
+#include <map>
 #include <memory>
+#include <mutex>
 #include <ostream>
 #include <set>
+#include <string>
 #include <thread>
 #include <vector>
 
@@ -136,6 +165,99 @@ TEST_F(TestSystem, FiberPool)
     EXPECT_EQ(s0.size(), 1);
 }
 
+TEST_F(TestSystem, FiberTaskQueueSubmission)
+{
+    auto system = system::make_system(make_options([](Options& options) {
+        options.topology().user_cpuset("0-1");
+        options.topology().restrict_gpus(true);
+    }));
+
+    system::Resources resources((system::SystemProvider(system)));
+    auto pool   = resources.make_fiber_pool(CpuSet("0"));
+    auto& queue = pool.task_queue(0);
+
+    // concurrent producers, with more tasks than a single drained batch
+    constexpr int producer_count = 4;
+    constexpr int task_count     = 1000;
+
+    std::atomic<int> counter{0};
+    std::vector<std::thread> producers;
+    for (int p = 0; p < producer_count; p++)
+    {
+        producers.emplace_back([&queue, &counter] {
+            std::vector<Future<void>> futures;
+            for (int i = 0; i < task_count; i++)
+            {
+                futures.push_back(queue.enqueue([&counter] { ++counter; }));
+            }
+            for (auto& f : futures)
+            {
+                f.get();
+            }
+        });
+    }
+    for (auto& producer : producers)
+    {
+        producer.join();
+    }
+    EXPECT_EQ(counter.load(), producer_count * task_count);
+
+    // tasks submitted from the fiber thread are launched on it directly
+    auto same_thread = queue
+                           .enqueue([&queue] {
+                               auto tid = std::this_thread::get_id();
+                               return queue.enqueue([tid] { return std::this_thread::get_id() == tid; }).get();
+                           })
+                           .get();
+    EXPECT_TRUE(same_thread);
+}
+
+TEST_F(TestSystem, FiberStackPool)
+{
+    auto system = system::make_system(make_options([](Options& options) {
+        options.topology().user_cpuset("0");
+    }));
+
+    system::Resources resources((system::SystemProvider(system)));
+    auto pool = resources.make_fiber_pool(CpuSet("0"));
+
+    auto stack_pool = FiberStackPool::create(200 * 1024, 4, true);
+    EXPECT_GE(stack_pool->stack_size(), 200 * 1024);
+    EXPECT_EQ(stack_pool->stack_size() % 4096, 0);
+
+    stack_pool->reserve(16);
+    EXPECT_EQ(stack_pool->mapped_count(), 4);
+    EXPECT_EQ(stack_pool->free_count(), 4);
+
+    // more concurrent fibers than the pool retains; the surplus stacks are unmapped as their fibers complete
+    std::vector<Future<std::size_t>> futures;
+    for (int i = 0; i < 8; i++)
+    {
+        futures.push_back(pool.task_queue(0).enqueue(FiberMetaData{MRC_DEFAULT_FIBER_PRIORITY, stack_pool}, [] {
+            // touch most of the requested stack
+            volatile char frame[150 * 1024];
+            frame[0] = 1;
+            boost::this_fiber::sleep_for(std::chrono::milliseconds(10));
+            return sizeof(frame);
+        }));
+    }
+    EXPECT_EQ(pool.task_queue(0).enqueue([stack_pool] { return stack_pool->mapped_count(); }).get(), 8);
+
+    for (auto& f : futures)
+    {
+        EXPECT_EQ(f.get(), 150 * 1024);
+    }
+
+    // completed fibers return their stacks once the scheduler releases their contexts
+    for (int i = 0; i < 100 && stack_pool->mapped_count() > 4; i++)
+    {
+        pool.task_queue(0).enqueue([] {}).get();
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    EXPECT_EQ(stack_pool->mapped_count(), 4);
+    EXPECT_EQ(stack_pool->free_count(), 4);
+}
+
 TEST_F(TestSystem, ImpossibleCoreCount)
 {
     auto system = system::make_system(make_options([](Options& options) {
@@ -210,6 +332,63 @@ TEST_F(TestSystem, ThreadInitializersAndFinalizers)
     EXPECT_EQ(fini_counter, 3);
 }
 
+TEST_F(TestSystem, EngineGroupScheduling)
+{
+    auto system = system::make_system(make_options([](Options& options) {
+        options.topology().user_cpuset("0-3");
+        options.topology().restrict_gpus(true);
+
+        // batch and a positive nice level require no privileges
+        EngineFactoryOptions group;
+        group.engine_type       = runnable::EngineType::Fiber;
+        group.allow_overlap     = false;
+        group.cpu_count         = 1;
+        group.scheduling.policy = ThreadSchedulingPolicy::Batch;
+        group.scheduling.nice   = 5;
+        options.engine_factories().set_engine_factory_options("bulk", std::move(group));
+    }));
+
+    auto resources = std::make_unique<system::Resources>((system::SystemProvider(system)));
+    system::register_engine_group_scheduling(*resources);
+
+    const auto& cpu_sets = system->partitions().host_partitions().at(0).engine_factory_cpu_sets();
+    auto bulk_cpus       = cpu_sets.fiber_cpu_sets.at("bulk");
+    auto main_cpus       = CpuSet(std::to_string(cpu_sets.main_cpu_id()));
+
+    int policy = -1;
+    int nice   = 0;
+    auto probe = [&policy, &nice] {
+        policy = sched_getscheduler(0);
+        errno  = 0;
+        nice   = getpriority(PRIO_PROCESS, 0);
+    };
+
+    std::make_unique<system::Thread>(resources->make_thread(bulk_cpus, probe))->join();
+    EXPECT_EQ(policy, SCHED_BATCH);
+    EXPECT_EQ(nice, 5);
+
+    std::make_unique<system::Thread>(resources->make_thread(main_cpus, probe))->join();
+    EXPECT_EQ(policy, SCHED_OTHER);
+}
+
+TEST_F(TestSystem, InvalidThreadScheduling)
+{
+    auto system = system::make_system(make_options([](Options& options) {
+        options.topology().user_cpuset("0-3");
+        options.topology().restrict_gpus(true);
+
+        EngineFactoryOptions group;
+        group.allow_overlap       = false;
+        group.cpu_count           = 1;
+        group.scheduling.policy   = ThreadSchedulingPolicy::Fifo;
+        group.scheduling.priority = 1000;
+        options.engine_factories().set_engine_factory_options("latency", std::move(group));
+    }));
+
+    auto resources = std::make_unique<system::Resources>((system::SystemProvider(system)));
+    EXPECT_ANY_THROW(system::register_engine_group_scheduling(*resources));
+}
+
 TEST_F(TestSystem, ThreadPool)
 {
     auto system = system::make_system(make_options([](Options& options) {
@@ -244,3 +423,304 @@ TEST_F(TestSystem, ThreadPool)
     EXPECT_EQ(counter, 3);
     EXPECT_EQ(ids.size(), 2);
 }
+
+TEST_F(TestSystem, CoroutineThreadPool)
+{
+    auto system = system::make_system(make_options([](Options& options) {
+        options.topology().user_cpuset("0-3");
+        options.topology().restrict_gpus(true);
+    }));
+
+    system::Resources resources((system::SystemProvider(system)));
+
+    std::atomic<std::size_t> initialized = 0;
+    resources.register_thread_local_initializer(CpuSet("2-3"), [&initialized] { ++initialized; });
+    auto fiber_threads = initialized.load();
+
+    auto thread_pool = resources.make_coroutine_thread_pool("coro", CpuSet("2-3"));
+    EXPECT_EQ(thread_pool->thread_count(), 2);
+
+    // each executor thread is pinned to a single logical cpu of the set
+    auto affinity = [] {
+        cpu_set_t mask;
+        CPU_ZERO(&mask);
+        CHECK_EQ(pthread_getaffinity_np(pthread_self(), sizeof(mask), &mask), 0);
+        std::set<int> cpus;
+        for (int cpu = 0; cpu < CPU_SETSIZE; cpu++)
+        {
+            if (CPU_ISSET(cpu, &mask))
+            {
+                cpus.insert(cpu);
+            }
+        }
+        return cpus;
+    };
+
+    std::set<int> cpus;
+    for (int i = 0; i < 16; i++)
+    {
+        auto thread_cpus = coroutines::sync_wait(thread_pool->enqueue(affinity));
+        EXPECT_EQ(thread_cpus.size(), 1);
+        cpus.insert(thread_cpus.begin(), thread_cpus.end());
+    }
+    for (auto cpu : cpus)
+    {
+        EXPECT_TRUE(cpu == 2 || cpu == 3);
+    }
+
+    // the thread local initializers of the cpus ran on the executor threads as they started
+    for (int i = 0; i < 100 && initialized.load() < fiber_threads + 2; i++)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    EXPECT_EQ(initialized.load(), fiber_threads + 2);
+}
+
+TEST_F(TestSystem, FiberPrioritySchedulerOrdering)
+{
+    std::vector<int> order;
+
+    std::thread thread([&order] {
+        boost::fibers::use_scheduling_algorithm<system::FiberPriorityScheduler>();
+
+        std::vector<boost::fibers::fiber> fibers;
+        for (int priority : {1, 5, 3, 5, 0})
+        {
+            boost::fibers::fiber fiber([&order, priority] { order.push_back(priority); });
+            fiber.properties<system::FiberPriorityProps>().set_priority(priority);
+            fibers.push_back(std::move(fiber));
+        }
+        for (auto& fiber : fibers)
+        {
+            fiber.join();
+        }
+    });
+    thread.join();
+
+    EXPECT_EQ(order, (std::vector<int>{5, 5, 3, 1, 0}));
+}
+
+TEST_F(TestSystem, FiberPrioritySchedulerShares)
+{
+    std::vector<std::uint32_t> order;
+
+    std::thread thread([&order] {
+        boost::fibers::use_scheduling_algorithm<system::FiberPriorityScheduler>();
+
+        std::vector<boost::fibers::fiber> fibers;
+        for (std::uint32_t group : {1, 2})
+        {
+            boost::fibers::fiber fiber([&order, group] {
+                for (int i = 0; i < 40; i++)
+                {
+                    order.push_back(group);
+                    boost::this_fiber::yield();
+                }
+            });
+            fiber.properties<system::FiberPriorityProps>().set_share(FiberShare{group, group == 1 ? 3U : 1U});
+            fibers.push_back(std::move(fiber));
+        }
+        for (auto& fiber : fibers)
+        {
+            fiber.join();
+        }
+    });
+    thread.join();
+
+    // while both groups are ready, the group of weight 3 gets three turns for each turn of the group of weight 1
+    ASSERT_EQ(order.size(), 80U);
+    auto weighted = std::count(order.begin(), order.begin() + 20, 1U);
+    EXPECT_GE(weighted, 14);
+    EXPECT_LE(weighted, 16);
+}
+
+TEST_F(TestSystem, FiberPrioritySchedulerTimeSlice)
+{
+    std::vector<int> order;
+
+    std::thread thread([&order] {
+        boost::fibers::use_scheduling_algorithm<system::FiberPriorityScheduler>();
+
+        // 20 elements of 200us each between channel writes, yielding at the writes once 1ms has elapsed
+        boost::fibers::fiber hog([&order] {
+            channel::BufferedChannel<int> channel(32);
+            for (int i = 0; i < 20; i++)
+            {
+                auto end = std::chrono::steady_clock::now() + std::chrono::microseconds(200);
+                while (std::chrono::steady_clock::now() < end) {}
+                order.push_back(1);
+                channel.await_write(int(i));
+            }
+        });
+        hog.properties<system::FiberPriorityProps>().set_time_slice(std::chrono::milliseconds(1));
+
+        boost::fibers::fiber neighbor([&order] {
+            for (int i = 0; i < 5; i++)
+            {
+                order.push_back(0);
+                boost::this_fiber::yield();
+            }
+        });
+
+        hog.join();
+        neighbor.join();
+    });
+    thread.join();
+
+    // without a time slice the hog would process all of its elements before the second turn of its neighbor
+    ASSERT_EQ(order.size(), 25U);
+    auto neighbor_turns = std::count(order.begin(), std::find(order.rbegin(), order.rend(), 1).base(), 0);
+    EXPECT_GE(neighbor_turns, 3);
+
+    auto usage = TimeSlice::collect();
+    auto unnamed = std::find_if(usage.begin(), usage.end(), [](const TimeSliceUsage& u) { return u.name.empty(); });
+    ASSERT_NE(unnamed, usage.end());
+    EXPECT_GE(unnamed->yields, 3);
+    EXPECT_GE(unnamed->max_overrun, std::chrono::nanoseconds(0));
+}
+
+TEST_F(TestSystem, FiberPrioritySchedulerWorkStealing)
+{
+    constexpr int fiber_count = 16;
+
+    auto group = std::make_shared<system::FiberStealingGroup>();
+
+    std::mutex mutex;
+    std::set<std::thread::id> ids;
+
+    // the idle thread only wakes periodically, it has no fibers of its own
+    std::thread idle([group] {
+        boost::fibers::use_scheduling_algorithm<system::FiberPriorityScheduler>(group);
+        while (group->outstanding() != 0U || group->steal_count() == 0U)
+        {
+            boost::this_fiber::sleep_for(std::chrono::milliseconds(1));
+        }
+    });
+
+    // all fibers are launched on the busy thread and cooperatively yield for a while
+    std::thread busy([group, &mutex, &ids] {
+        boost::fibers::use_scheduling_algorithm<system::FiberPriorityScheduler>(group);
+        for (int i = 0; i < fiber_count; i++)
+        {
+            group->fiber_launched();
+            boost::fibers::fiber([group, &mutex, &ids] {
+                auto end = std::chrono::steady_clock::now() + std::chrono::milliseconds(20);
+                while (std::chrono::steady_clock::now() < end)
+                {
+                    {
+                        std::lock_guard<std::mutex> lock(mutex);
+                        ids.insert(std::this_thread::get_id());
+                    }
+                    boost::this_fiber::yield();
+                }
+                group->fiber_completed();
+            }).detach();
+        }
+        while (group->outstanding() != 0U)
+        {
+            boost::this_fiber::yield();
+        }
+    });
+
+    busy.join();
+    idle.join();
+
+    EXPECT_GT(group->steal_count(), 0);
+    EXPECT_EQ(ids.size(), 2);
+}
+
+TEST_F(TestSystem, FiberPrioritySchedulerFutexWakeup)
+{
+    constexpr int handoff_count = 100;
+
+    boost::fibers::buffered_channel<int> ping(2);
+    boost::fibers::buffered_channel<int> pong(2);
+
+    // the fiber thread parks between handoffs and must be woken by the remote producer each time
+    std::thread fiber_thread([&ping, &pong] {
+        boost::fibers::use_scheduling_algorithm<system::FiberPriorityScheduler>(
+            nullptr, system::FiberSuspendOptions{true, 16});
+        int value;
+        while (ping.pop(value) == boost::fibers::channel_op_status::success)
+        {
+            pong.push(value + 1);
+        }
+    });
+
+    for (int i = 0; i < handoff_count; i++)
+    {
+        std::this_thread::sleep_for(std::chrono::microseconds(100));
+        ping.push(i);
+        int value;
+        EXPECT_EQ(pong.pop(value), boost::fibers::channel_op_status::success);
+        EXPECT_EQ(value, i + 1);
+    }
+
+    ping.close();
+    fiber_thread.join();
+}
+
+TEST_F(TestSystem, FiberPrioritySchedulerTracing)
+{
+    std::thread thread([] {
+        boost::fibers::use_scheduling_algorithm<system::FiberPriorityScheduler>(
+            nullptr, system::FiberSuspendOptions{}, true);
+
+        boost::fibers::buffered_channel<int> channel(2);
+
+        boost::fibers::fiber producer([&channel] {
+            benchmarking::FiberTracer::name_current_fiber("tracing_producer");
+            for (int i = 0; i < 10; i++)
+            {
+                boost::this_fiber::sleep_for(std::chrono::milliseconds(1));
+                channel.push(i);
+            }
+            channel.close();
+
+            // waits on mrc channels are attributed to the fiber
+            channel::ChannelTelemetry telemetry;
+            {
+                channel::BlockedTimer timer(telemetry, &channel::ChannelTelemetry::record_blocked_writer);
+                boost::this_fiber::sleep_for(std::chrono::milliseconds(2));
+            }
+        });
+
+        boost::fibers::fiber consumer([&channel] {
+            benchmarking::FiberTracer::name_current_fiber("tracing_consumer");
+            int value;
+            while (channel.pop(value) == boost::fibers::channel_op_status::success)
+            {
+                auto end = std::chrono::steady_clock::now() + std::chrono::microseconds(100);
+                while (std::chrono::steady_clock::now() < end) {}
+            }
+        });
+
+        producer.join();
+        consumer.join();
+    });
+    thread.join();
+
+    std::map<std::string, benchmarking::FiberStatistics> stats;
+    for (auto& s : benchmarking::FiberTracer::collect())
+    {
+        stats[s.name] = s;
+    }
+
+    ASSERT_TRUE(stats.contains("tracing_producer"));
+    ASSERT_TRUE(stats.contains("tracing_consumer"));
+    EXPECT_EQ(stats["tracing_producer"].fiber_count, 1);
+    EXPECT_GE(stats["tracing_producer"].context_switches, 10);
+    EXPECT_GT(stats["tracing_producer"].blocked, std::chrono::milliseconds(5));
+    EXPECT_GT(stats["tracing_consumer"].running, std::chrono::microseconds(500));
+    EXPECT_GT(stats["tracing_consumer"].cpu, std::chrono::microseconds(500));
+    EXPECT_LE(stats["tracing_consumer"].cpu, stats["tracing_consumer"].running + std::chrono::microseconds(100));
+    EXPECT_GE(stats["tracing_producer"].channel_wait, std::chrono::milliseconds(2));
+
+    auto filename = std::filesystem::temp_directory_path() / "mrc_fiber_trace.json";
+    benchmarking::FiberTracer::write_chrome_trace(filename.string());
+
+    std::ifstream file(filename);
+    auto trace = nlohmann::json::parse(file);
+    EXPECT_FALSE(trace["traceEvents"].empty());
+    std::filesystem::remove(filename);
+}
@@ -27,15 +27,19 @@
 #include <hwloc.h>
 #include <hwloc/bitmap.h>
 #include <hwloc/nvml.h>
+#include <unistd.h>
 
 #include <cstdint>
 #include <cstdio>
 #include <cstdlib>
+#include <filesystem>
+#include <fstream>
 #include <map>
 #include <memory>
 #include <ostream>
 #include <set>
 #include <string>
+#include <utility>
 #include <vector>
 
 using namespace mrc;
@@ -93,6 +97,32 @@ TEST_F(TestTopology, Bitmap)
     EXPECT_FALSE(bitmap.contains(sub_no));
 }
 
+TEST_F(TestTopology, BitmapWords)
+{
+    // bits spanning multiple words of the bitmap
+    Bitmap bitmap("0-3,64-70,130");
+    EXPECT_EQ(bitmap.weight(), 12);
+    EXPECT_EQ(bitmap.vec().at(4), 64);
+
+    auto groups = bitmap.split(5);
+    ASSERT_EQ(groups.size(), 5);
+    EXPECT_EQ(groups[0].str(), "0-2");
+    EXPECT_EQ(groups[1].str(), "3,64-65");
+    EXPECT_EQ(groups[4].str(), "70,130");
+
+    auto popped = bitmap.pop(5);
+    EXPECT_EQ(popped.str(), "0-3,64");
+    EXPECT_EQ(bitmap.str(), "65-70,130");
+
+    RoundRobinCpuSet round_robin(CpuSet("3,5,9"));
+    EXPECT_EQ(round_robin.next(), std::make_pair(0, 3));
+    EXPECT_EQ(round_robin.next_id(), 5);
+    EXPECT_EQ(round_robin.next_id(), 9);
+    EXPECT_EQ(round_robin.next(), std::make_pair(0, 3));
+    round_robin.reset();
+    EXPECT_EQ(round_robin.next_index(), 0);
+}
+
 TEST_F(TestTopology, TopologyOptions)
 {
     auto options  = std::make_unique<TopologyOptions>();
@@ -206,5 +236,40 @@ TEST_F(TestTopology, Codable)
         EXPECT_EQ(info.name(), decoded->gpu_info().at(id).name());
         EXPECT_EQ(info.uuid(), decoded->gpu_info().at(id).uuid());
         EXPECT_EQ(info.pcie_bus_id(), decoded->gpu_info().at(id).pcie_bus_id());
+        EXPECT_EQ(info.nics(), decoded->gpu_info().at(id).nics());
+        EXPECT_EQ(info.nvlink_peers(), decoded->gpu_info().at(id).nvlink_peers());
     }
 }
+
+TEST_F(TestTopology, Cache)
+{
+    auto path = std::filesystem::temp_directory_path() / ("mrc_topology_cache_" + std::to_string(getpid()) + ".bin");
+
+    TopologyOptions options;
+    options.cache_path(path.string());
+
+    // the first topology is discovered and written to the cache
+    auto discovered = internal::system::Topology::Create(options);
+    ASSERT_TRUE(std::filesystem::exists(path));
+    auto cached_msg = internal::system::Topology::deserialize_from_file(path.string());
+    EXPECT_FALSE(cached_msg.fingerprint().empty());
+
+    // the second topology is loaded from the cache
+    auto cached = internal::system::Topology::Create(options);
+    EXPECT_EQ(discovered->cpu_set().str(), cached->cpu_set().str());
+    EXPECT_EQ(discovered->core_count(), cached->core_count());
+    EXPECT_EQ(discovered->numa_count(), cached->numa_count());
+    EXPECT_EQ(discovered->gpu_count(), cached->gpu_count());
+
+    // a cache with a different fingerprint is rediscovered and overwritten
+    cached_msg.set_fingerprint("stale");
+    {
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        ASSERT_TRUE(cached_msg.SerializeToOstream(&file));
+    }
+    auto rediscovered = internal::system::Topology::Create(options);
+    EXPECT_EQ(discovered->cpu_set().str(), rediscovered->cpu_set().str());
+    EXPECT_NE(internal::system::Topology::deserialize_from_file(path.string()).fingerprint(), "stale");
+
+    std::filesystem::remove(path);
+}
@@ -21,6 +21,7 @@
 #include "internal/ucx/endpoint.hpp"
 
 #include "mrc/channel/forward.hpp"
+#include "mrc/options/network.hpp"
 #include "mrc/types.hpp"
 
 #include <boost/fiber/future/future.hpp>
@@ -72,6 +73,22 @@ TEST_F(TestUCX, CreateWorkerAddress)
     EXPECT_GT(address.length(), 0);
 }
 
+TEST_F(TestUCX, TcpTransport)
+{
+    if (std::getenv("UCX_TLS") != nullptr)
+    {
+        GTEST_SKIP() << "UCX_TLS takes precedence over the transport option";
+    }
+
+    auto context = std::make_shared<Context>(NetworkOptions().transport(NetworkTransport::Tcp));
+    EXPECT_EQ(context->transport(), NetworkTransport::Tcp);
+
+    auto worker  = std::make_shared<Worker>(context);
+    auto address = worker->address();
+    EXPECT_GT(address.length(), 0);
+    worker->progress();
+}
+
 TEST_F(TestUCX, EndpointsInProcess)
 {
     // note this test really should use a progress engine
@@ -0,0 +1,270 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "mrc/arrow/arrow_batch.hpp"
+#include "mrc/arrow/c_data_interface.hpp"
+#include "mrc/exceptions/runtime_error.hpp"
+#include "mrc/memory/buffer_view.hpp"
+#include "mrc/memory/memory_kind.hpp"
+
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace mrc;
+
+namespace {
+
+memory::const_buffer_view host_view(const void* data, std::size_t bytes)
+{
+    return {data, bytes, memory::memory_kind::host};
+}
+
+template <typename T>
+memory::const_buffer_view host_view(const std::vector<T>& values)
+{
+    return host_view(values.data(), values.size() * sizeof(T));
+}
+
+// columns of a batch of 4 rows: an int32 column with a null, a utf8 column and a list<int64> column
+struct Columns
+{
+    std::vector<std::uint8_t> ids_validity{0b1011};
+    std::vector<std::int32_t> ids{1, 2, 0, 4};
+    std::vector<std::int32_t> name_offsets{0, 3, 6, 6, 11};
+    std::string names{"foobarhello"};
+    std::vector<std::int32_t> list_offsets{0, 2, 2, 3, 5};
+    std::vector<std::int64_t> values{10, 11, 12, 13, 14};
+
+    arrow::ArrowArrayLayout layout() const
+    {
+        arrow::ArrowArrayLayout id_column{"i", "id", "", ARROW_FLAG_NULLABLE, 4, 1, 0};
+        id_column.buffers = {host_view(ids_validity), host_view(ids)};
+
+        arrow::ArrowArrayLayout name_column{"u", "name", "", ARROW_FLAG_NULLABLE, 4, 0, 0};
+        name_column.buffers = {{}, host_view(name_offsets), host_view(names.data(), names.size())};
+
+        arrow::ArrowArrayLayout item{"l", "item", "", ARROW_FLAG_NULLABLE, 5, 0, 0};
+        item.buffers = {{}, host_view(values)};
+
+        arrow::ArrowArrayLayout list_column{"+l", "values", "", ARROW_FLAG_NULLABLE, 4, 0, 0};
+        list_column.buffers  = {{}, host_view(list_offsets)};
+        list_column.children = {item};
+
+        arrow::ArrowArrayLayout root{"+s", "", "", 0, 4, 0, 0};
+        root.buffers  = {{}};
+        root.children = {id_column, name_column, list_column};
+        return root;
+    }
+};
+
+// an array of a single buffer produced outside of mrc, counting the releases of its structs
+struct ForeignArray
+{
+    inline static int schema_releases = 0;
+    inline static int array_releases  = 0;
+
+    ForeignArray(const char* format, std::int64_t length, std::vector<const void*> buffers) :
+      m_buffers(std::move(buffers))
+    {
+        schema.format   = format;
+        schema.name     = "";
+        schema.release  = release_schema;
+        array.length    = length;
+        array.n_buffers = static_cast<std::int64_t>(m_buffers.size());
+        array.buffers   = m_buffers.data();
+        array.release   = release_array;
+    }
+
+    static void release_schema(ArrowSchema* schema)
+    {
+        ++schema_releases;
+        schema->release = nullptr;
+    }
+
+    static void release_array(ArrowArray* array)
+    {
+        ++array_releases;
+        array->release = nullptr;
+    }
+
+    ArrowSchema schema{};
+    ArrowArray array{};
+
+  private:
+    std::vector<const void*> m_buffers;
+};
+
+}  // namespace
+
+class TestArrowBatch : public ::testing::Test
+{
+  protected:
+    void SetUp() override
+    {
+        ForeignArray::schema_releases = 0;
+        ForeignArray::array_releases  = 0;
+    }
+};
+
+TEST_F(TestArrowBatch, FromLayout)
+{
+    Columns columns;
+    auto batch = arrow::ArrowBatch::from_layout(columns.layout(), nullptr);
+
+    EXPECT_TRUE(batch);
+    EXPECT_EQ(batch.num_rows(), 4);
+    EXPECT_EQ(batch.num_columns(), 3);
+    EXPECT_EQ(batch.column_names(), (std::vector<std::string>{"id", "name", "values"}));
+
+    // the sizes are derived from the formats, the value bytes of the utf8 column from its last offset
+    auto buffers = batch.buffers();
+    ASSERT_EQ(buffers.size(), 6);
+    EXPECT_EQ(buffers[0].bytes(), 1);
+    EXPECT_EQ(buffers[1].bytes(), 16);
+    EXPECT_EQ(buffers[2].bytes(), 20);
+    EXPECT_EQ(buffers[3].bytes(), 11);
+    EXPECT_EQ(buffers[3].data(), columns.names.data());
+    EXPECT_EQ(buffers[4].bytes(), 20);
+    EXPECT_EQ(buffers[5].bytes(), 40);
+    EXPECT_EQ(batch.nbytes(), 1 + 16 + 20 + 11 + 20 + 40);
+
+    EXPECT_FALSE(arrow::ArrowBatch());
+}
+
+TEST_F(TestArrowBatch, ExportImportRoundTrip)
+{
+    Columns columns;
+    auto layout = columns.layout();
+    layout.children[0].metadata = std::string("\x01\x00\x00\x00\x01\x00\x00\x00k\x02\x00\x00\x00vv", 15);
+
+    ArrowSchema schema;
+    ArrowArray array;
+    arrow::ArrowBatch::from_layout(layout, nullptr).export_to_c(&schema, &array);
+    EXPECT_NE(schema.release, nullptr);
+    EXPECT_NE(array.release, nullptr);
+
+    auto batch = arrow::ArrowBatch::import_from_c(&schema, &array);
+    EXPECT_EQ(schema.release, nullptr);
+    EXPECT_EQ(array.release, nullptr);
+
+    // the columns are exchanged without copies
+    auto imported = batch.layout();
+    ASSERT_EQ(imported.children.size(), 3);
+    EXPECT_EQ(imported.children[0].metadata, layout.children[0].metadata);
+    EXPECT_EQ(imported.children[0].null_count, 1);
+    EXPECT_EQ(imported.children[1].buffers[0].data(), nullptr);
+    EXPECT_EQ(imported.children[1].buffers[2].data(), columns.names.data());
+    EXPECT_EQ(imported.children[2].children[0].format, "l");
+    EXPECT_EQ(imported.children[2].children[0].buffers[1].data(), columns.values.data());
+}
+
+TEST_F(TestArrowBatch, ReleasesImportedArraysOnce)
+{
+    std::vector<std::int32_t> values{1, 2, 3};
+    ForeignArray child("i", 3, {nullptr, values.data()});
+    ArrowSchema* child_schema = &child.schema;
+    ArrowArray* child_array   = &child.array;
+
+    ForeignArray root("+s", 3, {nullptr});
+    root.schema.n_children = 1;
+    root.schema.children   = &child_schema;
+    root.array.n_children  = 1;
+    root.array.children    = &child_array;
+
+    ArrowSchema exported_schema;
+    ArrowArray exported_array;
+    {
+        auto batch = arrow::ArrowBatch::import_from_c(&root.schema, &root.array);
+        auto copy  = batch;
+        EXPECT_EQ(copy.buffers().front().data(), values.data());
+
+        copy.export_to_c(&exported_schema, &exported_array);
+    }
+
+    // the exported array keeps the batch alive
+    EXPECT_EQ(ForeignArray::array_releases, 0);
+
+    // children moved out by a consumer outlive their parent
+    ArrowArray moved_child              = *exported_array.children[0];
+    exported_array.children[0]->release = nullptr;
+    exported_array.release(&exported_array);
+    exported_schema.release(&exported_schema);
+    EXPECT_EQ(ForeignArray::array_releases, 0);
+    EXPECT_EQ(moved_child.buffers[1], values.data());
+
+    moved_child.release(&moved_child);
+    EXPECT_EQ(ForeignArray::array_releases, 1);
+    EXPECT_EQ(ForeignArray::schema_releases, 1);
+}
+
+TEST_F(TestArrowBatch, BufferSizes)
+{
+    std::vector<std::byte> bytes(64);
+    auto size_of = [&](const char* format, std::size_t buffer) {
+        ForeignArray array(format, 3, {bytes.data(), bytes.data()});
+        return arrow::make_layout(array.schema, array.array).buffers[buffer].bytes();
+    };
+
+    EXPECT_EQ(size_of("b", 0), 1);
+    EXPECT_EQ(size_of("b", 1), 1);
+    EXPECT_EQ(size_of("c", 1), 3);
+    EXPECT_EQ(size_of("e", 1), 6);
+    EXPECT_EQ(size_of("g", 1), 24);
+    EXPECT_EQ(size_of("w:5", 1), 15);
+    EXPECT_EQ(size_of("d:10,2", 1), 48);
+    EXPECT_EQ(size_of("d:40,2,256", 1), 96);
+    EXPECT_EQ(size_of("tdD", 1), 12);
+    EXPECT_EQ(size_of("tsu:UTC", 1), 24);
+    EXPECT_EQ(size_of("tin", 1), 48);
+    EXPECT_EQ(size_of("+l", 1), 16);
+
+    // offsets count from the start of the buffers, so sliced arrays span their offset
+    ForeignArray sliced("i", 3, {nullptr, bytes.data()});
+    sliced.array.offset = 2;
+    EXPECT_EQ(arrow::make_layout(sliced.schema, sliced.array).buffers[1].bytes(), 20);
+}
+
+TEST_F(TestArrowBatch, RejectsUnsupportedArrays)
+{
+    std::vector<std::byte> bytes(64);
+
+    ForeignArray not_a_batch("i", 3, {nullptr, bytes.data()});
+    EXPECT_THROW(arrow::ArrowBatch::import_from_c(&not_a_batch.schema, &not_a_batch.array),
+                 exceptions::MrcRuntimeError);
+
+    // a failed import releases the structs it took ownership of
+    EXPECT_EQ(ForeignArray::array_releases, 1);
+    EXPECT_EQ(ForeignArray::schema_releases, 1);
+    EXPECT_THROW(arrow::ArrowBatch::import_from_c(&not_a_batch.schema, &not_a_batch.array),
+                 exceptions::MrcRuntimeError);
+
+    ForeignArray dense_union("+ud:0,1", 3, {bytes.data(), bytes.data()});
+    EXPECT_THROW(arrow::make_layout(dense_union.schema, dense_union.array), exceptions::MrcRuntimeError);
+
+    ForeignArray missing_buffer("u", 3, {nullptr, bytes.data()});
+    EXPECT_THROW(arrow::make_layout(missing_buffer.schema, missing_buffer.array), exceptions::MrcRuntimeError);
+
+    ForeignArray dictionary("i", 3, {nullptr, bytes.data()});
+    ArrowSchema value_schema{};
+    dictionary.schema.dictionary = &value_schema;
+    EXPECT_THROW(arrow::make_layout(dictionary.schema, dictionary.array), exceptions::MrcRuntimeError);
+}
@@ -0,0 +1,158 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "mrc/benchmarking/auto_tuner.hpp"
+#include "mrc/benchmarking/live_sampler.hpp"
+#include "mrc/benchmarking/tuning_profile.hpp"
+#include "mrc/runnable/launch_options.hpp"
+
+#include <gtest/gtest.h>
+#include <nlohmann/json.hpp>
+
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <string>
+
+using namespace mrc::benchmarking;
+using namespace std::chrono_literals;
+
+namespace mrc {
+
+namespace {
+
+// activity over a one second interval; wait times are summed over the engines of the node
+LiveNodeSample node_sample(const std::string& name,
+                           std::size_t received,
+                           std::size_t emitted,
+                           double latency_ms,
+                           double read_wait,
+                           double write_wait = 0.0)
+{
+    LiveNodeSample node;
+    node.name            = name;
+    node.received        = received;
+    node.emitted         = emitted;
+    node.receive_rate    = received;
+    node.emit_rate       = emitted;
+    node.mean_latency_ns = latency_ms * 1e6;
+    node.read_wait_ns    = static_cast<std::size_t>(read_wait * 1e9);
+    node.write_wait_ns   = static_cast<std::size_t>(write_wait * 1e9);
+    return node;
+}
+
+// source -> transform -> sink at 1000 elements per second; the source is backpressured and the transform is saturated
+// on a single engine unless its reads wait for the given number of seconds
+LiveSample pipeline_sample(double transform_read_wait)
+{
+    LiveSample sample;
+    sample.interval_seconds = 1.0;
+    sample.nodes.push_back(node_sample("source", 0, 1000, 0.0, 0.0, 0.6));
+    sample.nodes.push_back(node_sample("transform", 1000, 1000, 1.0, transform_read_wait));
+    sample.nodes.push_back(node_sample("sink", 1000, 0, 0.0, 0.9));
+
+    LiveQueueSample queue;
+    queue.name      = "transform";
+    queue.capacity  = 128;
+    queue.occupancy = 100;
+    sample.queues.push_back(queue);
+    return sample;
+}
+
+}  // namespace
+
+TEST(AutoTunerTest, ScalesSaturatedNodes)
+{
+    AutoTunerOptions options;
+    options.latency_target  = 200ms;
+    options.warm_up_samples = 1;
+    AutoTuner tuner(options);
+
+    // the warm-up sample is ignored
+    tuner.observe(pipeline_sample(0.9));
+    tuner.observe(pipeline_sample(0.0));
+    tuner.observe(pipeline_sample(0.0));
+
+    auto profile = tuner.next_round();
+    EXPECT_FALSE(tuner.converged());
+
+    const auto* transform = profile.find("transform");
+    ASSERT_NE(transform, nullptr);
+    EXPECT_EQ(transform->pe_count, 2);
+    EXPECT_EQ(transform->engines_per_pe, 1);
+
+    // the latency budget left by the service times is shared by the two input channels: ~100ms at 1000/s
+    EXPECT_EQ(transform->channel_size, 128);
+    ASSERT_NE(profile.find("sink"), nullptr);
+    EXPECT_EQ(profile.find("sink")->pe_count, 1);
+    ASSERT_NE(profile.find("source"), nullptr);
+    EXPECT_EQ(profile.find("source")->channel_size, 0);
+
+    // 100 queued elements at 1000/s and 1ms of service
+    auto best = tuner.best();
+    ASSERT_TRUE(best);
+    EXPECT_EQ(best->samples, 2);
+    EXPECT_DOUBLE_EQ(best->throughput, 1000.0);
+    EXPECT_NEAR(best->latency_seconds, 0.101, 1e-6);
+    EXPECT_TRUE(best->meets_latency_target);
+
+    // on two engines the transform is balanced, so the next round keeps the profile
+    tuner.observe(pipeline_sample(0.6));
+    tuner.observe(pipeline_sample(0.6));
+    EXPECT_EQ(tuner.next_round(), profile);
+    EXPECT_TRUE(tuner.converged());
+}
+
+TEST(AutoTunerTest, EnginesPerPeBeyondMaxPeCount)
+{
+    AutoTunerOptions options;
+    options.max_pe_count    = 1;
+    options.warm_up_samples = 0;
+    AutoTuner tuner(options);
+
+    tuner.observe(pipeline_sample(0.0));
+    auto profile = tuner.next_round();
+
+    const auto* transform = profile.find("transform");
+    ASSERT_NE(transform, nullptr);
+    EXPECT_EQ(transform->pe_count, 1);
+    EXPECT_EQ(transform->engines_per_pe, 2);
+}
+
+TEST(AutoTunerTest, ProfilePersistence)
+{
+    TuningProfile profile;
+    profile.set("transform", {.pe_count = 2, .engines_per_pe = 4, .channel_size = 256});
+    profile.set("sink", {});
+
+    runnable::LaunchOptions launch_options;
+    EXPECT_TRUE(profile.apply("transform", launch_options));
+    EXPECT_EQ(launch_options.pe_count, 2);
+    EXPECT_EQ(launch_options.engines_per_pe, 4);
+    EXPECT_FALSE(profile.apply("unknown", launch_options));
+
+    EXPECT_EQ(TuningProfile::from_json(profile.to_json()), profile);
+
+    auto path = (std::filesystem::temp_directory_path() / "mrc_test_tuning_profile.json").string();
+    profile.save(path);
+    EXPECT_EQ(TuningProfile::load(path), profile);
+    std::remove(path.c_str());
+
+    EXPECT_ANY_THROW(TuningProfile::load(path));
+}
+
+}  // namespace mrc
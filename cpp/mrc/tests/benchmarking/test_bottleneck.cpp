@@ -0,0 +1,129 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2021-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "mrc/benchmarking/bottleneck.hpp"
+#include "mrc/benchmarking/live_sampler.hpp"
+
+#include <gtest/gtest.h>
+#include <nlohmann/json.hpp>
+
+#include <stdexcept>
+#include <string>
+
+using namespace mrc::benchmarking;
+
+namespace mrc {
+
+namespace {
+
+// node active over a one second interval, waiting for the given number of seconds summed over its pes
+LiveNodeSample node_sample(const std::string& name, double read_wait, double write_wait)
+{
+    LiveNodeSample node;
+    node.name          = name;
+    node.received      = 1000;
+    node.emitted       = 1000;
+    node.read_wait_ns  = static_cast<std::size_t>(read_wait * 1e9);
+    node.write_wait_ns = static_cast<std::size_t>(write_wait * 1e9);
+    return node;
+}
+
+const NodeDiagnosis& find_node(const BottleneckReport& report, const std::string& name)
+{
+    for (const auto& node : report.nodes)
+    {
+        if (node.name == name)
+        {
+            return node;
+        }
+    }
+    throw std::runtime_error("node not found: " + name);
+}
+
+}  // namespace
+
+TEST(BottleneckTest, ClassifyNodes)
+{
+    LiveSample sample;
+    sample.sequence         = 3;
+    sample.interval_seconds = 1.0;
+    sample.nodes.push_back(node_sample("source", 0.0, 0.9));
+    sample.nodes.push_back(node_sample("transform", 0.05, 0.05));
+    sample.nodes.push_back(node_sample("sink", 3.2, 0.0));
+    sample.nodes.push_back(node_sample("balanced", 0.3, 0.3));
+
+    BottleneckOptions options;
+    options.pe_counts["transform"] = 2;
+    options.pe_counts["sink"]      = 4;
+    auto report                    = analyze_bottlenecks(sample, options);
+
+    EXPECT_EQ(report.sequence, 3);
+    ASSERT_EQ(report.nodes.size(), 4);
+    EXPECT_EQ(report.nodes.front().name, "transform");
+    ASSERT_TRUE(report.critical_node);
+    EXPECT_EQ(*report.critical_node, "transform");
+
+    // wait times are summed over the pes of the node
+    const auto& transform = find_node(report, "transform");
+    EXPECT_EQ(transform.state, NodeState::Saturated);
+    EXPECT_NEAR(transform.utilization, 0.95, 1e-6);
+    EXPECT_EQ(transform.recommended_pe_count, 3);
+
+    const auto& sink = find_node(report, "sink");
+    EXPECT_EQ(sink.state, NodeState::Starved);
+    EXPECT_EQ(sink.recommended_pe_count, 2);
+
+    const auto& source = find_node(report, "source");
+    EXPECT_EQ(source.state, NodeState::Backpressured);
+    EXPECT_EQ(source.recommended_pe_count, 1);
+
+    EXPECT_EQ(find_node(report, "balanced").state, NodeState::Balanced);
+
+    auto j = report.to_json();
+    EXPECT_EQ(j["critical_node"], "transform");
+    EXPECT_EQ(j["nodes"][0]["state"], "saturated");
+    EXPECT_NE(report.summary().find("sink: starved"), std::string::npos);
+}
+
+TEST(BottleneckTest, FullInputQueue)
+{
+    LiveSample sample;
+    sample.interval_seconds = 1.0;
+    sample.nodes.push_back(node_sample("node", 0.2, 0.1));
+    sample.nodes.push_back(node_sample("idle", 0.0, 0.0));
+    sample.nodes.back().received = 0;
+    sample.nodes.back().emitted  = 0;
+
+    LiveQueueSample queue;
+    queue.name      = "node";
+    queue.capacity  = 8;
+    queue.occupancy = 8;
+    sample.queues.push_back(queue);
+
+    auto report = analyze_bottlenecks(sample);
+
+    const auto& node = find_node(report, "node");
+    ASSERT_TRUE(node.input_fill);
+    EXPECT_DOUBLE_EQ(*node.input_fill, 1.0);
+    EXPECT_EQ(node.state, NodeState::Saturated);
+    EXPECT_EQ(node.recommended_pe_count, 2);
+
+    const auto& idle = find_node(report, "idle");
+    EXPECT_EQ(idle.state, NodeState::Balanced);
+    EXPECT_EQ(idle.recommended_pe_count, 1);
+}
+
+}  // namespace mrc
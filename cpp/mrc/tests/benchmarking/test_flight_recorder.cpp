@@ -0,0 +1,145 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2021-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "mrc/benchmarking/flight_recorder.hpp"
+
+#include <gtest/gtest.h>
+#include <nlohmann/json.hpp>
+
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <latch>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace mrc::benchmarking;
+
+namespace mrc {
+
+namespace {
+
+// retained Mark events with ids in [first, last)
+std::vector<FlightEvent> marks(std::uint64_t first, std::uint64_t last)
+{
+    std::vector<FlightEvent> events;
+    for (const auto& event : FlightRecorder::snapshot())
+    {
+        if (event.type == FlightEventType::Mark && event.id >= first && event.id < last)
+        {
+            events.push_back(event);
+        }
+    }
+    return events;
+}
+
+}  // namespace
+
+TEST(FlightRecorderTest, Disabled)
+{
+    FlightRecorder::enable(false);
+    FlightRecorder::record(FlightEventType::Mark, 100);
+    EXPECT_TRUE(marks(100, 101).empty());
+}
+
+TEST(FlightRecorderTest, RingRetainsNewestEvents)
+{
+    FlightRecorder::enable(true);
+    FlightRecorder::capacity_per_thread(60);
+
+    // a fresh thread gets a ring of the new capacity, rounded up to 64
+    std::thread([] {
+        for (std::uint64_t i = 0; i < 200; i++)
+        {
+            FlightRecorder::record(FlightEventType::Mark, 1000 + i, i);
+        }
+    }).join();
+    FlightRecorder::enable(false);
+
+    auto events = marks(1000, 1200);
+    ASSERT_EQ(events.size(), 64);
+    for (std::size_t i = 0; i < events.size(); i++)
+    {
+        EXPECT_EQ(events[i].id, 1136 + i);
+        EXPECT_EQ(events[i].value, 136 + i);
+        EXPECT_EQ(events[i].thread_id, events[0].thread_id);
+    }
+}
+
+TEST(FlightRecorderTest, SnapshotOrdersThreads)
+{
+    FlightRecorder::enable(true);
+
+    // the threads are kept alive until the snapshot since the ring of an exited thread is recycled
+    std::latch recorded(4);
+    std::latch done(1);
+    std::vector<std::thread> threads;
+    for (std::uint64_t t = 0; t < 4; t++)
+    {
+        threads.emplace_back([t, &recorded, &done] {
+            for (std::uint64_t i = 0; i < 16; i++)
+            {
+                FlightRecorder::record(FlightEventType::Mark, 2000 + t * 16 + i);
+            }
+            recorded.count_down();
+            done.wait();
+        });
+    }
+    recorded.wait();
+    FlightRecorder::enable(false);
+    auto events = marks(2000, 2064);
+    done.count_down();
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+
+    ASSERT_EQ(events.size(), 64);
+    for (std::size_t i = 1; i < events.size(); i++)
+    {
+        EXPECT_LE(events[i - 1].timestamp, events[i].timestamp);
+    }
+}
+
+TEST(FlightRecorderTest, WriteTrace)
+{
+    FlightRecorder::enable(true);
+    FlightRecorder::record(FlightEventType::Mark, 3000, 7);
+    FlightRecorder::record(FlightEventType::ChannelWrite, 3001, 1);
+    FlightRecorder::enable(false);
+
+    auto filename = testing::TempDir() + "mrc_flight_recorder_test.json";
+    FlightRecorder::write_trace(filename);
+
+    std::ifstream file(filename);
+    auto trace = nlohmann::json::parse(file);
+    std::remove(filename.c_str());
+
+    bool found = false;
+    for (const auto& event : trace["traceEvents"])
+    {
+        if (event["ph"] == "i" && event["name"] == "mark" && event["args"]["id"] == "0xbb8")
+        {
+            found = true;
+            EXPECT_EQ(event["args"]["value"], 7);
+            EXPECT_EQ(event["cat"], "flight_recorder");
+        }
+    }
+    EXPECT_TRUE(found);
+}
+
+}  // namespace mrc
@@ -0,0 +1,91 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2021-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "mrc/benchmarking/message_trace.hpp"
+
+#include <gtest/gtest.h>
+#include <nlohmann/json.hpp>
+
+#include <memory>
+#include <sstream>
+#include <string>
+
+using namespace mrc::benchmarking;
+
+namespace mrc {
+
+TEST(MessageTraceTest, Sampling)
+{
+    TraceContext::set_sample_rate(0.0);
+    auto unsampled = TraceContext::start("unsampled");
+    EXPECT_FALSE(unsampled.sampled());
+    {
+        TraceScope scope(unsampled, "node");
+    }
+    EXPECT_TRUE(unsampled.hops().empty());
+
+    TraceContext::set_sample_rate(1.0);
+    auto sampled = TraceContext::start("sampled");
+    TraceContext::set_sample_rate(0.0);
+    EXPECT_TRUE(sampled.sampled());
+    {
+        TraceScope scope(sampled, "node");
+    }
+    ASSERT_EQ(sampled.hops().size(), 1);
+    EXPECT_EQ(sampled.hops()[0].location, TraceContext::location());
+    EXPECT_LE(sampled.start_ns(), sampled.hops()[0].start_ns);
+    EXPECT_LE(sampled.hops()[0].start_ns, sampled.hops()[0].end_ns);
+
+    auto bytes    = sampled.pack();
+    auto unpacked = TraceContext::unpack(bytes.data(), bytes.size());
+    EXPECT_EQ(unpacked.trace_id(), sampled.trace_id());
+    EXPECT_EQ(unpacked.span_id(), sampled.span_id());
+    ASSERT_EQ(unpacked.hops().size(), 1);
+    EXPECT_EQ(unpacked.hops()[0].name, "node");
+}
+
+TEST(MessageTraceTest, OtlpJsonExport)
+{
+    std::stringstream stream;
+    TraceExporter::set_exporter(std::make_shared<OtlpJsonTraceExporter>(stream, "test_service"));
+
+    TraceContext::set_sample_rate(1.0);
+    auto msg = make_traced(42, "message");
+    TraceContext::set_sample_rate(0.0);
+    {
+        TraceScope scope(msg.trace, "first");
+    }
+    {
+        TraceScope scope(msg.trace, "second");
+    }
+    msg.trace.finish();
+    EXPECT_FALSE(msg.trace.sampled());
+    TraceExporter::set_exporter(nullptr);
+
+    auto otlp  = nlohmann::json::parse(stream.str());
+    auto spans = otlp["resourceSpans"][0]["scopeSpans"][0]["spans"];
+    EXPECT_EQ(otlp["resourceSpans"][0]["resource"]["attributes"][0]["value"]["stringValue"], "test_service");
+    ASSERT_EQ(spans.size(), 3);
+    EXPECT_EQ(spans[0]["name"], "message");
+    EXPECT_EQ(spans[1]["name"], "first");
+    EXPECT_EQ(spans[2]["name"], "second");
+    EXPECT_EQ(spans[1]["parentSpanId"], spans[0]["spanId"]);
+    EXPECT_EQ(spans[2]["traceId"], spans[0]["traceId"]);
+    EXPECT_EQ(spans[0]["traceId"].get<std::string>().size(), 32);
+}
+
+}  // namespace mrc
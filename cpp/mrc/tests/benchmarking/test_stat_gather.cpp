@@ -19,14 +19,25 @@
 
 #include "../test_segment.hpp"
 
+#include "mrc/benchmarking/live_sampler.hpp"
 #include "mrc/benchmarking/trace_statistics.hpp"
 #include "mrc/benchmarking/util.hpp"
+#include "mrc/channel/buffered_channel.hpp"
 #include "mrc/core/executor.hpp"
 #include "mrc/engine/pipeline/ipipeline.hpp"
 #include "mrc/options/options.hpp"
 
 #include <nlohmann/json.hpp>
 
+#include <atomic>
+#include <chrono>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
 using namespace mrc::benchmarking;
 
 void stat_check_helper(
@@ -120,4 +131,108 @@ TEST_F(StatGatherTest, TestStatisticsFullGather)
     TraceStatistics::reset();
 }
 
+TEST_F(StatGatherTest, TestStatisticsSnapshot)
+{
+    TraceStatistics::reset();
+    TraceStatistics::trace_operators(true);
+
+    // snapshots are taken without blocking the pipeline while it runs
+    std::atomic<bool> done{false};
+    std::thread poller([&done] {
+        while (!done)
+        {
+            TraceStatistics::snapshot();
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    });
+
+    Executor executor(std::move(m_resources->make_options()));
+    executor.register_pipeline(std::move(m_pipeline));
+    executor.start();
+    executor.join();
+
+    done = true;
+    poller.join();
+
+    std::map<std::string, TraceStatisticsSnapshot> snapshots;
+    for (auto& stats : TraceStatistics::snapshot())
+    {
+        snapshots[stats.name] = stats;
+    }
+    for (const auto& component : m_components)
+    {
+        ASSERT_EQ(snapshots.count(component), 1) << component << " not found";
+    }
+
+    EXPECT_EQ(snapshots["src"].emission_count, m_iterations);
+    EXPECT_EQ(snapshots["internal_1"].receive_count, m_iterations);
+    EXPECT_EQ(snapshots["internal_1"].emission_count, m_iterations);
+    EXPECT_EQ(snapshots["sink"].receive_count, m_iterations);
+    EXPECT_EQ(snapshots["sink"].channel_sink_reads, 0);
+
+    TraceStatistics::reset();
+    for (const auto& stats : TraceStatistics::snapshot())
+    {
+        EXPECT_EQ(stats.emission_count, 0);
+        EXPECT_EQ(stats.receive_count, 0);
+    }
+}
+
+TEST_F(StatGatherTest, TestLiveSampler)
+{
+    TraceStatistics::reset();
+    TraceStatistics::trace_operators(true);
+
+    std::mutex mutex;
+    std::vector<LiveSample> samples;
+    LiveSampler sampler(std::chrono::milliseconds(1), [&](const LiveSample& sample) {
+        std::lock_guard<std::mutex> lock(mutex);
+        samples.push_back(sample);
+    });
+
+    channel::BufferedChannel<int> queue(8);
+    queue.await_write(1);
+    queue.await_write(2);
+    sampler.watch_queue("queue", [&queue]() -> std::optional<channel::ChannelStatistics> {
+        return queue.statistics();
+    });
+
+    sampler.start();
+    Executor executor(std::move(m_resources->make_options()));
+    executor.register_pipeline(std::move(m_pipeline));
+    executor.start();
+    executor.join();
+    sampler.stop();
+    EXPECT_FALSE(sampler.is_running());
+
+    // the deltas of all samples add up to the totals of the run
+    samples.push_back(sampler.sample());
+    std::map<std::string, std::size_t> emitted;
+    std::size_t queue_writes = 0;
+    for (std::size_t i = 0; i < samples.size(); i++)
+    {
+        EXPECT_EQ(samples[i].sequence, i);
+        for (const auto& node : samples[i].nodes)
+        {
+            emitted[node.name] += node.emitted;
+        }
+        ASSERT_EQ(samples[i].queues.size(), 1);
+        EXPECT_EQ(samples[i].queues[0].capacity, queue.statistics().capacity);
+        EXPECT_EQ(samples[i].queues[0].occupancy, 2);
+        queue_writes += samples[i].queues[0].writes;
+    }
+    EXPECT_EQ(emitted["src"], m_iterations);
+    EXPECT_EQ(emitted["internal_1"], m_iterations);
+    EXPECT_EQ(emitted["sink"], 0);
+
+    // writes before start belong to the baseline
+    EXPECT_EQ(queue_writes, 0);
+
+    auto json = samples.back().to_json();
+    EXPECT_EQ(json["queues"][0]["name"], "queue");
+    EXPECT_EQ(json["nodes"].size(), samples.back().nodes.size());
+
+    TraceStatistics::reset();
+}
+
 }  // namespace mrc
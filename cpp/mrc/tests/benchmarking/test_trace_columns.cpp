@@ -0,0 +1,108 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "mrc/benchmarking/trace_columns.hpp"
+#include "mrc/benchmarking/tracer.hpp"
+
+#include <gtest/gtest.h>
+#include <nlohmann/json.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+using namespace mrc::benchmarking;
+
+namespace mrc {
+
+TEST(TraceColumnsTest, Summarize)
+{
+    TraceColumns columns(2, 200);
+    for (std::uint64_t value = 1; value <= 100; ++value)
+    {
+        auto row = columns.append_row();
+        columns.set(row, 0, 101 - value);
+    }
+
+    // rows which did not traverse a cell are excluded from its summary
+    for (std::size_t i = 0; i < 100; ++i)
+    {
+        columns.append_row();
+    }
+    EXPECT_EQ(columns.rows(), 200U);
+
+    auto summary = columns.summarize(0);
+    EXPECT_EQ(summary.count, 100U);
+    EXPECT_EQ(summary.sum, 5050U);
+    EXPECT_EQ(summary.min, 1U);
+    EXPECT_EQ(summary.max, 100U);
+    EXPECT_EQ(summary.p50, 50U);
+    EXPECT_EQ(summary.p90, 90U);
+    EXPECT_EQ(summary.p99, 99U);
+
+    EXPECT_EQ(columns.summarize(1).count, 0U);
+
+    // rows beyond the capacity are dropped
+    EXPECT_EQ(columns.append_row(), TraceColumns::npos);
+
+    // cleared rows are zeroed as they are appended again
+    columns.clear();
+    auto row = columns.append_row();
+    EXPECT_EQ(columns.summarize(0).count, 0U);
+    columns.set(row, 1, 7);
+    summary = columns.summarize(1);
+    EXPECT_EQ(summary.count, 1U);
+    EXPECT_EQ(summary.p50, 7U);
+    EXPECT_EQ(summary.p99, 7U);
+}
+
+TEST(TraceColumnsTest, AggregateLatencyTracers)
+{
+    using ensemble_t = TracerEnsemble<std::size_t, LatencyTracer>;
+
+    TraceColumns columns(ensemble_t::column_count(2), 10);
+    auto ts = TracerBase::time_pt_t{};
+    for (std::size_t i = 1; i <= 10; ++i)
+    {
+        ensemble_t tracer(2);
+        tracer.LatencyTracer::emit(0, 0, ts, ts, std::chrono::nanoseconds(i * 1000));
+        tracer.LatencyTracer::receive(0, 1, ts, ts, std::chrono::nanoseconds(i * 10));
+        tracer.write_columns(columns, columns.append_row());
+    }
+
+    TraceAggregator<ensemble_t> aggregator;
+    aggregator.process_tracer_columns(columns, 1.0, 2, {{0, "src"}, {1, "sink"}});
+    const auto& json_data = aggregator.to_json();
+    const auto& counters  = json_data["aggregations"]["metrics"]["counter"];
+
+    EXPECT_EQ(json_data["metadata"]["tracer_count"], 10U);
+    ASSERT_EQ(counters["component_latency_seconds_mean"].size(), 2U);
+    ASSERT_EQ(counters["component_latency_seconds_p90"].size(), 2U);
+
+    const auto& op_mean = counters["component_latency_seconds_mean"][0];
+    EXPECT_EQ(op_mean["labels"]["type"], "operator");
+    EXPECT_EQ(op_mean["labels"]["source_name"], "src");
+    EXPECT_DOUBLE_EQ(op_mean["value"].get<double>(), 5500e-9);
+
+    const auto& channel_p90 = counters["component_latency_seconds_p90"][1];
+    EXPECT_EQ(channel_p90["labels"]["type"], "channel");
+    EXPECT_EQ(channel_p90["labels"]["dest_name"], "sink");
+    EXPECT_DOUBLE_EQ(channel_p90["value"].get<double>(), 90e-9);
+    EXPECT_DOUBLE_EQ(counters["component_latency_seconds_max"][1]["value"].get<double>(), 100e-9);
+}
+
+}  // namespace mrc
@@ -44,10 +44,13 @@
 
 #include <gtest/gtest.h>
 
+#include <atomic>
 #include <chrono>
 #include <thread>
+#include <vector>
 
 using namespace mrc;
+using namespace std::chrono_literals;
 
 class TestCoroEvent : public ::testing::Test
 {};
@@ -318,3 +321,68 @@ TEST_F(TestCoroEvent, FIFO_SingleExecutor)
 
     EXPECT_TRUE(counter == 1);
 }
+
+TEST_F(TestCoroEvent, SetResumesWaitersInBulk)
+{
+    coroutines::Event e{};
+    coroutines::ThreadPool tp{coroutines::ThreadPool::Options{.thread_count = 4}};
+
+    constexpr std::size_t WaiterCount = 1000;
+    std::atomic<std::size_t> resumed{0};
+
+    auto make_waiter = [&]() -> coroutines::Task<void> {
+        co_await tp.schedule();
+        co_await e;
+        EXPECT_EQ(coroutines::ThreadPool::from_current_thread(), &tp);
+        resumed++;
+    };
+
+    // the waiters are handed to the thread pool at once and striped across its executors
+    auto make_setter = [&]() -> coroutines::Task<void> {
+        co_await tp.schedule();
+        while (tp.size() > 1)
+        {
+            co_await tp.yield();
+        }
+        e.set(tp);
+    };
+
+    std::vector<coroutines::Task<void>> tasks;
+    for (std::size_t i = 0; i < WaiterCount; i++)
+    {
+        tasks.push_back(make_waiter());
+    }
+    tasks.push_back(make_setter());
+
+    coroutines::sync_wait(coroutines::when_all(std::move(tasks)));
+
+    EXPECT_EQ(resumed.load(), WaiterCount);
+}
+
+TEST_F(TestCoroEvent, WaitFor)
+{
+    coroutines::Event e{};
+    coroutines::ThreadPool tp{coroutines::ThreadPool::Options{.thread_count = 1}};
+
+    auto waiter = [&](std::chrono::milliseconds timeout) -> coroutines::Task<bool> {
+        co_await tp.schedule();
+        auto set = co_await e.wait_for(timeout);
+        EXPECT_EQ(coroutines::ThreadPool::from_current_thread(), &tp);
+        co_return set;
+    };
+
+    EXPECT_FALSE(coroutines::sync_wait(waiter(5ms)));
+
+    auto setter = [&]() -> coroutines::Task<void> {
+        co_await tp.schedule();
+        co_await tp.sleep_for(5ms);
+        e.set(tp);
+    };
+
+    // the timed out waiter from above is still linked and is released by set()
+    auto [set, ignored] = coroutines::sync_wait(coroutines::when_all(waiter(10s), setter()));
+    EXPECT_TRUE(set.return_value());
+
+    // already set
+    EXPECT_TRUE(coroutines::sync_wait(waiter(0ms)));
+}
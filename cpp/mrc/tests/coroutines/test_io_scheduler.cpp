@@ -0,0 +1,208 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "mrc/coroutines/io_scheduler.hpp"
+#include "mrc/coroutines/sync_wait.hpp"
+#include "mrc/coroutines/task.hpp"
+#include "mrc/coroutines/thread_pool.hpp"
+#include "mrc/coroutines/when_all.hpp"
+
+#include <fcntl.h>
+#include <gtest/gtest.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace mrc;
+using namespace std::chrono_literals;
+
+class TestCoroIoScheduler : public ::testing::TestWithParam<coroutines::IoScheduler::Backend>
+{
+  protected:
+    coroutines::IoScheduler::Options options() const
+    {
+        coroutines::IoScheduler::Options opts;
+        opts.backend = GetParam();
+        return opts;
+    }
+};
+
+TEST_P(TestCoroIoScheduler, PipeReadWrite)
+{
+    coroutines::IoScheduler scheduler(options());
+    EXPECT_NE(scheduler.backend(), coroutines::IoScheduler::Backend::automatic);
+
+    std::array<int, 2> fds;
+    ASSERT_EQ(::pipe2(fds.data(), O_NONBLOCK | O_CLOEXEC), 0);
+
+    const std::string message = "hello io scheduler";
+
+    auto reader = [&]() -> coroutines::Task<std::string> {
+        std::array<std::byte, 64> buffer;
+        auto bytes = co_await scheduler.read(fds[0], buffer);
+        EXPECT_GT(bytes, 0);
+        co_return std::string(reinterpret_cast<const char*>(buffer.data()), bytes > 0 ? bytes : 0);
+    };
+
+    auto writer = [&]() -> coroutines::Task<std::int64_t> {
+        // give the reader time to suspend on the empty pipe
+        co_await scheduler.schedule_after(10ms);
+        co_return co_await scheduler.write(fds[1], std::as_bytes(std::span(message)));
+    };
+
+    auto [received, written] = coroutines::sync_wait(coroutines::when_all(reader(), writer()));
+    EXPECT_EQ(written.return_value(), message.size());
+    EXPECT_EQ(received.return_value(), message);
+
+    ::close(fds[0]);
+    ::close(fds[1]);
+}
+
+TEST_P(TestCoroIoScheduler, ConcurrentFileReads)
+{
+    coroutines::IoScheduler scheduler(options());
+
+    char path[] = "/tmp/mrc_io_scheduler_XXXXXX";
+    int fd      = ::mkstemp(path);
+    ASSERT_GE(fd, 0);
+    ::unlink(path);
+
+    constexpr std::size_t BlockSize  = 4096;
+    constexpr std::size_t BlockCount = 32;
+
+    std::vector<std::byte> contents(BlockSize * BlockCount);
+    for (std::size_t i = 0; i < contents.size(); i++)
+    {
+        contents[i] = static_cast<std::byte>(i / BlockSize);
+    }
+    auto write_file = [&]() -> coroutines::Task<std::int64_t> { co_return co_await scheduler.write(fd, contents, 0); };
+    ASSERT_EQ(coroutines::sync_wait(write_file()), contents.size());
+
+    auto read_block = [&](std::size_t block) -> coroutines::Task<bool> {
+        std::vector<std::byte> buffer(BlockSize);
+        auto bytes = co_await scheduler.read(fd, buffer, block * BlockSize);
+        co_return bytes == BlockSize && std::memcmp(buffer.data(), contents.data() + block * BlockSize, BlockSize) == 0;
+    };
+
+    std::vector<coroutines::Task<bool>> reads;
+    for (std::size_t block = 0; block < BlockCount; block++)
+    {
+        reads.push_back(read_block(block));
+    }
+
+    auto results = coroutines::sync_wait(coroutines::when_all(std::move(reads)));
+    for (auto& result : results)
+    {
+        EXPECT_TRUE(result.return_value());
+    }
+
+    // errors are reported as -errno
+    auto read_invalid = [&]() -> coroutines::Task<std::int64_t> {
+        std::array<std::byte, 8> buffer;
+        co_return co_await scheduler.read(-1, buffer);
+    };
+    EXPECT_EQ(coroutines::sync_wait(read_invalid()), -EBADF);
+
+    ::close(fd);
+}
+
+TEST_P(TestCoroIoScheduler, Accept)
+{
+    coroutines::IoScheduler scheduler(options());
+
+    int listener = ::socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    ASSERT_GE(listener, 0);
+
+    sockaddr_in addr{};
+    addr.sin_family      = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    socklen_t addr_len   = sizeof(addr);
+    ASSERT_EQ(::bind(listener, reinterpret_cast<sockaddr*>(&addr), addr_len), 0);
+    ASSERT_EQ(::listen(listener, 1), 0);
+    ASSERT_EQ(::getsockname(listener, reinterpret_cast<sockaddr*>(&addr), &addr_len), 0);
+
+    std::thread client([addr] {
+        std::this_thread::sleep_for(10ms);
+        int fd = ::socket(AF_INET, SOCK_STREAM, 0);
+        EXPECT_EQ(::connect(fd, reinterpret_cast<const sockaddr*>(&addr), sizeof(addr)), 0);
+        EXPECT_EQ(::write(fd, "x", 1), 1);
+        ::close(fd);
+    });
+
+    auto server = [&]() -> coroutines::Task<char> {
+        auto fd = co_await scheduler.accept(listener);
+        EXPECT_GE(fd, 0);
+        std::array<std::byte, 1> buffer{};
+        auto bytes = co_await scheduler.read(fd, buffer);
+        EXPECT_EQ(bytes, 1);
+        ::close(fd);
+        co_return static_cast<char>(buffer[0]);
+    };
+
+    EXPECT_EQ(coroutines::sync_wait(server()), 'x');
+
+    client.join();
+    ::close(listener);
+}
+
+TEST_P(TestCoroIoScheduler, Timers)
+{
+    coroutines::IoScheduler scheduler(options());
+
+    std::vector<int> order;
+
+    auto sleeper = [&](int id, std::chrono::milliseconds duration) -> coroutines::Task<void> {
+        co_await scheduler.schedule_after(duration);
+        order.push_back(id);
+    };
+
+    auto start = coroutines::IoScheduler::clock_t::now();
+    coroutines::sync_wait(coroutines::when_all(sleeper(3, 30ms), sleeper(1, 10ms), sleeper(2, 20ms)));
+    EXPECT_GE(coroutines::IoScheduler::clock_t::now() - start, 30ms);
+    EXPECT_EQ(order, (std::vector<int>{1, 2, 3}));
+    EXPECT_TRUE(scheduler.empty());
+}
+
+TEST_P(TestCoroIoScheduler, ResumeOnThreadPool)
+{
+    coroutines::ThreadPool pool({.thread_count = 2});
+    auto opts        = options();
+    opts.thread_pool = &pool;
+    coroutines::IoScheduler scheduler(opts);
+
+    auto task = [&]() -> coroutines::Task<coroutines::ThreadPool*> {
+        co_await scheduler.schedule_after(1ms);
+        co_return coroutines::ThreadPool::from_current_thread();
+    };
+
+    EXPECT_EQ(coroutines::sync_wait(task()), &pool);
+}
+
+INSTANTIATE_TEST_SUITE_P(Backends,
+                         TestCoroIoScheduler,
+                         ::testing::Values(coroutines::IoScheduler::Backend::automatic,
+                                           coroutines::IoScheduler::Backend::epoll));
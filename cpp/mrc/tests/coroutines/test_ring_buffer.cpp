@@ -39,16 +39,22 @@
 #include "mrc/coroutines/latch.hpp"
 #include "mrc/coroutines/ring_buffer.hpp"
 #include "mrc/coroutines/schedule_policy.hpp"
+#include "mrc/coroutines/select.hpp"
 #include "mrc/coroutines/sync_wait.hpp"
 #include "mrc/coroutines/task.hpp"
+#include "mrc/coroutines/thread_pool.hpp"
 #include "mrc/coroutines/when_all.hpp"
 
 #include <gtest/gtest.h>
 
 #include <chrono>
+#include <cstddef>
+#include <memory>
 #include <thread>
+#include <vector>
 
 using namespace mrc;
+using namespace std::chrono_literals;
 
 class TestCoroRingBuffer : public ::testing::Test
 {};
@@ -274,3 +280,137 @@ TEST_F(TestCoroRingBuffer, MultiProducerMultiConsumer)
 
     EXPECT_TRUE(rb.empty());
 }
+
+TEST_F(TestCoroRingBuffer, ReadWriteDeadlines)
+{
+    coroutines::ThreadPool tp{{.thread_count = 1}};
+    coroutines::RingBuffer<int> rb{{.capacity = 1}};
+
+    auto task = [&]() -> coroutines::Task<void> {
+        co_await tp.schedule();
+
+        auto start    = coroutines::TimerWheel::clock_t::now();
+        auto expected = co_await rb.read_for(5ms);
+        EXPECT_GE(coroutines::TimerWheel::clock_t::now() - start, 5ms);
+        EXPECT_FALSE(expected);
+        EXPECT_EQ(expected.error(), coroutines::RingBufferOpStatus::Timeout);
+
+        EXPECT_EQ(co_await rb.write_for(1, 5ms), coroutines::RingBufferOpStatus::Success);
+        EXPECT_EQ(co_await rb.write_for(2, 5ms), coroutines::RingBufferOpStatus::Timeout);
+        EXPECT_EQ(co_await rb.write_until(3, coroutines::TimerWheel::clock_t::now()),
+                  coroutines::RingBufferOpStatus::Timeout);
+
+        expected = co_await rb.read_for(5ms);
+        EXPECT_TRUE(expected);
+        EXPECT_EQ(*expected, 1);
+    };
+    coroutines::sync_wait(task());
+
+    // a deadline read completed by a writer before it expires
+    auto reader = [&]() -> coroutines::Task<int> {
+        co_await tp.schedule();
+        auto expected = co_await rb.read_for(10s);
+        co_return expected ? *expected : -1;
+    };
+    auto writer = [&]() -> coroutines::Task<void> {
+        co_await tp.schedule();
+        co_await tp.sleep_for(5ms);
+        co_await rb.write(42);
+    };
+    auto [value, ignored] = coroutines::sync_wait(coroutines::when_all(reader(), writer()));
+    EXPECT_EQ(value.return_value(), 42);
+}
+
+TEST_F(TestCoroRingBuffer, Select)
+{
+    coroutines::RingBuffer<int> rb0{{.capacity = 4}};
+    coroutines::RingBuffer<int> rb1{{.capacity = 4}};
+    coroutines::RingBuffer<int> rb2{{.capacity = 4}};
+    coroutines::Select<int> select({&rb0, &rb1, &rb2});
+
+    auto task = [&]() -> coroutines::Task<void> {
+        co_await rb0.write(0);
+        co_await rb0.write(3);
+        co_await rb1.write(1);
+        co_await rb1.write(4);
+        co_await rb2.write(2);
+
+        // the ring buffers are polled in rotation, so each of them is read from in turn
+        for (int i = 0; i < 5; i++)
+        {
+            auto result = co_await select.read();
+            EXPECT_EQ(result.index, i % 3);
+            EXPECT_TRUE(result.value);
+            EXPECT_EQ(*result.value, i);
+        }
+
+        // each closed and drained ring buffer reports that it has stopped once
+        rb0.close();
+        rb1.close();
+        rb2.close();
+        for (std::size_t i = 0; i < 3; i++)
+        {
+            auto result = co_await select.read();
+            EXPECT_EQ(result.index, (i + 2) % 3);
+            EXPECT_FALSE(result.value);
+            EXPECT_EQ(result.value.error(), coroutines::RingBufferOpStatus::Stopped);
+        }
+        EXPECT_EQ(select.active(), 0);
+
+        auto result = co_await select.read();
+        EXPECT_EQ(result.index, select.size());
+        EXPECT_FALSE(result.value);
+    };
+
+    coroutines::sync_wait(task());
+}
+
+TEST_F(TestCoroRingBuffer, SelectMultiProducer)
+{
+    constexpr std::size_t Producers = 4;
+    constexpr int Iterations        = 10000;
+
+    coroutines::ThreadPool tp{{.thread_count = 4}};
+    std::vector<std::unique_ptr<coroutines::RingBuffer<int>>> buffers;
+    std::vector<coroutines::RingBuffer<int>*> inputs;
+    for (std::size_t i = 0; i < Producers; i++)
+    {
+        buffers.push_back(std::make_unique<coroutines::RingBuffer<int>>(coroutines::RingBuffer<int>::Options{
+            .capacity = 1}));
+        inputs.push_back(buffers.back().get());
+    }
+    coroutines::Select<int> select(inputs);
+
+    auto producer = [&](coroutines::RingBuffer<int>& rb) -> coroutines::Task<void> {
+        co_await tp.schedule();
+        for (int i = 1; i <= Iterations; i++)
+        {
+            co_await rb.write(i);
+        }
+        rb.close();
+    };
+
+    auto consumer = [&]() -> coroutines::Task<void> {
+        co_await tp.schedule();
+        std::vector<int> last(Producers, 0);
+        while (select.active() > 0)
+        {
+            auto result = co_await select.read();
+            if (result.value)
+            {
+                // elements of each input arrive in order, with none lost or duplicated
+                EXPECT_EQ(*result.value, last[result.index] + 1);
+                last[result.index] = *result.value;
+            }
+        }
+        EXPECT_EQ(last, std::vector<int>(Producers, Iterations));
+    };
+
+    std::vector<coroutines::Task<void>> tasks;
+    tasks.push_back(consumer());
+    for (auto& rb : buffers)
+    {
+        tasks.push_back(producer(*rb));
+    }
+    coroutines::sync_wait(coroutines::when_all(std::move(tasks)));
+}
@@ -37,19 +37,43 @@
  */
 
 #include "mrc/core/thread.hpp"
+#include "mrc/coroutines/async_generator.hpp"
+#include "mrc/coroutines/frame_pool.hpp"
+#include "mrc/coroutines/generator.hpp"
 #include "mrc/coroutines/ring_buffer.hpp"
 #include "mrc/coroutines/sync_wait.hpp"
 #include "mrc/coroutines/task.hpp"
 #include "mrc/coroutines/thread_pool.hpp"
+#include "mrc/coroutines/when_all.hpp"
+#include "mrc/coroutines/when_any.hpp"
 
 #include <gtest/gtest.h>
 
+#include <atomic>
 #include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <set>
+#include <stdexcept>
 #include <stop_token>
 #include <string>
 #include <thread>
+#include <type_traits>
+#include <vector>
 
 using namespace mrc;
+using namespace std::chrono_literals;
+
+namespace {
+struct PooledValue
+{
+    std::uint64_t value;
+};
+}  // namespace
+
+template <>
+struct mrc::coroutines::use_frame_pool<PooledValue> : std::true_type
+{};
 
 class TestCoroTask : public ::testing::Test
 {};
@@ -72,6 +96,97 @@ TEST_F(TestCoroTask, Task)
     EXPECT_EQ(output, 4);
 }
 
+TEST_F(TestCoroTask, PooledFrames)
+{
+    auto pooled_task = [](std::uint64_t x) -> coroutines::Task<PooledValue> { co_return PooledValue{x * 2}; };
+    auto pooled_generator = [](std::uint64_t count) -> coroutines::Generator<PooledValue> {
+        for (std::uint64_t i = 0; i < count; i++)
+        {
+            co_yield PooledValue{i};
+        }
+    };
+
+    coroutines::FramePool::release_cached_frames();
+
+    // frames of tasks which have not opted in are not pooled
+    EXPECT_EQ(coroutines::sync_wait(double_task(2)), 4);
+    EXPECT_EQ(coroutines::FramePool::cached_frames(), 0);
+
+    EXPECT_EQ(coroutines::sync_wait(pooled_task(2)).value, 4);
+    EXPECT_EQ(coroutines::FramePool::cached_frames(), 1);
+
+    // the cached frame is reused by each subsequent task
+    for (std::uint64_t i = 0; i < 100; i++)
+    {
+        EXPECT_EQ(coroutines::sync_wait(pooled_task(i)).value, i * 2);
+    }
+    EXPECT_EQ(coroutines::FramePool::cached_frames(), 1);
+
+    std::uint64_t sum = 0;
+    for (const auto& value : pooled_generator(10))
+    {
+        sum += value.value;
+    }
+    EXPECT_EQ(sum, 45);
+    EXPECT_GE(coroutines::FramePool::cached_frames(), 1);
+
+    coroutines::FramePool::release_cached_frames();
+    EXPECT_EQ(coroutines::FramePool::cached_frames(), 0);
+}
+
+TEST_F(TestCoroTask, AsyncGenerator)
+{
+    coroutines::ThreadPool pool({.thread_count = 1, .description = "generator"});
+
+    std::atomic<std::uint64_t> generated{0};
+    auto generator = [&](std::uint64_t count) -> coroutines::AsyncGenerator<std::uint64_t> {
+        for (std::uint64_t i = 0; i < count; i++)
+        {
+            co_await pool.schedule();
+            ++generated;
+            co_yield i * 2;
+        }
+    };
+
+    auto consumer = [&]() -> coroutines::Task<std::uint64_t> {
+        auto values       = generator(10);
+        std::uint64_t sum = 0;
+
+        // the body runs only while a value is awaited
+        EXPECT_EQ(generated.load(), 0);
+        while (auto value = co_await values.next())
+        {
+            EXPECT_EQ(generated.load(), *value / 2 + 1);
+            sum += *value;
+        }
+        EXPECT_TRUE(values.done());
+        EXPECT_FALSE(co_await values.next());
+        co_return sum;
+    };
+
+    EXPECT_EQ(coroutines::sync_wait(consumer()), 90);
+    EXPECT_EQ(generated.load(), 10);
+}
+
+TEST_F(TestCoroTask, AsyncGeneratorException)
+{
+    auto generator = []() -> coroutines::AsyncGenerator<int> {
+        co_yield 1;
+        throw std::runtime_error("generator failed");
+    };
+
+    auto consumer = [&]() -> coroutines::Task<int> {
+        auto values = generator();
+        auto first  = co_await values.next();
+        EXPECT_EQ(first, 1);
+        EXPECT_THROW(co_await values.next(), std::runtime_error);
+        EXPECT_FALSE(co_await values.next());
+        co_return *first;
+    };
+
+    EXPECT_EQ(coroutines::sync_wait(consumer()), 1);
+}
+
 TEST_F(TestCoroTask, ScheduledTask)
 {
     coroutines::ThreadPool main({.thread_count = 1, .description = "main"});
@@ -116,3 +231,81 @@ TEST_F(TestCoroTask, RingBufferStressTest)
         coroutines::sync_wait(coroutines::when_all(source(), sink()));
     }
 }
+
+TEST_F(TestCoroTask, ThreadPoolFanOutFanIn)
+{
+    coroutines::ThreadPool pool({.thread_count = 4, .description = "fan_out"});
+
+    std::mutex mutex;
+    std::set<std::size_t> thread_ids;
+
+    auto leaf = [&](std::uint64_t x) -> coroutines::Task<std::uint64_t> {
+        co_await pool.schedule();
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            thread_ids.insert(coroutines::ThreadPool::get_thread_id());
+        }
+        // hold the executor thread so the remaining leaves must be stolen
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        co_return x;
+    };
+
+    // tasks fanned out from an executor thread land on its local queue and must be stolen by the other executors
+    auto root = [&]() -> coroutines::Task<std::uint64_t> {
+        co_await pool.schedule();
+        std::vector<coroutines::Task<std::uint64_t>> tasks;
+        for (std::uint64_t i = 0; i < 64; i++)
+        {
+            tasks.push_back(leaf(i));
+        }
+        auto results       = co_await coroutines::when_all(std::move(tasks));
+        std::uint64_t sum = 0;
+        for (auto& result : results)
+        {
+            sum += result.return_value();
+        }
+        co_return sum;
+    };
+
+    EXPECT_EQ(coroutines::sync_wait(root()), 63 * 64 / 2);
+    EXPECT_GT(thread_ids.size(), 1);
+}
+
+TEST_F(TestCoroTask, WhenAny)
+{
+    coroutines::ThreadPool pool({.thread_count = 2, .description = "when_any"});
+
+    auto work = [&](int value, std::chrono::milliseconds duration) -> coroutines::Task<int> {
+        co_await pool.schedule();
+        co_await pool.sleep_for(duration);
+        co_return value;
+    };
+
+    auto race = [&]() -> coroutines::Task<void> {
+        co_await pool.schedule();
+
+        auto [index, value] = co_await coroutines::when_any(work(1, 200ms), work(2, 1ms), work(3, 200ms));
+        EXPECT_EQ(index, 1);
+        EXPECT_EQ(value, 2);
+        EXPECT_EQ(coroutines::ThreadPool::from_current_thread(), &pool);
+
+        std::vector<coroutines::Task<int>> tasks;
+        tasks.push_back(work(1, 1ms));
+        tasks.push_back(work(2, 200ms));
+        auto first = co_await coroutines::when_any(std::move(tasks));
+        EXPECT_EQ(first.first, 0);
+        EXPECT_EQ(first.second, 1);
+    };
+    coroutines::sync_wait(race());
+
+    auto throws = [&]() -> coroutines::Task<void> {
+        co_await pool.schedule();
+        throw std::runtime_error("failed");
+    };
+    auto sleeps = [&]() -> coroutines::Task<void> {
+        co_await pool.sleep_for(200ms);
+    };
+    EXPECT_THROW(coroutines::sync_wait(coroutines::when_any(throws(), sleeps())), std::runtime_error);
+    EXPECT_THROW(coroutines::sync_wait(coroutines::when_any(std::vector<coroutines::Task<int>>{})),
+                 std::runtime_error);
+}
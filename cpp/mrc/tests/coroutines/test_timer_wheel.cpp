@@ -0,0 +1,202 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "mrc/coroutines/sync_wait.hpp"
+#include "mrc/coroutines/task.hpp"
+#include "mrc/coroutines/thread_pool.hpp"
+#include "mrc/coroutines/timer_wheel.hpp"
+#include "mrc/coroutines/when_all.hpp"
+#include "mrc/coroutines/with_timeout.hpp"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using namespace mrc;
+using namespace std::chrono_literals;
+
+namespace {
+
+class RecordingTimer final : public coroutines::TimerWheel::Timer
+{
+  public:
+    RecordingTimer(int id, std::mutex& mutex, std::vector<int>& order) : m_id(id), m_mutex(mutex), m_order(order) {}
+
+  private:
+    void on_expired() noexcept final
+    {
+        expired_at = coroutines::TimerWheel::clock_t::now();
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_order.push_back(m_id);
+    }
+
+  public:
+    coroutines::TimerWheel::time_point_t expired_at;
+
+  private:
+    int m_id;
+    std::mutex& m_mutex;
+    std::vector<int>& m_order;
+};
+
+}  // namespace
+
+class TestCoroTimerWheel : public ::testing::Test
+{};
+
+TEST_F(TestCoroTimerWheel, ExpiresInDeadlineOrder)
+{
+    // a 100us tick puts the later deadlines on levels 1 and 2, so they are cascaded before they expire
+    coroutines::TimerWheel wheel({.resolution = 100us});
+
+    std::mutex mutex;
+    std::vector<int> order;
+    RecordingTimer t0(0, mutex, order);
+    RecordingTimer t1(1, mutex, order);
+    RecordingTimer t2(2, mutex, order);
+    RecordingTimer t3(3, mutex, order);
+
+    auto start = coroutines::TimerWheel::clock_t::now();
+    wheel.schedule(t3, start + 450ms);
+    wheel.schedule(t1, start + 20ms);
+    wheel.schedule(t2, start + 100ms);
+    wheel.schedule(t0, start + 1ms);
+    EXPECT_EQ(wheel.size(), 4);
+
+    while (wheel.size() > 0)
+    {
+        std::this_thread::sleep_for(5ms);
+    }
+
+    EXPECT_EQ(order, (std::vector<int>{0, 1, 2, 3}));
+    EXPECT_GE(t0.expired_at, start + 1ms);
+    EXPECT_GE(t1.expired_at, start + 20ms);
+    EXPECT_GE(t2.expired_at, start + 100ms);
+    EXPECT_GE(t3.expired_at, start + 450ms);
+}
+
+TEST_F(TestCoroTimerWheel, Cancel)
+{
+    coroutines::TimerWheel wheel;
+
+    std::mutex mutex;
+    std::vector<int> order;
+    RecordingTimer cancelled(0, mutex, order);
+    RecordingTimer expired(1, mutex, order);
+
+    EXPECT_FALSE(wheel.cancel(cancelled));
+
+    auto start = coroutines::TimerWheel::clock_t::now();
+    wheel.schedule(cancelled, start + 10ms);
+    wheel.schedule(expired, start + 20ms);
+    EXPECT_TRUE(wheel.cancel(cancelled));
+
+    while (wheel.size() > 0)
+    {
+        std::this_thread::sleep_for(5ms);
+    }
+    EXPECT_FALSE(wheel.cancel(expired));
+    EXPECT_EQ(order, (std::vector<int>{1}));
+
+    // timers can be rescheduled once they have expired or been cancelled
+    wheel.schedule(cancelled, coroutines::TimerWheel::clock_t::now());
+    wheel.shutdown();
+    EXPECT_EQ(order, (std::vector<int>{1, 0}));
+}
+
+TEST_F(TestCoroTimerWheel, ShutdownExpiresPendingTimers)
+{
+    coroutines::TimerWheel wheel;
+
+    std::mutex mutex;
+    std::vector<int> order;
+    RecordingTimer timer(0, mutex, order);
+
+    wheel.schedule(timer, coroutines::TimerWheel::clock_t::now() + 24h);
+    wheel.shutdown();
+    EXPECT_EQ(order, (std::vector<int>{0}));
+    EXPECT_EQ(wheel.size(), 0);
+}
+
+TEST_F(TestCoroTimerWheel, SleepOnThreadPool)
+{
+    coroutines::ThreadPool pool({.thread_count = 2});
+    std::atomic<std::size_t> resumed_on_pool{0};
+
+    auto sleeper = [&](std::chrono::milliseconds duration) -> coroutines::Task<void> {
+        co_await pool.schedule();
+        auto start = coroutines::TimerWheel::clock_t::now();
+        co_await pool.sleep_for(duration);
+        EXPECT_GE(coroutines::TimerWheel::clock_t::now() - start, duration);
+        if (coroutines::ThreadPool::from_current_thread() == &pool)
+        {
+            resumed_on_pool++;
+        }
+    };
+
+    // many concurrent sleepers share the pool's single ticker thread
+    std::vector<coroutines::Task<void>> tasks;
+    for (int i = 0; i < 100; i++)
+    {
+        tasks.push_back(sleeper(std::chrono::milliseconds(1 + i % 20)));
+    }
+    coroutines::sync_wait(coroutines::when_all(std::move(tasks)));
+
+    EXPECT_EQ(resumed_on_pool, 100);
+}
+
+TEST_F(TestCoroTimerWheel, WithTimeout)
+{
+    coroutines::ThreadPool pool({.thread_count = 1});
+
+    auto work = [&](std::chrono::milliseconds duration) -> coroutines::Task<int> {
+        co_await pool.sleep_for(duration);
+        co_return 42;
+    };
+
+    auto fast = [&]() -> coroutines::Task<std23::expected<int, coroutines::Timeout>> {
+        co_await pool.schedule();
+        co_return co_await coroutines::with_timeout(work(1ms), 1s);
+    };
+    auto result = coroutines::sync_wait(fast());
+    ASSERT_TRUE(result.has_value());
+    EXPECT_EQ(*result, 42);
+
+    auto slow = [&]() -> coroutines::Task<bool> {
+        co_await pool.schedule();
+        auto start   = coroutines::TimerWheel::clock_t::now();
+        auto expired = co_await coroutines::with_timeout(work(200ms), 10ms);
+        EXPECT_LT(coroutines::TimerWheel::clock_t::now() - start, 200ms);
+        EXPECT_EQ(coroutines::ThreadPool::from_current_thread(), &pool);
+        co_return expired.has_value();
+    };
+    EXPECT_FALSE(coroutines::sync_wait(slow()));
+
+    auto throws = []() -> coroutines::Task<void> {
+        throw std::runtime_error("failed");
+        co_return;
+    };
+    auto propagate = [&]() -> coroutines::Task<void> {
+        co_await coroutines::with_timeout(throws(), 1s);
+    };
+    EXPECT_THROW(coroutines::sync_wait(propagate()), std::runtime_error);
+}
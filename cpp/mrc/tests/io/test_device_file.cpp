@@ -0,0 +1,147 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "mrc/coroutines/ring_buffer.hpp"
+#include "mrc/coroutines/sync_wait.hpp"
+#include "mrc/coroutines/task.hpp"
+#include "mrc/coroutines/when_all.hpp"
+#include "mrc/io/device_file.hpp"
+#include "mrc/memory/memory_kind.hpp"
+#include "mrc/memory/resources/device/cuda_malloc_resource.hpp"
+
+#include <cuda_runtime.h>
+#include <gtest/gtest.h>
+#include <unistd.h>
+
+#include <cstddef>
+#include <cstdlib>
+#include <exception>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <system_error>
+#include <vector>
+
+using namespace mrc;
+
+class TestIoDeviceFile : public ::testing::Test
+{
+  protected:
+    void SetUp() override
+    {
+        char path[] = "/tmp/mrc_io_device_file_XXXXXX";
+        int fd      = ::mkstemp(path);
+        ASSERT_GE(fd, 0);
+        ::close(fd);
+        m_path = path;
+        m_mr   = std::make_shared<memory::cuda_malloc_resource>(0);
+    }
+
+    void TearDown() override
+    {
+        ::unlink(m_path.c_str());
+    }
+
+    // the chunks read by a reader, with their bytes copied back to the host
+    std::vector<std::pair<io::DeviceChunk, std::string>> read_file(io::DeviceFileReaderOptions options)
+    {
+        io::DeviceFileReader reader(m_path, options, m_mr);
+        coroutines::RingBuffer<io::DeviceChunk> buffer({.capacity = 2});
+        std::vector<std::pair<io::DeviceChunk, std::string>> chunks;
+
+        // the buffer is closed on errors as well, releasing the consumer
+        auto produce = [&]() -> coroutines::Task<void> {
+            std::exception_ptr error;
+            try
+            {
+                co_await reader.read(buffer);
+            } catch (...)
+            {
+                error = std::current_exception();
+            }
+            buffer.close();
+            if (error)
+            {
+                std::rethrow_exception(error);
+            }
+        };
+
+        auto consume = [&]() -> coroutines::Task<void> {
+            while (auto chunk = co_await buffer.read())
+            {
+                std::string bytes(chunk->bytes(), '\0');
+                EXPECT_EQ(cudaMemcpy(bytes.data(), chunk->data(), bytes.size(), cudaMemcpyDeviceToHost), cudaSuccess);
+                chunks.emplace_back(std::move(*chunk), std::move(bytes));
+            }
+        };
+
+        auto [produced, consumed] = coroutines::sync_wait(coroutines::when_all(produce(), consume()));
+        produced.return_value();
+        return chunks;
+    }
+
+    std::string m_path;
+    std::shared_ptr<memory::memory_resource> m_mr;
+};
+
+TEST_F(TestIoDeviceFile, Read)
+{
+    std::string contents;
+    for (int i = 0; i < 100000; ++i)
+    {
+        contents += static_cast<char>(i * 7 % 251);
+    }
+    std::ofstream(m_path, std::ios::binary) << contents;
+
+    // chunks are rounded up to 4096 bytes, so the file spans 25 reads with a short last one
+    auto chunks = read_file({.chunk_size = 4000, .read_ahead = 3});
+    ASSERT_EQ(chunks.size(), 25);
+
+    std::string joined;
+    for (const auto& [chunk, bytes] : chunks)
+    {
+        EXPECT_EQ(chunk.offset(), joined.size());
+        EXPECT_EQ(chunk.view().kind(), memory::memory_kind::device);
+        EXPECT_EQ(chunk.view().bytes(), chunk.bytes());
+        joined += bytes;
+    }
+    EXPECT_EQ(chunks.back().first.bytes(), contents.size() % 4096);
+    EXPECT_EQ(joined, contents);
+}
+
+TEST_F(TestIoDeviceFile, ExactMultipleOfChunks)
+{
+    const std::string contents(4 * 4096, 'x');
+    std::ofstream(m_path, std::ios::binary) << contents;
+
+    auto chunks = read_file({.chunk_size = 4096, .read_ahead = 2});
+    ASSERT_EQ(chunks.size(), 4);
+    for (const auto& [chunk, bytes] : chunks)
+    {
+        EXPECT_EQ(bytes, std::string(4096, 'x'));
+    }
+}
+
+TEST_F(TestIoDeviceFile, Empty)
+{
+    EXPECT_TRUE(read_file({}).empty());
+}
+
+TEST_F(TestIoDeviceFile, MissingFile)
+{
+    EXPECT_THROW(io::DeviceFileReader("/tmp/mrc_io_device_file_does_not_exist", {}, m_mr), std::system_error);
+}
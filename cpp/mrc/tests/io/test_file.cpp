@@ -0,0 +1,194 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "mrc/coroutines/io_scheduler.hpp"
+#include "mrc/coroutines/ring_buffer.hpp"
+#include "mrc/coroutines/sync_wait.hpp"
+#include "mrc/coroutines/task.hpp"
+#include "mrc/coroutines/when_all.hpp"
+#include "mrc/exceptions/runtime_error.hpp"
+#include "mrc/io/file.hpp"
+
+#include <gtest/gtest.h>
+#include <unistd.h>
+
+#include <cstddef>
+#include <cstdlib>
+#include <exception>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <vector>
+
+using namespace mrc;
+
+class TestIoFile : public ::testing::TestWithParam<coroutines::IoScheduler::Backend>
+{
+  protected:
+    void SetUp() override
+    {
+        coroutines::IoScheduler::Options options;
+        options.backend = GetParam();
+        m_scheduler     = std::make_shared<coroutines::IoScheduler>(options);
+
+        char path[] = "/tmp/mrc_io_file_XXXXXX";
+        int fd      = ::mkstemp(path);
+        ASSERT_GE(fd, 0);
+        ::close(fd);
+        m_path = path;
+    }
+
+    void TearDown() override
+    {
+        ::unlink(m_path.c_str());
+    }
+
+    void write_file(const std::string& contents, io::FileWriterOptions options = {})
+    {
+        io::FileWriter writer(m_path, options, m_scheduler);
+        coroutines::sync_wait(writer.write(io::as_bytes(contents)));
+        coroutines::sync_wait(writer.close());
+        EXPECT_EQ(writer.bytes_written(), contents.size());
+    }
+
+    std::vector<io::FileChunk> read_file(io::FileReaderOptions options)
+    {
+        io::FileReader reader(m_path, options, m_scheduler);
+        coroutines::RingBuffer<io::FileChunk> buffer({.capacity = 2});
+        std::vector<io::FileChunk> chunks;
+
+        // the buffer is closed on errors as well, releasing the consumer
+        auto produce = [&]() -> coroutines::Task<void> {
+            std::exception_ptr error;
+            try
+            {
+                co_await reader.read(buffer);
+            } catch (...)
+            {
+                error = std::current_exception();
+            }
+            buffer.close();
+            if (error)
+            {
+                std::rethrow_exception(error);
+            }
+        };
+        auto consume = [&]() -> coroutines::Task<void> {
+            while (auto chunk = co_await buffer.read())
+            {
+                chunks.push_back(std::move(*chunk));
+            }
+        };
+
+        auto [produced, consumed] = coroutines::sync_wait(coroutines::when_all(produce(), consume()));
+        produced.return_value();
+        return chunks;
+    }
+
+    std::shared_ptr<coroutines::IoScheduler> m_scheduler;
+    std::string m_path;
+};
+
+TEST_P(TestIoFile, Lines)
+{
+    std::string contents;
+    for (int i = 0; i < 500; i++)
+    {
+        contents += "line " + std::to_string(i) + "\n";
+    }
+    // a line longer than a read and a final line without terminator
+    contents += std::string(200, 'x') + "\n" + "tail";
+    write_file(contents, {.chunk_size = 100});
+
+    auto chunks = read_file({.chunk_size = 64, .read_ahead = 3});
+
+    std::string read;
+    std::vector<std::string_view> lines;
+    for (const auto& chunk : chunks)
+    {
+        EXPECT_EQ(chunk.offset(), read.size());
+        read += chunk.view();
+        if (&chunk != &chunks.back())
+        {
+            EXPECT_EQ(chunk.view().back(), '\n');
+        }
+        chunk.for_each_line([&lines](std::string_view line) { lines.push_back(line); });
+    }
+    EXPECT_EQ(read, contents);
+    ASSERT_EQ(lines.size(), 502);
+    EXPECT_EQ(lines[42], "line 42");
+    EXPECT_EQ(lines[500].size(), 200);
+    EXPECT_EQ(lines[501], "tail");
+}
+
+TEST_P(TestIoFile, FixedRecords)
+{
+    std::string contents;
+    for (int i = 0; i < 300; i++)
+    {
+        contents += std::string(7, static_cast<char>('a' + i % 26));
+    }
+    write_file(contents);
+
+    std::string read;
+    for (const auto& chunk : read_file({.format = io::RecordFormat::fixed, .record_size = 7, .chunk_size = 50}))
+    {
+        EXPECT_EQ(chunk.offset() % 7, 0);
+        EXPECT_EQ(chunk.size() % 7, 0);
+        read += chunk.view();
+    }
+    EXPECT_EQ(read, contents);
+
+    // a truncated record is an error
+    io::FileWriter writer(m_path, {.append = true}, m_scheduler);
+    coroutines::sync_wait(writer.write(io::as_bytes(std::string("abc"))));
+    coroutines::sync_wait(writer.close());
+    EXPECT_THROW(read_file({.format = io::RecordFormat::fixed, .record_size = 7, .chunk_size = 50}),
+                 exceptions::MrcRuntimeError);
+}
+
+TEST_P(TestIoFile, BlobDirectIo)
+{
+    std::string contents(3 * 4096 + 100, '\0');
+    for (std::size_t i = 0; i < contents.size(); i++)
+    {
+        contents[i] = static_cast<char>(i % 251);
+    }
+    write_file(contents, {.chunk_size = 4096, .direct_io = true});
+
+    // direct i/o falls back to buffered i/o on filesystems without O_DIRECT
+    auto chunks = read_file({.format = io::RecordFormat::blob, .chunk_size = 4096, .direct_io = true});
+    ASSERT_EQ(chunks.size(), 4);
+
+    std::string read;
+    for (const auto& chunk : chunks)
+    {
+        read += chunk.view();
+    }
+    EXPECT_EQ(read, contents);
+}
+
+TEST_P(TestIoFile, MissingFile)
+{
+    EXPECT_THROW(io::FileReader("/tmp/mrc_io_file_missing", {}, m_scheduler), std::system_error);
+}
+
+INSTANTIATE_TEST_SUITE_P(Backends,
+                         TestIoFile,
+                         ::testing::Values(coroutines::IoScheduler::Backend::automatic,
+                                           coroutines::IoScheduler::Backend::epoll));
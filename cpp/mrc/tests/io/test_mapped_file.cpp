@@ -0,0 +1,201 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "mrc/exceptions/runtime_error.hpp"
+#include "mrc/io/mapped_file.hpp"
+#include "mrc/memory/memory_kind.hpp"
+
+#include <gtest/gtest.h>
+#include <unistd.h>
+
+#include <cstddef>
+#include <cstdlib>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <vector>
+
+using namespace mrc;
+
+class TestIoMappedFile : public ::testing::Test
+{
+  protected:
+    void SetUp() override
+    {
+        char path[] = "/tmp/mrc_io_mapped_file_XXXXXX";
+        int fd      = ::mkstemp(path);
+        ASSERT_GE(fd, 0);
+        ::close(fd);
+        m_path = path;
+    }
+
+    void TearDown() override
+    {
+        ::unlink(m_path.c_str());
+    }
+
+    std::shared_ptr<const io::MappedFile> map_file(const std::string& contents)
+    {
+        std::ofstream(m_path, std::ios::binary) << contents;
+        return io::MappedFile::open(m_path);
+    }
+
+    // the views each of count partitions emits, concatenated in partition order
+    static std::vector<io::MappedView> read_partitions(const std::shared_ptr<const io::MappedFile>& file,
+                                                       const io::MappedFileOptions& options,
+                                                       std::size_t count)
+    {
+        std::vector<io::MappedView> views;
+        std::size_t expected_begin = 0;
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            auto [begin, end] = file->partition(options, i, count);
+            EXPECT_EQ(begin, expected_begin);
+            EXPECT_LE(begin, end);
+            while (begin < end)
+            {
+                auto chunk_end = file->chunk_end(options, begin, end);
+                EXPECT_GT(chunk_end, begin);
+                views.emplace_back(file, begin, chunk_end - begin);
+                begin = chunk_end;
+            }
+            expected_begin = end;
+        }
+        EXPECT_EQ(expected_begin, file->size());
+        return views;
+    }
+
+    std::string m_path;
+};
+
+TEST_F(TestIoMappedFile, Lines)
+{
+    std::string contents;
+    for (int i = 0; i < 500; ++i)
+    {
+        contents += "record_" + std::to_string(i) + std::string(i % 37, 'x') + "\n";
+    }
+    contents += "unterminated";
+    auto file = map_file(contents);
+    EXPECT_EQ(file->size(), contents.size());
+
+    for (std::size_t count : {1, 3, 7, 1000})
+    {
+        auto views = read_partitions(file, {.chunk_size = 100}, count);
+
+        std::string joined;
+        std::size_t lines = 0;
+        for (const auto& view : views)
+        {
+            EXPECT_EQ(view.offset(), joined.size());
+            EXPECT_EQ(view.kind(), memory::memory_kind::host);
+            EXPECT_EQ(view.file(), file);
+
+            // views hold whole lines
+            EXPECT_TRUE(view.view().back() == '\n' || view.offset() + view.bytes() == file->size());
+            view.for_each_line([&](std::string_view line) {
+                EXPECT_TRUE(line.starts_with("record_") || line == "unterminated") << line;
+                ++lines;
+            });
+            joined += view.view();
+        }
+        EXPECT_EQ(joined, contents);
+        EXPECT_EQ(lines, 501);
+    }
+}
+
+TEST_F(TestIoMappedFile, LineLongerThanChunk)
+{
+    const std::string contents = "a\n" + std::string(1000, 'b') + "\nc\n";
+    auto file                  = map_file(contents);
+
+    auto views = read_partitions(file, {.chunk_size = 16}, 2);
+    ASSERT_EQ(views.size(), 3);
+    EXPECT_EQ(views[0].view(), "a\n");
+    EXPECT_EQ(views[1].view(), std::string(1000, 'b') + "\n");
+    EXPECT_EQ(views[2].view(), "c\n");
+}
+
+TEST_F(TestIoMappedFile, FixedRecords)
+{
+    constexpr std::size_t RecordSize = 24;
+    std::string contents;
+    for (int i = 0; i < 100; ++i)
+    {
+        contents += std::string(RecordSize, static_cast<char>('a' + i % 26));
+    }
+    auto file = map_file(contents);
+    const io::MappedFileOptions options{
+        .format = io::RecordFormat::fixed, .record_size = RecordSize, .chunk_size = 100};
+
+    for (std::size_t count : {1, 4, 9})
+    {
+        auto views = read_partitions(file, options, count);
+        for (const auto& view : views)
+        {
+            EXPECT_EQ(view.offset() % RecordSize, 0);
+            EXPECT_EQ(view.bytes() % RecordSize, 0);
+            EXPECT_LE(view.bytes(), 96);
+        }
+    }
+}
+
+TEST_F(TestIoMappedFile, PartialFixedRecord)
+{
+    auto file = map_file(std::string(50, 'x'));
+    EXPECT_THROW(file->partition({.format = io::RecordFormat::fixed, .record_size = 24}, 0, 1),
+                 exceptions::MrcRuntimeError);
+}
+
+TEST_F(TestIoMappedFile, Blob)
+{
+    auto file  = map_file(std::string(1000, 'x'));
+    auto views = read_partitions(file, {.format = io::RecordFormat::blob, .chunk_size = 128}, 3);
+
+    std::size_t bytes = 0;
+    for (const auto& view : views)
+    {
+        EXPECT_LE(view.bytes(), 128);
+        bytes += view.bytes();
+    }
+    EXPECT_EQ(bytes, 1000);
+}
+
+TEST_F(TestIoMappedFile, Empty)
+{
+    auto file = map_file("");
+    EXPECT_EQ(file->size(), 0);
+    EXPECT_TRUE(read_partitions(file, {}, 4).empty());
+    file->will_need(0, 100);
+}
+
+TEST_F(TestIoMappedFile, ViewOutlivesFile)
+{
+    io::MappedView view;
+    {
+        auto file = map_file("abc\ndef\n");
+        view      = io::MappedView(file, 4, 4);
+    }
+    EXPECT_EQ(view.view(), "def\n");
+}
+
+TEST_F(TestIoMappedFile, MissingFile)
+{
+    EXPECT_THROW(io::MappedFile::open("/tmp/mrc_io_mapped_file_does_not_exist"), std::system_error);
+}
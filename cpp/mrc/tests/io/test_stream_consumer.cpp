@@ -0,0 +1,72 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "mrc/exceptions/runtime_error.hpp"
+#include "mrc/io/kafka_consumer.hpp"
+#include "mrc/io/stream_consumer.hpp"
+#include "mrc/memory/memory_kind.hpp"
+
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <memory>
+#include <span>
+#include <string>
+
+using namespace mrc;
+
+TEST(TestIoStreamConsumer, Offsets)
+{
+    const io::StreamOffsets offsets{{{"events", 0}, 42}, {{"events", 11}, 0}, {{"audit.log", 3}, 1L << 40}};
+
+    auto token = io::encode_offsets(offsets);
+    EXPECT_EQ(io::decode_offsets(token), offsets);
+    EXPECT_TRUE(io::decode_offsets(io::encode_offsets({})).empty());
+
+    EXPECT_THROW(io::decode_offsets("events\t0\n"), exceptions::MrcRuntimeError);
+    EXPECT_THROW(io::decode_offsets("events\tzero\t42\n"), exceptions::MrcRuntimeError);
+    EXPECT_THROW(io::decode_offsets("events\t0\t42x\n"), exceptions::MrcRuntimeError);
+}
+
+TEST(TestIoStreamConsumer, MessageKeepsOwnerAlive)
+{
+    auto storage = std::make_shared<std::string>("key:payload");
+    std::weak_ptr<std::string> weak(storage);
+    auto bytes = std::as_bytes(std::span(storage->data(), storage->size()));
+
+    io::StreamMessage message(std::move(storage), {"events", 2}, 7, bytes.first(3), bytes.subspan(4));
+    auto copy = message;
+    message   = {};
+    EXPECT_FALSE(weak.expired());
+
+    EXPECT_EQ(copy.partition(), (io::StreamPartition{"events", 2}));
+    EXPECT_EQ(copy.offset(), 7);
+    EXPECT_EQ(copy.key().size(), 3);
+    EXPECT_EQ(copy.view(), "payload");
+    EXPECT_EQ(copy.payload_view().data(), copy.payload().data());
+    EXPECT_EQ(copy.payload_view().kind(), memory::memory_kind::host);
+
+    copy = {};
+    EXPECT_TRUE(weak.expired());
+}
+
+#ifndef MRC_HAS_RDKAFKA
+TEST(TestIoStreamConsumer, KafkaUnavailable)
+{
+    EXPECT_THROW(io::KafkaConsumer({.topics = {"events"}}), exceptions::MrcRuntimeError);
+}
+#endif
@@ -17,19 +17,60 @@
 
 #include "test_modules.hpp"
 
+#include "mrc/modules/module_config.hpp"
+#include "mrc/modules/module_registry.hpp"
 #include "mrc/modules/module_registry_util.hpp"
 #include "mrc/modules/sample_modules.hpp"
+#include "mrc/modules/segment_modules.hpp"
 #include "mrc/node/rx_source.hpp"
 #include "mrc/segment/builder.hpp"
 #include "mrc/version.hpp"
 
 #include <gtest/gtest.h>
+#include <nlohmann/json.hpp>
 
 #include <memory>
 #include <stdexcept>
 #include <string>
 #include <vector>
 
+namespace {
+
+struct CountingConfig
+{
+    int count{0};
+    std::string label;
+};
+
+void from_json(const nlohmann::json& json, CountingConfig& config)
+{
+    json.at("count").get_to(config.count);
+    config.label = json.value("label", "");
+}
+
+class TypedConfigModule final : public mrc::modules::SegmentModule
+{
+  public:
+    using config_t = CountingConfig;
+
+    using SegmentModule::SegmentModule;
+
+    std::string module_type_name() const final
+    {
+        return "TypedConfigModule";
+    }
+
+    const config_t* m_compiled{nullptr};
+
+  protected:
+    void initialize(mrc::segment::Builder& builder) final
+    {
+        m_compiled = &typed_config<config_t>();
+    }
+};
+
+}  // namespace
+
 namespace mrc {
 
 TEST_F(TestModuleUtil, ModuleRegistryUtilTest)
@@ -56,4 +97,55 @@ TEST_F(TestModuleUtil, ModuleRegistryUtilTest)
         std::invalid_argument);
 }
 
+TEST_F(TestModuleUtil, TypedConfigModules)
+{
+    using namespace modules;
+
+    const auto* registry_namespace = "mrc_unittest_typed";
+
+    const std::vector<unsigned int> release_version = {mrc_VERSION_MAJOR, mrc_VERSION_MINOR, mrc_VERSION_PATCH};
+
+    ModelRegistryUtil::create_registered_module<TypedConfigModule>(
+        "TypedConfigModule", registry_namespace, release_version);
+
+    // configurations are validated when the module is constructed, before it is initialized on a segment
+    auto fn_constructor = ModuleRegistry::get_module_constructor("TypedConfigModule", registry_namespace);
+    EXPECT_THROW(fn_constructor("invalid", {{"label", "no count"}}), std::invalid_argument);
+
+    std::vector<std::shared_ptr<SegmentModule>> modules;
+    m_pipeline->make_segment("TypedConfig_Segment", [&](segment::Builder& builder) {
+        modules = builder.load_modules_from_registry({
+            {"TypedConfigModule", registry_namespace, "typed_1", {{"count", 4}, {"label", "a"}}},
+            {"TypedConfigModule", registry_namespace, "typed_2", {{"count", 4}, {"label", "a"}}},
+            {"TypedConfigModule", registry_namespace, "typed_3", {{"count", 8}}},
+        });
+    });
+
+    auto options = std::make_shared<Options>();
+    options->topology().user_cpuset("0");
+    options->topology().restrict_gpus(true);
+
+    Executor executor(options);
+    executor.register_pipeline(std::move(m_pipeline));
+    executor.start();
+    executor.join();
+
+    ASSERT_EQ(modules.size(), 3);
+    auto typed_1 = std::dynamic_pointer_cast<TypedConfigModule>(modules[0]);
+    auto typed_2 = std::dynamic_pointer_cast<TypedConfigModule>(modules[1]);
+    auto typed_3 = std::dynamic_pointer_cast<TypedConfigModule>(modules[2]);
+    ASSERT_TRUE(typed_1 && typed_2 && typed_3);
+    EXPECT_EQ(typed_1->name(), "typed_1");
+    EXPECT_EQ(typed_3->name(), "typed_3");
+
+    // identical configurations share one compiled struct
+    EXPECT_EQ(typed_1->m_compiled, typed_2->m_compiled);
+    EXPECT_EQ(typed_1->m_compiled->count, 4);
+    EXPECT_EQ(typed_1->m_compiled->label, "a");
+    EXPECT_EQ(typed_3->m_compiled->count, 8);
+    EXPECT_EQ(CompiledConfigCache<CountingConfig>::size(), 2);
+
+    ModuleRegistry::unregister_module("TypedConfigModule", registry_namespace);
+}
+
 }  // namespace mrc
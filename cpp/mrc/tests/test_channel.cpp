@@ -19,23 +19,36 @@
 
 #include "mrc/channel/buffered_channel.hpp"
 #include "mrc/channel/egress.hpp"
+#include "mrc/channel/in_flight_budget.hpp"
 #include "mrc/channel/ingress.hpp"
 #include "mrc/channel/null_channel.hpp"
+#include "mrc/channel/priority_channel.hpp"
 #include "mrc/channel/recent_channel.hpp"
+#include "mrc/channel/ring_channel.hpp"
+#include "mrc/channel/sharded_channel.hpp"
 #include "mrc/core/userspace_threads.hpp"
 #include "mrc/core/watcher.hpp"
+#include "mrc/node/edge.hpp"
 
 #include <boost/fiber/buffered_channel.hpp>
 #include <boost/fiber/channel_op_status.hpp>
 #include <boost/fiber/future/future.hpp>
 #include <boost/fiber/operations.hpp>  // for sleep_for
 
+#include <algorithm>
+#include <atomic>
 #include <chrono>      // for duration, system_clock, milliseconds, time_point
 #include <cstddef>     // for size_t
 #include <cstdint>     // for uint64_t
 #include <functional>  // for ref, reference_wrapper
 #include <memory>
+#include <numeric>
+#include <optional>
+#include <stdexcept>
+#include <thread>
+#include <type_traits>
 #include <utility>
+#include <vector>
 // IWYU thinks algorithm is needed for: auto channel = std::make_shared<RecentChannel<int>>(2);
 // IWYU pragma: no_include <algorithm>
 
@@ -177,6 +190,31 @@ TEST_F(TestChannel, BufferedChannel)
     EXPECT_GE(t, 0.1);
 }
 
+TEST_F(TestChannel, WatcherAddedOnce)
+{
+    auto channel  = std::make_shared<BufferedChannel<int>>(4);
+    auto observer = std::make_shared<TestChannelObserver>();
+
+    channel->add_watcher(observer);
+    channel->add_watcher(observer);
+    channel->await_write(42);
+
+#ifdef MRC_TRACING_DISABLED
+    EXPECT_EQ(observer->m_write_counter, 0);
+#else
+    EXPECT_EQ(observer->m_write_counter, 1);
+#endif
+
+    channel->remove_watcher(observer);
+    channel->await_write(2);
+
+#ifdef MRC_TRACING_DISABLED
+    EXPECT_EQ(observer->m_write_counter, 0);
+#else
+    EXPECT_EQ(observer->m_write_counter, 1);
+#endif
+}
+
 TEST_F(TestChannel, RecentChannel)
 {
     auto channel = std::make_shared<RecentChannel<int>>(2);
@@ -193,6 +231,21 @@ TEST_F(TestChannel, RecentChannel)
     EXPECT_EQ(i, 2);
     egress.try_read(std::ref(i));
     EXPECT_EQ(i, -2);
+    EXPECT_EQ(channel->dropped_count(), 1);
+    EXPECT_EQ(egress.try_read(std::ref(i)), channel::Status::empty);
+
+    // a full channel never blocks the writer
+    for (int j = 0; j < 100; j++)
+    {
+        EXPECT_EQ(ingress.await_write(int(j)), channel::Status::success);
+    }
+    EXPECT_EQ(channel->dropped_count(), 99);
+    egress.await_read(std::ref(i));
+    EXPECT_EQ(i, 98);
+
+    // reads are reachable through the concrete type as well as through Egress
+    EXPECT_EQ(channel->await_read(i), channel::Status::success);
+    EXPECT_EQ(i, 99);
 
     /*
     auto f = userspace_threads::async([&] {
@@ -209,6 +262,556 @@ TEST_F(TestChannel, RecentChannel)
     */
 }
 
+TEST_F(TestChannel, RingChannel)
+{
+    auto channel = std::make_shared<RingChannel<int, channel::RingTopology::spsc>>(4);
+
+    channel::Ingress<int>& ingress = *channel;
+    channel::Egress<int>& egress   = *channel;
+
+    // unlike BufferedChannel, the full capacity of the ring is usable
+    for (int i = 0; i < 4; i++)
+    {
+        EXPECT_EQ(ingress.await_write(i), channel::Status::success);
+    }
+
+    int i;
+    for (int j = 0; j < 4; j++)
+    {
+        EXPECT_EQ(egress.try_read(std::ref(i)), channel::Status::success);
+        EXPECT_EQ(i, j);
+    }
+    EXPECT_EQ(egress.try_read(std::ref(i)), channel::Status::empty);
+
+    auto deadline = channel::clock_t::now() + std::chrono::milliseconds(10);
+    EXPECT_EQ(egress.await_read_until(std::ref(i), deadline), channel::Status::timeout);
+
+    // elements written before close are drained before closed is reported
+    ingress.await_write(42);
+    channel->close_channel();
+    EXPECT_EQ(ingress.await_write(2), channel::Status::closed);
+    EXPECT_EQ(egress.await_read(std::ref(i)), channel::Status::success);
+    EXPECT_EQ(i, 42);
+    EXPECT_EQ(egress.await_read(std::ref(i)), channel::Status::closed);
+
+    EXPECT_THROW((RingChannel<int>(3)), std::invalid_argument);
+}
+
+TEST_F(TestChannel, RingChannelMultiProducerMultiConsumer)
+{
+    constexpr int Producers = 4;
+    constexpr int Consumers = 4;
+    constexpr int Count     = 10000;
+
+    std::shared_ptr<channel::Channel<int>> channel = channel::make_ring_channel<int>(8, Producers, Consumers);
+
+    std::atomic<std::int64_t> sum{0};
+    std::atomic<std::size_t> read_count{0};
+    std::vector<std::thread> producers;
+    std::vector<std::thread> consumers;
+
+    for (int c = 0; c < Consumers; c++)
+    {
+        consumers.emplace_back([&] {
+            int val;
+            while (channel->await_read(val) == channel::Status::success)
+            {
+                sum += val;
+                read_count++;
+            }
+        });
+    }
+
+    for (int p = 0; p < Producers; p++)
+    {
+        producers.emplace_back([&] {
+            for (int i = 0; i < Count; i++)
+            {
+                EXPECT_EQ(channel->await_write(int(i)), channel::Status::success);
+            }
+        });
+    }
+
+    for (auto& t : producers)
+    {
+        t.join();
+    }
+    channel->close_channel();
+    for (auto& t : consumers)
+    {
+        t.join();
+    }
+
+    EXPECT_EQ(read_count, Producers * Count);
+    EXPECT_EQ(sum, std::int64_t(Producers) * Count * (Count - 1) / 2);
+}
+
+TEST_F(TestChannel, BatchedReadWrite)
+{
+    auto check_channel = [](std::shared_ptr<channel::Channel<int>> channel) {
+        std::vector<int> input{0, 1, 2, 3, 4, 5};
+        std::vector<int> output;
+
+        EXPECT_EQ(channel->await_write_n(input), channel::Status::success);
+
+        // reads are capped at max_count
+        EXPECT_EQ(channel->await_read_n(output, 4), channel::Status::success);
+        EXPECT_EQ(output, (std::vector<int>{0, 1, 2, 3}));
+
+        // reads return what is available without waiting for max_count
+        output.clear();
+        EXPECT_EQ(channel->await_read_n(output, 4), channel::Status::success);
+        EXPECT_EQ(output, (std::vector<int>{4, 5}));
+
+        output.clear();
+        auto deadline = channel::clock_t::now() + std::chrono::milliseconds(10);
+        EXPECT_EQ(channel->await_read_n(output, 4, deadline), channel::Status::timeout);
+        EXPECT_TRUE(output.empty());
+
+        channel->close_channel();
+        EXPECT_EQ(channel->await_write_n(input), channel::Status::closed);
+        EXPECT_EQ(channel->await_read_n(output, 4), channel::Status::closed);
+        EXPECT_TRUE(output.empty());
+    };
+
+    check_channel(std::make_shared<BufferedChannel<int>>(8));
+    check_channel(std::make_shared<RecentChannel<int>>(8));
+    check_channel(std::make_shared<RingChannel<int, channel::RingTopology::spsc>>(8));
+    check_channel(std::make_shared<RingChannel<int, channel::RingTopology::mpmc>>(8));
+}
+
+TEST_F(TestChannel, BatchedWriteBlocksWhenFull)
+{
+    auto channel = std::make_shared<RingChannel<int>>(4);
+
+    auto f = userspace_threads::async([channel] {
+        std::vector<int> input(16);
+        for (int i = 0; i < input.size(); i++)
+        {
+            input[i] = i;
+        }
+        return channel->await_write_n(input);
+    });
+
+    std::vector<int> output;
+    while (output.size() < 16)
+    {
+        EXPECT_EQ(channel->await_read_n(output, 3), channel::Status::success);
+    }
+    EXPECT_EQ(f.get(), channel::Status::success);
+
+    for (int i = 0; i < output.size(); i++)
+    {
+        EXPECT_EQ(output[i], i);
+    }
+}
+
+TEST_F(TestChannel, WaitPolicyCounters)
+{
+    auto channel = std::make_shared<BufferedChannel<int>>(4);
+    channel->set_wait_policy({channel::WaitStrategy::spin_yield, 0, 16});
+
+    int i;
+
+    // data already present
+    channel->await_write(1);
+    EXPECT_EQ(channel->await_read(i), channel::Status::success);
+    EXPECT_EQ(channel->wait_counters().immediate, 1);
+
+    // writer fiber is only scheduled once the reader yields
+    auto writer = userspace_threads::async([channel] { channel->await_write(2); });
+    EXPECT_EQ(channel->await_read(i), channel::Status::success);
+    EXPECT_EQ(i, 2);
+    EXPECT_EQ(channel->wait_counters().yield, 1);
+    writer.get();
+
+    // writer sleeps past the yield phase, the reader must park
+    channel->set_wait_policy({channel::WaitStrategy::spin, 16, 0});
+    writer = userspace_threads::async([channel] {
+        boost::this_fiber::sleep_for(std::chrono::milliseconds(10));
+        channel->await_write(3);
+    });
+    EXPECT_EQ(channel->await_read(i), channel::Status::success);
+    EXPECT_EQ(i, 3);
+    EXPECT_EQ(channel->wait_counters().park, 1);
+    writer.get();
+}
+
+TEST_F(TestChannel, ChannelStatistics)
+{
+    auto channel = std::make_shared<BufferedChannel<int>>(8);
+
+    channel->await_write(1);
+    channel->await_write(2);
+    channel->await_write(3);
+
+    int i;
+    channel->await_read(i);
+
+    auto stats = channel->statistics();
+    EXPECT_EQ(stats.capacity, 7);
+    EXPECT_EQ(stats.writes, 3);
+    EXPECT_EQ(stats.reads, 1);
+    EXPECT_EQ(stats.occupancy, 2);
+    EXPECT_EQ(stats.high_water_mark, 3);
+    EXPECT_EQ(stats.blocked_reader_time.count(), 0);
+
+    channel->try_read(i);
+    channel->try_read(i);
+    channel->reset_high_water_mark();
+    EXPECT_EQ(channel->statistics().high_water_mark, 0);
+
+    // a reader which has to wait on the writer accumulates blocked reader time
+    auto writer = userspace_threads::async([channel] {
+        boost::this_fiber::sleep_for(std::chrono::milliseconds(10));
+        channel->await_write(4);
+    });
+    channel->await_read(i);
+    writer.get();
+    EXPECT_GE(channel->statistics().blocked_reader_time, std::chrono::milliseconds(10));
+
+    // evictions from a RecentChannel are accounted as drops
+    auto recent = std::make_shared<RecentChannel<int>>(2);
+    recent->await_write(1);
+    recent->await_write(2);
+    recent->await_write(3);
+    EXPECT_EQ(recent->statistics().dropped, 1);
+    EXPECT_EQ(recent->statistics().occupancy, 2);
+}
+
+TEST_F(TestChannel, ChannelTelemetryReadsBeforeWrites)
+{
+    // a woken reader may record its read before the writer records the write which woke it
+    channel::ChannelTelemetry telemetry;
+    telemetry.record_reads(1);
+    telemetry.record_dropped(1);
+    telemetry.record_writes(1);
+    EXPECT_EQ(telemetry.occupancy(), 0);
+    EXPECT_EQ(telemetry.statistics(8).high_water_mark, 0);
+
+    telemetry.record_writes(3);
+    EXPECT_EQ(telemetry.occupancy(), 2);
+    EXPECT_EQ(telemetry.statistics(8).high_water_mark, 2);
+}
+
+TEST_F(TestChannel, WritableCapacity)
+{
+    auto channel = std::make_shared<BufferedChannel<int>>(8);
+    EXPECT_EQ(channel->writable_capacity(), 7);
+
+    channel->await_write(1);
+    channel->await_write(2);
+    EXPECT_EQ(channel->writable_capacity(), 5);
+
+    int i;
+    channel->await_read(i);
+    EXPECT_EQ(channel->writable_capacity(), 6);
+
+    // converting edges forward the demand of the channel they write to
+    node::Edge<int, long> edge(std::make_shared<BufferedChannel<long>>(4));
+    edge.await_write(1);
+    EXPECT_EQ(edge.writable_capacity(), 2);
+
+    auto ring = std::make_shared<RingChannel<int>>(4);
+    for (int j = 0; j < 4; j++)
+    {
+        ring->await_write(std::move(j));
+    }
+    EXPECT_EQ(ring->writable_capacity(), 0);
+
+    // channels of unknown capacity report no demand
+    EXPECT_EQ(std::make_shared<NullChannel<int>>()->writable_capacity(), std::nullopt);
+}
+
+TEST_F(TestChannel, RingChannelAutoTuneGrows)
+{
+    channel::RingAutoTuneOptions options;
+    options.min_capacity        = 2;
+    options.max_capacity        = 16;
+    options.evaluation_interval = 4;
+
+    auto channel = std::make_shared<RingChannel<int, channel::RingTopology::spsc>>(options);
+    EXPECT_EQ(channel->statistics().capacity, 2);
+
+    // a fast producer against a slow consumer stalls the writer, the channel should grow to its upper bound
+    auto writer = userspace_threads::async([channel] {
+        for (int i = 0; i < 64; i++)
+        {
+            channel->await_write(int(i));
+        }
+        channel->close_channel();
+    });
+
+    int i;
+    int expected = 0;
+    while (channel->await_read(i) == channel::Status::success)
+    {
+        EXPECT_EQ(i, expected++);
+        boost::this_fiber::sleep_for(std::chrono::microseconds(100));
+    }
+    writer.get();
+
+    EXPECT_EQ(expected, 64);
+    EXPECT_EQ(channel->statistics().capacity, 16);
+    EXPECT_GT(channel->statistics().high_water_mark, 2);
+}
+
+// only pairs with an integral priority may omit the priority function
+static_assert(std::is_constructible_v<PriorityChannel<std::pair<int, int>>, std::size_t>);
+static_assert(!std::is_constructible_v<PriorityChannel<int>, std::size_t>);
+static_assert(!std::is_default_constructible_v<PriorityChannel<int>>);
+
+TEST_F(TestChannel, PriorityChannel)
+{
+    using data_t = std::pair<int, int>;
+    auto channel = std::make_shared<PriorityChannel<data_t>>(8);
+
+    channel->await_write({0, 1});
+    channel->await_write({0, 2});
+    channel->await_write({5, 3});
+    channel->await_write({1, 4});
+    channel->await_write({5, 5});
+
+    // highest priority first, fifo within a priority level
+    std::vector<int> order;
+    data_t data;
+    while (channel->try_read(data) == channel::Status::success)
+    {
+        order.push_back(data.second);
+    }
+    EXPECT_EQ(order, (std::vector<int>{3, 5, 4, 1, 2}));
+
+    channel->await_write({0, 6});
+    channel->close_channel();
+    EXPECT_EQ(channel->await_write({0, 7}), channel::Status::closed);
+    EXPECT_EQ(channel->await_read(data), channel::Status::success);
+    EXPECT_EQ(data.second, 6);
+    EXPECT_EQ(channel->await_read(data), channel::Status::closed);
+}
+
+TEST_F(TestChannel, PriorityChannelStarvationProtection)
+{
+    // priority is the value itself; the oldest element may be bypassed at most twice in a row
+    auto channel = std::make_shared<PriorityChannel<int>>(
+        16, [](const int& value) { return value; }, 2);
+
+    channel->await_write(0);
+    for (int i = 1; i <= 6; i++)
+    {
+        channel->await_write(int(10 + i));
+    }
+
+    std::vector<int> order;
+    int value;
+    while (channel->try_read(value) == channel::Status::success)
+    {
+        order.push_back(value);
+    }
+    EXPECT_EQ(order, (std::vector<int>{16, 15, 0, 14, 13, 11, 12}));
+}
+
+TEST_F(TestChannel, PriorityChannelWriteBatchBeyondCapacity)
+{
+    using data_t = std::pair<int, int>;
+    auto channel = std::make_shared<PriorityChannel<data_t>>(4);
+
+    // the reader parks on the empty channel before the batch is written
+    std::vector<int> received;
+    std::thread reader([&] {
+        data_t data;
+        while (channel->await_read(data) == channel::Status::success)
+        {
+            received.push_back(data.second);
+        }
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+
+    std::vector<data_t> input;
+    for (int i = 0; i < 16; i++)
+    {
+        input.emplace_back(0, i);
+    }
+    EXPECT_EQ(channel->await_write_n(input), channel::Status::success);
+    channel->close_channel();
+    reader.join();
+
+    std::vector<int> expected(16);
+    std::iota(expected.begin(), expected.end(), 0);
+    EXPECT_EQ(received, expected);
+}
+
+TEST_F(TestChannel, ShardedChannel)
+{
+    auto channel = std::make_shared<ShardedChannel<int>>(4, 8);
+    EXPECT_EQ(channel->shard_count(), 4U);
+
+    // a single reader steals the elements written to the other shards
+    for (int i = 0; i < 8; i++)
+    {
+        EXPECT_EQ(channel->await_write(int(i)), channel::Status::success);
+    }
+
+    std::vector<int> values;
+    EXPECT_EQ(channel->await_read_n(values, 2), channel::Status::success);
+    EXPECT_EQ(values.size(), 2U);
+
+    int value;
+    while (channel->try_read(value) == channel::Status::success)
+    {
+        values.push_back(value);
+    }
+    std::sort(values.begin(), values.end());
+    EXPECT_EQ(values, (std::vector<int>{0, 1, 2, 3, 4, 5, 6, 7}));
+    EXPECT_EQ(channel->try_read(value), channel::Status::empty);
+
+    auto deadline = channel::clock_t::now() + std::chrono::milliseconds(10);
+    EXPECT_EQ(channel->await_read_until(value, deadline), channel::Status::timeout);
+
+    channel->await_write(8);
+    channel->close_channel();
+    EXPECT_EQ(channel->await_write(9), channel::Status::closed);
+    EXPECT_EQ(channel->await_read(value), channel::Status::success);
+    EXPECT_EQ(value, 8);
+    EXPECT_EQ(channel->await_read(value), channel::Status::closed);
+}
+
+TEST_F(TestChannel, ShardedChannelMultiProducerMultiConsumer)
+{
+    constexpr int Producers = 2;
+    constexpr int Consumers = 8;
+    constexpr int Count     = 10000;
+
+    auto channel = std::make_shared<ShardedChannel<int>>(Consumers, 64);
+
+    std::atomic<std::int64_t> sum{0};
+    std::atomic<std::size_t> read_count{0};
+    std::vector<std::thread> producers;
+    std::vector<std::thread> consumers;
+
+    for (int c = 0; c < Consumers; c++)
+    {
+        consumers.emplace_back([&] {
+            int val;
+            while (channel->await_read(val) == channel::Status::success)
+            {
+                sum += val;
+                read_count++;
+            }
+        });
+    }
+
+    for (int p = 0; p < Producers; p++)
+    {
+        producers.emplace_back([&] {
+            for (int i = 0; i < Count; i++)
+            {
+                EXPECT_EQ(channel->await_write(int(i)), channel::Status::success);
+            }
+        });
+    }
+
+    for (auto& t : producers)
+    {
+        t.join();
+    }
+    channel->close_channel();
+    for (auto& t : consumers)
+    {
+        t.join();
+    }
+
+    EXPECT_EQ(read_count, Producers * Count);
+    EXPECT_EQ(sum, std::int64_t(Producers) * Count * (Count - 1) / 2);
+}
+
+TEST_F(TestChannel, InFlightBudget)
+{
+    auto budget = std::make_shared<channel::InFlightBudget>(4 * sizeof(std::uint64_t));
+    auto first  = std::make_shared<BufferedChannel<std::uint64_t>>(16);
+    auto second = std::make_shared<BufferedChannel<std::uint64_t>>(16);
+    auto third  = std::make_shared<BufferedChannel<std::uint64_t>>(16);
+    first->set_in_flight_budget(budget);
+    second->set_in_flight_budget(budget);
+    third->set_in_flight_budget(budget);
+
+    for (std::uint64_t i = 0; i < 3; i++)
+    {
+        EXPECT_EQ(first->await_write(std::uint64_t(i)), channel::Status::success);
+    }
+    EXPECT_EQ(second->await_write(std::uint64_t(3)), channel::Status::success);
+    EXPECT_EQ(budget->in_flight(), 4 * sizeof(std::uint64_t));
+
+    // the budget is shared, so a second write to the second channel waits for a read of the first
+    std::atomic<bool> written{false};
+    std::thread writer([&] {
+        EXPECT_EQ(second->await_write(std::uint64_t(4)), channel::Status::success);
+        written = true;
+    });
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    EXPECT_FALSE(written);
+
+    std::uint64_t value;
+    EXPECT_EQ(first->await_read(value), channel::Status::success);
+    writer.join();
+    EXPECT_TRUE(written);
+    EXPECT_EQ(budget->blocked_count(), 1U);
+
+    // a channel holding none of the budget is admitted its reserve of one write beyond the limit
+    EXPECT_EQ(third->await_write(std::uint64_t(5)), channel::Status::success);
+    EXPECT_EQ(budget->in_flight(), 5 * sizeof(std::uint64_t));
+
+    std::vector<std::uint64_t> values;
+    EXPECT_EQ(first->await_read_n(values, 8), channel::Status::success);
+    values.clear();
+    EXPECT_EQ(second->await_read_n(values, 8), channel::Status::success);
+    EXPECT_EQ(third->try_read(value), channel::Status::success);
+    EXPECT_EQ(budget->in_flight(), 0U);
+}
+
+TEST_F(TestChannel, InFlightBudgetStages)
+{
+    // src -> mid -> sink sharing a budget of a few elements: the upstream writes must not starve the downstream hop
+    constexpr std::uint64_t Count = 10000;
+
+    auto budget = std::make_shared<channel::InFlightBudget>(4 * sizeof(std::uint64_t));
+    auto mid_in  = std::make_shared<BufferedChannel<std::uint64_t>>(16);
+    auto sink_in = std::make_shared<BufferedChannel<std::uint64_t>>(16);
+    mid_in->set_in_flight_budget(budget);
+    sink_in->set_in_flight_budget(budget);
+
+    std::thread src([&] {
+        for (std::uint64_t i = 0; i < Count; i++)
+        {
+            mid_in->await_write(std::uint64_t(i));
+        }
+        mid_in->close_channel();
+    });
+
+    std::thread mid([&] {
+        std::uint64_t value;
+        while (mid_in->await_read(value) == channel::Status::success)
+        {
+            std::this_thread::sleep_for(std::chrono::microseconds(5));
+            sink_in->await_write(std::move(value));
+        }
+        sink_in->close_channel();
+    });
+
+    std::uint64_t received = 0;
+    std::uint64_t value;
+    while (sink_in->await_read(value) == channel::Status::success)
+    {
+        EXPECT_EQ(value, received);
+        received++;
+    }
+
+    src.join();
+    mid.join();
+    EXPECT_EQ(received, Count);
+    EXPECT_EQ(budget->in_flight(), 0U);
+}
+
 TEST_F(TestChannel, OnComplete) {}
 
 TEST_F(TestChannel, AwaitWriteOverloads)
@@ -0,0 +1,111 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "mrc/core/completion.hpp"
+#include "mrc/coroutines/sync_wait.hpp"
+#include "mrc/coroutines/task.hpp"
+
+#include <boost/fiber/fiber.hpp>
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace mrc;
+using namespace std::chrono_literals;
+
+class TestCompletion : public ::testing::Test
+{};
+
+TEST_F(TestCompletion, ReadyBeforeAwait)
+{
+    Completion<std::string> completion;
+    EXPECT_FALSE(completion.is_ready());
+
+    completion.complete("done");
+    EXPECT_TRUE(completion.is_ready());
+    EXPECT_EQ(completion.await(), "done");
+    EXPECT_TRUE(completion.wait_for(0ms));
+
+    completion.reset();
+    EXPECT_FALSE(completion.is_ready());
+    EXPECT_FALSE(completion.wait_for(1ms));
+
+    completion.complete("again");
+    EXPECT_EQ(completion.value(), "again");
+}
+
+TEST_F(TestCompletion, AwaitedByThreadsAndFibers)
+{
+    Completion<int> completion;
+    std::atomic<int> sum{0};
+
+    std::vector<std::thread> threads;
+    for (int i = 0; i < 4; ++i)
+    {
+        threads.emplace_back([&] { sum += completion.await(); });
+    }
+
+    boost::fibers::fiber fiber([&] { sum += completion.await(); });
+
+    std::this_thread::sleep_for(10ms);
+    EXPECT_EQ(sum, 0);
+
+    std::thread producer([&] { completion.complete(2); });
+    fiber.join();
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+    producer.join();
+
+    EXPECT_EQ(sum, 10);
+}
+
+TEST_F(TestCompletion, AwaitedByCoroutine)
+{
+    Completion<void> completion;
+
+    auto task = [&]() -> coroutines::Task<bool> {
+        co_await completion;
+        co_return completion.is_ready();
+    };
+
+    std::thread producer([&] {
+        std::this_thread::sleep_for(10ms);
+        completion.complete();
+    });
+    EXPECT_TRUE(coroutines::sync_wait(task()));
+    producer.join();
+}
+
+TEST_F(TestCompletion, WaitForTimesOut)
+{
+    Completion<int> completion;
+    EXPECT_FALSE(completion.wait_for(5ms));
+
+    // the waiter which timed out is still in the list; completing releases it
+    completion.complete(1);
+    EXPECT_TRUE(completion.wait_for(5ms));
+
+    // a waiter which timed out and was never completed is released with the completion
+    Completion<int> abandoned;
+    EXPECT_FALSE(abandoned.wait_for(1ms));
+}
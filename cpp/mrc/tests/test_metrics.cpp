@@ -18,12 +18,16 @@
 #include "./test_mrc.hpp"  // IWYU pragma: associated
 
 #include "mrc/metrics/counter.hpp"
+#include "mrc/metrics/histogram.hpp"
 #include "mrc/metrics/registry.hpp"
 
 #include <gtest/gtest.h>  // for AssertionResult, SuiteApiResolver, TestInfo, EXPECT_TRUE, Message, TEST_F, Test, TestFactoryImpl, TestPartResult
 
+#include <chrono>
+#include <cstdint>
 #include <memory>
 #include <string>  // for allocator, operator==, basic_string, string
+#include <thread>
 #include <vector>
 
 namespace mrc {
@@ -55,4 +59,65 @@ TEST_F(TestMetrics, ThroughputCounter)
     EXPECT_EQ(report[0].count, 43);
 }
 
+TEST_F(TestMetrics, Histogram)
+{
+    auto histogram = m_registry->make_histogram("mrc_test_latency", {{"name", "test_histogram"}});
+
+    // each thread records 1..10000, so the quantiles of the merged histogram are those of a single thread
+    std::vector<std::thread> threads;
+    for (int i = 0; i < 4; i++)
+    {
+        threads.emplace_back([histogram]() mutable {
+            for (std::uint64_t value = 1; value <= 10000; value++)
+            {
+                histogram.record(std::chrono::nanoseconds(value));
+            }
+        });
+    }
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+
+    auto report = m_registry->collect_histograms();
+    ASSERT_EQ(report.size(), 1);
+    EXPECT_EQ(report[0].name, "mrc_test_latency");
+
+    const auto& snapshot = report[0].snapshot;
+    EXPECT_EQ(snapshot.count(), 40000);
+    EXPECT_EQ(snapshot.sum(), 4 * 50005000);
+    EXPECT_EQ(snapshot.max(), 10000);
+    EXPECT_NEAR(snapshot.value_at_quantile(0.5), 5000, 5000 / 64);
+    EXPECT_NEAR(snapshot.value_at_quantile(0.99), 9900, 9900 / 64);
+    EXPECT_EQ(snapshot.value_at_quantile(1.0), 10000);
+
+    // values below 128 are counted exactly
+    Histogram small;
+    small.record(std::uint64_t(3));
+    small.record(std::uint64_t(7));
+    EXPECT_EQ(small.snapshot().value_at_quantile(0.5), 3);
+    EXPECT_EQ(Histogram().snapshot().value_at_quantile(0.5), 0);
+}
+
+TEST_F(TestMetrics, Scrape)
+{
+    auto gauge     = m_registry->make_gauge("mrc_test_gauge", {{"name", "test_gauge"}});
+    auto histogram = m_registry->make_histogram("mrc_test_scrape_latency", {{"name", "test_histogram"}});
+    gauge.set(42);
+    histogram.record(std::uint64_t(100));
+
+    auto text = m_registry->scrape();
+    EXPECT_NE(text.find("mrc_test_gauge{name=\"test_gauge\"} 42"), std::string::npos);
+    EXPECT_NE(text.find("mrc_test_scrape_latency{name=\"test_histogram\",quantile=\"0.5\"} 100"), std::string::npos);
+    EXPECT_NE(text.find("mrc_test_scrape_latency_count{name=\"test_histogram\"} 1"), std::string::npos);
+
+    // families of the same name from different registries are merged into one
+    Registry other;
+    other.make_gauge("mrc_test_gauge", {{"name", "other_gauge"}}).set(1);
+    auto all = Registry::scrape_all();
+    EXPECT_NE(all.find("other_gauge"), std::string::npos);
+    EXPECT_NE(all.find("test_gauge"), std::string::npos);
+    EXPECT_EQ(all.find("# TYPE mrc_test_gauge"), all.rfind("# TYPE mrc_test_gauge"));
+}
+
 }  // namespace mrc
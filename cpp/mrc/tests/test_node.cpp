@@ -17,11 +17,35 @@
 
 #include "test_mrc.hpp"  // IWYU pragma: associated
 
+#include "mrc/channel/buffered_channel.hpp"
+#include "mrc/channel/spill_channel.hpp"
+#include "mrc/codable/fundamental_types.hpp"  // IWYU pragma: keep
 #include "mrc/core/executor.hpp"
+#include "mrc/core/watcher.hpp"
+#include "mrc/coroutines/async_generator.hpp"
+#include "mrc/coroutines/generator.hpp"
+#include "mrc/coroutines/ring_buffer.hpp"
+#include "mrc/coroutines/task.hpp"
+#include "mrc/coroutines/thread_pool.hpp"
 #include "mrc/engine/pipeline/ipipeline.hpp"
+#include "mrc/io/file.hpp"
+#include "mrc/io/mapped_file.hpp"
+#include "mrc/io/stream_consumer.hpp"
+#include "mrc/node/admission_node.hpp"
+#include "mrc/node/caching_node.hpp"
+#include "mrc/node/checkpoint.hpp"
+#include "mrc/node/checkpointable_source.hpp"
+#include "mrc/node/demand_source.hpp"
+#include "mrc/node/fair_muxer.hpp"
+#include "mrc/node/generator_source.hpp"
+#include "mrc/node/lazy_node.hpp"
+#include "mrc/node/operators/broadcast.hpp"
+#include "mrc/node/operators/keyed_join.hpp"
+#include "mrc/node/replay.hpp"
 #include "mrc/node/rx_node.hpp"
 #include "mrc/node/rx_sink.hpp"
 #include "mrc/node/rx_source.hpp"
+#include "mrc/node/stream_source.hpp"
 #include "mrc/options/options.hpp"
 #include "mrc/options/placement.hpp"
 #include "mrc/options/topology.hpp"
@@ -31,22 +55,33 @@
 #include "mrc/segment/builder.hpp"
 #include "mrc/utils/string_utils.hpp"
 
+#include <boost/fiber/operations.hpp>
 #include <glog/logging.h>
 #include <gtest/gtest.h>
 #include <rxcpp/rx.hpp>
+#include <unistd.h>
 
+#include <algorithm>
 #include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
 #include <exception>
+#include <filesystem>
+#include <fstream>
+#include <functional>
 #include <memory>
 #include <mutex>
+#include <optional>
 #include <set>
+#include <span>
 #include <sstream>
 #include <string>
+#include <string_view>
 #include <thread>
+#include <tuple>
 #include <utility>
-
-// IWYU thinks we need vector for make_segment
-// IWYU pragma: no_include <vector>
+#include <vector>
 
 using namespace std::chrono_literals;
 
@@ -137,6 +172,681 @@ TEST_F(TestNode, GenericEndToEnd)
     EXPECT_EQ(complete_count, 2);
 }
 
+TEST_F(TestNode, CoroEndToEnd)
+{
+    auto p    = pipeline::make_pipeline();
+    auto pool = std::make_shared<coroutines::ThreadPool>(coroutines::ThreadPool::Options{.thread_count = 2});
+
+    std::atomic<int> next_count = 0;
+    std::atomic<long> sum       = 0;
+
+    auto my_segment = p->make_segment("my_segment", [&](segment::Builder& seg) {
+        auto task_source = seg.make_coro_source<int>(
+            "task_src",
+            [](coroutines::RingBuffer<int>& output) -> coroutines::Task<void> {
+                for (int i = 0; i < 100; i++)
+                {
+                    co_await output.write(int(i));
+                }
+            },
+            pool);
+
+        auto generator_source = seg.make_coro_source<int>("generator_src", []() -> coroutines::Generator<int> {
+            for (int i = 100; i < 200; i++)
+            {
+                co_yield i;
+            }
+        });
+
+        // each call suspends on the pool so many calls are in flight at once
+        auto doubler = seg.make_coro_node<int, long>(
+            "doubler",
+            [pool](int x) -> coroutines::Task<long> {
+                co_await pool->yield();
+                co_return 2L * x;
+            },
+            16,
+            pool);
+
+        auto identity = seg.make_coro_node<int>("identity", [](int x) -> coroutines::Task<int> { co_return x; });
+
+        auto sink_long = seg.make_sink<long>("sink_long", [&](const long& x) {
+            sum += x;
+            ++next_count;
+        });
+
+        auto sink_int = seg.make_sink<int>("sink_int", [&](const int& x) {
+            sum += x;
+            ++next_count;
+        });
+
+        seg.make_edge(task_source, doubler);
+        seg.make_edge(doubler, sink_long);
+        seg.make_edge(generator_source, identity);
+        seg.make_edge(identity, sink_int);
+    });
+
+    auto options = std::make_unique<Options>();
+    options->topology().user_cpuset("0");
+
+    Executor exec(std::move(options));
+
+    exec.register_pipeline(std::move(p));
+
+    exec.start();
+
+    exec.join();
+
+    EXPECT_EQ(next_count, 200);
+    EXPECT_EQ(sum, 2 * (99 * 100 / 2) + (100 + 199) * 100 / 2);
+}
+
+TEST_F(TestNode, GeneratorSource)
+{
+    auto p = pipeline::make_pipeline();
+
+    auto pool = std::make_shared<coroutines::ThreadPool>(
+        coroutines::ThreadPool::Options{.thread_count = 1, .description = "generator"});
+
+    std::vector<int> outputs;
+    std::vector<long> async_outputs;
+    std::uint64_t max_ahead = 0;
+    node::GeneratorSource<int>* generator_node{nullptr};
+
+    auto my_segment = p->make_segment("my_segment", [&](segment::Builder& seg) {
+        auto generator_source = seg.make_generator_source<int>(
+            "generator_src",
+            []() -> coroutines::Generator<int> {
+                for (int i = 0; i < 100; i++)
+                {
+                    co_yield i;
+                }
+            },
+            {.prefetch = 4});
+        generator_node = &generator_source->object();
+
+        // the body of the async generator resumes on the pool between values
+        auto async_source = seg.make_generator_source<long>("async_src", [pool]() -> coroutines::AsyncGenerator<long> {
+            for (long i = 0; i < 100; i++)
+            {
+                co_await pool->schedule();
+                co_yield 2 * i;
+            }
+        });
+
+        // a slow sink behind a small channel saturates the edge, so the pulls are bounded by the prefetch
+        auto sink = seg.make_sink<int>("sink", [&](int x) {
+            outputs.push_back(x);
+            max_ahead = std::max(max_ahead, generator_node->pulled_count() - outputs.size());
+            boost::this_fiber::sleep_for(std::chrono::microseconds(100));
+        });
+        sink->object().update_channel(std::make_unique<channel::BufferedChannel<int>>(4));
+
+        auto async_sink = seg.make_sink<long>("async_sink", [&](long x) { async_outputs.push_back(x); });
+
+        seg.make_edge(generator_source, sink);
+        seg.make_edge(async_source, async_sink);
+    });
+
+    auto options = std::make_unique<Options>();
+    options->topology().user_cpuset("0");
+
+    Executor exec(std::move(options));
+
+    exec.register_pipeline(std::move(p));
+
+    exec.start();
+
+    exec.join();
+
+    ASSERT_EQ(outputs.size(), 100U);
+    ASSERT_EQ(async_outputs.size(), 100U);
+    for (int i = 0; i < 100; i++)
+    {
+        EXPECT_EQ(outputs[i], i);
+        EXPECT_EQ(async_outputs[i], 2L * i);
+    }
+
+    // values held by the channel, the prefetch queue and the writing fiber
+    EXPECT_EQ(generator_node->pulled_count(), 100);
+    EXPECT_LE(max_ahead, 4 + 4 + 1);
+}
+
+TEST_F(TestNode, DemandSource)
+{
+    auto p = pipeline::make_pipeline();
+
+    std::vector<int> outputs;
+    std::vector<std::size_t> requests;
+    std::size_t max_ahead = 0;
+    int next              = 0;
+
+    auto my_segment = p->make_segment("my_segment", [&](segment::Builder& seg) {
+        auto source = seg.make_demand_source<int>("demand_src", [&](std::size_t n, std::vector<int>& batch) {
+            requests.push_back(n);
+            for (std::size_t i = 0; i < n && next < 100; i++)
+            {
+                batch.push_back(next++);
+            }
+            return next < 100;
+        });
+
+        // the requests never exceed the free capacity of the channel of the slow sink
+        auto sink = seg.make_sink<int>("sink", [&](int x) {
+            outputs.push_back(x);
+            max_ahead = std::max(max_ahead, static_cast<std::size_t>(next) - outputs.size());
+            boost::this_fiber::sleep_for(std::chrono::microseconds(100));
+        });
+        sink->object().update_channel(std::make_unique<channel::BufferedChannel<int>>(8));
+
+        seg.make_edge(source, sink);
+    });
+
+    auto options = std::make_unique<Options>();
+    options->topology().user_cpuset("0");
+
+    Executor exec(std::move(options));
+
+    exec.register_pipeline(std::move(p));
+
+    exec.start();
+
+    exec.join();
+
+    ASSERT_EQ(outputs.size(), 100U);
+    for (int i = 0; i < 100; i++)
+    {
+        EXPECT_EQ(outputs[i], i);
+    }
+
+    ASSERT_FALSE(requests.empty());
+    for (auto n : requests)
+    {
+        EXPECT_GE(n, 1);
+        EXPECT_LE(n, 7);
+    }
+
+    // values held by the channel and the sink
+    EXPECT_LE(max_ahead, 7 + 1);
+}
+
+TEST_F(TestNode, FileSourceSink)
+{
+    const auto input  = std::filesystem::temp_directory_path() / ("mrc_file_source_" + std::to_string(::getpid()));
+    const auto output = std::filesystem::path(input).replace_extension(".out");
+
+    std::string contents;
+    for (int i = 0; i < 1000; i++)
+    {
+        contents += "record " + std::to_string(i) + "\n";
+    }
+    std::ofstream(input) << contents;
+
+    std::atomic<std::size_t> line_count = 0;
+
+    auto p = pipeline::make_pipeline();
+
+    auto my_segment = p->make_segment("my_segment", [&](segment::Builder& seg) {
+        // small reads, so records straddle reads and several rounds of read-ahead are needed
+        auto source = seg.make_file_source("src", input, {.chunk_size = 256, .read_ahead = 2});
+
+        auto count = seg.make_node<io::FileChunk>("count", rxcpp::operators::map([&](io::FileChunk chunk) {
+                                                      chunk.for_each_line([&](std::string_view) { ++line_count; });
+                                                      return chunk;
+                                                  }));
+
+        auto sink = seg.make_file_sink("sink", output, {.chunk_size = 1024});
+
+        seg.make_edge(source, count);
+        seg.make_edge(count, sink);
+    });
+
+    auto options = std::make_unique<Options>();
+    options->topology().user_cpuset("0");
+
+    Executor exec(std::move(options));
+
+    exec.register_pipeline(std::move(p));
+
+    exec.start();
+
+    exec.join();
+
+    EXPECT_EQ(line_count, 1000);
+
+    std::stringstream written;
+    written << std::ifstream(output).rdbuf();
+    EXPECT_EQ(written.str(), contents);
+
+    std::filesystem::remove(input);
+    std::filesystem::remove(output);
+}
+
+TEST_F(TestNode, MappedFileSource)
+{
+    const auto input = std::filesystem::temp_directory_path() / ("mrc_mapped_source_" + std::to_string(::getpid()));
+
+    std::string contents;
+    for (int i = 0; i < 1000; i++)
+    {
+        contents += "record " + std::to_string(i) + "\n";
+    }
+    std::ofstream(input) << contents;
+
+    std::mutex mutex;
+    std::set<std::string> lines;
+    std::size_t bytes = 0;
+
+    auto p = pipeline::make_pipeline();
+
+    auto my_segment = p->make_segment("my_segment", [&](segment::Builder& seg) {
+        // each pe emits the records of half of the file
+        auto source = seg.make_mapped_file_source("src", input, {.chunk_size = 256});
+        source->launch_options().pe_count = 2;
+
+        auto sink = seg.make_sink<io::MappedView>("sink", [&](io::MappedView view) {
+            std::lock_guard<std::mutex> lock(mutex);
+            bytes += view.bytes();
+            view.for_each_line([&](std::string_view line) { EXPECT_TRUE(lines.emplace(line).second) << line; });
+        });
+
+        seg.make_edge(source, sink);
+    });
+
+    auto options = std::make_unique<Options>();
+    options->topology().user_cpuset("0-1");
+
+    Executor exec(std::move(options));
+
+    exec.register_pipeline(std::move(p));
+
+    exec.start();
+
+    exec.join();
+
+    EXPECT_EQ(lines.size(), 1000);
+    EXPECT_EQ(bytes, contents.size());
+
+    std::filesystem::remove(input);
+}
+
+TEST_F(TestNode, Batcher)
+{
+    auto p = pipeline::make_pipeline();
+
+    std::mutex mutex;
+    std::vector<std::size_t> count_batches;
+    std::vector<std::size_t> byte_batches;
+
+    auto my_segment = p->make_segment("my_segment", [&](segment::Builder& seg) {
+        auto source = seg.make_source<int>("src", [](rxcpp::subscriber<int>& s) {
+            for (int i = 0; i < 10; i++)
+            {
+                s.on_next(int(i));
+            }
+            s.on_completed();
+        });
+
+        auto bcast = std::make_shared<node::Broadcast<int>>();
+        seg.make_edge(source, *bcast);
+
+        // the latency trigger is not reached, so only the count trigger and the close of the input emit batches
+        auto by_count = seg.make_batcher<int>("by_count", {.max_count = 4, .max_latency = 10s});
+
+        // every element is estimated at 3 bytes, so a batch is emitted once it holds 2 elements
+        auto by_bytes = seg.make_batcher<int>(
+            "by_bytes", {.max_count = 100, .max_latency = 10s, .max_bytes = 5}, [](const int&) { return 3; });
+
+        auto count_sink = seg.make_sink<std::vector<int>>("count_sink", [&](std::vector<int> batch) {
+            std::lock_guard<std::mutex> lock(mutex);
+            count_batches.push_back(batch.size());
+        });
+
+        auto bytes_sink = seg.make_sink<std::vector<int>>("bytes_sink", [&](std::vector<int> batch) {
+            std::lock_guard<std::mutex> lock(mutex);
+            byte_batches.push_back(batch.size());
+        });
+
+        seg.make_edge(*bcast, by_count);
+        seg.make_edge(by_count, count_sink);
+        seg.make_edge(*bcast, by_bytes);
+        seg.make_edge(by_bytes, bytes_sink);
+    });
+
+    auto options = std::make_unique<Options>();
+    options->topology().user_cpuset("0");
+
+    Executor exec(std::move(options));
+
+    exec.register_pipeline(std::move(p));
+
+    exec.start();
+
+    exec.join();
+
+    // batches hold at most the trigger counts; the remainder is emitted when the input closes
+    std::size_t count_total = 0;
+    for (auto size : count_batches)
+    {
+        EXPECT_LE(size, 4U);
+        count_total += size;
+    }
+    EXPECT_EQ(count_total, 10U);
+
+    std::size_t bytes_total = 0;
+    for (auto size : byte_batches)
+    {
+        EXPECT_LE(size, 2U);
+        bytes_total += size;
+    }
+    EXPECT_EQ(bytes_total, 10U);
+}
+
+TEST_F(TestNode, OrderedNode)
+{
+    auto p = pipeline::make_pipeline();
+
+    std::vector<long> outputs;
+
+    auto my_segment = p->make_segment("my_segment", [&](segment::Builder& seg) {
+        auto source = seg.make_source<int>("src", [](rxcpp::subscriber<int>& s) {
+            for (int i = 0; i < 100; i++)
+            {
+                s.on_next(int(i));
+            }
+            s.on_completed();
+        });
+
+        // later inputs complete first, so the outputs would be reordered without the reorder buffer
+        auto ordered = seg.make_ordered_node<int, long>(
+            "ordered",
+            [](int&& x) {
+                boost::this_fiber::sleep_for(std::chrono::microseconds((100 - x % 10) * 10));
+                return 2L * x;
+            },
+            8);
+        ordered->launch_options().pe_count       = 2;
+        ordered->launch_options().engines_per_pe = 2;
+
+        auto sink = seg.make_sink<long>("sink", [&](long x) { outputs.push_back(x); });
+
+        seg.make_edge(source, ordered);
+        seg.make_edge(ordered, sink);
+    });
+
+    auto options = std::make_unique<Options>();
+    options->topology().user_cpuset("0-1");
+
+    Executor exec(std::move(options));
+
+    exec.register_pipeline(std::move(p));
+
+    exec.start();
+
+    exec.join();
+
+    ASSERT_EQ(outputs.size(), 100U);
+    for (int i = 0; i < 100; i++)
+    {
+        EXPECT_EQ(outputs[i], 2L * i);
+    }
+}
+
+TEST_F(TestNode, CachingNode)
+{
+    auto p = pipeline::make_pipeline();
+
+    std::vector<long> outputs;
+    std::atomic<int> mapped{0};
+    node::CachingNode<int, long, int>* caching_node{nullptr};
+
+    auto my_segment = p->make_segment("my_segment", [&](segment::Builder& seg) {
+        auto source = seg.make_source<int>("src", [](rxcpp::subscriber<int>& s) {
+            for (int i = 0; i < 100; i++)
+            {
+                s.on_next(int(i));
+            }
+            s.on_completed();
+        });
+
+        // ten distinct keys; repeats of a key are either found in the cache or wait on the engine mapping it
+        auto caching = seg.make_caching_node<int, long, int>(
+            "caching",
+            [&](int&& x) {
+                ++mapped;
+                boost::this_fiber::sleep_for(std::chrono::microseconds(100));
+                return 2L * (x % 10);
+            },
+            [](const int& x) { return x % 10; });
+        caching->launch_options().pe_count       = 2;
+        caching->launch_options().engines_per_pe = 2;
+        caching_node                             = &caching->object();
+
+        auto sink = seg.make_sink<long>("sink", [&](long x) { outputs.push_back(x); });
+
+        seg.make_edge(source, caching);
+        seg.make_edge(caching, sink);
+    });
+
+    auto options = std::make_unique<Options>();
+    options->topology().user_cpuset("0-1");
+
+    Executor exec(std::move(options));
+
+    exec.register_pipeline(std::move(p));
+
+    exec.start();
+
+    exec.join();
+
+    ASSERT_EQ(outputs.size(), 100U);
+    std::sort(outputs.begin(), outputs.end());
+    for (int i = 0; i < 100; i++)
+    {
+        EXPECT_EQ(outputs[i], 2L * (i / 10));
+    }
+
+    EXPECT_EQ(mapped.load(), 10);
+    EXPECT_EQ(caching_node->miss_count(), 10);
+    EXPECT_EQ(caching_node->hit_count() + caching_node->miss_count() + caching_node->coalesced_count(), 100);
+    EXPECT_EQ(caching_node->cache().size(), 10);
+}
+
+TEST_F(TestNode, LazyNode)
+{
+    using namespace std::chrono_literals;
+
+    auto p = pipeline::make_pipeline();
+
+    std::vector<int> outputs;
+    std::atomic<int> builds{0};
+    node::LazyNode<int>* lazy_node{nullptr};
+    node::LazyNode<int>* unused_node{nullptr};
+
+    auto my_segment = p->make_segment("my_segment", [&](segment::Builder& seg) {
+        // the pause exceeds the idle timeout, so the map function is released and built again
+        auto source = seg.make_source<int>("src", [](rxcpp::subscriber<int>& s) {
+            for (int i = 0; i < 10; i++)
+            {
+                if (i == 5)
+                {
+                    boost::this_fiber::sleep_for(100ms);
+                }
+                s.on_next(int(i));
+            }
+            s.on_completed();
+        });
+        auto idle = seg.make_source<int>("idle", [](rxcpp::subscriber<int>& s) { s.on_completed(); });
+
+        auto factory = [&] {
+            ++builds;
+            return std::function<int(int&&)>([](int&& x) { return x * 2; });
+        };
+
+        auto lazy   = seg.make_lazy_node<int>("lazy", factory, {.idle_timeout = 10ms});
+        auto unused = seg.make_lazy_node<int>("unused", factory);
+        lazy_node   = &lazy->object();
+        unused_node = &unused->object();
+
+        auto sink      = seg.make_sink<int>("sink", [&](int x) { outputs.push_back(x); });
+        auto idle_sink = seg.make_sink<int>("idle_sink", [](int) {});
+
+        seg.make_edge(source, lazy);
+        seg.make_edge(lazy, sink);
+        seg.make_edge(idle, unused);
+        seg.make_edge(unused, idle_sink);
+    });
+
+    auto options = std::make_unique<Options>();
+    options->topology().user_cpuset("0");
+
+    Executor exec(std::move(options));
+
+    exec.register_pipeline(std::move(p));
+
+    exec.start();
+
+    exec.join();
+
+    ASSERT_EQ(outputs.size(), 10U);
+    for (int i = 0; i < 10; i++)
+    {
+        EXPECT_EQ(outputs[i], 2 * i);
+    }
+
+    EXPECT_EQ(builds.load(), 2);
+    EXPECT_EQ(lazy_node->build_count(), 2);
+    EXPECT_EQ(lazy_node->release_count(), 1);
+    EXPECT_FALSE(lazy_node->is_built());
+    EXPECT_EQ(unused_node->build_count(), 0);
+}
+
+TEST_F(TestNode, FairMuxer)
+{
+    auto p = pipeline::make_pipeline();
+
+    std::vector<int> outputs;
+
+    auto my_segment = p->make_segment("my_segment", [&](segment::Builder& seg) {
+        auto chatty = seg.make_source<int>("chatty", [](rxcpp::subscriber<int>& s) {
+            for (int i = 0; i < 100; i++)
+            {
+                s.on_next(int(i));
+            }
+            s.on_completed();
+        });
+
+        auto quiet = seg.make_source<int>("quiet", [](rxcpp::subscriber<int>& s) {
+            for (int i = 1000; i < 1010; i++)
+            {
+                s.on_next(int(i));
+            }
+            s.on_completed();
+        });
+
+        auto muxer = seg.construct_object<node::FairMuxer<int>>("muxer", node::FairMuxerInputOptions{.capacity = 4});
+
+        auto sink = seg.make_sink<int>("sink", [&](int x) { outputs.push_back(x); });
+
+        seg.make_edge(chatty, muxer->object().input(0, {.weight = 2, .capacity = 4}));
+        seg.make_edge(quiet, muxer->object().input(1));
+        seg.make_edge(muxer, sink);
+    });
+
+    auto options = std::make_unique<Options>();
+    options->topology().user_cpuset("0");
+
+    Executor exec(std::move(options));
+
+    exec.register_pipeline(std::move(p));
+
+    exec.start();
+
+    exec.join();
+
+    // every element is forwarded and the elements of each input keep their order
+    ASSERT_EQ(outputs.size(), 110U);
+    int last_chatty = -1;
+    int last_quiet  = 999;
+    for (auto x : outputs)
+    {
+        auto& last = (x < 1000 ? last_chatty : last_quiet);
+        EXPECT_EQ(x, last + 1);
+        last = x;
+    }
+}
+
+TEST_F(TestNode, WindowAndJoin)
+{
+    auto p = pipeline::make_pipeline();
+
+    using window_t = node::KeyedWindow<int, int>;
+    using joined_t = std::tuple<int, int, int>;
+
+    std::vector<window_t> windows;
+    std::vector<joined_t> joined;
+
+    auto my_segment = p->make_segment("my_segment", [&](segment::Builder& seg) {
+        auto source = seg.make_source<int>("src", [](rxcpp::subscriber<int>& s) {
+            for (int i = 0; i < 12; i++)
+            {
+                s.on_next(int(i));
+            }
+            s.on_completed();
+        });
+
+        auto bcast = std::make_shared<node::Broadcast<int>>();
+        seg.make_edge(source, *bcast);
+
+        // tumbling windows of 2 elements per parity
+        auto window = seg.make_window<int, int>(
+            "window", {.kind = node::WindowKind::Count, .size = 2}, [](const int& x) { return x % 2; });
+        auto window_sink = seg.make_sink<window_t>("window_sink", [&](window_t w) { windows.push_back(std::move(w)); });
+
+        // joins the elements below 4 with the elements from 4 on of the same parity
+        auto join = std::make_shared<node::KeyedJoin<int, int, int>>([](const int& x) { return x % 2; },
+                                                                      [](const int& x) { return x % 2; });
+        auto join_sink = seg.make_sink<joined_t>("join_sink", [&](joined_t j) { joined.push_back(j); });
+        auto for_left  = seg.make_node<int>("left", rxcpp::operators::filter([](int x) { return x < 4; }));
+        auto for_right = seg.make_node<int>("right", rxcpp::operators::filter([](int x) { return x >= 4; }));
+
+        seg.make_edge(*bcast, window);
+        seg.make_edge(window, window_sink);
+        seg.make_edge(*bcast, for_left);
+        seg.make_edge(*bcast, for_right);
+        seg.make_edge(for_left, join->left());
+        seg.make_edge(for_right, join->right());
+        seg.make_edge(*join, join_sink);
+    });
+
+    auto options = std::make_unique<Options>();
+    options->topology().user_cpuset("0");
+
+    Executor exec(std::move(options));
+
+    exec.register_pipeline(std::move(p));
+
+    exec.start();
+
+    exec.join();
+
+    ASSERT_EQ(windows.size(), 6U);
+    for (const auto& w : windows)
+    {
+        ASSERT_EQ(w.elements.size(), 2U);
+        EXPECT_EQ(w.elements[0] % 2, w.key);
+        EXPECT_EQ(w.elements[1], w.elements[0] + 2);
+    }
+
+    // each of the 2 left elements of a parity joins each of the 4 right elements of its parity
+    EXPECT_EQ(joined.size(), 16U);
+    for (const auto& [key, left, right] : joined)
+    {
+        EXPECT_EQ(left % 2, key);
+        EXPECT_EQ(right % 2, key);
+    }
+}
+
 // ======= Replace SourceRoundRobinPolicy with approprate Operator =======
 // TEST_F(TestNode, EnsureMoveSemantics)
 // {
@@ -393,6 +1103,426 @@ TEST_F(TestNode, NodePrologueEpilogue)
     EXPECT_EQ(epilogue_tap_sum, 20);
 }
 
+TEST_F(TestNode, NodeTraceTaps)
+{
+    auto p = pipeline::make_pipeline();
+
+    std::atomic<int> tap_count   = 0;
+    std::atomic<int> trace_count = 0;
+
+    auto my_segment = p->make_segment("my_segment", [&](segment::Builder& seg) {
+        auto source = seg.make_source<int>("src1", [&](rxcpp::subscriber<int>& s) {
+            for (int i = 0; i < 100; i++)
+            {
+                s.on_next(i);
+            }
+            s.on_completed();
+        });
+
+        auto node = seg.make_node<int>("node", rxcpp::operators::map([](const int& x) { return x; }));
+
+        node->object().add_epilogue_tap([&tap_count](const int& x) { ++tap_count; });
+        node->object().add_epilogue_trace_tap([&trace_count](const int& x) { ++trace_count; });
+
+        seg.make_edge(source, node);
+
+        auto sink = seg.make_sink<int>("sinkRef", [&](const int& x) {});
+
+        seg.make_edge(node, sink);
+    });
+
+    auto options = std::make_unique<Options>();
+    options->topology().user_cpuset("0");
+
+    Executor exec(std::move(options));
+
+    exec.register_pipeline(std::move(p));
+
+    // trace taps see 1 in 4 elements while tracing is enabled
+    const bool was_enabled = TraceControl::is_enabled();
+    TraceControl::enable(true);
+    TraceControl::set_sample_rate(4);
+
+    exec.start();
+
+    exec.join();
+
+    TraceControl::set_sample_rate(1);
+    TraceControl::enable(was_enabled);
+
+    EXPECT_EQ(tap_count, 100);
+    EXPECT_EQ(trace_count, 25);
+}
+
+static std::pair<std::uint64_t, std::uint64_t> run_admission(node::AdmissionOptions options, int count)
+{
+    auto p = pipeline::make_pipeline();
+
+    std::atomic<std::uint64_t> received{0};
+    std::shared_ptr<segment::Object<node::AdmissionNode<int>>> admission;
+
+    p->make_segment("my_segment", [&](segment::Builder& seg) {
+        auto source = seg.make_source<int>("src", [count](rxcpp::subscriber<int>& s) {
+            for (int i = 0; i < count && s.is_subscribed(); i++)
+            {
+                s.on_next(i);
+            }
+            s.on_completed();
+        });
+
+        admission = seg.make_admission_node<int>("admission", options);
+        auto sink = seg.make_sink<int>("sink", [&received](int x) { ++received; });
+
+        seg.make_edge(source, admission);
+        seg.make_edge(admission, sink);
+    });
+
+    auto exec_options = std::make_unique<Options>();
+    exec_options->topology().user_cpuset("0");
+
+    Executor exec(std::move(exec_options));
+    exec.register_pipeline(std::move(p));
+    exec.start();
+    exec.join();
+
+    EXPECT_EQ(received, admission->object().admitted_count());
+    return {admission->object().admitted_count(), admission->object().shed_count()};
+}
+
+TEST_F(TestNode, AdmissionNode)
+{
+    node::AdmissionOptions options;
+    options.rate  = 100;
+    options.burst = 10;
+
+    // a burst far above the rate is shed beyond the bucket instead of pushing back on the source
+    options.policy        = node::ShedPolicy::DropNewest;
+    auto [admitted, shed] = run_admission(options, 1000);
+    EXPECT_EQ(admitted + shed, 1000);
+    EXPECT_GE(admitted, 10);
+    EXPECT_LT(admitted, 100);
+
+    options.policy           = node::ShedPolicy::Sample;
+    options.sample_every     = 10;
+    std::tie(admitted, shed) = run_admission(options, 1000);
+    EXPECT_EQ(admitted + shed, 1000);
+    EXPECT_GE(admitted, 100);
+
+    // blocking admits every element, paced by the rate
+    options.rate             = 1000;
+    options.policy           = node::ShedPolicy::Block;
+    auto start               = std::chrono::steady_clock::now();
+    std::tie(admitted, shed) = run_admission(options, 60);
+    EXPECT_EQ(admitted, 60);
+    EXPECT_EQ(shed, 0);
+    EXPECT_GE(std::chrono::steady_clock::now() - start, 40ms);
+}
+
+namespace {
+
+// emits the integers [resume_token, stop_at); the token of a position is the next integer to emit
+class RangeCheckpointSource final : public node::CheckpointableSource<int>
+{
+  public:
+    RangeCheckpointSource(std::shared_ptr<node::CheckpointCoordinator> coordinator, int stop_at) :
+      node::CheckpointableSource<int>(std::move(coordinator), 10),
+      m_stop_at(stop_at)
+    {}
+
+  private:
+    void data_source(rxcpp::subscriber<int>& s, const std::optional<std::string>& resume_token) final
+    {
+        m_next = (resume_token ? std::stoi(*resume_token) : 0);
+        while (m_next < m_stop_at && s.is_subscribed())
+        {
+            s.on_next(m_next++);
+        }
+        s.on_completed();
+    }
+
+    std::string checkpoint_token() final
+    {
+        return std::to_string(m_next);
+    }
+
+    const int m_stop_at;
+    int m_next{0};
+};
+
+std::vector<int> run_checkpointed_range(const std::shared_ptr<node::CheckpointStore>& store, int stop_at)
+{
+    auto p = pipeline::make_pipeline();
+
+    auto coordinator = std::make_shared<node::CheckpointCoordinator>("range", store);
+    std::vector<int> received;
+
+    p->make_segment("my_segment", [&](segment::Builder& seg) {
+        auto source = seg.construct_object<RangeCheckpointSource>("src", coordinator, stop_at);
+        auto sink   = seg.make_sink<node::Checkpointed<int>>(
+            "sink", node::acknowledge_checkpoints<int>(coordinator, [&received](int x) { received.push_back(x); }));
+        seg.make_edge(source, sink);
+    });
+
+    auto options = std::make_unique<Options>();
+    options->topology().user_cpuset("0");
+
+    Executor exec(std::move(options));
+    exec.register_pipeline(std::move(p));
+    exec.start();
+    exec.join();
+
+    return received;
+}
+
+}  // namespace
+
+TEST_F(TestNode, CheckpointableSource)
+{
+    auto store = std::make_shared<node::MemoryCheckpointStore>();
+
+    // the first run dies after 35 elements; three periodic markers and the final one are committed
+    auto first = run_checkpointed_range(store, 35);
+    EXPECT_EQ(first.size(), 35);
+    auto checkpoint = store->load("range");
+    ASSERT_TRUE(checkpoint);
+    EXPECT_EQ(checkpoint->epoch, 4);
+    EXPECT_EQ(checkpoint->token, "35");
+
+    // the restarted run resumes behind the last committed element
+    auto second = run_checkpointed_range(store, 100);
+    ASSERT_EQ(second.size(), 65);
+    EXPECT_EQ(second.front(), 35);
+    EXPECT_EQ(store->load("range")->token, "100");
+}
+
+TEST_F(TestNode, FileCheckpointStore)
+{
+    auto directory = std::filesystem::temp_directory_path() / ("mrc_checkpoints_" + std::to_string(getpid()));
+
+    {
+        node::FileCheckpointStore store(directory);
+        EXPECT_FALSE(store.load("seg/src"));
+        store.save("seg/src", {3, std::string("offset\n42", 9)});
+    }
+
+    node::FileCheckpointStore store(directory);
+    auto checkpoint = store.load("seg/src");
+    ASSERT_TRUE(checkpoint);
+    EXPECT_EQ(checkpoint->epoch, 3);
+    EXPECT_EQ(checkpoint->token, std::string("offset\n42", 9));
+
+    std::filesystem::remove_all(directory);
+}
+
+namespace {
+
+// stream of count messages of a single partition, received in batches of at most max_messages
+class VectorStreamConsumer final : public io::StreamConsumer
+{
+  public:
+    VectorStreamConsumer(std::int64_t count) : m_count(count) {}
+
+    std::optional<std::vector<io::StreamMessage>> poll(std::size_t max_messages,
+                                                       std::chrono::milliseconds /*timeout*/) final
+    {
+        if (m_next == m_count)
+        {
+            return std::nullopt;
+        }
+        std::vector<io::StreamMessage> batch;
+        while (m_next < m_count && batch.size() < max_messages)
+        {
+            auto payload = std::make_shared<std::string>("message " + std::to_string(m_next));
+            auto bytes   = std::as_bytes(std::span(payload->data(), payload->size()));
+            batch.emplace_back(
+                std::move(payload), io::StreamPartition{"events", 0}, m_next++, std::span<const std::byte>{}, bytes);
+        }
+        return batch;
+    }
+
+    void commit(const io::StreamOffsets& offsets) final
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_commits.push_back(offsets);
+    }
+
+    std::vector<io::StreamOffsets> commits()
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_commits;
+    }
+
+  private:
+    const std::int64_t m_count;
+    std::int64_t m_next{0};
+    std::mutex m_mutex;
+    std::vector<io::StreamOffsets> m_commits;
+};
+
+}  // namespace
+
+TEST_F(TestNode, StreamSource)
+{
+    auto consumer = std::make_shared<VectorStreamConsumer>(1000);
+    std::vector<std::string> received;
+
+    auto p = pipeline::make_pipeline();
+
+    p->make_segment("my_segment", [&](segment::Builder& seg) {
+        auto source = seg.make_stream_source("src", consumer, {.max_batch_size = 64, .commit_interval = 4});
+        auto sink   = seg.make_sink<node::Checkpointed<std::vector<io::StreamMessage>>>(
+            "sink",
+            node::acknowledge_checkpoints<std::vector<io::StreamMessage>>(
+                source->object().coordinator(), [&received](std::vector<io::StreamMessage> batch) {
+                    EXPECT_LE(batch.size(), 64);
+                    for (const auto& message : batch)
+                    {
+                        received.emplace_back(message.view());
+                    }
+                }));
+        seg.make_edge(source, sink);
+    });
+
+    auto options = std::make_unique<Options>();
+    options->topology().user_cpuset("0");
+
+    Executor exec(std::move(options));
+    exec.register_pipeline(std::move(p));
+    exec.start();
+    exec.join();
+
+    ASSERT_EQ(received.size(), 1000);
+    EXPECT_EQ(received.back(), "message 999");
+
+    // a commit every four batches of 64 and a final one behind the last message
+    auto commits = consumer->commits();
+    ASSERT_EQ(commits.size(), 4);
+    EXPECT_EQ(commits.front().at({"events", 0}), 256);
+    EXPECT_EQ(commits.back().at({"events", 0}), 1000);
+}
+
+namespace {
+
+void run_single_segment(const std::function<void(segment::Builder&)>& init)
+{
+    auto p = pipeline::make_pipeline();
+    p->make_segment("my_segment", init);
+
+    auto options = std::make_unique<Options>();
+    options->topology().user_cpuset("0");
+
+    Executor exec(std::move(options));
+    exec.register_pipeline(std::move(p));
+    exec.start();
+    exec.join();
+}
+
+}  // namespace
+
+TEST_F(TestNode, RecordAndReplay)
+{
+    auto path = std::filesystem::temp_directory_path() / ("mrc_recording_" + std::to_string(getpid()));
+
+    run_single_segment([&](segment::Builder& seg) {
+        auto source = seg.make_source<std::string>("src", [](rxcpp::subscriber<std::string>& s) {
+            for (int i = 0; i < 20 && s.is_subscribed(); ++i)
+            {
+                s.on_next("element " + std::to_string(i));
+                boost::this_fiber::sleep_for(2ms);
+            }
+            s.on_completed();
+        });
+        auto sink = seg.construct_object<node::RecordingSink<std::string>>("sink", path);
+        seg.make_edge(source, sink);
+    });
+
+    // back to back, then at the recorded rate, which spans the 38ms between the first and the last element
+    for (double speedup : {0.0, 1.0})
+    {
+        std::vector<std::string> replayed;
+        const auto start = std::chrono::steady_clock::now();
+
+        run_single_segment([&](segment::Builder& seg) {
+            auto source = seg.construct_object<node::ReplaySource<std::string>>("src", path, speedup);
+            auto sink   = seg.make_sink<std::string>("sink", [&replayed](std::string x) {
+                replayed.push_back(std::move(x));
+            });
+            seg.make_edge(source, sink);
+        });
+
+        ASSERT_EQ(replayed.size(), 20);
+        EXPECT_EQ(replayed.front(), "element 0");
+        EXPECT_EQ(replayed.back(), "element 19");
+        if (speedup > 0)
+        {
+            EXPECT_GE(std::chrono::steady_clock::now() - start, 38ms);
+        }
+    }
+
+    std::filesystem::remove(path);
+}
+
+TEST_F(TestNode, SpillChannel)
+{
+    auto directory = std::filesystem::temp_directory_path() / ("mrc_spill_" + std::to_string(getpid()));
+    std::filesystem::create_directories(directory);
+
+    // the log file of the edge, if it has been created
+    auto spilled_bytes = [&directory] {
+        std::uintmax_t bytes = 0;
+        for (const auto& entry : std::filesystem::directory_iterator(directory))
+        {
+            bytes += entry.file_size();
+        }
+        return bytes;
+    };
+
+    std::vector<std::string> received;
+    std::uintmax_t spilled = 0;
+
+    run_single_segment([&](segment::Builder& seg) {
+        auto source = seg.make_source<std::string>("src", [](rxcpp::subscriber<std::string>& s) {
+            for (int i = 0; i < 200 && s.is_subscribed(); ++i)
+            {
+                s.on_next("element " + std::to_string(i));
+            }
+            s.on_completed();
+        });
+
+        // the sink stalls on its first element until the source has written all others, 8 to memory, the rest to disk
+        auto sink = seg.make_sink<std::string>("sink", [&](std::string x) {
+            if (received.empty())
+            {
+                for (int i = 0; i < 100 && spilled_bytes() == 0; ++i)
+                {
+                    boost::this_fiber::sleep_for(10ms);
+                }
+                boost::this_fiber::sleep_for(10ms);
+                spilled = spilled_bytes();
+            }
+            received.push_back(std::move(x));
+        });
+
+        channel::SpillChannelOptions options;
+        options.directory        = directory;
+        options.memory_watermark = 8;
+        sink->object().update_channel(std::make_unique<channel::SpillChannel<std::string>>(options));
+
+        seg.make_edge(source, sink);
+    });
+
+    EXPECT_GT(spilled, 0);
+    ASSERT_EQ(received.size(), 200);
+    for (std::size_t i = 0; i < received.size(); ++i)
+    {
+        EXPECT_EQ(received[i], "element " + std::to_string(i));
+    }
+
+    // the log is removed with the channel
+    EXPECT_TRUE(std::filesystem::is_empty(directory));
+    std::filesystem::remove_all(directory);
+}
+
 // the parallel tests:
 // - SourceMultiThread
 // - SinkMultiThread
@@ -0,0 +1,108 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "mrc/utils/numa_replicated.hpp"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using namespace mrc;
+
+class TestNumaReplicated : public ::testing::Test
+{};
+
+TEST_F(TestNumaReplicated, ReplicaPerNode)
+{
+    const auto nodes = utils::detail::online_numa_nodes();
+    ASSERT_FALSE(nodes.empty());
+
+    std::atomic<std::size_t> built{0};
+    utils::NumaReplicated<std::vector<std::uint32_t>> table([&](std::uint32_t numa_node) {
+        built++;
+        // the builder runs on the node of its replica
+        EXPECT_EQ(utils::detail::current_numa_node(), numa_node);
+        return std::make_shared<const std::vector<std::uint32_t>>(1024, numa_node);
+    });
+
+    EXPECT_EQ(built, nodes.size());
+    EXPECT_EQ(table.numa_nodes(), nodes);
+    EXPECT_EQ(table.version(), 0);
+    for (auto node : nodes)
+    {
+        EXPECT_EQ(table.load(node)->front(), node);
+    }
+
+    // the replica read by the calling thread is the one of its node
+    EXPECT_EQ(table.local().front(), table.load(utils::detail::current_numa_node())->front());
+    EXPECT_EQ(table.load_local().get(), table.load(utils::detail::current_numa_node()).get());
+}
+
+TEST_F(TestNumaReplicated, NodesWithoutReplicaReadTheFirstNode)
+{
+    utils::NumaReplicated<int> value([](std::uint32_t numa_node) { return std::make_shared<const int>(numa_node); },
+                                     {utils::detail::online_numa_nodes().front()});
+
+    EXPECT_EQ(*value.load(1024), utils::detail::online_numa_nodes().front());
+    EXPECT_EQ(value.local(), utils::detail::online_numa_nodes().front());
+}
+
+TEST_F(TestNumaReplicated, UpdatesSwapAllReplicas)
+{
+    utils::NumaReplicated<std::uint64_t> value([](std::uint32_t) { return std::make_shared<const std::uint64_t>(0); });
+
+    std::atomic<bool> running{true};
+    std::atomic<bool> mismatch{false};
+    std::thread reader([&] {
+        while (running)
+        {
+            // the value of each version is its version number
+            auto version = value.version();
+            if (value.local() < version)
+            {
+                mismatch = true;
+            }
+        }
+    });
+
+    for (std::uint64_t version = 1; version <= 100; ++version)
+    {
+        EXPECT_EQ(value.update([version](std::uint32_t) { return std::make_shared<const std::uint64_t>(version); }),
+                  version);
+        EXPECT_EQ(value.local(), version);
+    }
+
+    running = false;
+    reader.join();
+    EXPECT_FALSE(mismatch);
+    EXPECT_EQ(value.version(), 100);
+}
+
+TEST_F(TestNumaReplicated, FactoryExceptionsKeepTheCurrentVersion)
+{
+    utils::NumaReplicated<int> value([](std::uint32_t) { return std::make_shared<const int>(1); });
+
+    EXPECT_THROW(value.update([](std::uint32_t) -> std::shared_ptr<const int> { throw std::runtime_error("failed"); }),
+                 std::runtime_error);
+    EXPECT_EQ(value.version(), 0);
+    EXPECT_EQ(value.local(), 1);
+}
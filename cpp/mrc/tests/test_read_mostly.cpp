@@ -0,0 +1,109 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "mrc/utils/read_mostly.hpp"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <thread>
+#include <vector>
+
+using namespace mrc;
+
+class TestReadMostly : public ::testing::Test
+{};
+
+TEST_F(TestReadMostly, ReadsStoredValue)
+{
+    utils::ReadMostly<int> value(std::make_shared<int>(1));
+    EXPECT_EQ(value.read(), 1);
+
+    value.store(std::make_shared<int>(2));
+    EXPECT_EQ(value.read(), 2);
+
+    auto previous = value.exchange(std::make_shared<int>(3));
+    EXPECT_EQ(*previous, 2);
+    EXPECT_EQ(value.read(), 3);
+    EXPECT_EQ(*value.load(), 3);
+}
+
+TEST_F(TestReadMostly, HandlesSharingASlot)
+{
+    // handles created one after the other map to consecutive slots, so every slot is shared by more than one handle
+    std::vector<std::unique_ptr<utils::ReadMostly<std::size_t>>> handles;
+    for (std::size_t i = 0; i < 2 * utils::ReadMostly<std::size_t>::CacheSize + 1; ++i)
+    {
+        handles.push_back(std::make_unique<utils::ReadMostly<std::size_t>>(std::make_shared<std::size_t>(i)));
+    }
+    for (int pass = 0; pass < 2; ++pass)
+    {
+        for (std::size_t i = 0; i < handles.size(); ++i)
+        {
+            EXPECT_EQ(handles[i]->read(), i);
+        }
+    }
+}
+
+TEST_F(TestReadMostly, RetiredValueHeldByReaders)
+{
+    auto first = std::make_shared<int>(1);
+    std::weak_ptr<int> weak = first;
+    utils::ReadMostly<int> value(std::move(first));
+
+    EXPECT_EQ(value.read(), 1);
+    value.store(std::make_shared<int>(2));
+
+    // the cache of this thread holds the retired value until its next read
+    EXPECT_FALSE(weak.expired());
+    EXPECT_EQ(value.read(), 2);
+    EXPECT_TRUE(weak.expired());
+}
+
+TEST_F(TestReadMostly, ConcurrentReadsAndStores)
+{
+    utils::ReadMostly<int> value(std::make_shared<int>(0));
+    std::atomic<bool> running{true};
+
+    std::vector<std::thread> readers;
+    for (int i = 0; i < 4; ++i)
+    {
+        readers.emplace_back([&] {
+            int last = 0;
+            while (running.load())
+            {
+                // the values are stored in increasing order
+                auto current = value.read();
+                EXPECT_GE(current, last);
+                last = current;
+            }
+        });
+    }
+
+    for (int i = 1; i <= 1000; ++i)
+    {
+        value.store(std::make_shared<int>(i));
+    }
+    running = false;
+    for (auto& reader : readers)
+    {
+        reader.join();
+    }
+    EXPECT_EQ(value.read(), 1000);
+}
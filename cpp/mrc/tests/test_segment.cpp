@@ -18,6 +18,7 @@
 #include "test_segment.hpp"
 
 #include "mrc/benchmarking/trace_statistics.hpp"
+#include "mrc/channel/ring_channel.hpp"
 #include "mrc/channel/status.hpp"
 #include "mrc/core/executor.hpp"
 #include "mrc/engine/pipeline/ipipeline.hpp"
@@ -26,6 +27,7 @@
 #include "mrc/node/rx_node.hpp"
 #include "mrc/node/rx_sink.hpp"
 #include "mrc/node/rx_source.hpp"
+#include "mrc/node/sink_channel_base.hpp"
 #include "mrc/options/options.hpp"
 #include "mrc/options/topology.hpp"
 #include "mrc/pipeline/pipeline.hpp"
@@ -35,15 +37,19 @@
 #include "mrc/segment/ports.hpp"
 #include "mrc/types.hpp"
 
+#include <boost/fiber/fiber.hpp>
+#include <boost/fiber/operations.hpp>
 #include <glog/logging.h>
 #include <nlohmann/json.hpp>
 
 #include <array>
 #include <atomic>
+#include <chrono>
 #include <future>
 #include <iostream>
 #include <mutex>
 #include <string>
+#include <thread>
 #include <utility>
 #include <vector>
 
@@ -713,6 +719,212 @@ TEST_F(TestSegment, SegmentSingleSourceMultiNodes)
     }
 }
 
+TEST_F(TestSegment, SegmentSharedBroadcastOverflow)
+{
+    unsigned int iterations{100};
+    std::atomic<unsigned int> primary_count{0};
+    std::atomic<unsigned int> tap_count{0};
+    std::shared_ptr<node::SharedBroadcast<std::string>> bcast;
+
+    auto init = [&](segment::Builder& segment) {
+        auto src = segment.make_source<std::string>("src", [&](rxcpp::subscriber<std::string>& s) {
+            for (size_t i = 0; i < iterations && s.is_subscribed(); i++)
+            {
+                s.on_next("payload");
+            }
+            s.on_completed();
+        });
+
+        bcast = std::make_shared<node::SharedBroadcast<std::string>>();
+        segment.make_edge(src, *bcast);
+
+        auto primary = segment.make_sink<std::shared_ptr<const std::string>>(
+            "primary", [&](std::shared_ptr<const std::string> x) { ++primary_count; });
+        segment.make_edge(*bcast, primary);
+
+        // a slow tap may only drop its own elements; the primary path receives every element
+        auto tap = segment.make_sink<std::shared_ptr<const std::string>>(
+            "tap", [&](std::shared_ptr<const std::string> x) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                ++tap_count;
+            });
+        segment.make_edge(*bcast, tap);
+        bcast->set_output_options(1, {node::BroadcastOverflowPolicy::Drop, 4});
+    };
+
+    auto segdef   = segment::Definition::create("segment_test", init);
+    auto pipeline = pipeline::make_pipeline();
+    pipeline->register_segment(segdef);
+    execute_pipeline(std::move(pipeline));
+
+    EXPECT_EQ(primary_count.load(), iterations);
+    auto tap_stats = bcast->output_statistics(1);
+    EXPECT_EQ(tap_stats.lag, 0U);
+    EXPECT_EQ(tap_stats.written, tap_count.load());
+    EXPECT_EQ(tap_stats.written + tap_stats.dropped, iterations);
+}
+
+TEST_F(TestSegment, SegmentFusedNodes)
+{
+    using fiber_id_t = boost::fibers::fiber::id;
+
+    std::array<fiber_id_t, 2> fused_ids;
+    std::vector<fiber_id_t> unfused_ids;
+    std::mutex mutex;
+    std::atomic<int> sum{0};
+
+    auto init = [&](segment::Builder& segment) {
+        segment.enable_fusion();
+
+        auto src = segment.make_source<int>("src", [](rxcpp::subscriber<int>& s) {
+            for (int i = 0; i < 100 && s.is_subscribed(); i++)
+            {
+                s.on_next(i);
+            }
+            s.on_completed();
+        });
+
+        auto a = segment.make_node<int>("a", rxcpp::operators::map([&](int x) {
+                                            fused_ids[0] = boost::this_fiber::get_id();
+                                            return x + 1;
+                                        }));
+        auto b = segment.make_node<int>("b", rxcpp::operators::map([&](int x) {
+                                            fused_ids[1] = boost::this_fiber::get_id();
+                                            return x * 2;
+                                        }));
+        auto c = segment.make_node<int>("c", rxcpp::operators::map([&](int x) {
+                                            std::lock_guard<std::mutex> lock(mutex);
+                                            unfused_ids.push_back(boost::this_fiber::get_id());
+                                            return x - 1;
+                                        }));
+        auto sink = segment.make_sink<int>("sink", [&](int x) { sum += x; });
+
+        segment.make_edge(src, a);
+        segment.make_edge(a, b);
+        segment.make_edge(b, c);
+        segment.make_edge(c, sink);
+
+        // differing launch options keep c on its own runnable
+        c->launch_options().engines_per_pe = 2;
+    };
+
+    auto segdef   = segment::Definition::create("segment_test", init);
+    auto pipeline = pipeline::make_pipeline();
+    pipeline->register_segment(segdef);
+    execute_pipeline(std::move(pipeline));
+
+    EXPECT_EQ(sum.load(), 10000);
+    EXPECT_EQ(fused_ids[0], fused_ids[1]);
+    EXPECT_EQ(unfused_ids.size(), 100U);
+    for (const auto& id : unfused_ids)
+    {
+        EXPECT_NE(id, fused_ids[0]);
+    }
+}
+
+TEST_F(TestSegment, SegmentRingChannels)
+{
+    using spsc_channel_t = channel::RingChannel<int, channel::RingTopology::spsc>;
+    using mpmc_channel_t = channel::RingChannel<int, channel::RingTopology::mpmc>;
+
+    // the input channel of each node, observed from within the node while it is running
+    std::atomic<bool> a_is_spsc{false};
+    std::atomic<bool> b_is_mpmc{false};
+    std::atomic<bool> sink_is_mpmc{false};
+    std::atomic<int> sum{0};
+
+    // the nodes are not moved to the executor until the pipeline is started, so their addresses remain valid
+    node::SinkChannelBase<int>* a_node    = nullptr;
+    node::SinkChannelBase<int>* b_node    = nullptr;
+    node::SinkChannelBase<int>* sink_node = nullptr;
+
+    auto init = [&](segment::Builder& segment) {
+        segment.enable_ring_channels();
+
+        auto src = segment.make_source<int>("src", [](rxcpp::subscriber<int>& s) {
+            for (int i = 0; i < 100 && s.is_subscribed(); i++)
+            {
+                s.on_next(i);
+            }
+            s.on_completed();
+        });
+
+        auto a = segment.make_node<int>("a", rxcpp::operators::map([&a_is_spsc, &a_node](int x) {
+                                            auto input = a_node->channel_observer().lock();
+                                            a_is_spsc  = dynamic_cast<const spsc_channel_t*>(input.get()) != nullptr;
+                                            return x + 1;
+                                        }));
+        auto b = segment.make_node<int>("b", rxcpp::operators::map([&b_is_mpmc, &b_node](int x) {
+                                            auto input = b_node->channel_observer().lock();
+                                            b_is_mpmc  = dynamic_cast<const mpmc_channel_t*>(input.get()) != nullptr;
+                                            return x * 2;
+                                        }));
+        auto sink = segment.make_sink<int>("sink", [&sum, &sink_is_mpmc, &sink_node](int x) {
+            auto input   = sink_node->channel_observer().lock();
+            sink_is_mpmc = dynamic_cast<const mpmc_channel_t*>(input.get()) != nullptr;
+            sum += x;
+        });
+
+        a_node    = &a->object();
+        b_node    = &b->object();
+        sink_node = &sink->object();
+
+        segment.make_edge(src, a);
+        segment.make_edge(a, b);
+        segment.make_edge(b, sink);
+
+        // set after the edges are formed; b has two readers, so b and sink, which has two writers, require mpmc
+        b->launch_options().engines_per_pe = 2;
+    };
+
+    auto segdef   = segment::Definition::create("segment_test", init);
+    auto pipeline = pipeline::make_pipeline();
+    pipeline->register_segment(segdef);
+    execute_pipeline(std::move(pipeline));
+
+    EXPECT_EQ(sum.load(), 10100);
+    EXPECT_TRUE(a_is_spsc);
+    EXPECT_TRUE(b_is_mpmc);
+    EXPECT_TRUE(sink_is_mpmc);
+}
+
+TEST_F(TestSegment, SegmentNodeComponent)
+{
+    boost::fibers::fiber::id source_id;
+    std::atomic<bool> inline_calls{true};
+    std::atomic<int> sum{0};
+
+    auto init = [&](segment::Builder& segment) {
+        auto src = segment.make_source<int>("src", [&](rxcpp::subscriber<int>& s) {
+            source_id = boost::this_fiber::get_id();
+            for (int i = 0; i < 100 && s.is_subscribed(); i++)
+            {
+                s.on_next(i);
+            }
+            s.on_completed();
+        });
+
+        // the component runs on the fiber of the source rather than a runnable of its own
+        auto component = segment.make_node_component<int>("component", rxcpp::operators::map([&](int x) {
+                                                              inline_calls = inline_calls &&
+                                                                             boost::this_fiber::get_id() == source_id;
+                                                              return x * 2;
+                                                          }));
+        auto sink = segment.make_sink<int>("sink", [&](int x) { sum += x; });
+
+        segment.make_edge(src, component);
+        segment.make_edge(component, sink);
+    };
+
+    auto segdef   = segment::Definition::create("segment_test", init);
+    auto pipeline = pipeline::make_pipeline();
+    pipeline->register_segment(segdef);
+    execute_pipeline(std::move(pipeline));
+
+    EXPECT_EQ(sum.load(), 9900);
+    EXPECT_TRUE(inline_calls.load());
+}
+
 TEST_F(TestSegment, EnsureMove)
 {
     auto init = [&](segment::Builder& segment) {
@@ -0,0 +1,173 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "mrc/data/sharded_cache.hpp"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace std::chrono_literals;
+
+namespace mrc {
+
+class TestShardedCache : public ::testing::Test
+{};
+
+TEST_F(TestShardedCache, GetPut)
+{
+    data::ShardedCache<std::string, int> cache;
+
+    EXPECT_FALSE(cache.get("a"));
+    EXPECT_TRUE(cache.put("a", 1));
+    EXPECT_EQ(cache.get("a"), 1);
+
+    // a put replaces the cached value
+    EXPECT_TRUE(cache.put("a", 2));
+    EXPECT_EQ(cache.get("a"), 2);
+    EXPECT_EQ(cache.size(), 1);
+
+    EXPECT_TRUE(cache.erase("a"));
+    EXPECT_FALSE(cache.erase("a"));
+
+    auto stats = cache.statistics();
+    EXPECT_EQ(stats.hits, 2);
+    EXPECT_EQ(stats.misses, 1);
+    EXPECT_EQ(stats.insertions, 1);
+    EXPECT_DOUBLE_EQ(stats.hit_rate(), 2.0 / 3.0);
+}
+
+TEST_F(TestShardedCache, EvictsLeastRecentlyUsed)
+{
+    data::ShardedCache<std::string, int> cache({.shard_count = 1, .max_entries = 3});
+
+    cache.put("a", 1);
+    cache.put("b", 2);
+    cache.put("c", 3);
+    EXPECT_TRUE(cache.get("a"));
+    cache.put("d", 4);
+
+    EXPECT_FALSE(cache.get("b"));
+    EXPECT_TRUE(cache.get("a"));
+    EXPECT_TRUE(cache.get("c"));
+    EXPECT_TRUE(cache.get("d"));
+    EXPECT_EQ(cache.statistics().evictions, 1);
+}
+
+TEST_F(TestShardedCache, BoundsBytes)
+{
+    data::ShardedCache<int, std::string> cache({.shard_count = 1, .max_entries = 0, .max_bytes = 10},
+                                               [](const int& /*key*/, const std::string& value) {
+                                                   return value.size();
+                                               });
+
+    EXPECT_TRUE(cache.put(1, "aaaa"));
+    EXPECT_TRUE(cache.put(2, "bbbb"));
+    EXPECT_TRUE(cache.put(3, "cccc"));
+    EXPECT_FALSE(cache.put(4, std::string(11, 'd')));
+
+    auto stats = cache.statistics();
+    EXPECT_EQ(stats.entries, 2);
+    EXPECT_EQ(stats.bytes, 8);
+    EXPECT_EQ(stats.rejections, 1);
+    EXPECT_FALSE(cache.get(1));
+}
+
+TEST_F(TestShardedCache, ExpiresEntries)
+{
+    data::ShardedCache<int, int> cache({.ttl = 20ms});
+
+    cache.put(1, 1);
+    EXPECT_EQ(cache.get(1), 1);
+
+    std::this_thread::sleep_for(30ms);
+    EXPECT_FALSE(cache.get(1));
+    EXPECT_EQ(cache.statistics().expirations, 1);
+    EXPECT_EQ(cache.size(), 0);
+}
+
+TEST_F(TestShardedCache, TinyLfuKeepsPopularEntries)
+{
+    data::ShardedCache<int, int> cache(
+        {.shard_count = 1, .max_entries = 2, .admission = data::CacheAdmission::tiny_lfu});
+
+    cache.put(1, 1);
+    cache.put(2, 2);
+    for (int i = 0; i < 8; ++i)
+    {
+        cache.get(1);
+        cache.get(2);
+    }
+
+    // a scan of one-off keys does not flush the popular ones
+    for (int key = 100; key < 200; ++key)
+    {
+        cache.get(key);
+        EXPECT_FALSE(cache.put(key, key));
+    }
+    EXPECT_TRUE(cache.get(1));
+    EXPECT_TRUE(cache.get(2));
+
+    // a key seen as often as the least recently used entry displaces it
+    for (int i = 0; i < 16; ++i)
+    {
+        cache.get(3);
+    }
+    EXPECT_TRUE(cache.put(3, 3));
+    EXPECT_FALSE(cache.get(1));
+}
+
+TEST_F(TestShardedCache, Concurrent)
+{
+    data::ShardedCache<int, int> cache({.shard_count = 4, .max_entries = 64});
+
+    constexpr int Lookups = 10000;
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t)
+    {
+        threads.emplace_back([&cache, t] {
+            for (int i = 0; i < Lookups; ++i)
+            {
+                auto key = (i * 7 + t) % 128;
+                if (auto value = cache.get(key))
+                {
+                    EXPECT_EQ(*value, key * 2);
+                }
+                else
+                {
+                    cache.put(key, key * 2);
+                }
+            }
+        });
+    }
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+
+    auto stats = cache.statistics();
+    EXPECT_EQ(stats.hits + stats.misses, 4 * Lookups);
+    EXPECT_LE(stats.entries, 64);
+    EXPECT_GT(stats.hits, 0);
+}
+
+}  // namespace mrc
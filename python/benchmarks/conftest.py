@@ -0,0 +1,74 @@
+# SPDX-FileCopyrightText: Copyright (c) 2021-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+# SPDX-License-Identifier: Apache-2.0
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+"""
+Benchmarks of the per-element overhead of pymrc nodes, run with pytest-benchmark. They are kept out of the regular
+test run, run them from the python folder with:
+
+    pytest benchmarks
+
+Record a baseline with `--benchmark-save=<name>` and compare a later run against it, failing on regressions, with:
+
+    pytest benchmarks --benchmark-compare=0001_<name> --benchmark-compare-fail=mean:10%
+
+Each round runs a complete pipeline over a fixed number of messages, so the executor startup is included in every
+round. The message count of a benchmark is reported in its `extra_info` to derive the per-message cost.
+"""
+
+import pytest
+
+import mrc
+
+# messages pushed through the pipeline of each round
+MESSAGE_COUNT = 10000
+
+ROUNDS = 5
+
+
+def run_pipeline(segment_init, cpuset: str = "0"):
+    pipeline = mrc.Pipeline()
+
+    pipeline.make_segment("bench_seg", segment_init)
+
+    options = mrc.Options()
+    options.topology.user_cpuset = cpuset
+
+    executor = mrc.Executor(options)
+
+    executor.register_pipeline(pipeline)
+
+    executor.start()
+
+    executor.join()
+
+
+@pytest.fixture
+def bench_pipeline(benchmark):
+    """
+    Benchmarks a pipeline built by `segment_init`, checking after each round that `expected` messages reached its sink
+    """
+
+    def run(segment_init, counter: list, expected: int = MESSAGE_COUNT, cpuset: str = "0"):
+
+        def setup():
+            counter.clear()
+
+        def target():
+            run_pipeline(segment_init, cpuset)
+            assert len(counter) == expected
+
+        benchmark.extra_info["messages"] = expected
+        benchmark.pedantic(target, setup=setup, rounds=ROUNDS, warmup_rounds=1, iterations=1)
+
+    return run
@@ -0,0 +1,98 @@
+# SPDX-FileCopyrightText: Copyright (c) 2021-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+# SPDX-License-Identifier: Apache-2.0
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+from conftest import MESSAGE_COUNT
+
+import mrc
+import mrc.tests.test_edges_cpp as m
+
+
+def derived_source():
+    for _ in range(MESSAGE_COUNT):
+        yield m.DerivedB()
+
+
+def test_python_to_python(bench_pipeline):
+    """
+    Baseline for the conversion benchmarks: the same objects over a python to python edge
+    """
+    received = []
+
+    def segment_init(seg: mrc.Builder):
+        src = seg.make_source("src", derived_source())
+
+        sink = seg.make_sink("sink", received.append, None, None)
+        seg.make_edge(src, sink)
+
+    bench_pipeline(segment_init, received)
+
+
+def test_python_to_cpp(bench_pipeline):
+    """
+    Python objects cast to their c++ holder on the edge to a c++ sink
+    """
+    received = []
+
+    def source_fn():
+        for x in derived_source():
+            received.append(None)
+            yield x
+
+    def segment_init(seg: mrc.Builder):
+        src = seg.make_source("src", source_fn())
+
+        sink = m.SinkBase(seg, "sink")
+        seg.make_edge(src, sink)
+
+    bench_pipeline(segment_init, received)
+
+
+def test_python_to_cpp_to_python(bench_pipeline):
+    """
+    Python objects cast to c++ on the way into a c++ node and back to python on the way out
+    """
+    received = []
+
+    def segment_init(seg: mrc.Builder):
+        src = seg.make_source("src", derived_source())
+
+        node = m.NodeBase(seg, "node")
+        seg.make_edge(src, node)
+
+        sink = seg.make_sink("sink", received.append, None, None)
+        seg.make_edge(node, sink)
+
+    bench_pipeline(segment_init, received)
+
+
+def test_python_to_column(bench_pipeline):
+    """
+    Python floats cast to doubles on the edge to a column node, which hands them back to python as one array per batch
+    """
+    received = []
+
+    def count(column):
+        return column.shape[0]
+
+    def segment_init(seg: mrc.Builder):
+        src = seg.make_source("src", [float(i) for i in range(MESSAGE_COUNT)])
+
+        node = seg.make_column_node("node", count, dtype="float64", max_batch_size=1024, max_hold_ms=0.0)
+        seg.make_edge(src, node)
+
+        sink = seg.make_sink("sink", lambda n: received.extend([None] * n), None, None)
+        seg.make_edge(node, sink)
+
+    bench_pipeline(segment_init, received)
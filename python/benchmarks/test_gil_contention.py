@@ -0,0 +1,74 @@
+# SPDX-FileCopyrightText: Copyright (c) 2021-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+# SPDX-License-Identifier: Apache-2.0
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+import pytest
+from conftest import MESSAGE_COUNT
+
+import mrc
+import mrc.tests.test_edges_cpp as m
+
+
+def busy(x):
+    # pure python work, which holds the GIL throughout
+    total = 0
+    for i in range(200):
+        total += i * i
+    return x
+
+
+@pytest.mark.parametrize("pe_count", [1, 2, 4])
+def test_python_node_pe_count(bench_pipeline, pe_count: int):
+    """
+    A GIL-bound python node spread over `pe_count` pes; with the GIL serializing the pes, the time per round should not
+    drop with the pe count and any growth is the cost of the contention
+    """
+    received = []
+
+    def segment_init(seg: mrc.Builder):
+        src = seg.make_source("src", list(range(MESSAGE_COUNT)))
+
+        node = seg.make_node("node", busy)
+        node.launch_options.pe_count = pe_count
+        seg.make_edge(src, node)
+
+        sink = seg.make_sink("sink", received.append, None, None)
+        seg.make_edge(node, sink)
+
+    bench_pipeline(segment_init, received, cpuset="0-{}".format(pe_count))
+
+
+@pytest.mark.parametrize("pe_count", [1, 2, 4])
+def test_cpp_node_pe_count(bench_pipeline, pe_count: int):
+    """
+    A c++ node spread over `pe_count` pes between python endpoints, whose pes only take the GIL to convert and release
+    the python objects on their edges
+    """
+    received = []
+
+    def source_fn():
+        for _ in range(MESSAGE_COUNT):
+            yield m.DerivedB()
+
+    def segment_init(seg: mrc.Builder):
+        src = seg.make_source("src", source_fn())
+
+        node = m.NodeBase(seg, "node")
+        node.launch_options.pe_count = pe_count
+        seg.make_edge(src, node)
+
+        sink = seg.make_sink("sink", received.append, None, None)
+        seg.make_edge(node, sink)
+
+    bench_pipeline(segment_init, received, cpuset="0-{}".format(pe_count))
@@ -0,0 +1,85 @@
+# SPDX-FileCopyrightText: Copyright (c) 2021-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+# SPDX-License-Identifier: Apache-2.0
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+import pytest
+from conftest import MESSAGE_COUNT
+
+import mrc
+
+
+def identity(x):
+    return x
+
+
+@pytest.mark.parametrize("depth", [0, 1, 4])
+def test_python_node_chain(bench_pipeline, depth: int):
+    """
+    Python source -> `depth` python nodes -> python sink, the cost of each python to python hop
+    """
+    received = []
+
+    def segment_init(seg: mrc.Builder):
+        upstream = seg.make_source("src", list(range(MESSAGE_COUNT)))
+
+        for i in range(depth):
+            node = seg.make_node("node_{}".format(i), identity)
+            seg.make_edge(upstream, node)
+            upstream = node
+
+        sink = seg.make_sink("sink", received.append, None, None)
+        seg.make_edge(upstream, sink)
+
+    bench_pipeline(segment_init, received)
+
+
+@pytest.mark.parametrize("max_batch_size", [1, 64, 1024])
+def test_batched_node(bench_pipeline, max_batch_size: int):
+    """
+    Same hop as test_python_node_chain[1] through a node acquiring the GIL once per batch
+    """
+    received = []
+
+    def segment_init(seg: mrc.Builder):
+        src = seg.make_source("src", list(range(MESSAGE_COUNT)))
+
+        node = seg.make_batched_node("node", identity, max_batch_size=max_batch_size, max_hold_ms=0.0)
+        seg.make_edge(src, node)
+
+        sink = seg.make_sink("sink", received.append, None, None)
+        seg.make_edge(node, sink)
+
+    bench_pipeline(segment_init, received)
+
+
+@pytest.mark.parametrize("max_concurrency", [1, 64])
+def test_async_node(bench_pipeline, max_concurrency: int):
+    """
+    Same hop as test_python_node_chain[1] through a node awaiting a coroutine on its event loop
+    """
+    received = []
+
+    async def async_identity(x):
+        return x
+
+    def segment_init(seg: mrc.Builder):
+        src = seg.make_source("src", list(range(MESSAGE_COUNT)))
+
+        node = seg.make_async_node("node", async_identity, max_concurrency=max_concurrency)
+        seg.make_edge(src, node)
+
+        sink = seg.make_sink("sink", received.append, None, None)
+        seg.make_edge(node, sink)
+
+    bench_pipeline(segment_init, received)
@@ -0,0 +1,58 @@
+# SPDX-FileCopyrightText: Copyright (c) 2021-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+# SPDX-License-Identifier: Apache-2.0
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+import subprocess
+import sys
+
+import pytest
+
+import mrc
+
+
+def identity(x):
+    return x
+
+
+def test_import(benchmark):
+    """
+    Cost of `import mrc` in a fresh interpreter
+    """
+
+    def target():
+        subprocess.run([sys.executable, "-c", "import mrc"], check=True)
+
+    benchmark.pedantic(target, rounds=5, warmup_rounds=1, iterations=1)
+
+
+@pytest.mark.parametrize("node_count", [10, 100, 500])
+def test_pipeline_startup(bench_pipeline, node_count: int):
+    """
+    Building, starting and joining a chain of `node_count` python nodes which no data flows through, the time before
+    the first message of a pipeline could flow
+    """
+    received = []
+
+    def segment_init(seg: mrc.Builder):
+        upstream = seg.make_source("src", [])
+
+        for i in range(node_count):
+            node = seg.make_node("node_{}".format(i), identity)
+            seg.make_edge(upstream, node)
+            upstream = node
+
+        sink = seg.make_sink("sink", received.append, None, None)
+        seg.make_edge(upstream, sink)
+
+    bench_pipeline(segment_init, received, expected=0)
@@ -13,8 +13,8 @@
 # See the License for the specific language governing permissions and
 # limitations under the License.
 
-from .core import logging
-from .core import operators
+import importlib
+
 from .core.common import __version__
 from .core.executor import Executor
 from .core.executor import Future
@@ -22,11 +22,37 @@ from .core.node import SegmentObject
 from .core.options import Config
 from .core.options import Options
 from .core.pipeline import Pipeline
-from .core.plugins import PluginModule
 from .core.segment import Builder
 from .core.segment import ModuleRegistry
 from .core.segment import SegmentModule
+from .core.subscriber import BufferedObserver
 from .core.subscriber import Observable
 from .core.subscriber import Observer
 from .core.subscriber import Subscriber
 from .core.subscriber import Subscription
+
+# Attributes which are not needed to build and run a pipeline are imported on their first access (PEP 562), which
+# keeps their extension modules from being loaded by `import mrc`
+_LAZY_ATTRIBUTES = {
+    "logging": (".core.logging", None),
+    "operators": (".core.operators", None),
+    "PluginModule": (".core.plugins", "PluginModule"),
+}
+
+
+def __getattr__(name: str):
+    if (name not in _LAZY_ATTRIBUTES):
+        raise AttributeError("module '{}' has no attribute '{}'".format(__name__, name))
+
+    module_name, attr_name = _LAZY_ATTRIBUTES[name]
+    module = importlib.import_module(module_name, __name__)
+    value = module if attr_name is None else getattr(module, attr_name)
+
+    # Cache the attribute so __getattr__ is only hit once
+    globals()[name] = value
+
+    return value
+
+
+def __dir__():
+    return sorted(set(globals()) | set(_LAZY_ATTRIBUTES))
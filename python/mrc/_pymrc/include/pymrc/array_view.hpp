@@ -0,0 +1,145 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2021-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "mrc/codable/codable_protocol.hpp"
+#include "mrc/memory/buffer_view.hpp"
+#include "mrc/memory/memory_kind.hpp"
+
+#include <pybind11/pytypes.h>
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace mrc::pymrc {
+
+// Export everything in the mrc::pymrc namespace by default since we compile with -fvisibility=hidden
+#pragma GCC visibility push(default)
+
+/**
+ * @brief Zero-copy view of an n-dimensional array, used to pass arrays and tensors across python <-> c++ edges
+ *
+ * A view is built from a python object exposing `__cuda_array_interface__` (cupy, numba, torch on device) or the
+ * buffer protocol (numpy, bytes, memoryview) and keeps that object alive for as long as any copy of the view exists.
+ * Back in python the view exposes the matching `__array_interface__` or `__cuda_array_interface__`, so
+ * `numpy.asarray(view)` or `cupy.asarray(view)` wrap the same memory. The memory kind of the elements is preserved,
+ * including when the view is encoded: the elements are described in place for a remote get where the encoding
+ * options allow it, and decoded into memory of the same kind.
+ *
+ * Strides are in bytes and typestr follows the numpy array interface, e.g. "<f4".
+ */
+class ArrayView
+{
+  public:
+    ArrayView() = default;
+    ArrayView(memory::buffer_view view,
+              std::vector<std::int64_t> shape,
+              std::vector<std::int64_t> strides,
+              std::string typestr,
+              std::shared_ptr<const void> owner,
+              bool readonly = false);
+
+    /**
+     * @brief Views the elements of obj without copying them; requires the GIL
+     *
+     * @throws pybind11::type_error if obj exposes neither the cuda array interface nor the buffer protocol
+     */
+    static ArrayView from_object(const pybind11::object& obj);
+
+    const memory::buffer_view& view() const;
+
+    memory::memory_kind kind() const;
+
+    const std::vector<std::int64_t>& shape() const;
+
+    const std::vector<std::int64_t>& strides() const;
+
+    const std::string& typestr() const;
+
+    std::size_t itemsize() const;
+
+    std::size_t size() const;
+
+    bool is_c_contiguous() const;
+
+    bool readonly() const;
+
+    /**
+     * @brief Array interface (version 3) describing the view; requires the GIL
+     */
+    pybind11::dict array_interface() const;
+
+  private:
+    memory::buffer_view m_view;
+    std::vector<std::int64_t> m_shape;
+    std::vector<std::int64_t> m_strides;
+    std::string m_typestr;
+    bool m_readonly{false};
+
+    // keeps the memory of the view alive; a python object or the buffer of a decoded view
+    std::shared_ptr<const void> m_owner;
+};
+
+/**
+ * @brief Array interface typestr of an arithmetic type, e.g. "<f8" for double
+ */
+template <typename T>
+std::string typestr_for()
+{
+    static_assert(std::is_arithmetic_v<T>);
+
+    char kind = 'f';
+    if constexpr (std::is_same_v<T, bool>)
+    {
+        kind = 'b';
+    }
+    else if constexpr (std::is_integral_v<T>)
+    {
+        kind = (std::is_signed_v<T> ? 'i' : 'u');
+    }
+
+    const char order = (sizeof(T) == 1 ? '|' : (std::endian::native == std::endian::little ? '<' : '>'));
+    return std::string(1, order) + kind + std::to_string(sizeof(T));
+}
+
+#pragma GCC visibility pop
+
+}  // namespace mrc::pymrc
+
+namespace mrc::codable {
+
+template <typename T>
+class Encoder;
+template <typename T>
+class Decoder;
+class EncodingOptions;
+
+template <>
+struct codable_protocol<pymrc::ArrayView>
+{
+    static void serialize(const pymrc::ArrayView& obj, Encoder<pymrc::ArrayView>& encoded, const EncodingOptions& opts);
+
+    static pymrc::ArrayView deserialize(const Decoder<pymrc::ArrayView>& encoded, std::size_t object_idx);
+};
+
+}  // namespace mrc::codable
@@ -0,0 +1,54 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "mrc/arrow/arrow_batch.hpp"
+
+#include <pybind11/pytypes.h>
+
+namespace mrc::pymrc {
+
+// Export everything in the mrc::pymrc namespace by default since we compile with -fvisibility=hidden
+#pragma GCC visibility push(default)
+
+/**
+ * @brief Imports a record batch from python without copying its columns; requires the GIL
+ *
+ * Accepted are objects implementing the Arrow PyCapsule interface (`__arrow_c_array__`, e.g. pyarrow >= 14 and
+ * polars), objects with `_export_to_c` (older pyarrow record batches) and pandas DataFrames, which are converted with
+ * `pyarrow.RecordBatch.from_pandas`; the pandas metadata travels with the batch, so the frame is restored with its
+ * index and dtypes by `to_pyarrow(batch).to_pandas()`.
+ *
+ * @throws pybind11::type_error if obj is none of them
+ */
+arrow::ArrowBatch arrow_batch_from_object(const pybind11::object& obj);
+
+/**
+ * @brief pyarrow.RecordBatch referencing the columns of batch, which stay alive for as long as it does; requires the
+ * GIL and pyarrow
+ */
+pybind11::object arrow_batch_to_pyarrow(const arrow::ArrowBatch& batch);
+
+/**
+ * @brief Exports batch as the (schema, array) capsules of the Arrow PyCapsule interface; requires the GIL
+ */
+pybind11::tuple arrow_batch_to_capsules(const arrow::ArrowBatch& batch);
+
+#pragma GCC visibility pop
+
+}  // namespace mrc::pymrc
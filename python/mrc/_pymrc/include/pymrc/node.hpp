@@ -17,6 +17,7 @@
 
 #pragma once
 
+#include "pymrc/array_view.hpp"
 #include "pymrc/edge_adapter.hpp"
 #include "pymrc/port_builders.hpp"
 #include "pymrc/types.hpp"
@@ -24,22 +25,35 @@
 
 #include "mrc/channel/ingress.hpp"
 #include "mrc/channel/status.hpp"
+#include "mrc/memory/buffer_view.hpp"
+#include "mrc/memory/memory_kind.hpp"
+#include "mrc/node/batcher.hpp"
 #include "mrc/node/edge.hpp"
 #include "mrc/node/edge_connector.hpp"
 #include "mrc/node/forward.hpp"  // IWYU pragma: keep
+#include "mrc/node/generic_batch_node.hpp"
 #include "mrc/node/rx_node.hpp"
 #include "mrc/node/rx_sink.hpp"
 #include "mrc/node/rx_source.hpp"
+#include "mrc/node/sink_channel.hpp"
+#include "mrc/node/source_channel.hpp"
 #include "mrc/runnable/context.hpp"
+#include "mrc/runnable/runnable.hpp"
 
 #include <pybind11/cast.h>
 #include <pybind11/gil.h>
 #include <pybind11/pytypes.h>
 #include <rxcpp/rx.hpp>
 
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
 #include <functional>
 #include <memory>
+#include <span>
+#include <type_traits>
 #include <utility>
+#include <vector>
 
 // Avoid forward declaring template specialization base classes
 // IWYU pragma: no_forward_declare mrc::node::Edge
@@ -214,11 +228,11 @@ class PythonNode : public node::RxNode<InputT, OutputT, ContextT>,
     {
         if constexpr (pybind11::detail::is_pyobject<OutputT>::value)
         {
-            pybind11::gil_scoped_acquire gil;
-            OutputT tmp = std::move(data);
+            pymrc::release_deferred(std::move(data));
         }
         else
         {
+            // dropped holders queue their reference if the GIL is not held
             OutputT tmp = std::move(data);
         }
 
@@ -244,6 +258,149 @@ class PythonSource : public node::RxSource<OutputT, ContextT>,
     {}
 };
 
+template <typename ContextT = mrc::runnable::Context>
+class PythonBatcher : public node::Batcher<PyHolder, PyHolder, ContextT>,
+                      public pymrc::AutoRegSourceAdapter<PyHolder>,
+                      public pymrc::AutoRegSinkAdapter<PyHolder>,
+                      public pymrc::AutoRegIngressPort<PyHolder>,
+                      public pymrc::AutoRegEgressPort<PyHolder>
+{
+    using base_t = node::Batcher<PyHolder, PyHolder, ContextT>;
+
+  public:
+    using node::Batcher<PyHolder, PyHolder, ContextT>::Batcher;
+
+  private:
+    channel::Status no_channel(PyHolder&& data) final
+    {
+        // the dropped holder queues its reference if the GIL is not held
+        PyHolder tmp = std::move(data);
+        return channel::Status::success;
+    }
+};
+
+/**
+ * @brief Python node handing each batch drained from its input channel to batch_fn, which is expected to take the
+ * GIL once for the whole batch instead of once per element.
+ */
+template <typename ContextT = mrc::runnable::Context>
+class PythonBatchNode : public node::GenericBatchNode<PyHolder, PyHolder, ContextT>,
+                        public pymrc::AutoRegSourceAdapter<PyHolder>,
+                        public pymrc::AutoRegSinkAdapter<PyHolder>,
+                        public pymrc::AutoRegIngressPort<PyHolder>,
+                        public pymrc::AutoRegEgressPort<PyHolder>
+{
+    using base_t = node::GenericBatchNode<PyHolder, PyHolder, ContextT>;
+
+  public:
+    using batch_fn_t = std::function<void(std::span<PyHolder>, std::vector<PyHolder>&)>;
+
+    PythonBatchNode(batch_fn_t batch_fn, std::size_t max_batch_size, std::chrono::microseconds max_latency) :
+      base_t(max_batch_size, max_latency),
+      m_batch_fn(std::move(batch_fn))
+    {}
+
+  private:
+    void on_data_batch(std::span<PyHolder> batch, std::vector<PyHolder>& outputs) final
+    {
+        m_batch_fn(batch, outputs);
+    }
+
+    channel::Status no_channel(PyHolder&& data) final
+    {
+        // the dropped holder queues its reference if the GIL is not held
+        PyHolder tmp = std::move(data);
+        return channel::Status::success;
+    }
+
+    batch_fn_t m_batch_fn;
+};
+
+/**
+ * @brief Python node receiving scalar elements of type T from c++ nodes and handing them to python as columns
+ *
+ * Each batch drained from the input channel is packed into a contiguous column without the GIL; column_fn then takes
+ * the GIL once for the whole batch and is handed the column as an ArrayView sharing its memory, so numpy can compute
+ * on it in place. The GenericBatchNode options bound the size and the hold time of a batch.
+ */
+template <typename T, typename ContextT = mrc::runnable::Context>
+class PythonColumnNode : public node::GenericBatchNode<T, PyHolder, ContextT>,
+                         public pymrc::AutoRegSourceAdapter<PyHolder>,
+                         public pymrc::AutoRegSinkAdapter<T>,
+                         public pymrc::AutoRegIngressPort<PyHolder>,
+                         public pymrc::AutoRegEgressPort<T>
+{
+    static_assert(std::is_arithmetic_v<T>, "columns hold arithmetic elements");
+
+    using base_t = node::GenericBatchNode<T, PyHolder, ContextT>;
+
+  public:
+    using column_fn_t = std::function<void(ArrayView, std::vector<PyHolder>&)>;
+
+    PythonColumnNode(column_fn_t column_fn, std::size_t max_batch_size, std::chrono::microseconds max_latency) :
+      base_t(max_batch_size, max_latency),
+      m_column_fn(std::move(column_fn))
+    {}
+
+  private:
+    void on_data_batch(std::span<T> batch, std::vector<PyHolder>& outputs) final
+    {
+        // the column owns a copy of the batch, which is reused by the next read
+        auto column = std::make_shared<std::vector<T>>(batch.begin(), batch.end());
+
+        memory::buffer_view view(column->data(), column->size() * sizeof(T), memory::memory_kind::host);
+        m_column_fn(ArrayView(std::move(view),
+                              {static_cast<std::int64_t>(column->size())},
+                              {static_cast<std::int64_t>(sizeof(T))},
+                              typestr_for<T>(),
+                              std::move(column)),
+                    outputs);
+    }
+
+    channel::Status no_channel(PyHolder&& data) final
+    {
+        // the dropped holder queues its reference if the GIL is not held
+        PyHolder tmp = std::move(data);
+        return channel::Status::success;
+    }
+
+    column_fn_t m_column_fn;
+};
+
+/**
+ * @brief Python node awaiting an async callable on each of its inputs with an asyncio event loop owned by each pe
+ *
+ * Up to max_concurrency calls are in flight per pe and their results are emitted in completion order. While calls are
+ * pending, the event loop runs for at most poll_interval between polls of the input channel. The loop blocks the
+ * thread of the pe, not just its fiber, so async nodes should run on a thread engine or on pes of their own.
+ */
+class PythonAsyncNode : public node::SinkChannel<PyHolder>,
+                        public node::SourceChannel<PyHolder>,
+                        public runnable::RunnableWithContext<runnable::Context>,
+                        public pymrc::AutoRegSourceAdapter<PyHolder>,
+                        public pymrc::AutoRegSinkAdapter<PyHolder>,
+                        public pymrc::AutoRegIngressPort<PyHolder>,
+                        public pymrc::AutoRegEgressPort<PyHolder>
+{
+  public:
+    PythonAsyncNode(PyHolder async_fn,
+                    std::size_t max_concurrency,
+                    std::chrono::microseconds poll_interval = std::chrono::milliseconds(1));
+
+    ~PythonAsyncNode() override;
+
+  private:
+    void run(runnable::Context& ctx) final;
+
+    void on_state_update(const runnable::Runnable::State& state) final;
+
+    channel::Status no_channel(PyHolder&& data) final;
+
+    PyHolder m_async_fn;
+    const std::size_t m_max_concurrency;
+    const std::chrono::microseconds m_poll_interval;
+};
+
 class SegmentObjectProxy
 {
     // add name
@@ -19,6 +19,7 @@
 
 #include "pymrc/types.hpp"
 
+#include <cstddef>
 #include <functional>
 #include <string>
 
@@ -60,6 +61,17 @@ class OperatorsProxy
     static PythonOperator on_completed(std::function<pybind11::object()> finally_fn);
     static PythonOperator pairwise();
     static PythonOperator to_list();
+
+    // Operators implemented in C++; they only acquire the GIL to build or inspect python objects and never call back
+    // into python, except for a callable key of key_by
+    static PythonOperator batch(std::size_t count);
+    static PythonOperator distinct();
+    static PythonOperator key_by(pybind11::object key);
+    static PythonOperator rate_limit(double per_second);
+    static PythonOperator skip(std::size_t count);
+    static PythonOperator take(std::size_t count);
+    static PythonOperator throttle(double interval_ms);
+    static PythonOperator window(std::size_t count, std::size_t step);
 };
 
 #pragma GCC visibility pop
@@ -74,6 +74,22 @@ class OptionsProxy
 
     static void set_user_cpuset(mrc::TopologyOptions& self, const std::string& user_cpuset);
 
+    static std::string get_cache_path(mrc::TopologyOptions& self);
+
+    static void set_cache_path(mrc::TopologyOptions& self, const std::string& cache_path);
+
+    static bool get_use_cpu_quota(mrc::TopologyOptions& self);
+
+    static void set_use_cpu_quota(mrc::TopologyOptions& self, bool use_cpu_quota);
+
+    static bool get_exclude_isolated_cpus(mrc::TopologyOptions& self);
+
+    static void set_exclude_isolated_cpus(mrc::TopologyOptions& self, bool exclude_isolated_cpus);
+
+    static std::size_t get_max_cpu_count(mrc::TopologyOptions& self);
+
+    static void set_max_cpu_count(mrc::TopologyOptions& self, std::size_t max_cpu_count);
+
     static mrc::PlacementStrategy get_cpu_strategy(mrc::PlacementOptions& self);
 
     static void set_cpu_strategy(mrc::PlacementOptions& self, mrc::PlacementStrategy strategy);
@@ -25,6 +25,7 @@
 #include <pybind11/pytypes.h>
 #include <pybind11/stl.h>  // IWYU pragma: keep
 
+#include <cstddef>
 #include <functional>
 #include <memory>
 #include <string>
@@ -164,19 +165,85 @@ class BuilderProxy
      *
      * This will create and return a new lambda function with the following signature:
      * (py) @param name : Unique name of the node that will be created in the MRC Segment.
-     * (py) @param map_f : a std::function that takes a pybind11::object and returns a pybind11::object. This is your
-     * python-function which will be called on each data element as it flows through the node.
+     * (py) @param map_f : a python callable that takes a pybind11::object and returns a pybind11::object. This is your
+     * python-function which will be called on each data element as it flows through the node. It is held as is rather
+     * than wrapped in a std::function, which would re-acquire the GIL already held by the node on each call.
      */
-    static std::shared_ptr<mrc::segment::ObjectProperties> make_node(
-        mrc::segment::Builder& self,
-        const std::string& name,
-        std::function<pybind11::object(pybind11::object x)> map_f);
+    static std::shared_ptr<mrc::segment::ObjectProperties> make_node(mrc::segment::Builder& self,
+                                                                     const std::string& name,
+                                                                     pybind11::function map_f);
 
     static std::shared_ptr<mrc::segment::ObjectProperties> make_node_full(
         mrc::segment::Builder& self,
         const std::string& name,
         std::function<void(const pymrc::PyObjectObservable& obs, pymrc::PyObjectSubscriber& sub)> sub_fn);
 
+    /**
+     * Construct a new python::object -> python::object node collecting its inputs into lists
+     *
+     * (py) @param name : Unique name of the node that will be created in the MRC Segment.
+     * (py) @param max_count : a list is emitted once it holds max_count elements.
+     * (py) @param max_latency_ms : a list is emitted at most max_latency_ms after its first element was received.
+     * (py) @param max_bytes : a list is emitted once the estimated size of its elements reaches max_bytes; 0 disables
+     * the byte trigger.
+     * (py) @param size_fn : estimates the byte size of an element; `sys.getsizeof` if None.
+     */
+    static std::shared_ptr<mrc::segment::ObjectProperties> make_batcher(
+        mrc::segment::Builder& self,
+        const std::string& name,
+        std::size_t max_count,
+        double max_latency_ms,
+        std::size_t max_bytes,
+        std::function<std::size_t(pybind11::object x)> size_fn);
+
+    static std::shared_ptr<mrc::segment::ObjectProperties> make_batched_node(mrc::segment::Builder& self,
+                                                                             const std::string& name,
+                                                                             pybind11::function fn,
+                                                                             std::size_t max_batch_size,
+                                                                             double max_hold_ms,
+                                                                             bool batch_aware);
+
+    /**
+     * Construct a new node collecting scalar elements from c++ nodes into columns handed to a python function
+     *
+     * (py) @param name : Unique name of the node that will be created in the MRC Segment.
+     * (py) @param fn : called with an ArrayView of each column, which numpy.asarray wraps without a copy; results
+     * other than None are emitted.
+     * (py) @param dtype : element type of the input, one of float32, float64, int32, int64, uint32 or uint64.
+     * (py) @param max_batch_size : most elements in a column.
+     * (py) @param max_hold_ms : a column fills for at most max_hold_ms after its first element was read.
+     */
+    static std::shared_ptr<mrc::segment::ObjectProperties> make_column_node(mrc::segment::Builder& self,
+                                                                            const std::string& name,
+                                                                            pybind11::function fn,
+                                                                            const std::string& dtype,
+                                                                            std::size_t max_batch_size,
+                                                                            double max_hold_ms);
+
+    /**
+     * Construct a new pybind11::object source from an async generator function or an async iterable
+     *
+     * (py) @param name: Unique name of the node that will be created in the MRC Segment.
+     * (py) @param source: an `async def` generator function, called once per engine, or an async iterable.
+     *
+     * Each engine drives its async iterator with an asyncio event loop of its own.
+     */
+    static std::shared_ptr<mrc::segment::ObjectProperties> make_async_source(mrc::segment::Builder& self,
+                                                                             const std::string& name,
+                                                                             pybind11::object source);
+
+    /**
+     * Construct a new python::object -> python::object node awaiting an async function on each input
+     *
+     * (py) @param name : Unique name of the node that will be created in the MRC Segment.
+     * (py) @param async_fn : `async def` function called with each input; its awaited result is emitted.
+     * (py) @param max_concurrency : calls in flight at once on each pe; results are emitted in completion order.
+     */
+    static std::shared_ptr<mrc::segment::ObjectProperties> make_async_node(mrc::segment::Builder& self,
+                                                                           const std::string& name,
+                                                                           pybind11::function async_fn,
+                                                                           std::size_t max_concurrency);
+
     static void make_edge(mrc::segment::Builder& self,
                           std::shared_ptr<mrc::segment::ObjectProperties> source,
                           std::shared_ptr<mrc::segment::ObjectProperties> sink);
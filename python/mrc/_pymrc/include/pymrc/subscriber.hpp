@@ -21,7 +21,9 @@
 
 #include <pybind11/pytypes.h>  // for pybind11::object
 
+#include <cstddef>
 #include <functional>
+#include <memory>
 
 namespace mrc::pymrc {
 
@@ -55,5 +57,43 @@ class ObservableProxy
     static PyObjectObservable pipe(PyObjectObservable* self, pybind11::args args);
 };
 
+/**
+ * @brief Pull-based consumer of an observable, letting python read the elements in batches
+ *
+ * The observer returned by observer() buffers the elements it receives, without the GIL, in a bounded channel; a full
+ * channel blocks the producer. Python drains the channel with await_many, which releases the GIL once while it waits
+ * and builds the list of elements with a single acquisition, instead of a GIL round trip per element.
+ */
+class BufferedObserver
+{
+  public:
+    BufferedObserver(std::size_t capacity, std::size_t batch_size);
+
+    /**
+     * @brief Observer feeding the buffer; completes the buffer once the observable completes or fails
+     */
+    PyObjectObserver observer();
+
+    /**
+     * @brief Waits up to timeout seconds, or forever if timeout is negative, for the first element, then returns up to
+     * max_count elements without waiting further; requires the GIL. The list is empty if the wait timed out, or once
+     * the observable completed and every element was read. Rethrows the error of a failed observable.
+     */
+    pybind11::list await_many(std::size_t max_count, double timeout);
+
+    /**
+     * @brief True once await_many returned after the observable completed and every element was read
+     */
+    bool is_done() const;
+
+    std::size_t batch_size() const;
+
+  private:
+    struct State;
+
+    std::shared_ptr<State> m_state;
+    const std::size_t m_batch_size;
+};
+
 #pragma GCC visibility pop
 }  // namespace mrc::pymrc
@@ -21,6 +21,7 @@
 #include <pybind11/pybind11.h>
 #include <pybind11/pytypes.h>
 
+#include <cstddef>
 #include <memory>
 #include <string>
 #include <typeinfo>
@@ -58,6 +59,32 @@ void from_import_as(pybind11::module_& dest, const std::string& from, const std:
  */
 const std::type_info* cpptype_info_from_object(pybind11::object& obj);
 
+/**
+ * @brief Whether the running interpreter serializes python code on the GIL. False only on a free-threaded CPython
+ * build (PEP 703) with the GIL disabled, in which case python nodes with more than one pe run their callables in
+ * parallel and objects handed to several downstream nodes by a broadcast edge may be accessed concurrently. Requires
+ * the GIL to be held, or the thread to be attached on free-threaded builds.
+ */
+bool is_gil_enabled();
+
+/**
+ * @brief Drops the reference held by obj. Without the GIL, the reference is queued and dropped by the next thread
+ * draining the queue instead of taking the GIL only to destroy the object; the releasing thread drains the queue
+ * itself once it holds a batch of references. Destructors of queued objects therefore run later, on another thread.
+ */
+void release_deferred(pybind11::object&& obj);
+
+/**
+ * @brief Drops the references queued by release_deferred; requires the GIL. Called by AcquireGIL and on the hot paths
+ * which already hold the GIL.
+ */
+void drain_deferred_releases();
+
+/**
+ * @brief Number of references waiting to be dropped -- approximate
+ */
+std::size_t deferred_release_count();
+
 /**
  * @brief Wraps a `pybind11::gil_scoped_acquire` with additional functionality to release the GIL before this object
  * leaves the scope. Useful to avoid unnecessary nested `gil_scoped_acquire` then `gil_scoped_release` which need to
@@ -0,0 +1,374 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2021-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "pymrc/array_view.hpp"
+
+#include "mrc/codable/decode.hpp"
+#include "mrc/codable/encode.hpp"
+#include "mrc/codable/encoding_options.hpp"
+#include "mrc/memory/buffer.hpp"
+
+#include <glog/logging.h>
+#include <pybind11/buffer_info.h>
+#include <pybind11/cast.h>
+#include <pybind11/gil.h>
+#include <pybind11/pybind11.h>
+
+#include <cstring>
+#include <stdexcept>
+#include <string_view>
+#include <typeindex>
+#include <utility>
+
+namespace mrc::pymrc {
+
+namespace py = pybind11;
+
+namespace {
+
+// numpy typestr for a buffer protocol format character, e.g. "<f4" for "f"
+std::string typestr_from_format(const std::string& format, std::size_t itemsize)
+{
+    std::size_t pos = 0;
+    while (pos < format.size() && std::string_view("@=<>!").find(format[pos]) != std::string_view::npos)
+    {
+        pos++;
+    }
+    const std::string code = format.substr(pos);
+
+    char kind = 'V';
+    if (code == "?")
+    {
+        kind = 'b';
+    }
+    else if (code.size() == 1 && std::string_view("bhilqn").find(code[0]) != std::string_view::npos)
+    {
+        kind = 'i';
+    }
+    else if (code.size() == 1 && std::string_view("BHILQN").find(code[0]) != std::string_view::npos)
+    {
+        kind = 'u';
+    }
+    else if (code.size() == 1 && std::string_view("efdg").find(code[0]) != std::string_view::npos)
+    {
+        kind = 'f';
+    }
+    else if (code.size() == 2 && code[0] == 'Z')
+    {
+        kind = 'c';
+    }
+
+    char order = '|';
+    if (itemsize > 1 && kind != 'V')
+    {
+        const bool big_endian = (pos > 0 && (format[pos - 1] == '>' || format[pos - 1] == '!'));
+        order                 = (big_endian ? '>' : '<');
+    }
+    return std::string(1, order) + kind + std::to_string(itemsize);
+}
+
+std::vector<std::int64_t> c_contiguous_strides(const std::vector<std::int64_t>& shape, std::size_t itemsize)
+{
+    std::vector<std::int64_t> strides(shape.size());
+    auto stride = static_cast<std::int64_t>(itemsize);
+    for (std::size_t i = shape.size(); i > 0; i--)
+    {
+        strides[i - 1] = stride;
+        stride *= shape[i - 1];
+    }
+    return strides;
+}
+
+// bytes spanned by the elements of a strided array starting at its first element
+std::size_t extent_bytes(const std::vector<std::int64_t>& shape,
+                         const std::vector<std::int64_t>& strides,
+                         std::size_t itemsize)
+{
+    std::int64_t extent = itemsize;
+    for (std::size_t i = 0; i < shape.size(); i++)
+    {
+        if (shape[i] == 0)
+        {
+            return 0;
+        }
+        if (strides[i] < 0)
+        {
+            throw py::value_error("arrays with negative strides can not be viewed");
+        }
+        extent += (shape[i] - 1) * strides[i];
+    }
+    return extent;
+}
+
+std::size_t itemsize_from_typestr(const std::string& typestr)
+{
+    CHECK_GE(typestr.size(), 3) << "invalid typestr: " << typestr;
+    return std::stoul(typestr.substr(2));
+}
+
+// releases a python object held by a view, which may be dropped on a thread without the GIL
+std::shared_ptr<const void> hold_with_gil(py::object obj)
+{
+    return {new py::object(std::move(obj)), [](const py::object* held) {
+                py::gil_scoped_acquire gil;
+                delete held;
+            }};
+}
+
+ArrayView from_cuda_array_interface(const py::object& obj)
+{
+    auto cai = obj.attr("__cuda_array_interface__").cast<py::dict>();
+
+    std::vector<std::int64_t> shape;
+    for (auto dim : cai["shape"].cast<py::tuple>())
+    {
+        shape.push_back(dim.cast<std::int64_t>());
+    }
+    auto typestr  = cai["typestr"].cast<std::string>();
+    auto itemsize = itemsize_from_typestr(typestr);
+
+    std::vector<std::int64_t> strides;
+    if (cai.contains("strides") && !cai["strides"].is_none())
+    {
+        for (auto stride : cai["strides"].cast<py::tuple>())
+        {
+            strides.push_back(stride.cast<std::int64_t>());
+        }
+    }
+    else
+    {
+        strides = c_contiguous_strides(shape, itemsize);
+    }
+
+    auto data     = cai["data"].cast<py::tuple>();
+    auto* ptr     = reinterpret_cast<void*>(data[0].cast<std::uintptr_t>());
+    auto readonly = data[1].cast<bool>();
+
+    memory::buffer_view view(ptr, extent_bytes(shape, strides, itemsize), memory::memory_kind::device);
+    return {std::move(view), std::move(shape), std::move(strides), std::move(typestr), hold_with_gil(obj), readonly};
+}
+
+ArrayView from_buffer_protocol(const py::object& obj)
+{
+    // the buffer is released with the view, keeping the exporting object alive and its memory in place
+    auto* info = new py::buffer_info(py::reinterpret_borrow<py::buffer>(obj).request());
+    std::shared_ptr<const void> owner(info, [](const py::buffer_info* held) {
+        py::gil_scoped_acquire gil;
+        delete held;
+    });
+
+    const auto itemsize = static_cast<std::size_t>(info->itemsize);
+    std::vector<std::int64_t> shape(info->shape.begin(), info->shape.end());
+    std::vector<std::int64_t> strides(info->strides.begin(), info->strides.end());
+
+    memory::buffer_view view(info->ptr, extent_bytes(shape, strides, itemsize), memory::memory_kind::host);
+    return {std::move(view),
+            std::move(shape),
+            std::move(strides),
+            typestr_from_format(info->format, itemsize),
+            std::move(owner),
+            info->readonly};
+}
+
+}  // namespace
+
+ArrayView::ArrayView(memory::buffer_view view,
+                     std::vector<std::int64_t> shape,
+                     std::vector<std::int64_t> strides,
+                     std::string typestr,
+                     std::shared_ptr<const void> owner,
+                     bool readonly) :
+  m_view(std::move(view)),
+  m_shape(std::move(shape)),
+  m_strides(std::move(strides)),
+  m_typestr(std::move(typestr)),
+  m_readonly(readonly),
+  m_owner(std::move(owner))
+{
+    CHECK_EQ(m_shape.size(), m_strides.size());
+}
+
+ArrayView ArrayView::from_object(const py::object& obj)
+{
+    if (py::hasattr(obj, "__cuda_array_interface__"))
+    {
+        return from_cuda_array_interface(obj);
+    }
+    if (PyObject_CheckBuffer(obj.ptr()) != 0)
+    {
+        return from_buffer_protocol(obj);
+    }
+    throw py::type_error("object exposes neither __cuda_array_interface__ nor the buffer protocol");
+}
+
+const memory::buffer_view& ArrayView::view() const
+{
+    return m_view;
+}
+
+memory::memory_kind ArrayView::kind() const
+{
+    return m_view.kind();
+}
+
+const std::vector<std::int64_t>& ArrayView::shape() const
+{
+    return m_shape;
+}
+
+const std::vector<std::int64_t>& ArrayView::strides() const
+{
+    return m_strides;
+}
+
+const std::string& ArrayView::typestr() const
+{
+    return m_typestr;
+}
+
+std::size_t ArrayView::itemsize() const
+{
+    return itemsize_from_typestr(m_typestr);
+}
+
+std::size_t ArrayView::size() const
+{
+    std::size_t size = 1;
+    for (auto dim : m_shape)
+    {
+        size *= dim;
+    }
+    return size;
+}
+
+bool ArrayView::is_c_contiguous() const
+{
+    return m_strides == c_contiguous_strides(m_shape, itemsize());
+}
+
+bool ArrayView::readonly() const
+{
+    return m_readonly;
+}
+
+py::dict ArrayView::array_interface() const
+{
+    py::tuple shape(m_shape.size());
+    py::tuple strides(m_strides.size());
+    for (std::size_t i = 0; i < m_shape.size(); i++)
+    {
+        shape[i]   = m_shape[i];
+        strides[i] = m_strides[i];
+    }
+
+    py::dict interface;
+    interface["shape"]   = shape;
+    interface["strides"] = strides;
+    interface["typestr"] = m_typestr;
+    interface["data"]    = py::make_tuple(reinterpret_cast<std::uintptr_t>(m_view.data()), m_readonly);
+    interface["version"] = 3;
+    return interface;
+}
+
+}  // namespace mrc::pymrc
+
+namespace mrc::codable {
+
+namespace {
+
+// header of an encoded view: kind, typestr, ndim, shape and strides
+std::vector<std::byte> pack_header(const pymrc::ArrayView& obj)
+{
+    const auto kind    = static_cast<std::int32_t>(obj.kind());
+    const auto typelen = static_cast<std::uint32_t>(obj.typestr().size());
+    const auto ndim    = static_cast<std::uint32_t>(obj.shape().size());
+
+    std::vector<std::byte> bytes(sizeof(kind) + sizeof(typelen) + typelen + sizeof(ndim) +
+                                 2 * ndim * sizeof(std::int64_t));
+    auto* pos = bytes.data();
+    auto put  = [&pos](const void* src, std::size_t count) {
+        std::memcpy(pos, src, count);
+        pos += count;
+    };
+    put(&kind, sizeof(kind));
+    put(&typelen, sizeof(typelen));
+    put(obj.typestr().data(), typelen);
+    put(&ndim, sizeof(ndim));
+    put(obj.shape().data(), ndim * sizeof(std::int64_t));
+    put(obj.strides().data(), ndim * sizeof(std::int64_t));
+    return bytes;
+}
+
+}  // namespace
+
+void codable_protocol<pymrc::ArrayView>::serialize(const pymrc::ArrayView& obj,
+                                                   Encoder<pymrc::ArrayView>& encoded,
+                                                   const EncodingOptions& opts)
+{
+    auto header = pack_header(obj);
+    encoded.copy_to_eager_descriptor({header.data(), header.size(), memory::memory_kind::host});
+
+    if (opts.force_copy())
+    {
+        auto idx = encoded.create_memory_buffer(obj.view().bytes());
+        encoded.copy_to_buffer(idx, obj.view());
+        return;
+    }
+
+    // device elements are always described in place, host elements once they are above the eager threshold
+    encoded.add_memory_view(obj.view(), opts);
+}
+
+pymrc::ArrayView codable_protocol<pymrc::ArrayView>::deserialize(const Decoder<pymrc::ArrayView>& encoded,
+                                                                 std::size_t object_idx)
+{
+    DCHECK_EQ(std::type_index(typeid(pymrc::ArrayView)).hash_code(), encoded.type_index_hash_for_object(object_idx));
+    auto idx = encoded.start_idx_for_object(object_idx);
+
+    std::vector<std::byte> header(encoded.buffer_size(idx));
+    encoded.copy_from_buffer(idx, {header.data(), header.size(), memory::memory_kind::host});
+
+    const auto* pos = header.data();
+    auto get        = [&pos](void* dst, std::size_t count) {
+        std::memcpy(dst, pos, count);
+        pos += count;
+    };
+    std::int32_t kind;
+    std::uint32_t typelen;
+    std::uint32_t ndim;
+    get(&kind, sizeof(kind));
+    get(&typelen, sizeof(typelen));
+    std::string typestr(typelen, '\0');
+    get(typestr.data(), typelen);
+    get(&ndim, sizeof(ndim));
+    std::vector<std::int64_t> shape(ndim);
+    std::vector<std::int64_t> strides(ndim);
+    get(shape.data(), ndim * sizeof(std::int64_t));
+    get(strides.data(), ndim * sizeof(std::int64_t));
+
+    // the elements are decoded into memory of the kind they were encoded from
+    auto resource = (static_cast<memory::memory_kind>(kind) == memory::memory_kind::device
+                         ? encoded.device_memory_resource()
+                         : encoded.host_memory_resource());
+    auto buffer   = std::make_shared<memory::buffer>(encoded.buffer_size(idx + 1), std::move(resource));
+    encoded.copy_from_buffer(idx + 1, *buffer);
+
+    memory::buffer_view view(buffer->data(), buffer->bytes(), buffer->kind());
+    return {std::move(view), std::move(shape), std::move(strides), std::move(typestr), std::move(buffer)};
+}
+
+}  // namespace mrc::codable
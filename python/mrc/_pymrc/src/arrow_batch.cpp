@@ -0,0 +1,144 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "pymrc/arrow_batch.hpp"
+
+#include "mrc/arrow/c_data_interface.hpp"
+
+#include <pybind11/pybind11.h>
+
+#include <cstdint>
+#include <memory>
+#include <utility>
+
+namespace mrc::pymrc {
+
+namespace py = pybind11;
+
+namespace {
+
+// the struct of a capsule of the Arrow PyCapsule interface
+template <typename T>
+T* capsule_struct(const py::handle& capsule, const char* name)
+{
+    auto* ptr = static_cast<T*>(PyCapsule_GetPointer(capsule.ptr(), name));
+    if (ptr == nullptr)
+    {
+        throw py::error_already_set();
+    }
+    return ptr;
+}
+
+// capsules own the structs they export; pyarrow moves them out, leaving them released
+void release_schema_capsule(PyObject* capsule)
+{
+    auto* schema = static_cast<ArrowSchema*>(PyCapsule_GetPointer(capsule, "arrow_schema"));
+    if (schema->release != nullptr)
+    {
+        schema->release(schema);
+    }
+    delete schema;
+}
+
+void release_array_capsule(PyObject* capsule)
+{
+    auto* array = static_cast<ArrowArray*>(PyCapsule_GetPointer(capsule, "arrow_array"));
+    if (array->release != nullptr)
+    {
+        array->release(array);
+    }
+    delete array;
+}
+
+arrow::ArrowBatch import_from_capsules(const py::object& obj)
+{
+    auto capsules = obj.attr("__arrow_c_array__")().cast<py::tuple>();
+
+    // the structs are moved out of the capsules, whose destructors skip released structs
+    return arrow::ArrowBatch::import_from_c(capsule_struct<ArrowSchema>(capsules[0], "arrow_schema"),
+                                            capsule_struct<ArrowArray>(capsules[1], "arrow_array"));
+}
+
+arrow::ArrowBatch import_from_export_to_c(const py::object& obj)
+{
+    ArrowSchema schema{};
+    ArrowArray array{};
+    obj.attr("_export_to_c")(reinterpret_cast<std::uintptr_t>(&array), reinterpret_cast<std::uintptr_t>(&schema));
+
+    return arrow::ArrowBatch::import_from_c(&schema, &array);
+}
+
+}  // namespace
+
+arrow::ArrowBatch arrow_batch_from_object(const py::object& obj)
+{
+    if (py::hasattr(obj, "__arrow_c_array__"))
+    {
+        return import_from_capsules(obj);
+    }
+    if (py::hasattr(obj, "_export_to_c"))
+    {
+        return import_from_export_to_c(obj);
+    }
+
+    auto pandas = py::module_::import("sys").attr("modules").attr("get")("pandas");
+    if (!pandas.is_none() && py::isinstance(obj, pandas.attr("DataFrame")))
+    {
+        return import_from_export_to_c(py::module_::import("pyarrow").attr("RecordBatch").attr("from_pandas")(obj));
+    }
+
+    throw py::type_error("object is neither an arrow record batch nor a pandas DataFrame");
+}
+
+py::object arrow_batch_to_pyarrow(const arrow::ArrowBatch& batch)
+{
+    auto record_batch = py::module_::import("pyarrow").attr("RecordBatch");
+
+    ArrowSchema schema;
+    ArrowArray array;
+    batch.export_to_c(&schema, &array);
+    try
+    {
+        return record_batch.attr("_import_from_c")(reinterpret_cast<std::uintptr_t>(&array),
+                                                   reinterpret_cast<std::uintptr_t>(&schema));
+    } catch (...)
+    {
+        // structs not moved from by pyarrow are still ours
+        if (array.release != nullptr)
+        {
+            array.release(&array);
+        }
+        if (schema.release != nullptr)
+        {
+            schema.release(&schema);
+        }
+        throw;
+    }
+}
+
+py::tuple arrow_batch_to_capsules(const arrow::ArrowBatch& batch)
+{
+    auto schema = std::make_unique<ArrowSchema>();
+    auto array  = std::make_unique<ArrowArray>();
+    batch.export_to_c(schema.get(), array.get());
+
+    py::capsule schema_capsule(schema.release(), "arrow_schema", &release_schema_capsule);
+    py::capsule array_capsule(array.release(), "arrow_array", &release_array_capsule);
+    return py::make_tuple(std::move(schema_capsule), std::move(array_capsule));
+}
+
+}  // namespace mrc::pymrc
@@ -17,4 +17,152 @@
 
 #include "pymrc/node.hpp"
 
-namespace mrc::pymrc {}  // namespace mrc::pymrc
+#include "mrc/channel/egress.hpp"
+
+#include <glog/logging.h>
+#include <pybind11/gil.h>
+#include <pybind11/pybind11.h>
+#include <pybind11/pytypes.h>
+
+#include <chrono>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace mrc::pymrc {
+
+namespace py = pybind11;
+using namespace py::literals;
+
+PythonAsyncNode::PythonAsyncNode(PyHolder async_fn,
+                                 std::size_t max_concurrency,
+                                 std::chrono::microseconds poll_interval) :
+  m_async_fn(std::move(async_fn)),
+  m_max_concurrency(max_concurrency),
+  m_poll_interval(poll_interval)
+{
+    CHECK_GT(m_max_concurrency, 0);
+}
+
+PythonAsyncNode::~PythonAsyncNode() = default;
+
+void PythonAsyncNode::run(runnable::Context& ctx)
+{
+    auto& egress = SinkChannel<PyHolder>::egress();
+
+    // holders, so the loop and the pending tasks may be released without the gil
+    PyHolder asyncio;
+    PyHolder loop;
+    PyHolder pending;
+    {
+        py::gil_scoped_acquire gil;
+        asyncio = py::module_::import("asyncio");
+        loop    = asyncio.attr("new_event_loop")();
+        pending = py::set();
+    }
+
+    auto close_loop = [&]() {
+        py::gil_scoped_acquire gil;
+        for (auto task : py::reinterpret_borrow<py::set>(pending))
+        {
+            task.attr("cancel")();
+        }
+        if (py::len(pending) > 0)
+        {
+            loop.attr("run_until_complete")(
+                asyncio.attr("gather")(*py::reinterpret_borrow<py::set>(pending), "return_exceptions"_a = true));
+        }
+        loop.attr("close")();
+    };
+
+    std::vector<PyHolder> outputs;
+    std::size_t in_flight = 0;
+    bool is_closed        = false;
+
+    try
+    {
+        while (!is_closed || in_flight > 0)
+        {
+            // start calls for the available inputs, blocking for one only when no call is pending
+            while (!is_closed && in_flight < m_max_concurrency)
+            {
+                PyHolder data;
+                auto rc = (in_flight == 0 ? egress.await_read(data) : egress.try_read(data));
+                if (rc == channel::Status::success)
+                {
+                    py::gil_scoped_acquire gil;
+                    auto task = asyncio.attr("ensure_future")(m_async_fn(py::object(std::move(data))), "loop"_a = loop);
+                    pending.attr("add")(std::move(task));
+                    ++in_flight;
+                    continue;
+                }
+                is_closed = (rc == channel::Status::closed);
+                break;
+            }
+
+            if (in_flight == 0)
+            {
+                continue;
+            }
+
+            {
+                py::gil_scoped_acquire gil;
+                drain_deferred_releases();
+
+                // with room for more calls the loop runs for a slice only, so new inputs are picked up
+                py::object timeout = py::none();
+                if (!is_closed && in_flight < m_max_concurrency)
+                {
+                    timeout = py::float_(std::chrono::duration<double>(m_poll_interval).count());
+                }
+
+                py::tuple waited = loop.attr("run_until_complete")(asyncio.attr("wait")(
+                    pending, "timeout"_a = timeout, "return_when"_a = asyncio.attr("FIRST_COMPLETED")));
+
+                for (auto task : py::reinterpret_borrow<py::set>(waited[0]))
+                {
+                    pending.attr("discard")(task);
+                    --in_flight;
+                    outputs.emplace_back(task.attr("result")());
+                }
+            }
+
+            for (auto& output : outputs)
+            {
+                SourceChannel<PyHolder>::await_write(std::move(output));
+            }
+            outputs.clear();
+        }
+    } catch (...)
+    {
+        LOG(ERROR) << ctx.info() << " error in async node, cancelling " << in_flight << " pending calls";
+        close_loop();
+        throw;
+    }
+
+    close_loop();
+
+    ctx.barrier();
+    if (ctx.rank() == 0)
+    {
+        DVLOG(10) << ctx.info() << " async node releasing its downstream channel";
+        SourceChannel<PyHolder>::release_channel();
+    }
+}
+
+void PythonAsyncNode::on_state_update(const runnable::Runnable::State& state)
+{
+    if (state == runnable::Runnable::State::Stop || state == runnable::Runnable::State::Kill)
+    {
+        SinkChannel<PyHolder>::disable_persistence();
+    }
+}
+
+channel::Status PythonAsyncNode::no_channel(PyHolder&& data)
+{
+    // the dropped holder queues its reference if the GIL is not held
+    PyHolder tmp = std::move(data);
+    return channel::Status::success;
+}
+
+}  // namespace mrc::pymrc
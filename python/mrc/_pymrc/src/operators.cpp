@@ -20,6 +20,7 @@
 #include "pymrc/types.hpp"
 #include "pymrc/utils.hpp"
 
+#include <boost/fiber/operations.hpp>
 #include <pybind11/cast.h>
 #include <pybind11/functional.h>  // IWYU pragma: keep
 #include <pybind11/gil.h>
@@ -27,8 +28,11 @@
 #include <pybind11/pytypes.h>
 #include <rxcpp/rx.hpp>
 
+#include <chrono>
+#include <cstddef>
 #include <exception>
 #include <functional>
+#include <memory>
 #include <tuple>
 #include <type_traits>
 #include <utility>
@@ -40,6 +44,28 @@ namespace mrc::pymrc {
 
 namespace py = pybind11;
 
+namespace {
+
+PyHolder make_py_list(std::vector<PyHolder>& obj_list)
+{
+    AcquireGIL gil;
+
+    // Convert the list back into a python object
+    py::list values;
+
+    for (auto& x : obj_list)
+    {
+        values.append(py::object(std::move(x)));
+    }
+
+    // Clear the list while we still have the GIL
+    obj_list.clear();
+
+    return PyHolder(std::move(values));
+}
+
+}  // namespace
+
 PythonOperator::PythonOperator(std::string name, PyObjectOperateFn operate_fn) :
   m_name(std::move(name)),
   m_operate_fn(std::move(operate_fn))
@@ -263,22 +289,158 @@ PythonOperator OperatorsProxy::to_list()
 
         // return source.subscribe(sink);
         return source.lift<rxcpp::util::value_type_t<pyobj_to_list_t>>(pyobj_to_list_t())
-            .map([](std::vector<PyHolder> obj_list) -> PyHolder {
-                AcquireGIL gil;
+            .map([](std::vector<PyHolder> obj_list) -> PyHolder { return make_py_list(obj_list); });
+    });
+}
 
-                // Convert the list back into a python object
-                py::list values;
+PythonOperator OperatorsProxy::batch(std::size_t count)
+{
+    if (count == 0)
+    {
+        throw py::value_error("batch count must be positive");
+    }
 
-                for (auto& x : obj_list)
-                {
-                    values.append(py::object(std::move(x)));
-                }
+    // The last batch holds the remaining elements once the source completes
+    return PythonOperator("batch", [count](PyObjectObservable source) {
+        return source.buffer(count).map([](std::vector<PyHolder> obj_list) -> PyHolder {
+            return make_py_list(obj_list);
+        });
+    });
+}
 
-                // Clear the list while we still have the GIL
-                obj_list.clear();
+PythonOperator OperatorsProxy::distinct()
+{
+    return PythonOperator("distinct", [](PyObjectObservable source) {
+        // Hashes of the elements seen so far are kept in a python set, created on the first element
+        auto seen = std::make_shared<PyHolder>();
 
-                return PyHolder(std::move(values));
-            });
+        return source.filter([seen](const PyHolder& data_object) {
+            py::gil_scoped_acquire gil;
+
+            if (!*seen)
+            {
+                *seen = PyHolder(py::set());
+            }
+
+            auto found = PySet_Contains(seen->ptr(), data_object.ptr());
+            if (found == 0)
+            {
+                found = PySet_Add(seen->ptr(), data_object.ptr());
+            }
+            if (found < 0)
+            {
+                throw py::error_already_set();
+            }
+
+            return found == 0;
+        });
+    });
+}
+
+PythonOperator OperatorsProxy::key_by(py::object key)
+{
+    // A callable key is called with each element, any other key indexes the elements
+    const bool is_callable = PyCallable_Check(key.ptr()) == 1;
+    PyHolder key_holder(std::move(key));
+
+    return PythonOperator("key_by", [is_callable, key_holder](PyObjectObservable source) -> PyObjectObservable {
+        return source.map([is_callable, key_holder](PyHolder data_object) -> PyHolder {
+            py::gil_scoped_acquire gil;
+
+            py::object value = std::move(data_object);
+            const py::handle& key_ref = key_holder;
+
+            py::object element_key = (is_callable ? key_ref(value) : py::object(value[key_ref]));
+
+            return py::make_tuple(std::move(element_key), std::move(value));
+        });
+    });
+}
+
+PythonOperator OperatorsProxy::rate_limit(double per_second)
+{
+    if (per_second <= 0)
+    {
+        throw py::value_error("rate_limit requires a positive rate");
+    }
+
+    const auto period =
+        std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double>(1.0 / per_second));
+
+    return PythonOperator("rate_limit", [period](PyObjectObservable source) -> PyObjectObservable {
+        auto next = std::make_shared<std::chrono::steady_clock::time_point>();
+
+        return source.map([period, next](PyHolder data_object) -> PyHolder {
+            // Sleeping suspends the calling fiber only, the GIL is not held here
+            auto now = std::chrono::steady_clock::now();
+            if (now < *next)
+            {
+                boost::this_fiber::sleep_until(*next);
+                now = *next;
+            }
+            *next = now + period;
+
+            return data_object;
+        });
+    });
+}
+
+PythonOperator OperatorsProxy::skip(std::size_t count)
+{
+    return PythonOperator("skip", [count](PyObjectObservable source) { return source.skip(count); });
+}
+
+PythonOperator OperatorsProxy::take(std::size_t count)
+{
+    // The elements after the first count elements are dropped rather than unsubscribing from the source, which keeps
+    // the upstream channel drained until it completes
+    return PythonOperator("take", [count](PyObjectObservable source) {
+        auto taken = std::make_shared<std::size_t>(0);
+
+        return source.filter([count, taken](const PyHolder& /*data_object*/) {
+            if (*taken == count)
+            {
+                return false;
+            }
+            ++*taken;
+            return true;
+        });
+    });
+}
+
+PythonOperator OperatorsProxy::throttle(double interval_ms)
+{
+    const auto interval = std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+        std::chrono::duration<double, std::milli>(interval_ms));
+
+    // Emits an element, then drops the elements arriving within interval_ms of it
+    return PythonOperator("throttle", [interval](PyObjectObservable source) {
+        auto next = std::make_shared<std::chrono::steady_clock::time_point>();
+
+        return source.filter([interval, next](const PyHolder& /*data_object*/) {
+            auto now = std::chrono::steady_clock::now();
+            if (now < *next)
+            {
+                return false;
+            }
+            *next = now + interval;
+            return true;
+        });
+    });
+}
+
+PythonOperator OperatorsProxy::window(std::size_t count, std::size_t step)
+{
+    if (count == 0 || step == 0)
+    {
+        throw py::value_error("window count and step must be positive");
+    }
+
+    // Windows of count elements starting every step elements; partial windows at completion are dropped
+    return PythonOperator("window", [count, step](PyObjectObservable source) {
+        return source.buffer(count, step)
+            .filter([count](const std::vector<PyHolder>& obj_list) { return obj_list.size() == count; })
+            .map([](std::vector<PyHolder> obj_list) -> PyHolder { return make_py_list(obj_list); });
     });
 }
 
@@ -95,6 +95,46 @@ void OptionsProxy::set_user_cpuset(mrc::TopologyOptions& self, const std::string
     self.user_cpuset(user_cpuset);
 }
 
+std::string OptionsProxy::get_cache_path(mrc::TopologyOptions& self)
+{
+    return self.cache_path();
+}
+
+void OptionsProxy::set_cache_path(mrc::TopologyOptions& self, const std::string& cache_path)
+{
+    self.cache_path(cache_path);
+}
+
+bool OptionsProxy::get_use_cpu_quota(mrc::TopologyOptions& self)
+{
+    return self.use_cpu_quota();
+}
+
+void OptionsProxy::set_use_cpu_quota(mrc::TopologyOptions& self, bool use_cpu_quota)
+{
+    self.use_cpu_quota(use_cpu_quota);
+}
+
+bool OptionsProxy::get_exclude_isolated_cpus(mrc::TopologyOptions& self)
+{
+    return self.exclude_isolated_cpus();
+}
+
+void OptionsProxy::set_exclude_isolated_cpus(mrc::TopologyOptions& self, bool exclude_isolated_cpus)
+{
+    self.exclude_isolated_cpus(exclude_isolated_cpus);
+}
+
+std::size_t OptionsProxy::get_max_cpu_count(mrc::TopologyOptions& self)
+{
+    return self.max_cpu_count();
+}
+
+void OptionsProxy::set_max_cpu_count(mrc::TopologyOptions& self, std::size_t max_cpu_count)
+{
+    self.max_cpu_count(max_cpu_count);
+}
+
 mrc::PlacementStrategy OptionsProxy::get_cpu_strategy(mrc::PlacementOptions& self)
 {
     // Convert the CPU set to a string
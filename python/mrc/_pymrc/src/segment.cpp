@@ -17,10 +17,12 @@
 
 #include "pymrc/segment.hpp"
 
+#include "pymrc/array_view.hpp"
 #include "pymrc/node.hpp"
 #include "pymrc/types.hpp"
 #include "pymrc/utils.hpp"
 
+#include "mrc/node/batcher.hpp"
 #include "mrc/node/edge_builder.hpp"
 #include "mrc/node/port_registry.hpp"
 #include "mrc/runnable/context.hpp"
@@ -34,11 +36,15 @@
 #include <pybind11/pytypes.h>
 #include <rxcpp/rx.hpp>
 
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
 #include <exception>
 #include <fstream>
 #include <functional>
 #include <future>
 #include <map>
+#include <span>
 #include <stdexcept>
 #include <string>
 #include <typeindex>
@@ -109,6 +115,81 @@ std::shared_ptr<mrc::segment::ObjectProperties> build_source(mrc::segment::Build
     return self.construct_object<PythonSource<PyHolder>>(name, wrapper);
 }
 
+std::shared_ptr<mrc::segment::ObjectProperties> build_async_source(mrc::segment::Builder& self,
+                                                                   const std::string& name,
+                                                                   PyObjectHolder source)
+{
+    auto wrapper = [source](PyObjectSubscriber& subscriber) mutable {
+        auto& ctx = runnable::Context::get_runtime_context();
+
+        AcquireGIL gil;
+
+        // each engine drives the async iterator with an event loop of its own
+        auto asyncio = py::module_::import("asyncio");
+        auto loop    = asyncio.attr("new_event_loop")();
+
+        auto close_loop = [&loop]() {
+            loop.attr("run_until_complete")(loop.attr("shutdown_asyncgens")());
+            loop.attr("close")();
+        };
+
+        try
+        {
+            DVLOG(10) << ctx.info() << " Starting async source";
+
+            // an async generator function is called, an async iterable is iterated
+            auto iter  = (PyCallable_Check(source.ptr()) != 0 ? source() : source.attr("__aiter__")());
+            auto anext = iter.attr("__anext__");
+
+            while (true)
+            {
+                py::object next_val;
+                try
+                {
+                    next_val = loop.attr("run_until_complete")(anext());
+                } catch (py::error_already_set& err)
+                {
+                    if (err.matches(PyExc_StopAsyncIteration))
+                    {
+                        break;
+                    }
+                    throw;
+                }
+
+                {
+                    // Release the GIL to call on_next
+                    pybind11::gil_scoped_release nogil;
+
+                    if (subscriber.is_subscribed())
+                    {
+                        subscriber.on_next(std::move(next_val));
+                    }
+                }
+            }
+
+            close_loop();
+
+        } catch (const std::exception& e)
+        {
+            LOG(ERROR) << ctx.info() << "Error occurred in async source. Error msg: " << e.what();
+
+            loop.attr("close")();
+            gil.release();
+            subscriber.on_error(std::current_exception());
+            return;
+        }
+
+        // Release the GIL to call on_complete
+        gil.release();
+
+        subscriber.on_completed();
+
+        DVLOG(10) << ctx.info() << " Async source complete";
+    };
+
+    return self.construct_object<PythonSource<PyHolder>>(name, wrapper);
+}
+
 std::shared_ptr<mrc::segment::ObjectProperties> BuilderProxy::make_source(mrc::segment::Builder& self,
                                                                           const std::string& name,
                                                                           py::iterator source_iterator)
@@ -159,6 +240,7 @@ std::shared_ptr<mrc::segment::ObjectProperties> BuilderProxy::make_sink(mrc::seg
 {
     auto on_next_w = [on_next](PyHolder object) {
         pybind11::gil_scoped_acquire gil;
+        drain_deferred_releases();
         on_next(std::move(object));  // Move the object into a temporary
     };
 
@@ -210,19 +292,21 @@ std::shared_ptr<mrc::segment::ObjectProperties> BuilderProxy::get_egress(mrc::se
     return self.get_egress<PyHolder>(name);
 }
 
-std::shared_ptr<mrc::segment::ObjectProperties> BuilderProxy::make_node(
-    mrc::segment::Builder& self,
-    const std::string& name,
-    std::function<pybind11::object(pybind11::object object)> map_f)
+std::shared_ptr<mrc::segment::ObjectProperties> BuilderProxy::make_node(mrc::segment::Builder& self,
+                                                                       const std::string& name,
+                                                                       py::function map_f)
 {
+    PyObjectHolder fn_holder(std::move(map_f));
+
     return self.make_node<PyHolder, PyHolder, PythonNode>(
-        name, rxcpp::operators::map([map_f](PyHolder data_object) -> PyHolder {
+        name, rxcpp::operators::map([fn_holder](PyHolder data_object) -> PyHolder {
             try
             {
                 py::gil_scoped_acquire gil;
+                const auto& callable = static_cast<const py::handle&>(fn_holder);
 
                 // Call the map function
-                return map_f(std::move(data_object));
+                return callable(py::object(std::move(data_object)));
             } catch (py::error_already_set& err)
             {
                 {
@@ -273,6 +357,170 @@ std::shared_ptr<mrc::segment::ObjectProperties> BuilderProxy::make_node_full(
     return node;
 }
 
+std::shared_ptr<mrc::segment::ObjectProperties> BuilderProxy::make_batcher(
+    mrc::segment::Builder& self,
+    const std::string& name,
+    std::size_t max_count,
+    double max_latency_ms,
+    std::size_t max_bytes,
+    std::function<std::size_t(pybind11::object x)> size_fn)
+{
+    node::BatcherOptions options;
+    options.max_count   = max_count;
+    options.max_latency = std::chrono::microseconds(static_cast<std::int64_t>(max_latency_ms * 1000.0));
+    options.max_bytes   = max_bytes;
+
+    node::Batcher<PyHolder, PyHolder>::size_fn_t size_fn_w = nullptr;
+    if (max_bytes > 0)
+    {
+        if (!size_fn)
+        {
+            py::gil_scoped_acquire gil;
+            size_fn = py::module_::import("sys").attr("getsizeof").cast<std::function<std::size_t(py::object)>>();
+        }
+
+        size_fn_w = [size_fn](const PyHolder& data) {
+            py::gil_scoped_acquire gil;
+            return size_fn(py::reinterpret_borrow<py::object>(static_cast<const py::handle&>(data)));
+        };
+    }
+
+    // the elements are moved into the list, so the emptied holders may be released without the gil
+    auto batch_fn = [](std::vector<PyHolder>&& batch) -> PyHolder {
+        py::gil_scoped_acquire gil;
+        py::list list(batch.size());
+        for (std::size_t i = 0; i < batch.size(); ++i)
+        {
+            list[i] = py::object(std::move(batch[i]));
+        }
+        return PyHolder(std::move(list));
+    };
+
+    return self.construct_object<PythonBatcher<>>(name, options, std::move(size_fn_w), std::move(batch_fn));
+}
+
+std::shared_ptr<mrc::segment::ObjectProperties> BuilderProxy::make_batched_node(mrc::segment::Builder& self,
+                                                                               const std::string& name,
+                                                                               py::function fn,
+                                                                               std::size_t max_batch_size,
+                                                                               double max_hold_ms,
+                                                                               bool batch_aware)
+{
+    PyObjectHolder fn_holder(std::move(fn));
+
+    // the gil is taken once per batch; the elements are moved out while it is held, so the emptied holders may be
+    // released without it
+    auto batch_fn = [fn_holder, batch_aware](std::span<PyHolder> batch, std::vector<PyHolder>& outputs) {
+        py::gil_scoped_acquire gil;
+        drain_deferred_releases();
+        const auto& callable = static_cast<const py::handle&>(fn_holder);
+
+        if (batch_aware)
+        {
+            py::list list(batch.size());
+            for (std::size_t i = 0; i < batch.size(); ++i)
+            {
+                list[i] = py::object(std::move(batch[i]));
+            }
+
+            py::object results = callable(std::move(list));
+            if (!results.is_none())
+            {
+                for (auto result : results)
+                {
+                    outputs.emplace_back(py::reinterpret_borrow<py::object>(result));
+                }
+            }
+            return;
+        }
+
+        for (auto& data : batch)
+        {
+            outputs.emplace_back(callable(py::object(std::move(data))));
+        }
+    };
+
+    return self.construct_object<PythonBatchNode<>>(
+        name,
+        std::move(batch_fn),
+        max_batch_size,
+        std::chrono::microseconds(static_cast<std::int64_t>(max_hold_ms * 1000.0)));
+}
+
+template <typename T>
+std::shared_ptr<mrc::segment::ObjectProperties> build_column_node(mrc::segment::Builder& self,
+                                                                  const std::string& name,
+                                                                  PyObjectHolder fn,
+                                                                  std::size_t max_batch_size,
+                                                                  std::chrono::microseconds max_latency)
+{
+    auto column_fn = [fn](ArrayView column, std::vector<PyHolder>& outputs) {
+        py::gil_scoped_acquire gil;
+        drain_deferred_releases();
+
+        py::object result = fn(py::cast(std::move(column)));
+        if (!result.is_none())
+        {
+            outputs.emplace_back(std::move(result));
+        }
+    };
+
+    return self.construct_object<PythonColumnNode<T>>(name, std::move(column_fn), max_batch_size, max_latency);
+}
+
+std::shared_ptr<mrc::segment::ObjectProperties> BuilderProxy::make_column_node(mrc::segment::Builder& self,
+                                                                               const std::string& name,
+                                                                               py::function fn,
+                                                                               const std::string& dtype,
+                                                                               std::size_t max_batch_size,
+                                                                               double max_hold_ms)
+{
+    PyObjectHolder fn_holder(std::move(fn));
+    auto max_latency = std::chrono::microseconds(static_cast<std::int64_t>(max_hold_ms * 1000.0));
+
+    if (dtype == "float32")
+    {
+        return build_column_node<float>(self, name, std::move(fn_holder), max_batch_size, max_latency);
+    }
+    if (dtype == "float64")
+    {
+        return build_column_node<double>(self, name, std::move(fn_holder), max_batch_size, max_latency);
+    }
+    if (dtype == "int32")
+    {
+        return build_column_node<std::int32_t>(self, name, std::move(fn_holder), max_batch_size, max_latency);
+    }
+    if (dtype == "int64")
+    {
+        return build_column_node<std::int64_t>(self, name, std::move(fn_holder), max_batch_size, max_latency);
+    }
+    if (dtype == "uint32")
+    {
+        return build_column_node<std::uint32_t>(self, name, std::move(fn_holder), max_batch_size, max_latency);
+    }
+    if (dtype == "uint64")
+    {
+        return build_column_node<std::uint64_t>(self, name, std::move(fn_holder), max_batch_size, max_latency);
+    }
+
+    throw py::value_error("unsupported column dtype '" + dtype + "'");
+}
+
+std::shared_ptr<mrc::segment::ObjectProperties> BuilderProxy::make_async_source(mrc::segment::Builder& self,
+                                                                                const std::string& name,
+                                                                                py::object source)
+{
+    return build_async_source(self, name, PyObjectHolder(std::move(source)));
+}
+
+std::shared_ptr<mrc::segment::ObjectProperties> BuilderProxy::make_async_node(mrc::segment::Builder& self,
+                                                                              const std::string& name,
+                                                                              py::function async_fn,
+                                                                              std::size_t max_concurrency)
+{
+    return self.construct_object<PythonAsyncNode>(name, PyObjectHolder(std::move(async_fn)), max_concurrency);
+}
+
 std::shared_ptr<mrc::modules::SegmentModule> BuilderProxy::load_module_from_registry(
     mrc::segment::Builder& self,
     const std::string& module_id,
@@ -307,9 +555,7 @@ void BuilderProxy::register_module_output(mrc::segment::Builder& self,
 
 py::dict BuilderProxy::get_current_module_config(mrc::segment::Builder& self)
 {
-    auto json_config = self.get_current_module_config();
-
-    return cast_from_json(json_config);
+    return cast_from_json(self.get_current_module_config());
 }
 
 void BuilderProxy::make_edge(mrc::segment::Builder& self,
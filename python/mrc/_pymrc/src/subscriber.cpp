@@ -21,6 +21,10 @@
 #include "pymrc/types.hpp"
 #include "pymrc/utils.hpp"
 
+#include "mrc/channel/buffered_channel.hpp"
+#include "mrc/channel/status.hpp"
+#include "mrc/channel/types.hpp"
+
 #include <glog/logging.h>
 #include <pybind11/cast.h>
 #include <pybind11/eval.h>
@@ -30,8 +34,13 @@
 #include <rxcpp/rx.hpp>
 
 #include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
 #include <exception>
 #include <functional>
+#include <memory>
+#include <mutex>
 #include <stdexcept>
 #include <utility>
 #include <vector>
@@ -129,6 +138,86 @@ PySubscription ObservableProxy::subscribe(PyObjectObservable* self, PyObjectSubs
     return self->subscribe(subscriber);
 }
 
+struct BufferedObserver::State
+{
+    State(std::size_t capacity) : channel(capacity) {}
+
+    channel::BufferedChannel<PyHolder> channel;
+    std::mutex mutex;
+    std::exception_ptr error;
+    std::atomic<bool> is_done{false};
+};
+
+BufferedObserver::BufferedObserver(std::size_t capacity, std::size_t batch_size) :
+  m_state(std::make_shared<State>(capacity)),
+  m_batch_size(batch_size)
+{
+    CHECK_GT(m_batch_size, 0);
+}
+
+PyObjectObserver BufferedObserver::observer()
+{
+    // the observer shares the state, so the buffer outlives the python object while elements are in flight
+    auto state = m_state;
+    return rxcpp::make_observer_dynamic<PyHolder>(
+        [state](PyHolder x) { state->channel.await_write(std::move(x)); },
+        [state](std::exception_ptr error) {
+            {
+                std::lock_guard<std::mutex> lock(state->mutex);
+                state->error = std::move(error);
+            }
+            state->channel.close_channel();
+        },
+        [state]() { state->channel.close_channel(); });
+}
+
+py::list BufferedObserver::await_many(std::size_t max_count, double timeout)
+{
+    std::vector<PyHolder> values;
+    channel::Status rc;
+    {
+        py::gil_scoped_release nogil;
+        if (timeout < 0)
+        {
+            rc = m_state->channel.await_read_n(values, max_count);
+        }
+        else
+        {
+            auto deadline = channel::clock_t::now() + std::chrono::duration_cast<channel::clock_t::duration>(
+                                                          std::chrono::duration<double>(timeout));
+            rc = m_state->channel.await_read_n(values, max_count, deadline);
+        }
+    }
+
+    if (rc == channel::Status::closed)
+    {
+        m_state->is_done.store(true);
+
+        std::lock_guard<std::mutex> lock(m_state->mutex);
+        if (m_state->error)
+        {
+            std::rethrow_exception(m_state->error);
+        }
+    }
+
+    py::list list(values.size());
+    for (std::size_t i = 0; i < values.size(); ++i)
+    {
+        list[i] = py::object(std::move(values[i]));
+    }
+    return list;
+}
+
+bool BufferedObserver::is_done() const
+{
+    return m_state->is_done.load();
+}
+
+std::size_t BufferedObserver::batch_size() const
+{
+    return m_batch_size;
+}
+
 std::function<PyObjectObservable(PyObjectObservable&)> test_operator()
 {
     return [](PyObjectObservable& source) {
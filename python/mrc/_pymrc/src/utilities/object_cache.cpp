@@ -17,6 +17,8 @@
 
 #include "pymrc/utilities/object_cache.hpp"
 
+#include "pymrc/utils.hpp"
+
 #include <glog/logging.h>
 #include <pybind11/cast.h>
 #include <pybind11/gil.h>
@@ -116,6 +118,7 @@ void PythonObjectCache::cache_object(const std::string& object_id, pybind11::obj
 void PythonObjectCache::atexit_callback()
 {
     py::gil_scoped_acquire gil;
+    drain_deferred_releases();
 
     for (auto iter : m_object_cache)
     {
@@ -26,10 +26,14 @@
 #include <pybind11/pybind11.h>
 #include <pybind11/pytypes.h>
 
+#include <atomic>
 #include <cassert>
+#include <cstddef>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <utility>
+#include <vector>
 
 namespace mrc::pymrc {
 
@@ -74,6 +78,100 @@ const std::type_info* cpptype_info_from_object(py::object& obj)
     return nullptr;
 }
 
+namespace {
+
+// references dropped by threads not holding the GIL, waiting for a thread which holds it
+struct DeferredReleases
+{
+    std::mutex mutex;
+    std::vector<PyObject*> objects;
+    std::atomic<std::size_t> count{0};
+};
+
+// released objects above which the releasing thread takes the GIL to drain the queue itself
+constexpr std::size_t DeferredReleaseBatch = 256;
+
+DeferredReleases& deferred_releases()
+{
+    // leaked, the queue may be used by objects released during static destruction
+    static auto* releases = new DeferredReleases();
+    return *releases;
+}
+
+}  // namespace
+
+void release_deferred(py::object&& obj)
+{
+    if (!obj)
+    {
+        return;
+    }
+
+    if (PyGILState_Check() != 0)
+    {
+        py::object tmp = std::move(obj);
+        return;
+    }
+
+    auto& releases    = deferred_releases();
+    std::size_t count = 0;
+    {
+        std::lock_guard<std::mutex> lock(releases.mutex);
+        releases.objects.push_back(obj.release().ptr());
+        count = releases.objects.size();
+        releases.count.store(count, std::memory_order_relaxed);
+    }
+
+    if (count >= DeferredReleaseBatch)
+    {
+        py::gil_scoped_acquire gil;
+        drain_deferred_releases();
+    }
+}
+
+void drain_deferred_releases()
+{
+    auto& releases = deferred_releases();
+    if (releases.count.load(std::memory_order_relaxed) == 0)
+    {
+        return;
+    }
+
+    std::vector<PyObject*> objects;
+    {
+        std::lock_guard<std::mutex> lock(releases.mutex);
+        objects.swap(releases.objects);
+        releases.count.store(0, std::memory_order_relaxed);
+    }
+
+    // references outliving the interpreter are leaked
+    if (Py_IsInitialized() == 0)
+    {
+        return;
+    }
+
+    for (auto* object : objects)
+    {
+        Py_DECREF(object);
+    }
+}
+
+std::size_t deferred_release_count()
+{
+    return deferred_releases().count.load(std::memory_order_relaxed);
+}
+
+bool is_gil_enabled()
+{
+    // sys._is_gil_enabled only exists from python 3.13, interpreters without it always have a GIL
+    auto sys = py::module_::import("sys");
+    if (!py::hasattr(sys, "_is_gil_enabled"))
+    {
+        return true;
+    }
+    return sys.attr("_is_gil_enabled")().cast<bool>();
+}
+
 py::object cast_from_json(const json& source)
 {
     if (source.is_null())
@@ -174,7 +272,10 @@ json cast_from_pyobject(const py::object& source)
     return json();
 }
 
-AcquireGIL::AcquireGIL() : m_gil(std::make_unique<py::gil_scoped_acquire>()) {}
+AcquireGIL::AcquireGIL() : m_gil(std::make_unique<py::gil_scoped_acquire>())
+{
+    drain_deferred_releases();
+}
 
 AcquireGIL::~AcquireGIL() = default;
 
@@ -212,20 +313,10 @@ PyObjectWrapper::PyObjectWrapper(pybind11::object&& to_wrap) : m_obj(std::move(t
 
 PyObjectWrapper::~PyObjectWrapper()
 {
-    // If we are being destroyed with a wrapped object, grab the GIL before destroying
+    // Without the GIL, the reference is queued rather than grabbing the GIL just to drop it
     if (m_obj)
     {
-        // Two paths here make it easy to put breakpoints in for debugging
-        if (PyGILState_Check() == 0)
-        {
-            pybind11::gil_scoped_acquire gil;
-
-            pybind11::object tmp = std::move(m_obj);
-        }
-        else
-        {
-            pybind11::object tmp = std::move(m_obj);
-        }
+        release_deferred(std::move(m_obj));
 
         assert(!m_obj);
     }
@@ -279,7 +370,8 @@ PyObject* PyObjectWrapper::ptr() const
     return m_obj.ptr();
 }
 
-PyObjectHolder::PyObjectHolder() : m_wrapped(std::make_shared<PyObjectWrapper>()) {}
+// Empty holders, e.g. the targets of channel reads, do not allocate a wrapper
+PyObjectHolder::PyObjectHolder() = default;
 
 PyObjectHolder::PyObjectHolder(pybind11::object&& to_wrap) :
   m_wrapped(std::make_shared<PyObjectWrapper>(std::move(to_wrap)))
@@ -314,24 +406,31 @@ PyObjectHolder& PyObjectHolder::operator=(PyObjectHolder&& other)
 
 PyObjectHolder::operator bool() const
 {
-    return (bool)*m_wrapped;
+    return m_wrapped && (bool)*m_wrapped;
 }
 
 const pybind11::handle& PyObjectHolder::view_obj() const&
 {
+    static const pybind11::handle empty;
+
     // Allow for peaking into the object
-    return m_wrapped->view_obj();
+    return (m_wrapped ? m_wrapped->view_obj() : empty);
 }
 
 pybind11::object PyObjectHolder::copy_obj() const&
 {
+    if (!m_wrapped)
+    {
+        return {};
+    }
+
     // Allow for peaking into the object
     return m_wrapped->copy_obj();
 }
 
 pybind11::object&& PyObjectHolder::move_obj() &&
 {
-    return std::move(*m_wrapped).move_obj();
+    return std::move(*this).operator pybind11::object&&();
 }
 
 PyObjectHolder::operator const pybind11::handle&() const&
@@ -342,16 +441,22 @@ PyObjectHolder::operator const pybind11::handle&() const&
         throw mrc::exceptions::MrcRuntimeError("Must have the GIL copying to py::object");
     }
 
-    return m_wrapped->view_obj();
+    return view_obj();
 }
 
 PyObjectHolder::operator pybind11::object&&() &&
 {
+    if (!m_wrapped)
+    {
+        throw mrc::exceptions::MrcRuntimeError(
+            "Cannot convert empty holder to py::object. Did you accidentally move out the object?");
+    }
+
     return std::move(*m_wrapped).move_obj();
 }
 
 PyObject* PyObjectHolder::ptr() const
 {
-    return m_wrapped->ptr();
+    return (m_wrapped ? m_wrapped->ptr() : nullptr);
 }
 }  // namespace mrc::pymrc
@@ -0,0 +1,104 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2021-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "test_pymrc.hpp"
+
+#include "pymrc/array_view.hpp"
+
+#include "mrc/memory/memory_kind.hpp"
+
+#include <gtest/gtest.h>
+#include <pybind11/cast.h>
+#include <pybind11/pybind11.h>
+#include <pybind11/pytypes.h>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace py    = pybind11;
+namespace pymrc = mrc::pymrc;
+using namespace pybind11::literals;
+
+PYMRC_TEST_CLASS(ArrayView);
+
+TEST_F(TestArrayView, BufferProtocol)
+{
+    py::bytearray data("abcdefghijkl", 12);
+    auto matrix = py::memoryview(data).attr("cast")("B", py::make_tuple(3, 4));
+
+    auto view = pymrc::ArrayView::from_object(matrix);
+
+    EXPECT_EQ(view.kind(), mrc::memory::memory_kind::host);
+    EXPECT_EQ(view.view().data(), PyByteArray_AsString(data.ptr()));
+    EXPECT_EQ(view.view().bytes(), 12);
+    EXPECT_EQ(view.shape(), (std::vector<std::int64_t>{3, 4}));
+    EXPECT_EQ(view.strides(), (std::vector<std::int64_t>{4, 1}));
+    EXPECT_EQ(view.typestr(), "|u1");
+    EXPECT_EQ(view.size(), 12);
+    EXPECT_TRUE(view.is_c_contiguous());
+    EXPECT_FALSE(view.readonly());
+
+    auto interface = view.array_interface();
+    EXPECT_TRUE(interface["shape"].equal(py::make_tuple(3, 4)));
+    EXPECT_EQ(interface["typestr"].cast<std::string>(), "|u1");
+    EXPECT_EQ(interface["data"].cast<py::tuple>()[0].cast<std::uintptr_t>(),
+              reinterpret_cast<std::uintptr_t>(view.view().data()));
+}
+
+TEST_F(TestArrayView, KeepsOwnerAlive)
+{
+    auto view = pymrc::ArrayView::from_object(py::bytes("0123456789"));
+    EXPECT_TRUE(view.readonly());
+    EXPECT_EQ(view.typestr(), "|u1");
+
+    // the bytes object is only referenced by the view at this point
+    py::module_::import("gc").attr("collect")();
+    EXPECT_EQ(std::string(static_cast<const char*>(view.view().data()), view.view().bytes()), "0123456789");
+}
+
+TEST_F(TestArrayView, Strided)
+{
+    py::bytearray data("abcdefgh", 8);
+    auto doubles = py::memoryview(data).attr("cast")("d");
+
+    auto view = pymrc::ArrayView::from_object(doubles);
+    EXPECT_EQ(view.typestr(), "<f8");
+    EXPECT_EQ(view.itemsize(), 8);
+
+    auto every_other = py::memoryview(py::bytearray(std::string(16, '\0'))).attr("__getitem__")(py::slice(0, 16, 2));
+    auto strided     = pymrc::ArrayView::from_object(every_other);
+    EXPECT_EQ(strided.shape(), (std::vector<std::int64_t>{8}));
+    EXPECT_EQ(strided.strides(), (std::vector<std::int64_t>{2}));
+    EXPECT_EQ(strided.view().bytes(), 15);
+    EXPECT_FALSE(strided.is_c_contiguous());
+}
+
+TEST_F(TestArrayView, RejectsOpaqueObjects)
+{
+    EXPECT_THROW(pymrc::ArrayView::from_object(py::dict("a"_a = 1)), py::type_error);
+}
+
+TEST_F(TestArrayView, TypestrFor)
+{
+    EXPECT_EQ(pymrc::typestr_for<double>(), "<f8");
+    EXPECT_EQ(pymrc::typestr_for<float>(), "<f4");
+    EXPECT_EQ(pymrc::typestr_for<std::int32_t>(), "<i4");
+    EXPECT_EQ(pymrc::typestr_for<std::uint64_t>(), "<u8");
+    EXPECT_EQ(pymrc::typestr_for<std::uint8_t>(), "|u1");
+    EXPECT_EQ(pymrc::typestr_for<bool>(), "|b1");
+}
@@ -0,0 +1,89 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "test_pymrc.hpp"
+
+#include "pymrc/arrow_batch.hpp"
+
+#include "mrc/arrow/arrow_batch.hpp"
+
+#include <gtest/gtest.h>
+#include <pybind11/cast.h>
+#include <pybind11/pybind11.h>
+#include <pybind11/pytypes.h>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace py    = pybind11;
+namespace pymrc = mrc::pymrc;
+using namespace pybind11::literals;
+
+PYMRC_TEST_CLASS(ArrowBatch);
+
+namespace {
+
+// pyarrow is an optional dependency of the bindings
+py::object import_pyarrow()
+{
+    try
+    {
+        return py::module_::import("pyarrow");
+    } catch (const py::error_already_set&)
+    {
+        return py::none();
+    }
+}
+
+}  // namespace
+
+TEST_F(TestArrowBatch, PyarrowRoundTrip)
+{
+    auto pa = import_pyarrow();
+    if (pa.is_none())
+    {
+        GTEST_SKIP() << "pyarrow is not installed";
+    }
+
+    auto record_batch = pa.attr("record_batch")(
+        py::dict("id"_a = py::make_tuple(1, py::none(), 3), "name"_a = py::make_tuple("x", "yy", "zzz")));
+
+    auto batch = pymrc::arrow_batch_from_object(record_batch);
+    EXPECT_EQ(batch.num_rows(), 3);
+    EXPECT_EQ(batch.column_names(), (std::vector<std::string>{"id", "name"}));
+
+    // the values are viewed in place
+    auto values = record_batch.attr("column")(0).attr("buffers")()[py::int_(1)].attr("address").cast<std::uintptr_t>();
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(batch.layout().children[0].buffers[1].data()), values);
+
+    auto exported = pymrc::arrow_batch_to_pyarrow(batch);
+    EXPECT_TRUE(exported.attr("equals")(record_batch).cast<bool>());
+
+    // the PyCapsule interface is available from pyarrow 14
+    if (py::hasattr(pa.attr("RecordBatch"), "_import_from_c_capsule"))
+    {
+        auto capsules      = pymrc::arrow_batch_to_capsules(batch);
+        auto from_capsules = pa.attr("RecordBatch").attr("_import_from_c_capsule")(capsules[0], capsules[1]);
+        EXPECT_TRUE(from_capsules.attr("equals")(record_batch).cast<bool>());
+    }
+}
+
+TEST_F(TestArrowBatch, RejectsOpaqueObjects)
+{
+    EXPECT_THROW(pymrc::arrow_batch_from_object(py::dict("a"_a = 1)), py::type_error);
+}
@@ -0,0 +1,92 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2021-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "test_pymrc.hpp"
+
+#include "pymrc/subscriber.hpp"
+#include "pymrc/types.hpp"
+
+#include <gtest/gtest.h>
+#include <pybind11/cast.h>
+#include <pybind11/gil.h>
+#include <pybind11/pytypes.h>
+#include <rxcpp/rx.hpp>
+
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace py    = pybind11;
+namespace pymrc = mrc::pymrc;
+
+PYMRC_TEST_CLASS(Subscriber);
+
+TEST_F(TestSubscriber, BufferedObserverBatches)
+{
+    pymrc::BufferedObserver buffered(16, 4);
+
+    std::vector<pymrc::PyHolder> values;
+    for (int i = 0; i < 10; i++)
+    {
+        values.emplace_back(py::int_(i));
+    }
+    rxcpp::observable<>::iterate(values).subscribe(buffered.observer());
+
+    std::vector<int> received;
+    std::vector<std::size_t> batch_sizes;
+    while (!buffered.is_done())
+    {
+        auto batch = buffered.await_many(4, 1.0);
+        if (!batch.empty())
+        {
+            batch_sizes.push_back(batch.size());
+        }
+        for (auto value : batch)
+        {
+            received.push_back(value.cast<int>());
+        }
+    }
+
+    EXPECT_EQ(received, (std::vector<int>{0, 1, 2, 3, 4, 5, 6, 7, 8, 9}));
+    EXPECT_EQ(batch_sizes, (std::vector<std::size_t>{4, 4, 2}));
+}
+
+TEST_F(TestSubscriber, BufferedObserverTimeout)
+{
+    pymrc::BufferedObserver buffered(16, 4);
+
+    auto batch = buffered.await_many(4, 0.01);
+    EXPECT_TRUE(batch.empty());
+    EXPECT_FALSE(buffered.is_done());
+}
+
+TEST_F(TestSubscriber, BufferedObserverError)
+{
+    pymrc::BufferedObserver buffered(16, 4);
+
+    auto observer = buffered.observer();
+    {
+        // the producer does not hold the GIL
+        py::gil_scoped_release nogil;
+        std::thread([&observer]() {
+            observer.on_error(std::make_exception_ptr(std::runtime_error("failed")));
+        }).join();
+    }
+
+    EXPECT_THROW(buffered.await_many(4, 1.0), std::runtime_error);
+    EXPECT_TRUE(buffered.is_done());
+}
@@ -20,6 +20,8 @@
 #include "pymrc/forward.hpp"
 #include "pymrc/utils.hpp"
 
+#include "mrc/exceptions/runtime_error.hpp"
+
 #include <glog/logging.h>
 #include <gtest/gtest.h>
 #include <nlohmann/json.hpp>
@@ -35,6 +37,7 @@
 #include <memory>
 #include <stdexcept>
 #include <string>
+#include <thread>
 #include <utility>
 #include <vector>
 
@@ -211,3 +214,42 @@ TEST_F(TestUtils, PyObjectHolder)
     EXPECT_TRUE(wrapper.view_obj());
     EXPECT_EQ(wrapper.view_obj().ref_count(), 1);
 }
+
+TEST_F(TestUtils, PyObjectHolderEmpty)
+{
+    mrc::pymrc::PyObjectHolder empty;
+    EXPECT_FALSE(empty);
+    EXPECT_FALSE(empty.view_obj());
+    EXPECT_EQ(empty.ptr(), nullptr);
+
+    mrc::pymrc::PyObjectHolder holder = py::list();
+    mrc::pymrc::PyObjectHolder moved  = std::move(holder);
+    EXPECT_FALSE(holder);  // NOLINT(bugprone-use-after-move)
+    EXPECT_TRUE(moved);
+
+    EXPECT_THROW(py::object(std::move(empty)), mrc::exceptions::MrcRuntimeError);
+}
+
+TEST_F(TestUtils, DeferredRelease)
+{
+    py::object test_obj = py::list();
+    auto holder         = std::make_unique<mrc::pymrc::PyObjectHolder>(py::object(test_obj));
+    EXPECT_EQ(test_obj.ref_count(), 2);
+
+    {
+        // dropping the holder on a thread without the GIL queues its reference
+        py::gil_scoped_release nogil;
+        std::thread([&holder]() { holder.reset(); }).join();
+    }
+
+    EXPECT_EQ(test_obj.ref_count(), 2);
+    EXPECT_GE(mrc::pymrc::deferred_release_count(), 1);
+
+    mrc::pymrc::drain_deferred_releases();
+    EXPECT_EQ(test_obj.ref_count(), 1);
+    EXPECT_EQ(mrc::pymrc::deferred_release_count(), 0);
+
+    // with the GIL, the reference is dropped right away
+    mrc::pymrc::release_deferred(py::object(test_obj));
+    EXPECT_EQ(test_obj.ref_count(), 1);
+}
@@ -19,21 +19,56 @@
 
 #include "pymrc/executor.hpp"  // IWYU pragma: keep
 #include "pymrc/segment.hpp"
+#include "pymrc/utils.hpp"
 
+#include "mrc/benchmarking/bottleneck.hpp"
+#include "mrc/benchmarking/live_sampler.hpp"
+
+#include <nlohmann/json.hpp>
 #include <pybind11/attr.h>
 #include <pybind11/gil.h>  // IWYU pragma: keep
 #include <pybind11/pybind11.h>
 
 #include <array>
+#include <chrono>
 #include <cstddef>
 #include <functional>
 #include <memory>
+#include <utility>
 #include <vector>
 
 namespace mrc::pymrc {
 
 namespace py = pybind11;
 
+// live samples are handed to the python callback as dicts, see LiveSample::to_json
+template <typename WatcherT>
+void start_live(WatcherT& watcher, std::size_t period_ms, py::function on_sample)
+{
+    PyObjectHolder callback(std::move(on_sample));
+
+    // starting stops a previous live session, whose sampling thread may be waiting on the gil
+    py::gil_scoped_release nogil;
+    watcher.start_live(std::chrono::milliseconds(period_ms), [callback](const mrc::benchmarking::LiveSample& sample) {
+        py::gil_scoped_acquire gil;
+        callback(cast_from_json(sample.to_json()));
+    });
+}
+
+// bottleneck reports are handed to the python callback as dicts, see BottleneckReport::to_json
+template <typename WatcherT>
+void start_bottleneck_reports(WatcherT& watcher, std::size_t period_ms, py::function on_report)
+{
+    PyObjectHolder callback(std::move(on_report));
+
+    py::gil_scoped_release nogil;
+    watcher.start_bottleneck_reports(std::chrono::milliseconds(period_ms),
+                                     [callback](const mrc::benchmarking::BottleneckReport& report) {
+                                         py::gil_scoped_acquire gil;
+                                         callback(cast_from_json(report.to_json()));
+                                     });
+}
+
 PYBIND11_MODULE(watchers, m)
 {
     m.doc() = R"pbdoc()pbdoc";
@@ -63,6 +98,12 @@ PYBIND11_MODULE(watchers, m)
         "trace_until_notified", &pymrc::LatencyWatcher::trace_until_notified, py::call_guard<py::gil_scoped_release>());
     PyLatencyWatcher.def("tracer_count", py::overload_cast<std::size_t>(&pymrc::LatencyWatcher::tracer_count));
     PyLatencyWatcher.def("tracing", &pymrc::LatencyWatcher::tracing);
+    PyLatencyWatcher.def("start_live", &start_live<pymrc::LatencyWatcher>, py::arg("period_ms"), py::arg("on_sample"));
+    PyLatencyWatcher.def("stop_live", &pymrc::LatencyWatcher::stop_live, py::call_guard<py::gil_scoped_release>());
+    PyLatencyWatcher.def("start_bottleneck_reports",
+                         &start_bottleneck_reports<pymrc::LatencyWatcher>,
+                         py::arg("period_ms"),
+                         py::arg("on_report"));
 
     /** Throughput Watcher Begin **/
     auto PyThroughputWatcher = py::class_<pymrc::ThroughputWatcher>(m, "ThroughputWatcher");
@@ -93,5 +134,13 @@ PYBIND11_MODULE(watchers, m)
                             py::call_guard<py::gil_scoped_release>());
     PyThroughputWatcher.def("tracer_count", py::overload_cast<std::size_t>(&pymrc::ThroughputWatcher::tracer_count));
     PyThroughputWatcher.def("tracing", &pymrc::ThroughputWatcher::tracing);
+    PyThroughputWatcher.def(
+        "start_live", &start_live<pymrc::ThroughputWatcher>, py::arg("period_ms"), py::arg("on_sample"));
+    PyThroughputWatcher.def(
+        "stop_live", &pymrc::ThroughputWatcher::stop_live, py::call_guard<py::gil_scoped_release>());
+    PyThroughputWatcher.def("start_bottleneck_reports",
+                            &start_bottleneck_reports<pymrc::ThroughputWatcher>,
+                            py::arg("period_ms"),
+                            py::arg("on_report"));
 }
 }  // namespace mrc::pymrc
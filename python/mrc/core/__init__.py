@@ -12,3 +12,13 @@
 # WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
 # See the License for the specific language governing permissions and
 # limitations under the License.
+
+import importlib
+
+
+def __getattr__(name: str):
+    # Submodules are imported on their first access, so `mrc.core.operators` resolves without importing it first
+    try:
+        return importlib.import_module("." + name, __name__)
+    except ModuleNotFoundError as e:
+        raise AttributeError("module '{}' has no attribute '{}'".format(__name__, name)) from e
@@ -15,11 +15,16 @@
  * limitations under the License.
  */
 
+#include "pymrc/array_view.hpp"
+#include "pymrc/arrow_batch.hpp"
 #include "pymrc/edge_adapter.hpp"
 #include "pymrc/port_builders.hpp"
 #include "pymrc/types.hpp"
+#include "pymrc/utils.hpp"
 
+#include "mrc/arrow/arrow_batch.hpp"
 #include "mrc/channel/status.hpp"
+#include "mrc/memory/memory_kind.hpp"
 #include "mrc/node/sink_properties.hpp"
 #include "mrc/node/source_properties.hpp"
 #include "mrc/utils/string_utils.hpp"
@@ -28,6 +33,7 @@
 #include <boost/fiber/future/future.hpp>
 #include <pybind11/pybind11.h>
 #include <pybind11/pytypes.h>
+#include <pybind11/stl.h>
 #include <rxcpp/rx.hpp>
 
 #include <memory>
@@ -52,6 +58,62 @@ PYBIND11_MODULE(common, module)
     EdgeAdapterUtil::register_data_adapters<PyHolder>();
     PortBuilderUtil::register_port_util<PyHolder>();
 
+    // Arrays and tensors are viewed without a copy when they cross an edge between python and an ArrayView node
+    py::class_<ArrayView>(module, "ArrayView")
+        .def(py::init(&ArrayView::from_object), py::arg("obj"))
+        .def_property_readonly("shape", [](const ArrayView& self) { return py::tuple(py::cast(self.shape())); })
+        .def_property_readonly("strides", [](const ArrayView& self) { return py::tuple(py::cast(self.strides())); })
+        .def_property_readonly("typestr", &ArrayView::typestr)
+        .def_property_readonly("nbytes", [](const ArrayView& self) { return self.view().bytes(); })
+        .def_property_readonly("readonly", &ArrayView::readonly)
+        .def_property_readonly("is_device",
+                               [](const ArrayView& self) { return self.kind() == memory::memory_kind::device; })
+        .def_property_readonly("__array_interface__",
+                               [](const ArrayView& self) {
+                                   if (self.kind() == memory::memory_kind::device)
+                                   {
+                                       throw py::attribute_error("device arrays expose __cuda_array_interface__");
+                                   }
+                                   return self.array_interface();
+                               })
+        .def_property_readonly("__cuda_array_interface__", [](const ArrayView& self) {
+            if (self.kind() != memory::memory_kind::device)
+            {
+                throw py::attribute_error("host arrays expose __array_interface__");
+            }
+            return self.array_interface();
+        });
+
+    py::implicitly_convertible<py::object, ArrayView>();
+    EdgeAdapterUtil::register_data_adapters<ArrayView>();
+
+    // Record batches and dataframes cross edges between python and ArrowBatch nodes without copying their columns
+    py::class_<arrow::ArrowBatch>(module, "ArrowBatch")
+        .def(py::init(&arrow_batch_from_object), py::arg("obj"))
+        .def_property_readonly("num_rows", &arrow::ArrowBatch::num_rows)
+        .def_property_readonly("num_columns", &arrow::ArrowBatch::num_columns)
+        .def_property_readonly("column_names", &arrow::ArrowBatch::column_names)
+        .def_property_readonly("nbytes", &arrow::ArrowBatch::nbytes)
+        .def("to_pyarrow", &arrow_batch_to_pyarrow)
+        .def("to_pandas",
+             [](const arrow::ArrowBatch& self) { return arrow_batch_to_pyarrow(self).attr("to_pandas")(); })
+        .def(
+            "__arrow_c_array__",
+            [](const arrow::ArrowBatch& self, const py::object& /*requested_schema*/) {
+                return arrow_batch_to_capsules(self);
+            },
+            py::arg("requested_schema") = py::none());
+
+    py::implicitly_convertible<py::object, arrow::ArrowBatch>();
+    EdgeAdapterUtil::register_data_adapters<arrow::ArrowBatch>();
+
+    module.def("is_gil_enabled",
+               &is_gil_enabled,
+               R"pbdoc(
+        Returns False when running on a free-threaded CPython build with the GIL disabled. Only then do python nodes
+        with more than one pe execute in parallel; with a GIL their callables are serialized.
+    )pbdoc");
+
     module.attr("__version__") =
         MRC_CONCAT_STR(mrc_VERSION_MAJOR << "." << mrc_VERSION_MINOR << "." << mrc_VERSION_PATCH);
 }
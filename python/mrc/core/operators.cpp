@@ -56,6 +56,16 @@ PYBIND11_MODULE(operators, module)
     module.def("pairwise", &OperatorsProxy::pairwise);
     module.def("to_list", &OperatorsProxy::to_list);
 
+    // Native operators, which keep the elements out of the interpreter
+    module.def("batch", &OperatorsProxy::batch, py::arg("count"));
+    module.def("distinct", &OperatorsProxy::distinct);
+    module.def("key_by", &OperatorsProxy::key_by, py::arg("key"));
+    module.def("rate_limit", &OperatorsProxy::rate_limit, py::arg("per_second"));
+    module.def("skip", &OperatorsProxy::skip, py::arg("count"));
+    module.def("take", &OperatorsProxy::take, py::arg("count"));
+    module.def("throttle", &OperatorsProxy::throttle, py::arg("interval_ms"));
+    module.def("window", &OperatorsProxy::window, py::arg("count"), py::arg("step") = 1);
+
     module.attr("__version__") =
         MRC_CONCAT_STR(mrc_VERSION_MAJOR << "." << mrc_VERSION_MINOR << "." << mrc_VERSION_PATCH);
 }
@@ -30,6 +30,7 @@
 #include <pybind11/pybind11.h>
 #include <pybind11/pytypes.h>
 
+#include <cstdint>
 #include <memory>
 #include <sstream>
 
@@ -75,7 +76,13 @@ PYBIND11_MODULE(options, module)
 
     py::class_<mrc::TopologyOptions>(module, "TopologyOptions")
         .def(py::init<>())
-        .def_property("user_cpuset", &OptionsProxy::get_user_cpuset, &OptionsProxy::set_user_cpuset);
+        .def_property("user_cpuset", &OptionsProxy::get_user_cpuset, &OptionsProxy::set_user_cpuset)
+        .def_property("cache_path", &OptionsProxy::get_cache_path, &OptionsProxy::set_cache_path)
+        .def_property("use_cpu_quota", &OptionsProxy::get_use_cpu_quota, &OptionsProxy::set_use_cpu_quota)
+        .def_property("exclude_isolated_cpus",
+                      &OptionsProxy::get_exclude_isolated_cpus,
+                      &OptionsProxy::set_exclude_isolated_cpus)
+        .def_property("max_cpu_count", &OptionsProxy::get_max_cpu_count, &OptionsProxy::set_max_cpu_count);
 
     py::class_<mrc::PlacementOptions>(module, "PlacementOptions")
         .def(py::init<>())
@@ -113,7 +120,13 @@ PYBIND11_MODULE(options, module)
         .def_property("architect_url",
                       // return a const str
                       static_cast<std::string const& (mrc::Options::*)() const>(&mrc::Options::architect_url),
-                      static_cast<void (mrc::Options::*)(std::string)>(&mrc::Options::architect_url));
+                      static_cast<void (mrc::Options::*)(std::string)>(&mrc::Options::architect_url))
+        .def_property("enable_metrics_server",
+                      static_cast<bool (mrc::Options::*)() const>(&mrc::Options::enable_metrics_server),
+                      static_cast<void (mrc::Options::*)(bool)>(&mrc::Options::enable_metrics_server))
+        .def_property("metrics_port",
+                      static_cast<std::uint16_t (mrc::Options::*)() const>(&mrc::Options::metrics_port),
+                      static_cast<void (mrc::Options::*)(std::uint16_t)>(&mrc::Options::metrics_port));
 
     module.attr("__version__") =
         MRC_CONCAT_STR(mrc_VERSION_MAJOR << "." << mrc_VERSION_MINOR << "." << mrc_VERSION_PATCH);
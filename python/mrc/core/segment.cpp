@@ -146,6 +146,68 @@ PYBIND11_MODULE(segment, module)
      */
     Builder.def("make_node", &BuilderProxy::make_node, py::return_value_policy::reference_internal);
 
+    /**
+     * Construct a new python::object -> python::object node emitting its inputs as lists once the first of the
+     * count, byte size or latency triggers is reached
+     */
+    Builder.def("make_batcher",
+                &BuilderProxy::make_batcher,
+                py::arg("name"),
+                py::arg("max_count")      = 64,
+                py::arg("max_latency_ms") = 1.0,
+                py::arg("max_bytes")      = 0,
+                py::arg("size_fn")        = py::none(),
+                py::return_value_policy::reference_internal);
+
+    /**
+     * Construct a new python::object -> python::object node calling fn on batches drained from its input, holding
+     * the GIL once per batch rather than once per element. A batch fills for at most max_hold_ms after its first
+     * element was read. With batch_aware, fn is called once per batch with the list of its elements and returns an
+     * iterable of outputs, or None; otherwise fn is called on each element and its results are emitted.
+     */
+    Builder.def("make_batched_node",
+                &BuilderProxy::make_batched_node,
+                py::arg("name"),
+                py::arg("fn"),
+                py::arg("max_batch_size") = 64,
+                py::arg("max_hold_ms")    = 1.0,
+                py::arg("batch_aware")    = false,
+                py::return_value_policy::reference_internal);
+
+    /**
+     * Construct a new node packing the scalar elements received from c++ nodes into columns without the GIL, then
+     * calling fn once per column with an ArrayView of it
+     */
+    Builder.def("make_column_node",
+                &BuilderProxy::make_column_node,
+                py::arg("name"),
+                py::arg("fn"),
+                py::arg("dtype"),
+                py::arg("max_batch_size") = 1024,
+                py::arg("max_hold_ms")    = 1.0,
+                py::return_value_policy::reference_internal);
+
+    /**
+     * Construct a new py::object source from an `async def` generator function or an async iterable; each engine
+     * drives it with an asyncio event loop of its own
+     */
+    Builder.def("make_async_source",
+                &BuilderProxy::make_async_source,
+                py::arg("name"),
+                py::arg("source"),
+                py::return_value_policy::reference_internal);
+
+    /**
+     * Construct a new py::object -> py::object node awaiting an `async def` function on each input, with up to
+     * max_concurrency calls in flight per pe. Results are emitted in completion order.
+     */
+    Builder.def("make_async_node",
+                &BuilderProxy::make_async_node,
+                py::arg("name"),
+                py::arg("async_fn"),
+                py::arg("max_concurrency") = 64,
+                py::return_value_policy::reference_internal);
+
     /**
      * Find and return an existing egress port -- throws if `name` does not exist
      * (py) @param name: Name of the egress port
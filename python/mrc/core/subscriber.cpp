@@ -76,6 +76,34 @@ PYBIND11_MODULE(subscriber, module)
              py::call_guard<py::gil_scoped_release>())
         .def("pipe", &ObservableProxy::pipe);
 
+    py::class_<BufferedObserver, std::shared_ptr<BufferedObserver>>(module, "BufferedObserver")
+        .def(py::init<std::size_t, std::size_t>(), py::arg("capacity") = 1024, py::arg("batch_size") = 64)
+        .def_property_readonly("observer", &BufferedObserver::observer)
+        .def_property_readonly("is_done", &BufferedObserver::is_done)
+        .def("await_many",
+             &BufferedObserver::await_many,
+             py::arg("max_count"),
+             py::arg("timeout") = -1.0,
+             R"pbdoc(
+        Returns up to max_count elements once at least one is available, waiting at most timeout seconds, or forever
+        with a negative timeout. The list is empty on a timeout, or once the observable completed and was drained.
+    )pbdoc")
+        .def("__aiter__", [](py::object self) { return self; })
+        .def("__anext__", [](std::shared_ptr<BufferedObserver> self) {
+            // the wait runs on the default executor of the loop; each step yields a list of up to batch_size elements
+            auto read_batch = py::cpp_function([self]() {
+                py::list batch = self->await_many(self->batch_size(), -1.0);
+                if (batch.empty())
+                {
+                    PyErr_SetNone(PyExc_StopAsyncIteration);
+                    throw py::error_already_set();
+                }
+                return batch;
+            });
+            auto loop = py::module_::import("asyncio").attr("get_running_loop")();
+            return loop.attr("run_in_executor")(py::none(), read_batch);
+        });
+
     module.attr("__version__") =
         MRC_CONCAT_STR(mrc_VERSION_MAJOR << "." << mrc_VERSION_MINOR << "." << mrc_VERSION_PATCH);
 }
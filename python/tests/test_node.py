@@ -13,6 +13,9 @@
 # See the License for the specific language governing permissions and
 # limitations under the License.
 
+import asyncio
+import sys
+
 import pytest
 
 import mrc
@@ -200,3 +203,153 @@ def test_launch_options_properties():
 
 if (__name__ == "__main__"):
     test_launch_options_properties()
+
+
+@pytest.mark.parametrize("max_bytes", [0, 16])
+def test_batcher(max_bytes: int):
+    batches = []
+
+    def segment_init(seg: mrc.Builder):
+        src_node = seg.make_source("my_src", list(range(10)))
+
+        # every element is estimated at 8 bytes, so the byte trigger emits batches of 2 elements
+        batcher = seg.make_batcher("batcher",
+                                   max_count=4,
+                                   max_latency_ms=10000.0,
+                                   max_bytes=max_bytes,
+                                   size_fn=lambda x: 8)
+        seg.make_edge(src_node, batcher)
+
+        def on_next(batch: list):
+            batches.append(batch)
+
+        def on_error(err):
+            pass
+
+        def on_complete():
+            pass
+
+        sink = seg.make_sink("my_sink", on_next, on_error, on_complete)
+        seg.make_edge(batcher, sink)
+
+    pipeline = mrc.Pipeline()
+
+    pipeline.make_segment("my_seg", segment_init)
+
+    options = mrc.Options()
+    options.topology.user_cpuset = "0"
+
+    executor = mrc.Executor(options)
+
+    executor.register_pipeline(pipeline)
+
+    executor.start()
+
+    executor.join()
+
+    max_len = 2 if max_bytes > 0 else 4
+    assert all(isinstance(batch, list) and len(batch) <= max_len for batch in batches)
+    assert [x for batch in batches for x in batch] == list(range(10))
+
+
+@pytest.mark.parametrize("batch_aware", [False, True])
+def test_batched_node(batch_aware: bool):
+    batch_sizes = []
+    results = []
+
+    def map_fn(x):
+        return x * 2
+
+    def batch_fn(batch: list):
+        batch_sizes.append(len(batch))
+        # a batch-aware callable may drop elements
+        return [x * 2 for x in batch if x % 3 != 0]
+
+    def segment_init(seg: mrc.Builder):
+        src_node = seg.make_source("my_src", list(range(10)))
+
+        node = seg.make_batched_node("batched",
+                                     batch_fn if batch_aware else map_fn,
+                                     max_batch_size=4,
+                                     max_hold_ms=10.0,
+                                     batch_aware=batch_aware)
+        seg.make_edge(src_node, node)
+
+        sink = seg.make_sink("my_sink", results.append, None, None)
+        seg.make_edge(node, sink)
+
+    pipeline = mrc.Pipeline()
+
+    pipeline.make_segment("my_seg", segment_init)
+
+    options = mrc.Options()
+    options.topology.user_cpuset = "0"
+
+    executor = mrc.Executor(options)
+
+    executor.register_pipeline(pipeline)
+
+    executor.start()
+
+    executor.join()
+
+    if batch_aware:
+        assert all(size <= 4 for size in batch_sizes)
+        assert sum(batch_sizes) == 10
+        assert results == [x * 2 for x in range(10) if x % 3 != 0]
+    else:
+        assert results == [x * 2 for x in range(10)]
+
+
+def test_is_gil_enabled():
+    # free-threaded builds report whether the GIL was re-enabled, e.g. by PYTHON_GIL=1
+    expected = sys._is_gil_enabled() if hasattr(sys, "_is_gil_enabled") else True
+
+    assert mrc.core.common.is_gil_enabled() == expected
+
+
+def test_async_source_and_node():
+    in_flight = 0
+    max_in_flight = 0
+    results = []
+
+    async def gen():
+        for i in range(20):
+            await asyncio.sleep(0)
+            yield i
+
+    async def double(x):
+        nonlocal in_flight, max_in_flight
+        in_flight += 1
+        max_in_flight = max(max_in_flight, in_flight)
+        # later inputs complete first
+        await asyncio.sleep(0.001 * (20 - x))
+        in_flight -= 1
+        return x * 2
+
+    def segment_init(seg: mrc.Builder):
+        src_node = seg.make_async_source("my_src", gen)
+
+        node = seg.make_async_node("async_node", double, max_concurrency=4)
+        seg.make_edge(src_node, node)
+
+        sink = seg.make_sink("my_sink", results.append, None, None)
+        seg.make_edge(node, sink)
+
+    pipeline = mrc.Pipeline()
+
+    pipeline.make_segment("my_seg", segment_init)
+
+    options = mrc.Options()
+    options.topology.user_cpuset = "0"
+
+    executor = mrc.Executor(options)
+
+    executor.register_pipeline(pipeline)
+
+    executor.start()
+
+    executor.join()
+
+    assert sorted(results) == [x * 2 for x in range(20)]
+    assert max_in_flight <= 4
@@ -13,6 +13,8 @@
 # See the License for the specific language governing permissions and
 # limitations under the License.
 
+import time
+
 import pytest
 
 import mrc
@@ -208,6 +210,125 @@ def test_to_list_empty(run_segment):
     assert actual == expected
 
 
+def test_batch(run_segment):
+
+    input_data = [1, 2, 3, 4, 5, "one", "two"]
+    expected = [[1, 2, 3], [4, 5, "one"], ["two"]]
+
+    def node_fn(input: mrc.Observable, output: mrc.Subscriber):
+
+        input.pipe(ops.batch(3)).subscribe(output)
+
+    actual, raised_error = run_segment(input_data, node_fn)
+
+    assert actual == expected
+
+
+def test_window(run_segment):
+
+    input_data = [1, 2, 3, 4, 5, 6]
+    expected = [[1, 2, 3], [3, 4, 5]]
+
+    def node_fn(input: mrc.Observable, output: mrc.Subscriber):
+
+        input.pipe(ops.window(3, step=2)).subscribe(output)
+
+    actual, raised_error = run_segment(input_data, node_fn)
+
+    assert actual == expected
+
+
+def test_distinct(run_segment):
+
+    input_data = [1, 2, 1, "one", 3, "one", 2, (1, 2), (1, 2)]
+    expected = [1, 2, "one", 3, (1, 2)]
+
+    def node_fn(input: mrc.Observable, output: mrc.Subscriber):
+
+        input.pipe(ops.distinct()).subscribe(output)
+
+    actual, raised_error = run_segment(input_data, node_fn)
+
+    assert actual == expected
+
+
+def test_take_skip(run_segment):
+
+    input_data = [1, 2, 3, 4, 5, "one", "two", "three"]
+    expected = [3, 4, 5]
+
+    def node_fn(input: mrc.Observable, output: mrc.Subscriber):
+
+        input.pipe(ops.skip(2), ops.take(3)).subscribe(output)
+
+    actual, raised_error = run_segment(input_data, node_fn)
+
+    assert actual == expected
+
+
+def test_throttle(run_segment):
+
+    input_data = list(range(10))
+
+    def node_fn(input: mrc.Observable, output: mrc.Subscriber):
+
+        # All of the elements arrive well within the interval of the first one
+        input.pipe(ops.throttle(60000.0)).subscribe(output)
+
+    actual, raised_error = run_segment(input_data, node_fn)
+
+    assert actual == [0]
+
+
+def test_rate_limit(run_segment):
+
+    input_data = list(range(5))
+
+    def node_fn(input: mrc.Observable, output: mrc.Subscriber):
+
+        input.pipe(ops.rate_limit(100.0)).subscribe(output)
+
+    start = time.perf_counter()
+    actual, raised_error = run_segment(input_data, node_fn)
+    elapsed = time.perf_counter() - start
+
+    assert actual == input_data
+    # the first element passes right away, each of the others waits a 10ms period
+    assert elapsed >= 0.04
+
+
+def test_key_by(run_segment):
+
+    input_data = [{"id": 1, "v": "a"}, {"id": 2, "v": "b"}]
+
+    def node_fn(input: mrc.Observable, output: mrc.Subscriber):
+
+        input.pipe(ops.key_by("id"), ops.map(lambda x: (x[0], x[1]["v"])), ops.key_by(lambda x: x[1])).subscribe(output)
+
+    actual, raised_error = run_segment(input_data, node_fn)
+
+    assert actual == [("a", (1, "a")), ("b", (2, "b"))]
+
+
+def test_native_operator_arguments():
+
+    with pytest.raises(ValueError):
+        ops.batch(0)
+
+    with pytest.raises(ValueError):
+        ops.window(2, step=0)
+
+    with pytest.raises(ValueError):
+        ops.rate_limit(0.0)
+
+
+def test_lazy_module_attribute():
+    # operators is not imported by `import mrc`, it is resolved on its first access
+    assert mrc.operators is ops
+    assert mrc.core.operators is ops
+    assert "operators" in dir(mrc)
+
+
 def test_combination(run_segment):
 
     input_data = [1, 2, 3, 4, 5, "one", "two", "three", "four", "five", 1, "two", 3]